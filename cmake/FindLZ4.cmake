@@ -0,0 +1,65 @@
+#.rst:
+# FindLZ4
+# ---------
+#
+# Try to locate the LZ4 library.
+# If found, this will define the following variables:
+#
+# ``LZ4_FOUND``
+#     True if the lz4 library is available
+# ``LZ4_INCLUDE_DIRS``
+#     The lz4 include directories
+# ``LZ4_LIBRARIES``
+#     The lz4 libraries for linking
+#
+# If ``LZ4_FOUND`` is TRUE, it will also define the following
+# imported target:
+#
+# ``LZ4::LZ4``
+#     The lz4 library
+
+find_package(PkgConfig QUIET)
+pkg_check_modules(PC_LZ4 QUIET liblz4)
+
+find_path(LZ4_INCLUDE_DIRS
+          NAMES lz4frame.h
+          HINTS ${PC_LZ4_INCLUDEDIR})
+
+find_library(LZ4_LIBRARY_RELEASE
+             NAMES lz4 liblz4 lz4_static liblz4_static
+             HINTS ${PC_LZ4_LIBDIR}
+)
+find_library(LZ4_LIBRARY_DEBUG
+             NAMES lz4d liblz4d lz4 liblz4 lz4_static liblz4_static
+             HINTS ${PC_LZ4_LIBDIR}
+)
+
+include(SelectLibraryConfigurations)
+select_library_configurations(LZ4)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4 REQUIRED_VARS LZ4_LIBRARIES LZ4_INCLUDE_DIRS
+                                      VERSION_VAR PC_LZ4_VERSION)
+
+if(LZ4_FOUND AND NOT TARGET LZ4::LZ4)
+    add_library(LZ4::LZ4 UNKNOWN IMPORTED)
+    set_target_properties(LZ4::LZ4 PROPERTIES
+                          INTERFACE_INCLUDE_DIRECTORIES "${LZ4_INCLUDE_DIRS}")
+    set_target_properties(LZ4::LZ4 PROPERTIES
+                          IMPORTED_LOCATION "${LZ4_LIBRARY}")
+    if(LZ4_LIBRARY_RELEASE)
+        set_target_properties(LZ4::LZ4 PROPERTIES
+                              IMPORTED_LOCATION_RELEASE "${LZ4_LIBRARY_RELEASE}")
+    endif()
+    if(LZ4_LIBRARY_DEBUG)
+        set_target_properties(LZ4::LZ4 PROPERTIES
+                              IMPORTED_LOCATION_DEBUG "${LZ4_LIBRARY_DEBUG}")
+    endif()
+endif()
+
+mark_as_advanced(LZ4_INCLUDE_DIRS LZ4_LIBRARIES LZ4_LIBRARY_RELEASE LZ4_LIBRARY_DEBUG)
+
+include(FeatureSummary)
+set_package_properties(LZ4 PROPERTIES
+  URL "https://github.com/lz4/lz4"
+  DESCRIPTION "LZ4 compression library")
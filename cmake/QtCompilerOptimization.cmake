@@ -121,6 +121,11 @@ if(WASM)
     set(QT_CFLAGS_OPTIMIZE_SIZE "-Os")
     set(QT_CFLAGS_OPTIMIZE_DEBUG "-g2")
 
+    # Emscripten translates SSE up to SSE4.1 to WebAssembly SIMD128 instructions;
+    # SSE4.2 and later are emulated with scalar code, so are left out
     set(QT_CFLAGS_SSE2 -O2 -msimd128 -msse -msse2)
+    set(QT_CFLAGS_SSE3 ${QT_CFLAGS_SSE2} -msse3)
+    set(QT_CFLAGS_SSSE3 ${QT_CFLAGS_SSE3} -mssse3)
+    set(QT_CFLAGS_SSE4_1 ${QT_CFLAGS_SSSE3} -msse4.1)
 
 endif()
@@ -222,6 +222,10 @@ endif()
 
 if(WASM AND QT_FEATURE_sse2)
     target_compile_definitions(PlatformCommonInternal INTERFACE QT_COMPILER_SUPPORTS_SSE2)
+    if(QT_FEATURE_sse4_1)
+        target_compile_definitions(PlatformCommonInternal INTERFACE
+            QT_COMPILER_SUPPORTS_SSE3 QT_COMPILER_SUPPORTS_SSSE3 QT_COMPILER_SUPPORTS_SSE4_1)
+    endif()
 endif()
 
 # Taken from mkspecs/common/msvc-version.conf and mkspecs/common/msvc-desktop.conf
@@ -18,8 +18,10 @@ function (qt_internal_setup_wasm_target_properties wasmTarget)
     "SHELL:-s EXPORT_NAME=createQtAppInstance")
 
     #simd
-    if (QT_FEATURE_sse2)
-        target_compile_options("${wasmTarget}" INTERFACE -O2 -msimd128 -msse -msse2)
+    if (QT_FEATURE_sse4_1)
+        target_compile_options("${wasmTarget}" INTERFACE ${QT_CFLAGS_SSE4_1})
+    elseif (QT_FEATURE_sse2)
+        target_compile_options("${wasmTarget}" INTERFACE ${QT_CFLAGS_SSE2})
     endif()
 
     # Hardcode wasm memory size. Emscripten does not currently support memory growth
@@ -18,6 +18,7 @@ endif()
 
 # special case end
 qt_find_package(ZSTD 1.3 PROVIDED_TARGETS ZSTD::ZSTD MODULE_NAME global QMAKE_LIB zstd)
+qt_find_package(LZ4 1.8 PROVIDED_TARGETS LZ4::LZ4 MODULE_NAME global QMAKE_LIB lz4)
 qt_find_package(WrapDBus1 1.2 PROVIDED_TARGETS dbus-1 MODULE_NAME global QMAKE_LIB dbus)
 qt_find_package(Libudev PROVIDED_TARGETS PkgConfig::Libudev MODULE_NAME global QMAKE_LIB libudev)
 
@@ -697,19 +698,19 @@ qt_feature_definition("sse2" "QT_COMPILER_SUPPORTS_SSE2" VALUE "1")
 qt_feature_config("sse2" QMAKE_PRIVATE_CONFIG)
 qt_feature("sse3" PRIVATE
     LABEL "SSE3"
-    CONDITION QT_FEATURE_sse2 AND TEST_subarch_sse3
+    CONDITION QT_FEATURE_sse2 AND ( TEST_subarch_sse3 OR WASM )
 )
 qt_feature_definition("sse3" "QT_COMPILER_SUPPORTS_SSE3" VALUE "1")
 qt_feature_config("sse3" QMAKE_PRIVATE_CONFIG)
 qt_feature("ssse3" PRIVATE
     LABEL "SSSE3"
-    CONDITION QT_FEATURE_sse3 AND TEST_subarch_ssse3
+    CONDITION QT_FEATURE_sse3 AND ( TEST_subarch_ssse3 OR WASM )
 )
 qt_feature_definition("ssse3" "QT_COMPILER_SUPPORTS_SSSE3" VALUE "1")
 qt_feature_config("ssse3" QMAKE_PRIVATE_CONFIG)
 qt_feature("sse4_1" PRIVATE
     LABEL "SSE4.1"
-    CONDITION QT_FEATURE_ssse3 AND TEST_subarch_sse4_1
+    CONDITION QT_FEATURE_ssse3 AND ( TEST_subarch_sse4_1 OR WASM )
 )
 qt_feature_definition("sse4_1" "QT_COMPILER_SUPPORTS_SSE4_1" VALUE "1")
 qt_feature_config("sse4_1" QMAKE_PRIVATE_CONFIG)
@@ -879,6 +880,10 @@ qt_feature("zstd" PRIVATE
     LABEL "Zstandard support"
     CONDITION ZSTD_FOUND
 )
+qt_feature("lz4" PRIVATE
+    LABEL "LZ4 support"
+    CONDITION LZ4_FOUND
+)
 qt_feature("stdlib-libcpp" PRIVATE
     LABEL "Using stdlib=libc++"
     AUTODETECT OFF
@@ -1124,6 +1129,7 @@ qt_configure_add_summary_entry(ARGS "pkg-config")
 qt_configure_add_summary_entry(ARGS "libudev")
 qt_configure_add_summary_entry(ARGS "system-zlib")
 qt_configure_add_summary_entry(ARGS "zstd")
+qt_configure_add_summary_entry(ARGS "lz4")
 qt_configure_add_summary_entry(ARGS "thread")
 qt_configure_end_summary_section() # end of "Support enabled for" section
 qt_configure_add_report_entry(
@@ -100,6 +100,9 @@
 static int system_has_forkfd(void);
 static int system_forkfd(int flags, pid_t *ppid, int *system);
 static int system_forkfd_wait(int ffd, struct forkfd_info *info, int ffdwoptions, struct rusage *rusage);
+#ifdef __linux__
+static int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system);
+#endif
 
 static int disable_fork_fallback(void)
 {
@@ -764,6 +767,46 @@ err_free:
     freeInfo(header, info);
     return -1;
 }
+
+/**
+ * @brief vforkfd returns a file descriptor representing a child process
+ * @return a file descriptor, or -1 in case of failure
+ *
+ * vforkfd() works like forkfd(), except that it does not return in the child
+ * process. Instead, the child calls @a childFn with @a token as its argument
+ * and exits with the value that function returns, unless it replaces itself
+ * by calling one of the exec functions first.
+ *
+ * In addition to the flags of forkfd(), @a flags can contain:
+ *
+ * @li @c FFD_VFORK_SEMANTICS Let the child share the memory of the parent
+ * until it calls exec or exits, and suspend the calling thread until then,
+ * like vfork(2). This avoids copying the page tables of the parent, which is
+ * expensive for parent processes that use a lot of memory. @a childFn must
+ * not modify any memory the parent uses, must only call async-signal-safe
+ * functions and must not return to a caller. Signal handlers installed by the
+ * parent run in the child until it calls exec, so the caller should block
+ * signals around vforkfd(). This flag is ignored where the system cannot
+ * provide these semantics; the child is then started with fork(2).
+ */
+int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
+{
+    int fd;
+#ifdef __linux__
+    int system;
+
+    if ((flags & FFD_USE_FORK) == 0) {
+        fd = system_vforkfd(flags, ppid, childFn, token, &system);
+        if (system)
+            return fd;
+    }
+#endif
+
+    fd = forkfd(flags, ppid);
+    if (fd == FFD_CHILD_PROCESS)
+        _exit(childFn(token));
+    return fd;
+}
 #endif // FORKFD_NO_FORKFD
 
 #if _POSIX_SPAWN > 0 && !defined(FORKFD_NO_SPAWNFD)
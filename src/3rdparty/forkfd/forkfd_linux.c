@@ -131,16 +131,33 @@ int system_has_forkfd()
     return ffd_atomic_load(&system_forkfd_state, FFD_ATOMIC_RELAXED) > 0;
 }
 
-int system_forkfd(int flags, pid_t *ppid, int *system)
+static int system_forkfd_supported(void)
 {
-    pid_t pid;
-    int pidfd;
-
     int state = ffd_atomic_load(&system_forkfd_state, FFD_ATOMIC_RELAXED);
     if (state == 0) {
         state = detect_clone_pidfd_support();
         ffd_atomic_store(&system_forkfd_state, state, FFD_ATOMIC_RELAXED);
     }
+    return state;
+}
+
+static int set_pidfd_flags(int pidfd, int flags)
+{
+    if ((flags & FFD_CLOEXEC) == 0) {
+        /* pidfd defaults to O_CLOEXEC */
+        fcntl(pidfd, F_SETFD, 0);
+    }
+    if (flags & FFD_NONBLOCK)
+        fcntl(pidfd, F_SETFL, fcntl(pidfd, F_GETFL) | O_NONBLOCK);
+    return pidfd;
+}
+
+int system_forkfd(int flags, pid_t *ppid, int *system)
+{
+    pid_t pid;
+    int pidfd;
+
+    int state = system_forkfd_supported();
     if (state < 0) {
         *system = 0;
         return state;
@@ -160,13 +177,39 @@ int system_forkfd(int flags, pid_t *ppid, int *system)
     }
 
     /* parent process */
-    if ((flags & FFD_CLOEXEC) == 0) {
-        /* pidfd defaults to O_CLOEXEC */
-        fcntl(pidfd, F_SETFD, 0);
+    return set_pidfd_flags(pidfd, flags);
+}
+
+int system_vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token, int *system)
+{
+    /* the child runs on this stack while this thread is suspended */
+    __attribute__((aligned(64))) char childStack[16384];
+    pid_t pid;
+    int pidfd;
+
+    if ((flags & FFD_VFORK_SEMANTICS) == 0) {
+        pidfd = system_forkfd(flags, ppid, system);
+        if (pidfd == FFD_CHILD_PROCESS)
+            _exit(childFn(token));
+        return pidfd;
     }
-    if (flags & FFD_NONBLOCK)
-        fcntl(pidfd, F_SETFL, fcntl(pidfd, F_GETFL) | O_NONBLOCK);
-    return pidfd;
+
+    int state = system_forkfd_supported();
+    if (state < 0) {
+        *system = 0;
+        return state;
+    }
+
+    *system = 1;
+    unsigned long cloneflags = CLONE_PIDFD | CLONE_VM | CLONE_VFORK | SIGCHLD;
+    pid = clone(childFn, childStack + sizeof(childStack), cloneflags, token, &pidfd);
+    if (pid < 0)
+        return pid;
+    if (ppid)
+        *ppid = pid;
+
+    /* parent process, resumed after the child called exec or exited */
+    return set_pidfd_flags(pidfd, flags);
 }
 
 int system_forkfd_wait(int ffd, struct forkfd_info *info, int ffdoptions, struct rusage *rusage)
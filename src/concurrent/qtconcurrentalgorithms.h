@@ -0,0 +1,442 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_ALGORITHMS_H
+#define QTCONCURRENT_ALGORITHMS_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentrun.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <vector>
+#ifndef QT_NO_EXCEPTIONS
+#include <exception>
+#include <QtCore/qmutex.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+// Runs the phases of a parallel algorithm over [begin, end). The range is cut
+// into blocks that are processed by the calling thread plus as many threads of
+// the pool as are idle; nested phases never wait for a queued task, so they
+// cannot deadlock a busy pool.
+template <typename Iterator, typename Promise>
+class AlgorithmKernel
+{
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                      typename std::iterator_traits<Iterator>::iterator_category>,
+                  "QtConcurrent algorithms require random access iterators");
+
+public:
+    enum { MinimumBlockSize = 4096 };
+
+    AlgorithmKernel(QThreadPool *pool, Promise &promise, Iterator begin, Iterator end)
+        : pool(pool), promise(promise),
+          threadCount(qMax(1, pool->maxThreadCount()))
+    {
+        const qsizetype size = end - begin;
+        const qsizetype blockCount =
+                qBound(qsizetype(1), size / MinimumBlockSize, qsizetype(4 * threadCount));
+        blocks.reserve(blockCount + 1);
+        for (qsizetype i = 0; i < blockCount; ++i)
+            blocks.push_back(begin + size * i / blockCount);
+        blocks.push_back(end);
+
+        // every block is processed once, then combined with its neighbors
+        promise.setProgressRange(0, int(2 * blockCount - 1));
+    }
+
+    qsizetype blockCount() const { return qsizetype(blocks.size()) - 1; }
+    bool isCanceled() const { return promise.isCanceled(); }
+    void blockFinished() { promise.setProgressValue(progress.fetchAndAddRelaxed(1) + 1); }
+
+    // Calls function(i) for each i in [0, count) and returns once all calls
+    // are done; returns false if the future was canceled in the meantime.
+    template <typename Function>
+    bool forEach(qsizetype count, const Function &function)
+    {
+        struct Shared
+        {
+            QAtomicInteger<qsizetype> next = 0;
+            QSemaphore finished;
+#ifndef QT_NO_EXCEPTIONS
+            QMutex mutex;
+            std::exception_ptr exception;
+#endif
+        };
+        const auto shared = std::make_shared<Shared>();
+
+        const auto work = [this, count, &function, s = shared.get()] {
+#ifndef QT_NO_EXCEPTIONS
+            try {
+#endif
+                qsizetype i;
+                while (!isCanceled() && (i = s->next.fetchAndAddRelaxed(1)) < count)
+                    function(i);
+#ifndef QT_NO_EXCEPTIONS
+            } catch (...) {
+                s->next.storeRelaxed(count);
+                QMutexLocker locker(&s->mutex);
+                if (!s->exception)
+                    s->exception = std::current_exception();
+            }
+#endif
+        };
+
+        int helpers = 0;
+        const qsizetype maxHelpers = qMin(count, qsizetype(threadCount)) - 1;
+        while (helpers < maxHelpers && pool->tryStart([shared, work] {
+                   work();
+                   shared->finished.release();
+               })) {
+            ++helpers;
+        }
+
+        work();
+        shared->finished.acquire(helpers);
+#ifndef QT_NO_EXCEPTIONS
+        if (shared->exception)
+            std::rethrow_exception(shared->exception);
+#endif
+        return !isCanceled();
+    }
+
+    template <typename LessThan>
+    void sort(LessThan lessThan, bool stable)
+    {
+        std::vector<Iterator> runs = blocks;
+        const bool sorted = forEach(blockCount(), [&](qsizetype i) {
+            if (stable)
+                std::stable_sort(runs[i], runs[i + 1], lessThan);
+            else
+                std::sort(runs[i], runs[i + 1], lessThan);
+            blockFinished();
+        });
+        if (!sorted)
+            return;
+
+        while (runs.size() > 2) {
+            const qsizetype pairs = qsizetype(runs.size() - 1) / 2;
+            const int pieces = int(qMax(qsizetype(1), threadCount / pairs));
+            const bool merged = forEach(pairs, [&](qsizetype i) {
+                merge(runs[2 * i], runs[2 * i + 1], runs[2 * i + 2], lessThan, pieces);
+                blockFinished();
+            });
+            if (!merged)
+                return;
+            dropMergedBoundaries(runs);
+        }
+    }
+
+    template <typename BinaryOperation>
+    void inclusiveScan(BinaryOperation op)
+    {
+        using Value = typename std::iterator_traits<Iterator>::value_type;
+
+        const bool scanned = forEach(blockCount(), [&](qsizetype i) {
+            std::partial_sum(blocks[i], blocks[i + 1], blocks[i], op);
+            blockFinished();
+        });
+        if (!scanned || blockCount() < 2)
+            return;
+
+        // carries[i] is the result for the last element of block i
+        std::vector<Value> carries;
+        carries.reserve(blockCount() - 1);
+        carries.push_back(*std::prev(blocks[1]));
+        for (qsizetype i = 1; i < blockCount() - 1; ++i)
+            carries.push_back(op(carries.back(), *std::prev(blocks[i + 1])));
+
+        forEach(blockCount() - 1, [&](qsizetype i) {
+            for (Iterator it = blocks[i + 1]; it != blocks[i + 2]; ++it)
+                *it = op(carries[i], *it);
+            blockFinished();
+        });
+    }
+
+    // Returns the partition point, or end if canceled.
+    template <typename Predicate>
+    Iterator partition(Predicate predicate)
+    {
+        std::vector<Iterator> runs = blocks;
+        std::vector<Iterator> points(blockCount());
+        const bool partitioned = forEach(blockCount(), [&](qsizetype i) {
+            points[i] = std::partition(runs[i], runs[i + 1], predicate);
+            blockFinished();
+        });
+        if (!partitioned)
+            return blocks.back();
+
+        // [T1 F1][T2 F2] becomes [T1 T2 F1 F2] by rotating F1 T2
+        while (runs.size() > 2) {
+            const qsizetype pairs = qsizetype(runs.size() - 1) / 2;
+            const bool combined = forEach(pairs, [&](qsizetype i) {
+                points[2 * i] = std::rotate(points[2 * i], runs[2 * i + 1], points[2 * i + 1]);
+                blockFinished();
+            });
+            if (!combined)
+                return blocks.back();
+            for (size_t i = 0; 2 * i < points.size(); ++i)
+                points[i] = points[2 * i];
+            points.resize((points.size() + 1) / 2);
+            dropMergedBoundaries(runs);
+        }
+        return points.front();
+    }
+
+private:
+    // After merging pairs of neighboring runs, drops the boundaries between
+    // the runs of each pair.
+    static void dropMergedBoundaries(std::vector<Iterator> &runs)
+    {
+        const size_t last = runs.size() - 1;
+        size_t j = 0;
+        for (size_t i = 0; i <= last; i += 2)
+            runs[j++] = runs[i];
+        if (last % 2)
+            runs[j++] = runs[last];
+        runs.resize(j);
+    }
+
+    // Stable merge of [first, middle) and [middle, last). Large merges are cut
+    // in two independent ones by rotating the middle, which can then proceed
+    // in parallel.
+    template <typename LessThan>
+    void merge(Iterator first, Iterator middle, Iterator last, LessThan &lessThan, int pieces)
+    {
+        if (first == middle || middle == last)
+            return;
+        if (pieces < 2 || last - first < 2 * MinimumBlockSize) {
+            std::inplace_merge(first, middle, last, lessThan);
+            return;
+        }
+
+        Iterator firstCut;
+        Iterator secondCut;
+        if (middle - first >= last - middle) {
+            firstCut = first + (middle - first) / 2;
+            secondCut = std::lower_bound(middle, last, *firstCut, lessThan);
+        } else {
+            secondCut = middle + (last - middle) / 2;
+            firstCut = std::upper_bound(first, middle, *secondCut, lessThan);
+        }
+        const Iterator newMiddle = std::rotate(firstCut, middle, secondCut);
+
+        forEach(2, [&](qsizetype half) {
+            if (half == 0)
+                merge(first, firstCut, newMiddle, lessThan, pieces / 2);
+            else
+                merge(newMiddle, secondCut, last, lessThan, pieces - pieces / 2);
+        });
+    }
+
+    QThreadPool *pool;
+    Promise &promise;
+    const int threadCount;
+    std::vector<Iterator> blocks;
+    QAtomicInt progress = 0;
+};
+
+template <typename Iterator, typename LessThan>
+QFuture<void> startSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan lessThan,
+                        bool stable)
+{
+    return run(pool, [=](QPromise<void> &promise) {
+        AlgorithmKernel<Iterator, QPromise<void>> kernel(pool, promise, begin, end);
+        kernel.sort(lessThan, stable);
+    });
+}
+
+template <typename Iterator, typename BinaryOperation>
+QFuture<void> startInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end,
+                                 BinaryOperation op)
+{
+    return run(pool, [=](QPromise<void> &promise) {
+        AlgorithmKernel<Iterator, QPromise<void>> kernel(pool, promise, begin, end);
+        kernel.inclusiveScan(op);
+    });
+}
+
+template <typename Iterator, typename Predicate>
+QFuture<qsizetype> startPartition(QThreadPool *pool, Iterator begin, Iterator end,
+                                  Predicate predicate)
+{
+    return run(pool, [=](QPromise<qsizetype> &promise) {
+        AlgorithmKernel<Iterator, QPromise<qsizetype>> kernel(pool, promise, begin, end);
+        const Iterator point = kernel.partition(predicate);
+        if (!promise.isCanceled())
+            promise.addResult(qsizetype(point - begin));
+    });
+}
+
+// sort()
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(pool, std::begin(sequence), std::end(sequence), std::move(lessThan), false);
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> sort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), std::begin(sequence), std::end(sequence),
+                     std::move(lessThan), false);
+}
+
+// stableSort()
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> stableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(pool, std::begin(sequence), std::end(sequence), std::move(lessThan), true);
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> stableSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), std::begin(sequence), std::end(sequence),
+                     std::move(lessThan), true);
+}
+
+// inclusiveScan()
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(QThreadPool *pool, Sequence &sequence,
+                            BinaryOperation op = BinaryOperation())
+{
+    return startInclusiveScan(pool, std::begin(sequence), std::end(sequence), std::move(op));
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(Sequence &sequence, BinaryOperation op = BinaryOperation())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), std::begin(sequence),
+                              std::end(sequence), std::move(op));
+}
+
+// partition()
+template <typename Sequence, typename Predicate>
+QFuture<qsizetype> partition(QThreadPool *pool, Sequence &sequence, Predicate predicate)
+{
+    return startPartition(pool, std::begin(sequence), std::end(sequence), std::move(predicate));
+}
+
+template <typename Sequence, typename Predicate>
+QFuture<qsizetype> partition(Sequence &sequence, Predicate predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), std::begin(sequence),
+                          std::end(sequence), std::move(predicate));
+}
+
+// blocking variants
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = sort(pool, sequence, std::move(lessThan));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = sort(sequence, std::move(lessThan));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingStableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = stableSort(pool, sequence, std::move(lessThan));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingStableSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = stableSort(sequence, std::move(lessThan));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(QThreadPool *pool, Sequence &sequence,
+                           BinaryOperation op = BinaryOperation())
+{
+    QFuture<void> future = inclusiveScan(pool, sequence, std::move(op));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(Sequence &sequence, BinaryOperation op = BinaryOperation())
+{
+    QFuture<void> future = inclusiveScan(sequence, std::move(op));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename Predicate>
+qsizetype blockingPartition(QThreadPool *pool, Sequence &sequence, Predicate predicate)
+{
+    QFuture<qsizetype> future = partition(pool, sequence, std::move(predicate));
+    return future.result();
+}
+
+template <typename Sequence, typename Predicate>
+qsizetype blockingPartition(Sequence &sequence, Predicate predicate)
+{
+    QFuture<qsizetype> future = partition(sequence, std::move(predicate));
+    return future.result();
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif // QTCONCURRENT_ALGORITHMS_H
@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qtconcurrentdiriterator.h"
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+
+#include <QtCore/private/qdiriterator_p.h>
+#include <QtCore/private/qduplicatetracker_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+namespace {
+
+// Lists each directory in a task of its own. Subdirectories found while
+// listing are queued as new tasks, so the tree fans out over the pool; no
+// task ever waits for another one.
+class DirectoryWalk : public std::enable_shared_from_this<DirectoryWalk>
+{
+public:
+    enum { BatchSize = 256 };
+
+    DirectoryWalk(QThreadPool *pool, const QStringList &nameFilters, QDir::Filters filters,
+                  QDirIterator::IteratorFlags flags)
+        : pool(pool), nameFilters(nameFilters), filters(filters), flags(flags)
+    { }
+
+    QFuture<QFileInfo> start(const QString &path)
+    {
+        futureInterface.setThreadPool(pool);
+        futureInterface.reportStarted();
+        QFuture<QFileInfo> future = futureInterface.future();
+
+        const QFileInfo root(path);
+        if (flags & QDirIterator::FollowSymlinks)
+            hasSeen(root);
+        enqueue(root);
+        return future;
+    }
+
+private:
+    bool hasSeen(const QFileInfo &directory)
+    {
+        const QString canonicalPath = directory.canonicalFilePath();
+        QMutexLocker locker(&mutex);
+        return visited.hasSeen(canonicalPath);
+    }
+
+    void enqueue(const QFileInfo &directory)
+    {
+        pending.ref();
+        pool->start([self = shared_from_this(), directory] { self->list(directory); });
+    }
+
+    void list(const QFileInfo &directory)
+    {
+        if (!futureInterface.isCanceled()) {
+            const auto descend = [this](const QFileInfo &subdirectory) {
+                // stop link loops
+                if (!(flags & QDirIterator::FollowSymlinks) || !hasSeen(subdirectory))
+                    enqueue(subdirectory);
+            };
+            QDirIteratorPrivate it(QFileSystemEntry(directory.filePath()), nameFilters, filters,
+                                   flags, true, descend);
+
+            QList<QFileInfo> batch;
+            batch.reserve(BatchSize);
+            while (it.hasNext() && !futureInterface.isCanceled()) {
+                it.advance();
+                batch.append(it.currentFileInfo);
+                if (batch.size() == BatchSize) {
+                    futureInterface.reportResults(batch, -1, batch.size());
+                    batch.clear();
+                }
+            }
+            if (!batch.isEmpty())
+                futureInterface.reportResults(batch, -1, batch.size());
+        }
+
+        if (!pending.deref())
+            futureInterface.reportFinished();
+    }
+
+    QFutureInterface<QFileInfo> futureInterface;
+    QThreadPool *pool;
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+    const QDirIterator::IteratorFlags flags;
+
+    // the number of directories queued or being listed
+    QAtomicInt pending;
+
+    QMutex mutex;
+    QDuplicateTracker<QString> visited;
+};
+
+} // unnamed namespace
+
+/*!
+    \fn QFuture<QFileInfo> QtConcurrent::iterateDirectory(QThreadPool *pool, const QString &path, const QStringList &nameFilters, QDir::Filters filters, QDirIterator::IteratorFlags flags)
+    \since 6.4
+
+    Lists the entries of the directory \a path that match \a nameFilters and
+    \a filters, using the threads of \a pool. By default, \a flags is
+    QDirIterator::Subdirectories, and the entries of all subdirectories are
+    listed as well.
+
+    The entries are the same that a QDirIterator constructed with the same
+    arguments would return, but in no particular order. Each directory is
+    listed by a task of its own, and the subdirectories it contains are
+    queued as new tasks, so that a large tree is read by all threads of
+    \a pool at once.
+
+    The returned future receives the entries in batches while the directories
+    are being read. Use a QFutureWatcher and its resultsReadyAt() signal to
+    process them as they arrive. Calling QFuture::cancel() stops the
+    iteration after the batches being read.
+
+    \sa QDirIterator
+*/
+QFuture<QFileInfo> iterateDirectory(QThreadPool *pool, const QString &path,
+                                    const QStringList &nameFilters, QDir::Filters filters,
+                                    QDirIterator::IteratorFlags flags)
+{
+    const auto walk = std::make_shared<DirectoryWalk>(pool, nameFilters, filters, flags);
+    return walk->start(path);
+}
+
+/*!
+    \fn QFuture<QFileInfo> QtConcurrent::iterateDirectory(const QString &path, const QStringList &nameFilters, QDir::Filters filters, QDirIterator::IteratorFlags flags)
+    \since 6.4
+
+    Lists the entries of the directory \a path that match \a nameFilters and
+    \a filters, using the threads of the global QThreadPool. By default,
+    \a flags is QDirIterator::Subdirectories, and the entries of all
+    subdirectories are listed as well.
+
+    \sa QDirIterator
+*/
+QFuture<QFileInfo> iterateDirectory(const QString &path, const QStringList &nameFilters,
+                                    QDir::Filters filters, QDirIterator::IteratorFlags flags)
+{
+    return iterateDirectory(QThreadPool::globalInstance(), path, nameFilters, filters, flags);
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
@@ -467,6 +467,28 @@
     \sa {Concurrent Filter and Filter-Reduce}
 */
 
+/*!
+    \fn template <typename Sequence, typename KeepFunctor> QFuture<void> QtConcurrent::filter(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Sequence &sequence, KeepFunctor &&filterFunction)
+    \since 6.4
+    \overload
+
+    Calls \a filterFunction once for each item in \a sequence, using the
+    threads of \a pool, and removes the items for which it returns
+    \c false. The items are handed out to the threads as specified by
+    \a policy.
+*/
+
+/*!
+    \fn template <typename Sequence, typename KeepFunctor> void QtConcurrent::blockingFilter(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Sequence &sequence, KeepFunctor &&filterFunction)
+    \since 6.4
+    \overload
+
+    Calls \a filterFunction once for each item in \a sequence, using the
+    threads of \a pool, removes the items for which it returns \c false,
+    and waits until all items have been processed. The items are handed out
+    to the threads as specified by \a policy.
+*/
+
 /*!
     \fn template <typename Sequence, typename KeepFunctor> void QtConcurrent::blockingFilter(QThreadPool *pool, Sequence &sequence, KeepFunctor &&filterFunction)
 
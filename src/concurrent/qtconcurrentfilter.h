@@ -54,12 +54,15 @@ namespace QtConcurrent {
 //! [QtConcurrent-1]
 template <typename Sequence, typename KeepFunctor, typename ReduceFunctor>
 ThreadEngineStarter<void> filterInternal(QThreadPool *pool, Sequence &sequence,
-                                         KeepFunctor &&keep, ReduceFunctor &&reduce)
+                                         KeepFunctor &&keep, ReduceFunctor &&reduce,
+                                         DispatchPolicy policy = DispatchPolicy())
 {
     typedef FilterKernel<Sequence, std::decay_t<KeepFunctor>, std::decay_t<ReduceFunctor>>
             KernelType;
-    return startThreadEngine(new KernelType(pool, sequence, std::forward<KeepFunctor>(keep),
-                                            std::forward<ReduceFunctor>(reduce)));
+    auto kernel = new KernelType(pool, sequence, std::forward<KeepFunctor>(keep),
+                                 std::forward<ReduceFunctor>(reduce));
+    kernel->dispatchPolicy = policy;
+    return startThreadEngine(kernel);
 }
 
 // filter() on sequences
@@ -77,6 +80,14 @@ QFuture<void> filter(Sequence &sequence, KeepFunctor &&keep)
                           sequence, std::forward<KeepFunctor>(keep), QtPrivate::PushBackWrapper());
 }
 
+template <typename Sequence, typename KeepFunctor>
+QFuture<void> filter(QThreadPool *pool, DispatchPolicy policy, Sequence &sequence,
+                     KeepFunctor &&keep)
+{
+    return filterInternal(pool, sequence, std::forward<KeepFunctor>(keep),
+                          QtPrivate::PushBackWrapper(), policy);
+}
+
 // filteredReduced() on sequences
 template <typename ResultType, typename Sequence, typename KeepFunctor, typename ReduceFunctor>
 QFuture<ResultType> filteredReduced(QThreadPool *pool,
@@ -402,6 +413,14 @@ void blockingFilter(Sequence &sequence, KeepFunctor &&keep)
     future.waitForFinished();
 }
 
+template <typename Sequence, typename KeepFunctor>
+void blockingFilter(QThreadPool *pool, DispatchPolicy policy, Sequence &sequence,
+                    KeepFunctor &&keep)
+{
+    QFuture<void> future = filter(pool, policy, sequence, std::forward<KeepFunctor>(keep));
+    future.waitForFinished();
+}
+
 // blocking filteredReduced() on sequences
 template <typename ResultType, typename Sequence, typename KeepFunctor, typename ReduceFunctor>
 ResultType blockingFilteredReduced(QThreadPool *pool,
@@ -89,6 +89,38 @@ private:
     Q_DISABLE_COPY(BlockSizeManager)
 };
 
+class DispatchPolicy
+{
+public:
+    enum Mode {
+        Adaptive,
+        FixedGrain,
+        Guided,
+        StaticPartition
+    };
+
+    constexpr DispatchPolicy() noexcept = default;
+
+    static constexpr DispatchPolicy adaptive() noexcept { return DispatchPolicy(); }
+    static constexpr DispatchPolicy fixedGrain(int grainSize) noexcept
+    { return DispatchPolicy(FixedGrain, grainSize); }
+    static constexpr DispatchPolicy guided(int minimumGrainSize = 1) noexcept
+    { return DispatchPolicy(Guided, minimumGrainSize); }
+    static constexpr DispatchPolicy staticPartition() noexcept
+    { return DispatchPolicy(StaticPartition, 1); }
+
+    constexpr Mode mode() const noexcept { return m_mode; }
+    constexpr int grainSize() const noexcept { return m_grainSize; }
+
+private:
+    constexpr DispatchPolicy(Mode mode, int grainSize) noexcept
+        : m_mode(mode), m_grainSize(grainSize > 1 ? grainSize : 1)
+    { }
+
+    Mode m_mode = Adaptive;
+    int m_grainSize = 1;
+};
+
 template <typename T>
 class ResultReporter
 {
@@ -261,7 +293,7 @@ public:
             if (this->isCanceled())
                 break;
 
-            const int currentBlockSize = blockSizeManager.blockSize();
+            const int currentBlockSize = nextBlockSize(blockSizeManager);
 
             if (currentIndex.loadRelaxed() >= iterationCount)
                 break;
@@ -284,9 +316,12 @@ public:
             resultReporter.reserveSpace(finalBlockSize);
 
             // Call user code with the current iteration range.
-            blockSizeManager.timeBeforeUser();
+            const bool adaptive = dispatchPolicy.mode() == DispatchPolicy::Adaptive;
+            if (adaptive)
+                blockSizeManager.timeBeforeUser();
             const bool resultsAvailable = this->runIterations(begin, beginIndex, endIndex, resultReporter.getPointer());
-            blockSizeManager.timeAfterUser();
+            if (adaptive)
+                blockSizeManager.timeAfterUser();
 
             if (resultsAvailable)
                 resultReporter.reportResults(beginIndex);
@@ -340,6 +375,24 @@ public:
     }
 
 private:
+    // The number of iterations a thread reserves at a time.
+    int nextBlockSize(BlockSizeManager &blockSizeManager) const
+    {
+        const int threadCount = qMax(1, ThreadEngineBase::threadPool->maxThreadCount());
+        switch (dispatchPolicy.mode()) {
+        case DispatchPolicy::Adaptive:
+            break;
+        case DispatchPolicy::FixedGrain:
+            return dispatchPolicy.grainSize();
+        case DispatchPolicy::Guided:
+            return qMax(dispatchPolicy.grainSize(),
+                        (iterationCount - currentIndex.loadRelaxed()) / threadCount);
+        case DispatchPolicy::StaticPartition:
+            return qMax(1, (iterationCount + threadCount - 1) / threadCount);
+        }
+        return blockSizeManager.blockSize();
+    }
+
     ResultReporter<T> createResultsReporter()
     {
         if constexpr (!std::is_same_v<T, void>)
@@ -359,6 +412,7 @@ public:
     const bool forIteration;
     bool progressReportingEnabled;
     DefaultValueContainer<ResultType> defaultValue;
+    DispatchPolicy dispatchPolicy;
 };
 
 } // namespace QtConcurrent
@@ -141,6 +141,91 @@
     might be supported in a future version of Qt Concurrent.)
 */
 
+/*!
+    \class QtConcurrent::DispatchPolicy
+    \inmodule QtConcurrent
+    \since 6.4
+    \brief The DispatchPolicy class controls how many items a thread of
+    QtConcurrent::map(), QtConcurrent::mappedReduced() or
+    QtConcurrent::filter() takes from the sequence at a time.
+
+    By default, each thread starts with one item at a time and doubles the
+    number while the time spent in the map or filter function is small
+    compared to the bookkeeping around it. This adapts well to most
+    workloads, but needs several rounds to settle when each item is very
+    cheap, and hands out too much work at once when items take very
+    different amounts of time.
+
+    A DispatchPolicy replaces this heuristic with a fixed rule. It is
+    passed after the QThreadPool to the overloads that accept one. The
+    policy only applies to random access sequences and iterators; other
+    sequences are processed one item at a time.
+
+    \sa {Concurrent Map and Map-Reduce}, {Concurrent Filter and Filter-Reduce}
+*/
+
+/*!
+    \enum QtConcurrent::DispatchPolicy::Mode
+
+    \value Adaptive The block size is adjusted from timing measurements.
+    This is the default.
+    \value FixedGrain Each thread takes grainSize() items at a time.
+    \value Guided Each thread takes the remaining items divided by the
+    number of threads, but at least grainSize() items at a time.
+    \value StaticPartition The sequence is split into one block per thread
+    of the pool.
+*/
+
+/*!
+    \fn QtConcurrent::DispatchPolicy::DispatchPolicy()
+
+    Constructs an adaptive policy.
+
+    \sa adaptive()
+*/
+
+/*!
+    \fn QtConcurrent::DispatchPolicy QtConcurrent::DispatchPolicy::adaptive()
+
+    Returns a policy that adjusts the block size from timing measurements.
+*/
+
+/*!
+    \fn QtConcurrent::DispatchPolicy QtConcurrent::DispatchPolicy::fixedGrain(int grainSize)
+
+    Returns a policy that makes each thread take \a grainSize items at a
+    time. Use this when the cost of an item is known and uniform.
+*/
+
+/*!
+    \fn QtConcurrent::DispatchPolicy QtConcurrent::DispatchPolicy::guided(int minimumGrainSize)
+
+    Returns a policy that makes each thread take the remaining items divided
+    by the number of threads, but at least \a minimumGrainSize items at a
+    time. Blocks shrink towards the end of the sequence, which balances
+    items of varying cost.
+*/
+
+/*!
+    \fn QtConcurrent::DispatchPolicy QtConcurrent::DispatchPolicy::staticPartition()
+
+    Returns a policy that splits the sequence into one contiguous block per
+    thread of the pool.
+*/
+
+/*!
+    \fn QtConcurrent::DispatchPolicy::Mode QtConcurrent::DispatchPolicy::mode() const
+
+    Returns the mode of this policy.
+*/
+
+/*!
+    \fn int QtConcurrent::DispatchPolicy::grainSize() const
+
+    Returns the number of items a thread takes at a time for FixedGrain,
+    or at least takes for Guided. Returns 1 for the other modes.
+*/
+
 /*!
     \page qtconcurrentmap.html
     \title Concurrent Map and Map-Reduce
@@ -569,6 +654,68 @@
     \sa map(), {Concurrent Map and Map-Reduce}
 */
 
+/*!
+    \fn template <typename Sequence, typename MapFunctor> QFuture<void> QtConcurrent::map(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Sequence &&sequence, MapFunctor &&function)
+    \since 6.4
+    \overload
+
+    Calls \a function once for each item in \a sequence, using the threads
+    of \a pool. The items are handed out to the threads as specified by
+    \a policy.
+*/
+
+/*!
+    \fn template <typename Iterator, typename MapFunctor> QFuture<void> QtConcurrent::map(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Iterator begin, Iterator end, MapFunctor &&function)
+    \since 6.4
+    \overload
+
+    Calls \a function once for each item from \a begin to \a end, using the
+    threads of \a pool. The items are handed out to the threads as specified
+    by \a policy.
+*/
+
+/*!
+    \fn template <typename Sequence, typename MapFunctor> void QtConcurrent::blockingMap(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Sequence &&sequence, MapFunctor function)
+    \since 6.4
+    \overload
+
+    Calls \a function once for each item in \a sequence, using the threads
+    of \a pool, and waits until all items have been processed. The items are
+    handed out to the threads as specified by \a policy.
+*/
+
+/*!
+    \fn template <typename Iterator, typename MapFunctor> void QtConcurrent::blockingMap(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Iterator begin, Iterator end, MapFunctor &&function)
+    \since 6.4
+    \overload
+
+    Calls \a function once for each item from \a begin to \a end, using the
+    threads of \a pool, and waits until all items have been processed. The
+    items are handed out to the threads as specified by \a policy.
+*/
+
+/*!
+    \fn template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor> QFuture<ResultType> QtConcurrent::mappedReduced(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Sequence &&sequence, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+    \since 6.4
+    \overload
+
+    Calls \a mapFunction once for each item in \a sequence, using the
+    threads of \a pool, and passes the results to \a reduceFunction in the
+    order given by \a reduceOptions. The items are handed out to the threads
+    as specified by \a policy.
+*/
+
+/*!
+    \fn template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor> ResultType QtConcurrent::blockingMappedReduced(QThreadPool *pool, QtConcurrent::DispatchPolicy policy, Sequence &&sequence, MapFunctor &&mapFunction, ReduceFunctor &&reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+    \since 6.4
+    \overload
+
+    Calls \a mapFunction once for each item in \a sequence, using the
+    threads of \a pool, passes the results to \a reduceFunction in the order
+    given by \a reduceOptions, and returns the final result. The items are
+    handed out to the threads as specified by \a policy.
+*/
+
 /*!
   \fn template <typename Iterator, typename MapFunctor> void QtConcurrent::blockingMap(Iterator begin, Iterator end, MapFunctor &&function)
 
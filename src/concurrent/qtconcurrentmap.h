@@ -81,6 +81,52 @@ QFuture<void> map(Iterator begin, Iterator end, MapFunctor &&map)
     return startMap(QThreadPool::globalInstance(), begin, end, std::forward<MapFunctor>(map));
 }
 
+// map() and mappedReduced() with a dispatch policy
+template <typename Sequence, typename MapFunctor>
+QFuture<void> map(QThreadPool *pool, DispatchPolicy policy, Sequence &&sequence,
+                  MapFunctor &&map)
+{
+    return startMap(pool, sequence.begin(), sequence.end(), std::forward<MapFunctor>(map),
+                    policy);
+}
+
+template <typename Iterator, typename MapFunctor>
+QFuture<void> map(QThreadPool *pool, DispatchPolicy policy, Iterator begin, Iterator end,
+                  MapFunctor &&map)
+{
+    return startMap(pool, begin, end, std::forward<MapFunctor>(map), policy);
+}
+
+template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
+QFuture<ResultType> mappedReduced(QThreadPool *pool,
+                                  DispatchPolicy policy,
+                                  Sequence &&sequence,
+                                  MapFunctor &&map,
+                                  ReduceFunctor &&reduce,
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce
+                                                                        | SequentialReduce))
+{
+    return startMappedReduced<QtPrivate::MapResultType<Sequence, MapFunctor>, ResultType>
+        (pool, std::forward<Sequence>(sequence), std::forward<MapFunctor>(map),
+         std::forward<ReduceFunctor>(reduce), options, policy);
+}
+
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor,
+          std::enable_if_t<QtPrivate::isInvocable<MapFunctor, Sequence>::value, int> = 0,
+          typename ResultType = typename QtPrivate::ReduceResultTypeHelper<ReduceFunctor>::type>
+QFuture<ResultType> mappedReduced(QThreadPool *pool,
+                                  DispatchPolicy policy,
+                                  Sequence &&sequence,
+                                  MapFunctor &&map,
+                                  ReduceFunctor &&reduce,
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce
+                                                                        | SequentialReduce))
+{
+    return startMappedReduced<QtPrivate::MapResultType<Sequence, MapFunctor>, ResultType>
+        (pool, std::forward<Sequence>(sequence), std::forward<MapFunctor>(map),
+         std::forward<ReduceFunctor>(reduce), options, policy);
+}
+
 // mappedReduced() for sequences.
 template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
 QFuture<ResultType> mappedReduced(QThreadPool *pool,
@@ -447,6 +493,57 @@ void blockingMap(Iterator begin, Iterator end, MapFunctor &&map)
     future.waitForFinished();
 }
 
+// blockingMap() and blockingMappedReduced() with a dispatch policy
+template <typename Sequence, typename MapFunctor>
+void blockingMap(QThreadPool *pool, DispatchPolicy policy, Sequence &&sequence, MapFunctor map)
+{
+    QFuture<void> future = startMap(pool, sequence.begin(), sequence.end(),
+                                    std::forward<MapFunctor>(map), policy);
+    future.waitForFinished();
+}
+
+template <typename Iterator, typename MapFunctor>
+void blockingMap(QThreadPool *pool, DispatchPolicy policy, Iterator begin, Iterator end,
+                 MapFunctor &&map)
+{
+    QFuture<void> future = startMap(pool, begin, end, std::forward<MapFunctor>(map), policy);
+    future.waitForFinished();
+}
+
+template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
+ResultType blockingMappedReduced(QThreadPool *pool,
+                                 DispatchPolicy policy,
+                                 Sequence &&sequence,
+                                 MapFunctor &&map,
+                                 ReduceFunctor &&reduce,
+                                 ReduceOptions options = ReduceOptions(UnorderedReduce
+                                                                       | SequentialReduce))
+{
+    QFuture<ResultType> future =
+            mappedReduced<ResultType>(pool, policy, std::forward<Sequence>(sequence),
+                                      std::forward<MapFunctor>(map),
+                                      std::forward<ReduceFunctor>(reduce), options);
+    return future.takeResult();
+}
+
+template <typename MapFunctor, typename ReduceFunctor, typename Sequence,
+          std::enable_if_t<QtPrivate::isInvocable<MapFunctor, Sequence>::value, int> = 0,
+          typename ResultType = typename QtPrivate::ReduceResultTypeHelper<ReduceFunctor>::type>
+ResultType blockingMappedReduced(QThreadPool *pool,
+                                 DispatchPolicy policy,
+                                 Sequence &&sequence,
+                                 MapFunctor &&map,
+                                 ReduceFunctor &&reduce,
+                                 ReduceOptions options = ReduceOptions(UnorderedReduce
+                                                                       | SequentialReduce))
+{
+    QFuture<ResultType> future =
+            mappedReduced<ResultType>(pool, policy, std::forward<Sequence>(sequence),
+                                      std::forward<MapFunctor>(map),
+                                      std::forward<ReduceFunctor>(reduce), options);
+    return future.takeResult();
+}
+
 // blockingMappedReduced() for sequences
 template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
 ResultType blockingMappedReduced(QThreadPool *pool,
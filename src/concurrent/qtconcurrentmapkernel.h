@@ -210,10 +210,13 @@ public:
 //! [qtconcurrentmapkernel-1]
 template <typename Iterator, typename Functor>
 inline ThreadEngineStarter<void> startMap(QThreadPool *pool, Iterator begin,
-                                          Iterator end, Functor &&functor)
+                                          Iterator end, Functor &&functor,
+                                          DispatchPolicy policy = DispatchPolicy())
 {
-    return startThreadEngine(new MapKernel<Iterator, std::decay_t<Functor>>(
-            pool, begin, end, std::forward<Functor>(functor)));
+    auto kernel = new MapKernel<Iterator, std::decay_t<Functor>>(
+            pool, begin, end, std::forward<Functor>(functor));
+    kernel->dispatchPolicy = policy;
+    return startThreadEngine(kernel);
 }
 
 //! [qtconcurrentmapkernel-2]
@@ -270,7 +273,8 @@ inline ThreadEngineStarter<ResultType> startMappedReduced(QThreadPool *pool,
                                                           Sequence &&sequence,
                                                           MapFunctor &&mapFunctor,
                                                           ReduceFunctor &&reduceFunctor,
-                                                          ReduceOptions options)
+                                                          ReduceOptions options,
+                                                          DispatchPolicy policy = DispatchPolicy())
 {
     using DecayedSequence = std::decay_t<Sequence>;
     using DecayedMapFunctor = std::decay_t<MapFunctor>;
@@ -281,10 +285,11 @@ inline ThreadEngineStarter<ResultType> startMappedReduced(QThreadPool *pool,
                                                  DecayedReduceFunctor, Reducer>;
     using SequenceHolderType = SequenceHolder2<DecayedSequence, MappedReduceType, DecayedMapFunctor,
                                                DecayedReduceFunctor>;
-    return startThreadEngine(new SequenceHolderType(pool, std::forward<Sequence>(sequence),
-                                                    std::forward<MapFunctor>(mapFunctor),
-                                                    std::forward<ReduceFunctor>(reduceFunctor),
-                                                    options));
+    auto kernel = new SequenceHolderType(pool, std::forward<Sequence>(sequence),
+                                         std::forward<MapFunctor>(mapFunctor),
+                                         std::forward<ReduceFunctor>(reduceFunctor), options);
+    kernel->dispatchPolicy = policy;
+    return startThreadEngine(kernel);
 }
 
 //! [qtconcurrentmapkernel-5]
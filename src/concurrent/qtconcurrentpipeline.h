@@ -0,0 +1,481 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtConcurrent module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_PIPELINE_H
+#define QTCONCURRENT_PIPELINE_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtCore/qfuture.h>
+#include <QtCore/qfutureinterface.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#ifndef QT_NO_EXCEPTIONS
+#include <exception>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+enum class StageMode {
+    Parallel,
+    SerialInOrder,
+    SerialOutOfOrder
+};
+
+template <typename Function>
+class PipelineStage
+{
+public:
+    PipelineStage(StageMode mode, Function function)
+        : mode(mode), function(std::move(function))
+    { }
+
+    StageMode mode;
+    Function function;
+};
+
+template <typename Function>
+PipelineStage<std::decay_t<Function>> stage(StageMode mode, Function &&function)
+{
+    return PipelineStage<std::decay_t<Function>>(mode, std::forward<Function>(function));
+}
+
+#ifndef Q_CLANG_QDOC
+
+// Stands in for the value passed on by a last stage that returns void.
+struct PipelineVoid
+{
+};
+
+template <typename T>
+struct PipelineStageType
+{
+    using Type = PipelineStage<std::decay_t<T>>;
+    static Type make(T &&function) { return Type(StageMode::Parallel, std::forward<T>(function)); }
+};
+
+template <typename Function>
+struct PipelineStageType<PipelineStage<Function>>
+{
+    using Type = PipelineStage<Function>;
+    static Type make(PipelineStage<Function> &&stage) { return std::move(stage); }
+};
+
+template <typename Function>
+struct PipelineStageType<PipelineStage<Function> &> : PipelineStageType<PipelineStage<Function>>
+{
+    static PipelineStage<Function> make(const PipelineStage<Function> &stage) { return stage; }
+};
+
+template <typename Function>
+struct PipelineStageType<const PipelineStage<Function> &>
+    : PipelineStageType<PipelineStage<Function> &>
+{
+};
+
+template <typename Function, typename In>
+using PipelineStageResult = std::conditional_t<
+        std::is_void_v<std::invoke_result_t<Function &, In &&>>,
+        PipelineVoid, std::decay_t<std::invoke_result_t<Function &, In &&>>>;
+
+template <typename In, typename... Stages>
+struct PipelineResult
+{
+    using Type = std::conditional_t<std::is_same_v<In, PipelineVoid>, void, In>;
+};
+
+template <typename In, typename Function, typename... Stages>
+struct PipelineResult<In, PipelineStage<Function>, Stages...>
+    : PipelineResult<PipelineStageResult<Function, In>, Stages...>
+{
+};
+
+// The state shared by all stages of a pipeline: the future, the number of
+// items in flight (tokens), and the number of workers pulling items from the
+// source. Nothing in a pipeline ever waits for a task of the pool, so it can
+// run on a busy pool, or from within one of its tasks.
+template <typename ResultType>
+class PipelineControl : public std::enable_shared_from_this<PipelineControl<ResultType>>
+{
+public:
+    PipelineControl(QThreadPool *pool, int maxTokens)
+        : pool(pool), maxTokens(qMax(1, maxTokens)),
+          maxWorkers(qMin(this->maxTokens, qMax(1, pool->maxThreadCount())))
+    { }
+    virtual ~PipelineControl() = default;
+
+    QFuture<ResultType> start()
+    {
+        futureInterface.setThreadPool(pool);
+        futureInterface.reportStarted();
+        QFuture<ResultType> future = futureInterface.future();
+        workers = 1;
+        startWorker();
+        return future;
+    }
+
+    bool isCanceled() const { return futureInterface.isCanceled(); }
+
+    // Runs task on the pool, keeping the pipeline alive until it returns.
+    void startTask(std::function<void()> task)
+    {
+        pool->start([self = this->shared_from_this(), task = std::move(task)] { task(); });
+    }
+
+#ifndef QT_NO_EXCEPTIONS
+    void reportException(const std::exception_ptr &exception)
+    {
+        futureInterface.reportException(exception);
+    }
+#endif
+
+    template <typename T>
+    void reportResult(qsizetype sequence, T &&result)
+    {
+        futureInterface.reportAndMoveResult(std::move(result), int(sequence));
+    }
+
+    // Called when an item has left the last stage, or was never produced.
+    void releaseToken()
+    {
+        QMutexLocker locker(&mutex);
+        --tokens;
+        // all workers gave up because every token was taken
+        if (workers == 0 && !sourceDone && !isCanceled()) {
+            ++workers;
+            locker.unlock();
+            startWorker();
+            return;
+        }
+        finishIfDone(locker);
+    }
+
+protected:
+    // Pulls one item from the source and pushes it into the first stage;
+    // returns false if the source is exhausted.
+    virtual bool pullItem() = 0;
+
+    void setSourceDone()
+    {
+        QMutexLocker locker(&mutex);
+        sourceDone = true;
+    }
+
+    bool isSourceDone()
+    {
+        QMutexLocker locker(&mutex);
+        return sourceDone;
+    }
+
+    // Called after an item was pulled; fans out to more workers as long as
+    // there are tokens and threads for them.
+    void startWorkerIfNeeded()
+    {
+        QMutexLocker locker(&mutex);
+        if (workers < maxWorkers && tokens < maxTokens && !sourceDone && !isCanceled()) {
+            ++workers;
+            locker.unlock();
+            startWorker();
+        }
+    }
+
+private:
+    void startWorker()
+    {
+        startTask([this] {
+            while (acquireToken()) {
+                if (!pullItem())
+                    releaseToken();
+            }
+        });
+    }
+
+    bool acquireToken()
+    {
+        QMutexLocker locker(&mutex);
+        if (tokens < maxTokens && !sourceDone && !isCanceled()) {
+            ++tokens;
+            return true;
+        }
+        --workers;
+        finishIfDone(locker);
+        return false;
+    }
+
+    void finishIfDone(QMutexLocker<QMutex> &locker)
+    {
+        if (finished || tokens > 0 || workers > 0 || !(sourceDone || isCanceled()))
+            return;
+        finished = true;
+        locker.unlock();
+        futureInterface.reportFinished();
+    }
+
+    QFutureInterface<ResultType> futureInterface;
+    QThreadPool *pool;
+    const int maxTokens;
+    const int maxWorkers;
+
+    QMutex mutex;
+    int tokens = 0;
+    int workers = 0;
+    bool sourceDone = false;
+    bool finished = false;
+};
+
+// A chain of stages; In is the type of the items entering the first one. An
+// empty item marks a slot whose value was lost to cancellation; it still
+// travels through the chain so that in-order stages do not wait for it.
+template <typename ResultType, typename In, typename... Stages>
+class PipelineNode;
+
+template <typename ResultType, typename In>
+class PipelineNode<ResultType, In>
+{
+public:
+    explicit PipelineNode(PipelineControl<ResultType> *control) : control(control) { }
+
+    void push(qsizetype sequence, std::optional<In> &&value)
+    {
+        if constexpr (!std::is_void_v<ResultType>) {
+            if (value)
+                control->reportResult(sequence, std::move(*value));
+        }
+        control->releaseToken();
+    }
+
+private:
+    PipelineControl<ResultType> *control;
+};
+
+template <typename ResultType, typename In, typename Function, typename... Stages>
+class PipelineNode<ResultType, In, PipelineStage<Function>, Stages...>
+{
+    using Out = PipelineStageResult<Function, In>;
+
+public:
+    PipelineNode(PipelineControl<ResultType> *control, PipelineStage<Function> &&stage,
+                 Stages &&...stages)
+        : control(control), mode(stage.mode), function(std::move(stage.function)),
+          next(control, std::move(stages)...)
+    { }
+
+    void push(qsizetype sequence, std::optional<In> &&value)
+    {
+        if (mode != StageMode::Parallel) {
+            QMutexLocker locker(&mutex);
+            if (busy || (mode == StageMode::SerialInOrder && sequence != nextSequence)) {
+                waiting.emplace(sequence, std::move(value));
+                return;
+            }
+            busy = true;
+        }
+        process(sequence, std::move(value));
+    }
+
+private:
+    void process(qsizetype sequence, std::optional<In> &&value)
+    {
+        std::optional<Out> result = invoke(std::move(value));
+        if (mode != StageMode::Parallel)
+            release(sequence);
+        next.push(sequence, std::move(result));
+    }
+
+    std::optional<Out> invoke(std::optional<In> &&value)
+    {
+        if (!value || control->isCanceled())
+            return std::nullopt;
+#ifndef QT_NO_EXCEPTIONS
+        try {
+#endif
+            if constexpr (std::is_same_v<Out, PipelineVoid>) {
+                std::invoke(function, std::move(*value));
+                return PipelineVoid();
+            } else {
+                return std::invoke(function, std::move(*value));
+            }
+#ifndef QT_NO_EXCEPTIONS
+        } catch (...) {
+            control->reportException(std::current_exception());
+            return std::nullopt;
+        }
+#endif
+    }
+
+    // Hands the stage over to the next waiting item, if it may run now. The
+    // current thread carries its own item on to the next stage, so the
+    // waiting one is processed by a new task.
+    void release(qsizetype sequence)
+    {
+        QMutexLocker locker(&mutex);
+        nextSequence = sequence + 1;
+        if (waiting.empty()
+            || (mode == StageMode::SerialInOrder && waiting.begin()->first != nextSequence)) {
+            busy = false;
+            return;
+        }
+        locker.unlock();
+        control->startTask([this] {
+            QMutexLocker locker(&mutex);
+            const auto it = waiting.begin();
+            const qsizetype sequence = it->first;
+            std::optional<In> value = std::move(it->second);
+            waiting.erase(it);
+            locker.unlock();
+            process(sequence, std::move(value));
+        });
+    }
+
+    PipelineControl<ResultType> *control;
+    const StageMode mode;
+    Function function;
+    PipelineNode<ResultType, Out, Stages...> next;
+
+    QMutex mutex;
+    bool busy = false;
+    qsizetype nextSequence = 0;
+    std::map<qsizetype, std::optional<In>> waiting;
+};
+
+template <typename ResultType, typename Source, typename... Stages>
+class Pipeline : public PipelineControl<ResultType>
+{
+    using In = typename std::decay_t<std::invoke_result_t<Source &>>::value_type;
+
+public:
+    Pipeline(QThreadPool *pool, int maxTokens, Source &&source, Stages &&...stages)
+        : PipelineControl<ResultType>(pool, maxTokens), source(std::move(source)),
+          first(this, std::move(stages)...)
+    { }
+
+protected:
+    bool pullItem() override
+    {
+        std::optional<In> value;
+        qsizetype sequence;
+        {
+            // the source is called serially, one item at a time
+            QMutexLocker locker(&sourceMutex);
+            if (this->isSourceDone())
+                return false;
+#ifndef QT_NO_EXCEPTIONS
+            try {
+#endif
+                value = std::invoke(source);
+#ifndef QT_NO_EXCEPTIONS
+            } catch (...) {
+                this->reportException(std::current_exception());
+            }
+#endif
+            if (!value) {
+                this->setSourceDone();
+                return false;
+            }
+            sequence = nextSequence++;
+        }
+        this->startWorkerIfNeeded();
+        first.push(sequence, std::move(value));
+        return true;
+    }
+
+private:
+    QMutex sourceMutex;
+    Source source;
+    qsizetype nextSequence = 0;
+    PipelineNode<ResultType, In, Stages...> first;
+};
+
+template <typename Source, typename... Stages>
+using PipelineResultType = typename PipelineResult<
+        typename std::decay_t<std::invoke_result_t<std::decay_t<Source> &>>::value_type,
+        typename PipelineStageType<Stages>::Type...>::Type;
+
+template <typename Source, typename... Stages>
+QFuture<PipelineResultType<Source, Stages...>>
+pipeline(QThreadPool *pool, int maxTokens, Source &&source, Stages &&...stages)
+{
+    static_assert(sizeof...(Stages) > 0, "A pipeline needs at least one stage");
+    using ResultType = PipelineResultType<Source, Stages...>;
+    using Engine = Pipeline<ResultType, std::decay_t<Source>,
+                           typename PipelineStageType<Stages>::Type...>;
+    const auto engine = std::make_shared<Engine>(
+            pool, maxTokens, std::decay_t<Source>(std::forward<Source>(source)),
+            PipelineStageType<Stages>::make(std::forward<Stages>(stages))...);
+    return engine->start();
+}
+
+template <typename Source, typename... Stages>
+QFuture<PipelineResultType<Source, Stages...>>
+pipeline(int maxTokens, Source &&source, Stages &&...stages)
+{
+    return pipeline(QThreadPool::globalInstance(), maxTokens, std::forward<Source>(source),
+                    std::forward<Stages>(stages)...);
+}
+
+#else
+
+using ResultType = int;
+
+template <typename Source, typename... Stages>
+QFuture<ResultType> pipeline(QThreadPool *pool, int maxTokens, Source &&source,
+                             Stages &&...stages);
+
+template <typename Source, typename... Stages>
+QFuture<ResultType> pipeline(int maxTokens, Source &&source, Stages &&...stages);
+
+#endif // Q_CLANG_QDOC
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif // QTCONCURRENT_PIPELINE_H
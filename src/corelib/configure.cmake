@@ -192,6 +192,26 @@ eventfd_write(fd, value);
 }
 ")
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"#include <sys/epoll.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct epoll_event ev;
+int fd = epoll_create1(EPOLL_CLOEXEC);
+ev.events = EPOLLIN;
+ev.data.fd = 0;
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(fd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # futimens
 qt_config_compile_test(futimens
     LABEL "futimens()"
@@ -286,6 +306,30 @@ inotify_rm_watch(0, 1);
 }
 ")
 
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+int fd = syscall(__NR_io_uring_setup, 8, &params);
+syscall(__NR_io_uring_enter, fd, 0, 0, IORING_ENTER_GETEVENTS, 0, 0);
+syscall(__NR_io_uring_register, fd, IORING_REGISTER_EVENTFD, 0, 0);
+struct io_uring_sqe sqe = {};
+sqe.opcode = IORING_OP_READ;
+sqe.opcode = IORING_OP_WRITE;
+(void) (params.features & IORING_FEAT_RW_CUR_POS);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # ipc_sysv
 qt_config_compile_test(ipc_sysv
     LABEL "SysV IPC"
@@ -543,6 +587,10 @@ qt_feature("eventfd" PUBLIC
     CONDITION NOT WASM AND TEST_eventfd
 )
 qt_feature_definition("eventfd" "QT_NO_EVENTFD" NEGATE VALUE "1")
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    CONDITION LINUX AND NOT WASM AND TEST_epoll
+)
 qt_feature("futimens" PRIVATE
     LABEL "futimens()"
     CONDITION NOT WIN32 AND TEST_futimens
@@ -580,6 +628,10 @@ qt_feature("inotify" PUBLIC PRIVATE
     CONDITION TEST_inotify
 )
 qt_feature_definition("inotify" "QT_NO_INOTIFY" NEGATE VALUE "1")
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    CONDITION LINUX AND TEST_io_uring
+)
 qt_feature("ipc_posix"
     LABEL "Using POSIX IPC"
     AUTODETECT NOT WIN32 AND ( ( APPLE AND QT_FEATURE_appstore_compliant ) OR NOT TEST_ipc_sysv )
@@ -846,6 +898,12 @@ qt_feature("stringlistmodel" PUBLIC
     CONDITION QT_FEATURE_itemmodel
 )
 qt_feature_definition("stringlistmodel" "QT_NO_STRINGLISTMODEL" NEGATE VALUE "1")
+qt_feature("columnartablemodel" PUBLIC
+    SECTION "ItemViews"
+    LABEL "QColumnarTableModel"
+    PURPOSE "Provides a table model storing the values of each column contiguously."
+    CONDITION QT_FEATURE_itemmodel
+)
 qt_feature("translation" PUBLIC
     SECTION "Internationalization"
     LABEL "Translation"
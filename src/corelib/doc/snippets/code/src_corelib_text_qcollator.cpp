@@ -56,3 +56,18 @@ QStringList sortedStrings(QStringList seq)
     return seq;
 }
 //! [0]
+
+//! [1]
+struct Contact
+{
+    QString name;
+    QString phone;
+};
+
+void sortByName(QList<Contact> &contacts)
+{
+    QCollator collator;
+    collator.sort(contacts.begin(), contacts.end(),
+                  [](const Contact &contact) -> const QString & { return contact.name; });
+}
+//! [1]
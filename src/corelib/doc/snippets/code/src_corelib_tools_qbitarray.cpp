@@ -191,3 +191,8 @@ ba.fill(true, 1, 2);            // ba: [ 0, 1, 0, 0 ]
 ba.fill(true, 1, 3);            // ba: [ 0, 1, 1, 0 ]
 ba.fill(true, 1, 4);            // ba: [ 0, 1, 1, 1 ]
 //! [15]
+
+//! [16]
+for (qsizetype i = bits.findFirstSet(); i != -1; i = bits.findNextSet(i + 1))
+    process(i);
+//! [16]
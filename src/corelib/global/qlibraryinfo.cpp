@@ -51,6 +51,7 @@
 #include "qcoreapplication.h"
 
 #include "private/qglobal_p.h"
+#include "private/qstartuptimeline_p.h"
 #include "archdetect.cpp"
 #include "qconfig.cpp"
 
@@ -552,6 +553,7 @@ QLibraryInfoPrivate::LocationInfo QLibraryInfoPrivate::locationInfo(QLibraryInfo
 */
 QString QLibraryInfo::path(LibraryPath p)
 {
+    QStartupTimelineScope timelineScope("QLibraryInfo::path");
     const LibraryPath loc = p;
     QString ret;
     bool fromConf = false;
@@ -57,6 +57,7 @@
 #include "qdatetime.h"
 #include "qcoreapplication.h"
 #include "qthread.h"
+#include "qwaitcondition.h"
 #include "private/qloggingregistry_p.h"
 #include "private/qcoreapplication_p.h"
 #include "private/qsimd_p.h"
@@ -162,6 +163,7 @@ static QT_PREPEND_NAMESPACE(qint64) qt_gettid()
 
 #include <cstdlib>
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -1095,12 +1097,14 @@ struct QMessagePattern
 
     bool fromEnvironment;
     static QBasicMutex mutex;
+    static QBasicAtomicInt hasBacktrace;  // whether the current pattern contains %{backtrace}
 };
 #ifdef QLOGGING_HAVE_BACKTRACE
 Q_DECLARE_TYPEINFO(QMessagePattern::BacktraceParams, Q_RELOCATABLE_TYPE);
 #endif
 
 QBasicMutex QMessagePattern::mutex;
+QBasicAtomicInt QMessagePattern::hasBacktrace = Q_BASIC_ATOMIC_INITIALIZER(0);
 
 QMessagePattern::QMessagePattern()
 {
@@ -1268,6 +1272,10 @@ void QMessagePattern::setPattern(const QString &pattern)
 
     literals.reset(new std::unique_ptr<const char[]>[literalsVar.size() + 1]);
     std::move(literalsVar.begin(), literalsVar.end(), &literals[0]);
+
+#ifdef QLOGGING_HAVE_BACKTRACE
+    hasBacktrace.storeRelaxed(!backtraceArgs.isEmpty());
+#endif
 }
 
 #if defined(QLOGGING_HAVE_BACKTRACE) && !defined(QT_BOOTSTRAPPED)
@@ -1355,6 +1363,27 @@ static QString formatBacktraceForLogMessage(const QMessagePattern::BacktracePara
 
 Q_GLOBAL_STATIC(QMessagePattern, qMessagePattern)
 
+namespace {
+#ifndef QT_BOOTSTRAPPED
+// What the thread- and time-dependent placeholders of the message pattern
+// expand to, captured when the message was logged
+struct QMessageLogOrigin
+{
+    qint64 msecsSinceEpoch = 0;
+    QElapsedTimer monotonic;
+    qint64 threadId = 0;
+    quintptr qthreadPtr = 0;
+};
+#else
+// bootstrapped tools have no asynchronous output and format every message
+// when it is logged
+struct QMessageLogOrigin;
+#endif
+} // unnamed namespace
+
+static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str,
+                                const QMessageLogOrigin *origin);
+
 /*!
     \relates <QtGlobal>
     \since 5.4
@@ -1371,9 +1400,21 @@ Q_GLOBAL_STATIC(QMessagePattern, qMessagePattern)
  */
 QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str)
 {
-    QString message;
-
     const auto locker = qt_scoped_lock(QMessagePattern::mutex);
+    return formatLogMessage(type, context, str, nullptr);
+}
+
+// Applies the message pattern. If \a origin is not null, the message is
+// formatted after the fact and the placeholders that depend on when and where
+// it was logged are taken from \a origin. Must be called with
+// QMessagePattern::mutex locked.
+static QString formatLogMessage(QtMsgType type, const QMessageLogContext &context, const QString &str,
+                                const QMessageLogOrigin *origin)
+{
+#ifdef QT_BOOTSTRAPPED
+    Q_UNUSED(origin);
+#endif
+    QString message;
 
     QMessagePattern *pattern = qMessagePattern();
     if (!pattern) {
@@ -1441,10 +1482,11 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             message.append(QCoreApplication::applicationName());
         } else if (token == threadidTokenC) {
             // print the TID as decimal
-            message.append(QString::number(qt_gettid()));
+            message.append(QString::number(origin ? origin->threadId : qt_gettid()));
         } else if (token == qthreadptrTokenC) {
             message.append(QLatin1String("0x"));
-            message.append(QString::number(qlonglong(QThread::currentThread()->currentThread()), 16));
+            message.append(QString::number(origin ? qlonglong(origin->qthreadPtr)
+                                                  : qlonglong(QThread::currentThread()->currentThread()), 16));
 #ifdef QLOGGING_HAVE_BACKTRACE
         } else if (token == backtraceTokenC) {
             QMessagePattern::BacktraceParams backtraceParams = pattern->backtraceArgs.at(backtraceArgsIdx);
@@ -1455,18 +1497,22 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             QString timeFormat = pattern->timeArgs.at(timeArgsIdx);
             timeArgsIdx++;
             if (timeFormat == QLatin1String("process")) {
-                    quint64 ms = pattern->timer.elapsed();
+                    quint64 ms = origin ? pattern->timer.msecsTo(origin->monotonic) : pattern->timer.elapsed();
                     message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
             } else if (timeFormat ==  QLatin1String("boot")) {
                 // just print the milliseconds since the elapsed timer reference
-                // like the Linux kernel does
-                uint ms = QDeadlineTimer::current().deadline();
+                // like the Linux kernel does (QDeadlineTimer uses the same clock)
+                uint ms = origin ? origin->monotonic.msecsSinceReference()
+                                 : QDeadlineTimer::current().deadline();
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if QT_CONFIG(datestring)
-            } else if (timeFormat.isEmpty()) {
-                    message.append(QDateTime::currentDateTime().toString(Qt::ISODate));
             } else {
-                message.append(QDateTime::currentDateTime().toString(timeFormat));
+                const QDateTime now = origin ? QDateTime::fromMSecsSinceEpoch(origin->msecsSinceEpoch)
+                                             : QDateTime::currentDateTime();
+                if (timeFormat.isEmpty())
+                    message.append(now.toString(Qt::ISODate));
+                else
+                    message.append(now.toString(timeFormat));
 #endif // QT_CONFIG(datestring)
             }
 #endif // !QT_BOOTSTRAPPED
@@ -1739,8 +1785,306 @@ static bool wasm_default_message_handler(QtMsgType type,
 
 // --------------------------------------------------------------------------
 
+// ------------------------ Asynchronous output ----------------------------
+
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(thread)
+namespace {
+struct AsyncMessage
+{
+    quint64 sequence = 0;
+    QtMsgType type = QtDebugMsg;
+    int line = 0;
+    QByteArray file;
+    QByteArray function;
+    QByteArray category;
+    QString message;
+    QMessageLogOrigin origin;
+    bool formatted = false;     // the pattern was already applied on the logging thread
+};
+
+// Messages of one logging thread, waiting to be written. The owning thread
+// is the only producer; the consumer is whoever holds the consumer mutex of
+// AsyncMessageOutput.
+struct AsyncMessageRing
+{
+    static constexpr size_t Capacity = 512;
+
+    bool push(AsyncMessage &msg)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        entries[t % Capacity] = std::move(msg);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    void takeAll(std::vector<AsyncMessage> &out)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        const size_t t = tail.load(std::memory_order_acquire);
+        for (size_t i = h; i != t; ++i)
+            out.push_back(std::move(entries[i % Capacity]));
+        head.store(t, std::memory_order_release);
+    }
+
+    bool isEmpty() const
+    {
+        return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+    }
+
+    qint64 threadId = qt_gettid();
+    quintptr qthreadPtr = quintptr(QThread::currentThread());
+    std::atomic<bool> orphaned = false;     // the owning thread has exited
+    std::atomic<size_t> head = 0;
+    std::atomic<size_t> tail = 0;
+    AsyncMessage entries[Capacity];
+};
+
+static thread_local AsyncMessageRing *currentAsyncMessageRing = nullptr;
+static thread_local bool asyncMessageRingOrphaned = false;  // also set on the writer thread
+static thread_local bool isAsyncMessageWriter = false;
+
+class AsyncMessageOutput : public QThread
+{
+public:
+    AsyncMessageOutput() { setObjectName(QStringLiteral("QtMessageOutput")); }
+    ~AsyncMessageOutput() override { stop(); }
+
+    void start(bool dropWhenFull);
+    void stop();
+    bool post(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    bool writePending();
+
+    std::atomic<bool> enabled = false;
+
+protected:
+    void run() override;
+
+private:
+    AsyncMessageRing *localRing();
+    void wakeWriter();
+
+    QMutex consumerMutex;   // serializes emptying the rings and writing
+    QMutex mutex;           // protects rings and the wait condition
+    QWaitCondition wakeUp;
+    std::vector<std::unique_ptr<AsyncMessageRing>> rings;
+    std::vector<AsyncMessage> batch;
+    std::atomic<bool> dropWhenFull = false;
+    std::atomic<bool> stopping = false;
+    std::atomic<bool> writerIdle = false;
+    std::atomic<quint64> nextSequence = 0;
+    std::atomic<quint64> dropped = 0;
+};
+
+struct AsyncMessageRingOwner
+{
+    ~AsyncMessageRingOwner();
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(AsyncMessageOutput, asyncMessageOutput)
+
+AsyncMessageRingOwner::~AsyncMessageRingOwner()
+{
+    AsyncMessageRing *ring = std::exchange(currentAsyncMessageRing, nullptr);
+    asyncMessageRingOrphaned = true;
+    // the writer frees the ring once it has written what is left in it
+    if (ring && asyncMessageOutput.exists())
+        ring->orphaned.store(true, std::memory_order_release);
+}
+
+AsyncMessageRing *AsyncMessageOutput::localRing()
+{
+    if (Q_LIKELY(currentAsyncMessageRing) || asyncMessageRingOrphaned)
+        return currentAsyncMessageRing;
+    static thread_local AsyncMessageRingOwner owner;
+    Q_UNUSED(owner);
+    auto ring = std::make_unique<AsyncMessageRing>();
+    const auto locker = qt_scoped_lock(mutex);
+    rings.push_back(std::move(ring));
+    return currentAsyncMessageRing = rings.back().get();
+}
+
+void AsyncMessageOutput::wakeWriter()
+{
+    if (writerIdle.exchange(false)) {
+        const auto locker = qt_scoped_lock(mutex);
+        wakeUp.wakeOne();
+    }
+}
+
+bool AsyncMessageOutput::post(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    AsyncMessageRing *ring = localRing();
+    if (!ring)
+        return false;
+
+    AsyncMessage msg;
+    msg.type = type;
+    if (QMessagePattern::hasBacktrace.loadRelaxed()) {
+        // the backtrace can only be taken here
+        msg.message = qFormatLogMessage(type, context, message);
+        msg.formatted = true;
+    } else {
+        // the strings of the context are not guaranteed to outlive the call
+        msg.line = context.line;
+        msg.file = QByteArray(context.file);
+        msg.function = QByteArray(context.function);
+        msg.category = QByteArray(context.category);
+        msg.message = message;
+        msg.origin.msecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+        msg.origin.monotonic.start();
+        msg.origin.threadId = ring->threadId;
+        msg.origin.qthreadPtr = ring->qthreadPtr;
+    }
+    msg.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+
+    while (!ring->push(msg)) {
+        if (dropWhenFull.load(std::memory_order_relaxed)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if (!enabled.load(std::memory_order_relaxed))
+            return false;
+        wakeWriter();
+        QThread::yieldCurrentThread();
+    }
+
+    // pairs with the store in run(): either we see the writer idle, or it sees our message
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerIdle.load(std::memory_order_relaxed))
+        wakeWriter();
+    return true;
+}
+
+// Empties all rings and writes their messages to stderr in the order they were
+// logged. Returns false if there was nothing to write.
+bool AsyncMessageOutput::writePending()
+{
+    const auto consumerLocker = qt_scoped_lock(consumerMutex);
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        for (auto it = rings.begin(); it != rings.end(); ) {
+            AsyncMessageRing *ring = it->get();
+            const bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+            ring->takeAll(batch);
+            if (orphaned)
+                it = rings.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    const quint64 lost = dropped.exchange(0, std::memory_order_relaxed);
+    if (batch.empty() && !lost)
+        return false;
+
+    std::sort(batch.begin(), batch.end(), [](const AsyncMessage &lhs, const AsyncMessage &rhs) {
+        return lhs.sequence < rhs.sequence;
+    });
+
+    QByteArray output;
+    {
+        const auto locker = qt_scoped_lock(QMessagePattern::mutex);
+        for (const AsyncMessage &msg : batch) {
+            QString formatted = msg.message;
+            if (!msg.formatted) {
+                const QMessageLogContext context(msg.file.constData(), msg.line,
+                                                 msg.function.constData(), msg.category.constData());
+                formatted = formatLogMessage(msg.type, context, msg.message, &msg.origin);
+            }
+            // print nothing if message pattern didn't apply / was empty.
+            if (formatted.isNull())
+                continue;
+            output += formatted.toLocal8Bit();
+            output += '\n';
+        }
+    }
+    batch.clear();
+    if (lost)
+        output += "QtMessageOutput: " + QByteArray::number(lost) + " messages were dropped\n";
+
+    fwrite(output.constData(), 1, size_t(output.size()), stderr);
+    fflush(stderr);
+    return true;
+}
+
+void AsyncMessageOutput::run()
+{
+    // messages logged while writing are written synchronously
+    asyncMessageRingOrphaned = true;
+    isAsyncMessageWriter = true;
+
+    while (true) {
+        if (writePending())
+            continue;
+
+        auto locker = qt_unique_lock(mutex);
+        if (stopping.load(std::memory_order_relaxed))
+            break;
+        writerIdle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (std::none_of(rings.begin(), rings.end(), [](const auto &ring) { return !ring->isEmpty(); })) {
+            // the timeout only serves as a backstop
+            wakeUp.wait(&mutex, QDeadlineTimer(100));
+        }
+        writerIdle.store(false, std::memory_order_relaxed);
+    }
+}
+
+void AsyncMessageOutput::start(bool drop)
+{
+    {
+        // create the pattern now, so that hasBacktrace is accurate
+        const auto locker = qt_scoped_lock(QMessagePattern::mutex);
+        qMessagePattern();
+    }
+    dropWhenFull.store(drop, std::memory_order_relaxed);
+    stopping.store(false, std::memory_order_relaxed);
+    QThread::start();
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void AsyncMessageOutput::stop()
+{
+    enabled.store(false, std::memory_order_relaxed);
+    {
+        const auto locker = qt_scoped_lock(mutex);
+        stopping.store(true, std::memory_order_relaxed);
+        wakeUp.wakeOne();
+    }
+    wait();
+    writePending();
+}
+
+// Returns false if the message has to be written synchronously.
+static bool postAsyncMessage(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type == QtFatalMsg || !asyncMessageOutput.exists()
+            || !asyncMessageOutput->enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    return asyncMessageOutput->post(type, context, message);
+}
+
+// Writes out everything that was logged before a message that is written synchronously.
+static void flushAsyncMessageOutput()
+{
+    if (asyncMessageOutput.exists() && !isAsyncMessageWriter)
+        asyncMessageOutput->writePending();
+}
+#else
+static bool postAsyncMessage(QtMsgType, const QMessageLogContext &, const QString &) { return false; }
+static void flushAsyncMessageOutput() { }
+#endif // !QT_BOOTSTRAPPED && QT_CONFIG(thread)
+
 static void stderr_message_handler(QtMsgType type, const QMessageLogContext &context, const QString &message)
 {
+    if (postAsyncMessage(type, context, message))
+        return;
+    flushAsyncMessageOutput();
+
     QString formattedMessage = qFormatLogMessage(type, context, message);
 
     // print nothing if message pattern didn't apply / was empty.
@@ -2059,6 +2403,56 @@ void qSetMessagePattern(const QString &pattern)
         qMessagePattern()->setPattern(pattern);
 }
 
+/*!
+    \fn void qSetAsynchronousMessageOutput(bool enable, bool dropWhenFull)
+    \relates <QtGlobal>
+    \since 6.4
+
+    Makes the default message handler write to \c stderr on a background
+    thread if \a enable is \c true, or on the thread that logs the message
+    otherwise, which is the default.
+
+    With asynchronous output, qDebug(), qInfo(), qWarning() and qCritical()
+    only queue the message and the values of the message pattern's
+    placeholders that depend on the logging thread and the time; applying the
+    pattern and writing happen later, in batches. Messages of each thread are
+    queued separately, so that logging threads do not contend with each other.
+    They are written in the order they were logged.
+
+    When a thread logs faster than the messages can be written and its queue is
+    full, the thread waits for the queue to drain, unless \a dropWhenFull is
+    \c true. Then the message is dropped and the number of dropped messages is
+    written instead.
+
+    Fatal messages, and messages logged while messages are being written, are
+    written synchronously after everything that was queued before them.
+    Disabling asynchronous output writes out the queued messages. A pattern
+    containing \c{%{backtrace}} is applied on the logging thread.
+
+    \note This only affects the default output to \c stderr. It has no
+    effect on messages that a handler installed with qInstallMessageHandler()
+    receives, or that the default handler sends to the system log.
+
+    \sa qSetMessagePattern(), qInstallMessageHandler()
+*/
+void qSetAsynchronousMessageOutput(bool enable, bool dropWhenFull)
+{
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(thread)
+    static QBasicMutex mutex;
+    const auto locker = qt_scoped_lock(mutex);
+    AsyncMessageOutput *output = asyncMessageOutput();
+    if (!output)
+        return;
+    if (output->enabled.load(std::memory_order_relaxed))
+        output->stop();
+    if (enable)
+        output->start(dropWhenFull);
+#else
+    Q_UNUSED(enable);
+    Q_UNUSED(dropWhenFull);
+#endif
+}
+
 
 /*!
     Copies context information from \a logContext into this QMessageLogContext.
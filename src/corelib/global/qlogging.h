@@ -205,6 +205,7 @@ typedef void (*QtMessageHandler)(QtMsgType, const QMessageLogContext &, const QS
 Q_CORE_EXPORT QtMessageHandler qInstallMessageHandler(QtMessageHandler);
 
 Q_CORE_EXPORT void qSetMessagePattern(const QString &messagePattern);
+Q_CORE_EXPORT void qSetAsynchronousMessageOutput(bool enable, bool dropWhenFull = false);
 Q_CORE_EXPORT QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context,
                                         const QString &buf);
 
@@ -1306,6 +1306,8 @@ namespace Qt {
         BlockingQueuedConnection,
         UniqueConnection =  0x80,
         SingleShotConnection = 0x100,
+        BatchedQueuedConnection = QueuedConnection | 0x200,
+        CoalescedQueuedConnection = QueuedConnection | 0x400,
     };
 
     enum ShortcutContext {
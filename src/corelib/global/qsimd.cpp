@@ -374,6 +374,13 @@ static quint64 detectProcessorFeatures()
     static const quint64 AllAVX = AllAVX512 | CpuFeatureAVX | CpuFeatureAVX2 | CpuFeatureF16C
             | CpuFeatureFMA | CpuFeatureVAES;
 
+#if defined(Q_CC_EMSCRIPTEN)
+    // There is no CPUID in WebAssembly. Emscripten compiles the SSE intrinsics
+    // to SIMD128 instructions, which a module can rely on once it has loaded,
+    // so the features are the ones this build was compiled with.
+    return qCompilerCpuFeatures;
+#endif
+
     quint64 features = 0;
     int cpuidLevel = maxBasicCpuidSupported();
 #if Q_PROCESSOR_X86 < 5
@@ -0,0 +1,358 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qasyncfileio_p.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <private/qbytearray_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QAsyncFileIO
+    \inmodule QtCore
+
+    \brief The QAsyncFileIO class performs positional reads and writes on an
+    open QFileDevice without blocking the calling thread.
+
+    Each call to read() or write() queues one request and returns its
+    non-zero identifier; the result is reported later, from the event loop of
+    the thread QAsyncFileIO lives in, through readFinished() or
+    writeFinished(). Requests use absolute offsets and never change the
+    position of the file device. A read only returns fewer bytes than asked
+    for when it reaches the end of the file.
+
+    On Linux the requests are submitted through io_uring, and completions
+    are picked up by a socket notifier on an eventfd, so no thread is needed
+    at all. If io_uring is not available, or the \c QT_NO_IO_URING
+    environment variable is set, each request is run on the global
+    QThreadPool instead.
+
+    The file device must stay open while requests are pending, and it should
+    be unbuffered (QIODevice::Unbuffered), since QAsyncFileIO operates on the
+    native file descriptor directly and bypasses the device's buffers.
+*/
+
+/*!
+    \internal
+    \fn void QAsyncFileIO::readFinished(quint64 id, const QByteArray &data, QFileDevice::FileError error)
+
+    This signal is emitted when the read request \a id has finished. \a data
+    holds the bytes that were read, and \a error is QFileDevice::NoError
+    unless the operation failed.
+*/
+
+/*!
+    \internal
+    \fn void QAsyncFileIO::writeFinished(quint64 id, qint64 bytesWritten, QFileDevice::FileError error)
+
+    This signal is emitted when the write request \a id has finished, with
+    \a bytesWritten bytes written to the file. \a error is
+    QFileDevice::NoError unless the operation failed.
+*/
+
+struct QAsyncFileIOPrivate::ThreadPoolState
+{
+    QMutex mutex;
+    QWaitCondition finished;
+    int running = 0;
+};
+
+// Performs what is left of \a request with blocking calls; returns 0 or the
+// errno value of the failing call.
+static int performRequest(QAsyncFileIOPrivate::Request &request)
+{
+    const qint64 total = request.buffer.size();
+    while (request.done < total) {
+        qint64 ret;
+        if (request.operation == QAsyncFileIOPrivate::Operation::Read) {
+            ret = qt_safe_pread(request.fd, request.buffer.data() + request.done,
+                                total - request.done, request.offset + request.done);
+        } else {
+            ret = qt_safe_pwrite(request.fd, request.buffer.constData() + request.done,
+                                 total - request.done, request.offset + request.done);
+        }
+        if (ret < 0)
+            return errno;
+        if (ret == 0)
+            break;
+        request.done += ret;
+    }
+    return 0;
+}
+
+QAsyncFileIOPrivate::QAsyncFileIOPrivate(QFileDevice *file)
+    : file(file)
+{
+}
+
+QAsyncFileIOPrivate::~QAsyncFileIOPrivate()
+{
+#if QT_CONFIG(io_uring)
+    delete ring;
+#endif
+}
+
+void QAsyncFileIOPrivate::init()
+{
+#if QT_CONFIG(io_uring)
+    if (initIoUring())
+        return;
+#endif
+    threadPoolState.reset(new ThreadPoolState);
+}
+
+void QAsyncFileIOPrivate::enqueue(Request &&request)
+{
+    ++pending;
+#if QT_CONFIG(io_uring)
+    if (ring) {
+        queued.enqueue(std::move(request));
+        submitToIoUring();
+        return;
+    }
+#endif
+    startOnThreadPool(std::move(request));
+}
+
+void QAsyncFileIOPrivate::finishRequest(Request &request, int errorCode)
+{
+    Q_Q(QAsyncFileIO);
+    --pending;
+    if (shuttingDown)
+        return;
+
+    QFileDevice::FileError error = QFileDevice::NoError;
+    if (request.operation == QAsyncFileIOPrivate::Operation::Read) {
+        if (errorCode)
+            error = QFileDevice::ReadError;
+        request.buffer.truncate(request.done);
+        emit q->readFinished(request.id, request.buffer, error);
+    } else {
+        if (errorCode)
+            error = errorCode == ENOSPC ? QFileDevice::ResourceError : QFileDevice::WriteError;
+        emit q->writeFinished(request.id, request.done, error);
+    }
+}
+
+void QAsyncFileIOPrivate::startOnThreadPool(Request &&request)
+{
+    Q_Q(QAsyncFileIO);
+    QSharedPointer<ThreadPoolState> state = threadPoolState;
+    {
+        QMutexLocker locker(&state->mutex);
+        ++state->running;
+    }
+
+    QThreadPool::globalInstance()->start([q, state, request = std::move(request)]() mutable {
+        const int errorCode = performRequest(request);
+        QMetaObject::invokeMethod(q, [q, request = std::move(request), errorCode]() mutable {
+            q->d_func()->finishRequest(request, errorCode);
+        }, Qt::QueuedConnection);
+
+        QMutexLocker locker(&state->mutex);
+        if (--state->running == 0)
+            state->finished.wakeAll();
+    });
+}
+
+bool QAsyncFileIOPrivate::waitForThreadPool(int msecs)
+{
+    Q_Q(QAsyncFileIO);
+    {
+        QDeadlineTimer deadline(msecs);
+        QMutexLocker locker(&threadPoolState->mutex);
+        while (threadPoolState->running) {
+            if (!threadPoolState->finished.wait(&threadPoolState->mutex, deadline))
+                return false;
+        }
+    }
+
+    // deliver the results that were posted by the finished tasks
+    QCoreApplication::sendPostedEvents(q, QEvent::MetaCall);
+    return pending == 0;
+}
+
+/*!
+    \internal
+
+    Constructs a QAsyncFileIO object operating on \a file, with the given
+    \a parent.
+*/
+QAsyncFileIO::QAsyncFileIO(QFileDevice *file, QObject *parent)
+    : QObject(*new QAsyncFileIOPrivate(file), parent)
+{
+    Q_D(QAsyncFileIO);
+    d->init();
+}
+
+/*!
+    \internal
+
+    Destroys the QAsyncFileIO object. Requests that are still pending are
+    completed first, without emitting any signals.
+*/
+QAsyncFileIO::~QAsyncFileIO()
+{
+    Q_D(QAsyncFileIO);
+    d->shuttingDown = true;
+    waitForFinished(-1);
+}
+
+/*!
+    \internal
+
+    Returns the file device this object operates on.
+*/
+QFileDevice *QAsyncFileIO::file() const
+{
+    Q_D(const QAsyncFileIO);
+    return d->file;
+}
+
+/*!
+    \internal
+
+    Returns the backend that was picked for this object.
+*/
+QAsyncFileIO::Backend QAsyncFileIO::backend() const
+{
+    Q_D(const QAsyncFileIO);
+    return d->backend;
+}
+
+/*!
+    \internal
+
+    Queues a read of up to \a maxSize bytes starting at \a offset and returns
+    the identifier of the request, or 0 if the request could not be queued.
+*/
+quint64 QAsyncFileIO::read(qint64 offset, qint64 maxSize)
+{
+    Q_D(QAsyncFileIO);
+    const int fd = d->file ? d->file->handle() : -1;
+    if (fd < 0 || !d->file->isReadable()) {
+        qWarning("QAsyncFileIO::read: File not open for reading");
+        return 0;
+    }
+    if (offset < 0 || maxSize < 0 || maxSize > MaxByteArraySize) {
+        qWarning("QAsyncFileIO::read: Invalid offset or size");
+        return 0;
+    }
+
+    QAsyncFileIOPrivate::Request request = {
+        d->nextId++, offset, 0, QByteArray(maxSize, Qt::Uninitialized), fd,
+        QAsyncFileIOPrivate::Operation::Read
+    };
+    const quint64 id = request.id;
+    d->enqueue(std::move(request));
+    return id;
+}
+
+/*!
+    \internal
+
+    Queues a write of \a data at \a offset and returns the identifier of the
+    request, or 0 if the request could not be queued.
+*/
+quint64 QAsyncFileIO::write(qint64 offset, const QByteArray &data)
+{
+    Q_D(QAsyncFileIO);
+    const int fd = d->file ? d->file->handle() : -1;
+    if (fd < 0 || !d->file->isWritable()) {
+        qWarning("QAsyncFileIO::write: File not open for writing");
+        return 0;
+    }
+    if (offset < 0) {
+        qWarning("QAsyncFileIO::write: Invalid offset");
+        return 0;
+    }
+
+    QAsyncFileIOPrivate::Request request = {
+        d->nextId++, offset, 0, data, fd, QAsyncFileIOPrivate::Operation::Write
+    };
+    const quint64 id = request.id;
+    d->enqueue(std::move(request));
+    return id;
+}
+
+/*!
+    \internal
+
+    Returns the number of requests that have been queued but not reported
+    as finished yet.
+*/
+qsizetype QAsyncFileIO::pendingRequests() const
+{
+    Q_D(const QAsyncFileIO);
+    return d->pending;
+}
+
+/*!
+    \internal
+
+    Blocks until all pending requests have finished and their signals have
+    been emitted, or until \a msecs milliseconds have passed. A value of -1
+    waits forever. Returns \c true if no request is pending any more.
+*/
+bool QAsyncFileIO::waitForFinished(int msecs)
+{
+    Q_D(QAsyncFileIO);
+    if (d->pending == 0)
+        return true;
+#if QT_CONFIG(io_uring)
+    if (d->ring)
+        return d->waitForIoUring(msecs);
+#endif
+    return d->waitForThreadPool(msecs);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qasyncfileio_p.cpp"
@@ -0,0 +1,207 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QASYNCFILEIO_P_H
+#define QASYNCFILEIO_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfiledevice.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/private/qobject_p.h>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QAsyncFileIOPrivate;
+class QSocketNotifier;
+
+class Q_CORE_EXPORT QAsyncFileIO : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QAsyncFileIO)
+
+public:
+    enum Backend {
+        ThreadPoolBackend,
+        IoUringBackend
+    };
+    Q_ENUM(Backend)
+
+    explicit QAsyncFileIO(QFileDevice *file, QObject *parent = nullptr);
+    ~QAsyncFileIO();
+
+    QFileDevice *file() const;
+    Backend backend() const;
+
+    quint64 read(qint64 offset, qint64 maxSize);
+    quint64 write(qint64 offset, const QByteArray &data);
+
+    qsizetype pendingRequests() const;
+    bool waitForFinished(int msecs = 30000);
+
+Q_SIGNALS:
+    void readFinished(quint64 id, const QByteArray &data, QFileDevice::FileError error);
+    void writeFinished(quint64 id, qint64 bytesWritten, QFileDevice::FileError error);
+
+private:
+    Q_DISABLE_COPY(QAsyncFileIO)
+};
+
+#if QT_CONFIG(io_uring)
+class QIoUring
+{
+public:
+    struct Completion {
+        quint64 userData;
+        int result;
+    };
+
+    QIoUring() = default;
+    ~QIoUring();
+
+    bool init(unsigned entries);
+    int eventFd() const { return efd; }
+    unsigned capacity() const { return sqEntries; }
+
+    bool prepareRead(quint64 userData, int fd, void *buffer, unsigned length, qint64 offset);
+    bool prepareWrite(quint64 userData, int fd, const void *buffer, unsigned length, qint64 offset);
+    bool submit(unsigned waitFor = 0);
+    qsizetype reapCompletions(QList<Completion> *completions);
+    void drainEventFd();
+
+private:
+    Q_DISABLE_COPY_MOVE(QIoUring)
+    bool prepare(quint8 opcode, quint64 userData, int fd, quint64 address, unsigned length,
+                 qint64 offset);
+
+    int ringFd = -1;
+    int efd = -1;
+
+    void *sqRing = nullptr;
+    void *cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    void *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqMask = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqEntries = 0;
+    unsigned toSubmit = 0;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned *cqMask = nullptr;
+    void *cqes = nullptr;
+};
+#endif // QT_CONFIG(io_uring)
+
+class QAsyncFileIOPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QAsyncFileIO)
+
+public:
+    enum class Operation : quint8 {
+        Read,
+        Write
+    };
+
+    struct Request {
+        quint64 id;
+        qint64 offset;
+        qint64 done;
+        QByteArray buffer;
+        int fd;
+        Operation operation;
+    };
+
+    struct ThreadPoolState;
+
+    QAsyncFileIOPrivate(QFileDevice *file);
+    ~QAsyncFileIOPrivate();
+
+    void init();
+    void enqueue(Request &&request);
+    void finishRequest(Request &request, int errorCode);
+
+    void startOnThreadPool(Request &&request);
+    bool waitForThreadPool(int msecs);
+
+    QFileDevice *file;
+    quint64 nextId = 1;
+    qsizetype pending = 0;
+    QAsyncFileIO::Backend backend = QAsyncFileIO::ThreadPoolBackend;
+    bool shuttingDown = false;
+
+    QSharedPointer<ThreadPoolState> threadPoolState;
+
+#if QT_CONFIG(io_uring)
+    bool initIoUring();
+    void submitToIoUring();
+    void reapIoUring();
+    bool waitForIoUring(int msecs);
+
+    QIoUring *ring = nullptr;
+    QSocketNotifier *ringNotifier = nullptr;
+    QHash<quint64, Request> inFlight;
+    QQueue<Request> queued;
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QASYNCFILEIO_P_H
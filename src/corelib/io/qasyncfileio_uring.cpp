@@ -0,0 +1,323 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qasyncfileio_p.h"
+
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qsocketnotifier.h>
+
+#include <private/qcore_unix_p.h>
+
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+QT_BEGIN_NAMESPACE
+
+// 64 entries are plenty: requests that do not fit are queued by
+// QAsyncFileIOPrivate and submitted as soon as earlier ones complete.
+static constexpr unsigned RingEntries = 64;
+
+// The kernel limits a single read or write to about 2 GB anyway; larger
+// requests are split and resubmitted by QAsyncFileIOPrivate.
+static constexpr qint64 MaxChunkSize = 1 << 30;
+
+static int qt_io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int qt_io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static int qt_io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nrArgs)
+{
+    return int(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+template <typename T> static T *ringPointer(void *ring, quint32 offset)
+{
+    return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+QIoUring::~QIoUring()
+{
+    if (sqes)
+        munmap(sqes, sqesSize);
+    if (cqRing && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing)
+        munmap(sqRing, sqRingSize);
+    if (efd >= 0)
+        qt_safe_close(efd);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+bool QIoUring::init(unsigned entries)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd = qt_io_uring_setup(entries, &params);
+    if (ringFd < 0)
+        return false;
+
+    // IORING_OP_READ and IORING_OP_WRITE appeared in the same kernel release
+    // (5.6) as this feature flag.
+    if (!(params.features & IORING_FEAT_RW_CUR_POS))
+        return false;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    void *ptr = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     ringFd, IORING_OFF_SQ_RING);
+    if (ptr == MAP_FAILED)
+        return false;
+    sqRing = ptr;
+
+    if (singleMap) {
+        cqRing = sqRing;
+    } else {
+        ptr = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ringFd, IORING_OFF_CQ_RING);
+        if (ptr == MAP_FAILED)
+            return false;
+        cqRing = ptr;
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ptr = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               ringFd, IORING_OFF_SQES);
+    if (ptr == MAP_FAILED)
+        return false;
+    sqes = ptr;
+
+    sqHead = ringPointer<unsigned>(sqRing, params.sq_off.head);
+    sqTail = ringPointer<unsigned>(sqRing, params.sq_off.tail);
+    sqMask = ringPointer<unsigned>(sqRing, params.sq_off.ring_mask);
+    sqArray = ringPointer<unsigned>(sqRing, params.sq_off.array);
+    sqEntries = params.sq_entries;
+
+    cqHead = ringPointer<unsigned>(cqRing, params.cq_off.head);
+    cqTail = ringPointer<unsigned>(cqRing, params.cq_off.tail);
+    cqMask = ringPointer<unsigned>(cqRing, params.cq_off.ring_mask);
+    cqes = ringPointer<void>(cqRing, params.cq_off.cqes);
+
+    efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (efd < 0)
+        return false;
+    return qt_io_uring_register(ringFd, IORING_REGISTER_EVENTFD, &efd, 1) == 0;
+}
+
+bool QIoUring::prepare(quint8 opcode, quint64 userData, int fd, quint64 address,
+                       unsigned length, qint64 offset)
+{
+    // we are the only producer, so only the head can move behind our back
+    const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    const unsigned tail = *sqTail;
+    if (tail - head >= sqEntries)
+        return false;
+
+    const unsigned index = tail & *sqMask;
+    io_uring_sqe *sqe = static_cast<io_uring_sqe *>(sqes) + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = address;
+    sqe->len = length;
+    sqe->off = quint64(offset);
+    sqe->user_data = userData;
+    sqArray[index] = index;
+
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++toSubmit;
+    return true;
+}
+
+bool QIoUring::prepareRead(quint64 userData, int fd, void *buffer, unsigned length, qint64 offset)
+{
+    return prepare(IORING_OP_READ, userData, fd, quintptr(buffer), length, offset);
+}
+
+bool QIoUring::prepareWrite(quint64 userData, int fd, const void *buffer, unsigned length,
+                            qint64 offset)
+{
+    return prepare(IORING_OP_WRITE, userData, fd, quintptr(buffer), length, offset);
+}
+
+bool QIoUring::submit(unsigned waitFor)
+{
+    if (toSubmit == 0 && waitFor == 0)
+        return true;
+
+    int ret;
+    EINTR_LOOP(ret, qt_io_uring_enter(ringFd, toSubmit, waitFor,
+                                      waitFor ? IORING_ENTER_GETEVENTS : 0));
+    if (ret < 0)
+        return false;
+    toSubmit -= qMin(unsigned(ret), toSubmit);
+    return true;
+}
+
+qsizetype QIoUring::reapCompletions(QList<Completion> *completions)
+{
+    unsigned head = *cqHead;
+    const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    const qsizetype count = qsizetype(tail - head);
+    for (; head != tail; ++head) {
+        const io_uring_cqe *cqe = static_cast<io_uring_cqe *>(cqes) + (head & *cqMask);
+        completions->append({ cqe->user_data, cqe->res });
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    return count;
+}
+
+void QIoUring::drainEventFd()
+{
+    eventfd_t value;
+    eventfd_read(efd, &value);
+}
+
+bool QAsyncFileIOPrivate::initIoUring()
+{
+    Q_Q(QAsyncFileIO);
+    if (qEnvironmentVariableIsSet("QT_NO_IO_URING"))
+        return false;
+
+    ring = new QIoUring;
+    if (!ring->init(RingEntries)) {
+        delete ring;
+        ring = nullptr;
+        return false;
+    }
+
+    ringNotifier = new QSocketNotifier(ring->eventFd(), QSocketNotifier::Read, q);
+    QObject::connect(ringNotifier, &QSocketNotifier::activated, q, [this] { reapIoUring(); });
+    backend = QAsyncFileIO::IoUringBackend;
+    return true;
+}
+
+void QAsyncFileIOPrivate::submitToIoUring()
+{
+    bool prepared = false;
+    while (!queued.isEmpty() && inFlight.size() < qsizetype(ring->capacity())) {
+        Request &request = queued.head();
+        const unsigned length =
+                unsigned(qMin(qint64(request.buffer.size()) - request.done, MaxChunkSize));
+        const qint64 offset = request.offset + request.done;
+        const bool ok = request.operation == Operation::Read
+                ? ring->prepareRead(request.id, request.fd, request.buffer.data() + request.done,
+                                    length, offset)
+                : ring->prepareWrite(request.id, request.fd,
+                                     request.buffer.constData() + request.done, length, offset);
+        if (!ok)
+            break;
+
+        // moving the request keeps the QByteArray's data where the kernel expects it
+        inFlight.insert(request.id, queued.dequeue());
+        prepared = true;
+    }
+
+    if (prepared && !ring->submit())
+        qErrnoWarning("QAsyncFileIO: Unable to submit requests to io_uring");
+}
+
+void QAsyncFileIOPrivate::reapIoUring()
+{
+    ring->drainEventFd();
+
+    QList<QIoUring::Completion> completions;
+    while (ring->reapCompletions(&completions)) {
+        for (const QIoUring::Completion &completion : qAsConst(completions)) {
+            auto it = inFlight.find(completion.userData);
+            if (it == inFlight.end())
+                continue;
+            Request request = std::move(it.value());
+            inFlight.erase(it);
+
+            if (completion.result < 0) {
+                finishRequest(request, -completion.result);
+                continue;
+            }
+
+            request.done += completion.result;
+            if (completion.result > 0 && request.done < request.buffer.size()) {
+                // short read or write, resubmit the rest before anything else
+                queued.prepend(std::move(request));
+                continue;
+            }
+            finishRequest(request, 0);
+        }
+        completions.clear();
+        submitToIoUring();
+    }
+}
+
+bool QAsyncFileIOPrivate::waitForIoUring(int msecs)
+{
+    QDeadlineTimer deadline(msecs);
+    for (;;) {
+        // completions may already be in the ring if the notifier drained the
+        // eventfd without us having looked at them yet
+        submitToIoUring();
+        reapIoUring();
+        if (!pending)
+            return true;
+
+        pollfd pfd = qt_make_pollfd(ring->eventFd(), POLLIN);
+        const int remaining = deadline.isForever() ? -1 : int(deadline.remainingTime());
+        if (qt_poll_msecs(&pfd, 1, remaining) == 0) {
+            reapIoUring();
+            return pending == 0;
+        }
+    }
+}
+
+QT_END_NAMESPACE
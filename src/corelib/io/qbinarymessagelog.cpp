@@ -0,0 +1,411 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qbinarymessagelog.h"
+
+#include "qdatetime.h"
+#include "qelapsedtimer.h"
+#include "qhash.h"
+#include "qiodevice.h"
+#include "qmutex.h"
+#include "qthread.h"
+#include <QtCore/private/qlocking_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QBinaryMessageLog
+    \inmodule QtCore
+    \since 6.4
+    \brief The QBinaryMessageLog class records log messages in a compact
+    binary form, to be formatted later.
+
+    Formatting a log message costs much more than capturing its arguments.
+    For high-volume tracing, where the messages are read by a tool rather than
+    by a person, QBinaryMessageLog skips the formatting. It writes each
+    message as a reference to its format string and call site, the time, the
+    thread, and the raw values of the arguments. The format string and the call
+    site are written once, the first time a call site records a message.
+
+    Messages are recorded with the qCRecord() macro, while a log is active:
+
+    \code
+    Q_LOGGING_CATEGORY(lcNetworkTrace, "app.network.trace")
+
+    QFile file("trace.qbml");
+    file.open(QIODevice::WriteOnly);
+    QBinaryMessageLog::start(&file);
+    ...
+    qCRecord(lcNetworkTrace, "received %1 bytes from %2", size, peer);
+    ...
+    QBinaryMessageLog::stop();
+    \endcode
+
+    Use decode(), or the \c qtlogdecode tool, to turn a log into text.
+
+    \sa QLoggingCategory, qSetMessagePattern()
+*/
+
+/*!
+    \macro qCRecord(category, format, ...)
+    \relates QBinaryMessageLog
+    \since 6.4
+
+    Records a message in the active QBinaryMessageLog, if there is one and
+    debug messages are enabled for \a category.
+
+    \a format is the message text, in which \c %1, \c %2, and so on are
+    replaced by the remaining arguments when the log is decoded, like
+    QString::arg() does. It must be a string literal or otherwise outlive the
+    recording of the message.
+
+    Booleans, integers, enumerations, floating point numbers, pointers and
+    strings are recorded as such. Values of other types are recorded as the
+    text their QDebug stream operator produces, so that recording them is not
+    cheaper than logging them.
+
+    The arguments are not evaluated if no log is active or the category is
+    disabled.
+*/
+
+namespace {
+enum RecordTag : char {
+    DefinitionTag = 'D',
+    MessageTag = 'M',
+};
+
+// "QBML" and the format version
+constexpr char Magic[] = { 'Q', 'B', 'M', 'L', 1 };
+
+// The log is buffered, and written to the device in chunks of this size.
+constexpr qsizetype ChunkSize = 64 * 1024;
+
+struct BinaryMessageLogState
+{
+    QBasicMutex mutex;
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    QElapsedTimer timer;
+    QHash<const QBinaryMessageLog::Site *, quint32> siteIds;
+
+    void appendVarint(quint64 v)
+    {
+        while (v >= 0x80) {
+            buffer.append(char(v | 0x80));
+            v >>= 7;
+        }
+        buffer.append(char(v));
+    }
+
+    void appendString(const char *s)
+    {
+        const qsizetype size = s ? qsizetype(qstrlen(s)) : 0;
+        appendVarint(quint64(size));
+        buffer.append(s, size);
+    }
+
+    void flush()
+    {
+        if (!buffer.isEmpty())
+            device->write(buffer);
+        buffer.clear();
+    }
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(BinaryMessageLogState, binaryMessageLogState)
+
+QBasicAtomicInt QBinaryMessageLog::active = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*!
+    Starts recording messages to \a device, which must be open for writing
+    and usable from all threads that record messages, like a QFile is. Stops
+    recording to the previous device, if any.
+
+    Returns \c false if \a device is not writable.
+*/
+bool QBinaryMessageLog::start(QIODevice *device)
+{
+    if (!device || !device->isWritable())
+        return false;
+
+    stop();
+    BinaryMessageLogState *state = binaryMessageLogState();
+    if (!state)
+        return false;
+
+    const auto locker = qt_scoped_lock(state->mutex);
+    state->device = device;
+    state->siteIds.clear();
+    state->buffer.reserve(ChunkSize);
+    state->buffer.append(Magic, sizeof(Magic));
+    char epoch[sizeof(qint64)];
+    qToLittleEndian(QDateTime::currentMSecsSinceEpoch(), epoch);
+    state->buffer.append(epoch, sizeof(epoch));
+    state->timer.start();
+    active.storeRelease(1);
+    return true;
+}
+
+/*!
+    Writes out the messages recorded so far and stops recording. The device
+    passed to start() is not closed.
+*/
+void QBinaryMessageLog::stop()
+{
+    if (!binaryMessageLogState.exists())
+        return;
+
+    BinaryMessageLogState *state = binaryMessageLogState();
+    const auto locker = qt_scoped_lock(state->mutex);
+    active.storeRelaxed(0);
+    if (state->device)
+        state->flush();
+    state->device = nullptr;
+}
+
+/*!
+    \fn bool QBinaryMessageLog::isActive()
+
+    Returns \c true while messages are being recorded.
+*/
+
+/*!
+    \internal
+
+    Appends the message to the log. \a arguments points to the \a count
+    encoded arguments, which take \a size bytes.
+*/
+void QBinaryMessageLog::write(const Site &site, const QLoggingCategory &category,
+                              const char *format, const char *arguments, qsizetype size, int count)
+{
+    const quintptr threadId = quintptr(QThread::currentThreadId());
+
+    BinaryMessageLogState *state = binaryMessageLogState();
+    if (!state)
+        return;
+    const auto locker = qt_scoped_lock(state->mutex);
+    if (!state->device)
+        return;
+
+    const qint64 nsecs = state->timer.nsecsElapsed();
+    quint32 &id = state->siteIds[&site];
+    if (id == 0) {
+        id = quint32(state->siteIds.size());
+        state->buffer.append(char(DefinitionTag));
+        state->appendVarint(id);
+        state->appendString(format);
+        state->appendString(category.categoryName());
+        state->appendString(site.file);
+        state->appendVarint(quint64(qMax(site.line, 0)));
+        state->appendString(site.function);
+    }
+
+    state->buffer.append(char(MessageTag));
+    state->appendVarint(id);
+    state->appendVarint(quint64(nsecs));
+    state->appendVarint(threadId);
+    state->appendVarint(quint64(count));
+    state->buffer.append(arguments, size);
+
+    if (state->buffer.size() >= ChunkSize)
+        state->flush();
+}
+
+namespace {
+class BinaryMessageLogReader
+{
+public:
+    explicit BinaryMessageLogReader(const QByteArray &data) : data(data) { }
+
+    bool atEnd() const { return pos >= data.size(); }
+    bool failed() const { return error; }
+
+    char readByte()
+    {
+        if (pos >= data.size()) {
+            error = true;
+            return 0;
+        }
+        return data.at(pos++);
+    }
+
+    quint64 readVarint()
+    {
+        quint64 v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uchar c = uchar(readByte());
+            v |= quint64(c & 0x7f) << shift;
+            if (!(c & 0x80))
+                return v;
+        }
+        error = true;
+        return v;
+    }
+
+    QByteArray readBytes(quint64 size)
+    {
+        if (size > quint64(data.size() - pos)) {
+            error = true;
+            return QByteArray();
+        }
+        const QByteArray bytes = data.mid(pos, qsizetype(size));
+        pos += qsizetype(size);
+        return bytes;
+    }
+
+    QString readArgument()
+    {
+        switch (readByte()) {
+        case QBinaryMessageLog::Bool:
+            return readByte() ? QStringLiteral("true") : QStringLiteral("false");
+        case QBinaryMessageLog::Int: {
+            const quint64 v = readVarint();
+            return QString::number(qint64(v >> 1) ^ -qint64(v & 1));
+        }
+        case QBinaryMessageLog::UInt:
+            return QString::number(readVarint());
+        case QBinaryMessageLog::Double: {
+            const QByteArray bytes = readBytes(sizeof(double));
+            if (error)
+                return QString();
+            return QString::number(qFromLittleEndian<double>(bytes.constData()), 'g', 17);
+        }
+        case QBinaryMessageLog::String:
+            return QString::fromUtf8(readBytes(readVarint()));
+        case QBinaryMessageLog::Pointer:
+            return QLatin1String("0x") + QString::number(readVarint(), 16);
+        }
+        error = true;
+        return QString();
+    }
+
+private:
+    QByteArray data;
+    qsizetype pos = 0;
+    bool error = false;
+};
+
+// Replaces %1, %2, ... like QString::arg() does, but in one pass
+QString formatRecordedMessage(const QString &format, const QStringList &arguments)
+{
+    QString result;
+    result.reserve(format.size());
+    for (qsizetype i = 0; i < format.size(); ++i) {
+        const QChar c = format.at(i);
+        qsizetype end = i + 1;
+        int n = 0;
+        while (c == QLatin1Char('%') && end < format.size() && end - i <= 2
+               && format.at(end).isDigit()) {
+            n = n * 10 + format.at(end).digitValue();
+            ++end;
+        }
+        if (n > 0 && n <= arguments.size()) {
+            result += arguments.at(n - 1);
+            i = end - 1;
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+} // unnamed namespace
+
+/*!
+    Reads the recorded messages from \a log and writes them to \a text, one
+    line per message, in the order they were recorded. Each line holds the
+    time since recording started in seconds, the category and the message.
+
+    Returns \c false if \a log is not a QBinaryMessageLog or is truncated; the
+    messages before the damage are written anyway.
+*/
+bool QBinaryMessageLog::decode(QIODevice *log, QIODevice *text)
+{
+    BinaryMessageLogReader reader(log->readAll());
+    if (reader.readBytes(sizeof(Magic)) != QByteArray::fromRawData(Magic, sizeof(Magic)))
+        return false;
+    reader.readBytes(sizeof(qint64));   // the start of the recording
+    if (reader.failed())
+        return false;
+
+    struct Definition
+    {
+        QString format;
+        QByteArray category;
+    };
+    QHash<quint64, Definition> definitions;
+
+    while (!reader.atEnd()) {
+        const char tag = reader.readByte();
+        if (tag == DefinitionTag) {
+            const quint64 id = reader.readVarint();
+            Definition &definition = definitions[id];
+            definition.format = QString::fromUtf8(reader.readBytes(reader.readVarint()));
+            definition.category = reader.readBytes(reader.readVarint());
+            reader.readBytes(reader.readVarint());  // file
+            reader.readVarint();                    // line
+            reader.readBytes(reader.readVarint());  // function
+        } else if (tag == MessageTag) {
+            const auto it = definitions.constFind(reader.readVarint());
+            const quint64 nsecs = reader.readVarint();
+            reader.readVarint();                    // thread
+            const quint64 count = reader.readVarint();
+            QStringList arguments;
+            for (quint64 i = 0; i < count && !reader.failed(); ++i)
+                arguments.append(reader.readArgument());
+            if (reader.failed() || it == definitions.constEnd())
+                return false;
+
+            QString line = QString::asprintf("%6llu.%06llu ", nsecs / 1000000000,
+                                             nsecs / 1000 % 1000000);
+            if (!it->category.isEmpty())
+                line += QString::fromUtf8(it->category) + QLatin1String(": ");
+            line += formatRecordedMessage(it->format, arguments);
+            line += QLatin1Char('\n');
+            text->write(line.toUtf8());
+        } else {
+            return false;
+        }
+        if (reader.failed())
+            return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
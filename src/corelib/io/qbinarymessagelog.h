@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBINARYMESSAGELOG_H
+#define QBINARYMESSAGELOG_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qdebug.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class Q_CORE_EXPORT QBinaryMessageLog
+{
+public:
+    // one per qCRecord() call site; only its address matters
+    struct Site
+    {
+        const char *file;
+        int line;
+        const char *function;
+    };
+
+    enum ArgumentType : quint8 {
+        Bool,
+        Int,
+        UInt,
+        Double,
+        String,
+        Pointer
+    };
+
+    static bool start(QIODevice *device);
+    static void stop();
+    static bool isActive() noexcept { return active.loadRelaxed(); }
+
+    static bool decode(QIODevice *log, QIODevice *text);
+
+    template <typename... Args>
+    static void record(const Site &site, const QLoggingCategory &category, const char *format,
+                       const Args &...args)
+    {
+        Encoder encoder;
+        (encoder.add(args), ...);
+        write(site, category, format, encoder.data.constData(), encoder.data.size(),
+              int(sizeof...(Args)));
+    }
+
+private:
+    class Encoder
+    {
+    public:
+        template <typename T>
+        void add(const T &value)
+        {
+            if constexpr (std::is_same_v<T, bool>) {
+                data.append(char(Bool));
+                data.append(char(value));
+            } else if constexpr (std::is_enum_v<T>) {
+                add(std::underlying_type_t<T>(value));
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                data.append(char(Int));
+                const quint64 v = quint64(qint64(value));
+                appendVarint(qint64(value) < 0 ? ~(v << 1) : v << 1);
+            } else if constexpr (std::is_integral_v<T>) {
+                data.append(char(UInt));
+                appendVarint(quint64(value));
+            } else if constexpr (std::is_floating_point_v<T>) {
+                data.append(char(Double));
+                char buf[sizeof(double)];
+                qToLittleEndian(double(value), buf);
+                data.append(buf, sizeof(buf));
+            } else if constexpr (std::is_same_v<T, QByteArray>) {
+                appendString(value.constData(), value.size());
+            } else if constexpr (std::is_convertible_v<const T &, const char *>) {
+                const char *s = value;
+                appendString(s, s ? qsizetype(qstrlen(s)) : 0);
+            } else if constexpr (std::is_same_v<T, QLatin1String>) {
+                add(QString(value));
+            } else if constexpr (std::is_convertible_v<const T &, QStringView>) {
+                const QByteArray utf8 = QStringView(value).toUtf8();
+                appendString(utf8.constData(), utf8.size());
+            } else if constexpr (std::is_pointer_v<T>) {
+                data.append(char(Pointer));
+                appendVarint(quintptr(value));
+            } else {
+                // anything else is recorded as its QDebug output
+                QString text;
+                QDebug(&text).nospace() << value;
+                add(text);
+            }
+        }
+
+        QVarLengthArray<char, 256> data;
+
+    private:
+        void appendVarint(quint64 v)
+        {
+            while (v >= 0x80) {
+                data.append(char(v | 0x80));
+                v >>= 7;
+            }
+            data.append(char(v));
+        }
+
+        void appendString(const char *s, qsizetype size)
+        {
+            data.append(char(String));
+            appendVarint(quint64(size));
+            data.append(s, size);
+        }
+    };
+
+    static void write(const Site &site, const QLoggingCategory &category, const char *format,
+                      const char *arguments, qsizetype size, int count);
+
+    static QBasicAtomicInt active;
+};
+
+#define qCRecord(category, ...) \
+    do { \
+        if (QBinaryMessageLog::isActive()) { \
+            const QLoggingCategory &qt_category = (category)(); \
+            if (qt_category.isDebugEnabled()) { \
+                static QBinaryMessageLog::Site qt_site = \
+                    { QT_MESSAGELOG_FILE, QT_MESSAGELOG_LINE, QT_MESSAGELOG_FUNC }; \
+                QBinaryMessageLog::record(qt_site, qt_category, __VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+QT_END_NAMESPACE
+
+#endif // QBINARYMESSAGELOG_H
@@ -0,0 +1,382 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qcompressiondevice.h"
+
+#include <QtCore/private/qiodevice_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QCompressionDevicePrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QCompressionDevice)
+
+public:
+    enum FillMode { UntilOutput, AllAvailable };
+
+    qsizetype pendingSize() const { return pending.size() - pendingOffset; }
+    void fill(FillMode mode);
+    bool writeToDevice(const QByteArray &data);
+
+    QIODevice *device = nullptr;
+    QCompressor::Algorithm algorithm = QCompressor::Deflate;
+    int level = -1;
+    int workerThreadCount = 0;
+
+    std::unique_ptr<QCompressor> compressor;
+    std::unique_ptr<QDecompressor> decompressor;
+
+    // decompressed data not yet read, from pendingOffset on
+    QByteArray pending;
+    qsizetype pendingOffset = 0;
+    QByteArray input;
+    bool deviceAtEnd = false;
+    QMetaObject::Connection readyReadConnection;
+};
+
+// compressed data is read from the device in blocks of this size
+static constexpr qsizetype InputChunkSize = 16 * 1024;
+
+void QCompressionDevicePrivate::fill(FillMode mode)
+{
+    Q_Q(QCompressionDevice);
+    if (pendingOffset == pending.size()) {
+        pending.clear();
+        pendingOffset = 0;
+    }
+
+    while (!deviceAtEnd && !decompressor->hasError()
+           && (mode == AllAvailable || pendingSize() == 0)) {
+        input.resize(InputChunkSize);
+        const qint64 read = device->read(input.data(), InputChunkSize);
+        if (read <= 0) {
+            // a sequential device may just not have received more data yet
+            if (read < 0 || !device->isSequential())
+                deviceAtEnd = true;
+            break;
+        }
+        pending += decompressor->decompress(QByteArrayView(input.constData(), read));
+    }
+
+    if (decompressor->hasError())
+        q->setErrorString(decompressor->errorString());
+    else if (deviceAtEnd && !decompressor->isFinished())
+        q->setErrorString(QCompressionDevice::tr("Unexpected end of compressed data"));
+}
+
+bool QCompressionDevicePrivate::writeToDevice(const QByteArray &data)
+{
+    Q_Q(QCompressionDevice);
+    if (compressor->hasError()) {
+        q->setErrorString(compressor->errorString());
+        return false;
+    }
+    if (!data.isEmpty() && device->write(data) != data.size()) {
+        q->setErrorString(device->errorString());
+        return false;
+    }
+    return true;
+}
+
+/*!
+    \class QCompressionDevice
+    \inmodule QtCore
+    \since 6.4
+    \reentrant
+    \brief The QCompressionDevice class compresses data written to another
+    device, or decompresses data read from it.
+
+    \ingroup io
+
+    QCompressionDevice wraps another QIODevice. Opened for writing, it
+    compresses the data written to it with QCompressor and writes the result
+    to the other device; opened for reading, it reads compressed data from the
+    other device and decompresses it with QDecompressor. It cannot be opened
+    for both at once.
+
+    \snippet code/src_corelib_io_qcompressor.cpp 2
+
+    The other device must already be open in the matching mode, and it is not
+    closed by close(). When writing, close() ends the compressed stream, so it
+    must be called before the other device is closed. flush() writes out all
+    compressed data buffered so far, for instance before waiting for a reply
+    over a socket.
+
+    When reading from a sequential device, such as a socket, the readyRead()
+    signal of that device is forwarded whenever it carries data that
+    decompresses to something. A read that reaches the end of the other
+    device before the end of the compressed stream sets an errorString().
+
+    \sa QCompressor, QDecompressor
+*/
+
+/*!
+    Constructs a QCompressionDevice that compresses data written to, or
+    decompresses data read from, \a device, using the format of \a algorithm.
+    \a parent is passed to the QObject constructor.
+*/
+QCompressionDevice::QCompressionDevice(QIODevice *device, QCompressor::Algorithm algorithm,
+                                       QObject *parent)
+    : QIODevice(*new QCompressionDevicePrivate, parent)
+{
+    Q_D(QCompressionDevice);
+    d->device = device;
+    d->algorithm = algorithm;
+}
+
+/*!
+    Destroys the QCompressionDevice, closing it first.
+
+    \sa close()
+*/
+QCompressionDevice::~QCompressionDevice()
+{
+    if (isOpen())
+        close();
+}
+
+/*!
+    Returns the device compressed data is written to or read from.
+*/
+QIODevice *QCompressionDevice::device() const
+{
+    Q_D(const QCompressionDevice);
+    return d->device;
+}
+
+/*!
+    Returns the format of the compressed data.
+*/
+QCompressor::Algorithm QCompressionDevice::algorithm() const
+{
+    Q_D(const QCompressionDevice);
+    return d->algorithm;
+}
+
+/*!
+    Sets the compression level used when writing to \a level. A negative
+    level, the default, selects the algorithm's default level. The level
+    applies from the next call to open().
+
+    \sa QCompressor::QCompressor()
+*/
+void QCompressionDevice::setCompressionLevel(int level)
+{
+    Q_D(QCompressionDevice);
+    d->level = level;
+}
+
+/*!
+    Returns the compression level used when writing.
+
+    \sa setCompressionLevel()
+*/
+int QCompressionDevice::compressionLevel() const
+{
+    Q_D(const QCompressionDevice);
+    return d->level;
+}
+
+/*!
+    Sets the number of threads compressing in the background when writing to
+    \a count. The count applies from the next call to open(), and is ignored
+    if the algorithm or the library does not support multi-threading.
+
+    \sa QCompressor::setWorkerThreadCount()
+*/
+void QCompressionDevice::setWorkerThreadCount(int count)
+{
+    Q_D(QCompressionDevice);
+    d->workerThreadCount = count;
+}
+
+/*!
+    Returns the number of threads compressing in the background when writing.
+
+    \sa setWorkerThreadCount()
+*/
+int QCompressionDevice::workerThreadCount() const
+{
+    Q_D(const QCompressionDevice);
+    return d->workerThreadCount;
+}
+
+/*!
+    \reimp
+
+    \a mode must be either QIODevice::ReadOnly or QIODevice::WriteOnly,
+    optionally combined with QIODevice::Unbuffered, and device() must be open
+    for reading or writing respectively.
+*/
+bool QCompressionDevice::open(OpenMode mode)
+{
+    Q_D(QCompressionDevice);
+    const OpenMode direction = mode & ReadWrite;
+    if ((mode & ~(ReadWrite | Unbuffered)) || (direction != ReadOnly && direction != WriteOnly)) {
+        qWarning("QCompressionDevice::open: Compression devices are either read or written");
+        return false;
+    }
+    if (!d->device || !(d->device->openMode() & direction)) {
+        setErrorString(tr("The underlying device is not open"));
+        return false;
+    }
+
+    if (direction == WriteOnly) {
+        d->compressor = std::make_unique<QCompressor>(d->algorithm, d->level);
+        if (d->workerThreadCount > 0)
+            d->compressor->setWorkerThreadCount(d->workerThreadCount);
+        if (d->compressor->hasError()) {
+            setErrorString(d->compressor->errorString());
+            d->compressor.reset();
+            return false;
+        }
+    } else {
+        d->decompressor = std::make_unique<QDecompressor>(d->algorithm);
+        if (d->decompressor->hasError()) {
+            setErrorString(d->decompressor->errorString());
+            d->decompressor.reset();
+            return false;
+        }
+        d->deviceAtEnd = false;
+        if (d->device->isSequential()) {
+            d->readyReadConnection = connect(d->device, &QIODevice::readyRead, this, [this] {
+                Q_D(QCompressionDevice);
+                const qsizetype available = d->pendingSize();
+                d->fill(QCompressionDevicePrivate::AllAvailable);
+                if (d->pendingSize() > available)
+                    emit readyRead();
+            });
+        }
+    }
+    return QIODevice::open(mode);
+}
+
+/*!
+    \reimp
+
+    When writing, ends the compressed stream and writes its remainder to
+    device(). device() itself stays open.
+*/
+void QCompressionDevice::close()
+{
+    Q_D(QCompressionDevice);
+    if (d->compressor && isOpen())
+        d->writeToDevice(d->compressor->finish());
+    QIODevice::close();
+
+    disconnect(d->readyReadConnection);
+    d->compressor.reset();
+    d->decompressor.reset();
+    d->pending.clear();
+    d->pendingOffset = 0;
+    d->input.clear();
+}
+
+/*!
+    \reimp
+
+    Compressed streams can only be read or written sequentially.
+*/
+bool QCompressionDevice::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressionDevice::bytesAvailable() const
+{
+    Q_D(const QCompressionDevice);
+    return QIODevice::bytesAvailable() + d->pendingSize();
+}
+
+/*!
+    Writes all data compressed so far to device(), so that it can be
+    decompressed without waiting for more. Returns \c true on success.
+
+    Flushing often degrades compression.
+
+    \sa QCompressor::flush()
+*/
+bool QCompressionDevice::flush()
+{
+    Q_D(QCompressionDevice);
+    if (!d->compressor || !isOpen())
+        return false;
+    return d->writeToDevice(d->compressor->flush());
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressionDevice::readData(char *data, qint64 maxlen)
+{
+    Q_D(QCompressionDevice);
+    if (!d->decompressor)
+        return -1;
+    if (d->pendingSize() == 0)
+        d->fill(QCompressionDevicePrivate::UntilOutput);
+
+    const qsizetype size = qsizetype(qMin(maxlen, qint64(d->pendingSize())));
+    if (size == 0)
+        return d->deviceAtEnd || d->decompressor->hasError() ? -1 : 0;
+    memcpy(data, d->pending.constData() + d->pendingOffset, size_t(size));
+    d->pendingOffset += size;
+    return size;
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressionDevice::writeData(const char *data, qint64 len)
+{
+    Q_D(QCompressionDevice);
+    if (!d->compressor)
+        return -1;
+    if (!d->writeToDevice(d->compressor->compress(QByteArrayView(data, len))))
+        return -1;
+    return len;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qcompressiondevice.cpp"
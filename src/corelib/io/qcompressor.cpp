@@ -0,0 +1,928 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qcompressor.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <private/qglobal_p.h>
+
+#include <zlib.h>
+
+#if QT_CONFIG(zstd)
+#  include <zstd.h>
+// streaming compression with parameters needs the advanced API of 1.4
+#  if ZSTD_VERSION_NUMBER >= 10400
+#    define QT_COMPRESSOR_ZSTD
+#  endif
+#endif
+
+#if QT_CONFIG(lz4)
+#  include <lz4frame.h>
+#endif
+
+#include <limits>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// output is produced into the QByteArray in steps of this size
+constexpr qsizetype OutputChunkSize = 16 * 1024;
+
+// zlib counts input in uInt, so larger views are fed in slices
+constexpr qsizetype MaxZlibSlice = qsizetype(std::numeric_limits<uInt>::max() / 2 + 1);
+
+#if QT_CONFIG(lz4)
+// LZ4F_HEADER_SIZE_MAX, which older versions of lz4frame.h do not define
+constexpr size_t Lz4HeaderSizeMax = 19;
+// LZ4HC_CLEVEL_MAX, from lz4hc.h
+constexpr int Lz4MaximumLevel = 12;
+// input is compressed in slices of this size, so that the worst-case output
+// buffer LZ4F_compressUpdate() requires stays small
+constexpr qsizetype Lz4InputSlice = 64 * 1024;
+#endif
+
+// Grows \a out by \a by bytes and returns a pointer to the new space; the
+// caller shrinks it again to what was actually produced.
+char *grow(QByteArray &out, qsizetype by)
+{
+    const qsizetype size = out.size();
+    out.resize(size + by);
+    return out.data() + size;
+}
+
+#if !defined(QT_COMPRESSOR_ZSTD) || !QT_CONFIG(lz4)
+QString unsupportedAlgorithm()
+{
+    return QCoreApplication::translate("QCompressor", "Unsupported compression algorithm");
+}
+#endif
+
+QString zlibError(const z_stream &stream, int code)
+{
+    if (stream.msg)
+        return QString::fromLatin1(stream.msg);
+    if (code == Z_MEM_ERROR)
+        return QCoreApplication::translate("QCompressor", "Out of memory");
+    return QCoreApplication::translate("QCompressor", "Invalid compressed data");
+}
+} // unnamed namespace
+
+class QCompressorPrivate
+{
+public:
+    enum Mode { Continue, Flush, Finish };
+
+    QCompressorPrivate(QCompressor::Algorithm algorithm, int level);
+    ~QCompressorPrivate();
+
+    QByteArray process(QByteArrayView data, Mode mode);
+    void processZlib(QByteArrayView data, Mode mode, QByteArray &out);
+#ifdef QT_COMPRESSOR_ZSTD
+    void processZstd(QByteArrayView data, Mode mode, QByteArray &out);
+#endif
+#if QT_CONFIG(lz4)
+    void processLz4(QByteArrayView data, Mode mode, QByteArray &out);
+#endif
+    void restart();
+
+    QCompressor::Algorithm algorithm;
+    int level;
+    int workerThreadCount = 0;
+    bool initialized = false;
+    bool finished = false;
+    QString errorString;
+
+    z_stream zlib;
+#ifdef QT_COMPRESSOR_ZSTD
+    ZSTD_CCtx *zstd = nullptr;
+#endif
+#if QT_CONFIG(lz4)
+    LZ4F_cctx *lz4 = nullptr;
+    LZ4F_preferences_t lz4Preferences;
+    bool lz4FrameStarted = false;
+#endif
+};
+
+QCompressorPrivate::QCompressorPrivate(QCompressor::Algorithm algorithm, int level)
+    : algorithm(algorithm)
+{
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip: {
+        this->level = level < 0 ? 6 : qMin(level, 9);
+        memset(&zlib, 0, sizeof(zlib));
+        // 16 more window bits select the gzip wrapper instead of the zlib one
+        const int windowBits = algorithm == QCompressor::GZip ? MAX_WBITS + 16 : MAX_WBITS;
+        const int ret = deflateInit2(&zlib, this->level, Z_DEFLATED, windowBits, 8,
+                                     Z_DEFAULT_STRATEGY);
+        if (ret != Z_OK) {
+            errorString = zlibError(zlib, ret);
+            return;
+        }
+        initialized = true;
+        break;
+    }
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        this->level = level < 0 ? ZSTD_CLEVEL_DEFAULT : qMin(level, ZSTD_maxCLevel());
+        zstd = ZSTD_createCCtx();
+        if (!zstd) {
+            errorString = QCoreApplication::translate("QCompressor", "Out of memory");
+            return;
+        }
+        ZSTD_CCtx_setParameter(zstd, ZSTD_c_compressionLevel, this->level);
+        initialized = true;
+        break;
+#else
+        this->level = level;
+        errorString = unsupportedAlgorithm();
+        return;
+#endif
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        // 0 is lz4's fast default; 3 and above select the high-compression mode
+        this->level = level < 0 ? 0 : qMin(level, Lz4MaximumLevel);
+        memset(&lz4Preferences, 0, sizeof(lz4Preferences));
+        lz4Preferences.compressionLevel = this->level;
+        if (LZ4F_isError(LZ4F_createCompressionContext(&lz4, LZ4F_VERSION))) {
+            lz4 = nullptr;
+            errorString = QCoreApplication::translate("QCompressor", "Out of memory");
+            return;
+        }
+        initialized = true;
+        break;
+#else
+        this->level = level;
+        errorString = unsupportedAlgorithm();
+        return;
+#endif
+    }
+}
+
+QCompressorPrivate::~QCompressorPrivate()
+{
+    if (!initialized)
+        return;
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip:
+        deflateEnd(&zlib);
+        break;
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        ZSTD_freeCCtx(zstd);
+#endif
+        break;
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        LZ4F_freeCompressionContext(lz4);
+#endif
+        break;
+    }
+}
+
+void QCompressorPrivate::restart()
+{
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip:
+        deflateReset(&zlib);
+        break;
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        ZSTD_CCtx_reset(zstd, ZSTD_reset_session_only);
+#endif
+        break;
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        // LZ4F_compressBegin() starts over, whatever state the context is in
+        lz4FrameStarted = false;
+#endif
+        break;
+    }
+    finished = false;
+}
+
+QByteArray QCompressorPrivate::process(QByteArrayView data, Mode mode)
+{
+    QByteArray out;
+    if (!errorString.isEmpty())
+        return out;
+    if (finished) {
+        // the previous stream was finished; this data starts another one
+        if (data.isEmpty())
+            return out;
+        restart();
+    }
+
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip:
+        processZlib(data, mode, out);
+        break;
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        processZstd(data, mode, out);
+#endif
+        break;
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        processLz4(data, mode, out);
+#endif
+        break;
+    }
+    if (mode == Finish)
+        finished = true;
+    return out;
+}
+
+void QCompressorPrivate::processZlib(QByteArrayView data, Mode mode, QByteArray &out)
+{
+    const int flush = mode == Finish ? Z_FINISH : mode == Flush ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+    do {
+        const QByteArrayView slice = data.first(qMin(data.size(), MaxZlibSlice));
+        data = data.sliced(slice.size());
+        const int sliceFlush = data.isEmpty() ? flush : Z_NO_FLUSH;
+
+        zlib.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(slice.data()));
+        zlib.avail_in = uInt(slice.size());
+        int ret;
+        do {
+            const qsizetype size = out.size();
+            zlib.next_out = reinterpret_cast<Bytef *>(grow(out, OutputChunkSize));
+            zlib.avail_out = uInt(OutputChunkSize);
+            ret = deflate(&zlib, sliceFlush);
+            out.resize(size + OutputChunkSize - qsizetype(zlib.avail_out));
+            if (ret == Z_STREAM_ERROR) {
+                errorString = zlibError(zlib, ret);
+                return;
+            }
+            // deflate() fills the whole buffer whenever it has more to write
+        } while (zlib.avail_out == 0);
+    } while (!data.isEmpty());
+}
+
+#ifdef QT_COMPRESSOR_ZSTD
+void QCompressorPrivate::processZstd(QByteArrayView data, Mode mode, QByteArray &out)
+{
+    const ZSTD_EndDirective directive = mode == Finish ? ZSTD_e_end
+                                      : mode == Flush ? ZSTD_e_flush
+                                                      : ZSTD_e_continue;
+    ZSTD_inBuffer input = { data.data(), size_t(data.size()), 0 };
+    for (;;) {
+        const qsizetype size = out.size();
+        ZSTD_outBuffer output = { grow(out, OutputChunkSize), size_t(OutputChunkSize), 0 };
+        const size_t ret = ZSTD_compressStream2(zstd, &output, &input, directive);
+        out.resize(size + qsizetype(output.pos));
+        if (ZSTD_isError(ret)) {
+            errorString = QString::fromLatin1(ZSTD_getErrorName(ret));
+            return;
+        }
+        // with e_continue zstd may keep data buffered; otherwise it returns
+        // the amount it still has to write
+        if (directive == ZSTD_e_continue ? input.pos == input.size : ret == 0)
+            break;
+    }
+}
+#endif
+
+#if QT_CONFIG(lz4)
+void QCompressorPrivate::processLz4(QByteArrayView data, Mode mode, QByteArray &out)
+{
+    auto check = [this, &out](qsizetype size, size_t ret) {
+        if (LZ4F_isError(ret)) {
+            out.resize(size);
+            errorString = QString::fromLatin1(LZ4F_getErrorName(ret));
+            return false;
+        }
+        out.resize(size + qsizetype(ret));
+        return true;
+    };
+
+    if (!lz4FrameStarted) {
+        const qsizetype size = out.size();
+        const size_t ret = LZ4F_compressBegin(lz4, grow(out, Lz4HeaderSizeMax), Lz4HeaderSizeMax,
+                                              &lz4Preferences);
+        if (!check(size, ret))
+            return;
+        lz4FrameStarted = true;
+    }
+
+    while (!data.isEmpty()) {
+        const QByteArrayView slice = data.first(qMin(data.size(), Lz4InputSlice));
+        data = data.sliced(slice.size());
+        const size_t bound = LZ4F_compressBound(size_t(slice.size()), &lz4Preferences);
+        const qsizetype size = out.size();
+        const size_t ret = LZ4F_compressUpdate(lz4, grow(out, qsizetype(bound)), bound,
+                                               slice.data(), size_t(slice.size()), nullptr);
+        if (!check(size, ret))
+            return;
+    }
+
+    if (mode != Continue) {
+        // a bound for no input covers flushing the buffered data and the footer
+        const size_t bound = LZ4F_compressBound(0, &lz4Preferences);
+        const qsizetype size = out.size();
+        char *buffer = grow(out, qsizetype(bound));
+        const size_t ret = mode == Finish ? LZ4F_compressEnd(lz4, buffer, bound, nullptr)
+                                          : LZ4F_flush(lz4, buffer, bound, nullptr);
+        if (!check(size, ret))
+            return;
+        if (mode == Finish)
+            lz4FrameStarted = false;
+    }
+}
+#endif
+
+/*!
+    \class QCompressor
+    \inmodule QtCore
+    \since 6.4
+    \reentrant
+    \brief The QCompressor class compresses a stream of data incrementally.
+
+    \ingroup io
+    \ingroup shared
+
+    QCompressor produces a compressed stream in one of the formats listed in
+    QCompressor::Algorithm from data handed to it in pieces. Unlike qCompress(),
+    neither the input nor the output has to be held in memory as a whole, and
+    the output is a standard stream that other tools and libraries can read.
+
+    \snippet code/src_corelib_io_qcompressor.cpp 0
+
+    compress() returns whatever compressed data is ready, which may be none at
+    all while the compressor collects enough input. flush() forces everything
+    compressed so far out, so that the receiver can decompress all of it, at
+    the cost of a slightly worse compression ratio. finish() ends the stream.
+    Compressing more data after finish() starts a new stream, which is
+    appended to the output as the formats allow.
+
+    Zstandard can compress on several threads; see setWorkerThreadCount().
+
+    Use QDecompressor to decompress the data again, or QCompressionDevice to
+    compress or decompress the data written to or read from a QIODevice.
+
+    \sa QDecompressor, QCompressionDevice, qCompress()
+*/
+
+/*!
+    \enum QCompressor::Algorithm
+
+    This enum describes the compressed formats supported. Deflate and GZip
+    are always available; the others depend on the libraries Qt was built
+    with. Use isSupported() to find out at runtime.
+
+    \value Deflate The zlib format (RFC 1950), as used by the \c deflate HTTP
+    content encoding. Levels range from 0 to 9.
+    \value GZip The gzip format (RFC 1952). Levels range from 0 to 9.
+    \value Zstandard The Zstandard format (RFC 8878). Levels range from 1 to
+    22; levels above 19 need a lot of memory to decompress.
+    \value Lz4 The LZ4 frame format. Level 0 selects the fast compressor,
+    levels 3 to 12 the high-compression one.
+*/
+
+/*!
+    Constructs a compressor producing data in the format of \a algorithm,
+    compressing at \a level. A negative level selects the algorithm's default,
+    and levels above the maximum are treated as the maximum.
+
+    If \a algorithm is not supported, hasError() returns \c true.
+
+    \sa isSupported()
+*/
+QCompressor::QCompressor(Algorithm algorithm, int level)
+    : d(new QCompressorPrivate(algorithm, level))
+{
+}
+
+/*!
+    Destroys the compressor. Data of an unfinished stream is discarded.
+*/
+QCompressor::~QCompressor()
+{
+    delete d;
+}
+
+/*!
+    Returns \c true if this build of Qt can compress and decompress data in
+    the format of \a algorithm.
+*/
+bool QCompressor::isSupported(Algorithm algorithm) noexcept
+{
+    switch (algorithm) {
+    case Deflate:
+    case GZip:
+        return true;
+    case Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    case Lz4:
+        return QT_CONFIG(lz4);
+    }
+    return false;
+}
+
+/*!
+    Returns the algorithm of the compressed stream.
+*/
+QCompressor::Algorithm QCompressor::algorithm() const noexcept
+{
+    return d->algorithm;
+}
+
+/*!
+    Returns the compression level in use, after the default level has been
+    resolved and the level has been limited to the algorithm's range.
+*/
+int QCompressor::level() const noexcept
+{
+    return d->level;
+}
+
+/*!
+    Sets the number of threads compressing in the background to \a count,
+    and returns \c true if that is possible. With a count of 0, the default,
+    all the work is done in the calling thread.
+
+    Only Zstandard compresses on several threads, and only if the zstd library
+    was built with multi-threading support. Worker threads pay off for large
+    amounts of data; compress() then returns before the data handed to it has
+    been compressed, and flush() and finish() wait for the workers.
+
+    The count applies from the start of the next stream, so set it before
+    compressing any data.
+*/
+bool QCompressor::setWorkerThreadCount(int count)
+{
+    if (count < 0 || !d->initialized)
+        return false;
+    if (d->algorithm != Zstandard)
+        return count == 0;
+#ifdef QT_COMPRESSOR_ZSTD
+    if (ZSTD_isError(ZSTD_CCtx_setParameter(d->zstd, ZSTD_c_nbWorkers, count)))
+        return false;
+    d->workerThreadCount = count;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*!
+    Returns the number of threads compressing in the background.
+
+    \sa setWorkerThreadCount()
+*/
+int QCompressor::workerThreadCount() const noexcept
+{
+    return d->workerThreadCount;
+}
+
+/*!
+    Compresses \a data and returns the compressed data ready so far. The
+    result can be empty, as the compressor buffers input to compress it
+    better.
+
+    \sa flush(), finish()
+*/
+QByteArray QCompressor::compress(QByteArrayView data)
+{
+    return d->process(data, QCompressorPrivate::Continue);
+}
+
+/*!
+    Returns all compressed data buffered by the compressor, so that it can be
+    decompressed completely on the receiving side without waiting for the end
+    of the stream. Flushing too often degrades compression.
+
+    \sa compress(), finish()
+*/
+QByteArray QCompressor::flush()
+{
+    return d->process({}, QCompressorPrivate::Flush);
+}
+
+/*!
+    Ends the compressed stream and returns the remaining compressed data,
+    including the format's trailer.
+
+    \sa compress(), reset()
+*/
+QByteArray QCompressor::finish()
+{
+    return d->process({}, QCompressorPrivate::Finish);
+}
+
+/*!
+    Discards the state of the current stream, and any error, so that the
+    next call to compress() starts a new stream.
+*/
+void QCompressor::reset()
+{
+    if (!d->initialized)
+        return;
+    d->restart();
+    d->errorString.clear();
+}
+
+/*!
+    Returns \c true if the algorithm is not supported or compression failed.
+    Once an error has occurred, all functions producing data return an empty
+    QByteArray until reset() is called.
+
+    \sa errorString()
+*/
+bool QCompressor::hasError() const noexcept
+{
+    return !d->errorString.isEmpty();
+}
+
+/*!
+    Returns a human-readable description of the error, if any.
+
+    \sa hasError()
+*/
+QString QCompressor::errorString() const
+{
+    return d->errorString;
+}
+
+class QDecompressorPrivate
+{
+public:
+    explicit QDecompressorPrivate(QCompressor::Algorithm algorithm);
+    ~QDecompressorPrivate();
+
+    QByteArray process(QByteArrayView data);
+    void processZlib(QByteArrayView data, QByteArray &out);
+#ifdef QT_COMPRESSOR_ZSTD
+    void processZstd(QByteArrayView data, QByteArray &out);
+#endif
+#if QT_CONFIG(lz4)
+    void processLz4(QByteArrayView data, QByteArray &out);
+#endif
+    void restart();
+
+    QCompressor::Algorithm algorithm;
+    bool initialized = false;
+    bool finished = false;
+    QString errorString;
+
+    z_stream zlib;
+#ifdef QT_COMPRESSOR_ZSTD
+    ZSTD_DStream *zstd = nullptr;
+#endif
+#if QT_CONFIG(lz4)
+    LZ4F_dctx *lz4 = nullptr;
+#endif
+};
+
+QDecompressorPrivate::QDecompressorPrivate(QCompressor::Algorithm algorithm)
+    : algorithm(algorithm)
+{
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip: {
+        memset(&zlib, 0, sizeof(zlib));
+        const int windowBits = algorithm == QCompressor::GZip ? MAX_WBITS + 16 : MAX_WBITS;
+        const int ret = inflateInit2(&zlib, windowBits);
+        if (ret != Z_OK) {
+            errorString = zlibError(zlib, ret);
+            return;
+        }
+        initialized = true;
+        break;
+    }
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        zstd = ZSTD_createDStream();
+        if (!zstd) {
+            errorString = QCoreApplication::translate("QCompressor", "Out of memory");
+            return;
+        }
+        ZSTD_initDStream(zstd);
+        initialized = true;
+#else
+        errorString = unsupportedAlgorithm();
+#endif
+        break;
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        if (LZ4F_isError(LZ4F_createDecompressionContext(&lz4, LZ4F_VERSION))) {
+            lz4 = nullptr;
+            errorString = QCoreApplication::translate("QCompressor", "Out of memory");
+            return;
+        }
+        initialized = true;
+#else
+        errorString = unsupportedAlgorithm();
+#endif
+        break;
+    }
+}
+
+QDecompressorPrivate::~QDecompressorPrivate()
+{
+    if (!initialized)
+        return;
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip:
+        inflateEnd(&zlib);
+        break;
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        ZSTD_freeDStream(zstd);
+#endif
+        break;
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        LZ4F_freeDecompressionContext(lz4);
+#endif
+        break;
+    }
+}
+
+void QDecompressorPrivate::restart()
+{
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip:
+        inflateReset(&zlib);
+        break;
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        ZSTD_initDStream(zstd);
+#endif
+        break;
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        LZ4F_resetDecompressionContext(lz4);
+#endif
+        break;
+    }
+    finished = false;
+}
+
+QByteArray QDecompressorPrivate::process(QByteArrayView data)
+{
+    QByteArray out;
+    if (!errorString.isEmpty() || data.isEmpty())
+        return out;
+
+    switch (algorithm) {
+    case QCompressor::Deflate:
+    case QCompressor::GZip:
+        processZlib(data, out);
+        break;
+    case QCompressor::Zstandard:
+#ifdef QT_COMPRESSOR_ZSTD
+        processZstd(data, out);
+#endif
+        break;
+    case QCompressor::Lz4:
+#if QT_CONFIG(lz4)
+        processLz4(data, out);
+#endif
+        break;
+    }
+    return out;
+}
+
+void QDecompressorPrivate::processZlib(QByteArrayView data, QByteArray &out)
+{
+    do {
+        const QByteArrayView slice = data.first(qMin(data.size(), MaxZlibSlice));
+        data = data.sliced(slice.size());
+
+        zlib.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(slice.data()));
+        zlib.avail_in = uInt(slice.size());
+        for (;;) {
+            if (finished) {
+                if (zlib.avail_in == 0)
+                    break;
+                if (algorithm != QCompressor::GZip) {
+                    // anything after the end of a zlib stream is not ours
+                    zlib.avail_in = 0;
+                    return;
+                }
+                // gzip files may consist of several members, one after the other
+                inflateReset(&zlib);
+                finished = false;
+            }
+
+            const qsizetype size = out.size();
+            zlib.next_out = reinterpret_cast<Bytef *>(grow(out, OutputChunkSize));
+            zlib.avail_out = uInt(OutputChunkSize);
+            const int ret = inflate(&zlib, Z_NO_FLUSH);
+            out.resize(size + OutputChunkSize - qsizetype(zlib.avail_out));
+            if (ret == Z_STREAM_END) {
+                finished = true;
+                continue;
+            }
+            // Z_BUF_ERROR only means that no progress was possible
+            if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                errorString = zlibError(zlib, ret);
+                return;
+            }
+            if (zlib.avail_out != 0)
+                break;
+        }
+    } while (!data.isEmpty());
+}
+
+#ifdef QT_COMPRESSOR_ZSTD
+void QDecompressorPrivate::processZstd(QByteArrayView data, QByteArray &out)
+{
+    ZSTD_inBuffer input = { data.data(), size_t(data.size()), 0 };
+    for (;;) {
+        const qsizetype size = out.size();
+        ZSTD_outBuffer output = { grow(out, OutputChunkSize), size_t(OutputChunkSize), 0 };
+        const size_t ret = ZSTD_decompressStream(zstd, &output, &input);
+        out.resize(size + qsizetype(output.pos));
+        if (ZSTD_isError(ret)) {
+            errorString = QString::fromLatin1(ZSTD_getErrorName(ret));
+            return;
+        }
+        // 0 means that a frame was completely decoded and written out
+        finished = ret == 0;
+        if (input.pos == input.size && output.pos < output.size)
+            break;
+    }
+}
+#endif
+
+#if QT_CONFIG(lz4)
+void QDecompressorPrivate::processLz4(QByteArrayView data, QByteArray &out)
+{
+    for (;;) {
+        const qsizetype size = out.size();
+        size_t outputSize = size_t(OutputChunkSize);
+        size_t inputSize = size_t(data.size());
+        const size_t ret = LZ4F_decompress(lz4, grow(out, OutputChunkSize), &outputSize,
+                                           data.data(), &inputSize, nullptr);
+        out.resize(size + qsizetype(outputSize));
+        if (LZ4F_isError(ret)) {
+            errorString = QString::fromLatin1(LZ4F_getErrorName(ret));
+            return;
+        }
+        data = data.sliced(qsizetype(inputSize));
+        // 0 means that a frame was completely decoded and written out
+        finished = ret == 0;
+        if (data.isEmpty() && outputSize < size_t(OutputChunkSize))
+            break;
+    }
+}
+#endif
+
+/*!
+    \class QDecompressor
+    \inmodule QtCore
+    \since 6.4
+    \reentrant
+    \brief The QDecompressor class decompresses a stream of data incrementally.
+
+    \ingroup io
+
+    QDecompressor decompresses data in one of the formats of
+    QCompressor::Algorithm, as it arrives in pieces of any size:
+
+    \snippet code/src_corelib_io_qcompressor.cpp 1
+
+    isFinished() tells whether the end of the compressed stream has been
+    reached. Several streams may follow each other in the data, as
+    QCompressor produces them when compressing after finish(); they are
+    decompressed one after the other, except in the Deflate format, where data
+    following the end of the stream is ignored.
+
+    \sa QCompressor, QCompressionDevice, qUncompress()
+*/
+
+/*!
+    Constructs a decompressor for data in the format of \a algorithm.
+
+    If \a algorithm is not supported, hasError() returns \c true.
+
+    \sa QCompressor::isSupported()
+*/
+QDecompressor::QDecompressor(QCompressor::Algorithm algorithm)
+    : d(new QDecompressorPrivate(algorithm))
+{
+}
+
+/*!
+    Destroys the decompressor.
+*/
+QDecompressor::~QDecompressor()
+{
+    delete d;
+}
+
+/*!
+    Returns the format of the compressed stream.
+*/
+QCompressor::Algorithm QDecompressor::algorithm() const noexcept
+{
+    return d->algorithm;
+}
+
+/*!
+    Decompresses \a data and returns the decompressed data ready so far.
+
+    If \a data is not valid compressed data, hasError() returns \c true
+    afterwards, and the result holds what could be decompressed before the
+    error was detected.
+*/
+QByteArray QDecompressor::decompress(QByteArrayView data)
+{
+    return d->process(data);
+}
+
+/*!
+    Returns \c true if the data passed to decompress() so far ends with the
+    end of a compressed stream. A stream that breaks off before its end has
+    been truncated.
+*/
+bool QDecompressor::isFinished() const noexcept
+{
+    return d->finished;
+}
+
+/*!
+    Discards the state of the current stream, and any error, so that the
+    next call to decompress() expects the start of a new stream.
+*/
+void QDecompressor::reset()
+{
+    if (!d->initialized)
+        return;
+    d->restart();
+    d->errorString.clear();
+}
+
+/*!
+    Returns \c true if the algorithm is not supported or the data is not
+    valid compressed data. Once an error has occurred, decompress() returns
+    an empty QByteArray until reset() is called.
+
+    \sa errorString()
+*/
+bool QDecompressor::hasError() const noexcept
+{
+    return !d->errorString.isEmpty();
+}
+
+/*!
+    Returns a human-readable description of the error, if any.
+
+    \sa hasError()
+*/
+QString QDecompressor::errorString() const
+{
+    return d->errorString;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qcompressor.cpp"
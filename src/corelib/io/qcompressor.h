@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCOMPRESSOR_H
+#define QCOMPRESSOR_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QCompressorPrivate;
+class QDecompressorPrivate;
+
+class Q_CORE_EXPORT QCompressor
+{
+    Q_GADGET
+public:
+    enum Algorithm {
+        Deflate,
+        GZip,
+        Zstandard,
+        Lz4
+    };
+    Q_ENUM(Algorithm)
+
+    explicit QCompressor(Algorithm algorithm, int level = -1);
+    ~QCompressor();
+
+    static bool isSupported(Algorithm algorithm) noexcept;
+
+    Algorithm algorithm() const noexcept;
+    int level() const noexcept;
+
+    bool setWorkerThreadCount(int count);
+    int workerThreadCount() const noexcept;
+
+    QByteArray compress(QByteArrayView data);
+    QByteArray flush();
+    QByteArray finish();
+    void reset();
+
+    bool hasError() const noexcept;
+    QString errorString() const;
+
+private:
+    Q_DISABLE_COPY(QCompressor)
+    QCompressorPrivate *d;
+};
+
+class Q_CORE_EXPORT QDecompressor
+{
+public:
+    explicit QDecompressor(QCompressor::Algorithm algorithm);
+    ~QDecompressor();
+
+    QCompressor::Algorithm algorithm() const noexcept;
+
+    QByteArray decompress(QByteArrayView data);
+    bool isFinished() const noexcept;
+    void reset();
+
+    bool hasError() const noexcept;
+    QString errorString() const;
+
+private:
+    Q_DISABLE_COPY(QDecompressor)
+    QDecompressorPrivate *d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCOMPRESSOR_H
@@ -90,82 +90,29 @@
 */
 
 #include "qdiriterator.h"
+#include "qdiriterator_p.h"
 #include "qdir_p.h"
-#include "qabstractfileengine_p.h"
 
 #include <QtCore/qset.h>
-#include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
-#if QT_CONFIG(regularexpression)
-#include <QtCore/qregularexpression.h>
-#endif
 
-#include <QtCore/private/qfilesystemiterator_p.h>
-#include <QtCore/private/qfilesystementry_p.h>
 #include <QtCore/private/qfilesystemmetadata_p.h>
 #include <QtCore/private/qfilesystemengine_p.h>
 #include <QtCore/private/qfileinfo_p.h>
-#include <QtCore/private/qduplicatetracker_p.h>
-
-#include <memory>
 
 QT_BEGIN_NAMESPACE
 
-template <class Iterator>
-class QDirIteratorPrivateIteratorStack : public QStack<Iterator *>
-{
-public:
-    ~QDirIteratorPrivateIteratorStack()
-    {
-        qDeleteAll(*this);
-    }
-};
-
-class QDirIteratorPrivate
-{
-public:
-    QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                        QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine = true);
-
-    void advance();
-
-    bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
-    void pushDirectory(const QFileInfo &fileInfo);
-    void checkAndPushDirectory(const QFileInfo &);
-    bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
-
-    std::unique_ptr<QAbstractFileEngine> engine;
-
-    QFileSystemEntry dirEntry;
-    const QStringList nameFilters;
-    const QDir::Filters filters;
-    const QDirIterator::IteratorFlags iteratorFlags;
-
-#if QT_CONFIG(regularexpression)
-    QList<QRegularExpression> nameRegExps;
-#endif
-
-    QDirIteratorPrivateIteratorStack<QAbstractFileEngineIterator> fileEngineIterators;
-#ifndef QT_NO_FILESYSTEMITERATOR
-    QDirIteratorPrivateIteratorStack<QFileSystemIterator> nativeIterators;
-#endif
-
-    QFileInfo currentFileInfo;
-    QFileInfo nextFileInfo;
-
-    // Loop protection
-    QDuplicateTracker<QString> visitedLinks;
-};
-
 /*!
     \internal
 */
 QDirIteratorPrivate::QDirIteratorPrivate(const QFileSystemEntry &entry, const QStringList &nameFilters,
-                                         QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine)
+                                         QDir::Filters _filters, QDirIterator::IteratorFlags flags, bool resolveEngine,
+                                         SubdirectoryHandler subdirectoryHandler)
     : dirEntry(entry)
       , nameFilters(nameFilters.contains(QLatin1String("*")) ? QStringList() : nameFilters)
       , filters(QDir::NoFilter == _filters ? QDir::AllEntries : _filters)
       , iteratorFlags(flags)
+      , subdirectoryHandler(std::move(subdirectoryHandler))
 {
 #if QT_CONFIG(regularexpression)
     nameRegExps.reserve(nameFilters.size());
@@ -197,7 +144,7 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
         path = fileInfo.canonicalFilePath();
 #endif
 
-    if ((iteratorFlags & QDirIterator::FollowSymlinks)) {
+    if ((iteratorFlags & QDirIterator::FollowSymlinks) && !subdirectoryHandler) {
         // Stop link loops
         if (visitedLinks.hasSeen(fileInfo.canonicalFilePath()))
             return;
@@ -238,6 +185,20 @@ inline bool QDirIteratorPrivate::entryMatches(const QString & fileName, const QF
     return false;
 }
 
+/*!
+    \internal
+*/
+bool QDirIteratorPrivate::hasNext() const
+{
+    if (engine)
+        return !fileEngineIterators.isEmpty();
+#ifndef QT_NO_FILESYSTEMITERATOR
+    return !nativeIterators.isEmpty();
+#else
+    return false;
+#endif
+}
+
 /*!
     \internal
 */
@@ -308,7 +269,10 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
     if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && fileInfo.isHidden())
         return;
 
-    pushDirectory(fileInfo);
+    if (subdirectoryHandler)
+        subdirectoryHandler(fileInfo);
+    else
+        pushDirectory(fileInfo);
 }
 
 /*!
@@ -531,14 +495,7 @@ QFileInfo QDirIterator::nextFileInfo()
 */
 bool QDirIterator::hasNext() const
 {
-    if (d->engine)
-        return !d->fileEngineIterators.isEmpty();
-    else
-#ifndef QT_NO_FILESYSTEMITERATOR
-        return !d->nativeIterators.isEmpty();
-#else
-        return false;
-#endif
+    return d->hasNext();
 }
 
 /*!
@@ -0,0 +1,388 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qfilerecordreader.h"
+
+#include <QtCore/qfile.h>
+
+#if defined(Q_OS_UNIX) && !defined(Q_OS_INTEGRITY)
+#  include <sys/mman.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QFileRecordReaderPrivate
+{
+public:
+    explicit QFileRecordReaderPrivate(const QString &fileName, char delimiter)
+        : file(fileName), delimiter(delimiter)
+    {}
+
+    void advise(QFileRecordReader::AccessPattern pattern);
+
+    QFile file;
+    QByteArrayView mapped;
+    QFileDevice::FileError error = QFileDevice::NoError;
+    QString errorString;
+    char delimiter;
+    bool open = false;
+};
+
+void QFileRecordReaderPrivate::advise(QFileRecordReader::AccessPattern pattern)
+{
+#if defined(Q_OS_UNIX) && !defined(Q_OS_INTEGRITY) && defined(MADV_SEQUENTIAL)
+    // the mapping starts at file offset 0, so it is page-aligned
+    void *address = const_cast<char *>(mapped.data());
+    const size_t size = size_t(mapped.size());
+    if (pattern == QFileRecordReader::SequentialAccess) {
+        madvise(address, size, MADV_SEQUENTIAL);
+#  ifdef MADV_WILLNEED
+        madvise(address, size, MADV_WILLNEED);
+#  endif
+    } else {
+        madvise(address, size, MADV_RANDOM);
+    }
+#else
+    Q_UNUSED(pattern);
+#endif
+}
+
+/*!
+    \class QFileRecordReader
+    \inmodule QtCore
+    \since 6.4
+    \reentrant
+    \brief The QFileRecordReader class iterates over the lines or records of a
+    file without copying them.
+
+    \ingroup io
+
+    QFileRecordReader maps a file into memory with QFile::map() and presents
+    it as a sequence of QByteArrayView records separated by a delimiter
+    character, which is \c{'\n'} by default. Unlike QFile::readLine() or
+    QTextStream::readLine(), no memory is allocated per record and no data is
+    copied through QIODevice buffers:
+
+    \snippet code/src_corelib_io_qfilerecordreader.cpp 0
+
+    Each record excludes its delimiter. A delimiter at the very end of the file
+    does not start another, empty, record. When reading text files with
+    Windows line endings, each line keeps its trailing \c{'\r'}; use
+    QByteArrayView::chopped() or trimmed() as required.
+
+    The views returned remain valid until close() is called or the reader is
+    destroyed. Any concurrent modification of the file by other processes is
+    visible through them, and truncating the file while it is mapped may
+    cause the process to be terminated by the operating system.
+
+    \section1 Processing in Parallel
+
+    chunks() splits the mapped data into contiguous parts whose boundaries fall
+    just after a delimiter, so that no record spans two chunks. Each chunk can
+    be iterated with QFileRecordReader::Records independently of the others,
+    for instance from QtConcurrent:
+
+    \snippet code/src_corelib_io_qfilerecordreader.cpp 1
+
+    \sa QFile::map(), QByteArrayView
+*/
+
+/*!
+    \enum QFileRecordReader::AccessPattern
+
+    This enum is passed to open() to tell the operating system how the mapped
+    data is going to be read. It only affects performance.
+
+    \value SequentialAccess The data is read from start to end. On Unix
+    systems, the mapping is advised with \c MADV_SEQUENTIAL and
+    \c MADV_WILLNEED, so that pages are read ahead aggressively and released
+    soon after use.
+    \value RandomAccess The data is read in no particular order, for example
+    by several threads processing separate chunks(). Read-ahead is disabled
+    on Unix systems.
+*/
+
+/*!
+    \class QFileRecordReader::Records
+    \inmodule QtCore
+    \since 6.4
+    \brief The Records class is a range of the records in a block of data.
+
+    Records splits a QByteArrayView on a delimiter character lazily, as it is
+    iterated. It does not own the data.
+
+    \sa QFileRecordReader::chunks()
+*/
+
+/*!
+    \fn QFileRecordReader::Records::Records(QByteArrayView data, char delimiter)
+
+    Constructs a range over the records of \a data, separated by \a delimiter.
+*/
+
+/*!
+    \fn QFileRecordReader::const_iterator QFileRecordReader::Records::begin() const
+    \fn QFileRecordReader::const_iterator QFileRecordReader::Records::cbegin() const
+
+    Returns an iterator to the first record in the range.
+*/
+
+/*!
+    \fn QFileRecordReader::const_iterator QFileRecordReader::Records::end() const
+    \fn QFileRecordReader::const_iterator QFileRecordReader::Records::cend() const
+
+    Returns an iterator past the last record in the range.
+*/
+
+/*!
+    \fn QByteArrayView QFileRecordReader::Records::data() const
+
+    Returns the data this range splits.
+*/
+
+/*!
+    \fn char QFileRecordReader::Records::delimiter() const
+
+    Returns the character that separates records in this range.
+*/
+
+/*!
+    \class QFileRecordReader::const_iterator
+    \inmodule QtCore
+    \since 6.4
+    \brief The const_iterator class is a forward iterator over records.
+
+    Dereferencing the iterator yields the current record as a QByteArrayView,
+    without its delimiter.
+*/
+
+/*!
+    Constructs a reader for the file \a fileName, with records separated by
+    \a delimiter. The file is not opened until open() is called.
+*/
+QFileRecordReader::QFileRecordReader(const QString &fileName, char delimiter)
+    : d(new QFileRecordReaderPrivate(fileName, delimiter))
+{
+}
+
+/*!
+    Destroys the reader, unmapping and closing the file.
+*/
+QFileRecordReader::~QFileRecordReader()
+{
+    close();
+}
+
+/*!
+    Returns the name of the file read.
+*/
+QString QFileRecordReader::fileName() const
+{
+    return d->file.fileName();
+}
+
+/*!
+    Returns the character that separates records.
+
+    \sa setDelimiter()
+*/
+char QFileRecordReader::delimiter() const noexcept
+{
+    return d->delimiter;
+}
+
+/*!
+    Sets the character that separates records to \a delimiter. This affects
+    iterators obtained afterwards, and chunks() computed afterwards.
+
+    \sa delimiter()
+*/
+void QFileRecordReader::setDelimiter(char delimiter) noexcept
+{
+    d->delimiter = delimiter;
+}
+
+/*!
+    Opens and maps the file, advising the operating system that it is going to
+    be read according to \a pattern. Returns \c true on success; otherwise
+    sets error() and returns \c false.
+
+    An empty file is opened successfully and has no records.
+*/
+bool QFileRecordReader::open(AccessPattern pattern)
+{
+    close();
+    d->error = QFileDevice::NoError;
+    d->errorString.clear();
+
+    auto fail = [this] {
+        d->error = d->file.error();
+        d->errorString = d->file.errorString();
+        d->file.close();
+        return false;
+    };
+
+    if (!d->file.open(QIODevice::ReadOnly))
+        return fail();
+
+    const qint64 size = d->file.size();
+    if (size > 0) {
+        if (qint64(qsizetype(size)) != size) {
+            d->error = QFileDevice::ResourceError;
+            d->errorString = QFile::tr("File too large to map");
+            d->file.close();
+            return false;
+        }
+        const uchar *address = d->file.map(0, size);
+        if (!address)
+            return fail();
+        d->mapped = QByteArrayView(address, qsizetype(size));
+        d->advise(pattern);
+    }
+    d->open = true;
+    return true;
+}
+
+/*!
+    Returns \c true if the file has been opened and mapped.
+*/
+bool QFileRecordReader::isOpen() const noexcept
+{
+    return d->open;
+}
+
+/*!
+    Unmaps and closes the file. Views previously returned by the reader become
+    dangling.
+*/
+void QFileRecordReader::close()
+{
+    if (!d->mapped.isNull())
+        d->file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(d->mapped.data())));
+    d->mapped = QByteArrayView();
+    d->file.close();
+    d->open = false;
+}
+
+/*!
+    Returns the whole contents of the file, or a null view if it is not open.
+*/
+QByteArrayView QFileRecordReader::data() const noexcept
+{
+    return d->mapped;
+}
+
+/*!
+    Returns a range over all records of the file.
+
+    \sa begin(), end()
+*/
+QFileRecordReader::Records QFileRecordReader::records() const noexcept
+{
+    return Records(d->mapped, d->delimiter);
+}
+
+/*!
+    \fn QFileRecordReader::const_iterator QFileRecordReader::begin() const
+
+    Returns an iterator to the first record of the file.
+*/
+
+/*!
+    \fn QFileRecordReader::const_iterator QFileRecordReader::end() const
+
+    Returns an iterator past the last record of the file.
+*/
+
+/*!
+    Splits the data into at most \a count contiguous chunks of roughly equal
+    size, each ending just after a delimiter (or at the end of the file). No
+    record spans two chunks, so each chunk can be processed on its own by
+    iterating QFileRecordReader::Records over it.
+
+    Fewer chunks are returned if the data holds fewer records than \a count,
+    or if some records are longer than the chunk size. Returns an empty list
+    if the file is empty or not open.
+*/
+QList<QByteArrayView> QFileRecordReader::chunks(qsizetype count) const
+{
+    QList<QByteArrayView> result;
+    const QByteArrayView data = d->mapped;
+    if (data.isEmpty() || count < 1)
+        return result;
+
+    result.reserve(count);
+    const qsizetype target = (data.size() + count - 1) / count;
+    qsizetype from = 0;
+    while (from < data.size()) {
+        qsizetype to = from + target;
+        if (to >= data.size()) {
+            to = data.size();
+        } else {
+            // include the delimiter the split point falls on, or the next one
+            const qsizetype delimiterAt = data.indexOf(d->delimiter, to - 1);
+            to = delimiterAt < 0 ? data.size() : delimiterAt + 1;
+        }
+        result.append(data.sliced(from, to - from));
+        from = to;
+    }
+    return result;
+}
+
+/*!
+    Returns the error of the last open() call.
+
+    \sa errorString()
+*/
+QFileDevice::FileError QFileRecordReader::error() const noexcept
+{
+    return d->error;
+}
+
+/*!
+    Returns a human-readable description of the last error of open().
+
+    \sa error()
+*/
+QString QFileRecordReader::errorString() const
+{
+    return d->errorString;
+}
+
+QT_END_NAMESPACE
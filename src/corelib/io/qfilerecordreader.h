@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFILERECORDREADER_H
+#define QFILERECORDREADER_H
+
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qfiledevice.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+class QFileRecordReaderPrivate;
+
+class Q_CORE_EXPORT QFileRecordReader
+{
+    Q_DISABLE_COPY(QFileRecordReader)
+public:
+    class Records;
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = QByteArrayView;
+        using difference_type = qsizetype;
+        using pointer = const QByteArrayView *;
+        using reference = const QByteArrayView &;
+
+        constexpr const_iterator() noexcept = default;
+
+        reference operator*() const noexcept { return record; }
+        pointer operator->() const noexcept { return &record; }
+
+        const_iterator &operator++() noexcept
+        {
+            advance();
+            return *this;
+        }
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator copy = *this;
+            advance();
+            return copy;
+        }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return lhs.record.data() == rhs.record.data(); }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return !(lhs == rhs); }
+
+    private:
+        friend class Records;
+
+        constexpr const_iterator(const char *begin, const char *end, char delimiter) noexcept
+            : end(end), delimiter(delimiter)
+        { find(begin); }
+
+        constexpr void advance() noexcept
+        {
+            const char *next = record.data() + record.size();
+            // step over the delimiter, unless this was an unterminated last record
+            find(next == end ? end : next + 1);
+        }
+
+        constexpr void find(const char *from) noexcept
+        {
+            if (from == end) {
+                record = QByteArrayView(end, qsizetype(0));
+                return;
+            }
+            const char *it = from;
+            while (it != end && *it != delimiter)
+                ++it;
+            record = QByteArrayView(from, it - from);
+        }
+
+        QByteArrayView record;
+        const char *end = nullptr;
+        char delimiter = '\n';
+    };
+
+    class Records
+    {
+    public:
+        constexpr Records(QByteArrayView data, char delimiter = '\n') noexcept
+            : m_data(data), m_delimiter(delimiter)
+        {}
+
+        constexpr const_iterator begin() const noexcept
+        { return const_iterator(m_data.data(), m_data.data() + m_data.size(), m_delimiter); }
+        constexpr const_iterator end() const noexcept
+        { return const_iterator(m_data.data() + m_data.size(), m_data.data() + m_data.size(),
+                                m_delimiter); }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+        constexpr const_iterator cend() const noexcept { return end(); }
+
+        constexpr QByteArrayView data() const noexcept { return m_data; }
+        constexpr char delimiter() const noexcept { return m_delimiter; }
+
+    private:
+        QByteArrayView m_data;
+        char m_delimiter;
+    };
+
+    enum AccessPattern {
+        SequentialAccess,
+        RandomAccess
+    };
+
+    explicit QFileRecordReader(const QString &fileName, char delimiter = '\n');
+    ~QFileRecordReader();
+
+    QString fileName() const;
+
+    char delimiter() const noexcept;
+    void setDelimiter(char delimiter) noexcept;
+
+    bool open(AccessPattern pattern = SequentialAccess);
+    bool isOpen() const noexcept;
+    void close();
+
+    QByteArrayView data() const noexcept;
+    Records records() const noexcept;
+    const_iterator begin() const noexcept { return records().begin(); }
+    const_iterator end() const noexcept { return records().end(); }
+
+    QList<QByteArrayView> chunks(qsizetype count) const;
+
+    QFileDevice::FileError error() const noexcept;
+    QString errorString() const;
+
+private:
+    QScopedPointer<QFileRecordReaderPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QFILERECORDREADER_H
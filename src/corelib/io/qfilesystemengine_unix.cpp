@@ -615,6 +615,14 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
 #else
     Q_UNUSED(entry);
 #endif
+
+#ifndef UF_HIDDEN
+    // Without st_flags, hidden only depends on the name, so we can tell
+    // right away and spare directory iterators a lookup for each entry.
+    if (entry.d_name[0] == '.')
+        entryFlags |= QFileSystemMetaData::HiddenAttribute;
+    knownFlagsMask |= QFileSystemMetaData::HiddenAttribute;
+#endif
 }
 
 //static
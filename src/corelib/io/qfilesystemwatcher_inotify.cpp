@@ -45,8 +45,8 @@
 
 #include <qdebug.h>
 #include <qfile.h>
-#include <qfileinfo.h>
 #include <qscopeguard.h>
+#include <qset.h>
 #include <qsocketnotifier.h>
 #include <qvarlengtharray.h>
 
@@ -211,6 +211,8 @@ struct inotify_event {
 
 #define IN_CLOSE                (IN_CLOSE_WRITE | IN_CLOSE_NOWRITE)
 #define IN_MOVE                 (IN_MOVED_FROM | IN_MOVED_TO)
+
+#define IN_ONLYDIR              0x01000000
 }
 
 QT_END_NAMESPACE
@@ -269,37 +271,44 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
                                                       QStringList *files,
                                                       QStringList *directories)
 {
+    enum : uint32_t {
+        DirectoryMask = IN_ATTRIB | IN_MOVE | IN_CREATE | IN_DELETE | IN_DELETE_SELF,
+        FileMask = IN_ATTRIB | IN_MODIFY | IN_MOVE | IN_MOVE_SELF | IN_DELETE_SELF,
+    };
+
+    pathToID.reserve(pathToID.size() + paths.size());
+    idToPath.reserve(idToPath.size() + paths.size());
+
     QStringList unhandled;
-    for (const QString &path : paths) {
-        QFileInfo fi(path);
-        bool isDir = fi.isDir();
+    for (qsizetype i = 0; i < paths.size(); ++i) {
+        const QString &path = paths.at(i);
         auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
-        if (isDir) {
-            if (directories->contains(path))
-                continue;
-        } else {
-            if (files->contains(path))
-                continue;
-        }
 
-        int wd = inotify_add_watch(inotifyFd,
-                                   QFile::encodeName(path),
-                                   (isDir
-                                    ? (0
-                                       | IN_ATTRIB
-                                       | IN_MOVE
-                                       | IN_CREATE
-                                       | IN_DELETE
-                                       | IN_DELETE_SELF
-                                       )
-                                    : (0
-                                       | IN_ATTRIB
-                                       | IN_MODIFY
-                                       | IN_MOVE
-                                       | IN_MOVE_SELF
-                                       | IN_DELETE_SELF
-                                       )));
+        // A path is watched at most once, as either a file or a directory.
+        // The hash lookup replaces a linear search of the watched lists,
+        // which made adding many paths quadratic.
+        if (pathToID.contains(path))
+            continue;
+
+        // Let the kernel tell directories from files instead of calling
+        // stat() first: IN_ONLYDIR fails with ENOTDIR for anything else.
+        const QByteArray encodedPath = QFile::encodeName(path);
+        bool isDir = true;
+        int wd = inotify_add_watch(inotifyFd, encodedPath, DirectoryMask | IN_ONLYDIR);
+        if (wd < 0 && errno == ENOTDIR) {
+            isDir = false;
+            wd = inotify_add_watch(inotifyFd, encodedPath, FileMask);
+        }
         if (wd < 0) {
+            if (errno == ENOSPC) {
+                // The watch limit (fs.inotify.max_user_watches) is reached,
+                // and all remaining paths would fail the same way.
+                qErrnoWarning("inotify_add_watch(%ls) failed; %lld paths are not watched:",
+                              path.constData(), qlonglong(paths.size() - i));
+                sg.dismiss();
+                unhandled += paths.mid(i);
+                break;
+            }
             if (errno != ENOENT)
                 qErrnoWarning("inotify_add_watch(%ls) failed:", path.constData());
             continue;
@@ -326,6 +335,8 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
                                                          QStringList *directories)
 {
     QStringList unhandled;
+    QSet<QString> removedFiles;
+    QSet<QString> removedDirectories;
     for (const QString &path : paths) {
         int id = pathToID.take(path);
 
@@ -352,12 +363,18 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
         sg.dismiss();
 
         if (id < 0) {
-            directories->removeAll(path);
+            removedDirectories.insert(path);
         } else {
-            files->removeAll(path);
+            removedFiles.insert(path);
         }
     }
 
+    // prune the lists once rather than searching them for every path
+    if (!removedDirectories.isEmpty())
+        directories->removeIf([&](const QString &path) { return removedDirectories.contains(path); });
+    if (!removedFiles.isEmpty())
+        files->removeIf([&](const QString &path) { return removedFiles.contains(path); });
+
     return unhandled;
 }
 
@@ -1311,6 +1311,49 @@ QByteArray QIODevice::readAll()
     return result;
 }
 
+/*!
+    \since 6.4
+
+    Reads the next contiguous block of data from the device, and returns
+    it as a byte array.
+
+    Data the device already holds in its read buffer is returned one buffer
+    chunk at a time, sharing the chunk's storage instead of copying it; this
+    is how QTcpSocket and QUdpSocket hand out the data they received. If the
+    buffer is empty, the device is read directly into the returned byte
+    array. The size of the returned block is unspecified, and an empty byte
+    array means that no data was currently available or that an error
+    occurred.
+
+    Inside a transaction, or in \l{QIODeviceBase::}{Text} mode, this
+    function copies the data exactly as read() does.
+
+    \sa read(), peekChunks(), readBufferSize()
+*/
+QByteArray QIODevice::readChunk()
+{
+    Q_D(QIODevice);
+#if defined QIODEVICE_DEBUG
+    printf("%p QIODevice::readChunk(), d->pos = %lld, d->buffer.size() = %lld\n",
+           this, d->pos, d->buffer.size());
+#endif
+
+    CHECK_READABLE(read, QByteArray());
+
+    if (!d->buffer.isEmpty() && !d->transactionStarted
+        && (d->openMode & QIODevice::Text) == 0) {
+        const qint64 chunkSize = d->buffer.nextDataBlockSize();
+        QByteArray result = d->buffer.read();
+        if (!d->isSequential())
+            d->pos += chunkSize;
+        if (d->buffer.isEmpty())
+            readData(nullptr, 0);
+        return result;
+    }
+
+    return read(qMax(qint64(d->buffer.chunkSize()), qint64(QRINGBUFFER_CHUNKSIZE)));
+}
+
 /*!
     This function reads a line of ASCII characters from the device, up
     to a maximum of \a maxSize - 1 bytes, stores the characters in \a
@@ -1956,6 +1999,45 @@ QByteArray QIODevice::peek(qint64 maxSize)
     return d->peek(maxSize);
 }
 
+/*!
+    \since 6.4
+
+    Returns the data currently held in the device's read buffer, as a list
+    of views into the buffer's chunks, without copying or consuming it.
+    Nothing is read from the device itself, so the list is empty for
+    unbuffered devices, and when no data has arrived yet.
+
+    The views are only valid until the next call of a non-const function on
+    the device, as reading or receiving data can free or reuse the chunks.
+    In a transaction, the data read since startTransaction() is skipped. No
+    end-of-line translation is done, so in \l{QIODeviceBase::}{Text} mode
+    this function returns an empty list; use peek() instead.
+
+    \sa peek(), readChunk()
+*/
+QList<QByteArrayView> QIODevice::peekChunks() const
+{
+    Q_D(const QIODevice);
+
+    QList<QByteArrayView> chunks;
+    CHECK_READABLE(peek, chunks);
+
+    if (d->openMode & QIODevice::Text)
+        return chunks;
+
+    qint64 bufferPos = (d->isSequential() && d->transactionStarted) ? d->transactionPos
+                                                                   : Q_INT64_C(0);
+    while (bufferPos < d->buffer.size()) {
+        qint64 length = 0;
+        const char *data = d->buffer.readPointerAtPosition(bufferPos, length);
+        Q_ASSERT(data && length > 0);
+        chunks.append(QByteArrayView(data, length));
+        bufferPos += length;
+    }
+
+    return chunks;
+}
+
 /*!
     \since 5.10
 
@@ -112,6 +112,7 @@ public:
     qint64 read(char *data, qint64 maxlen);
     QByteArray read(qint64 maxlen);
     QByteArray readAll();
+    QByteArray readChunk();
     qint64 readLine(char *data, qint64 maxlen);
     QByteArray readLine(qint64 maxlen = 0);
     virtual bool canReadLine() const;
@@ -127,6 +128,7 @@ public:
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
+    QList<QByteArrayView> peekChunks() const;
     qint64 skip(qint64 maxSize);
 
     virtual bool waitForReadyRead(int msecs);
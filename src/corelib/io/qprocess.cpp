@@ -1534,6 +1534,11 @@ std::function<void(void)> QProcess::childProcessModifier() const
     "async-signal-safe" is advised). Most of the Qt API is unsafe inside this
     callback, including qDebug(), and may lead to deadlocks.
 
+    \note Without a modifier, QProcess on Linux starts the child so that it
+    shares the parent's memory until it calls \c{execve()}, which keeps
+    starting processes from a parent that uses a lot of memory cheap. Setting
+    a modifier makes QProcess use a full \c{fork()} instead.
+
     \sa childProcessModifier()
 */
 void QProcess::setChildProcessModifier(const std::function<void(void)> &modifier)
@@ -70,6 +70,7 @@
 
 #include <errno.h>
 #include <limits.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -445,6 +446,40 @@ static QString resolveExecutable(const QString &program)
     return program;
 }
 
+namespace {
+struct QChildLaunch
+{
+    QProcessPrivate *d;
+    const char *workingDir;
+    char **argv;
+    char **envp;
+    sigset_t signalMask;
+    bool vforkSemantics;
+};
+}
+
+// Runs in the child. With vfork semantics, the child shares the memory of the
+// parent until it calls execve(), so nothing here may modify the parent's state.
+static int launchChild(void *token)
+{
+    const QChildLaunch *launch = static_cast<const QChildLaunch *>(token);
+    if (launch->vforkSemantics) {
+        for (int sig = 1; sig < NSIG; ++sig) {
+            struct sigaction action;
+            if (::sigaction(sig, nullptr, &action) == 0 && action.sa_handler != SIG_IGN
+                    && action.sa_handler != SIG_DFL) {
+                memset(&action, 0, sizeof(action));
+                action.sa_handler = SIG_DFL;
+                ::sigaction(sig, &action, nullptr);
+            }
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &launch->signalMask, nullptr);
+
+    launch->d->execChild(launch->workingDir, launch->argv, launch->envp);
+    return -1;
+}
+
 void QProcessPrivate::startProcess()
 {
     Q_Q(QProcess);
@@ -492,9 +527,24 @@ void QProcessPrivate::startProcess()
     ffdflags |= FFD_USE_FORK;
 #endif
 
+    // Unless the user wants to run code of their own in the child, let it
+    // share our memory until it has called execve(), so that starting it does
+    // not need to copy the page tables of a large parent process.
+    QChildLaunch launch = { this, workingDirPtr, argv.pointers.get(), envp.pointers.get(), {},
+                            !childProcessModifier };
+    if (launch.vforkSemantics)
+        ffdflags |= FFD_VFORK_SEMANTICS;
+
+    // Block all signals, so that none of our handlers can run in the child
+    // until it has reset them.
+    sigset_t allSignals;
+    sigfillset(&allSignals);
+    pthread_sigmask(SIG_SETMASK, &allSignals, &launch.signalMask);
+
     pid_t childPid;
-    forkfd = ::forkfd(ffdflags , &childPid);
+    forkfd = ::vforkfd(ffdflags, &childPid, launchChild, &launch);
     int lastForkErrno = errno;
+    pthread_sigmask(SIG_SETMASK, &launch.signalMask, nullptr);
 
     if (forkfd == -1) {
         // Cleanup, report error and return
@@ -508,17 +558,12 @@ void QProcessPrivate::startProcess()
         return;
     }
 
-    // Start the child.
-    if (forkfd == FFD_CHILD_PROCESS) {
-        execChild(workingDirPtr, argv.pointers.get(), envp.pointers.get());
-        ::_exit(-1);
-    }
-
     pid = qint64(childPid);
     Q_ASSERT(pid > 0);
 
     // parent
-    // close the ends we don't use and make all pipes non-blocking
+    // close the ends we don't use and make all pipes non-blocking (the pipes
+    // were just created, so they have no other file status flags to keep)
     qt_safe_close(childStartedPipe[1]);
     childStartedPipe[1] = -1;
 
@@ -528,7 +573,7 @@ void QProcessPrivate::startProcess()
     }
 
     if (stdinChannel.pipe[1] != -1)
-        ::fcntl(stdinChannel.pipe[1], F_SETFL, ::fcntl(stdinChannel.pipe[1], F_GETFL) | O_NONBLOCK);
+        ::fcntl(stdinChannel.pipe[1], F_SETFL, O_NONBLOCK);
 
     if (stdoutChannel.pipe[1] != -1) {
         qt_safe_close(stdoutChannel.pipe[1]);
@@ -536,14 +581,14 @@ void QProcessPrivate::startProcess()
     }
 
     if (stdoutChannel.pipe[0] != -1)
-        ::fcntl(stdoutChannel.pipe[0], F_SETFL, ::fcntl(stdoutChannel.pipe[0], F_GETFL) | O_NONBLOCK);
+        ::fcntl(stdoutChannel.pipe[0], F_SETFL, O_NONBLOCK);
 
     if (stderrChannel.pipe[1] != -1) {
         qt_safe_close(stderrChannel.pipe[1]);
         stderrChannel.pipe[1] = -1;
     }
     if (stderrChannel.pipe[0] != -1)
-        ::fcntl(stderrChannel.pipe[0], F_SETFL, ::fcntl(stderrChannel.pipe[0], F_GETFL) | O_NONBLOCK);
+        ::fcntl(stderrChannel.pipe[0], F_SETFL, O_NONBLOCK);
 }
 
 void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp)
@@ -586,7 +631,6 @@ void QProcessPrivate::execChild(const char *workingDir, char **argv, char **envp
 report_errno:
     error.code = errno;
     qt_safe_write(childStartedPipe[1], &error, sizeof(error));
-    childStartedPipe[1] = -1;
 }
 
 bool QProcessPrivate::processStarted(QString *errorMessage)
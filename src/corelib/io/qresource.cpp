@@ -42,6 +42,7 @@
 #include "qresource_p.h"
 #include "qresource_iterator_p.h"
 #include "qset.h"
+#include "qcache.h"
 #include <private/qlocking_p.h>
 #include "qdebug.h"
 #include "qlocale.h"
@@ -95,6 +96,7 @@ RCC_FEATURE_SYMBOL(Zlib)
 #endif
 #if QT_CONFIG(zstd)
 RCC_FEATURE_SYMBOL(Zstd)
+RCC_FEATURE_SYMBOL(ZstdDictionary)
 #endif
 
 #undef RCC_FEATURE_SYMBOL
@@ -136,7 +138,8 @@ public:
         // must match rcc.h
         Compressed = 0x01,
         Directory = 0x02,
-        CompressedZstd = 0x04
+        CompressedZstd = 0x04,
+        ZstdDictionary = 0x08
     };
 
 private:
@@ -164,6 +167,7 @@ public:
         return QResource::NoCompression;
     }
     const uchar *data(int node, qint64 *size) const;
+    const uchar *zstdDictionary(int node, qint64 *size) const;
     quint64 lastModified(int node) const;
     QStringList children(int node) const;
     virtual QString mappingRoot() const { return QString(); }
@@ -214,6 +218,26 @@ static inline ResourceList *resourceList()
 static inline QStringList *resourceSearchPaths()
 { return &resourceGlobalData->resourceSearchPaths; }
 
+// Decompressed payloads, keyed by the address of their compressed data.
+// Only created once a limit is set with setDecompressionCacheLimit().
+struct QResourceDecompressionCache
+{
+    QBasicMutex mutex;
+    QCache<const uchar *, QByteArray> cache{0};
+};
+Q_GLOBAL_STATIC(QResourceDecompressionCache, resourceDecompressionCache)
+
+// Must be called whenever resource data may go away, since data registered
+// later can reuse its addresses.
+static void clearDecompressionCache()
+{
+    if (!resourceDecompressionCache.exists())
+        return;
+    QResourceDecompressionCache *d = resourceDecompressionCache();
+    const auto locker = qt_scoped_lock(d->mutex);
+    d->cache.clear();
+}
+
 /*!
     \class QResource
     \inmodule QtCore
@@ -310,6 +334,8 @@ public:
     mutable qint64 size;
     mutable quint64 lastModified;
     mutable const uchar *data;
+    mutable const uchar *dictionary;
+    mutable qint64 dictionarySize;
     mutable QStringList children;
     mutable quint8 compressionAlgo;
     bool container;
@@ -325,13 +351,17 @@ void QResourcePrivate::clear()
     compressionAlgo = QResource::NoCompression;
     data = nullptr;
     size = 0;
+    dictionary = nullptr;
+    dictionarySize = 0;
     children.clear();
     lastModified = 0;
     container = 0;
     for (int i = 0; i < related.size(); ++i) {
         QResourceRoot *root = related.at(i);
-        if (!root->ref.deref())
+        if (!root->ref.deref()) {
             delete root;
+            clearDecompressionCache();
+        }
     }
     related.clear();
 }
@@ -350,6 +380,7 @@ bool QResourcePrivate::load(const QString &file)
                 container = res->isContainer(node);
                 if (!container) {
                     data = res->data(node, &size);
+                    dictionary = res->zstdDictionary(node, &dictionarySize);
                     compressionAlgo = res->compressionAlgo(node);
                 } else {
                     data = nullptr;
@@ -497,7 +528,15 @@ qsizetype QResourcePrivate::decompress(char *buffer, qsizetype bufferSize) const
 
     case QResource::ZstdCompression: {
 #if QT_CONFIG(zstd)
-        size_t usize = ZSTD_decompress(buffer, bufferSize, data, size);
+        size_t usize;
+        if (dictionary) {
+            ZSTD_DCtx *dctx = ZSTD_createDCtx();
+            usize = ZSTD_decompress_usingDict(dctx, buffer, bufferSize, data, size,
+                                              dictionary, dictionarySize);
+            ZSTD_freeDCtx(dctx);
+        } else {
+            usize = ZSTD_decompress(buffer, bufferSize, data, size);
+        }
         if (ZSTD_isError(usize)) {
             qWarning("QResource: error decompressing zstd content: %s", ZSTD_getErrorName(usize));
             return -1;
@@ -639,6 +678,10 @@ bool QResource::isValid() const
 
     See \l{http://facebook.github.io/zstd/zstd_manual.html}{Zstandard manual}.
 
+    Resources compressed by rcc with a dictionary (the \c{--zstd-dictionary-size}
+    option) cannot be decompressed from data() alone, because the dictionary
+    is not part of it. Use uncompressedData() or QFile to read them.
+
     \sa data(), isFile()
 */
 QResource::Compression QResource::compressionAlgorithm() const
@@ -705,7 +748,8 @@ const uchar *QResource::data() const
     decompressing, a null QByteArray is returned.
 
     \note If the data was compressed, this function will decompress every time
-    it is called. The result is not cached between calls.
+    it is called, unless a decompression cache was enabled with
+    setDecompressionCacheLimit().
 
     \sa uncompressedSize(), size(), compressionAlgorithm(), isFile()
 */
@@ -723,16 +767,78 @@ QByteArray QResource::uncompressedData() const
     if (d->compressionAlgo == NoCompression)
         return QByteArray::fromRawData(reinterpret_cast<const char *>(d->data), n);
 
+    QResourceDecompressionCache *cache =
+            resourceDecompressionCache.exists() ? resourceDecompressionCache() : nullptr;
+    if (cache) {
+        const auto locker = qt_scoped_lock(cache->mutex);
+        if (const QByteArray *cached = cache->cache.object(d->data))
+            return *cached;
+    }
+
     // decompress
     QByteArray result(n, Qt::Uninitialized);
     n = d->decompress(result.data(), n);
-    if (n < 0)
+    if (n < 0) {
         result.clear();
-    else
-        result.truncate(n);
+        return result;
+    }
+    result.truncate(n);
+
+    if (cache) {
+        const auto locker = qt_scoped_lock(cache->mutex);
+        if (result.size() <= cache->cache.maxCost())
+            cache->cache.insert(d->data, new QByteArray(result), result.size());
+    }
     return result;
 }
 
+/*!
+    \since 6.4
+
+    Sets the maximum number of bytes of decompressed resource data that
+    uncompressedData() keeps in memory to \a bytes. A value of 0, the default,
+    disables the cache.
+
+    While the cache is enabled, uncompressedData() returns a shared copy of
+    the data decompressed earlier for the same resource, rather than
+    decompressing it again. Reading a compressed resource through QFile uses
+    the cache as well. When the cache is full, the data used least recently
+    is dropped first. Data that is larger than the limit is never cached.
+
+    The cache can be used from several threads at once, so resources that are
+    needed later can be decompressed in parallel up front, for instance by
+    calling uncompressedData() from QtConcurrent::blockingMap().
+
+    \sa decompressionCacheLimit(), uncompressedData()
+*/
+void QResource::setDecompressionCacheLimit(qint64 bytes)
+{
+    QResourceDecompressionCache *d = resourceDecompressionCache();
+    if (!d)
+        return;
+    const auto locker = qt_scoped_lock(d->mutex);
+    d->cache.setMaxCost(qsizetype(qBound(qint64(0), bytes,
+                                         qint64(std::numeric_limits<qsizetype>::max()))));
+}
+
+/*!
+    \since 6.4
+
+    Returns the maximum number of bytes of decompressed resource data that
+    uncompressedData() keeps in memory. The default is 0, meaning that
+    nothing is cached.
+
+    \sa setDecompressionCacheLimit()
+*/
+qint64 QResource::decompressionCacheLimit()
+{
+    if (!resourceDecompressionCache.exists())
+        return 0;
+    QResourceDecompressionCache *d = resourceDecompressionCache();
+    const auto locker = qt_scoped_lock(d->mutex);
+    return d->cache.maxCost();
+}
+
 /*!
     \since 5.8
 
@@ -953,12 +1059,30 @@ const uchar *QResourceRoot::data(int node, qint64 *size) const
         const quint32 data_length = qFromBigEndian<quint32>(payloads + data_offset);
         const uchar *ret = payloads + data_offset + 4;
         *size = data_length;
+        if (flags & ZstdDictionary) {
+            // skip the dictionary offset in front of the zstd frame
+            ret += 4;
+            *size -= 4;
+        }
         return ret;
     }
     *size = 0;
     return nullptr;
 }
 
+const uchar *QResourceRoot::zstdDictionary(int node, qint64 *size) const
+{
+    if (node == -1 || !(flags(node) & ZstdDictionary)) {
+        *size = 0;
+        return nullptr;
+    }
+    const int offset = findOffset(node) + 10; // jump past name, flags and locale
+    const qint32 data_offset = qFromBigEndian<qint32>(tree + offset);
+    const qint32 dictionary_offset = qFromBigEndian<qint32>(payloads + data_offset + 4);
+    *size = qFromBigEndian<quint32>(payloads + dictionary_offset);
+    return payloads + dictionary_offset + 4;
+}
+
 quint64 QResourceRoot::lastModified(int node) const
 {
     if (node == -1 || version < 0x02)
@@ -1051,8 +1175,10 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
         for (int i = 0; i < list->size();) {
             if (*list->at(i) == res) {
                 QResourceRoot *root = list->takeAt(i);
-                if (!root->ref.deref())
+                if (!root->ref.deref()) {
                     delete root;
+                    clearDecompressionCache();
+                }
             } else {
                 ++i;
             }
@@ -1071,7 +1197,7 @@ class QDynamicBufferResourceRoot : public QResourceRoot
 
 public:
     inline QDynamicBufferResourceRoot(const QString &_root) : root(_root), buffer(nullptr) { }
-    inline ~QDynamicBufferResourceRoot() { }
+    inline ~QDynamicBufferResourceRoot() { clearDecompressionCache(); }
     inline const uchar *mappingBuffer() const { return buffer; }
     QString mappingRoot() const override { return root; }
     ResourceRootType type() const override { return Resource_Buffer; }
@@ -1121,7 +1247,7 @@ public:
         acceptableFlags |= Compressed;
 #endif
         if (QT_CONFIG(zstd))
-            acceptableFlags |= CompressedZstd;
+            acceptableFlags |= CompressedZstd | ZstdDictionary;
         if (file_flags & ~acceptableFlags)
             return false;
 
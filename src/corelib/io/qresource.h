@@ -86,6 +86,9 @@ public:
     static bool registerResource(const uchar *rccData, const QString &resourceRoot=QString());
     static bool unregisterResource(const uchar *rccData, const QString &resourceRoot=QString());
 
+    static void setDecompressionCacheLimit(qint64 bytes);
+    static qint64 decompressionCacheLimit();
+
 protected:
     friend class QResourceFileEngine;
     friend class QResourceFileEngineIterator;
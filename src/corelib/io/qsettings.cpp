@@ -65,6 +65,9 @@
 #ifndef QT_BOOTSTRAPPED
 #include "qsavefile.h"
 #include "qlockfile.h"
+#if QT_CONFIG(thread)
+#include "qthreadpool.h"
+#endif
 #endif
 
 #ifdef Q_OS_VXWORKS
@@ -72,6 +75,7 @@
 #endif
 
 #include <algorithm>
+#include <limits>
 #include <stdlib.h>
 
 #ifdef Q_OS_WIN // for homedirpath reading from registry
@@ -126,6 +130,17 @@ typedef QList<QConfFileCustomFormat> CustomFormatVector;
 
 Q_GLOBAL_STATIC(ConfFileHash, usedHashFunc)
 Q_GLOBAL_STATIC(ConfFileCache, unusedCacheFunc)
+
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+namespace {
+// Background flushes all run on one thread, in the order they were requested
+struct SettingsFlushPool : public QThreadPool
+{
+    SettingsFlushPool() { setMaxThreadCount(1); }
+};
+}
+Q_GLOBAL_STATIC(SettingsFlushPool, settingsFlushPool)
+#endif
 Q_GLOBAL_STATIC(PathHash, pathHashFunc)
 Q_GLOBAL_STATIC(CustomFormatVector, customFormatVectorFunc)
 
@@ -326,7 +341,10 @@ void QSettingsPrivate::setStatus(QSettings::Status status) const
 
 void QSettingsPrivate::update()
 {
-    flush();
+    if (backgroundSync)
+        flushInBackground();
+    else
+        flush();
     pendingChanges = false;
 }
 
@@ -1130,6 +1148,8 @@ QConfFileSettingsPrivate::QConfFileSettingsPrivate(const QString &fileName,
 
 QConfFileSettingsPrivate::~QConfFileSettingsPrivate()
 {
+    waitForBackgroundFlush();
+
     const auto locker = qt_scoped_lock(settingsGlobalMutex);
     ConfFileHash *usedHash = usedHashFunc();
     ConfFileCache *unusedCache = unusedCacheFunc();
@@ -1285,6 +1305,12 @@ void QConfFileSettingsPrivate::clear()
 }
 
 void QConfFileSettingsPrivate::sync()
+{
+    waitForBackgroundFlush();
+    syncConfFiles();
+}
+
+void QConfFileSettingsPrivate::syncConfFiles()
 {
     // people probably won't be checking the status a whole lot, so in case of
     // error we just try to go on and make the best of it
@@ -1300,6 +1326,40 @@ void QConfFileSettingsPrivate::flush()
     sync();
 }
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+void QConfFileSettingsPrivate::flushInBackground()
+{
+    {
+        const auto locker = qt_scoped_lock(backgroundFlushMutex);
+        if (backgroundFlushRunning) {
+            // coalesce with the flush in progress: it will run once more
+            backgroundFlushRequested = true;
+            return;
+        }
+        backgroundFlushRunning = true;
+    }
+
+    settingsFlushPool()->start([this] {
+        auto locker = qt_unique_lock(backgroundFlushMutex);
+        do {
+            backgroundFlushRequested = false;
+            locker.unlock();
+            syncConfFiles();
+            locker.lock();
+        } while (backgroundFlushRequested);
+        backgroundFlushRunning = false;
+        backgroundFlushDone.wakeAll();
+    });
+}
+
+void QConfFileSettingsPrivate::waitForBackgroundFlush() const
+{
+    auto locker = qt_unique_lock(backgroundFlushMutex);
+    while (backgroundFlushRunning)
+        backgroundFlushDone.wait(locker.mutex());
+}
+#endif
+
 QString QConfFileSettingsPrivate::fileName() const
 {
     if (confFiles.isEmpty())
@@ -1389,8 +1449,17 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             } else
 #endif
             if (format <= QSettings::IniFormat) {
-                QByteArray data = file.readAll();
-                ok = readIniFile(data, &confFile->unparsedIniSections);
+                // readIniFile() copies each section out of the data, so a
+                // mapping of the file only needs to last as long as the call
+                const qint64 size = file.size();
+                uchar *mapped = size <= std::numeric_limits<int>::max() ? file.map(0, size) : nullptr;
+                if (mapped) {
+                    ok = readIniFile(QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), size),
+                                     &confFile->unparsedIniSections);
+                    file.unmap(mapped);
+                } else {
+                    ok = readIniFile(file.readAll(), &confFile->unparsedIniSections);
+                }
             } else if (readFunc) {
                 QSettings::SettingsMap tempNewKeys;
                 ok = readFunc(file, tempNewKeys);
@@ -2810,6 +2879,7 @@ QString QSettings::applicationName() const
 QSettings::Status QSettings::status() const
 {
     Q_D(const QSettings);
+    d->waitForBackgroundFlush();
     return d->status;
 }
 
@@ -2857,6 +2927,48 @@ void QSettings::setAtomicSyncRequired(bool enable)
     d->atomicSyncOnly = enable;
 }
 
+/*!
+    \since 6.4
+
+    Returns \c true if the changes QSettings writes on its own, from the
+    event loop, are written by a background thread; otherwise returns
+    \c false.
+
+    The default is \c false.
+
+    \sa setBackgroundSyncEnabled()
+*/
+bool QSettings::isBackgroundSyncEnabled() const
+{
+    Q_D(const QSettings);
+    return d->backgroundSync;
+}
+
+/*!
+    \since 6.4
+
+    Configures whether QSettings writes the changes it saves on its own,
+    from the event loop, on a background thread. If \a enable is \c true,
+    setting a value never waits for a settings file to be written, and
+    further changes made while a write is in progress are saved together by
+    one more write once it finishes.
+
+    Calling sync(), or destroying the QSettings object, still writes any
+    unsaved changes before returning, and status() waits for a background
+    write in progress to finish so that it can report its outcome.
+
+    This setting only affects QSettings objects backed by a file; on other
+    storage, and in builds without thread support, changes are always written
+    from the event loop.
+
+    \sa isBackgroundSyncEnabled(), sync()
+*/
+void QSettings::setBackgroundSyncEnabled(bool enable)
+{
+    Q_D(QSettings);
+    d->backgroundSync = enable;
+}
+
 /*!
     Appends \a prefix to the current group.
 
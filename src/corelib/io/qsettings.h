@@ -147,6 +147,8 @@ public:
     Status status() const;
     bool isAtomicSyncRequired() const;
     void setAtomicSyncRequired(bool enable);
+    bool isBackgroundSyncEnabled() const;
+    void setBackgroundSyncEnabled(bool enable);
 
     void beginGroup(const QString &prefix);
     void endGroup();
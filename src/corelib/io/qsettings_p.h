@@ -61,6 +61,10 @@
 #include <QtCore/qvariant.h>
 #include "qsettings.h"
 
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+#include "QtCore/qwaitcondition.h"
+#endif
+
 #ifndef QT_NO_QOBJECT
 #include "private/qobject_p.h"
 #endif
@@ -205,6 +209,8 @@ public:
     virtual void clear() = 0;
     virtual void sync() = 0;
     virtual void flush() = 0;
+    virtual void flushInBackground() { flush(); }
+    virtual void waitForBackgroundFlush() const { }
     virtual bool isWritable() const = 0;
     virtual QString fileName() const = 0;
 
@@ -247,6 +253,7 @@ protected:
     bool fallbacks;
     bool pendingChanges;
     bool atomicSyncOnly = true;
+    bool backgroundSync = false;
     mutable QSettings::Status status;
 };
 
@@ -271,6 +278,10 @@ public:
     void clear() override;
     void sync() override;
     void flush() override;
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    void flushInBackground() override;
+    void waitForBackgroundFlush() const override;
+#endif
     bool isWritable() const override;
     QString fileName() const override;
 
@@ -283,6 +294,7 @@ public:
 private:
     void initFormat();
     virtual void initAccess();
+    void syncConfFiles();
     void syncConfFile(QConfFile *confFile);
     bool writeIniFile(QIODevice &device, const ParsedSettingsMap &map);
 #ifdef Q_OS_MAC
@@ -298,6 +310,13 @@ private:
     QString extension;
     Qt::CaseSensitivity caseSensitivity;
     int nextPosition;
+#if QT_CONFIG(thread) && !defined(QT_BOOTSTRAPPED)
+    // a background flush in progress, and whether another one was requested meanwhile
+    mutable QMutex backgroundFlushMutex;
+    mutable QWaitCondition backgroundFlushDone;
+    bool backgroundFlushRunning = false;
+    bool backgroundFlushRequested = false;
+#endif
 #ifdef Q_OS_WASM
     friend class QWasmSettingsPrivate;
 #endif
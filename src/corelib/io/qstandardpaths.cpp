@@ -46,6 +46,7 @@
 #ifndef QT_BOOTSTRAPPED
 #include <qobject.h>
 #include <qcoreapplication.h>
+#include <private/qstartuptimeline_p.h>
 #endif
 
 #if __has_include(<paths.h>)
@@ -410,6 +411,9 @@ static bool existsAsSpecified(const QString &path, QStandardPaths::LocateOptions
  */
 QString QStandardPaths::locate(StandardLocation type, const QString &fileName, LocateOptions options)
 {
+#ifndef QT_BOOTSTRAPPED
+    QStartupTimelineScope timelineScope("QStandardPaths::locate", fileName);
+#endif
     const QStringList &dirs = standardLocations(type);
     for (QStringList::const_iterator dir = dirs.constBegin(); dir != dirs.constEnd(); ++dir) {
         const QString path = *dir + QLatin1Char('/') + fileName;
@@ -424,6 +428,9 @@ QString QStandardPaths::locate(StandardLocation type, const QString &fileName, L
  */
 QStringList QStandardPaths::locateAll(StandardLocation type, const QString &fileName, LocateOptions options)
 {
+#ifndef QT_BOOTSTRAPPED
+    QStartupTimelineScope timelineScope("QStandardPaths::locateAll", fileName);
+#endif
     const QStringList &dirs = standardLocations(type);
     QStringList result;
     for (QStringList::const_iterator dir = dirs.constBegin(); dir != dirs.constEnd(); ++dir) {
@@ -1393,27 +1393,14 @@ QUrlPrivate::setHost(const QString &value, qsizetype from, qsizetype iend, QUrl:
     return true;
 }
 
-inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode)
+// Finds the first ':' and '?' before the first '#', and the first '#'.
+static void findUrlDelimiters(QStringView url, qsizetype &colon, qsizetype &question, qsizetype &hash)
 {
-    //   URI-reference = URI / relative-ref
-    //   URI           = scheme ":" hier-part [ "?" query ] [ "#" fragment ]
-    //   relative-ref  = relative-part [ "?" query ] [ "#" fragment ]
-    //   hier-part     = "//" authority path-abempty
-    //                 / other path types
-    //   relative-part = "//" authority path-abempty
-    //                 /  other path types here
-
-    sectionIsPresent = 0;
-    flags = 0;
-    clearError();
-
-    // find the important delimiters
-    qsizetype colon = -1;
-    qsizetype question = -1;
-    qsizetype hash = -1;
+    colon = -1;
+    question = -1;
+    hash = -1;
     const qsizetype len = url.length();
-    const QChar *const begin = url.constData();
-    const ushort *const data = reinterpret_cast<const ushort *>(begin);
+    const char16_t *const data = url.utf16();
 
     for (qsizetype i = 0; i < len; ++i) {
         size_t uc = data[i];
@@ -1431,6 +1418,28 @@ inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode
                 question = i;
         }
     }
+}
+
+inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode)
+{
+    //   URI-reference = URI / relative-ref
+    //   URI           = scheme ":" hier-part [ "?" query ] [ "#" fragment ]
+    //   relative-ref  = relative-part [ "?" query ] [ "#" fragment ]
+    //   hier-part     = "//" authority path-abempty
+    //                 / other path types
+    //   relative-part = "//" authority path-abempty
+    //                 /  other path types here
+
+    sectionIsPresent = 0;
+    flags = 0;
+    clearError();
+
+    // find the important delimiters
+    qsizetype colon, question, hash;
+    findUrlDelimiters(url, colon, question, hash);
+    const qsizetype len = url.length();
+    const QChar *const begin = url.constData();
+    const ushort *const data = reinterpret_cast<const ushort *>(begin);
 
     // check if we have a scheme
     qsizetype hierStart;
@@ -3825,4 +3834,255 @@ QUrl QUrl::fromUserInput(const QString &userInput, const QString &workingDirecto
     return QUrl();
 }
 
+/*!
+    \class QUrlView
+    \inmodule QtCore
+    \since 6.4
+    \brief The QUrlView class splits a URL into its components without
+    copying or decoding it.
+
+    QUrlView parses a URL the way QUrl does in QUrl::TolerantMode, but each
+    component it returns is a QStringView into the string it was constructed
+    from, exactly as it appears there: percent-encoded sequences are not
+    decoded, and the scheme and host are not normalized. This makes parsing a
+    URL allocation-free, which matters when many URLs are parsed and only some
+    of their components are used. Call decoded() on the components that need
+    decoding, or toUrl() to get a QUrl with full validation.
+
+    The string the view was constructed from must outlive the view.
+
+    \code
+    const QUrlView url(request.target);
+    if (url.host() == u"example.com")
+        route(QUrlView::decoded(url.path()));
+    \endcode
+
+    \sa QUrl, QStringView
+*/
+
+/*!
+    \fn QUrlView::QUrlView()
+
+    Constructs a view on no URL.
+*/
+
+/*!
+    Parses \a url and constructs a view on it.
+*/
+QUrlView::QUrlView(QStringView url) noexcept
+    : input(url), valid(true)
+{
+    qsizetype colon, question, hash;
+    findUrlDelimiters(url, colon, question, hash);
+    const qsizetype len = url.size();
+    const char16_t *const data = url.utf16();
+
+    // scheme = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." ); without a valid
+    // one, the colon belongs to the path
+    qsizetype hierStart = 0;
+    if (colon > 0) {
+        qsizetype i = 0;
+        for ( ; i < colon; ++i) {
+            const char16_t c = data[i] | 0x20;
+            if (c >= 'a' && c <= 'z')
+                continue;
+            if (i && ((data[i] >= '0' && data[i] <= '9')
+                      || data[i] == '+' || data[i] == '-' || data[i] == '.'))
+                continue;
+            break;
+        }
+        if (i == colon) {
+            schemeView = url.first(colon);
+            hierStart = colon + 1;
+        }
+    }
+
+    const qsizetype hierEnd = qMin<size_t>(qMin<size_t>(question, hash), len);
+    qsizetype pathStart = hierStart;
+    if (hierEnd - hierStart >= 2 && data[hierStart] == '/' && data[hierStart + 1] == '/') {
+        const qsizetype authorityStart = hierStart + 2;
+        qsizetype authorityEnd = hierEnd;
+        for (qsizetype i = authorityStart; i < authorityEnd; ++i) {
+            if (data[i] == '/') {
+                authorityEnd = i;
+                break;
+            }
+        }
+        authorityView = url.sliced(authorityStart, authorityEnd - authorityStart);
+        pathStart = authorityEnd;
+
+        QStringView hostAndPort = authorityView;
+        const qsizetype at = hostAndPort.indexOf(u'@');
+        if (at != -1) {
+            userInfoView = hostAndPort.first(at);
+            hostAndPort = hostAndPort.sliced(at + 1);
+        }
+
+        // the port follows the last colon, unless that is inside an IPv6 "[...]"
+        qsizetype portColon = hostAndPort.lastIndexOf(u':');
+        if (hostAndPort.startsWith(u'[') && portColon < hostAndPort.indexOf(u']'))
+            portColon = -1;
+        if (portColon != -1) {
+            const QStringView portText = hostAndPort.sliced(portColon + 1);
+            hostAndPort = hostAndPort.first(portColon);
+            if (!portText.isEmpty()) {
+                uint x = 0;
+                for (const QChar c : portText) {
+                    if (c.unicode() < '0' || c.unicode() > '9' || x > 0xffff) {
+                        x = 0x10000;
+                        break;
+                    }
+                    x = x * 10 + (c.unicode() - '0');
+                }
+                if (x > 0xffff)
+                    valid = false;
+                else
+                    portNumber = int(x);
+            }
+        }
+
+        if (hostAndPort.size() >= 2 && hostAndPort.startsWith(u'[') && hostAndPort.endsWith(u']'))
+            hostAndPort = hostAndPort.sliced(1, hostAndPort.size() - 2);
+        hostView = hostAndPort;
+    }
+
+    pathView = url.sliced(pathStart, hierEnd - pathStart);
+    if (size_t(question) < size_t(hash))
+        queryView = url.sliced(question + 1, qMin<size_t>(hash, len) - question - 1);
+    if (hash != -1)
+        fragmentView = url.sliced(hash + 1);
+}
+
+/*!
+    \fn bool QUrlView::isValid() const
+
+    Returns \c false if the URL has a port that is not a number from 0 to
+    65535, and \c true otherwise. QUrlView does not validate the other
+    components; use toUrl() for that.
+*/
+
+/*!
+    \fn QStringView QUrlView::url() const
+
+    Returns the string this view was constructed from.
+*/
+
+/*!
+    \fn QStringView QUrlView::scheme() const
+
+    Returns the scheme of the URL, as written, or a null view if the URL has
+    no scheme.
+*/
+
+/*!
+    \fn QStringView QUrlView::authority() const
+
+    Returns the authority of the URL, as written, or a null view if the URL
+    has no authority.
+
+    \sa hasAuthority()
+*/
+
+/*!
+    \fn QStringView QUrlView::userInfo() const
+
+    Returns the user info of the URL, as written, or a null view if the URL
+    has none.
+*/
+
+/*!
+    Returns the user name of the URL, as written, or a null view if the URL
+    has none.
+*/
+QStringView QUrlView::userName() const noexcept
+{
+    const qsizetype colon = userInfoView.indexOf(u':');
+    return colon == -1 ? userInfoView : userInfoView.first(colon);
+}
+
+/*!
+    Returns the password of the URL, as written, or a null view if the URL
+    has none.
+*/
+QStringView QUrlView::password() const noexcept
+{
+    const qsizetype colon = userInfoView.indexOf(u':');
+    return colon == -1 ? QStringView() : userInfoView.sliced(colon + 1);
+}
+
+/*!
+    \fn QStringView QUrlView::host() const
+
+    Returns the host of the URL, as written, without the brackets around an
+    IPv6 address. Unlike QUrl::host(), the host is not lowercased nor
+    converted from ACE.
+*/
+
+/*!
+    \fn int QUrlView::port(int defaultPort) const
+
+    Returns the port of the URL, or \a defaultPort if the URL has none.
+*/
+
+/*!
+    \fn QStringView QUrlView::path() const
+
+    Returns the path of the URL, as written.
+*/
+
+/*!
+    \fn QStringView QUrlView::query() const
+
+    Returns the query of the URL, as written, without the leading \c{?}, or
+    a null view if the URL has no query.
+
+    \sa hasQuery()
+*/
+
+/*!
+    \fn QStringView QUrlView::fragment() const
+
+    Returns the fragment of the URL, as written, without the leading \c{#},
+    or a null view if the URL has no fragment.
+
+    \sa hasFragment()
+*/
+
+/*!
+    \fn bool QUrlView::hasAuthority() const
+
+    Returns \c true if the URL has an authority, even an empty one.
+*/
+
+/*!
+    \fn bool QUrlView::hasQuery() const
+
+    Returns \c true if the URL has a query, even an empty one.
+*/
+
+/*!
+    \fn bool QUrlView::hasFragment() const
+
+    Returns \c true if the URL has a fragment, even an empty one.
+*/
+
+/*!
+    Returns \a component with its percent-encoded sequences decoded, like
+    QUrl::FullyDecoded does. Only allocates when \a component contains any.
+*/
+QString QUrlView::decoded(QStringView component)
+{
+    if (!component.contains(u'%'))
+        return component.toString();
+    return QString::fromUtf8(QByteArray::fromPercentEncoding(component.toUtf8()));
+}
+
+/*!
+    Returns the URL this view refers to as a QUrl, parsed using \a mode.
+*/
+QUrl QUrlView::toUrl(QUrl::ParsingMode mode) const
+{
+    return QUrl(input.toString(), mode);
+}
+
 QT_END_NAMESPACE
@@ -345,6 +345,48 @@ constexpr inline QUrl::FormattingOptions operator|(QUrl::ComponentFormattingOpti
 //{ i = int(f); f; }
 #endif // Q_QDOC
 
+class Q_CORE_EXPORT QUrlView
+{
+public:
+    constexpr QUrlView() noexcept = default;
+    explicit QUrlView(QStringView url) noexcept;
+
+    bool isValid() const noexcept { return valid; }
+    QStringView url() const noexcept { return input; }
+
+    QStringView scheme() const noexcept { return schemeView; }
+    QStringView authority() const noexcept { return authorityView; }
+    QStringView userInfo() const noexcept { return userInfoView; }
+    QStringView userName() const noexcept;
+    QStringView password() const noexcept;
+    QStringView host() const noexcept { return hostView; }
+    int port(int defaultPort = -1) const noexcept { return portNumber == -1 ? defaultPort : portNumber; }
+    QStringView path() const noexcept { return pathView; }
+    QStringView query() const noexcept { return queryView; }
+    QStringView fragment() const noexcept { return fragmentView; }
+
+    bool hasAuthority() const noexcept { return !authorityView.isNull(); }
+    bool hasQuery() const noexcept { return !queryView.isNull(); }
+    bool hasFragment() const noexcept { return !fragmentView.isNull(); }
+
+    static QString decoded(QStringView component);
+    QUrl toUrl(QUrl::ParsingMode mode = QUrl::TolerantMode) const;
+
+private:
+    QStringView input;
+    QStringView schemeView;
+    QStringView authorityView;
+    QStringView userInfoView;
+    QStringView hostView;
+    QStringView pathView;
+    QStringView queryView;
+    QStringView fragmentView;
+    int portNumber = -1;
+    bool valid = false;
+};
+
+Q_DECLARE_TYPEINFO(QUrlView, Q_RELOCATABLE_TYPE);
+
 #ifndef QT_NO_DATASTREAM
 Q_CORE_EXPORT QDataStream &operator<<(QDataStream &, const QUrl &);
 Q_CORE_EXPORT QDataStream &operator>>(QDataStream &, QUrl &);
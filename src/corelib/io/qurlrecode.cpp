@@ -205,6 +205,34 @@ static inline char16_t encodeNibble(ushort c)
     return QtMiscUtils::toHexUpper(c);
 }
 
+// Returns the first character in [input, end) that isn't unreserved
+// (ALPHA / DIGIT / "-" / "." / "_" / "~"). No action table changes how those
+// are handled, so recode() can copy runs of them without looking them up.
+static const char16_t *skipUnreserved(const char16_t *input, const char16_t *end) noexcept
+{
+#ifdef __SSE2__
+    // x <= max, unsigned, for each lane
+    const auto lessEqual = [](__m128i x, short max) {
+        return _mm_cmpeq_epi16(_mm_subs_epu16(x, _mm_set1_epi16(max)), _mm_setzero_si128());
+    };
+    for ( ; end - input >= 8; input += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+        const __m128i lower = _mm_or_si128(data, _mm_set1_epi16(0x20));
+        __m128i match = lessEqual(_mm_sub_epi16(lower, _mm_set1_epi16('a')), 'z' - 'a');
+        match = _mm_or_si128(match, lessEqual(_mm_sub_epi16(data, _mm_set1_epi16('0')), 9));
+        match = _mm_or_si128(match, lessEqual(_mm_sub_epi16(data, _mm_set1_epi16('-')), 1));
+        match = _mm_or_si128(match, _mm_cmpeq_epi16(data, _mm_set1_epi16('_')));
+        match = _mm_or_si128(match, _mm_cmpeq_epi16(data, _mm_set1_epi16('~')));
+        const uint mask = ~uint(_mm_movemask_epi8(match)) & 0xffff;
+        if (mask)
+            return input + qCountTrailingZeroBits(mask) / 2;
+    }
+#else
+    Q_UNUSED(end);
+#endif
+    return input;
+}
+
 static void ensureDetached(QString &result, char16_t *&output, const char16_t *begin, const char16_t *input, const char16_t *end,
                            int add = 0)
 {
@@ -381,6 +409,14 @@ static int recode(QString &result, const char16_t *begin, const char16_t *end,
     for ( ; input != end; ++input) {
         char16_t c;
         // try a run where no change is necessary
+        if (end - input >= 8) {
+            const char16_t *runEnd = skipUnreserved(input, end);
+            if (output) {
+                memcpy(output, input, (runEnd - input) * sizeof(char16_t));
+                output += runEnd - input;
+            }
+            input = runEnd;
+        }
         for ( ; input != end; ++input) {
             c = *input;
             if (c < 0x20U)
@@ -0,0 +1,638 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qcolumnartablemodel.h"
+#include <private/qabstractitemmodel_p.h>
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// The Qt::DisplayRole (and Qt::EditRole) values of one column
+class ColumnValues
+{
+public:
+    explicit ColumnValues(QMetaType type) : type(type) { }
+    virtual ~ColumnValues() = default;
+
+    virtual void insertRows(int row, int count) = 0;
+    virtual void removeRows(int row, int count) = 0;
+    virtual QVariant value(int row) const = 0;
+    virtual bool setValue(int row, const QVariant &value) = 0;
+
+    const QMetaType type;
+};
+
+// Stores the values of a column of type T in one array, plus whether each is set
+template <typename T>
+class TypedColumnValues final : public ColumnValues
+{
+public:
+    TypedColumnValues(QMetaType type, int rows) : ColumnValues(type), values(rows), isSet(rows) { }
+
+    void insertRows(int row, int count) override
+    {
+        values.insert(row, count, T());
+        isSet.insert(row, count, false);
+    }
+    void removeRows(int row, int count) override
+    {
+        values.remove(row, count);
+        isSet.remove(row, count);
+    }
+    QVariant value(int row) const override
+    {
+        return isSet.at(row) ? QVariant::fromValue(values.at(row)) : QVariant();
+    }
+    bool setValue(int row, const QVariant &value) override
+    {
+        if (!value.isValid()) {
+            values[row] = T();
+            isSet[row] = false;
+            return true;
+        }
+        if (value.metaType() == type) {
+            values[row] = *static_cast<const T *>(value.constData());
+        } else {
+            T converted;
+            if (!QMetaType::convert(value.metaType(), value.constData(), type, &converted))
+                return false;
+            values[row] = std::move(converted);
+        }
+        isSet[row] = true;
+        return true;
+    }
+
+private:
+    QList<T> values;
+    QList<bool> isSet;
+};
+
+// Stores the values of a column of any other type as variants
+class VariantColumnValues final : public ColumnValues
+{
+public:
+    VariantColumnValues(QMetaType type, int rows) : ColumnValues(type), values(rows) { }
+
+    void insertRows(int row, int count) override { values.insert(row, count, QVariant()); }
+    void removeRows(int row, int count) override { values.remove(row, count); }
+    QVariant value(int row) const override { return values.at(row); }
+    bool setValue(int row, const QVariant &value) override
+    {
+        if (!type.isValid() || !value.isValid() || value.metaType() == type) {
+            values[row] = value;
+            return true;
+        }
+        QVariant converted = value;
+        if (!converted.convert(type))
+            return false;
+        values[row] = std::move(converted);
+        return true;
+    }
+
+private:
+    QList<QVariant> values;
+};
+
+std::unique_ptr<ColumnValues> makeColumnValues(QMetaType type, int rows)
+{
+    switch (type.id()) {
+    case QMetaType::Bool:
+        return std::make_unique<TypedColumnValues<bool>>(type, rows);
+    case QMetaType::Int:
+        return std::make_unique<TypedColumnValues<int>>(type, rows);
+    case QMetaType::UInt:
+        return std::make_unique<TypedColumnValues<uint>>(type, rows);
+    case QMetaType::LongLong:
+        return std::make_unique<TypedColumnValues<qlonglong>>(type, rows);
+    case QMetaType::ULongLong:
+        return std::make_unique<TypedColumnValues<qulonglong>>(type, rows);
+    case QMetaType::Float:
+        return std::make_unique<TypedColumnValues<float>>(type, rows);
+    case QMetaType::Double:
+        return std::make_unique<TypedColumnValues<double>>(type, rows);
+    case QMetaType::QString:
+        return std::make_unique<TypedColumnValues<QString>>(type, rows);
+    default:
+        return std::make_unique<VariantColumnValues>(type, rows);
+    }
+}
+
+// Maps keyed by row only hold the rows that have an entry, so rows inserted or
+// removed before an entry move its key
+template <typename T>
+void insertSparseRows(QMap<int, T> &map, int row, int count)
+{
+    if (map.isEmpty() || map.lastKey() < row)
+        return;
+    QMap<int, T> shifted;
+    for (auto it = map.cbegin(), end = map.cend(); it != end; ++it)
+        shifted.insert(shifted.cend(), it.key() < row ? it.key() : it.key() + count, it.value());
+    map = std::move(shifted);
+}
+
+template <typename T>
+void removeSparseRows(QMap<int, T> &map, int row, int count)
+{
+    if (map.isEmpty() || map.lastKey() < row)
+        return;
+    QMap<int, T> shifted;
+    for (auto it = map.cbegin(), end = map.cend(); it != end; ++it) {
+        if (it.key() < row)
+            shifted.insert(shifted.cend(), it.key(), it.value());
+        else if (it.key() >= row + count)
+            shifted.insert(shifted.cend(), it.key() - count, it.value());
+    }
+    map = std::move(shifted);
+}
+
+} // unnamed namespace
+
+class QColumnarTableModelPrivate : public QAbstractItemModelPrivate
+{
+    Q_DECLARE_PUBLIC(QColumnarTableModel)
+
+public:
+    struct Column
+    {
+        std::unique_ptr<ColumnValues> values;
+        QMap<int, QMap<int, QVariant>> roles; // the other roles of the rows that have any
+        QMap<int, QVariant> header;
+    };
+
+    static Column makeColumn(QMetaType type, int rows)
+    {
+        return Column { makeColumnValues(type, rows), {}, {} };
+    }
+
+    bool isValid(const QModelIndex &index) const
+    {
+        return index.model() == q_func() && index.row() >= 0 && index.row() < rowCount
+                && index.column() >= 0 && index.column() < int(columns.size());
+    }
+
+    // Like QStandardItem, headers don't distinguish between these roles
+    static int headerRole(int role) { return role == Qt::EditRole ? Qt::DisplayRole : role; }
+
+    int rowCount = 0;
+    std::vector<Column> columns;
+    QMap<int, QMap<int, QVariant>> verticalHeaders;
+};
+
+/*!
+    \class QColumnarTableModel
+    \inmodule QtCore
+    \since 6.4
+    \brief The QColumnarTableModel class provides a compact model for large
+    tables of data.
+
+    \ingroup model-view
+
+    QColumnarTableModel stores a table the way a database or a data frame
+    would: the values of each column are kept together in one contiguous
+    array. Unlike QStandardItemModel, which allocates a QStandardItem for
+    each cell, a cell only takes the space of its value, so tables with
+    millions of cells remain cheap to hold and fast to fill.
+
+    The Qt::DisplayRole and Qt::EditRole of a cell share its value. Give a
+    column a type with setColumnType() to store its values unboxed; values
+    set for the column are then converted to that type, and values that
+    cannot be converted are rejected. Columns of type \c bool, \c int,
+    \c uint, \c qlonglong, \c qulonglong, \c float, \c double and QString
+    are stored as plain arrays of that type. Columns of other types, and
+    columns without a type (the default), store QVariants.
+
+    All other roles are stored sparsely, only for the cells that have them.
+    Views that fetch several roles of a cell at once through multiData()
+    get them with a single lookup.
+
+    \snippet code/src_corelib_itemmodels_qcolumnartablemodel.cpp 0
+
+    \sa QStandardItemModel, QAbstractTableModel, {Model/View Programming}
+*/
+
+/*!
+    Constructs an empty table model with the given \a parent.
+*/
+QColumnarTableModel::QColumnarTableModel(QObject *parent)
+    : QAbstractTableModel(*new QColumnarTableModelPrivate, parent)
+{
+}
+
+/*!
+    Constructs a table model with \a rows rows and \a columns columns of
+    empty cells, with the given \a parent.
+*/
+QColumnarTableModel::QColumnarTableModel(int rows, int columns, QObject *parent)
+    : QColumnarTableModel(parent)
+{
+    Q_D(QColumnarTableModel);
+    d->rowCount = qMax(rows, 0);
+    d->columns.reserve(qMax(columns, 0));
+    for (int i = 0; i < columns; ++i)
+        d->columns.push_back(d->makeColumn(QMetaType(), d->rowCount));
+}
+
+/*!
+    Destroys the model.
+*/
+QColumnarTableModel::~QColumnarTableModel() = default;
+
+/*!
+    \reimp
+*/
+int QColumnarTableModel::rowCount(const QModelIndex &parent) const
+{
+    Q_D(const QColumnarTableModel);
+    return parent.isValid() ? 0 : d->rowCount;
+}
+
+/*!
+    \reimp
+*/
+int QColumnarTableModel::columnCount(const QModelIndex &parent) const
+{
+    Q_D(const QColumnarTableModel);
+    return parent.isValid() ? 0 : int(d->columns.size());
+}
+
+/*!
+    \reimp
+*/
+QVariant QColumnarTableModel::data(const QModelIndex &index, int role) const
+{
+    Q_D(const QColumnarTableModel);
+    if (!d->isValid(index))
+        return QVariant();
+    const QColumnarTableModelPrivate::Column &column = d->columns[index.column()];
+    if (role == Qt::DisplayRole || role == Qt::EditRole)
+        return column.values->value(index.row());
+    const auto it = column.roles.constFind(index.row());
+    return it == column.roles.cend() ? QVariant() : it->value(role);
+}
+
+/*!
+    \reimp
+
+    Fills \a roleDataSpan with the data of the cell at \a index, looking the
+    cell up only once for all roles.
+*/
+void QColumnarTableModel::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    Q_D(const QColumnarTableModel);
+    if (!d->isValid(index)) {
+        for (QModelRoleData &roleData : roleDataSpan)
+            roleData.clearData();
+        return;
+    }
+    const QColumnarTableModelPrivate::Column &column = d->columns[index.column()];
+    const auto rolesIt = column.roles.constFind(index.row());
+    const QMap<int, QVariant> *roles = rolesIt == column.roles.cend() ? nullptr : &*rolesIt;
+    for (QModelRoleData &roleData : roleDataSpan) {
+        const int role = roleData.role();
+        if (role == Qt::DisplayRole || role == Qt::EditRole)
+            roleData.setData(column.values->value(index.row()));
+        else if (roles)
+            roleData.setData(roles->value(role));
+        else
+            roleData.clearData();
+    }
+}
+
+/*!
+    \reimp
+
+    Sets the \a role data of the cell at \a index to \a value. For
+    Qt::DisplayRole and Qt::EditRole, \a value is converted to the
+    columnType() of the cell's column, if it has one; returns \c false if
+    that conversion fails.
+*/
+bool QColumnarTableModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    Q_D(QColumnarTableModel);
+    if (!d->isValid(index))
+        return false;
+    QColumnarTableModelPrivate::Column &column = d->columns[index.column()];
+    if (role == Qt::DisplayRole || role == Qt::EditRole) {
+        if (!column.values->setValue(index.row(), value))
+            return false;
+        emit dataChanged(index, index, { Qt::DisplayRole, Qt::EditRole });
+        return true;
+    }
+    if (value.isValid()) {
+        column.roles[index.row()].insert(role, value);
+    } else {
+        const auto it = column.roles.find(index.row());
+        if (it == column.roles.end() || !it->remove(role))
+            return true;
+        if (it->isEmpty())
+            column.roles.erase(it);
+    }
+    emit dataChanged(index, index, { role });
+    return true;
+}
+
+/*!
+    \reimp
+*/
+bool QColumnarTableModel::clearItemData(const QModelIndex &index)
+{
+    Q_D(QColumnarTableModel);
+    if (!d->isValid(index))
+        return false;
+    QColumnarTableModelPrivate::Column &column = d->columns[index.column()];
+    column.values->setValue(index.row(), QVariant());
+    column.roles.remove(index.row());
+    emit dataChanged(index, index, {});
+    return true;
+}
+
+/*!
+    \reimp
+*/
+QMap<int, QVariant> QColumnarTableModel::itemData(const QModelIndex &index) const
+{
+    Q_D(const QColumnarTableModel);
+    QMap<int, QVariant> result;
+    if (!d->isValid(index))
+        return result;
+    const QColumnarTableModelPrivate::Column &column = d->columns[index.column()];
+    const auto it = column.roles.constFind(index.row());
+    if (it != column.roles.cend())
+        result = *it;
+    const QVariant value = column.values->value(index.row());
+    if (value.isValid()) {
+        result.insert(Qt::DisplayRole, value);
+        result.insert(Qt::EditRole, value);
+    }
+    return result;
+}
+
+/*!
+    \reimp
+*/
+QVariant QColumnarTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    Q_D(const QColumnarTableModel);
+    const QMap<int, QVariant> *header = nullptr;
+    if (orientation == Qt::Horizontal) {
+        if (section >= 0 && section < int(d->columns.size()))
+            header = &d->columns[section].header;
+    } else {
+        const auto it = d->verticalHeaders.constFind(section);
+        if (it != d->verticalHeaders.cend())
+            header = &*it;
+    }
+    if (header) {
+        const auto it = header->constFind(d->headerRole(role));
+        if (it != header->cend())
+            return *it;
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+/*!
+    \reimp
+*/
+bool QColumnarTableModel::setHeaderData(int section, Qt::Orientation orientation,
+                                        const QVariant &value, int role)
+{
+    Q_D(QColumnarTableModel);
+    const int count = orientation == Qt::Horizontal ? int(d->columns.size()) : d->rowCount;
+    if (section < 0 || section >= count)
+        return false;
+    role = d->headerRole(role);
+    if (orientation == Qt::Horizontal) {
+        QMap<int, QVariant> &header = d->columns[section].header;
+        if (value.isValid())
+            header.insert(role, value);
+        else
+            header.remove(role);
+    } else if (value.isValid()) {
+        d->verticalHeaders[section].insert(role, value);
+    } else {
+        const auto it = d->verticalHeaders.find(section);
+        if (it != d->verticalHeaders.end()) {
+            it->remove(role);
+            if (it->isEmpty())
+                d->verticalHeaders.erase(it);
+        }
+    }
+    emit headerDataChanged(orientation, section, section);
+    return true;
+}
+
+/*!
+    \reimp
+*/
+Qt::ItemFlags QColumnarTableModel::flags(const QModelIndex &index) const
+{
+    Q_D(const QColumnarTableModel);
+    if (!d->isValid(index))
+        return QAbstractTableModel::flags(index);
+    return QAbstractTableModel::flags(index) | Qt::ItemIsEditable;
+}
+
+/*!
+    \reimp
+*/
+bool QColumnarTableModel::insertRows(int row, int count, const QModelIndex &parent)
+{
+    Q_D(QColumnarTableModel);
+    if (parent.isValid() || count < 1 || row < 0 || row > d->rowCount)
+        return false;
+    beginInsertRows(QModelIndex(), row, row + count - 1);
+    for (QColumnarTableModelPrivate::Column &column : d->columns) {
+        column.values->insertRows(row, count);
+        insertSparseRows(column.roles, row, count);
+    }
+    insertSparseRows(d->verticalHeaders, row, count);
+    d->rowCount += count;
+    endInsertRows();
+    return true;
+}
+
+/*!
+    \reimp
+*/
+bool QColumnarTableModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+    Q_D(QColumnarTableModel);
+    if (parent.isValid() || count < 1 || row < 0 || row > d->rowCount - count)
+        return false;
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    for (QColumnarTableModelPrivate::Column &column : d->columns) {
+        column.values->removeRows(row, count);
+        removeSparseRows(column.roles, row, count);
+    }
+    removeSparseRows(d->verticalHeaders, row, count);
+    d->rowCount -= count;
+    endRemoveRows();
+    return true;
+}
+
+/*!
+    \reimp
+
+    The new columns have no type; see setColumnType().
+*/
+bool QColumnarTableModel::insertColumns(int column, int count, const QModelIndex &parent)
+{
+    Q_D(QColumnarTableModel);
+    if (parent.isValid() || count < 1 || column < 0 || column > int(d->columns.size()))
+        return false;
+    beginInsertColumns(QModelIndex(), column, column + count - 1);
+    std::vector<QColumnarTableModelPrivate::Column> added;
+    added.reserve(count);
+    for (int i = 0; i < count; ++i)
+        added.push_back(d->makeColumn(QMetaType(), d->rowCount));
+    d->columns.insert(d->columns.begin() + column, std::make_move_iterator(added.begin()),
+                      std::make_move_iterator(added.end()));
+    endInsertColumns();
+    return true;
+}
+
+/*!
+    \reimp
+*/
+bool QColumnarTableModel::removeColumns(int column, int count, const QModelIndex &parent)
+{
+    Q_D(QColumnarTableModel);
+    if (parent.isValid() || count < 1 || column < 0 || column > int(d->columns.size()) - count)
+        return false;
+    beginRemoveColumns(QModelIndex(), column, column + count - 1);
+    d->columns.erase(d->columns.begin() + column, d->columns.begin() + column + count);
+    endRemoveColumns();
+    return true;
+}
+
+/*!
+    Sets the number of rows in the model to \a rows, adding empty rows at
+    the end or removing the last rows as needed.
+
+    \sa setColumnCount()
+*/
+void QColumnarTableModel::setRowCount(int rows)
+{
+    Q_D(QColumnarTableModel);
+    if (rows > d->rowCount)
+        insertRows(d->rowCount, rows - d->rowCount);
+    else if (rows >= 0 && rows < d->rowCount)
+        removeRows(rows, d->rowCount - rows);
+}
+
+/*!
+    Sets the number of columns in the model to \a columns, adding columns
+    without a type at the end or removing the last columns as needed.
+
+    \sa setRowCount()
+*/
+void QColumnarTableModel::setColumnCount(int columns)
+{
+    Q_D(QColumnarTableModel);
+    const int count = int(d->columns.size());
+    if (columns > count)
+        insertColumns(count, columns - count);
+    else if (columns >= 0 && columns < count)
+        removeColumns(columns, count - columns);
+}
+
+/*!
+    Returns the type of the values in \a column, or an invalid QMetaType if
+    the column has no type.
+
+    \sa setColumnType()
+*/
+QMetaType QColumnarTableModel::columnType(int column) const
+{
+    Q_D(const QColumnarTableModel);
+    if (column < 0 || column >= int(d->columns.size()))
+        return QMetaType();
+    return d->columns[column].values->type;
+}
+
+/*!
+    Sets the type of the values in \a column to \a type, and returns \c true
+    if \a column exists.
+
+    The values already in the column are converted to \a type. Cells whose
+    value can't be converted become empty. An invalid \a type lets the
+    column hold values of any type.
+
+    \sa columnType()
+*/
+bool QColumnarTableModel::setColumnType(int column, QMetaType type)
+{
+    Q_D(QColumnarTableModel);
+    if (column < 0 || column >= int(d->columns.size()))
+        return false;
+    QColumnarTableModelPrivate::Column &target = d->columns[column];
+    if (target.values->type == type)
+        return true;
+    std::unique_ptr<ColumnValues> values = makeColumnValues(type, d->rowCount);
+    for (int row = 0; row < d->rowCount; ++row)
+        values->setValue(row, target.values->value(row));
+    target.values = std::move(values);
+    if (d->rowCount > 0) {
+        emit dataChanged(index(0, column), index(d->rowCount - 1, column),
+                         { Qt::DisplayRole, Qt::EditRole });
+    }
+    return true;
+}
+
+/*!
+    Removes all rows and columns from the model.
+*/
+void QColumnarTableModel::clear()
+{
+    Q_D(QColumnarTableModel);
+    beginResetModel();
+    d->rowCount = 0;
+    d->columns.clear();
+    d->verticalHeaders.clear();
+    endResetModel();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qcolumnartablemodel.cpp"
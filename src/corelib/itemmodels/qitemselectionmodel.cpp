@@ -458,6 +458,35 @@ bool QItemSelection::contains(const QModelIndex &index) const
     return false;
 }
 
+QItemSelectionRangeIndex::QItemSelectionRangeIndex(const QItemSelection &selection)
+{
+    QHash<QModelIndex, qsizetype> groupOfParent;
+    for (int position = 0; position < selection.size(); ++position) {
+        const QItemSelectionRange &range = selection.at(position);
+        if (!range.isValid())
+            continue;
+        const auto it = groupOfParent.constFind(range.parent());
+        if (it != groupOfParent.constEnd()) {
+            groups[*it].byTop.append(position);
+        } else {
+            groupOfParent.insert(range.parent(), groups.size());
+            groups.emplaceBack(Group{ { position }, {} });
+        }
+    }
+    for (Group &group : groups) {
+        std::stable_sort(group.byTop.begin(), group.byTop.end(), [&selection](int lhs, int rhs) {
+            return selection.at(lhs).top() < selection.at(rhs).top();
+        });
+        group.maxBottom.reserve(group.byTop.size());
+        int lowest = group.byTop.first();
+        for (int position : qAsConst(group.byTop)) {
+            if (selection.at(position).bottom() > selection.at(lowest).bottom())
+                lowest = position;
+            group.maxBottom.append(lowest);
+        }
+    }
+}
+
 /*!
     Returns a list of model indexes that correspond to the selected items.
 */
@@ -495,12 +524,31 @@ void QItemSelection::merge(const QItemSelection &other, QItemSelectionModel::Sel
 
     QItemSelection newSelection;
     newSelection.reserve(other.size());
-    // Collect intersections
+    // Collect intersections; for big selections, only look at the ranges
+    // covering the same rows, so that merging disjoint ranges stays cheap
     QItemSelection intersections;
+    const bool useIndex = count() > 16 && other.size() > 1;
+    const QItemSelectionRangeIndex index = useIndex ? QItemSelectionRangeIndex(*this)
+                                                    : QItemSelectionRangeIndex();
+    QList<int> candidates;
     for (const auto &range : other) {
         if (!range.isValid())
             continue;
         newSelection.push_back(range);
+        if (useIndex) {
+            candidates.clear();
+            index.forEachRangeInRows(*this, range.parent(), range.top(), range.bottom(),
+                                     [&candidates](int position) {
+                candidates.append(position);
+                return false;
+            });
+            std::sort(candidates.begin(), candidates.end());
+            for (int t : qAsConst(candidates)) {
+                if (range.intersects(at(t)))
+                    intersections.append(at(t).intersected(range));
+            }
+            continue;
+        }
         for (int t = 0; t < count(); ++t) {
             if (range.intersects(at(t)))
                 intersections.append(at(t).intersected(range));
@@ -675,6 +723,26 @@ QItemSelection QItemSelectionModelPrivate::expandSelection(const QItemSelection
     return expanded;
 }
 
+/*!
+    \internal
+
+    Returns an index over the ranges of the selection, or \nullptr if there
+    are too few of them for an index to pay off.
+*/
+const QItemSelectionRangeIndex *QItemSelectionModelPrivate::indexedRanges() const
+{
+    if (ranges.size() <= 16) {
+        rangeIndexSource.clear();
+        return nullptr;
+    }
+    if (rangeIndexSource.constData() != ranges.constData()
+        || rangeIndexSource.size() != ranges.size()) {
+        rangeIndexSource = ranges;
+        rangeIndex = QItemSelectionRangeIndex(ranges);
+    }
+    return &rangeIndex;
+}
+
 /*!
     \internal
 */
@@ -1464,11 +1532,20 @@ bool QItemSelectionModel::isSelected(const QModelIndex &index) const
 
     bool selected = false;
     //  search model ranges
-    QList<QItemSelectionRange>::const_iterator it = d->ranges.begin();
-    for (; it != d->ranges.end(); ++it) {
-        if ((*it).isValid() && (*it).contains(index)) {
-            selected = true;
-            break;
+    if (const QItemSelectionRangeIndex *rangeIndex = d->indexedRanges()) {
+        rangeIndex->forEachRangeInRows(d->ranges, index.parent(), index.row(), index.row(),
+                                       [&](int position) {
+            const QItemSelectionRange &range = d->ranges.at(position);
+            selected = range.isValid() && range.contains(index);
+            return selected;
+        });
+    } else {
+        QList<QItemSelectionRange>::const_iterator it = d->ranges.begin();
+        for (; it != d->ranges.end(); ++it) {
+            if ((*it).isValid() && (*it).contains(index)) {
+                selected = true;
+                break;
+            }
         }
     }
 
@@ -54,10 +54,56 @@
 #include "private/qobject_p.h"
 #include "private/qproperty_p.h"
 
+#include <algorithm>
+
 QT_REQUIRE_CONFIG(itemmodel);
 
 QT_BEGIN_NAMESPACE
 
+// Orders the valid ranges of a selection by parent and top row, so that the
+// ranges covering some rows can be found without looking at all of them.
+// Rows are read from the selection's persistent indexes when searching; the
+// model inserting or removing rows keeps their order, so the index remains
+// usable until the selection itself is modified.
+class QItemSelectionRangeIndex
+{
+public:
+    QItemSelectionRangeIndex() = default;
+    explicit QItemSelectionRangeIndex(const QItemSelection &selection);
+
+    // Calls f(position) for the ranges of \a selection under \a parent that
+    // overlap the rows from \a top to \a bottom, until f returns true.
+    template <typename Function>
+    void forEachRangeInRows(const QItemSelection &selection, const QModelIndex &parent,
+                            int top, int bottom, Function f) const
+    {
+        for (const Group &group : groups) {
+            if (selection.at(group.byTop.first()).parent() != parent)
+                continue;
+            const auto end = std::upper_bound(group.byTop.cbegin(), group.byTop.cend(), bottom,
+                                              [&selection](int row, int position) {
+                return row < selection.at(position).top();
+            });
+            for (qsizetype i = end - group.byTop.cbegin() - 1; i >= 0; --i) {
+                // No range starting at or above this one reaches down to top:
+                if (selection.at(group.maxBottom.at(i)).bottom() < top)
+                    break;
+                const int position = group.byTop.at(i);
+                if (selection.at(position).bottom() >= top && f(position))
+                    return;
+            }
+            return;
+        }
+    }
+
+private:
+    struct Group {
+        QList<int> byTop; // positions of the ranges, ordered by top row
+        QList<int> maxBottom; // position of the lowest-reaching range in byTop[0..i]
+    };
+    QList<Group> groups;
+};
+
 class QItemSelectionModelPrivate: public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QItemSelectionModel)
@@ -93,6 +139,8 @@ public:
             currentSelection.clear();
     }
 
+    const QItemSelectionRangeIndex *indexedRanges() const;
+
     void setModel(QAbstractItemModel *mod) { q_func()->setModel(mod); }
     void modelChanged(QAbstractItemModel *mod) { q_func()->modelChanged(mod); }
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(QItemSelectionModelPrivate, QAbstractItemModel *, model,
@@ -111,6 +159,10 @@ public:
     bool tableSelected;
     QPersistentModelIndex tableParent;
     int tableColCount, tableRowCount;
+    // Index over ranges, valid as long as ranges still shares its data with
+    // rangeIndexSource: any modification of ranges detaches it
+    mutable QItemSelection rangeIndexSource;
+    mutable QItemSelectionRangeIndex rangeIndex;
 };
 
 QT_END_NAMESPACE
@@ -47,8 +47,13 @@
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
 #include <private/qproperty_p.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <atomic>
 
 QT_BEGIN_NAMESPACE
 
@@ -200,6 +205,11 @@ public:
         emit q_func()->autoAcceptChildRowsChanged(accept);
     }
 
+    void parallelFilteringEnabledChangedForwarder(bool enabled)
+    {
+        emit q_func()->parallelFilteringEnabledChanged(enabled);
+    }
+
     void setDynamicSortFilterForwarder(bool enable) { q_func()->setDynamicSortFilter(enable); }
 
     void setFilterCaseSensitivityForwarder(Qt::CaseSensitivity cs)
@@ -255,6 +265,10 @@ public:
             &QSortFilterProxyModelPrivate::setAutoAcceptChildRowsForwarder,
             &QSortFilterProxyModelPrivate::autoAcceptChildRowsChangedForwarder, false)
 
+    Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(
+            QSortFilterProxyModelPrivate, bool, parallel_filtering, false,
+            &QSortFilterProxyModelPrivate::parallelFilteringEnabledChangedForwarder)
+
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(QSortFilterProxyModelPrivate, bool, dynamic_sortfilter,
                                        &QSortFilterProxyModelPrivate::setDynamicSortFilterForwarder,
                                        true)
@@ -413,6 +427,12 @@ public:
     bool needsReorder(const QList<int> &source_rows, const QModelIndex &source_parent) const;
 
     bool filterAcceptsRowInternal(int source_row, const QModelIndex &source_parent) const;
+    // Rows are only filtered in parallel when there are enough of them to pay for it
+    static constexpr int ParallelFilterBlockSize = 1024;
+    bool use_parallel_filtering(int source_count) const
+    { return parallel_filtering && source_count >= 2 * ParallelFilterBlockSize; }
+    QList<bool> filter_source_rows_in_parallel(const QModelIndex &source_parent,
+                                               int source_count) const;
     bool recursiveChildAcceptsRow(int source_row, const QModelIndex &source_parent) const;
     bool recursiveParentAcceptsRow(const QModelIndex &source_parent) const;
 };
@@ -449,6 +469,51 @@ bool QSortFilterProxyModelPrivate::filterAcceptsRowInternal(int source_row, cons
     return false;
 }
 
+/*!
+  \internal
+
+  Returns, for each of the first \a source_count rows of \a source_parent,
+  whether the filter accepts it. Blocks of rows are handed out to this thread
+  and to idle threads of the global QThreadPool, so filterAcceptsRow() must be
+  safe to call concurrently; see parallelFilteringEnabled.
+*/
+QList<bool> QSortFilterProxyModelPrivate::filter_source_rows_in_parallel(
+    const QModelIndex &source_parent, int source_count) const
+{
+    QList<bool> accepted(source_count);
+    bool *const acceptedData = accepted.data();
+    const auto filterRows = [&](int from, int to) {
+        for (int i = from; i < to; ++i)
+            acceptedData[i] = filterAcceptsRowInternal(i, source_parent);
+    };
+
+#if QT_CONFIG(thread)
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int blocks = (source_count + ParallelFilterBlockSize - 1) / ParallelFilterBlockSize;
+    if (blocks > 1 && pool->maxThreadCount() > 1) {
+        std::atomic<int> nextBlock = 0;
+        const auto work = [&] {
+            for (int b = nextBlock++; b < blocks; b = nextBlock++) {
+                filterRows(b * ParallelFilterBlockSize,
+                           qMin((b + 1) * ParallelFilterBlockSize, source_count));
+            }
+        };
+        QSemaphore finished;
+        int helpers = 0;
+        // Only tryStart(), so that we can't deadlock when called from a pool thread
+        while (helpers < qMin(pool->maxThreadCount(), blocks) - 1
+               && pool->tryStart([&] { work(); finished.release(); })) {
+            ++helpers;
+        }
+        work();
+        finished.acquire(helpers);
+        return accepted;
+    }
+#endif
+    filterRows(0, source_count);
+    return accepted;
+}
+
 bool QSortFilterProxyModelPrivate::recursiveParentAcceptsRow(const QModelIndex &source_parent) const
 {
     Q_Q(const QSortFilterProxyModel);
@@ -519,9 +584,17 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
 
     int source_rows = model->rowCount(source_parent);
     m->source_rows.reserve(source_rows);
-    for (int i = 0; i < source_rows; ++i) {
-        if (filterAcceptsRowInternal(i, source_parent))
-            m->source_rows.append(i);
+    if (use_parallel_filtering(source_rows)) {
+        const QList<bool> accepted = filter_source_rows_in_parallel(source_parent, source_rows);
+        for (int i = 0; i < source_rows; ++i) {
+            if (accepted.at(i))
+                m->source_rows.append(i);
+        }
+    } else {
+        for (int i = 0; i < source_rows; ++i) {
+            if (filterAcceptsRowInternal(i, source_parent))
+                m->source_rows.append(i);
+        }
     }
     int source_cols = model->columnCount(source_parent);
     m->source_columns.reserve(source_cols);
@@ -1361,25 +1434,34 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     const QModelIndex &source_parent, Qt::Orientation orient)
 {
     Q_Q(QSortFilterProxyModel);
+    int source_count = source_to_proxy.size();
+    // Each source row is checked exactly once below, so we can as well check
+    // them all up front when that can be spread over several threads
+    QList<bool> rows_accepted;
+    if (orient == Qt::Vertical && use_parallel_filtering(source_count))
+        rows_accepted = filter_source_rows_in_parallel(source_parent, source_count);
+    const auto accepts = [&](int source_item) {
+        if (orient == Qt::Horizontal)
+            return q->filterAcceptsColumn(source_item, source_parent);
+        if (!rows_accepted.isEmpty())
+            return rows_accepted.at(source_item);
+        return filterAcceptsRowInternal(source_item, source_parent);
+    };
+
     // Figure out which mapped items to remove
     QList<int> source_items_remove;
     for (int i = 0; i < proxy_to_source.count(); ++i) {
         const int source_item = proxy_to_source.at(i);
-        if ((orient == Qt::Vertical)
-            ? !filterAcceptsRowInternal(source_item, source_parent)
-            : !q->filterAcceptsColumn(source_item, source_parent)) {
+        if (!accepts(source_item)) {
             // This source item does not satisfy the filter, so it must be removed
             source_items_remove.append(source_item);
         }
     }
     // Figure out which non-mapped items to insert
     QList<int> source_items_insert;
-    int source_count = source_to_proxy.size();
     for (int source_item = 0; source_item < source_count; ++source_item) {
         if (source_to_proxy.at(source_item) == -1) {
-            if ((orient == Qt::Vertical)
-                ? filterAcceptsRowInternal(source_item, source_parent)
-                : q->filterAcceptsColumn(source_item, source_parent)) {
+            if (accepts(source_item)) {
                 // This source item satisfies the filter, so it must be added
                 source_items_insert.append(source_item);
             }
@@ -3133,6 +3215,54 @@ QBindable<bool> QSortFilterProxyModel::bindableAutoAcceptChildRows()
     return QBindable<bool>(&d->accept_children);
 }
 
+/*!
+    \since 6.4
+    \property QSortFilterProxyModel::parallelFilteringEnabled
+    \brief whether filterAcceptsRow() may be called for several rows at once
+    from the threads of the global QThreadPool.
+
+    When this property is true and the proxy model has to filter many rows
+    of the same parent at once, for instance after the filter was changed or
+    when the rows of a parent are mapped for the first time, the rows are
+    split into blocks that are filtered in parallel. The proxy model waits
+    for all of them, and updates itself and emits its signals from its own
+    thread as usual.
+
+    Only enable this if your reimplementation of filterAcceptsRow(), and the
+    parts of the source model it reads, are safe to call from several threads
+    at once while the thread of the proxy model is blocked. The default
+    implementation only reads data() of the source model.
+
+    The default value is false.
+
+    \sa filterAcceptsRow(), QThreadPool::globalInstance()
+*/
+
+/*!
+    \since 6.4
+    \fn void QSortFilterProxyModel::parallelFilteringEnabledChanged(bool parallelFilteringEnabled)
+
+    This signal is emitted when the value of the \a parallelFilteringEnabled
+    property is changed.
+*/
+bool QSortFilterProxyModel::isParallelFilteringEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->parallel_filtering;
+}
+
+void QSortFilterProxyModel::setParallelFilteringEnabled(bool enabled)
+{
+    Q_D(QSortFilterProxyModel);
+    d->parallel_filtering = enabled;
+}
+
+QBindable<bool> QSortFilterProxyModel::bindableParallelFilteringEnabled()
+{
+    Q_D(QSortFilterProxyModel);
+    return QBindable<bool>(&d->parallel_filtering);
+}
+
 /*!
    \since 4.3
 
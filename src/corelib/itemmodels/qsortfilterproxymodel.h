@@ -82,6 +82,9 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
                BINDABLE bindableRecursiveFilteringEnabled)
     Q_PROPERTY(bool autoAcceptChildRows READ autoAcceptChildRows WRITE setAutoAcceptChildRows
                NOTIFY autoAcceptChildRowsChanged BINDABLE bindableAutoAcceptChildRows)
+    Q_PROPERTY(bool parallelFilteringEnabled READ isParallelFilteringEnabled
+               WRITE setParallelFilteringEnabled NOTIFY parallelFilteringEnabledChanged
+               BINDABLE bindableParallelFilteringEnabled)
 
 public:
     explicit QSortFilterProxyModel(QObject *parent = nullptr);
@@ -137,6 +140,10 @@ public:
     void setAutoAcceptChildRows(bool accept);
     QBindable<bool> bindableAutoAcceptChildRows();
 
+    bool isParallelFilteringEnabled() const;
+    void setParallelFilteringEnabled(bool enabled);
+    QBindable<bool> bindableParallelFilteringEnabled();
+
 public Q_SLOTS:
     void setFilterRegularExpression(const QString &pattern);
     void setFilterRegularExpression(const QRegularExpression &regularExpression);
@@ -204,6 +211,7 @@ Q_SIGNALS:
     void filterRoleChanged(int filterRole);
     void recursiveFilteringEnabledChanged(bool recursiveFilteringEnabled);
     void autoAcceptChildRowsChanged(bool autoAcceptChildRows);
+    void parallelFilteringEnabledChanged(bool parallelFilteringEnabled);
 
 private:
     Q_DECLARE_PRIVATE(QSortFilterProxyModel)
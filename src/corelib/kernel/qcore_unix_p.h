@@ -294,6 +294,28 @@ static inline qint64 qt_safe_write(int fd, const void *data, qint64 len)
 #undef QT_WRITE
 #define QT_WRITE qt_safe_write
 
+static inline qint64 qt_safe_pread(int fd, void *data, qint64 maxlen, qint64 offset)
+{
+    qint64 ret = 0;
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+    EINTR_LOOP(ret, ::pread64(fd, data, maxlen, QT_OFF_T(offset)));
+#else
+    EINTR_LOOP(ret, ::pread(fd, data, maxlen, QT_OFF_T(offset)));
+#endif
+    return ret;
+}
+
+static inline qint64 qt_safe_pwrite(int fd, const void *data, qint64 len, qint64 offset)
+{
+    qint64 ret = 0;
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+    EINTR_LOOP(ret, ::pwrite64(fd, data, len, QT_OFF_T(offset)));
+#else
+    EINTR_LOOP(ret, ::pwrite(fd, data, len, QT_OFF_T(offset)));
+#endif
+    return ret;
+}
+
 static inline qint64 qt_safe_write_nosignal(int fd, const void *data, qint64 len)
 {
     qt_ignore_sigpipe();
@@ -55,6 +55,7 @@
 #include <qfile.h>
 #include <qfileinfo.h>
 #include <qmutex.h>
+#include <qreadwritelock.h>
 #include <private/qloggingregistry_p.h>
 #include <qscopeguard.h>
 #include <qstandardpaths.h>
@@ -65,6 +66,8 @@
 #include <QtCore/qpromise.h>
 #endif
 #include <private/qthread_p.h>
+#include <private/qcoremetrics_p.h>
+#include <private/qstartuptimeline_p.h>
 #if QT_CONFIG(thread)
 #include <qthreadpool.h>
 #endif
@@ -134,6 +137,8 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <typeinfo>
 
 QT_BEGIN_NAMESPACE
 
@@ -357,6 +362,8 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
+    const auto locker = qt_scoped_lock(currentThreadData->postEventList.mutex);
+    currentThreadData->takeIncomingPostedEvents();
     return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
 }
 
@@ -467,6 +474,7 @@ QCoreApplicationPrivate::QCoreApplicationPrivate(int &aargc, char **aargv, uint
 #endif // Q_OS_WIN
 
 #ifndef QT_NO_QOBJECT
+    QStartupTimeline::start();
     QCoreApplicationPrivate::is_app_closing = false;
 
 #  if defined(Q_OS_UNIX)
@@ -505,6 +513,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->takeIncomingPostedEvents();
         for (int i = 0; i < thisThreadData->postEventList.size(); ++i) {
             const QPostEvent &pe = thisThreadData->postEventList.at(i);
             if (pe.event) {
@@ -514,6 +523,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
             }
         }
         thisThreadData->postEventList.clear();
+        thisThreadData->postEventList.compressibleEvents.clear();
         thisThreadData->postEventList.recursion = 0;
         thisThreadData->quitNow = false;
         threadData_clean = true;
@@ -774,6 +784,9 @@ QCoreApplication::QCoreApplication(int &argc, char **argv
 void QCoreApplicationPrivate::init()
 {
     Q_TRACE_SCOPE(QCoreApplicationPrivate_init);
+#ifndef QT_NO_QOBJECT
+    QStartupTimelineScope timelineScope("QCoreApplicationPrivate::init");
+#endif
 
 #if defined(Q_OS_MACOS)
     QMacAutoReleasePool pool;
@@ -887,6 +900,8 @@ QCoreApplication::~QCoreApplication()
 
     self = nullptr;
 #ifndef QT_NO_QOBJECT
+    // the application quit before it finished starting up
+    QStartupTimeline::finish();
     QCoreApplicationPrivate::is_app_closing = true;
     QCoreApplicationPrivate::is_app_running = false;
 #endif
@@ -1216,6 +1231,7 @@ bool QCoreApplicationPrivate::notify_helper(QObject *receiver, QEvent * event)
     bool consumed = false;
     bool filtered = false;
     Q_TRACE_EXIT(QCoreApplication_notify_exit, consumed, filtered);
+    QMetricScopedTimer notifyTimer(QCoreMetrics::eventNotifyTime);
 
     // send to all application event filters (only does anything in the main thread)
     if (QCoreApplication::self
@@ -1385,6 +1401,11 @@ int QCoreApplication::exec()
     QEventLoop eventLoop;
     self->d_func()->in_exec = true;
     self->d_func()->aboutToQuitEmitted = false;
+    // GUI applications have started up once their first window is exposed
+    if (self->d_func()->application_type == QCoreApplicationPrivate::Tty) {
+        QStartupTimeline::mark("QCoreApplication::exec");
+        QStartupTimeline::finish();
+    }
     int returnCode = eventLoop.exec(QEventLoop::ApplicationExec);
     threadData->quitNow = false;
 
@@ -1578,6 +1599,10 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // keep the order of events posted from this thread through
+    // postMetaCallEvent() and through here
+    data->takeIncomingPostedEvents();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1616,9 +1641,15 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
     data->postEventList.addEvent(QPostEvent(receiver, event, priority));
     eventDeleter.take();
+    if (QCoreApplicationPrivate::isCompressibleEventType(event->type()))
+        data->postEventList.indexCompressibleEvent(QPostEvent(receiver, event, priority));
     event->m_posted = true;
     ++receiver->d_func()->postedEvents;
     data->canWait = false;
+    if (QCoreMetrics::isEnabled()) {
+        QCoreMetrics::postedEventQueueDepth.record(data->postEventList.size()
+                                                   - data->postEventList.startOffset);
+    }
     locker.unlock();
 
     QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
@@ -1626,6 +1657,145 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+  \internal
+
+  Posts the queued meta-call \a event to \a receiver without taking the
+  receiver thread's post event list mutex: the event is pushed onto the
+  lock-free QPostEventList::incoming stack and moved into the list, with
+  Qt::NormalEventPriority, the next time the list is locked. Meta-call events
+  are never compressed, so this is equivalent to postEvent().
+
+  The caller must hold the receiver's signal/slot lock, which keeps the
+  receiver from being destroyed (but not from changing threads) meanwhile.
+*/
+void QCoreApplicationPrivate::postMetaCallEvent(QObject *receiver, QMetaCallEvent *event)
+{
+    Q_ASSERT(receiver && event);
+
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    QThreadData *data = threadData.loadAcquire();
+    if (!data) {
+        delete event;
+        return;
+    }
+
+    event->m_posted = true;
+    event->postedReceiver_ = receiver;
+    QMetaCallEvent *head = data->postEventList.incoming.loadRelaxed();
+    do {
+        event->nextPosted_ = head;
+    } while (!data->postEventList.incoming.testAndSetOrdered(head, event, head));
+
+    // QObject::moveToThread() stores the new thread data and then takes the
+    // incoming events of the old one; we push and then check the thread
+    // data. With both sides fenced, either it saw our event or we see the
+    // move.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (Q_UNLIKELY(threadData.loadAcquire() != data)) {
+        auto locker = qt_unique_lock(data->postEventList.mutex);
+        data->takeIncomingPostedEvents();
+        // if the event is not set aside, the move (or a later one) took it along
+        const bool misrouted = data->postEventList.misrouted.removeOne(event);
+        locker.unlock();
+        if (misrouted) {
+            event->m_posted = false;
+            event->postedReceiver_ = nullptr;
+            QCoreApplication::postEvent(receiver, event);
+        }
+        return;
+    }
+
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
+namespace {
+struct CompressibleEventTypes
+{
+    QReadWriteLock lock;
+    QHash<int, QCoreApplication::EventMergeFunction> mergeFunctions;
+};
+}
+
+Q_GLOBAL_STATIC(CompressibleEventTypes, compressibleEventTypes)
+static QBasicAtomicInt customCompressibleEventTypeCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*!
+    \typealias QCoreApplication::EventMergeFunction
+    \since 6.4
+
+    Type of the functions passed to registerCompressibleEventType(). The
+    function is called with the \c pending event, which is still in the
+    queue, and the newly \c posted event, which is deleted afterwards.
+*/
+
+/*!
+    \since 6.4
+    \threadsafe
+
+    Makes postEvent() compress events of the custom \a type: when such an
+    event is posted to a receiver that already has one of the same type
+    pending, only one event stays in the queue.
+
+    If \a merge is \nullptr, the pending event is kept and the new one is
+    discarded. Otherwise \a merge is called with both events so that it can
+    update the pending event, for instance by copying over the payload of
+    the newer one; the posted event is deleted after it returns. \a merge is
+    called with the receiver's event queue locked and must not post events.
+
+    Finding the pending event does not depend on the number of events in
+    the queue. \a type must be between QEvent::User and QEvent::MaxUser.
+
+    \sa postEvent(), QEvent::registerEventType()
+*/
+void QCoreApplication::registerCompressibleEventType(QEvent::Type type, EventMergeFunction merge)
+{
+    if (type < QEvent::User || type > QEvent::MaxUser) {
+        qWarning("QCoreApplication::registerCompressibleEventType: Invalid event type %d", int(type));
+        return;
+    }
+    auto *types = compressibleEventTypes();
+    const QWriteLocker locker(&types->lock);
+    types->mergeFunctions.insert(type, merge);
+    customCompressibleEventTypeCount.storeRelease(int(types->mergeFunctions.size()));
+}
+
+/*!
+  \internal
+  Returns \c true if events of \a type are kept in QPostEventList's index of
+  compressible events. For custom types, \a merge receives the function
+  registered with QCoreApplication::registerCompressibleEventType().
+*/
+bool QCoreApplicationPrivate::isCompressibleEventType(int type, QCoreApplication::EventMergeFunction *merge)
+{
+    switch (type) {
+    case QEvent::Quit:
+    case QEvent::UpdateRequest:
+    case QEvent::LayoutRequest:
+    case QEvent::Resize:
+    case QEvent::Move:
+    case QEvent::LanguageChange:
+        return true;
+    default:
+        break;
+    }
+    if (type < QEvent::User || !customCompressibleEventTypeCount.loadAcquire())
+        return false;
+    auto *types = compressibleEventTypes();
+    if (!types)
+        return false;
+    const QReadLocker locker(&types->lock);
+    const auto it = types->mergeFunctions.constFind(type);
+    if (it == types->mergeFunctions.cend())
+        return false;
+    if (merge)
+        *merge = it.value();
+    return true;
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1664,18 +1834,25 @@ bool QCoreApplication::compressEvent(QEvent *event, QObject *receiver, QPostEven
     }
 
     if (event->type() == QEvent::Quit && receiver->d_func()->postedEvents > 0) {
-        for (int i = 0; i < postedEvents->size(); ++i) {
-            const QPostEvent &cur = postedEvents->at(i);
-            if (cur.receiver != receiver
-                    || cur.event == nullptr
-                    || cur.event->type() != event->type())
-                continue;
+        if (postedEvents->pendingCompressibleEvent(receiver, QEvent::Quit)) {
             // found an event for this receiver
             delete event;
             return true;
         }
     }
 
+    EventMergeFunction merge = nullptr;
+    if (event->type() >= QEvent::User
+            && QCoreApplicationPrivate::isCompressibleEventType(event->type(), &merge)) {
+        QEvent *pending = postedEvents->pendingCompressibleEvent(receiver, event->type());
+        if (!pending)
+            return false;
+        if (merge)
+            merge(pending, event);
+        delete event;
+        return true;
+    }
+
     return false;
 }
 
@@ -1723,6 +1900,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->takeIncomingPostedEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1836,6 +2014,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
         // next, update the data structure so that we're ready
         // for the next event.
+        data->postEventList.forgetCompressibleEvent(pe);
         const_cast<QPostEvent &>(pe).event = nullptr;
 
         locker.unlock();
@@ -1877,6 +2056,8 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     QThreadData *data = locker.threadData;
+    if (data)
+        data->takeIncomingPostedEvents();
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1898,6 +2079,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
             && (pe.event && (eventType == 0 || pe.event->type() == eventType))) {
             --pe.receiver->d_func()->postedEvents;
             pe.event->m_posted = false;
+            data->postEventList.forgetCompressibleEvent(pe);
             events.append(pe.event);
             const_cast<QPostEvent &>(pe).event = nullptr;
         } else if (!data->postEventList.recursion) {
@@ -1940,6 +2122,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->takeIncomingPostedEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -1960,6 +2143,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
 #endif
             --pe.receiver->d_func()->postedEvents;
             pe.event->m_posted = false;
+            data->postEventList.forgetCompressibleEvent(pe);
             delete pe.event;
             const_cast<QPostEvent &>(pe).event = nullptr;
             return;
@@ -2129,6 +2313,7 @@ bool QCoreApplication::installTranslator(QTranslator *translationFile)
     {
         QWriteLocker locker(&d->translateMutex);
         d->translators.prepend(translationFile);
+        d->updateTranslationCache();
     }
 
 #ifndef QT_NO_TRANSLATION_BUILDER
@@ -2163,6 +2348,7 @@ bool QCoreApplication::removeTranslator(QTranslator *translationFile)
     QCoreApplicationPrivate *d = self->d_func();
     QWriteLocker locker(&d->translateMutex);
     if (d->translators.removeAll(translationFile)) {
+        d->updateTranslationCache();
 #ifndef QT_NO_QOBJECT
         locker.unlock();
         if (!self->closingDown()) {
@@ -2246,7 +2432,10 @@ QString QCoreApplication::translate(const char *context, const char *sourceText,
     if (self) {
         QCoreApplicationPrivate *d = self->d_func();
         QReadLocker locker(&d->translateMutex);
-        if (!d->translators.isEmpty()) {
+        uint generation = 0;
+        if (!d->translators.isEmpty()
+                && !d->findCachedTranslation(context, sourceText, disambiguation, n,
+                                             &result, &generation)) {
             QList<QTranslator*>::ConstIterator it;
             QTranslator *translationFile;
             for (it = d->translators.constBegin(); it != d->translators.constEnd(); ++it) {
@@ -2255,6 +2444,7 @@ QString QCoreApplication::translate(const char *context, const char *sourceText,
                 if (!result.isNull())
                     break;
             }
+            d->cacheTranslation(context, sourceText, disambiguation, n, result, generation);
         }
     }
 
@@ -2280,6 +2470,86 @@ bool QCoreApplicationPrivate::isTranslatorInstalled(QTranslator *translator)
     return d->translators.contains(translator);
 }
 
+static inline QByteArray rawTranslationString(const char *str)
+{
+    return str ? QByteArray::fromRawData(str, qstrlen(str)) : QByteArray();
+}
+
+/*
+    Looks up the result of a previous translate() call, so that strings
+    that are translated often don't need a lookup in every installed
+    translator. Must be called with translateMutex locked; \a generation
+    must be passed to cacheTranslation() when the result was not found.
+*/
+bool QCoreApplicationPrivate::findCachedTranslation(const char *context, const char *sourceText,
+                                                    const char *disambiguation, int n,
+                                                    QString *result, uint *generation)
+{
+    if (!translationCacheEnabled)
+        return false;
+
+    QReadLocker locker(&translationCacheLock);
+    *generation = translationCacheGeneration;
+    const auto contextCache = translationCache.constFind(rawTranslationString(context));
+    if (contextCache == translationCache.constEnd())
+        return false;
+    const TranslationKey key = { rawTranslationString(sourceText),
+                                 rawTranslationString(disambiguation), n };
+    const auto it = contextCache->constFind(key);
+    if (it == contextCache->constEnd())
+        return false;
+    *result = it.value();
+    return true;
+}
+
+void QCoreApplicationPrivate::cacheTranslation(const char *context, const char *sourceText,
+                                               const char *disambiguation, int n,
+                                               const QString &result, uint generation)
+{
+    // keeps the cache small for messages with ever changing plural counts
+    constexpr qsizetype MaxCachedTranslationsPerContext = 4096;
+
+    if (!translationCacheEnabled)
+        return;
+
+    QWriteLocker locker(&translationCacheLock);
+    // a translator was loaded again while we were looking up the message
+    if (generation != translationCacheGeneration)
+        return;
+    TranslationContextCache &contextCache = translationCache[QByteArray(context)];
+    if (contextCache.size() >= MaxCachedTranslationsPerContext)
+        contextCache.clear();
+    contextCache.insert({ QByteArray(sourceText), QByteArray(disambiguation), n }, result);
+}
+
+/*
+    Enables the translation cache if all installed translators are plain
+    QTranslator objects; subclasses may return different translations for
+    the same message. Must be called with translateMutex locked for writing.
+*/
+void QCoreApplicationPrivate::updateTranslationCache()
+{
+    translationCacheEnabled = std::all_of(translators.cbegin(), translators.cend(),
+                                          [](QTranslator *translator) {
+        return typeid(*translator) == typeid(QTranslator);
+    });
+
+    QWriteLocker locker(&translationCacheLock);
+    translationCache.clear();
+    ++translationCacheGeneration;
+}
+
+void QCoreApplicationPrivate::clearTranslationCache(QTranslator *translator)
+{
+    if (!isTranslatorInstalled(translator))
+        return;
+
+    QCoreApplicationPrivate *d = QCoreApplication::self->d_func();
+    QWriteLocker locker(&d->translationCacheLock);
+    d->translationCache.clear();
+    ++d->translationCacheGeneration;
+}
+
 #else
 
 QString QCoreApplication::translate(const char *context, const char *sourceText,
@@ -130,6 +130,8 @@ public:
     static void postEvent(QObject *receiver, QEvent *event, int priority = Qt::NormalEventPriority);
     static void sendPostedEvents(QObject *receiver = nullptr, int event_type = 0);
     static void removePostedEvents(QObject *receiver, int eventType = 0);
+    using EventMergeFunction = void (*)(QEvent *pending, QEvent *posted);
+    static void registerCompressibleEventType(QEvent::Type type, EventMergeFunction merge = nullptr);
     static QAbstractEventDispatcher *eventDispatcher();
     static void setEventDispatcher(QAbstractEventDispatcher *eventDispatcher);
 
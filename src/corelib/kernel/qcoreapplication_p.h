@@ -125,6 +125,7 @@ public:
     virtual void createEventDispatcher();
     virtual void eventDispatcherReady();
     static void removePostedEvent(QEvent *);
+    static bool isCompressibleEventType(int type, QCoreApplication::EventMergeFunction *merge = nullptr);
 #ifdef Q_OS_WIN
     static void removePostedTimerEvent(QObject *object, int timerId);
 #endif
@@ -141,6 +142,7 @@ public:
     static bool threadRequiresCoreApplication();
 
     static void sendPostedEvents(QObject *receiver, int event_type, QThreadData *data);
+    static void postMetaCallEvent(QObject *receiver, QMetaCallEvent *event);
 
     static void checkReceiverThread(QObject *receiver);
     void cleanupThreadData();
@@ -167,6 +169,40 @@ public:
     QTranslatorList translators;
     QReadWriteLock translateMutex;
     static bool isTranslatorInstalled(QTranslator *translator);
+
+    // Results of looking up a message in all installed translators, per
+    // context. Only used while all of them are plain QTranslator objects,
+    // whose translations don't change until they are loaded again.
+    struct TranslationKey
+    {
+        QByteArray sourceText;
+        QByteArray disambiguation;
+        int n;
+
+        friend bool operator==(const TranslationKey &lhs, const TranslationKey &rhs) noexcept
+        {
+            return lhs.n == rhs.n && lhs.sourceText == rhs.sourceText
+                    && lhs.disambiguation == rhs.disambiguation;
+        }
+        friend size_t qHash(const TranslationKey &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.sourceText, key.disambiguation, key.n);
+        }
+    };
+    using TranslationContextCache = QHash<TranslationKey, QString>;
+    QHash<QByteArray, TranslationContextCache> translationCache;
+    QReadWriteLock translationCacheLock;
+    uint translationCacheGeneration = 0;
+    bool translationCacheEnabled = false; // guarded by translateMutex
+
+    bool findCachedTranslation(const char *context, const char *sourceText,
+                               const char *disambiguation, int n,
+                               QString *result, uint *generation);
+    void cacheTranslation(const char *context, const char *sourceText,
+                          const char *disambiguation, int n,
+                          const QString &result, uint generation);
+    void updateTranslationCache();
+    static void clearTranslationCache(QTranslator *translator);
 #endif
 
     QCoreApplicationPrivate::Type application_type;
@@ -0,0 +1,264 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "qcoremetrics_p.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/private/qthread_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QCoreMetrics
+    \inmodule QtCore
+
+    \brief QCoreMetrics collects counters and histograms about the health of
+    the event loops and thread pools of the application.
+
+    When enabled with setEnabled(), the event dispatcher, event delivery,
+    posted event queues, timers and QThreadPool feed the built-in histograms.
+    Applications can register their own QMetricCounter and QMetricHistogram
+    objects. snapshot() returns the current values of all metrics, and
+    toPrometheusText() formats them in the Prometheus text exposition format,
+    ready to be served from a scrape endpoint.
+*/
+
+QBasicAtomicInt QCoreMetrics::enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+QMetricHistogram QCoreMetrics::eventLoopBusyTime(
+        "qt_event_loop_busy_seconds",
+        "Time an event loop iteration spent processing rather than waiting for events",
+        QMetricHistogram::Nanoseconds, 10);
+QMetricHistogram QCoreMetrics::eventNotifyTime(
+        "qt_event_notify_seconds",
+        "Time spent delivering an event to its receiver, including event filters",
+        QMetricHistogram::Nanoseconds, 10);
+QMetricHistogram QCoreMetrics::postedEventQueueDepth(
+        "qt_posted_event_queue_depth",
+        "Events pending in the receiving thread's queue after an event was posted",
+        QMetricHistogram::Count);
+QMetricHistogram QCoreMetrics::timerLateness(
+        "qt_timer_lateness_seconds",
+        "Delay between a timer's timeout and its activation",
+        QMetricHistogram::Nanoseconds, 10);
+QMetricHistogram QCoreMetrics::threadPoolQueueLength(
+        "qt_thread_pool_queue_length",
+        "Tasks waiting in a QThreadPool queue after a task was queued",
+        QMetricHistogram::Count);
+QMetricHistogram QCoreMetrics::threadPoolWaitTime(
+        "qt_thread_pool_wait_seconds",
+        "Time a task spent in a QThreadPool queue before a thread picked it up",
+        QMetricHistogram::Nanoseconds, 10);
+
+static QMetricHistogram *const builtinHistograms[] = {
+    &QCoreMetrics::eventLoopBusyTime,
+    &QCoreMetrics::eventNotifyTime,
+    &QCoreMetrics::postedEventQueueDepth,
+    &QCoreMetrics::timerLateness,
+    &QCoreMetrics::threadPoolQueueLength,
+    &QCoreMetrics::threadPoolWaitTime,
+};
+
+namespace {
+struct QMetricRegistry
+{
+    QMutex mutex;
+    QList<QMetricCounter *> counters;
+    QList<QMetricHistogram *> histograms;
+};
+}
+Q_GLOBAL_STATIC(QMetricRegistry, metricRegistry)
+
+quint64 QMetricHistogram::count() const noexcept
+{
+    quint64 total = 0;
+    for (const auto &bucket : m_buckets)
+        total += bucket.load(std::memory_order_relaxed);
+    return total;
+}
+
+void QMetricHistogram::reset() noexcept
+{
+    for (auto &bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+}
+
+void QCoreMetrics::setEnabled(bool enable) noexcept
+{
+    enabled.storeRelaxed(enable);
+}
+
+void QCoreMetrics::registerMetric(QMetricCounter *counter)
+{
+    QMetricRegistry *registry = metricRegistry();
+    QMutexLocker locker(&registry->mutex);
+    if (!registry->counters.contains(counter))
+        registry->counters.append(counter);
+}
+
+void QCoreMetrics::registerMetric(QMetricHistogram *histogram)
+{
+    QMetricRegistry *registry = metricRegistry();
+    QMutexLocker locker(&registry->mutex);
+    if (!registry->histograms.contains(histogram))
+        registry->histograms.append(histogram);
+}
+
+void QCoreMetrics::unregisterMetric(QMetricCounter *counter)
+{
+    if (QMetricRegistry *registry = metricRegistry()) {
+        QMutexLocker locker(&registry->mutex);
+        registry->counters.removeOne(counter);
+    }
+}
+
+void QCoreMetrics::unregisterMetric(QMetricHistogram *histogram)
+{
+    if (QMetricRegistry *registry = metricRegistry()) {
+        QMutexLocker locker(&registry->mutex);
+        registry->histograms.removeOne(histogram);
+    }
+}
+
+static QMetricSample sample(const QMetricCounter *counter)
+{
+    QMetricSample result;
+    result.name = counter->name();
+    result.help = counter->help();
+    result.type = QMetricSample::Counter;
+    result.count = counter->value();
+    return result;
+}
+
+static QMetricSample sample(const QMetricHistogram *histogram)
+{
+    const double scale = histogram->unit() == QMetricHistogram::Nanoseconds ? 1e-9 : 1;
+
+    QMetricSample result;
+    result.name = histogram->name();
+    result.help = histogram->help();
+    result.type = QMetricSample::Histogram;
+    result.sum = histogram->sum() * scale;
+    result.buckets.reserve(QMetricHistogram::BucketCount);
+    quint64 cumulative = 0;
+    for (int i = 0; i < QMetricHistogram::BucketCount; ++i) {
+        cumulative += histogram->bucketCount(i);
+        result.buckets.append({ histogram->upperBound(i) * scale, cumulative });
+    }
+    // the buckets are read one at a time while other threads keep recording,
+    // so take the total from them rather than from a separate read
+    result.count = cumulative + histogram->bucketCount(QMetricHistogram::BucketCount);
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns the current values of the built-in and of all registered metrics.
+*/
+QList<QMetricSample> QCoreMetrics::snapshot()
+{
+    QList<QMetricSample> samples;
+    for (const QMetricHistogram *histogram : builtinHistograms)
+        samples.append(sample(histogram));
+
+    QMetricRegistry *registry = metricRegistry();
+    QMutexLocker locker(&registry->mutex);
+    for (const QMetricCounter *counter : qAsConst(registry->counters))
+        samples.append(sample(counter));
+    for (const QMetricHistogram *histogram : qAsConst(registry->histograms))
+        samples.append(sample(histogram));
+    return samples;
+}
+
+/*!
+    \internal
+
+    Formats \a samples in the Prometheus text exposition format, version 0.0.4.
+*/
+QByteArray QCoreMetrics::toPrometheusText(const QList<QMetricSample> &samples)
+{
+    QByteArray text;
+    for (const QMetricSample &sample : samples) {
+        text += "# HELP " + sample.name + ' ' + sample.help + '\n';
+        if (sample.type == QMetricSample::Counter) {
+            text += "# TYPE " + sample.name + " counter\n";
+            text += sample.name + ' ' + QByteArray::number(sample.count) + '\n';
+            continue;
+        }
+
+        text += "# TYPE " + sample.name + " histogram\n";
+        for (const auto &bucket : sample.buckets) {
+            text += sample.name + "_bucket{le=\"" + QByteArray::number(bucket.first, 'g', 10)
+                    + "\"} " + QByteArray::number(bucket.second) + '\n';
+        }
+        text += sample.name + "_bucket{le=\"+Inf\"} " + QByteArray::number(sample.count) + '\n';
+        text += sample.name + "_sum " + QByteArray::number(sample.sum, 'g', 10) + '\n';
+        text += sample.name + "_count " + QByteArray::number(sample.count) + '\n';
+    }
+    return text;
+}
+
+/*!
+    \internal
+
+    Resets the built-in and all registered metrics to zero.
+*/
+void QCoreMetrics::reset()
+{
+    for (QMetricHistogram *histogram : builtinHistograms)
+        histogram->reset();
+
+    QMetricRegistry *registry = metricRegistry();
+    QMutexLocker locker(&registry->mutex);
+    for (QMetricCounter *counter : qAsConst(registry->counters))
+        counter->reset();
+    for (QMetricHistogram *histogram : qAsConst(registry->histograms))
+        histogram->reset();
+}
+
+qsizetype QCoreMetrics::postedEventCount(QThread *thread)
+{
+    QThreadData *data = QThreadData::get2(thread);
+    QMutexLocker locker(&data->postEventList.mutex);
+    return data->postEventList.size() - data->postEventList.startOffset;
+}
+
+QT_END_NAMESPACE
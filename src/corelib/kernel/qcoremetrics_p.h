@@ -0,0 +1,217 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QCOREMETRICS_P_H
+#define QCOREMETRICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/private/qglobal_p.h>
+
+#include <atomic>
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+
+class QMetricCounter
+{
+public:
+    constexpr QMetricCounter(const char *name, const char *help) noexcept
+        : m_name(name), m_help(help)
+    {}
+    Q_DISABLE_COPY_MOVE(QMetricCounter)
+
+    const char *name() const noexcept { return m_name; }
+    const char *help() const noexcept { return m_help; }
+
+    void add(quint64 n = 1) noexcept { m_value.fetch_add(n, std::memory_order_relaxed); }
+    quint64 value() const noexcept { return m_value.load(std::memory_order_relaxed); }
+    void reset() noexcept { m_value.store(0, std::memory_order_relaxed); }
+
+private:
+    const char *m_name;
+    const char *m_help;
+    std::atomic<quint64> m_value = {};
+};
+
+// Values are counted in buckets whose upper bounds are consecutive powers of
+// two, starting at 2^firstBucketShift, plus one bucket for everything larger.
+class Q_CORE_EXPORT QMetricHistogram
+{
+public:
+    enum Unit {
+        Count,
+        Nanoseconds     // exported in seconds
+    };
+    static constexpr int BucketCount = 24;
+
+    constexpr QMetricHistogram(const char *name, const char *help, Unit unit,
+                               int firstBucketShift = 0) noexcept
+        : m_name(name), m_help(help), m_unit(unit), m_shift(firstBucketShift)
+    {}
+    Q_DISABLE_COPY_MOVE(QMetricHistogram)
+
+    const char *name() const noexcept { return m_name; }
+    const char *help() const noexcept { return m_help; }
+    Unit unit() const noexcept { return m_unit; }
+
+    void record(qint64 value) noexcept
+    {
+        value = qMax(value, qint64(0));
+        m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    // the last bucket has no upper bound
+    qint64 upperBound(int bucket) const noexcept { return qint64(1) << (m_shift + bucket); }
+    quint64 bucketCount(int bucket) const noexcept
+    { return m_buckets[bucket].load(std::memory_order_relaxed); }
+    quint64 count() const noexcept;
+    qint64 sum() const noexcept { return m_sum.load(std::memory_order_relaxed); }
+    void reset() noexcept;
+
+private:
+    int bucketIndex(qint64 value) const noexcept
+    {
+        if (value <= upperBound(0))
+            return 0;
+        // number of bits needed for value - 1 is the exponent of the
+        // smallest power of two that is >= value
+        const int exponent = 64 - qCountLeadingZeroBits(quint64(value - 1));
+        return qMin(exponent - m_shift, BucketCount);
+    }
+
+    const char *m_name;
+    const char *m_help;
+    Unit m_unit;
+    int m_shift;
+    std::atomic<quint64> m_buckets[BucketCount + 1] = {};
+    std::atomic<qint64> m_sum = {};
+};
+
+struct QMetricSample
+{
+    enum Type { Counter, Histogram };
+
+    QByteArray name;
+    QByteArray help;
+    Type type = Counter;
+    quint64 count = 0;      // the counter value, or the number of recorded values
+    double sum = 0;         // histograms only, in the exported unit
+    // histograms only: cumulative counts per upper bound, without the +Inf bucket
+    QList<std::pair<double, quint64>> buckets;
+};
+
+class Q_CORE_EXPORT QCoreMetrics
+{
+public:
+    // Collection is off by default; while it is, the instrumented code paths
+    // only pay for checking this flag.
+    static bool isEnabled() noexcept { return enabled.loadRelaxed(); }
+    static void setEnabled(bool enable) noexcept;
+
+    static qint64 timestamp() noexcept
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Application-defined metrics are included in snapshots while registered;
+    // they must stay alive until unregistered.
+    static void registerMetric(QMetricCounter *counter);
+    static void registerMetric(QMetricHistogram *histogram);
+    static void unregisterMetric(QMetricCounter *counter);
+    static void unregisterMetric(QMetricHistogram *histogram);
+
+    static QList<QMetricSample> snapshot();
+    static QByteArray toPrometheusText(const QList<QMetricSample> &samples);
+    static void reset();
+
+    // number of events currently posted to thread and not yet delivered
+    static qsizetype postedEventCount(QThread *thread);
+
+    // built-in metrics
+    static QMetricHistogram eventLoopBusyTime;
+    static QMetricHistogram eventNotifyTime;
+    static QMetricHistogram postedEventQueueDepth;
+    static QMetricHistogram timerLateness;
+    static QMetricHistogram threadPoolQueueLength;
+    static QMetricHistogram threadPoolWaitTime;
+
+private:
+    static QBasicAtomicInt enabled;
+};
+
+// Records the lifetime of the object in histogram, if metrics were enabled
+// when it was created
+class QMetricScopedTimer
+{
+public:
+    explicit QMetricScopedTimer(QMetricHistogram &histogram) noexcept
+        : m_histogram(histogram),
+          m_start(QCoreMetrics::isEnabled() ? QCoreMetrics::timestamp() : 0)
+    {}
+    ~QMetricScopedTimer()
+    {
+        if (m_start)
+            m_histogram.record(QCoreMetrics::timestamp() - m_start);
+    }
+    Q_DISABLE_COPY_MOVE(QMetricScopedTimer)
+
+private:
+    QMetricHistogram &m_histogram;
+    const qint64 m_start;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCOREMETRICS_P_H
@@ -0,0 +1,345 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCOROUTINE_H
+#define QCOROUTINE_H
+
+#include <QtCore/qglobal.h>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define QT_HAS_COROUTINES
+
+#include <QtCore/qabstracteventdispatcher.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtimer.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
+
+#include <chrono>
+#include <coroutine>
+#include <optional>
+#include <tuple>
+#ifndef QT_NO_EXCEPTIONS
+#include <exception>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// An object living in the current thread through which a coroutine can be
+// resumed from another thread, or nullptr if the thread has no event loop.
+inline QObject *coroutineResumeContext()
+{
+    return QThread::currentThread()->eventDispatcher();
+}
+
+#if QT_CONFIG(future)
+
+template <typename T>
+class FutureCoroutinePromiseBase
+{
+public:
+    FutureCoroutinePromiseBase() { fi.reportStarted(); }
+    ~FutureCoroutinePromiseBase() { fi.reportFinished(); }
+    Q_DISABLE_COPY_MOVE(FutureCoroutinePromiseBase)
+
+    QFuture<T> get_return_object() { return fi.future(); }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        fi.reportException(std::current_exception());
+#endif
+    }
+
+    void cancel() { fi.cancel(); }
+
+protected:
+    QFutureInterface<T> fi;
+};
+
+// The promise type of coroutines returning QFuture<T>
+template <typename T>
+class FutureCoroutinePromise : public FutureCoroutinePromiseBase<T>
+{
+public:
+    void return_value(const T &value) { this->fi.reportResult(value); }
+    void return_value(T &&value) { this->fi.reportAndMoveResult(std::move(value)); }
+};
+
+template <>
+class FutureCoroutinePromise<void> : public FutureCoroutinePromiseBase<void>
+{
+public:
+    void return_void() { }
+};
+
+template <typename Promise>
+inline constexpr bool IsFutureCoroutinePromise = false;
+template <typename T>
+inline constexpr bool IsFutureCoroutinePromise<FutureCoroutinePromise<T>> = true;
+
+template <typename T>
+class FutureAwaiter
+{
+public:
+    explicit FutureAwaiter(const QFuture<T> &future) : future(future) { }
+    Q_DISABLE_COPY_MOVE(FutureAwaiter)
+
+    bool await_ready() const noexcept
+    {
+        return future.isFinished() && !propagatesCancellation();
+    }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        awaiting = handle;
+        if constexpr (IsFutureCoroutinePromise<Promise>) {
+            cancelAwaiting = [](std::coroutine_handle<> h) {
+                auto coroutine = std::coroutine_handle<Promise>::from_address(h.address());
+                coroutine.promise().cancel();
+                coroutine.destroy();
+            };
+        }
+        thread = QThread::currentThread();
+        context = coroutineResumeContext();
+
+        future.d.setContinuation([this](const QFutureInterfaceBase &) { finished(); });
+
+        if (state.testAndSetOrdered(Initial, Suspended))
+            return true;
+
+        // the future finished before we could suspend
+        if (cancelAwaiting && propagatesCancellation()) {
+            cancelAwaiting(awaiting); // destroys *this
+            return true;
+        }
+        return false;
+    }
+
+    T await_resume()
+    {
+        // rethrows the exception stored in the future, if any
+        future.waitForFinished();
+        if constexpr (!std::is_void_v<T>) {
+            Q_ASSERT_X(future.resultCount() > 0, "co_await QFuture",
+                       "The awaited future was canceled without a result");
+            if constexpr (std::is_copy_constructible_v<T>)
+                return future.result();
+            else
+                return future.takeResult();
+        }
+    }
+
+private:
+    enum State { Initial, Suspended, FinishedEarly };
+
+    bool propagatesCancellation() const
+    {
+        return future.isCanceled() && !future.d.hasException();
+    }
+
+    // called from the thread finishing the future
+    void finished()
+    {
+        if (state.testAndSetOrdered(Initial, FinishedEarly))
+            return; // await_suspend() takes care of it
+
+        if (QThread::currentThread() == thread || !context)
+            resume();
+        else
+            QMetaObject::invokeMethod(context.data(), [this] { resume(); }, Qt::QueuedConnection);
+    }
+
+    void resume()
+    {
+        if (cancelAwaiting && propagatesCancellation())
+            cancelAwaiting(awaiting);
+        else
+            awaiting.resume();
+    }
+
+    QFuture<T> future;
+    std::coroutine_handle<> awaiting;
+    void (*cancelAwaiting)(std::coroutine_handle<>) = nullptr;
+    QThread *thread = nullptr;
+    QPointer<QObject> context;
+    QAtomicInt state = Initial;
+};
+
+#endif // QT_CONFIG(future)
+
+// The number of leading signal arguments delivered to the awaiting coroutine.
+// This drops the QPrivateSignal tag of private signals; a trailing empty
+// argument carries no value anyway.
+template <typename Args>
+inline constexpr int SignalValueCount = 0;
+template <typename... Args>
+inline constexpr int SignalValueCount<List<Args...>> = []() {
+    if constexpr (sizeof...(Args) == 0) {
+        return 0;
+    } else {
+        using Last = std::tuple_element_t<sizeof...(Args) - 1, std::tuple<Args...>>;
+        return int(sizeof...(Args)) - (std::is_class_v<Last> && std::is_empty_v<Last> ? 1 : 0);
+    }
+}();
+
+template <typename Func, typename Values = typename List_Left<
+                  typename FunctionPointer<Func>::Arguments,
+                  SignalValueCount<typename FunctionPointer<Func>::Arguments>>::Value>
+class SignalAwaiter;
+
+template <typename Func, typename... Values>
+class SignalAwaiter<Func, List<Values...>>
+{
+    using Object = typename FunctionPointer<Func>::Object;
+    using Value = std::conditional_t<sizeof...(Values) == 1,
+                                     std::tuple_element_t<0, std::tuple<std::decay_t<Values>..., void>>,
+                                     std::tuple<std::decay_t<Values>...>>;
+    using Result = std::conditional_t<sizeof...(Values) == 0, bool, std::optional<Value>>;
+
+public:
+    SignalAwaiter(const Object *sender, Func signal) : sender(sender), signal(signal) { }
+    ~SignalAwaiter()
+    {
+        QObject::disconnect(emitted);
+        QObject::disconnect(destroyed);
+    }
+    Q_DISABLE_COPY_MOVE(SignalAwaiter)
+
+    bool await_ready() const noexcept { return !sender; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        awaiting = handle;
+        emitted = QObject::connect(sender, signal, sender, [this](Values... values) {
+            if constexpr (sizeof...(Values) == 0)
+                result = true;
+            else
+                result.emplace(values...);
+            finished();
+        }, Qt::SingleShotConnection);
+        destroyed = QObject::connect(sender, &QObject::destroyed, sender, [this] {
+            finished();
+        }, Qt::SingleShotConnection);
+    }
+
+    Result await_resume() { return std::move(result); }
+
+private:
+    void finished()
+    {
+        QObject::disconnect(emitted);
+        QObject::disconnect(destroyed);
+        awaiting.resume();
+    }
+
+    const Object *sender;
+    Func signal;
+    std::coroutine_handle<> awaiting;
+    QMetaObject::Connection emitted;
+    QMetaObject::Connection destroyed;
+    Result result = {};
+};
+
+class TimerAwaiter
+{
+public:
+    TimerAwaiter(std::chrono::milliseconds interval, Qt::TimerType timerType)
+        : interval(interval), timerType(timerType) { }
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        QTimer::singleShot(interval, timerType, [handle] { handle.resume(); });
+    }
+    void await_resume() const noexcept { }
+
+private:
+    std::chrono::milliseconds interval;
+    Qt::TimerType timerType;
+};
+
+} // namespace QtPrivate
+
+#if QT_CONFIG(future)
+template <typename T>
+QtPrivate::FutureAwaiter<T> operator co_await(const QFuture<T> &future)
+{
+    return QtPrivate::FutureAwaiter<T>(future);
+}
+#endif
+
+namespace QtCoroutine {
+
+template <typename Func>
+QtPrivate::SignalAwaiter<Func>
+signal(const typename QtPrivate::FunctionPointer<Func>::Object *sender, Func signal)
+{
+    return QtPrivate::SignalAwaiter<Func>(sender, signal);
+}
+
+inline QtPrivate::TimerAwaiter sleep(std::chrono::milliseconds interval,
+                                     Qt::TimerType timerType = Qt::CoarseTimer)
+{
+    return QtPrivate::TimerAwaiter(interval, timerType);
+}
+
+} // namespace QtCoroutine
+
+QT_END_NAMESPACE
+
+#if QT_CONFIG(future)
+template <typename T, typename... Args>
+struct std::coroutine_traits<QT_PREPEND_NAMESPACE(QFuture)<T>, Args...>
+{
+    using promise_type = QT_PREPEND_NAMESPACE(QtPrivate)::FutureCoroutinePromise<T>;
+};
+#endif
+
+#endif // __cpp_impl_coroutine
+
+#endif // QCOROUTINE_H
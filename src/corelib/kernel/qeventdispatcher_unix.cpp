@@ -50,6 +50,7 @@
 #include <private/qthread_p.h>
 #include <private/qcoreapplication_p.h>
 #include <private/qcore_unix_p.h>
+#include <private/qcoremetrics_p.h>
 
 #include <errno.h>
 #include <stdio.h>
@@ -226,14 +227,125 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIntValue("QT_EVENTDISPATCHER_EPOLL") > 0)
+        initEpoll();
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     qDeleteAll(timerList);
 }
 
+#if QT_CONFIG(epoll)
+// The poll() and epoll() event bits are identical on Linux, which lets us
+// share markPendingSocketNotifiers() and QThreadPipe::check() between both.
+static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI
+              && EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        perror("QEventDispatcherUNIXPrivate: Unable to create epoll instance");
+        return false;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) < 0) {
+        perror("QEventDispatcherUNIXPrivate: Unable to watch thread pipe with epoll");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpollRegistration(int fd, short events, bool isNew)
+{
+    Q_ASSERT(epollFd >= 0);
+
+    epoll_event ev = {};
+    ev.events = uint(events);
+    ev.data.fd = fd;
+
+    int ret;
+    if (events == 0) {
+        // The kernel drops closed descriptors from the interest list by
+        // itself, so ENOENT and EBADF are expected here.
+        ret = epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev);
+        if (ret < 0 && errno != ENOENT && errno != EBADF)
+            perror("QEventDispatcherUNIXPrivate: epoll_ctl(EPOLL_CTL_DEL)");
+        return;
+    }
+
+    ret = epoll_ctl(epollFd, isNew ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev);
+    if (ret < 0 && errno == (isNew ? EEXIST : ENOENT)) {
+        // The descriptor was closed and reused behind our back, or it was
+        // never removed after a close; either way, fix up the registration.
+        ret = epoll_ctl(epollFd, isNew ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+    }
+    if (ret < 0) {
+        qWarning("QSocketNotifier: Unable to watch socket %d with epoll: %s",
+                 fd, qPrintable(qt_error_string(errno)));
+    }
+}
+
+int QEventDispatcherUNIXPrivate::processEpollEvents(timespec *tm, qint64 *waitedNsecs)
+{
+    Q_ASSERT(epollFd >= 0);
+
+    int timeout = -1;
+    if (tm) {
+        // round up so that we never wake up before the next timer is due
+        const qint64 msecs = qint64(tm->tv_sec) * 1000 + (tm->tv_nsec + 999999) / 1000000;
+        timeout = int(qMin(msecs, qint64(std::numeric_limits<int>::max())));
+    }
+
+    // One slot for the thread pipe plus one per registered descriptor, capped
+    // so that a huge interest list does not mean a huge result buffer; any
+    // events that do not fit are simply reported on the next iteration.
+    const qsizetype maxEvents = qBound(qsizetype(16), socketNotifiers.size() + 1, qsizetype(1024));
+    if (epollEvents.size() != maxEvents)
+        epollEvents.resize(maxEvents);
+
+    const qint64 waitStart = QCoreMetrics::isEnabled() ? QCoreMetrics::timestamp() : 0;
+    const int ready = epoll_wait(epollFd, epollEvents.data(), int(epollEvents.size()), timeout);
+    if (waitStart)
+        *waitedNsecs = QCoreMetrics::timestamp() - waitStart;
+    if (ready < 0) {
+        if (errno != EINTR)
+            perror("epoll_wait");
+        return 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < ready; ++i) {
+        const epoll_event &ev = epollEvents.at(i);
+        if (ev.data.fd == threadPipe.fds[0]) {
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = short(ev.events);
+            nevents += threadPipe.check(pfd);
+            continue;
+        }
+        markPendingSocketNotifiers(ev.data.fd, short(ev.events));
+    }
+
+    return nevents + activateSocketNotifiers();
+}
+#endif // QT_CONFIG(epoll)
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -255,38 +367,48 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
         if (pfd.fd < 0 || pfd.revents == 0)
             continue;
 
-        auto it = socketNotifiers.find(pfd.fd);
-        Q_ASSERT(it != socketNotifiers.end());
+        markPendingSocketNotifiers(pfd.fd, pfd.revents);
+    }
+
+    pollfds.clear();
+}
 
-        const QSocketNotifierSetUNIX &sn_set = it.value();
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers(int fd, short revents)
+{
+    auto it = socketNotifiers.find(fd);
+    if (it == socketNotifiers.end()) {
+        // poll() only reports descriptors we asked for, but epoll keeps
+        // reporting a descriptor that was dup()ed before being closed.
+        Q_ASSERT(pollfds.isEmpty());
+        return;
+    }
 
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
+    const QSocketNotifierSetUNIX &sn_set = it.value();
 
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
 
-            if (!notifier)
-                continue;
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+        if (!notifier)
+            continue;
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     it.key(), socketType(n.type));
+            notifier->setEnabled(false);
         }
-    }
 
-    pollfds.clear();
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
 }
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
@@ -411,7 +533,16 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && sn_set.events() != oldEvents)
+        d->updateEpollRegistration(sockfd, sn_set.events(), oldEvents == 0);
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -452,6 +583,11 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
 
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollRegistration(sockfd, sn_set.events(), false);
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -461,6 +597,10 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     Q_D(QEventDispatcherUNIX);
     d->interrupt.storeRelaxed(0);
 
+    // for QCoreMetrics: the time of this iteration minus the time spent blocked
+    const qint64 iterationStart = QCoreMetrics::isEnabled() ? QCoreMetrics::timestamp() : 0;
+    qint64 waitedNsecs = 0;
+
     // we are awake, broadcast it
     emit awake();
 
@@ -487,34 +627,53 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
-    d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
-
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
-
-    // This must be last, as it's popped off the end below
-    d->pollfds.append(d->threadPipe.prepare());
-
     int nevents = 0;
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
-    case -1:
-        perror("qt_safe_poll");
-        break;
-    case 0:
-        break;
-    default:
-        nevents += d->threadPipe.check(d->pollfds.takeLast());
+#if QT_CONFIG(epoll)
+    // The epoll interest list always contains every registered notifier, so
+    // fall back to polling just the thread pipe if notifiers are excluded.
+    if (d->epollFd >= 0 && include_notifiers) {
+        nevents += d->processEpollEvents(tm, &waitedNsecs);
+    } else
+#endif
+    {
+        d->pollfds.clear();
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
         if (include_notifiers)
-            nevents += d->activateSocketNotifiers();
-        break;
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+
+        // This must be last, as it's popped off the end below
+        d->pollfds.append(d->threadPipe.prepare());
+
+        const qint64 waitStart = iterationStart ? QCoreMetrics::timestamp() : 0;
+        const int result = qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm);
+        if (waitStart)
+            waitedNsecs = QCoreMetrics::timestamp() - waitStart;
+
+        switch (result) {
+        case -1:
+            perror("qt_safe_poll");
+            break;
+        case 0:
+            break;
+        default:
+            nevents += d->threadPipe.check(d->pollfds.takeLast());
+            if (include_notifiers)
+                nevents += d->activateSocketNotifiers();
+            break;
+        }
     }
 
     if (include_timers)
         nevents += d->activateTimers();
 
+    if (iterationStart) {
+        QCoreMetrics::eventLoopBusyTime.record(QCoreMetrics::timestamp() - iterationStart
+                                               - waitedNsecs);
+    }
+
     // return true if we handled events, false otherwise
     return (nevents > 0);
 }
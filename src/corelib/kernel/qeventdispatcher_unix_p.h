@@ -58,6 +58,10 @@
 #include "QtCore/qvarlengtharray.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -135,9 +139,21 @@ public:
     int activateTimers();
 
     void markPendingSocketNotifiers();
+    void markPendingSocketNotifiers(int fd, short revents);
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollRegistration(int fd, short events, bool isNew);
+    int processEpollEvents(timespec *tm, qint64 *waitedNsecs);
+
+    // persistent epoll(7) interest list, used instead of pollfds when
+    // QT_EVENTDISPATCHER_EPOLL is set; -1 means poll() is in use
+    int epollFd = -1;
+    QList<epoll_event> epollEvents;
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
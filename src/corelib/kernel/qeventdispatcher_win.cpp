@@ -51,6 +51,10 @@
 #include "qelapsedtimer.h"
 #include "qcoreapplication_p.h"
 #include <private/qthread_p.h>
+#include <private/qntdll_p.h>
+
+#include <limits>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -94,6 +98,326 @@ class QEventDispatcherWin32Private;
 
 LRESULT QT_WIN_CALLBACK qt_internal_proc(HWND hwnd, UINT message, WPARAM wp, LPARAM lp);
 
+#ifndef STATUS_CANCELLED
+#  define STATUS_CANCELLED ((NTSTATUS)0xC0000120L)
+#endif
+#ifndef NT_SUCCESS
+#  define NT_SUCCESS(status) (((NTSTATUS)(status)) >= 0)
+#endif
+#ifndef SIO_BASE_HANDLE
+#  define SIO_BASE_HANDLE 0x48000022 // _WSAIOR(IOC_WS2, 34)
+#endif
+
+namespace {
+using QtNtCreateFile = NTSTATUS (NTAPI *)(PHANDLE, ACCESS_MASK, POBJECT_ATTRIBUTES,
+                                          PIO_STATUS_BLOCK, PLARGE_INTEGER, ULONG, ULONG,
+                                          ULONG, ULONG, PVOID, ULONG);
+using QtNtDeviceIoControlFile = NTSTATUS (NTAPI *)(HANDLE, HANDLE, PIO_APC_ROUTINE, PVOID,
+                                                   PIO_STATUS_BLOCK, ULONG, PVOID, ULONG,
+                                                   PVOID, ULONG);
+// resolved at runtime since <windows.h> pulls in the Winsock 1 header
+using QtWSAIoctl = int (WSAAPI *)(SOCKET, DWORD, LPVOID, DWORD, LPVOID, DWORD, LPDWORD,
+                                  LPVOID, LPVOID);
+
+struct AfdFunctions
+{
+    QtNtCreateFile ntCreateFile = nullptr;
+    QtNtDeviceIoControlFile ntDeviceIoControlFile = nullptr;
+    QtWSAIoctl wsaIoctl = nullptr;
+
+    AfdFunctions()
+    {
+        QSystemLibrary ntdll(QStringLiteral("ntdll"));
+        QSystemLibrary ws2(QStringLiteral("ws2_32"));
+        if (!ntdll.load() || !ws2.load())
+            return;
+        ntCreateFile = reinterpret_cast<QtNtCreateFile>(ntdll.resolve("NtCreateFile"));
+        ntDeviceIoControlFile =
+                reinterpret_cast<QtNtDeviceIoControlFile>(ntdll.resolve("NtDeviceIoControlFile"));
+        wsaIoctl = reinterpret_cast<QtWSAIoctl>(ws2.resolve("WSAIoctl"));
+    }
+    bool isValid() const { return ntCreateFile && ntDeviceIoControlFile && wsaIoctl; }
+};
+}
+Q_GLOBAL_STATIC(AfdFunctions, afdFunctions)
+
+/*
+    Socket notifier backend that keeps one IOCTL_AFD_POLL request in flight
+    per watched socket, directly against the AFD driver that also backs
+    WSAAsyncSelect() and select(). Requests complete by queuing an APC to the
+    dispatcher thread, which runs the next time that thread waits alertably;
+    the dispatcher already waits with MWMO_ALERTABLE, so completions wake it up
+    without going through the message queue. The APC only records readiness,
+    the notifiers are activated from processEvents().
+
+    The cost of an event loop iteration depends on the number of sockets that
+    became ready, not on the number of registered notifiers, and there is no
+    per-window limit on the number of sockets.
+
+    All requests are issued from the dispatcher thread, which is therefore the
+    only one that can run their completion routines. Requests own their poll
+    buffer and status block, so they must outlive the I/O: a request that is
+    removed while in flight is cancelled and deleted by its completion routine.
+*/
+class QWinAfdPoller
+{
+    Q_DISABLE_COPY_MOVE(QWinAfdPoller)
+
+    struct Request
+    {
+        IO_STATUS_BLOCK iosb;
+        AFD_POLL_INFO info;
+        QWinAfdPoller *poller;
+        qintptr socket;
+        SOCKET baseSocket;
+        ULONG events = 0;       // AFD_POLL_* events wanted
+        ULONG readyEvents = 0;  // reported but not yet delivered
+        bool pending = false;   // IOCTL_AFD_POLL in flight
+        bool removed = false;   // delete once the cancelled request completes
+        bool queuedForSubmit = false;
+        bool queuedAsReady = false;
+    };
+
+public:
+    struct ReadySocket
+    {
+        qintptr socket;
+        ULONG events;
+    };
+
+    static QWinAfdPoller *create();
+
+    void update(qintptr socket, ULONG events);
+    void submit();
+    QList<ReadySocket> takeReady();
+    void shutdown();
+
+private:
+    QWinAfdPoller(HANDLE afd) : afd(afd) { }
+    ~QWinAfdPoller() { CloseHandle(afd); }
+
+    static void NTAPI completionRoutine(PVOID context, PIO_STATUS_BLOCK iosb, ULONG);
+    void issue(Request *request);
+    void queueForSubmit(qintptr socket, Request *request)
+    {
+        if (!request->queuedForSubmit) {
+            request->queuedForSubmit = true;
+            toSubmit.append(socket);
+        }
+    }
+
+    HANDLE afd;
+    DWORD threadId = 0;
+    int pendingCount = 0;
+    bool deleteWhenIdle = false;
+    QHash<qintptr, Request *> requests;
+    // Keyed by socket rather than by request so that removing a request does
+    // not need to search these; stale entries are skipped via the flags.
+    QList<qintptr> toSubmit;
+    QList<qintptr> ready;
+};
+
+QWinAfdPoller *QWinAfdPoller::create()
+{
+    if (!afdFunctions()->isValid())
+        return nullptr;
+
+    // Any name below \Device\Afd opens a new handle to the driver
+    static const wchar_t deviceName[] = L"\\Device\\Afd\\Qt";
+    UNICODE_STRING name;
+    name.Length = USHORT(sizeof(deviceName) - sizeof(wchar_t));
+    name.MaximumLength = USHORT(sizeof(deviceName));
+    name.Buffer = const_cast<PWSTR>(deviceName);
+
+    OBJECT_ATTRIBUTES attributes;
+    InitializeObjectAttributes(&attributes, &name, 0, nullptr, nullptr);
+
+    HANDLE afd = INVALID_HANDLE_VALUE;
+    IO_STATUS_BLOCK iosb;
+    const NTSTATUS status =
+            afdFunctions()->ntCreateFile(&afd, SYNCHRONIZE, &attributes, &iosb, nullptr, 0,
+                                         FILE_SHARE_READ | FILE_SHARE_WRITE, FILE_OPEN, 0,
+                                         nullptr, 0);
+    if (!NT_SUCCESS(status)) {
+        qWarning("QEventDispatcherWin32: Unable to open the AFD driver (0x%08lx), "
+                 "falling back to WSAAsyncSelect", ulong(status));
+        return nullptr;
+    }
+    return new QWinAfdPoller(afd);
+}
+
+// events == 0 stops watching the socket
+void QWinAfdPoller::update(qintptr socket, ULONG events)
+{
+    auto it = requests.find(socket);
+    if (events == 0) {
+        if (it == requests.end())
+            return;
+        Request *request = it.value();
+        requests.erase(it);
+        if (request->pending) {
+            request->removed = true;
+            CancelIoEx(afd, &request->iosb);
+        } else {
+            delete request;
+        }
+        return;
+    }
+
+    Request *request;
+    if (it == requests.end()) {
+        request = new Request;
+        request->poller = this;
+        request->socket = socket;
+        // AFD only knows about base provider sockets, not about any layered
+        // service provider handles stacked on top of them
+        DWORD bytes;
+        if (afdFunctions()->wsaIoctl(SOCKET(socket), SIO_BASE_HANDLE, nullptr, 0, &request->baseSocket,
+                     sizeof(request->baseSocket), &bytes, nullptr, nullptr) == SOCKET_ERROR) {
+            request->baseSocket = SOCKET(socket);
+        }
+        requests.insert(socket, request);
+    } else {
+        request = it.value();
+        if (request->events == events)
+            return;
+    }
+
+    request->events = events;
+    request->readyEvents &= events;
+    if (request->pending)
+        CancelIoEx(afd, &request->iosb);    // resubmitted with the new events on completion
+    else
+        queueForSubmit(socket, request);
+}
+
+void QWinAfdPoller::submit()
+{
+    const QList<qintptr> sockets = std::exchange(toSubmit, {});
+    for (qintptr socket : sockets) {
+        Request *request = requests.value(socket);
+        if (!request || !request->queuedForSubmit)
+            continue;
+        request->queuedForSubmit = false;
+        if (!request->pending)
+            issue(request);
+    }
+}
+
+void QWinAfdPoller::issue(Request *request)
+{
+    Q_ASSERT(!threadId || threadId == GetCurrentThreadId());
+    threadId = GetCurrentThreadId();
+
+    AFD_POLL_INFO &info = request->info;
+    info.Timeout.QuadPart = std::numeric_limits<LONGLONG>::max();
+    info.NumberOfHandles = 1;
+    info.Exclusive = FALSE;
+    info.Handles[0].Handle = reinterpret_cast<HANDLE>(request->baseSocket);
+    info.Handles[0].Status = 0;
+    info.Handles[0].Events = request->events | AFD_POLL_LOCAL_CLOSE;
+
+    request->iosb.Status = NTSTATUS(STATUS_PENDING);
+    const NTSTATUS status =
+            afdFunctions()->ntDeviceIoControlFile(afd, nullptr, completionRoutine, request,
+                                                  &request->iosb, IOCTL_AFD_POLL,
+                                                  &info, sizeof(info), &info, sizeof(info));
+    if (status == NTSTATUS(STATUS_PENDING) || NT_SUCCESS(status)) {
+        // the completion routine runs in both cases
+        request->pending = true;
+        ++pendingCount;
+    } else {
+        qWarning("QSocketNotifier: Unable to poll socket %d (0x%08lx)",
+                 int(request->baseSocket), ulong(status));
+    }
+}
+
+void NTAPI QWinAfdPoller::completionRoutine(PVOID context, PIO_STATUS_BLOCK iosb, ULONG)
+{
+    auto request = static_cast<Request *>(context);
+    QWinAfdPoller *poller = request->poller;
+    request->pending = false;
+    --poller->pendingCount;
+
+    if (request->removed) {
+        delete request;
+    } else {
+        const qintptr socket = request->socket;
+        if (iosb->Status == STATUS_CANCELLED) {
+            // cancelled by update() to change the events
+            poller->queueForSubmit(socket, request);
+        } else if (NT_SUCCESS(iosb->Status) && request->info.NumberOfHandles == 1) {
+            const ULONG events = request->info.Handles[0].Events;
+            if (events & AFD_POLL_LOCAL_CLOSE) {
+                // closed without disabling its notifiers first; polling it
+                // again would fail, so wait for the notifiers to go away
+            } else {
+                request->readyEvents |= events;
+                if (!request->queuedAsReady) {
+                    request->queuedAsReady = true;
+                    poller->ready.append(socket);
+                }
+            }
+        }
+        // on errors, wait for the notifiers to be updated before polling again
+    }
+
+    if (poller->deleteWhenIdle && poller->pendingCount == 0)
+        delete poller;
+}
+
+/*
+    Returns the sockets that became ready since the last call, and queues
+    them to be polled again on the next submit(), like poll() would report
+    them again on its next call if they are still ready.
+*/
+QList<QWinAfdPoller::ReadySocket> QWinAfdPoller::takeReady()
+{
+    QList<ReadySocket> result;
+    const QList<qintptr> sockets = std::exchange(ready, {});
+    result.reserve(sockets.size());
+    for (qintptr socket : sockets) {
+        Request *request = requests.value(socket);
+        if (!request || !request->queuedAsReady)
+            continue;
+        request->queuedAsReady = false;
+        if (const ULONG events = std::exchange(request->readyEvents, 0) & request->events)
+            result.append({ socket, events });
+        queueForSubmit(socket, request);
+    }
+    return result;
+}
+
+void QWinAfdPoller::shutdown()
+{
+    for (Request *request : qAsConst(requests)) {
+        if (request->pending)
+            request->removed = true;
+        else
+            delete request;
+    }
+    requests.clear();
+    toSubmit.clear();
+    ready.clear();
+
+    if (pendingCount == 0) {
+        delete this;
+        return;
+    }
+
+    CancelIoEx(afd, nullptr);
+    if (threadId == GetCurrentThreadId()) {
+        // cancellation completes promptly, but the completion routines still
+        // need to run before the requests can be freed
+        while (pendingCount > 0)
+            SleepEx(INFINITE, TRUE);
+        delete this;
+    } else {
+        // only the issuing thread can run them; the last one cleans up
+        deleteWhenIdle = true;
+    }
+}
+
 QEventDispatcherWin32Private::QEventDispatcherWin32Private()
     : interrupt(false), internalHwnd(0),
       sendPostedEventsTimerId(0), wakeUps(0),
@@ -103,6 +427,8 @@ QEventDispatcherWin32Private::QEventDispatcherWin32Private()
 
 QEventDispatcherWin32Private::~QEventDispatcherWin32Private()
 {
+    if (afdPoller)
+        afdPoller->shutdown();
     if (internalHwnd)
         DestroyWindow(internalHwnd);
 }
@@ -462,6 +788,51 @@ void QEventDispatcherWin32Private::postActivateSocketNotifiers()
         activateNotifiersPosted = PostMessage(internalHwnd, WM_QT_ACTIVATENOTIFIERS, 0, 0);
 }
 
+void QEventDispatcherWin32Private::updateAfdPoll(int socket)
+{
+    Q_ASSERT(afdPoller);
+    ULONG events = 0;
+    if (sn_read.contains(socket))
+        events |= AFD_POLL_RECEIVE | AFD_POLL_ACCEPT | AFD_POLL_DISCONNECT | AFD_POLL_ABORT;
+    if (sn_write.contains(socket))
+        events |= AFD_POLL_SEND | AFD_POLL_CONNECT_FAIL | AFD_POLL_ABORT;
+    if (sn_except.contains(socket))
+        events |= AFD_POLL_RECEIVE_EXPEDITED;
+    afdPoller->update(socket, events);
+}
+
+bool QEventDispatcherWin32Private::activateAfdSocketNotifiers()
+{
+    Q_ASSERT(afdPoller);
+    const QList<QWinAfdPoller::ReadySocket> readySockets = afdPoller->takeReady();
+    for (const QWinAfdPoller::ReadySocket &ready : readySockets) {
+        const int socket = int(ready.socket);
+        // Same mapping as for WSAAsyncSelect(): a closed connection is
+        // reported to the read notifier as QEvent::SockClose. Look the
+        // notifiers up each time, since activating one may remove others.
+        if (ready.events & (AFD_POLL_RECEIVE | AFD_POLL_ACCEPT | AFD_POLL_DISCONNECT | AFD_POLL_ABORT)) {
+            if (QSockNot *sn = sn_read.value(socket)) {
+                const bool closed = !(ready.events & (AFD_POLL_RECEIVE | AFD_POLL_ACCEPT));
+                QEvent event(closed ? QEvent::SockClose : QEvent::SockAct);
+                QCoreApplication::sendEvent(sn->obj, &event);
+            }
+        }
+        if (ready.events & (AFD_POLL_SEND | AFD_POLL_CONNECT_FAIL | AFD_POLL_ABORT)) {
+            if (QSockNot *sn = sn_write.value(socket)) {
+                QEvent event(QEvent::SockAct);
+                QCoreApplication::sendEvent(sn->obj, &event);
+            }
+        }
+        if (ready.events & AFD_POLL_RECEIVE_EXPEDITED) {
+            if (QSockNot *sn = sn_except.value(socket)) {
+                QEvent event(QEvent::SockAct);
+                QCoreApplication::sendEvent(sn->obj, &event);
+            }
+        }
+    }
+    return !readySockets.isEmpty();
+}
+
 QEventDispatcherWin32::QEventDispatcherWin32(QObject *parent)
     : QEventDispatcherWin32(*new QEventDispatcherWin32Private, parent)
 {
@@ -473,6 +844,9 @@ QEventDispatcherWin32::QEventDispatcherWin32(QEventDispatcherWin32Private &dd, Q
     Q_D(QEventDispatcherWin32);
 
     d->internalHwnd = qt_create_internal_window(this);
+
+    if (qEnvironmentVariableIntValue("QT_EVENTDISPATCHER_AFD") > 0)
+        d->afdPoller = QWinAfdPoller::create();
 }
 
 QEventDispatcherWin32::~QEventDispatcherWin32()
@@ -514,6 +888,14 @@ bool QEventDispatcherWin32::processEvents(QEventLoop::ProcessEventsFlags flags)
     bool canWait;
     bool retVal = false;
     do {
+        if (d->afdPoller) {
+            // readiness was recorded by completion routines that ran during
+            // the last alertable wait
+            if (!(flags & QEventLoop::ExcludeSocketNotifiers) && d->activateAfdSocketNotifiers())
+                retVal = true;
+            d->afdPoller->submit();
+        }
+
         QVarLengthArray<MSG> processedTimers;
         while (!d->interrupt.loadRelaxed()) {
             MSG msg;
@@ -585,6 +967,8 @@ bool QEventDispatcherWin32::processEvents(QEventLoop::ProcessEventsFlags flags)
                    && flags.testFlag(QEventLoop::WaitForMoreEvents)
                    && threadData->canWaitLocked());
         if (canWait) {
+            if (d->afdPoller)
+                d->afdPoller->submit();
             emit aboutToBlock();
             MsgWaitForMultipleObjectsEx(0, NULL, INFINITE, QS_ALLINPUT, MWMO_ALERTABLE | MWMO_INPUTAVAILABLE);
             emit awake();
@@ -629,6 +1013,11 @@ void QEventDispatcherWin32::registerSocketNotifier(QSocketNotifier *notifier)
     sn->fd  = sockfd;
     dict->insert(sn->fd, sn);
 
+    if (d->afdPoller) {
+        d->updateAfdPoll(sockfd);
+        return;
+    }
+
     long event = 0;
     if (d->sn_read.contains(sockfd))
         event |= FD_READ | FD_CLOSE | FD_ACCEPT;
@@ -685,6 +1074,13 @@ void QEventDispatcherWin32::doUnregisterSocketNotifier(QSocketNotifier *notifier
     int sockfd = notifier->socket();
     Q_ASSERT(sockfd >= 0);
 
+    if (d->afdPoller) {
+        QSNDict *sn_vec[3] = { &d->sn_read, &d->sn_write, &d->sn_except };
+        delete sn_vec[type]->take(sockfd);
+        d->updateAfdPoll(sockfd);
+        return;
+    }
+
     QSFDict::iterator it = d->active_fd.find(sockfd);
     if (it != d->active_fd.end()) {
         QSockFd &sd = it.value();
@@ -876,6 +1272,10 @@ void QEventDispatcherWin32::closingDown()
     while (!d->sn_except.isEmpty())
         doUnregisterSocketNotifier((*(d->sn_except.begin()))->obj);
     Q_ASSERT(d->active_fd.isEmpty());
+    if (d->afdPoller) {
+        d->afdPoller->shutdown();
+        d->afdPoller = nullptr;
+    }
 
     // clean up any timers
     for (WinTimerInfo *t : qAsConst(d->timerDict))
@@ -61,6 +61,7 @@
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherWin32Private;
+class QWinAfdPoller;
 
 // forward declaration
 LRESULT QT_WIN_CALLBACK qt_internal_proc(HWND hwnd, UINT message, WPARAM wp, LPARAM lp);
@@ -174,6 +175,11 @@ public:
     void postActivateSocketNotifiers();
     void doWsaAsyncSelect(int socket, long event);
 
+    // AFD poll based socket notifiers, opt-in via QT_EVENTDISPATCHER_AFD
+    QWinAfdPoller *afdPoller = nullptr;
+    void updateAfdPoll(int socket);
+    bool activateAfdSocketNotifiers();
+
     bool closingDown = false;
 
     QList<MSG> queuedUserInputEvents;
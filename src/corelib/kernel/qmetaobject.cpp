@@ -52,6 +52,8 @@
 #include <qdebug.h>
 #if QT_CONFIG(thread)
 #include <qsemaphore.h>
+#include <qhash.h>
+#include <qmutex.h>
 #endif
 
 #include "private/qobject_p.h"
@@ -172,6 +174,44 @@ static inline QByteArray stringData(const QMetaObject *mo, int index)
     return QByteArray::fromRawData(view.data(), view.size());
 }
 
+// The name index emitted by moc directly after the header consists of two
+// tables, one for the properties and one for the methods. Each is a count
+// followed by (hash, local index) pairs sorted by hash and then by index.
+static inline const uint *propertyNameIndex(const QMetaObject *mo)
+{
+    if (!(priv(mo->d.data)->flags & HasNameIndex))
+        return nullptr;
+    return mo->d.data + MetaObjectPrivateFieldCount;
+}
+
+static inline const uint *methodNameIndex(const QMetaObject *mo)
+{
+    const uint *properties = propertyNameIndex(mo);
+    return properties ? properties + 1 + 2 * properties[0] : nullptr;
+}
+
+// Returns the entries of \a table whose hash equals \a hash
+static std::pair<const uint *, const uint *> nameIndexRange(const uint *table, uint hash)
+{
+    const uint *first = table + 1;
+    const uint *end = first + 2 * table[0];
+    uint count = table[0];
+    while (count > 0) {
+        const uint half = count / 2;
+        const uint *middle = first + 2 * half;
+        if (*middle < hash) {
+            first = middle + 2;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    const uint *last = first;
+    while (last != end && *last == hash)
+        last += 2;
+    return { first, last };
+}
+
 static inline const char *rawTypeNameFromTypeInfo(const QMetaObject *mo, uint typeInfo)
 {
     if (typeInfo & IsUnresolvedType) {
@@ -629,7 +669,18 @@ bool QMetaObjectPrivate::methodMatch(const QMetaObject *m, const QMetaMethod &me
  */
 QMetaMethod QMetaObjectPrivate::firstMethod(const QMetaObject *baseObject, QByteArrayView name)
 {
+    const uint hash = nameHash(name.data(), name.size());
     for (const QMetaObject *currentObject = baseObject; currentObject; currentObject = currentObject->superClass()) {
+        if (const uint *table = methodNameIndex(currentObject)) {
+            const auto [first, last] = nameIndexRange(table, hash);
+            for (const uint *entry = last; entry != first; ) {
+                entry -= 2;
+                auto candidate = QMetaMethod::fromRelativeMethodIndex(currentObject, int(entry[1]));
+                if (name == candidate.name())
+                    return candidate;
+            }
+            continue;
+        }
         const int start = priv(currentObject->d.data)->methodCount - 1;
         const int end = 0;
         for (int i = start; i >= end; --i) {
@@ -652,6 +703,7 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
                                         const QByteArray &name, int argc,
                                         const QArgumentType *types)
 {
+    const uint hash = QMetaObjectPrivate::nameHash(name.constData(), name.size());
     for (const QMetaObject *m = *baseObject; m; m = m->d.superdata) {
         Q_ASSERT(priv(m->d.data)->revision >= 7);
         int i = (MethodType == MethodSignal)
@@ -659,6 +711,23 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
         const int end = (MethodType == MethodSlot)
                         ? (priv(m->d.data)->signalCount) : 0;
 
+        if (const uint *table = methodNameIndex(m)) {
+            // visit the candidates from the highest index down, like the scan below
+            const auto [first, last] = nameIndexRange(table, hash);
+            for (const uint *entry = last; entry != first; ) {
+                entry -= 2;
+                const int candidate = int(entry[1]);
+                if (candidate > i || candidate < end)
+                    continue;
+                auto data = QMetaMethod::fromRelativeMethodIndex(m, candidate);
+                if (methodMatch(m, data, name, argc, types)) {
+                    *baseObject = m;
+                    return candidate;
+                }
+            }
+            continue;
+        }
+
         for (; i >= end; --i) {
             auto data = QMetaMethod::fromRelativeMethodIndex(m, i);
             if (methodMatch(m, data, name, argc, types)) {
@@ -1060,9 +1129,20 @@ int QMetaObject::indexOfEnumerator(const char *name) const
 */
 int QMetaObject::indexOfProperty(const char *name) const
 {
+    const uint hash = QMetaObjectPrivate::nameHash(name, qstrlen(name));
     const QMetaObject *m = this;
     while (m) {
         const QMetaObjectPrivate *d = priv(m->d.data);
+        if (const uint *table = propertyNameIndex(m)) {
+            const auto [first, last] = nameIndexRange(table, hash);
+            for (const uint *entry = first; entry != last; entry += 2) {
+                const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, int(entry[1]));
+                if (strcmp(name, rawStringData(m, data.name())) == 0)
+                    return int(entry[1]) + m->propertyOffset();
+            }
+            m = m->d.superdata;
+            continue;
+        }
         for (int i = 0; i < d->propertyCount; ++i) {
             const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, i);
             const char *prop = rawStringData(m, data.name());
@@ -1310,23 +1390,20 @@ QByteArray QMetaObject::normalizedType(const char *type)
     return normalizeTypeInternal(type, type + qstrlen(type));
 }
 
-/*!
-    Normalizes the signature of the given \a method.
+namespace {
+struct NormalizedSignatureCache
+{
+    enum { MaxSize = 256, MaxKeyLength = 256 };
 
-    Qt uses normalized signatures to decide whether two given signals
-    and slots are compatible. Normalization reduces whitespace to a
-    minimum, moves 'const' to the front where appropriate, removes
-    'const' from value types and replaces const references with
-    values.
+    QBasicMutex mutex;
+    QHash<QByteArray, QByteArray> signatures;
+};
+}
+Q_GLOBAL_STATIC(NormalizedSignatureCache, normalizedSignatureCache)
 
-    \sa checkConnectArgs(), normalizedType()
- */
-QByteArray QMetaObject::normalizedSignature(const char *method)
+static QByteArray normalizeSignatureInternal(const char *method, qsizetype len)
 {
     QByteArray result;
-    if (!method || !*method)
-        return result;
-    int len = int(strlen(method));
     QVarLengthArray<char> stackbuf(len + 1);
     char *d = stackbuf.data();
     qRemoveWhitespace(method, d);
@@ -1351,6 +1428,47 @@ QByteArray QMetaObject::normalizedSignature(const char *method)
     return result;
 }
 
+/*!
+    Normalizes the signature of the given \a method.
+
+    Qt uses normalized signatures to decide whether two given signals
+    and slots are compatible. Normalization reduces whitespace to a
+    minimum, moves 'const' to the front where appropriate, removes
+    'const' from value types and replaces const references with
+    values.
+
+    \sa checkConnectArgs(), normalizedType()
+ */
+QByteArray QMetaObject::normalizedSignature(const char *method)
+{
+    if (!method || !*method)
+        return QByteArray();
+    const qsizetype len = qstrlen(method);
+    if (len > NormalizedSignatureCache::MaxKeyLength)
+        return normalizeSignatureInternal(method, len);
+
+    // String based connect() and invokeMethod() normalize the same few
+    // signatures over and over, so remember the results
+    NormalizedSignatureCache *cache = normalizedSignatureCache();
+    if (!cache)
+        return normalizeSignatureInternal(method, len);
+
+    const QByteArray key = QByteArray::fromRawData(method, len);
+    {
+        QMutexLocker locker(&cache->mutex);
+        const auto it = cache->signatures.constFind(key);
+        if (it != cache->signatures.cend())
+            return it.value();
+    }
+
+    QByteArray result = normalizeSignatureInternal(method, len);
+    QMutexLocker locker(&cache->mutex);
+    if (cache->signatures.size() >= NormalizedSignatureCache::MaxSize)
+        cache->signatures.clear();
+    cache->signatures.insert(QByteArray(method, len), result);
+    return result;
+}
+
 enum { MaximumParamCount = 11 }; // up to 10 arguments + 1 return value
 
 /*
@@ -106,7 +106,8 @@ enum MethodFlags {
 enum MetaObjectFlag {
     DynamicMetaObject = 0x01,
     RequiresVariantMetaObject = 0x02,
-    PropertyAccessInStaticMetaCall = 0x04 // since Qt 5.5, property code is in the static metacall
+    PropertyAccessInStaticMetaCall = 0x04, // since Qt 5.5, property code is in the static metacall
+    HasNameIndex = 0x08 // since Qt 6.4, hashed property and method names follow the header
 };
 Q_DECLARE_FLAGS(MetaObjectFlags, MetaObjectFlag)
 Q_DECLARE_OPERATORS_FOR_FLAGS(MetaObjectFlags)
@@ -230,6 +231,16 @@ struct QMetaObjectPrivate
 
     static QList<QByteArray> parameterTypeNamesFromSignature(const char *signature);
 
+    // Hash of the property and method names in the name index (see
+    // HasNameIndex). moc computes the same values at build time.
+    static constexpr uint nameHash(const char *name, qsizetype size) noexcept
+    {
+        uint h = 2166136261u; // FNV-1a
+        for (qsizetype i = 0; i < size; ++i)
+            h = (h ^ uchar(name[i])) * 16777619u;
+        return h;
+    }
+
 #ifndef QT_NO_QOBJECT
     // defined in qobject.cpp
     enum DisconnectType { DisconnectAll, DisconnectOne };
@@ -107,6 +107,36 @@ struct DefinedTypesFilter {
     };
 };
 
+// Per-thread cache of registry lookups. The registries bump their generation
+// after every change, which drops the cached results in each thread on its
+// next lookup, so lookups that hit the cache do not take the registry lock.
+template <typename Key, typename T>
+struct QMetaTypeLookupCache
+{
+    enum { MaxSize = 128 };
+
+    uint generation = 0;
+    QHash<Key, T> entries;
+
+    const T *find(const Key &key, uint currentGeneration)
+    {
+        if (generation != currentGeneration) {
+            entries.clear();
+            generation = currentGeneration;
+            return nullptr;
+        }
+        const auto it = entries.constFind(key);
+        return it == entries.cend() ? nullptr : &it.value();
+    }
+
+    void insert(const Key &key, const T &value)
+    {
+        if (entries.size() >= MaxSize)
+            entries.clear();
+        entries.insert(key, value);
+    }
+};
+
 struct QMetaTypeCustomRegistry
 {
     QReadWriteLock lock;
@@ -114,6 +144,8 @@ struct QMetaTypeCustomRegistry
     QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
+    // bumped under the write lock after registry or aliases changed
+    QAtomicInteger<uint> generation;
 
     int registerCustomType(const QtPrivate::QMetaTypeInterface *ti)
     {
@@ -142,6 +174,7 @@ struct QMetaTypeCustomRegistry
                 firstEmpty = registry.size();
             }
             ti->typeId = firstEmpty + QMetaType::User;
+            generation.fetchAndAddRelease(1);
         }
         if (ti->legacyRegisterOp)
             ti->legacyRegisterOp();
@@ -169,12 +202,20 @@ struct QMetaTypeCustomRegistry
         ti = nullptr;
 
         firstEmpty = std::min(firstEmpty, idx);
+        generation.fetchAndAddRelease(1);
     }
 
     const QtPrivate::QMetaTypeInterface *getCustomType(int id)
     {
+        static thread_local QMetaTypeLookupCache<int, const QtPrivate::QMetaTypeInterface *> cache;
+        const uint currentGeneration = generation.loadAcquire();
+        if (auto cached = cache.find(id, currentGeneration))
+            return *cached;
+
         QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        const QtPrivate::QMetaTypeInterface *iface = registry.value(id - QMetaType::User - 1);
+        cache.insert(id, iface);
+        return iface;
     }
 };
 
@@ -1574,13 +1615,14 @@ public:
     ~QMetaTypeFunctionRegistry()
     {
         const QWriteLocker locker(&lock);
+        qDeleteAll(map);
         map.clear();
+        generation.fetchAndAddRelease(1);
     }
 
     bool contains(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.contains(k);
+        return function(k) != nullptr;
     }
 
     bool insertIfNotContains(Key k, const T &f)
@@ -1590,26 +1632,42 @@ public:
         auto &e = map[k];
         if (map.size() == oldSize) // already present
             return false;
-        e = f;
+        e = new T(f);
+        generation.fetchAndAddRelease(1);
         return true;
     }
 
+    // Every QMetaType::convert() and canConvert() between types without a
+    // built-in conversion ends up here, so misses are cached as well
     const T *function(Key k) const
     {
+        static thread_local QMetaTypeLookupCache<Key, const T *> cache;
+        const uint currentGeneration = generation.loadAcquire();
+        if (auto cached = cache.find(k, currentGeneration))
+            return *cached;
+
         const QReadLocker locker(&lock);
-        auto it = map.find(k);
-        return it == map.end() ? nullptr : std::addressof(*it);
+        const T *f = map.value(k);
+        cache.insert(k, f);
+        return f;
     }
 
     void remove(int from, int to)
     {
         const Key k(from, to);
         const QWriteLocker locker(&lock);
-        map.remove(k);
+        if (const T *f = map.take(k)) {
+            delete f;
+            generation.fetchAndAddRelease(1);
+        }
     }
 private:
     mutable QReadWriteLock lock;
-    QHash<Key, T> map;
+    // the functions are allocated individually so that the pointers handed
+    // out (and cached) stay valid while other functions are registered
+    QHash<Key, const T *> map;
+    // bumped under the write lock after map changed
+    QAtomicInteger<uint> generation;
 };
 
 typedef QMetaTypeFunctionRegistry<QMetaType::ConverterFunction,QPair<int,int> >
@@ -2613,6 +2671,7 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
         if (al)
             return;
         al = metaType.d_ptr;
+        reg->generation.fetchAndAddRelease(1);
     }
 }
 
@@ -2632,9 +2691,18 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
 {
     if (!length)
         return QMetaType::UnknownType;
+
+    // Both the static table and the custom types are searched by name
+    // comparison, so cache the result per thread
+    static thread_local QMetaTypeLookupCache<QByteArray, int> cache;
+    auto reg = customTypeRegistry();
+    const uint currentGeneration = reg ? reg->generation.loadAcquire() : 0;
+    if (auto cached = cache.find(QByteArray::fromRawData(typeName, length), currentGeneration))
+        return *cached;
+
     int type = qMetaTypeStaticType(typeName, length);
-    if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
+    if (type == QMetaType::UnknownType && reg) {
+        QReadLocker locker(&reg->lock);
         type = qMetaTypeCustomType_unlocked(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
@@ -2648,6 +2716,7 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         }
 #endif
     }
+    cache.insert(QByteArray(typeName, length), type);
     return type;
 }
 
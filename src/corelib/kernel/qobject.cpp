@@ -69,6 +69,7 @@
 #include <private/qhooks_p.h>
 #include <qtcore_tracepoints_p.h>
 
+#include <atomic>
 #include <new>
 #include <mutex>
 
@@ -79,6 +80,49 @@ QT_BEGIN_NAMESPACE
 
 static int DIRECT_CONNECTION_ONLY = 0;
 
+/*!
+    \internal
+
+    Destroys the argument copies held for a batched queued connection;
+    \a values holds one group of arguments, typed by \a argumentTypes, per
+    emission.
+*/
+static void destroyBatchedArguments(const int *argumentTypes, const QList<void *> &values)
+{
+    if (values.isEmpty())
+        return;
+    int argc = 0;
+    while (argumentTypes[argc])
+        ++argc;
+    for (qsizetype i = 0; i < values.size(); ++i)
+        QMetaType(argumentTypes[i % argc]).destroy(values.at(i));
+}
+
+/*!
+    \internal
+
+    Reduces Qt::BatchedQueuedConnection and Qt::CoalescedQueuedConnection in
+    \a type to Qt::QueuedConnection and returns the delivery flags that were
+    set.
+*/
+static int takeQueuedDeliveryFlags(int &type)
+{
+    constexpr int mask = (Qt::BatchedQueuedConnection | Qt::CoalescedQueuedConnection)
+            & ~Qt::QueuedConnection;
+    const int flags = type & mask;
+    if (flags)
+        type = Qt::QueuedConnection;
+    return flags;
+}
+
+static void setQueuedDelivery(QObjectPrivate::Connection *c, int deliveryFlags)
+{
+    if (!deliveryFlags || c->isSingleShot)
+        return;
+    c->batch = new QObjectPrivate::Connection::Batch;
+    c->isCoalesced = (deliveryFlags & (Qt::CoalescedQueuedConnection & ~Qt::QueuedConnection)) != 0;
+}
+
 Q_LOGGING_CATEGORY(lcConnectSlotsByName, "qt.core.qmetaobject.connectslotsbyname")
 Q_LOGGING_CATEGORY(lcConnect, "qt.core.qobject.connect")
 
@@ -200,6 +244,7 @@ QObjectPrivate::QObjectPrivate(int version)
     isQuickItem = false;
     willBeWidget = false;
     wasWidget = false;
+    isCoAllocated = false;
 }
 
 QObjectPrivate::~QObjectPrivate()
@@ -219,7 +264,7 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    if (postedEvents || thisThreadData->postEventList.hasIncoming())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     thisThreadData->deref();
@@ -515,6 +560,176 @@ QAbstractMetaCallEvent::~QAbstractMetaCallEvent()
 #endif
 }
 
+namespace {
+// Recycles the storage of QMetaCallEvents, which are allocated by the
+// emitting thread and usually freed by another one after delivery. Each
+// thread keeps its own free list; a block freed by a thread other than the
+// one it was allocated by is handed back to its owner through a lock-free
+// stack that only the owner empties.
+struct MetaCallEventPool
+{
+    struct Block
+    {
+        Block *next;
+        MetaCallEventPool *pool;
+    };
+    static constexpr size_t Alignment = alignof(std::max_align_t);
+    static constexpr size_t HeaderSize = (sizeof(Block) + Alignment - 1) & ~(Alignment - 1);
+    static constexpr int LocalCapacity = 256;
+    static constexpr int RemoteCapacity = 4096;
+
+    // owning thread and every block allocated from the pool
+    QAtomicInt ref = 1;
+    std::atomic<bool> orphaned = false;
+    QAtomicPointer<Block> remote;
+    QAtomicInt remoteCount;
+    Block *local = nullptr;
+    int localCount = 0;
+
+    static void *payload(Block *b) { return reinterpret_cast<char *>(b) + HeaderSize; }
+    static Block *block(void *p) { return reinterpret_cast<Block *>(static_cast<char *>(p) - HeaderSize); }
+
+    static Block *newBlock(MetaCallEventPool *pool)
+    {
+        Block *b = static_cast<Block *>(::operator new(HeaderSize + sizeof(QMetaCallEvent)));
+        b->next = nullptr;
+        b->pool = pool;
+        if (pool)
+            pool->ref.ref();
+        return b;
+    }
+
+    static void release(Block *b)
+    {
+        MetaCallEventPool *pool = b->pool;
+        ::operator delete(b);
+        if (pool && !pool->ref.deref())
+            delete pool;
+    }
+
+    static void releaseAll(Block *b)
+    {
+        while (b) {
+            Block *next = b->next;
+            release(b);
+            b = next;
+        }
+    }
+
+    Block *allocate()
+    {
+        if (!local) {
+            local = remote.fetchAndStoreAcquire(nullptr);
+            for (Block *b = local; b; b = b->next) {
+                ++localCount;
+                remoteCount.deref();
+            }
+        }
+        if (!local)
+            return newBlock(this);
+        Block *b = local;
+        local = b->next;
+        --localCount;
+        return b;
+    }
+
+    void freeLocal(Block *b)
+    {
+        if (localCount >= LocalCapacity)
+            return release(b);
+        b->next = local;
+        local = b;
+        ++localCount;
+    }
+
+    void freeRemote(Block *b)
+    {
+        if (remoteCount.fetchAndAddRelaxed(1) >= RemoteCapacity) {
+            remoteCount.deref();
+            return release(b);
+        }
+        ref.ref();      // keep the pool alive until we are done with it
+        Block *head = remote.loadRelaxed();
+        do {
+            b->next = head;
+        } while (!remote.testAndSetRelease(head, b, head));
+        // pairs with the fence in orphan(): if the owner is gone and did not
+        // see our block, it is ours to release
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (orphaned.load(std::memory_order_relaxed))
+            releaseAll(remote.fetchAndStoreAcquire(nullptr));
+        if (!ref.deref())
+            delete this;
+    }
+
+    void orphan()
+    {
+        orphaned.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        releaseAll(std::exchange(local, nullptr));
+        releaseAll(remote.fetchAndStoreAcquire(nullptr));
+        if (!ref.deref())
+            delete this;
+    }
+};
+
+static thread_local MetaCallEventPool *currentMetaCallEventPool = nullptr;
+static thread_local bool metaCallEventPoolOrphaned = false;
+
+struct MetaCallEventPoolOwner
+{
+    ~MetaCallEventPoolOwner()
+    {
+        MetaCallEventPool *pool = std::exchange(currentMetaCallEventPool, nullptr);
+        metaCallEventPoolOrphaned = true;
+        if (pool)
+            pool->orphan();
+    }
+};
+
+static MetaCallEventPool *metaCallEventPool()
+{
+    if (Q_LIKELY(currentMetaCallEventPool) || metaCallEventPoolOrphaned)
+        return currentMetaCallEventPool;
+    static thread_local MetaCallEventPoolOwner owner;
+    Q_UNUSED(owner);
+    return currentMetaCallEventPool = new MetaCallEventPool;
+}
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Takes the storage for events of exactly this class from a per-thread pool.
+ */
+void *QMetaCallEvent::operator new(std::size_t size)
+{
+    if (size != sizeof(QMetaCallEvent))
+        return ::operator new(size);
+    MetaCallEventPool *pool = metaCallEventPool();
+    MetaCallEventPool::Block *b = pool ? pool->allocate() : MetaCallEventPool::newBlock(nullptr);
+    return MetaCallEventPool::payload(b);
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr, std::size_t size) noexcept
+{
+    if (!ptr)
+        return;
+    if (size != sizeof(QMetaCallEvent))
+        return ::operator delete(ptr);
+    MetaCallEventPool::Block *b = MetaCallEventPool::block(ptr);
+    MetaCallEventPool *pool = b->pool;
+    if (!pool)
+        MetaCallEventPool::release(b);
+    else if (pool == currentMetaCallEventPool)
+        pool->freeLocal(b);
+    else
+        pool->freeRemote(b);
+}
+
 /*!
     \internal
  */
@@ -1113,10 +1328,20 @@ QObject::~QObject()
 
     if (d->parent)        // remove it from parent object
         d->setParent_helper(nullptr);
+
+    if (d->isCoAllocated) {
+        // The private object lives in our own allocation; destroy it in place
+        // and let the memory go away together with the object.
+        d_ptr.take()->~QObjectData();
+    }
 }
 
 QObjectPrivate::Connection::~Connection()
 {
+    if (batch) {
+        destroyBatchedArguments(argumentTypes.loadRelaxed(), batch->values);
+        delete batch;
+    }
     if (ownArgumentTypes) {
         const int *v = argumentTypes.loadRelaxed();
         if (v != &DIRECT_CONNECTION_ONLY)
@@ -1640,8 +1865,17 @@ void QObject::moveToThread(QThread *targetThread)
     currentData->ref();
 
     // move the object
+    currentData->takeIncomingPostedEvents();
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // queued meta-call events may still have been pushed to currentData by
+    // threads that read the old thread data; the fence pairs with the one in
+    // QCoreApplicationPrivate::postMetaCallEvent(), so whatever is not taken
+    // here is handled by the posting thread
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    currentData->takeIncomingPostedEvents();
+    currentData->moveMisroutedPostedEvents(targetData);
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -1671,7 +1905,10 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
             continue;
         if (pe.receiver == q) {
             // move this post event to the targetList
+            const bool compressible = currentData->postEventList.forgetCompressibleEvent(pe);
             targetData->postEventList.addEvent(pe);
+            if (compressible)
+                targetData->postEventList.indexCompressibleEvent(pe);
             const_cast<QPostEvent &>(pe).event = nullptr;
             ++eventsMoved;
         }
@@ -3424,6 +3661,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
 
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
+    const int deliveryFlags = takeQueuedDeliveryFlags(type);
 
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
@@ -3442,6 +3680,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    setQueuedDelivery(c.get(), deliveryFlags);
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3739,6 +3978,122 @@ private:
     QtPrivate::QSlotObjectBase *m_slotObject = nullptr;
 };
 
+/*!
+    \internal
+
+    Delivers the emissions collected for a batched queued connection in one
+    event. It keeps the connection, and with it the pending arguments, alive
+    until it is delivered or discarded.
+*/
+class QBatchedMetaCallEvent : public QAbstractMetaCallEvent
+{
+public:
+    QBatchedMetaCallEvent(QObjectPrivate::Connection *c, const QObject *sender, int signalId)
+        : QAbstractMetaCallEvent(sender, signalId), c(c),
+          slotObj(c->isSlotObject ? c->slotObj : nullptr),
+          callFunction(c->isSlotObject ? nullptr : c->callFunction),
+          method_offset(c->method_offset), method_relative(c->method_relative)
+    {
+        c->ref();
+        if (slotObj)
+            slotObj->ref();
+    }
+
+    ~QBatchedMetaCallEvent() override
+    {
+        // arguments left behind go out with the next event, or the connection
+        if (!delivered)
+            c->batch->eventPosted.storeRelease(0);
+        if (slotObj)
+            slotObj->destroyIfLastRef();
+        c->deref();
+    }
+
+    void placeMetaCall(QObject *object) override
+    {
+        QList<void *> values;
+        int pending;
+        {
+            QBasicMutexLocker locker(signalSlotLock(object));
+            values.swap(c->batch->values);
+            pending = std::exchange(c->batch->pending, 0);
+            c->batch->eventPosted.storeRelaxed(0);
+            delivered = true;
+        }
+
+        const int *argumentTypes = c->argumentTypes.loadRelaxed();
+        const auto cleanup = qScopeGuard([&] { destroyBatchedArguments(argumentTypes, values); });
+        if (!pending)
+            return;
+
+        const qsizetype argc = values.size() / pending;
+        QVarLengthArray<void *, 8> args(argc + 1);
+        args[0] = nullptr; // return value
+        const QPointer<QObject> guard(object);
+        for (int i = 0; i < pending && guard; ++i) {
+            std::copy_n(values.constData() + i * argc, argc, args.data() + 1);
+            if (slotObj) {
+                slotObj->call(object, args.data());
+            } else if (callFunction && method_offset <= object->metaObject()->methodOffset()) {
+                callFunction(object, QMetaObject::InvokeMetaMethod, method_relative, args.data());
+            } else {
+                QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod,
+                                      method_offset + method_relative, args.data());
+            }
+        }
+    }
+
+private:
+    QObjectPrivate::Connection *c;
+    QtPrivate::QSlotObjectBase *slotObj;
+    QObjectPrivate::StaticMetaCallFunction callFunction;
+    ushort method_offset;
+    ushort method_relative;
+    bool delivered = false;
+};
+
+/*!
+    \internal
+
+    Queued activation for a connection made with Qt::BatchedQueuedConnection
+    or Qt::CoalescedQueuedConnection: the arguments are added to the
+    connection's batch, and an event is posted only if none is pending yet.
+*/
+static void batched_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                             const int *argumentTypes, int nargs, void **argv)
+{
+    QVarLengthArray<void *, 8> values(nargs - 1);
+    for (int n = 1; n < nargs; ++n)
+        values[n - 1] = QMetaType(argumentTypes[n - 1]).create(argv[n]);
+
+    QList<void *> replaced;
+    QBasicMutexLocker locker(signalSlotLock(c->receiver.loadRelaxed()));
+    QObject *receiver = c->receiver.loadRelaxed();
+    if (!receiver) {
+        // the connection has been disconnected before we got the lock
+        locker.unlock();
+        for (int n = 1; n < nargs; ++n)
+            QMetaType(argumentTypes[n - 1]).destroy(values[n - 1]);
+        return;
+    }
+
+    QObjectPrivate::Connection::Batch *batch = c->batch;
+    if (c->isCoalesced) {
+        replaced.swap(batch->values);
+        batch->pending = 0;
+    }
+    for (void *value : std::as_const(values))
+        batch->values.append(value);
+    ++batch->pending;
+    if (!batch->eventPosted.loadRelaxed()) {
+        batch->eventPosted.storeRelaxed(1);
+        QCoreApplication::postEvent(receiver, new QBatchedMetaCallEvent(c, sender, signal));
+    }
+    locker.unlock();
+
+    destroyBatchedArguments(argumentTypes, replaced);
+}
+
 /*!
     \internal
 
@@ -3764,6 +4119,9 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     while (argumentTypes[nargs - 1])
         ++nargs;
 
+    if (c->batch)
+        return batched_activate(sender, signal, c, argumentTypes, nargs, argv);
+
     QBasicMutexLocker locker(signalSlotLock(c->receiver.loadRelaxed()));
     QObject *receiver = c->receiver.loadRelaxed();
     if (!receiver) {
@@ -3805,7 +4163,25 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
-    QCoreApplication::postEvent(receiver, ev);
+    QCoreApplicationPrivate::postMetaCallEvent(receiver, ev);
+}
+
+/*!
+    \internal
+    Returns \c true if the slot of \a c can still be called through its static
+    metacall function, i.e. \a receiver is not being destroyed past the class
+    declaring the slot.
+*/
+static inline bool isReceiverComplete(QObjectPrivate::Connection *c, QObject *receiver)
+{
+    // we compare the vtable to make sure we are not in the destructor of the object.
+    const QMetaObject *mo = receiver->metaObject();
+    if (Q_LIKELY(mo == c->checkedReceiverMetaObject.loadRelaxed()))
+        return true;
+    if (c->method_offset > mo->methodOffset())
+        return false;
+    c->checkedReceiverMetaObject.storeRelaxed(mo);
+    return true;
 }
 
 template <bool callbacks_enabled>
@@ -3856,7 +4232,8 @@ void doActivate(QObject *sender, int signal_index, void **argv)
         list = &signalVector->at(-1);
 
     Qt::HANDLE currentThreadId = QThread::currentThreadId();
-    bool inSenderThread = currentThreadId == QObjectPrivate::get(sender)->threadData.loadRelaxed()->threadId.loadRelaxed();
+    QThreadData *senderThreadData = sp->threadData.loadRelaxed();
+    bool inSenderThread = currentThreadId == senderThreadData->threadId.loadRelaxed();
 
     // We need to check against the highest connection id to ensure that signals added
     // during the signal emission are not emitted in this emission.
@@ -3877,7 +4254,9 @@ void doActivate(QObject *sender, int signal_index, void **argv)
 
             bool receiverInSameThread;
             if (inSenderThread) {
-                receiverInSameThread = currentThreadId == td->threadId.loadRelaxed();
+                // most receivers live in the sender's thread, so don't touch their thread data
+                receiverInSameThread = td == senderThreadData
+                        || currentThreadId == td->threadId.loadRelaxed();
             } else {
                 // need to lock before reading the threadId, because moveToThread() could interfere
                 QMutexLocker lock(signalSlotLock(receiver));
@@ -3931,8 +4310,7 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                     Q_TRACE_SCOPE(QMetaObject_activate_slot_functor, c->slotObj);
                     obj->call(receiver, argv);
                 }
-            } else if (c->callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
-                //we compare the vtable to make sure we are not in the destructor of the object.
+            } else if (c->callFunction && isReceiverComplete(c, receiver)) {
                 const int method_relative = c->method_relative;
                 const auto callFunction = c->callFunction;
                 const int methodIndex = (Q_HAS_TRACEPOINTS || callbacks_enabled) ? c->method() : 0;
@@ -5076,6 +5454,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
 
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
+    const int deliveryFlags = takeQueuedDeliveryFlags(type);
 
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
@@ -5095,6 +5474,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    setQueuedDelivery(c.get(), deliveryFlags);
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
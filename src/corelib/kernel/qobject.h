@@ -110,7 +110,8 @@ public:
     uint isQuickItem : 1;
     uint willBeWidget : 1; // for handling widget-specific bits in QObject's ctor
     uint wasWidget : 1; // for properly cleaning up in QObject's dtor
-    uint unused : 21;
+    uint isCoAllocated : 1; // shares the allocation of q_ptr, see QObjectPrivate::createCoAllocated()
+    uint unused : 20;
     int postedEvents;
     QDynamicMetaObjectData *metaObject;
     QBindingStorage bindingStorage;
@@ -63,6 +63,8 @@
 #include "QtCore/qproperty.h"
 #include "QtCore/private/qproperty_p.h"
 
+#include <new>
+
 QT_BEGIN_NAMESPACE
 
 class QVariant;
@@ -96,6 +98,13 @@ public:
     static void (*setWidgetParent)(QObject *, QObject *); // Used by the QML engine to specify parents for widgets. Set by QtWidgets.
 };
 
+// The block allocated by QObjectPrivate::createCoAllocated() is larger than
+// the object, so it must not be released with a sized operator delete.
+#define Q_OBJECT_CO_ALLOCATED \
+    public: \
+        static void operator delete(void *ptr) { ::operator delete(ptr); } \
+    private:
+
 class Q_CORE_EXPORT QObjectPrivate : public QObjectData
 {
 public:
@@ -150,6 +159,15 @@ public:
 
     struct Connection : public ConnectionOrSignalVector
     {
+        // emissions of a Qt::BatchedQueuedConnection or Qt::CoalescedQueuedConnection
+        // waiting for delivery; protected by the receiver's signalSlotLock()
+        struct Batch
+        {
+            QList<void *> values; // the nargs - 1 arguments of each pending emission
+            int pending = 0;
+            QAtomicInt eventPosted;
+        };
+
         // linked list of connections connected to slots in this object, next is in base class
         Connection **prev;
         // linked list of connections connected to signals in this object
@@ -173,7 +191,12 @@ public:
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
         ushort isSingleShot : 1;
-        Connection() : ref_(2), ownArgumentTypes(true) {
+        ushort isCoalesced : 1;
+        Batch *batch = nullptr;
+        // the receiver's meta-object the last time activate() checked that the
+        // receiver is not being destroyed; spares walking its class hierarchy
+        QAtomicPointer<const QMetaObject> checkedReceiverMetaObject;
+        Connection() : ref_(2), ownArgumentTypes(true), isCoalesced(false) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -362,6 +385,22 @@ public:
     static QObjectPrivate *get(QObject *o) { return o->d_func(); }
     static const QObjectPrivate *get(const QObject *o) { return o->d_func(); }
 
+    // Creates an Object and its Private in a single heap allocation, with the
+    // private placed right after the object. Object must be final, take the
+    // private by reference as its first constructor argument, and declare
+    // Q_OBJECT_CO_ALLOCATED so that deleting it frees the whole block.
+    template <typename Object, typename Private = QObjectPrivate, typename... Args>
+    static Object *createCoAllocated(Args &&... args)
+    {
+        static_assert(std::is_final_v<Object>, "Only final classes can share their allocation");
+        static_assert(std::is_base_of_v<QObjectPrivate, Private>);
+        constexpr size_t privateOffset = (sizeof(Object) + alignof(Private) - 1) & ~(alignof(Private) - 1);
+        void *memory = ::operator new(privateOffset + sizeof(Private));
+        Private *d = new (static_cast<char *>(memory) + privateOffset) Private;
+        d->isCoAllocated = true;
+        return new (memory) Object(*d, std::forward<Args>(args)...);
+    }
+
     int signalIndex(const char *signalName, const QMetaObject **meta = nullptr) const;
     bool isSignalConnected(uint signalIdx, bool checkDeclarative = true) const;
     bool maybeSignalConnected(uint signalIndex) const;
@@ -627,9 +666,18 @@ public:
 
     virtual void placeMetaCall(QObject *object) override;
 
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size) noexcept;
+
 private:
     inline void allocArgs();
 
+    friend class QThreadData;
+    friend class QCoreApplicationPrivate;
+    // link and receiver while queued in QPostEventList::incoming
+    QMetaCallEvent *nextPosted_ = nullptr;
+    QObject *postedReceiver_ = nullptr;
+
     struct Data {
         QtPrivate::QSlotObjectBase *slotObj_;
         void **args_;
@@ -41,6 +41,7 @@
 #include "qproperty_p.h"
 
 #include <qscopedvaluerollback.h>
+#include <qvarlengtharray.h>
 #include <QScopeGuard>
 #include <QtCore/qloggingcategory.h>
 #include <QThread>
@@ -88,6 +89,126 @@ void QPropertyBindingDataPointer::addObserver(QPropertyObserver *observer)
     }
 }
 
+/*!
+    \internal
+
+    QPropertyBindingScheduler evaluates the bindings that depend on one or more
+    changed properties.
+
+    Evaluating recursively along the observer lists evaluates a binding once for
+    every path that leads to it, so a diamond (a -> b, a -> c, {b, c} -> d)
+    evaluates d twice. Instead, the scheduler first collects all bindings that
+    are reachable from the changed properties, without evaluating anything, and
+    sorts them topologically. It then evaluates them in that order, each only
+    if one of its dependencies actually changed. Thus every binding is evaluated
+    at most once per update (an evaluation epoch).
+
+    A dependency loop shows up as a back edge of the depth-first search. When a
+    value propagates along it at runtime, the binding at its end is reported as a
+    binding loop, like the recursive evaluation does when it reaches a binding
+    that is still being evaluated.
+*/
+class QPropertyBindingScheduler
+{
+public:
+    void addDependentsOf(QPropertyObserverPointer observer);
+    void evaluate(QBindingStatus *status);
+
+private:
+    void visit(QPropertyBindingPrivate *binding);
+    static void markDependents(QPropertyBindingPrivate *binding, quint32 epoch, QBindingStatus *status);
+
+    // reverse topological order
+    QVarLengthArray<QPropertyBindingPrivatePtr, 16> postOrder;
+};
+
+static thread_local quint32 bindingEvaluationEpoch = 0;
+
+void QPropertyBindingScheduler::addDependentsOf(QPropertyObserverPointer observer)
+{
+    for (; observer; observer = observer.nextObserver()) {
+        if (QPropertyObserver::ObserverTag(observer.ptr->next.tag()) != QPropertyObserver::ObserverNotifiesBinding)
+            continue;
+        QPropertyBindingPrivate *binding = observer.ptr->binding;
+        binding->needsEvaluation = true;
+        visit(binding);
+    }
+}
+
+void QPropertyBindingScheduler::visit(QPropertyBindingPrivate *binding)
+{
+    if (binding->isScheduled) {
+        if (binding->isVisiting)
+            binding->closesLoop = true;
+        // else already sorted, or owned by an outer scheduler still running
+        return;
+    }
+    binding->isScheduled = true;
+    binding->isVisiting = true;
+    for (auto observer = binding->firstObserver; observer; observer = observer.nextObserver()) {
+        if (QPropertyObserver::ObserverTag(observer.ptr->next.tag()) == QPropertyObserver::ObserverNotifiesBinding)
+            visit(observer.ptr->binding);
+    }
+    binding->isVisiting = false;
+    postOrder.push_back(QPropertyBindingPrivatePtr(binding));
+}
+
+void QPropertyBindingScheduler::evaluate(QBindingStatus *status)
+{
+    Q_ASSERT(status);
+    quint32 epoch = ++bindingEvaluationEpoch;
+    if (!epoch) // 0 is what new bindings start with
+        epoch = ++bindingEvaluationEpoch;
+
+    for (qsizetype i = postOrder.size() - 1; i >= 0; --i) {
+        auto *binding = static_cast<QPropertyBindingPrivate *>(postOrder.at(i).data());
+        binding->isScheduled = false;
+        // skip bindings that were removed from their property in the meantime
+        if (!binding->needsEvaluation || !binding->propertyDataPtr)
+            continue;
+        binding->needsEvaluation = false;
+        binding->evaluationEpoch = epoch;
+        if (binding->updating) {
+            binding->reportBindingLoop();
+            continue;
+        }
+        QScopedValueRollback<bool> updateGuard(binding->updating, true);
+        if (!binding->evaluateSelf_inline(status) || !binding->firstObserver)
+            continue;
+        binding->firstObserver.noSelfDependencies(binding);
+        markDependents(binding, epoch, status);
+    }
+
+    for (const QPropertyBindingPrivatePtr &binding : postOrder)
+        static_cast<QPropertyBindingPrivate *>(binding.data())->closesLoop = false;
+}
+
+void QPropertyBindingScheduler::markDependents(QPropertyBindingPrivate *binding, quint32 epoch,
+                                               QBindingStatus *status)
+{
+    auto observer = const_cast<QPropertyObserver *>(binding->firstObserver.ptr);
+    // See also comment in QPropertyObserverPointer::notify()
+    while (observer) {
+        QPropertyObserver *next = observer->next.data();
+
+        if (QPropertyObserver::ObserverTag(observer->next.tag()) == QPropertyObserver::ObserverNotifiesBinding) {
+            QPropertyBindingPrivate *dependent = observer->binding;
+            if (dependent->isScheduled) {
+                dependent->needsEvaluation = true;
+            } else if (dependent->evaluationEpoch == epoch && dependent->closesLoop) {
+                dependent->reportBindingLoop();
+            } else {
+                // a dependency that appeared while evaluating, so it was not sorted
+                QPropertyObserverNodeProtector protector(observer);
+                dependent->evaluateRecursive_inline(status);
+                next = protector.next();
+            }
+        }
+
+        observer = next;
+    }
+}
+
 /*!
     \internal
 
@@ -148,13 +269,14 @@ struct QPropertyDelayedNotifications
         \a index, it
         \list
             \li restores the original binding data that was modified in addProperty and
-            \li evaluates any bindings which depend on properties that were changed inside
-                the group.
+            \li adds the bindings which depend on the property to \a scheduler.
         \endlist
-        Change notifications are sent later with notify (following the logic of separating
-        binding updates and notifications used in non-deferred updates).
+        The bindings of all properties changed inside the group are evaluated together
+        afterwards, so that each is evaluated at most once. Change notifications are sent
+        later with notify (following the logic of separating binding updates and
+        notifications used in non-deferred updates).
      */
-    void evaluateBindings(int index, QBindingStatus *status) {
+    void scheduleBindings(int index, QPropertyBindingScheduler &scheduler) {
         auto *delayed = delayedProperties + index;
         auto *bindingData = delayed->originalBindingData;
         if (!bindingData)
@@ -170,7 +292,7 @@ struct QPropertyDelayedNotifications
         QPropertyBindingDataPointer bindingDataPointer{bindingData};
         QPropertyObserverPointer observer = bindingDataPointer.firstObserver();
         if (observer)
-            observer.evaluateBindings(status);
+            scheduler.addDependentsOf(observer);
     }
 
     /*!
@@ -251,11 +373,13 @@ void Qt::endPropertyUpdateGroup()
     groupUpdateData = nullptr;
     // update all delayed properties
     auto start = data;
+    QPropertyBindingScheduler scheduler;
     while (data) {
         for (int i = 0; i < data->used; ++i)
-            data->evaluateBindings(i, status);
+            data->scheduleBindings(i, scheduler);
         data = data->next;
     }
+    scheduler.evaluate(status);
     // notify all delayed properties
     data = start;
     while (data) {
@@ -745,20 +869,9 @@ void QPropertyObserverPointer::noSelfDependencies(QPropertyBindingPrivate *bindi
 void QPropertyObserverPointer::evaluateBindings(QBindingStatus *status)
 {
     Q_ASSERT(status);
-    auto observer = const_cast<QPropertyObserver*>(ptr);
-    // See also comment in notify()
-    while (observer) {
-        QPropertyObserver *next = observer->next.data();
-
-        if (QPropertyObserver::ObserverTag(observer->next.tag()) == QPropertyObserver::ObserverNotifiesBinding) {
-            auto bindingToEvaluate = observer->binding;
-            QPropertyObserverNodeProtector protector(observer);
-            bindingToEvaluate->evaluateRecursive_inline(status);
-            next = protector.next();
-        }
-
-        observer = next;
-    }
+    QPropertyBindingScheduler scheduler;
+    scheduler.addDependentsOf(*this);
+    scheduler.evaluate(status);
 }
 
 void QPropertyObserverPointer::observeProperty(QPropertyBindingDataPointer property)
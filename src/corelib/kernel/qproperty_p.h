@@ -212,11 +212,14 @@ struct CompatPropertySafePoint
 
 }
 
+class QPropertyBindingScheduler;
+
 class Q_CORE_EXPORT QPropertyBindingPrivate : public QtPrivate::RefCounted
 {
 private:
     friend struct QPropertyBindingDataPointer;
     friend class QPropertyBindingPrivatePtr;
+    friend class QPropertyBindingScheduler;
 
     using ObserverArray = std::array<QPropertyObserver, 4>;
 
@@ -234,6 +237,12 @@ private:
        in qtdeclarative
     */
     bool m_sticky:1;
+    // state of QPropertyBindingScheduler, only used while it runs
+    bool isScheduled:1;
+    bool isVisiting:1;
+    bool needsEvaluation:1;
+    bool closesLoop:1;
+    quint32 evaluationEpoch = 0;
 
     const QtPrivate::BindingFunctionVTable *vtable;
 
@@ -281,6 +290,8 @@ public:
 
     // public because the auto-tests access it, too.
     size_t dependencyObserverCount = 0;
+    // how often the binding function has been called, for instrumentation
+    quint64 evaluationCount = 0;
 
     bool isUpdating() {return updating;}
     void setSticky(bool keep = true) {m_sticky = keep;}
@@ -291,6 +302,10 @@ public:
         : hasBindingWrapper(false)
         , isQQmlPropertyBinding(isQQmlPropertyBinding)
         , m_sticky(false)
+        , isScheduled(false)
+        , isVisiting(false)
+        , needsEvaluation(false)
+        , closesLoop(false)
         , vtable(vtable)
         , location(location)
         , metaType(metaType)
@@ -371,6 +386,13 @@ public:
 
     void evaluateRecursive(QBindingStatus *status = nullptr);
     void Q_ALWAYS_INLINE evaluateRecursive_inline(QBindingStatus *status);
+    bool Q_ALWAYS_INLINE evaluateSelf_inline(QBindingStatus *status);
+    void reportBindingLoop()
+    {
+        error = QPropertyBindingError(QPropertyBindingError::BindingLoop);
+        if (isQQmlPropertyBinding)
+            errorCallBack(this);
+    }
 
     void notifyRecursive();
 
@@ -778,9 +800,7 @@ struct QUntypedBindablePrivate
 inline void QPropertyBindingPrivate::evaluateRecursive_inline(QBindingStatus *status)
 {
     if (updating) {
-        error = QPropertyBindingError(QPropertyBindingError::BindingLoop);
-        if (isQQmlPropertyBinding)
-            errorCallBack(this);
+        reportBindingLoop();
         return;
     }
 
@@ -796,8 +816,26 @@ inline void QPropertyBindingPrivate::evaluateRecursive_inline(QBindingStatus *st
 
     QScopedValueRollback<bool> updateGuard(updating, true);
 
+    if (!evaluateSelf_inline(status) || !firstObserver)
+        return;
+
+    firstObserver.noSelfDependencies(this);
+    firstObserver.evaluateBindings(status);
+}
+
+/*!
+    \internal
+    Calls the binding function, without evaluating the bindings that depend
+    on this one. Returns \c true if the value of the property changed.
+    The caller is responsible for keeping the binding alive and for setting
+    updating.
+*/
+inline bool QPropertyBindingPrivate::evaluateSelf_inline(QBindingStatus *status)
+{
+    Q_ASSERT(updating);
     QtPrivate::BindingEvaluationState evaluationFrame(this, status);
 
+    ++evaluationCount;
     auto bindingFunctor =  reinterpret_cast<std::byte *>(this) +
             QPropertyBindingPrivate::getSizeEnsuringAlignment();
     bool changed = false;
@@ -810,11 +848,7 @@ inline void QPropertyBindingPrivate::evaluateRecursive_inline(QBindingStatus *st
     // If there was a change, we must set pendingNotify.
     // If there was not, we must not clear it, as that only should happen in notifyRecursive
     pendingNotify = pendingNotify || changed;
-    if (!changed || !firstObserver)
-        return;
-
-    firstObserver.noSelfDependencies(this);
-    firstObserver.evaluateBindings(status);
+    return changed;
 }
 
 inline void QPropertyObserverPointer::notify(QUntypedPropertyData *propertyDataPtr)
@@ -0,0 +1,790 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsharedmemorychannel.h"
+#include "qsharedmemorychannel_p.h"
+
+#if !defined(QT_NO_SHAREDMEMORY) && !defined(QT_NO_QOBJECT)
+
+#include <qabstracteventdispatcher.h>
+#include <qcryptographichash.h>
+#include <qdeadlinetimer.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qmath.h>
+#include <qsocketnotifier.h>
+#include <qthread.h>
+
+#ifdef Q_OS_UNIX
+#  include "private/qcore_unix_p.h"
+#  include <sys/stat.h>
+#  include <errno.h>
+#endif
+#ifdef Q_OS_LINUX
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <limits.h>
+#endif
+
+#include <atomic>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Layout of the shared memory segment: a Header, followed by a ring of
+    capacity bytes, where capacity is a power of two.
+
+    Positions are free-running 32-bit byte counters. The offset of a position
+    in the ring is position & (capacity - 1), and distances between positions
+    are computed modulo 2^32. Producers reserve space by advancing
+    reservePosition with a compare-and-swap, write their record, and publish
+    it by setting its state to Committed. The single consumer reads records at
+    readPosition in order, clears them, and then advances readPosition. A
+    record never wraps around the end of the ring; if it doesn't fit, the
+    producer fills the rest of the ring with a Padding record.
+*/
+struct QSharedMemoryChannelPrivate::Header
+{
+    enum : quint32 {
+        Magic = 0x51534d43, // "QSMC"
+        Version = 1
+    };
+
+    QBasicAtomicInteger<quint32> magic;
+    quint32 version;
+    quint32 capacity;
+
+    // written by different parties, so keep them on separate cache lines
+    alignas(64) QBasicAtomicInteger<quint32> reservePosition;
+    alignas(64) QBasicAtomicInteger<quint32> readPosition;
+    alignas(64) QBasicAtomicInteger<quint32> waiters;
+    QBasicAtomicInteger<quint32> futexSequence;
+};
+
+struct QSharedMemoryChannelPrivate::Record
+{
+    enum State : quint32 {
+        Empty = 0,
+        Committed = 1,
+        Padding = 2
+    };
+
+    QBasicAtomicInteger<quint32> state;
+    quint32 size;
+
+    // the message follows the record header
+    char *payload() { return reinterpret_cast<char *>(this + 1); }
+    const char *payload() const { return reinterpret_cast<const char *>(this + 1); }
+};
+
+namespace {
+enum Waiter : quint32 {
+    FutexWaiter = 0x1,
+    WakeupPipeWaiter = 0x2
+};
+}
+
+using Header = QSharedMemoryChannelPrivate::Header;
+using Record = QSharedMemoryChannelPrivate::Record;
+
+static constexpr quint32 MinimumCapacity = 4096;
+static constexpr quint32 MaximumCapacity = 1u << 30;
+
+static_assert(sizeof(Header) % alignof(Record) == 0);
+static_assert(sizeof(Record) == 8);
+
+static constexpr quint32 recordSize(quint32 payload)
+{
+    return quint32(sizeof(Record)) + ((payload + 7) & ~7u);
+}
+
+#ifdef Q_OS_LINUX
+// not FUTEX_PRIVATE_FLAG, the futex word is shared between processes
+static int sharedFutex(QBasicAtomicInteger<quint32> *address, int op, quint32 value,
+                       const struct timespec *timeout = nullptr)
+{
+    return int(syscall(SYS_futex, reinterpret_cast<int *>(address), op, int(value),
+                       timeout, nullptr, 0));
+}
+#endif
+
+/*!
+    \class QSharedMemoryChannel
+    \inmodule QtCore
+    \since 6.4
+    \brief The QSharedMemoryChannel class passes messages between processes
+    through a ring buffer in shared memory.
+
+    QSharedMemoryChannel implements a bounded, lock-free message queue with
+    any number of producers and a single consumer, stored in a QSharedMemory
+    segment. Sending a message copies it into the segment and, unless the
+    consumer is waiting, involves no system call. This makes it suitable for
+    low-latency communication between processes on the same machine, where
+    QLocalSocket would need several system calls and copies per message.
+
+    The consumer calls create() with the key of the channel and the capacity
+    of the ring buffer. Producers construct a QSharedMemoryChannel with the
+    same key and call attach(). Producers in the same process, or in other
+    threads, need a QSharedMemoryChannel object each.
+
+    \code
+    // consumer
+    QSharedMemoryChannel channel("market-data");
+    channel.create(1 << 20);
+    connect(&channel, &QSharedMemoryChannel::readyRead, [&] {
+        while (channel.hasPendingMessages())
+            process(channel.read());
+    });
+
+    // producer, in another process
+    QSharedMemoryChannel channel("market-data");
+    if (channel.attach())
+        channel.write(message);
+    \endcode
+
+    write() never blocks: if the ring buffer does not have room for the
+    message, it returns \c false and error() returns \l ChannelFull.
+    Messages from one producer are delivered in the order in which they were
+    written. A single message can be at most maximumMessageSize() bytes.
+
+    The consumer is woken up only if it is waiting. On Linux,
+    waitForReadyRead() sleeps on a futex in the shared segment. On Unix
+    systems, a named pipe next to the segment additionally lets the
+    consumer's event loop emit readyRead() through a QSocketNotifier, which
+    requires that create() is called in a thread with an event dispatcher.
+    On other platforms, readyRead() is not emitted and waitForReadyRead()
+    polls.
+
+    \sa QSharedMemory, QLocalSocket
+*/
+
+/*!
+    \enum QSharedMemoryChannel::ChannelError
+
+    \value NoError No error occurred.
+    \value PermissionDenied The operation failed because the caller didn't have
+    the required permissions.
+    \value InvalidSize A create operation failed because the requested capacity
+    was invalid, or a message was larger than maximumMessageSize().
+    \value KeyError The operation failed because of an invalid key.
+    \value AlreadyExists A create() operation failed because a channel with the
+    specified key already existed.
+    \value NotFound An attach() failed because no channel with the specified key
+    could be found, or the channel is not attached.
+    \value OutOfResources A create() operation failed because there was not
+    enough memory available.
+    \value IncompatibleChannel An attach() failed because the shared memory segment
+    with the specified key is not a channel, or was created by an incompatible
+    version of Qt.
+    \value ChannelFull A write() failed because the ring buffer is full.
+    \value UnknownError Something else happened and it was bad.
+*/
+
+/*!
+    \fn void QSharedMemoryChannel::readyRead()
+
+    This signal is emitted on the consumer side when new messages are
+    available. It is emitted again only after further messages have been
+    written, so it is best to read all pending messages in the connected
+    slot.
+
+    This signal is only emitted on Unix systems.
+*/
+
+/*!
+    Constructs a channel object with the given \a parent. Call setKey()
+    before create() or attach().
+*/
+QSharedMemoryChannel::QSharedMemoryChannel(QObject *parent)
+    : QObject(*new QSharedMemoryChannelPrivate, parent)
+{
+}
+
+/*!
+    Constructs a channel object for the channel identified by \a key, with
+    the given \a parent.
+*/
+QSharedMemoryChannel::QSharedMemoryChannel(const QString &key, QObject *parent)
+    : QSharedMemoryChannel(parent)
+{
+    setKey(key);
+}
+
+/*!
+    Destroys the channel object, detaching from the channel first.
+*/
+QSharedMemoryChannel::~QSharedMemoryChannel()
+{
+    detach();
+}
+
+/*!
+    Sets the key of the channel to \a key, detaching from the current
+    channel first.
+*/
+void QSharedMemoryChannel::setKey(const QString &key)
+{
+    Q_D(QSharedMemoryChannel);
+    if (key == d->key)
+        return;
+    detach();
+    d->key = key;
+}
+
+/*!
+    Returns the key of the channel.
+*/
+QString QSharedMemoryChannel::key() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->key;
+}
+
+/*!
+    Creates the channel and makes this object its consumer. The ring buffer
+    holds at least \a capacity bytes, rounded up to a power of two of at
+    least 4096 bytes. Returns \c true on success.
+
+    \sa attach(), capacity()
+*/
+bool QSharedMemoryChannel::create(qsizetype capacity)
+{
+    Q_D(QSharedMemoryChannel);
+    detach();
+
+    const QLatin1String function("QSharedMemoryChannel::create");
+    if (capacity <= 0 || capacity > qsizetype(MaximumCapacity)) {
+        d->setError(InvalidSize, tr("%1: invalid capacity").arg(function));
+        return false;
+    }
+    const quint32 ringSize = qMax(MinimumCapacity, qNextPowerOfTwo(quint32(capacity - 1)));
+
+    d->memory.setKey(d->key);
+    if (!d->memory.create(qsizetype(sizeof(Header)) + ringSize)) {
+        d->setErrorFromMemory(function);
+        return false;
+    }
+
+    memset(d->memory.data(), 0, size_t(d->memory.size()));
+    auto *header = static_cast<Header *>(d->memory.data());
+    header->version = Header::Version;
+    header->capacity = ringSize;
+    d->consumer = true;
+    d->map();
+
+#ifdef Q_OS_UNIX
+    if (!d->openWakeupReader()) {
+        d->unmap();
+        d->memory.detach();
+        d->consumer = false;
+        return false;
+    }
+#endif
+
+    // publish the initialized header to producers that attach
+    header->magic.storeRelease(Header::Magic);
+    d->setError(NoError, QString());
+    return true;
+}
+
+/*!
+    Attaches to the channel created with the same key as a producer.
+    Returns \c true on success.
+
+    \sa create()
+*/
+bool QSharedMemoryChannel::attach()
+{
+    Q_D(QSharedMemoryChannel);
+    detach();
+
+    const QLatin1String function("QSharedMemoryChannel::attach");
+    d->memory.setKey(d->key);
+    if (!d->memory.attach(QSharedMemory::ReadWrite)) {
+        d->setErrorFromMemory(function);
+        return false;
+    }
+
+    const auto *header = static_cast<const Header *>(d->memory.constData());
+    const qsizetype size = d->memory.size();
+    if (size < qsizetype(sizeof(Header)) || header->magic.loadAcquire() != Header::Magic
+            || header->version != Header::Version || header->capacity < MinimumCapacity
+            || header->capacity > MaximumCapacity
+            || (header->capacity & (header->capacity - 1))
+            || size < qsizetype(sizeof(Header)) + header->capacity) {
+        d->memory.detach();
+        d->setError(IncompatibleChannel, tr("%1: not a channel").arg(function));
+        return false;
+    }
+
+    d->consumer = false;
+    d->map();
+#ifdef Q_OS_UNIX
+    d->openWakeupWriter();
+#endif
+    d->setError(NoError, QString());
+    return true;
+}
+
+/*!
+    Returns \c true if this object is attached to a channel, either as its
+    consumer or as a producer.
+*/
+bool QSharedMemoryChannel::isAttached() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header;
+}
+
+/*!
+    Returns \c true if this object created the channel and can read from it.
+*/
+bool QSharedMemoryChannel::isConsumer() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header && d->consumer;
+}
+
+/*!
+    Detaches from the channel. Messages that have not been read are lost
+    once the consumer and all producers have detached.
+*/
+void QSharedMemoryChannel::detach()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header)
+        return;
+#ifdef Q_OS_UNIX
+    d->closeWakeup();
+#endif
+    d->unmap();
+    d->memory.detach();
+    d->consumer = false;
+}
+
+/*!
+    Returns the size of the ring buffer in bytes, or 0 if not attached.
+*/
+qsizetype QSharedMemoryChannel::capacity() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->capacity;
+}
+
+/*!
+    Returns the size of the largest message that can be written, or 0 if
+    not attached. It is a bit less than half the capacity().
+*/
+qsizetype QSharedMemoryChannel::maximumMessageSize() const
+{
+    Q_D(const QSharedMemoryChannel);
+    // a message that does not fit before the end of the ring comes after
+    // padding, which is smaller than the message itself
+    return d->capacity ? qsizetype(d->capacity / 2 - sizeof(Record)) : 0;
+}
+
+/*!
+    Appends \a message to the channel. Returns \c true on success, or
+    \c false if the channel is not attached, the message is too large, or
+    the ring buffer does not have enough free space.
+
+    This function does not block, and only makes a system call if the
+    consumer is waiting for messages.
+*/
+bool QSharedMemoryChannel::write(QByteArrayView message)
+{
+    Q_D(QSharedMemoryChannel);
+    const QLatin1String function("QSharedMemoryChannel::write");
+    if (!d->header) {
+        d->setError(NotFound, tr("%1: not attached").arg(function));
+        return false;
+    }
+    if (message.size() > maximumMessageSize()) {
+        d->setError(InvalidSize, tr("%1: message too large").arg(function));
+        return false;
+    }
+
+    const quint32 mask = d->capacity - 1;
+    const quint32 size = recordSize(quint32(message.size()));
+    quint32 position;
+    quint32 padding;
+    for (;;) {
+        // read readPosition first, it never overtakes reservePosition
+        const quint32 readPosition = d->header->readPosition.loadAcquire();
+        position = d->header->reservePosition.loadRelaxed();
+        const quint32 toEnd = d->capacity - (position & mask);
+        padding = size <= toEnd ? 0 : toEnd;
+        if (position - readPosition + padding + size > d->capacity) {
+            d->setError(ChannelFull, tr("%1: channel is full").arg(function));
+            return false;
+        }
+        if (d->header->reservePosition.testAndSetRelaxed(position, position + padding + size))
+            break;
+    }
+
+    if (padding) {
+        Record *record = d->recordAt(position);
+        record->size = padding - quint32(sizeof(Record));
+        record->state.storeRelease(Record::Padding);
+    }
+
+    Record *record = d->recordAt(position + padding);
+    record->size = quint32(message.size());
+    if (!message.isEmpty())
+        memcpy(record->payload(), message.data(), size_t(message.size()));
+    record->state.storeRelease(Record::Committed);
+
+    d->wakeConsumer();
+    return true;
+}
+
+/*!
+    Removes the oldest message from the channel and returns it. Returns a
+    null QByteArray if there are no pending messages or this object is not
+    the consumer; an empty message is returned as an empty, but not null,
+    QByteArray.
+
+    \sa hasPendingMessages(), waitForReadyRead()
+*/
+QByteArray QSharedMemoryChannel::read()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header || !d->consumer)
+        return QByteArray();
+
+    d->consumePadding();
+    const quint32 position = d->header->readPosition.loadRelaxed();
+    Record *record = d->recordAt(position);
+    if (record->state.loadAcquire() != Record::Committed)
+        return QByteArray();
+
+    const quint32 messageSize = record->size;
+    const QByteArray message(record->payload(), messageSize);
+
+    // clear the whole record, a later record may start anywhere in it
+    const quint32 size = recordSize(messageSize);
+    memset(record->payload(), 0, size - sizeof(Record));
+    record->size = 0;
+    record->state.storeRelaxed(Record::Empty);
+    d->header->readPosition.storeRelease(position + size);
+    return message;
+}
+
+/*!
+    Returns \c true if this object is the consumer and at least one message
+    can be read.
+*/
+bool QSharedMemoryChannel::hasPendingMessages() const
+{
+    Q_D(const QSharedMemoryChannel);
+    if (!d->header || !d->consumer)
+        return false;
+    const quint32 position = d->header->readPosition.loadRelaxed();
+    const Record *record = d->recordAt(position);
+    quint32 state = record->state.loadAcquire();
+    if (state == Record::Padding) {
+        record = d->recordAt(position + quint32(sizeof(Record)) + record->size);
+        state = record->state.loadAcquire();
+    }
+    return state == Record::Committed;
+}
+
+/*!
+    Blocks until a message can be read or \a msecs milliseconds have
+    passed; if \a msecs is -1, this function does not time out. Returns
+    \c true if a message can be read.
+
+    Only the consumer can wait for messages.
+*/
+bool QSharedMemoryChannel::waitForReadyRead(int msecs)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header || !d->consumer)
+        return false;
+
+    const QDeadlineTimer deadline(msecs);
+    while (!hasPendingMessages()) {
+        if (deadline.hasExpired())
+            return false;
+#if defined(Q_OS_LINUX)
+        const quint32 sequence = d->header->futexSequence.loadAcquire();
+        if (d->armWakeup(FutexWaiter)) {
+            struct timespec timeout;
+            struct timespec *timeoutPtr = nullptr;
+            if (!deadline.isForever()) {
+                const qint64 nsecs = qMax<qint64>(deadline.remainingTimeNSecs(), 0);
+                timeout.tv_sec = nsecs / (1000 * 1000 * 1000);
+                timeout.tv_nsec = nsecs % (1000 * 1000 * 1000);
+                timeoutPtr = &timeout;
+            }
+            sharedFutex(&d->header->futexSequence, FUTEX_WAIT, sequence, timeoutPtr);
+        }
+        d->header->waiters.fetchAndAndRelaxed(~quint32(FutexWaiter));
+#elif defined(Q_OS_UNIX)
+        if (d->armWakeup(WakeupPipeWaiter)) {
+            pollfd pfd = qt_make_pollfd(d->wakeupReadFd, POLLIN);
+            qt_poll_msecs(&pfd, 1, int(deadline.remainingTime()));
+        }
+        d->drainWakeup();
+#else
+        QThread::yieldCurrentThread();
+#endif
+    }
+    return true;
+}
+
+/*!
+    Returns the type of the last error that occurred.
+
+    \sa errorString()
+*/
+QSharedMemoryChannel::ChannelError QSharedMemoryChannel::error() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->error;
+}
+
+/*!
+    Returns a text description of the last error that occurred.
+
+    \sa error()
+*/
+QString QSharedMemoryChannel::errorString() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->errorString;
+}
+
+void QSharedMemoryChannelPrivate::setError(QSharedMemoryChannel::ChannelError e,
+                                           const QString &message)
+{
+    error = e;
+    errorString = message;
+}
+
+void QSharedMemoryChannelPrivate::setErrorFromMemory(QLatin1String function)
+{
+    QSharedMemoryChannel::ChannelError e = QSharedMemoryChannel::UnknownError;
+    switch (memory.error()) {
+    case QSharedMemory::NoError:
+        e = QSharedMemoryChannel::NoError;
+        break;
+    case QSharedMemory::PermissionDenied:
+        e = QSharedMemoryChannel::PermissionDenied;
+        break;
+    case QSharedMemory::InvalidSize:
+        e = QSharedMemoryChannel::InvalidSize;
+        break;
+    case QSharedMemory::KeyError:
+        e = QSharedMemoryChannel::KeyError;
+        break;
+    case QSharedMemory::AlreadyExists:
+        e = QSharedMemoryChannel::AlreadyExists;
+        break;
+    case QSharedMemory::NotFound:
+        e = QSharedMemoryChannel::NotFound;
+        break;
+    case QSharedMemory::OutOfResources:
+        e = QSharedMemoryChannel::OutOfResources;
+        break;
+    case QSharedMemory::LockError:
+    case QSharedMemory::UnknownError:
+        break;
+    }
+    setError(e, QSharedMemoryChannel::tr("%1: %2").arg(function, memory.errorString()));
+}
+
+void QSharedMemoryChannelPrivate::map()
+{
+    header = static_cast<Header *>(memory.data());
+    ring = static_cast<uchar *>(memory.data()) + sizeof(Header);
+    capacity = header->capacity;
+}
+
+void QSharedMemoryChannelPrivate::unmap()
+{
+    header = nullptr;
+    ring = nullptr;
+    capacity = 0;
+}
+
+QSharedMemoryChannelPrivate::Record *QSharedMemoryChannelPrivate::recordAt(quint32 position) const
+{
+    return reinterpret_cast<Record *>(ring + (position & (capacity - 1)));
+}
+
+void QSharedMemoryChannelPrivate::consumePadding()
+{
+    const quint32 position = header->readPosition.loadRelaxed();
+    Record *record = recordAt(position);
+    if (record->state.loadAcquire() != Record::Padding)
+        return;
+    const quint32 size = quint32(sizeof(Record)) + record->size;
+    memset(record->payload(), 0, record->size);
+    record->size = 0;
+    record->state.storeRelaxed(Record::Empty);
+    header->readPosition.storeRelease(position + size);
+}
+
+/*
+    Producers and the consumer synchronize their view of the waiters word and
+    the ring with a full fence on both sides: either the producer sees the
+    consumer's waiter flag, or the consumer sees the producer's record.
+*/
+void QSharedMemoryChannelPrivate::wakeConsumer()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const quint32 waiting = header->waiters.loadRelaxed();
+    if (!waiting)
+        return;
+#ifdef Q_OS_LINUX
+    if (waiting & FutexWaiter) {
+        header->futexSequence.fetchAndAddRelease(1);
+        sharedFutex(&header->futexSequence, FUTEX_WAKE, INT_MAX);
+    }
+#endif
+#ifdef Q_OS_UNIX
+    // write at most one byte per time the consumer arms the pipe
+    if ((waiting & WakeupPipeWaiter)
+            && (header->waiters.fetchAndAndRelaxed(~quint32(WakeupPipeWaiter)) & WakeupPipeWaiter)) {
+        if (wakeupWriteFd == -1)
+            openWakeupWriter();
+        if (wakeupWriteFd != -1) {
+            const char byte = 0;
+            qt_safe_write(wakeupWriteFd, &byte, 1);
+        }
+    }
+#endif
+}
+
+// Returns true if there is nothing to read, so the consumer may go to sleep.
+bool QSharedMemoryChannelPrivate::armWakeup(quint32 waiter)
+{
+    header->waiters.fetchAndOrRelaxed(waiter);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return !q_func()->hasPendingMessages();
+}
+
+#ifdef Q_OS_UNIX
+QString QSharedMemoryChannelPrivate::wakeupPath(const QString &key)
+{
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1);
+    return QDir::tempPath() + QLatin1String("/qipc_channel_") + QLatin1String(hash.toHex());
+}
+
+bool QSharedMemoryChannelPrivate::openWakeupReader()
+{
+    Q_Q(QSharedMemoryChannel);
+    const QLatin1String function("QSharedMemoryChannel::create");
+    wakeupFile = wakeupPath(key);
+    const QByteArray path = QFile::encodeName(wakeupFile);
+
+    // a consumer that crashed may have left its pipe behind
+    ::unlink(path.constData());
+    if (::mkfifo(path.constData(), 0600) == 0) {
+        wakeupReadFd = qt_safe_open(path.constData(), O_RDONLY | O_NONBLOCK);
+        // keep a write end open, so that the read end never reports a hang-up
+        wakeupWriteFd = qt_safe_open(path.constData(), O_WRONLY | O_NONBLOCK);
+    }
+    if (wakeupReadFd == -1 || wakeupWriteFd == -1) {
+        const int savedErrno = errno;
+        closeWakeup();
+        setError(savedErrno == EACCES ? QSharedMemoryChannel::PermissionDenied
+                                      : QSharedMemoryChannel::UnknownError,
+                 QSharedMemoryChannel::tr("%1: cannot create %2: %3")
+                         .arg(function, wakeupFile, qt_error_string(savedErrno)));
+        return false;
+    }
+
+    if (QAbstractEventDispatcher::instance(q->thread())) {
+        notifier = new QSocketNotifier(wakeupReadFd, QSocketNotifier::Read, q);
+        QObject::connect(notifier, &QSocketNotifier::activated, q, [this] { wakeupActivated(); });
+    }
+    armWakeup(WakeupPipeWaiter);
+    return true;
+}
+
+void QSharedMemoryChannelPrivate::openWakeupWriter()
+{
+    // fails with ENXIO while the consumer has no read end open; retried on
+    // the next wake-up
+    const QByteArray path = QFile::encodeName(wakeupPath(key));
+    wakeupWriteFd = qt_safe_open(path.constData(), O_WRONLY | O_NONBLOCK);
+}
+
+void QSharedMemoryChannelPrivate::drainWakeup()
+{
+    char buffer[64];
+    while (qt_safe_read(wakeupReadFd, buffer, sizeof buffer) > 0)
+        ;
+    // keep the pipe armed for the notifier and the next wait
+    header->waiters.fetchAndOrRelaxed(WakeupPipeWaiter);
+}
+
+void QSharedMemoryChannelPrivate::closeWakeup()
+{
+    delete notifier;
+    notifier = nullptr;
+    if (wakeupReadFd != -1)
+        qt_safe_close(wakeupReadFd);
+    if (wakeupWriteFd != -1)
+        qt_safe_close(wakeupWriteFd);
+    wakeupReadFd = wakeupWriteFd = -1;
+    if (consumer && !wakeupFile.isEmpty())
+        ::unlink(QFile::encodeName(wakeupFile).constData());
+    wakeupFile.clear();
+}
+
+void QSharedMemoryChannelPrivate::wakeupActivated()
+{
+    Q_Q(QSharedMemoryChannel);
+    drainWakeup();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (q->hasPendingMessages())
+        emit q->readyRead();
+}
+#endif // Q_OS_UNIX
+
+QT_END_NAMESPACE
+
+#endif // !QT_NO_SHAREDMEMORY && !QT_NO_QOBJECT
+
+#include "moc_qsharedmemorychannel.cpp"
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSHAREDMEMORYCHANNEL_P_H
+#define QSHAREDMEMORYCHANNEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qsharedmemorychannel.h"
+
+#if !defined(QT_NO_SHAREDMEMORY) && !defined(QT_NO_QOBJECT)
+
+#include "qsharedmemory.h"
+#include "private/qobject_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifier;
+
+class QSharedMemoryChannelPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QSharedMemoryChannel)
+
+public:
+    struct Header;
+    struct Record;
+
+    QSharedMemoryChannelPrivate() = default;
+
+    void setError(QSharedMemoryChannel::ChannelError e, const QString &message);
+    void setErrorFromMemory(QLatin1String function);
+    void map();
+    void unmap();
+
+    Record *recordAt(quint32 position) const;
+    void consumePadding();
+    void wakeConsumer();
+    bool armWakeup(quint32 waiter);
+
+#ifdef Q_OS_UNIX
+    static QString wakeupPath(const QString &key);
+    bool openWakeupReader();
+    void openWakeupWriter();
+    void drainWakeup();
+    void closeWakeup();
+    void wakeupActivated();
+#endif
+
+    QString key;
+    QSharedMemory memory;
+    Header *header = nullptr;
+    uchar *ring = nullptr;
+    quint32 capacity = 0;
+    bool consumer = false;
+
+    QSharedMemoryChannel::ChannelError error = QSharedMemoryChannel::NoError;
+    QString errorString;
+
+#ifdef Q_OS_UNIX
+    // Named pipe the producers write a byte into to wake the consumer's
+    // event loop or poll(); the consumer keeps its own write end open so
+    // that it never sees a hang-up.
+    QString wakeupFile;
+    int wakeupReadFd = -1;
+    int wakeupWriteFd = -1;
+    QSocketNotifier *notifier = nullptr;
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // !QT_NO_SHAREDMEMORY && !QT_NO_QOBJECT
+
+#endif // QSHAREDMEMORYCHANNEL_P_H
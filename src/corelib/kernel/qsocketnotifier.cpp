@@ -53,6 +53,8 @@
 
 #include <QtCore/QLoggingCategory>
 
+#include <qtcore_tracepoints_p.h>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(lcSocketNotifierDeprecation)
@@ -358,6 +360,7 @@ bool QSocketNotifier::event(QEvent *e)
     case QEvent::SockAct:
     case QEvent::SockClose:
         {
+            Q_TRACE_SCOPE(QSocketNotifier_activated, this, qintptr(d->sockfd), int(d->sntype));
             QPointer<QSocketNotifier> alive(this);
             emit activated(d->sockfd, d->sntype, QPrivateSignal());
             // ### Qt7: Remove emission if the activated(int) signal is removed
@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qstartuptimeline_p.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(lcStartupTimeline, "qt.core.startuptimeline")
+
+/*!
+    \internal
+    \class QStartupTimeline
+    \inmodule QtCore
+
+    \brief QStartupTimeline records how long the phases of application
+    startup take.
+
+    When the \c QT_STARTUP_TIMELINE environment variable is set to a file
+    name, recording starts when the application object is constructed.
+    QCoreApplication and QGuiApplication initialization, loading of plugins
+    and libraries, QLibraryInfo and QStandardPaths lookups, creation of the
+    platform integration and theme, font database population, style creation
+    and the first expose of a window are recorded as phases. Recording
+    finishes with the first expose event, or when the event loop of a
+    console application is started, and the timeline is then written to the
+    file in the Chrome trace event format, which can be opened in
+    chrome://tracing or Perfetto.
+
+    These phases are also covered by tracepoints, which give more detail but
+    require a build with a tracing backend.
+*/
+
+namespace {
+struct TimelineEvent
+{
+    const char *name;
+    QString detail;
+    qint64 start;
+    qint64 end;     // -1 for instant events
+    quintptr thread;
+};
+
+struct StartupTimelineData
+{
+    QMutex mutex;
+    QList<TimelineEvent> events;
+    QString fileName;
+    qint64 origin = 0;
+    bool started = false;
+};
+}
+
+Q_GLOBAL_STATIC(StartupTimelineData, timelineData)
+
+QBasicAtomicInt QStartupTimeline::recording = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*!
+    Starts recording if requested by the environment. Only the first call in
+    the lifetime of the process has an effect.
+*/
+void QStartupTimeline::start()
+{
+    StartupTimelineData *d = timelineData();
+    if (!d)
+        return;
+    QMutexLocker locker(&d->mutex);
+    if (d->started)
+        return;
+    d->started = true;
+    d->fileName = qEnvironmentVariable("QT_STARTUP_TIMELINE");
+    if (d->fileName.isEmpty())
+        return;
+    d->origin = timestamp();
+    recording.storeRelaxed(1);
+}
+
+/*!
+    Stops recording and writes the recorded timeline.
+*/
+void QStartupTimeline::finish()
+{
+    if (!isRecording())
+        return;
+    StartupTimelineData *d = timelineData();
+    QMutexLocker locker(&d->mutex);
+    if (!recording.loadRelaxed())
+        return;
+    recording.storeRelaxed(0);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    // timestamps are in microseconds
+    const auto micros = [d](qint64 ns) { return double(ns - d->origin) / 1000; };
+    QJsonArray traceEvents;
+    for (const TimelineEvent &event : qAsConst(d->events)) {
+        QJsonObject object {
+            { QLatin1String("name"), QLatin1String(event.name) },
+            { QLatin1String("cat"), QLatin1String("startup") },
+            { QLatin1String("ts"), micros(event.start) },
+            { QLatin1String("pid"), pid },
+            { QLatin1String("tid"), qint64(event.thread) },
+        };
+        if (event.end < 0) {
+            object.insert(QLatin1String("ph"), QLatin1String("i"));
+            object.insert(QLatin1String("s"), QLatin1String("p"));
+        } else {
+            object.insert(QLatin1String("ph"), QLatin1String("X"));
+            object.insert(QLatin1String("dur"), micros(event.end) - micros(event.start));
+        }
+        if (!event.detail.isEmpty())
+            object.insert(QLatin1String("args"), QJsonObject { { QLatin1String("detail"), event.detail } });
+        traceEvents.append(object);
+    }
+    d->events.clear();
+
+    QFile file(d->fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(QJsonDocument(QJsonObject { { QLatin1String("traceEvents"), traceEvents } })
+                          .toJson(QJsonDocument::Compact)) < 0) {
+        qCWarning(lcStartupTimeline, "Cannot write startup timeline to %ls: %ls",
+                  qUtf16Printable(d->fileName), qUtf16Printable(file.errorString()));
+    }
+}
+
+/*!
+    Records the phase \a name that took from \a start to \a end, as returned
+    by timestamp(). \a detail, such as the name of a loaded file, is shown
+    together with the phase.
+*/
+void QStartupTimeline::record(const char *name, qint64 start, qint64 end, const QString &detail)
+{
+    StartupTimelineData *d = timelineData();
+    QMutexLocker locker(&d->mutex);
+    // finish() may have been called while the phase was running
+    if (!recording.loadRelaxed())
+        return;
+    d->events.append({ name, detail, start, end, quintptr(QThread::currentThreadId()) });
+}
+
+/*!
+    Records that the instant event \a name happened now.
+*/
+void QStartupTimeline::mark(const char *name, const QString &detail)
+{
+    if (isRecording())
+        record(name, timestamp(), -1, detail);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSTARTUPTIMELINE_P_H
+#define QSTARTUPTIMELINE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qstring.h>
+#include <QtCore/private/qglobal_p.h>
+
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QStartupTimeline
+{
+public:
+    // Recording is enabled by setting QT_STARTUP_TIMELINE to the name of the
+    // file the timeline is written to. While it is off, the instrumented code
+    // paths only pay for checking this flag.
+    static bool isRecording() noexcept { return recording.loadRelaxed(); }
+    static void start();
+    static void finish();
+
+    static qint64 timestamp() noexcept
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void record(const char *name, qint64 start, qint64 end,
+                       const QString &detail = QString());
+    static void mark(const char *name, const QString &detail = QString());
+
+private:
+    static QBasicAtomicInt recording;
+};
+
+// Records the lifetime of the object as a phase named name, if the timeline
+// was recording when it was created
+class QStartupTimelineScope
+{
+public:
+    explicit QStartupTimelineScope(const char *name, const QString &detail = QString())
+        : m_name(name),
+          m_start(QStartupTimeline::isRecording() ? QStartupTimeline::timestamp() : 0)
+    {
+        if (m_start)
+            m_detail = detail;
+    }
+    ~QStartupTimelineScope()
+    {
+        if (m_start)
+            QStartupTimeline::record(m_name, m_start, QStartupTimeline::timestamp(), m_detail);
+    }
+    Q_DISABLE_COPY_MOVE(QStartupTimelineScope)
+
+private:
+    const char *m_name;
+    const qint64 m_start;
+    QString m_detail;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTARTUPTIMELINE_P_H
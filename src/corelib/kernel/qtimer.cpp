@@ -296,17 +296,18 @@ void QTimer::timerEvent(QTimerEvent *e)
     }
 }
 
-class QSingleShotTimer : public QObject
+class QSingleShotTimer final : public QObject
 {
     Q_OBJECT
+    Q_OBJECT_CO_ALLOCATED
     int timerId;
     bool hasValidReceiver;
     QPointer<const QObject> receiver;
     QtPrivate::QSlotObjectBase *slotObj;
 public:
     ~QSingleShotTimer();
-    QSingleShotTimer(int msec, Qt::TimerType timerType, const QObject *r, const char * m);
-    QSingleShotTimer(int msec, Qt::TimerType timerType, const QObject *r, QtPrivate::QSlotObjectBase *slotObj);
+    QSingleShotTimer(QObjectPrivate &dd, int msec, Qt::TimerType timerType, const QObject *r, const char * m);
+    QSingleShotTimer(QObjectPrivate &dd, int msec, Qt::TimerType timerType, const QObject *r, QtPrivate::QSlotObjectBase *slotObj);
 
 Q_SIGNALS:
     void timeout();
@@ -314,15 +315,15 @@ protected:
     void timerEvent(QTimerEvent *) override;
 };
 
-QSingleShotTimer::QSingleShotTimer(int msec, Qt::TimerType timerType, const QObject *r, const char *member)
-    : QObject(QAbstractEventDispatcher::instance()), hasValidReceiver(true), slotObj(nullptr)
+QSingleShotTimer::QSingleShotTimer(QObjectPrivate &dd, int msec, Qt::TimerType timerType, const QObject *r, const char *member)
+    : QObject(dd, QAbstractEventDispatcher::instance()), hasValidReceiver(true), slotObj(nullptr)
 {
     timerId = startTimer(msec, timerType);
     connect(this, SIGNAL(timeout()), r, member);
 }
 
-QSingleShotTimer::QSingleShotTimer(int msec, Qt::TimerType timerType, const QObject *r, QtPrivate::QSlotObjectBase *slotObj)
-    : QObject(QAbstractEventDispatcher::instance()), hasValidReceiver(r), receiver(r), slotObj(slotObj)
+QSingleShotTimer::QSingleShotTimer(QObjectPrivate &dd, int msec, Qt::TimerType timerType, const QObject *r, QtPrivate::QSlotObjectBase *slotObj)
+    : QObject(dd, QAbstractEventDispatcher::instance()), hasValidReceiver(r), receiver(r), slotObj(slotObj)
 {
     timerId = startTimer(msec, timerType);
     if (r && thread() != r->thread()) {
@@ -410,7 +411,7 @@ void QTimer::singleShotImpl(int msec, Qt::TimerType timerType,
         return;
     }
 
-    new QSingleShotTimer(msec, timerType, receiver, slotObj);
+    QObjectPrivate::createCoAllocated<QSingleShotTimer>(msec, timerType, receiver, slotObj);
 }
 
 /*!
@@ -473,7 +474,7 @@ void QTimer::singleShot(int msec, Qt::TimerType timerType, const QObject *receiv
             QMetaObject::invokeMethod(const_cast<QObject *>(receiver), methodName.constData(), Qt::QueuedConnection);
             return;
         }
-        (void) new QSingleShotTimer(msec, timerType, receiver, member);
+        (void) QObjectPrivate::createCoAllocated<QSingleShotTimer>(msec, timerType, receiver, member);
     }
 }
 
@@ -40,11 +40,15 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
 #include "private/qobject_p.h"
 #include "private/qabstracteventdispatcher_p.h"
+#include "private/qcoremetrics_p.h"
+
+#include <qtcore_tracepoints_p.h>
 
 #ifdef QTIMERINFO_DEBUG
 #  include <QDebug>
@@ -53,6 +57,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
@@ -170,18 +176,122 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+/*
+  Timers are ordered by timeout; timers with the same timeout fire in the
+  order in which they were (re)inserted.
+*/
+static inline bool timerFiresBefore(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout < t2->timeout)
+        return true;
+    if (t2->timeout < t1->timeout)
+        return false;
+    return t1->sequence < t2->sequence;
+}
+
+void QTimerInfoList::siftUp(qsizetype index)
+{
+    QTimerInfo **heap = data();
+    QTimerInfo *t = heap[index];
+    while (index > 0) {
+        const qsizetype parent = (index - 1) / 4;
+        if (!timerFiresBefore(t, heap[parent]))
+            break;
+        heap[index] = heap[parent];
+        heap[index]->heapIndex = index;
+        index = parent;
+    }
+    heap[index] = t;
+    t->heapIndex = index;
+}
+
+void QTimerInfoList::siftDown(qsizetype index)
+{
+    QTimerInfo **heap = data();
+    const qsizetype n = size();
+    QTimerInfo *t = heap[index];
+    for (;;) {
+        const qsizetype firstChild = 4 * index + 1;
+        if (firstChild >= n)
+            break;
+        const qsizetype endChild = qMin(firstChild + 4, n);
+        qsizetype child = firstChild;
+        for (qsizetype i = firstChild + 1; i < endChild; ++i) {
+            if (timerFiresBefore(heap[i], heap[child]))
+                child = i;
+        }
+        if (!timerFiresBefore(heap[child], t))
+            break;
+        heap[index] = heap[child];
+        heap[index]->heapIndex = index;
+        index = child;
+    }
+    heap[index] = t;
+    t->heapIndex = index;
+}
+
 /*
   insert timer info into list
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
+    ti->sequence = nextSequence++;
+    append(ti);
+    siftUp(size() - 1);
+}
+
+/*
+  take timer info out of the list, without unregistering it
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *ti)
+{
+    const qsizetype index = ti->heapIndex;
+    Q_ASSERT(at(index) == ti);
+    QTimerInfo *last = takeLast();
+    if (last == ti)
+        return;
+    data()[index] = last;
+    last->heapIndex = index;
+    if (index > 0 && timerFiresBefore(last, at((index - 1) / 4)))
+        siftUp(index);
+    else
+        siftDown(index);
+}
+
+/*
+  remove an unregistered timer from the list and delete it
+*/
+void QTimerInfoList::timerDestroy(QTimerInfo *t)
+{
+    timerRemove(t);
+    if (t == firstTimerInfo)
+        firstTimerInfo = nullptr;
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+}
+
+/*
+  Returns the number of timers that have expired at currentTime.
+*/
+qsizetype QTimerInfoList::countExpiredTimers() const
+{
+    // the expired timers form a subtree at the top of the heap
+    qsizetype count = 0;
+    QVarLengthArray<qsizetype, 64> pending;
+    if (!isEmpty())
+        pending.append(0);
+    while (!pending.isEmpty()) {
+        const qsizetype index = pending.last();
+        pending.removeLast();
+        if (currentTime < at(index)->timeout)
+            continue;
+        ++count;
+        const qsizetype endChild = qMin(4 * index + 5, size());
+        for (qsizetype i = 4 * index + 1; i < endChild; ++i)
+            pending.append(i);
     }
-    insert(index+1, ti);
+    return count;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -384,13 +494,27 @@ bool QTimerInfoList::timerWait(timespec &tm)
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
 
-    // Find first waiting timer not already active
+    // Find first waiting timer not already active. Only the timers being
+    // sent by activateTimers() are active, so walk the heap from the top in
+    // timeout order until we get past them.
     QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
+    QVarLengthArray<qsizetype, 16> candidates;
+    if (!isEmpty())
+        candidates.append(0);
+    while (!candidates.isEmpty()) {
+        const auto next = std::min_element(candidates.begin(), candidates.end(),
+                                           [this](qsizetype i1, qsizetype i2) {
+            return timerFiresBefore(at(i1), at(i2));
+        });
+        const qsizetype index = *next;
+        candidates.erase(next);
+        if (!at(index)->activateRef) {
+            t = at(index);
             break;
         }
+        const qsizetype endChild = qMin(4 * index + 5, size());
+        for (qsizetype i = 4 * index + 1; i < endChild; ++i)
+            candidates.append(i);
     }
 
     if (!t)
@@ -419,16 +543,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -490,6 +611,8 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
+    timersByObject.insert(object, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -503,41 +626,25 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t) {
+        // id not found
+        return false;
     }
-    // id not found
-    return false;
+    timersByObject.remove(t->obj, t);
+    timerDestroy(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
+    const QList<QTimerInfo *> timers = timersByObject.values(object);
+    timersByObject.remove(object);
+    for (QTimerInfo *t : timers) {
+        timersById.remove(t->id);
+        timerDestroy(t);
     }
     return true;
 }
@@ -545,15 +652,14 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    const auto range = timersByObject.equal_range(object);
+    for (auto it = range.first; it != range.second; ++it) {
+        const QTimerInfo * const t = *it;
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -561,12 +667,19 @@ QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObj
 /*
     Activate pending timers, returning how many where activated.
 */
+// How long after its timeout a timer is being activated
+static inline qint64 latenessInNsecs(const timespec &currentTime, const timespec &timeout)
+{
+    const timespec lateness = currentTime - timeout;
+    return lateness.tv_sec * Q_INT64_C(1000000000) + lateness.tv_nsec;
+}
+
 int QTimerInfoList::activateTimers()
 {
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
-    int n_act = 0, maxCount = 0;
+    int n_act = 0;
     firstTimerInfo = nullptr;
 
     timespec currentTime = updateCurrentTime();
@@ -575,11 +688,7 @@ int QTimerInfoList::activateTimers()
 
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    qsizetype maxCount = countExpiredTimers();
 
     //fire the timers.
     while (maxCount--) {
@@ -601,7 +710,7 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        timerRemove(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -623,6 +732,13 @@ int QTimerInfoList::activateTimers()
                 << "avg error" << (currentTimerInfo->cumulativeError / currentTimerInfo->count);
 #endif
 
+        Q_TRACE(QTimerInfoList_timerExpired, currentTimerInfo->obj, currentTimerInfo->id,
+                latenessInNsecs(currentTime, currentTimerInfo->timeout));
+        if (QCoreMetrics::isEnabled()) {
+            QCoreMetrics::timerLateness.record(
+                    latenessInNsecs(currentTime, currentTimerInfo->timeout));
+        }
+
         // determine next timeout time
         calculateNextTimeout(currentTimerInfo, currentTime);
 
@@ -634,6 +750,7 @@ int QTimerInfoList::activateTimers()
         // Send event, but don't allow it to recurse:
         if (!currentTimerInfo->activateRef) {
             currentTimerInfo->activateRef = &currentTimerInfo;
+            Q_TRACE_SCOPE(QTimerInfoList_activateTimer, currentTimerInfo->obj, currentTimerInfo->id);
 
             QTimerEvent e(currentTimerInfo->id);
             QCoreApplication::sendEvent(currentTimerInfo->obj, &e);
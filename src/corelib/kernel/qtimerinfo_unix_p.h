@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +70,8 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    qsizetype heapIndex; // - position in QTimerInfoList
+    quint64 sequence; // - insertion order, breaks ties between equal timeouts
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -77,6 +80,10 @@ struct QTimerInfo {
 #endif
 };
 
+// The list is kept as a 4-ary min-heap on (timeout, sequence), so that
+// constFirst() is the next timer to fire and registering, unregistering and
+// rescheduling a timer are O(log n); the order of the other entries is
+// unspecified.
 class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
@@ -92,6 +99,16 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    QHash<int, QTimerInfo *> timersById;
+    QMultiHash<QObject *, QTimerInfo *> timersByObject;
+    quint64 nextSequence = 0;
+
+    void siftUp(qsizetype index);
+    void siftDown(qsizetype index);
+    void timerRemove(QTimerInfo *);
+    void timerDestroy(QTimerInfo *);
+    qsizetype countExpiredTimers() const;
+
 public:
     QTimerInfoList();
 
@@ -879,6 +879,10 @@ bool QTranslatorPrivate::do_load(const uchar *data, qsizetype len, const QString
         numerusRulesLength = 0;
     }
 
+    // translations of messages looked up before are out of date now
+    Q_Q(QTranslator);
+    QCoreApplicationPrivate::clearTranslationCache(q);
+
     return ok;
 }
 
@@ -1087,6 +1091,7 @@ void QTranslatorPrivate::clear()
     language.clear();
     filePath.clear();
 
+    QCoreApplicationPrivate::clearTranslationCache(q);
     if (QCoreApplicationPrivate::isTranslatorInstalled(q))
         QCoreApplication::postEvent(QCoreApplication::instance(),
                                     new QEvent(QEvent::LanguageChange));
@@ -686,6 +686,33 @@ QList<QMimeType> QMimeDatabase::mimeTypesForFileName(const QString &fileName) co
         mimes.append(d->mimeTypeForName(mime));
     return mimes;
 }
+/*!
+    \since 6.4
+
+    Returns a MIME type for each of the files named in \a fileNames, using
+    \a mode, in the same order.
+
+    The result is the same as calling mimeTypeForFile() on each file, but the
+    database is locked, and checked for updates, only once for the whole list,
+    which makes this function faster when classifying many files at once.
+
+    \sa mimeTypeForFile()
+*/
+QList<QMimeType> QMimeDatabase::mimeTypesForFiles(const QStringList &fileNames, MatchMode mode) const
+{
+    QMutexLocker locker(&d->mutex);
+
+    QList<QMimeType> mimes;
+    mimes.reserve(fileNames.size());
+    for (const QString &fileName : fileNames) {
+        if (mode == MatchExtension)
+            mimes.append(d->mimeTypeForFileExtension(fileName));
+        else
+            mimes.append(d->mimeTypeForFile(fileName, nullptr, mode));
+    }
+    return mimes;
+}
+
 /*!
     Returns the suffix for the file \a fileName, as known by the MIME database.
 
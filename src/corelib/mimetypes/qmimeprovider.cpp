@@ -47,8 +47,12 @@
 
 #include <QXmlStreamReader>
 #include <QBuffer>
+#include <QDataStream>
 #include <QDir>
 #include <QFile>
+#if QT_CONFIG(temporaryfile)
+#include <QSaveFile>
+#endif
 #include <QByteArrayMatcher>
 #include <QDebug>
 #include <QDateTime>
@@ -623,6 +627,187 @@ static QString internalMimeFileName()
     return QStringLiteral("<internal MIME data>");
 }
 
+/*
+    The bundled database is compiled, on first use, into a cache file holding
+    the provider's data structures in QDataStream format, which loads much
+    faster than the XML can be parsed. The header identifies the bundled
+    database the file was compiled from; a file that doesn't match it is
+    simply compiled again.
+*/
+enum : quint32 {
+    CompiledMimeDatabaseMagic = 0x514d4442, // "QMDB"
+    CompiledMimeDatabaseVersion = 1
+};
+
+static QString compiledMimeDatabaseFileName()
+{
+    if (!qEnvironmentVariableIsEmpty("QT_NO_MIME_CACHE"))
+        return QString();
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty())
+        return QString();
+    return dir + QLatin1String("/qmimedatabase-" QT_VERSION_STR ".cache");
+}
+
+static quint16 bundledMimeDatabaseChecksum()
+{
+    return qChecksum(QByteArrayView(mimetype_database, sizeof(mimetype_database)));
+}
+
+static void writeMagicRules(QDataStream &stream, const QList<QMimeMagicRule> &rules)
+{
+    stream << quint32(rules.size());
+    for (const QMimeMagicRule &rule : rules) {
+        stream << quint8(rule.type()) << rule.value() << qint32(rule.startPos())
+               << qint32(rule.endPos()) << rule.mask();
+        writeMagicRules(stream, rule.m_subMatches);
+    }
+}
+
+static bool readMagicRules(QDataStream &stream, QList<QMimeMagicRule> &rules)
+{
+    quint32 count;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        quint8 type;
+        QByteArray value, mask;
+        qint32 startPos, endPos;
+        stream >> type >> value >> startPos >> endPos >> mask;
+        QString errorString;
+        QMimeMagicRule rule(QString::fromLatin1(QMimeMagicRule::typeName(QMimeMagicRule::Type(type))),
+                            value, QString::number(startPos) + QLatin1Char(':') + QString::number(endPos),
+                            mask, &errorString);
+        if (!rule.isValid() || !readMagicRules(stream, rule.m_subMatches))
+            return false;
+        rules.append(std::move(rule));
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+static void writeGlobs(QDataStream &stream, const QMimeGlobPatternList &globs)
+{
+    stream << quint32(globs.size());
+    for (const QMimeGlobPattern &glob : globs)
+        stream << glob.pattern() << glob.mimeType() << quint32(glob.weight()) << glob.isCaseSensitive();
+}
+
+static void readGlobs(QDataStream &stream, QMimeGlobPatternList &globs)
+{
+    quint32 count;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString pattern, mimeType;
+        quint32 weight;
+        bool caseSensitive;
+        stream >> pattern >> mimeType >> weight >> caseSensitive;
+        globs.append(QMimeGlobPattern(pattern, mimeType, weight,
+                                      caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive));
+    }
+}
+
+bool QMimeXMLProvider::loadCompiled(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QByteArray data;
+    if (uchar *mapped = file.map(0, file.size()))
+        data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), file.size());
+    else
+        data = file.readAll();
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream stream(&buffer);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic, version, compressedSize, originalSize;
+    quint16 checksum;
+    stream >> magic >> version >> compressedSize >> originalSize >> checksum;
+    if (stream.status() != QDataStream::Ok || magic != CompiledMimeDatabaseMagic
+            || version != CompiledMimeDatabaseVersion || compressedSize != sizeof(mimetype_database)
+            || originalSize != MimeTypeDatabaseOriginalSize
+            || checksum != bundledMimeDatabaseChecksum()) {
+        return false;
+    }
+
+    quint32 count;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QMimeTypePrivate mimePrivate;
+        mimePrivate.loaded = true;
+        stream >> mimePrivate.name >> mimePrivate.localeComments >> mimePrivate.genericIconName
+               >> mimePrivate.iconName >> mimePrivate.globPatterns;
+        m_nameMimeTypeMap.insert(mimePrivate.name, QMimeType(mimePrivate));
+    }
+    stream >> m_aliases >> m_parents >> m_mimeTypeGlobs.m_fastPatterns;
+    readGlobs(stream, m_mimeTypeGlobs.m_highWeightGlobs);
+    readGlobs(stream, m_mimeTypeGlobs.m_lowWeightGlobs);
+
+    bool ok = stream.status() == QDataStream::Ok;
+    stream >> count;
+    for (quint32 i = 0; i < count && ok; ++i) {
+        QString mimeType;
+        quint32 priority;
+        stream >> mimeType >> priority;
+        QList<QMimeMagicRule> rules;
+        ok = readMagicRules(stream, rules);
+        QMimeMagicRuleMatcher matcher(mimeType, priority);
+        matcher.addRules(rules);
+        m_magicMatchers.append(std::move(matcher));
+    }
+
+    if (!ok || stream.status() != QDataStream::Ok || !stream.atEnd()) {
+        m_nameMimeTypeMap.clear();
+        m_aliases.clear();
+        m_parents.clear();
+        m_mimeTypeGlobs.clear();
+        m_magicMatchers.clear();
+        return false;
+    }
+    return true;
+}
+
+void QMimeXMLProvider::saveCompiled(const QString &fileName) const
+{
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath()))
+        return;
+#if QT_CONFIG(temporaryfile)
+    QSaveFile file(fileName);
+#else
+    QFile file(fileName);
+#endif
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << quint32(CompiledMimeDatabaseMagic) << quint32(CompiledMimeDatabaseVersion)
+           << quint32(sizeof(mimetype_database)) << quint32(MimeTypeDatabaseOriginalSize)
+           << bundledMimeDatabaseChecksum();
+
+    stream << quint32(m_nameMimeTypeMap.size());
+    for (const QMimeType &mime : m_nameMimeTypeMap) {
+        const QMimeTypePrivate &mimePrivate = *mime.d;
+        stream << mimePrivate.name << mimePrivate.localeComments << mimePrivate.genericIconName
+               << mimePrivate.iconName << mimePrivate.globPatterns;
+    }
+    stream << m_aliases << m_parents << m_mimeTypeGlobs.m_fastPatterns;
+    writeGlobs(stream, m_mimeTypeGlobs.m_highWeightGlobs);
+    writeGlobs(stream, m_mimeTypeGlobs.m_lowWeightGlobs);
+
+    stream << quint32(m_magicMatchers.size());
+    for (const QMimeMagicRuleMatcher &matcher : m_magicMatchers) {
+        stream << matcher.mimetype() << quint32(matcher.priority());
+        writeMagicRules(stream, matcher.magicRules());
+    }
+
+#if QT_CONFIG(temporaryfile)
+    if (stream.status() == QDataStream::Ok)
+        file.commit();
+#endif
+}
+
 QMimeXMLProvider::QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnum)
     : QMimeProviderBase(db, internalMimeFileName())
 {
@@ -631,6 +816,10 @@ QMimeXMLProvider::QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnu
                       "Compressed MIME database is larger than the original size");
     static_assert(MimeTypeDatabaseOriginalSize <= 16*1024*1024,
                       "Bundled MIME database is too big");
+    const QString compiledFileName = compiledMimeDatabaseFileName();
+    if (!compiledFileName.isEmpty() && loadCompiled(compiledFileName))
+        return;
+
     const char *data = reinterpret_cast<const char *>(mimetype_database);
     qsizetype size = MimeTypeDatabaseOriginalSize;
 
@@ -660,6 +849,9 @@ QMimeXMLProvider::QMimeXMLProvider(QMimeDatabasePrivate *db, InternalDatabaseEnu
 #endif
 
     load(data, size);
+
+    if (!compiledFileName.isEmpty())
+        saveCompiled(compiledFileName);
 }
 #else // !QT_CONFIG(mimetype_database)
 // never called in release mode, but some debug builds may need
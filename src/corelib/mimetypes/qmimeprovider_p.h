@@ -174,6 +174,10 @@ public:
 private:
     void load(const QString &fileName);
     void load(const char *data, qsizetype len);
+#if QT_CONFIG(mimetype_database)
+    bool loadCompiled(const QString &fileName);
+    void saveCompiled(const QString &fileName) const;
+#endif
 
     typedef QHash<QString, QMimeType> NameMimeTypeMap;
     NameMimeTypeMap m_nameMimeTypeMap;
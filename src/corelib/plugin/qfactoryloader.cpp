@@ -64,10 +64,16 @@
 
 #if QT_CONFIG(library)
 #  include "qlibrary_p.h"
+#  include "qpluginmetadatacache_p.h"
+#  if QT_CONFIG(thread)
+#    include "qthreadpool.h"
+#  endif
 #endif
 
 #include <qtcore_tracepoints_p.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 bool QPluginParsedMetaData::parse(QByteArrayView raw)
@@ -105,6 +111,16 @@ bool QPluginParsedMetaData::parse(QByteArrayView raw)
     return true;
 }
 
+// Restores a map previously obtained from toCbor(), such as one read back
+// from the plugin metadata cache.
+bool QPluginParsedMetaData::restore(const QCborValue &cached)
+{
+    if (!cached.isMap())
+        return setError(QFactoryLoader::tr("Unexpected metadata contents"));
+    data = cached;
+    return true;
+}
+
 QJsonObject QPluginParsedMetaData::toJson() const
 {
     // convert from the internal CBOR representation to an external JSON one
@@ -164,6 +180,11 @@ struct QFactoryLoaderGlobals
 
 Q_GLOBAL_STATIC(QFactoryLoaderGlobals, qt_factoryloader_global)
 
+#if QT_CONFIG(thread)
+// below this many uncached files, starting threads costs more than it saves
+static constexpr qsizetype MinimumParallelScan = 8;
+#endif
+
 QFactoryLoaderPrivate::~QFactoryLoaderPrivate()
 {
     for (QLibraryPrivate *library : qAsConst(libraryList))
@@ -191,6 +212,15 @@ inline void QFactoryLoaderPrivate::updateSinglePath(const QString &path)
 #endif
                 QDir::Files);
 
+    struct Candidate {
+        QFileInfo fileInfo;
+        std::unique_ptr<QLibraryPrivate, LibraryReleaser> library;
+        bool fromCache;
+    };
+    std::vector<Candidate> candidates;
+    QPluginMetaDataCache cache(path);
+    qsizetype unscanned = 0;
+
     while (plugins.hasNext()) {
         QString fileName = plugins.next();
 #ifdef Q_OS_MAC
@@ -216,9 +246,48 @@ inline void QFactoryLoaderPrivate::updateSinglePath(const QString &path)
 
         Q_TRACE(QFactoryLoader_update, fileName);
 
+        const QFileInfo fileInfo = plugins.fileInfo();
+        QCborValue cached;
+        const auto lookup = cache.lookup(fileInfo, &cached);
+        if (lookup == QPluginMetaDataCache::NotAPlugin) {
+            qCDebug(lcFactoryLoader) << "not a plugin (cached)";
+            continue;
+        }
+
         std::unique_ptr<QLibraryPrivate, LibraryReleaser> library;
-        library.reset(QLibraryPrivate::findOrCreate(QFileInfo(fileName).canonicalFilePath()));
-        if (!library->isPlugin()) {
+        library.reset(QLibraryPrivate::findOrCreate(fileInfo.canonicalFilePath()));
+        if (lookup == QPluginMetaDataCache::Hit) {
+            qCDebug(lcFactoryLoader) << "using cached metadata";
+            library->setCachedMetaData(cached);
+        } else {
+            ++unscanned;
+        }
+        candidates.push_back({ fileInfo, std::move(library), lookup == QPluginMetaDataCache::Hit });
+    }
+
+#if QT_CONFIG(thread)
+    // Extracting the metadata means reading through each file, which adds up
+    // when the cache is cold, so spread it over a few threads. Libraries
+    // don't share state while being scanned.
+    if (unscanned >= MinimumParallelScan) {
+        QThreadPool pool;
+        for (const Candidate &candidate : candidates) {
+            if (!candidate.fromCache) {
+                QLibraryPrivate *library = candidate.library.get();
+                pool.start([library] { library->isPlugin(); });
+            }
+        }
+        pool.waitForDone();
+    }
+#endif
+
+    for (Candidate &candidate : candidates) {
+        auto &library = candidate.library;
+        const bool isPlugin = library->isPlugin();
+        if (!candidate.fromCache)
+            cache.insert(candidate.fileInfo, library->metaData.isError()
+                                             ? QCborValue() : QCborValue(library->metaData.toCbor()));
+        if (!isPlugin) {
             qCDebug(lcFactoryLoader) << library->errorString << Qt::endl
                                      << "         not a plugin";
             continue;
@@ -263,7 +332,9 @@ inline void QFactoryLoaderPrivate::updateSinglePath(const QString &path)
             QMutexLocker locker(&mutex);
             libraryList += library.release();
         }
-    };
+    }
+
+    cache.save();
 }
 
 void QFactoryLoader::update()
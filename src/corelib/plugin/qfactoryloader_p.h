@@ -85,6 +85,7 @@ public:
     bool parse(QByteArrayView input);
     bool parse(QPluginMetaData metaData)
     { return parse(QByteArrayView(reinterpret_cast<const char *>(metaData.data), metaData.size)); }
+    bool restore(const QCborValue &cached);
 
     QJsonObject toJson() const;     // only for QLibrary & QPluginLoader
 
@@ -58,6 +58,7 @@
 #include <private/qcoreapplication_p.h>
 #include <private/qloggingregistry_p.h>
 #include <private/qsystemerror_p.h>
+#include <private/qstartuptimeline_p.h>
 
 #include "qcoffpeparser_p.h"
 #include "qelfparser_p.h"
@@ -537,6 +538,7 @@ bool QLibraryPrivate::load()
         return false;
 
     Q_TRACE(QLibraryPrivate_load_entry, fileName);
+    QStartupTimelineScope timelineScope("QLibrary::load", fileName);
 
     bool ret = load_sys();
     qCDebug(lcDebugLibrary)
@@ -763,6 +765,35 @@ void QLibraryPrivate::updatePluginState()
         return;
     }
 
+    checkPluginMetaData();
+}
+
+/*!
+    \internal
+
+    Seeds the plugin state from metadata found in the plugin cache instead of
+    scanning the file. Returns false if the state was already known, in which
+    case \a cached is ignored.
+*/
+bool QLibraryPrivate::setCachedMetaData(const QCborValue &cached)
+{
+    QMutexLocker locker(&mutex);
+    if (pluginState != MightBeAPlugin)
+        return false;
+
+    errorString.clear();
+    if (!metaData.restore(cached)) {
+        errorString = QLibrary::tr("The file '%1' is not a valid Qt plugin.").arg(fileName);
+        pluginState = IsNotAPlugin;
+        return true;
+    }
+    checkPluginMetaData();
+    return true;
+}
+
+// must be called with the mutex held
+void QLibraryPrivate::checkPluginMetaData()
+{
     pluginState = IsNotAPlugin; // be pessimistic
 
     uint qt_version = uint(metaData.value(QtPluginMetaDataKeys::QtVersion).toInteger());
@@ -118,11 +118,13 @@ public:
 
     void updatePluginState();
     bool isPlugin();
+    bool setCachedMetaData(const QCborValue &cached);
 
 private:
     explicit QLibraryPrivate(const QString &canonicalFileName, const QString &version, QLibrary::LoadHints loadHints);
     ~QLibraryPrivate();
     void mergeLoadHints(QLibrary::LoadHints loadHints);
+    void checkPluginMetaData();
 
     bool load_sys();
     bool unload_sys();
@@ -0,0 +1,233 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qpluginmetadatacache_p.h"
+
+#include "private/qloggingregistry_p.h"
+#include "qcborarray.h"
+#include "qcryptographichash.h"
+#include "qdatetime.h"
+#include "qdir.h"
+#include "qfile.h"
+#include "qfileinfo.h"
+#include "qsavefile.h"
+#include "qstandardpaths.h"
+
+QT_BEGIN_NAMESPACE
+
+static Q_LOGGING_CATEGORY_WITH_ENV_OVERRIDE(lcPluginCache, "QT_DEBUG_PLUGINS",
+                                            "qt.core.plugin.cache")
+
+// Bump whenever the layout below changes or when the way metadata is parsed
+// changes in a way that would make previously cached maps wrong.
+static constexpr int CacheFormatVersion = 1;
+
+namespace {
+namespace CacheKeys {
+static constexpr QLatin1String Version("version");
+static constexpr QLatin1String QtVersion("qt");
+static constexpr QLatin1String Directory("dir");
+static constexpr QLatin1String Entries("entries");
+}
+
+// Each entry is [size, mtime in ms since epoch, metadata map or null]
+enum EntryField { EntrySize, EntryModified, EntryMetaData, EntryFieldCount };
+}
+
+static QString cacheDirectory()
+{
+#ifdef QT_NO_TEMPORARYFILE
+    return QString();
+#else
+    if (qEnvironmentVariableIsSet("QT_NO_PLUGIN_METADATA_CACHE"))
+        return QString();
+
+    QString dir = qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE_DIR");
+    if (dir.isEmpty()) {
+        dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        if (dir.isEmpty())
+            return QString();
+        dir += QLatin1String("/qt" QT_STRINGIFY(QT_VERSION_MAJOR) "/plugin-metadata");
+    }
+    return dir;
+#endif
+}
+
+static QString cacheFileFor(const QString &directory)
+{
+    const QString cacheDir = cacheDirectory();
+    if (cacheDir.isEmpty())
+        return QString();
+
+    const QByteArray hash =
+            QCryptographicHash::hash(directory.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return cacheDir + u'/' + QLatin1String(hash) + QLatin1String(".cbor");
+}
+
+static qint64 modificationTime(const QFileInfo &fileInfo)
+{
+    return fileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+QPluginMetaDataCache::QPluginMetaDataCache(const QString &directory)
+    : directory(QDir::cleanPath(QDir(directory).absolutePath())),
+      cacheFileName(cacheFileFor(this->directory))
+{
+    if (cacheFileName.isEmpty())
+        return;
+
+    QFile file(cacheFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QCborParserError error;
+    const QCborMap root = QCborValue::fromCbor(file.readAll(), &error).toMap();
+    if (error.error != QCborError::NoError) {
+        qCDebug(lcPluginCache) << "ignoring corrupt plugin cache" << cacheFileName
+                               << error.errorString();
+        return;
+    }
+
+    // a hash collision or a cache left behind by a different Qt is as good as
+    // no cache at all
+    if (root.value(CacheKeys::Version).toInteger() != CacheFormatVersion
+            || root.value(CacheKeys::QtVersion).toInteger() != QT_VERSION
+            || root.value(CacheKeys::Directory).toString() != this->directory) {
+        qCDebug(lcPluginCache) << "ignoring stale plugin cache" << cacheFileName;
+        return;
+    }
+
+    entries = root.value(CacheKeys::Entries).toMap();
+    qCDebug(lcPluginCache) << "loaded" << entries.size() << "cached entries for"
+                           << this->directory;
+}
+
+/*!
+    \internal
+
+    Looks up \a fileInfo in the cache. On a hit, the parsed metadata map is
+    stored in \a metaData. NotAPlugin means the file was already scanned with
+    the same size and modification time and did not carry any metadata.
+*/
+QPluginMetaDataCache::LookupResult
+QPluginMetaDataCache::lookup(const QFileInfo &fileInfo, QCborValue *metaData)
+{
+    if (!isEnabled())
+        return Miss;
+
+    const QString key = fileInfo.fileName();
+    const QCborArray entry = entries.value(key).toArray();
+    if (entry.size() != EntryFieldCount
+            || entry.at(EntrySize).toInteger() != fileInfo.size()
+            || entry.at(EntryModified).toInteger() != modificationTime(fileInfo)) {
+        return Miss;
+    }
+
+    seenEntries.insert(key, entry);
+    const QCborValue cached = entry.at(EntryMetaData);
+    if (!cached.isMap())
+        return NotAPlugin;
+    *metaData = cached;
+    return Hit;
+}
+
+/*!
+    \internal
+
+    Records the result of scanning \a fileInfo. Pass a null \a metaData for
+    files that turned out not to be plugins.
+*/
+void QPluginMetaDataCache::insert(const QFileInfo &fileInfo, const QCborValue &metaData)
+{
+    if (!isEnabled())
+        return;
+
+    QCborArray entry;
+    entry.append(fileInfo.size());
+    entry.append(modificationTime(fileInfo));
+    entry.append(metaData.isMap() ? metaData : QCborValue(nullptr));
+    seenEntries.insert(fileInfo.fileName(), entry);
+    dirty = true;
+}
+
+/*!
+    \internal
+
+    Writes the entries looked up or inserted since construction back to disk,
+    dropping those for files that have disappeared. Does nothing if the cache
+    file is already up to date.
+*/
+bool QPluginMetaDataCache::save()
+{
+    if (!isEnabled())
+        return false;
+    if (!dirty && seenEntries.size() == entries.size())
+        return true;
+
+#ifndef QT_NO_TEMPORARYFILE
+    if (!QDir().mkpath(QFileInfo(cacheFileName).path()))
+        return false;
+
+    QCborMap root;
+    root.insert(CacheKeys::Version, CacheFormatVersion);
+    root.insert(CacheKeys::QtVersion, QT_VERSION);
+    root.insert(CacheKeys::Directory, directory);
+    root.insert(CacheKeys::Entries, seenEntries);
+
+    // QSaveFile renames into place, so concurrent readers never see a
+    // partially written cache
+    QSaveFile file(cacheFileName);
+    if (!file.open(QIODevice::WriteOnly)
+            || file.write(root.toCborValue().toCbor()) < 0
+            || !file.commit()) {
+        qCDebug(lcPluginCache) << "could not write plugin cache" << cacheFileName
+                               << file.errorString();
+        return false;
+    }
+
+    qCDebug(lcPluginCache) << "wrote" << seenEntries.size() << "entries to" << cacheFileName;
+    entries = seenEntries;
+    dirty = false;
+    return true;
+#else
+    return false;
+#endif
+}
+
+QT_END_NAMESPACE
@@ -47,6 +47,8 @@
 #include "qrandom.h"
 #include "private/qtools_p.h"
 
+#include <chrono>
+
 QT_BEGIN_NAMESPACE
 
 // 16 bytes (a uint, two shorts and a uchar[8]), each represented by two hex
@@ -283,6 +285,13 @@ static QUuid createFromName(const QUuid &ns, const QByteArray &baseData, QCrypto
     \li 1
     \li Sha1
 
+    \row
+    \li 0
+    \li 1
+    \li 1
+    \li 1
+    \li UnixEpoch
+
     \endtable
 
     The field layouts for the DCE versions listed in the table above
@@ -300,6 +309,10 @@ static QUuid createFromName(const QUuid &ns, const QByteArray &baseData, QCrypto
     \l{http://en.wikipedia.org/wiki/Universally_Unique_Identifier#Random_UUID_probability_of_duplicates}
     {a \e{very} small chance}.
 
+    Random UUIDs are spread evenly over the whole value range. When UUIDs
+    are used as keys of a sorted index, createUuidV7() is a better choice:
+    its UUIDs start with a timestamp and therefore sort in creation order.
+
     UUIDs can be constructed from numeric values or from strings, or
     using the static createUuid() function. They can be converted to a
     string with toString(). UUIDs have a variant() and a version(),
@@ -791,6 +804,8 @@ bool QUuid::isNull() const noexcept
     \value Md5 Alias for Name
     \value Random Random-based, by using random numbers for all sections
     \value Sha1
+    \value UnixEpoch Time-ordered, by using a Unix timestamp in milliseconds
+    for the most significant bits and random numbers for the rest (since Qt 6.4)
 */
 
 /*!
@@ -831,7 +846,7 @@ QUuid::Version QUuid::version() const noexcept
     if (isNull()
          || (variant() != DCE)
          || ver < Time
-         || ver > Sha1)
+         || (ver > Sha1 && ver != UnixEpoch))
         return VerUnknown;
     return ver;
 }
@@ -915,7 +930,7 @@ bool QUuid::operator>(const QUuid &other) const noexcept
     generated using the Windows API and will be of the type that the API
     decides to create.
 
-    \sa variant(), version()
+    \sa variant(), version(), createUuids(), createUuidV7()
 */
 #if defined(Q_OS_WIN)
 
@@ -947,6 +962,86 @@ QUuid QUuid::createUuid()
 }
 #endif // !Q_OS_WIN
 
+/*!
+    \since 6.4
+
+    Fills the array \a uuids with \a count new UUIDs with variant QUuid::DCE
+    and version QUuid::Random.
+
+    This is equivalent to calling createUuid() \a count times, but reads the
+    random data for all UUIDs from the system's random number generator at
+    once.
+
+    \sa createUuid(), createUuidV7()
+*/
+void QUuid::createUuids(QUuid *uuids, qsizetype count)
+{
+    static_assert(sizeof(QUuid) == 4 * sizeof(quint32));
+    if (count <= 0)
+        return;
+
+    QRandomGenerator::system()->fillRange(reinterpret_cast<quint32 *>(uuids), count * 4);
+    for (qsizetype i = 0; i < count; ++i) {
+        QUuid &uuid = uuids[i];
+        uuid.data4[0] = (uuid.data4[0] & 0x3F) | 0x80;      // UV_DCE
+        uuid.data3 = (uuid.data3 & 0x0FFF) | 0x4000;        // UV_Random
+    }
+}
+
+/*!
+    \since 6.4
+
+    Returns a new UUID with variant QUuid::DCE and version QUuid::UnixEpoch,
+    as specified in RFC 9562.
+
+    The 48 most significant bits hold the current time as milliseconds since
+    the Unix epoch, so that UUIDs created later sort after those created
+    earlier. This keeps insertions into sorted indexes, such as database
+    B-trees, local. The following 12 bits are a counter, which starts at a
+    random value every millisecond and guarantees that UUIDs created by the
+    same thread are strictly increasing, even if the system clock goes
+    backwards. The remaining 62 bits are random.
+
+    UUIDs created by different threads within the same millisecond are not
+    ordered relative to each other.
+
+    \sa createUuid(), version(), operator<()
+*/
+QUuid QUuid::createUuidV7()
+{
+    struct State {
+        qint64 msecs = 0;
+        uint counter = 0;
+    };
+    static thread_local State state;
+
+    quint32 random[3];
+    QRandomGenerator::system()->fillRange(random);
+
+    const qint64 now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    if (now > state.msecs) {
+        state.msecs = now;
+        // leave room for the counter to be incremented within this millisecond
+        state.counter = random[2] & 0x7FF;
+    } else if (++state.counter > 0xFFF) {
+        // counter overflow: borrow from the next millisecond
+        ++state.msecs;
+        state.counter = random[2] & 0x7FF;
+    }
+
+    const quint64 msecs = quint64(state.msecs) & Q_UINT64_C(0xFFFFFFFFFFFF);
+    QUuid result(Qt::Uninitialized);
+    result.data1 = uint(msecs >> 16);
+    result.data2 = ushort(msecs);
+    result.data3 = ushort(0x7000 | state.counter);                      // UV_UnixEpoch
+    qToBigEndian(random[0], result.data4);
+    qToBigEndian(random[1], result.data4 + 4);
+    result.data4[0] = (result.data4[0] & 0x3F) | 0x80;                  // UV_DCE
+
+    return result;
+}
+
 /*!
     \fn bool QUuid::operator==(const GUID &guid) const
 
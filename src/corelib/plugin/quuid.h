@@ -82,7 +82,8 @@ public:
         Md5                 = 3, // 0 0 1 1
         Name = Md5,
         Random                = 4,  // 0 1 0 0
-        Sha1                 = 5 // 0 1 0 1
+        Sha1                 = 5, // 0 1 0 1
+        UnixEpoch        = 7  // 0 1 1 1
     };
 
     enum StringFormat {
@@ -168,6 +169,8 @@ public:
     }
 #endif
     static QUuid createUuid();
+    static void createUuids(QUuid *uuids, qsizetype count);
+    static QUuid createUuidV7();
 #ifndef QT_BOOTSTRAPPED
     static QUuid createUuidV3(const QUuid &ns, const QByteArray &baseData);
 #endif
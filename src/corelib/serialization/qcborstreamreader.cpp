@@ -568,6 +568,9 @@ public:
     QByteArray::size_type bufferStart;
     bool corrupt = false;
 
+    // holds the last chunk returned by a view read from a QIODevice
+    QByteArray viewBuffer;
+
     QCborStreamReaderPrivate(const QByteArray &data)
         : device(nullptr), buffer(data)
     {
@@ -652,15 +655,18 @@ public:
             char *ptr;
             QByteArray *array;
             QString *string;
+            QByteArrayView *view;
         };
-        enum { ByteArray = -1, String = -3 };
+        enum { ByteArray = -1, String = -3, View = -5 };
         qsizetype maxlen_or_type;
 
         ReadStringChunk(char *ptr, qsizetype maxlen) : ptr(ptr), maxlen_or_type(maxlen) {}
         ReadStringChunk(QByteArray *array) : array(array), maxlen_or_type(ByteArray) {}
         ReadStringChunk(QString *str) : string(str), maxlen_or_type(String) {}
+        ReadStringChunk(QByteArrayView *view) : view(view), maxlen_or_type(View) {}
         bool isString() const { return maxlen_or_type == String; }
         bool isByteArray() const { return maxlen_or_type == ByteArray; }
+        bool isView() const { return maxlen_or_type == View; }
         bool isPlainPointer() const { return maxlen_or_type >= 0; }
     };
 
@@ -1452,6 +1458,72 @@ QCborStreamReader::readStringChunk(char *ptr, qsizetype maxlen)
     return r;
 }
 
+/*!
+    \since 6.4
+
+    Decodes one string chunk from the CBOR string and returns a view of its
+    UTF-8 contents. Like readString(), this function must be called in a loop
+    until it returns a \l StringResult whose status is not \l Ok, even if
+    isLengthKnown() is true.
+
+    If this reader operates on a QByteArray or a memory buffer, the returned
+    view points directly into that data and no copy is made. The view remains
+    valid for as long as the data the reader was given does, until addData(),
+    clear() or reparse() is called. If this reader operates on a QIODevice, the
+    chunk is read into an internal buffer that is reused by the next call to
+    this function or to readByteArrayView().
+
+    Unlike readStringChunk(), this function verifies that the chunk is valid
+    UTF-8 and reports QCborError::InvalidUtf8String otherwise, like
+    readString(). It may only be called if isString() is true.
+
+    \sa readString(), readByteArrayView(), isString()
+ */
+QCborStreamReader::StringResult<QUtf8StringView> QCborStreamReader::readUtf8StringView()
+{
+    Q_ASSERT(isString());
+    StringResult<QByteArrayView> r = _readStringChunkView_helper();
+    StringResult<QUtf8StringView> result;
+    result.status = r.status;
+    if (r.status == Ok && !QUtf8::isValidUtf8(r.data).isValidUtf8) {
+        d->handleError(CborErrorInvalidUtf8TextString);
+        result.status = Error;
+    } else {
+        result.data = QUtf8StringView(r.data.data(), r.data.size());
+    }
+    return result;
+}
+
+/*!
+    \fn QCborStreamReader::StringResult<QByteArrayView> QCborStreamReader::readByteArrayView()
+    \since 6.4
+
+    Decodes one byte array chunk from the CBOR string and returns a view of
+    it. Like readByteArray(), this function must be called in a loop until it
+    returns a \l StringResult whose status is not \l Ok, even if
+    isLengthKnown() is true.
+
+    If this reader operates on a QByteArray or a memory buffer, the returned
+    view points directly into that data and no copy is made. See
+    readUtf8StringView() for how long the returned view remains valid.
+
+    This function may only be called if isByteArray() is true.
+
+    \sa readByteArray(), readUtf8StringView(), isByteArray()
+ */
+QCborStreamReader::StringResult<QByteArrayView> QCborStreamReader::_readStringChunkView_helper()
+{
+    StringResult<QByteArrayView> result;
+    auto r = d->readStringChunk(&result.data);
+    result.status = r.status;
+    if (r.status == Error) {
+        result.data = {};
+    } else if (r.status == EndOfString && lastError() == QCborError::NoError) {
+        preparse();
+    }
+    return result;
+}
+
 // used by qcborvalue.cpp
 QCborStreamReader::StringResultCode qt_cbor_append_string_chunk(QCborStreamReader &reader, QByteArray *data)
 {
@@ -1529,6 +1601,16 @@ QCborStreamReaderPrivate::readStringChunk(ReadStringChunk params)
     if (params.isString()) {
         // readString()
         result.data = readStringChunk_unicode(params, qsizetype(len));
+    } else if (params.isView() && !device) {
+        // readByteArrayView() or readUtf8StringView(): point into the buffer
+        *params.view = QByteArrayView(buffer.constData() + bufferStart, qsizetype(len));
+        result.data = qsizetype(len);
+    } else if (params.isView()) {
+        // same, but the chunk must be read out of the QIODevice first
+        viewBuffer.clear();
+        ReadStringChunk into(&viewBuffer);
+        result.data = readStringChunk_byte(into, qsizetype(len));
+        *params.view = viewBuffer;
     } else {
         // readByteArray() or readStringChunk()
         result.data = readStringChunk_byte(params, qsizetype(len));
@@ -157,6 +157,9 @@ public:
     StringResult<QByteArray> readByteArray(){ Q_ASSERT(isByteArray()); return _readByteArray_helper(); }
     qsizetype currentStringChunkSize() const{ Q_ASSERT(isString() || isByteArray()); return _currentStringChunkSize(); }
     StringResult<qsizetype> readStringChunk(char *ptr, qsizetype maxlen);
+    StringResult<QUtf8StringView> readUtf8StringView();
+    StringResult<QByteArrayView> readByteArrayView()
+    { Q_ASSERT(isByteArray()); return _readStringChunkView_helper(); }
 
     bool toBool() const                 { Q_ASSERT(isBool()); return value64 - int(QCborSimpleType::False); }
     QCborTag toTag() const              { Q_ASSERT(isTag()); return QCborTag(value64); }
@@ -181,6 +184,7 @@ private:
     bool _enterContainer_helper();
     StringResult<QString> _readString_helper();
     StringResult<QByteArray> _readByteArray_helper();
+    StringResult<QByteArrayView> _readStringChunkView_helper();
     qsizetype _currentStringChunkSize() const;
 
     template <typename FP> FP _toFloatingPoint() const noexcept
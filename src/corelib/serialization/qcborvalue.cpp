@@ -919,6 +919,101 @@ static inline int typeOrder(Element e1, Element e2)
     return comparable(e1) - comparable(e2);
 }
 
+QCborArena *QCborArena::create(qsizetype sizeHint)
+{
+    // the arena object itself lives at the start of its first block
+    const qsizetype blockSize = sizeof(QCborArena) + qMax(sizeHint, qsizetype(256));
+    void *memory = ::malloc(blockSize);
+    Q_CHECK_PTR(memory);
+    auto arena = new (memory) QCborArena;
+    arena->ptr = static_cast<char *>(memory) + sizeof(QCborArena);
+    arena->end = static_cast<char *>(memory) + blockSize;
+    arena->lastBlockSize = blockSize;
+    return arena;
+}
+
+void *QCborArena::allocate(qsizetype size, qsizetype alignment)
+{
+    Q_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    auto aligned = [=](char *p) {
+        return reinterpret_cast<char *>((quintptr(p) + alignment - 1) & ~quintptr(alignment - 1));
+    };
+
+    char *result = aligned(ptr);
+    if (end - result < size) {
+        // grow geometrically, but keep huge requests in blocks of their own
+        constexpr qsizetype MaxBlockSize = 1024 * 1024;
+        lastBlockSize = qMin(lastBlockSize * 2, MaxBlockSize);
+        const qsizetype blockSize = qMax(lastBlockSize, qsizetype(sizeof(Block)) + size + alignment);
+        auto block = static_cast<Block *>(::malloc(blockSize));
+        Q_CHECK_PTR(block);
+        block->next = blocks;
+        blocks = block;
+        ptr = reinterpret_cast<char *>(block + 1);
+        end = reinterpret_cast<char *>(block) + blockSize;
+        result = aligned(ptr);
+    }
+    ptr = result + size;
+    return result;
+}
+
+void QCborArena::destroy() noexcept
+{
+    for (Block *block = blocks; block; ) {
+        Block *next = block->next;
+        ::free(block);
+        block = next;
+    }
+    this->~QCborArena();
+    ::free(this);
+}
+
+// The arena pointer precedes each container allocated in the arena
+static_assert(alignof(QCborContainerPrivate) <= sizeof(QCborArena *));
+static constexpr size_t ContainerHeaderSize = sizeof(QCborArena *);
+
+static QCborArena *&containerArena(void *ptr) noexcept
+{
+    auto header = static_cast<char *>(ptr) - ContainerHeaderSize;
+    return *reinterpret_cast<QCborArena **>(header);
+}
+
+// The destructor can still read arenaAllocated, operator delete can't, so the
+// destructor names the arena container that operator delete must not free.
+// Both run on the same thread, right after each other.
+static thread_local void *arenaContainerBeingDeleted = nullptr;
+
+void *QCborContainerPrivate::operator new(size_t size)
+{
+    return ::operator new(size);
+}
+
+void *QCborContainerPrivate::operator new(size_t size, QCborArena *arena)
+{
+    Q_ASSERT(arena);
+    auto memory = static_cast<char *>(arena->allocate(ContainerHeaderSize + size,
+                                                      alignof(QCborContainerPrivate)));
+    *reinterpret_cast<QCborArena **>(memory) = arena;
+    arena->ref();
+    return memory + ContainerHeaderSize;
+}
+
+void QCborContainerPrivate::operator delete(void *ptr) noexcept
+{
+    if (ptr && ptr == arenaContainerBeingDeleted) {
+        arenaContainerBeingDeleted = nullptr;
+        containerArena(ptr)->deref();
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+void QCborContainerPrivate::operator delete(void *ptr, QCborArena *arena) noexcept
+{
+    Q_UNUSED(ptr);
+    arena->deref();
+}
+
 QCborContainerPrivate::~QCborContainerPrivate()
 {
     // delete our elements
@@ -926,6 +1021,10 @@ QCborContainerPrivate::~QCborContainerPrivate()
         if (e.flags & Element::IsContainer)
             e.container->deref();
     }
+
+    // after the elements, whose destruction may delete other arena containers
+    if (arenaAllocated)
+        arenaContainerBeingDeleted = this;
 }
 
 void QCborContainerPrivate::compact(qsizetype reserved)
@@ -943,7 +1042,14 @@ QCborContainerPrivate *QCborContainerPrivate::clone(QCborContainerPrivate *d, qs
     if (!d) {
         d = new QCborContainerPrivate;
     } else {
+        const bool fromArena = d->isArenaAllocated();
         d = new QCborContainerPrivate(*d);
+        d->arenaAllocated = false;
+        if (fromArena) {
+            // the storage belongs to the arena, which the copy doesn't keep alive
+            d->elements.detach();
+            d->data.detach();
+        }
         if (reserved >= 0) {
             d->elements.reserve(reserved);
             d->compact(reserved);
@@ -1483,7 +1589,8 @@ static Element decodeBasicValueFromCbor(QCborStreamReader &reader)
     return e;
 }
 
-static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                                             QCborArenaDecoder *arena)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
@@ -1500,42 +1607,44 @@ static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &
         // QList::size_type).
         len = qMin(len, quint64(1024 * 1024 - 1));
         if (len) {
-            d = new QCborContainerPrivate;
+            d = arena ? arena->createContainer() : new QCborContainerPrivate;
             d->ref.storeRelaxed(1);
             d->elements.reserve(qsizetype(len) << mapShift);
         }
     } else {
-        d = new QCborContainerPrivate;
+        d = arena ? arena->createContainer() : new QCborContainerPrivate;
         d->ref.storeRelaxed(1);
     }
 
     reader.enterContainer();
-    if (reader.lastError() != QCborError::NoError)
-        return d;
-
-    while (reader.hasNext() && reader.lastError() == QCborError::NoError)
-        d->decodeValueFromCbor(reader, remainingRecursionDepth - 1);
+    if (reader.lastError() == QCborError::NoError) {
+        while (reader.hasNext() && reader.lastError() == QCborError::NoError)
+            d->decodeValueFromCbor(reader, remainingRecursionDepth - 1, arena);
 
-    if (reader.lastError() == QCborError::NoError)
-        reader.leaveContainer();
+        if (reader.lastError() == QCborError::NoError)
+            reader.leaveContainer();
+    }
 
+    if (arena)
+        arena->finishContainer(d);
     return d;
 }
 
-static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                      QCborArenaDecoder *arena)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
         return QCborValue::Invalid;
     }
 
-    auto d = new QCborContainerPrivate;
+    auto d = arena ? arena->createContainer() : new QCborContainerPrivate;
     d->append(reader.toTag());
     reader.next();
 
     if (reader.lastError() == QCborError::NoError) {
         // decode tagged value
-        d->decodeValueFromCbor(reader, remainingRecursionDepth - 1);
+        d->decodeValueFromCbor(reader, remainingRecursionDepth - 1, arena);
     }
 
     QCborValue::Type type;
@@ -1547,6 +1656,9 @@ static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRe
         type = QCborValue::Invalid;
     }
 
+    if (arena)
+        arena->finishContainer(d);
+
     // note: may return invalid state!
     return QCborContainerPrivate::makeValue(type, -1, d);
 }
@@ -1667,7 +1779,8 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
     }
 }
 
-void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                                QCborArenaDecoder *arena)
 {
     QCborStreamReader::Type t = reader.type();
     switch (t) {
@@ -1688,11 +1801,11 @@ void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int r
     case QCborStreamReader::Array:
     case QCborStreamReader::Map:
         return append(makeValue(t == QCborStreamReader::Array ? QCborValue::Array : QCborValue::Map, -1,
-                                createContainerFromCbor(reader, remainingRecursionDepth),
+                                createContainerFromCbor(reader, remainingRecursionDepth, arena),
                                 MoveContainer));
 
     case QCborStreamReader::Tag:
-        return append(taggedValueFromCbor(reader, remainingRecursionDepth));
+        return append(taggedValueFromCbor(reader, remainingRecursionDepth, arena));
 
     case QCborStreamReader::Invalid:
         return;                 // probably a decode error
@@ -2424,6 +2537,11 @@ enum { MaximumRecursionDepth = 1024 };
     \sa toCbor(), toDiagnosticNotation(), toVariant(), toJsonValue()
  */
 QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
+{
+    return QCborContainerPrivate::decodeFromCbor(reader, nullptr);
+}
+
+QCborValue QCborContainerPrivate::decodeFromCbor(QCborStreamReader &reader, QCborArenaDecoder *arena)
 {
     QCborValue result;
     auto t = reader.type();
@@ -2452,23 +2570,25 @@ QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
     case QCborStreamReader::ByteArray:
     case QCborStreamReader::String:
         result.n = 0;
-        result.t = reader.isString() ? String : ByteArray;
-        result.container = new QCborContainerPrivate;
+        result.t = reader.isString() ? QCborValue::String : QCborValue::ByteArray;
+        result.container = arena ? arena->createContainer() : new QCborContainerPrivate;
         result.container->ref.ref();
         result.container->decodeStringFromCbor(reader);
+        if (arena)
+            arena->finishContainer(result.container);
         break;
 
     // containers
     case QCborStreamReader::Array:
     case QCborStreamReader::Map:
         result.n = -1;
-        result.t = reader.isArray() ? Array : Map;
-        result.container = createContainerFromCbor(reader, MaximumRecursionDepth);
+        result.t = reader.isArray() ? QCborValue::Array : QCborValue::Map;
+        result.container = createContainerFromCbor(reader, MaximumRecursionDepth, arena);
         break;
 
     // tag
     case QCborStreamReader::Tag:
-        result = taggedValueFromCbor(reader, MaximumRecursionDepth);
+        result = taggedValueFromCbor(reader, MaximumRecursionDepth, arena);
         break;
     }
 
@@ -2508,6 +2628,121 @@ QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error)
     return result;
 }
 
+#endif // QT_CONFIG(cborstreamreader)
+
+/*!
+    \internal
+    \class QCborArenaDecoder
+
+    Decodes CBOR and JSON into QCborValue and QJsonDocument trees whose
+    containers, element lists and string data are all placed into a single
+    monotonic arena, which is released in one step when the last container of
+    the tree is destroyed. This replaces the several heap allocations per
+    nested array or map of regular decoding with a few arena blocks per
+    document.
+
+    The decoder keeps the buffers used while the containers are being filled
+    and reuses them for the next document, so one decoder should be kept
+    around to decode many documents. It must not be used by several threads
+    at the same time, but the trees it returns behave like any other and may
+    be modified, copied and destroyed in any thread. Modifying a container
+    moves its contents to the regular heap.
+*/
+
+QCborArenaDecoder::QCborArenaDecoder() = default;
+
+QCborArenaDecoder::~QCborArenaDecoder()
+{
+    end();
+}
+
+#if QT_CONFIG(cborstreamreader)
+/*!
+    Decodes one item from the CBOR stream in \a ba, like
+    QCborValue::fromCbor(const QByteArray &, QCborParserError *) does.
+*/
+QCborValue QCborArenaDecoder::fromCbor(const QByteArray &ba, QCborParserError *error)
+{
+    // small integers expand to full elements, so reserve more than the input
+    begin(ba.size() * 4);
+    QCborStreamReader reader(ba);
+    QCborValue result = QCborContainerPrivate::decodeFromCbor(reader, this);
+    end();
+    if (error) {
+        error->error = reader.lastError();
+        error->offset = reader.currentOffset();
+    }
+    return result;
+}
+#endif
+
+// Starts a new tree in a fresh arena of about sizeHint bytes.
+void QCborArenaDecoder::begin(qsizetype sizeHint)
+{
+    end();
+    arena = QCborArena::create(qMin(sizeHint, qsizetype(1024 * 1024)));
+}
+
+// Drops the decoder's own reference; the containers keep the arena alive.
+void QCborArenaDecoder::end()
+{
+    if (arena)
+        arena->deref();
+    arena = nullptr;
+}
+
+// Creates a container in the arena, giving it spare buffers to grow into.
+QCborContainerPrivate *QCborArenaDecoder::createContainer()
+{
+    Q_ASSERT(arena);
+    auto d = new (arena) QCborContainerPrivate;
+    d->arenaAllocated = true;
+    if (!spareElements.isEmpty())
+        d->elements = spareElements.takeLast();
+    if (!spareData.isEmpty())
+        d->data = spareData.takeLast();
+    return d;
+}
+
+// Copies the contents of a container that is done being filled into the
+// arena and keeps the buffers it was filled in for the next container.
+void QCborArenaDecoder::finishContainer(QCborContainerPrivate *d)
+{
+    constexpr qsizetype MaxSpareBuffers = 64;
+    constexpr qsizetype MaxSpareSize = 64 * 1024;
+    if (!d)
+        return;
+
+    if (d->elements.isDetached()) {
+        QList<QtCbor::Element> buffer = std::move(d->elements);
+        if (const qsizetype n = buffer.size()) {
+            auto ptr = static_cast<QtCbor::Element *>(
+                        arena->allocate(n * sizeof(QtCbor::Element), alignof(QtCbor::Element)));
+            memcpy(ptr, buffer.constData(), n * sizeof(QtCbor::Element));
+            d->elements = QList<QtCbor::Element>(
+                        QArrayDataPointer<QtCbor::Element>::fromRawData(ptr, n));
+        }
+        if (spareElements.size() < MaxSpareBuffers
+                && buffer.capacity() * qsizetype(sizeof(QtCbor::Element)) <= MaxSpareSize) {
+            buffer.clear();
+            spareElements.append(std::move(buffer));
+        }
+    }
+
+    if (d->data.isDetached()) {
+        QByteArray buffer = std::move(d->data);
+        if (const qsizetype n = buffer.size()) {
+            auto ptr = static_cast<char *>(arena->allocate(n, alignof(QtCbor::ByteData)));
+            memcpy(ptr, buffer.constData(), n);
+            d->data = QByteArray::fromRawData(ptr, n);
+        }
+        if (spareData.size() < MaxSpareBuffers && buffer.capacity() <= MaxSpareSize) {
+            buffer.truncate(0);
+            spareData.append(std::move(buffer));
+        }
+    }
+}
+
 /*!
     \fn QCborValue QCborValue::fromCbor(const char *data, qsizetype len, QCborParserError *error)
     \fn QCborValue QCborValue::fromCbor(const quint8 *data, qsizetype len, QCborParserError *error)
@@ -2517,7 +2752,6 @@ QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error)
     overload of this function that accepts a QByteArray, also passing \a error,
     if provided.
 */
-#endif // QT_CONFIG(cborstreamreader)
 
 #if QT_CONFIG(cborstreamwriter)
 /*!
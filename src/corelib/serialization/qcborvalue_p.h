@@ -126,6 +126,37 @@ static_assert(std::is_standard_layout<ByteData>::value);
 
 Q_DECLARE_TYPEINFO(QtCbor::Element, Q_PRIMITIVE_TYPE);
 
+class QCborArenaDecoder;
+class QJsonDocument;
+struct QJsonParseError;
+
+// Monotonic memory for the containers of one decoded tree. Every container
+// allocated in the arena holds a reference to it, so the memory is released
+// in one step, when the last of them is gone.
+class QCborArena
+{
+    Q_DISABLE_COPY_MOVE(QCborArena)
+public:
+    static QCborArena *create(qsizetype sizeHint);
+
+    void *allocate(qsizetype size, qsizetype alignment);
+    void ref() noexcept { refCount.ref(); }
+    void deref() noexcept { if (!refCount.deref()) destroy(); }
+
+private:
+    struct Block { Block *next; };
+
+    QCborArena() = default;
+    ~QCborArena() = default;
+    void destroy() noexcept;
+
+    QAtomicInt refCount = 1;
+    Block *blocks = nullptr;
+    char *ptr = nullptr;
+    char *end = nullptr;
+    qsizetype lastBlockSize = 0;
+};
+
 class QCborContainerPrivate : public QSharedData
 {
     friend class QExplicitlySharedDataPointer<QCborContainerPrivate>;
@@ -134,10 +165,20 @@ class QCborContainerPrivate : public QSharedData
 public:
     enum ContainerDisposition { CopyContainer, MoveContainer };
 
+    // fits in the padding after the reference count
+    bool arenaAllocated = false;
     QByteArray::size_type usedData = 0;
     QByteArray data;
     QList<QtCbor::Element> elements;
 
+    // Containers allocated in an arena are preceded by a pointer to it, so
+    // that delete can return their memory to the arena.
+    static void *operator new(size_t size);
+    static void *operator new(size_t size, QCborArena *arena);
+    static void operator delete(void *ptr) noexcept;
+    static void operator delete(void *ptr, QCborArena *arena) noexcept;
+    bool isArenaAllocated() const noexcept { return arenaAllocated; }
+
     void deref() { if (!ref.deref()) delete this; }
     void compact(qsizetype reserved);
     static QCborContainerPrivate *clone(QCborContainerPrivate *d, qsizetype reserved = -1);
@@ -420,12 +461,38 @@ public:
     }
 
 #if QT_CONFIG(cborstreamreader)
-    void decodeValueFromCbor(QCborStreamReader &reader, int remainingStackDepth);
+    static QCborValue decodeFromCbor(QCborStreamReader &reader, QCborArenaDecoder *arena);
+    void decodeValueFromCbor(QCborStreamReader &reader, int remainingStackDepth,
+                             QCborArenaDecoder *arena);
     void decodeStringFromCbor(QCborStreamReader &reader);
     static inline void setErrorInReader(QCborStreamReader &reader, QCborError error);
 #endif
 };
 
+class Q_CORE_EXPORT QCborArenaDecoder
+{
+    Q_DISABLE_COPY_MOVE(QCborArenaDecoder)
+public:
+    QCborArenaDecoder();
+    ~QCborArenaDecoder();
+
+#if QT_CONFIG(cborstreamreader)
+    QCborValue fromCbor(const QByteArray &ba, QCborParserError *error = nullptr);
+#endif
+    QJsonDocument fromJson(const QByteArray &json, QJsonParseError *error = nullptr);
+
+    // for the decoders
+    void begin(qsizetype sizeHint);
+    void end();
+    QCborContainerPrivate *createContainer();
+    void finishContainer(QCborContainerPrivate *d);
+
+private:
+    QCborArena *arena = nullptr;
+    QList<QList<QtCbor::Element>> spareElements;
+    QList<QByteArray> spareData;
+};
+
 QT_END_NAMESPACE
 
 #endif // QCBORVALUE_P_H
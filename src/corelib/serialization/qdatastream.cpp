@@ -1472,6 +1472,95 @@ int QDataStream::skipRawData(int len)
     \sa {Serializing Qt Data Types}
 */
 
+namespace QtPrivate {
+
+static void swapBulkArray(const void *source, qsizetype count, int elementSize, void *dest)
+{
+    switch (elementSize) {
+    case 2:
+        qbswap<2>(source, count, dest);
+        break;
+    case 4:
+        qbswap<4>(source, count, dest);
+        break;
+    case 8:
+        qbswap<8>(source, count, dest);
+        break;
+    default:
+        Q_ASSERT(elementSize == 1);
+        if (source != dest)
+            memcpy(dest, source, count);
+        break;
+    }
+}
+
+/*!
+    \internal
+
+    Reads \a count elements of \a elementSize bytes each from \a s straight
+    into \a data, then converts them from the stream's byte order in one pass.
+    This is the fast path of operator>>() for a QList of arithmetic types.
+*/
+void readBulkArray(QDataStream &s, void *data, qsizetype count, int elementSize)
+{
+    // readRawData() takes an int, so read very large arrays in blocks
+    constexpr qsizetype MaxBlockSize = 1 << 30;
+    char *ptr = static_cast<char *>(data);
+    qsizetype remaining = count * elementSize;
+    while (remaining > 0) {
+        const int len = int(qMin(remaining, MaxBlockSize));
+        if (s.readRawData(ptr, len) != len) {
+            s.setStatus(QDataStream::ReadPastEnd);
+            return;
+        }
+        ptr += len;
+        remaining -= len;
+    }
+
+    if (elementSize > 1 && s.byteOrder() != QDataStream::ByteOrder(QSysInfo::ByteOrder))
+        swapBulkArray(data, count, elementSize, data);
+}
+
+/*!
+    \internal
+
+    Writes \a count elements of \a elementSize bytes each from \a data to \a s
+    in the stream's byte order, with one device write per block rather than
+    one per element. This is the fast path of operator<<() for a QList of
+    arithmetic types.
+*/
+void writeBulkArray(QDataStream &s, const void *data, qsizetype count, int elementSize)
+{
+    const char *ptr = static_cast<const char *>(data);
+    if (elementSize == 1 || s.byteOrder() == QDataStream::ByteOrder(QSysInfo::ByteOrder)) {
+        constexpr qsizetype MaxBlockSize = 1 << 30;
+        qsizetype remaining = count * elementSize;
+        while (remaining > 0 && s.status() == QDataStream::Ok) {
+            const int len = int(qMin(remaining, MaxBlockSize));
+            if (s.writeRawData(ptr, len) != len)
+                return;
+            ptr += len;
+            remaining -= len;
+        }
+        return;
+    }
+
+    // swap through a small buffer, since we can't modify the source
+    alignas(quint64) char buffer[16384];
+    const qsizetype elementsPerBlock = qsizetype(sizeof(buffer)) / elementSize;
+    while (count > 0 && s.status() == QDataStream::Ok) {
+        const qsizetype n = qMin(count, elementsPerBlock);
+        const int len = int(n * elementSize);
+        swapBulkArray(ptr, n, elementSize, buffer);
+        if (s.writeRawData(buffer, len) != len)
+            return;
+        ptr += len;
+        count -= n;
+    }
+}
+
+} // namespace QtPrivate
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_DATASTREAM
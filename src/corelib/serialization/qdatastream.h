@@ -350,6 +350,69 @@ QDataStream &writeAssociativeMultiContainer(QDataStream &s, const Container &c)
     return s;
 }
 
+// Element types of QList whose stream representation is their in-memory
+// representation, possibly byte-swapped
+template <typename T>
+constexpr bool IsBulkStreamable = std::is_same_v<T, char>
+        || std::is_same_v<T, qint8> || std::is_same_v<T, quint8>
+        || std::is_same_v<T, qint16> || std::is_same_v<T, quint16>
+        || std::is_same_v<T, qint32> || std::is_same_v<T, quint32>
+        || std::is_same_v<T, qint64> || std::is_same_v<T, quint64>
+        || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>
+        || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <typename T>
+bool canStreamInBulk(const QDataStream &s)
+{
+    // floating point values may be stored with a different precision
+    if constexpr (std::is_same_v<T, float>)
+        return s.version() < QDataStream::Qt_4_6
+                || s.floatingPointPrecision() == QDataStream::SinglePrecision;
+    else if constexpr (std::is_same_v<T, double>)
+        return s.version() < QDataStream::Qt_4_6
+                || s.floatingPointPrecision() == QDataStream::DoublePrecision;
+    else
+        return true;
+}
+
+Q_CORE_EXPORT void readBulkArray(QDataStream &s, void *data, qsizetype count, int elementSize);
+Q_CORE_EXPORT void writeBulkArray(QDataStream &s, const void *data, qsizetype count,
+                                  int elementSize);
+
+template <typename T>
+QDataStream &readBulkList(QDataStream &s, QList<T> &c)
+{
+    if (!canStreamInBulk<T>(s))
+        return readArrayBasedContainer(s, c);
+
+    StreamStateSaver stateSaver(&s);
+
+    c.clear();
+    quint32 n;
+    s >> n;
+    if (s.status() != QDataStream::Ok || n == 0)
+        return s;
+
+    c.resize(n);
+    readBulkArray(s, c.data(), c.size(), int(sizeof(T)));
+    if (s.status() != QDataStream::Ok)
+        c.clear();
+
+    return s;
+}
+
+template <typename T>
+QDataStream &writeBulkList(QDataStream &s, const QList<T> &c)
+{
+    if (!canStreamInBulk<T>(s))
+        return writeSequentialContainer(s, c);
+
+    s << quint32(c.size());
+    writeBulkArray(s, c.constData(), c.size(), int(sizeof(T)));
+
+    return s;
+}
+
 } // QtPrivate namespace
 
 template<typename ...T>
@@ -440,13 +503,19 @@ operator>>(QDataStream &s, T &t)
 template<typename T>
 inline QDataStreamIfHasIStreamOperatorsContainer<QList<T>, T> operator>>(QDataStream &s, QList<T> &v)
 {
-    return QtPrivate::readArrayBasedContainer(s, v);
+    if constexpr (QtPrivate::IsBulkStreamable<T>)
+        return QtPrivate::readBulkList(s, v);
+    else
+        return QtPrivate::readArrayBasedContainer(s, v);
 }
 
 template<typename T>
 inline QDataStreamIfHasOStreamOperatorsContainer<QList<T>, T> operator<<(QDataStream &s, const QList<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    if constexpr (QtPrivate::IsBulkStreamable<T>)
+        return QtPrivate::writeBulkList(s, v);
+    else
+        return QtPrivate::writeSequentialContainer(s, v);
 }
 
 template <typename T>
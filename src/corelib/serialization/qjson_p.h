@@ -221,6 +221,8 @@ public:
     static QJsonArray toJsonArray(const QVariantList &list);
 };
 
+void sortContainer(QCborContainerPrivate *container);
+
 } // namespace QJsonPrivate
 
 QT_END_NAMESPACE
@@ -243,12 +243,22 @@ static QJsonArray convertToJsonArray(QCborContainerPrivate *d,
 static QJsonObject convertToJsonObject(QCborContainerPrivate *d,
                                        ConversionMode mode = ConversionMode::FromRaw)
 {
-    QJsonObject o;
-    if (d) {
-        for (qsizetype idx = 0; idx < d->elements.size(); idx += 2)
-            o.insert(makeString(d, idx), qt_convertToJson(d, idx + 1, mode));
+    if (!d || d->elements.isEmpty())
+        return QJsonObject();
+
+    // CBOR map keys are neither sorted nor unique, so collect the converted
+    // pairs first and sort them once
+    QExplicitlySharedDataPointer<QCborContainerPrivate> o(new QCborContainerPrivate);
+    o->elements.reserve(d->elements.size());
+    for (qsizetype idx = 0; idx < d->elements.size(); idx += 2) {
+        o->append(makeString(d, idx));
+        o->append(QCborValue::fromJsonValue(qt_convertToJson(d, idx + 1, mode)));
     }
-    return o;
+    QJsonPrivate::sortContainer(o.data());
+    if (o->elements.isEmpty())
+        return QJsonObject();
+    return QJsonPrivate::Value::fromTrustedCbor(
+                QCborContainerPrivate::makeValue(QCborValue::Map, -1, o.data())).toObject();
 }
 
 QJsonValue qt_convertToJson(QCborContainerPrivate *d, qsizetype idx, ConversionMode mode)
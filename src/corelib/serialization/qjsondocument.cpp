@@ -300,6 +300,32 @@ QByteArray QJsonDocument::toJson(JsonFormat format) const
 
     return json;
 }
+
+/*!
+    \since 6.4
+    \overload
+
+    Writes the QJsonDocument to \a device as a UTF-8 encoded JSON document in
+    the provided \a format, and returns \c true if all of it could be written.
+
+    Unlike the overload returning a QByteArray, this function hands the output
+    to \a device in blocks as it is produced, so the whole text of a large
+    document is never held in memory. \a device must be open for writing. A
+    null document writes nothing.
+
+    \sa fromJson(), JsonFormat
+ */
+bool QJsonDocument::toJson(QIODevice *device, JsonFormat format) const
+{
+    Q_ASSERT(device);
+    if (!d)
+        return true;
+
+    const QCborContainerPrivate *container = QJsonPrivate::Value::container(d->value);
+    if (d->value.isArray())
+        return QJsonPrivate::Writer::arrayToJson(container, device, 0, (format == Compact));
+    return QJsonPrivate::Writer::objectToJson(container, device, 0, (format == Compact));
+}
 #endif
 
 /*!
@@ -324,6 +350,28 @@ QJsonDocument QJsonDocument::fromJson(const QByteArray &json, QJsonParseError *e
     return result;
 }
 
+/*!
+    \internal
+
+    Parses \a json like QJsonDocument::fromJson() does, but places the
+    resulting tree into an arena. See QCborArenaDecoder.
+*/
+QJsonDocument QCborArenaDecoder::fromJson(const QByteArray &json, QJsonParseError *error)
+{
+    // numbers and literals take up more space as elements than as text
+    begin(json.size() * 2);
+    QJsonPrivate::Parser parser(json.constData(), json.length(), this);
+    const QCborValue val = parser.parse(error);
+    end();
+
+    const QJsonValue value = QJsonPrivate::Value::fromTrustedCbor(val);
+    if (value.isArray())
+        return QJsonDocument(value.toArray());
+    if (value.isObject())
+        return QJsonDocument(value.toObject());
+    return QJsonDocument();
+}
+
 /*!
     Returns \c true if the document doesn't contain any data.
  */
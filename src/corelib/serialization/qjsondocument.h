@@ -49,6 +49,7 @@ QT_BEGIN_NAMESPACE
 
 class QDebug;
 class QCborValue;
+class QIODevice;
 
 namespace QJsonPrivate { class Parser; }
 
@@ -118,6 +119,7 @@ public:
 
 #if !defined(QT_JSON_READONLY) || defined(Q_CLANG_QDOC)
     QByteArray toJson(JsonFormat format = Indented) const;
+    bool toJson(QIODevice *device, JsonFormat format = Indented) const;
 #endif
 
     bool isEmpty() const;
@@ -0,0 +1,304 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonlazydocument_p.h"
+#include "qjsonparser_p.h"
+#include "qjson_p.h"
+
+QT_BEGIN_NAMESPACE
+
+using namespace QJsonPrivate;
+
+/*!
+    \class QJsonPrivate::LazyDocument
+    \inmodule QtCore
+    \internal
+
+    \brief The LazyDocument class gives access to the members of a JSON
+    document without decoding the whole document.
+
+    The constructor only scans the top-level object or array to find where
+    each of its members starts; nested values are skipped over without being
+    decoded. A member is parsed the first time it is accessed through value()
+    or valueAt(), and the result is cached. This is much cheaper than
+    QJsonDocument::fromJson() when only a few members of a large document are
+    needed.
+
+    Only the structure of the top level is checked up front. Errors inside a
+    member are reported when that member is decoded. Use toDocument() to parse
+    and validate the whole document.
+
+    LazyDocument keeps a (shallow) copy of the JSON data. Since decoding
+    updates the cache, a LazyDocument must not be accessed from several
+    threads at the same time, not even through const functions.
+*/
+
+// Returns the position after the value starting at ptr, or nullptr if the
+// value is obviously malformed. Only the nesting is checked.
+static const char *skipValue(const char *ptr, const char *end) noexcept
+{
+    switch (*ptr) {
+    case '"':
+        return skipString(ptr + 1, end);
+    case '[':
+    case '{': {
+        qsizetype depth = 0;
+        while (ptr < end) {
+            const char c = *ptr++;
+            if (c == '"') {
+                ptr = skipString(ptr, end);
+                if (!ptr)
+                    return nullptr;
+            } else if (c == '[' || c == '{') {
+                ++depth;
+            } else if (c == ']' || c == '}') {
+                if (--depth == 0)
+                    return ptr;
+            }
+        }
+        return nullptr;
+    }
+    case ',':
+    case ':':
+    case ']':
+    case '}':
+        return nullptr;
+    default: {
+        // number, true, false or null: runs up to the next separator
+        const char *start = ptr;
+        while (ptr < end && uchar(*ptr) > 0x20 && *ptr != ',' && *ptr != ']' && *ptr != '}')
+            ++ptr;
+        return ptr != start ? ptr : nullptr;
+    }
+    }
+}
+
+/*!
+    Creates a LazyDocument for the UTF-8 encoded \a json and indexes its top
+    level. If the top level is malformed, the document is null and \a error,
+    if not null, is set to the problem found.
+*/
+LazyDocument::LazyDocument(const QByteArray &json, QJsonParseError *error)
+    : json(json)
+{
+    buildIndex(error);
+}
+
+bool LazyDocument::buildIndex(QJsonParseError *error)
+{
+    const char *begin = json.constData();
+    const char *end = begin + json.size();
+    const char *ptr = begin;
+
+    const auto fail = [&](QJsonParseError::ParseError parseError) {
+        entries.clear();
+        if (error) {
+            error->offset = int(ptr - begin);
+            error->error = parseError;
+        }
+        return false;
+    };
+
+    // eat UTF-8 byte order mark
+    if (end - ptr >= 3 && memcmp(ptr, "\xef\xbb\xbf", 3) == 0)
+        ptr += 3;
+
+    ptr = skipWhitespace(ptr, end);
+    if (ptr == end || (*ptr != '{' && *ptr != '['))
+        return fail(QJsonParseError::IllegalValue);
+    const bool isObject = *ptr++ == '{';
+    const char endToken = isObject ? '}' : ']';
+    const QJsonParseError::ParseError unterminated = isObject
+            ? QJsonParseError::UnterminatedObject : QJsonParseError::UnterminatedArray;
+
+    ptr = skipWhitespace(ptr, end);
+    if (ptr < end && *ptr == endToken) {
+        ++ptr;
+    } else {
+        while (true) {
+            Entry entry = { -1, 0, 0, false };
+            if (isObject) {
+                if (ptr == end || *ptr != '"')
+                    return fail(QJsonParseError::UnterminatedObject);
+                const char *keyEnd = skipString(ptr + 1, end);
+                if (!keyEnd)
+                    return fail(QJsonParseError::UnterminatedString);
+                entry.keyBegin = ptr + 1 - begin;
+                entry.keyLength = keyEnd - ptr - 2;
+                entry.keyHasEscapes = memchr(ptr + 1, '\\', entry.keyLength) != nullptr;
+
+                ptr = skipWhitespace(keyEnd, end);
+                if (ptr == end || *ptr != ':')
+                    return fail(QJsonParseError::MissingNameSeparator);
+                ptr = skipWhitespace(ptr + 1, end);
+            }
+
+            if (ptr == end)
+                return fail(unterminated);
+            entry.valueBegin = ptr - begin;
+            const char *valueEnd = skipValue(ptr, end);
+            if (!valueEnd)
+                return fail(QJsonParseError::IllegalValue);
+            entries.append(std::move(entry));
+
+            ptr = skipWhitespace(valueEnd, end);
+            if (ptr == end)
+                return fail(unterminated);
+            if (*ptr == endToken) {
+                ++ptr;
+                break;
+            }
+            if (*ptr != ',')
+                return fail(isObject ? unterminated : QJsonParseError::MissingValueSeparator);
+            ptr = skipWhitespace(ptr + 1, end);
+            if (ptr < end && *ptr == endToken)
+                return fail(QJsonParseError::MissingObject);
+        }
+    }
+
+    ptr = skipWhitespace(ptr, end);
+    if (ptr != end)
+        return fail(QJsonParseError::GarbageAtEnd);
+
+    rootType = isObject ? QJsonValue::Object : QJsonValue::Array;
+    if (error) {
+        error->offset = 0;
+        error->error = QJsonParseError::NoError;
+    }
+    return true;
+}
+
+/*!
+    Returns the key of member \a i, or a null string if the document is an
+    array.
+*/
+QString LazyDocument::keyAt(qsizetype i) const
+{
+    const Entry &entry = entries.at(i);
+    if (entry.keyBegin < 0)
+        return QString();
+
+    const char *key = json.constData() + entry.keyBegin;
+    if (!entry.keyHasEscapes)
+        return QString::fromUtf8(key, entry.keyLength);
+
+    // let the parser deal with the escape sequences, starting at the quote
+    Parser parser(key - 1, int(json.size() - entry.keyBegin + 1));
+    return parser.parseFirstValue(nullptr).toString();
+}
+
+qsizetype LazyDocument::indexOf(QStringView key) const
+{
+    // as in QJsonObject, the last of duplicate keys wins
+    for (qsizetype i = entries.size() - 1; i >= 0; --i) {
+        const Entry &entry = entries.at(i);
+        if (entry.keyBegin < 0)
+            return -1;
+        if (entry.keyHasEscapes) {
+            if (keyAt(i) == key)
+                return i;
+        } else {
+            const QUtf8StringView candidate(json.constData() + entry.keyBegin, entry.keyLength);
+            if (QtPrivate::compareStrings(candidate, key) == 0)
+                return i;
+        }
+    }
+    return -1;
+}
+
+/*!
+    Returns member \a i, decoding it if that has not been done yet. If the
+    member is malformed, returns QJsonValue::Undefined and sets \a error, if
+    not null, to the problem found; the offset is relative to the start of the
+    document.
+*/
+QJsonValue LazyDocument::valueAt(qsizetype i, QJsonParseError *error) const
+{
+    const Entry &entry = entries.at(i);
+    if (entry.value.isUndefined()) {
+        QJsonParseError parseError;
+        Parser parser(json.constData() + entry.valueBegin, int(json.size() - entry.valueBegin));
+        const QCborValue value = parser.parseFirstValue(&parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            if (error) {
+                *error = parseError;
+                error->offset += int(entry.valueBegin);
+            }
+            return QJsonValue::Undefined;
+        }
+        entry.value = Value::fromTrustedCbor(value);
+    }
+
+    if (error) {
+        error->offset = 0;
+        error->error = QJsonParseError::NoError;
+    }
+    return entry.value;
+}
+
+/*!
+    Returns the value of the member called \a key, decoding it if that has
+    not been done yet. Returns QJsonValue::Undefined if there is no such
+    member, or if it is malformed (in which case \a error, if not null, is set
+    as for valueAt()).
+*/
+QJsonValue LazyDocument::value(QStringView key, QJsonParseError *error) const
+{
+    const qsizetype i = indexOf(key);
+    if (i < 0) {
+        if (error) {
+            error->offset = 0;
+            error->error = QJsonParseError::NoError;
+        }
+        return QJsonValue::Undefined;
+    }
+    return valueAt(i, error);
+}
+
+/*!
+    Parses the whole document, exactly like QJsonDocument::fromJson() does,
+    and returns it. \a error is set as by QJsonDocument::fromJson().
+*/
+QJsonDocument LazyDocument::toDocument(QJsonParseError *error) const
+{
+    return QJsonDocument::fromJson(json, error);
+}
+
+QT_END_NAMESPACE
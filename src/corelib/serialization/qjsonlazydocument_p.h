@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QJSONLAZYDOCUMENT_P_H
+#define QJSONLAZYDOCUMENT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qlist.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QJsonPrivate {
+
+class Q_CORE_EXPORT LazyDocument
+{
+public:
+    LazyDocument() = default;
+    explicit LazyDocument(const QByteArray &json, QJsonParseError *error = nullptr);
+
+    bool isNull() const { return rootType == QJsonValue::Null; }
+    bool isArray() const { return rootType == QJsonValue::Array; }
+    bool isObject() const { return rootType == QJsonValue::Object; }
+
+    qsizetype size() const { return entries.size(); }
+    QString keyAt(qsizetype i) const;
+    QJsonValue valueAt(qsizetype i, QJsonParseError *error = nullptr) const;
+    QJsonValue value(QStringView key, QJsonParseError *error = nullptr) const;
+    bool contains(QStringView key) const { return indexOf(key) >= 0; }
+
+    QJsonDocument toDocument(QJsonParseError *error = nullptr) const;
+
+private:
+    struct Entry {
+        qsizetype keyBegin;     // first byte of the key after the quote, -1 in arrays
+        qsizetype keyLength;
+        qsizetype valueBegin;
+        bool keyHasEscapes;
+        mutable QJsonValue value = QJsonValue::Undefined;    // Undefined until decoded
+    };
+
+    qsizetype indexOf(QStringView key) const;
+    bool buildIndex(QJsonParseError *error);
+
+    QByteArray json;
+    QList<Entry> entries;
+    QJsonValue::Type rootType = QJsonValue::Null;
+};
+
+} // namespace QJsonPrivate
+
+QT_END_NAMESPACE
+
+#endif // QJSONLAZYDOCUMENT_P_H
@@ -147,8 +147,18 @@ QJsonObject::~QJsonObject() = default;
 
 QJsonObject::QJsonObject(std::initializer_list<QPair<QString, QJsonValue> > args)
 {
-    for (const auto &arg : args)
-        insert(arg.first, arg.second);
+    if (args.size() == 0)
+        return;
+
+    QExplicitlySharedDataPointer<QCborContainerPrivate> container(new QCborContainerPrivate);
+    container->elements.reserve(qsizetype(args.size()) * 2);
+    for (const auto &arg : args) {
+        container->append(arg.first);
+        container->append(QCborValue::fromJsonValue(arg.second));
+    }
+    QJsonPrivate::sortContainer(container.data());
+    if (!container->elements.isEmpty())
+        o = std::move(container);
 }
 
 /*!
@@ -241,12 +251,19 @@ QVariantMap QJsonObject::toVariantMap() const
  */
 QJsonObject QJsonObject::fromVariantHash(const QVariantHash &hash)
 {
-    // ### this is implemented the trivial way, not the most efficient way
-
-    QJsonObject object;
-    for (QVariantHash::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it)
-        object.insert(it.key(), QJsonValue::fromVariant(it.value()));
-    return object;
+    if (hash.isEmpty())
+        return QJsonObject();
+
+    QExplicitlySharedDataPointer<QCborContainerPrivate> container(new QCborContainerPrivate);
+    container->elements.reserve(hash.size() * 2);
+    for (QVariantHash::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        container->append(it.key());
+        container->append(QCborValue::fromJsonValue(QJsonValue::fromVariant(it.value())));
+    }
+    QJsonPrivate::sortContainer(container.data());
+    if (container->elements.isEmpty())
+        return QJsonObject();
+    return QJsonObject(container.data());
 }
 
 /*!
@@ -47,6 +47,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -204,13 +205,15 @@ class StashedContainer
     Q_DISABLE_COPY_MOVE(StashedContainer)
 public:
     StashedContainer(QExplicitlySharedDataPointer<QCborContainerPrivate> *container,
-                     QCborValue::Type type)
-        : type(type), stashed(std::move(*container)), current(container)
+                     QCborValue::Type type, QCborArenaDecoder *arena)
+        : type(type), stashed(std::move(*container)), current(container), arena(arena)
     {
     }
 
     ~StashedContainer()
     {
+        if (arena)
+            arena->finishContainer(current->data());
         stashed->append(QCborContainerPrivate::makeValue(type, -1, current->take(),
                                                          QCborContainerPrivate::MoveContainer));
         *current = std::move(stashed);
@@ -220,12 +223,14 @@ private:
     QCborValue::Type type;
     QExplicitlySharedDataPointer<QCborContainerPrivate> stashed;
     QExplicitlySharedDataPointer<QCborContainerPrivate> *current;
+    QCborArenaDecoder *arena;
 };
 
-Parser::Parser(const char *json, int length)
+Parser::Parser(const char *json, int length, QCborArenaDecoder *arena)
     : head(json), json(json)
     , nestingLevel(0)
     , lastError(QJsonParseError::NoError)
+    , arena(arena)
 {
     end = json + length;
 }
@@ -272,6 +277,155 @@ enum {
     Quote = 0x22
 };
 
+#if defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+static inline uint neonMovemask(uint8x16_t matches)
+{
+    // collapse one bit per byte into a 16-bit mask, like SSE2's PMOVMSKB
+    const uint8x16_t bits = { 1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7,
+                              1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7 };
+    const uint8x16_t masked = vandq_u8(matches, bits);
+    return vaddv_u8(vget_low_u8(masked)) | (uint(vaddv_u8(vget_high_u8(masked))) << 8);
+}
+#endif
+
+/*!
+    \internal
+
+    Returns a pointer to the first byte in [\a ptr, \a end) that ends a run of
+    plain US-ASCII string content: a quotation mark, a backslash or a byte
+    with the high bit set (the start of a multi-byte UTF-8 sequence). Returns
+    \a end if there is none.
+*/
+const char *QJsonPrivate::scanStringRun(const char *ptr, const char *end) noexcept
+{
+#if defined(__SSE2__)
+#  if defined(__AVX2__)
+    const __m256i quote32 = _mm256_set1_epi8(Quote);
+    const __m256i backslash32 = _mm256_set1_epi8('\\');
+    while (ptr + 32 <= end) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote32),
+                                          _mm256_cmpeq_epi8(data, backslash32));
+        // the high bit of non-ASCII bytes is picked up by the movemask directly
+        quint32 mask = _mm256_movemask_epi8(_mm256_or_si256(special, data));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 32;
+    }
+#  endif
+    const __m128i quote = _mm_set1_epi8(Quote);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while (ptr + 16 <= end) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                       _mm_cmpeq_epi8(data, backslash));
+        uint mask = _mm_movemask_epi8(_mm_or_si128(special, data));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 16;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const uint8x16_t quote = vdupq_n_u8(Quote);
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t nonAscii = vdupq_n_u8(0x80);
+    while (ptr + 16 <= end) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr));
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, quote), vceqq_u8(data, backslash)),
+                                      vcgeq_u8(data, nonAscii));
+        if (uint mask = neonMovemask(special))
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 16;
+    }
+#endif
+
+    while (ptr < end && *ptr != Quote && *ptr != '\\' && uchar(*ptr) < 0x80)
+        ++ptr;
+    return ptr;
+}
+
+/*!
+    \internal
+
+    Returns a pointer to the first byte in [\a ptr, \a end) that is not JSON
+    whitespace, or \a end if there is none.
+*/
+const char *QJsonPrivate::skipWhitespace(const char *ptr, const char *end) noexcept
+{
+    const auto isSpace = [](char c) {
+        return c == Space || c == Tab || c == LineFeed || c == Return;
+    };
+
+    // Compact JSON has no whitespace at all and most separators are followed
+    // by at most one space, so only use the vector code for longer runs
+    // (i.e. indentation).
+    for (int i = 0; i < 2; ++i) {
+        if (ptr == end || !isSpace(*ptr))
+            return ptr;
+        ++ptr;
+    }
+
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+    const __m128i cr = _mm_set1_epi8(Return);
+    while (ptr + 16 <= end) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                               _mm_cmpeq_epi8(data, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed),
+                                               _mm_cmpeq_epi8(data, cr)));
+        uint mask = ~uint(_mm_movemask_epi8(ws)) & 0xffffu;
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 16;
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const uint8x16_t space = vdupq_n_u8(Space);
+    const uint8x16_t tab = vdupq_n_u8(Tab);
+    const uint8x16_t lineFeed = vdupq_n_u8(LineFeed);
+    const uint8x16_t cr = vdupq_n_u8(Return);
+    while (ptr + 16 <= end) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(ptr));
+        uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(data, space), vceqq_u8(data, tab)),
+                                 vorrq_u8(vceqq_u8(data, lineFeed), vceqq_u8(data, cr)));
+        if (uint mask = neonMovemask(vmvnq_u8(ws)))
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 16;
+    }
+#endif
+
+    while (ptr < end && isSpace(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+/*!
+    \internal
+
+    Skips the rest of a string whose opening quote precedes \a ptr, without
+    decoding or validating it. Returns the position after the closing quote,
+    or \nullptr if the string is not terminated before \a end.
+*/
+const char *QJsonPrivate::skipString(const char *ptr, const char *end) noexcept
+{
+    while (true) {
+        ptr = scanStringRun(ptr, end);
+        if (ptr == end)
+            return nullptr;
+        if (*ptr == Quote)
+            return ptr + 1;
+        if (*ptr == '\\') {
+            if (end - ptr < 2)
+                return nullptr;
+            ptr += 2;
+        } else {
+            // start of a multi-byte UTF-8 sequence; validated when decoded
+            ++ptr;
+        }
+    }
+}
+
 void Parser::eatBOM()
 {
     // eat UTF-8 byte order mark
@@ -285,16 +439,9 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
+    if (json < end && *json > Space)
+        return true;
+    json = QJsonPrivate::skipWhitespace(json, end);
     return (json < end);
 }
 
@@ -319,6 +466,11 @@ char Parser::nextToken()
     return token;
 }
 
+QCborContainerPrivate *Parser::createContainer()
+{
+    return arena ? arena->createContainer() : new QCborContainerPrivate;
+}
+
 /*
     JSON-text = object / array
 */
@@ -335,15 +487,19 @@ QCborValue Parser::parse(QJsonParseError *error)
 
     DEBUG << Qt::hex << (uint)token;
     if (token == BeginArray) {
-        container = new QCborContainerPrivate;
+        container = createContainer();
         if (!parseArray())
             goto error;
+        if (arena)
+            arena->finishContainer(container.data());
         data = QCborContainerPrivate::makeValue(QCborValue::Array, -1, container.take(),
                                                 QCborContainerPrivate::MoveContainer);
     } else if (token == BeginObject) {
-        container = new QCborContainerPrivate;
+        container = createContainer();
         if (!parseObject())
             goto error;
+        if (arena)
+            arena->finishContainer(container.data());
         data = QCborContainerPrivate::makeValue(QCborValue::Map, -1, container.take(),
                                                 QCborContainerPrivate::MoveContainer);
     } else {
@@ -379,6 +535,32 @@ error:
     return QCborValue();
 }
 
+/*
+    Parses a single JSON value of any type (RFC 8259 also allows scalars at
+    the top level) at the start of the input and stops right after it;
+    anything that follows is left unparsed. Used to decode values on demand.
+*/
+QCborValue Parser::parseFirstValue(QJsonParseError *error)
+{
+    eatBOM();
+    container = createContainer();
+
+    QCborValue data;
+    if (!eatSpace()) {
+        lastError = QJsonParseError::IllegalValue;
+    } else if (parseValue()) {
+        Q_ASSERT(container->elements.size() == 1);
+        data = container->valueAt(0);
+    }
+
+    container.reset();
+    if (error) {
+        error->offset = data.isUndefined() ? json - head : 0;
+        error->error = data.isUndefined() ? lastError : QJsonParseError::NoError;
+    }
+    return data;
+}
+
 // We need to retain the _last_ value for any duplicate keys and we need to deref containers.
 // Therefore the manual implementation of std::unique().
 template<typename Iterator, typename Compare, typename Assign>
@@ -412,7 +594,15 @@ static Iterator customAssigningUniqueLast(Iterator first, Iterator last,
     return ++result;
 }
 
-static void sortContainer(QCborContainerPrivate *container)
+/*!
+    \internal
+
+    Sorts the key/value pairs of the object \a container by key. Only the last
+    pair of duplicate keys is retained, and it is dropped if its value is
+    undefined. This yields the same object as inserting the pairs one after the
+    other with QJsonObject::insert(), but in O(n log n) instead of O(n²) time.
+*/
+void QJsonPrivate::sortContainer(QCborContainerPrivate *container)
 {
     using Forward = QJsonPrivate::KeyIterator;
     using Value = Forward::value_type;
@@ -474,6 +664,20 @@ static void sortContainer(QCborContainerPrivate *container)
                 [&compare](const Value &a, const Value &b) { return compare(a, b) == 0; }, move);
 
     container->elements.erase(result.elementsIterator(), container->elements.end());
+
+    auto &elements = container->elements;
+    qsizetype kept = 0;
+    for (qsizetype i = 0; i < elements.size(); i += 2) {
+        // undefined values own neither byte data nor a container
+        if (elements.at(i + 1).type == QCborValue::Undefined)
+            continue;
+        if (kept != i) {
+            elements[kept] = elements.at(i);
+            elements[kept + 1] = elements.at(i + 1);
+        }
+        kept += 2;
+    }
+    elements.resize(kept);
 }
 
 
@@ -494,7 +698,7 @@ bool Parser::parseObject()
     char token = nextToken();
     while (token == Quote) {
         if (!container)
-            container = new QCborContainerPrivate;
+            container = createContainer();
         if (!parseMember())
             return false;
         token = nextToken();
@@ -572,7 +776,7 @@ bool Parser::parseArray()
                 return false;
             }
             if (!container)
-                container = new QCborContainerPrivate;
+                container = createContainer();
             if (!parseValue())
                 return false;
             char token = nextToken();
@@ -660,7 +864,7 @@ bool Parser::parseValue()
         return true;
     }
     case BeginArray: {
-        StashedContainer stashedContainer(&container, QCborValue::Array);
+        StashedContainer stashedContainer(&container, QCborValue::Array, arena);
         if (!parseArray())
             return false;
         DEBUG << "value: array";
@@ -668,7 +872,7 @@ bool Parser::parseValue()
         return true;
     }
     case BeginObject: {
-        StashedContainer stashedContainer(&container, QCborValue::Map);
+        StashedContainer stashedContainer(&container, QCborValue::Map, arena);
         if (!parseObject())
             return false;
         DEBUG << "value: object";
@@ -891,6 +1095,10 @@ bool Parser::parseString()
     bool isUtf8 = true;
     bool isAscii = true;
     while (json < end) {
+        json = scanStringRun(json, end);
+        if (json == end)
+            break;
+
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -933,6 +1141,14 @@ bool Parser::parseString()
 
     QString ucs4;
     while (json < end) {
+        const char *run = scanStringRun(json, end);
+        if (run != json) {
+            ucs4.append(QLatin1String(json, run - json));
+            json = run;
+            if (json == end)
+                break;
+        }
+
         char32_t ch = 0;
         if (*json == '"')
             break;
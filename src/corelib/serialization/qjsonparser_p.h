@@ -59,12 +59,17 @@ QT_BEGIN_NAMESPACE
 
 namespace QJsonPrivate {
 
+const char *scanStringRun(const char *ptr, const char *end) noexcept;
+const char *skipWhitespace(const char *ptr, const char *end) noexcept;
+const char *skipString(const char *ptr, const char *end) noexcept;
+
 class Parser
 {
 public:
-    Parser(const char *json, int length);
+    Parser(const char *json, int length, QCborArenaDecoder *arena = nullptr);
 
     QCborValue parse(QJsonParseError *error);
+    QCborValue parseFirstValue(QJsonParseError *error);
 
 private:
     inline void eatBOM();
@@ -77,6 +82,8 @@ private:
     bool parseString();
     bool parseValue();
     bool parseNumber();
+    QCborContainerPrivate *createContainer();
+
     const char *head;
     const char *json;
     const char *end;
@@ -84,6 +91,7 @@ private:
     int nestingLevel;
     QJsonParseError::ParseError lastError;
     QExplicitlySharedDataPointer<QCborContainerPrivate> container;
+    QCborArenaDecoder *arena;
 };
 
 }
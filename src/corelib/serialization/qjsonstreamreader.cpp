@@ -0,0 +1,790 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamreader_p.h"
+#include "qjsonparser_p.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+#include <private/qcborvalue_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QJsonPrivate;
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \internal
+
+    \brief The QJsonStreamReader class is a simple JSON pull parser that
+    reads a document one value at a time.
+
+    QJsonStreamReader is the JSON counterpart of QCborStreamReader. It never
+    builds a tree: only the value the reader is positioned on is decoded, and
+    only the bytes of that value (plus those of a string being read) need to
+    be buffered, so arbitrarily large documents can be processed in constant
+    memory.
+
+    The reader starts positioned on the document's top-level array or
+    object. Use enterContainer() to step into an array or object, type() and
+    the toXxx() functions to inspect the current value, next() to skip it
+    (including, for containers, all of their contents) and leaveContainer() to
+    skip the rest of the current container. Inside an object, keys and values
+    alternate, with isKey() telling them apart; keys are always strings, read
+    with readString().
+
+    Data can come from a QIODevice, from which the reader reads in chunks as
+    needed, or be appended with addData(). If the data available ends in the
+    middle of the current value, isIncomplete() returns \c true and the value
+    is reported as Invalid; once more data has arrived (or been added), call
+    reparse() to continue. For non-sequential devices such as files, reaching
+    the end of the device in the middle of the document is an error instead.
+
+    Values that are skipped over are only checked for correct nesting.
+*/
+
+/*!
+    \enum QJsonStreamReader::Type
+
+    This enum describes the value the reader is positioned on.
+
+    \value Invalid   No value: the end of a container or of the document, an
+                     error, or the value is incomplete.
+    \value Null      \c null
+    \value Bool      \c true or \c false
+    \value Number    A number, see isInteger(), toInteger() and toDouble().
+    \value String    A string (possibly an object key), see readString().
+    \value Array     An array, see enterContainer().
+    \value Object    An object, see enterContainer().
+*/
+
+static const int nestingLimit = 1024;
+
+// Read from devices in blocks of this size, and keep at most this much of
+// already consumed data before compacting the buffer.
+static const qsizetype ChunkSize = 65536;
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum State : quint8 {
+        FirstElement,   // right after the opening bracket
+        AfterComma,
+        AfterKey,       // expecting the name separator
+        AfterColon,     // expecting the value of a member
+        AfterValue      // expecting a comma or the closing bracket
+    };
+    struct Container {
+        bool isObject;
+        State state;
+    };
+    enum class Pending : quint8 {
+        None,
+        SkipElement,
+        LeaveContainer
+    };
+
+    void clear();
+    void preparse();
+    bool fillBuffer();
+    bool skipWhitespace();
+    bool skipBOM();
+    bool classifyValue(bool isKey);
+    bool runSkip();
+    void finishElement();
+    void incomplete(QJsonParseError::ParseError errorAtEnd);
+    void setError(QJsonParseError::ParseError parseError, qsizetype at);
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;              // parse position in buffer
+    qint64 bufferOffset = 0;        // stream offset of buffer[0]
+
+    QVarLengthArray<Container, 16> containers;
+    QJsonStreamReader::Type type = QJsonStreamReader::Invalid;
+    qsizetype tokenEnd = 0;         // the current value starts at pos
+    QCborValue scalar;              // decoded Null, Bool and Number values
+    bool currentIsKey = false;
+    bool atEnd = false;             // at the end of the container or document
+    bool isIncomplete = false;
+    bool documentFinished = false;
+
+    Pending pending = Pending::None;
+    qsizetype skipDepth = 0;
+    bool skipInString = false;
+
+    QJsonParseError::ParseError error = QJsonParseError::NoError;
+    qint64 errorOffset = 0;
+};
+
+void QJsonStreamReaderPrivate::clear()
+{
+    buffer.clear();
+    pos = 0;
+    bufferOffset = 0;
+    containers.clear();
+    type = QJsonStreamReader::Invalid;
+    tokenEnd = 0;
+    scalar = QCborValue();
+    currentIsKey = false;
+    atEnd = false;
+    isIncomplete = false;
+    documentFinished = false;
+    pending = Pending::None;
+    skipDepth = 0;
+    skipInString = false;
+    error = QJsonParseError::NoError;
+    errorOffset = 0;
+}
+
+void QJsonStreamReaderPrivate::setError(QJsonParseError::ParseError parseError, qsizetype at)
+{
+    type = QJsonStreamReader::Invalid;
+    error = parseError;
+    errorOffset = bufferOffset + at;
+}
+
+// The buffer ends inside the current value: that is an error if no more data
+// can come, otherwise the caller has to supply more and reparse().
+void QJsonStreamReaderPrivate::incomplete(QJsonParseError::ParseError errorAtEnd)
+{
+    type = QJsonStreamReader::Invalid;
+    if (device && !device->isSequential() && device->atEnd())
+        setError(errorAtEnd, buffer.size());
+    else
+        isIncomplete = true;
+}
+
+// Reads more data from the device, dropping what has been consumed already.
+// Everything before pos may be discarded.
+bool QJsonStreamReaderPrivate::fillBuffer()
+{
+    if (!device)
+        return false;
+
+    if (pos >= ChunkSize || (pos && pos == buffer.size())) {
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        tokenEnd -= pos;
+        pos = 0;
+    }
+
+    const qsizetype oldSize = buffer.size();
+    buffer.resize(oldSize + ChunkSize);
+    const qint64 readBytes = device->read(buffer.data() + oldSize, ChunkSize);
+    buffer.resize(oldSize + qMax(readBytes, qint64(0)));
+    return readBytes > 0;
+}
+
+bool QJsonStreamReaderPrivate::skipWhitespace()
+{
+    while (true) {
+        const char *begin = buffer.constData();
+        pos = QJsonPrivate::skipWhitespace(begin + pos, begin + buffer.size()) - begin;
+        if (pos < buffer.size())
+            return true;
+        if (!fillBuffer())
+            return false;
+    }
+}
+
+// Skips a UTF-8 byte order mark at the start of the document, like
+// QJsonDocument::fromJson() does.
+bool QJsonStreamReaderPrivate::skipBOM()
+{
+    static const char utf8bom[] = "\xef\xbb\xbf";
+    while (buffer.size() - pos < 3) {
+        if (!QByteArrayView(utf8bom).startsWith(QByteArrayView(buffer).sliced(pos))) {
+            setError(QJsonParseError::IllegalValue, pos);
+            return false;
+        }
+        if (!fillBuffer()) {
+            incomplete(QJsonParseError::IllegalValue);
+            return false;
+        }
+    }
+    if (QByteArrayView(buffer).sliced(pos, 3) != QByteArrayView(utf8bom)) {
+        setError(QJsonParseError::IllegalValue, pos);
+        return false;
+    }
+    pos += 3;
+    return true;
+}
+
+// Determines the type and extent of the value starting at pos.
+bool QJsonStreamReaderPrivate::classifyValue(bool isKey)
+{
+    currentIsKey = isKey;
+    scalar = QCborValue();
+
+    while (true) {
+        const char *begin = buffer.constData();
+        const char *end = begin + buffer.size();
+        const char *ptr = begin + pos;
+
+        switch (*ptr) {
+        case '{':
+        case '[':
+            type = *ptr == '{' ? QJsonStreamReader::Object : QJsonStreamReader::Array;
+            tokenEnd = pos + 1;
+            return true;
+
+        case '"': {
+            // the parser needs to see one byte past the closing quote
+            const char *stringEnd = skipString(ptr + 1, end);
+            if (stringEnd && stringEnd < end) {
+                type = QJsonStreamReader::String;
+                tokenEnd = stringEnd - begin;
+                return true;
+            }
+            break;
+        }
+
+        case ',':
+        case ':':
+            setError(QJsonParseError::IllegalValue, pos);
+            return false;
+        case ']':
+        case '}':
+            setError(QJsonParseError::MissingObject, pos);
+            return false;
+
+        default: {
+            // literal or number; it ends at the first character that cannot
+            // be part of it, which must be there already
+            const bool isLiteral = *ptr >= 'a' && *ptr <= 'z';
+            const char *tokenPtr = ptr;
+            while (tokenPtr < end && (isLiteral ? (*tokenPtr >= 'a' && *tokenPtr <= 'z')
+                                                : ((*tokenPtr >= '0' && *tokenPtr <= '9')
+                                                   || *tokenPtr == '-' || *tokenPtr == '+'
+                                                   || *tokenPtr == '.' || *tokenPtr == 'e'
+                                                   || *tokenPtr == 'E'))) {
+                ++tokenPtr;
+            }
+            if (tokenPtr == end)
+                break;
+
+            const QByteArrayView token(ptr, tokenPtr - ptr);
+            if (isLiteral) {
+                if (token == "null")
+                    scalar = QCborValue(QCborValue::Null);
+                else if (token == "true")
+                    scalar = QCborValue(true);
+                else if (token == "false")
+                    scalar = QCborValue(false);
+                else {
+                    setError(QJsonParseError::IllegalValue, pos);
+                    return false;
+                }
+                type = scalar.isNull() ? QJsonStreamReader::Null : QJsonStreamReader::Bool;
+            } else {
+                QJsonParseError parseError;
+                Parser parser(ptr, int(end - ptr));
+                scalar = parser.parseFirstValue(&parseError);
+                if (parseError.error != QJsonParseError::NoError || token.isEmpty()) {
+                    setError(token.isEmpty() ? QJsonParseError::IllegalValue
+                                             : parseError.error, pos + parseError.offset);
+                    return false;
+                }
+                type = QJsonStreamReader::Number;
+            }
+            tokenEnd = tokenPtr - begin;
+            return true;
+        }
+        }
+
+        // the value is not complete yet (this invalidates ptr)
+        const bool isString = *ptr == '"';
+        if (!fillBuffer()) {
+            incomplete(isString ? QJsonParseError::UnterminatedString
+                                : QJsonParseError::TerminationByNumber);
+            return false;
+        }
+    }
+}
+
+// Continues skipping over nested content until skipDepth drops to zero.
+bool QJsonStreamReaderPrivate::runSkip()
+{
+    while (true) {
+        const char *begin = buffer.constData();
+        const char *end = begin + buffer.size();
+        const char *ptr = begin + pos;
+        while (ptr < end) {
+            if (skipInString) {
+                ptr = scanStringRun(ptr, end);
+                if (ptr == end)
+                    break;
+                if (*ptr == '\\') {
+                    if (end - ptr < 2)
+                        break;
+                    ++ptr;
+                } else if (*ptr == '"') {
+                    skipInString = false;
+                }
+                ++ptr;
+                continue;
+            }
+
+            const char c = *ptr++;
+            if (c == '"') {
+                skipInString = true;
+            } else if (c == '[' || c == '{') {
+                ++skipDepth;
+            } else if (c == ']' || c == '}') {
+                if (--skipDepth == 0) {
+                    pos = ptr - begin;
+                    return true;
+                }
+            }
+        }
+
+        pos = ptr - begin;
+        if (!fillBuffer()) {
+            incomplete(containers.isEmpty() || !containers.last().isObject
+                       ? QJsonParseError::UnterminatedArray
+                       : QJsonParseError::UnterminatedObject);
+            return false;
+        }
+    }
+}
+
+// Called after the current value has been consumed.
+void QJsonStreamReaderPrivate::finishElement()
+{
+    if (containers.isEmpty()) {
+        documentFinished = true;
+        return;
+    }
+    Container &top = containers.last();
+    top.state = currentIsKey ? AfterKey : AfterValue;
+}
+
+// Positions the reader on the next value, consuming separators on the way.
+void QJsonStreamReaderPrivate::preparse()
+{
+    type = QJsonStreamReader::Invalid;
+    atEnd = false;
+    isIncomplete = false;
+    if (error != QJsonParseError::NoError)
+        return;
+
+    if (pending != Pending::None) {
+        if (!runSkip())
+            return;
+        if (pending == Pending::LeaveContainer)
+            containers.removeLast();
+        pending = Pending::None;
+        currentIsKey = false;
+        finishElement();
+    }
+
+    while (true) {
+        if (!skipWhitespace()) {
+            if (documentFinished)
+                atEnd = true;
+            else
+                incomplete(containers.isEmpty() ? QJsonParseError::IllegalValue
+                           : containers.last().isObject ? QJsonParseError::UnterminatedObject
+                                                             : QJsonParseError::UnterminatedArray);
+            return;
+        }
+
+        const char c = buffer.at(pos);
+        if (containers.isEmpty()) {
+            if (documentFinished) {
+                setError(QJsonParseError::GarbageAtEnd, pos);
+            } else if (c == '\xef' && bufferOffset + pos == 0) {
+                if (!skipBOM())
+                    return;
+                continue;
+            } else if (c != '{' && c != '[') {
+                setError(QJsonParseError::IllegalValue, pos);
+            } else {
+                classifyValue(false);
+            }
+            return;
+        }
+
+        Container &top = containers.last();
+        const char endToken = top.isObject ? '}' : ']';
+        switch (top.state) {
+        case FirstElement:
+        case AfterComma:
+            if (c == endToken) {
+                if (top.state == AfterComma)
+                    setError(QJsonParseError::MissingObject, pos);
+                else
+                    atEnd = true;
+                return;
+            }
+            if (top.isObject && c != '"') {
+                setError(QJsonParseError::UnterminatedObject, pos);
+                return;
+            }
+            classifyValue(top.isObject);
+            return;
+
+        case AfterKey:
+            if (c != ':') {
+                setError(QJsonParseError::MissingNameSeparator, pos);
+                return;
+            }
+            ++pos;
+            top.state = AfterColon;
+            continue;
+
+        case AfterColon:
+            classifyValue(false);
+            return;
+
+        case AfterValue:
+            if (c == endToken) {
+                atEnd = true;
+                return;
+            }
+            if (c != ',') {
+                setError(top.isObject ? QJsonParseError::UnterminatedObject
+                                      : QJsonParseError::MissingValueSeparator, pos);
+                return;
+            }
+            ++pos;
+            top.state = AfterComma;
+            continue;
+        }
+    }
+}
+
+/*!
+    Constructs a QJsonStreamReader with no data. Use addData() or
+    setDevice() to supply some.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a QJsonStreamReader that reads the JSON document in \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d(new QJsonStreamReaderPrivate)
+{
+    d->buffer = data;
+    d->preparse();
+}
+
+/*!
+    Constructs a QJsonStreamReader that reads from \a device, which must be
+    open for reading.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d(new QJsonStreamReaderPrivate)
+{
+    setDevice(device);
+}
+
+/*!
+    Destroys the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader() = default;
+
+/*!
+    Makes the reader read from \a device, starting over. Any data added with
+    addData() is discarded.
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->clear();
+    d->device = device;
+    d->preparse();
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr.
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Appends \a data to the data being parsed. Call reparse() afterwards if
+    the reader was waiting for it.
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+    \overload
+
+    Appends \a len bytes starting at \a data.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with a device set is not supported");
+        return;
+    }
+    if (d->pos >= ChunkSize) {
+        d->buffer.remove(0, d->pos);
+        d->bufferOffset += d->pos;
+        d->tokenEnd -= d->pos;
+        d->pos = 0;
+    }
+    d->buffer.append(data, len);
+}
+
+/*!
+    Evaluates the current position again, after more data has become
+    available on the device or has been added with addData(). Also resumes a
+    next() or leaveContainer() that ran out of data.
+*/
+void QJsonStreamReader::reparse()
+{
+    d->preparse();
+}
+
+/*!
+    Resets the reader to its initial empty state, discarding all data and
+    unsetting the device.
+*/
+void QJsonStreamReader::clear()
+{
+    d->clear();
+    d->device = nullptr;
+}
+
+/*!
+    Returns the error that stopped the reader, if any. Once an error has
+    occurred the reader does not continue.
+*/
+QJsonParseError QJsonStreamReader::lastError() const
+{
+    QJsonParseError result;
+    result.error = d->error;
+    result.offset = d->error == QJsonParseError::NoError ? 0 : int(d->errorOffset);
+    return result;
+}
+
+/*!
+    Returns \c true if the data available ends before the reader could
+    determine the next value, i.e. more data must be supplied before
+    reparse() can make progress.
+*/
+bool QJsonStreamReader::isIncomplete() const
+{
+    return d->isIncomplete;
+}
+
+/*!
+    Returns the offset, in bytes from the start of the stream, of the value
+    the reader is positioned on (or of the position it got to).
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    Returns the type of the value the reader is positioned on.
+*/
+QJsonStreamReader::Type QJsonStreamReader::type() const
+{
+    return d->type;
+}
+
+/*!
+    Returns \c true if the reader is positioned on a key of an object.
+*/
+bool QJsonStreamReader::isKey() const
+{
+    return d->type == String && d->currentIsKey;
+}
+
+/*!
+    Returns the number of containers the reader has entered.
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns \c false if the reader is at the end of the current container or
+    of the document, or an error has occurred. While isIncomplete() is \c true
+    this returns \c true, as there may be more values.
+*/
+bool QJsonStreamReader::hasNext() const
+{
+    return d->error == QJsonParseError::NoError && !d->atEnd;
+}
+
+/*!
+    Skips the current value, including all of the contents of an array or
+    object, and positions the reader on the one after it. Returns \c true on
+    success.
+
+    If the data ends inside a skipped container, this returns \c false with
+    isIncomplete() set; reparse() resumes the skipping.
+*/
+bool QJsonStreamReader::next()
+{
+    switch (d->type) {
+    case Invalid:
+        return false;
+    case Array:
+    case Object:
+        d->pending = QJsonStreamReaderPrivate::Pending::SkipElement;
+        d->skipDepth = 0;
+        d->skipInString = false;
+        break;
+    default:
+        d->pos = d->tokenEnd;
+        d->finishElement();
+        break;
+    }
+    d->preparse();
+    return d->error == QJsonParseError::NoError && !d->isIncomplete;
+}
+
+/*!
+    Steps into the array or object the reader is positioned on, positioning
+    it on the first element (or at the end, if there is none). Returns
+    \c true on success.
+*/
+bool QJsonStreamReader::enterContainer()
+{
+    if (!isContainer())
+        return false;
+    if (d->containers.size() >= nestingLimit) {
+        d->setError(QJsonParseError::DeepNesting, d->pos);
+        return false;
+    }
+    d->containers.append({ d->type == Object, QJsonStreamReaderPrivate::FirstElement });
+    d->pos = d->tokenEnd;
+    d->preparse();
+    return d->error == QJsonParseError::NoError;
+}
+
+/*!
+    Skips the remaining elements of the current container and positions the
+    reader on the value after it. Returns \c true on success.
+
+    Like next(), this may run out of data; reparse() resumes it.
+*/
+bool QJsonStreamReader::leaveContainer()
+{
+    if (d->containers.isEmpty() || d->error != QJsonParseError::NoError
+            || d->pending != QJsonStreamReaderPrivate::Pending::None) {
+        return false;
+    }
+    d->pending = QJsonStreamReaderPrivate::Pending::LeaveContainer;
+    d->skipDepth = 1;
+    d->skipInString = false;
+    d->preparse();
+    return d->error == QJsonParseError::NoError && !d->isIncomplete;
+}
+
+/*!
+    Returns the current value if it is a boolean, \c false otherwise.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return d->type == Bool && d->scalar.toBool();
+}
+
+/*!
+    Returns \c true if the current value is a number that fits a qint64
+    exactly.
+*/
+bool QJsonStreamReader::isInteger() const
+{
+    return d->type == Number && d->scalar.isInteger();
+}
+
+/*!
+    Returns the current value if it is a number, truncated to an integer, or
+    0 otherwise.
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    if (d->type != Number)
+        return 0;
+    return d->scalar.isInteger() ? d->scalar.toInteger() : qint64(d->scalar.toDouble());
+}
+
+/*!
+    Returns the current value if it is a number, or 0 otherwise.
+*/
+double QJsonStreamReader::toDouble() const
+{
+    return d->type == Number ? d->scalar.toDouble() : 0;
+}
+
+/*!
+    Decodes the current string (a key or a value), advances to the next
+    value and returns the string. Returns a null string if the reader is not
+    positioned on a string or the string is malformed.
+*/
+QString QJsonStreamReader::readString()
+{
+    if (d->type != String)
+        return QString();
+
+    const char *begin = d->buffer.constData();
+    QJsonParseError parseError;
+    Parser parser(begin + d->pos, int(d->buffer.size() - d->pos));
+    const QCborValue value = parser.parseFirstValue(&parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        d->setError(parseError.error, d->pos + parseError.offset);
+        return QString();
+    }
+
+    d->pos = d->tokenEnd;
+    d->finishElement();
+    d->preparse();
+    return value.toString();
+}
+
+QT_END_NAMESPACE
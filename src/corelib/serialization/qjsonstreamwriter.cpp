@@ -0,0 +1,364 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamwriter_p.h"
+#include "qjsonwriter_p.h"
+
+#include <qcborvalue.h>
+#include <qiodevice.h>
+#include <qjsonvalue.h>
+#include <qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \internal
+
+    \brief The QJsonStreamWriter class is a simple JSON writer that writes a
+    document one value at a time.
+
+    QJsonStreamWriter is the JSON counterpart of QCborStreamWriter. Values
+    are written to the QIODevice or QByteArray as they are appended, so large
+    documents can be produced without building a QJsonDocument first.
+
+    Arrays and objects are opened with startArray() and startObject() and
+    closed with endArray() and endObject(). Inside an object, keys and values
+    alternate: every other string appended is written as a key. The output is
+    formatted exactly as QJsonDocument::toJson() would format the same
+    document, in the format chosen with setFormat().
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    struct Container {
+        bool isObject;
+        bool isEmpty;
+        bool expectingValue;    // a key has been written
+    };
+
+    bool beforeValue(bool isString);
+    void afterValue();
+    void write(const QByteArray &data);
+    void appendScalar(const QCborValue &value, bool isString = false);
+    void startContainer(bool isObject);
+    bool endContainer(bool isObject);
+
+    QIODevice *device = nullptr;
+    QByteArray *array = nullptr;
+    QVarLengthArray<Container, 16> containers;
+    QJsonDocument::JsonFormat format = QJsonDocument::Indented;
+    QByteArray chunk;
+};
+
+void QJsonStreamWriterPrivate::write(const QByteArray &data)
+{
+    if (array)
+        array->append(data);
+    else if (device)
+        device->write(data);
+}
+
+// Writes what has to precede a value: the separator, the indentation and,
+// for the value of an object member, the name separator. Returns false if
+// the value cannot be written.
+bool QJsonStreamWriterPrivate::beforeValue(bool isString)
+{
+    chunk.clear();
+    if (containers.isEmpty())
+        return true;
+
+    Container &top = containers.last();
+    const bool compact = format == QJsonDocument::Compact;
+    if (top.expectingValue) {
+        top.expectingValue = false;
+        chunk += compact ? ":" : ": ";
+        return true;
+    }
+
+    if (top.isObject && !isString) {
+        qWarning("QJsonStreamWriter: object keys must be strings");
+        return false;
+    }
+    if (!top.isEmpty)
+        chunk += compact ? "," : ",\n";
+    top.isEmpty = false;
+    if (!compact)
+        chunk += QByteArray(4 * containers.size(), ' ');
+    return true;
+}
+
+void QJsonStreamWriterPrivate::afterValue()
+{
+    write(chunk);
+    chunk.clear();
+}
+
+void QJsonStreamWriterPrivate::appendScalar(const QCborValue &value, bool isString)
+{
+    // remember whether this string is a key before beforeValue() updates the state
+    const bool isKey = isString && !containers.isEmpty() && containers.last().isObject
+            && !containers.last().expectingValue;
+    if (!beforeValue(isString))
+        return;
+    const bool compact = format == QJsonDocument::Compact;
+    QJsonPrivate::Writer::valueToJson(value, chunk, compact ? 0 : int(containers.size()), compact);
+    if (isKey)
+        containers.last().expectingValue = true;
+    afterValue();
+}
+
+void QJsonStreamWriterPrivate::startContainer(bool isObject)
+{
+    if (!beforeValue(false))
+        return;
+    chunk += isObject ? '{' : '[';
+    if (format == QJsonDocument::Indented)
+        chunk += '\n';
+    containers.append({ isObject, true, false });
+    afterValue();
+}
+
+bool QJsonStreamWriterPrivate::endContainer(bool isObject)
+{
+    if (containers.isEmpty() || containers.last().isObject != isObject) {
+        qWarning("QJsonStreamWriter: %s() called without a matching start",
+                 isObject ? "endObject" : "endArray");
+        return false;
+    }
+    if (containers.last().expectingValue) {
+        qWarning("QJsonStreamWriter: missing value for the last key of an object");
+        return false;
+    }
+
+    const bool indented = format == QJsonDocument::Indented;
+    const bool wasEmpty = containers.last().isEmpty;
+    containers.removeLast();
+
+    chunk.clear();
+    if (indented) {
+        if (!wasEmpty)
+            chunk += '\n';
+        chunk += QByteArray(4 * containers.size(), ' ');
+    }
+    chunk += isObject ? '}' : ']';
+    if (indented && containers.isEmpty())
+        chunk += '\n';
+    afterValue();
+    return true;
+}
+
+/*!
+    Constructs a writer that writes to \a device, which must be open for
+    writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->device = device;
+}
+
+/*!
+    Constructs a writer that appends to \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->array = data;
+}
+
+/*!
+    Destroys the writer. Containers that are still open are not closed.
+*/
+QJsonStreamWriter::~QJsonStreamWriter() = default;
+
+/*!
+    Makes the writer continue on \a device.
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->device = device;
+    d->array = nullptr;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if it writes to a
+    QByteArray.
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the output format to \a format. The default is
+    QJsonDocument::Indented, as for QJsonDocument::toJson(). Change it only
+    before writing the first value.
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->format = format;
+}
+
+/*!
+    Returns the output format.
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->format;
+}
+
+/*!
+    Appends the string \a str, as a key if an object member's key is
+    expected and as a value otherwise.
+*/
+void QJsonStreamWriter::append(QStringView str)
+{
+    d->appendScalar(QCborValue(str), true);
+}
+
+/*!
+    \overload
+*/
+void QJsonStreamWriter::append(QLatin1String str)
+{
+    d->appendScalar(QCborValue(str), true);
+}
+
+/*!
+    \overload
+
+    Appends the UTF-8 string of \a size bytes starting at \a str, or up to
+    the terminating null if \a size is -1.
+*/
+void QJsonStreamWriter::append(const char *str, qsizetype size)
+{
+    d->appendScalar(QCborValue(QString::fromUtf8(str, size)), true);
+}
+
+/*!
+    Appends the integer \a i.
+*/
+void QJsonStreamWriter::append(qint64 i)
+{
+    d->appendScalar(QCborValue(i));
+}
+
+/*!
+    Appends the number \a d. Infinities and NaN have no JSON representation
+    and are written as \c null, as QJsonDocument does.
+*/
+void QJsonStreamWriter::append(double d)
+{
+    this->d->appendScalar(QCborValue(d));
+}
+
+/*!
+    Appends \c true or \c false, according to \a b.
+*/
+void QJsonStreamWriter::append(bool b)
+{
+    d->appendScalar(QCborValue(b));
+}
+
+/*!
+    Appends \c null.
+*/
+void QJsonStreamWriter::appendNull()
+{
+    d->appendScalar(QCborValue(QCborValue::Null));
+}
+
+/*!
+    Appends \a value, including all the contents of an array or object. An
+    undefined \a value is written as \c null.
+*/
+void QJsonStreamWriter::append(const QJsonValue &value)
+{
+    d->appendScalar(QCborValue::fromJsonValue(value), value.isString());
+}
+
+/*!
+    Starts an array. Follow it by the array's elements and endArray().
+*/
+void QJsonStreamWriter::startArray()
+{
+    d->startContainer(false);
+}
+
+/*!
+    Ends the array started last. Returns \c false if the innermost open
+    container is not an array.
+*/
+bool QJsonStreamWriter::endArray()
+{
+    return d->endContainer(false);
+}
+
+/*!
+    Starts an object. Follow it by alternating keys and values, and
+    endObject().
+*/
+void QJsonStreamWriter::startObject()
+{
+    d->startContainer(true);
+}
+
+/*!
+    Ends the object started last. Returns \c false if the innermost open
+    container is not an object, or if it has a key without a value.
+*/
+bool QJsonStreamWriter::endObject()
+{
+    return d->endContainer(true);
+}
+
+/*!
+    Returns the number of arrays and objects that have been started but not
+    ended yet.
+*/
+int QJsonStreamWriter::containerDepth() const
+{
+    return int(d->containers.size());
+}
+
+QT_END_NAMESPACE
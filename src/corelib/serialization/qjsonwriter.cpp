@@ -45,19 +45,79 @@
 #include "private/qstringconverter_p.h"
 #include <private/qnumeric_p.h>
 #include <private/qcborvalue_p.h>
+#include <private/qsimd_p.h>
+#include <qiodevice.h>
 
 QT_BEGIN_NAMESPACE
 
 using namespace QJsonPrivate;
 
-static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json, int indent, bool compact);
-static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact);
+namespace {
+// Where the output goes when writing to a QIODevice instead of only
+// into a QByteArray
+struct DeviceSink
+{
+    QIODevice *device;
+    bool failed = false;
+};
+}
+
+static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json, int indent,
+                                bool compact, DeviceSink *sink);
+static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json, int indent,
+                               bool compact, DeviceSink *sink);
+
+// Hands the output written so far to the device once there is enough of it,
+// so that the whole document is never held in memory at once.
+static void flushToDevice(QByteArray &json, DeviceSink *sink, qsizetype threshold = 64 * 1024)
+{
+    if (!sink || json.size() < threshold)
+        return;
+    if (!sink->failed && sink->device->write(json) != json.size())
+        sink->failed = true;
+    json.truncate(0);               // keeps the capacity for the next block
+}
 
 static inline uchar hexdig(uint u)
 {
     return (u < 0xa ? '0' + u : 'a' + u - 0xa);
 }
 
+#ifdef __SSE2__
+// Copies the leading characters that need neither escaping nor UTF-8
+// encoding, eight at a time. At least 6 bytes remain before ba_end.
+static void copyPlainAscii(const char16_t *&src, const char16_t *end,
+                           uchar *&cursor, const uchar *ba_end)
+{
+    const __m128i space = _mm_set1_epi16(0x20);
+    const __m128i plainRange = _mm_set1_epi16(0x7f - 0x20);
+    const __m128i quote = _mm_set1_epi16('"');
+    const __m128i backslash = _mm_set1_epi16('\\');
+    while (end - src >= 8 && ba_end - cursor >= 8 + 6) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+        // data - 0x20 is above 0x5f (unsigned) for control and non-ASCII characters
+        __m128i outside = _mm_subs_epu16(_mm_sub_epi16(data, space), plainRange);
+        __m128i plain = _mm_cmpeq_epi16(outside, _mm_setzero_si128());
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi16(data, quote),
+                                       _mm_cmpeq_epi16(data, backslash));
+        plain = _mm_andnot_si128(special, plain);
+
+        // store all eight, but only advance past the plain ones
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(cursor), _mm_packus_epi16(data, data));
+        const uint mask = ~uint(_mm_movemask_epi8(plain)) & 0xffffU;
+        if (mask) {
+            const uint n = qCountTrailingZeroBits(mask) / 2;
+            src += n;
+            cursor += n;
+            return;
+        }
+        src += 8;
+        cursor += 8;
+    }
+}
+#endif
+
 static QByteArray escapedString(const QString &s)
 {
     // give it a minimum size to ensure the resize() below always adds enough space
@@ -77,6 +137,12 @@ static QByteArray escapedString(const QString &s)
             ba_end = (const uchar *)ba.constData() + ba.length();
         }
 
+#ifdef __SSE2__
+        copyPlainAscii(src, end, cursor, ba_end);
+        if (src == end)
+            break;
+#endif
+
         char16_t u = *src++;
         if (u < 0x80) {
             if (u < 0x20 || u == 0x22 || u == 0x5c) {
@@ -128,7 +194,8 @@ static QByteArray escapedString(const QString &s)
     return ba;
 }
 
-static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
+static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact,
+                        DeviceSink *sink = nullptr)
 {
     QCborValue::Type type = v.type();
     switch (type) {
@@ -157,14 +224,14 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
     case QCborValue::Array:
         json += compact ? "[" : "[\n";
         arrayContentToJson(
-                QJsonPrivate::Value::container(v), json, indent + (compact ? 0 : 1), compact);
+                QJsonPrivate::Value::container(v), json, indent + (compact ? 0 : 1), compact, sink);
         json += QByteArray(4*indent, ' ');
         json += ']';
         break;
     case QCborValue::Map:
         json += compact ? "{" : "{\n";
         objectContentToJson(
-                QJsonPrivate::Value::container(v), json, indent + (compact ? 0 : 1), compact);
+                QJsonPrivate::Value::container(v), json, indent + (compact ? 0 : 1), compact, sink);
         json += QByteArray(4*indent, ' ');
         json += '}';
         break;
@@ -174,7 +241,8 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
     }
 }
 
-static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact)
+static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json, int indent,
+                               bool compact, DeviceSink *sink)
 {
     if (!a || a->elements.empty())
         return;
@@ -184,7 +252,8 @@ static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json,
     qsizetype i = 0;
     while (true) {
         json += indentString;
-        valueToJson(a->valueAt(i), json, indent, compact);
+        valueToJson(a->valueAt(i), json, indent, compact, sink);
+        flushToDevice(json, sink);
 
         if (++i == a->elements.size()) {
             if (!compact)
@@ -197,7 +266,8 @@ static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json,
 }
 
 
-static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json, int indent, bool compact)
+static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json, int indent,
+                                bool compact, DeviceSink *sink)
 {
     if (!o || o->elements.empty())
         return;
@@ -211,7 +281,8 @@ static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json
         json += '"';
         json += escapedString(o->valueAt(i).toString());
         json += compact ? "\":" : "\": ";
-        valueToJson(o->valueAt(i + 1), json, indent, compact);
+        valueToJson(o->valueAt(i + 1), json, indent, compact, sink);
+        flushToDevice(json, sink);
 
         if ((i += 2) == o->elements.size()) {
             if (!compact)
@@ -227,18 +298,60 @@ void Writer::objectToJson(const QCborContainerPrivate *o, QByteArray &json, int
 {
     json.reserve(json.size() + (o ? (int)o->elements.size() : 16));
     json += compact ? "{" : "{\n";
-    objectContentToJson(o, json, indent + (compact ? 0 : 1), compact);
+    objectContentToJson(o, json, indent + (compact ? 0 : 1), compact, nullptr);
     json += QByteArray(4*indent, ' ');
     json += compact ? "}" : "}\n";
 }
 
+/*!
+    \internal
+
+    Writes the JSON for object \a o to \a device in blocks, instead of
+    building the whole document in memory first. Returns false if writing to
+    \a device failed.
+*/
+bool Writer::objectToJson(const QCborContainerPrivate *o, QIODevice *device, int indent, bool compact)
+{
+    DeviceSink sink{ device };
+    QByteArray json;
+    json += compact ? "{" : "{\n";
+    objectContentToJson(o, json, indent + (compact ? 0 : 1), compact, &sink);
+    json += QByteArray(4*indent, ' ');
+    json += compact ? "}" : "}\n";
+    flushToDevice(json, &sink, 0);
+    return !sink.failed;
+}
+
+void Writer::valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
+{
+    QT_PREPEND_NAMESPACE(valueToJson)(v, json, indent, compact);
+}
+
 void Writer::arrayToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact)
 {
     json.reserve(json.size() + (a ? (int)a->elements.size() : 16));
     json += compact ? "[" : "[\n";
-    arrayContentToJson(a, json, indent + (compact ? 0 : 1), compact);
+    arrayContentToJson(a, json, indent + (compact ? 0 : 1), compact, nullptr);
+    json += QByteArray(4*indent, ' ');
+    json += compact ? "]" : "]\n";
+}
+
+/*!
+    \internal
+
+    Writes the JSON for array \a a to \a device in blocks. Returns false if
+    writing to \a device failed.
+*/
+bool Writer::arrayToJson(const QCborContainerPrivate *a, QIODevice *device, int indent, bool compact)
+{
+    DeviceSink sink{ device };
+    QByteArray json;
+    json += compact ? "[" : "[\n";
+    arrayContentToJson(a, json, indent + (compact ? 0 : 1), compact, &sink);
     json += QByteArray(4*indent, ' ');
     json += compact ? "]" : "]\n";
+    flushToDevice(json, &sink, 0);
+    return !sink.failed;
 }
 
 QT_END_NAMESPACE
@@ -56,6 +56,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
+
 namespace QJsonPrivate
 {
 
@@ -64,6 +66,10 @@ class Writer
 public:
     static void objectToJson(const QCborContainerPrivate *o, QByteArray &json, int indent, bool compact = false);
     static void arrayToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact = false);
+    static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact = false);
+
+    static bool objectToJson(const QCborContainerPrivate *o, QIODevice *device, int indent, bool compact = false);
+    static bool arrayToJson(const QCborContainerPrivate *a, QIODevice *device, int indent, bool compact = false);
 };
 
 }
@@ -234,6 +234,7 @@ static const int QTEXTSTREAM_BUFFERSIZE = 16384;
 
 #include <locale.h>
 #include "private/qlocale_p.h"
+#include "private/qlocale_tools_p.h"
 #include "private/qstringconverter_p.h"
 
 #include <stdlib.h>
@@ -1733,12 +1734,15 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
         break;
     }
     case 10: {
+        // Look the locale up once per number, not once per character
+        const QString negativeSign = locale.negativeSign();
+        const QString groupSeparator = locale != QLocale::c() ? locale.groupSeparator() : QString();
         // Parse sign (or first digit)
         QChar sign;
         int ndigits = 0;
         if (!getChar(&sign))
             return npsMissingDigit;
-        if (sign != locale.negativeSign() && sign != locale.positiveSign()) {
+        if (sign != negativeSign && sign != locale.positiveSign()) {
             if (!sign.isDigit()) {
                 ungetChar(sign);
                 return npsMissingDigit;
@@ -1749,10 +1753,14 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
         // Parse digits
         QChar ch;
         while (getChar(&ch)) {
-            if (ch.isDigit()) {
+            const char16_t n = ch.unicode();
+            if (n >= '0' && n <= '9') {
+                val *= 10;
+                val += n - '0';
+            } else if (ch.isDigit()) {
                 val *= 10;
                 val += ch.digitValue();
-            } else if (locale != QLocale::c() && ch == locale.groupSeparator()) {
+            } else if (!groupSeparator.isEmpty() && ch == groupSeparator) {
                 continue;
             } else {
                 ungetChar(ch);
@@ -1762,7 +1770,7 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
         }
         if (ndigits == 0)
             return npsMissingDigit;
-        if (sign == locale.negativeSign()) {
+        if (sign == negativeSign) {
             qlonglong ival = qlonglong(val);
             if (ival > 0)
                 ival = -ival;
@@ -1869,6 +1877,14 @@ bool QTextStreamPrivate::getReal(double *f)
     scan(nullptr, nullptr, 0, NotSpace);
     consumeLastToken();
 
+    // Look the locale up once per number, not once per character
+    const bool isCLocale = locale == QLocale::c();
+    const QString decimalPoint = locale.decimalPoint().toLower();
+    const QString exponential = locale.exponential().toLower();
+    const QString negativeSign = locale.negativeSign().toLower();
+    const QString positiveSign = locale.positiveSign().toLower();
+    const QString groupSeparator = isCLocale ? QString() : locale.groupSeparator().toLower();
+
     const int BufferSize = 128;
     char buf[BufferSize];
     int i = 0;
@@ -1897,15 +1913,14 @@ bool QTextStreamPrivate::getReal(double *f)
             break;
         default: {
             QChar lc = c.toLower();
-            if (lc == locale.decimalPoint().toLower())
+            if (lc == decimalPoint)
                 input = InputDot;
-            else if (lc == locale.exponential().toLower())
+            else if (lc == exponential)
                 input = InputExp;
-            else if (lc == locale.negativeSign().toLower()
-                     || lc == locale.positiveSign().toLower())
+            else if (lc == negativeSign || lc == positiveSign)
                 input = InputSign;
-            else if (locale != QLocale::c() // backward-compatibility
-                     && lc == locale.groupSeparator().toLower())
+            else if (!groupSeparator.isEmpty() // backward-compatibility
+                     && lc == groupSeparator)
                 input = InputDigit; // well, it isn't a digit, but no one cares.
             else
                 input = None;
@@ -1952,6 +1967,12 @@ bool QTextStreamPrivate::getReal(double *f)
         return true;
     }
     bool ok;
+    if (isCLocale) {
+        // buf only holds characters the C locale parser takes as they are
+        int processed;
+        *f = qt_asciiToDouble(buf, i, ok, processed);
+        return ok;
+    }
     *f = locale.toDouble(QString::fromLatin1(buf), &ok);
     return ok;
 }
@@ -64,7 +64,9 @@ public: \
 private:
 #endif
 
+#include <algorithm>
 #include <iterator>
+#include "private/qsimd_p.h"
 #include "qxmlstream_p.h"
 #include "qxmlstreamparser_p.h"
 
@@ -1133,6 +1135,63 @@ bool QXmlStreamReaderPrivate::scanAttType()
     return false;
 }
 
+/*
+    Returns the length of the run at the start of [begin, end) made of
+    characters the fast scanners pass through unchanged: those from U+0020 to
+    U+FFFD (including surrogates) other than the four stop characters.
+*/
+static qsizetype plainCharRun(const char16_t *begin, const char16_t *end,
+                              char16_t stop1, char16_t stop2, char16_t stop3, char16_t stop4)
+{
+    const char16_t *ptr = begin;
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i minChar = _mm_set1_epi16(0x20);
+    const __m128i maxChar = _mm_set1_epi16(short(0xfffd));
+    const __m128i s1 = _mm_set1_epi16(short(stop1));
+    const __m128i s2 = _mm_set1_epi16(short(stop2));
+    const __m128i s3 = _mm_set1_epi16(short(stop3));
+    const __m128i s4 = _mm_set1_epi16(short(stop4));
+    for ( ; end - ptr >= 8; ptr += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        // unsigned 0x20 <= c <= 0xfffd, by saturating subtraction
+        const __m128i inRange = _mm_and_si128(_mm_cmpeq_epi16(_mm_subs_epu16(minChar, data), zero),
+                                              _mm_cmpeq_epi16(_mm_subs_epu16(data, maxChar), zero));
+        __m128i stop = _mm_or_si128(_mm_cmpeq_epi16(data, s1), _mm_cmpeq_epi16(data, s2));
+        stop = _mm_or_si128(stop, _mm_or_si128(_mm_cmpeq_epi16(data, s3), _mm_cmpeq_epi16(data, s4)));
+        const uint mask = ~uint(_mm_movemask_epi8(_mm_andnot_si128(stop, inRange))) & 0xffff;
+        if (mask)
+            return ptr - begin + qCountTrailingZeroBits(mask) / 2;
+    }
+#endif
+    for ( ; ptr != end; ++ptr) {
+        const char16_t c = *ptr;
+        if (c < 0x20 || c > 0xfffd || c == stop1 || c == stop2 || c == stop3 || c == stop4)
+            break;
+    }
+    return ptr - begin;
+}
+
+/*!
+ \internal
+
+ Appends to textBuffer the run of characters at the read position that the
+ fast scanners would append one by one, as found by plainCharRun(), and
+ returns its length. Nothing is consumed while characters were put back.
+ */
+qsizetype QXmlStreamReaderPrivate::fastScanPlainRun(char16_t stop1, char16_t stop2,
+                                                    char16_t stop3, char16_t stop4)
+{
+    if (!putStack.isEmpty() || readBufferPos >= readBuffer.size())
+        return 0;
+    const char16_t *begin = reinterpret_cast<const char16_t *>(readBuffer.constData()) + readBufferPos;
+    const char16_t *end = reinterpret_cast<const char16_t *>(readBuffer.constData()) + readBuffer.size();
+    const qsizetype run = plainCharRun(begin, end, stop1, stop2, stop3, stop4);
+    textBuffer.append(reinterpret_cast<const QChar *>(begin), run);
+    readBufferPos += int(run);
+    return run;
+}
+
 /*!
  \internal
 
@@ -1149,7 +1208,11 @@ inline int QXmlStreamReaderPrivate::fastScanLiteralContent()
 {
     int n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        // a space needs no normalization, so it can be part of the run
+        n += int(fastScanPlainRun(u'&', u'<', u'"', u'\''));
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -1232,7 +1295,17 @@ inline int QXmlStreamReaderPrivate::fastScanContentCharList()
 {
     int n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        if (const qsizetype run = fastScanPlainRun(u'&', u'<', u']', u']')) {
+            n += int(run);
+            if (isWhitespace) {
+                const QStringView appended = QStringView(textBuffer).last(run);
+                isWhitespace = std::all_of(appended.begin(), appended.end(),
+                                           [](QChar ch) { return ch == u' '; });
+            }
+        }
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
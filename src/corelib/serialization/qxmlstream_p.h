@@ -500,6 +500,7 @@ public:
 
     // scan optimization functions. Not strictly necessary but LALR is
     // not very well suited for scanning fast
+    qsizetype fastScanPlainRun(char16_t stop1, char16_t stop2, char16_t stop3, char16_t stop4);
     int fastScanLiteralContent();
     int fastScanSpace();
     int fastScanContentCharList();
@@ -39,6 +39,8 @@
 
 #include "qbytearraymatcher.h"
 
+#include <private/qsimd_p.h>
+
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
@@ -52,6 +54,56 @@ static inline void bm_init_skiptable(const uchar *cc, qsizetype len, uchar *skip
         skiptable[*cc++] = l;
 }
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+// Up to this pattern length, comparing 16 bytes at a time against the
+// pattern's first and last byte beats the skip table; longer patterns
+// let Boyer-Moore skip further than that.
+static constexpr qsizetype SimdPrefilterMaxLength = 16;
+
+// Searches whole 16-byte blocks of the haystack, starting at index, for the
+// pattern. Returns the match position, or -1 with index advanced to the first
+// position that still needs to be searched.
+static qsizetype simd_find(const uchar *cc, qsizetype l, qsizetype &index, const uchar *puc,
+                           qsizetype pl)
+{
+    const qsizetype pl_minus_one = pl - 1;
+    auto verify = [&](qsizetype pos) {
+        return memcmp(cc + pos + 1, puc + 1, pl - 2) == 0;
+    };
+#  if defined(__SSE2__)
+    const __m128i first = _mm_set1_epi8(char(puc[0]));
+    const __m128i last = _mm_set1_epi8(char(puc[pl_minus_one]));
+    for ( ; index + pl_minus_one + 16 <= l; index += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + index));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(cc + index + pl_minus_one));
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                                    _mm_cmpeq_epi8(b, last)));
+        for ( ; mask; mask &= mask - 1) {
+            const qsizetype pos = index + qCountTrailingZeroBits(mask);
+            if (verify(pos))
+                return pos;
+        }
+    }
+#  else
+    const uint8x16_t first = vdupq_n_u8(puc[0]);
+    const uint8x16_t last = vdupq_n_u8(puc[pl_minus_one]);
+    for ( ; index + pl_minus_one + 16 <= l; index += 16) {
+        const uint8x16_t cmp = vandq_u8(vceqq_u8(vld1q_u8(cc + index), first),
+                                        vceqq_u8(vld1q_u8(cc + index + pl_minus_one), last));
+        // NEON has no movemask; narrowing leaves 4 bits per byte
+        quint64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0)
+                & Q_UINT64_C(0x8888888888888888);
+        for ( ; mask; mask &= mask - 1) {
+            const qsizetype pos = index + qCountTrailingZeroBits(mask) / 4;
+            if (verify(pos))
+                return pos;
+        }
+    }
+#  endif
+    return -1;
+}
+#endif
+
 static inline qsizetype bm_find(const uchar *cc, qsizetype l, qsizetype index, const uchar *puc,
                                 qsizetype pl, const uchar *skiptable)
 {
@@ -59,6 +111,15 @@ static inline qsizetype bm_find(const uchar *cc, qsizetype l, qsizetype index, c
         return index > l ? -1 : index;
     const qsizetype pl_minus_one = pl - 1;
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+    if (pl > 1 && pl <= SimdPrefilterMaxLength) {
+        const qsizetype found = simd_find(cc, l, index, puc, pl);
+        if (found >= 0)
+            return found;
+        // the tail shorter than a block is left to the loop below
+    }
+#endif
+
     const uchar *current = cc + index + pl_minus_one;
     const uchar *end = cc + l;
     while (current < end) {
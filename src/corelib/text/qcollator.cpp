@@ -45,6 +45,13 @@
 #include "qdebug.h"
 #include "qlocale_p.h"
 #include "qthreadstorage.h"
+#if QT_CONFIG(thread)
+#include "qsemaphore.h"
+#include "qthreadpool.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
 
 QT_BEGIN_NAMESPACE
 
@@ -408,6 +415,110 @@ QCollatorSortKey QCollator::defaultSortKey(QStringView key)
     \note Not supported with the C (a.k.a. POSIX) locale on Darwin.
 */
 
+/*!
+    \fn void QCollator::sort(QStringList &list) const
+    \since 6.4
+
+    Sorts \a list according to this collator.
+
+    This computes the sort key of each string once, spreading the work over
+    the threads of the global QThreadPool for large lists, and then sorts on
+    the keys. That is usually much faster than passing the collator to
+    std::sort(), which collates each pair of strings it compares from scratch.
+    Strings that collate equal keep their relative order.
+
+    \sa sortKey()
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator> void QCollator::sort(RandomAccessIterator first, RandomAccessIterator last) const
+    \since 6.4
+    \overload
+
+    Sorts the strings in the range [\a first, \a last) according to this
+    collator. The elements must be QStrings or convertible to QStringView.
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename Projection> void QCollator::sort(RandomAccessIterator first, RandomAccessIterator last, Projection projection) const
+    \since 6.4
+    \overload
+
+    Sorts the elements in the range [\a first, \a last) according to this
+    collator's order of the strings that \a projection returns for them. The
+    projection must return a QString reference or a QStringView into the
+    element, not a temporary string. The elements are moved, so they must be
+    move-constructible and move-assignable.
+
+    \snippet code/src_corelib_text_qcollator.cpp 1
+*/
+
+/*!
+    \internal
+
+    Returns the permutation that sorts the \a count \a strings: the index of
+    the string that goes first, then that of the string that goes second, and
+    so on.
+*/
+QList<qsizetype> QCollator::sortOrder(const QStringView *strings, qsizetype count) const
+{
+    if (d->dirty)
+        d->init();
+
+    QList<qsizetype> order(count);
+    for (qsizetype i = 0; i < count; ++i)
+        order[i] = i;
+    if (count < 2)
+        return order;
+
+    QList<QCollatorSortKey> keys(count, QCollatorSortKey(nullptr));
+    QCollatorSortKey *const keyData = keys.data();
+    keyData[0] = sortKey(strings[0].toString());
+    if (!keyData[0].d) {
+        // This collator doesn't support sort keys (C locale on Darwin)
+        std::stable_sort(order.begin(), order.end(), [&](qsizetype lhs, qsizetype rhs) {
+            return compare(strings[lhs], strings[rhs]) < 0;
+        });
+        return order;
+    }
+    const auto computeKeys = [&](qsizetype from, qsizetype to) {
+        for (qsizetype i = qMax<qsizetype>(from, 1); i < to; ++i)
+            keyData[i] = sortKey(strings[i].toString());
+    };
+
+    // Computing the keys is what's expensive; hand out blocks of strings to
+    // this thread and to as many idle threads of the global pool as needed.
+    constexpr qsizetype BlockSize = 256;
+#if QT_CONFIG(thread)
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype blocks = (count + BlockSize - 1) / BlockSize;
+    if (blocks > 1 && pool->maxThreadCount() > 1) {
+        std::atomic<qsizetype> nextBlock = 0;
+        const auto work = [&] {
+            for (qsizetype b = nextBlock++; b < blocks; b = nextBlock++)
+                computeKeys(b * BlockSize, qMin((b + 1) * BlockSize, count));
+        };
+        QSemaphore finished;
+        int helpers = 0;
+        // Only tryStart(), so that we can't deadlock when called from a pool thread
+        while (helpers < qMin<qsizetype>(pool->maxThreadCount(), blocks) - 1
+               && pool->tryStart([&] { work(); finished.release(); })) {
+            ++helpers;
+        }
+        work();
+        finished.acquire(helpers);
+    } else
+#endif
+    {
+        computeKeys(0, count);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [keyData](qsizetype lhs, qsizetype rhs) {
+        return keyData[lhs].compare(keyData[rhs]) < 0;
+    });
+    return order;
+}
+
 /*!
     \class QCollatorSortKey
     \inmodule QtCore
@@ -117,6 +117,36 @@ public:
 
     QCollatorSortKey sortKey(const QString &string) const;
 
+    void sort(QStringList &list) const
+    { sort(list.begin(), list.end()); }
+    template <typename RandomAccessIterator>
+    void sort(RandomAccessIterator first, RandomAccessIterator last) const
+    { sort(first, last, [](const auto &s) { return QStringView(s); }); }
+    template <typename RandomAccessIterator, typename Projection>
+    void sort(RandomAccessIterator first, RandomAccessIterator last, Projection projection) const
+    {
+        QList<QStringView> strings;
+        strings.reserve(last - first);
+        for (auto it = first; it != last; ++it)
+            strings.append(QStringView(projection(*it)));
+        QList<qsizetype> order = sortOrder(strings.constData(), strings.size());
+
+        // Move each element into place, following the cycles of the permutation
+        for (qsizetype i = 0; i < order.size(); ++i) {
+            if (order.at(i) == i)
+                continue;
+            auto value = std::move(first[i]);
+            qsizetype j = i;
+            for (qsizetype from = order.at(j); from != i; from = order.at(j)) {
+                first[j] = std::move(first[from]);
+                order[j] = j;
+                j = from;
+            }
+            first[j] = std::move(value);
+            order[j] = j;
+        }
+    }
+
     static int defaultCompare(QStringView s1, QStringView s2);
     static QCollatorSortKey defaultSortKey(QStringView key);
 
@@ -124,6 +154,7 @@ private:
     QCollatorPrivate *d;
 
     void detach();
+    QList<qsizetype> sortOrder(const QStringView *strings, qsizetype count) const;
 };
 
 Q_DECLARE_SHARED(QCollatorSortKey)
@@ -69,9 +69,7 @@ QT_WARNING_DISABLE_GCC("-Wfree-nonheap-object") // false positive tracking
 #include "qstringbuilder.h"
 #include "private/qnumeric_p.h"
 #include <cmath>
-#ifndef QT_NO_SYSTEMLOCALE
-#   include "qmutex.h"
-#endif
+#include "qmutex.h"
 #ifdef Q_OS_WIN
 #   include <qt_windows.h>
 #   include <time.h>
@@ -853,15 +851,77 @@ QBasicAtomicInt QLocalePrivate::s_generation = Q_BASIC_ATOMIC_INITIALIZER(0);
 Q_GLOBAL_STATIC_WITH_ARGS(QSharedDataPointer<QLocalePrivate>, defaultLocalePrivate,
                           (new QLocalePrivate(defaultData(), defaultIndex())))
 
+/*
+    Applications tend to construct the same few locales over and over. Share one
+    QLocalePrivate per locale_data entry instead of allocating one per QLocale;
+    QSharedDataPointer detaches before anything modifies it.
+*/
+static QLocalePrivate *sharedLocalePrivate(int index)
+{
+    Q_ASSERT(index >= 0 && size_t(index) < std::size(locale_data) - 1);
+    if (index == 0)
+        return c_private();
+
+    static QBasicAtomicPointer<QLocalePrivate> cache[std::size(locale_data) - 1] = {};
+    QLocalePrivate *d = cache[index].loadAcquire();
+    if (!d) {
+        // The cache holds a reference, so these are never deleted
+        auto created = new QLocalePrivate(locale_data + index, index,
+                                          locale_data[index].m_language_id == QLocale::C
+                                          ? QLocale::OmitGroupSeparator
+                                          : QLocale::DefaultNumberOptions, 1);
+        if (cache[index].testAndSetOrdered(nullptr, created, d))
+            d = created;
+        else
+            delete created;
+    }
+    return d;
+}
+
+namespace {
+// Remembers the last few names resolved, as parsing a name and searching
+// the tables for it is the expensive part of QLocale(QStringView).
+struct LocaleNameCache
+{
+    struct Entry
+    {
+        QString name;
+        int index = -1;
+    };
+    QBasicMutex mutex;
+    Entry entries[16];
+    uint next = 0;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(LocaleNameCache, localeNameCache)
+
+static int localeIndexByName(QStringView name)
+{
+    LocaleNameCache *cache = localeNameCache();
+    if (cache) {
+        QMutexLocker locker(&cache->mutex);
+        for (const LocaleNameCache::Entry &entry : cache->entries) {
+            if (entry.index >= 0 && entry.name == name)
+                return entry.index;
+        }
+    }
+
+    const int index = QLocaleData::findLocaleIndex(QLocaleId::fromName(name));
+    if (cache) {
+        QMutexLocker locker(&cache->mutex);
+        LocaleNameCache::Entry &entry = cache->entries[cache->next++ % std::size(cache->entries)];
+        entry.name = name.toString();
+        entry.index = index;
+    }
+    return index;
+}
+
 static QLocalePrivate *localePrivateByName(QStringView name)
 {
     if (name == u"C")
         return c_private();
-    const int index = QLocaleData::findLocaleIndex(QLocaleId::fromName(name));
-    Q_ASSERT(index >= 0 && size_t(index) < std::size(locale_data) - 1);
-    return new QLocalePrivate(locale_data + index, index,
-                              locale_data[index].m_language_id == QLocale::C
-                              ? QLocale::OmitGroupSeparator : QLocale::DefaultNumberOptions);
+    return sharedLocalePrivate(localeIndexByName(name));
 }
 
 static QLocalePrivate *findLocalePrivate(QLocale::Language language, QLocale::Script script,
@@ -882,8 +942,9 @@ static QLocalePrivate *findLocalePrivate(QLocale::Language language, QLocale::Sc
             numberOptions = defaultLocalePrivate->data()->m_numberOptions;
         data = defaultData();
         index = defaultIndex();
+        return new QLocalePrivate(data, index, numberOptions);
     }
-    return new QLocalePrivate(data, index, numberOptions);
+    return sharedLocalePrivate(index);
 }
 
 QString QLocaleData::decimalPoint() const
@@ -53,6 +53,7 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <cmath>
 #include <limits>
 #include <charconv>
 
@@ -75,6 +76,96 @@ QT_BEGIN_NAMESPACE
 
 QT_CLOCALE_HOLDER
 
+// std::to_chars() and std::from_chars() for double are exact, and faster than
+// libdouble-conversion where the standard library implements them with Ryu and
+// fast_float. libstdc++ before version 12 parses with strtod() under a locale
+// switch, so don't bother with it there.
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L && !defined(QT_BOOTSTRAPPED) \
+    && (!defined(_GLIBCXX_RELEASE) || _GLIBCXX_RELEASE >= 12)
+#  define QT_LOCALE_TOOLS_FLOATING_POINT_CHARCONV
+#endif
+
+#ifdef QT_LOCALE_TOOLS_FLOATING_POINT_CHARCONV
+/*
+    Generates the shortest digits that round-trip for the finite, non-negative
+    \a d into \a buf, the same as libdouble-conversion's SHORTEST mode does.
+    Returns false if they don't fit.
+*/
+static bool doubleToAsciiCharconv(double d, char *buf, int bufSize, int &length, int &decpt)
+{
+    // d.dddddddddddddddde-308
+    char scientific[std::numeric_limits<double>::max_digits10 + 8];
+    const auto res = std::to_chars(scientific, std::end(scientific), d,
+                                   std::chars_format::scientific);
+    if (res.ec != std::errc())
+        return false;
+
+    const char *const e = std::find(scientific, res.ptr, 'e');
+    Q_ASSERT(e != res.ptr);
+    length = 0;
+    for (const char *p = scientific; p != e; ++p) {
+        if (*p == '.')
+            continue;
+        if (length == bufSize)
+            return false;
+        buf[length++] = *p;
+    }
+    int exponent = 0;
+    for (const char *p = e + 2; p != res.ptr; ++p)
+        exponent = exponent * 10 + (*p - '0');
+    decpt = (e[1] == '-' ? -exponent : exponent) + 1;
+    return true;
+}
+
+/*
+    Parses the whole of \a num (or, with TrailingJunkAllowed, a prefix of it)
+    like libdouble-conversion does, as long as it is a plain finite number in
+    range. Returns false if the caller has to fall back to the latter.
+*/
+static bool asciiToDoubleCharconv(const char *num, qsizetype numLen,
+                                  StrayCharacterMode strayCharMode, double &d, int &processed)
+{
+    const auto isSpace = [](char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    };
+    if (int(numLen) != numLen)
+        return false;
+    const char *begin = num;
+    const char *end = num + numLen;
+    if (strayCharMode == WhitespacesAllowed) {
+        while (begin != end && isSpace(*begin))
+            ++begin;
+        while (begin != end && isSpace(end[-1]))
+            --end;
+    }
+    // std::from_chars() doesn't accept a '+', but does accept "inf", "nan"
+    // and hexadecimal floats without prefix, none of which we want
+    const char *digits = begin;
+    if (digits != end && *digits == '+')
+        begin = ++digits;
+    else if (digits != end && *digits == '-')
+        ++digits;
+    if (digits == end || !(*digits == '.' || (*digits >= '0' && *digits <= '9')))
+        return false;
+
+    const auto res = std::from_chars(begin, end, d, std::chars_format::general);
+    if (res.ec != std::errc())
+        return false; // garbage, overflow or underflow
+    if (res.ptr != end && strayCharMode != TrailingJunkAllowed)
+        return false;
+    if (isZero(d)) {
+        // leave reporting underflow to the fallback
+        for (const char *p = digits; p != res.ptr && *p != 'e' && *p != 'E'; ++p) {
+            if (*p >= '1' && *p <= '9')
+                return false;
+        }
+    }
+    // trailing whitespace counts as processed
+    processed = int(res.ptr == end ? numLen : res.ptr - num);
+    return true;
+}
+#endif // QT_LOCALE_TOOLS_FLOATING_POINT_CHARCONV
+
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, char *buf, int bufSize,
                       bool &sign, int &length, int &decpt)
 {
@@ -116,6 +207,16 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#ifdef QT_LOCALE_TOOLS_FLOATING_POINT_CHARCONV
+    // Only for the shortest form: for a given precision, libstdc++'s
+    // std::to_chars() is slower than libdouble-conversion.
+    if (precision == QLocale::FloatingPointShortest) {
+        sign = std::signbit(d);
+        if (doubleToAsciiCharconv(std::abs(d), buf, bufSize, length, decpt))
+            return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
@@ -320,6 +421,10 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
     }
 
     double d = 0.0;
+#ifdef QT_LOCALE_TOOLS_FLOATING_POINT_CHARCONV
+    if (asciiToDoubleCharconv(num, numLen, strayCharMode, d, processed))
+        return d;
+#endif
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
     if (strayCharMode == TrailingJunkAllowed) {
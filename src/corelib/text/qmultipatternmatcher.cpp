@@ -0,0 +1,342 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmultipatternmatcher_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+/*!
+    \internal
+
+    Builds the automaton for \a patterns, replacing the previous ones. The
+    pattern indexes reported by forEachOutput() are indexes into \a patterns.
+*/
+void QAhoCorasickAutomaton::build(const QList<QByteArrayView> &patterns)
+{
+    // bytes that occur in no pattern all map to class 0
+    memset(byteClass, 0, sizeof(byteClass));
+    classCount = 1;
+    for (QByteArrayView pattern : patterns) {
+        for (char c : pattern) {
+            if (!byteClass[uchar(c)])
+                byteClass[uchar(c)] = quint16(classCount++);
+        }
+    }
+
+    // the trie, with -1 for missing transitions
+    transitions = QList<qint32>(classCount, -1);
+    terminalPattern = { -1 };
+    nextSamePattern = QList<qint32>(patterns.size(), -1);
+    patternLengths = QList<qsizetype>(patterns.size(), 0);
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QByteArrayView pattern = patterns.at(i);
+        patternLengths[i] = pattern.size();
+        if (pattern.isEmpty())
+            continue;
+        qint32 state = 0;
+        for (char c : pattern) {
+            const qsizetype idx = state * classCount + byteClass[uchar(c)];
+            if (transitions.at(idx) < 0) {
+                transitions[idx] = qint32(terminalPattern.size());
+                transitions.insert(transitions.size(), classCount, -1);
+                terminalPattern.append(-1);
+            }
+            state = transitions.at(idx);
+        }
+        if (terminalPattern.at(state) < 0) {
+            terminalPattern[state] = qint32(i);
+        } else {
+            qint32 last = terminalPattern.at(state);
+            while (nextSamePattern.at(last) >= 0)
+                last = nextSamePattern.at(last);
+            nextSamePattern[last] = qint32(i);
+        }
+    }
+
+    // Compute the fail links breadth-first and fill in the missing
+    // transitions from the fail state's, which is shallower and therefore
+    // already complete. This turns the trie into a DFA.
+    const qsizetype stateCount = terminalPattern.size();
+    fail = QList<qint32>(stateCount, 0);
+    outputLink = QList<qint32>(stateCount, -1);
+    QList<qint32> queue;
+    queue.reserve(stateCount);
+    auto enqueue = [&](qint32 state, qint32 failState) {
+        fail[state] = failState;
+        outputLink[state] = terminalPattern.at(state) >= 0 ? state : outputLink.at(failState);
+        queue.append(state);
+    };
+    for (qint32 c = 0; c < classCount; ++c) {
+        if (transitions.at(c) < 0)
+            transitions[c] = 0;
+        else
+            enqueue(transitions.at(c), 0);
+    }
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const qsizetype row = queue.at(head) * classCount;
+        const qsizetype failRow = fail.at(queue.at(head)) * classCount;
+        for (qint32 c = 0; c < classCount; ++c) {
+            const qint32 target = transitions.at(row + c);
+            if (target < 0)
+                transitions[row + c] = transitions.at(failRow + c);
+            else
+                enqueue(target, transitions.at(failRow + c));
+        }
+    }
+}
+
+} // namespace QtPrivate
+
+namespace {
+// Runs the automaton over data from position from on and calls f for every
+// match, in order of their end position, until f returns false.
+template <typename F>
+void scanBytes(const QtPrivate::QAhoCorasickAutomaton &automaton, QByteArrayView data,
+               qsizetype from, F f)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data.data());
+    qint32 state = 0;
+    for (qsizetype i = qMax(from, qsizetype(0)); i < data.size(); ++i) {
+        state = automaton.next(state, p[i]);
+        if (Q_LIKELY(!automaton.hasOutput(state)))
+            continue;
+        const bool more = automaton.forEachOutput(state, [&](qsizetype pattern) {
+            const qsizetype length = automaton.patternLength(pattern);
+            return f(QMultiPatternMatch{ i + 1 - length, length, pattern });
+        });
+        if (!more)
+            return;
+    }
+}
+
+// As scanBytes(), but feeds each UTF-16 code unit as two bytes and reports
+// positions and lengths in code units. Case folding is done one code point
+// at a time, as QString::toCaseFolded() does for the patterns.
+template <typename F>
+void scanString(const QtPrivate::QAhoCorasickAutomaton &automaton, QStringView str,
+                qsizetype from, Qt::CaseSensitivity cs, F f)
+{
+    const char16_t *uc = str.utf16();
+    const qsizetype len = str.size();
+    qint32 state = 0;
+    auto feed = [&](char16_t c, qsizetype end) {
+        state = automaton.next(automaton.next(state, uchar(c)), uchar(c >> 8));
+        if (Q_LIKELY(!automaton.hasOutput(state)))
+            return true;
+        return automaton.forEachOutput(state, [&](qsizetype pattern) {
+            const qsizetype length = automaton.patternLength(pattern) / 2;
+            return f(QMultiPatternMatch{ end - length, length, pattern });
+        });
+    };
+    for (qsizetype i = qMax(from, qsizetype(0)); i < len; ++i) {
+        char16_t c = uc[i];
+        if (cs == Qt::CaseInsensitive) {
+            if (QChar::isHighSurrogate(c) && i + 1 < len && QChar::isLowSurrogate(uc[i + 1])) {
+                const char32_t folded = QChar::toCaseFolded(QChar::surrogateToUcs4(c, uc[i + 1]));
+                if (!feed(QChar::highSurrogate(folded), i + 1))
+                    return;
+                ++i;
+                c = QChar::lowSurrogate(folded);
+            } else {
+                c = QChar::toCaseFolded(c);
+            }
+        }
+        if (!feed(c, i + 1))
+            return;
+    }
+}
+} // unnamed namespace
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \internal
+
+    \brief The QMultiByteArrayMatcher class finds any of a set of byte
+    sequences in a byte array in a single pass.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    Constructs a matcher that searches for all of \a patterns.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &patterns)
+{
+    setPatterns(patterns);
+}
+
+/*!
+    Sets the byte arrays that this matcher searches for to \a patterns.
+*/
+void QMultiByteArrayMatcher::setPatterns(const QList<QByteArray> &patterns)
+{
+    q_patterns = patterns;
+    QList<QByteArrayView> views;
+    views.reserve(q_patterns.size());
+    for (const QByteArray &pattern : std::as_const(q_patterns))
+        views.append(pattern);
+    q_automaton.build(views);
+}
+
+/*!
+    Searches \a data from byte position \a from for the patterns, and returns
+    the match that ends first. If several patterns end there, the longest one
+    is returned. The returned match is invalid if none of the patterns occurs.
+*/
+QMultiPatternMatch QMultiByteArrayMatcher::indexIn(QByteArrayView data, qsizetype from) const
+{
+    Match result;
+    scanBytes(q_automaton, data, from, [&](const Match &match) {
+        result = match;
+        return false;
+    });
+    return result;
+}
+
+/*!
+    Returns every occurrence of every pattern in \a data from byte position
+    \a from on, including overlapping ones, in order of their end position.
+*/
+QList<QMultiPatternMatch> QMultiByteArrayMatcher::findAll(QByteArrayView data, qsizetype from) const
+{
+    QList<Match> result;
+    scanBytes(q_automaton, data, from, [&](const Match &match) {
+        result.append(match);
+        return true;
+    });
+    return result;
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \internal
+
+    \brief The QMultiStringMatcher class finds any of a set of strings in a
+    Unicode string in a single pass.
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+/*!
+    Constructs a matcher that searches for all of \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : q_patterns(patterns), q_cs(cs)
+{
+    rebuild();
+}
+
+/*!
+    Sets the strings that this matcher searches for to \a patterns.
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    q_patterns = patterns;
+    rebuild();
+}
+
+/*!
+    Sets the case sensitivity of this matcher to \a cs.
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs == q_cs)
+        return;
+    q_cs = cs;
+    rebuild();
+}
+
+void QMultiStringMatcher::rebuild()
+{
+    // spell out the byte order, since scanString() feeds the low byte first
+    QList<QByteArray> bytes;
+    bytes.reserve(q_patterns.size());
+    for (const QString &pattern : std::as_const(q_patterns)) {
+        const QString &folded = q_cs == Qt::CaseInsensitive ? pattern.toCaseFolded() : pattern;
+        QByteArray &b = bytes.emplace_back();
+        b.reserve(folded.size() * 2);
+        for (QChar c : folded) {
+            b.append(char(c.unicode()));
+            b.append(char(c.unicode() >> 8));
+        }
+    }
+    QList<QByteArrayView> views;
+    views.reserve(bytes.size());
+    for (const QByteArray &b : std::as_const(bytes))
+        views.append(b);
+    q_automaton.build(views);
+}
+
+/*!
+    Searches \a str from character position \a from for the patterns, and
+    returns the match that ends first. If several patterns end there, the
+    longest one is returned. The returned match is invalid if none of the
+    patterns occurs.
+*/
+QMultiPatternMatch QMultiStringMatcher::indexIn(QStringView str, qsizetype from) const
+{
+    Match result;
+    scanString(q_automaton, str, from, q_cs, [&](const Match &match) {
+        result = match;
+        return false;
+    });
+    return result;
+}
+
+/*!
+    Returns every occurrence of every pattern in \a str from character
+    position \a from on, including overlapping ones, in order of their end
+    position.
+*/
+QList<QMultiPatternMatch> QMultiStringMatcher::findAll(QStringView str, qsizetype from) const
+{
+    QList<Match> result;
+    scanString(q_automaton, str, from, q_cs, [&](const Match &match) {
+        result.append(match);
+        return true;
+    });
+    return result;
+}
+
+QT_END_NAMESPACE
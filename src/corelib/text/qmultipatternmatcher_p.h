@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QMULTIPATTERNMATCHER_P_H
+#define QMULTIPATTERNMATCHER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QMultiByteArrayMatcher and QMultiStringMatcher search for any number of
+  patterns at once, finding every occurrence of every pattern in a single
+  pass over the haystack. Their cost per searched byte does not depend on the
+  number of patterns, so they are meant for the case where QByteArrayMatcher
+  or QStringMatcher would have to be run once per pattern.
+
+  Both build an Aho-Corasick automaton over bytes when the patterns are set.
+  Bytes that occur in no pattern share one input class, which keeps the
+  transition table small. QMultiStringMatcher feeds each UTF-16 code unit as
+  two bytes and only reports matches that end on a code unit boundary.
+
+  A match is reported as the pattern's index in patterns(), its position and
+  its length. Matches may overlap. Empty patterns never match.
+*/
+
+struct QMultiPatternMatch
+{
+    qsizetype position = -1;
+    qsizetype length = 0;
+    qsizetype pattern = -1;
+
+    bool isValid() const noexcept { return position >= 0; }
+};
+Q_DECLARE_TYPEINFO(QMultiPatternMatch, Q_PRIMITIVE_TYPE);
+
+namespace QtPrivate {
+class Q_CORE_EXPORT QAhoCorasickAutomaton
+{
+public:
+    void build(const QList<QByteArrayView> &patterns);
+
+    qint32 next(qint32 state, uchar c) const noexcept
+    { return transitions[state * classCount + byteClass[c]]; }
+    bool hasOutput(qint32 state) const noexcept
+    { return outputLink[state] >= 0; }
+    qsizetype patternLength(qsizetype pattern) const noexcept
+    { return patternLengths[pattern]; }
+
+    // Calls f(pattern) for every pattern that ends in the given state,
+    // longest first, until f returns false. Returns false if f did.
+    template <typename F>
+    bool forEachOutput(qint32 state, F f) const
+    {
+        for (qint32 s = outputLink[state]; s >= 0; s = outputLink[fail[s]]) {
+            for (qint32 p = terminalPattern[s]; p >= 0; p = nextSamePattern[p]) {
+                if (!f(qsizetype(p)))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    quint16 byteClass[256] = {};
+    qint32 classCount = 1;
+    // the root state's row, so that an empty automaton never matches
+    QList<qint32> transitions = { 0 };
+    QList<qint32> fail = { 0 };
+    // nearest state, following fail links, in which a pattern ends
+    QList<qint32> outputLink = { -1 };
+    QList<qint32> terminalPattern = { -1 };
+    QList<qint32> nextSamePattern;
+    QList<qsizetype> patternLengths;
+};
+} // namespace QtPrivate
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    using Match = QMultiPatternMatch;
+
+    QMultiByteArrayMatcher() = default;
+    explicit QMultiByteArrayMatcher(const QList<QByteArray> &patterns);
+
+    void setPatterns(const QList<QByteArray> &patterns);
+    QList<QByteArray> patterns() const { return q_patterns; }
+
+    Match indexIn(QByteArrayView data, qsizetype from = 0) const;
+    QList<Match> findAll(QByteArrayView data, qsizetype from = 0) const;
+    bool containsAny(QByteArrayView data) const
+    { return indexIn(data).isValid(); }
+
+private:
+    QList<QByteArray> q_patterns;
+    QtPrivate::QAhoCorasickAutomaton q_automaton;
+};
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    using Match = QMultiPatternMatch;
+
+    QMultiStringMatcher() = default;
+    explicit QMultiStringMatcher(const QStringList &patterns,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+
+    void setPatterns(const QStringList &patterns);
+    QStringList patterns() const { return q_patterns; }
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const { return q_cs; }
+
+    Match indexIn(QStringView str, qsizetype from = 0) const;
+    QList<Match> findAll(QStringView str, qsizetype from = 0) const;
+    bool containsAny(QStringView str) const
+    { return indexIn(str).isValid(); }
+
+private:
+    void rebuild();
+
+    QStringList q_patterns;
+    Qt::CaseSensitivity q_cs = Qt::CaseSensitive;
+    QtPrivate::QAhoCorasickAutomaton q_automaton;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMULTIPATTERNMATCHER_P_H
@@ -40,7 +40,9 @@
 ****************************************************************************/
 
 #include "qregularexpression.h"
+#include "qregularexpressionset_p.h"
 
+#include <QtCore/qbitarray.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -51,6 +53,8 @@
 #include <QtCore/qatomic.h>
 #include <QtCore/qdatastream.h>
 
+#include <QtCore/private/qconcurrentcache_p.h>
+
 #if defined(Q_OS_MACOS)
 #include <QtCore/private/qcore_mac_p.h>
 #endif
@@ -734,6 +738,28 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    A compiled (and possibly JIT-compiled) PCRE2 pattern. PCRE2 allows the
+    same compiled pattern to be matched from several threads at once, so it
+    is never modified after construction and is shared by all the objects
+    using the same pattern with the same options; see compiledPatternFor().
+*/
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    QRegularExpressionCompiledPattern(const QString &pattern, int options);
+    ~QRegularExpressionCompiledPattern();
+    Q_DISABLE_COPY_MOVE(QRegularExpressionCompiledPattern)
+
+    void getPatternInfo(const QString &pattern);
+    void optimizePattern();
+
+    pcre2_code_16 *code = nullptr;
+    int errorCode = 0;
+    qsizetype errorOffset = -1;
+    int capturingCount = 0;
+    bool usingCrLfNewlines = false;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -742,8 +768,6 @@ struct QRegularExpressionPrivate : QSharedData
 
     void cleanCompiledPattern();
     void compilePattern();
-    void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -766,9 +790,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code pointer is owned by compiled, which may be shared with
+    // other QRegularExpressionPrivate objects using the same pattern and
+    // options; when the private is copied (i.e. a detach happened) both are
+    // set to nullptr
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> compiled;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -884,7 +910,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiled.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -892,6 +918,49 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
     usingCrLfNewlines = false;
 }
 
+namespace {
+struct CompiledPatternKey
+{
+    QString pattern;
+    int options;
+
+    friend bool operator==(const CompiledPatternKey &lhs, const CompiledPatternKey &rhs) noexcept
+    { return lhs.options == rhs.options && lhs.pattern == rhs.pattern; }
+    friend size_t qHash(const CompiledPatternKey &key, size_t seed = 0) noexcept
+    { return qHashMulti(seed, key.pattern, key.options); }
+};
+
+using CompiledPatternPointer = QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern>;
+using CompiledPatternCache = QConcurrentCache<CompiledPatternKey, CompiledPatternPointer>;
+} // unnamed namespace
+
+// Compiling, and especially JIT-compiling, a pattern costs far more than
+// most matches do, so the most recently used compiled patterns are kept
+// even when no QRegularExpression refers to them any more.
+Q_GLOBAL_STATIC(CompiledPatternCache, compiledPatternCache, 256)
+
+/*!
+    \internal
+
+    Returns the pattern \a pattern compiled with the PCRE2 \a options, from
+    the process-wide cache if it has been compiled before.
+*/
+static CompiledPatternPointer compiledPatternFor(const QString &pattern, int options)
+{
+    CompiledPatternPointer result;
+    if (CompiledPatternCache *cache = compiledPatternCache()) {
+        cache->visitOrInsert({ pattern, options },
+                             [&] {
+                                 auto compiled = new QRegularExpressionCompiledPattern(pattern, options);
+                                 return new CompiledPatternPointer(compiled);
+                             },
+                             [&](const CompiledPatternPointer &cached) { result = cached; });
+    }
+    if (!result) // the cache has already been destroyed
+        result.reset(new QRegularExpressionCompiledPattern(pattern, options));
+    return result;
+}
+
 /*!
     \internal
 */
@@ -908,15 +977,31 @@ void QRegularExpressionPrivate::compilePattern()
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
+    compiled = compiledPatternFor(pattern, options);
+    compiledPattern = compiled->code;
+    errorCode = compiled->errorCode;
+    errorOffset = compiled->errorOffset;
+    capturingCount = compiled->capturingCount;
+    usingCrLfNewlines = compiled->usingCrLfNewlines;
+}
+
+/*!
+    \internal
+
+    Compiles \a pattern with the PCRE2 \a options. If that fails, code is
+    left as nullptr and errorCode and errorOffset describe the error.
+*/
+QRegularExpressionCompiledPattern::QRegularExpressionCompiledPattern(const QString &pattern, int options)
+{
     PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
-                                       pattern.length(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       nullptr);
-
-    if (!compiledPattern) {
+    code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
+                            pattern.length(),
+                            options,
+                            &errorCode,
+                            &patternErrorOffset,
+                            nullptr);
+
+    if (!code) {
         errorOffset = qsizetype(patternErrorOffset);
         return;
     } else {
@@ -925,21 +1010,29 @@ void QRegularExpressionPrivate::compilePattern()
     }
 
     optimizePattern();
-    getPatternInfo();
+    getPatternInfo(pattern);
+}
+
+/*!
+    \internal
+*/
+QRegularExpressionCompiledPattern::~QRegularExpressionCompiledPattern()
+{
+    pcre2_code_free_16(code);
 }
 
 /*!
     \internal
 */
-void QRegularExpressionPrivate::getPatternInfo()
+void QRegularExpressionCompiledPattern::getPatternInfo(const QString &pattern)
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
+    pcre2_pattern_info_16(code, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
 
     // detect the settings for the newline
     unsigned int patternNewlineSetting;
-    if (pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
+    if (pcre2_pattern_info_16(code, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
         // no option was specified in the regexp, grab PCRE build defaults
         pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
     }
@@ -949,7 +1042,7 @@ void QRegularExpressionPrivate::getPatternInfo()
             (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
 
     unsigned int hasJOptionChanged;
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
+    pcre2_pattern_info_16(code, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
     if (Q_UNLIKELY(hasJOptionChanged)) {
         qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
                  qUtf16Printable(pattern));
@@ -1008,19 +1101,19 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called when a pattern is compiled by us, before the compiled
+    pattern is shared with anyone.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionCompiledPattern::optimizePattern()
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
 }
 
 /*!
@@ -2862,6 +2955,307 @@ QDebug operator<<(QDebug debug, const QRegularExpressionMatch &match)
 }
 #endif
 
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \internal
+
+    \brief The QRegularExpressionSet class matches a subject string against
+    many regular expressions in a single scan.
+
+    \sa QRegularExpression
+*/
+
+struct QRegularExpressionSetPrivate : QSharedData
+{
+    QStringList patterns;
+    QRegularExpression::PatternOptions patternOptions;
+    // one for each pattern, also for error reporting
+    QList<CompiledPatternPointer> compiled;
+    // the patterns that are matched on their own
+    QList<qsizetype> separate;
+    // all the other valid patterns, and them joined; null if there are none
+    QList<qsizetype> combinedIndexes;
+    CompiledPatternPointer combined;
+    bool isValid = true;
+};
+
+/*!
+    \internal
+
+    Returns whether \a pattern keeps its meaning as one alternative of a
+    larger pattern. This errs on the side of matching patterns on their own.
+*/
+static bool canBeCombined(QStringView pattern, QRegularExpression::PatternOptions options,
+                          const pcre2_code_16 *code)
+{
+    // back references would refer to other patterns' groups
+    uint32_t backReferenceMax = 0;
+    pcre2_pattern_info_16(code, PCRE2_INFO_BACKREFMAX, &backReferenceMax);
+    if (backReferenceMax)
+        return false;
+
+    // verbs and start-of-pattern options, callouts, recursion, subroutine
+    // calls and conditions, which can refer to the whole pattern or to
+    // groups by number, and \Q, which quotes up to the end of the pattern
+    static const char16_t *const unsafe[] = {
+        u"(*", u"(?C", u"(?R", u"(?&", u"(?P>", u"(?(", u"(?+", u"(?-", u"\\g", u"\\Q",
+    };
+    for (const char16_t *s : unsafe) {
+        if (pattern.contains(QStringView(s)))
+            return false;
+    }
+    for (qsizetype i = pattern.indexOf(u"(?"); i >= 0; i = pattern.indexOf(u"(?", i + 1)) {
+        if (i + 2 < pattern.size() && pattern.at(i + 2).isDigit())
+            return false;
+    }
+
+    // in extended syntax, a trailing comment would swallow what follows
+    const bool mayBeExtended = (options & QRegularExpression::ExtendedPatternSyntaxOption)
+            || pattern.contains(u"(?");
+    return !(mayBeExtended && pattern.contains(u'#'));
+}
+
+/*!
+    Constructs an empty set, which matches nothing.
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate)
+{
+}
+
+/*!
+    Constructs a set of the regular expressions \a patterns, all compiled
+    with the pattern options \a options.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QStringList &patterns,
+                                             QRegularExpression::PatternOptions options)
+{
+    setPatterns(patterns, options);
+}
+
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other) = default;
+QRegularExpressionSet::QRegularExpressionSet(QRegularExpressionSet &&other) noexcept = default;
+QRegularExpressionSet::~QRegularExpressionSet() = default;
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other) = default;
+QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other) noexcept = default;
+
+/*!
+    Replaces the regular expressions of this set with \a patterns, all
+    compiled with the pattern options \a options.
+*/
+void QRegularExpressionSet::setPatterns(const QStringList &patterns,
+                                        QRegularExpression::PatternOptions options)
+{
+    auto dd = new QRegularExpressionSetPrivate;
+    d.reset(dd);
+    dd->patterns = patterns;
+    dd->patternOptions = options;
+
+    const int pcreOptions = convertToPcreOptions(options) | PCRE2_UTF;
+    QString combined;
+    QList<qsizetype> combinedIndexes;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QString &pattern = patterns.at(i);
+        CompiledPatternPointer compiled = compiledPatternFor(pattern, pcreOptions);
+        dd->compiled.append(compiled);
+        if (!compiled->code) {
+            dd->isValid = false;
+        } else if (!canBeCombined(pattern, options, compiled->code)) {
+            dd->separate.append(i);
+        } else {
+            const QString index = QString::number(i);
+            if (!combined.isEmpty())
+                combined += u'|';
+            combined += QLatin1String("(?C{s") + index + QLatin1String("})(?:") + pattern
+                    + QLatin1String(")(?C{e") + index + QLatin1String("})");
+            combinedIndexes.append(i);
+        }
+    }
+    if (combinedIndexes.isEmpty())
+        return;
+
+    // The groups of the patterns are of no interest, so don't capture, and
+    // allow names to be reused. Auto-possessification could make PCRE2 skip
+    // callouts.
+    combined = QLatin1String("(?:") + combined + QLatin1String(")(*FAIL)");
+    dd->combined = compiledPatternFor(combined, pcreOptions | PCRE2_NO_AUTO_CAPTURE
+                                                | PCRE2_DUPNAMES | PCRE2_NO_AUTO_POSSESS);
+    if (dd->combined->code) {
+        dd->combinedIndexes = combinedIndexes;
+    } else {
+        // e.g. too large as a whole
+        dd->combined.reset();
+        dd->separate += combinedIndexes;
+        std::sort(dd->separate.begin(), dd->separate.end());
+    }
+}
+
+/*!
+    Returns the regular expressions of this set.
+*/
+QStringList QRegularExpressionSet::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Returns the pattern options the regular expressions of this set are
+    compiled with.
+*/
+QRegularExpression::PatternOptions QRegularExpressionSet::patternOptions() const
+{
+    return d->patternOptions;
+}
+
+/*!
+    Returns the number of regular expressions in this set.
+*/
+qsizetype QRegularExpressionSet::size() const
+{
+    return d->patterns.size();
+}
+
+/*!
+    Returns \c true if all the regular expressions of this set are valid.
+    Use regularExpression() to find out what is wrong with the others.
+*/
+bool QRegularExpressionSet::isValid() const
+{
+    return d->isValid;
+}
+
+/*!
+    Returns the regular expression at index \a i of this set.
+*/
+QRegularExpression QRegularExpressionSet::regularExpression(qsizetype i) const
+{
+    return QRegularExpression(d->patterns.at(i), d->patternOptions);
+}
+
+/*!
+    Returns the indexes of the regular expressions in this set that match
+    somewhere in \a subject with the match options \a matchOptions, in
+    ascending order.
+*/
+QList<qsizetype> QRegularExpressionSet::matchingPatterns(QStringView subject,
+                                                         QRegularExpression::MatchOptions matchOptions) const
+{
+    return match(subject, matchOptions, false);
+}
+
+/*!
+    Returns \c true if any of the regular expressions in this set matches
+    somewhere in \a subject with the match options \a matchOptions. This
+    stops scanning at the first match.
+*/
+bool QRegularExpressionSet::matchesAny(QStringView subject,
+                                       QRegularExpression::MatchOptions matchOptions) const
+{
+    return !match(subject, matchOptions, true).isEmpty();
+}
+
+namespace {
+struct SetMatchState
+{
+    QBitArray matched;
+    qsizetype remaining;
+    bool stopAtFirstMatch;
+};
+} // unnamed namespace
+
+/*!
+    \internal
+
+    The callouts of QRegularExpressionSet's combined pattern; their strings
+    are "s" or "e", for the start or end of a pattern, and its index.
+*/
+static int setMatchCallout(pcre2_callout_block_16 *block, void *data)
+{
+    auto state = static_cast<SetMatchState *>(data);
+    if (!block->callout_string || block->callout_string_length < 2)
+        return 0;
+    const QStringView callout(reinterpret_cast<const char16_t *>(block->callout_string),
+                              qsizetype(block->callout_string_length));
+    const qsizetype index = callout.sliced(1).toLongLong();
+
+    if (callout.front() == u's') // don't try a pattern that already matched again
+        return state->matched.testBit(index) ? 1 : 0;
+
+    if (!state->matched.testBit(index)) {
+        state->matched.setBit(index);
+        --state->remaining;
+    }
+    // either abort the match, as there is nothing left to find, or fail to
+    // go on with the other alternatives
+    return state->remaining == 0 || state->stopAtFirstMatch ? PCRE2_ERROR_CALLOUT : 1;
+}
+
+/*!
+    \internal
+*/
+QList<qsizetype> QRegularExpressionSet::match(QStringView subject,
+                                              QRegularExpression::MatchOptions matchOptions,
+                                              bool stopAtFirstMatch) const
+{
+    SetMatchState state{ QBitArray(d->patterns.size()), d->combinedIndexes.size(), stopAtFirstMatch };
+    int pcreOptions = convertToPcreOptions(matchOptions);
+
+    // see QRegularExpressionPrivate::doMatch()
+    const char16_t dummySubject = 0;
+    const auto subjectUtf16 = reinterpret_cast<PCRE2_SPTR16>(subject.utf16() ? subject.utf16()
+                                                                             : &dummySubject);
+
+    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
+    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
+    pcre2_match_data_16 *matchData = pcre2_match_data_create_16(1, nullptr);
+
+    // only the first match needs to check that the subject is valid UTF-16
+    bool validSubject = true;
+    auto run = [&](const pcre2_code_16 *code) {
+        const int result = safe_pcre2_match_16(code, subjectUtf16, subject.size(), 0,
+                                               pcreOptions, matchData, matchContext);
+        if (result <= PCRE2_ERROR_UTF16_ERR1 && result >= PCRE2_ERROR_UTF16_ERR3)
+            validSubject = false;
+        pcreOptions |= PCRE2_NO_UTF_CHECK;
+        return result;
+    };
+    bool found = false;
+    auto runSeparately = [&](const QList<qsizetype> &indexes) {
+        for (qsizetype i : indexes) {
+            if (!validSubject || (found && stopAtFirstMatch))
+                return;
+            if (run(d->compiled.at(i)->code) >= 0) {
+                state.matched.setBit(i);
+                found = true;
+            }
+        }
+    };
+
+    bool combinedFailed = false;
+    if (d->combined) {
+        pcre2_set_callout_16(matchContext, &setMatchCallout, &state);
+        const int result = run(d->combined->code);
+        pcre2_set_callout_16(matchContext, nullptr, nullptr);
+        found = state.remaining < d->combinedIndexes.size();
+        // e.g. the match limit was hit; the patterns on their own may not
+        combinedFailed = result != PCRE2_ERROR_NOMATCH && result != PCRE2_ERROR_CALLOUT;
+    }
+    runSeparately(d->separate);
+    if (combinedFailed)
+        runSeparately(d->combinedIndexes);
+
+    pcre2_match_data_free_16(matchData);
+    pcre2_match_context_free_16(matchContext);
+
+    QList<qsizetype> result;
+    if (validSubject) {
+        for (qsizetype i = state.matched.findFirstSet(); i >= 0; i = state.matched.findNextSet(i + 1))
+            result.append(i);
+    }
+    return result;
+}
+
 // fool lupdate: make it extract those strings for translation, but don't put them
 // inside Qt -- they're already inside libpcre (cf. man 3 pcreapi, pcre_compile.c).
 #if 0
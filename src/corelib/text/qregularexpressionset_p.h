@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QREGULAREXPRESSIONSET_P_H
+#define QREGULAREXPRESSIONSET_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qregularexpression.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringlist.h>
+
+QT_REQUIRE_CONFIG(regularexpression);
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QRegularExpressionSet tells which of a list of patterns match somewhere in
+  a subject string, scanning the subject once for all of them.
+
+  The patterns are joined into a single PCRE2 pattern, each one an
+  alternative that ends in a callout recording which pattern matched. The
+  alternation is followed by (*FAIL), so that PCRE2 keeps backtracking into
+  the other alternatives and start positions instead of stopping at the
+  first match. Another callout at the start of each alternative skips the
+  patterns that have already matched.
+
+  Patterns that would change meaning when embedded into that alternation,
+  because they refer to groups by number, recurse, use backtracking control
+  verbs or callouts, or could swallow the text that follows them, are
+  matched on their own instead. Invalid patterns never match.
+
+  Like QRegularExpression, a set can be used from several threads at once.
+*/
+
+struct QRegularExpressionSetPrivate;
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QStringList &patterns,
+                                   QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+    QRegularExpressionSet(const QRegularExpressionSet &other);
+    QRegularExpressionSet(QRegularExpressionSet &&other) noexcept;
+    ~QRegularExpressionSet();
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other);
+    QRegularExpressionSet &operator=(QRegularExpressionSet &&other) noexcept;
+
+    void setPatterns(const QStringList &patterns,
+                     QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption);
+    QStringList patterns() const;
+    QRegularExpression::PatternOptions patternOptions() const;
+    qsizetype size() const;
+
+    bool isValid() const;
+    QRegularExpression regularExpression(qsizetype i) const;
+
+    QList<qsizetype> matchingPatterns(QStringView subject,
+                                      QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+    bool matchesAny(QStringView subject,
+                    QRegularExpression::MatchOptions matchOptions = QRegularExpression::NoMatchOption) const;
+
+private:
+    QList<qsizetype> match(QStringView subject, QRegularExpression::MatchOptions matchOptions,
+                           bool stopAtFirstMatch) const;
+
+    QExplicitlySharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QREGULAREXPRESSIONSET_P_H
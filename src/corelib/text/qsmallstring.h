@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+#include <new>
+#include <string.h>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// Holds either a String or, for payloads of up to InlineCapacity code units,
+// the characters themselves. The first word tells the two apart: a String
+// starts with its (aligned, possibly null) QArrayData pointer, while the
+// inline form stores (size << 1) | 1 there, followed by the characters and
+// a terminating null.
+template <typename String, typename View>
+class QSmallStringStorage
+{
+public:
+    using storage_type = typename View::storage_type;
+    static constexpr qsizetype InlineCapacity =
+            qsizetype((sizeof(String) - sizeof(quintptr)) / sizeof(storage_type)) - 1;
+
+    QSmallStringStorage() noexcept { setInline(nullptr, 0); }
+    QSmallStringStorage(View view) { assign(view); }
+    QSmallStringStorage(const String &string)
+    {
+        if (string.size() <= InlineCapacity)
+            setInline(reinterpret_cast<const storage_type *>(string.constData()), string.size());
+        else
+            new (&heap) String(string);
+    }
+    QSmallStringStorage(const QSmallStringStorage &other)
+    {
+        if (other.isInline())
+            memcpy(static_cast<void *>(this), static_cast<const void *>(&other), sizeof(*this));
+        else
+            new (&heap) String(other.heap);
+    }
+    QSmallStringStorage(QSmallStringStorage &&other) noexcept
+    {
+        // String is relocatable, so moving the bytes moves either form
+        memcpy(static_cast<void *>(this), static_cast<const void *>(&other), sizeof(*this));
+        other.setInline(nullptr, 0);
+    }
+    QSmallStringStorage &operator=(const QSmallStringStorage &other)
+    {
+        QSmallStringStorage copy(other);
+        swap(copy);
+        return *this;
+    }
+    QSmallStringStorage &operator=(QSmallStringStorage &&other) noexcept
+    {
+        QSmallStringStorage moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    ~QSmallStringStorage()
+    {
+        if (!isInline())
+            heap.~String();
+    }
+
+    void swap(QSmallStringStorage &other) noexcept
+    {
+        alignas(QSmallStringStorage) char tmp[sizeof(QSmallStringStorage)];
+        memcpy(tmp, static_cast<const void *>(this), sizeof(tmp));
+        memcpy(static_cast<void *>(this), static_cast<const void *>(&other), sizeof(tmp));
+        memcpy(static_cast<void *>(&other), tmp, sizeof(tmp));
+    }
+
+    bool isInline() const noexcept
+    {
+        quintptr word;
+        memcpy(&word, static_cast<const void *>(this), sizeof(word));
+        return word & 1;
+    }
+
+    qsizetype size() const noexcept
+    {
+        return isInline() ? qsizetype(small.tag >> 1) : heap.size();
+    }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    const storage_type *constData() const noexcept
+    {
+        return isInline() ? small.data : reinterpret_cast<const storage_type *>(heap.constData());
+    }
+
+    View view() const noexcept { return View(constData(), size()); }
+    operator View() const noexcept { return view(); }
+
+    void clear()
+    {
+        if (!isInline())
+            heap.~String();
+        setInline(nullptr, 0);
+    }
+
+    void append(View view)
+    {
+        if (!isInline()) {
+            heap.append(view);
+            return;
+        }
+        const qsizetype oldSize = size();
+        if (oldSize + view.size() <= InlineCapacity) {
+            // view may point into our own characters
+            memmove(small.data + oldSize, view.data(), size_t(view.size()) * sizeof(storage_type));
+            small.tag = (quintptr(oldSize + view.size()) << 1) | 1;
+            small.data[oldSize + view.size()] = storage_type(0);
+            return;
+        }
+        String grown = toOwned();
+        grown.append(view);
+        new (&heap) String(std::move(grown));
+    }
+
+    void assign(View view)
+    {
+        if (view.size() <= InlineCapacity) {
+            QSmallStringStorage copy;
+            copy.setInline(reinterpret_cast<const storage_type *>(view.data()), view.size());
+            swap(copy);
+        } else {
+            String string = toOwned(view);
+            clear();
+            new (&heap) String(std::move(string));
+        }
+    }
+
+protected:
+    static String toOwned(View view)
+    {
+        if constexpr (std::is_same_v<View, QByteArrayView>)
+            return view.toByteArray();
+        else
+            return view.toString();
+    }
+    String toOwned() const
+    {
+        return isInline() ? toOwned(view()) : heap;
+    }
+
+    friend bool operator==(const QSmallStringStorage &lhs, const QSmallStringStorage &rhs) noexcept
+    { return lhs.view() == rhs.view(); }
+    friend bool operator!=(const QSmallStringStorage &lhs, const QSmallStringStorage &rhs) noexcept
+    { return lhs.view() != rhs.view(); }
+    friend bool operator<(const QSmallStringStorage &lhs, const QSmallStringStorage &rhs) noexcept
+    { return lhs.view() < rhs.view(); }
+    friend size_t qHash(const QSmallStringStorage &key, size_t seed = 0) noexcept
+    { return qHash(key.view(), seed); }
+
+private:
+    void setInline(const storage_type *data, qsizetype size) noexcept
+    {
+        Q_ASSERT(size >= 0 && size <= InlineCapacity);
+        small.tag = (quintptr(size) << 1) | 1;
+        if (size)
+            memcpy(small.data, data, size_t(size) * sizeof(storage_type));
+        small.data[size] = storage_type(0);
+    }
+
+    struct Inline
+    {
+        quintptr tag;
+        storage_type data[InlineCapacity + 1];
+    };
+
+    union {
+        String heap;
+        Inline small;
+    };
+
+    static_assert(sizeof(Inline) == sizeof(String));
+    static_assert(alignof(QArrayData) > 1);
+};
+
+} // namespace QtPrivate
+
+class QSmallByteArray : public QtPrivate::QSmallStringStorage<QByteArray, QByteArrayView>
+{
+public:
+    using QSmallStringStorage::QSmallStringStorage;
+    QSmallByteArray(const char *string) : QSmallStringStorage(QByteArrayView(string)) {}
+
+    QByteArray toByteArray() const { return toOwned(); }
+};
+Q_DECLARE_SHARED(QSmallByteArray)
+
+class QSmallString : public QtPrivate::QSmallStringStorage<QString, QStringView>
+{
+public:
+    using QSmallStringStorage::QSmallStringStorage;
+    QSmallString(QLatin1String string)
+    {
+        if (string.size() > InlineCapacity) {
+            assign(QString(string));
+            return;
+        }
+        char16_t buffer[InlineCapacity];
+        for (qsizetype i = 0; i < string.size(); ++i)
+            buffer[i] = uchar(string.data()[i]);
+        assign(QStringView(buffer, string.size()));
+    }
+
+    QString toString() const { return toOwned(); }
+};
+Q_DECLARE_SHARED(QSmallString)
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
@@ -8530,9 +8530,10 @@ static int getEscape(const Char *uc, qsizetype *pos, qsizetype len, int maxNumbe
     Algorithm for multiArg:
 
     1. Parse the string as a sequence of verbatim text and placeholders (%L?\d{,3}).
-       The L is parsed and accepted for compatibility with non-multi-arg, but since
-       multiArg only accepts strings as replacements, the localization request can
-       be safely ignored.
+       The L is parsed and accepted for compatibility with non-multi-arg. It is
+       ignored for string replacements; numbers passed through qFormat() are
+       formatted with the default QLocale if it is present and with the C locale
+       otherwise.
     2. The result of step (1) is a list of (string-ref,int)-tuples. The string-ref
        either points at text to be copied verbatim (in which case the int is -1),
        or, initially, at the textual representation of the placeholder. In that case,
@@ -8636,7 +8637,49 @@ static ArgIndexToPlaceholderMap makeArgIndexToPlaceholderMap(const ParseResult &
     return result;
 }
 
-static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const ArgIndexToPlaceholderMap &argIndexToPlaceholderMap, const QtPrivate::ArgBase *args[])
+// Storage for the textual form of numeric replacements. Integers formatted
+// with the C locale are written into a fixed slot per argument, so that the
+// common case needs no allocation besides the result; anything else is kept
+// in a QString that lives until the result has been assembled.
+struct NumberStorage
+{
+    enum { SlotSize = 24 }; // enough for a 64-bit integer with sign
+
+    explicit NumberStorage(size_t numArgs) : digits(qsizetype(numArgs) * SlotSize) {}
+
+    QLatin1String integer(size_t index, qulonglong value, bool negative)
+    {
+        char *const end = digits.data() + (qsizetype(index) + 1) * SlotSize;
+        char *p = end;
+        do {
+            *--p = char('0' + value % 10);
+            value /= 10;
+        } while (value);
+        if (negative)
+            *--p = '-';
+        return QLatin1String(p, end);
+    }
+
+    QStringView keep(QString &&string)
+    {
+        strings.push_back(std::move(string));
+        return strings.back();
+    }
+
+    QVarLengthArray<char, 8 * SlotSize> digits;
+    QVarLengthArray<QString, 4> strings;
+};
+
+static bool isLocalizedPlaceholder(const Part &part)
+{
+    // part still refers to the placeholder text, "%L..." or "%..."
+    Q_ASSERT(part.size >= 2);
+    if (part.tag == QtPrivate::ArgBase::L1)
+        return static_cast<const char *>(part.data)[1] == 'L';
+    return static_cast<const char16_t *>(part.data)[1] == u'L';
+}
+
+static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const ArgIndexToPlaceholderMap &argIndexToPlaceholderMap, const QtPrivate::ArgBase *args[], NumberStorage &numbers)
 {
     using namespace QtPrivate;
     qsizetype totalSize = 0;
@@ -8644,7 +8687,8 @@ static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const A
         if (part.number != -1) {
             const auto it = std::find(argIndexToPlaceholderMap.begin(), argIndexToPlaceholderMap.end(), part.number);
             if (it != argIndexToPlaceholderMap.end()) {
-                const auto &arg = *args[it - argIndexToPlaceholderMap.begin()];
+                const size_t index = size_t(it - argIndexToPlaceholderMap.begin());
+                const auto &arg = *args[index];
                 switch (arg.tag) {
                 case ArgBase::L1:
                     part.reset(static_cast<const QLatin1StringArg&>(arg).string);
@@ -8655,6 +8699,28 @@ static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const A
                 case ArgBase::U16:
                     part.reset(static_cast<const QStringViewArg&>(arg).string);
                     break;
+                case ArgBase::Integer: {
+                    const qlonglong value = static_cast<const IntegerArg &>(arg).value;
+                    if (isLocalizedPlaceholder(part))
+                        part.reset(numbers.keep(QLocale().toString(value)));
+                    else
+                        part.reset(numbers.integer(index, value < 0 ? 0 - qulonglong(value) : qulonglong(value), value < 0));
+                    break;
+                }
+                case ArgBase::UnsignedInteger: {
+                    const qulonglong value = static_cast<const UnsignedIntegerArg &>(arg).value;
+                    if (isLocalizedPlaceholder(part))
+                        part.reset(numbers.keep(QLocale().toString(value)));
+                    else
+                        part.reset(numbers.integer(index, value, false));
+                    break;
+                }
+                case ArgBase::Double: {
+                    const double value = static_cast<const DoubleArg &>(arg).value;
+                    const QLocale locale = isLocalizedPlaceholder(part) ? QLocale() : QLocale::c();
+                    part.reset(numbers.keep(locale.toString(value)));
+                    break;
+                }
                 }
             }
         }
@@ -8684,7 +8750,8 @@ static QString argToQStringImpl(StringView pattern, size_t numArgs, const QtPriv
                  int(numArgs - argIndexToPlaceholderMap.size()), qUtf16Printable(to_string(pattern)));
 
     // 5
-    const qsizetype totalSize = resolveStringRefsAndReturnTotalSize(parts, argIndexToPlaceholderMap, args);
+    NumberStorage numbers(numArgs);
+    const qsizetype totalSize = resolveStringRefsAndReturnTotalSize(parts, argIndexToPlaceholderMap, args, numbers);
 
     // 6:
     QString result(totalSize, Qt::Uninitialized);
@@ -8705,6 +8772,11 @@ static QString argToQStringImpl(StringView pattern, size_t numArgs, const QtPriv
             if (part.size)
                 memcpy(out, part.data, part.size * sizeof(QChar));
             break;
+        case QtPrivate::ArgBase::Integer:
+        case QtPrivate::ArgBase::UnsignedInteger:
+        case QtPrivate::ArgBase::Double:
+            Q_UNREACHABLE(); // resolved to text in step 5
+            break;
         }
         out += part.size;
     }
@@ -8722,6 +8794,40 @@ QString QtPrivate::argToQString(QLatin1String pattern, size_t n, const ArgBase *
     return argToQStringImpl(pattern, n, args);
 }
 
+/*!
+    \fn template <typename...Args> QString qFormat(QtPrivate::QFormatPattern<sizeof...(Args)> pattern, const Args &...args)
+    \relates QString
+    \since 6.4
+
+    Returns a copy of \a pattern with its \c{%N} placeholders replaced by
+    \a args, in the same way as the multi-argument QString::arg(): the first
+    of the \a args replaces every \c{%N} with the lowest \c{N}, the second
+    the next-lowest \c{N}, and so on.
+
+    Unlike chained calls to QString::arg(), the pattern is parsed once, the
+    size of the result is computed up front and the result is written into a
+    single allocation.
+
+    \a pattern can be a QString, QStringView, QLatin1String or a \c{u""}
+    string literal. \a args can be anything accepted by the multi-argument
+    QString::arg(), as well as integer and floating-point numbers. Numbers
+    are formatted like QString::arg() does with default arguments: with the
+    C locale for \c{%N}, and with the default QLocale for \c{%LN}.
+    Integers formatted with the C locale need no temporary allocation.
+
+    \code
+    QString message = qFormat(u"%1 of %2 files copied (%L3 bytes)", done, total, bytes);
+    \endcode
+
+    When compiling in C++20 mode, the number of distinct placeholders in a
+    \c{u""} literal pattern is checked against the number of \a args at
+    compile time, and a mismatch makes the call ill-formed. Other patterns
+    are checked at runtime, with a warning for arguments that have no
+    placeholder.
+
+    \sa QString::arg()
+*/
+
 /*! \fn bool QString::isSimpleText() const
 
     \internal
@@ -1511,7 +1511,7 @@ inline QString &&asString(QString &&s)              { return std::move(s); }
 namespace QtPrivate {
 
 struct ArgBase {
-    enum Tag : uchar { L1, U8, U16 } tag;
+    enum Tag : uchar { L1, U8, U16, Integer, UnsignedInteger, Double } tag;
 };
 
 struct QStringViewArg : ArgBase {
@@ -1526,6 +1526,21 @@ struct QLatin1StringArg : ArgBase {
     constexpr explicit QLatin1StringArg(QLatin1String v) noexcept : ArgBase{L1}, string{v} {}
 };
 
+struct IntegerArg : ArgBase {
+    qlonglong value;
+    constexpr explicit IntegerArg(qlonglong v) noexcept : ArgBase{Integer}, value{v} {}
+};
+
+struct UnsignedIntegerArg : ArgBase {
+    qulonglong value;
+    constexpr explicit UnsignedIntegerArg(qulonglong v) noexcept : ArgBase{UnsignedInteger}, value{v} {}
+};
+
+struct DoubleArg : ArgBase {
+    double value;
+    constexpr explicit DoubleArg(double v) noexcept : ArgBase{Double}, value{v} {}
+};
+
 [[nodiscard]] Q_CORE_EXPORT QString argToQString(QStringView pattern, size_t n, const ArgBase **args);
 [[nodiscard]] Q_CORE_EXPORT QString argToQString(QLatin1String pattern, size_t n, const ArgBase **args);
 
@@ -1541,8 +1556,109 @@ constexpr inline QStringViewArg   qStringLikeToArg(QStringView s) noexcept { ret
           inline QStringViewArg   qStringLikeToArg(const QChar &c) noexcept { return QStringViewArg{QStringView{&c, 1}}; }
 constexpr inline QLatin1StringArg qStringLikeToArg(QLatin1String s) noexcept { return QLatin1StringArg{s}; }
 
+template <typename T>
+using is_format_number = std::integral_constant<bool,
+        std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>
+        && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>
+        && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>
+        && !std::is_same_v<T, wchar_t>>;
+
+template <typename T, std::enable_if_t<is_format_number<T>::value, bool> = true>
+constexpr inline auto qFormatToArg(T value) noexcept
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return DoubleArg{double(value)};
+    else if constexpr (std::is_signed_v<T>)
+        return IntegerArg{qlonglong(value)};
+    else
+        return UnsignedIntegerArg{qulonglong(value)};
+}
+
+// no temporaries allowed here, the arg must refer to the caller's object
+template <typename T, std::enable_if_t<!std::is_arithmetic_v<T>, bool> = true>
+inline auto qFormatToArg(const T &s) noexcept -> decltype(qStringLikeToArg(s))
+{ return qStringLikeToArg(s); }
+
+void formatPatternArgumentCountMismatch(); // not constexpr, so calling it breaks compilation
+
+template <typename Char>
+constexpr qsizetype countFormatPlaceholders(const Char *pattern, qsizetype len)
+{
+    // same grammar as argToQString(): %L?[0-9]+, numbers up to 999
+    bool seen[1000] = {};
+    qsizetype count = 0;
+    qsizetype i = 0;
+    while (i < len - 1) {
+        if (pattern[i] == Char('%')) {
+            qsizetype j = i + 1;
+            if (pattern[j] == Char('L'))
+                ++j;
+            int number = 0;
+            qsizetype digits = 0;
+            while (j < len && pattern[j] >= Char('0') && pattern[j] <= Char('9')) {
+                number = number * 10 + int(pattern[j] - Char('0'));
+                if (number > 999)
+                    break;
+                ++j;
+                ++digits;
+            }
+            if (digits && number <= 999) {
+                if (!seen[number]) {
+                    seen[number] = true;
+                    ++count;
+                }
+                i = j;
+                continue;
+            }
+        }
+        ++i;
+    }
+    return count;
+}
+
+template <size_t ArgCount>
+class QFormatPattern
+{
+public:
+    template <size_t Size>
+#ifdef __cpp_consteval
+    consteval
+#else
+    constexpr
+#endif
+    QFormatPattern(const char16_t (&pattern)[Size])
+        : m_utf16(pattern, qsizetype(Size) - 1)
+    {
+#ifdef __cpp_consteval
+        if (countFormatPlaceholders(pattern, qsizetype(Size) - 1) != qsizetype(ArgCount))
+            formatPatternArgumentCountMismatch();
+#endif
+    }
+    constexpr QFormatPattern(QStringView pattern) noexcept : m_utf16(pattern) {}
+    constexpr QFormatPattern(QLatin1String pattern) noexcept
+        : m_latin1(pattern), m_isLatin1(true) {}
+    QFormatPattern(const QString &pattern) noexcept : m_utf16(qToStringViewIgnoringNull(pattern)) {}
+
+    constexpr bool isLatin1() const noexcept { return m_isLatin1; }
+    constexpr QStringView utf16() const noexcept { return m_utf16; }
+    constexpr QLatin1String latin1() const noexcept { return m_latin1; }
+
+private:
+    QStringView m_utf16;
+    QLatin1String m_latin1;
+    bool m_isLatin1 = false;
+};
+
 } // namespace QtPrivate
 
+template <typename...Args>
+[[nodiscard]] inline QString qFormat(QtPrivate::QFormatPattern<sizeof...(Args)> pattern, const Args &...args)
+{
+    if (pattern.isLatin1())
+        return QtPrivate::argToQStringDispatch(pattern.latin1(), QtPrivate::qFormatToArg(args)...);
+    return QtPrivate::argToQStringDispatch(pattern.utf16(), QtPrivate::qFormatToArg(args)...);
+}
+
 template <typename...Args>
 Q_ALWAYS_INLINE
 QString QStringView::arg(Args &&...args) const
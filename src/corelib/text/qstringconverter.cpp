@@ -360,6 +360,128 @@ static void simdCompareAscii(const char8_t *&src8, const char8_t *end8, const ch
     src8 += offset;
     src16 += offset;
 }
+// Decodes blocks of sixteen bytes made of complete one-, two- and three-byte
+// sequences, stopping at the first block that contains anything else (four-byte
+// sequences, invalid or overlong ones), which is left to the scalar decoder.
+// Returns true if anything was decoded.
+static inline bool simdDecodeUtf8(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    const uchar *const start = src;
+    const __m128i zero = _mm_setzero_si128();
+    while (end - src >= 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+        // classify the bytes by comparing them as signed values: ASCII is
+        // positive, continuation bytes are 0x80 to 0xbf, leading bytes of
+        // two-byte sequences 0xc2 to 0xdf and of three-byte sequences 0xe0 to 0xef
+        const uint ascii = ~_mm_movemask_epi8(data) & 0xffff;
+        const uint cont = _mm_movemask_epi8(_mm_cmplt_epi8(data, _mm_set1_epi8(-64)));
+        const uint lead2 = _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(data, _mm_set1_epi8(-63)),
+                                                           _mm_cmplt_epi8(data, _mm_set1_epi8(-32))));
+        const uint lead3 = _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(data, _mm_set1_epi8(-33)),
+                                                           _mm_cmplt_epi8(data, _mm_set1_epi8(-16))));
+
+        // a sequence that doesn't end in this block is left for the next one
+        const uint incomplete = (lead2 & 0x8000) | (lead3 & 0xc000);
+        const uint len = incomplete ? qCountTrailingZeroBits(incomplete) : 16;
+        const uint mask = (1U << len) - 1;
+
+        // every leading byte must be followed by the right number of
+        // continuation bytes, and there must be no other continuation bytes
+        if (((ascii | cont | lead2 | lead3) & mask) != mask)
+            break;
+        if ((cont & mask) != (((lead2 << 1) | (lead3 << 1) | (lead3 << 2)) & mask))
+            break;
+
+        // compute the character that each byte would end, in 16-bit lanes
+        const __m128i prev1 = _mm_slli_si128(data, 1);
+        const __m128i prev2 = _mm_slli_si128(data, 2);
+        alignas(16) char16_t values[16];
+        __m128i invalid = zero;
+        for (int half = 0; half < 2; ++half) {
+            const __m128i c = half ? _mm_unpackhi_epi8(data, zero) : _mm_unpacklo_epi8(data, zero);
+            const __m128i p1 = half ? _mm_unpackhi_epi8(prev1, zero) : _mm_unpacklo_epi8(prev1, zero);
+            const __m128i p2 = half ? _mm_unpackhi_epi8(prev2, zero) : _mm_unpacklo_epi8(prev2, zero);
+
+            const __m128i low6 = _mm_and_si128(c, _mm_set1_epi16(0x3f));
+            const __m128i v2 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(p1, _mm_set1_epi16(0x1f)), 6), low6);
+            const __m128i v3 = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(p2, 12),
+                                                         _mm_slli_epi16(_mm_and_si128(p1, _mm_set1_epi16(0x3f)), 6)),
+                                            low6);
+            const __m128i is2 = _mm_cmpeq_epi16(_mm_and_si128(p1, _mm_set1_epi16(0xe0)), _mm_set1_epi16(0xc0));
+            const __m128i is3 = _mm_cmpeq_epi16(_mm_and_si128(p2, _mm_set1_epi16(0xf0)), _mm_set1_epi16(0xe0));
+
+            // three-byte sequences must not be overlong or encode surrogates
+            const __m128i top5 = _mm_and_si128(v3, _mm_set1_epi16(short(0xf800)));
+            const __m128i bad = _mm_or_si128(_mm_cmpeq_epi16(top5, zero),
+                                             _mm_cmpeq_epi16(top5, _mm_set1_epi16(short(0xd800))));
+            invalid = half ? _mm_packs_epi16(invalid, _mm_and_si128(is3, bad)) : _mm_and_si128(is3, bad);
+
+            __m128i value = _mm_or_si128(_mm_and_si128(is2, v2), _mm_andnot_si128(is2, c));
+            value = _mm_or_si128(_mm_and_si128(is3, v3), _mm_andnot_si128(is3, value));
+            _mm_store_si128(reinterpret_cast<__m128i *>(values) + half, value);
+        }
+
+        uint ends = (ascii | (lead2 << 1) | (lead3 << 2)) & mask;
+        if (_mm_movemask_epi8(invalid) & ends)
+            break;
+
+        // store the characters, skipping the bytes that don't end one
+        for ( ; ends; ends &= ends - 1)
+            *dst++ = values[qCountTrailingZeroBits(ends)];
+        src += len;
+    }
+    return src != start;
+}
+
+// Encodes blocks of eight UTF-16 code units that contain no surrogates,
+// stopping at the first block that does. Each character is stored with a
+// four-byte write, so this function never encodes the last code unit: the
+// output buffer is only guaranteed to have three bytes per code unit.
+// Returns true if anything was encoded.
+static inline bool simdEncodeUtf8(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    const char16_t *const start = src;
+    for ( ; end - src > 8; src += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))),
+                                                   _mm_set1_epi16(short(0xd800)));
+        if (_mm_movemask_epi8(surrogates))
+            break;
+
+        // unsigned comparisons, by flipping the sign bit
+        const __m128i flipped = _mm_xor_si128(data, _mm_set1_epi16(short(0x8000)));
+        const __m128i isAscii = _mm_cmplt_epi16(flipped, _mm_set1_epi16(short(0x8080)));
+        const __m128i isTwo = _mm_cmplt_epi16(flipped, _mm_set1_epi16(short(0x8800)));
+
+        // the first byte
+        const __m128i lead2 = _mm_or_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0xc0));
+        const __m128i lead3 = _mm_or_si128(_mm_srli_epi16(data, 12), _mm_set1_epi16(0xe0));
+        __m128i byte1 = _mm_or_si128(_mm_and_si128(isTwo, lead2), _mm_andnot_si128(isTwo, lead3));
+        byte1 = _mm_or_si128(_mm_and_si128(isAscii, data), _mm_andnot_si128(isAscii, byte1));
+
+        // the continuation bytes
+        const __m128i low6 = _mm_or_si128(_mm_and_si128(data, _mm_set1_epi16(0x3f)), _mm_set1_epi16(0x80));
+        const __m128i mid6 = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0x3f)),
+                                          _mm_set1_epi16(0x80));
+        const __m128i byte2 = _mm_or_si128(_mm_and_si128(isTwo, low6), _mm_andnot_si128(isTwo, mid6));
+
+        // lay the bytes out in 32-bit words and compute their lengths
+        const __m128i bytes12 = _mm_or_si128(byte1, _mm_slli_epi16(byte2, 8));
+        alignas(16) quint32 words[8];
+        alignas(16) quint16 lengths[8];
+        _mm_store_si128(reinterpret_cast<__m128i *>(words), _mm_unpacklo_epi16(bytes12, low6));
+        _mm_store_si128(reinterpret_cast<__m128i *>(words) + 1, _mm_unpackhi_epi16(bytes12, low6));
+        _mm_store_si128(reinterpret_cast<__m128i *>(lengths),
+                        _mm_add_epi16(_mm_set1_epi16(3), _mm_add_epi16(isAscii, isTwo)));
+
+        for (int i = 0; i < 8; ++i) {
+            memcpy(dst, &words[i], sizeof(quint32));
+            dst += lengths[i];
+        }
+    }
+    return src != start;
+}
 #elif defined(__ARM_NEON__)
 static inline bool simdEncodeAscii(uchar *&dst, const char16_t *&nextAscii, const char16_t *&src, const char16_t *end)
 {
@@ -460,6 +582,16 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *&, const char16_t *)
 {
 }
+
+static inline bool simdDecodeUtf8(char16_t *&, const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static inline bool simdEncodeUtf8(uchar *&, const char16_t *&, const char16_t *)
+{
+    return false;
+}
 #else
 static inline bool simdEncodeAscii(uchar *, const char16_t *, const char16_t *, const char16_t *)
 {
@@ -480,6 +612,16 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *&, const char16_t *)
 {
 }
+
+static inline bool simdDecodeUtf8(char16_t *&, const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static inline bool simdEncodeUtf8(uchar *&, const char16_t *&, const char16_t *)
+{
+    return false;
+}
 #endif
 
 enum { HeaderDone = 1 };
@@ -498,6 +640,8 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        if (simdEncodeUtf8(dst, src, end))
+            continue;
 
         do {
             char16_t u = *src++;
@@ -565,6 +709,8 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        if (simdEncodeUtf8(cursor, src, end))
+            continue;
 
         do {
             char16_t uc = *src++;
@@ -652,6 +798,8 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, QByteArrayView in) noexcept
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
+            if (simdDecodeUtf8(dst, src, end))
+                continue;
 
             do {
                 uchar b = *src++;
@@ -754,8 +902,14 @@ QChar *QUtf8::convertToUnicode(QChar *out, QByteArrayView in, QStringConverter::
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            if (simdDecodeUtf8(dst, src, end)) {
+                nextAscii = src;
+                continue;
+            }
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -40,6 +40,8 @@
 
 #include "qstringmatcher.h"
 
+#include <private/qsimd_p.h>
+
 QT_BEGIN_NAMESPACE
 
 static void bm_init_skiptable(QStringView needle, uchar *skiptable, Qt::CaseSensitivity cs)
@@ -63,6 +65,56 @@ static void bm_init_skiptable(QStringView needle, uchar *skiptable, Qt::CaseSens
     }
 }
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+// Up to this pattern length, comparing 8 characters at a time against the
+// pattern's first and last character beats the skip table.
+static constexpr qsizetype SimdPrefilterMaxLength = 16;
+
+// Searches whole 8-character blocks of the haystack, starting at index, for
+// the pattern. Returns the match position, or -1 with index advanced to the
+// first position that still needs to be searched.
+static qsizetype simd_find(const char16_t *uc, qsizetype l, qsizetype &index,
+                           const char16_t *puc, qsizetype pl)
+{
+    const qsizetype pl_minus_one = pl - 1;
+    auto verify = [&](qsizetype pos) {
+        return memcmp(uc + pos + 1, puc + 1, (pl - 2) * sizeof(char16_t)) == 0;
+    };
+#  if defined(__SSE2__)
+    const __m128i first = _mm_set1_epi16(short(puc[0]));
+    const __m128i last = _mm_set1_epi16(short(puc[pl_minus_one]));
+    for ( ; index + pl_minus_one + 8 <= l; index += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + index));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(uc + index + pl_minus_one));
+        // two mask bits per character; keep one
+        uint mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(a, first),
+                                                    _mm_cmpeq_epi16(b, last))) & 0x5555;
+        for ( ; mask; mask &= mask - 1) {
+            const qsizetype pos = index + qCountTrailingZeroBits(mask) / 2;
+            if (verify(pos))
+                return pos;
+        }
+    }
+#  else
+    const uint16x8_t first = vdupq_n_u16(puc[0]);
+    const uint16x8_t last = vdupq_n_u16(puc[pl_minus_one]);
+    for ( ; index + pl_minus_one + 8 <= l; index += 8) {
+        const uint16x8_t cmp = vandq_u16(vceqq_u16(vld1q_u16(uc + index), first),
+                                         vceqq_u16(vld1q_u16(uc + index + pl_minus_one), last));
+        // NEON has no movemask; narrowing leaves 8 bits per character
+        quint64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(cmp, 4)), 0)
+                & Q_UINT64_C(0x8080808080808080);
+        for ( ; mask; mask &= mask - 1) {
+            const qsizetype pos = index + qCountTrailingZeroBits(mask) / 8;
+            if (verify(pos))
+                return pos;
+        }
+    }
+#  endif
+    return -1;
+}
+#endif
+
 static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringView needle,
                           const uchar *skiptable, Qt::CaseSensitivity cs)
 {
@@ -75,6 +127,15 @@ static inline qsizetype bm_find(QStringView haystack, qsizetype index, QStringVi
         return index > l ? -1 : index;
     const qsizetype pl_minus_one = pl - 1;
 
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+    if (cs == Qt::CaseSensitive && pl > 1 && pl <= SimdPrefilterMaxLength) {
+        const qsizetype found = simd_find(uc, l, index, puc, pl);
+        if (found >= 0)
+            return found;
+        // the tail shorter than a block is left to the loop below
+    }
+#endif
+
     const char16_t *current = uc + index + pl_minus_one;
     const char16_t *end = uc + l;
     if (cs == Qt::CaseSensitive) {
@@ -317,6 +317,9 @@ private:
     template<typename ResultType>
     friend struct QtPrivate::WhenAnyContext;
 
+    template<class U>
+    friend class QtPrivate::FutureAwaiter;
+
     using QFuturePrivate =
             std::conditional_t<std::is_same_v<T, void>, QFutureInterfaceBase, QFutureInterface<T>>;
 
@@ -77,7 +77,10 @@ QT_BEGIN_NAMESPACE
     When the number of pending resultReadyAt() or resultsReadyAt() signals
     exceeds the limit, the computation represented by the future will be
     throttled automatically. The computation will resume once the number of
-    pending signals drops below the limit.
+    pending signals drops below the limit. Results that are reported while the
+    limit is exceeded are merged into the range of the last pending
+    resultsReadyAt() signal, so a computation that does not honor throttling
+    cannot flood the event queue of the watcher's thread.
 
     Example: Starting a computation and getting a slot callback when it's
     finished:
@@ -438,6 +441,11 @@ bool QFutureWatcherBase::event(QEvent *event)
     \a limit, the computation represented by the future will be throttled
     automatically. The computation will resume once the number of pending
     signals drops below the \a limit.
+
+    While the limit is exceeded, results that directly follow those of the
+    last pending resultsReadyAt() signal are added to its range, rather than
+    reported by another signal. resultReadyAt() is still emitted once for
+    each result.
 */
 void QFutureWatcherBase::setPendingResultsLimit(int limit)
 {
@@ -504,16 +512,36 @@ void QFutureWatcherBasePrivate::postCallOutEvent(const QFutureCallOutEvent &call
 {
     Q_Q(QFutureWatcherBase);
 
-    if (callOutEvent.callOutType == QFutureCallOutEvent::ResultsReady) {
-        if (pendingResultsReady.fetchAndAddRelaxed(1) >= maximumPendingResultsReady)
+    const bool resultsReady = callOutEvent.callOutType == QFutureCallOutEvent::ResultsReady;
+    if (resultsReady) {
+        if (pendingResultsReady.fetchAndAddRelaxed(1) >= maximumPendingResultsReady) {
             q->futureInterface().d->internal_setThrottled(true);
+
+            // Don't flood the event queue: merge into the last event if it
+            // is still waiting to be delivered.
+            QMutexLocker locker(&lastResultsReadyMutex);
+            if (lastResultsReady && lastResultsReady->index2 == callOutEvent.index1) {
+                lastResultsReady->index2 = callOutEvent.index2;
+                pendingResultsReady.deref();
+                return;
+            }
+        }
     }
 
-    QCoreApplication::postEvent(q, callOutEvent.clone());
+    auto event = static_cast<QFutureCallOutEvent *>(callOutEvent.clone());
+    {
+        QMutexLocker locker(&lastResultsReadyMutex);
+        lastResultsReady = resultsReady ? event : nullptr;
+    }
+    QCoreApplication::postEvent(q, event);
 }
 
 void QFutureWatcherBasePrivate::callOutInterfaceDisconnected()
 {
+    {
+        QMutexLocker locker(&lastResultsReadyMutex);
+        lastResultsReady = nullptr;
+    }
     QCoreApplication::removePostedEvents(q_func(), QEvent::FutureCallOut);
 }
 
@@ -554,15 +582,22 @@ QT_WARNING_POP
             emit q->resumed();
         break;
         case QFutureCallOutEvent::ResultsReady: {
+            int beginIndex;
+            int endIndex;
+            {
+                QMutexLocker locker(&lastResultsReadyMutex);
+                if (lastResultsReady == event)
+                    lastResultsReady = nullptr;
+                beginIndex = event->index1;
+                endIndex = event->index2;
+            }
+
             if (q->futureInterface().isCanceled())
                 break;
 
             if (pendingResultsReady.fetchAndAddRelaxed(-1) <= maximumPendingResultsReady)
                 q->futureInterface().setThrottled(false);
 
-            const int beginIndex = event->index1;
-            const int endIndex = event->index2;
-
             emit q->resultsReadyAt(beginIndex, endIndex);
 
             if (resultAtConnected.loadRelaxed() <= 0)
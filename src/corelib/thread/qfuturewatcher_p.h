@@ -77,6 +77,12 @@ public:
     QAtomicInt pendingResultsReady;
     int maximumPendingResultsReady;
 
+    // The last ResultsReady event posted and not yet delivered. Once the
+    // pending results limit is reached, contiguous results extend its range
+    // instead of posting another event.
+    QBasicMutex lastResultsReadyMutex;
+    QFutureCallOutEvent *lastResultsReady = nullptr;
+
     QAtomicInt resultAtConnected;
 };
 
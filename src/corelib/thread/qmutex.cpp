@@ -581,12 +581,65 @@ void QRecursiveMutex::unlock() noexcept
  * waiting in the past. We then set the mutex to 0x0 and perform a FUTEX_WAKE.
  */
 
+/*
+ * ADAPTIVE SPINNING (futex implementation):
+ *
+ * Parking on the futex costs two system calls and a context switch, which is
+ * much more than most critical sections protected by a QMutex. So before
+ * parking, a thread that finds the mutex locked spins for a while, hoping
+ * that the owner, still running on another core, unlocks it soon.
+ *
+ * Spinning only makes sense while the owner is running. We cannot observe
+ * that directly, so we use the mutex state as a proxy: as long as it is 0x1
+ * no thread has had to park, i.e. the mutex changes owners quickly. Once it
+ * is 0x3 the owner is holding it for long enough to make someone else sleep,
+ * and we park right away. Spinning is also pointless on a single CPU.
+ *
+ * The number of iterations adapts to how long spinning took to succeed
+ * recently, like glibc's PTHREAD_MUTEX_ADAPTIVE_NP mutexes. QBasicMutex has
+ * no room for the estimate, so it is kept per thread.
+ */
+static constexpr int MaxSpinCount = 200;
+static thread_local int spinEstimate = 10;
+
+static bool canSpin()
+{
+    static const bool multipleCpus = QThread::idealThreadCount() > 1;
+    return multipleCpus;
+}
+
+// Returns true if the mutex was acquired while spinning
+static bool spinLock(QBasicAtomicPointer<QMutexPrivate> &d_ptr, QMutexPrivate *locked) noexcept
+{
+    if (!canSpin())
+        return false;
+
+    const int maxSpins = qMin(MaxSpinCount, spinEstimate * 2 + 10);
+    for (int spins = 0; spins < maxSpins; ++spins) {
+        QMutexPrivate *value = d_ptr.loadRelaxed();
+        if (value == nullptr) {
+            if (d_ptr.testAndSetAcquire(nullptr, locked)) {
+                spinEstimate += (spins - spinEstimate) / 8;
+                return true;
+            }
+        } else if (value != locked) {
+            break; // somebody is parked already, don't compete with them
+        }
+        qYieldCpu();
+    }
+    spinEstimate += (maxSpins - spinEstimate) / 8;
+    return false;
+}
+
 /*!
     \internal helper for lock()
  */
 void QBasicMutex::lockInternal() QT_MUTEX_LOCK_NOEXCEPT
 {
     if (futexAvailable()) {
+        if (spinLock(d_ptr, dummyLocked()))
+            return;
+
         // note we must set to dummyFutexValue because there could be other threads
         // also waiting
         while (d_ptr.fetchAndStoreAcquire(dummyFutexValue()) != nullptr) {
@@ -616,6 +669,9 @@ bool QBasicMutex::lockInternal(int timeout) QT_MUTEX_LOCK_NOEXCEPT
         }
 
         QDeadlineTimer deadlineTimer(timeout);
+        if (spinLock(d_ptr, dummyLocked()))
+            return true;
+
         // The mutex is already locked, set a bit indicating we're waiting.
         // Note we must set to dummyFutexValue because there could be other threads
         // also waiting.
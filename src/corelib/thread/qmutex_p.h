@@ -69,10 +69,26 @@
 # endif
 #endif
 
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC)
+# include <intrin.h>
+#endif
+
 struct timespec;
 
 QT_BEGIN_NAMESPACE
 
+// Tells the CPU that the calling thread is busy-waiting on a lock
+static inline void qYieldCpu() noexcept
+{
+#if defined(Q_PROCESSOR_X86) && defined(Q_CC_GNU)
+    __builtin_ia32_pause();
+#elif defined(Q_PROCESSOR_X86) && defined(Q_CC_MSVC)
+    _mm_pause();
+#elif defined(Q_PROCESSOR_ARM_64) && defined(Q_CC_GNU)
+    asm volatile("yield");
+#endif
+}
+
 class QMutexPrivate
 {
 public:
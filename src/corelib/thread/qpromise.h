@@ -92,6 +92,10 @@ public:
     {
         return d.reportResult(std::forward<U>(result), index);
     }
+    bool addResults(const QList<T> &results, int index = -1)
+    {
+        return d.reportResults(results, index, int(results.size()));
+    }
 #ifndef QT_NO_EXCEPTIONS
     void setException(const QException &e) { d.reportException(e); }
 #if QT_VERSION < QT_VERSION_CHECK(7, 0, 0)
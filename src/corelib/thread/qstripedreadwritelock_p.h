@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSTRIPEDREADWRITELOCK_P_H
+#define QSTRIPEDREADWRITELOCK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/private/qmutex_p.h>
+
+#include <atomic>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QStripedReadWriteLock is a reader-writer lock for data that is read by
+    many threads at once and rarely written.
+
+    QReadWriteLock counts readers in a single atomic, so the cache line holding
+    it moves between the cores of all readers. Here, each reader increments a
+    counter in one of several stripes, chosen by its thread id, each stripe on
+    a cache line of its own. Threads mostly touch their own stripe, and the
+    only shared state readers look at is the writer flag, which stays in all
+    caches while nobody writes.
+
+    A writer serializes against other writers with a QMutex, raises the writer
+    flag and waits for the reader counts of all stripes to drop to zero.
+    Readers that see the flag back off and block on the writer's mutex, so
+    writers are not starved. Writing is correspondingly more expensive than
+    with QReadWriteLock.
+
+    The lock is not recursive, and a read lock must be released by the thread
+    that acquired it. Besides the Qt-style functions, it provides the
+    interface of std::shared_mutex, to be used with std::shared_lock and
+    std::unique_lock.
+*/
+class QStripedReadWriteLock
+{
+public:
+    explicit QStripedReadWriteLock(int count = defaultStripeCount())
+    {
+        count = int(qNextPowerOfTwo(quint32(qBound(2, count, int(MaxStripeCount)) - 1)));
+        stripes.reset(new Stripe[count]);
+        stripeShift = 64 - qCountTrailingZeroBits(quint32(count));
+    }
+    Q_DISABLE_COPY_MOVE(QStripedReadWriteLock)
+
+    void lockForRead()
+    {
+        std::atomic<int> &readers = stripeForCurrentThread();
+        while (!tryLockForRead(readers)) {
+            // a writer holds or is acquiring the lock, wait until it is done
+            QMutexLocker locker(&writerMutex);
+        }
+    }
+    bool tryLockForRead() { return tryLockForRead(stripeForCurrentThread()); }
+    void unlockRead() { stripeForCurrentThread().fetch_sub(1, std::memory_order_release); }
+
+    void lockForWrite()
+    {
+        writerMutex.lock();
+        writerActive.store(true);
+        for (int i = 0, end = stripeCount(); i < end; ++i)
+            waitForReaders(stripes[i].readers);
+    }
+    bool tryLockForWrite()
+    {
+        if (!writerMutex.tryLock())
+            return false;
+        writerActive.store(true);
+        for (int i = 0, end = stripeCount(); i < end; ++i) {
+            if (stripes[i].readers.load() != 0) {
+                unlockWrite();
+                return false;
+            }
+        }
+        return true;
+    }
+    void unlockWrite()
+    {
+        writerActive.store(false, std::memory_order_release);
+        writerMutex.unlock();
+    }
+
+    int stripeCount() const { return 1 << (64 - stripeShift); }
+
+    // std::shared_mutex interface
+    void lock() { lockForWrite(); }
+    bool try_lock() { return tryLockForWrite(); }
+    void unlock() { unlockWrite(); }
+    void lock_shared() { lockForRead(); }
+    bool try_lock_shared() { return tryLockForRead(); }
+    void unlock_shared() { unlockRead(); }
+
+private:
+    enum { MaxStripeCount = 64 };
+
+    // 64 bytes is the cache line size of all common x86 and ARM cores
+    struct alignas(64) Stripe
+    {
+        std::atomic<int> readers = { 0 };
+    };
+
+    static int defaultStripeCount() { return QThread::idealThreadCount(); }
+
+    std::atomic<int> &stripeForCurrentThread() const
+    {
+        // thread ids are often aligned addresses, so mix all of their bits
+        const quint64 id = quintptr(QThread::currentThreadId());
+        return stripes[(id * Q_UINT64_C(0x9E3779B97F4A7C15)) >> stripeShift].readers;
+    }
+
+    bool tryLockForRead(std::atomic<int> &readers)
+    {
+        // Both this increment and the load below are sequentially consistent,
+        // like the store to writerActive and the loads of the reader counts
+        // in lockForWrite(). So either we see the writer, or it sees us.
+        readers.fetch_add(1);
+        if (Q_LIKELY(!writerActive.load()))
+            return true;
+        readers.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    static void waitForReaders(std::atomic<int> &readers)
+    {
+        // readers hold the lock briefly, so spin before giving up the CPU
+        for (int spins = 0; readers.load() != 0; ++spins) {
+            if (spins < 1000)
+                qYieldCpu();
+            else
+                QThread::yieldCurrentThread();
+        }
+    }
+
+    std::unique_ptr<Stripe[]> stripes;
+    int stripeShift;
+    alignas(64) std::atomic<bool> writerActive = { false };
+    QMutex writerMutex;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTRIPEDREADWRITELOCK_P_H
@@ -93,6 +93,8 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    takeIncomingPostedEvents();
+    qDeleteAll(postEventList.misrouted);
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -105,6 +107,72 @@ QThreadData::~QThreadData()
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
+/*!
+    \internal
+
+    Moves the events pushed onto postEventList.incoming into the list proper,
+    in the order they were posted. Events whose receiver has meanwhile been
+    moved to another thread are set aside in postEventList.misrouted for the
+    posting thread to deliver. Must be called with postEventList.mutex held.
+*/
+void QThreadData::takeIncomingPostedEvents()
+{
+    QMetaCallEvent *head = postEventList.incoming.fetchAndStoreAcquire(nullptr);
+    if (!head)
+        return;
+
+    QMetaCallEvent *ordered = nullptr;
+    while (head) {
+        QMetaCallEvent *next = head->nextPosted_;
+        head->nextPosted_ = ordered;
+        ordered = head;
+        head = next;
+    }
+
+    while (ordered) {
+        QMetaCallEvent *ev = ordered;
+        ordered = ev->nextPosted_;
+        ev->nextPosted_ = nullptr;
+        QObject *receiver = ev->postedReceiver_;
+        if (QObjectPrivate::get(receiver)->threadData.loadRelaxed() != this) {
+            postEventList.misrouted.append(ev);
+            continue;
+        }
+        postEventList.addEvent(QPostEvent(receiver, ev, Qt::NormalEventPriority));
+        ++receiver->d_func()->postedEvents;
+        canWait = false;
+    }
+}
+
+/*!
+    \internal
+
+    Moves the set-aside events whose receivers now live in \a targetData to
+    its list. Must be called with both post event list mutexes held.
+*/
+void QThreadData::moveMisroutedPostedEvents(QThreadData *targetData)
+{
+    const auto movedThere = [targetData](QMetaCallEvent *ev) {
+        return QObjectPrivate::get(ev->postedReceiver_)->threadData.loadRelaxed() == targetData;
+    };
+    QList<QMetaCallEvent *> &misrouted = postEventList.misrouted;
+    if (std::none_of(misrouted.cbegin(), misrouted.cend(), movedThere))
+        return;
+
+    for (QMetaCallEvent *ev : std::as_const(misrouted)) {
+        if (!movedThere(ev))
+            continue;
+        targetData->postEventList.addEvent(QPostEvent(ev->postedReceiver_, ev, Qt::NormalEventPriority));
+        ++ev->postedReceiver_->d_func()->postedEvents;
+    }
+    misrouted.removeIf(movedThere);
+
+    if (targetData->hasEventDispatcher()) {
+        targetData->canWait = false;
+        targetData->eventDispatcher.loadRelaxed()->wakeUp();
+    }
+}
+
 void QThreadData::ref()
 {
 #if QT_CONFIG(thread)
@@ -536,6 +604,48 @@ uint QThread::stackSize() const
     return d->stackSize;
 }
 
+/*!
+    \since 6.4
+
+    Restricts the thread to run on the logical processors whose numbers are
+    listed in \a cpus. An empty list, the default, lets the operating system
+    schedule the thread on any processor the process may use.
+
+    Pinning the threads that work on a large data set to the processors of
+    one NUMA node keeps the memory they first touch on that node.
+
+    The affinity is applied when the thread starts and must not be changed
+    while the thread is running. Processor numbers that do not exist are
+    ignored. This function is only supported on Linux and Windows; on other
+    platforms it has no effect. On Windows, only the first 64 processors can
+    be selected.
+
+    \sa cpuAffinity(), QThreadPool::cpuAffinity
+*/
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThread);
+    QMutexLocker locker(&d->mutex);
+    Q_ASSERT_X(!d->running, "QThread::setCpuAffinity",
+               "cannot change the CPU affinity while the thread is running");
+    d->cpuAffinity = cpus;
+}
+
+/*!
+    \since 6.4
+
+    Returns the processors the thread is restricted to, as set with
+    setCpuAffinity(); otherwise returns an empty list.
+
+    \sa setCpuAffinity()
+*/
+QList<int> QThread::cpuAffinity() const
+{
+    Q_D(const QThread);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
 /*!
     Enters the event loop and waits until exit() is called, returning the value
     that was passed to exit(). The value returned is 0 if exit() is called via
@@ -967,6 +1077,16 @@ uint QThread::stackSize() const
     return 0;
 }
 
+void QThread::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_UNUSED(cpus);
+}
+
+QList<int> QThread::cpuAffinity() const
+{
+    return {};
+}
+
 #endif // QT_CONFIG(thread)
 
 /*!
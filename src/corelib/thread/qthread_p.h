@@ -60,6 +60,7 @@
 #if QT_CONFIG(thread)
 #include "QtCore/qwaitcondition.h"
 #endif
+#include "QtCore/qhash.h"
 #include "QtCore/qmap.h"
 #include "QtCore/qcoreapplication.h"
 #include "private/qobject_p.h"
@@ -107,8 +108,48 @@ public:
 
     QMutex mutex;
 
+    // queued meta-call events pushed without taking the mutex (see
+    // QCoreApplicationPrivate::postMetaCallEvent()); linked through
+    // QMetaCallEvent::nextPosted_ in LIFO order and moved into the list by
+    // QThreadData::takeIncomingPostedEvents()
+    QAtomicPointer<QMetaCallEvent> incoming;
+    // incoming events whose receiver had already moved to another thread when
+    // they were taken; the posting thread picks these up again
+    QList<QMetaCallEvent *> misrouted;
+
+    // the queued events of the types QCoreApplication::compressEvent() looks
+    // for, by receiver and type; entries are added by postEvent() and
+    // dropped when the event leaves the list
+    QHash<std::pair<QObject *, int>, QEvent *> compressibleEvents;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
+    QEvent *pendingCompressibleEvent(QObject *receiver, int type) const
+    {
+        return compressibleEvents.value({ receiver, type }, nullptr);
+    }
+
+    void indexCompressibleEvent(const QPostEvent &ev)
+    {
+        QEvent *&pending = compressibleEvents[{ ev.receiver, ev.event->type() }];
+        if (!pending)
+            pending = ev.event;
+    }
+
+    // returns whether ev was indexed
+    bool forgetCompressibleEvent(const QPostEvent &ev)
+    {
+        if (compressibleEvents.isEmpty())
+            return false;
+        const auto it = compressibleEvents.find({ ev.receiver, ev.event->type() });
+        if (it == compressibleEvents.end() || it.value() != ev.event)
+            return false;
+        compressibleEvents.erase(it);
+        return true;
+    }
+
+    bool hasIncoming() const { return incoming.loadAcquire() != nullptr; }
+
     void addEvent(const QPostEvent &ev)
     {
         int priority = ev.priority;
@@ -165,6 +206,7 @@ public:
 
     uint stackSize;
     std::underlying_type_t<QThread::Priority> priority;
+    QList<int> cpuAffinity;
 
 #ifdef Q_OS_UNIX
     QWaitCondition thread_done;
@@ -261,9 +303,12 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasIncoming();
     }
 
+    void takeIncomingPostedEvents();
+    void moveMisroutedPostedEvents(QThreadData *targetData);
+
     // This class provides per-thread (by way of being a QThreadData
     // member) storage for qFlagLocation()
     class FlaggedDebugSignatures
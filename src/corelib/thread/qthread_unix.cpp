@@ -67,6 +67,8 @@
 #include <cxxabi.h>
 #endif
 
+#include <algorithm>
+
 #include <sched.h>
 #include <errno.h>
 
@@ -284,6 +286,29 @@ static void setCurrentThreadName(const char *name)
 }
 #endif
 
+static void setCurrentThreadCpuAffinity(const QList<int> &cpus)
+{
+#if defined(Q_OS_LINUX)
+    const int maxCpu = *std::max_element(cpus.cbegin(), cpus.cend());
+    if (maxCpu < 0)
+        return;
+    cpu_set_t *cpuset = CPU_ALLOC(maxCpu + 1);
+    if (!cpuset)
+        return;
+    const size_t size = CPU_ALLOC_SIZE(maxCpu + 1);
+    CPU_ZERO_S(size, cpuset);
+    for (int cpu : cpus) {
+        if (cpu >= 0)
+            CPU_SET_S(cpu, size, cpuset);
+    }
+    if (sched_setaffinity(0, size, cpuset) != 0)
+        qErrnoWarning("QThread::start: Failed to set the CPU affinity");
+    CPU_FREE(cpuset);
+#else
+    Q_UNUSED(cpus);
+#endif
+}
+
 namespace {
 template <typename T>
 void terminate_on_exception(T &&t)
@@ -326,6 +351,9 @@ void *QThreadPrivate::start(void *arg)
                 thr->d_func()->setPriority(QThread::Priority(thr->d_func()->priority & ~ThreadPriorityResetFlag));
             }
 
+            if (!thr->d_func()->cpuAffinity.isEmpty())
+                setCurrentThreadCpuAffinity(thr->d_func()->cpuAffinity);
+
             // threadId is set in QThread::start()
             Q_ASSERT(pthread_equal(from_HANDLE<pthread_t>(data->threadId.loadRelaxed()),
                                    pthread_self()));
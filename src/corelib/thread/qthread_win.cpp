@@ -498,6 +498,16 @@ void QThread::start(Priority priority)
         qErrnoWarning("QThread::start: Failed to set thread priority");
     }
 
+    if (!d->cpuAffinity.isEmpty()) {
+        DWORD_PTR mask = 0;
+        for (int cpu : qAsConst(d->cpuAffinity)) {
+            if (cpu >= 0 && cpu < int(sizeof(DWORD_PTR) * 8))
+                mask |= DWORD_PTR(1) << cpu;
+        }
+        if (mask && !SetThreadAffinityMask(d->handle, mask))
+            qErrnoWarning("QThread::start: Failed to set the CPU affinity");
+    }
+
     if (ResumeThread(d->handle) == (DWORD) -1) {
         qErrnoWarning("QThread::start: Failed to resume new thread");
     }
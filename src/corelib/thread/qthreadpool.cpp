@@ -41,9 +41,14 @@
 #include "qthreadpool_p.h"
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
+#include "qscopeguard.h"
+
+#include <private/qcoremetrics_p.h>
 
 #include <algorithm>
 
+#include <qtcore_tracepoints_p.h>
+
 QT_BEGIN_NAMESPACE
 
 /*
@@ -57,11 +62,20 @@ public:
     void run() override;
     void registerThreadInactive();
 
+    QRunnable *takeLocalTask();
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // runnables started from this thread in work-stealing mode; the owner
+    // takes from the back, other threads steal from the front
+    QMutex localMutex;
+    QList<QRunnable *> localQueue;
 };
 
+static thread_local QThreadPoolThread *currentThreadPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -74,6 +88,22 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
     :manager(manager), runnable(nullptr)
 {
     setStackSize(manager->stackSize);
+    setCpuAffinity(manager->cpuAffinity);
+}
+
+/*
+    \internal
+*/
+QRunnable *QThreadPoolThread::takeLocalTask()
+{
+    QMutexLocker locker(&localMutex);
+    return localQueue.isEmpty() ? nullptr : localQueue.takeLast();
+}
+
+static void recordQueueWaitTime(const QueuePage *page)
+{
+    if (const qint64 enqueuedAt = page->firstEnqueuedAt())
+        QCoreMetrics::threadPoolWaitTime.record(QCoreMetrics::timestamp() - enqueuedAt);
 }
 
 /*
@@ -81,18 +111,21 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentThreadPoolThread = this;
+
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
         runnable = nullptr;
 
         do {
-            if (r) {
+            while (r) {
                 // If autoDelete() is false, r might already be deleted after run(), so check status now.
                 const bool del = r->autoDelete();
 
                 // run the task
                 locker.unlock();
+                Q_TRACE(QThreadPoolThread_runTask_entry, manager->q_func(), r);
 #ifndef QT_NO_EXCEPTIONS
                 try {
 #endif
@@ -102,31 +135,65 @@ void QThreadPoolThread::run()
                     qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
                              "This is not supported, exceptions thrown in worker threads must be\n"
                              "caught before control returns to Qt Concurrent.");
+                    locker.relock();
+                    manager->flushLocalQueue(this);
                     registerThreadInactive();
                     throw;
                 }
 #endif
+                Q_TRACE(QThreadPoolThread_runTask_exit);
 
                 if (del)
                     delete r;
-                locker.relock();
+
+                // In work-stealing mode, carry on with our own queue without
+                // touching the pool's mutex, unless the shared queue holds
+                // something with a higher priority.
+                r = nullptr;
+                if (manager->workStealing.loadRelaxed()
+                        && manager->highestQueuedPriority.loadRelaxed() <= 0) {
+                    r = takeLocalTask();
+                }
+                if (!r)
+                    locker.relock();
             }
 
             // if too many threads are active, stop working in this one
-            if (manager->tooManyThreadsActive())
+            if (manager->tooManyThreadsActive()) {
+                manager->flushLocalQueue(this);
                 break;
+            }
+
+            // Runnables in our own queue have the default priority; run them
+            // after anything more important from the shared queue.
+            if (manager->queue.isEmpty() || manager->queue.first()->priority() <= 0) {
+                if ((r = takeLocalTask()))
+                    continue;
+            }
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
+            if (manager->queue.isEmpty()) {
+                if (manager->workStealing.loadRelaxed()) {
+                    // Clear the flag before looking at the other queues, so
+                    // that a thread pushing to its own queue after we looked
+                    // sees the flag cleared and wakes us up.
+                    manager->saturated.storeRelease(0);
+                    if ((r = manager->stealTask(this)))
+                        continue;
+                }
+
+                // all work is done, time to wait for more
                 break;
+            }
 
             QueuePage *page = manager->queue.first();
+            recordQueueWaitTime(page);
             r = page->pop();
 
             if (page->isFinished()) {
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updateQueuedPriority();
         } while (true);
 
         // this thread is about to be deleted, do not wait or expire
@@ -152,6 +219,7 @@ void QThreadPoolThread::run()
         }
         if (manager->waitingThreads.removeOne(this)) {
             manager->expiredThreads.enqueue(this);
+            manager->saturated.storeRelaxed(0);
             return;
         }
         ++manager->activeThreads;
@@ -221,14 +289,102 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    const qint64 enqueuedAt = QCoreMetrics::isEnabled() ? QCoreMetrics::timestamp() : 0;
+    const auto recordQueueLength = qScopeGuard([this, enqueuedAt] {
+        if (!enqueuedAt)
+            return;
+        qsizetype length = 0;
+        for (const QueuePage *page : qAsConst(queue))
+            length += page->size();
+        QCoreMetrics::threadPoolQueueLength.record(length);
+    });
+
     for (QueuePage *page : qAsConst(queue)) {
         if (page->priority() == priority && !page->isFull()) {
-            page->push(runnable);
+            page->push(runnable, enqueuedAt);
             return;
         }
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
-    queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    queue.insert(std::distance(queue.constBegin(), it),
+                 new QueuePage(runnable, priority, enqueuedAt));
+    updateQueuedPriority();
+}
+
+void QThreadPoolPrivate::updateQueuedPriority()
+{
+    highestQueuedPriority.storeRelaxed(queue.isEmpty() ? std::numeric_limits<int>::min()
+                                                       : queue.first()->priority());
+}
+
+/*!
+    \internal
+
+    Puts \a task into the queue of the current thread if work stealing is
+    enabled and the current thread belongs to this pool. Returns \c false if
+    the task has to go through the shared queue instead. Must be called
+    without holding the mutex.
+*/
+bool QThreadPoolPrivate::pushLocalTask(QRunnable *task)
+{
+    QThreadPoolThread *self = currentThreadPoolThread;
+    if (!self || self->manager != this || !workStealing.loadRelaxed())
+        return false;
+
+    {
+        QMutexLocker locker(&self->localMutex);
+        self->localQueue.append(task);
+    }
+
+    // When all threads were busy the last time we looked, leave the task
+    // where it is: we run it ourselves or the next thread that runs out of
+    // work steals it. Otherwise hand it over to an idle or new thread.
+    if (saturated.loadAcquire())
+        return true;
+
+    QMutexLocker locker(&mutex);
+    QRunnable *r = self->takeLocalTask();
+    if (r && !tryStart(r)) {
+        QMutexLocker localLocker(&self->localMutex);
+        self->localQueue.append(r);
+        saturated.storeRelaxed(1);
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Takes the oldest runnable from the queue of a thread other than \a thief.
+    Must be called with the mutex held.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    for (QThreadPoolThread *victim : qAsConst(allThreads)) {
+        if (victim == thief)
+            continue;
+        QMutexLocker locker(&victim->localMutex);
+        if (!victim->localQueue.isEmpty())
+            return victim->localQueue.takeFirst();
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Moves the runnables queued by \a thread to the shared queue, before that
+    thread stops working. Must be called with the mutex held.
+*/
+void QThreadPoolPrivate::flushLocalQueue(QThreadPoolThread *thread)
+{
+    QList<QRunnable *> tasks;
+    {
+        QMutexLocker locker(&thread->localMutex);
+        tasks.swap(thread->localQueue);
+    }
+    for (QRunnable *task : qAsConst(tasks))
+        enqueueTask(task);
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -247,6 +403,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
         if (!tryStart(page->first()))
             break;
 
+        recordQueueWaitTime(page);
         page->pop();
 
         if (page->isFinished()) {
@@ -254,6 +411,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updateQueuedPriority();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -299,6 +457,7 @@ void QThreadPoolPrivate::reset()
     auto allThreadsCopy = std::exchange(allThreads, {});
     expiredThreads.clear();
     waitingThreads.clear();
+    saturated.storeRelaxed(0);
 
     mutex.unlock();
 
@@ -342,6 +501,11 @@ bool QThreadPoolPrivate::waitForDone(int msecs)
 void QThreadPoolPrivate::clear()
 {
     QMutexLocker locker(&mutex);
+    QList<QRunnable *> localTasks;
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        localTasks += std::exchange(thread->localQueue, {});
+    }
     while (!queue.isEmpty()) {
         auto *page = queue.takeLast();
         while (!page->isFinished()) {
@@ -354,6 +518,13 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updateQueuedPriority();
+
+    locker.unlock();
+    for (QRunnable *r : qAsConst(localTasks)) {
+        if (r->autoDelete())
+            delete r;
+    }
 }
 
 /*!
@@ -386,11 +557,18 @@ bool QThreadPool::tryTake(QRunnable *runnable)
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
+                d->updateQueuedPriority();
             }
             return true;
         }
     }
 
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (thread->localQueue.removeOne(runnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -461,6 +639,11 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     implementing time-consuming operations that are not visible to the
     QThreadPool.
 
+    Programs that start many small runnables from within running runnables,
+    such as recursive divide-and-conquer algorithms, can reduce contention
+    between the threads by enabling work stealing with
+    setWorkStealingEnabled().
+
     Note that QThreadPool is a low-level class for managing threads, see
     the Qt Concurrent module for higher level alternatives.
 
@@ -521,6 +704,12 @@ QThreadPool *QThreadPool::globalInstance()
     ownership of \a runnable remains with the caller. Note that
     changing the auto-deletion on \a runnable after calling this
     functions results in undefined behavior.
+
+    If work stealing is enabled and this function is called from one of the
+    pool's threads with the default \a priority, \a runnable is put into
+    the queue of the calling thread instead.
+
+    \sa setWorkStealingEnabled()
 */
 void QThreadPool::start(QRunnable *runnable, int priority)
 {
@@ -528,6 +717,10 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    Q_TRACE(QThreadPool_start, this, runnable, priority);
+    if (priority == 0 && d->pushLocalTask(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
@@ -661,6 +854,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
         return;
 
     d->requestedMaxThreadCount = maxThreadCount;
+    d->saturated.storeRelaxed(0);
     d->tryToStartMoreThreads();
 }
 
@@ -753,6 +947,34 @@ QThread::Priority QThreadPool::threadPriority() const
     return d->threadPriority;
 }
 
+/*! \property QThreadPool::cpuAffinity
+    \brief the processors the worker threads are restricted to.
+
+    The value of the property is only used when the thread pool creates
+    new threads. Changing it has no effect for already created
+    or running threads.
+
+    The default value is an empty list, which lets the operating system
+    schedule the worker threads on any processor.
+
+    \sa QThread::setCpuAffinity()
+
+    \since 6.4
+*/
+void QThreadPool::setCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+}
+
+QList<int> QThreadPool::cpuAffinity() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -770,6 +992,7 @@ void QThreadPool::releaseThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
+    d->saturated.storeRelaxed(0);
     d->tryToStartMoreThreads();
 }
 
@@ -836,6 +1059,46 @@ bool QThreadPool::waitForDone(int msecs)
     return d->waitForDone(msecs);
 }
 
+/*!
+    \since 6.4
+
+    Sets whether the thread pool uses work stealing to \a enabled. Work
+    stealing is disabled by default.
+
+    Normally, all runnables passed to start() go through one queue that is
+    shared by all threads of the pool. With work stealing enabled, a runnable
+    that one of the pool's own threads starts with the default priority is
+    put into a queue that belongs to that thread instead. A thread works
+    through its own queue without synchronizing with the other threads, most
+    recently started runnable first, and a thread that runs out of work takes
+    the oldest runnables from the queues of the other threads.
+
+    Runnables started with a non-default priority, and runnables started from
+    threads that do not belong to the pool, always use the shared queue. A
+    thread prefers runnables from the shared queue whose priority is higher
+    than the default one over the runnables in its own queue.
+
+    \sa workStealingEnabled(), start()
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.storeRelaxed(enabled);
+}
+
+/*!
+    \since 6.4
+
+    Returns \c true if work stealing is enabled for this thread pool.
+
+    \sa setWorkStealingEnabled()
+*/
+bool QThreadPool::workStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.loadRelaxed();
+}
+
 /*!
     \since 5.2
 
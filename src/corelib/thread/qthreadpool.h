@@ -61,6 +61,7 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
     Q_PROPERTY(QThread::Priority threadPriority READ threadPriority WRITE setThreadPriority)
+    Q_PROPERTY(QList<int> cpuAffinity READ cpuAffinity WRITE setCpuAffinity)
     friend class QFutureInterfaceBase;
 
 public:
@@ -92,9 +93,15 @@ public:
     void setThreadPriority(QThread::Priority priority);
     QThread::Priority threadPriority() const;
 
+    void setCpuAffinity(const QList<int> &cpus);
+    QList<int> cpuAffinity() const;
+
     void reserveThread();
     void releaseThread();
 
+    void setWorkStealingEnabled(bool enabled);
+    bool workStealingEnabled() const;
+
     bool waitForDone(int msecs = -1);
 
     void clear();
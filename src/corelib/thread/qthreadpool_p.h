@@ -73,18 +73,22 @@ public:
         MaxPageSize = 256
     };
 
-    QueuePage(QRunnable *runnable, int pri) : m_priority(pri) { push(runnable); }
+    QueuePage(QRunnable *runnable, int pri, qint64 enqueuedAt) : m_priority(pri)
+    { push(runnable, enqueuedAt); }
 
     bool isFull() { return m_lastIndex >= MaxPageSize - 1; }
 
-    bool isFinished() { return m_firstIndex > m_lastIndex; }
+    bool isFinished() const { return m_firstIndex > m_lastIndex; }
 
-    void push(QRunnable *runnable)
+    // enqueuedAt is the QCoreMetrics::timestamp() of the push, or 0 when
+    // metrics are disabled
+    void push(QRunnable *runnable, qint64 enqueuedAt)
     {
         Q_ASSERT(runnable != nullptr);
         Q_ASSERT(!isFull());
         m_lastIndex += 1;
         m_entries[m_lastIndex] = runnable;
+        m_enqueuedAt[m_lastIndex] = enqueuedAt;
     }
 
     void skipToNextOrEnd()
@@ -102,6 +106,15 @@ public:
         return runnable;
     }
 
+    qint64 firstEnqueuedAt() const
+    {
+        Q_ASSERT(!isFinished());
+        return m_enqueuedAt[m_firstIndex];
+    }
+
+    // including the entries removed by tryTake()
+    int size() const { return m_lastIndex - m_firstIndex + 1; }
+
     QRunnable *pop()
     {
         Q_ASSERT(!isFinished());
@@ -141,6 +154,7 @@ private:
     int m_firstIndex = 0;
     int m_lastIndex = -1;
     QRunnable *m_entries[MaxPageSize];
+    qint64 m_enqueuedAt[MaxPageSize];
 };
 
 class QThreadPoolThread;
@@ -169,6 +183,11 @@ public:
     void clear();
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
+    void updateQueuedPriority();
+
+    bool pushLocalTask(QRunnable *task);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    void flushLocalQueue(QThreadPoolThread *thread);
 
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
@@ -184,6 +203,12 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+    QList<int> cpuAffinity;
+
+    // Read without holding the mutex by the work-stealing fast paths.
+    QAtomicInt workStealing;            // bool
+    QAtomicInt saturated;               // bool, all threads were busy when last checked
+    QAtomicInt highestQueuedPriority = std::numeric_limits<int>::min(); // of queue.first()
 };
 
 QT_END_NAMESPACE
@@ -5044,6 +5044,108 @@ QDateTime QDateTime::fromSecsSinceEpoch(qint64 secs, const QTimeZone &timeZone)
     \sa toString(), QLocale::toDateTime()
 */
 
+template <typename Char>
+static bool readAsciiDigits(const Char *text, qsizetype count, int *value)
+{
+    int result = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const char16_t ch = char16_t(text[i]);
+        if (ch < u'0' || ch > u'9')
+            return false;
+        result = result * 10 + (ch - u'0');
+    }
+    *value = result;
+    return true;
+}
+
+/*
+    \internal
+
+    Parses the canonical ISO 8601 form produced by toString(Qt::ISODate) and
+    toString(Qt::ISODateWithMs), yyyy-MM-ddTHH:mm[:ss[.zzz]] optionally followed
+    by Z or [+-]HH[[:]mm], without allocating.  Returns false for anything else,
+    leaving the general code in fromString() to parse (or reject) it.
+*/
+template <typename Char>
+static bool fromCanonicalIsoString(const Char *text, qsizetype size, QDateTime *result)
+{
+    if (size < 16)
+        return false;
+
+    int year, month, day, hour, minute, second = 0, msec = 0;
+    if (!readAsciiDigits(text, 4, &year) || text[4] != '-'
+        || !readAsciiDigits(text + 5, 2, &month) || text[7] != '-'
+        || !readAsciiDigits(text + 8, 2, &day)) {
+        return false;
+    }
+    if (text[10] != 'T' && text[10] != 't' && text[10] != ' ')
+        return false;
+    if (!readAsciiDigits(text + 11, 2, &hour) || text[13] != ':'
+        || !readAsciiDigits(text + 14, 2, &minute)) {
+        return false;
+    }
+
+    qsizetype pos = 16;
+    if (pos < size && text[pos] == ':') {
+        if (size - pos < 3 || !readAsciiDigits(text + pos + 1, 2, &second))
+            return false;
+        pos += 3;
+        if (pos < size && text[pos] == '.') {
+            ++pos;
+            qsizetype digits = 0;
+            while (digits < 4 && pos + digits < size
+                   && text[pos + digits] >= '0' && text[pos + digits] <= '9') {
+                ++digits;
+            }
+            // More digits need rounding, which the general code takes care of
+            if (digits == 0 || digits > 3)
+                return false;
+            readAsciiDigits(text + pos, digits, &msec);
+            for (qsizetype i = digits; i < 3; ++i)
+                msec *= 10;
+            pos += digits;
+        }
+    }
+
+    Qt::TimeSpec spec = Qt::LocalTime;
+    int offset = 0;
+    if (pos < size) {
+        const Char sign = text[pos];
+        if ((sign == 'Z' || sign == 'z') && pos + 1 == size) {
+            spec = Qt::UTC;
+        } else if (sign == '+' || sign == '-') {
+            const qsizetype length = size - pos - 1;
+            int offsetHours, offsetMinutes = 0;
+            if (length < 2 || !readAsciiDigits(text + pos + 1, 2, &offsetHours))
+                return false;
+            if (length == 5 && text[pos + 3] == ':') {
+                if (!readAsciiDigits(text + pos + 4, 2, &offsetMinutes))
+                    return false;
+            } else if (length == 4) {
+                if (!readAsciiDigits(text + pos + 3, 2, &offsetMinutes))
+                    return false;
+            } else if (length != 2) {
+                return false;
+            }
+            if (offsetHours > 23 || offsetMinutes > 59)
+                return false;
+            offset = (sign == '-' ? -60 : 60) * (offsetHours * 60 + offsetMinutes);
+            spec = Qt::OffsetFromUTC;
+        } else {
+            return false;
+        }
+    }
+
+    // 24:00 and out-of-range fields are left to the general code
+    if (year == 0 || hour > 23 || minute > 59 || second > 59)
+        return false;
+    const QDate date(year, month, day);
+    if (!date.isValid())
+        return false;
+    *result = QDateTime(date, QTime(hour, minute, second, msec), spec, offset);
+    return true;
+}
+
 /*!
     \overload
     \since 6.0
@@ -5066,6 +5168,10 @@ QDateTime QDateTime::fromString(QStringView string, Qt::DateFormat format)
     }
     case Qt::ISODate:
     case Qt::ISODateWithMs: {
+        QDateTime result;
+        if (fromCanonicalIsoString(string.utf16(), string.size(), &result))
+            return result;
+
         const int size = string.size();
         if (size < 10)
             return QDateTime();
@@ -5186,6 +5292,31 @@ QDateTime QDateTime::fromString(QStringView string, Qt::DateFormat format)
     return QDateTime();
 }
 
+// in qstring.cpp:
+void qt_from_latin1(char16_t *dst, const char *str, size_t size) noexcept;
+
+/*!
+    \overload
+    \since 6.4
+
+    Parses the Latin-1 \a string according to \a format. Date-times in the
+    form produced by toString(Qt::ISODate) and toString(Qt::ISODateWithMs) are
+    parsed directly from \a string, without converting it to UTF-16 first,
+    which makes this overload well suited to reading time stamps from files or
+    network protocols.
+*/
+QDateTime QDateTime::fromString(QLatin1String string, Qt::DateFormat format)
+{
+    if (format == Qt::ISODate || format == Qt::ISODateWithMs) {
+        QDateTime result;
+        if (fromCanonicalIsoString(string.data(), string.size(), &result))
+            return result;
+    }
+    QVarLengthArray<char16_t, 64> buffer(string.size());
+    qt_from_latin1(buffer.data(), string.data(), size_t(string.size()));
+    return fromString(QStringView(buffer.data(), buffer.size()), format);
+}
+
 /*!
     \fn QDateTime QDateTime::fromString(const QString &string, const QString &format, QCalendar cal)
 
@@ -348,6 +348,7 @@ public:
     static QDateTime currentDateTimeUtc();
 #if QT_CONFIG(datestring)
     static QDateTime fromString(QStringView string, Qt::DateFormat format = Qt::TextDate);
+    static QDateTime fromString(QLatin1String string, Qt::DateFormat format = Qt::TextDate);
     static QDateTime fromString(QStringView string, QStringView format,
                                 QCalendar cal = QCalendar())
     { return fromString(string.toString(), format, cal); }
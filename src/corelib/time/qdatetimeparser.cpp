@@ -464,6 +464,48 @@ static inline void appendSeparator(QStringList *list, QStringView string,
     list->append(lastQuote >= from ? unquote(separator) : separator.toString());
 }
 
+namespace {
+// QDate/QTime/QDateTime::fromString() create a new parser for every call, so
+// code parsing many strings in one format would re-parse the format each time.
+// Remember the last few formats parsed on each thread; the result depends only
+// on the format and parser type when parsing from strings.
+struct ParsedFormat
+{
+    QString format;
+    QMetaType::Type parserType = QMetaType::UnknownType;
+    QList<QDateTimeParser::SectionNode> sectionNodes;
+    QStringList separators;
+    QDateTimeParser::Sections display;
+};
+
+struct ParsedFormatCache
+{
+    static constexpr int Size = 4;
+    ParsedFormat entries[Size];
+    int next = 0;
+
+    const ParsedFormat *find(QStringView format, QMetaType::Type type) const
+    {
+        for (const ParsedFormat &entry : entries) {
+            if (entry.parserType == type && entry.format == format)
+                return &entry;
+        }
+        return nullptr;
+    }
+    void insert(ParsedFormat &&entry)
+    {
+        entries[next] = std::move(entry);
+        next = (next + 1) % Size;
+    }
+};
+
+ParsedFormatCache &parsedFormatCache()
+{
+    static thread_local ParsedFormatCache cache;
+    return cache;
+}
+} // unnamed namespace
+
 /*!
     \internal
 
@@ -478,6 +520,19 @@ bool QDateTimeParser::parseFormat(QStringView newFormat)
     if (newFormat == displayFormat && !newFormat.isEmpty())
         return true;
 
+    if (context == FromString) {
+        if (const ParsedFormat *cached = parsedFormatCache().find(newFormat, parserType)) {
+            displayFormat = cached->format;
+            separators = cached->separators;
+            // SectionNode::pos is updated while parsing, so don't share the list
+            sectionNodes = QList<SectionNode>(cached->sectionNodes.cbegin(),
+                                              cached->sectionNodes.cend());
+            display = cached->display;
+            last.pos = -1;
+            return true;
+        }
+    }
+
     QDTPDEBUGN("parseFormat: %s", newFormat.toLatin1().constData());
 
     QList<SectionNode> newSectionNodes;
@@ -638,6 +693,11 @@ bool QDateTimeParser::parseFormat(QStringView newFormat)
     sectionNodes = newSectionNodes;
     display = newDisplay;
     last.pos = -1;
+    if (context == FromString) {
+        parsedFormatCache().insert({ displayFormat, parserType,
+                                     QList<SectionNode>(sectionNodes.cbegin(), sectionNodes.cend()),
+                                     separators, display });
+    }
 
 //     for (int i=0; i<sectionNodes.size(); ++i) {
 //         QDTPDEBUG << sectionNodes.at(i).name() << sectionNodes.at(i).count;
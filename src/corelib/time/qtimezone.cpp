@@ -618,6 +618,34 @@ int QTimeZone::offsetFromUtc(const QDateTime &atDateTime) const
     return 0;
 }
 
+/*!
+    \since 6.4
+
+    Returns the total effective offset from UTC, in seconds, at each of the
+    moments in \a atMSecsSinceEpoch, given as milliseconds since the start of
+    1970 UTC. Each entry of the result is what offsetFromUtc() returns for the
+    corresponding moment.
+
+    This is the fastest way to convert a large number of timestamps: moments
+    close to each other, in particular sorted ones, share most of the work of
+    looking up the offset.
+
+    \sa offsetFromUtc()
+*/
+QList<int> QTimeZone::offsetsFromUtc(const QList<qint64> &atMSecsSinceEpoch) const
+{
+    QList<int> offsets(atMSecsSinceEpoch.size(), 0);
+    if (!isValid())
+        return offsets;
+
+    d->offsetsFromUtc(atMSecsSinceEpoch.constData(), offsets.data(), offsets.size());
+    for (int &offset : offsets) {
+        if (offset == QTimeZonePrivate::invalidSeconds())
+            offset = 0;
+    }
+    return offsets;
+}
+
 /*!
     Returns the standard time offset at the given \a atDateTime, i.e. the
     number of seconds to add to UTC to obtain the local Standard Time.  This
@@ -126,6 +126,7 @@ public:
     QString abbreviation(const QDateTime &atDateTime) const;
 
     int offsetFromUtc(const QDateTime &atDateTime) const;
+    QList<int> offsetsFromUtc(const QList<qint64> &atMSecsSinceEpoch) const;
     int standardTimeOffset(const QDateTime &atDateTime) const;
     int daylightTimeOffset(const QDateTime &atDateTime) const;
 
@@ -173,6 +173,15 @@ int QTimeZonePrivate::offsetFromUtc(qint64 atMSecsSinceEpoch) const
     return std == bad || dst == bad ? bad : std + dst;
 }
 
+// Fills offsets with offsetFromUtc() for each of the count moments; backends
+// override this when they can answer runs of nearby moments more cheaply
+void QTimeZonePrivate::offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                      qsizetype count) const
+{
+    for (qsizetype i = 0; i < count; ++i)
+        offsets[i] = offsetFromUtc(atMSecsSinceEpoch[i]);
+}
+
 int QTimeZonePrivate::standardTimeOffset(qint64 atMSecsSinceEpoch) const
 {
     Q_UNUSED(atMSecsSinceEpoch);
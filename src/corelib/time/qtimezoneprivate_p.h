@@ -113,6 +113,8 @@ public:
     virtual QString abbreviation(qint64 atMSecsSinceEpoch) const;
 
     virtual int offsetFromUtc(qint64 atMSecsSinceEpoch) const;
+    virtual void offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                qsizetype count) const;
     virtual int standardTimeOffset(qint64 atMSecsSinceEpoch) const;
     virtual int daylightTimeOffset(qint64 atMSecsSinceEpoch) const;
 
@@ -329,6 +331,8 @@ public:
     QString abbreviation(qint64 atMSecsSinceEpoch) const override;
 
     int offsetFromUtc(qint64 atMSecsSinceEpoch) const override;
+    void offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                        qsizetype count) const override;
     int standardTimeOffset(qint64 atMSecsSinceEpoch) const override;
     int daylightTimeOffset(qint64 atMSecsSinceEpoch) const override;
 
@@ -348,6 +352,16 @@ public:
     QList<QByteArray> availableTimeZoneIds(QLocale::Territory territory) const override;
 
 private:
+    // The offsets data() reports at a moment, and the range of moments,
+    // from inclusive to exclusive, over which they stay the same
+    struct OffsetRange {
+        qint64 from;
+        qint64 to;
+        int standardTimeOffset;
+        int daylightTimeOffset;
+    };
+    OffsetRange offsetRange(qint64 forMSecsSinceEpoch) const;
+
     static QByteArray staticSystemTimeZoneId();
     QList<QTimeZonePrivate::Data> getPosixTransitions(qint64 msNear) const;
 
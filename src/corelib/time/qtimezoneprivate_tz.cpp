@@ -1088,18 +1088,39 @@ QString QTzTimeZonePrivate::abbreviation(qint64 atMSecsSinceEpoch) const
 
 int QTzTimeZonePrivate::offsetFromUtc(qint64 atMSecsSinceEpoch) const
 {
-    const QTimeZonePrivate::Data tran = data(atMSecsSinceEpoch);
-    return tran.offsetFromUtc; // == tran.standardTimeOffset + tran.daylightTimeOffset
+    const OffsetRange range = offsetRange(atMSecsSinceEpoch);
+    if (range.standardTimeOffset == invalidSeconds())
+        return range.standardTimeOffset;
+    return range.standardTimeOffset + range.daylightTimeOffset;
+}
+
+void QTzTimeZonePrivate::offsetsFromUtc(const qint64 *atMSecsSinceEpoch, int *offsets,
+                                        qsizetype count) const
+{
+    // Nearby moments usually share their offsets, so only look up a new
+    // range when leaving the current one:
+    OffsetRange range = { 0, 0, 0, 0 };
+    int offset = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 at = atMSecsSinceEpoch[i];
+        if (at < range.from || at >= range.to) {
+            range = offsetRange(at);
+            offset = range.standardTimeOffset == invalidSeconds()
+                    ? range.standardTimeOffset
+                    : range.standardTimeOffset + range.daylightTimeOffset;
+        }
+        offsets[i] = offset;
+    }
 }
 
 int QTzTimeZonePrivate::standardTimeOffset(qint64 atMSecsSinceEpoch) const
 {
-    return data(atMSecsSinceEpoch).standardTimeOffset;
+    return offsetRange(atMSecsSinceEpoch).standardTimeOffset;
 }
 
 int QTzTimeZonePrivate::daylightTimeOffset(qint64 atMSecsSinceEpoch) const
 {
-    return data(atMSecsSinceEpoch).daylightTimeOffset;
+    return offsetRange(atMSecsSinceEpoch).daylightTimeOffset;
 }
 
 bool QTzTimeZonePrivate::hasDaylightTime() const
@@ -1124,12 +1145,133 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::dataFromRule(QTzTransitionRule rule,
              msecsSinceEpoch, rule.stdOffset + rule.dstOffset, rule.stdOffset, rule.dstOffset };
 }
 
+namespace {
+// The transitions of a POSIX rule around a given year, shared between all
+// zones (and all instances of a zone) using the same rule, so that they are
+// not recomputed for every query
+class QTzPosixTransitionCache
+{
+public:
+    struct Key {
+        QByteArray posixRule;
+        qint64 lastTranMSecs;
+        int year;
+
+        friend bool operator==(const Key &lhs, const Key &rhs) noexcept
+        {
+            return lhs.year == rhs.year && lhs.lastTranMSecs == rhs.lastTranMSecs
+                    && lhs.posixRule == rhs.posixRule;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.posixRule, key.lastTranMSecs, key.year);
+        }
+    };
+
+    QList<QTimeZonePrivate::Data> fetch(const Key &key);
+
+private:
+    QCache<Key, QList<QTimeZonePrivate::Data>> m_cache{256};
+    QMutex m_mutex;
+};
+
+QList<QTimeZonePrivate::Data> QTzPosixTransitionCache::fetch(const Key &key)
+{
+    const auto locker = qt_scoped_lock(m_mutex);
+    if (const auto *transitions = m_cache.object(key))
+        return *transitions;
+
+    const auto transitions = calculatePosixTransitions(key.posixRule, key.year - 1,
+                                                       key.year + 1, key.lastTranMSecs);
+    m_cache.insert(key, new QList<QTimeZonePrivate::Data>(transitions));
+    return transitions;
+}
+} // unnamed namespace
+
 QList<QTimeZonePrivate::Data> QTzTimeZonePrivate::getPosixTransitions(qint64 msNear) const
 {
-    const int year = QDateTime::fromMSecsSinceEpoch(msNear, Qt::UTC).date().year();
+    constexpr qint64 MSECS_PER_DAY = 86400000LL;
+    constexpr qint64 JULIAN_DAY_FOR_EPOCH = 2440588LL; // result of julianDayFromDate(1970, 1, 1)
+    qint64 days = msNear / MSECS_PER_DAY;
+    if (msNear % MSECS_PER_DAY < 0)
+        --days;
+    const int year = QDate::fromJulianDay(days + JULIAN_DAY_FOR_EPOCH).year();
+    static QTzPosixTransitionCache posixCache;
+    if (!tranCache().isEmpty())
+        return posixCache.fetch({ cached_data.m_posixRule, tranCache().last().atMSecsSinceEpoch, year });
+
     // The Data::atMSecsSinceEpoch of the single entry if zone is constant:
-    qint64 atTime = tranCache().isEmpty() ? msNear : tranCache().last().atMSecsSinceEpoch;
-    return calculatePosixTransitions(cached_data.m_posixRule, year - 1, year + 1, atTime);
+    auto transitions = posixCache.fetch({ cached_data.m_posixRule, invalidMSecs(), year });
+    if (transitions.size() == 1)
+        transitions.first().atMSecsSinceEpoch = msNear;
+    return transitions;
+}
+
+QTzTimeZonePrivate::OffsetRange QTzTimeZonePrivate::offsetRange(qint64 forMSecsSinceEpoch) const
+{
+    // This follows data(), below, but avoids building the abbreviation
+    const qint64 next = forMSecsSinceEpoch < maxMSecs() ? forMSecsSinceEpoch + 1 : forMSecsSinceEpoch;
+    OffsetRange range = { forMSecsSinceEpoch, next, 0, 0 };
+    bool found = false;
+    if (!cached_data.m_posixRule.isEmpty()
+        && (tranCache().isEmpty() || tranCache().last().atMSecsSinceEpoch < forMSecsSinceEpoch)) {
+        const QList<QTimeZonePrivate::Data> posixTrans = getPosixTransitions(forMSecsSinceEpoch);
+        auto it = std::partition_point(posixTrans.cbegin(), posixTrans.cend(),
+                                       [forMSecsSinceEpoch] (const QTimeZonePrivate::Data &at) {
+                                           return at.atMSecsSinceEpoch <= forMSecsSinceEpoch;
+                                       });
+        if (it > posixTrans.cbegin() || (tranCache().isEmpty() && it < posixTrans.cend())) {
+            const QTimeZonePrivate::Data &data = *(it > posixTrans.cbegin() ? it - 1 : it);
+            range.standardTimeOffset = data.standardTimeOffset;
+            range.daylightTimeOffset = data.daylightTimeOffset;
+            if (posixTrans.size() == 1) {
+                // the rule describes a constant offset
+                range.from = minMSecs();
+                range.to = maxMSecs();
+            } else if (it > posixTrans.cbegin() && it < posixTrans.cend()) {
+                range.from = (it - 1)->atMSecsSinceEpoch;
+                range.to = it->atMSecsSinceEpoch;
+            }
+            // the rule only applies after the last transition
+            if (!tranCache().isEmpty())
+                range.from = qMax(range.from, tranCache().last().atMSecsSinceEpoch + 1);
+            found = true;
+        }
+    }
+    if (!found) {
+        if (tranCache().isEmpty()) { // Only possible if !isValid()
+            range.standardTimeOffset = range.daylightTimeOffset = int(invalidSeconds());
+            return range;
+        }
+
+        auto last = std::partition_point(tranCache().cbegin(), tranCache().cend(),
+                                         [forMSecsSinceEpoch] (const QTzTransitionTime &at) {
+                                             return at.atMSecsSinceEpoch <= forMSecsSinceEpoch;
+                                         });
+        QTzTransitionRule rule;
+        if (last == tranCache().cbegin()) {
+            rule = cached_data.m_preZoneRule;
+            range.from = minMSecs();
+        } else {
+            rule = cached_data.m_tranRules.at((last - 1)->ruleIndex);
+            range.from = (last - 1)->atMSecsSinceEpoch;
+        }
+        if (last != tranCache().cend())
+            range.to = last->atMSecsSinceEpoch;
+        else if (cached_data.m_posixRule.isEmpty())
+            range.to = maxMSecs();
+        else
+            range.to = tranCache().last().atMSecsSinceEpoch + 1;
+        range.standardTimeOffset = rule.stdOffset;
+        range.daylightTimeOffset = rule.dstOffset;
+    }
+
+    // Never claim more than we know to hold for the moment asked about
+    if (forMSecsSinceEpoch < range.from || forMSecsSinceEpoch >= range.to) {
+        range.from = forMSecsSinceEpoch;
+        range.to = next;
+    }
+    return range;
 }
 
 QTimeZonePrivate::Data QTzTimeZonePrivate::data(qint64 forMSecsSinceEpoch) const
@@ -39,6 +39,7 @@
 ****************************************************************************/
 
 #include <QtCore/qarraydata.h>
+#include <QtCore/private/qarraydataallocator_p.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
 #include <QtCore/qmath.h>
@@ -47,6 +48,15 @@
 #include <QtCore/qstring.h>  // QString::value_type
 
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(Q_OS_LINUX)
+#  include <sys/mman.h>
+#  include <unistd.h>
+#  if defined(MREMAP_MAYMOVE)
+#    define QT_ARRAYDATA_USE_MMAP
+#  endif
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -173,9 +183,205 @@ static inline qsizetype calculateBlockSize(qsizetype &capacity, qsizetype object
     }
 }
 
+/*!
+    \class QArrayDataAllocator
+    \inmodule QtCore
+    \internal
+    \since 6.4
+
+    \brief Supplies the memory of QArrayData-backed containers.
+
+    While a QArrayDataAllocator::Scope is alive, the QByteArray, QString and
+    QList storage allocated by its thread comes from the allocator, for
+    instance from an arena or a per-thread pool. Blocks remember their
+    allocator: they are grown and freed through it from any thread and after
+    the scope has ended, so the allocator must outlive them. Blocks must be
+    aligned like those returned by malloc().
+*/
+
+QArrayDataAllocator::~QArrayDataAllocator()
+    = default;
+
+static QBasicAtomicInt activeAllocatorScopes = Q_BASIC_ATOMIC_INITIALIZER(0);
+static thread_local QArrayDataAllocator *scopedAllocator = nullptr;
+
+/*!
+    Makes \a allocator supply the QArrayData blocks allocated by the current
+    thread until this object is destroyed. Scopes nest; \nullptr restores
+    the use of malloc().
+*/
+QArrayDataAllocator::Scope::Scope(QArrayDataAllocator *allocator)
+    : previous(scopedAllocator)
+{
+    scopedAllocator = allocator;
+    activeAllocatorScopes.ref();
+}
+
+QArrayDataAllocator::Scope::~Scope()
+{
+    scopedAllocator = previous;
+    activeAllocatorScopes.deref();
+}
+
+static inline QArrayDataAllocator *currentAllocator() noexcept
+{
+    return activeAllocatorScopes.loadRelaxed() ? scopedAllocator : nullptr;
+}
+
+#ifdef QT_ARRAYDATA_USE_MMAP
+namespace {
+// Maps blocks of MappingThreshold bytes and above directly, so that growing
+// them remaps pages instead of copying and the kernel can back them with huge
+// pages. Smaller blocks come from malloc(). The size passed back on
+// reallocation and deallocation tells which kind a block is.
+class MappingAllocator final : public QArrayDataAllocator
+{
+public:
+    static constexpr size_t MappingThreshold = 2 * 1024 * 1024;
+
+    void *allocate(size_t size) override
+    {
+        return size < MappingThreshold ? ::malloc(size) : map(size);
+    }
+
+    void *reallocate(void *block, size_t oldSize, size_t newSize) override
+    {
+        const bool wasMapped = oldSize >= MappingThreshold;
+        const bool mapped = newSize >= MappingThreshold;
+        if (!wasMapped && !mapped)
+            return ::realloc(block, newSize);
+        if (wasMapped && mapped) {
+            void *result = mremap(block, mappedSize(oldSize), mappedSize(newSize), MREMAP_MAYMOVE);
+            if (result == MAP_FAILED)
+                return nullptr;
+            adviseHugePages(result, mappedSize(newSize));
+            return result;
+        }
+        void *result = allocate(newSize);
+        if (result) {
+            ::memcpy(result, block, qMin(oldSize, newSize));
+            deallocate(block, oldSize);
+        }
+        return result;
+    }
+
+    void deallocate(void *block, size_t size) override
+    {
+        if (size < MappingThreshold)
+            ::free(block);
+        else
+            munmap(block, mappedSize(size));
+    }
+
+private:
+    static size_t mappedSize(size_t size) noexcept
+    {
+        const size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+        return (size + pageSize - 1) & ~(pageSize - 1);
+    }
+
+    static void adviseHugePages(void *block, size_t size) noexcept
+    {
+#ifdef MADV_HUGEPAGE
+        madvise(block, size, MADV_HUGEPAGE);
+#else
+        Q_UNUSED(block);
+        Q_UNUSED(size);
+#endif
+    }
+
+    static void *map(size_t size) noexcept
+    {
+        size = mappedSize(size);
+        void *block = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block == MAP_FAILED)
+            return nullptr;
+        adviseHugePages(block, size);
+        return block;
+    }
+};
+}
+#endif
+
+/*!
+    Returns an allocator that maps blocks of 2 MiB and above directly from
+    the operating system, so that growing them does not copy, and takes
+    smaller blocks from malloc(). Returns \nullptr if the platform cannot
+    remap memory; a scope of \nullptr uses malloc() for all blocks.
+
+    Mapping costs a system call per allocation, which only pays off for
+    buffers that grow large and live long, so it has to be enabled with a
+    QArrayDataAllocator::Scope.
+*/
+QArrayDataAllocator *QArrayDataAllocator::mappingAllocator()
+{
+#ifdef QT_ARRAYDATA_USE_MMAP
+    // leaked: blocks may still be freed after static destructors have run
+    static MappingAllocator *allocator = new MappingAllocator;
+    return allocator;
+#else
+    return nullptr;
+#endif
+}
+
+namespace {
+// Blocks from a QArrayDataAllocator start with this prefix, and their header
+// is placed half way between two multiples of alignof(std::max_align_t).
+// malloc() never returns such an address, so the header's address tells
+// whether a block has the prefix, no matter what code inlined from older
+// headers wrote into QArrayData::flags.
+struct ExternalBlockPrefix
+{
+    QArrayDataAllocator *allocator;
+    size_t size;
+};
+
+constexpr size_t MallocAlignment = alignof(std::max_align_t);
+constexpr size_t ExternalHeaderOffset =
+        (sizeof(ExternalBlockPrefix) + MallocAlignment - 1) / MallocAlignment * MallocAlignment
+        + MallocAlignment / 2;
+// moving the header by half of MallocAlignment may need as much padding
+// in front of the data
+constexpr size_t ExternalBlockOverhead = ExternalHeaderOffset + MallocAlignment / 2;
+
+static_assert(alignof(QArrayData) <= MallocAlignment / 2);
+static_assert(alignof(ExternalBlockPrefix) <= MallocAlignment / 2);
+}
+
+static inline bool isExternalBlock(const QArrayData *header) noexcept
+{
+    return quintptr(header) % MallocAlignment != 0;
+}
+
+static inline char *externalBlockStart(QArrayData *header) noexcept
+{
+    return reinterpret_cast<char *>(header) - ExternalHeaderOffset;
+}
+
+static inline ExternalBlockPrefix *externalBlockPrefix(QArrayData *header) noexcept
+{
+    return reinterpret_cast<ExternalBlockPrefix *>(
+            reinterpret_cast<char *>(header) - sizeof(ExternalBlockPrefix));
+}
+
+static QArrayData *placeExternalHeader(void *block, QArrayDataAllocator *allocator, size_t size)
+{
+    Q_ASSERT(quintptr(block) % MallocAlignment == 0);
+    auto header = reinterpret_cast<QArrayData *>(static_cast<char *>(block) + ExternalHeaderOffset);
+    *externalBlockPrefix(header) = { allocator, size };
+    return header;
+}
+
 static QArrayData *allocateData(qsizetype allocSize)
 {
-    QArrayData *header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    QArrayData *header = nullptr;
+    if (QArrayDataAllocator *allocator = currentAllocator()) {
+        const size_t size = size_t(allocSize) + ExternalBlockOverhead;
+        if (void *block = allocator->allocate(size))
+            header = placeExternalHeader(block, allocator, size);
+    } else {
+        header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    }
     if (header) {
         header->ref_.storeRelaxed(1);
         header->flags = {};
@@ -184,7 +390,6 @@ static QArrayData *allocateData(qsizetype allocSize)
     return header;
 }
 
-
 namespace {
 // QArrayData with strictest alignment requirements supported by malloc()
 struct alignas(std::max_align_t) AlignedQArrayData : QArrayData
@@ -257,7 +462,17 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
     if (Q_UNLIKELY(allocSize < 0))  // handle overflow. cannot reallocate reliably
         return qMakePair(data, dataPointer);
 
-    QArrayData *header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    QArrayData *header = nullptr;
+    if (!data) {
+        header = allocateData(allocSize);
+    } else if (isExternalBlock(data)) {
+        const ExternalBlockPrefix prefix = *externalBlockPrefix(data);
+        const size_t size = size_t(allocSize) + ExternalBlockOverhead;
+        if (void *block = prefix.allocator->reallocate(externalBlockStart(data), prefix.size, size))
+            header = placeExternalHeader(block, prefix.allocator, size);
+    } else {
+        header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    }
     if (header) {
         header->alloc = capacity;
         dataPointer = reinterpret_cast<char *>(header) + offset;
@@ -276,7 +491,12 @@ void QArrayData::deallocate(QArrayData *data, qsizetype objectSize,
     Q_UNUSED(objectSize);
     Q_UNUSED(alignment);
 
-    ::free(data);
+    if (isExternalBlock(data)) {
+        const ExternalBlockPrefix prefix = *externalBlockPrefix(data);
+        prefix.allocator->deallocate(externalBlockStart(data), prefix.size);
+    } else {
+        ::free(data);
+    }
 }
 
 QT_END_NAMESPACE
@@ -43,10 +43,90 @@
 #include <qdatastream.h>
 #include <qdebug.h>
 #include <qendian.h>
+#include <private/qsimd_p.h>
 #include <string.h>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+enum class BitwiseOp { And, Or, Xor };
+
+template <BitwiseOp Op, typename T>
+inline T bitwiseOp(T a, T b) noexcept
+{
+    if constexpr (Op == BitwiseOp::And)
+        return a & b;
+    else if constexpr (Op == BitwiseOp::Or)
+        return a | b;
+    else
+        return a ^ b;
+}
+
+// Applies Op to the n bytes at dst and src, storing the result in dst.
+template <BitwiseOp Op>
+void bitwiseOp(uchar *dst, const uchar *src, qsizetype n) noexcept
+{
+    qsizetype i = 0;
+#if defined(__AVX2__)
+    for ( ; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i r;
+        if constexpr (Op == BitwiseOp::And)
+            r = _mm256_and_si256(a, b);
+        else if constexpr (Op == BitwiseOp::Or)
+            r = _mm256_or_si256(a, b);
+        else
+            r = _mm256_xor_si256(a, b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), r);
+    }
+#endif
+#if defined(__SSE2__)
+    for ( ; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i r;
+        if constexpr (Op == BitwiseOp::And)
+            r = _mm_and_si128(a, b);
+        else if constexpr (Op == BitwiseOp::Or)
+            r = _mm_or_si128(a, b);
+        else
+            r = _mm_xor_si128(a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), r);
+    }
+#elif defined(__ARM_NEON__)
+    for ( ; i + 16 <= n; i += 16) {
+        const uint8x16_t a = vld1q_u8(dst + i);
+        const uint8x16_t b = vld1q_u8(src + i);
+        uint8x16_t r;
+        if constexpr (Op == BitwiseOp::And)
+            r = vandq_u8(a, b);
+        else if constexpr (Op == BitwiseOp::Or)
+            r = vorrq_u8(a, b);
+        else
+            r = veorq_u8(a, b);
+        vst1q_u8(dst + i, r);
+    }
+#endif
+    for ( ; i + 8 <= n; i += 8)
+        qToUnaligned(bitwiseOp<Op>(qFromUnaligned<quint64>(dst + i), qFromUnaligned<quint64>(src + i)), dst + i);
+    for ( ; i < n; ++i)
+        dst[i] = bitwiseOp<Op>(dst[i], src[i]);
+}
+
+// Counts the set bits in the n bytes at bits
+qsizetype countSetBits(const uchar *bits, qsizetype n) noexcept
+{
+    qsizetype numBits = 0;
+    qsizetype i = 0;
+    for ( ; i + 8 <= n; i += 8)
+        numBits += qsizetype(qPopulationCount(qFromUnaligned<quint64>(bits + i)));
+    for ( ; i < n; ++i)
+        numBits += qsizetype(qPopulationCount(bits[i]));
+    return numBits;
+}
+} // unnamed namespace
+
 /*!
     \class QBitArray
     \inmodule QtCore
@@ -177,32 +257,88 @@ QBitArray::QBitArray(qsizetype size, bool value)
 */
 qsizetype QBitArray::count(bool on) const
 {
-    qsizetype numBits = 0;
-    const quint8 *bits = reinterpret_cast<const quint8 *>(d.data()) + 1;
+    if (isEmpty())
+        return 0;
+    const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+    const qsizetype numBits = countSetBits(bits, d.size() - 1);
+    return on ? numBits : size() - numBits;
+}
+
+/*!
+    \overload
+    \since 6.4
 
-    // the loops below will try to read from *end
-    // it's the QByteArray implicit NUL, so it will not change the bit count
-    const quint8 *const end = reinterpret_cast<const quint8 *>(d.end());
+    If \a on is true, this function returns the number of 1-bits at index
+    positions \a begin up to (but not including) \a end; otherwise the
+    number of 0-bits is returned.
 
-    while (bits + 7 <= end) {
-        quint64 v = qFromUnaligned<quint64>(bits);
-        bits += 8;
-        numBits += qsizetype(qPopulationCount(v));
+    \a begin and \a end must satisfy 0 <= \a begin <= \a end <= size().
+
+    \sa fill(), findNextSet()
+*/
+qsizetype QBitArray::count(bool on, qsizetype begin, qsizetype end) const
+{
+    Q_ASSERT(0 <= begin && begin <= end && end <= size());
+    const qsizetype len = end - begin;
+    qsizetype numBits = 0;
+    while (begin < end && begin & 0x7)
+        numBits += testBit(begin++);
+    if (end - begin >= 8) {
+        const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+        const qsizetype bytes = (end - begin) >> 3;
+        numBits += countSetBits(bits + (begin >> 3), bytes);
+        begin += bytes << 3;
     }
-    if (bits + 3 <= end) {
-        quint32 v = qFromUnaligned<quint32>(bits);
-        bits += 4;
-        numBits += qsizetype(qPopulationCount(v));
+    while (begin < end)
+        numBits += testBit(begin++);
+    return on ? numBits : len - numBits;
+}
+
+/*!
+    \fn qsizetype QBitArray::findFirstSet() const
+    \since 6.4
+
+    Returns the index position of the first 1-bit in the bit array, or -1
+    if no bit is set.
+
+    \sa findNextSet(), count()
+*/
+
+/*!
+    \since 6.4
+
+    Returns the index position of the first 1-bit at or after index
+    position \a from, or -1 if there is none.
+
+    This can be used to iterate over the set bits of a sparse bit array
+    much faster than testing every bit:
+
+    \snippet code/src_corelib_tools_qbitarray.cpp 16
+
+    \sa findFirstSet(), testBit()
+*/
+qsizetype QBitArray::findNextSet(qsizetype from) const
+{
+    if (from < 0)
+        from = 0;
+    if (from >= size())
+        return -1;
+
+    // bits past size() in the last byte are always 0
+    const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+    const qsizetype nbytes = d.size() - 1;
+    qsizetype i = from >> 3;
+    if (const uint first = bits[i] & (0xffU << (from & 7)))
+        return (i << 3) + qCountTrailingZeroBits(first);
+    for (++i; i + 8 <= nbytes; i += 8) {
+        if (const quint64 v = qFromLittleEndian<quint64>(bits + i))
+            return (i << 3) + qCountTrailingZeroBits(v);
     }
-    if (bits + 1 < end) {
-        quint16 v = qFromUnaligned<quint16>(bits);
-        bits += 2;
-        numBits += qsizetype(qPopulationCount(v));
+    for ( ; i < nbytes; ++i) {
+        if (bits[i])
+            return (i << 3) + qCountTrailingZeroBits(uint(bits[i]));
     }
-    if (bits < end)
-        numBits += qsizetype(qPopulationCount(bits[0]));
-
-    return on ? numBits : size() - numBits;
+    return -1;
 }
 
 /*!
@@ -555,14 +691,13 @@ quint32 QBitArray::toUInt32(QSysInfo::Endian endianness, bool *ok) const noexcep
 QBitArray &QBitArray::operator&=(const QBitArray &other)
 {
     resize(qMax(size(), other.size()));
+    if (isEmpty())
+        return *this;
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    qsizetype n = other.d.size() - 1;
-    qsizetype p = d.size() - 1 - n;
-    while (n-- > 0)
-        *a1++ &= *a2++;
-    while (p-- > 0)
-        *a1++ = 0;
+    const qsizetype n = qMax(other.d.size() - 1, qsizetype(0));
+    bitwiseOp<BitwiseOp::And>(a1, a2, n);
+    memset(a1 + n, 0, d.size() - 1 - n);
     return *this;
 }
 
@@ -584,11 +719,11 @@ QBitArray &QBitArray::operator&=(const QBitArray &other)
 QBitArray &QBitArray::operator|=(const QBitArray &other)
 {
     resize(qMax(size(), other.size()));
+    if (other.isEmpty())
+        return *this;
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    qsizetype n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ |= *a2++;
+    bitwiseOp<BitwiseOp::Or>(a1, a2, other.d.size() - 1);
     return *this;
 }
 
@@ -610,11 +745,11 @@ QBitArray &QBitArray::operator|=(const QBitArray &other)
 QBitArray &QBitArray::operator^=(const QBitArray &other)
 {
     resize(qMax(size(), other.size()));
+    if (other.isEmpty())
+        return *this;
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    qsizetype n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ ^= *a2++;
+    bitwiseOp<BitwiseOp::Xor>(a1, a2, other.d.size() - 1);
     return *this;
 }
 
@@ -713,6 +848,18 @@ QBitArray operator^(const QBitArray &a1, const QBitArray &a2)
     return tmp;
 }
 
+/*!
+    \fn QBitArray operator&(QBitArray &&a1, const QBitArray &a2)
+    \fn QBitArray operator|(QBitArray &&a1, const QBitArray &a2)
+    \fn QBitArray operator^(QBitArray &&a1, const QBitArray &a2)
+    \relates QBitArray
+    \overload
+    \since 6.4
+
+    These overloads compute the result in the storage of \a a1 instead
+    of copying it, since \a a1 is a temporary.
+*/
+
 /*!
     \class QBitRef
     \inmodule QtCore
@@ -67,6 +67,7 @@ public:
     inline qsizetype size() const { return (d.size() << 3) - *d.constData(); }
     inline qsizetype count() const { return (d.size() << 3) - *d.constData(); }
     qsizetype count(bool on) const;
+    qsizetype count(bool on, qsizetype begin, qsizetype end) const;
 
     inline bool isEmpty() const { return d.isEmpty(); }
     inline bool isNull() const { return d.isNull(); }
@@ -83,6 +84,9 @@ public:
     void clearBit(qsizetype i);
     bool toggleBit(qsizetype i);
 
+    qsizetype findFirstSet() const { return findNextSet(0); }
+    qsizetype findNextSet(qsizetype from) const;
+
     bool at(qsizetype i) const;
     QBitRef operator[](qsizetype i);
     bool operator[](qsizetype i) const;
@@ -117,6 +121,14 @@ Q_CORE_EXPORT QBitArray operator&(const QBitArray &, const QBitArray &);
 Q_CORE_EXPORT QBitArray operator|(const QBitArray &, const QBitArray &);
 Q_CORE_EXPORT QBitArray operator^(const QBitArray &, const QBitArray &);
 
+// reuse the storage of temporaries instead of copying them
+inline QBitArray operator&(QBitArray &&a1, const QBitArray &a2)
+{ a1 &= a2; return std::move(a1); }
+inline QBitArray operator|(QBitArray &&a1, const QBitArray &a2)
+{ a1 |= a2; return std::move(a1); }
+inline QBitArray operator^(QBitArray &&a1, const QBitArray &a2)
+{ a1 ^= a2; return std::move(a1); }
+
 inline bool QBitArray::testBit(qsizetype i) const
 { Q_ASSERT(size_t(i) < size_t(size()));
  return (*(reinterpret_cast<const uchar*>(d.constData())+1+(i>>3)) & (1 << (i & 7))) != 0; }
@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCONCURRENTCACHE_P_H
+#define QCONCURRENTCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qmutex.h>
+
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QConcurrentCache is a thread-safe variant of QCache. It has the same cost
+  model and ownership semantics: the cache takes ownership of the objects
+  inserted into it and deletes them when they are evicted.
+
+  The keys are split over a number of shards by their hash. Each shard is a
+  QCache of its own, guarded by its own mutex, and evicts the least recently
+  used objects once it exceeds its share of the maximum cost. Threads that
+  access keys in different shards therefore do not contend with each other.
+
+  Since another thread may evict an object at any time, QConcurrentCache
+  does not hand out pointers to the objects it owns. Instead, visit() and
+  visitOrInsert() call a function on the object while the shard is locked.
+  That function must not access the cache itself.
+*/
+
+template <class Key, class T>
+class QConcurrentCache
+{
+    struct alignas(64) Shard // one cache line each, to avoid false sharing
+    {
+        mutable QMutex mutex;
+        QCache<Key, T> cache;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    qsizetype nShards;
+    int shardShift;
+    QAtomicInteger<qsizetype> mx;
+    size_t seed = QHashSeed::globalSeed();
+
+    Shard &shardFor(const Key &key) const noexcept
+    {
+        // QHash picks its buckets from the low bits of the same hash, so use
+        // the high bits here to keep the keys spread within each shard
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        return shards[shardShift < int(sizeof(size_t) * 8) ? hash >> shardShift : 0];
+    }
+    qsizetype shardMaxCost() const noexcept
+    {
+        return (mx.loadRelaxed() + nShards - 1) / nShards;
+    }
+
+    Q_DISABLE_COPY_MOVE(QConcurrentCache)
+
+public:
+    explicit QConcurrentCache(qsizetype maxCost = 100, qsizetype shardCount = 16)
+        : nShards(qsizetype(qNextPowerOfTwo(quint64(qMax(shardCount, qsizetype(1)) - 1)))),
+          shardShift(int(sizeof(size_t) * 8) - qCountTrailingZeroBits(quint64(nShards))),
+          mx(maxCost)
+    {
+        shards.reset(new Shard[nShards]);
+        for (qsizetype i = 0; i < nShards; ++i)
+            shards[i].cache.setMaxCost(shardMaxCost());
+    }
+
+    qsizetype shardCount() const noexcept { return nShards; }
+
+    qsizetype maxCost() const noexcept { return mx.loadRelaxed(); }
+    void setMaxCost(qsizetype m)
+    {
+        // not atomic with respect to concurrent inserts: a shard may briefly
+        // use the old limit
+        mx.storeRelaxed(m);
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            shards[i].cache.setMaxCost(shardMaxCost());
+        }
+    }
+
+    // The following iterate over all shards, so the result is only a
+    // snapshot if other threads modify the cache at the same time.
+    qsizetype totalCost() const
+    {
+        qsizetype total = 0;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            total += shards[i].cache.totalCost();
+        }
+        return total;
+    }
+    qsizetype size() const
+    {
+        qsizetype n = 0;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            n += shards[i].cache.size();
+        }
+        return n;
+    }
+    qsizetype count() const { return size(); }
+    bool isEmpty() const { return size() == 0; }
+    QList<Key> keys() const
+    {
+        QList<Key> k;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            k += shards[i].cache.keys();
+        }
+        return k;
+    }
+    void clear()
+    {
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            shards[i].cache.clear();
+        }
+    }
+
+    bool insert(const Key &key, T *object, qsizetype cost = 1)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        return shard.cache.insert(key, object, cost);
+    }
+    bool contains(const Key &key) const
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        return shard.cache.contains(key);
+    }
+    bool remove(const Key &key)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        return shard.cache.remove(key);
+    }
+    T *take(const Key &key)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        return shard.cache.take(key);
+    }
+
+    // Calls visitor(T &) on the object for key, marking it as recently used.
+    // Returns false if the cache has no object for key.
+    template <typename Visitor>
+    bool visit(const Key &key, Visitor &&visitor)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        T *object = shard.cache.object(key);
+        if (!object)
+            return false;
+        std::forward<Visitor>(visitor)(*object);
+        return true;
+    }
+
+    // Like visit(), but if the cache has no object for key, creates one with
+    // create(), which returns a T * the cache takes ownership of, and
+    // inserts it with the given cost first. Other threads asking for the same
+    // key wait for the object instead of creating it a second time.
+    // Returns false if create() returned nullptr or the object could not be
+    // inserted because cost is too large.
+    template <typename Create, typename Visitor>
+    bool visitOrInsert(const Key &key, Create &&create, Visitor &&visitor, qsizetype cost = 1)
+    {
+        Shard &shard = shardFor(key);
+        QMutexLocker locker(&shard.mutex);
+        T *object = shard.cache.object(key);
+        if (!object) {
+            object = std::forward<Create>(create)();
+            if (!object || !shard.cache.insert(key, object, cost))
+                return false;
+        }
+        std::forward<Visitor>(visitor)(*object);
+        return true;
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTCACHE_P_H
@@ -40,6 +40,7 @@
 
 #include <qcryptographichash.h>
 #include <qiodevice.h>
+#include <private/qsimd_p.h>
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -138,6 +139,185 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 
 QT_BEGIN_NAMESPACE
 
+#if QT_COMPILER_SUPPORTS_HERE(SHA) && !defined(QT_BOOTSTRAPPED)
+#  define QT_CRYPTOGRAPHICHASH_SHANI
+// the SHA extensions operate on SSE registers; the code below also needs
+// SSSE3 (pshufb, palignr) and SSE4.1 (pblendw)
+#  define QT_FUNCTION_TARGET_STRING_SHANI   \
+    QT_FUNCTION_TARGET_STRING_SHA ","       \
+    QT_FUNCTION_TARGET_STRING_SSE4_1
+
+static bool hasShaNi() noexcept
+{
+    constexpr quint64 CpuFeatureSHANI = CpuFeatureSHA | CpuFeatureSSE4_1;
+    return qCpuHasFeature(SHANI);
+}
+
+// Processes the given number of 64-byte blocks into the SHA-1 state
+static QT_FUNCTION_TARGET(SHANI)
+void sha1ProcessBlocksShaNi(Sha1State *state, const uchar *data, qsizetype blocks) noexcept
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    // lanes 3 to 0 hold A to D, and lane 3 of e holds E
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state->h0)), 0x1b);
+    __m128i e = _mm_set_epi32(int(state->h4), 0, 0, 0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abcdSave = abcd;
+        const __m128i eSave = e;
+        __m128i w[4];
+
+        // each iteration does four of the 80 rounds; w[i & 3] holds the
+        // message words for them, computed from the previous four
+        for (int i = 0; i < 20; ++i) {
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), byteSwap);
+            } else {
+                w[i & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w[i & 3], w[(i + 1) & 3]),
+                                                            w[(i + 2) & 3]),
+                                              w[(i + 3) & 3]);
+            }
+            const __m128i eNext = i == 0 ? _mm_add_epi32(e, w[0]) : _mm_sha1nexte_epu32(e, w[i & 3]);
+            e = abcd;
+            switch (i / 5) {
+            case 0: abcd = _mm_sha1rnds4_epu32(abcd, eNext, 0); break;
+            case 1: abcd = _mm_sha1rnds4_epu32(abcd, eNext, 1); break;
+            case 2: abcd = _mm_sha1rnds4_epu32(abcd, eNext, 2); break;
+            default: abcd = _mm_sha1rnds4_epu32(abcd, eNext, 3); break;
+            }
+        }
+
+        e = _mm_sha1nexte_epu32(e, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&state->h0), _mm_shuffle_epi32(abcd, 0x1b));
+    state->h4 = quint32(_mm_extract_epi32(e, 3));
+}
+#endif // QT_COMPILER_SUPPORTS_HERE(SHA)
+
+// Same as sha1Update(), but whole blocks go through the SHA extensions if
+// the CPU has them
+static void sha1Input(Sha1State *state, const unsigned char *data, qint64 len)
+{
+#ifdef QT_CRYPTOGRAPHICHASH_SHANI
+    if (len >= 64 && hasShaNi()) {
+        if (const qint64 rest = state->messageSize & 63) {
+            const qint64 head = qMin(64 - rest, len);
+            sha1Update(state, data, head);
+            data += head;
+            len -= head;
+        }
+        const qint64 blocks = len / 64;
+        sha1ProcessBlocksShaNi(state, data, blocks);
+        state->messageSize += blocks * 64;
+        data += blocks * 64;
+        len -= blocks * 64;
+    }
+#endif
+    sha1Update(state, data, len);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#ifdef QT_CRYPTOGRAPHICHASH_SHANI
+// Processes the given number of 64-byte blocks into the SHA-224/256 state
+static QT_FUNCTION_TARGET(SHANI)
+void sha256ProcessBlocksShaNi(uint32_t hash[8], const uchar *data, qsizetype blocks) noexcept
+{
+    alignas(16) static const quint32 K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // sha256rnds2 wants the state as ABEF and CDGH
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash)), 0xb1);
+    __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hash + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i abefSave = abef;
+        const __m128i cdghSave = cdgh;
+        __m128i w[4];
+
+        // each iteration does four of the 64 rounds; w[i & 3] holds the
+        // message words for them, computed from the previous four
+        for (int i = 0; i < 16; ++i) {
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), byteSwap);
+            } else {
+                __m128i next = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(next, w[(i + 3) & 3]);
+            }
+            __m128i msg = _mm_add_epi32(w[i & 3], _mm_load_si128(reinterpret_cast<const __m128i *>(K + 4 * i)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0e);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, msg);
+        }
+
+        abef = _mm_add_epi32(abef, abefSave);
+        cdgh = _mm_add_epi32(cdgh, cdghSave);
+    }
+
+    tmp = _mm_shuffle_epi32(abef, 0x1b);
+    cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash), _mm_blend_epi16(tmp, cdgh, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hash + 4), _mm_alignr_epi8(cdgh, tmp, 8));
+}
+#endif // QT_CRYPTOGRAPHICHASH_SHANI
+
+// Same as SHA256Input(), which also handles SHA-224, but feeds whole blocks
+// to the compression function directly instead of going through
+// Message_Block one byte at a time
+static void sha256Input(SHA256Context *context, const uchar *data, uint length)
+{
+    if (const uint rest = uint(context->Message_Block_Index)) {
+        const uint head = qMin(SHA256_Message_Block_Size - rest, length);
+        SHA256Input(context, data, head);
+        data += head;
+        length -= head;
+    }
+
+    const uint blocks = length / SHA256_Message_Block_Size;
+    if (blocks && context->Message_Block_Index == 0 && !context->Computed && !context->Corrupted) {
+        // 512 bits per block
+        const quint64 bits = (quint64(context->Length_High) << 32 | context->Length_Low);
+        const quint64 newBits = bits + quint64(blocks) * SHA256_Message_Block_Size * 8;
+        if (newBits < bits) {
+            context->Corrupted = shaInputTooLong;
+            return;
+        }
+        context->Length_High = uint32_t(newBits >> 32);
+        context->Length_Low = uint32_t(newBits);
+
+#ifdef QT_CRYPTOGRAPHICHASH_SHANI
+        if (hasShaNi()) {
+            sha256ProcessBlocksShaNi(context->Intermediate_Hash, data, blocks);
+        } else
+#endif
+        {
+            for (uint i = 0; i < blocks; ++i) {
+                memcpy(context->Message_Block, data + i * SHA256_Message_Block_Size,
+                       SHA256_Message_Block_Size);
+                SHA224_256ProcessMessageBlock(context);
+            }
+        }
+        data += blocks * SHA256_Message_Block_Size;
+        length -= blocks * SHA256_Message_Block_Size;
+    }
+
+    SHA256Input(context, data, length);
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
 static constexpr qsizetype MaxHashLength = 64;
 
 static constexpr int hashLengthInternal(QCryptographicHash::Algorithm method) noexcept
@@ -476,7 +656,7 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
 #endif
         switch (method) {
         case QCryptographicHash::Sha1:
-            sha1Update(&sha1Context, (const unsigned char *)data, length);
+            sha1Input(&sha1Context, (const unsigned char *)data, length);
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
         default:
@@ -491,10 +671,10 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
             MD5Update(&md5Context, (const unsigned char *)data, length);
             break;
         case QCryptographicHash::Sha224:
-            SHA224Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case QCryptographicHash::Sha256:
-            SHA256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case QCryptographicHash::Sha384:
             SHA384Input(&sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -469,8 +469,15 @@ struct BezierEase : public QEasingCurveFunction
         qreal p3x, p3y;
     };
 
+    // Number of evenly spaced x positions for which the curve parameter t is
+    // precomputed. The table only provides the starting guess for a Newton
+    // refinement, so a coarse table is enough.
+    enum { TableResolution = 64 };
+
     QList<SingleCubicBezier> _curves;
     QList<qreal> _intervals;
+    QList<qreal> _tTable;
+    QList<int> _segmentTable;
     int _curveCount;
     bool _init;
     bool _valid;
@@ -528,11 +535,24 @@ struct BezierEase : public QEasingCurveFunction
                 }
             }
             _valid = true;
+            initTable();
         } else {
             _valid = false;
         }
     }
 
+    void initTable()
+    {
+        _tTable.resize(TableResolution + 1);
+        _segmentTable.resize(TableResolution + 1);
+        for (int i = 0; i <= TableResolution; ++i) {
+            const qreal x = qreal(i) / TableResolution;
+            const int segment = segmentIndex(x);
+            _segmentTable[i] = segment;
+            _tTable[i] = findTForX(_curves.at(segment), x);
+        }
+    }
+
     QEasingCurveFunction *copy() const override
     {
         BezierEase *rv = new BezierEase();
@@ -545,9 +565,8 @@ struct BezierEase : public QEasingCurveFunction
         return rv;
     }
 
-    void getBezierSegment(SingleCubicBezier * &singleCubicBezier, qreal x)
+    int segmentIndex(qreal x) const
     {
-
         int currentSegment = 0;
 
         while (currentSegment < _curveCount) {
@@ -556,7 +575,7 @@ struct BezierEase : public QEasingCurveFunction
             currentSegment++;
         }
 
-        singleCubicBezier = &_curves.data()[currentSegment];
+        return currentSegment;
     }
 
 
@@ -591,10 +610,36 @@ struct BezierEase : public QEasingCurveFunction
         if (!(x < 1))
             return 1;
 
-        SingleCubicBezier *singleCubicBezier = nullptr;
-        getBezierSegment(singleCubicBezier, x);
+        const int segment = segmentIndex(x);
+        const SingleCubicBezier &singleCubicBezier = _curves.at(segment);
+
+        return evaluateSegmentForY(singleCubicBezier, findTForXFromTable(singleCubicBezier, segment, x));
+    }
+
+    qreal findTForXFromTable(const SingleCubicBezier &singleCubicBezier, int segment, qreal x) const
+    {
+        const qreal position = x * TableResolution;
+        const int i = qMin(int(position), TableResolution - 1);
+
+        // Interpolate between the neighboring table entries and polish the
+        // result with Newton's method. Solving the cubic is only necessary
+        // when the entries belong to another segment or Newton does not
+        // converge, e.g. close to a vertical tangent.
+        if (_segmentTable.at(i) == segment && _segmentTable.at(i + 1) == segment) {
+            const qreal t0 = _tTable.at(i);
+            qreal t = t0 + (_tTable.at(i + 1) - t0) * (position - i);
+            for (int iteration = 0; iteration < 4; ++iteration) {
+                const qreal error = evaluateForX(singleCubicBezier, t) - x;
+                if (qAbs(error) < qreal(1e-6))
+                    return (t >= 0 && t <= 1) ? t : findTForX(singleCubicBezier, x);
+                const qreal derivative = evaluateDerivateForX(singleCubicBezier, t);
+                if (qFuzzyIsNull(derivative))
+                    break;
+                t -= error / derivative;
+            }
+        }
 
-        return evaluateSegmentForY(*singleCubicBezier, findTForX(*singleCubicBezier, x));
+        return findTForX(singleCubicBezier, x);
     }
 
     qreal static inline evaluateSegmentForY(const SingleCubicBezier &singleCubicBezier, qreal t)
@@ -0,0 +1,577 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_P_H
+#define QFLATHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QFlatHash is an open addressing hash table that keeps its key/value nodes
+  in a single array, next to an array of one control byte per slot.
+
+  A full slot's control byte holds the low 7 bits of the key's hash; empty
+  and deleted slots use values with the sign bit set. Lookups probe groups
+  of 16 consecutive slots: the control bytes of a group are compared with
+  the hash fragment all at once (using SSE2 or NEON where available), so
+  keys are only compared for the few slots whose fragment matches, and a
+  lookup miss usually stops at the first group that has an empty slot.
+
+  Compared to QHash, this is faster for large tables where lookup misses
+  are common, but it is not implicitly shared, and inserting or removing
+  invalidates all iterators and references into the table.
+*/
+
+namespace QFlatHashPrivate {
+
+enum Control : qint8 {
+    Empty = -128,
+    Deleted = -2,
+};
+
+constexpr qsizetype GroupWidth = 16;
+
+// The slots of a group matching some condition, Stride bits per slot
+template <int Stride, typename MaskType>
+class BitMask
+{
+public:
+    explicit BitMask(MaskType mask) noexcept : mask(mask) {}
+
+    explicit operator bool() const noexcept { return mask != 0; }
+    qsizetype lowestBitSet() const noexcept { return qCountTrailingZeroBits(mask) / Stride; }
+    void clearLowestBitSet() noexcept { mask &= mask - 1; }
+
+private:
+    MaskType mask;
+};
+
+struct Group
+{
+#if defined(__SSE2__)
+    using Mask = BitMask<1, quint32>;
+
+    explicit Group(const qint8 *pos) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos)))
+    {}
+
+    Mask match(qint8 h2) const noexcept
+    {
+        return Mask(quint32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+    }
+    Mask matchEmpty() const noexcept { return match(Empty); }
+    Mask matchEmptyOrDeleted() const noexcept
+    {
+        // Empty and Deleted are the only control values below -1
+        return Mask(quint32(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl))));
+    }
+
+    __m128i ctrl;
+#elif defined(__ARM_NEON__)
+    // NEON has no movemask; narrowing the comparison result leaves 4 bits
+    // per slot, of which we keep one.
+    using Mask = BitMask<4, quint64>;
+
+    explicit Group(const qint8 *pos) noexcept : ctrl(vld1q_s8(pos)) {}
+
+    static Mask toMask(uint8x16_t cmp) noexcept
+    {
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+        return Mask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0)
+                    & Q_UINT64_C(0x8888888888888888));
+    }
+
+    Mask match(qint8 h2) const noexcept { return toMask(vceqq_s8(vdupq_n_s8(h2), ctrl)); }
+    Mask matchEmpty() const noexcept { return match(Empty); }
+    Mask matchEmptyOrDeleted() const noexcept { return toMask(vcltq_s8(ctrl, vdupq_n_s8(-1))); }
+
+    int8x16_t ctrl;
+#else
+    using Mask = BitMask<1, quint32>;
+
+    explicit Group(const qint8 *pos) noexcept { memcpy(ctrl, pos, GroupWidth); }
+
+    Mask match(qint8 h2) const noexcept
+    {
+        quint32 mask = 0;
+        for (qsizetype i = 0; i < GroupWidth; ++i)
+            mask |= quint32(ctrl[i] == h2) << i;
+        return Mask(mask);
+    }
+    Mask matchEmpty() const noexcept { return match(Empty); }
+    Mask matchEmptyOrDeleted() const noexcept
+    {
+        quint32 mask = 0;
+        for (qsizetype i = 0; i < GroupWidth; ++i)
+            mask |= quint32(ctrl[i] < -1) << i;
+        return Mask(mask);
+    }
+
+    qint8 ctrl[GroupWidth];
+#endif
+};
+
+// Triangular probing over groups; with a power of two capacity this visits
+// every group before repeating one.
+struct ProbeSequence
+{
+    ProbeSequence(size_t hash, size_t mask) noexcept : offset(hash & mask), mask(mask) {}
+
+    size_t slot(qsizetype i) const noexcept { return (offset + size_t(i)) & mask; }
+    void next() noexcept
+    {
+        index += GroupWidth;
+        offset = (offset + index) & mask;
+    }
+
+    size_t offset;
+    size_t index = 0;
+    size_t mask;
+};
+
+} // namespace QFlatHashPrivate
+
+template <typename Key, typename T>
+class QFlatHash
+{
+    struct Node
+    {
+        Key key;
+        T value;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QFlatHash;
+        friend class const_iterator;
+
+        QFlatHash *h = nullptr;
+        qsizetype i = 0;
+
+        iterator(QFlatHash *h, qsizetype i) noexcept : h(h), i(i) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+
+        iterator() noexcept = default;
+
+        const Key &key() const noexcept { return h->nodes[i].key; }
+        T &value() const noexcept { return h->nodes[i].value; }
+        T &operator*() const noexcept { return value(); }
+        T *operator->() const noexcept { return &value(); }
+
+        iterator &operator++() noexcept
+        {
+            i = h->nextFull(i + 1);
+            return *this;
+        }
+        iterator operator++(int) noexcept
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        friend bool operator==(const iterator &a, const iterator &b) noexcept { return a.i == b.i; }
+        friend bool operator!=(const iterator &a, const iterator &b) noexcept { return a.i != b.i; }
+    };
+
+    class const_iterator
+    {
+        friend class QFlatHash;
+
+        const QFlatHash *h = nullptr;
+        qsizetype i = 0;
+
+        const_iterator(const QFlatHash *h, qsizetype i) noexcept : h(h), i(i) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const_iterator() noexcept = default;
+        const_iterator(const iterator &o) noexcept : h(o.h), i(o.i) {}
+
+        const Key &key() const noexcept { return h->nodes[i].key; }
+        const T &value() const noexcept { return h->nodes[i].value; }
+        const T &operator*() const noexcept { return value(); }
+        const T *operator->() const noexcept { return &value(); }
+
+        const_iterator &operator++() noexcept
+        {
+            i = h->nextFull(i + 1);
+            return *this;
+        }
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        friend bool operator==(const const_iterator &a, const const_iterator &b) noexcept
+        { return a.i == b.i; }
+        friend bool operator!=(const const_iterator &a, const const_iterator &b) noexcept
+        { return a.i != b.i; }
+    };
+
+    QFlatHash() noexcept = default;
+    QFlatHash(std::initializer_list<std::pair<Key, T>> list)
+    {
+        reserve(qsizetype(list.size()));
+        for (const auto &entry : list)
+            insert(entry.first, entry.second);
+    }
+    QFlatHash(const QFlatHash &other)
+    {
+        if (!other.used)
+            return;
+        allocate(other.cap);
+        for (qsizetype i = 0; i < other.cap; ++i) {
+            if (other.isFull(i))
+                emplaceUnique(hashOf(other.nodes[i].key), other.nodes[i]);
+        }
+    }
+    QFlatHash(QFlatHash &&other) noexcept
+    {
+        swap(other);
+    }
+    QFlatHash &operator=(const QFlatHash &other)
+    {
+        if (this != &other) {
+            QFlatHash copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    QFlatHash &operator=(QFlatHash &&other) noexcept
+    {
+        QFlatHash moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    ~QFlatHash()
+    {
+        destroy();
+    }
+
+    void swap(QFlatHash &other) noexcept
+    {
+        qSwap(ctrl, other.ctrl);
+        qSwap(nodes, other.nodes);
+        qSwap(cap, other.cap);
+        qSwap(used, other.used);
+        qSwap(growthLeft, other.growthLeft);
+        qSwap(seed, other.seed);
+    }
+
+    qsizetype size() const noexcept { return used; }
+    qsizetype count() const noexcept { return used; }
+    bool isEmpty() const noexcept { return used == 0; }
+    qsizetype capacity() const noexcept { return cap; }
+
+    void reserve(qsizetype size)
+    {
+        const qsizetype wanted = capacityForSize(qMax(size, used));
+        if (wanted > cap)
+            rehash(wanted);
+    }
+    void clear() noexcept
+    {
+        destroy();
+        ctrl = nullptr;
+        nodes = nullptr;
+        cap = used = growthLeft = 0;
+    }
+
+    bool contains(const Key &key) const noexcept { return findIndex(key) >= 0; }
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        const qsizetype i = findIndex(key);
+        return i >= 0 ? nodes[i].value : defaultValue;
+    }
+
+    iterator find(const Key &key) noexcept
+    {
+        const qsizetype i = findIndex(key);
+        return iterator(this, i >= 0 ? i : cap);
+    }
+    const_iterator find(const Key &key) const noexcept { return constFind(key); }
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        const qsizetype i = findIndex(key);
+        return const_iterator(this, i >= 0 ? i : cap);
+    }
+
+    iterator insert(const Key &key, const T &value)
+    {
+        const size_t hash = hashOf(key);
+        qsizetype i = findIndex(key, hash);
+        if (i >= 0)
+            nodes[i].value = value;
+        else
+            i = emplaceNew(hash, Node{ key, value });
+        return iterator(this, i);
+    }
+    T &operator[](const Key &key)
+    {
+        const size_t hash = hashOf(key);
+        qsizetype i = findIndex(key, hash);
+        if (i < 0)
+            i = emplaceNew(hash, Node{ key, T() });
+        return nodes[i].value;
+    }
+
+    bool remove(const Key &key)
+    {
+        const qsizetype i = findIndex(key);
+        if (i < 0)
+            return false;
+        eraseAt(i);
+        return true;
+    }
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it.h == this && isFull(it.i));
+        eraseAt(it.i);
+        return iterator(this, nextFull(it.i + 1));
+    }
+
+    iterator begin() noexcept { return iterator(this, nextFull(0)); }
+    iterator end() noexcept { return iterator(this, cap); }
+    const_iterator begin() const noexcept { return constBegin(); }
+    const_iterator end() const noexcept { return constEnd(); }
+    const_iterator cbegin() const noexcept { return constBegin(); }
+    const_iterator cend() const noexcept { return constEnd(); }
+    const_iterator constBegin() const noexcept { return const_iterator(this, nextFull(0)); }
+    const_iterator constEnd() const noexcept { return const_iterator(this, cap); }
+
+private:
+    static constexpr qsizetype growthFor(qsizetype capacity) noexcept
+    {
+        // Keep the load factor at or below 7/8
+        return capacity - capacity / 8;
+    }
+    static qsizetype capacityForSize(qsizetype size) noexcept
+    {
+        qsizetype capacity = QFlatHashPrivate::GroupWidth;
+        while (growthFor(capacity) < size)
+            capacity *= 2;
+        return capacity;
+    }
+    static qint8 h2(size_t hash) noexcept { return qint8(hash & 0x7f); }
+
+    size_t hashOf(const Key &key) const noexcept(noexcept(qHash(key, 0)))
+    {
+        return qHash(key, seed);
+    }
+    bool isFull(qsizetype i) const noexcept { return ctrl[i] >= 0; }
+    qsizetype nextFull(qsizetype i) const noexcept
+    {
+        while (i < cap && !isFull(i))
+            ++i;
+        return i;
+    }
+
+    void setCtrl(qsizetype i, qint8 value) noexcept
+    {
+        ctrl[i] = value;
+        // The first group is mirrored after the end, so that a group can
+        // be loaded from any slot without wrapping around
+        if (i < QFlatHashPrivate::GroupWidth)
+            ctrl[cap + i] = value;
+    }
+
+    qsizetype findIndex(const Key &key) const noexcept
+    {
+        return cap ? findIndex(key, hashOf(key)) : -1;
+    }
+    qsizetype findIndex(const Key &key, size_t hash) const noexcept
+    {
+        using namespace QFlatHashPrivate;
+        if (!cap)
+            return -1;
+        ProbeSequence seq(hash >> 7, size_t(cap - 1));
+        while (true) {
+            const Group group(ctrl + seq.offset);
+            for (auto mask = group.match(h2(hash)); mask; mask.clearLowestBitSet()) {
+                const qsizetype i = qsizetype(seq.slot(mask.lowestBitSet()));
+                if (qHashEquals(nodes[i].key, key))
+                    return i;
+            }
+            // The load factor leaves empty nodes in the table, so probing ends
+            if (group.matchEmpty())
+                return -1;
+            seq.next();
+        }
+    }
+    qsizetype findInsertSlot(size_t hash) const noexcept
+    {
+        using namespace QFlatHashPrivate;
+        ProbeSequence seq(hash >> 7, size_t(cap - 1));
+        while (true) {
+            const auto mask = Group(ctrl + seq.offset).matchEmptyOrDeleted();
+            if (mask)
+                return qsizetype(seq.slot(mask.lowestBitSet()));
+            seq.next();
+        }
+    }
+
+    // Takes the node by value, as it may refer to one of our own nodes,
+    // which growing the table would invalidate
+    qsizetype emplaceNew(size_t hash, Node &&node)
+    {
+        qsizetype i = cap ? findInsertSlot(hash) : -1;
+        if (i < 0 || (growthLeft == 0 && ctrl[i] == QFlatHashPrivate::Empty)) {
+            grow();
+            // The seed may have changed if the table was not allocated yet
+            hash = hashOf(node.key);
+            i = findInsertSlot(hash);
+        }
+        new (nodes + i) Node(std::move(node));
+        growthLeft -= (ctrl[i] == QFlatHashPrivate::Empty);
+        setCtrl(i, h2(hash));
+        ++used;
+        return i;
+    }
+    template <typename N>
+    void emplaceUnique(size_t hash, N &&node)
+    {
+        const qsizetype i = findInsertSlot(hash);
+        new (nodes + i) Node(std::forward<N>(node));
+        --growthLeft;
+        setCtrl(i, h2(hash));
+        ++used;
+    }
+
+    void eraseAt(qsizetype i) noexcept
+    {
+        nodes[i].~Node();
+        setCtrl(i, QFlatHashPrivate::Deleted);
+        --used;
+    }
+
+    void grow()
+    {
+        // Reclaim the deleted nodes if they make up a good part of the table
+        if (cap && used <= growthFor(cap) / 2)
+            rehash(cap);
+        else
+            rehash(cap ? cap * 2 : QFlatHashPrivate::GroupWidth);
+    }
+    void rehash(qsizetype capacity)
+    {
+        QFlatHash fresh;
+        fresh.allocate(capacity);
+        for (qsizetype i = 0; i < cap; ++i) {
+            if (isFull(i))
+                fresh.emplaceUnique(fresh.hashOf(nodes[i].key), std::move(nodes[i]));
+        }
+        swap(fresh);
+    }
+
+    void allocate(qsizetype capacity)
+    {
+        Q_ASSERT(capacity >= QFlatHashPrivate::GroupWidth);
+        Q_ASSERT((capacity & (capacity - 1)) == 0);
+        nodes = std::allocator<Node>().allocate(size_t(capacity));
+        ctrl = new qint8[capacity + QFlatHashPrivate::GroupWidth];
+        memset(ctrl, QFlatHashPrivate::Empty, size_t(capacity + QFlatHashPrivate::GroupWidth));
+        cap = capacity;
+        growthLeft = growthFor(capacity);
+        seed = QHashSeed::globalSeed();
+    }
+    void destroy() noexcept
+    {
+        if (!ctrl)
+            return;
+        for (qsizetype i = 0; i < cap; ++i) {
+            if (isFull(i))
+                nodes[i].~Node();
+        }
+        std::allocator<Node>().deallocate(nodes, size_t(cap));
+        delete[] ctrl;
+    }
+
+    qint8 *ctrl = nullptr;
+    Node *nodes = nullptr;
+    qsizetype cap = 0;
+    qsizetype used = 0;
+    qsizetype growthLeft = 0;
+    size_t seed = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_P_H
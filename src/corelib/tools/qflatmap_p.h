@@ -811,13 +811,13 @@ public:
 
     const_iterator lower_bound(const Key &key) const
     {
-        return fromKeysIterator(std::lower_bound(c.keys.begin(), c.keys.end(), key, key_comp()));
+        return fromKeysIterator(branchlessLowerBound(key));
     }
 
     template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
     const_iterator lower_bound(const X &key) const
     {
-        return fromKeysIterator(std::lower_bound(c.keys.begin(), c.keys.end(), key, key_comp()));
+        return fromKeysIterator(branchlessLowerBound(key));
     }
 
     iterator find(const Key &key)
@@ -865,6 +865,24 @@ public:
     }
 
 private:
+    // Binary search without data dependent branches: the comparison only
+    // selects the next base, which compiles to a conditional move, so
+    // lookups in larger maps do not suffer from mispredicted branches.
+    template <class X>
+    typename key_container_type::const_iterator branchlessLowerBound(const X &key) const
+    {
+        auto base = c.keys.begin();
+        auto length = c.keys.size();
+        if (length == 0)
+            return base;
+        while (length > 1) {
+            const auto half = length / 2;
+            base += key_compare::operator()(*(base + (half - 1)), key) ? half : 0;
+            length -= half;
+        }
+        return base + (key_compare::operator()(*base, key) ? 1 : 0);
+    }
+
     bool do_remove(iterator it)
     {
         if (it != end()) {
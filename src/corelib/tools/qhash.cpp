@@ -1384,6 +1384,20 @@ size_t qHash(long double key, size_t seed) noexcept
     floating point values.
 */
 
+/*! \class QHashHeterogeneousSearch
+    \relates QHash
+    \since 6.4
+    \internal
+
+    Trait that allows a QHash, QMultiHash or QSet with keys of type \c Key to
+    be searched with keys of type \c K without converting them to \c Key
+    first. It is enabled for QString keys searched with QStringView or
+    QLatin1String, and for QByteArray keys searched with QByteArrayView.
+
+    A specialization must only be provided if a \c Key and a \c K that
+    compare equal with \c{operator==()} also hash to the same bucket.
+*/
+
 
 /*!
     \class QHash
@@ -1879,6 +1893,35 @@ size_t qHash(long double key, size_t seed) noexcept
     parameter has not been supplied.
 */
 
+/*! \fn template <class Key, class T> template <class K> bool QHash<Key, T>::contains(const K &key) const
+    \fn template <class Key, class T> template <class K> qsizetype QHash<Key, T>::count(const K &key) const
+    \fn template <class Key, class T> template <class K> T QHash<Key, T>::value(const K &key) const
+    \fn template <class Key, class T> template <class K> T QHash<Key, T>::value(const K &key, const T &defaultValue) const
+    \fn template <class Key, class T> template <class K> const T QHash<Key, T>::operator[](const K &key) const
+    \fn template <class Key, class T> template <class K> QHash<Key, T>::iterator QHash<Key, T>::find(const K &key)
+    \fn template <class Key, class T> template <class K> QHash<Key, T>::const_iterator QHash<Key, T>::find(const K &key) const
+    \fn template <class Key, class T> template <class K> QHash<Key, T>::const_iterator QHash<Key, T>::constFind(const K &key) const
+    \since 6.4
+    \overload
+
+    These overloads look up \a key without first converting it to \c Key,
+    so that a QHash<QString, T> can be searched with a QStringView or a
+    QLatin1String, and a QHash<QByteArray, T> with a QByteArrayView,
+    without allocating a temporary key.
+
+    They only participate in overload resolution if \c K is such a
+    compatible key type for \c Key.
+*/
+
+/*! \fn template <class Key, class T> template <class K> T &QHash<Key, T>::operator[](const K &key)
+    \since 6.4
+    \overload
+
+    Converts \a key to \c Key and returns operator[](const Key &key), as the
+    item may have to be inserted. \c K must be a compatible key type for
+    \c Key, as for the read-only overloads.
+*/
+
 /*! \fn template <class Key, class T> T &QHash<Key, T>::operator[](const Key &key)
 
     Returns the value associated with the \a key as a modifiable
@@ -2925,6 +2968,29 @@ size_t qHash(long double key, size_t seed) noexcept
     \sa count(), insert()
 */
 
+/*! \fn template <class Key, class T> template <class K> bool QMultiHash<Key, T>::contains(const K &key) const
+    \fn template <class Key, class T> template <class K> qsizetype QMultiHash<Key, T>::count(const K &key) const
+    \fn template <class Key, class T> template <class K> T QMultiHash<Key, T>::value(const K &key) const
+    \fn template <class Key, class T> template <class K> T QMultiHash<Key, T>::value(const K &key, const T &defaultValue) const
+    \fn template <class Key, class T> template <class K> const T QMultiHash<Key, T>::operator[](const K &key) const
+    \fn template <class Key, class T> template <class K> QList<T> QMultiHash<Key, T>::values(const K &key) const
+    \fn template <class Key, class T> template <class K> QMultiHash<Key, T>::const_iterator QMultiHash<Key, T>::find(const K &key) const
+    \fn template <class Key, class T> template <class K> QMultiHash<Key, T>::const_iterator QMultiHash<Key, T>::constFind(const K &key) const
+    \since 6.4
+    \overload
+
+    These overloads look up \a key without first converting it to \c Key.
+    See QHash::contains() for the supported key types.
+*/
+
+/*! \fn template <class Key, class T> template <class K> T &QMultiHash<Key, T>::operator[](const K &key)
+    \since 6.4
+    \overload
+
+    Converts \a key to \c Key and returns operator[](const Key &key), as the
+    item may have to be inserted.
+*/
+
 /*! \fn template <class Key, class T> T &QMultiHash<Key, T>::operator[](const Key &key)
 
     Returns the value associated with the \a key as a modifiable reference.
@@ -102,6 +102,51 @@ size_t calculateHash(const T &t, size_t seed = 0)
     }
 }
 
+template <typename Key, typename K>
+using if_heterogeneously_searchable = std::enable_if_t<QHashHeterogeneousSearch<Key, K>::value, bool>;
+
+// Hashes a lookup key of type K so that it lands in the same bucket as an
+// equal key of type Key.
+template <typename Key, typename K>
+size_t calculateLookupHash(const K &key, size_t seed)
+{
+    if constexpr (std::is_same_v<Key, QString> && std::is_same_v<K, QLatin1String>) {
+        // qHash(QLatin1String) hashes the Latin-1 bytes, whereas QString is
+        // hashed as UTF-16, so widen short keys on the stack
+        constexpr qsizetype BufferSize = 256;
+        if (key.size() > BufferSize)
+            return qHash(QString(key), seed);
+        char16_t buffer[BufferSize];
+        const char *src = key.data();
+        for (qsizetype i = 0; i < key.size(); ++i)
+            buffer[i] = uchar(src[i]);
+        return qHash(QStringView(buffer, key.size()), seed);
+    } else {
+        return calculateHash(key, seed);
+    }
+}
+
+// Returns the Key that an inserting lookup with \a key stores.
+template <typename Key, typename K>
+Key keyFromLookupKey(const K &key)
+{
+    if constexpr (std::is_constructible_v<Key, const K &>)
+        return Key(key);
+    else if constexpr (std::is_same_v<Key, QString>)
+        return key.toString();
+    else
+        return key.toByteArray();
+}
+
+template <typename Key, typename K>
+bool lookupKeysEqual(const Key &key, const K &lookupKey)
+{
+    if constexpr (std::is_same_v<Key, K>)
+        return qHashEquals(key, lookupKey);
+    else
+        return key == lookupKey;
+}
+
 template <typename Key, typename T>
 struct Node
 {
@@ -681,10 +726,11 @@ struct Data
         return size >= (numBuckets >> 1);
     }
 
-    Bucket findBucket(const Key &key) const noexcept
+    template <typename K>
+    Bucket findBucket(const K &key) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
+        size_t hash = QHashPrivate::calculateLookupHash<Key>(key, seed);
         Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
         // loop over the buckets until we find the entry we search for
         // or an empty slot, in which case we know the entry doesn't exist
@@ -694,17 +740,18 @@ struct Data
                 return bucket;
             } else {
                 Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
+                if (QHashPrivate::lookupKeysEqual(n.key, key))
                     return bucket;
             }
             bucket.advanceWrapped(this);
         }
     }
 
-    Node *findNode(const Key &key) const noexcept
+    template <typename K>
+    Node *findNode(const K &key) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
+        size_t hash = QHashPrivate::calculateLookupHash<Key>(key, seed);
         Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
         // loop over the buckets until we find the entry we search for
         // or an empty slot, in which case we know the entry doesn't exist
@@ -714,7 +761,7 @@ struct Data
                 return nullptr;
             } else {
                 Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
+                if (QHashPrivate::lookupKeysEqual(n.key, key))
                     return &n;
             }
             bucket.advanceWrapped(this);
@@ -1011,6 +1058,18 @@ public:
     {
         return contains(key) ? 1 : 0;
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    bool contains(const K &key) const noexcept
+    {
+        if (!d)
+            return false;
+        return d->findNode(key) != nullptr;
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    qsizetype count(const K &key) const noexcept
+    {
+        return contains(key) ? 1 : 0;
+    }
 
 private:
     const Key *keyImpl(const T &value) const noexcept
@@ -1044,7 +1103,8 @@ public:
     }
 
 private:
-    T *valueImpl(const Key &key) const noexcept
+    template <typename K>
+    T *valueImpl(const K &key) const noexcept
     {
         if (d) {
             Node *n = d->findNode(key);
@@ -1070,6 +1130,24 @@ public:
             return defaultValue;
     }
 
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    T value(const K &key) const noexcept
+    {
+        if (T *v = valueImpl(key))
+            return *v;
+        else
+            return T();
+    }
+
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    T value(const K &key, const T &defaultValue) const noexcept
+    {
+        if (T *v = valueImpl(key))
+            return *v;
+        else
+            return defaultValue;
+    }
+
     T &operator[](const Key &key)
     {
         const auto copy = isDetached() ? QHash() : *this; // keep 'key' alive across the detach
@@ -1086,6 +1164,19 @@ public:
         return value(key);
     }
 
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const T operator[](const K &key) const noexcept
+    {
+        return value(key);
+    }
+    // may insert, so it needs a real Key; without it, calls on a non-const
+    // hash would resolve to the const overload above
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    T &operator[](const K &key)
+    {
+        return operator[](QHashPrivate::keyFromLookupKey<Key>(key));
+    }
+
     QList<Key> keys() const { return QList<Key>(keyBegin(), keyEnd()); }
     QList<Key> keys(const T &value) const
     {
@@ -1289,6 +1380,34 @@ public:
     {
         return find(key);
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    iterator find(const K &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return end();
+        auto it = d->findBucket(key);
+        size_t bucket = it.toBucketIndex(d);
+        detach();
+        it = typename Data::Bucket(d, bucket); // reattach in case of detach
+        if (it.isUnused())
+            return end();
+        return iterator(it.toIterator(d));
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const_iterator find(const K &key) const noexcept
+    {
+        if (isEmpty())
+            return end();
+        auto it = d->findBucket(key);
+        if (it.isUnused())
+            return end();
+        return const_iterator({d, it.toBucketIndex(d)});
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const_iterator constFind(const K &key) const noexcept
+    {
+        return find(key);
+    }
     iterator insert(const Key &key, const T &value)
     {
         return emplace(key, value);
@@ -1576,6 +1695,13 @@ public:
             return false;
         return d->findNode(key) != nullptr;
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    bool contains(const K &key) const noexcept
+    {
+        if (!d)
+            return false;
+        return d->findNode(key) != nullptr;
+    }
 
 private:
     const Key *keyImpl(const T &value) const noexcept
@@ -1609,7 +1735,8 @@ public:
     }
 
 private:
-    T *valueImpl(const Key &key) const noexcept
+    template <typename K>
+    T *valueImpl(const K &key) const noexcept
     {
         if (d) {
             Node *n = d->findNode(key);
@@ -1635,6 +1762,22 @@ public:
         else
             return defaultValue;
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    T value(const K &key) const noexcept
+    {
+        if (auto *v = valueImpl(key))
+            return *v;
+        else
+            return T();
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    T value(const K &key, const T &defaultValue) const noexcept
+    {
+        if (auto *v = valueImpl(key))
+            return *v;
+        else
+            return defaultValue;
+    }
 
     T &operator[](const Key &key)
     {
@@ -1652,6 +1795,19 @@ public:
         return value(key);
     }
 
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const T operator[](const K &key) const noexcept
+    {
+        return value(key);
+    }
+    // may insert, so it needs a real Key; without it, calls on a non-const
+    // hash would resolve to the const overload above
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    T &operator[](const K &key)
+    {
+        return operator[](QHashPrivate::keyFromLookupKey<Key>(key));
+    }
+
     QList<Key> uniqueKeys() const
     {
         QList<Key> res;
@@ -1679,6 +1835,17 @@ public:
     }
     QList<T> values() const { return QList<T>(begin(), end()); }
     QList<T> values(const Key &key) const
+    {
+        return valuesImpl(key);
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    QList<T> values(const K &key) const
+    {
+        return valuesImpl(key);
+    }
+private:
+    template <typename K>
+    QList<T> valuesImpl(const K &key) const
     {
         QList<T> values;
         if (d) {
@@ -1693,6 +1860,7 @@ public:
         }
         return values;
     }
+public:
 
     class const_iterator;
 
@@ -1927,6 +2095,21 @@ public:
             return constEnd();
         return const_iterator(it.toIterator(d));
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const_iterator find(const K &key) const noexcept
+    {
+        return constFind(key);
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const_iterator constFind(const K &key) const noexcept
+    {
+        if (isEmpty())
+            return end();
+        auto it = d->findBucket(key);
+        if (it.isUnused())
+            return constEnd();
+        return const_iterator(it.toIterator(d));
+    }
     iterator insert(const Key &key, const T &value)
     {
         return emplace(key, value);
@@ -2031,6 +2214,17 @@ public:
     }
 
     qsizetype count(const Key &key) const noexcept
+    {
+        return countImpl(key);
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    qsizetype count(const K &key) const noexcept
+    {
+        return countImpl(key);
+    }
+private:
+    template <typename K>
+    qsizetype countImpl(const K &key) const noexcept
     {
         if (!d)
             return 0;
@@ -2046,6 +2240,7 @@ public:
 
         return n;
     }
+public:
 
     qsizetype count(const Key &key, const T &value) const noexcept
     {
@@ -209,6 +209,16 @@ bool qHashEquals(const T &a, const T &b)
     return a == b;
 }
 
+template <typename Key, typename K>
+struct QHashHeterogeneousSearch : std::false_type {};
+
+template <>
+struct QHashHeterogeneousSearch<QString, QStringView> : std::true_type {};
+template <>
+struct QHashHeterogeneousSearch<QString, QLatin1String> : std::true_type {};
+template <>
+struct QHashHeterogeneousSearch<QByteArray, QByteArrayView> : std::true_type {};
+
 namespace QtPrivate {
 
 struct QHashCombine
@@ -105,6 +105,8 @@ public:
     }
 
     inline bool contains(const T &value) const { return q_hash.contains(value); }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<T, K> = true>
+    bool contains(const K &value) const { return q_hash.contains(value); }
 
     bool contains(const QSet<T> &set) const;
 
@@ -195,6 +197,10 @@ public:
     iterator find(const T &value) { return q_hash.find(value); }
     const_iterator find(const T &value) const { return q_hash.find(value); }
     inline const_iterator constFind(const T &value) const { return find(value); }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<T, K> = true>
+    const_iterator find(const K &value) const { return q_hash.find(value); }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<T, K> = true>
+    const_iterator constFind(const K &value) const { return find(value); }
     QSet<T> &unite(const QSet<T> &other);
     QSet<T> &intersect(const QSet<T> &other);
     bool intersects(const QSet<T> &other) const;
@@ -133,11 +133,55 @@ void QDBusAbstractInterfacePrivate::initOwnerTracking()
                      SIGNAL(serviceOwnerChanged(QString,QString,QString)),
                      q_func(), SLOT(_q_serviceOwnerChanged(QString,QString,QString)));
 
-    currentOwner = connectionPrivate()->getNameOwner(service);
+    // Don't block creation on a round trip to the bus, unless we are in the
+    // connection's thread, where waiting for the reply later would deadlock
+    if (!connectionPrivate()->getCachedNameOwner(service, &currentOwner)) {
+        if (connectionPrivate()->thread() != QThread::currentThread()) {
+            requestOwner();
+            return;
+        }
+        currentOwner = connectionPrivate()->getNameOwner(service);
+    }
     if (currentOwner.isEmpty())
         lastError = connectionPrivate()->lastError;
 }
 
+void QDBusAbstractInterfacePrivate::requestOwner()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(QDBusUtil::dbusService(),
+                                                      QDBusUtil::dbusPath(),
+                                                      QDBusUtil::dbusInterface(),
+                                                      QStringLiteral("GetNameOwner"));
+    QDBusMessagePrivate::setParametersValidated(msg, true);
+    msg << service;
+    pendingOwner = connection.asyncCall(msg);
+    ownerError = connectionPrivate()->lastError;
+    ownerPending.storeRelease(1);
+}
+
+/*
+    Waits for the reply to the GetNameOwner call made by initOwnerTracking().
+    This must be called before anything that reads the owner or changes
+    lastError, so that a failed lookup reports its error as if it had
+    happened during creation.
+*/
+void QDBusAbstractInterfacePrivate::resolveOwner() const
+{
+    if (!ownerPending.loadAcquire())
+        return;
+
+    QMutexLocker locker(&ownerMutex);
+    if (!ownerPending.loadRelaxed())
+        return;
+    pendingOwner.waitForFinished();
+    if (pendingOwner.isValid())
+        currentOwner = pendingOwner.value();
+    pendingOwner = QDBusPendingReply<QString>();
+    if (currentOwner.isEmpty())
+        lastError = ownerError;
+    ownerPending.storeRelease(0);
+}
+
 bool QDBusAbstractInterfacePrivate::canMakeCalls() const
 {
     // recheck only if we have a wildcard (i.e. empty) service or path
@@ -151,6 +195,7 @@ bool QDBusAbstractInterfacePrivate::canMakeCalls() const
 
 bool QDBusAbstractInterfacePrivate::property(const QMetaProperty &mp, void *returnValuePtr) const
 {
+    resolveOwner();
     if (!isValid || !canMakeCalls())   // can't make calls
         return false;
 
@@ -234,6 +279,7 @@ bool QDBusAbstractInterfacePrivate::property(const QMetaProperty &mp, void *retu
 
 bool QDBusAbstractInterfacePrivate::setProperty(const QMetaProperty &mp, const QVariant &value)
 {
+    resolveOwner();
     if (!isValid || !canMakeCalls())    // can't make calls
         return false;
 
@@ -260,6 +306,12 @@ void QDBusAbstractInterfacePrivate::_q_serviceOwnerChanged(const QString &name,
     Q_UNUSED(name);
     //qDebug() << "QDBusAbstractInterfacePrivate serviceOwnerChanged" << name << oldOwner << newOwner;
     Q_ASSERT(name == service);
+    QMutexLocker locker(&ownerMutex);
+    // this is newer than the reply to GetNameOwner, if that is still pending
+    if (ownerPending.loadRelaxed()) {
+        pendingOwner = QDBusPendingReply<QString>();
+        ownerPending.storeRelease(0);
+    }
     currentOwner = newOwner;
 }
 
@@ -361,6 +413,7 @@ QDBusAbstractInterface::~QDBusAbstractInterface()
 bool QDBusAbstractInterface::isValid() const
 {
     Q_D(const QDBusAbstractInterface);
+    d->resolveOwner();
     /* We don't retrieve the owner name for peer connections */
     if (d->connectionPrivate() && d->connectionPrivate()->mode == QDBusConnectionPrivate::PeerMode) {
         return d->isValid;
@@ -407,7 +460,9 @@ QString QDBusAbstractInterface::interface() const
 */
 QDBusError QDBusAbstractInterface::lastError() const
 {
-    return d_func()->lastError;
+    Q_D(const QDBusAbstractInterface);
+    d->resolveOwner();
+    return d->lastError;
 }
 
 /*!
@@ -454,6 +509,7 @@ QDBusMessage QDBusAbstractInterface::callWithArgumentList(QDBus::CallMode mode,
                                                           const QList<QVariant>& args)
 {
     Q_D(QDBusAbstractInterface);
+    d->resolveOwner();
 
     if (!d->isValid || !d->canMakeCalls())
         return QDBusMessage::createError(d->lastError);
@@ -555,6 +611,7 @@ bool QDBusAbstractInterface::callWithCallback(const QString &method,
                                               const char *errorMethod)
 {
     Q_D(QDBusAbstractInterface);
+    d->resolveOwner();
 
     if (!d->isValid || !d->canMakeCalls())
         return false;
@@ -57,6 +57,8 @@
 #include <qdbusabstractinterface.h>
 #include <qdbusconnection.h>
 #include <qdbuserror.h>
+#include <qdbuspendingreply.h>
+#include <qmutex.h>
 #include "qdbusconnection_p.h"
 #include "private/qobject_p.h"
 
@@ -73,7 +75,7 @@ public:
 
     mutable QDBusConnection connection; // mutable because we want to make calls from const functions
     QString service;
-    QString currentOwner;
+    mutable QString currentOwner;
     QString path;
     QString interface;
     mutable QDBusError lastError;
@@ -83,10 +85,19 @@ public:
     // it can't be const because QDBusInterfacePrivate has one more check
     bool isValid;
 
+    // the reply to the GetNameOwner call made during creation, which is
+    // only waited for once the owner or the error is needed
+    mutable QDBusPendingReply<QString> pendingOwner;
+    QDBusError ownerError;
+    mutable QAtomicInt ownerPending;
+    mutable QBasicMutex ownerMutex;
+
     QDBusAbstractInterfacePrivate(const QString &serv, const QString &p,
                                   const QString &iface, const QDBusConnection& con, bool dynamic);
     virtual ~QDBusAbstractInterfacePrivate() { }
     void initOwnerTracking();
+    void requestOwner();
+    void resolveOwner() const;
     bool canMakeCalls() const;
 
     // these functions do not check if the property is valid
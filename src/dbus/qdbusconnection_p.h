@@ -205,6 +205,7 @@ public:
     void closeConnection();
 
     QString getNameOwner(const QString &service);
+    bool getCachedNameOwner(const QString &service, QString *owner);
 
     bool shouldWatchService(const QString &service);
     void watchService(const QString &service, QDBusServiceWatcher::WatchMode mode,
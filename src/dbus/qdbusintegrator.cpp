@@ -1626,21 +1626,40 @@ void QDBusConnectionPrivate::handleSignal(const QString &key, const QDBusMessage
     SignalHookHash::const_iterator end = signalHooks.constEnd();
     //qDebug("looking for: %s", path.toLocal8Bit().constData());
     //qDBusDebug() << signalHooks.keys();
+    if (it == end)
+        return;
+
+    // this is called for every incoming signal, so avoid copying the
+    // message's fields and allocating anything per hook
+    const QString sender = msg.service();
+    const QString path = msg.path();
+    const QString signature = msg.signature();
+    QVariantList cachedArguments;
+    bool argumentsFetched = false;
+    const auto fetchArguments = [&]() -> const QVariantList & {
+        if (!argumentsFetched) {
+            cachedArguments = msg.arguments();
+            argumentsFetched = true;
+        }
+        return cachedArguments;
+    };
+
     for ( ; it != end && it.key() == key; ++it) {
         const SignalHook &hook = it.value();
         if (!hook.service.isEmpty()) {
-            QString owner = watchedServices.value(hook.service, WatchedServiceData(hook.service)).owner;
-            if (owner != msg.service())
+            const WatchedServicesHash::const_iterator sit = watchedServices.constFind(hook.service);
+            const QString &owner = sit == watchedServices.constEnd() ? QString() : sit->owner;
+            if (owner != sender)
                 continue;
         }
-        if (!hook.path.isEmpty() && hook.path != msg.path())
+        if (!hook.path.isEmpty() && hook.path != path)
             continue;
-        if (!hook.signature.isEmpty() && hook.signature != msg.signature())
+        if (!hook.signature.isEmpty() && hook.signature != signature)
             continue;
-        if (hook.signature.isEmpty() && !hook.signature.isNull() && !msg.signature().isEmpty())
+        if (hook.signature.isEmpty() && !hook.signature.isNull() && !signature.isEmpty())
             continue;
         if (!hook.argumentMatch.args.isEmpty()) {
-            const QVariantList arguments = msg.arguments();
+            const QVariantList &arguments = fetchArguments();
             if (hook.argumentMatch.args.size() > arguments.size())
                 continue;
 
@@ -1658,12 +1677,14 @@ void QDBusConnectionPrivate::handleSignal(const QString &key, const QDBusMessage
                 continue;
         }
         if (!hook.argumentMatch.arg0namespace.isEmpty()) {
-            const QVariantList arguments = msg.arguments();
+            const QVariantList &arguments = fetchArguments();
             if (arguments.size() < 1)
                 continue;
             const QString param = arguments.at(0).toString();
-            if (param != hook.argumentMatch.arg0namespace
-                && !param.startsWith(hook.argumentMatch.arg0namespace + QLatin1Char('.')))
+            const QString &ns = hook.argumentMatch.arg0namespace;
+            if (param != ns
+                && !(param.startsWith(ns) && param.size() > ns.size()
+                     && param.at(ns.size()) == QLatin1Char('.')))
                 continue;
         }
         activateSignal(hook, msg);
@@ -2535,18 +2556,36 @@ QString QDBusConnectionPrivate::getNameOwner(const QString& serviceName)
     if (!connection)
         return QString();
 
-    {
-        // acquire a read lock for the cache
-        QReadLocker locker(&lock);
-        WatchedServicesHash::ConstIterator it = watchedServices.constFind(serviceName);
-        if (it != watchedServices.constEnd())
-            return it->owner;
-    }
+    QString owner;
+    if (getCachedNameOwner(serviceName, &owner))
+        return owner;
 
     // not cached
     return getNameOwnerNoCache(serviceName);
 }
 
+/*!
+    \internal
+    Sets \a owner to the owner of \a serviceName and returns \c true if it
+    is known without asking the bus, i.e. if the name is a unique connection
+    name or is being watched.
+*/
+bool QDBusConnectionPrivate::getCachedNameOwner(const QString &serviceName, QString *owner)
+{
+    if (QDBusUtil::isValidUniqueConnectionName(serviceName)) {
+        *owner = serviceName;
+        return true;
+    }
+
+    // acquire a read lock for the cache
+    QReadLocker locker(&lock);
+    WatchedServicesHash::ConstIterator it = watchedServices.constFind(serviceName);
+    if (it == watchedServices.constEnd())
+        return false;
+    *owner = it->owner;
+    return true;
+}
+
 QString QDBusConnectionPrivate::getNameOwnerNoCache(const QString &serviceName)
 {
     QDBusMessage msg = QDBusMessage::createMethodCall(QDBusUtil::dbusService(),
@@ -42,6 +42,9 @@
 #include "qdbusmetatype_p.h"
 #include "qdbusutil_p.h"
 
+#include <QtCore/qstringconverter.h>
+#include <QtCore/qvarlengtharray.h>
+
 #ifndef QT_NO_DBUS
 
 QT_BEGIN_NAMESPACE
@@ -54,6 +57,25 @@ static void qIterAppend(DBusMessageIter *it, QByteArray *ba, int type, const voi
         q_dbus_message_iter_append_basic(it, type, arg);
 }
 
+namespace {
+// Converts strings to the NUL-terminated UTF-8 that libdbus copies into the
+// message, reusing one buffer instead of allocating a QByteArray per string
+class Utf8Buffer
+{
+public:
+    const char *convert(QStringView str)
+    {
+        QStringEncoder encoder(QStringEncoder::Utf8, QStringEncoder::Flag::Stateless);
+        buffer.resize(encoder.requiredSpace(str.size()) + 1);
+        *encoder.appendToBuffer(buffer.data(), str) = '\0';
+        return buffer.constData();
+    }
+
+private:
+    QVarLengthArray<char, 256> buffer;
+};
+}
+
 QDBusMarshaller::~QDBusMarshaller()
 {
     close();
@@ -133,33 +155,38 @@ inline void QDBusMarshaller::append(double arg)
 
 void QDBusMarshaller::append(const QString &arg)
 {
-    QByteArray data = arg.toUtf8();
-    const char *cdata = data.constData();
-    if (!skipSignature)
-        qIterAppend(&iterator, ba, DBUS_TYPE_STRING, &cdata);
+    if (skipSignature)
+        return;
+    if (ba) {
+        *ba += char(DBUS_TYPE_STRING);
+        return;
+    }
+    Utf8Buffer buffer;
+    const char *cdata = buffer.convert(arg);
+    q_dbus_message_iter_append_basic(&iterator, DBUS_TYPE_STRING, &cdata);
 }
 
 inline void QDBusMarshaller::append(const QDBusObjectPath &arg)
 {
-    QByteArray data = arg.path().toUtf8();
-    if (!ba && data.isEmpty()) {
+    const QString path = arg.path();
+    if (!ba && path.isEmpty()) {
         error(QLatin1String("Invalid object path passed in arguments"));
-    } else {
-        const char *cdata = data.constData();
-        if (!skipSignature)
-            qIterAppend(&iterator, ba, DBUS_TYPE_OBJECT_PATH, &cdata);
+    } else if (!skipSignature) {
+        Utf8Buffer buffer;
+        const char *cdata = ba ? nullptr : buffer.convert(path);
+        qIterAppend(&iterator, ba, DBUS_TYPE_OBJECT_PATH, &cdata);
     }
 }
 
 inline void QDBusMarshaller::append(const QDBusSignature &arg)
 {
-    QByteArray data = arg.signature().toUtf8();
-    if (!ba && data.isEmpty()) {
+    const QString signature = arg.signature();
+    if (!ba && signature.isEmpty()) {
         error(QLatin1String("Invalid signature passed in arguments"));
-    } else {
-        const char *cdata = data.constData();
-        if (!skipSignature)
-            qIterAppend(&iterator, ba, DBUS_TYPE_SIGNATURE, &cdata);
+    } else if (!skipSignature) {
+        Utf8Buffer buffer;
+        const char *cdata = ba ? nullptr : buffer.convert(signature);
+        qIterAppend(&iterator, ba, DBUS_TYPE_SIGNATURE, &cdata);
     }
 }
 
@@ -240,10 +267,11 @@ inline void QDBusMarshaller::append(const QStringList &arg)
 
     QDBusMarshaller sub(capabilities);
     open(sub, DBUS_TYPE_ARRAY, DBUS_TYPE_STRING_AS_STRING);
-    QStringList::ConstIterator it = arg.constBegin();
-    QStringList::ConstIterator end = arg.constEnd();
-    for ( ; it != end; ++it)
-        sub.append(*it);
+    Utf8Buffer buffer;
+    for (const QString &str : arg) {
+        const char *cdata = buffer.convert(str);
+        q_dbus_message_iter_append_basic(&sub.iterator, DBUS_TYPE_STRING, &cdata);
+    }
     // don't call sub.close(): it auto-closes
 }
 
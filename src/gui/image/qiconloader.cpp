@@ -50,6 +50,7 @@
 #include <QtCore/qmath.h>
 #include <QtCore/QList>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #if QT_CONFIG(settings)
 #include <QtCore/QSettings>
 #endif
@@ -340,6 +341,37 @@ QList<const char *> QIconCacheGtkReader::lookup(QStringView name)
     return ret;
 }
 
+/*!
+    \internal
+    Helper class that lists the icon files in the subdirectories of a theme
+    directory once, for themes that don't have an icon-theme.cache. Looking
+    an icon up in the index is then a hash lookup rather than a file stat for
+    every subdirectory, every fallback name and every inherited theme.
+*/
+class QIconDirIndex
+{
+public:
+    QIconDirIndex(const QString &themeDir, const QList<QIconDirInfo> &subDirs);
+    QList<int> lookup(const QString &fileName) const { return m_files.value(fileName); }
+private:
+    // file name -> ascending indexes of the subdirectories containing it
+    QHash<QString, QList<int>> m_files;
+};
+
+QIconDirIndex::QIconDirIndex(const QString &themeDir, const QList<QIconDirInfo> &subDirs)
+{
+    const QStringList nameFilters = { QStringLiteral("*.png"), QStringLiteral("*.svg") };
+    for (int i = 0; i < subDirs.size(); ++i) {
+        QDirIterator it(themeDir + QLatin1Char('/') + subDirs.at(i).path, nameFilters, QDir::Files);
+        while (it.hasNext()) {
+            it.next();
+            QList<int> &dirs = m_files[it.fileName()];
+            if (dirs.isEmpty() || dirs.constLast() != i)
+                dirs.append(i);
+        }
+    }
+}
+
 QIconTheme::QIconTheme(const QString &themeName)
         : m_valid(false)
 {
@@ -422,6 +454,8 @@ QIconTheme::QIconTheme(const QString &themeName)
             m_parents.append(QLatin1String("hicolor"));
     }
 #endif // settings
+
+    m_dirIndexes.resize(m_contentDirs.size());
 }
 
 QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
@@ -473,6 +507,22 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
                         }
                     }
                 }
+            } else if (!subDirs.isEmpty()) {
+                // Without a cache, only look in the subdirectories that have the file
+                QSharedPointer<QIconDirIndex> &index = theme.m_dirIndexes[i];
+                if (!index)
+                    index = QSharedPointer<QIconDirIndex>::create(contentDirs.at(i), subDirs);
+                QList<int> dirs = index->lookup(pngIconName);
+                if (m_supportsSvg) {
+                    dirs += index->lookup(svgIconName);
+                    std::sort(dirs.begin(), dirs.end());
+                    dirs.erase(std::unique(dirs.begin(), dirs.end()), dirs.end());
+                }
+                const QList<QIconDirInfo> subDirsCopy = subDirs;
+                subDirs.clear();
+                subDirs.reserve(dirs.size());
+                for (int dir : qAsConst(dirs))
+                    subDirs.append(subDirsCopy.at(dir));
             }
 
             QString contentDir = contentDirs.at(i) + QLatin1Char('/');
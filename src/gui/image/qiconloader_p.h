@@ -156,6 +156,7 @@ private:
 };
 
 class QIconCacheGtkReader;
+class QIconDirIndex;
 
 class QIconTheme
 {
@@ -173,6 +174,7 @@ private:
     bool m_valid;
 public:
     QList<QSharedPointer<QIconCacheGtkReader>> m_gtkCaches;
+    QList<QSharedPointer<QIconDirIndex>> m_dirIndexes;
 };
 
 class Q_GUI_EXPORT QIconLoader
@@ -41,6 +41,7 @@
 
 #include "qbuffer.h"
 #include "qdatastream.h"
+#include "qfile.h"
 #include "qcolortransform.h"
 #include "qfloat16.h"
 #include "qmap.h"
@@ -56,6 +57,7 @@
 #include <ctype.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <memory>
 #include <qpa/qplatformpixmap.h>
 #include <private/qcolortransform_p.h>
 #include <private/qmemrotate_p.h>
@@ -106,6 +108,79 @@ static int next_qimage_serial_number()
     return 1 + serial.fetchAndAddRelaxed(1);
 }
 
+#if QT_CONFIG(thread)
+static QBasicAtomicPointer<QThreadPool> imageThreadPool = Q_BASIC_ATOMIC_INITIALIZER(nullptr);
+static QBasicAtomicInt imageThreadPoolSet = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*!
+    \internal
+
+    Returns the thread pool used to convert, scale and transform large images,
+    or \nullptr if such operations run on the calling thread only. Unless set
+    with qt_setImageThreadPool(), this is QThreadPool::globalInstance().
+*/
+QThreadPool *qt_imageThreadPool()
+{
+#ifdef Q_OS_WASM
+    // WebAssembly has threads; however we can't block the main thread.
+    return nullptr;
+#else
+    if (imageThreadPoolSet.loadAcquire())
+        return imageThreadPool.loadRelaxed();
+    return QThreadPool::globalInstance();
+#endif
+}
+
+/*!
+    \internal
+
+    Makes large image operations run in \a threadPool, or serially if
+    \a threadPool is \nullptr. The caller keeps ownership of the pool, which
+    must outlive any image operation using it.
+*/
+void qt_setImageThreadPool(QThreadPool *threadPool)
+{
+    imageThreadPool.storeRelaxed(threadPool);
+    imageThreadPoolSet.storeRelease(1);
+}
+#endif
+
+/*!
+    \internal
+
+    Splits the \a rows of an image of \a pixels pixels into segments of at
+    least 64K pixels, and calls \a segment for each with \a context and the
+    segment's row range. The segments run in qt_imageThreadPool() and this
+    function returns once all are done; it returns the number of segments.
+*/
+int qt_imageParallelFor(qsizetype pixels, int rows,
+                        void (*segment)(const void *context, int yStart, int yEnd),
+                        const void *context)
+{
+#if QT_CONFIG(thread)
+    const int segments = int(std::min(pixels >> 16, qsizetype(rows)));
+    QThreadPool *threadPool = segments > 1 ? qt_imageThreadPool() : nullptr;
+    if (threadPool && !threadPool->contains(QThread::currentThread())) {
+        QSemaphore semaphore;
+        int y = 0;
+        for (int i = 0; i < segments; ++i) {
+            int yn = (rows - y) / (segments - i);
+            threadPool->start([&, y, yn]() {
+                segment(context, y, y + yn);
+                semaphore.release(1);
+            });
+            y += yn;
+        }
+        semaphore.acquire(segments);
+        return segments;
+    }
+#else
+    Q_UNUSED(pixels);
+#endif
+    segment(context, 0, rows);
+    return 1;
+}
+
 QImageData::QImageData()
     : ref(0), width(0), height(0), depth(0), nbytes(0), devicePixelRatio(1.0), data(nullptr),
       format(QImage::Format_ARGB32), bytes_per_line(0),
@@ -2177,6 +2252,8 @@ QImage QImage::convertToFormat_helper(Format format, Qt::ImageConversionFlags fl
     if (!d || d->format == format)
         return *this;
 
+    Q_TRACE_SCOPE(QImage_convertToFormat_helper, d->format, format);
+
     if (d->format == Format_Invalid || format <= Format_Invalid || format >= NImageFormats)
         return QImage();
 
@@ -3847,6 +3924,88 @@ QImage QImage::fromData(const uchar *data, int size, const char *format)
 
 */
 
+namespace {
+struct QImageFileMapping
+{
+    QFile file;
+    uchar *data = nullptr;
+};
+}
+
+static void qt_unmapImageFile(void *info)
+{
+    auto mapping = static_cast<QImageFileMapping *>(info);
+    mapping->file.unmap(mapping->data);
+    delete mapping;
+}
+
+/*!
+    \since 6.4
+
+    Constructs an image from uncompressed pixel data stored in the file
+    \a fileName, starting at \a offset. The image has the given \a size and
+    \a format, and its scanlines are \a bytesPerLine bytes apart in the file.
+    The format must not be an indexed format.
+
+    If possible, the file is mapped into memory and the image uses the
+    mapped pixels directly, without reading or copying them. Loading is then
+    nearly instantaneous even for very large files, and processes that map
+    the same file share the memory. The image is read-only: like an image
+    constructed on a \c{const uchar *} buffer, it makes a copy of the pixels
+    the first time it is modified. Mapping requires \a offset and
+    \a bytesPerLine to be multiples of 4; otherwise, the pixels are read
+    into a newly allocated image.
+
+    Returns a null image if the file cannot be opened, is too small for
+    the given geometry, or if any of the parameters is invalid.
+
+    \warning The file must not be modified or truncated while a mapped image
+    or an unmodified copy of it exists. Depending on the platform, doing so
+    changes the image or crashes the application.
+
+    \sa QFile::map(), constBits()
+*/
+QImage QImage::fromMappedFile(const QString &fileName, qint64 offset, const QSize &size,
+                              qsizetype bytesPerLine, Format format)
+{
+    if (size.isEmpty() || offset < 0 || format <= Format_Invalid || format >= NImageFormats
+        || format == Format_Mono || format == Format_MonoLSB || format == Format_Indexed8) {
+        return QImage();
+    }
+
+    const qsizetype minBytesPerLine = (qsizetype(size.width()) * qt_depthForFormat(format) + 7) / 8;
+    qsizetype totalSize;
+    if (bytesPerLine < minBytesPerLine || mul_overflow<qsizetype>(bytesPerLine, size.height(), &totalSize))
+        return QImage();
+
+    auto mapping = std::make_unique<QImageFileMapping>();
+    mapping->file.setFileName(fileName);
+    if (!mapping->file.open(QIODevice::ReadOnly) || mapping->file.size() - offset < totalSize)
+        return QImage();
+
+    if (offset % 4 == 0 && bytesPerLine % 4 == 0) {
+        mapping->data = mapping->file.map(offset, totalSize);
+        if (mapping->data) {
+            QImage image(const_cast<const uchar *>(mapping->data), size.width(), size.height(),
+                         bytesPerLine, format, qt_unmapImageFile, mapping.get());
+            if (image.isNull())
+                return QImage();
+            mapping.release();
+            return image;
+        }
+    }
+
+    QImage image(size, format);
+    QIMAGE_SANITYCHECK_MEMORY(image);
+    for (int y = 0; y < size.height(); ++y) {
+        if (!mapping->file.seek(offset + y * bytesPerLine)
+            || mapping->file.read(reinterpret_cast<char *>(image.scanLine(y)), minBytesPerLine) != minBytesPerLine) {
+            return QImage();
+        }
+    }
+    return image;
+}
+
 /*!
     Saves the image to the file with the given \a fileName, using the
     given image file \a format and \a quality factor. If \a format is
@@ -4689,7 +4848,16 @@ static QImage rotated90(const QImage &image)
     int h = image.height();
     const MemRotateFunc memrotate = qMemRotateFunctions[qPixelLayouts[image.format()].bpp][2];
     if (memrotate) {
-        memrotate(image.constBits(), w, h, image.bytesPerLine(), out.bits(), out.bytesPerLine());
+        // Source rows [yStart, yEnd) become destination columns [h - yEnd, h - yStart)
+        const uchar *srcData = image.constBits();
+        uchar *destData = out.bits();
+        const qsizetype sbpl = image.bytesPerLine();
+        const qsizetype dbpl = out.bytesPerLine();
+        const int bytesPerPixel = image.depth() >> 3;
+        qt_imageParallelFor(qsizetype(w) * h, h, [&](int yStart, int yEnd) {
+            memrotate(srcData + yStart * sbpl, w, yEnd - yStart, sbpl,
+                      destData + (h - yEnd) * bytesPerPixel, dbpl);
+        });
     } else {
         for (int y=0; y<h; ++y) {
             if (image.colorCount())
@@ -4715,7 +4883,15 @@ static QImage rotated180(const QImage &image)
         out.setColorTable(image.colorTable());
     int w = image.width();
     int h = image.height();
-    memrotate(image.constBits(), w, h, image.bytesPerLine(), out.bits(), out.bytesPerLine());
+    // Source rows [yStart, yEnd) become destination rows [h - yEnd, h - yStart)
+    const uchar *srcData = image.constBits();
+    uchar *destData = out.bits();
+    const qsizetype sbpl = image.bytesPerLine();
+    const qsizetype dbpl = out.bytesPerLine();
+    qt_imageParallelFor(qsizetype(w) * h, h, [&](int yStart, int yEnd) {
+        memrotate(srcData + yStart * sbpl, w, yEnd - yStart, sbpl,
+                  destData + (h - yEnd) * dbpl, dbpl);
+    });
     return out;
 }
 
@@ -4729,7 +4905,16 @@ static QImage rotated270(const QImage &image)
     int h = image.height();
     const MemRotateFunc memrotate = qMemRotateFunctions[qPixelLayouts[image.format()].bpp][0];
     if (memrotate) {
-        memrotate(image.constBits(), w, h, image.bytesPerLine(), out.bits(), out.bytesPerLine());
+        // Source rows [yStart, yEnd) become destination columns [yStart, yEnd)
+        const uchar *srcData = image.constBits();
+        uchar *destData = out.bits();
+        const qsizetype sbpl = image.bytesPerLine();
+        const qsizetype dbpl = out.bytesPerLine();
+        const int bytesPerPixel = image.depth() >> 3;
+        qt_imageParallelFor(qsizetype(w) * h, h, [&](int yStart, int yEnd) {
+            memrotate(srcData + yStart * sbpl, w, yEnd - yStart, sbpl,
+                      destData + yStart * bytesPerPixel, dbpl);
+        });
     } else {
         for (int y=0; y<h; ++y) {
             if (image.colorCount())
@@ -4903,13 +5088,20 @@ QImage QImage::transformed(const QTransform &matrix, Qt::TransformationMode mode
         Q_ASSERT(sImage.devicePixelRatio() == 1);
         Q_ASSERT(sImage.devicePixelRatio() == dImage.devicePixelRatio());
 
-        QPainter p(&dImage);
-        if (mode == Qt::SmoothTransformation) {
-            p.setRenderHint(QPainter::Antialiasing);
-            p.setRenderHint(QPainter::SmoothPixmapTransform);
-        }
-        p.setTransform(mat);
-        p.drawImage(QPoint(0, 0), sImage);
+        // Paint horizontal bands of the target concurrently; each band is a
+        // QImage sharing dImage's memory, with the transform shifted up to it.
+        uchar *dData = dImage.bits();
+        const qsizetype dbpl = dImage.bytesPerLine();
+        qt_imageParallelFor(qsizetype(wd) * hd, hd, [&](int yStart, int yEnd) {
+            QImage band(dData + yStart * dbpl, wd, yEnd - yStart, dbpl, target_format);
+            QPainter p(&band);
+            if (mode == Qt::SmoothTransformation) {
+                p.setRenderHint(QPainter::Antialiasing);
+                p.setRenderHint(QPainter::SmoothPixmapTransform);
+            }
+            p.setTransform(mat * QTransform::fromTranslate(0, -yStart));
+            p.drawImage(QPoint(0, 0), sImage);
+        });
     } else {
         bool invertible;
         mat = mat.inverted(&invertible);                // invert matrix
@@ -5089,25 +5281,7 @@ void QImage::applyColorTransform(const QColorTransform &transform)
         };
     }
 
-#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
-    int segments = (qsizetype(width()) * height()) >> 16;
-    segments = std::min(segments, height());
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments > 1 && threadPool && !threadPool->contains(QThread::currentThread())) {
-        QSemaphore semaphore;
-        int y = 0;
-        for (int i = 0; i < segments; ++i) {
-            int yn = (height() - y) / (segments - i);
-            threadPool->start([&, y, yn]() {
-                transformSegment(y, y + yn);
-                semaphore.release(1);
-            });
-            y += yn;
-        }
-        semaphore.acquire(segments);
-    } else
-#endif
-        transformSegment(0, height());
+    qt_imageParallelFor(qsizetype(width()) * height(), height(), transformSegment);
 
     if (oldFormat != format())
         *this = std::move(*this).convertToFormat(oldFormat);
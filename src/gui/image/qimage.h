@@ -286,6 +286,8 @@ public:
     static QImage fromData(const uchar *data, int size, const char *format = nullptr); // ### Qt 7: qsizetype
     static QImage fromData(const QByteArray &data, const char *format = nullptr)  // ### Qt 7: drop
     { return fromData(QByteArrayView(data), format); }
+    static QImage fromMappedFile(const QString &fileName, qint64 offset, const QSize &size,
+                                 qsizetype bytesPerLine, Format format);
 
     qint64 cacheKey() const;
 
@@ -48,15 +48,6 @@
 
 #include <qendian.h>
 #include <qrgbafloat.h>
-#if QT_CONFIG(thread)
-#include <qsemaphore.h>
-#include <qthreadpool.h>
-#ifdef Q_OS_WASM
-// WebAssembly has threads; however we can't block the main thread.
-#else
-#define QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-#endif
-#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -235,28 +226,7 @@ void convert_generic(QImageData *dest, const QImageData *src, Qt::ImageConversio
         }
     };
 
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = (qsizetype(src->width) * src->height) >> 16;
-    segments = std::min(segments, src->height);
-
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments <= 1 || !threadPool || threadPool->contains(QThread::currentThread()))
-        return convertSegment(0, src->height);
-
-    QSemaphore semaphore;
-    int y = 0;
-    for (int i = 0; i < segments; ++i) {
-        int yn = (src->height - y) / (segments - i);
-        threadPool->start([&, y, yn]() {
-            convertSegment(y, y + yn);
-            semaphore.release(1);
-        });
-        y += yn;
-    }
-    semaphore.acquire(segments);
-#else
-    convertSegment(0, src->height);
-#endif
+    qt_imageParallelFor(qsizetype(src->width) * src->height, src->height, convertSegment);
 }
 
 void convert_generic_over_rgb64(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -290,28 +260,7 @@ void convert_generic_over_rgb64(QImageData *dest, const QImageData *src, Qt::Ima
             destData += dest->bytes_per_line;
         }
     };
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = (qsizetype(src->width) * src->height) >> 16;
-    segments = std::min(segments, src->height);
-
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments <= 1 || !threadPool || threadPool->contains(QThread::currentThread()))
-        return convertSegment(0, src->height);
-
-    QSemaphore semaphore;
-    int y = 0;
-    for (int i = 0; i < segments; ++i) {
-        int yn = (src->height - y) / (segments - i);
-        threadPool->start([&, y, yn]() {
-            convertSegment(y, y + yn);
-            semaphore.release(1);
-        });
-        y += yn;
-    }
-    semaphore.acquire(segments);
-#else
-    convertSegment(0, src->height);
-#endif
+    qt_imageParallelFor(qsizetype(src->width) * src->height, src->height, convertSegment);
 }
 
 #if QT_CONFIG(raster_fp)
@@ -344,28 +293,7 @@ void convert_generic_over_rgba32f(QImageData *dest, const QImageData *src, Qt::I
             destData += dest->bytes_per_line;
         }
     };
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = (qsizetype(src->width) * src->height) >> 16;
-    segments = std::min(segments, src->height);
-
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments <= 1 || !threadPool || threadPool->contains(QThread::currentThread()))
-        return convertSegment(0, src->height);
-
-    QSemaphore semaphore;
-    int y = 0;
-    for (int i = 0; i < segments; ++i) {
-        int yn = (src->height - y) / (segments - i);
-        threadPool->start([&, y, yn]() {
-            convertSegment(y, y + yn);
-            semaphore.release(1);
-        });
-        y += yn;
-    }
-    semaphore.acquire(segments);
-#else
-    convertSegment(0, src->height);
-#endif
+    qt_imageParallelFor(qsizetype(src->width) * src->height, src->height, convertSegment);
 }
 #endif
 
@@ -452,37 +380,20 @@ bool convert_generic_inplace(QImageData *data, QImage::Format dst_format, Qt::Im
             destData += params.bytesPerLine;
         }
     };
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = (qsizetype(data->width) * data->height) >> 16;
-    segments = std::min(segments, data->height);
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments > 1 && threadPool && !threadPool->contains(QThread::currentThread())) {
-        QSemaphore semaphore;
+    const int segments = qt_imageParallelFor(qsizetype(data->width) * data->height, data->height,
+                                             convertSegment);
+    if (segments > 1 && data->bytes_per_line != params.bytesPerLine) {
+        // Compress segments to a continuous block
         int y = 0;
         for (int i = 0; i < segments; ++i) {
             int yn = (data->height - y) / (segments - i);
-            threadPool->start([&, y, yn]() {
-                convertSegment(y, y + yn);
-                semaphore.release(1);
-            });
+            uchar *srcData = data->data + data->bytes_per_line * y;
+            uchar *destData = data->data + params.bytesPerLine * y;
+            if (srcData != destData)
+                memmove(destData, srcData, params.bytesPerLine * yn);
             y += yn;
         }
-        semaphore.acquire(segments);
-        if (data->bytes_per_line != params.bytesPerLine) {
-            // Compress segments to a continuous block
-            y = 0;
-            for (int i = 0; i < segments; ++i) {
-                int yn = (data->height - y) / (segments - i);
-                uchar *srcData = data->data + data->bytes_per_line * y;
-                uchar *destData = data->data + params.bytesPerLine * y;
-                if (srcData != destData)
-                    memmove(destData, srcData, params.bytesPerLine * yn);
-                y += yn;
-            }
-        }
-    } else
-#endif
-        convertSegment(0, data->height);
+    }
     if (params.totalSize != data->nbytes) {
         Q_ASSERT(params.totalSize < data->nbytes);
         void *newData = realloc(data->data, params.totalSize);
@@ -546,37 +457,20 @@ bool convert_generic_inplace_over_rgb64(QImageData *data, QImage::Format dst_for
             destData += params.bytesPerLine;
         }
     };
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = (qsizetype(data->width) * data->height) >> 16;
-    segments = std::min(segments, data->height);
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments > 1 && threadPool && !threadPool->contains(QThread::currentThread())) {
-        QSemaphore semaphore;
+    const int segments = qt_imageParallelFor(qsizetype(data->width) * data->height, data->height,
+                                             convertSegment);
+    if (segments > 1 && data->bytes_per_line != params.bytesPerLine) {
+        // Compress segments to a continuous block
         int y = 0;
         for (int i = 0; i < segments; ++i) {
             int yn = (data->height - y) / (segments - i);
-            threadPool->start([&, y, yn]() {
-                convertSegment(y, y + yn);
-                semaphore.release(1);
-            });
+            uchar *srcData = data->data + data->bytes_per_line * y;
+            uchar *destData = data->data + params.bytesPerLine * y;
+            if (srcData != destData)
+                memmove(destData, srcData, params.bytesPerLine * yn);
             y += yn;
         }
-        semaphore.acquire(segments);
-        if (data->bytes_per_line != params.bytesPerLine) {
-            // Compress segments to a continuous block
-            y = 0;
-            for (int i = 0; i < segments; ++i) {
-                int yn = (data->height - y) / (segments - i);
-                uchar *srcData = data->data + data->bytes_per_line * y;
-                uchar *destData = data->data + params.bytesPerLine * y;
-                if (srcData != destData)
-                    memmove(destData, srcData, params.bytesPerLine * yn);
-                y += yn;
-            }
-        }
-    } else
-#endif
-        convertSegment(0, data->height);
+    }
     if (params.totalSize != data->nbytes) {
         Q_ASSERT(params.totalSize < data->nbytes);
         void *newData = realloc(data->data, params.totalSize);
@@ -641,37 +535,20 @@ bool convert_generic_inplace_over_rgba32f(QImageData *data, QImage::Format dst_f
             destData += params.bytesPerLine;
         }
     };
-#ifdef QT_USE_THREAD_PARALLEL_IMAGE_CONVERSIONS
-    int segments = (qsizetype(data->width) * data->height) >> 16;
-    segments = std::min(segments, data->height);
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments > 1 && threadPool && !threadPool->contains(QThread::currentThread())) {
-        QSemaphore semaphore;
+    const int segments = qt_imageParallelFor(qsizetype(data->width) * data->height, data->height,
+                                             convertSegment);
+    if (segments > 1 && data->bytes_per_line != params.bytesPerLine) {
+        // Compress segments to a continuous block
         int y = 0;
         for (int i = 0; i < segments; ++i) {
             int yn = (data->height - y) / (segments - i);
-            threadPool->start([&, y, yn]() {
-                convertSegment(y, y + yn);
-                semaphore.release(1);
-            });
+            uchar *srcData = data->data + data->bytes_per_line * y;
+            uchar *destData = data->data + params.bytesPerLine * y;
+            if (srcData != destData)
+                memmove(destData, srcData, params.bytesPerLine * yn);
             y += yn;
         }
-        semaphore.acquire(segments);
-        if (data->bytes_per_line != params.bytesPerLine) {
-            // Compress segments to a continuous block
-            y = 0;
-            for (int i = 0; i < segments; ++i) {
-                int yn = (data->height - y) / (segments - i);
-                uchar *srcData = data->data + data->bytes_per_line * y;
-                uchar *destData = data->data + params.bytesPerLine * y;
-                if (srcData != destData)
-                    memmove(destData, srcData, params.bytesPerLine * yn);
-                y += yn;
-            }
-        }
-    } else
-#endif
-        convertSegment(0, data->height);
+    }
     if (params.totalSize != data->nbytes) {
         Q_ASSERT(params.totalSize < data->nbytes);
         void *newData = realloc(data->data, params.totalSize);
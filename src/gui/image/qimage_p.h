@@ -61,6 +61,7 @@
 QT_BEGIN_NAMESPACE
 
 class QImageWriter;
+class QThreadPool;
 
 struct Q_GUI_EXPORT QImageData {        // internal image data
     QImageData();
@@ -424,6 +425,25 @@ inline QImage::Format qt_alphaVersionForPainting(QImage::Format format)
 Q_GUI_EXPORT QMap<QString, QString> qt_getImageText(const QImage &image, const QString &description);
 Q_GUI_EXPORT QMap<QString, QString> qt_getImageTextFromDescription(const QString &description);
 
+#if QT_CONFIG(thread)
+// The thread pool used to process large images; nullptr turns it off
+Q_GUI_EXPORT QThreadPool *qt_imageThreadPool();
+Q_GUI_EXPORT void qt_setImageThreadPool(QThreadPool *threadPool);
+#endif
+
+// Segment i covers (rows - yStart) / (segments - i) rows, starting at yStart
+Q_GUI_EXPORT int qt_imageParallelFor(qsizetype pixels, int rows,
+                                     void (*segment)(const void *context, int yStart, int yEnd),
+                                     const void *context);
+
+template <typename Segment>
+inline int qt_imageParallelFor(qsizetype pixels, int rows, const Segment &segment)
+{
+    return qt_imageParallelFor(pixels, rows, [](const void *context, int yStart, int yEnd) {
+        (*static_cast<const Segment *>(context))(yStart, yEnd);
+    }, &segment);
+}
+
 QT_END_NAMESPACE
 
 #endif // QIMAGE_P_H
@@ -0,0 +1,240 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qimagecache_p.h"
+
+#include <QtCore/qhash.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QImageCache
+    \inmodule QtGui
+    \internal
+    \since 6.4
+
+    \brief The QImageCache class provides a thread-safe cache of images with
+    its own memory budget.
+
+    Unlike QPixmapCache, which is application-wide and only usable from the
+    main thread, an image cache can be used from any thread, and separate
+    kinds of content (icons, thumbnails, rendered tiles) can use separate
+    caches so that they don't evict each other. pool() returns a named,
+    application-wide cache that is created on first use.
+
+    Like QPixmapCache, the cost of an image is its size in kilobytes, and
+    the least recently used images are evicted first when the cache exceeds
+    its budget. statistics() reports the number of lookups that hit and
+    missed, and the memory used, for tuning the budgets.
+
+    trim() and trimPools() release part of the memory in response to memory
+    pressure.
+*/
+
+namespace {
+struct QImageCachePools
+{
+    ~QImageCachePools() { qDeleteAll(pools); }
+
+    QMutex mutex;
+    QHash<QString, QImageCache *> pools;
+};
+}
+
+Q_GLOBAL_STATIC(QImageCachePools, imageCachePools)
+
+static inline qsizetype imageCost(const QImage &image)
+{
+    // a small image should have at least a cost of 1(kb)
+    return qMax(qsizetype(1), image.sizeInBytes() / 1024);
+}
+
+/*!
+    Constructs an image cache with a budget of \a maxCostKb kilobytes.
+*/
+QImageCache::QImageCache(qsizetype maxCostKb)
+    : cache(maxCostKb)
+{
+}
+
+QImageCache::~QImageCache() = default;
+
+/*!
+    Returns the application-wide image cache called \a name, creating it with
+    the default budget if it doesn't exist yet. The returned cache stays valid
+    until the application exits.
+*/
+QImageCache *QImageCache::pool(const QString &name)
+{
+    QImageCachePools *pools = imageCachePools();
+    QMutexLocker locker(&pools->mutex);
+    QImageCache *&pool = pools->pools[name];
+    if (!pool)
+        pool = new QImageCache;
+    return pool;
+}
+
+/*!
+    Returns the names of all the caches created with pool().
+*/
+QStringList QImageCache::pools()
+{
+    QImageCachePools *pools = imageCachePools();
+    QMutexLocker locker(&pools->mutex);
+    return pools->pools.keys();
+}
+
+/*!
+    Calls trim() with \a percent on every cache created with pool().
+*/
+void QImageCache::trimPools(int percent)
+{
+    if (!imageCachePools.exists())
+        return;
+    QImageCachePools *pools = imageCachePools();
+    QMutexLocker locker(&pools->mutex);
+    for (QImageCache *pool : qAsConst(pools->pools))
+        pool->trim(percent);
+}
+
+/*!
+    Looks for the image associated with \a key. If it is found, sets \a image
+    to it and returns \c true; otherwise leaves \a image alone and returns
+    \c false.
+*/
+bool QImageCache::find(const QString &key, QImage *image) const
+{
+    QMutexLocker locker(&mutex);
+    const QImage *cached = cache.object(key);
+    if (!cached) {
+        ++misses;
+        return false;
+    }
+    ++hits;
+    if (image)
+        *image = *cached;
+    return true;
+}
+
+/*!
+    Inserts a copy of \a image associated with \a key, replacing any image
+    already associated with it. Returns \c false if the image is larger than
+    the budget of the cache.
+*/
+bool QImageCache::insert(const QString &key, const QImage &image)
+{
+    QMutexLocker locker(&mutex);
+    return cache.insert(key, new QImage(image), imageCost(image));
+}
+
+/*!
+    Removes the image associated with \a key. Returns \c true if there was one.
+*/
+bool QImageCache::remove(const QString &key)
+{
+    QMutexLocker locker(&mutex);
+    return cache.remove(key);
+}
+
+/*!
+    Removes all images from the cache.
+*/
+void QImageCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    cache.clear();
+}
+
+/*!
+    Returns the budget of the cache in kilobytes.
+*/
+qsizetype QImageCache::maxCost() const
+{
+    QMutexLocker locker(&mutex);
+    return cache.maxCost();
+}
+
+/*!
+    Sets the budget of the cache to \a maxCostKb kilobytes, evicting the least
+    recently used images that don't fit anymore.
+*/
+void QImageCache::setMaxCost(qsizetype maxCostKb)
+{
+    QMutexLocker locker(&mutex);
+    cache.setMaxCost(maxCostKb);
+}
+
+/*!
+    Evicts the least recently used images until the cache uses at most
+    \a percent percent of the memory it uses now. The budget is unchanged.
+*/
+void QImageCache::trim(int percent)
+{
+    QMutexLocker locker(&mutex);
+    const qsizetype budget = cache.maxCost();
+    cache.setMaxCost(cache.totalCost() * qBound(0, percent, 100) / 100);
+    cache.setMaxCost(budget);
+}
+
+/*!
+    Returns the lookup counts since the last resetStatistics() and the
+    current memory use of the cache.
+*/
+QImageCache::Statistics QImageCache::statistics() const
+{
+    QMutexLocker locker(&mutex);
+    Statistics statistics;
+    statistics.hits = hits;
+    statistics.misses = misses;
+    statistics.count = cache.count();
+    statistics.totalCost = cache.totalCost();
+    statistics.maxCost = cache.maxCost();
+    return statistics;
+}
+
+/*!
+    Resets the hit and miss counts reported by statistics().
+*/
+void QImageCache::resetStatistics()
+{
+    QMutexLocker locker(&mutex);
+    hits = misses = 0;
+}
+
+QT_END_NAMESPACE
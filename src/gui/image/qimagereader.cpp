@@ -167,6 +167,12 @@
 #include <private/qimagereaderwriterhelpers_p.h>
 #include <qtgui_tracepoints_p.h>
 
+#if QT_CONFIG(thread)
+#include <qatomic.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
+
 #include <algorithm>
 
 QT_BEGIN_NAMESPACE
@@ -532,6 +538,8 @@ bool QImageReaderPrivate::initHandler()
     if (handler)
         return true;
 
+    Q_TRACE_SCOPE(QImageReaderPrivate_initHandler);
+
     // check some preconditions
     if (!device || (!deleteDevice && !device->isOpen() && !device->open(QIODevice::ReadOnly))) {
         imageReaderError = QImageReader::DeviceError;
@@ -1619,4 +1627,78 @@ void QImageReader::setAllocationLimit(int mbLimit)
         QImageReaderPrivate::maxAlloc = mbLimit;
 }
 
+static QImage readImageForBatch(const QString &fileName, const QSize &scaledSize,
+                                 Qt::AspectRatioMode aspectRatioMode)
+{
+    QImageReader reader(fileName);
+    reader.setAutoTransform(true);
+    bool scaleAfterRead = false;
+    if (scaledSize.isValid()) {
+        QSize size = reader.size();
+        if (size.isValid()) {
+            // The handler scales before the orientation is applied, so work
+            // in the untransformed frame when the image will be rotated.
+            const bool transposed = reader.transformation() & QImageIOHandler::TransformationRotate90;
+            const QSize target = transposed ? scaledSize.transposed() : scaledSize;
+            reader.setScaledSize(size.scaled(target, aspectRatioMode));
+        } else {
+            scaleAfterRead = true;
+        }
+    }
+    QImage image = reader.read();
+    if (scaleAfterRead && !image.isNull())
+        image = image.scaled(scaledSize, aspectRatioMode, Qt::SmoothTransformation);
+    return image;
+}
+
+/*!
+    \since 6.4
+
+    Reads all images in \a fileNames and returns them in the same order.
+    Images that cannot be read are returned as null images.
+
+    If \a scaledSize is valid, each image is scaled to fit \a scaledSize
+    according to \a aspectRatioMode. Where the image handler supports
+    QImageIOHandler::ScaledSize the scaling is done while decoding, which
+    avoids allocating the full-size image.
+
+    The images are decoded concurrently on the global QThreadPool when it
+    has more than one thread available. Each file is read through its own
+    QImageReader with auto transformation enabled, so image plugins must be
+    reentrant, which is the case for all plugins shipped with Qt.
+
+    \sa setScaledSize(), setAutoTransform()
+*/
+QList<QImage> QImageReader::readImages(const QStringList &fileNames, const QSize &scaledSize,
+                                       Qt::AspectRatioMode aspectRatioMode)
+{
+    const qsizetype count = fileNames.size();
+    QList<QImage> images(count);
+    QImage *results = images.data();
+
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const int tasks = int(qMin<qsizetype>(count, threadPool->maxThreadCount()));
+    if (tasks > 1 && !threadPool->contains(QThread::currentThread())) {
+        QAtomicInteger<qsizetype> next(0);
+        QSemaphore semaphore;
+        for (int i = 0; i < tasks; ++i) {
+            threadPool->start([&]() {
+                for (qsizetype j = next.fetchAndAddRelaxed(1); j < count;
+                     j = next.fetchAndAddRelaxed(1)) {
+                    results[j] = readImageForBatch(fileNames.at(j), scaledSize, aspectRatioMode);
+                }
+                semaphore.release(1);
+            });
+        }
+        semaphore.acquire(tasks);
+        return images;
+    }
+#endif
+
+    for (qsizetype i = 0; i < count; ++i)
+        results[i] = readImageForBatch(fileNames.at(i), scaledSize, aspectRatioMode);
+    return images;
+}
+
 QT_END_NAMESPACE
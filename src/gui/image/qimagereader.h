@@ -43,6 +43,7 @@
 #include <QtGui/qtguiglobal.h>
 #include <QtCore/qbytearray.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qstringlist.h>
 #include <QtGui/qimage.h>
 #include <QtGui/qimageiohandler.h>
 
@@ -144,6 +145,10 @@ public:
     static int allocationLimit();
     static void setAllocationLimit(int mbLimit);
 
+    static QList<QImage> readImages(const QStringList &fileNames,
+                                    const QSize &scaledSize = QSize(),
+                                    Qt::AspectRatioMode aspectRatioMode = Qt::KeepAspectRatio);
+
 private:
     Q_DISABLE_COPY(QImageReader)
     QImageReaderPrivate *d;
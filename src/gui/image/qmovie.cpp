@@ -60,7 +60,8 @@
     \snippet code/src_gui_image_qmovie.cpp 0
 
     Whenever a new frame is available in the movie, QMovie will emit
-    updated(). If the size of the frame changes, resized() is emitted. You can
+    updated(). In the \l CacheAhead mode, the rectangle passed to updated()
+    only covers the pixels that differ from the previous frame. If the size of the frame changes, resized() is emitted. You can
     call currentImage() or currentPixmap() to get a copy of the current
     frame. When the movie is done, QMovie emits finished(). If any error
     occurs during playback (i.e, the image file is corrupt), QMovie will emit
@@ -115,6 +116,13 @@
     \value CacheNone No frames are cached (the default).
 
     \value CacheAll All frames are cached.
+
+    \value [since 6.4] CacheAhead The next few frames are decoded ahead of
+    time in a worker thread. Movies that play the same file with the same
+    settings share the decoded frames, and an animation whose frames fit into
+    a few megabytes is decoded only once. Only sequential playback benefits
+    from this mode; it behaves like CacheNone for movies that read from a
+    device rather than a file.
 */
 
 /*! \fn void QMovie::started()
@@ -188,6 +196,18 @@
 #include "private/qobject_p.h"
 #include "private/qproperty_p.h"
 
+#if QT_CONFIG(thread)
+#include "qdatetime.h"
+#include "qfileinfo.h"
+#include "qhash.h"
+#include "qmutex.h"
+#include "qsharedpointer.h"
+#include "qthreadpool.h"
+#include "qwaitcondition.h"
+#endif
+
+#include <optional>
+
 #define QMOVIE_INVALID_DELAY -1
 
 QT_BEGIN_NAMESPACE
@@ -223,6 +243,349 @@ public:
 };
 Q_DECLARE_TYPEINFO(QFrameInfo, Q_RELOCATABLE_TYPE);
 
+#if QT_CONFIG(thread)
+/*!
+    \internal
+
+    Decodes the frames of an animation file on the global thread pool, a few
+    frames ahead of the movies in QMovie::CacheAhead mode that play it.
+    Movies with the same file and settings share a source. A source keeps all
+    frames as long as they fit into RetainLimit, so that looping and further
+    movies need no decoding at all; beyond that, it drops the frames that
+    none of its movies needs any more.
+*/
+class QMovieFrameSource : public QEnableSharedFromThis<QMovieFrameSource>
+{
+public:
+    struct Key
+    {
+        QString fileName;
+        QByteArray format;
+        QSize scaledSize;
+        QColor backgroundColor;
+        QDateTime lastModified;
+        qint64 fileSize;
+
+        friend bool operator==(const Key &lhs, const Key &rhs)
+        {
+            return lhs.fileName == rhs.fileName && lhs.format == rhs.format
+                    && lhs.scaledSize == rhs.scaledSize
+                    && lhs.backgroundColor == rhs.backgroundColor
+                    && lhs.lastModified == rhs.lastModified && lhs.fileSize == rhs.fileSize;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.fileName, key.format, key.scaledSize.width(),
+                              key.scaledSize.height(), key.fileSize);
+        }
+    };
+
+    struct Frame
+    {
+        QImage image;
+        int delay = QMOVIE_INVALID_DELAY;
+        QRect dirtyRect; // what changed compared to the previous frame
+    };
+
+    enum Status { FrameReady, EndOfAnimation, DecodingFailed, FrameUnavailable };
+
+    static QSharedPointer<QMovieFrameSource> acquire(const Key &key, bool shared);
+
+    explicit QMovieFrameSource(const Key &key) : key(key) { }
+
+    Status frame(const void *consumer, int frameNumber, Frame *frame);
+    void release(const void *consumer);
+
+private:
+    void evict();
+    void restart();
+    int wantedFrameCount() const;
+    void scheduleDecoding();
+    void decodeFrames(QMutexLocker<QMutex> &locker, int until = -1);
+
+    static QRect changedRect(const QImage &from, const QImage &to);
+
+    // keep every frame while they take up less memory than this
+    static constexpr qsizetype RetainLimit = 16 * 1024 * 1024;
+    // and decode this many frames ahead of the movies
+    static constexpr int DecodeAhead = 4;
+
+    const Key key;
+
+    QMutex mutex;
+    QWaitCondition frameDecoded;
+    QHash<const void *, int> cursors; // the next frame each movie needs
+    QList<Frame> frames; // the frames from firstFrame to decodedCount
+    int firstFrame = 0;
+    int decodedCount = 0;
+    qsizetype retainedBytes = 0;
+    bool retainAll = true;
+    bool decoding = false;
+    bool atEnd = false;
+    bool failed = false;
+
+    // only used by whoever set decoding
+    QScopedPointer<QImageReader> reader;
+    QImage previousImage;
+};
+
+Q_GLOBAL_STATIC(QMutex, frameSourcesMutex)
+typedef QHash<QMovieFrameSource::Key, QWeakPointer<QMovieFrameSource>> QMovieFrameSources;
+Q_GLOBAL_STATIC(QMovieFrameSources, frameSources)
+
+/*!
+    \internal
+
+    Returns the source for \a key that other movies use as well if \a shared
+    is \c true; otherwise returns a new source.
+*/
+QSharedPointer<QMovieFrameSource> QMovieFrameSource::acquire(const Key &key, bool shared)
+{
+    if (!shared)
+        return QSharedPointer<QMovieFrameSource>::create(key);
+
+    QMutexLocker locker(frameSourcesMutex());
+    QMovieFrameSources &sources = *frameSources();
+    sources.removeIf([](const auto &it) { return it.value().isNull(); });
+    QSharedPointer<QMovieFrameSource> source = sources.value(key).toStrongRef();
+    if (!source) {
+        source = QSharedPointer<QMovieFrameSource>::create(key);
+        sources.insert(key, source);
+    }
+    return source;
+}
+
+/*!
+    \internal
+
+    Returns the frame \a frameNumber in \a frame for the movie \a consumer,
+    waiting for the frame to be decoded if necessary.
+
+    Returns FrameUnavailable if the frame has been dropped already and the
+    source cannot decode it again without disturbing its other movies.
+*/
+QMovieFrameSource::Status QMovieFrameSource::frame(const void *consumer, int frameNumber,
+                                                  Frame *frame)
+{
+    QMutexLocker locker(&mutex);
+    while (frameNumber < firstFrame) {
+        if (cursors.size() > 1 || (cursors.size() == 1 && !cursors.contains(consumer)))
+            return FrameUnavailable;
+        if (!decoding) {
+            restart();
+            break;
+        }
+        frameDecoded.wait(&mutex);
+    }
+    cursors.insert(consumer, frameNumber);
+    evict();
+
+    for (;;) {
+        if (frameNumber < decodedCount) {
+            *frame = frames.at(frameNumber - firstFrame);
+            cursors.insert(consumer, frameNumber + 1);
+            evict();
+            scheduleDecoding();
+            return FrameReady;
+        }
+        if (failed)
+            return DecodingFailed;
+        if (atEnd)
+            return frameNumber == decodedCount ? EndOfAnimation : DecodingFailed;
+        if (decoding) {
+            frameDecoded.wait(&mutex);
+        } else {
+            // the pool had no thread for the worker; decode only what we
+            // need right now, and leave the rest to a worker again
+            decoding = true;
+            decodeFrames(locker, frameNumber + 1);
+            decoding = false;
+            frameDecoded.wakeAll();
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Stops decoding frames for the movie \a consumer.
+*/
+void QMovieFrameSource::release(const void *consumer)
+{
+    QMutexLocker locker(&mutex);
+    cursors.remove(consumer);
+    evict();
+}
+
+/*!
+    \internal
+
+    Drops the frames that no movie needs any more, unless all are kept.
+*/
+void QMovieFrameSource::evict()
+{
+    if (retainAll || cursors.isEmpty())
+        return;
+    const int needed = qMin(*std::min_element(cursors.cbegin(), cursors.cend()), decodedCount);
+    while (firstFrame < needed) {
+        retainedBytes -= frames.takeFirst().image.sizeInBytes();
+        ++firstFrame;
+    }
+}
+
+/*!
+    \internal
+
+    Starts decoding the animation from the beginning again.
+*/
+void QMovieFrameSource::restart()
+{
+    Q_ASSERT(!decoding);
+    reader.reset();
+    previousImage = QImage();
+    frames.clear();
+    firstFrame = 0;
+    decodedCount = 0;
+    retainedBytes = 0;
+    atEnd = false;
+    failed = false;
+}
+
+int QMovieFrameSource::wantedFrameCount() const
+{
+    if (cursors.isEmpty())
+        return 0;
+    return *std::max_element(cursors.cbegin(), cursors.cend()) + DecodeAhead;
+}
+
+/*!
+    \internal
+
+    Decodes the frames the movies will need next on the global thread pool.
+    If the pool has no thread available, the movies decode the frames
+    themselves when they need them.
+*/
+void QMovieFrameSource::scheduleDecoding()
+{
+    if (decoding || atEnd || failed || decodedCount >= wantedFrameCount())
+        return;
+
+    decoding = true;
+    const QSharedPointer<QMovieFrameSource> self = sharedFromThis();
+    const bool started = QThreadPool::globalInstance()->tryStart([self] {
+        QMutexLocker locker(&self->mutex);
+        self->decodeFrames(locker);
+        self->decoding = false;
+        self->frameDecoded.wakeAll();
+    });
+    if (!started)
+        decoding = false;
+}
+
+/*!
+    \internal
+
+    Decodes frames until there are \a until of them, or until the movies have
+    enough of them if \a until is -1. The mutex held by \a locker is released
+    while decoding.
+*/
+void QMovieFrameSource::decodeFrames(QMutexLocker<QMutex> &locker, int until)
+{
+    Q_ASSERT(decoding);
+    while (!atEnd && !failed && decodedCount < (until < 0 ? wantedFrameCount() : until)) {
+        const int frameNumber = decodedCount;
+        locker.unlock();
+
+        if (!reader) {
+            reader.reset(new QImageReader(key.fileName, key.format));
+            reader->setScaledSize(key.scaledSize);
+            reader->setBackgroundColor(key.backgroundColor);
+        }
+        Frame frame;
+        bool end = false;
+        if (reader->canRead()) {
+            frame.image = reader->read();
+            frame.delay = reader->nextImageDelay();
+            frame.dirtyRect = changedRect(previousImage, frame.image);
+            previousImage = frame.image;
+        } else {
+            end = frameNumber != 0;
+        }
+
+        locker.relock();
+        if (end) {
+            atEnd = true;
+        } else if (frame.image.isNull()) {
+            failed = true;
+        } else {
+            retainedBytes += frame.image.sizeInBytes();
+            frames.append(std::move(frame));
+            ++decodedCount;
+            if (retainAll && retainedBytes > RetainLimit) {
+                // too big to keep around; the frames already shown go away,
+                // so movies starting later cannot use this source any more
+                retainAll = false;
+                QMutexLocker sourcesLocker(frameSourcesMutex());
+                QMovieFrameSources &sources = *frameSources();
+                const auto it = sources.constFind(key);
+                if (it != sources.cend() && it.value() == sharedFromThis())
+                    sources.erase(it);
+            }
+            evict();
+        }
+        frameDecoded.wakeAll();
+    }
+    if (atEnd || failed)
+        reader.reset();
+}
+
+/*!
+    \internal
+
+    Returns the bounding rectangle of the pixels that differ between the
+    images \a from and \a to.
+*/
+QRect QMovieFrameSource::changedRect(const QImage &from, const QImage &to)
+{
+    if (from.size() != to.size() || from.format() != to.format() || to.depth() % 8)
+        return to.rect();
+
+    const int bytesPerPixel = to.depth() / 8;
+    const size_t rowBytes = size_t(to.width()) * bytesPerPixel;
+    const auto rowsDiffer = [&](int y) {
+        return memcmp(from.constScanLine(y), to.constScanLine(y), rowBytes) != 0;
+    };
+    int top = 0;
+    while (top < to.height() && !rowsDiffer(top))
+        ++top;
+    if (top == to.height())
+        return QRect();
+    int bottom = to.height() - 1;
+    while (!rowsDiffer(bottom))
+        --bottom;
+
+    int left = to.width();
+    int right = -1;
+    for (int y = top; y <= bottom; ++y) {
+        const uchar *a = from.constScanLine(y);
+        const uchar *b = to.constScanLine(y);
+        for (int x = 0; x < left; ++x) {
+            if (memcmp(a + x * bytesPerPixel, b + x * bytesPerPixel, bytesPerPixel)) {
+                left = x;
+                break;
+            }
+        }
+        for (int x = to.width() - 1; x > right; --x) {
+            if (memcmp(a + x * bytesPerPixel, b + x * bytesPerPixel, bytesPerPixel)) {
+                right = x;
+                break;
+            }
+        }
+    }
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+#endif // QT_CONFIG(thread)
+
 class QMoviePrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QMovie)
@@ -238,6 +601,10 @@ public:
     bool jumpToNextFrame();
     QFrameInfo infoForFrame(int frameNumber);
     void reset();
+#if QT_CONFIG(thread)
+    QMovieFrameSource *acquireFrameSource(bool shared);
+    void releaseFrameSource();
+#endif
 
     inline void enterState(QMovie::MovieState newState) {
         movieState = newState;
@@ -256,6 +623,8 @@ public:
     QMovie::MovieState movieState = QMovie::NotRunning;
     QRect frameRect;
     QPixmap currentPixmap;
+    QRect updatedRect;
+    std::optional<QRect> frameDirtyRect;
     int currentFrameNumber = -1;
     int nextFrameNumber = 0;
     int greatestFrameNumber = -1;
@@ -268,6 +637,9 @@ public:
     bool isFirstIteration = true;
     QMap<int, QFrameInfo> frameMap;
     QString absoluteFilePath;
+#if QT_CONFIG(thread)
+    QSharedPointer<QMovieFrameSource> frameSource;
+#endif
 
     QTimer nextImageTimer;
 };
@@ -295,8 +667,43 @@ void QMoviePrivate::reset()
     haveReadAll = false;
     isFirstIteration = true;
     frameMap.clear();
+#if QT_CONFIG(thread)
+    releaseFrameSource();
+#endif
+}
+
+#if QT_CONFIG(thread)
+/*! \internal
+
+    Returns the source that decodes the frames of the movie file ahead of
+    time, or \nullptr if the movie does not read from a file.
+*/
+QMovieFrameSource *QMoviePrivate::acquireFrameSource(bool shared)
+{
+    if (frameSource)
+        return frameSource.get();
+    const QFileInfo fileInfo(absoluteFilePath);
+    if (absoluteFilePath.isEmpty() || reader->fileName().isEmpty() || !fileInfo.isFile())
+        return nullptr;
+
+    QMovieFrameSource::Key key{ absoluteFilePath, reader->format(), reader->scaledSize(),
+                                reader->backgroundColor(), fileInfo.lastModified(),
+                                fileInfo.size() };
+    frameSource = QMovieFrameSource::acquire(key, shared);
+    return frameSource.get();
 }
 
+/*! \internal
+ */
+void QMoviePrivate::releaseFrameSource()
+{
+    if (frameSource) {
+        frameSource->release(this);
+        frameSource.reset();
+    }
+}
+#endif
+
 /*! \internal
  */
 bool QMoviePrivate::isDone()
@@ -333,6 +740,7 @@ QFrameInfo QMoviePrivate::infoForFrame(int frameNumber)
 {
     Q_Q(QMovie);
 
+    frameDirtyRect.reset();
     if (frameNumber < 0)
         return QFrameInfo(); // Invalid
 
@@ -342,7 +750,39 @@ QFrameInfo QMoviePrivate::infoForFrame(int frameNumber)
         return QFrameInfo(); // Invalid
     }
 
-    if (cacheMode == QMovie::CacheNone) {
+#if QT_CONFIG(thread)
+    if (cacheMode != QMovie::CacheAhead) {
+        releaseFrameSource();
+    } else if (QMovieFrameSource *source = acquireFrameSource(true)) {
+        QMovieFrameSource::Frame frame;
+        QMovieFrameSource::Status status = source->frame(this, frameNumber, &frame);
+        if (status == QMovieFrameSource::FrameUnavailable) {
+            // the frame is gone from the source we share; decode on our own
+            releaseFrameSource();
+            source = acquireFrameSource(false);
+            if (source)
+                status = source->frame(this, frameNumber, &frame);
+        }
+        switch (status) {
+        case QMovieFrameSource::FrameReady:
+            if (frameNumber > greatestFrameNumber)
+                greatestFrameNumber = frameNumber;
+            if (frameNumber == currentFrameNumber + 1 && frameNumber > 0)
+                frameDirtyRect = frame.dirtyRect;
+            return QFrameInfo(QPixmap::fromImage(std::move(frame.image)), frame.delay);
+        case QMovieFrameSource::EndOfAnimation:
+            haveReadAll = true;
+            return QFrameInfo::endMarker();
+        case QMovieFrameSource::DecodingFailed:
+        case QMovieFrameSource::FrameUnavailable:
+            // let our own reader run into the error, so that it is reported
+            releaseFrameSource();
+            break;
+        }
+    }
+#endif
+
+    if (cacheMode != QMovie::CacheAll) {
         if (frameNumber != currentFrameNumber+1) {
             // Non-sequential frame access
             if (!reader->jumpToImage(frameNumber)) {
@@ -463,10 +903,13 @@ bool QMoviePrivate::next()
     // Image and delay OK, update internal state
     currentFrameNumber = nextFrameNumber++;
     QSize scaledSize = reader->scaledSize();
-    if (scaledSize.isValid() && (scaledSize != info.pixmap.size()))
+    if (scaledSize.isValid() && (scaledSize != info.pixmap.size())) {
         currentPixmap = QPixmap::fromImage( info.pixmap.toImage().scaled(scaledSize) );
-    else
+        frameDirtyRect.reset();
+    } else {
         currentPixmap = info.pixmap;
+    }
+    updatedRect = frameDirtyRect.value_or(currentPixmap.rect());
 
     if (!speed)
         return true;
@@ -499,10 +942,11 @@ void QMoviePrivate::_q_loadNextFrame(bool starting)
 
         if (frameRect.size() != currentPixmap.rect().size()) {
             frameRect = currentPixmap.rect();
+            updatedRect = frameRect;
             emit q->resized(frameRect.size());
         }
 
-        emit q->updated(frameRect);
+        emit q->updated(updatedRect);
         emit q->frameChanged(currentFrameNumber);
 
         if (speed && movieState == QMovie::Running)
@@ -638,6 +1082,9 @@ QMovie::QMovie(const QString &fileName, const QByteArray &format, QObject *paren
 QMovie::~QMovie()
 {
     Q_D(QMovie);
+#if QT_CONFIG(thread)
+    d->releaseFrameSource();
+#endif
     delete d->reader;
 }
 
@@ -707,6 +1154,9 @@ void QMovie::setFormat(const QByteArray &format)
 {
     Q_D(QMovie);
     d->reader->setFormat(format);
+#if QT_CONFIG(thread)
+    d->releaseFrameSource();
+#endif
 }
 
 /*!
@@ -731,6 +1181,9 @@ void QMovie::setBackgroundColor(const QColor &color)
 {
     Q_D(QMovie);
     d->reader->setBackgroundColor(color);
+#if QT_CONFIG(thread)
+    d->releaseFrameSource();
+#endif
 }
 
 /*!
@@ -1013,6 +1466,9 @@ void QMovie::setScaledSize(const QSize &size)
 {
     Q_D(QMovie);
     d->reader->setScaledSize(size);
+#if QT_CONFIG(thread)
+    d->releaseFrameSource();
+#endif
 }
 
 /*!
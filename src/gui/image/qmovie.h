@@ -75,7 +75,8 @@ public:
     Q_ENUM(MovieState)
     enum CacheMode {
         CacheNone,
-        CacheAll
+        CacheAll,
+        CacheAhead
     };
     Q_ENUM(CacheMode)
 
@@ -238,6 +238,10 @@ public:
 
     bool flushDetachedPixmaps(bool nt);
 
+    void countLookup(bool hit) { ++(hit ? hits : misses); }
+    quint64 hits = 0;
+    quint64 misses = 0;
+
 private:
     enum { soon_time = 10000, flush_time = 30000 };
     int *keyArray;
@@ -489,6 +493,37 @@ int Q_AUTOTEST_EXPORT q_QPixmapCache_keyHashSize()
     return pm_cache()->size();
 }
 
+/*!
+    \internal
+
+    Returns the lookup counts since the last qt_resetPixmapCacheStatistics()
+    call and the current memory use of the pixmap cache, or empty statistics
+    when called outside of the main thread.
+*/
+QPixmapCacheStatistics qt_pixmapCacheStatistics()
+{
+    QPixmapCacheStatistics statistics;
+    if (!qt_pixmapcache_thread_test() || !pm_cache.exists())
+        return statistics;
+    const QPMCache *cache = pm_cache();
+    statistics.hits = cache->hits;
+    statistics.misses = cache->misses;
+    statistics.count = cache->count();
+    statistics.totalCost = cache->totalCost();
+    statistics.maxCost = cache->maxCost();
+    return statistics;
+}
+
+/*!
+    \internal
+*/
+void qt_resetPixmapCacheStatistics()
+{
+    if (!qt_pixmapcache_thread_test() || !pm_cache.exists())
+        return;
+    pm_cache()->hits = pm_cache()->misses = 0;
+}
+
 QPixmapCacheEntry::~QPixmapCacheEntry()
 {
     pm_cache()->releaseKey(key);
@@ -510,6 +545,7 @@ bool QPixmapCache::find(const QString &key, QPixmap *pixmap)
     if (!qt_pixmapcache_thread_test())
         return false;
     QPixmap *ptr = pm_cache()->object(key);
+    pm_cache()->countLookup(ptr != nullptr);
     if (ptr && pixmap)
         *pixmap = *ptr;
     return ptr != nullptr;
@@ -529,9 +565,12 @@ bool QPixmapCache::find(const Key &key, QPixmap *pixmap)
     if (!qt_pixmapcache_thread_test())
         return false;
     //The key is not valid anymore, a flush happened before probably
-    if (!key.d || !key.d->isValid)
+    if (!key.d || !key.d->isValid) {
+        pm_cache()->countLookup(false);
         return false;
+    }
     QPixmap *ptr = pm_cache()->object(key);
+    pm_cache()->countLookup(ptr != nullptr);
     if (ptr && pixmap)
         *pixmap = *ptr;
     return ptr != nullptr;
@@ -54,6 +54,7 @@
 #include "qpixmapcache.h"
 #include "qpaintengine.h"
 #include <private/qimage_p.h>
+#include <private/qimagecache_p.h>
 #include <private/qpixmap_raster_p.h>
 #include "qcache.h"
 
@@ -61,6 +62,11 @@ QT_BEGIN_NAMESPACE
 
 size_t qHash(const QPixmapCache::Key &k, size_t seed = 0);
 
+// Same figures as QImageCache reports, in kilobytes
+using QPixmapCacheStatistics = QImageCache::Statistics;
+Q_GUI_EXPORT QPixmapCacheStatistics qt_pixmapCacheStatistics();
+Q_GUI_EXPORT void qt_resetPixmapCacheStatistics();
+
 class QPixmapCache::KeyData
 {
 public:
@@ -56,6 +56,12 @@
 #include <png.h>
 #include <pngconf.h>
 
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#include <zlib.h>
+#endif
+
 #if PNG_LIBPNG_VER >= 10400 && PNG_LIBPNG_VER <= 10502 \
         && defined(PNG_PEDANTIC_WARNINGS_SUPPORTED)
 /*
@@ -119,6 +125,7 @@ public:
     int compression;
     QString description;
     QSize scaledSize;
+    QRect clipRect;
     QStringList readTexts;
     QColorSpace colorSpace;
     ColorSpaceState colorSpaceState;
@@ -240,7 +247,7 @@ void qpiw_flush_fn(png_structp /* png_ptr */)
 }
 
 static
-bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scaledSize, bool *doScaledRead)
+bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize size, QSize scaledSize, bool *doScaledRead)
 {
     png_uint_32 width = 0;
     png_uint_32 height = 0;
@@ -253,7 +260,6 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
     int num_palette;
     int interlace_method = PNG_INTERLACE_LAST;
     png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, &interlace_method, nullptr, nullptr);
-    QSize size(width, height);
     png_set_interlace_handling(png_ptr);
 
     if (color_type == PNG_COLOR_TYPE_GRAY) {
@@ -329,7 +335,6 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
             png_set_packing(png_ptr);
         png_read_update_info(png_ptr, info_ptr);
         png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
-        size = QSize(width, height);
         QImage::Format format = bit_depth == 1 ? QImage::Format_Mono : QImage::Format_Indexed8;
         if (!QImageIOHandler::allocateImage(size, format, &image))
             return false;
@@ -394,9 +399,9 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
             // We want 4 bytes, but it isn't an alpha channel
             format = QImage::Format_RGB32;
         }
-        QSize outSize(width,height);
-        if (!scaledSize.isEmpty() && quint32(scaledSize.width()) <= width &&
-            quint32(scaledSize.height()) <= height && scaledSize != outSize && interlace_method == PNG_INTERLACE_NONE) {
+        QSize outSize = size;
+        if (!scaledSize.isEmpty() && scaledSize.width() <= size.width() &&
+            scaledSize.height() <= size.height() && scaledSize != outSize && interlace_method == PNG_INTERLACE_NONE) {
             // Do inline downscaling
             outSize = scaledSize;
             if (doScaledRead)
@@ -419,7 +424,8 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
 }
 
 static void read_image_scaled(QImage *outImage, png_structp png_ptr, png_infop info_ptr,
-                              QPngHandlerPrivate::AllocatedMemoryPointers &amp, QSize scaledSize)
+                              QPngHandlerPrivate::AllocatedMemoryPointers &amp, QSize scaledSize,
+                              const QRect &readRect)
 {
 
     png_uint_32 width = 0;
@@ -438,28 +444,34 @@ static void read_image_scaled(QImage *outImage, png_structp png_ptr, png_infop i
     if (scaledSize.isEmpty() || !width || !height)
         return;
 
-    const quint32 iysz = height;
-    const quint32 ixsz = width;
+    const quint32 iysz = readRect.height();
+    const quint32 ixsz = readRect.width();
     const quint32 oysz = scaledSize.height();
     const quint32 oxsz = scaledSize.width();
-    const quint32 ibw = 4*width;
+    const quint32 ibw = 4*ixsz;
     amp.accRow = new quint32[ibw];
     memset(amp.accRow, 0, ibw*sizeof(quint32));
-    amp.inRow = new png_byte[ibw];
-    memset(amp.inRow, 0, ibw*sizeof(png_byte));
+    amp.inRow = new png_byte[4*width];
+    memset(amp.inRow, 0, 4*width*sizeof(png_byte));
     amp.outRow = new uchar[ibw];
     memset(amp.outRow, 0, ibw*sizeof(uchar));
+
+    // Skip the rows above the clip rect, and only look at the pixels inside it
+    for (int y = 0; y < readRect.y(); y++)
+        png_read_row(png_ptr, amp.inRow, nullptr);
+    const png_byte *inRow = amp.inRow + 4 * readRect.x();
+
     qint32 rval = 0;
     for (quint32 oy=0; oy<oysz; oy++) {
         // Store the rest of the previous input row, if any
         for (quint32 i=0; i < ibw; i++)
-            amp.accRow[i] = rval*amp.inRow[i];
+            amp.accRow[i] = rval*inRow[i];
         // Accumulate the next input rows
         for (rval = iysz-rval; rval > 0; rval-=oysz) {
             png_read_row(png_ptr, amp.inRow, nullptr);
             quint32 fact = qMin(oysz, quint32(rval));
             for (quint32 i=0; i < ibw; i++)
-                amp.accRow[i] += fact*amp.inRow[i];
+                amp.accRow[i] += fact*inRow[i];
         }
         rval *= -1;
 
@@ -497,6 +509,22 @@ static void read_image_scaled(QImage *outImage, png_structp png_ptr, png_infop i
 
 }
 
+static void read_image_clipped(QImage *outImage, png_structp png_ptr, png_infop info_ptr,
+                               QPngHandlerPrivate::AllocatedMemoryPointers &amp, const QRect &readRect)
+{
+    // The rows are read one by one, and the reading stops after the last
+    // one of the clip rect, so that the full image is never allocated
+    const qsizetype bytesPerPixel = outImage->depth() / 8;
+    const qsizetype bytesPerRow = bytesPerPixel * readRect.width();
+    amp.inRow = new png_byte[png_get_rowbytes(png_ptr, info_ptr)];
+    for (int y = 0; y <= readRect.bottom(); y++) {
+        png_read_row(png_ptr, amp.inRow, nullptr);
+        if (y >= readRect.y())
+            memcpy(outImage->scanLine(y - readRect.y()), amp.inRow + bytesPerPixel * readRect.x(), bytesPerRow);
+    }
+    amp.deallocate();
+}
+
 extern "C" {
 static void qt_png_warning(png_structp /*png_ptr*/, png_const_charp message)
 {
@@ -666,8 +694,22 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         colorSpaceState = GammaChrm;
     }
 
+    // The clip rect can be applied while reading if the rows come in order
+    // and each pixel takes at least one byte; otherwise the full image is
+    // read and clipped afterwards, before scaling it.
+    png_uint_32 width = 0;
+    png_uint_32 height = 0;
+    int bit_depth = 0;
+    int interlace_method = PNG_INTERLACE_LAST;
+    png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, nullptr, &interlace_method, nullptr, nullptr);
+    const QRect imageRect(0, 0, width, height);
+    const bool doClippedRead = !clipRect.isNull() && imageRect.contains(clipRect)
+                               && interlace_method == PNG_INTERLACE_NONE && bit_depth > 1;
+    const QRect readRect = doClippedRead ? clipRect : imageRect;
+
     bool doScaledRead = false;
-    if (!setup_qt(*outImage, png_ptr, info_ptr, scaledSize, &doScaledRead)) {
+    if (!setup_qt(*outImage, png_ptr, info_ptr, readRect.size(),
+                  clipRect.isNull() || doClippedRead ? scaledSize : QSize(), &doScaledRead)) {
         png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
         png_ptr = nullptr;
         amp.deallocate();
@@ -676,27 +718,29 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     }
 
     if (doScaledRead) {
-        read_image_scaled(outImage, png_ptr, info_ptr, amp, scaledSize);
+        read_image_scaled(outImage, png_ptr, info_ptr, amp, scaledSize, readRect);
     } else {
-        png_uint_32 width = 0;
-        png_uint_32 height = 0;
         png_int_32 offset_x = 0;
         png_int_32 offset_y = 0;
 
-        int bit_depth = 0;
         int color_type = 0;
         int unit_type = PNG_OFFSET_PIXEL;
         png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
         png_get_oFFs(png_ptr, info_ptr, &offset_x, &offset_y, &unit_type);
         uchar *data = outImage->bits();
         qsizetype bpl = outImage->bytesPerLine();
-        amp.row_pointers = new png_bytep[height];
 
-        for (uint y = 0; y < height; y++)
-            amp.row_pointers[y] = data + y * bpl;
+        if (doClippedRead) {
+            read_image_clipped(outImage, png_ptr, info_ptr, amp, readRect);
+        } else {
+            amp.row_pointers = new png_bytep[height];
 
-        png_read_image(png_ptr, amp.row_pointers);
-        amp.deallocate();
+            for (uint y = 0; y < height; y++)
+                amp.row_pointers[y] = data + y * bpl;
+
+            png_read_image(png_ptr, amp.row_pointers);
+            amp.deallocate();
+        }
 
         outImage->setDotsPerMeterX(png_get_x_pixels_per_meter(png_ptr,info_ptr));
         outImage->setDotsPerMeterY(png_get_y_pixels_per_meter(png_ptr,info_ptr));
@@ -707,9 +751,9 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         // sanity check palette entries
         if (color_type == PNG_COLOR_TYPE_PALETTE && outImage->format() == QImage::Format_Indexed8) {
             int color_table_size = outImage->colorCount();
-            for (int y=0; y<(int)height; ++y) {
+            for (int y=0; y<outImage->height(); ++y) {
                 uchar *p = FAST_SCAN_LINE(data, bpl, y);
-                uchar *end = p + width;
+                uchar *end = p + outImage->width();
                 while (p < end) {
                     if (*p >= color_table_size)
                         *p = 0;
@@ -720,9 +764,11 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     }
 
     state = ReadingEnd;
-    png_read_end(png_ptr, end_info);
-
-    readPngTexts(end_info);
+    // Stopping early after the clip rect leaves the remaining image data unread
+    if (readRect.bottom() == imageRect.bottom()) {
+        png_read_end(png_ptr, end_info);
+        readPngTexts(end_info);
+    }
     for (int i = 0; i < readTexts.size()-1; i+=2)
         outImage->setText(readTexts.at(i), readTexts.at(i+1));
 
@@ -731,6 +777,9 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     amp.deallocate();
     state = Ready;
 
+    if (!clipRect.isNull() && !doClippedRead)
+        *outImage = outImage->copy(clipRect);
+
     if (scaledSize.isValid() && outImage->size() != scaledSize)
         *outImage = outImage->scaled(scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 
@@ -875,6 +924,244 @@ static void set_text(const QImage &image, png_structp png_ptr, png_infop info_pt
     delete [] text_ptr;
 }
 
+#if QT_CONFIG(thread)
+namespace {
+// Compresses the image data of large 8-bit RGB, RGBA and grayscale images
+// the way pigz does: the rows are split into blocks that are filtered and
+// deflated independently on the global thread pool, each block ending on a
+// byte boundary with a sync flush so that the results can be concatenated
+// into one zlib stream. Each block is primed with the last 32 KiB of the
+// data before it, so this compresses nearly as well as a single stream.
+class ParallelIdatEncoder
+{
+public:
+    ParallelIdatEncoder(const QImage &image, int level);
+
+    bool isApplicable() const { return !rows.isNull(); }
+    QList<QByteArray> encode();
+
+private:
+    struct Block
+    {
+        int firstRow;
+        int endRow;
+        QByteArray data;
+        uLong adler;
+        uLong length;
+    };
+
+    void filterRow(uchar *out, int y, uchar *scratch) const;
+    void compressBlock(Block &block, bool last) const;
+
+    // blocks hold about this much filtered data
+    static constexpr qsizetype BlockSize = 256 * 1024;
+    static constexpr qsizetype WindowSize = 32 * 1024;
+
+    QImage rows;
+    qsizetype rowBytes = 0;
+    int bytesPerPixel = 0;
+    int level;
+};
+
+ParallelIdatEncoder::ParallelIdatEncoder(const QImage &image, int level)
+    : level(level < 0 ? Z_DEFAULT_COMPRESSION : level)
+{
+    // the same conversions as the transformations libpng applies when writing
+    QImage::Format format;
+    switch (image.format()) {
+    case QImage::Format_Grayscale8:
+        format = QImage::Format_Grayscale8;
+        bytesPerPixel = 1;
+        break;
+    case QImage::Format_RGB32:
+    case QImage::Format_RGB888:
+    case QImage::Format_BGR888:
+    case QImage::Format_RGBX8888:
+        format = QImage::Format_RGB888;
+        bytesPerPixel = 3;
+        break;
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+    case QImage::Format_RGBA8888:
+    case QImage::Format_RGBA8888_Premultiplied:
+        format = QImage::Format_RGBA8888;
+        bytesPerPixel = 4;
+        break;
+    default:
+        return;
+    }
+
+    rowBytes = qsizetype(image.width()) * bytesPerPixel;
+    const qsizetype size = (rowBytes + 1) * image.height();
+    if (size < 2 * BlockSize || QThreadPool::globalInstance()->maxThreadCount() < 2)
+        return;
+    rows = image.convertToFormat(format);
+}
+
+static inline uchar paethPredictor(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = qAbs(p - a);
+    const int pb = qAbs(p - b);
+    const int pc = qAbs(p - c);
+    if (pa <= pb && pa <= pc)
+        return uchar(a);
+    return uchar(pb <= pc ? b : c);
+}
+
+// Writes the filter type byte and the filtered row \a y to \a out, choosing
+// the filter whose output has the smallest sum of absolute values, as libpng
+// does. Fast levels only try the two cheapest filters.
+void ParallelIdatEncoder::filterRow(uchar *out, int y, uchar *scratch) const
+{
+    enum { None, Sub, Up, Average, Paeth, FilterCount };
+    const uchar *row = rows.constScanLine(y);
+    const uchar *prior = y > 0 ? rows.constScanLine(y - 1) : nullptr;
+    const int bpp = bytesPerPixel;
+
+    if (level == 0) {
+        out[0] = None;
+        memcpy(out + 1, row, size_t(rowBytes));
+        return;
+    }
+
+    const bool fast = level <= 3;
+    int best = None;
+    quint64 bestCost = std::numeric_limits<quint64>::max();
+    for (int filter = None; filter < FilterCount; ++filter) {
+        if (fast && filter != Sub && filter != Up)
+            continue;
+        uchar *candidate = scratch + filter * rowBytes;
+        quint64 cost = 0;
+        for (qsizetype i = 0; i < rowBytes; ++i) {
+            const int left = i >= bpp ? row[i - bpp] : 0;
+            const int up = prior ? prior[i] : 0;
+            const int upLeft = prior && i >= bpp ? prior[i - bpp] : 0;
+            uchar value;
+            switch (filter) {
+            case None: value = row[i]; break;
+            case Sub: value = uchar(row[i] - left); break;
+            case Up: value = uchar(row[i] - up); break;
+            case Average: value = uchar(row[i] - ((left + up) >> 1)); break;
+            default: value = uchar(row[i] - paethPredictor(left, up, upLeft)); break;
+            }
+            candidate[i] = value;
+            cost += qAbs(int(qint8(value)));
+        }
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = filter;
+        }
+    }
+    out[0] = uchar(best);
+    memcpy(out + 1, scratch + best * rowBytes, size_t(rowBytes));
+}
+
+void ParallelIdatEncoder::compressBlock(Block &block, bool last) const
+{
+    const qsizetype filteredRowBytes = rowBytes + 1;
+    // the rows before the block that fill the deflate window
+    const int windowRows = int(qMin(qsizetype(block.firstRow),
+                                    (WindowSize + filteredRowBytes - 1) / filteredRowBytes));
+    const int firstRow = block.firstRow - windowRows;
+
+    QByteArray filtered(filteredRowBytes * (block.endRow - firstRow), Qt::Uninitialized);
+    QByteArray scratch(rowBytes * 5, Qt::Uninitialized);
+    uchar *out = reinterpret_cast<uchar *>(filtered.data());
+    for (int y = firstRow; y < block.endRow; ++y, out += filteredRowBytes)
+        filterRow(out, y, reinterpret_cast<uchar *>(scratch.data()));
+
+    const qsizetype windowBytes = filteredRowBytes * windowRows;
+    const Bytef *input = reinterpret_cast<const Bytef *>(filtered.constData()) + windowBytes;
+    const uInt inputSize = uInt(filtered.size() - windowBytes);
+    block.length = inputSize;
+    block.adler = adler32(adler32(0, nullptr, 0), input, inputSize);
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return;
+    if (windowBytes) {
+        const qsizetype dictionarySize = qMin(windowBytes, WindowSize);
+        deflateSetDictionary(&stream, input - dictionarySize, uInt(dictionarySize));
+    }
+
+    stream.next_in = const_cast<Bytef *>(input);
+    stream.avail_in = inputSize;
+    // the last block ends the stream; the others end on a byte boundary
+    const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    // a sync flush adds an empty stored block to what the bound covers
+    block.data.resize(qsizetype(deflateBound(&stream, inputSize)) + 16);
+    qsizetype produced = 0;
+    for (;;) {
+        stream.next_out = reinterpret_cast<Bytef *>(block.data.data()) + produced;
+        stream.avail_out = uInt(block.data.size() - produced);
+        const int res = deflate(&stream, flush);
+        produced = block.data.size() - stream.avail_out;
+        if (res == Z_STREAM_ERROR) {
+            block.data.clear();
+            break;
+        }
+        if (stream.avail_out != 0)
+            break;
+        block.data.resize(block.data.size() * 2);
+    }
+    block.data.truncate(produced);
+    deflateEnd(&stream);
+}
+
+// Returns the contents of the IDAT chunks, or an empty list on failure.
+QList<QByteArray> ParallelIdatEncoder::encode()
+{
+    const int height = rows.height();
+    const int rowsPerBlock = int(qMax(qsizetype(1), BlockSize / (rowBytes + 1)));
+    QList<Block> blocks;
+    for (int y = 0; y < height; y += rowsPerBlock)
+        blocks.append({ y, qMin(y + rowsPerBlock, height), QByteArray(), 0, 0 });
+
+    // the calling thread compresses whatever the pool has no thread for
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore compressed;
+    int started = 0;
+    for (qsizetype i = 0; i < blocks.size(); ++i) {
+        Block &block = blocks[i];
+        const bool last = i == blocks.size() - 1;
+        const auto task = [this, &block, last, &compressed] {
+            compressBlock(block, last);
+            compressed.release();
+        };
+        if (pool->tryStart(task))
+            ++started;
+        else
+            compressBlock(block, last);
+    }
+    compressed.acquire(started);
+
+    // wrap the raw deflate blocks into a zlib stream
+    const int levelFlag = level == Z_DEFAULT_COMPRESSION || level == 6 ? 2
+                        : level < 2 ? 0
+                        : level < 6 ? 1
+                                    : 3;
+    uchar header[2] = { 0x78, uchar(levelFlag << 6) };
+    header[1] |= 31 - (header[0] * 256 + header[1]) % 31;
+
+    QList<QByteArray> chunks;
+    uLong adler = adler32(0, nullptr, 0);
+    for (Block &block : blocks) {
+        if (block.data.isEmpty())
+            return {};
+        adler = adler32_combine(adler, block.adler, z_off_t(block.length));
+        chunks.append(std::move(block.data));
+    }
+    chunks.first().prepend(reinterpret_cast<const char *>(header), 2);
+    const uchar trailer[4] = { uchar(adler >> 24), uchar(adler >> 16),
+                               uchar(adler >> 8), uchar(adler) };
+    chunks.last().append(reinterpret_cast<const char *>(trailer), 4);
+    return chunks;
+}
+} // unnamed namespace
+#endif // QT_CONFIG(thread)
+
 bool QPNGImageWriter::writeImage(const QImage& image, int off_x, int off_y)
 {
     return writeImage(image, -1, QString(), off_x, off_y);
@@ -918,6 +1205,12 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
             compression = 9;
         }
         png_set_compression_level(png_ptr, compression);
+        // libpng tries all five filters on every row by default, which
+        // dominates the time spent at the fast levels
+        if (compression == 0)
+            png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_NONE);
+        else if (compression <= 3)
+            png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB | PNG_FILTER_UP);
     }
 
     png_set_write_fn(png_ptr, (void*)this, qpiw_write_fn, qpiw_flush_fn);
@@ -1104,6 +1397,27 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
         png_write_chunk(png_ptr, const_cast<png_bytep>((const png_byte *)"gIFg"), data, 4);
     }
 
+#if QT_CONFIG(thread)
+    if (color_type != PNG_COLOR_TYPE_PALETTE) {
+        ParallelIdatEncoder encoder(image, compression);
+        const QList<QByteArray> chunks = encoder.isApplicable() ? encoder.encode()
+                                                                : QList<QByteArray>();
+        if (!chunks.isEmpty()) {
+            for (const QByteArray &chunk : chunks) {
+                png_write_chunk(png_ptr, const_cast<png_bytep>((const png_byte *)"IDAT"),
+                                (png_const_bytep)chunk.constData(), png_size_t(chunk.size()));
+            }
+            // png_write_end() refuses to end a file whose image data it has
+            // not written itself; everything but IEND has been written already
+            png_write_chunk(png_ptr, const_cast<png_bytep>((const png_byte *)"IEND"),
+                            nullptr, 0);
+            frames_written++;
+            png_destroy_write_struct(&png_ptr, &info_ptr);
+            return true;
+        }
+    }
+#endif
+
     int height = image.height();
     int width = image.width();
     switch (image.format()) {
@@ -1234,7 +1548,8 @@ bool QPngHandler::supportsOption(ImageOption option) const
         || option == Quality
         || option == CompressionRatio
         || option == Size
-        || option == ScaledSize;
+        || option == ScaledSize
+        || option == ClipRect;
 }
 
 QVariant QPngHandler::option(ImageOption option) const
@@ -1257,6 +1572,8 @@ QVariant QPngHandler::option(ImageOption option) const
                      png_get_image_height(d->png_ptr, d->info_ptr));
     else if (option == ScaledSize)
         return d->scaledSize;
+    else if (option == ClipRect)
+        return d->clipRect;
     else if (option == ImageFormat)
         return d->readImageFormat();
     return QVariant();
@@ -1274,6 +1591,8 @@ void QPngHandler::setOption(ImageOption option, const QVariant &value)
         d->description = value.toString();
     else if (option == ScaledSize)
         d->scaledSize = value.toSize();
+    else if (option == ClipRect)
+        d->clipRect = value.toRect();
 }
 
 QT_END_NAMESPACE
@@ -41,6 +41,8 @@
 #include <qdebug.h>
 #include <qdiriterator.h>
 #include <private/qfileinfo_p.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
 #ifndef Q_OS_WIN
 #  include <unistd.h>
 #  include <sys/types.h>
@@ -51,6 +53,9 @@
 
 QT_BEGIN_NAMESPACE
 
+// Number of directory entries that are stat'ed together
+static constexpr int StatBatchSize = 256;
+
 #ifdef QT_BUILD_INTERNAL
 static QBasicAtomicInt fetchedRoot = Q_BASIC_ATOMIC_INITIALIZER(false);
 Q_AUTOTEST_EXPORT void qt_test_resetFetchedRoot()
@@ -326,11 +331,16 @@ void QFileInfoGatherer::run()
     }
 }
 
-QExtendedInformation QFileInfoGatherer::getInfo(const QFileInfo &fileInfo) const
+/*
+    Returns the extended information for \a fileInfo. Looking up the icon and
+    type can be expensive, so unless \a resolveDecoration is true it is left
+    to resolveDecoration() once the file is actually shown.
+*/
+QExtendedInformation QFileInfoGatherer::getInfo(const QFileInfo &fileInfo, bool resolveDecoration) const
 {
     QExtendedInformation info(fileInfo);
-    info.icon = m_iconProvider->icon(fileInfo);
-    info.displayType = m_iconProvider->type(fileInfo);
+    if (resolveDecoration)
+        this->resolveDecoration(&info);
 #if QT_CONFIG(filesystemwatcher)
     // ### Not ready to listen all modifications by default
     static const bool watchFiles = qEnvironmentVariableIsSet("QT_FILESYSTEMMODEL_WATCH_FILES");
@@ -359,9 +369,50 @@ QExtendedInformation QFileInfoGatherer::getInfo(const QFileInfo &fileInfo) const
     return info;
 }
 
+void QFileInfoGatherer::resolveDecoration(QExtendedInformation *info) const
+{
+    const QFileInfo fileInfo = info->fileInfo();
+    info->icon = m_iconProvider->icon(fileInfo);
+    info->displayType = m_iconProvider->type(fileInfo);
+    info->decorationResolved = true;
+}
+
+/*
+    Stats all \a infos, spreading the work over the global thread pool. On
+    network file systems each stat is a round trip, so they are issued
+    concurrently rather than one after the other.
+*/
+void QFileInfoGatherer::statFileInfos(QFileInfoList &infos) const
+{
+    const qsizetype count = infos.size();
+    QFileInfo *results = infos.data();
+
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const int tasks = int(qMin<qsizetype>(count, threadPool->maxThreadCount()));
+    if (tasks > 1) {
+        QAtomicInteger<qsizetype> next(0);
+        QSemaphore semaphore;
+        for (int i = 0; i < tasks; ++i) {
+            threadPool->start([&]() {
+                for (qsizetype j = next.fetchAndAddRelaxed(1); j < count && !abort.loadRelaxed();
+                     j = next.fetchAndAddRelaxed(1)) {
+                    results[j].stat();
+                }
+                semaphore.release(1);
+            });
+        }
+        semaphore.acquire(tasks);
+        return;
+    }
+
+    for (qsizetype i = 0; i < count && !abort.loadRelaxed(); ++i)
+        results[i].stat();
+}
+
 /*
     Get specific file info's, batch the files so update when we have 100
-    items and every 200ms after that
+    items and every second after that. The files are stat'ed in batches of
+    StatBatchSize.
  */
 void QFileInfoGatherer::getFileInfos(const QString &path, const QStringList &files)
 {
@@ -392,30 +443,41 @@ void QFileInfoGatherer::getFileInfos(const QString &path, const QStringList &fil
 
     QElapsedTimer base;
     base.start();
-    QFileInfo fileInfo;
     bool firstTime = true;
     QList<QPair<QString, QFileInfo>> updatedFiles;
-    QStringList filesToCheck = files;
+    QFileInfoList batch;
+    batch.reserve(StatBatchSize);
+    const auto fetchBatch = [&]() {
+        statFileInfos(batch);
+        for (const QFileInfo &fileInfo : qAsConst(batch)) {
+            if (abort.loadRelaxed())
+                break;
+            fetch(fileInfo, base, firstTime, updatedFiles, path);
+        }
+        batch.clear();
+    };
 
     QStringList allFiles;
     if (files.isEmpty()) {
         QDirIterator dirIt(path, QDir::AllEntries | QDir::System | QDir::Hidden);
         while (!abort.loadRelaxed() && dirIt.hasNext()) {
-            fileInfo = dirIt.nextFileInfo();
-            fileInfo.stat();
-            allFiles.append(fileInfo.fileName());
-            fetch(fileInfo, base, firstTime, updatedFiles, path);
+            batch.append(dirIt.nextFileInfo());
+            allFiles.append(batch.constLast().fileName());
+            if (batch.size() == StatBatchSize)
+                fetchBatch();
         }
+        if (!abort.loadRelaxed())
+            fetchBatch();
     }
     if (!allFiles.isEmpty())
         emit newListOfFiles(path, allFiles);
 
-    QStringList::const_iterator filesIt = filesToCheck.constBegin();
-    while (!abort.loadRelaxed() && filesIt != filesToCheck.constEnd()) {
-        fileInfo.setFile(path + QDir::separator() + *filesIt);
+    QStringList::const_iterator filesIt = files.constBegin();
+    while (!abort.loadRelaxed() && filesIt != files.constEnd()) {
+        batch.append(QFileInfo(path + QDir::separator() + *filesIt));
         ++filesIt;
-        fileInfo.stat();
-        fetch(fileInfo, base, firstTime, updatedFiles, path);
+        if (batch.size() == StatBatchSize || filesIt == files.constEnd())
+            fetchBatch();
     }
     if (!updatedFiles.isEmpty())
         emit updates(path, updatedFiles);
@@ -85,7 +85,8 @@ public:
 
     bool operator ==(const QExtendedInformation &fileInfo) const {
        return mFileInfo == fileInfo.mFileInfo
-       && displayType == fileInfo.displayType
+       && (displayType == fileInfo.displayType
+           || !decorationResolved || !fileInfo.decorationResolved)
        && permissions() == fileInfo.permissions()
        && lastModified() == fileInfo.lastModified();
     }
@@ -148,6 +149,7 @@ public:
 
     QString displayType;
     QIcon icon;
+    bool decorationResolved = false; // displayType and icon are set
 
 private :
     QFileInfo mFileInfo;
@@ -180,7 +182,8 @@ public:
     // only callable from this->thread():
     void clear();
     void removePath(const QString &path);
-    QExtendedInformation getInfo(const QFileInfo &info) const;
+    QExtendedInformation getInfo(const QFileInfo &info, bool resolveDecoration = true) const;
+    void resolveDecoration(QExtendedInformation *info) const;
     QAbstractFileIconProvider *iconProvider() const;
     bool resolveSymlinks() const;
 
@@ -199,6 +202,7 @@ private:
     void run() override;
     // called by run():
     void getFileInfos(const QString &path, const QStringList &files);
+    void statFileInfos(QFileInfoList &infos) const;
     void fetch(const QFileInfo &info, QElapsedTimer &base, bool &firstTime,
                QList<QPair<QString, QFileInfo>> &updatedFiles, const QString &path);
 
@@ -559,7 +559,9 @@ QString QFileSystemModel::type(const QModelIndex &index) const
     Q_D(const QFileSystemModel);
     if (!index.isValid())
         return QString();
-    return d->node(index)->type();
+    QFileSystemModelPrivate::QFileSystemNode *node = d->node(index);
+    d->resolveDecoration(node);
+    return node->type();
 }
 
 /*!
@@ -813,7 +815,9 @@ QString QFileSystemModelPrivate::type(const QModelIndex &index) const
 {
     if (!index.isValid())
         return QString();
-    return node(index)->type();
+    QFileSystemNode *typeNode = node(index);
+    resolveDecoration(typeNode);
+    return typeNode->type();
 }
 
 /*!
@@ -855,7 +859,25 @@ QIcon QFileSystemModelPrivate::icon(const QModelIndex &index) const
 {
     if (!index.isValid())
         return QIcon();
-    return node(index)->icon();
+    QFileSystemNode *iconNode = node(index);
+    resolveDecoration(iconNode);
+    return iconNode->icon();
+}
+
+/*!
+    \internal
+
+    The icon and type of the files reported by the gatherer are only looked
+    up once they are needed, typically because the file is shown.
+*/
+void QFileSystemModelPrivate::resolveDecoration(QFileSystemNode *node) const
+{
+#if QT_CONFIG(filesystemwatcher)
+    if (node->info && !node->info->decorationResolved)
+        fileInfoGatherer.resolveDecoration(node->info);
+#else
+    Q_UNUSED(node);
+#endif
 }
 
 /*!
@@ -1104,6 +1126,10 @@ void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent
             iterator.value()->isVisible = false;
         }
     }
+    if (column == 2) {
+        for (QFileSystemNode *value : qAsConst(values))
+            resolveDecoration(value);
+    }
     QFileSystemModelSorter ms(column);
     std::sort(values.begin(), values.end(), ms);
     // First update the new visible list
@@ -1933,7 +1959,7 @@ void QFileSystemModelPrivate::_q_fileSystemChanged(const QString &path,
     for (const auto &update : updates) {
         QString fileName = update.first;
         Q_ASSERT(!fileName.isEmpty());
-        QExtendedInformation info = fileInfoGatherer.getInfo(update.second);
+        QExtendedInformation info = fileInfoGatherer.getInfo(update.second, false);
         bool previouslyHere = parentNode->children.contains(fileName);
         if (!previouslyHere) {
             addNode(parentNode, fileName, info.fileInfo());
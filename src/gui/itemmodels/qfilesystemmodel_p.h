@@ -268,6 +268,7 @@ public:
     }
 
     QIcon icon(const QModelIndex &index) const;
+    void resolveDecoration(QFileSystemNode *node) const;
     QString name(const QModelIndex &index) const;
     QString displayName(const QModelIndex &index) const;
     QString filePath(const QModelIndex &index) const;
@@ -445,6 +445,34 @@ const QMimeData* QClipboard::mimeData(Mode mode) const
     return clipboard->mimeData(mode);
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.4
+
+    Returns a future that receives the clipboard data in the format
+    \a mimeType, or an empty QByteArray if the data is not available in
+    that format.
+
+    Unlike mimeData(), this function does not block while another
+    application transfers the data, which can take a long time for large
+    contents such as images. Platforms that transfer clipboard contents
+    asynchronously report the result from the event loop; on other
+    platforms the returned future is already finished.
+
+    The \a mode argument is used to control which part of the system
+    clipboard is used, as in mimeData().
+
+    \sa mimeData()
+*/
+QFuture<QByteArray> QClipboard::fetchData(const QString &mimeType, Mode mode) const
+{
+    QPlatformClipboard *clipboard = QGuiApplicationPrivate::platformIntegration()->clipboard();
+    if (!clipboard->supportsMode(mode))
+        return QtFuture::makeReadyFuture(QByteArray());
+    return clipboard->fetchData(mimeType, mode);
+}
+#endif // QT_CONFIG(future)
+
 /*!
     \fn void QClipboard::setMimeData(QMimeData *src, Mode mode)
 
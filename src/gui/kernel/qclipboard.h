@@ -42,6 +42,9 @@
 
 #include <QtGui/qtguiglobal.h>
 #include <QtCore/qobject.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -77,6 +80,9 @@ public:
 
     const QMimeData *mimeData(Mode mode = Clipboard ) const;
     void setMimeData(QMimeData *data, Mode mode = Clipboard);
+#if QT_CONFIG(future)
+    QFuture<QByteArray> fetchData(const QString &mimeType, Mode mode = Clipboard) const;
+#endif
 
     QImage image(Mode mode = Clipboard) const;
     QPixmap pixmap(Mode mode = Clipboard) const;
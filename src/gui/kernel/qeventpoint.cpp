@@ -415,6 +415,36 @@ qreal QEventPoint::rotation() const
 QSizeF QEventPoint::ellipseDiameters() const
 { return d ? d->ellipseDiameters : QSizeF(); }
 
+/*!
+    \since 6.4
+
+    Returns the samples that were merged into this point when consecutive
+    moves were coalesced before delivery, oldest first. The last entry is
+    the point itself, so the list is never empty for a valid point.
+
+    Pointer devices often report positions at a higher rate than the display
+    refreshes. When event coalescing is enabled for a window (see
+    QWindow::setPointerEventCoalescingEnabled()), queued moves of the same
+    point are delivered as a single event; applications that need the full
+    trajectory, such as drawing or handwriting tools, can retrieve the
+    intermediate positions and timestamps here.
+
+    The returned points carry a timestamp(), position(), scenePosition(),
+    globalPosition() and, when reported by the device, pressure().
+
+    \sa QWindow::setPointerEventCoalescingEnabled()
+*/
+QList<QEventPoint> QEventPoint::coalescedPoints() const
+{
+    if (!d)
+        return {};
+    if (d->coalescedPoints.isEmpty())
+        return { *this };
+    QList<QEventPoint> points = d->coalescedPoints;
+    points.append(*this);
+    return points;
+}
+
 /*!
     \property QEventPoint::accepted
     \brief the accepted state of the event point.
@@ -571,6 +601,7 @@ void QMutableEventPoint::update(const QEventPoint &other, QEventPoint &target)
     setEllipseDiameters(target, other.ellipseDiameters());
     setRotation(target, other.rotation());
     setVelocity(target, other.velocity());
+    setCoalescedPoints(target, coalescedPoints(other));
 }
 
 /*! \internal
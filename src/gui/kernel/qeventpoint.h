@@ -44,6 +44,7 @@
 #include <QtGui/qvector2d.h>
 #include <QtGui/qpointingdevice.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qmetatype.h>
 
 QT_BEGIN_NAMESPACE
@@ -157,6 +158,7 @@ public:
     qreal pressure() const;
     qreal rotation() const;
     QSizeF ellipseDiameters() const;
+    QList<QEventPoint> coalescedPoints() const;
 
     bool isAccepted() const;
     void setAccepted(bool accepted = true);
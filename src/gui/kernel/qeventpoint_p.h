@@ -110,6 +110,7 @@ public:
     ulong lastTimestamp = 0;
     ulong pressTimestamp = 0;
     QPointingDeviceUniqueId uniqueId;
+    QList<QEventPoint> coalescedPoints; // not compared: history, not state
     int pointId = -1;
     QEventPoint::State state = QEventPoint::State::Unknown;
     bool accept = false;
@@ -158,6 +159,9 @@ public:
     TRIVIAL_SETTER(qreal, pressure, Pressure)
     TRIVIAL_SETTER(qreal, rotation, Rotation)
     TRIVIAL_SETTER(QVector2D, velocity, Velocity)
+    TRIVIAL_SETTER(QList<QEventPoint>, coalescedPoints, CoalescedPoints)
+
+    static QList<QEventPoint> coalescedPoints(const QEventPoint &p) { return p.d->coalescedPoints; }
 
     static QWindow *window(const QEventPoint &p) { return p.d->window.data(); }
 
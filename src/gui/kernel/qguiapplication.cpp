@@ -65,6 +65,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/private/qnumeric_p.h>
+#include <QtCore/private/qstartuptimeline_p.h>
 #include <QtDebug>
 #ifndef QT_NO_ACCESSIBILITY
 #include "qaccessible.h"
@@ -1246,6 +1247,7 @@ static void init_platform(const QString &pluginNamesWithArguments, const QString
     }
 
     // Create the platform theme:
+    const qint64 themeStart = QStartupTimeline::isRecording() ? QStartupTimeline::timestamp() : 0;
 
     // 1) Fetch the platform name from the environment if present.
     QStringList themeNames;
@@ -1281,6 +1283,11 @@ static void init_platform(const QString &pluginNamesWithArguments, const QString
     if (!QGuiApplicationPrivate::platform_theme)
         QGuiApplicationPrivate::platform_theme = new QPlatformTheme;
 
+    if (themeStart) {
+        QStartupTimeline::record("QPlatformTheme creation", themeStart,
+                                 QStartupTimeline::timestamp(), themeNames.join(u';'));
+    }
+
 #ifndef QT_NO_PROPERTIES
     // Set arguments as dynamic properties on the native interface as
     // boolean 'foo' or strings: 'foo=bar'
@@ -1378,6 +1385,7 @@ void QGuiApplicationPrivate::addQtOptions(QList<QCommandLineOption> *options)
 
 void QGuiApplicationPrivate::createPlatformIntegration()
 {
+    QStartupTimelineScope timelineScope("QGuiApplicationPrivate::createPlatformIntegration");
     QHighDpiScaling::initHighDpiScaling();
 
     // Load the platform integration
@@ -1513,6 +1521,7 @@ void QGuiApplicationPrivate::eventDispatcherReady()
 void QGuiApplicationPrivate::init()
 {
     Q_TRACE_SCOPE(QGuiApplicationPrivate_init);
+    QStartupTimelineScope timelineScope("QGuiApplicationPrivate::init");
 
 #if defined(Q_OS_MACOS)
     QMacAutoReleasePool pool;
@@ -2238,6 +2247,8 @@ void QGuiApplicationPrivate::processMouseEvent(QWindowSystemInterfacePrivate::Mo
     persistentEPD = nullptr; // incoming and synth events can cause reallocation during delivery, so don't use this again
     // ev now contains a detached copy of the QEventPoint from QPointingDevicePrivate::activePoints
     ev.setTimestamp(e->timestamp);
+    if (!e->coalescedPoints.isEmpty())
+        QMutableEventPoint::setCoalescedPoints(ev.point(0), e->coalescedPoints);
     if (window->d_func()->blockedByModalWindow && !qApp->d_func()->popupActive()) {
         // a modal window is blocking this window, don't allow mouse events through
         return;
@@ -2899,6 +2910,16 @@ void QGuiApplicationPrivate::processTouchEvent(QWindowSystemInterfacePrivate::To
         // store the scene position as local position, for now
         QMutableEventPoint::setPosition(ep, window->mapFromGlobal(tempPt.globalPosition()));
 
+        // map the positions of moves coalesced into this one the same way
+        QList<QEventPoint> history = QMutableEventPoint::coalescedPoints(tempPt);
+        if (!history.isEmpty()) {
+            for (QEventPoint &sample : history) {
+                QMutableEventPoint::setScenePosition(sample, sample.globalPosition());
+                QMutableEventPoint::setPosition(sample, window->mapFromGlobal(sample.globalPosition()));
+            }
+            QMutableEventPoint::setCoalescedPoints(ep, history);
+        }
+
         // setTimeStamp has side effects, so we do it last
         QMutableEventPoint::setTimestamp(ep, e->timestamp);
 
@@ -3160,6 +3181,10 @@ void QGuiApplicationPrivate::processExposeEvent(QWindowSystemInterfacePrivate::E
         // paint events yet.
     }
 
+    // the first window to be exposed completes the startup of the application
+    const qint64 firstExposeStart = !wasExposed && p->exposed && QStartupTimeline::isRecording()
+            ? QStartupTimeline::timestamp() : 0;
+
     QExposeEvent exposeEvent(e->region);
     QCoreApplication::sendSpontaneousEvent(window, &exposeEvent);
     e->eventAccepted = exposeEvent.isAccepted();
@@ -3173,6 +3198,12 @@ void QGuiApplicationPrivate::processExposeEvent(QWindowSystemInterfacePrivate::E
         QPaintEvent paintEvent(e->region);
         QCoreApplication::sendSpontaneousEvent(window, &paintEvent);
     }
+
+    if (firstExposeStart) {
+        QStartupTimeline::record("first expose", firstExposeStart, QStartupTimeline::timestamp(),
+                                 QString::fromLatin1(window->metaObject()->className()));
+        QStartupTimeline::finish();
+    }
 }
 
 void QGuiApplicationPrivate::processPaintEvent(QWindowSystemInterfacePrivate::PaintEvent *e)
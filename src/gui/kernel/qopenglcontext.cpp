@@ -767,7 +767,20 @@ QSurface *QOpenGLContext::surface() const
 void QOpenGLContext::swapBuffers(QSurface *surface)
 {
     Q_D(QOpenGLContext);
-    if (!isValid())
+    d->swapBuffers(surface, QRegion());
+}
+
+/*!
+    \internal
+
+    Like QOpenGLContext::swapBuffers(), but passes \a damage, in device pixels
+    with a top-left origin, on to the platform as a hint of what has changed
+    since the previous frame. An empty region means the entire surface.
+*/
+void QOpenGLContextPrivate::swapBuffers(QSurface *surface, const QRegion &damage)
+{
+    Q_Q(QOpenGLContext);
+    if (!q->isValid())
         return;
 
     if (!surface) {
@@ -785,12 +798,31 @@ void QOpenGLContext::swapBuffers(QSurface *surface)
         return;
 
 #if !defined(QT_NO_DEBUG)
-    if (!QOpenGLContextPrivate::toggleMakeCurrentTracker(this, false))
+    if (!QOpenGLContextPrivate::toggleMakeCurrentTracker(q, false))
         qWarning("QOpenGLContext::swapBuffers() called without corresponding makeCurrent()");
 #endif
     if (surface->format().swapBehavior() == QSurfaceFormat::SingleBuffer)
-        functions()->glFlush();
-    d->platformGLContext->swapBuffers(surfaceHandle);
+        q->functions()->glFlush();
+    if (damage.isEmpty())
+        platformGLContext->swapBuffers(surfaceHandle);
+    else
+        platformGLContext->swapBuffersWithDamage(surfaceHandle, damage);
+}
+
+/*!
+    \internal
+
+    Returns the age of the back buffer of \a surface as reported by the
+    platform, or 0 when its contents are undefined. The context must be
+    current for \a surface.
+
+    \sa QPlatformOpenGLContext::bufferAge()
+*/
+int QOpenGLContextPrivate::bufferAge(QSurface *surface) const
+{
+    if (!platformGLContext || !surface || !surface->surfaceHandle())
+        return 0;
+    return platformGLContext->bufferAge(surface->surfaceHandle());
 }
 
 /*!
@@ -236,6 +236,9 @@ public:
 
     void adopt(QPlatformOpenGLContext *);
 
+    int bufferAge(QSurface *surface) const;
+    void swapBuffers(QSurface *surface, const QRegion &damage);
+
     QSurfaceFormat requestedFormat;
     QPlatformOpenGLContext *platformGLContext;
     QOpenGLContext *shareContext;
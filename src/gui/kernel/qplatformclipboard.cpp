@@ -41,6 +41,7 @@
 #ifndef QT_NO_CLIPBOARD
 
 #include <QtGui/private/qguiapplication_p.h>
+#include <QtGui/private/qinternalmimedata_p.h>
 #include <QtCore/qmimedata.h>
 
 QT_BEGIN_NAMESPACE
@@ -119,6 +120,24 @@ bool QPlatformClipboard::ownsMode(QClipboard::Mode mode) const
     return false;
 }
 
+#if QT_CONFIG(future)
+/*!
+    Returns a future that receives the contents of the clipboard \a mode
+    in the format \a mimeType.
+
+    The default implementation converts the data returned by mimeData()
+    and returns a finished future. Platforms that have to wait for other
+    applications to transfer the data should reimplement this function
+    and report the result without blocking.
+*/
+QFuture<QByteArray> QPlatformClipboard::fetchData(const QString &mimeType, QClipboard::Mode mode)
+{
+    const QMimeData *data = mimeData(mode);
+    return QtFuture::makeReadyFuture(data ? QInternalMimeData::renderDataHelper(mimeType, data)
+                                          : QByteArray());
+}
+#endif
+
 void QPlatformClipboard::emitChanged(QClipboard::Mode mode)
 {
     if (!QGuiApplicationPrivate::is_app_closing) // QTBUG-39317, prevent emission when closing down.
@@ -70,6 +70,9 @@ public:
     virtual void setMimeData(QMimeData *data, QClipboard::Mode mode = QClipboard::Clipboard);
     virtual bool supportsMode(QClipboard::Mode mode) const;
     virtual bool ownsMode(QClipboard::Mode mode) const;
+#if QT_CONFIG(future)
+    virtual QFuture<QByteArray> fetchData(const QString &mimeType, QClipboard::Mode mode);
+#endif
     void emitChanged(QClipboard::Mode mode);
 };
 
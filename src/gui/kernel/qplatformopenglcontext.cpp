@@ -115,6 +115,46 @@ GLuint QPlatformOpenGLContext::defaultFramebufferObject(QPlatformSurface *) cons
     return 0;
 }
 
+/*!
+    Swaps the buffers of \a surface like swapBuffers(), passing \a damage as
+    a hint of which parts of the frame have changed since the previous one.
+
+    \a damage is in device pixels, with the origin in the top-left corner of
+    the surface. An empty region means that the entire surface has changed.
+
+    Reimplement in subclass if the platform can make use of the hint, for
+    example with EGL_KHR_swap_buffers_with_damage. The default implementation
+    calls swapBuffers().
+
+    \sa bufferAge()
+    \since 6.4
+*/
+void QPlatformOpenGLContext::swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage)
+{
+    Q_UNUSED(damage);
+    swapBuffers(surface);
+}
+
+/*!
+    Returns the age of the back buffer of \a surface, that is, the number of
+    frames ago its contents were presented. 0 means that the contents are
+    undefined and the entire frame has to be rendered.
+
+    Must be called with the context current for \a surface, before any
+    rendering is done in the frame.
+
+    Reimplement in subclass if the platform can query this, for example with
+    EGL_EXT_buffer_age. The default implementation returns 0.
+
+    \sa swapBuffersWithDamage()
+    \since 6.4
+*/
+int QPlatformOpenGLContext::bufferAge(QPlatformSurface *surface)
+{
+    Q_UNUSED(surface);
+    return 0;
+}
+
 QOpenGLContext *QPlatformOpenGLContext::context() const
 {
     Q_D(const QPlatformOpenGLContext);
@@ -78,6 +78,8 @@ public:
     virtual QSurfaceFormat format() const = 0;
 
     virtual void swapBuffers(QPlatformSurface *surface) = 0;
+    virtual void swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage);
+    virtual int bufferAge(QPlatformSurface *surface);
 
     virtual GLuint defaultFramebufferObject(QPlatformSurface *surface) const;
 
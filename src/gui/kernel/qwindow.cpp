@@ -2086,6 +2086,43 @@ bool QWindow::setMouseGrabEnabled(bool grab)
     return false;
 }
 
+/*!
+    \since 6.4
+
+    Sets whether consecutive pointer moves queued for this window are
+    coalesced into a single event before delivery (\a enabled).
+
+    When the event loop falls behind a high-frequency pointing device, several
+    mouse moves, or touch updates involving the same set of points, may be
+    waiting in the queue by the time it gets to process them. With coalescing
+    enabled, only the most recent of them is delivered, and the positions and
+    timestamps of the ones that were skipped are available from
+    QEventPoint::coalescedPoints(). Presses, releases and moves with a changed
+    button or modifier state are never merged.
+
+    Coalescing is disabled by default.
+
+    \sa isPointerEventCoalescingEnabled(), QEventPoint::coalescedPoints()
+*/
+void QWindow::setPointerEventCoalescingEnabled(bool enabled)
+{
+    Q_D(QWindow);
+    d->pointerEventCoalescing = enabled;
+}
+
+/*!
+    \since 6.4
+
+    Returns whether queued pointer moves for this window are coalesced.
+
+    \sa setPointerEventCoalescingEnabled()
+*/
+bool QWindow::isPointerEventCoalescingEnabled() const
+{
+    Q_D(const QWindow);
+    return d->pointerEventCoalescing;
+}
+
 /*!
     Returns the screen on which the window is shown, or null if there is none.
 
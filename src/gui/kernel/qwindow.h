@@ -265,6 +265,9 @@ public:
     bool setKeyboardGrabEnabled(bool grab);
     bool setMouseGrabEnabled(bool grab);
 
+    void setPointerEventCoalescingEnabled(bool enabled);
+    bool isPointerEventCoalescingEnabled() const;
+
     QScreen *screen() const;
     void setScreen(QScreen *screen);
 
@@ -176,6 +176,8 @@ public:
     bool compositing = false;
     QElapsedTimer lastComposeTime;
 
+    bool pointerEventCoalescing = false;
+
 #if QT_CONFIG(vulkan)
     QVulkanInstance *vulkanInstance = nullptr;
 #endif
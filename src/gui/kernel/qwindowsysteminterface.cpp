@@ -43,6 +43,7 @@
 #include "private/qevent_p.h"
 #include "private/qeventpoint_p.h"
 #include "private/qpointingdevice_p.h"
+#include "private/qwindow_p.h"
 #include <QAbstractEventDispatcher>
 #include <qpa/qplatformintegration.h>
 #include <qdebug.h>
@@ -196,6 +197,98 @@ void QWindowSystemInterfacePrivate::removeWindowSystemEvent(WindowSystemEvent *e
     windowSystemEventQueue.remove(event);
 }
 
+static bool canCoalesce(const QWindowSystemInterfacePrivate::MouseEvent *e,
+                        const QWindowSystemInterfacePrivate::MouseEvent *next)
+{
+    return e->buttonType == QEvent::MouseMove && next->buttonType == QEvent::MouseMove
+        && !e->nonClientArea && !next->nonClientArea
+        && e->window == next->window && e->device == next->device
+        && e->buttons == next->buttons && e->modifiers == next->modifiers
+        && e->source == next->source;
+}
+
+static bool canCoalesce(const QWindowSystemInterfacePrivate::TouchEvent *e,
+                        const QWindowSystemInterfacePrivate::TouchEvent *next)
+{
+    if (e->touchType != QEvent::TouchUpdate || next->touchType != QEvent::TouchUpdate
+        || e->window != next->window || e->device != next->device
+        || e->modifiers != next->modifiers || e->points.count() != next->points.count()) {
+        return false;
+    }
+    const auto moving = [](QEventPoint::State state) {
+        return state == QEventPoint::State::Updated || state == QEventPoint::State::Stationary;
+    };
+    for (qsizetype i = 0; i < e->points.count(); ++i) {
+        const QEventPoint &p = e->points.at(i);
+        const QEventPoint &np = next->points.at(i);
+        if (p.id() != np.id() || !moving(p.state()) || !moving(np.state()))
+            return false;
+    }
+    return true;
+}
+
+// Returns \a point's history with \a point itself appended as the newest sample.
+static QList<QEventPoint> historyWith(const QEventPoint &point)
+{
+    QList<QEventPoint> history = QMutableEventPoint::coalescedPoints(point);
+    QEventPoint sample = point;
+    QMutableEventPoint::detach(sample);
+    QMutableEventPoint::setCoalescedPoints(sample, {});
+    history.append(sample);
+    return history;
+}
+
+/*!
+    \internal
+
+    Merges the pointer moves queued directly behind \a event into it, provided
+    that they target the same window, that window has opted into coalescing,
+    and nothing but the positions changed. Returns the event to deliver, which
+    carries the positions of the ones it replaced as QEventPoint history; the
+    replaced events are deleted.
+
+    Only the GUI thread takes events from the queue, so the event peeked at is
+    still first in line when it is taken.
+*/
+QWindowSystemInterfacePrivate::WindowSystemEvent *
+QWindowSystemInterfacePrivate::coalescePointerEvents(WindowSystemEvent *event)
+{
+    if ((event->type != Mouse && event->type != Touch) || event->synthetic())
+        return event;
+    QWindow *window = static_cast<PointerEvent *>(event)->window.data();
+    if (!window || !QWindowPrivate::get(window)->pointerEventCoalescing)
+        return event;
+
+    while (WindowSystemEvent *next = windowSystemEventQueue.peekFirst()) {
+        if (next->type != event->type || next->synthetic())
+            break;
+        if (event->type == Mouse) {
+            auto *e = static_cast<MouseEvent *>(event);
+            auto *n = static_cast<MouseEvent *>(next);
+            if (!canCoalesce(e, n))
+                break;
+            QEventPoint sample = QMutableEventPoint::withTimeStamp(e->timestamp, 0, QEventPoint::State::Updated,
+                                                                   e->localPos, e->localPos, e->globalPos);
+            QMutableEventPoint::setDevice(sample, static_cast<const QPointingDevice *>(e->device));
+            n->coalescedPoints = std::move(e->coalescedPoints);
+            n->coalescedPoints.append(sample);
+        } else {
+            auto *e = static_cast<TouchEvent *>(event);
+            auto *n = static_cast<TouchEvent *>(next);
+            if (!canCoalesce(e, n))
+                break;
+            for (qsizetype i = 0; i < n->points.count(); ++i) {
+                QMutableEventPoint::detach(n->points[i]);
+                QMutableEventPoint::setCoalescedPoints(n->points[i], historyWith(e->points.at(i)));
+            }
+        }
+        windowSystemEventQueue.takeFirstOrReturnNull();
+        delete event;
+        event = next;
+    }
+    return event;
+}
+
 void QWindowSystemInterfacePrivate::installWindowSystemEventHandler(QWindowSystemEventHandler *handler)
 {
     if (!eventHandler)
@@ -1126,6 +1219,8 @@ bool QWindowSystemInterface::sendWindowSystemEvents(QEventLoop::ProcessEventsFla
                         QWindowSystemInterfacePrivate::getWindowSystemEvent();
         if (!event)
             break;
+        if (!(flags & QEventLoop::ExcludeUserInputEvents))
+            event = QWindowSystemInterfacePrivate::coalescePointerEvents(event);
 
         if (QWindowSystemInterfacePrivate::eventHandler) {
             if (QWindowSystemInterfacePrivate::eventHandler->sendEvent(event))
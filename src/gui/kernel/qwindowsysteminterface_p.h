@@ -261,6 +261,7 @@ public:
         bool nonClientArea;
         Qt::MouseButton button;
         QEvent::Type buttonType;
+        QList<QEventPoint> coalescedPoints;
     };
 
     class WheelEvent : public PointerEvent {
@@ -481,6 +482,8 @@ public:
         { const QMutexLocker locker(&mutex); impl.prepend(e); }
         WindowSystemEvent *takeFirstOrReturnNull()
         { const QMutexLocker locker(&mutex); return impl.empty() ? nullptr : impl.takeFirst(); }
+        WindowSystemEvent *peekFirst() const
+        { const QMutexLocker locker(&mutex); return impl.empty() ? nullptr : impl.first(); }
         WindowSystemEvent *takeFirstNonUserInputOrReturnNull()
         {
             const QMutexLocker locker(&mutex);
@@ -531,6 +534,7 @@ public:
     static WindowSystemEvent *getWindowSystemEvent();
     static WindowSystemEvent *getNonUserInputWindowSystemEvent();
     static WindowSystemEvent *peekWindowSystemEvent(EventType t);
+    static WindowSystemEvent *coalescePointerEvents(WindowSystemEvent *event);
     static void removeWindowSystemEvent(WindowSystemEvent *event);
 
 public:
@@ -42,7 +42,9 @@
 #include "qeglpbuffer_p.h"
 #include <qpa/qplatformwindow.h>
 #include <QtGui/qopenglcontext.h>
+#include <QtGui/qregion.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qvarlengtharray.h>
 
 #ifdef Q_OS_ANDROID
 #include <QtCore/private/qjnihelpers_p.h>
@@ -70,6 +72,15 @@ QT_BEGIN_NAMESPACE
     surface). Other than that, no further customization is necessary.
  */
 
+// Constants from EGL_EXT_buffer_age
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
+// Same signature for EGL_KHR_swap_buffers_with_damage and EGL_EXT_swap_buffers_with_damage
+typedef EGLBoolean (EGLAPIENTRYP QEglSwapBuffersWithDamageProc)(EGLDisplay dpy, EGLSurface surface,
+                                                                 const EGLint *rects, EGLint n_rects);
+
 // Constants from EGL_KHR_create_context
 #ifndef EGL_CONTEXT_MINOR_VERSION_KHR
 #define EGL_CONTEXT_MINOR_VERSION_KHR 0x30FB
@@ -448,6 +459,70 @@ void QEGLPlatformContext::swapBuffers(QPlatformSurface *surface)
     }
 }
 
+void QEGLPlatformContext::resolveDamageExtensions()
+{
+    if (m_damageExtensionsResolved)
+        return;
+    m_damageExtensionsResolved = true;
+
+    m_hasBufferAge = q_hasEglExtension(m_eglDisplay, "EGL_EXT_buffer_age");
+    if (q_hasEglExtension(m_eglDisplay, "EGL_KHR_swap_buffers_with_damage"))
+        m_swapBuffersWithDamage = (QFunctionPointer) eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+    else if (q_hasEglExtension(m_eglDisplay, "EGL_EXT_swap_buffers_with_damage"))
+        m_swapBuffersWithDamage = (QFunctionPointer) eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+}
+
+void QEGLPlatformContext::swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage)
+{
+    resolveDamageExtensions();
+    if (!m_swapBuffersWithDamage || damage.isEmpty()) {
+        swapBuffers(surface);
+        return;
+    }
+
+    eglBindAPI(m_api);
+    EGLSurface eglSurface = eglSurfaceForPlatformSurface(surface);
+    if (eglSurface == EGL_NO_SURFACE) // skip if using surfaceless context
+        return;
+
+    EGLint surfaceHeight = 0;
+    if (!eglQuerySurface(m_eglDisplay, eglSurface, EGL_HEIGHT, &surfaceHeight)) {
+        swapBuffers(surface);
+        return;
+    }
+
+    // EGL wants the rectangles with a bottom-left origin
+    QVarLengthArray<EGLint, 16> rects;
+    rects.reserve(damage.rectCount() * 4);
+    for (const QRect &r : damage) {
+        rects.append(r.x());
+        rects.append(surfaceHeight - r.y() - r.height());
+        rects.append(r.width());
+        rects.append(r.height());
+    }
+
+    auto swapWithDamage = reinterpret_cast<QEglSwapBuffersWithDamageProc>(m_swapBuffersWithDamage);
+    bool ok = swapWithDamage(m_eglDisplay, eglSurface, rects.constData(), EGLint(damage.rectCount()));
+    if (!ok)
+        qWarning("QEGLPlatformContext: eglSwapBuffersWithDamage failed: %x", eglGetError());
+}
+
+int QEGLPlatformContext::bufferAge(QPlatformSurface *surface)
+{
+    resolveDamageExtensions();
+    if (!m_hasBufferAge)
+        return 0;
+
+    EGLSurface eglSurface = eglSurfaceForPlatformSurface(surface);
+    if (eglSurface == EGL_NO_SURFACE)
+        return 0;
+
+    EGLint age = 0;
+    if (!eglQuerySurface(m_eglDisplay, eglSurface, EGL_BUFFER_AGE_EXT, &age))
+        return 0;
+    return age;
+}
+
 QFunctionPointer QEGLPlatformContext::getProcAddress(const char *procName)
 {
     eglBindAPI(m_api);
@@ -101,6 +101,8 @@ public:
     bool makeCurrent(QPlatformSurface *surface) override;
     void doneCurrent() override;
     void swapBuffers(QPlatformSurface *surface) override;
+    void swapBuffersWithDamage(QPlatformSurface *surface, const QRegion &damage) override;
+    int bufferAge(QPlatformSurface *surface) override;
     QFunctionPointer getProcAddress(const char *procName) override;
 
     QSurfaceFormat format() const override;
@@ -125,6 +127,7 @@ protected:
 private:
     void adopt(EGLContext context, EGLDisplay display, QPlatformOpenGLContext *shareContext);
     void updateFormatFromGL();
+    void resolveDamageExtensions();
 
     EGLContext m_eglContext;
     EGLContext m_shareContext;
@@ -138,6 +141,9 @@ private:
     Flags m_flags;
     bool m_ownsContext = false;
     QList<EGLint> m_contextAttrs;
+    bool m_damageExtensionsResolved = false;
+    bool m_hasBufferAge = false;
+    QFunctionPointer m_swapBuffersWithDamage = nullptr;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QEGLPlatformContext::Flags)
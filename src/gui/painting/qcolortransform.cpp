@@ -115,6 +115,31 @@ void QColorTransformPrivate::updateLutsOut() const
     colorSpaceOut->lut.generated.storeRelease(1);
 }
 
+void QColorTransformPrivate::updateMatrixLut() const
+{
+    if (matrixLutGenerated.loadAcquire())
+        return;
+    QMutexLocker lock(&QColorSpacePrivate::s_lutWriteLock);
+    if (matrixLutGenerated.loadRelaxed())
+        return;
+    for (int i = 0; i < 3; ++i) {
+        if (!colorSpaceIn->trc[i].isValid())
+            return;
+    }
+
+    auto lut = std::make_unique<MatrixLut>();
+    const QColorVector *columns[3] = { &colorMatrix.r, &colorMatrix.g, &colorMatrix.b };
+    for (int c = 0; c < 3; ++c) {
+        for (int i = 0; i < 256; ++i) {
+            const float l = colorSpaceIn->trc[c].apply(i * (1.0f / 255.0f));
+            lut->column[c][i] = QColorVector(columns[c]->x * l, columns[c]->y * l, columns[c]->z * l);
+        }
+    }
+    matrixLut = std::move(lut);
+
+    matrixLutGenerated.storeRelease(1);
+}
+
 /*!
     \class QColorTransform
     \brief The QColorTransform class is a transformation between color spaces.
@@ -299,6 +324,50 @@ static void applyMatrix(QColorVector *buffer, const qsizetype len, const QColorM
 #endif
 }
 
+// Loads opaque or unpremultiplied pixels with the color matrix already applied
+static void loadMapped(QColorVector *buffer, const QRgb *src, const qsizetype len,
+                       const QColorTransformPrivate *d_ptr)
+{
+    const auto &column = d_ptr->matrixLut->column;
+#if defined(__SSE2__)
+    const __m128 minV = _mm_set1_ps(0.0f);
+    const __m128 maxV = _mm_set1_ps(1.0f);
+    for (qsizetype j = 0; j < len; ++j) {
+        const QRgb p = src[j];
+        __m128 c = _mm_add_ps(_mm_loadu_ps(&column[0][qRed(p)].x),
+                              _mm_loadu_ps(&column[1][qGreen(p)].x));
+        c = _mm_add_ps(c, _mm_loadu_ps(&column[2][qBlue(p)].x));
+        // Clamp:
+        c = _mm_min_ps(c, maxV);
+        c = _mm_max_ps(c, minV);
+        _mm_storeu_ps(&buffer[j].x, c);
+    }
+#elif defined(__ARM_NEON__)
+    const float32x4_t minV = vdupq_n_f32(0.0f);
+    const float32x4_t maxV = vdupq_n_f32(1.0f);
+    for (qsizetype j = 0; j < len; ++j) {
+        const QRgb p = src[j];
+        float32x4_t c = vaddq_f32(vld1q_f32(&column[0][qRed(p)].x),
+                                  vld1q_f32(&column[1][qGreen(p)].x));
+        c = vaddq_f32(c, vld1q_f32(&column[2][qBlue(p)].x));
+        // Clamp:
+        c = vminq_f32(c, maxV);
+        c = vmaxq_f32(c, minV);
+        vst1q_f32(&buffer[j].x, c);
+    }
+#else
+    for (qsizetype j = 0; j < len; ++j) {
+        const QRgb p = src[j];
+        const QColorVector &r = column[0][qRed(p)];
+        const QColorVector &g = column[1][qGreen(p)];
+        const QColorVector &b = column[2][qBlue(p)];
+        buffer[j].x = std::max(0.0f, std::min(1.0f, r.x + g.x + b.x));
+        buffer[j].y = std::max(0.0f, std::min(1.0f, r.y + g.y + b.y));
+        buffer[j].z = std::max(0.0f, std::min(1.0f, r.z + g.z + b.z));
+    }
+#endif
+}
+
 #if defined(__SSE2__) || defined(__ARM_NEON__)
 template<typename T>
 static constexpr inline bool isArgb();
@@ -908,18 +977,32 @@ void QColorTransformPrivate::apply(T *dst, const T *src, qsizetype count, Transf
 
     bool doApplyMatrix = (colorMatrix != QColorMatrix::identity());
 
+    // 8-bit channels can be linearized and mapped in a single table lookup
+    bool mapOnLoad = false;
+    if constexpr (std::is_same_v<T, QRgb>) {
+        if (!(flags & InputPremultiplied)) {
+            updateMatrixLut();
+            mapOnLoad = matrixLutGenerated.loadAcquire();
+        }
+    }
+
     QUninitialized<QColorVector, WorkBlockSize> buffer;
 
     qsizetype i = 0;
     while (i < count) {
         const qsizetype len = qMin(count - i, WorkBlockSize);
-        if (flags & InputPremultiplied)
-            loadPremultiplied(buffer, src + i, len, this);
-        else
-            loadUnpremultiplied(buffer, src + i, len, this);
+        if (mapOnLoad) {
+            if constexpr (std::is_same_v<T, QRgb>)
+                loadMapped(buffer, src + i, len, this);
+        } else {
+            if (flags & InputPremultiplied)
+                loadPremultiplied(buffer, src + i, len, this);
+            else
+                loadUnpremultiplied(buffer, src + i, len, this);
 
-        if (doApplyMatrix)
-            applyMatrix(buffer, len, colorMatrix);
+            if (doApplyMatrix)
+                applyMatrix(buffer, len, colorMatrix);
+        }
 
         if (flags & InputOpaque)
             storeOpaque(dst + i, src + i, buffer, len, this);
@@ -70,6 +70,7 @@ public:
 
     void updateLutsIn() const;
     void updateLutsOut() const;
+    void updateMatrixLut() const;
     bool simpleGammaCorrection() const;
 
     void prepare();
@@ -93,6 +94,13 @@ public:
     template<typename D, typename S>
     void applyReturnGray(D *dst, const S *src, qsizetype count, TransformFlags flags) const;
 
+    // The linearized 8-bit input channels premultiplied into their matrix
+    // columns, so an opaque or unpremultiplied QRgb maps to the sum of three entries.
+    struct MatrixLut {
+        QColorVector column[3][256];
+    };
+    mutable std::unique_ptr<const MatrixLut> matrixLut;
+    mutable QAtomicInt matrixLutGenerated;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,431 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qglobal.h>
+
+// GCC 12 warns about the undefined vectors its own AVX-512 intrinsics pass
+// through (GCC bug 105593); this has to be set before immintrin.h is read
+#if defined(Q_CC_GNU) && !defined(Q_CC_CLANG) && Q_CC_GNU < 1300
+QT_WARNING_DISABLE_GCC("-Wuninitialized")
+QT_WARNING_DISABLE_GCC("-Wmaybe-uninitialized")
+#endif
+
+#include "qdrawhelper_p.h"
+#include "qdrawhelper_x86_p.h"
+#include "qpixellayout_p.h"
+#include "qrgba64_p.h"
+
+#if defined(QT_COMPILER_SUPPORTS_AVX512CD) && defined(QT_COMPILER_SUPPORTS_AVX512BW) \
+    && defined(QT_COMPILER_SUPPORTS_AVX512DQ) && defined(QT_COMPILER_SUPPORTS_AVX512VL)
+
+QT_BEGIN_NAMESPACE
+
+// The functions in this file process 16 ARGB32 pixels per iteration. Instead
+// of aligning the destination and finishing with a scalar loop like the AVX2
+// code, the last pixels of a span are handled by the same vector code using
+// masked loads and stores.
+
+static inline __mmask16 pixelMask(qsizetype count)
+{
+    Q_ASSERT(count > 0);
+    return count >= 16 ? __mmask16(0xffff) : __mmask16(_bzhi_u32(0xffff, count));
+}
+
+// Returns the alpha of each pixel in both 16-bit halves of the pixel.
+static inline __m512i Q_DECL_VECTORCALL alphaChannel_avx512(__m512i pixelVector)
+{
+    const __m512i alphaShuffleMask = _mm512_broadcast_i32x4(
+            _mm_set_epi8(char(0xff), 15, char(0xff), 15, char(0xff), 11, char(0xff), 11,
+                         char(0xff), 7, char(0xff), 7, char(0xff), 3, char(0xff), 3));
+    return _mm512_shuffle_epi8(pixelVector, alphaShuffleMask);
+}
+
+// See BYTE_MUL_SSE2 for details.
+static inline __m512i Q_DECL_VECTORCALL BYTE_MUL_AVX512(__m512i pixelVector, __m512i alphaChannel)
+{
+    const __m512i colorMask = _mm512_set1_epi32(0x00ff00ff);
+    const __m512i half = _mm512_set1_epi16(0x80);
+    __m512i pixelVectorAG = _mm512_srli_epi16(pixelVector, 8);
+    __m512i pixelVectorRB = _mm512_and_si512(pixelVector, colorMask);
+
+    pixelVectorAG = _mm512_mullo_epi16(pixelVectorAG, alphaChannel);
+    pixelVectorRB = _mm512_mullo_epi16(pixelVectorRB, alphaChannel);
+
+    pixelVectorRB = _mm512_add_epi16(pixelVectorRB, _mm512_srli_epi16(pixelVectorRB, 8));
+    pixelVectorAG = _mm512_add_epi16(pixelVectorAG, _mm512_srli_epi16(pixelVectorAG, 8));
+    pixelVectorRB = _mm512_add_epi16(pixelVectorRB, half);
+    pixelVectorAG = _mm512_add_epi16(pixelVectorAG, half);
+
+    pixelVectorRB = _mm512_srli_epi16(pixelVectorRB, 8);
+    pixelVectorAG = _mm512_andnot_si512(colorMask, pixelVectorAG);
+
+    return _mm512_or_si512(pixelVectorAG, pixelVectorRB);
+}
+
+// See INTERPOLATE_PIXEL_255_SSE2 for details.
+static inline __m512i Q_DECL_VECTORCALL
+INTERPOLATE_PIXEL_255_AVX512(__m512i srcVector, __m512i dstVector, __m512i alphaChannel, __m512i oneMinusAlphaChannel)
+{
+    const __m512i colorMask = _mm512_set1_epi32(0x00ff00ff);
+    const __m512i half = _mm512_set1_epi16(0x80);
+    const __m512i srcVectorAG = _mm512_srli_epi16(srcVector, 8);
+    const __m512i dstVectorAG = _mm512_srli_epi16(dstVector, 8);
+    const __m512i srcVectorRB = _mm512_and_si512(srcVector, colorMask);
+    const __m512i dstVectorRB = _mm512_and_si512(dstVector, colorMask);
+    __m512i finalAG = _mm512_add_epi16(_mm512_mullo_epi16(srcVectorAG, alphaChannel),
+                                       _mm512_mullo_epi16(dstVectorAG, oneMinusAlphaChannel));
+    __m512i finalRB = _mm512_add_epi16(_mm512_mullo_epi16(srcVectorRB, alphaChannel),
+                                       _mm512_mullo_epi16(dstVectorRB, oneMinusAlphaChannel));
+    finalAG = _mm512_add_epi16(finalAG, _mm512_srli_epi16(finalAG, 8));
+    finalRB = _mm512_add_epi16(finalRB, _mm512_srli_epi16(finalRB, 8));
+    finalAG = _mm512_add_epi16(finalAG, half);
+    finalRB = _mm512_add_epi16(finalRB, half);
+    finalAG = _mm512_andnot_si512(colorMask, finalAG);
+    finalRB = _mm512_srli_epi16(finalRB, 8);
+
+    return _mm512_or_si512(finalAG, finalRB);
+}
+
+// dst = src + dst * (1 - alpha(src)), skipping fully transparent sources and
+// copying fully opaque ones; see blend_pixel()
+static inline void Q_DECL_VECTORCALL
+blendSourceOverPixels_avx512(quint32 *dst, const quint32 *src, __mmask16 mask)
+{
+    const __m512i alphaMask = _mm512_set1_epi32(0xff000000);
+    const __m512i one = _mm512_set1_epi16(0xff);
+    const __m512i srcVector = _mm512_maskz_loadu_epi32(mask, src);
+    if (!_mm512_test_epi32_mask(srcVector, alphaMask))
+        return;
+    if (_mm512_cmpge_epu32_mask(srcVector, alphaMask) == mask) {
+        _mm512_mask_storeu_epi32(dst, mask, srcVector);
+        return;
+    }
+    const __m512i alphaChannel = _mm512_sub_epi16(one, alphaChannel_avx512(srcVector));
+    __m512i dstVector = _mm512_maskz_loadu_epi32(mask, dst);
+    dstVector = _mm512_add_epi8(BYTE_MUL_AVX512(dstVector, alphaChannel), srcVector);
+    _mm512_mask_storeu_epi32(dst, mask, dstVector);
+}
+
+static inline void Q_DECL_VECTORCALL
+blendSourceOverPixels_avx512(quint32 *dst, const quint32 *src, __mmask16 mask, __m512i constAlphaVector)
+{
+    const __m512i alphaMask = _mm512_set1_epi32(0xff000000);
+    const __m512i one = _mm512_set1_epi16(0xff);
+    __m512i srcVector = _mm512_maskz_loadu_epi32(mask, src);
+    if (!_mm512_test_epi32_mask(srcVector, alphaMask))
+        return;
+    srcVector = BYTE_MUL_AVX512(srcVector, constAlphaVector);
+    const __m512i alphaChannel = _mm512_sub_epi16(one, alphaChannel_avx512(srcVector));
+    __m512i dstVector = _mm512_maskz_loadu_epi32(mask, dst);
+    dstVector = _mm512_add_epi8(BYTE_MUL_AVX512(dstVector, alphaChannel), srcVector);
+    _mm512_mask_storeu_epi32(dst, mask, dstVector);
+}
+
+static void blendSourceOver_avx512(quint32 *dst, const quint32 *src, qsizetype length)
+{
+    qsizetype x = 0;
+    for (; x < length - 15; x += 16)
+        blendSourceOverPixels_avx512(dst + x, src + x, 0xffff);
+    if (x < length)
+        blendSourceOverPixels_avx512(dst + x, src + x, pixelMask(length - x));
+}
+
+static void blendSourceOver_avx512(quint32 *dst, const quint32 *src, qsizetype length, uint const_alpha)
+{
+    const __m512i constAlphaVector = _mm512_set1_epi16(const_alpha);
+    qsizetype x = 0;
+    for (; x < length - 15; x += 16)
+        blendSourceOverPixels_avx512(dst + x, src + x, 0xffff, constAlphaVector);
+    if (x < length)
+        blendSourceOverPixels_avx512(dst + x, src + x, pixelMask(length - x), constAlphaVector);
+}
+
+void qt_blend_argb32_on_argb32_avx512(uchar *destPixels, int dbpl,
+                                      const uchar *srcPixels, int sbpl,
+                                      int w, int h,
+                                      int const_alpha)
+{
+    if (const_alpha == 0)
+        return;
+    if (const_alpha != 256)
+        const_alpha = (const_alpha * 255) >> 8;
+    for (int y = 0; y < h; ++y) {
+        const quint32 *src = reinterpret_cast<const quint32 *>(srcPixels);
+        quint32 *dst = reinterpret_cast<quint32 *>(destPixels);
+        if (const_alpha == 256)
+            blendSourceOver_avx512(dst, src, w);
+        else
+            blendSourceOver_avx512(dst, src, w, const_alpha);
+        destPixels += dbpl;
+        srcPixels += sbpl;
+    }
+}
+
+void QT_FASTCALL comp_func_SourceOver_avx512(uint *destPixels, const uint *srcPixels, int length, uint const_alpha)
+{
+    Q_ASSERT(const_alpha < 256);
+    if (const_alpha == 255)
+        blendSourceOver_avx512(destPixels, srcPixels, length);
+    else
+        blendSourceOver_avx512(destPixels, srcPixels, length, const_alpha);
+}
+
+void QT_FASTCALL comp_func_solid_SourceOver_avx512(uint *destPixels, int length, uint color, uint const_alpha)
+{
+    if ((const_alpha & qAlpha(color)) == 255) {
+        qt_memfill32(destPixels, color, length);
+        return;
+    }
+    if (const_alpha != 255)
+        color = BYTE_MUL(color, const_alpha);
+
+    const __m512i colorVector = _mm512_set1_epi32(color);
+    const __m512i minusAlphaOfColorVector = _mm512_set1_epi16(qAlpha(~color));
+    qsizetype x = 0;
+    for (; x < length; x += 16) {
+        const __mmask16 mask = pixelMask(length - x);
+        __m512i dstVector = _mm512_maskz_loadu_epi32(mask, destPixels + x);
+        dstVector = _mm512_add_epi8(colorVector, BYTE_MUL_AVX512(dstVector, minusAlphaOfColorVector));
+        _mm512_mask_storeu_epi32(destPixels + x, mask, dstVector);
+    }
+}
+
+void QT_FASTCALL comp_func_Source_avx512(uint *dst, const uint *src, int length, uint const_alpha)
+{
+    Q_ASSERT(const_alpha < 256);
+    if (const_alpha == 255) {
+        ::memcpy(dst, src, length * sizeof(uint));
+        return;
+    }
+
+    const __m512i constAlphaVector = _mm512_set1_epi16(const_alpha);
+    const __m512i oneMinusConstAlpha = _mm512_set1_epi16(255 - const_alpha);
+    for (qsizetype x = 0; x < length; x += 16) {
+        const __mmask16 mask = pixelMask(length - x);
+        const __m512i srcVector = _mm512_maskz_loadu_epi32(mask, src + x);
+        const __m512i dstVector = _mm512_maskz_loadu_epi32(mask, dst + x);
+        _mm512_mask_storeu_epi32(dst + x, mask,
+                                 INTERPOLATE_PIXEL_255_AVX512(srcVector, dstVector,
+                                                              constAlphaVector, oneMinusConstAlpha));
+    }
+}
+
+/*
+  result = d * sa
+  dest = d * sa * ca + d * cia
+       = d * (sa * ca + cia)
+*/
+void QT_FASTCALL comp_func_DestinationIn_avx512(uint *dst, const uint *src, int length, uint const_alpha)
+{
+    Q_ASSERT(const_alpha < 256);
+    const __m512i half = _mm512_set1_epi16(0x80);
+    const __m512i constAlphaVector = _mm512_set1_epi16(const_alpha);
+    const __m512i oneMinusConstAlpha = _mm512_set1_epi16(255 - const_alpha);
+    for (qsizetype x = 0; x < length; x += 16) {
+        const __mmask16 mask = pixelMask(length - x);
+        const __m512i srcVector = _mm512_maskz_loadu_epi32(mask, src + x);
+        __m512i alphaChannel = alphaChannel_avx512(srcVector);
+        if (const_alpha != 255) {
+            // qt_div_255(sa * ca) + cia
+            alphaChannel = _mm512_mullo_epi16(alphaChannel, constAlphaVector);
+            alphaChannel = _mm512_add_epi16(alphaChannel, _mm512_srli_epi16(alphaChannel, 8));
+            alphaChannel = _mm512_srli_epi16(_mm512_add_epi16(alphaChannel, half), 8);
+            alphaChannel = _mm512_add_epi16(alphaChannel, oneMinusConstAlpha);
+        }
+        const __m512i dstVector = _mm512_maskz_loadu_epi32(mask, dst + x);
+        _mm512_mask_storeu_epi32(dst + x, mask, BYTE_MUL_AVX512(dstVector, alphaChannel));
+    }
+}
+
+void QT_FASTCALL comp_func_solid_DestinationIn_avx512(uint *dst, int length, uint color, uint const_alpha)
+{
+    uint a = qAlpha(color);
+    if (const_alpha != 255)
+        a = qt_div_255(a * const_alpha) + 255 - const_alpha;
+    const __m512i alphaChannel = _mm512_set1_epi16(a);
+    for (qsizetype x = 0; x < length; x += 16) {
+        const __mmask16 mask = pixelMask(length - x);
+        const __m512i dstVector = _mm512_maskz_loadu_epi32(mask, dst + x);
+        _mm512_mask_storeu_epi32(dst + x, mask, BYTE_MUL_AVX512(dstVector, alphaChannel));
+    }
+}
+
+template<bool RGBA>
+static void convertARGBToARGB32PM_avx512(uint *buffer, const uint *src, qsizetype count)
+{
+    const __m512i alphaMask = _mm512_set1_epi32(0xff000000);
+    const __m512i rgbaMask = _mm512_broadcast_i32x4(_mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15));
+    const __m512i shuffleMask = _mm512_broadcast_i32x4(_mm_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15));
+    const __m512i half = _mm512_set1_epi16(0x0080);
+    const __m512i zero = _mm512_setzero_si512();
+
+    for (qsizetype i = 0; i < count; i += 16) {
+        const __mmask16 mask = pixelMask(count - i);
+        __m512i srcVector = _mm512_maskz_loadu_epi32(mask, src + i);
+        if (!_mm512_test_epi32_mask(srcVector, alphaMask)) {
+            _mm512_mask_storeu_epi32(buffer + i, mask, zero);
+            continue;
+        }
+        const bool opaque = _mm512_cmpge_epu32_mask(srcVector, alphaMask) == mask;
+        if (RGBA)
+            srcVector = _mm512_shuffle_epi8(srcVector, rgbaMask);
+        if (!opaque) {
+            __m512i src1 = _mm512_unpacklo_epi8(srcVector, zero);
+            __m512i src2 = _mm512_unpackhi_epi8(srcVector, zero);
+            const __m512i alpha1 = _mm512_shuffle_epi8(src1, shuffleMask);
+            const __m512i alpha2 = _mm512_shuffle_epi8(src2, shuffleMask);
+            src1 = _mm512_mullo_epi16(src1, alpha1);
+            src2 = _mm512_mullo_epi16(src2, alpha2);
+            src1 = _mm512_add_epi16(src1, _mm512_srli_epi16(src1, 8));
+            src2 = _mm512_add_epi16(src2, _mm512_srli_epi16(src2, 8));
+            src1 = _mm512_srli_epi16(_mm512_add_epi16(src1, half), 8);
+            src2 = _mm512_srli_epi16(_mm512_add_epi16(src2, half), 8);
+            src1 = _mm512_mask_blend_epi16(0x88888888, src1, alpha1);
+            src2 = _mm512_mask_blend_epi16(0x88888888, src2, alpha2);
+            srcVector = _mm512_packus_epi16(src1, src2);
+        } else if (buffer == src && !RGBA) {
+            continue;
+        }
+        _mm512_mask_storeu_epi32(buffer + i, mask, srcVector);
+    }
+}
+
+void QT_FASTCALL convertARGB32ToARGB32PM_avx512(uint *buffer, int count, const QList<QRgb> *)
+{
+    convertARGBToARGB32PM_avx512<false>(buffer, buffer, count);
+}
+
+void QT_FASTCALL convertRGBA8888ToARGB32PM_avx512(uint *buffer, int count, const QList<QRgb> *)
+{
+    convertARGBToARGB32PM_avx512<true>(buffer, buffer, count);
+}
+
+const uint *QT_FASTCALL fetchARGB32ToARGB32PM_avx512(uint *buffer, const uchar *src, int index, int count,
+                                                    const QList<QRgb> *, QDitherInfo *)
+{
+    convertARGBToARGB32PM_avx512<false>(buffer, reinterpret_cast<const uint *>(src) + index, count);
+    return buffer;
+}
+
+const uint *QT_FASTCALL fetchRGBA8888ToARGB32PM_avx512(uint *buffer, const uchar *src, int index, int count,
+                                                       const QList<QRgb> *, QDitherInfo *)
+{
+    convertARGBToARGB32PM_avx512<true>(buffer, reinterpret_cast<const uint *>(src) + index, count);
+    return buffer;
+}
+
+template<bool RGBA>
+static void convertARGBToRGBA64PM_avx512(QRgba64 *buffer, const uint *src, qsizetype count)
+{
+    const __m512i alphaMask = _mm512_set1_epi32(0xff000000);
+    const __m512i rgbaMask = _mm512_broadcast_i32x4(_mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15));
+    const __m512i shuffleMask = _mm512_broadcast_i32x4(_mm_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15));
+    // The unpack instructions work on the low or high half of each 128-bit
+    // lane. Moving the 64-bit pairs of pixels from [ P1 .. P8 ] to
+    // [ P1, P5; P2, P6; P3, P7; P4, P8 ] makes unpacklo produce pixels 1-8
+    // and unpackhi pixels 9-16, in order.
+    const __m512i permuteMask = _mm512_setr_epi64(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m512i zero = _mm512_setzero_si512();
+
+    for (qsizetype i = 0; i < count; i += 16) {
+        const __mmask16 mask = pixelMask(count - i);
+        __m512i dst1, dst2;
+        __m512i srcVector = _mm512_maskz_loadu_epi32(mask, src + i);
+        if (_mm512_test_epi32_mask(srcVector, alphaMask)) {
+            const __mmask16 opaque = _mm512_cmpge_epu32_mask(srcVector, alphaMask);
+            if (!RGBA)
+                srcVector = _mm512_shuffle_epi8(srcVector, rgbaMask);
+            srcVector = _mm512_permutexvar_epi64(permuteMask, srcVector);
+            const __m512i src1 = _mm512_unpacklo_epi8(srcVector, srcVector);
+            const __m512i src2 = _mm512_unpackhi_epi8(srcVector, srcVector);
+            if (opaque != mask) {
+                const __m512i alpha1 = _mm512_shuffle_epi8(src1, shuffleMask);
+                const __m512i alpha2 = _mm512_shuffle_epi8(src2, shuffleMask);
+                dst1 = _mm512_mulhi_epu16(src1, alpha1);
+                dst2 = _mm512_mulhi_epu16(src2, alpha2);
+                dst1 = _mm512_add_epi16(dst1, _mm512_srli_epi16(dst1, 15));
+                dst2 = _mm512_add_epi16(dst2, _mm512_srli_epi16(dst2, 15));
+                dst1 = _mm512_mask_blend_epi16(0x88888888, dst1, src1);
+                dst2 = _mm512_mask_blend_epi16(0x88888888, dst2, src2);
+                // the multiplication above is off by one for opaque pixels
+                dst1 = _mm512_mask_mov_epi64(dst1, __mmask8(opaque), src1);
+                dst2 = _mm512_mask_mov_epi64(dst2, __mmask8(opaque >> 8), src2);
+            } else {
+                dst1 = src1;
+                dst2 = src2;
+            }
+        } else {
+            dst1 = dst2 = zero;
+        }
+        _mm512_mask_storeu_epi64(buffer + i, __mmask8(mask), dst1);
+        _mm512_mask_storeu_epi64(buffer + i + 8, __mmask8(mask >> 8), dst2);
+    }
+}
+
+const QRgba64 * QT_FASTCALL convertARGB32ToRGBA64PM_avx512(QRgba64 *buffer, const uint *src, int count,
+                                                           const QList<QRgb> *, QDitherInfo *)
+{
+    convertARGBToRGBA64PM_avx512<false>(buffer, src, count);
+    return buffer;
+}
+
+const QRgba64 * QT_FASTCALL convertRGBA8888ToRGBA64PM_avx512(QRgba64 *buffer, const uint *src, int count,
+                                                             const QList<QRgb> *, QDitherInfo *)
+{
+    convertARGBToRGBA64PM_avx512<true>(buffer, src, count);
+    return buffer;
+}
+
+const QRgba64 *QT_FASTCALL fetchARGB32ToRGBA64PM_avx512(QRgba64 *buffer, const uchar *src, int index, int count,
+                                                        const QList<QRgb> *, QDitherInfo *)
+{
+    convertARGBToRGBA64PM_avx512<false>(buffer, reinterpret_cast<const uint *>(src) + index, count);
+    return buffer;
+}
+
+const QRgba64 *QT_FASTCALL fetchRGBA8888ToRGBA64PM_avx512(QRgba64 *buffer, const uchar *src, int index, int count,
+                                                          const QList<QRgb> *, QDitherInfo *)
+{
+    convertARGBToRGBA64PM_avx512<true>(buffer, reinterpret_cast<const uint *>(src) + index, count);
+    return buffer;
+}
+
+QT_END_NAMESPACE
+
+#endif
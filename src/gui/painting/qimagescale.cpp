@@ -45,10 +45,6 @@
 #include "qrgba64_p.h"
 #include "qrgbafloat.h"
 
-#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
-#include "qsemaphore.h"
-#include "qthreadpool.h"
-#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -306,28 +302,7 @@ void qt_qimageScaleAARGBA_down_xy_neon(QImageScaleInfo *isi, unsigned int *dest,
 template<typename T>
 static inline void multithread_pixels_function(QImageScaleInfo *isi, int dh, const T &scaleSection)
 {
-#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
-    int segments = (qsizetype(isi->sh) * isi->sw) / (1<<16);
-    segments = std::min(segments, dh);
-    QThreadPool *threadPool = QThreadPool::globalInstance();
-    if (segments > 1 && threadPool && !threadPool->contains(QThread::currentThread())) {
-        QSemaphore semaphore;
-        int y = 0;
-        for (int i = 0; i < segments; ++i) {
-            int yn = (dh - y) / (segments - i);
-            threadPool->start([&, y, yn]() {
-                scaleSection(y, y + yn);
-                semaphore.release(1);
-            });
-            y += yn;
-        }
-        semaphore.acquire(segments);
-        return;
-    }
-#else
-    Q_UNUSED(isi);
-#endif
-    scaleSection(0, dh);
+    qt_imageParallelFor(qsizetype(isi->sh) * isi->sw, dh, scaleSection);
 }
 
 static void qt_qimageScaleAARGBA_up_xy(QImageScaleInfo *isi, unsigned int *dest,
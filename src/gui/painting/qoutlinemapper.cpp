@@ -207,8 +207,7 @@ void QOutlineMapper::endOutline()
     if (m_transform.isIdentity()) {
         // Nothing to do
     } else if (m_transform.type() < QTransform::TxProject) {
-        for (int i = 0; i < m_elements.size(); ++i)
-            elements[i] = m_transform.map(elements[i]);
+        m_transform.map(elements, elements, m_elements.size());
     } else {
         const QVectorPath vp((qreal *)elements, m_elements.size(),
                              m_element_types.size() ? m_element_types.data() : nullptr);
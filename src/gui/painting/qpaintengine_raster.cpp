@@ -73,6 +73,13 @@
 #include <limits.h>
 #include <algorithm>
 
+#include <qtgui_tracepoints_p.h>
+
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
+
 #ifdef Q_OS_WIN
 #  include <qvarlengtharray.h>
 #  include <private/qfontengine_p.h>
@@ -388,6 +395,9 @@ void QRasterPaintEngine::init()
     d->mono_surface = false;
     gccaps &= ~PorterDuff;
 
+    static const bool parallelRasterization = qEnvironmentVariableIntValue("QT_RASTER_PARALLEL");
+    d->parallel_rasterization = parallelRasterization;
+
     QImage::Format format = QImage::Format_Invalid;
 
     switch (d->device->devType()) {
@@ -432,6 +442,7 @@ QRasterPaintEngine::~QRasterPaintEngine()
 bool QRasterPaintEngine::begin(QPaintDevice *device)
 {
     Q_D(QRasterPaintEngine);
+    Q_TRACE(QRasterPaintEngine_begin, device, device->devType());
 
     if (device->devType() == QInternal::Pixmap) {
         QPixmap *pixmap = static_cast<QPixmap *>(device);
@@ -507,6 +518,7 @@ bool QRasterPaintEngine::begin(QPaintDevice *device)
 */
 bool QRasterPaintEngine::end()
 {
+    Q_TRACE(QRasterPaintEngine_end, paintDevice());
 #ifdef QT_DEBUG_DRAW
     Q_D(QRasterPaintEngine);
     qDebug() << "QRasterPaintEngine::end devRect:" << d->deviceRect;
@@ -1410,6 +1422,45 @@ void QRasterPaintEngine::fillPath(const QPainterPath &path, QSpanData *fillData)
     d->rasterize(d->outlineMapper->convertPath(path), blend, fillData, d->rasterBuffer.data());
 }
 
+// Splits the rows [y1, y2) into bands and calls bandFunction(yStart, yEnd) for
+// each of them on the global thread pool, returning once all of them are done.
+// Returns false without calling bandFunction if the area of \a pixels pixels is
+// too small to be worth splitting.
+template <typename BandFunction>
+static bool rasterizeInBands(int y1, int y2, qsizetype pixels, const BandFunction &bandFunction)
+{
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    if (!threadPool || threadPool->contains(QThread::currentThread()))
+        return false;
+
+    // at least 64k pixels and 32 rows per band
+    qsizetype segments = std::min<qsizetype>(pixels >> 16, (y2 - y1) / 32);
+    segments = std::min<qsizetype>(segments, threadPool->maxThreadCount());
+    if (segments < 2)
+        return false;
+
+    QSemaphore semaphore;
+    int y = y1;
+    for (int i = 0; i < segments; ++i) {
+        int yn = (y2 - y) / (segments - i);
+        threadPool->start([&, y, yn]() {
+            bandFunction(y, y + yn);
+            semaphore.release(1);
+        });
+        y += yn;
+    }
+    semaphore.acquire(segments);
+    return true;
+#else
+    Q_UNUSED(y1);
+    Q_UNUSED(y2);
+    Q_UNUSED(pixels);
+    Q_UNUSED(bandFunction);
+    return false;
+#endif
+}
+
 static void fillRect_normalized(const QRect &r, QSpanData *data,
                                 QRasterPaintEnginePrivate *pe)
 {
@@ -1441,6 +1492,7 @@ static void fillRect_normalized(const QRect &r, QSpanData *data,
 
     const int width = x2 - x1;
     const int height = y2 - y1;
+    const bool parallel = pe && pe->parallel_rasterization;
 
     bool isUnclipped = rectClipped
                        || (pe && pe->isUnclipped_normalized(QRect(x1, y1, width, height)));
@@ -1453,32 +1505,41 @@ static void fillRect_normalized(const QRect &r, QSpanData *data,
                                    && (data->solidColor.spec() != QColor::ExtendedRgb &&
                                        data->solidColor.alphaF() >= 1.0f))))
         {
-            data->fillRect(data->rasterBuffer, x1, y1, width, height, data->solidColor.rgba64());
+            const QRgba64 color = data->solidColor.rgba64();
+            auto fillBand = [&](int yStart, int yEnd) {
+                data->fillRect(data->rasterBuffer, x1, yStart, width, yEnd - yStart, color);
+            };
+            if (!parallel || !rasterizeInBands(y1, y2, qsizetype(width) * height, fillBand))
+                fillBand(y1, y2);
             return;
         }
     }
 
     ProcessSpans blend = isUnclipped ? data->unclipped_blend : data->blend;
 
-    const int nspans = 256;
-    QT_FT_Span spans[nspans];
-
     Q_ASSERT(data->blend);
-    int y = y1;
-    while (y < y2) {
-        int n = qMin(nspans, y2 - y);
-        int i = 0;
-        while (i < n) {
-            spans[i].x = x1;
-            spans[i].len = width;
-            spans[i].y = y + i;
-            spans[i].coverage = 255;
-            ++i;
-        }
+    auto blendBand = [&](int yStart, int yEnd) {
+        const int nspans = 256;
+        QT_FT_Span spans[nspans];
+
+        int y = yStart;
+        while (y < yEnd) {
+            int n = qMin(nspans, yEnd - y);
+            int i = 0;
+            while (i < n) {
+                spans[i].x = x1;
+                spans[i].len = width;
+                spans[i].y = y + i;
+                spans[i].coverage = 255;
+                ++i;
+            }
 
-        blend(n, spans, data);
-        y += n;
-    }
+            blend(n, spans, data);
+            y += n;
+        }
+    };
+    if (!parallel || !rasterizeInBands(y1, y2, qsizetype(width) * height, blendBand))
+        blendBand(y1, y2);
 }
 
 /*!
@@ -1593,6 +1654,7 @@ void QRasterPaintEngine::drawRects(const QRectF *rects, int rectCount)
 void QRasterPaintEngine::stroke(const QVectorPath &path, const QPen &pen)
 {
     Q_D(QRasterPaintEngine);
+    Q_TRACE_SCOPE(QRasterPaintEngine_stroke, path.elementCount());
     QRasterPaintEngineState *s = state();
 
     ensurePen(pen);
@@ -1683,6 +1745,7 @@ void QRasterPaintEngine::fill(const QVectorPath &path, const QBrush &brush)
 {
     if (path.isEmpty())
         return;
+    Q_TRACE_SCOPE(QRasterPaintEngine_fill, path.elementCount());
 #ifdef QT_DEBUG_DRAW
     QRectF rf = path.controlPointRect();
     qDebug() << "QRasterPaintEngine::fill(): "
@@ -2079,6 +2142,7 @@ void QRasterPaintEngine::drawPixmap(const QPointF &pos, const QPixmap &pixmap)
 */
 void QRasterPaintEngine::drawPixmap(const QRectF &r, const QPixmap &pixmap, const QRectF &sr)
 {
+    Q_TRACE_SCOPE(QRasterPaintEngine_drawPixmap, r.toRect(), pixmap.width(), pixmap.height());
 #ifdef QT_DEBUG_DRAW
     qDebug() << " - QRasterPaintEngine::drawPixmap(), r=" << r << " sr=" << sr << " pixmap=" << pixmap.size() << "depth=" << pixmap.depth();
 #endif
@@ -2250,6 +2314,7 @@ namespace {
 void QRasterPaintEngine::drawImage(const QRectF &r, const QImage &img, const QRectF &sr,
                                    Qt::ImageConversionFlags)
 {
+    Q_TRACE_SCOPE(QRasterPaintEngine_drawImage, r.toRect(), img.width(), img.height(), img.format());
 #ifdef QT_DEBUG_DRAW
     qDebug() << " - QRasterPaintEngine::drawImage(), r=" << r << " sr=" << sr << " image=" << img.size() << "depth=" << img.depth();
 #endif
@@ -3117,6 +3182,7 @@ void QRasterPaintEngine::drawStaticTextItem(QStaticTextItem *textItem)
 void QRasterPaintEngine::drawTextItem(const QPointF &p, const QTextItem &textItem)
 {
     const QTextItemInt &ti = static_cast<const QTextItemInt &>(textItem);
+    Q_TRACE_SCOPE(QRasterPaintEngine_drawTextItem, ti.glyphs.numGlyphs);
 
 #ifdef QT_DEBUG_DRAW
     Q_D(QRasterPaintEngine);
@@ -3527,6 +3593,37 @@ QRasterPaintEngine::ClipType QRasterPaintEngine::clipType() const
         return ComplexClip;
 }
 
+/*!
+    \internal
+    Enables or disables parallel rasterization, depending on \a enabled.
+
+    When enabled, large antialiased fills and large rectangular fills are split
+    into horizontal bands of the device, which are rasterized and blended on
+    the global QThreadPool while the calling thread waits for them. The result
+    is the same as with serial rasterization, except for rounding differences
+    in gradients, which are evaluated along runs of spans that the bands may
+    split differently.
+
+    The default is taken from the \c QT_RASTER_PARALLEL environment variable.
+*/
+void QRasterPaintEngine::setParallelRasterizationEnabled(bool enabled)
+{
+    Q_D(QRasterPaintEngine);
+    d->parallel_rasterization = enabled;
+}
+
+/*!
+    \internal
+    Returns whether parallel rasterization is enabled.
+
+    \sa setParallelRasterizationEnabled()
+*/
+bool QRasterPaintEngine::isParallelRasterizationEnabled() const
+{
+    Q_D(const QRasterPaintEngine);
+    return d->parallel_rasterization;
+}
+
 /*!
     \internal
     Returns the bounding rect of the currently set clip.
@@ -3571,30 +3668,6 @@ void QRasterPaintEnginePrivate::initializeRasterizer(QSpanData *data)
     rasterizer->initialize(blend, data);
 }
 
-void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
-                                          ProcessSpans callback,
-                                          QSpanData *spanData, QRasterBuffer *rasterBuffer)
-{
-    if (!callback || !outline)
-        return;
-
-    Q_Q(QRasterPaintEngine);
-    QRasterPaintEngineState *s = q->state();
-
-    if (!s->flags.antialiased) {
-        initializeRasterizer(spanData);
-
-        const Qt::FillRule fillRule = outline->flags == QT_FT_OUTLINE_NONE
-                                      ? Qt::WindingFill
-                                      : Qt::OddEvenFill;
-
-        rasterizer->rasterize(outline, fillRule);
-        return;
-    }
-
-    rasterize(outline, callback, (void *)spanData, rasterBuffer);
-}
-
 extern "C" {
     int q_gray_rendered_spans(QT_FT_Raster raster);
 }
@@ -3604,29 +3677,9 @@ static inline uchar *alignAddress(uchar *address, quintptr alignmentMask)
     return (uchar *)(((quintptr)address + alignmentMask) & ~alignmentMask);
 }
 
-void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
-                                          ProcessSpans callback,
-                                          void *userData, QRasterBuffer *)
+static void rasterizeGray(QT_FT_Raster *grayRaster, QT_FT_Outline *outline,
+                          ProcessSpans callback, void *userData, const QT_FT_BBox &clip_box)
 {
-    if (!callback || !outline)
-        return;
-
-    Q_Q(QRasterPaintEngine);
-    QRasterPaintEngineState *s = q->state();
-
-    if (!s->flags.antialiased) {
-        rasterizer->setAntialiased(s->flags.antialiased);
-        rasterizer->setClipRect(deviceRect);
-        rasterizer->initialize(callback, userData);
-
-        const Qt::FillRule fillRule = outline->flags == QT_FT_OUTLINE_NONE
-                                      ? Qt::WindingFill
-                                      : Qt::OddEvenFill;
-
-        rasterizer->rasterize(outline, fillRule);
-        return;
-    }
-
     // Initial size for raster pool is MINIMUM_POOL_SIZE so as to
     // minimize memory reallocations. However if initial size for
     // raster pool is changed for lower value, reallocations will
@@ -3636,15 +3689,10 @@ void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
     uchar *rasterPoolBase = alignAddress(rasterPoolOnStack, 0xf);
     uchar *rasterPoolOnHeap = nullptr;
 
-    qt_ft_grays_raster.raster_reset(*grayRaster.data(), rasterPoolBase, rasterPoolSize);
+    qt_ft_grays_raster.raster_reset(*grayRaster, rasterPoolBase, rasterPoolSize);
 
     void *data = userData;
 
-    QT_FT_BBox clip_box = { deviceRect.x(),
-                            deviceRect.y(),
-                            deviceRect.x() + deviceRect.width(),
-                            deviceRect.y() + deviceRect.height() };
-
     QT_FT_Raster_Params rasterParams;
     rasterParams.target = nullptr;
     rasterParams.source = outline;
@@ -3666,7 +3714,7 @@ void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
         rasterParams.flags |= (QT_FT_RASTER_FLAG_AA | QT_FT_RASTER_FLAG_DIRECT);
         rasterParams.gray_spans = callback;
         rasterParams.skip_spans = rendered_spans;
-        error = qt_ft_grays_raster.raster_render(*grayRaster.data(), &rasterParams);
+        error = qt_ft_grays_raster.raster_render(*grayRaster, &rasterParams);
 
         // Out of memory, reallocate some more and try again...
         if (error == -6) { // ErrRaster_OutOfMemory from qgrayraster.c
@@ -3676,7 +3724,7 @@ void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
                 break;
             }
 
-            rendered_spans += q_gray_rendered_spans(*grayRaster.data());
+            rendered_spans += q_gray_rendered_spans(*grayRaster);
 
             free(rasterPoolOnHeap);
             rasterPoolOnHeap = (uchar *)malloc(rasterPoolSize + 0xf);
@@ -3685,9 +3733,9 @@ void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
 
             rasterPoolBase = alignAddress(rasterPoolOnHeap, 0xf);
 
-            qt_ft_grays_raster.raster_done(*grayRaster.data());
-            qt_ft_grays_raster.raster_new(grayRaster.data());
-            qt_ft_grays_raster.raster_reset(*grayRaster.data(), rasterPoolBase, rasterPoolSize);
+            qt_ft_grays_raster.raster_done(*grayRaster);
+            qt_ft_grays_raster.raster_new(grayRaster);
+            qt_ft_grays_raster.raster_reset(*grayRaster, rasterPoolBase, rasterPoolSize);
         } else {
             done = true;
         }
@@ -3696,6 +3744,101 @@ void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
     free(rasterPoolOnHeap);
 }
 
+void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
+                                          ProcessSpans callback,
+                                          QSpanData *spanData, QRasterBuffer *rasterBuffer)
+{
+    if (!callback || !outline)
+        return;
+
+    Q_Q(QRasterPaintEngine);
+    QRasterPaintEngineState *s = q->state();
+
+    if (!s->flags.antialiased) {
+        initializeRasterizer(spanData);
+
+        const Qt::FillRule fillRule = outline->flags == QT_FT_OUTLINE_NONE
+                                      ? Qt::WindingFill
+                                      : Qt::OddEvenFill;
+
+        rasterizer->rasterize(outline, fillRule);
+        return;
+    }
+
+    if (parallel_rasterization && outline->n_points > 0) {
+        // the bounding box of the outline, which is in 26.6 fixed point
+        QT_FT_Pos xmin = outline->points[0].x;
+        QT_FT_Pos xmax = xmin;
+        QT_FT_Pos ymin = outline->points[0].y;
+        QT_FT_Pos ymax = ymin;
+        for (int i = 1; i < outline->n_points; ++i) {
+            xmin = qMin(xmin, outline->points[i].x);
+            xmax = qMax(xmax, outline->points[i].x);
+            ymin = qMin(ymin, outline->points[i].y);
+            ymax = qMax(ymax, outline->points[i].y);
+        }
+        QRect bounds = QRect(QPoint(int(xmin >> 6), int(ymin >> 6)),
+                             QPoint(int((xmax + 63) >> 6), int((ymax + 63) >> 6)));
+        bounds = bounds.intersected(deviceRect);
+        if (const QClipData *c = clip())
+            bounds = bounds.intersected(QRect(QPoint(c->xmin, c->ymin), QPoint(c->xmax - 1, c->ymax - 1)));
+
+        // each band runs its own gray raster, clipped to its rows, and blends
+        // them; the clip data and the QSpanData are only read by the callbacks
+        auto rasterizeBand = [&](int yStart, int yEnd) {
+            QT_FT_Raster raster;
+            if (qt_ft_grays_raster.raster_new(&raster)) {
+                qWarning("QPainter: Rasterization of primitive failed");
+                return;
+            }
+            const QT_FT_BBox clip_box = { deviceRect.x(),
+                                          yStart,
+                                          deviceRect.x() + deviceRect.width(),
+                                          yEnd };
+            rasterizeGray(&raster, outline, callback, spanData, clip_box);
+            qt_ft_grays_raster.raster_done(raster);
+        };
+        if (!bounds.isEmpty()
+            && rasterizeInBands(bounds.top(), bounds.bottom() + 1,
+                                qsizetype(bounds.width()) * bounds.height(), rasterizeBand)) {
+            return;
+        }
+    }
+
+    rasterize(outline, callback, (void *)spanData, rasterBuffer);
+}
+
+void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
+                                          ProcessSpans callback,
+                                          void *userData, QRasterBuffer *)
+{
+    if (!callback || !outline)
+        return;
+
+    Q_Q(QRasterPaintEngine);
+    QRasterPaintEngineState *s = q->state();
+
+    if (!s->flags.antialiased) {
+        rasterizer->setAntialiased(s->flags.antialiased);
+        rasterizer->setClipRect(deviceRect);
+        rasterizer->initialize(callback, userData);
+
+        const Qt::FillRule fillRule = outline->flags == QT_FT_OUTLINE_NONE
+                                      ? Qt::WindingFill
+                                      : Qt::OddEvenFill;
+
+        rasterizer->rasterize(outline, fillRule);
+        return;
+    }
+
+    QT_FT_BBox clip_box = { deviceRect.x(),
+                            deviceRect.y(),
+                            deviceRect.x() + deviceRect.width(),
+                            deviceRect.y() + deviceRect.height() };
+
+    rasterizeGray(grayRaster.data(), outline, callback, userData, clip_box);
+}
+
 void QRasterPaintEnginePrivate::updateClipping()
 {
     Q_Q(QRasterPaintEngine);
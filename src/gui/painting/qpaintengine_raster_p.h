@@ -206,6 +206,9 @@ public:
     ClipType clipType() const;
     QRectF clipBoundingRect() const;
 
+    void setParallelRasterizationEnabled(bool enabled);
+    bool isParallelRasterizationEnabled() const;
+
 #ifdef Q_OS_WIN
     void setDC(HDC hdc);
     HDC getDC() const;
@@ -337,6 +340,7 @@ public:
 
     uint mono_surface : 1;
     uint outlinemapper_xform_dirty : 1;
+    uint parallel_rasterization : 1;
 
     QScopedPointer<QRasterizer> rasterizer;
 };
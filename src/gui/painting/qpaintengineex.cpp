@@ -40,6 +40,7 @@
 #include "qpaintengineex_p.h"
 #include "qpainter_p.h"
 #include "qstroker_p.h"
+#include "qstrokecache_p.h"
 #include "qbezier_p.h"
 #include <private/qpainterpath_p.h>
 #include <private/qfontengine_p.h>
@@ -48,6 +49,8 @@
 #include <qvarlengtharray.h>
 #include <qdebug.h>
 
+#include <optional>
+
 
 QT_BEGIN_NAMESPACE
 
@@ -488,6 +491,26 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &inPen)
 
     // ### Perspective Xforms are currently not supported...
     if (!pen.isCosmetic()) {
+        // The outline is in the path's coordinate system. A solid stroke
+        // depends on the pen only, a dashed one also on the scale and, unless
+        // the whole path is visible, on the clip rect.
+        const bool cacheStroke = QStrokeCache::isEnabled()
+                && (clipRect.isNull() || clipRect.contains(path.controlPointRect()));
+        std::optional<QStrokeCache::Key> cacheKey;
+        if (cacheStroke) {
+            qreal scale = 0;
+            if (d->activeStroker == &d->dasher)
+                qt_scaleForTransform(state()->matrix, &scale);
+            cacheKey.emplace(QStrokeCache::Outline, pen, scale);
+            QStrokeCache::Stroke cached;
+            if (QStrokeCache::find(path, *cacheKey, &cached)) {
+                QVectorPath strokePath(cached.points.constData(), cached.types.size(),
+                                       cached.types.constData(), cached.flags);
+                fill(strokePath, pen.brush());
+                return;
+            }
+        }
+
         // We include cosmetic pens in this case to avoid having to
         // change the current transform. Normal transformed,
         // non-cosmetic pens will be transformed as part of fill
@@ -537,6 +560,16 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &inPen)
         if (!d->strokeHandler->types.size()) // an empty path...
             return;
 
+        if (cacheKey) {
+            const qreal *pts = d->strokeHandler->pts.data();
+            const QPainterPath::ElementType *elementTypes = d->strokeHandler->types.data();
+            QStrokeCache::Stroke stroke;
+            stroke.points = QList<qreal>(pts, pts + d->strokeHandler->pts.size());
+            stroke.types = QList<QPainterPath::ElementType>(elementTypes, elementTypes + d->strokeHandler->types.size());
+            stroke.flags = flags;
+            QStrokeCache::insert(path, *cacheKey, stroke);
+        }
+
         QVectorPath strokePath(d->strokeHandler->pts.data(),
                                d->strokeHandler->types.size(),
                                d->strokeHandler->types.data(),
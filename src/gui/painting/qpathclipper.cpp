@@ -1616,6 +1616,195 @@ QPainterPath QPathClipper::clip(Operation operation)
     return path;
 }
 
+/*
+    Finds the edges that cross a horizontal line in time proportional to the
+    number of crossing edges, rather than to the number of all edges. The
+    y extents of the edges are stored in a centered interval tree, so the
+    vertices must not move while the tree is in use.
+*/
+class QEdgeIntervalTree
+{
+public:
+    explicit QEdgeIntervalTree(const QWingedEdge &list);
+
+    // the edges with one vertex above and one below y, in ascending order
+    QList<int> crossingEdges(qreal y) const;
+
+private:
+    struct Interval
+    {
+        qreal min;
+        qreal max;
+        int edge;
+    };
+
+    struct Node
+    {
+        qreal center;
+        int left;
+        int right;
+        // the intervals containing center, in m_byMin and m_byMax
+        int first;
+        int count;
+    };
+
+    int build(QList<Interval> intervals);
+
+    QList<Node> m_nodes;
+    QList<Interval> m_byMin; // per node, by ascending minimum
+    QList<Interval> m_byMax; // per node, by descending maximum
+};
+
+QEdgeIntervalTree::QEdgeIntervalTree(const QWingedEdge &list)
+{
+    QList<Interval> intervals;
+    intervals.reserve(list.edgeCount());
+    for (int i = 0; i < list.edgeCount(); ++i) {
+        const QPathEdge *edge = list.edge(i);
+        const qreal y0 = list.vertex(edge->first)->y;
+        const qreal y1 = list.vertex(edge->second)->y;
+        // horizontal edges never cross a horizontal line
+        if (y0 < y1)
+            intervals.append({ y0, y1, i });
+        else if (y1 < y0)
+            intervals.append({ y1, y0, i });
+    }
+    build(std::move(intervals));
+}
+
+int QEdgeIntervalTree::build(QList<Interval> intervals)
+{
+    if (intervals.isEmpty())
+        return -1;
+
+    // the interval with the median midpoint contains the center, and at
+    // most half of the others end before or start after it
+    const auto median = intervals.begin() + intervals.size() / 2;
+    std::nth_element(intervals.begin(), median, intervals.end(),
+                     [](const Interval &a, const Interval &b) {
+        return a.min + a.max < b.min + b.max;
+    });
+    const qreal center = 0.5 * (median->min + median->max);
+
+    const int index = m_nodes.size();
+    const int first = m_byMin.size();
+    QList<Interval> left;
+    QList<Interval> right;
+    for (const Interval &interval : qAsConst(intervals)) {
+        if (interval.max < center) {
+            left.append(interval);
+        } else if (interval.min > center) {
+            right.append(interval);
+        } else {
+            m_byMin.append(interval);
+            m_byMax.append(interval);
+        }
+    }
+    intervals.clear();
+
+    std::sort(m_byMin.begin() + first, m_byMin.end(), [](const Interval &a, const Interval &b) {
+        return a.min < b.min;
+    });
+    std::sort(m_byMax.begin() + first, m_byMax.end(), [](const Interval &a, const Interval &b) {
+        return a.max > b.max;
+    });
+    m_nodes.append({ center, -1, -1, first, int(m_byMin.size()) - first });
+
+    const int leftIndex = build(std::move(left));
+    const int rightIndex = build(std::move(right));
+    m_nodes[index].left = leftIndex;
+    m_nodes[index].right = rightIndex;
+    return index;
+}
+
+QList<int> QEdgeIntervalTree::crossingEdges(qreal y) const
+{
+    QList<int> edges;
+    int index = m_nodes.isEmpty() ? -1 : 0;
+    while (index >= 0) {
+        const Node &node = m_nodes.at(index);
+        const Interval *byMin = m_byMin.constData() + node.first;
+        const Interval *byMax = m_byMax.constData() + node.first;
+        if (y < node.center) {
+            // all intervals of the node end after y
+            for (int i = 0; i < node.count && byMin[i].min < y; ++i)
+                edges.append(byMin[i].edge);
+            index = node.left;
+        } else if (y > node.center) {
+            // all intervals of the node start before y
+            for (int i = 0; i < node.count && byMax[i].max > y; ++i)
+                edges.append(byMax[i].edge);
+            index = node.right;
+        } else {
+            for (int i = 0; i < node.count; ++i) {
+                if (byMin[i].min < y && byMin[i].max > y)
+                    edges.append(byMin[i].edge);
+            }
+            break;
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+namespace {
+// Finds the largest gap between consecutive sorted coordinates within a
+// range in constant time, using a sparse table of the positions of the
+// largest gap in each power-of-two sized range.
+class LargestGapFinder
+{
+public:
+    explicit LargestGapFinder(const QList<qreal> &coordinates)
+        : m_coordinates(coordinates)
+    {
+        const int gapCount = int(coordinates.size()) - 1;
+        if (gapCount <= 0)
+            return;
+        m_levels.resize(1);
+        m_levels[0].resize(gapCount);
+        for (int i = 0; i < gapCount; ++i)
+            m_levels[0][i] = i;
+        for (int width = 2; width <= gapCount; width *= 2) {
+            const QList<int> &previous = m_levels.last();
+            QList<int> level(gapCount - width + 1);
+            for (int i = 0; i < level.size(); ++i)
+                level[i] = larger(previous.at(i), previous.at(i + width / 2));
+            m_levels.append(std::move(level));
+        }
+    }
+
+    // the first of the largest gaps that start at first up to last
+    int find(int first, int last) const
+    {
+        Q_ASSERT(first <= last && last < int(m_coordinates.size()) - 1);
+        const int level = 31 - qCountLeadingZeroBits(quint32(last - first + 1));
+        const QList<int> &gaps = m_levels.at(level);
+        return larger(gaps.at(first), gaps.at(last - (1 << level) + 1));
+    }
+
+private:
+    qreal gap(int i) const { return m_coordinates.at(i + 1) - m_coordinates.at(i); }
+    // a comes before b, and is preferred if they are equal
+    int larger(int a, int b) const { return gap(b) > gap(a) ? b : a; }
+
+    const QList<qreal> &m_coordinates;
+    QList<QList<int>> m_levels;
+};
+}
+
+// coordinates is sorted, so the coordinate fuzzily equal to value is next
+// to the position where value would be inserted
+static int findCoordinate(const QList<qreal> &coordinates, int from, qreal value)
+{
+    const auto begin = coordinates.cbegin() + from;
+    auto it = std::lower_bound(begin, coordinates.cend(), value);
+    while (it != begin && qFuzzyCompare(*(it - 1), value))
+        --it;
+    if (it == coordinates.cend() || !qFuzzyCompare(*it, value))
+        it = qFuzzyFind(begin, coordinates.cend(), value);
+    return it - coordinates.cbegin();
+}
+
 bool QPathClipper::doClip(QWingedEdge &list, ClipperMode mode)
 {
     QList<qreal> y_coords;
@@ -1633,68 +1822,59 @@ bool QPathClipper::doClip(QWingedEdge &list, ClipperMode mode)
     }
 #endif
 
-    bool found;
-    do {
-        found = false;
-        int index = 0;
-        qreal maxHeight = 0;
-        for (int i = 0; i < list.edgeCount(); ++i) {
-            QPathEdge *edge = list.edge(i);
-
-            // have both sides of this edge already been handled?
-            if ((edge->flag & 0x3) == 0x3)
-                continue;
+    // Each scan line handles the tallest edge that has not been handled
+    // yet, and possibly others; since handled edges stay handled, the edges
+    // can be visited in order of decreasing height.
+    QList<int> edges;
+    QList<qreal> heights(list.edgeCount());
+    edges.reserve(list.edgeCount());
+    for (int i = 0; i < list.edgeCount(); ++i) {
+        const QPathEdge *edge = list.edge(i);
+        const QPathVertex *a = list.vertex(edge->first);
+        const QPathVertex *b = list.vertex(edge->second);
 
-            QPathVertex *a = list.vertex(edge->first);
-            QPathVertex *b = list.vertex(edge->second);
+        if (qFuzzyCompare(a->y, b->y))
+            continue;
 
-            if (qFuzzyCompare(a->y, b->y))
-                continue;
+        heights[i] = qAbs(a->y - b->y);
+        if (heights.at(i) > 0)
+            edges << i;
+    }
+    std::stable_sort(edges.begin(), edges.end(), [&heights](int a, int b) {
+        return heights.at(a) > heights.at(b);
+    });
 
-            found = true;
+    const QEdgeIntervalTree tree(list);
+    const LargestGapFinder gapFinder(y_coords);
 
-            qreal height = qAbs(a->y - b->y);
-            if (height > maxHeight) {
-                index = i;
-                maxHeight = height;
-            }
-        }
+    for (int index : qAsConst(edges)) {
+        QPathEdge *edge = list.edge(index);
 
-        if (found) {
-            QPathEdge *edge = list.edge(index);
+        // have both sides of this edge already been handled?
+        if ((edge->flag & 0x3) == 0x3)
+            continue;
 
-            QPathVertex *a = list.vertex(edge->first);
-            QPathVertex *b = list.vertex(edge->second);
+        QPathVertex *a = list.vertex(edge->first);
+        QPathVertex *b = list.vertex(edge->second);
 
-            // FIXME: this can be optimized by using binary search
-            const int first = qFuzzyFind(y_coords.cbegin(), y_coords.cend(), qMin(a->y, b->y)) - y_coords.cbegin();
-            const int last = qFuzzyFind(y_coords.cbegin() + first, y_coords.cend(), qMax(a->y, b->y)) - y_coords.cbegin();
+        const int first = findCoordinate(y_coords, 0, qMin(a->y, b->y));
+        const int last = findCoordinate(y_coords, first, qMax(a->y, b->y));
 
-            Q_ASSERT(first < y_coords.size() - 1);
-            Q_ASSERT(last < y_coords.size());
+        Q_ASSERT(first < y_coords.size() - 1);
+        Q_ASSERT(last < y_coords.size());
 
-            qreal biggestGap = y_coords.at(first + 1) - y_coords.at(first);
-            int bestIdx = first;
-            for (int i = first + 1; i < last; ++i) {
-                qreal gap = y_coords.at(i + 1) - y_coords.at(i);
-
-                if (gap > biggestGap) {
-                    bestIdx = i;
-                    biggestGap = gap;
-                }
-            }
-            const qreal bestY = 0.5 * (y_coords.at(bestIdx) + y_coords.at(bestIdx + 1));
+        const int bestIdx = gapFinder.find(first, qMax(first, last - 1));
+        const qreal bestY = 0.5 * (y_coords.at(bestIdx) + y_coords.at(bestIdx + 1));
 
 #ifdef QDEBUG_CLIPPER
-            printf("y: %.9f, gap: %.9f\n", bestY, biggestGap);
+        printf("y: %.9f, gap: %.9f\n", bestY, y_coords.at(bestIdx + 1) - y_coords.at(bestIdx));
 #endif
 
-            if (handleCrossingEdges(list, bestY, mode) && mode == CheckMode)
-                return true;
+        if (handleCrossingEdges(list, tree, bestY, mode) && mode == CheckMode)
+            return true;
 
-            edge->flag |= 0x3;
-        }
-    } while (found);
+        edge->flag |= 0x3;
+    }
 
     if (mode == ClipMode)
         list.simplify();
@@ -1778,26 +1958,28 @@ bool QWingedEdge::isInside(qreal x, qreal y) const
     return winding & 1;
 }
 
-static QList<QCrossingEdge> findCrossings(const QWingedEdge &list, qreal y)
+static QList<QCrossingEdge> findCrossings(const QWingedEdge &list, const QEdgeIntervalTree &tree,
+                                          qreal y)
 {
+    const QList<int> edges = tree.crossingEdges(y);
     QList<QCrossingEdge> crossings;
-    for (int i = 0; i < list.edgeCount(); ++i) {
+    crossings.reserve(edges.size());
+    for (int i : edges) {
         const QPathEdge *edge = list.edge(i);
         QPointF a = *list.vertex(edge->first);
         QPointF b = *list.vertex(edge->second);
 
-        if ((a.y() < y && b.y() > y) || (a.y() > y && b.y() < y)) {
-            const qreal intersection = a.x() + (b.x() - a.x()) * (y - a.y()) / (b.y() - a.y());
-            const QCrossingEdge edge = { i, intersection };
-            crossings << edge;
-        }
+        const qreal intersection = a.x() + (b.x() - a.x()) * (y - a.y()) / (b.y() - a.y());
+        const QCrossingEdge crossing = { i, intersection };
+        crossings << crossing;
     }
     return crossings;
 }
 
-bool QPathClipper::handleCrossingEdges(QWingedEdge &list, qreal y, ClipperMode mode)
+bool QPathClipper::handleCrossingEdges(QWingedEdge &list, const QEdgeIntervalTree &tree, qreal y,
+                                       ClipperMode mode)
 {
-    QList<QCrossingEdge> crossings = findCrossings(list, y);
+    QList<QCrossingEdge> crossings = findCrossings(list, tree, y);
 
     Q_ASSERT(!crossings.isEmpty());
     std::sort(crossings.begin(), crossings.end());
@@ -63,6 +63,7 @@ QT_BEGIN_NAMESPACE
 
 
 class QWingedEdge;
+class QEdgeIntervalTree;
 
 class Q_GUI_EXPORT QPathClipper
 {
@@ -93,7 +94,8 @@ private:
         CheckMode // for contains/intersects (only interested in whether the result path is non-empty)
     };
 
-    bool handleCrossingEdges(QWingedEdge &list, qreal y, ClipperMode mode);
+    bool handleCrossingEdges(QWingedEdge &list, const QEdgeIntervalTree &tree, qreal y,
+                             ClipperMode mode);
     bool doClip(QWingedEdge &list, ClipperMode mode);
 
     QPainterPath subjectPath;
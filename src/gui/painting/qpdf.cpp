@@ -56,6 +56,11 @@
 #include <qnumeric.h>
 #include <qtemporaryfile.h>
 #include <quuid.h>
+#if QT_CONFIG(thread)
+#include <qthreadpool.h>
+#endif
+
+#include <utility>
 
 #ifndef QT_NO_COMPRESS
 #include <zlib.h>
@@ -65,6 +70,59 @@
 static const bool do_compress = false;
 #else
 static const bool do_compress = true;
+
+// Deflates the contents of dev, read chunkSize bytes at a time, and hands the
+// compressed data to sink as it is produced
+template <typename Sink>
+static bool deflateDevice(QIODevice *dev, int chunkSize, Sink sink)
+{
+    ::z_stream zStruct;
+    zStruct.zalloc = Z_NULL;
+    zStruct.zfree = Z_NULL;
+    zStruct.opaque = Z_NULL;
+    if (::deflateInit(&zStruct, Z_DEFAULT_COMPRESSION) != Z_OK) {
+        qWarning("QPdfStream::writeCompressed: Error in deflateInit()");
+        return false;
+    }
+    zStruct.avail_in = 0;
+    QByteArray in, out;
+    out.resize(chunkSize);
+    while (!dev->atEnd() || zStruct.avail_in != 0) {
+        if (zStruct.avail_in == 0) {
+            in = dev->read(chunkSize);
+            zStruct.avail_in = in.size();
+            zStruct.next_in = reinterpret_cast<unsigned char*>(in.data());
+            if (in.size() <= 0) {
+                qWarning("QPdfStream::writeCompressed: Error in read()");
+                ::deflateEnd(&zStruct);
+                return false;
+            }
+        }
+        zStruct.next_out = reinterpret_cast<unsigned char*>(out.data());
+        zStruct.avail_out = out.size();
+        if (::deflate(&zStruct, 0) != Z_OK) {
+            qWarning("QPdfStream::writeCompressed: Error in deflate()");
+            ::deflateEnd(&zStruct);
+            return false;
+        }
+        sink(out.constData(), int(out.size() - zStruct.avail_out));
+    }
+    int ret;
+    do {
+        zStruct.next_out = reinterpret_cast<unsigned char*>(out.data());
+        zStruct.avail_out = out.size();
+        ret = ::deflate(&zStruct, Z_FINISH);
+        if (ret != Z_OK && ret != Z_STREAM_END) {
+            qWarning("QPdfStream::writeCompressed: Error in deflate()");
+            ::deflateEnd(&zStruct);
+            return false;
+        }
+        sink(out.constData(), int(out.size() - zStruct.avail_out));
+    } while (ret == Z_OK);
+
+    ::deflateEnd(&zStruct);
+    return true;
+}
 #endif
 
 // might be helpful for smooth transforms of images
@@ -1499,6 +1557,8 @@ QPdfEnginePrivate::QPdfEnginePrivate()
     stroker.stream = nullptr;
 
     streampos = 0;
+    objectStream = 0;
+    objectBuffer = nullptr;
 
     stream = new QDataStream;
 }
@@ -1549,7 +1609,13 @@ bool QPdfEngine::begin(QPaintDevice *pdev)
 
     d->pages.clear();
     d->imageCache.clear();
+    d->imageContentCache.clear();
     d->alphaCache.clear();
+    d->compressedObjects.clear();
+    d->objectStream = 0;
+    d->objectStreamObjects.clear();
+    d->objectStreamData.clear();
+    d->objectBuffer = nullptr;
 
     setActive(true);
     d->writeHeader();
@@ -1590,6 +1656,13 @@ void QPdfEngine::addFileAttachment(const QString &fileName, const QByteArray &da
 
 QPdfEnginePrivate::~QPdfEnginePrivate()
 {
+#if QT_CONFIG(thread)
+    for (PendingPageStream *pending : qAsConst(pendingPageStreams)) {
+        pending->done.acquire();
+        delete pending->page;
+        delete pending;
+    }
+#endif
     qDeleteAll(fonts);
     delete currentPage;
     delete stream;
@@ -2045,13 +2118,12 @@ void QPdfEnginePrivate::writePage()
     *currentPage << "Q Q\n";
 
     uint pageStream = requestObject();
-    uint pageStreamLength = requestObject();
     uint resources = requestObject();
     uint annots = requestObject();
 
     qreal userUnit = calcUserUnit();
 
-    addXrefEntry(pages.constLast());
+    beginObject(pages.constLast());
     xprintf("<<\n"
             "/Type /Page\n"
             "/Parent %d 0 R\n"
@@ -2067,10 +2139,10 @@ void QPdfEnginePrivate::writePage()
     if (pdfVersion >= QPdfEngine::Version_1_6)
         xprintf("/UserUnit %s\n", QByteArray::number(userUnit, 'f').constData());
 
-    xprintf(">>\n"
-            "endobj\n");
+    xprintf(">>\n");
+    endObject();
 
-    addXrefEntry(resources);
+    beginObject(resources);
     xprintf("<<\n"
             "/ColorSpace <<\n"
             "/PCSp %d 0 R\n"
@@ -2101,47 +2173,282 @@ void QPdfEnginePrivate::writePage()
     }
     xprintf(">>\n");
 
-    xprintf(">>\n"
-            "endobj\n");
+    xprintf(">>\n");
+    endObject();
 
-    addXrefEntry(annots);
+    beginObject(annots);
     xprintf("[ ");
     for (int i = 0; i<currentPage->annotations.size(); ++i) {
         xprintf("%d 0 R ", currentPage->annotations.at(i));
     }
-    xprintf("]\nendobj\n");
+    xprintf("]\n");
+    endObject();
+
+    writePageStream(pageStream, std::exchange(currentPage, nullptr));
+}
+
+void QPdfEnginePrivate::writePageStream(uint object, QPdfPage *page)
+{
+#if QT_CONFIG(thread) && !defined(QT_NO_COMPRESS) && !defined(Q_OS_WASM)
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    if (threadPool->maxThreadCount() > 1 && !threadPool->contains(QThread::currentThread())) {
+        // Compress the content while the next pages are painted. The streams
+        // are written out in order by flushPageStreams().
+        PendingPageStream *pending = new PendingPageStream;
+        pending->object = object;
+        pending->page = page;
+        QIODevice *content = page->stream();
+        threadPool->start([pending, content]() {
+            deflateDevice(content, 1 << 16, [pending](const char *data, int size) {
+                pending->data.append(data, size);
+            });
+            pending->done.release();
+        });
+        pendingPageStreams.append(pending);
+        flushPageStreams(threadPool->maxThreadCount());
+        return;
+    }
+#endif
+
+    uint length = requestObject();
 
-    addXrefEntry(pageStream);
+    addXrefEntry(object);
     xprintf("<<\n"
-            "/Length %d 0 R\n", pageStreamLength); // object number for stream length object
+            "/Length %d 0 R\n", length); // object number for stream length object
     if (do_compress)
         xprintf("/Filter /FlateDecode\n");
 
     xprintf(">>\n");
     xprintf("stream\n");
-    QIODevice *content = currentPage->stream();
+    QIODevice *content = page->stream();
     int len = writeCompressed(content);
     xprintf("\nendstream\n"
             "endobj\n");
+    delete page;
+
+    beginObject(length);
+    xprintf("%d\n", len);
+    endObject();
+}
 
-    addXrefEntry(pageStreamLength);
-    xprintf("%d\nendobj\n",len);
+/*!
+    \internal
+
+    Writes the page content streams that have been compressed, in order, and
+    waits for the oldest ones while more than \a maxPending are left.
+*/
+void QPdfEnginePrivate::flushPageStreams(qsizetype maxPending)
+{
+#if QT_CONFIG(thread)
+    Q_ASSERT(!objectBuffer);
+    while (!pendingPageStreams.isEmpty()) {
+        PendingPageStream *pending = pendingPageStreams.constFirst();
+        if (pendingPageStreams.size() > maxPending)
+            pending->done.acquire();
+        else if (!pending->done.tryAcquire())
+            break;
+        pendingPageStreams.removeFirst();
+
+        addXrefEntry(pending->object);
+        xprintf("<<\n"
+                "/Length %d\n"
+                "/Filter /FlateDecode\n"
+                ">>\n"
+                "stream\n", int(pending->data.size()));
+        write(pending->data);
+        xprintf("\nendstream\n"
+                "endobj\n");
+
+        delete pending->page;
+        delete pending;
+    }
+#else
+    Q_UNUSED(maxPending);
+#endif
+}
+
+bool QPdfEnginePrivate::useObjectStreams() const
+{
+    // Object streams were introduced with PDF 1.5, and are of no use uncompressed
+    return do_compress && pdfVersion == QPdfEngine::Version_1_6;
+}
+
+/*!
+    \internal
+
+    Starts writing \a object. Unlike objects started with addXrefEntry(), it
+    must not be a stream, and must be completed with endObject().
+*/
+void QPdfEnginePrivate::beginObject(uint object)
+{
+    Q_ASSERT(!objectBuffer);
+    if (!useObjectStreams()) {
+        addXrefEntry(object);
+        return;
+    }
+
+    if (!objectStream)
+        objectStream = requestObject();
+    compressedObjects.insert(object, { objectStream, int(objectStreamObjects.size()) });
+    objectStreamObjects.append(qMakePair(object, int(objectStreamData.size())));
+    objectBuffer = &objectStreamData;
+}
+
+void QPdfEnginePrivate::endObject()
+{
+    if (!objectBuffer) {
+        xprintf("endobj\n");
+        return;
+    }
+
+    objectBuffer = nullptr;
+    if (objectStreamObjects.size() >= 100)
+        flushObjectStream();
+}
+
+// Returns data compressed in the format expected by /FlateDecode, or an
+// empty array if that fails
+static QByteArray deflateData(const QByteArray &data)
+{
+    QByteArray compressed;
+#ifndef QT_NO_COMPRESS
+    uLongf destLen = ::compressBound(uLong(data.size()));
+    compressed.resize(qsizetype(destLen));
+    if (::compress(reinterpret_cast<Bytef *>(compressed.data()), &destLen,
+                   reinterpret_cast<const Bytef *>(data.constData()), uLong(data.size())) == Z_OK) {
+        compressed.resize(qsizetype(destLen));
+    } else {
+        qWarning("QPdfEngine: Error in compress()");
+        compressed.clear();
+    }
+#else
+    Q_UNUSED(data);
+#endif
+    return compressed;
+}
+
+void QPdfEnginePrivate::flushObjectStream()
+{
+    Q_ASSERT(!objectBuffer);
+    if (objectStreamObjects.isEmpty())
+        return;
+
+    QByteArray data;
+    for (const auto &object : qAsConst(objectStreamObjects))
+        data += QByteArray::number(object.first) + ' ' + QByteArray::number(object.second) + ' ';
+    const int first = int(data.size());
+    data += objectStreamData;
+
+    QByteArray compressed = deflateData(data);
+    const bool deflated = !compressed.isEmpty();
+
+    addXrefEntry(objectStream);
+    xprintf("<<\n"
+            "/Type /ObjStm\n"
+            "/N %d\n"
+            "/First %d\n"
+            "/Length %d\n",
+            int(objectStreamObjects.size()), first, int(deflated ? compressed.size() : data.size()));
+    if (deflated)
+        xprintf("/Filter /FlateDecode\n");
+    xprintf(">>\n"
+            "stream\n");
+    write(deflated ? compressed : data);
+    xprintf("\nendstream\n"
+            "endobj\n");
+
+    objectStream = 0;
+    objectStreamObjects.clear();
+    objectStreamData.clear();
+}
+
+/*!
+    \internal
+
+    Writes a cross-reference stream, which replaces both the cross-reference
+    table and the trailer when objects are stored in object streams.
+*/
+void QPdfEnginePrivate::writeXrefStream()
+{
+    const uint xrefStream = requestObject();
+    addXrefEntry(xrefStream);
+    const qint64 xrefOffset = xrefPositions.at(xrefStream);
+
+    const int size = int(currentObject);
+    if (xrefPositions.size() < size)
+        xrefPositions.resize(size);
+
+    int offsetSize = 1;
+    while (offsetSize < 8 && (qMax<qint64>(xrefOffset, size) >> (8 * offsetSize)))
+        ++offsetSize;
+
+    QByteArray entries;
+    entries.reserve(size * (offsetSize + 3));
+    auto append = [&entries](quint64 value, int bytes) {
+        while (bytes--)
+            entries.append(char(value >> (8 * bytes)));
+    };
+    for (int i = 0; i < size; ++i) {
+        const auto compressed = compressedObjects.constFind(uint(i));
+        if (compressed != compressedObjects.cend()) {
+            append(2, 1);
+            append(compressed->objectStream, offsetSize);
+            append(compressed->index, 2);
+        } else if (i > 0 && xrefPositions.at(i) > 0) {
+            append(1, 1);
+            append(xrefPositions.at(i), offsetSize);
+            append(0, 2);
+        } else {
+            append(0, 1);
+            append(0, offsetSize);
+            append(i == 0 ? 65535 : 0, 2);
+        }
+    }
+
+    QByteArray compressed = deflateData(entries);
+    const bool deflated = !compressed.isEmpty();
+
+    xprintf("<<\n"
+            "/Type /XRef\n"
+            "/Size %d\n"
+            "/W [1 %d 2]\n"
+            "/Root %d 0 R\n"
+            "/Info %d 0 R\n"
+            "/Length %d\n",
+            size, offsetSize, catalog, info, int(deflated ? compressed.size() : entries.size()));
+    if (deflated)
+        xprintf("/Filter /FlateDecode\n");
+    xprintf(">>\n"
+            "stream\n");
+    write(deflated ? compressed : entries);
+    xprintf("\nendstream\n"
+            "endobj\n"
+            "startxref\n"
+            "%lld\n"
+            "%%%%EOF\n", xrefOffset);
 }
 
 void QPdfEnginePrivate::writeTail()
 {
     writePage();
+    flushPageStreams(0);
     writeFonts();
     writePageRoot();
     writeAttachmentRoot();
 
+    if (useObjectStreams()) {
+        flushObjectStream();
+        writeXrefStream();
+        return;
+    }
+
     addXrefEntry(xrefPositions.size(),false);
     xprintf("xref\n"
             "0 %d\n"
-            "%010d 65535 f \n", xrefPositions.size()-1, xrefPositions[0]);
+            "%010lld 65535 f \n", int(xrefPositions.size() - 1), xrefPositions[0]);
 
     for (int i = 1; i < xrefPositions.size()-1; ++i)
-        xprintf("%010d 00000 n \n", xrefPositions[i]);
+        xprintf("%010lld 00000 n \n", xrefPositions[i]);
 
     {
         QByteArray trailer;
@@ -2222,76 +2529,27 @@ void QPdfEnginePrivate::xprintf(const char* fmt, ...)
     va_end(args);
 
     if (Q_LIKELY(bufsize < msize)) {
-        stream->writeRawData(buf, bufsize);
+        write(QByteArray::fromRawData(buf, bufsize));
     } else {
         // Fallback for abnormal cases
         QScopedArrayPointer<char> tmpbuf(new char[bufsize + 1]);
         va_start(args, fmt);
         bufsize = qvsnprintf(tmpbuf.data(), bufsize + 1, fmt, args);
         va_end(args);
-        stream->writeRawData(tmpbuf.data(), bufsize);
+        write(QByteArray::fromRawData(tmpbuf.data(), bufsize));
     }
-    streampos += bufsize;
 }
 
 int QPdfEnginePrivate::writeCompressed(QIODevice *dev)
 {
 #ifndef QT_NO_COMPRESS
     if (do_compress) {
-        int size = QPdfPage::chunkSize();
         int sum = 0;
-        ::z_stream zStruct;
-        zStruct.zalloc = Z_NULL;
-        zStruct.zfree = Z_NULL;
-        zStruct.opaque = Z_NULL;
-        if (::deflateInit(&zStruct, Z_DEFAULT_COMPRESSION) != Z_OK) {
-            qWarning("QPdfStream::writeCompressed: Error in deflateInit()");
-            return sum;
-        }
-        zStruct.avail_in = 0;
-        QByteArray in, out;
-        out.resize(size);
-        while (!dev->atEnd() || zStruct.avail_in != 0) {
-            if (zStruct.avail_in == 0) {
-                in = dev->read(size);
-                zStruct.avail_in = in.size();
-                zStruct.next_in = reinterpret_cast<unsigned char*>(in.data());
-                if (in.size() <= 0) {
-                    qWarning("QPdfStream::writeCompressed: Error in read()");
-                    ::deflateEnd(&zStruct);
-                    return sum;
-                }
-            }
-            zStruct.next_out = reinterpret_cast<unsigned char*>(out.data());
-            zStruct.avail_out = out.size();
-            if (::deflate(&zStruct, 0) != Z_OK) {
-                qWarning("QPdfStream::writeCompressed: Error in deflate()");
-                ::deflateEnd(&zStruct);
-                return sum;
-            }
-            int written = out.size() - zStruct.avail_out;
-            stream->writeRawData(out.constData(), written);
-            streampos += written;
-            sum += written;
-        }
-        int ret;
-        do {
-            zStruct.next_out = reinterpret_cast<unsigned char*>(out.data());
-            zStruct.avail_out = out.size();
-            ret = ::deflate(&zStruct, Z_FINISH);
-            if (ret != Z_OK && ret != Z_STREAM_END) {
-                qWarning("QPdfStream::writeCompressed: Error in deflate()");
-                ::deflateEnd(&zStruct);
-                return sum;
-            }
-            int written = out.size() - zStruct.avail_out;
-            stream->writeRawData(out.constData(), written);
-            streampos += written;
-            sum += written;
-        } while (ret == Z_OK);
-
-        ::deflateEnd(&zStruct);
-
+        deflateDevice(dev, QPdfPage::chunkSize(), [this, &sum](const char *data, int size) {
+            stream->writeRawData(data, size);
+            streampos += size;
+            sum += size;
+        });
         return sum;
     } else
 #endif
@@ -2836,6 +3094,20 @@ static inline bool is_monochrome(const QList<QRgb> &colorTable)
 /*!
  * Adds an image to the pdf and return the pdf-object id. Returns -1 if adding the image failed.
  */
+static QByteArray imageContentKey(const QImage &image, bool bitmap, bool lossless)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const int header[] = { image.width(), image.height(), int(image.format()), bitmap, lossless };
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(header), sizeof(header)));
+    const QList<QRgb> colorTable = image.colorTable();
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(colorTable.constData()),
+                                colorTable.size() * qsizetype(sizeof(QRgb))));
+    const qsizetype bytesPerLine = (qsizetype(image.width()) * image.depth() + 7) / 8;
+    for (int y = 0; y < image.height(); ++y)
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(image.constScanLine(y)), bytesPerLine));
+    return hash.result();
+}
+
 int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, bool lossless, qint64 serial_no)
 {
     if (img.isNull())
@@ -2845,6 +3117,16 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, bool lossless,
     if (object)
         return object;
 
+    // The same image is often drawn from different QImage or QPixmap
+    // instances, such as a logo that is loaded for every page
+    const QByteArray contentKey = imageContentKey(img, *bitmap, lossless);
+    const auto cached = imageContentCache.constFind(contentKey);
+    if (cached != imageContentCache.cend()) {
+        *bitmap = cached->second;
+        imageCache.insert(serial_no, cached->first);
+        return cached->first;
+    }
+
     QImage image = img;
     QImage::Format format = image.format();
 
@@ -2975,6 +3257,7 @@ int QPdfEnginePrivate::addImage(const QImage &img, bool *bitmap, bool lossless,
                             maskObject, softMaskObject, dct);
     }
     imageCache.insert(serial_no, object);
+    imageContentCache.insert(contentKey, qMakePair(uint(object), *bitmap));
     return object;
 }
 
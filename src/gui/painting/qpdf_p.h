@@ -57,6 +57,9 @@
 
 #include "QtCore/qlist.h"
 #include "QtCore/qstring.h"
+#if QT_CONFIG(thread)
+#include "QtCore/qsemaphore.h"
+#endif
 #include "private/qfontengine_p.h"
 #include "private/qfontsubset_p.h"
 #include "private/qpaintengine_p.h"
@@ -87,7 +90,7 @@ namespace QPdf {
         ByteStream &operator <<(qreal val);
         ByteStream &operator <<(int val);
         ByteStream &operator <<(uint val) { return (*this << int(val)); }
-        ByteStream &operator <<(qint64 val) { return (*this << int(val)); }
+        ByteStream &operator <<(qint64 val) { return (*this << QByteArray::number(val) << ' '); }
         ByteStream &operator <<(const QPointF &p);
         // Note that the stream may be invalidated by calls that insert data.
         QIODevice *stream();
@@ -312,22 +315,36 @@ private:
     void embedFont(QFontSubset *font);
     qreal calcUserUnit() const;
 
-    QList<int> xrefPositions;
+    QList<qint64> xrefPositions;
     QDataStream* stream;
-    int streampos;
+    qint64 streampos;
 
     int writeImage(const QByteArray &data, int width, int height, int depth,
                    int maskObject, int softMaskObject, bool dct = false, bool isMono = false);
     void writePage();
+    void writePageStream(uint object, QPdfPage *page);
+    void flushPageStreams(qsizetype maxPending);
 
     int addXrefEntry(int object, bool printostr = true);
     void printString(QStringView string);
     void xprintf(const char* fmt, ...);
     inline void write(const QByteArray &data) {
+        if (objectBuffer) {
+            objectBuffer->append(data);
+            return;
+        }
         stream->writeRawData(data.constData(), data.size());
         streampos += data.size();
     }
 
+    // Objects written between beginObject() and endObject() are packed into
+    // compressed object streams when the PDF version allows it
+    bool useObjectStreams() const;
+    void beginObject(uint object);
+    void endObject();
+    void flushObjectStream();
+    void writeXrefStream();
+
     int writeCompressed(const char *src, int len);
     inline int writeCompressed(const QByteArray &data) { return writeCompressed(data.constData(), data.length()); }
     int writeCompressed(QIODevice *dev);
@@ -345,9 +362,33 @@ private:
     int pageRoot, embeddedfilesRoot, namesRoot, catalog, info, graphicsState, patternColorSpace;
     QList<uint> pages;
     QHash<qint64, uint> imageCache;
+    QHash<QByteArray, QPair<uint, bool>> imageContentCache; // image object and whether it is a bitmap
     QHash<QPair<uint, uint>, uint > alphaCache;
     QList<AttachmentInfo> fileCache;
     QByteArray xmpDocumentMetadata;
+
+    struct CompressedObject
+    {
+        uint objectStream;
+        int index;
+    };
+    QHash<uint, CompressedObject> compressedObjects;
+    uint objectStream;
+    QList<QPair<uint, int>> objectStreamObjects; // object number and offset in objectStreamData
+    QByteArray objectStreamData;
+    QByteArray *objectBuffer;
+
+#if QT_CONFIG(thread)
+    // Page content streams that are being compressed on the thread pool
+    struct PendingPageStream
+    {
+        uint object;
+        QPdfPage *page;
+        QByteArray data;
+        QSemaphore done;
+    };
+    QList<PendingPageStream *> pendingPageStreams;
+#endif
 };
 
 QT_END_NAMESPACE
@@ -81,7 +81,9 @@ public:
     enum Flag {
         StacksOnTop = 0x01,
         TextureIsSrgb = 0x02,
-        NeedsPremultipliedAlphaBlending = 0x04
+        NeedsPremultipliedAlphaBlending = 0x04,
+        TextureIsDirty = 0x08,
+        Unobscured = 0x10
     };
     Q_DECLARE_FLAGS(Flags, Flag)
 
@@ -50,6 +50,8 @@
 
 #include <private/qdebug_p.h>
 
+#include <algorithm>
+
 #ifdef Q_OS_WIN
 #  include <qt_windows.h>
 #endif
@@ -927,7 +929,55 @@ QRegion QRegion::intersect(const QRect &r) const
     \omit
     Only some platforms have these restrictions (Qt for Embedded Linux, X11 and \macos).
     \endomit
+
+    \sa fromRects()
+*/
+
+/*!
+    \since 6.4
+
+    Returns the union of the \a count rectangles starting at \a rects.
+    Unlike setRects(), the rectangles may be in any order and overlap.
+
+    This is much faster than uniting the rectangles with a region one at a
+    time, which becomes slower with every rectangle that the region
+    consists of.
+
+    \sa united(), setRects()
 */
+QRegion QRegion::fromRects(const QRect *rects, qsizetype count)
+{
+    QList<QRect> sorted;
+    sorted.reserve(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        if (!rects[i].isEmpty())
+            sorted.append(rects[i]);
+    }
+    if (sorted.isEmpty())
+        return QRegion();
+
+    // rectangles that are next to each other in a band can then be appended
+    // to each other without a full union
+    std::sort(sorted.begin(), sorted.end(), [](const QRect &a, const QRect &b) {
+        return a.top() < b.top() || (a.top() == b.top() && a.left() < b.left());
+    });
+
+    // unite pairs of regions until only one is left, so that each rectangle
+    // takes part in a logarithmic number of unions
+    QList<QRegion> regions;
+    regions.reserve(sorted.size());
+    for (const QRect &rect : qAsConst(sorted))
+        regions.append(QRegion(rect));
+    while (regions.size() > 1) {
+        qsizetype united = 0;
+        for (qsizetype i = 0; i + 1 < regions.size(); i += 2)
+            regions[united++] = regions.at(i).united(regions.at(i + 1));
+        if (regions.size() % 2)
+            regions[united++] = regions.constLast();
+        regions.resize(united);
+    }
+    return regions.constFirst();
+}
 
 namespace {
 
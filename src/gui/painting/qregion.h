@@ -111,6 +111,7 @@ public:
 
     QRect boundingRect() const noexcept;
     void setRects(const QRect *rect, int num);
+    [[nodiscard]] static QRegion fromRects(const QRect *rects, qsizetype count);
     int rectCount() const noexcept;
 
     QRegion operator|(const QRegion &r) const;
@@ -0,0 +1,376 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qstrokecache_p.h"
+
+#include <private/qvectorpath_p.h>
+#include <private/qpainter_p.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QStrokeCache
+    \internal
+    \since 6.4
+
+    \brief The QStrokeCache class keeps the results of stroking paths so that
+    drawing the same path with the same pen again does not have to regenerate
+    them.
+
+    The cache is opt-in. It is enabled by giving it a size with
+    setCacheLimit(), or with the \c QT_STROKE_CACHE_SIZE environment variable,
+    both in kilobytes.
+
+    Entries are attached to the QVectorPath that was stroked, which for a
+    QPainterPath lives as long as the path's shared data is left unmodified.
+    The path's identity therefore acts as the key, together with the pen and
+    the scale of the transform (see Key), and modifying or destroying the path
+    releases its entries. Like the fill caches of the OpenGL paint engine, a
+    path is only cached once it has been seen a second time; one-off paths
+    never enter the cache.
+
+    Both QStroker based outlines, which the engine fills afterwards, and the
+    triangle strips of QTriangulatingStroker can be stored. A path keeps at
+    most a few differently stroked variants, and when the total size exceeds
+    the limit, the variants of the least recently used paths are dropped.
+    The cache is shared between all paint engines and threads.
+*/
+
+/*!
+    \class QStrokeCache::Key
+    \internal
+
+    Identifies how a path was stroked: the kind of result, the stroking
+    attributes of the pen and, for results that depend on it, the scale of
+    the transform. Use 0 as the scale when the result is independent of it.
+*/
+
+enum { MaxVariantsPerPath = 4 };
+
+namespace {
+
+struct CachedPath
+{
+    struct Variant {
+        QStrokeCache::Key key;
+        QStrokeCache::Stroke stroke;
+        quint64 lastUse;
+    };
+
+    QList<Variant> variants;
+    qsizetype cost = 0;
+    quint64 lastUse = 0;
+};
+
+struct StrokeCacheData
+{
+    void dropVariants(CachedPath *path)
+    {
+        totalCost -= path->cost;
+        path->cost = 0;
+        path->variants.clear();
+    }
+
+    void trim(qsizetype maxCost)
+    {
+        if (totalCost <= maxCost)
+            return;
+
+        // Trim a bit further than necessary, so that this is not done over
+        // and over again for every new entry once the cache is full.
+        const qsizetype target = maxCost - maxCost / 4;
+        QList<CachedPath *> lru;
+        lru.reserve(paths.size());
+        for (CachedPath *path : qAsConst(paths)) {
+            if (path->cost)
+                lru.append(path);
+        }
+        std::sort(lru.begin(), lru.end(), [](const CachedPath *a, const CachedPath *b) {
+            return a->lastUse < b->lastUse;
+        });
+        for (CachedPath *path : qAsConst(lru)) {
+            if (totalCost <= target)
+                break;
+            dropVariants(path);
+        }
+    }
+
+    QMutex mutex;
+    QSet<CachedPath *> paths;
+    qsizetype totalCost = 0;
+    quint64 useCounter = 0;
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(StrokeCacheData, strokeCache)
+
+static QBasicAtomicInt qt_stroke_cache_limit = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+// The CachedPath entries are owned by the paths they are attached to, and
+// may outlive the cache itself when paths are destroyed late on exit.
+static void qt_cleanup_stroke_cache(QPaintEngineEx *, void *data)
+{
+    CachedPath *path = static_cast<CachedPath *>(data);
+    if (!strokeCache.isDestroyed()) {
+        StrokeCacheData *cache = strokeCache();
+        QMutexLocker locker(&cache->mutex);
+        cache->totalCost -= path->cost;
+        cache->paths.remove(path);
+    }
+    delete path;
+}
+
+QStrokeCache::Key::Key(Kind kind, const QPen &pen, qreal scale)
+    : width(qpen_widthf(pen)),
+      miterLimit(pen.miterLimit()),
+      dashOffset(0),
+      scale(scale),
+      kind(kind),
+      style(qpen_style(pen)),
+      capStyle(qpen_capStyle(pen)),
+      joinStyle(qpen_joinStyle(pen)),
+      cosmetic(pen.isCosmetic())
+{
+    if (style > Qt::SolidLine && style != Qt::NoPen) {
+        dashPattern = pen.dashPattern();
+        dashOffset = pen.dashOffset();
+    }
+}
+
+bool QStrokeCache::Key::operator==(const Key &other) const
+{
+    return kind == other.kind
+        && width == other.width
+        && miterLimit == other.miterLimit
+        && scale == other.scale
+        && style == other.style
+        && capStyle == other.capStyle
+        && joinStyle == other.joinStyle
+        && cosmetic == other.cosmetic
+        && dashOffset == other.dashOffset
+        && dashPattern == other.dashPattern;
+}
+
+qsizetype QStrokeCache::Stroke::cost() const
+{
+    return qsizetype(sizeof(Stroke))
+        + points.size() * qsizetype(sizeof(qreal))
+        + types.size() * qsizetype(sizeof(QPainterPath::ElementType))
+        + vertices.size() * qsizetype(sizeof(float));
+}
+
+/*!
+    Returns the size of the cache in kilobytes. 0, the default unless
+    \c QT_STROKE_CACHE_SIZE is set, means the cache is disabled.
+*/
+int QStrokeCache::cacheLimit()
+{
+    int limit = qt_stroke_cache_limit.loadRelaxed();
+    if (limit < 0) {
+        bool ok = false;
+        int envLimit = qEnvironmentVariableIntValue("QT_STROKE_CACHE_SIZE", &ok);
+        if (!ok || envLimit < 0)
+            envLimit = 0;
+        qt_stroke_cache_limit.testAndSetRelaxed(-1, envLimit);
+        limit = qt_stroke_cache_limit.loadRelaxed();
+    }
+    return limit;
+}
+
+/*!
+    Sets the size of the cache to \a kb kilobytes. 0 disables the cache and
+    drops everything stored in it.
+*/
+void QStrokeCache::setCacheLimit(int kb)
+{
+    kb = qMax(kb, 0);
+    qt_stroke_cache_limit.storeRelaxed(kb);
+
+    StrokeCacheData *cache = strokeCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->trim(qsizetype(kb) * 1024);
+}
+
+/*!
+    Returns \c true if the cache has a non-zero size.
+*/
+bool QStrokeCache::isEnabled()
+{
+    return cacheLimit() > 0;
+}
+
+/*!
+    Looks up the result of stroking \a path as described by \a key. Returns
+    \c true and sets \a stroke if it is in the cache.
+
+    A path that is looked up for the first time is only marked as a candidate
+    for caching, and insert() will ignore it until it is looked up again.
+*/
+bool QStrokeCache::find(const QVectorPath &path, const Key &key, Stroke *stroke)
+{
+    Q_ASSERT(stroke);
+    StrokeCacheData *cache = strokeCache();
+    QMutexLocker locker(&cache->mutex);
+
+    if (!path.isCacheable()) {
+        path.makeCacheable();
+        ++cache->misses;
+        return false;
+    }
+
+    // Entries that do not belong to a specific engine are registered with a
+    // null engine, which keeps them apart from the engines' own fill caches.
+    QVectorPath::CacheEntry *entry = path.lookupCacheData(nullptr);
+    if (!entry) {
+        CachedPath *cachedPath = new CachedPath;
+        path.addCacheData(nullptr, cachedPath, qt_cleanup_stroke_cache);
+        cache->paths.insert(cachedPath);
+        ++cache->misses;
+        return false;
+    }
+
+    CachedPath *cachedPath = static_cast<CachedPath *>(entry->data);
+    for (CachedPath::Variant &variant : cachedPath->variants) {
+        if (variant.key == key) {
+            variant.lastUse = cachedPath->lastUse = ++cache->useCounter;
+            *stroke = variant.stroke;
+            ++cache->hits;
+            return true;
+        }
+    }
+
+    ++cache->misses;
+    return false;
+}
+
+/*!
+    Stores \a stroke as the result of stroking \a path as described by \a key,
+    provided that find() has seen the path before.
+*/
+void QStrokeCache::insert(const QVectorPath &path, const Key &key, const Stroke &stroke)
+{
+    const qsizetype maxCost = qsizetype(cacheLimit()) * 1024;
+    const qsizetype cost = stroke.cost();
+    if (cost > maxCost / 4)
+        return;
+
+    StrokeCacheData *cache = strokeCache();
+    QMutexLocker locker(&cache->mutex);
+
+    if (!path.isCacheable())
+        return;
+    QVectorPath::CacheEntry *entry = path.lookupCacheData(nullptr);
+    if (!entry)
+        return;
+
+    CachedPath *cachedPath = static_cast<CachedPath *>(entry->data);
+    auto &variants = cachedPath->variants;
+    auto it = std::find_if(variants.begin(), variants.end(),
+                           [&key](const CachedPath::Variant &v) { return v.key == key; });
+    if (it == variants.end() && variants.size() >= MaxVariantsPerPath) {
+        it = std::min_element(variants.begin(), variants.end(),
+                              [](const CachedPath::Variant &a, const CachedPath::Variant &b) {
+                                  return a.lastUse < b.lastUse;
+                              });
+    }
+    if (it != variants.end()) {
+        const qsizetype oldCost = it->stroke.cost();
+        cachedPath->cost -= oldCost;
+        cache->totalCost -= oldCost;
+        variants.erase(it);
+    }
+
+    cachedPath->lastUse = ++cache->useCounter;
+    variants.append({ key, stroke, cachedPath->lastUse });
+    cachedPath->cost += cost;
+    cache->totalCost += cost;
+    cache->trim(maxCost);
+}
+
+/*!
+    Drops all cached strokes.
+*/
+void QStrokeCache::clear()
+{
+    StrokeCacheData *cache = strokeCache();
+    QMutexLocker locker(&cache->mutex);
+    for (CachedPath *path : qAsConst(cache->paths))
+        cache->dropVariants(path);
+}
+
+/*!
+    Returns the hit and miss counts since the last resetStatistics(), and the
+    current contents of the cache.
+*/
+QStrokeCache::Statistics QStrokeCache::statistics()
+{
+    StrokeCacheData *cache = strokeCache();
+    QMutexLocker locker(&cache->mutex);
+    Statistics statistics;
+    statistics.hits = cache->hits;
+    statistics.misses = cache->misses;
+    statistics.totalCost = cache->totalCost;
+    for (const CachedPath *path : qAsConst(cache->paths)) {
+        if (path->cost)
+            ++statistics.pathCount;
+    }
+    return statistics;
+}
+
+/*!
+    Resets the hit and miss counts.
+*/
+void QStrokeCache::resetStatistics()
+{
+    StrokeCacheData *cache = strokeCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSTROKECACHE_P_H
+#define QSTROKECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/qpainterpath.h>
+#include <QtGui/qpen.h>
+#include <QtCore/qlist.h>
+
+QT_BEGIN_NAMESPACE
+
+class QVectorPath;
+
+class Q_GUI_EXPORT QStrokeCache
+{
+public:
+    enum Kind : quint8 {
+        Outline,        // QStroker/QDashStroker output, filled by the engine
+        TriangleStrip   // QTriangulatingStroker output
+    };
+
+    struct Key
+    {
+        Key(Kind kind, const QPen &pen, qreal scale);
+
+        bool operator==(const Key &other) const;
+        bool operator!=(const Key &other) const { return !operator==(other); }
+
+        QList<qreal> dashPattern;
+        qreal width;
+        qreal miterLimit;
+        qreal dashOffset;
+        qreal scale;
+        Kind kind;
+        Qt::PenStyle style;
+        Qt::PenCapStyle capStyle;
+        Qt::PenJoinStyle joinStyle;
+        bool cosmetic;
+    };
+
+    struct Stroke
+    {
+        QList<qreal> points;                    // Outline
+        QList<QPainterPath::ElementType> types; // Outline
+        QList<float> vertices;                  // TriangleStrip
+        uint flags = 0;                         // QVectorPath hints of the outline
+
+        qsizetype cost() const;
+    };
+
+    struct Statistics {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        qsizetype pathCount = 0;
+        qsizetype totalCost = 0; // in bytes
+    };
+
+    static int cacheLimit();
+    static void setCacheLimit(int kb);
+    static bool isEnabled();
+
+    static bool find(const QVectorPath &path, const Key &key, Stroke *stroke);
+    static void insert(const QVectorPath &path, const Key &key, const Stroke &stroke);
+    static void clear();
+
+    static Statistics statistics();
+    static void resetStatistics();
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTROKECACHE_P_H
@@ -49,6 +49,7 @@
 #include <qnumeric.h>
 
 #include <private/qbezier_p.h>
+#include <private/qsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -97,6 +98,116 @@ static void nanWarning(const char *func)
         }                                                               \
     } while (0)
 
+#if !defined(QT_COORD_TYPE) && (defined(__SSE2__) || (defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)))
+#  define QT_TRANSFORM_MAP_SIMD
+#endif
+
+#ifdef QT_TRANSFORM_MAP_SIMD
+// The two coordinates of a point, in one register
+#  if defined(__SSE2__)
+using QCoordinatePair = __m128d;
+static inline QCoordinatePair loadPair(const qreal *p) { return _mm_loadu_pd(p); }
+static inline void storePair(qreal *p, QCoordinatePair v) { _mm_storeu_pd(p, v); }
+static inline QCoordinatePair makePair(qreal x, qreal y) { return _mm_setr_pd(x, y); }
+static inline QCoordinatePair addPair(QCoordinatePair a, QCoordinatePair b) { return _mm_add_pd(a, b); }
+static inline QCoordinatePair mulPair(QCoordinatePair a, QCoordinatePair b) { return _mm_mul_pd(a, b); }
+static inline QCoordinatePair splatX(QCoordinatePair v) { return _mm_unpacklo_pd(v, v); }
+static inline QCoordinatePair splatY(QCoordinatePair v) { return _mm_unpackhi_pd(v, v); }
+#  else
+using QCoordinatePair = float64x2_t;
+static inline QCoordinatePair loadPair(const qreal *p) { return vld1q_f64(p); }
+static inline void storePair(qreal *p, QCoordinatePair v) { vst1q_f64(p, v); }
+static inline QCoordinatePair makePair(qreal x, qreal y) { return vcombine_f64(vdup_n_f64(x), vdup_n_f64(y)); }
+static inline QCoordinatePair addPair(QCoordinatePair a, QCoordinatePair b) { return vaddq_f64(a, b); }
+static inline QCoordinatePair mulPair(QCoordinatePair a, QCoordinatePair b) { return vmulq_f64(a, b); }
+static inline QCoordinatePair splatX(QCoordinatePair v) { return vdupq_laneq_f64(v, 0); }
+static inline QCoordinatePair splatY(QCoordinatePair v) { return vdupq_laneq_f64(v, 1); }
+#  endif
+#endif // QT_TRANSFORM_MAP_SIMD
+
+/*
+    Maps \a count points whose x coordinate is followed by their y
+    coordinate. Consecutive points are \a inStride and \a outStride qreals
+    apart, so that both QPointF arrays and QPainterPath elements can be
+    mapped. Mapping in place is allowed. Projective transformations are
+    applied like map(const QPointF &) does, without any clipping.
+*/
+static void mapPoints(const QTransform &transform, const qreal *in, qsizetype inStride,
+                      qreal *out, qsizetype outStride, qsizetype count)
+{
+    const qreal m11 = transform.m11(), m12 = transform.m12(), m13 = transform.m13();
+    const qreal m21 = transform.m21(), m22 = transform.m22(), m23 = transform.m23();
+    const qreal dx = transform.dx(), dy = transform.dy(), m33 = transform.m33();
+
+    switch (transform.type()) {
+    case QTransform::TxNone:
+        if (in == out && inStride == outStride)
+            break;
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride) {
+            out[0] = in[0];
+            out[1] = in[1];
+        }
+        break;
+    case QTransform::TxTranslate: {
+#ifdef QT_TRANSFORM_MAP_SIMD
+        const QCoordinatePair translate = makePair(dx, dy);
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride)
+            storePair(out, addPair(loadPair(in), translate));
+#else
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride) {
+            out[0] = in[0] + dx;
+            out[1] = in[1] + dy;
+        }
+#endif
+        break;
+    }
+    case QTransform::TxScale: {
+#ifdef QT_TRANSFORM_MAP_SIMD
+        const QCoordinatePair scale = makePair(m11, m22);
+        const QCoordinatePair translate = makePair(dx, dy);
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride)
+            storePair(out, addPair(mulPair(loadPair(in), scale), translate));
+#else
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride) {
+            out[0] = m11 * in[0] + dx;
+            out[1] = m22 * in[1] + dy;
+        }
+#endif
+        break;
+    }
+    case QTransform::TxRotate:
+    case QTransform::TxShear: {
+#ifdef QT_TRANSFORM_MAP_SIMD
+        const QCoordinatePair xColumn = makePair(m11, m12);
+        const QCoordinatePair yColumn = makePair(m21, m22);
+        const QCoordinatePair translate = makePair(dx, dy);
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride) {
+            const QCoordinatePair p = loadPair(in);
+            storePair(out, addPair(addPair(mulPair(splatX(p), xColumn),
+                                           mulPair(splatY(p), yColumn)), translate));
+        }
+#else
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride) {
+            const qreal fx = in[0];
+            const qreal fy = in[1];
+            out[0] = m11 * fx + m21 * fy + dx;
+            out[1] = m12 * fx + m22 * fy + dy;
+        }
+#endif
+        break;
+    }
+    case QTransform::TxProject:
+        for (qsizetype i = 0; i < count; ++i, in += inStride, out += outStride) {
+            const qreal fx = in[0];
+            const qreal fy = in[1];
+            const qreal w = 1./(m13 * fx + m23 * fy + m33);
+            out[0] = (m11 * fx + m21 * fy + dx) * w;
+            out[1] = (m12 * fx + m22 * fy + dy) * w;
+        }
+        break;
+    }
+}
+
 /*!
     \class QTransform
     \brief The QTransform class specifies 2D transformations of a coordinate system.
@@ -1404,15 +1515,8 @@ QPolygonF QTransform::map(const QPolygonF &a) const
     if (t >= QTransform::TxProject)
         return mapProjective(*this, a);
 
-    int size = a.size();
-    int i;
-    QPolygonF p(size);
-    const QPointF *da = a.constData();
-    QPointF *dp = p.data();
-
-    for(i = 0; i < size; ++i) {
-        MAP(da[i].xp, da[i].yp, dp[i].xp, dp[i].yp);
-    }
+    QPolygonF p(a.size());
+    map(a.constData(), p.data(), a.size());
     return p;
 }
 
@@ -1661,10 +1765,10 @@ QPainterPath QTransform::map(const QPainterPath &path) const
     } else {
         copy.detach();
         // Full xform
-        for (int i=0; i<path.elementCount(); ++i) {
-            QPainterPath::Element &e = copy.d_ptr->elements[i];
-            MAP(e.x, e.y, e.x, e.y);
-        }
+        static_assert(sizeof(QPainterPath::Element) % sizeof(qreal) == 0);
+        constexpr qsizetype stride = sizeof(QPainterPath::Element) / sizeof(qreal);
+        qreal *elements = &copy.d_ptr->elements[0].x;
+        mapPoints(*this, elements, stride, elements, stride, path.elementCount());
     }
 
     return copy;
@@ -2022,6 +2126,28 @@ void QTransform::map(qreal x, qreal y, qreal *tx, qreal *ty) const
     MAP(x, y, *tx, *ty);
 }
 
+/*!
+    \overload
+    \since 6.4
+
+    Maps the \a count points starting at \a points into the coordinate
+    system defined by this matrix, and writes them to \a result. Each
+    point is mapped in the same way as map(const QPointF &) maps it.
+
+    \a points and \a result may be the same array, for mapping the
+    points in place, but must not overlap otherwise.
+
+    This is considerably faster than mapping the points one at a time, and
+    is what map(const QPolygonF &) and map(const QPainterPath &) use.
+*/
+void QTransform::map(const QPointF *points, QPointF *result, qsizetype count) const
+{
+    if (count <= 0)
+        return;
+    static_assert(sizeof(QPointF) == 2 * sizeof(qreal));
+    mapPoints(*this, &points->xp, 2, &result->xp, 2, count);
+}
+
 /*!
     \overload
 
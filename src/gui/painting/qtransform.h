@@ -151,6 +151,7 @@ public:
     QRectF mapRect(const QRectF &) const;
     void map(int x, int y, int *tx, int *ty) const;
     void map(qreal x, qreal y, qreal *tx, qreal *ty) const;
+    void map(const QPointF *points, QPointF *result, qsizetype count) const;
 
     QTransform &operator*=(qreal div);
     QTransform &operator/=(qreal div);
@@ -40,6 +40,12 @@
 #include "qrhi_p_p.h"
 #include <qmath.h>
 #include <QLoggingCategory>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 #include "qrhinull_p_p.h"
 #ifndef QT_NO_OPENGL
@@ -477,6 +483,15 @@ Q_LOGGING_CATEGORY(QRHI_LOG_INFO, "qt.rhi.general")
     disk-based caching mechanisms for shader binaries. Writing to those may get
     disabled whenever this flag is set since storing program binaries (OpenGL)
     to multiple caches is not sensible.
+
+    \value EnablePersistentPipelineCache Implies EnablePipelineCacheDataSave,
+    and in addition makes QRhi itself load the pipeline cache from disk in
+    create() and save it when the QRhi is destroyed. The file is stored in
+    QStandardPaths::CacheLocation, and is specific to the backend, the device
+    and the Qt version. Data from a different driver version is rejected by
+    setPipelineCacheData(), and is then replaced when saving. The file is
+    written atomically and is not written when the data is larger than 32 MB.
+    This flag was introduced in Qt 6.4.
  */
 
 /*!
@@ -5276,10 +5291,59 @@ QRhi::~QRhi()
 
     runCleanup();
 
+    d->savePersistentPipelineCache();
+
     d->destroy();
     delete d;
 }
 
+static const qint64 persistentPipelineCacheMaxSize = 32 * 1024 * 1024;
+
+void QRhiImplementation::loadPersistentPipelineCache()
+{
+    if (!q->isFeatureSupported(QRhi::PipelineCacheDataLoadSave))
+        return;
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cacheDir.isEmpty())
+        return;
+
+    const QRhiDriverInfo info = driverInfo();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayView(q->backendName()));
+    hash.addData(info.deviceName);
+    hash.addData(QByteArray(QByteArray::number(info.vendorId) + ':' + QByteArray::number(info.deviceId)));
+    hash.addData(QByteArrayView(QT_VERSION_STR));
+    persistentPipelineCacheFile = cacheDir + QLatin1String("/qtpipelinecache/")
+            + QString::fromLatin1(hash.result().toHex());
+
+    QFile f(persistentPipelineCacheFile);
+    if (!f.open(QIODevice::ReadOnly) || f.size() > persistentPipelineCacheMaxSize)
+        return;
+    const QByteArray data = f.readAll();
+    if (!data.isEmpty()) {
+        qCDebug(QRHI_LOG_INFO, "Loading %d bytes of pipeline cache data from %s",
+                int(data.size()), qPrintable(persistentPipelineCacheFile));
+        setPipelineCacheData(data);
+    }
+}
+
+void QRhiImplementation::savePersistentPipelineCache()
+{
+    if (persistentPipelineCacheFile.isEmpty())
+        return;
+    const QByteArray data = pipelineCacheData();
+    if (data.isEmpty() || data.size() > persistentPipelineCacheMaxSize)
+        return;
+    if (!QDir().mkpath(QFileInfo(persistentPipelineCacheFile).absolutePath()))
+        return;
+    QSaveFile f(persistentPipelineCacheFile);
+    if (!f.open(QIODevice::WriteOnly) || f.write(data) != data.size()) {
+        qWarning("Failed to write pipeline cache data to %s", qPrintable(persistentPipelineCacheFile));
+        return;
+    }
+    f.commit();
+}
+
 /*!
     \return a new QRhi instance with a backend for the graphics API specified
     by \a impl with the specified \a flags.
@@ -5347,9 +5411,14 @@ QRhi *QRhi::create(Implementation impl, QRhiInitParams *params, Flags flags, QRh
 
         r->d->debugMarkers = flags.testFlag(EnableDebugMarkers);
 
+        if (flags.testFlag(EnablePersistentPipelineCache))
+            flags |= EnablePipelineCacheDataSave;
+
         if (r->d->create(flags)) {
             r->d->implType = impl;
             r->d->implThread = QThread::currentThread();
+            if (flags.testFlag(EnablePersistentPipelineCache))
+                r->d->loadPersistentPipelineCache();
             return r.take();
         }
     }
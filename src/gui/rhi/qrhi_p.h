@@ -1632,7 +1632,8 @@ public:
         EnableProfiling = 1 << 0,
         EnableDebugMarkers = 1 << 1,
         PreferSoftwareRenderer = 1 << 2,
-        EnablePipelineCacheDataSave = 1 << 3
+        EnablePipelineCacheDataSave = 1 << 3,
+        EnablePersistentPipelineCache = 1 << 4
     };
     Q_DECLARE_FLAGS(Flags, Flag)
 
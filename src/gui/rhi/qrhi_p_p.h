@@ -172,6 +172,8 @@ public:
 
     virtual QByteArray pipelineCacheData() = 0;
     virtual void setPipelineCacheData(const QByteArray &data) = 0;
+    void loadPersistentPipelineCache();
+    void savePersistentPipelineCache();
 
     bool isCompressedFormat(QRhiTexture::Format format) const;
     void compressedFormatInfo(QRhiTexture::Format format, const QSize &size,
@@ -240,6 +242,7 @@ public:
     static const int MAX_SHADER_CACHE_ENTRIES = 128;
 
     bool debugMarkers = false;
+    QString persistentPipelineCacheFile;
     int currentFrameSlot = 0; // for vk, mtl, and similar. unused by gl and d3d11.
     bool inFrame = false;
 
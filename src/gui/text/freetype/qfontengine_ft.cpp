@@ -48,6 +48,7 @@
 #include <qscreen.h>
 #include <qpa/qplatformscreen.h>
 #include <QtCore/QUuid>
+#include <QtCore/qcache.h>
 #include <QtGui/QPainterPath>
 
 #ifndef QT_NO_FREETYPE
@@ -85,6 +86,10 @@
 #  define QT_MAX_CACHED_GLYPH_SIZE 64
 #endif
 
+#if !defined(QT_MAX_SHARED_GLYPH_CACHE_COST)
+#  define QT_MAX_SHARED_GLYPH_CACHE_COST (4 * 1024 * 1024)
+#endif
+
 QT_BEGIN_NAMESPACE
 
 #define FLOOR(x)    ((x) & -64)
@@ -109,6 +114,104 @@ static bool ft_getSfntTable(void *user_data, uint tag, uchar *buffer, uint *leng
 
 static QFontEngineFT::Glyph emptyGlyph;
 
+// Rendered glyphs shared by all font engines, so that engines using the same face at the
+// same size, transformation and rendering options only rasterize each glyph once.
+struct QFreetypeSharedGlyphKey
+{
+    QFontEngine::FaceId faceId;
+    FT_Fixed xScale = 0;
+    FT_Fixed yScale = 0;
+    FT_Matrix matrix = { 0x10000, 0, 0, 0x10000 };
+    FT_Vector subPixelPosition = { 0, 0 };
+    int loadFlags = 0;
+    int format = 0;
+    int lcdFilterType = 0;
+    int subpixelType = 0;
+    bool embolden = false;
+    bool obliquen = false;
+    glyph_t glyph = 0;
+
+    bool operator==(const QFreetypeSharedGlyphKey &other) const
+    {
+        return glyph == other.glyph && xScale == other.xScale && yScale == other.yScale
+            && matrix.xx == other.matrix.xx && matrix.xy == other.matrix.xy
+            && matrix.yx == other.matrix.yx && matrix.yy == other.matrix.yy
+            && subPixelPosition.x == other.subPixelPosition.x
+            && subPixelPosition.y == other.subPixelPosition.y
+            && loadFlags == other.loadFlags && format == other.format
+            && lcdFilterType == other.lcdFilterType && subpixelType == other.subpixelType
+            && embolden == other.embolden && obliquen == other.obliquen
+            && faceId == other.faceId;
+    }
+};
+
+static size_t qHash(const QFreetypeSharedGlyphKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.faceId, key.glyph, key.xScale, key.yScale,
+                      key.matrix.xx, key.matrix.xy, key.matrix.yx, key.matrix.yy,
+                      key.subPixelPosition.x, key.subPixelPosition.y, key.loadFlags, key.format);
+}
+
+class QFreetypeSharedGlyphCache
+{
+public:
+    QFreetypeSharedGlyphCache() : glyphs(QT_MAX_SHARED_GLYPH_CACHE_COST) { }
+
+    QFontEngineFT::Glyph *copyGlyph(const QFreetypeSharedGlyphKey &key, QFontEngineFT::Glyph *g);
+    void insert(const QFreetypeSharedGlyphKey &key, const QFontEngineFT::Glyph *g, qsizetype dataSize);
+
+private:
+    struct SharedGlyph {
+        short linearAdvance;
+        unsigned short width;
+        unsigned short height;
+        short x;
+        short y;
+        short advance;
+        signed char format;
+        QByteArray data;
+    };
+
+    QMutex mutex;
+    QCache<QFreetypeSharedGlyphKey, SharedGlyph> glyphs;
+};
+
+Q_GLOBAL_STATIC(QFreetypeSharedGlyphCache, sharedGlyphCache)
+
+// Copies the cached rendering of key into g, allocating g if needed, or returns nullptr
+QFontEngineFT::Glyph *QFreetypeSharedGlyphCache::copyGlyph(const QFreetypeSharedGlyphKey &key,
+                                                           QFontEngineFT::Glyph *g)
+{
+    QMutexLocker locker(&mutex);
+    const SharedGlyph *shared = glyphs.object(key);
+    if (!shared)
+        return nullptr;
+
+    if (!g)
+        g = new QFontEngineFT::Glyph;
+    g->linearAdvance = shared->linearAdvance;
+    g->width = shared->width;
+    g->height = shared->height;
+    g->x = shared->x;
+    g->y = shared->y;
+    g->advance = shared->advance;
+    g->format = shared->format;
+    delete [] g->data;
+    g->data = new uchar[shared->data.size()];
+    memcpy(g->data, shared->data.constData(), shared->data.size());
+    return g;
+}
+
+void QFreetypeSharedGlyphCache::insert(const QFreetypeSharedGlyphKey &key,
+                                       const QFontEngineFT::Glyph *g, qsizetype dataSize)
+{
+    auto shared = new SharedGlyph { g->linearAdvance, g->width, g->height, g->x, g->y, g->advance,
+                                    g->format, QByteArray(reinterpret_cast<const char *>(g->data), dataSize) };
+    QMutexLocker locker(&mutex);
+    // Accounts for the bookkeeping as well, so empty glyphs are not free
+    glyphs.insert(key, shared, dataSize + qsizetype(sizeof(SharedGlyph)));
+}
+
 static const QFontEngine::HintStyle ftInitialDefaultHintStyle =
 #ifdef Q_OS_WIN
     QFontEngineFT::HintFull;
@@ -986,6 +1089,30 @@ QFontEngineFT::Glyph *QFontEngineFT::loadGlyph(QGlyphSet *set, uint glyph,
     if (transform || obliquen || (format != Format_Mono && !isScalableBitmap()))
         load_flags |= FT_LOAD_NO_BITMAP;
 
+    // Another engine may already have rendered this glyph the same way
+    const bool renderShared = set && !fetchMetricsOnly
+                              && !(set->outline_drawing && !disableOutlineDrawing)
+                              && QT_MAX_SHARED_GLYPH_CACHE_COST > 0;
+    QFreetypeSharedGlyphKey sharedKey;
+    if (renderShared) {
+        sharedKey.faceId = face_id;
+        sharedKey.xScale = face->size->metrics.x_scale;
+        sharedKey.yScale = face->size->metrics.y_scale;
+        sharedKey.matrix = matrix;
+        sharedKey.subPixelPosition = v;
+        sharedKey.loadFlags = load_flags;
+        sharedKey.format = format;
+        sharedKey.lcdFilterType = lcdFilterType;
+        sharedKey.subpixelType = subpixelType;
+        sharedKey.embolden = embolden;
+        sharedKey.obliquen = obliquen;
+        sharedKey.glyph = glyph;
+        if (Glyph *shared = sharedGlyphCache()->copyGlyph(sharedKey, g)) {
+            set->setGlyph(glyph, subPixelPosition, shared);
+            return shared;
+        }
+    }
+
     FT_Error err = FT_Load_Glyph(face, glyph, load_flags);
     if (err && (load_flags & FT_LOAD_NO_BITMAP)) {
         load_flags &= ~FT_LOAD_NO_BITMAP;
@@ -1203,6 +1330,9 @@ QFontEngineFT::Glyph *QFontEngineFT::loadGlyph(QGlyphSet *set, uint glyph,
     delete [] g->data;
     g->data = glyph_buffer.take();
 
+    if (renderShared)
+        sharedGlyphCache()->insert(sharedKey, g, glyph_buffer_size);
+
     if (set)
         set->setGlyph(glyph, subPixelPosition, g);
 
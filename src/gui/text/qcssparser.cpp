@@ -1924,6 +1924,17 @@ quint64 Selector::pseudoClass(quint64 *negated) const
 
 ///////////////////////////////////////////////////////////////////////////////
 // StyleSheet
+static const AttributeSelector *classSelector(const BasicSelector &sel)
+{
+    for (const AttributeSelector &a : sel.attributeSelectors) {
+        if (a.valueMatchCriterium == AttributeSelector::MatchIncludes
+            && a.name == QLatin1String("class") && !a.value.isEmpty()) {
+            return &a;
+        }
+    }
+    return nullptr;
+}
+
 void StyleSheet::buildIndexes(Qt::CaseSensitivity nameCaseSensitivity)
 {
     QList<StyleRule> universals;
@@ -1960,6 +1971,12 @@ void StyleSheet::buildIndexes(Qt::CaseSensitivity nameCaseSensitivity)
                 if (nameCaseSensitivity == Qt::CaseInsensitive)
                     name = std::move(name).toLower();
                 nameIndex.insert(name, nr);
+            } else if (const AttributeSelector *cls = classSelector(sel)) {
+                StyleRule nr;
+                nr.selectors += selector;
+                nr.declarations = rule.declarations;
+                nr.order = i;
+                classIndex.insert(cls->value, nr);
             } else {
                 universalsSelectors += selector;
             }
@@ -2178,6 +2195,23 @@ QList<StyleRule> StyleSelector::styleRulesForNode(NodePtr node)
                 }
             }
         }
+        if (!styleSheet.classIndex.isEmpty()) {
+            AttributeSelector classAttr;
+            classAttr.name = QLatin1String("class");
+            const QString classes = attributeValue(node, classAttr);
+            QStringList seen;
+            for (auto token : QStringView{classes}.tokenize(u' ', Qt::SkipEmptyParts)) {
+                const QString key = token.toString();
+                if (seen.contains(key))
+                    continue;
+                seen.append(key);
+                QMultiHash<QString, StyleRule>::const_iterator it = styleSheet.classIndex.constFind(key);
+                while (it != styleSheet.classIndex.constEnd() && it.key() == key) {
+                    matchRule(node, it.value(), styleSheet.origin, styleSheet.depth, &weightedRules);
+                    ++it;
+                }
+            }
+        }
         if (!medium.isEmpty()) {
             for (int i = 0; i < styleSheet.mediaRules.count(); ++i) {
                 if (styleSheet.mediaRules.at(i).media.contains(medium, Qt::CaseInsensitive)) {
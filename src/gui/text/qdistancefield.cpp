@@ -42,6 +42,22 @@
 #include <private/qdatabuffer_p.h>
 #include <private/qimage_p.h>
 #include <private/qpathsimplifier_p.h>
+#include <private/qrawfont_p.h>
+#include <private/qsimd_p.h>
+#include <private/qvectorpath_p.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <algorithm>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -488,12 +504,46 @@ static void drawPolygons(qint32 *bits, int width, int height, const QPoint *vert
     }
 }
 
-static void makeDistanceField(QDistanceFieldData *data, const QPainterPath &path, int dfScale, int offs)
+static void convertDistanceField(uchar *outLine, const qint32 *inLine, int count)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i outside = _mm_set1_epi32(0x7f80);
+    const __m128i mask = _mm_set1_epi32(0xff);
+    for (; i < count - 15; i += 16) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inLine + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inLine + i + 4));
+        __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inLine + i + 8));
+        __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inLine + i + 12));
+        // Masking keeps the packs below from saturating, matching the uchar cast
+        v0 = _mm_and_si128(_mm_srai_epi32(_mm_sub_epi32(outside, v0), 8), mask);
+        v1 = _mm_and_si128(_mm_srai_epi32(_mm_sub_epi32(outside, v1), 8), mask);
+        v2 = _mm_and_si128(_mm_srai_epi32(_mm_sub_epi32(outside, v2), 8), mask);
+        v3 = _mm_and_si128(_mm_srai_epi32(_mm_sub_epi32(outside, v3), 8), mask);
+        const __m128i lo = _mm_packs_epi32(v0, v1);
+        const __m128i hi = _mm_packs_epi32(v2, v3);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(outLine + i), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(__ARM_NEON__)
+    const int32x4_t outside = vdupq_n_s32(0x7f80);
+    for (; i < count - 7; i += 8) {
+        const int32x4_t v0 = vshrq_n_s32(vsubq_s32(outside, vld1q_s32(inLine + i)), 8);
+        const int32x4_t v1 = vshrq_n_s32(vsubq_s32(outside, vld1q_s32(inLine + i + 4)), 8);
+        // The narrowing moves truncate, like the uchar cast
+        const int16x8_t v = vcombine_s16(vmovn_s32(v0), vmovn_s32(v1));
+        vst1_u8(outLine + i, vreinterpret_u8_s8(vmovn_s16(v)));
+    }
+#endif
+    for (; i < count; ++i)
+        outLine[i] = uchar((0x7f80 - inLine[i]) >> 8);
+}
+
+static void makeDistanceField(QDistanceFieldData *data, const QVectorPath &path, int dfScale, int offs)
 {
     if (!data || !data->data)
         return;
 
-    if (path.isEmpty()) {
+    if (path.elementCount() == 0) {
         memset(data->data, 0, data->nbytes);
         return;
     }
@@ -513,8 +563,7 @@ static void makeDistanceField(QDistanceFieldData *data, const QPainterPath &path
     const qint32 exteriorColor = 0x7f80; // 8:8 signed format, 127.5
 
     QScopedArrayPointer<qint32> bits(new qint32[imgWidth * imgHeight]);
-    for (int i = 0; i < imgWidth * imgHeight; ++i)
-        bits[i] = exteriorColor;
+    std::fill_n(bits.data(), imgWidth * imgHeight, exteriorColor);
 
     const qreal angleStep = qDegreesToRadians(qreal(15));
     const QPoint rotation(qRound(qCos(angleStep) * 0x4000),
@@ -687,12 +736,7 @@ static void makeDistanceField(QDistanceFieldData *data, const QPainterPath &path
         index = end + 1;
     }
 
-    const qint32 *inLine = bits.data();
-    uchar *outLine = data->data;
-    for (int y = 0; y < imgHeight; ++y) {
-        for (int x = 0; x < imgWidth; ++x, ++inLine, ++outLine)
-            *outLine = uchar((0x7f80 - *inLine) >> 8);
-    }
+    convertDistanceField(data->data, bits.data(), imgWidth * imgHeight);
 }
 
 static bool imageHasNarrowOutlines(const QImage &im)
@@ -873,18 +917,21 @@ QDistanceFieldData *QDistanceFieldData::create(const QSize &size)
     return data;
 }
 
+static QSize distanceFieldSize(const QPainterPath &path, int dfScale, int dfMargin)
+{
+    const QRectF bounds = path.boundingRect();
+    return QSize(qCeil(bounds.width() / dfScale) + dfMargin * 2,
+                 qCeil(bounds.height() / dfScale) + dfMargin * 2);
+}
+
 QDistanceFieldData *QDistanceFieldData::create(const QPainterPath &path, bool doubleResolution)
 {
-    int dfMargin = QT_DISTANCEFIELD_RADIUS(doubleResolution) / QT_DISTANCEFIELD_SCALE(doubleResolution);
-    int glyphWidth = qCeil(path.boundingRect().width() / QT_DISTANCEFIELD_SCALE(doubleResolution)) + dfMargin * 2;
-    int glyphHeight = qCeil(path.boundingRect().height() / QT_DISTANCEFIELD_SCALE(doubleResolution)) + dfMargin * 2;
+    const int dfScale = QT_DISTANCEFIELD_SCALE(doubleResolution);
+    const int dfMargin = QT_DISTANCEFIELD_RADIUS(doubleResolution) / dfScale;
 
-    QDistanceFieldData *data = create(QSize(glyphWidth, glyphHeight));
+    QDistanceFieldData *data = create(distanceFieldSize(path, dfScale, dfMargin));
 
-    makeDistanceField(data,
-                      path,
-                      QT_DISTANCEFIELD_SCALE(doubleResolution),
-                      QT_DISTANCEFIELD_RADIUS(doubleResolution) / QT_DISTANCEFIELD_SCALE(doubleResolution));
+    makeDistanceField(data, qtVectorPathForPath(path), dfScale, dfMargin);
     return data;
 }
 
@@ -1098,5 +1145,281 @@ QImage QDistanceField::toImage(QImage::Format format) const
     return image;
 }
 
+namespace {
+struct DistanceFieldCacheDirectory
+{
+    DistanceFieldCacheDirectory()
+        : path(qEnvironmentVariable("QT_DISTANCEFIELD_CACHE_DIR"))
+    {
+    }
+
+    QMutex mutex;
+    QString path;
+};
+}
+
+Q_GLOBAL_STATIC(DistanceFieldCacheDirectory, distanceFieldCacheDirectory)
+
+static const char distanceFieldCacheMagic[4] = { 'Q', 'D', 'F', '1' };
+
+// Returns the directory holding the cached distance fields of the glyphs of
+// fontEngine, or an empty string if they cannot be cached.
+static QString distanceFieldCachePath(QFontEngine *fontEngine, bool doubleResolution)
+{
+    const QString cacheDirectory = QDistanceField::cacheDirectory();
+    if (cacheDirectory.isEmpty())
+        return QString();
+
+    // Fonts loaded from memory get a new uuid every time, so only fonts that
+    // are backed by a file can be found again
+    const QFontEngine::FaceId faceId = fontEngine->faceId();
+    if (faceId.filename.isEmpty())
+        return QString();
+
+    // The file's size and modification time catch fonts that are updated in place
+    const QFileInfo fileInfo(QFile::decodeName(faceId.filename));
+    const qint64 parameters[] = {
+        faceId.index,
+        fileInfo.size(),
+        fileInfo.lastModified().toMSecsSinceEpoch(),
+        qRound64(fontEngine->fontDef.pixelSize * 64),
+        fontEngine->synthesized(),
+        QT_DISTANCEFIELD_SCALE(doubleResolution),
+        QT_DISTANCEFIELD_RADIUS(doubleResolution)
+    };
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(faceId.filename);
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(parameters), sizeof(parameters)));
+    return cacheDirectory + QLatin1Char('/') + QLatin1String(hash.result().toHex());
+}
+
+static inline QString distanceFieldCacheFile(const QString &cachePath, glyph_t glyph)
+{
+    return cachePath + QLatin1Char('/') + QString::number(glyph) + QLatin1String(".df");
+}
+
+static QDistanceFieldData *loadCachedDistanceField(const QString &cachePath, glyph_t glyph)
+{
+    QFile file(distanceFieldCacheFile(cachePath, glyph));
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    char magic[sizeof(distanceFieldCacheMagic)];
+    quint32 size[2];
+    if (file.read(magic, sizeof(magic)) != qint64(sizeof(magic))
+            || memcmp(magic, distanceFieldCacheMagic, sizeof(magic)) != 0
+            || file.read(reinterpret_cast<char *>(size), sizeof(size)) != qint64(sizeof(size))
+            || size[0] > 0xffff || size[1] > 0xffff) {
+        return nullptr;
+    }
+
+    QDistanceFieldData *data = QDistanceFieldData::create(QSize(int(size[0]), int(size[1])));
+    if (!data->data || file.read(reinterpret_cast<char *>(data->data), data->nbytes) != data->nbytes) {
+        delete data;
+        return nullptr;
+    }
+    data->glyph = glyph;
+    return data;
+}
+
+static void storeCachedDistanceField(const QString &cachePath, const QDistanceFieldData *data)
+{
+    QSaveFile file(distanceFieldCacheFile(cachePath, data->glyph));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    const quint32 size[2] = { quint32(data->width), quint32(data->height) };
+    file.write(distanceFieldCacheMagic, sizeof(distanceFieldCacheMagic));
+    file.write(reinterpret_cast<const char *>(size), sizeof(size));
+    file.write(reinterpret_cast<const char *>(data->data), data->nbytes);
+    if (!file.commit())
+        qCWarning(lcDistanceField) << "Failed to write" << file.fileName() << file.errorString();
+}
+
+/*!
+    \internal
+    \since 6.4
+
+    Returns the distance fields of \a glyphs of \a fontEngine, in the same
+    order. The glyph outlines are taken at the size of \a fontEngine, like
+    setGlyph() does.
+
+    The outlines are extracted on the calling thread, since font engines are
+    not reentrant, while the distance fields themselves are generated
+    concurrently on the global QThreadPool. When a cacheDirectory() is set and
+    the font is loaded from a file, the results are also stored there and read
+    back instead of being generated again.
+*/
+QList<QDistanceField> QDistanceField::create(QFontEngine *fontEngine, const QList<glyph_t> &glyphs,
+                                             bool doubleResolution)
+{
+    QList<QDistanceField> fields(glyphs.size());
+    if (!fontEngine)
+        return fields;
+
+    const QString cachePath = distanceFieldCachePath(fontEngine, doubleResolution);
+
+    QList<qsizetype> indexes;
+    QList<QPainterPath> paths;
+    for (qsizetype i = 0; i < glyphs.size(); ++i) {
+        glyph_t glyph = glyphs.at(i);
+        if (!cachePath.isEmpty()) {
+            if (QDistanceFieldData *data = loadCachedDistanceField(cachePath, glyph)) {
+                fields[i] = QDistanceField(data);
+                continue;
+            }
+        }
+
+        QFixedPoint position;
+        QPainterPath path;
+        fontEngine->addGlyphsToPath(&glyph, &position, 1, &path, { });
+        indexes.append(i);
+        paths.append(path);
+    }
+
+    if (!paths.isEmpty() && !cachePath.isEmpty() && !QDir().mkpath(cachePath)) {
+        qCWarning(lcDistanceField) << "Failed to create" << cachePath;
+        generate(fields.data(), indexes, paths, glyphs, doubleResolution, QString());
+    } else {
+        generate(fields.data(), indexes, paths, glyphs, doubleResolution, cachePath);
+    }
+    return fields;
+}
+
+/*!
+    \internal
+    \since 6.4
+
+    Returns the distance fields of \a glyphs of \a font, in the same order, as
+    setGlyph() would generate them one by one.
+
+    \sa create(QFontEngine *, const QList<glyph_t> &, bool)
+*/
+QList<QDistanceField> QDistanceField::create(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                             bool doubleResolution)
+{
+    QRawFont renderFont = font;
+    renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * QT_DISTANCEFIELD_SCALE(doubleResolution));
+    if (!renderFont.isValid())
+        return QList<QDistanceField>(glyphs.size());
+
+    return create(QRawFontPrivate::get(renderFont)->fontEngine, glyphs, doubleResolution);
+}
+
+/*!
+    \internal
+    \since 6.4
+
+    Returns the distance fields of \a paths, tagged with the corresponding
+    entries of \a glyphs. The distance fields are generated concurrently, but
+    never cached on disk.
+*/
+QList<QDistanceField> QDistanceField::create(const QList<QPainterPath> &paths, const QList<glyph_t> &glyphs,
+                                             bool doubleResolution)
+{
+    Q_ASSERT(paths.size() == glyphs.size());
+
+    QList<QDistanceField> fields(paths.size());
+    QList<qsizetype> indexes(paths.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+    generate(fields.data(), indexes, paths, glyphs, doubleResolution, QString());
+    return fields;
+}
+
+/*!
+    \internal
+
+    Generates the distance field of each of \a paths into \a fields at the
+    corresponding entry of \a indexes, and stores it in \a cachePath unless
+    that is empty.
+*/
+void QDistanceField::generate(QDistanceField *fields, const QList<qsizetype> &indexes,
+                              QList<QPainterPath> paths, const QList<glyph_t> &glyphs,
+                              bool doubleResolution, const QString &cachePath)
+{
+    const qsizetype count = paths.size();
+    if (!count)
+        return;
+
+    const int dfScale = QT_DISTANCEFIELD_SCALE(doubleResolution);
+    const int dfMargin = QT_DISTANCEFIELD_RADIUS(doubleResolution) / dfScale;
+
+    // Everything that touches the lazily computed parts of the paths happens
+    // here, so that the workers below only ever read them.
+    QVarLengthArray<QDistanceFieldData *> results(count);
+    QVarLengthArray<const QVectorPath *> vectorPaths(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        QPainterPath &path = paths[i];
+        path.translate(-path.boundingRect().topLeft());
+        path.setFillRule(Qt::WindingFill);
+
+        const qsizetype index = indexes.at(i);
+        QDistanceFieldData *data = QDistanceFieldData::create(distanceFieldSize(path, dfScale, dfMargin));
+        data->glyph = glyphs.at(index);
+        fields[index] = QDistanceField(data);
+        results[i] = data;
+        vectorPaths[i] = &qtVectorPathForPath(path);
+    }
+
+    auto generateOne = [&](qsizetype i) {
+        makeDistanceField(results[i], *vectorPaths[i], dfScale, dfMargin);
+        if (!cachePath.isEmpty() && results[i]->data)
+            storeCachedDistanceField(cachePath, results[i]);
+    };
+
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const int tasks = int(qMin<qsizetype>(count, threadPool->maxThreadCount()));
+    if (tasks > 1 && !threadPool->contains(QThread::currentThread())) {
+        QAtomicInteger<qsizetype> next(0);
+        QSemaphore semaphore;
+        for (int i = 0; i < tasks; ++i) {
+            threadPool->start([&]() {
+                for (qsizetype j = next.fetchAndAddRelaxed(1); j < count;
+                     j = next.fetchAndAddRelaxed(1)) {
+                    generateOne(j);
+                }
+                semaphore.release(1);
+            });
+        }
+        semaphore.acquire(tasks);
+        return;
+    }
+#endif
+
+    for (qsizetype i = 0; i < count; ++i)
+        generateOne(i);
+}
+
+/*!
+    \internal
+    \since 6.4
+
+    Returns the directory in which create() keeps the distance fields of
+    file-backed fonts, or an empty string if they are not kept. It defaults to
+    the value of the \c QT_DISTANCEFIELD_CACHE_DIR environment variable.
+*/
+QString QDistanceField::cacheDirectory()
+{
+    DistanceFieldCacheDirectory *cacheDirectory = distanceFieldCacheDirectory();
+    QMutexLocker locker(&cacheDirectory->mutex);
+    return cacheDirectory->path;
+}
+
+/*!
+    \internal
+    \since 6.4
+
+    Sets the directory in which create() keeps distance fields to \a path. An
+    empty \a path disables the cache.
+*/
+void QDistanceField::setCacheDirectory(const QString &path)
+{
+    DistanceFieldCacheDirectory *cacheDirectory = distanceFieldCacheDirectory();
+    QMutexLocker locker(&cacheDirectory->mutex);
+    cacheDirectory->path = path;
+}
+
 QT_END_NAMESPACE
 
@@ -118,8 +118,21 @@ public:
 
     QImage toImage(QImage::Format format = QImage::Format_ARGB32_Premultiplied) const;
 
+    static QList<QDistanceField> create(QFontEngine *fontEngine, const QList<glyph_t> &glyphs,
+                                        bool doubleResolution = false);
+    static QList<QDistanceField> create(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                        bool doubleResolution = false);
+    static QList<QDistanceField> create(const QList<QPainterPath> &paths, const QList<glyph_t> &glyphs,
+                                        bool doubleResolution = false);
+
+    static QString cacheDirectory();
+    static void setCacheDirectory(const QString &path);
+
 private:
     QDistanceField(QDistanceFieldData *data);
+    static void generate(QDistanceField *fields, const QList<qsizetype> &indexes,
+                         QList<QPainterPath> paths, const QList<glyph_t> &glyphs,
+                         bool doubleResolution, const QString &cachePath);
     QSharedDataPointer<QDistanceFieldData> d;
 
     friend class QDistanceFieldData;
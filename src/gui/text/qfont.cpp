@@ -2900,6 +2900,10 @@ QFontCache::~QFontCache()
 
 void QFontCache::clear()
 {
+    // shaping results hold references to the engines below
+    if (m_shapingCache)
+        m_shapingCache->clear();
+
     {
         EngineDataCache::Iterator it = engineDataCache.begin(),
                                  end = engineDataCache.end();
@@ -2958,6 +2962,13 @@ void QFontCache::clear()
 }
 
 
+QTextShapingCache *QFontCache::shapingCache()
+{
+    if (!m_shapingCache)
+        m_shapingCache.reset(new QTextShapingCache);
+    return m_shapingCache.data();
+}
+
 QFontEngineData *QFontCache::findEngineData(const QFontDef &def) const
 {
     EngineDataCache::ConstIterator it = engineDataCache.constFind(def);
@@ -56,6 +56,7 @@
 #include "QtCore/qmap.h"
 #include "QtCore/qhash.h"
 #include "QtCore/qobject.h"
+#include "QtCore/qscopedpointer.h"
 #include "QtCore/qstringlist.h"
 #include <QtGui/qfontdatabase.h>
 #include "private/qfixed_p.h"
@@ -65,6 +66,7 @@ QT_BEGIN_NAMESPACE
 // forwards
 class QFontCache;
 class QFontEngine;
+class QTextShapingCache;
 
 #define QFONT_WEIGHT_MIN 1
 #define QFONT_WEIGHT_MAX 1000
@@ -285,6 +287,9 @@ public:
     void updateHitCountAndTimeStamp(Engine &value);
     void insertEngine(const Key &key, QFontEngine *engine, bool insertMulti = false);
 
+    // shaped text cache, see QTextEngine::shapeText()
+    QTextShapingCache *shapingCache();
+
 private:
     void increaseCost(uint cost);
     void decreaseCost(uint cost);
@@ -298,6 +303,7 @@ private:
     const bool autoClean;
     int timer_id;
     const int m_id;
+    QScopedPointer<QTextShapingCache> m_shapingCache;
 };
 
 Q_GUI_EXPORT int qt_defaultDpiX();
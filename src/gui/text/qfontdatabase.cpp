@@ -51,6 +51,7 @@
 #include <qpa/qplatformintegration.h>
 
 #include <QtGui/private/qguiapplication_p.h>
+#include <QtCore/private/qstartuptimeline_p.h>
 #include <qpa/qplatformfontdatabase.h>
 #include <qpa/qplatformtheme.h>
 
@@ -718,6 +719,7 @@ static void initializeDb()
 
     // init by asking for the platformfontdb for the first time or after invalidation
     if (!db->count) {
+        QStartupTimelineScope timelineScope("QPlatformFontDatabase::populateFontDatabase");
         QGuiApplicationPrivate::platformIntegration()->fontDatabase()->populateFontDatabase();
         for (int i = 0; i < db->applicationFonts.count(); i++) {
             if (!db->applicationFonts.at(i).properties.isEmpty())
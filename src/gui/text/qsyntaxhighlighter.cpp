@@ -49,6 +49,7 @@
 #include <qtextobject.h>
 #include <qtextcursor.h>
 #include <qdebug.h>
+#include <qdeadlinetimer.h>
 #include <qtimer.h>
 
 #include <algorithm>
@@ -67,7 +68,10 @@ public:
 
     void _q_reformatBlocks(int from, int charsRemoved, int charsAdded);
     void reformatBlocks(int from, int charsRemoved, int charsAdded);
+    QTextBlock highlightBlocks(QTextBlock block, int endPosition, int syncEndPosition);
     void reformatBlock(const QTextBlock &block);
+    void deferHighlighting(const QTextBlock &block, int endPosition);
+    void _q_continueHighlighting();
 
     inline void rehighlight(QTextCursor &cursor, QTextCursor::MoveOperation operation)
     {
@@ -83,6 +87,11 @@ public:
         if (!rehighlightPending)
             return;
         rehighlightPending = false;
+        if (timeSlice > 0 && !doc->isEmpty()) {
+            deferHighlighting(doc->begin(), QTextDocumentPrivate::get(doc)->length());
+            _q_continueHighlighting();
+            return;
+        }
         q_func()->rehighlight();
     }
 
@@ -91,6 +100,13 @@ public:
     QTextBlock currentBlock;
     bool rehighlightPending;
     bool inReformatBlocks;
+
+    // time sliced highlighting: the blocks from pendingFrom's up to and
+    // including pendingTo's still need to be highlighted
+    int timeSlice = 0;
+    QDeadlineTimer deadline;
+    QTextCursor pendingFrom;
+    QTextCursor pendingTo;
 };
 
 void QSyntaxHighlighterPrivate::applyFormatChanges()
@@ -171,9 +187,29 @@ void QSyntaxHighlighterPrivate::reformatBlocks(int from, int charsRemoved, int c
     else
         endPosition = QTextDocumentPrivate::get(doc)->length();
 
+    deadline = timeSlice > 0 ? QDeadlineTimer(timeSlice) : QDeadlineTimer(QDeadlineTimer::Forever);
+    const QTextBlock rest = highlightBlocks(block, endPosition, endPosition);
+    if (rest.isValid())
+        deferHighlighting(rest, endPosition);
+
+    formatChanges.clear();
+}
+
+/*
+    Highlights the blocks from \a block on that start before \a endPosition,
+    and then the following ones for as long as their previous block's state
+    changed. Once the blocks before \a syncEndPosition are done, it stops when
+    the deadline has expired and returns the first block left to highlight.
+*/
+QTextBlock QSyntaxHighlighterPrivate::highlightBlocks(QTextBlock block, int endPosition,
+                                                      int syncEndPosition)
+{
     bool forceHighlightOfNextBlock = false;
 
     while (block.isValid() && (block.position() < endPosition || forceHighlightOfNextBlock)) {
+        if (block.position() >= syncEndPosition && deadline.hasExpired())
+            return block;
+
         const int stateBeforeHighlight = block.userState();
 
         reformatBlock(block);
@@ -183,7 +219,54 @@ void QSyntaxHighlighterPrivate::reformatBlocks(int from, int charsRemoved, int c
         block = block.next();
     }
 
+    return QTextBlock();
+}
+
+/*
+    Remembers that the blocks from \a block on still need to be highlighted,
+    at least up to \a endPosition, and schedules the next time slice. The
+    block states act as checkpoints: the previous block's state is all that
+    is needed to pick up at \a block.
+*/
+void QSyntaxHighlighterPrivate::deferHighlighting(const QTextBlock &block, int endPosition)
+{
+    Q_Q(QSyntaxHighlighter);
+    const QTextBlock lastBlock = doc->findBlock(endPosition - 1);
+    const int to = qMax(block.position(), lastBlock.isValid() ? lastBlock.position() : 0);
+
+    if (pendingFrom.isNull()) {
+        pendingFrom = QTextCursor(doc);
+        pendingFrom.setPosition(block.position());
+        pendingTo = QTextCursor(doc);
+        pendingTo.setPosition(to);
+        QTimer::singleShot(0, q, SLOT(_q_continueHighlighting()));
+    } else {
+        pendingFrom.setPosition(qMin(pendingFrom.position(), block.position()));
+        pendingTo.setPosition(qMax(pendingTo.position(), to));
+    }
+}
+
+void QSyntaxHighlighterPrivate::_q_continueHighlighting()
+{
+    if (!doc || pendingFrom.isNull())
+        return;
+
+    const QTextBlock block = pendingFrom.block();
+    const QTextBlock lastBlock = pendingTo.block();
+    const int endPosition = qMax(block.position(), lastBlock.position()) + 1;
+    pendingFrom = QTextCursor();
+    pendingTo = QTextCursor();
+
+    QScopedValueRollback<bool> bg(inReformatBlocks, true);
+    QTextCursor cursor(doc);
+    cursor.beginEditBlock();
+    deadline = timeSlice > 0 ? QDeadlineTimer(timeSlice) : QDeadlineTimer(QDeadlineTimer::Forever);
+    // always make progress, even if the slice is used up by the first block
+    const QTextBlock rest = highlightBlocks(block, endPosition, block.position() + 1);
+    if (rest.isValid())
+        deferHighlighting(rest, endPosition);
     formatChanges.clear();
+    cursor.endEditBlock();
 }
 
 void QSyntaxHighlighterPrivate::reformatBlock(const QTextBlock &block)
@@ -337,6 +420,8 @@ void QSyntaxHighlighter::setDocument(QTextDocument *doc)
             blk.layout()->clearFormats();
         cursor.endEditBlock();
     }
+    d->pendingFrom = QTextCursor();
+    d->pendingTo = QTextCursor();
     d->doc = doc;
     if (d->doc) {
         connect(d->doc, SIGNAL(contentsChange(int,int,int)),
@@ -358,6 +443,47 @@ QTextDocument *QSyntaxHighlighter::document() const
     return d->doc;
 }
 
+/*!
+    \since 6.4
+
+    Sets the time slice for highlighting to \a msecs milliseconds.
+
+    By default, the time slice is 0 and the highlighting is always brought
+    up to date synchronously. When a change in a block alters its block state,
+    this can cascade through the rest of the document, and highlighting a
+    large document for the first time can take a long time as well.
+
+    With a positive time slice, only the changed blocks are highlighted right
+    away. The blocks that follow them, and the document as a whole once it has
+    been set, are highlighted in portions of about \a msecs milliseconds that
+    are processed whenever the event loop is idle. Each portion picks up where
+    the previous one stopped, using the block state of the last highlighted
+    block. Call rehighlightBlock() to bring a block that is about to be shown
+    up to date first.
+
+    rehighlight() always highlights the whole document synchronously.
+
+    \sa highlightingTimeSlice()
+*/
+void QSyntaxHighlighter::setHighlightingTimeSlice(int msecs)
+{
+    Q_D(QSyntaxHighlighter);
+    d->timeSlice = qMax(0, msecs);
+}
+
+/*!
+    \since 6.4
+
+    Returns the time slice for highlighting in milliseconds.
+
+    \sa setHighlightingTimeSlice()
+*/
+int QSyntaxHighlighter::highlightingTimeSlice() const
+{
+    Q_D(const QSyntaxHighlighter);
+    return d->timeSlice;
+}
+
 /*!
     \since 4.2
 
@@ -372,7 +498,12 @@ void QSyntaxHighlighter::rehighlight()
         return;
 
     QTextCursor cursor(d->doc);
-    d->rehighlight(cursor, QTextCursor::End);
+    {
+        QScopedValueRollback<int> fullPass(d->timeSlice, 0);
+        d->rehighlight(cursor, QTextCursor::End);
+    }
+    d->pendingFrom = QTextCursor();
+    d->pendingTo = QTextCursor();
     d->rehighlightPending = false; // user manually did a full rehighlight
 }
 
@@ -381,7 +512,10 @@ void QSyntaxHighlighter::rehighlight()
 
     Reapplies the highlighting to the given QTextBlock \a block.
 
-    \sa rehighlight()
+    If a highlighting time slice is set and the block state of \a block
+    changes, the blocks following it are highlighted later.
+
+    \sa rehighlight(), setHighlightingTimeSlice()
 */
 void QSyntaxHighlighter::rehighlightBlock(const QTextBlock &block)
 {
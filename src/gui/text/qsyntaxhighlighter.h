@@ -69,6 +69,9 @@ public:
     void setDocument(QTextDocument *doc);
     QTextDocument *document() const;
 
+    void setHighlightingTimeSlice(int msecs);
+    int highlightingTimeSlice() const;
+
 public Q_SLOTS:
     void rehighlight();
     void rehighlightBlock(const QTextBlock &block);
@@ -94,6 +97,7 @@ private:
     Q_DISABLE_COPY(QSyntaxHighlighter)
     Q_PRIVATE_SLOT(d_func(), void _q_reformatBlocks(int from, int charsRemoved, int charsAdded))
     Q_PRIVATE_SLOT(d_func(), void _q_delayedRehighlight())
+    Q_PRIVATE_SLOT(d_func(), void _q_continueHighlighting())
 };
 
 QT_END_NAMESPACE
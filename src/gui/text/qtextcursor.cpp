@@ -1461,6 +1461,23 @@ void QTextCursor::insertText(const QString &text, const QTextCharFormat &_format
 
         int textStart = d->priv->text.length();
         int blockStart = 0;
+        if (text.length() >= textStart) {
+            // Every block separator appends one more character to the text
+            // buffer. When loading large multi-line texts (setPlainText on a
+            // big file), reserve for all of them up front so that the buffer
+            // is allocated once instead of being grown and copied again while
+            // the blocks are inserted. Only done when the buffer at least
+            // doubles, so that repeated small inserts keep amortized growth.
+            qsizetype separators = 0;
+            for (const QChar ch : text) {
+                if (ch == QLatin1Char('\n') || ch == QLatin1Char('\r')
+                    || ch == QChar::ParagraphSeparator
+                    || ch == QTextBeginningOfFrame || ch == QTextEndOfFrame)
+                    ++separators;
+            }
+            if (separators)
+                d->priv->text.reserve(textStart + text.length() + separators);
+        }
         d->priv->text += text;
         int textEnd = d->priv->text.length();
 
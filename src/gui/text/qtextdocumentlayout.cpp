@@ -57,6 +57,7 @@
 #include <qvarlengtharray.h>
 #include <limits.h>
 #include <qbasictimer.h>
+#include <qelapsedtimer.h>
 #include "private/qfunctions_p.h"
 #include <qloggingcategory.h>
 
@@ -594,6 +595,7 @@ public:
     inline void ensureLayoutFinished() const
     { ensureLayoutedByPosition(INT_MAX); }
     void layoutStep() const;
+    void backgroundLayoutStep() const;
 
     QRectF frameBoundingRectInternal(QTextFrame *frame) const;
 
@@ -4034,6 +4036,25 @@ void QTextDocumentLayoutPrivate::layoutStep() const
     lazyLayoutStepSize = qMin(200000, lazyLayoutStepSize * 2);
 }
 
+// Target duration of a layout step run from the layout timer, in milliseconds
+static const int lazyLayoutStepTime = 10;
+
+// Lays out the next part of the document from the layout timer. Instead of
+// growing the step size unconditionally, it follows the time the previous step
+// took, so that documents with expensive blocks (long lines, complex scripts)
+// don't block the event loop for more than a few frames at a time.
+void QTextDocumentLayoutPrivate::backgroundLayoutStep() const
+{
+    QElapsedTimer timer;
+    timer.start();
+    ensureLayoutedByPosition(currentLazyLayoutPosition + lazyLayoutStepSize);
+    const qint64 elapsed = timer.elapsed();
+    if (elapsed < lazyLayoutStepTime / 2)
+        lazyLayoutStepSize = qMin(200000, lazyLayoutStepSize * 2);
+    else if (elapsed > lazyLayoutStepTime)
+        lazyLayoutStepSize = qMax(1000, lazyLayoutStepSize / 2);
+}
+
 void QTextDocumentLayout::setCursorWidth(int width)
 {
     Q_D(QTextDocumentLayout);
@@ -4164,7 +4185,7 @@ void QTextDocumentLayout::timerEvent(QTimerEvent *e)
     Q_D(QTextDocumentLayout);
     if (e->timerId() == d->layoutTimer.timerId()) {
         if (d->currentLazyLayoutPosition != -1)
-            d->layoutStep();
+            d->backgroundLayoutStep();
     } else if (e->timerId() == d->sizeChangedTimer.timerId()) {
         d->lastReportedSize = dynamicDocumentSize();
         emit documentSizeChanged(d->lastReportedSize);
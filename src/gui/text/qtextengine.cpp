@@ -1518,7 +1518,31 @@ void QTextEngine::shapeText(int item) const
 
 #if QT_CONFIG(harfbuzz)
     if (Q_LIKELY(shapingEnabled && qt_useHarfbuzzNG())) {
-        si.num_glyphs = shapeTextWithHarfbuzzNG(si, string, itemLength, fontEngine, itemBoundaries, kerningEnabled, letterSpacing != 0);
+        // the same strings tend to be laid out over and over, e.g. by item views
+        QTextShapingCache *shapingCache = QFontCache::instance()->shapingCache();
+        const bool useShapingCache = shapingCache->maxCost() > 0;
+        QTextShapingCache::Key shapingKey;
+        if (useShapingCache) {
+            shapingKey.text = QString(reinterpret_cast<const QChar *>(string), itemLength);
+            shapingKey.fontEngine = fontEngine;
+            shapingKey.script = si.analysis.script;
+            shapingKey.rightToLeft = si.analysis.bidiLevel % 2;
+            shapingKey.kerningEnabled = kerningEnabled;
+            shapingKey.hasLetterSpacing = letterSpacing != 0;
+            shapingKey.designMetrics = option.useDesignMetrics();
+            const QTextShapingCache::ShapedText *shaped = shapingCache->find(shapingKey);
+            if (shaped && Q_LIKELY(ensureSpace(shaped->numGlyphs))) {
+                QGlyphLayout g = availableGlyphs(&si);
+                shaped->copyTo(&g, logClusters(&si));
+                si.num_glyphs = shaped->numGlyphs;
+            }
+        }
+
+        if (!si.num_glyphs) {
+            si.num_glyphs = shapeTextWithHarfbuzzNG(si, string, itemLength, fontEngine, itemBoundaries, kerningEnabled, letterSpacing != 0);
+            if (useShapingCache && si.num_glyphs)
+                shapingCache->insert(shapingKey, availableGlyphs(&si).mid(0, si.num_glyphs), logClusters(&si));
+        }
     } else
 #endif
     {
@@ -1772,6 +1796,98 @@ int QTextEngine::shapeTextWithHarfbuzzNG(const QScriptItem &si,
 
 #endif // harfbuzz
 
+#ifndef QT_TEXT_SHAPING_CACHE_MAX_COST
+#  define QT_TEXT_SHAPING_CACHE_MAX_COST 512*1024 // 512kb
+#endif
+
+/*!
+    \internal
+    \class QTextShapingCache
+    \since 6.4
+
+    Keeps the shaped glyphs of recently laid out text items, so that laying
+    out the same text with the same font engine and shaping options again
+    does not have to go through HarfBuzz. The cache is per thread and owned
+    by QFontCache, and every entry keeps a reference to its font engine so
+    that a new engine can never be mistaken for a deleted one.
+
+    The maximum cost is counted in bytes. It can be set with the
+    \c QT_TEXT_SHAPING_CACHE_SIZE environment variable, in kilobytes,
+    where 0 disables the cache. hits() and misses() count lookups since the
+    last call to resetStatistics().
+*/
+QTextShapingCache::QTextShapingCache()
+    : cache(QT_TEXT_SHAPING_CACHE_MAX_COST)
+{
+    bool ok = false;
+    const int size = qEnvironmentVariableIntValue("QT_TEXT_SHAPING_CACHE_SIZE", &ok);
+    if (ok && size >= 0)
+        cache.setMaxCost(qsizetype(size) * 1024);
+}
+
+QTextShapingCache::~QTextShapingCache()
+{
+    clear();
+}
+
+QTextShapingCache::ShapedText::ShapedText(QFontEngine *engine, const QGlyphLayout &glyphs,
+                                          const ushort *clusters, int textLength)
+    : fontEngine(engine),
+      numGlyphs(glyphs.numGlyphs),
+      glyphData(glyphs.numGlyphs * int(QGlyphLayout::SpaceNeeded), Qt::Uninitialized),
+      logClusters(clusters, clusters + textLength)
+{
+    fontEngine->ref.ref();
+
+    QGlyphLayout copy(glyphData.data(), numGlyphs);
+    memcpy(copy.glyphs, glyphs.glyphs, numGlyphs * sizeof(glyph_t));
+    memcpy(static_cast<void *>(copy.advances), glyphs.advances, numGlyphs * sizeof(QFixed));
+    memcpy(static_cast<void *>(copy.offsets), glyphs.offsets, numGlyphs * sizeof(QFixedPoint));
+    memcpy(copy.attributes, glyphs.attributes, numGlyphs * sizeof(QGlyphAttributes));
+}
+
+QTextShapingCache::ShapedText::~ShapedText()
+{
+    if (!fontEngine->ref.deref())
+        delete fontEngine;
+}
+
+void QTextShapingCache::ShapedText::copyTo(QGlyphLayout *glyphs, ushort *clusters) const
+{
+    Q_ASSERT(glyphs->numGlyphs >= numGlyphs);
+    QGlyphLayout source(const_cast<char *>(glyphData.constData()), numGlyphs);
+    memcpy(glyphs->glyphs, source.glyphs, numGlyphs * sizeof(glyph_t));
+    memcpy(static_cast<void *>(glyphs->advances), source.advances, numGlyphs * sizeof(QFixed));
+    memcpy(static_cast<void *>(glyphs->offsets), source.offsets, numGlyphs * sizeof(QFixedPoint));
+    memcpy(glyphs->attributes, source.attributes, numGlyphs * sizeof(QGlyphAttributes));
+    memcpy(clusters, logClusters.constData(), logClusters.size() * sizeof(ushort));
+}
+
+const QTextShapingCache::ShapedText *QTextShapingCache::find(const Key &key)
+{
+    const ShapedText *shaped = cache.object(key);
+    if (shaped)
+        ++hitCount;
+    else
+        ++missCount;
+    return shaped;
+}
+
+void QTextShapingCache::insert(const Key &key, const QGlyphLayout &glyphs, const ushort *logClusters)
+{
+    const int textLength = key.text.size();
+    const qsizetype cost = qsizetype(sizeof(ShapedText)) + textLength * qsizetype(sizeof(QChar) + sizeof(ushort))
+            + glyphs.numGlyphs * qsizetype(QGlyphLayout::SpaceNeeded);
+    if (cost > cache.maxCost())
+        return;
+    cache.insert(key, new ShapedText(key.fontEngine, glyphs, logClusters, textLength), cost);
+}
+
+void QTextShapingCache::clear()
+{
+    cache.clear();
+}
+
 void QTextEngine::init(QTextEngine *e)
 {
     e->ignoreBidi = false;
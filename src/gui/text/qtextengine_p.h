@@ -58,6 +58,7 @@
 #include "QtGui/qtextoption.h"
 #include "QtGui/qtextlayout.h"
 
+#include "QtCore/qcache.h"
 #include "QtCore/qdebug.h"
 #include "QtCore/qlist.h"
 #include "QtCore/qnamespace.h"
@@ -675,6 +676,70 @@ public:
 };
 Q_DECLARE_TYPEINFO(QTextEngine::ItemDecoration, Q_RELOCATABLE_TYPE);
 
+class Q_GUI_EXPORT QTextShapingCache
+{
+public:
+    struct Key {
+        QString text;
+        QFontEngine *fontEngine = nullptr;
+        uint script = 0;
+        bool rightToLeft = false;
+        bool kerningEnabled = false;
+        bool hasLetterSpacing = false;
+        bool designMetrics = false;
+
+        bool operator==(const Key &other) const
+        {
+            return fontEngine == other.fontEngine && script == other.script
+                && rightToLeft == other.rightToLeft && kerningEnabled == other.kerningEnabled
+                && hasLetterSpacing == other.hasLetterSpacing
+                && designMetrics == other.designMetrics && text == other.text;
+        }
+    };
+
+    struct ShapedText {
+        explicit ShapedText(QFontEngine *engine, const QGlyphLayout &glyphs,
+                            const ushort *logClusters, int textLength);
+        ~ShapedText();
+        Q_DISABLE_COPY_MOVE(ShapedText)
+
+        void copyTo(QGlyphLayout *glyphs, ushort *logClusters) const;
+
+        QFontEngine *fontEngine;
+        int numGlyphs;
+        QByteArray glyphData;
+        QVarLengthArray<ushort, 32> logClusters;
+    };
+
+    QTextShapingCache();
+    ~QTextShapingCache();
+
+    const ShapedText *find(const Key &key);
+    void insert(const Key &key, const QGlyphLayout &glyphs, const ushort *logClusters);
+    void clear();
+
+    qsizetype maxCost() const { return cache.maxCost(); }
+    void setMaxCost(qsizetype cost) { cache.setMaxCost(cost); }
+    qsizetype totalCost() const { return cache.totalCost(); }
+
+    quint64 hits() const { return hitCount; }
+    quint64 misses() const { return missCount; }
+    void resetStatistics() { hitCount = missCount = 0; }
+
+private:
+    Q_DISABLE_COPY_MOVE(QTextShapingCache)
+
+    QCache<Key, ShapedText> cache;
+    quint64 hitCount = 0;
+    quint64 missCount = 0;
+};
+
+inline size_t qHash(const QTextShapingCache::Key &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.text, key.fontEngine, key.script, key.rightToLeft,
+                      key.kerningEnabled, key.hasLetterSpacing, key.designMetrics);
+}
+
 struct QTextLineItemIterator
 {
     QTextLineItemIterator(QTextEngine *eng, int lineNum, const QPointF &pos = QPointF(),
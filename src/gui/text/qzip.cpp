@@ -47,9 +47,16 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qhash.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
 #include <zlib.h>
 
+#include <limits>
+
 // Zip standard version for archives handled by this API
 // (actually, the only basic support of this version is implemented but it is enough for now)
 #define ZIP_VERSION 20
@@ -416,6 +423,13 @@ struct FileHeader
 };
 Q_DECLARE_TYPEINFO(FileHeader, Q_RELOCATABLE_TYPE);
 
+static QString decodeFileName(const FileHeader &header)
+{
+    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
+    const bool inUtf8 = (readUShort(header.h.general_purpose_bits) & Utf8Names) != 0;
+    return inUtf8 ? QString::fromUtf8(header.file_name) : QString::fromLocal8Bit(header.file_name);
+}
+
 class QZipPrivate
 {
 public:
@@ -487,10 +501,7 @@ QZipReader::FileInfo QZipPrivate::fillFileInfo(int index) const
         return fileInfo; // we don't support anything else
     }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
-    const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
-    fileInfo.filePath = inUtf8 ? QString::fromUtf8(header.file_name) : QString::fromLocal8Bit(header.file_name);
+    fileInfo.filePath = decodeFileName(header);
     fileInfo.crc = readUInt(header.h.crc_32);
     fileInfo.size = readUInt(header.h.uncompressed_size);
     fileInfo.lastModified = readMSDosDate(header.h.last_mod_file);
@@ -515,9 +526,19 @@ public:
     {
     }
 
+    ~QZipReaderPrivate() { unmap(); }
+
     void scanFiles();
+    void unmap();
+    int indexOf(const QString &fileName);
+    bool entryData(int index, QByteArray *buffer, QByteArrayView *data, int *compressionMethod);
 
     QZipReader::Status status;
+    // the central directory, by name as stored in the archive
+    QHash<QString, int> fileIndex;
+    // the whole archive, if it is a file that could be mapped
+    const uchar *mapped = nullptr;
+    qint64 mappedSize = 0;
 };
 
 class QZipWriterPrivate : public QZipPrivate
@@ -537,7 +558,28 @@ public:
 
     enum EntryType { Directory, File, Symlink };
 
+    struct Entry
+    {
+        FileHeader header;
+        QByteArray contents;
+        QByteArray data; // as stored in the archive
+        bool compress;
+    };
+
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    static void compressEntry(Entry &entry);
+    void writeEntry(Entry &entry);
+
+#if QT_CONFIG(thread)
+    void writePendingEntries();
+
+    // entries are compressed in batches of this much uncompressed data
+    static constexpr qsizetype MaxPendingSize = 64 * 1024 * 1024;
+
+    QThreadPool *threadPool = nullptr;
+    QList<Entry> pendingEntries;
+    qsizetype pendingSize = 0;
+#endif
 };
 
 static LocalFileHeader toLocalHeader(const CentralFileHeader &ch)
@@ -572,6 +614,19 @@ void QZipReaderPrivate::scanFiles()
     }
 
     dirtyFileTree = false;
+    fileHeaders.clear();
+    fileIndex.clear();
+    unmap();
+    if (QFileDevice *file = qobject_cast<QFileDevice *>(device)) {
+        // entries are then read straight from the mapping, without a copy
+        // through the device's buffers
+        const qint64 size = file->size();
+        if (size > 0 && qint64(qsizetype(size)) == size)
+            mapped = file->map(0, size);
+        if (mapped)
+            mappedSize = size;
+    }
+
     uchar tmp[4];
     device->read((char *)tmp, 4);
     if (readUInt(tmp) != 0x04034b50) {
@@ -641,10 +696,155 @@ void QZipReaderPrivate::scanFiles()
         }
 
         ZDEBUG("found file '%s'", header.file_name.data());
+        const QString fileName = decodeFileName(header);
+        // the first of several entries with the same name wins
+        if (!fileIndex.contains(fileName))
+            fileIndex.insert(fileName, fileHeaders.size());
         fileHeaders.append(header);
     }
 }
 
+void QZipReaderPrivate::unmap()
+{
+    if (mapped)
+        static_cast<QFileDevice *>(device)->unmap(const_cast<uchar *>(mapped));
+    mapped = nullptr;
+    mappedSize = 0;
+}
+
+int QZipReaderPrivate::indexOf(const QString &fileName)
+{
+    scanFiles();
+    return fileIndex.value(fileName, -1);
+}
+
+/*
+    Locates the stored, possibly compressed, data of the entry at \a index. If
+    the archive is mapped, \a data points into the mapping; otherwise the data
+    is read into \a buffer. Returns \c false if the entry cannot be extracted.
+*/
+bool QZipReaderPrivate::entryData(int index, QByteArray *buffer, QByteArrayView *data,
+                                  int *compressionMethod)
+{
+    const FileHeader &header = fileHeaders.at(index);
+
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return false;
+    }
+
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    const qint64 compressed_size = readUInt(header.h.compressed_size);
+    const qint64 start = readUInt(header.h.offset_local_header);
+    //qDebug("uncompressing file %d: local header at %d", index, start);
+
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+
+    LocalFileHeader lh;
+    if (mapped) {
+        if (start + qint64(sizeof(LocalFileHeader)) > mappedSize) {
+            qWarning("QZip: Local file header out of bounds");
+            return false;
+        }
+        memcpy(&lh, mapped + start, sizeof(LocalFileHeader));
+        const qint64 offset = start + qint64(sizeof(LocalFileHeader))
+                + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+        if (offset + compressed_size > mappedSize) {
+            qWarning("QZip: File data out of bounds");
+            return false;
+        }
+        *data = QByteArrayView(mapped + offset, qsizetype(compressed_size));
+    } else {
+        device->seek(start);
+        device->read((char *)&lh, sizeof(LocalFileHeader));
+        uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+        device->seek(device->pos() + skip);
+        //qDebug("file at %lld", device->pos());
+        *buffer = device->read(compressed_size);
+        *data = *buffer;
+    }
+    *compressionMethod = readUShort(lh.compression_method);
+    return true;
+}
+
+namespace {
+class QZipEntryDevice : public QIODevice
+{
+public:
+    QZipEntryDevice(const QByteArray &buffer, QByteArrayView data, bool deflated, qint64 size)
+        : buffer(buffer), data(data), uncompressedSize(size), deflated(deflated)
+    {
+        if (deflated) {
+            memset(&stream, 0, sizeof(stream));
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                atEnd = true;
+            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+            stream.avail_in = uInt(data.size());
+        }
+    }
+
+    ~QZipEntryDevice()
+    {
+        if (deflated)
+            inflateEnd(&stream);
+    }
+
+    bool isSequential() const override { return true; }
+
+    qint64 bytesAvailable() const override
+    {
+        return QIODevice::bytesAvailable() + (atEnd ? 0 : uncompressedSize - produced);
+    }
+
+protected:
+    qint64 readData(char *out, qint64 maxlen) override
+    {
+        if (atEnd)
+            return -1;
+        qint64 read;
+        if (!deflated) {
+            read = qMin(maxlen, qint64(data.size()) - produced);
+            memcpy(out, data.data() + produced, size_t(read));
+        } else {
+            stream.next_out = reinterpret_cast<Bytef *>(out);
+            stream.avail_out = uInt(qMin(maxlen, qint64(std::numeric_limits<uInt>::max())));
+            const uInt available = stream.avail_out;
+            const int res = ::inflate(&stream, Z_NO_FLUSH);
+            read = available - stream.avail_out;
+            if (res == Z_STREAM_END) {
+                atEnd = read == 0;
+            } else if (res != Z_OK && res != Z_BUF_ERROR) {
+                qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+                atEnd = true;
+                setErrorString(QString::fromLatin1(stream.msg ? stream.msg : "Corrupt data"));
+                return read ? read : -1;
+            }
+        }
+        produced += read;
+        if (read == 0) {
+            atEnd = true;
+            return -1;
+        }
+        return read;
+    }
+
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray buffer;
+    QByteArrayView data;
+    z_stream stream;
+    qint64 produced = 0;
+    qint64 uncompressedSize;
+    bool deflated;
+    bool atEnd = false;
+};
+} // unnamed namespace
+
 void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
 {
 #ifndef NDEBUG
@@ -659,55 +859,19 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         status = QZipWriter::FileOpenError;
         return;
     }
-    device->seek(start_of_directory);
 
+    Entry entry;
+    entry.contents = contents;
     // don't compress small files
-    QZipWriter::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == QZipWriter::AutoCompress) {
-        if (contents.length() < 64)
-            compression = QZipWriter::NeverCompress;
-        else
-            compression = QZipWriter::AlwaysCompress;
-    }
+    entry.compress = compressionPolicy == QZipWriter::AlwaysCompress
+            || (compressionPolicy == QZipWriter::AutoCompress && contents.length() >= 64);
 
-    FileHeader header;
+    FileHeader &header = entry.header;
     memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, contents.length());
     writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == QZipWriter::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-       ulong len = contents.length();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.length());
-    uint crc_32 = ::crc32(0, nullptr, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
-    writeUInt(header.h.crc_32, crc_32);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -745,19 +909,110 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
         break;
     }
     writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
 
+#if QT_CONFIG(thread)
+    if (threadPool) {
+        pendingSize += contents.size();
+        pendingEntries.append(std::move(entry));
+        if (pendingSize >= MaxPendingSize)
+            writePendingEntries();
+        return;
+    }
+#endif
+    compressEntry(entry);
+    writeEntry(entry);
+}
+
+/*
+    Fills in the data of \a entry and the parts of its header depending on it.
+    This only touches \a entry, so that entries can be compressed in parallel.
+*/
+void QZipWriterPrivate::compressEntry(Entry &entry)
+{
+    const QByteArray &contents = entry.contents;
+    FileHeader &header = entry.header;
+    writeUInt(header.h.uncompressed_size, contents.length());
+    QByteArray &data = entry.data;
+    data = contents;
+    if (entry.compress) {
+        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+
+       ulong len = contents.length();
+        // shamelessly copied form zlib
+        len += (len >> 12) + (len >> 14) + 11;
+        int res;
+        do {
+            data.resize(len);
+            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
+
+            switch (res) {
+            case Z_OK:
+                data.resize(len);
+                break;
+            case Z_MEM_ERROR:
+                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+                data.resize(0);
+                break;
+            case Z_BUF_ERROR:
+                len *= 2;
+                break;
+            }
+        } while (res == Z_BUF_ERROR);
+    }
+// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
+    writeUInt(header.h.compressed_size, data.length());
+    uint crc_32 = ::crc32(0, nullptr, 0);
+    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
+    writeUInt(header.h.crc_32, crc_32);
+    entry.contents = QByteArray();
+}
+
+void QZipWriterPrivate::writeEntry(Entry &entry)
+{
+    FileHeader &header = entry.header;
+    device->seek(start_of_directory);
+    writeUInt(header.h.offset_local_header, start_of_directory);
 
     fileHeaders.append(header);
 
     LocalFileHeader h = toLocalHeader(header.h);
     device->write((const char *)&h, sizeof(LocalFileHeader));
     device->write(header.file_name);
-    device->write(data);
+    device->write(entry.data);
     start_of_directory = device->pos();
     dirtyFileTree = true;
 }
 
+#if QT_CONFIG(thread)
+void QZipWriterPrivate::writePendingEntries()
+{
+    if (pendingEntries.isEmpty())
+        return;
+
+    // The calling thread compresses whatever the pool has no thread for, so
+    // this cannot deadlock even if it runs in a thread of the pool itself.
+    QSemaphore compressed;
+    int started = 0;
+    for (Entry &entry : pendingEntries) {
+        const auto task = [&entry, &compressed] {
+            compressEntry(entry);
+            compressed.release();
+        };
+        if (threadPool->tryStart(task))
+            ++started;
+        else
+            compressEntry(entry);
+    }
+    compressed.acquire(started);
+
+    // entries are written in the order they were added
+    for (Entry &entry : pendingEntries)
+        writeEntry(entry);
+    pendingEntries.clear();
+    pendingSize = 0;
+}
+#endif
+
 //////////////////////////////  Reader
 
 /*!
@@ -935,60 +1190,34 @@ QZipReader::FileInfo QZipReader::entryInfoAt(int index) const
 */
 QByteArray QZipReader::fileData(const QString &fileName) const
 {
-    d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromLocal8Bit(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
+    const int i = d->indexOf(fileName);
+    if (i < 0)
         return QByteArray();
 
-    FileHeader header = d->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+    QByteArray buffer;
+    QByteArrayView compressed;
+    int compression_method;
+    if (!d->entryData(i, &buffer, &compressed, &compression_method))
         return QByteArray();
-    }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
+    const FileHeader &header = d->fileHeaders.at(i);
+    int compressed_size = compressed.size();
     int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
     //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
 
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
-        return QByteArray();
-    }
-
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        return compressed.first(qMin(compressed_size, uncompressed_size)).toByteArray();
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
         //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         QByteArray baunzip;
         ulong len = qMax(uncompressed_size,  1);
         int res;
         do {
             baunzip.resize(len);
             res = inflate((uchar*)baunzip.data(), &len,
-                          (const uchar*)compressed.constData(), compressed_size);
+                          (const uchar*)compressed.data(), compressed_size);
 
             switch (res) {
             case Z_OK:
@@ -1013,6 +1242,58 @@ QByteArray QZipReader::fileData(const QString &fileName) const
     return QByteArray();
 }
 
+/*!
+    Returns a FileInfo of the entry called \a fileName, as stored in the
+    archive, or an invalid FileInfo if there is no such entry.
+
+    The central directory of the archive is indexed by name, so this does not
+    scan all entries.
+
+    \sa entryInfoAt()
+*/
+QZipReader::FileInfo QZipReader::entryInfo(const QString &fileName) const
+{
+    const int i = d->indexOf(fileName);
+    if (i < 0)
+        return QZipReader::FileInfo();
+    return d->fillFileInfo(i);
+}
+
+/*!
+    Returns a sequential, read-only device producing the uncompressed contents
+    of the entry called \a fileName, or \nullptr if there is no such entry or
+    it cannot be extracted. The caller takes ownership of the device.
+
+    Unlike fileData(), the contents are decompressed as they are read, so the
+    whole entry never has to be held in memory. If the archive is a file, the
+    compressed data is read from a memory mapping of it; the device must then
+    not be used after the reader has been closed or destroyed.
+*/
+QIODevice *QZipReader::entryDevice(const QString &fileName) const
+{
+    const int i = d->indexOf(fileName);
+    if (i < 0)
+        return nullptr;
+
+    QByteArray buffer;
+    QByteArrayView compressed;
+    int compression_method;
+    if (!d->entryData(i, &buffer, &compressed, &compression_method))
+        return nullptr;
+    if (compression_method != CompressionMethodStored
+            && compression_method != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return nullptr;
+    }
+
+    const qint64 uncompressed_size = readUInt(d->fileHeaders.at(i).h.uncompressed_size);
+    auto device = new QZipEntryDevice(buffer, compressed,
+                                      compression_method == CompressionMethodDeflated,
+                                      uncompressed_size);
+    device->open(QIODevice::ReadOnly);
+    return device;
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
@@ -1114,6 +1395,7 @@ QZipReader::Status QZipReader::status() const
 */
 void QZipReader::close()
 {
+    d->unmap();
     d->device->close();
 }
 
@@ -1279,6 +1561,43 @@ QFile::Permissions QZipWriter::creationPermissions() const
     return d->permissions;
 }
 
+/*!
+    Compresses the files added to the archive in parallel on the threads of
+    \a pool. Entries are then collected and compressed in batches, and written
+    in the order they were added once their batch is complete, or on close().
+    Passing \nullptr, the default, compresses each file in the calling thread
+    as it is added.
+
+    The pool must stay alive until the archive has been closed, or another
+    pool has been set.
+
+    \sa addFile()
+*/
+void QZipWriter::setThreadPool(QThreadPool *pool)
+{
+#if QT_CONFIG(thread)
+    d->writePendingEntries();
+    d->threadPool = pool;
+#else
+    Q_UNUSED(pool);
+#endif
+}
+
+/*!
+    Returns the thread pool files are compressed on, or \nullptr if they are
+    compressed in the calling thread.
+
+    \sa setThreadPool()
+*/
+QThreadPool *QZipWriter::threadPool() const
+{
+#if QT_CONFIG(thread)
+    return d->threadPool;
+#else
+    return nullptr;
+#endif
+}
+
 /*!
     Add a file to the archive with \a data as the file contents.
     The file will be stored in the archive using the \a fileName which
@@ -1353,6 +1672,10 @@ void QZipWriter::close()
         return;
     }
 
+#if QT_CONFIG(thread)
+    d->writePendingEntries();
+#endif
+
     //qDebug("QZip::close writing directory, %d entries", d->fileHeaders.size());
     d->device->seek(d->start_of_directory);
     // write new directory
@@ -99,7 +99,9 @@ public:
     int count() const;
 
     FileInfo entryInfoAt(int index) const;
+    FileInfo entryInfo(const QString &fileName) const;
     QByteArray fileData(const QString &fileName) const;
+    QIODevice *entryDevice(const QString &fileName) const;
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
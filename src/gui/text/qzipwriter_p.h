@@ -59,6 +59,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QThreadPool;
 class QZipWriterPrivate;
 
 
@@ -97,6 +98,9 @@ public:
     void setCreationPermissions(QFile::Permissions permissions);
     QFile::Permissions creationPermissions() const;
 
+    void setThreadPool(QThreadPool *pool);
+    QThreadPool *threadPool() const;
+
     void addFile(const QString &fileName, const QByteArray &data);
 
     void addFile(const QString &fileName, QIODevice *device);
@@ -43,8 +43,13 @@
 #include <QtGui/private/qfontengine_ft_p.h>
 
 #include <QtCore/QList>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
 
 #include <qpa/qplatformnativeinterface.h>
 #include <qpa/qplatformscreen.h>
@@ -400,7 +405,86 @@ static inline bool requiresOpenType(int writingSystem)
             || writingSystem == QFontDatabase::Khmer || writingSystem == QFontDatabase::Nko);
 }
 
-static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::ApplicationFont *applicationFont = nullptr)
+namespace {
+// The fonts and aliases registered from the system fontconfig configuration, so
+// that they can be registered again on the next start without enumerating
+struct FontconfigSnapshot
+{
+    struct Font {
+        QString familyName;
+        QString styleName;
+        QString foundry;
+        int weight;
+        int style;
+        int stretch;
+        bool antialias;
+        bool scalable;
+        double pixelSize;
+        bool fixedPitch;
+        quint64 writingSystems;
+        QString fileName;
+        int indexValue;
+    };
+
+    QList<Font> fonts;
+    QList<std::pair<QString, QString>> aliases;
+
+    void addFont(const QString &familyName, const QString &styleName, const QString &foundry,
+                 QFont::Weight weight, QFont::Style style, QFont::Stretch stretch, bool antialias,
+                 bool scalable, double pixelSize, bool fixedPitch,
+                 const QSupportedWritingSystems &writingSystems, const FontFile *fontFile)
+    {
+        quint64 supported = 0;
+        for (int i = 0; i < QFontDatabase::WritingSystemsCount; ++i) {
+            if (writingSystems.supported(QFontDatabase::WritingSystem(i)))
+                supported |= Q_UINT64_C(1) << i;
+        }
+        fonts.append({ familyName, styleName, foundry, weight, style, stretch, antialias, scalable,
+                       pixelSize, fixedPitch, supported, fontFile->fileName, fontFile->indexValue });
+    }
+
+    void registerFonts() const
+    {
+        for (const Font &font : fonts) {
+            QSupportedWritingSystems writingSystems;
+            for (int i = 0; i < QFontDatabase::WritingSystemsCount; ++i) {
+                if (font.writingSystems & (Q_UINT64_C(1) << i))
+                    writingSystems.setSupported(QFontDatabase::WritingSystem(i));
+            }
+            FontFile *fontFile = new FontFile;
+            fontFile->fileName = font.fileName;
+            fontFile->indexValue = font.indexValue;
+            QPlatformFontDatabase::registerFont(font.familyName, font.styleName, font.foundry,
+                                                QFont::Weight(font.weight), QFont::Style(font.style),
+                                                QFont::Stretch(font.stretch), font.antialias,
+                                                font.scalable, font.pixelSize, font.fixedPitch,
+                                                writingSystems, fontFile);
+        }
+        for (const auto &alias : aliases)
+            QPlatformFontDatabase::registerAliasToFontFamily(alias.first, alias.second);
+    }
+};
+static_assert(QFontDatabase::WritingSystemsCount <= 64);
+
+QDataStream &operator<<(QDataStream &stream, const FontconfigSnapshot::Font &font)
+{
+    return stream << font.familyName << font.styleName << font.foundry << font.weight
+                  << font.style << font.stretch << font.antialias << font.scalable
+                  << font.pixelSize << font.fixedPitch << font.writingSystems
+                  << font.fileName << font.indexValue;
+}
+
+QDataStream &operator>>(QDataStream &stream, FontconfigSnapshot::Font &font)
+{
+    return stream >> font.familyName >> font.styleName >> font.foundry >> font.weight
+                  >> font.style >> font.stretch >> font.antialias >> font.scalable
+                  >> font.pixelSize >> font.fixedPitch >> font.writingSystems
+                  >> font.fileName >> font.indexValue;
+}
+} // namespace
+
+static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::ApplicationFont *applicationFont = nullptr,
+                                FontconfigSnapshot *snapshot = nullptr)
 {
     QString familyName;
     QString familyNameLang;
@@ -523,6 +607,8 @@ static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::Applic
     }
 
     QPlatformFontDatabase::registerFont(familyName,styleName,QLatin1String((const char *)foundry_value),weight,style,stretch,antialias,scalable,pixel_size,fixedPitch,writingSystems,fontFile);
+    if (snapshot)
+        snapshot->addFont(familyName, styleName, QLatin1String((const char *)foundry_value), weight, style, stretch, antialias, scalable, pixel_size, fixedPitch, writingSystems, fontFile);
 //        qDebug() << familyName << (const char *)foundry_value << weight << style << &writingSystems << scalable << true << pixel_size;
 
     for (int k = 1; FcPatternGetString(pattern, FC_FAMILY, k, &value) == FcResultMatch; ++k) {
@@ -555,21 +641,109 @@ static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::Applic
             }
             FontFile *altFontFile = new FontFile(*fontFile);
             QPlatformFontDatabase::registerFont(altFamilyName, altStyleName, QLatin1String((const char *)foundry_value),weight,style,stretch,antialias,scalable,pixel_size,fixedPitch,writingSystems,altFontFile);
+            if (snapshot)
+                snapshot->addFont(altFamilyName, altStyleName, QLatin1String((const char *)foundry_value), weight, style, stretch, antialias, scalable, pixel_size, fixedPitch, writingSystems, altFontFile);
         } else {
             QPlatformFontDatabase::registerAliasToFontFamily(familyName, altFamilyName);
+            if (snapshot)
+                snapshot->aliases.append({ familyName, altFamilyName });
         }
     }
 
 }
 
+static const quint32 fontconfigSnapshotMagic = 0x51464353; // "QFCS"
+static const quint32 fontconfigSnapshotVersion = 1;
+
+static QString fontconfigSnapshotPath()
+{
+    if (qEnvironmentVariableIsSet("QT_NO_FONTCONFIG_SNAPSHOT"))
+        return QString();
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheDir.isEmpty())
+        return QString();
+    return cacheDir + QLatin1String("/qtfontconfig/fonts-") + QString::number(QT_VERSION, 16)
+            + QLatin1String(".cache");
+}
+
+static void appendFcPathStamps(QByteArray *stamp, FcStrList *list)
+{
+    if (!list)
+        return;
+    while (const FcChar8 *path = FcStrListNext(list)) {
+        const QString fileName = QFile::decodeName(reinterpret_cast<const char *>(path));
+        const QFileInfo info(fileName);
+        stamp->append(reinterpret_cast<const char *>(path));
+        stamp->append('\0');
+        stamp->append(QByteArray::number(info.exists()
+                                         ? info.lastModified().toMSecsSinceEpoch() : -1));
+        stamp->append('\0');
+    }
+    FcStrListDone(list);
+}
+
+// Identifies the current fontconfig setup. Like fontconfig's own caches, this relies
+// on the modification times of the configuration files and the font directories.
+static QByteArray fontconfigStamp()
+{
+    QByteArray stamp = QByteArray::number(FcGetVersion());
+    stamp.append('\0');
+    appendFcPathStamps(&stamp, FcConfigGetConfigFiles(nullptr));
+    appendFcPathStamps(&stamp, FcConfigGetFontDirs(nullptr));
+    return stamp;
+}
+
+static bool loadFontconfigSnapshot(const QString &path, const QByteArray &stamp,
+                                   FontconfigSnapshot *snapshot)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const qint64 size = file.size();
+    const uchar *mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (!mapped)
+        return false;
+
+    QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), size);
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray storedStamp;
+    stream >> magic >> version;
+    if (magic != fontconfigSnapshotMagic || version != fontconfigSnapshotVersion)
+        return false;
+    stream >> storedStamp;
+    if (storedStamp != stamp)
+        return false;
+    stream >> snapshot->fonts >> snapshot->aliases;
+    return stream.status() == QDataStream::Ok;
+}
+
+static void saveFontconfigSnapshot(const QString &path, const QByteArray &stamp,
+                                   const FontconfigSnapshot &snapshot)
+{
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return;
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << fontconfigSnapshotMagic << fontconfigSnapshotVersion << stamp
+           << snapshot.fonts << snapshot.aliases;
+    if (stream.status() == QDataStream::Ok)
+        file.commit();
+}
+
 QFontconfigDatabase::~QFontconfigDatabase()
 {
     FcConfigDestroy(FcConfigGetCurrent());
 }
 
-void QFontconfigDatabase::populateFontDatabase()
+static void populateFromFontconfig(FontconfigSnapshot *snapshot)
 {
-    FcInit();
     FcFontSet  *fonts;
 
     {
@@ -596,10 +770,13 @@ void QFontconfigDatabase::populateFontDatabase()
     }
 
     for (int i = 0; i < fonts->nfont; i++)
-        populateFromPattern(fonts->fonts[i]);
+        populateFromPattern(fonts->fonts[i], nullptr, snapshot);
 
     FcFontSetDestroy (fonts);
+}
 
+static void registerDefaultFamilies()
+{
     struct FcDefaultFont {
         const char *qtname;
         const char *rawname;
@@ -618,11 +795,32 @@ void QFontconfigDatabase::populateFontDatabase()
 
     while (f->qtname) {
         QString familyQtName = QString::fromLatin1(f->qtname);
-        registerFont(familyQtName,QString(),QString(),QFont::Normal,QFont::StyleNormal,QFont::Unstretched,true,true,0,f->fixed,ws,nullptr);
-        registerFont(familyQtName,QString(),QString(),QFont::Normal,QFont::StyleItalic,QFont::Unstretched,true,true,0,f->fixed,ws,nullptr);
-        registerFont(familyQtName,QString(),QString(),QFont::Normal,QFont::StyleOblique,QFont::Unstretched,true,true,0,f->fixed,ws,nullptr);
+        QPlatformFontDatabase::registerFont(familyQtName,QString(),QString(),QFont::Normal,QFont::StyleNormal,QFont::Unstretched,true,true,0,f->fixed,ws,nullptr);
+        QPlatformFontDatabase::registerFont(familyQtName,QString(),QString(),QFont::Normal,QFont::StyleItalic,QFont::Unstretched,true,true,0,f->fixed,ws,nullptr);
+        QPlatformFontDatabase::registerFont(familyQtName,QString(),QString(),QFont::Normal,QFont::StyleOblique,QFont::Unstretched,true,true,0,f->fixed,ws,nullptr);
         ++f;
     }
+}
+
+void QFontconfigDatabase::populateFontDatabase()
+{
+    FcInit();
+
+    // Enumerating all fonts is slow on systems with many of them, so the result is
+    // kept across runs for as long as the fontconfig setup doesn't change
+    const QString snapshotPath = fontconfigSnapshotPath();
+    const QByteArray stamp = snapshotPath.isEmpty() ? QByteArray() : fontconfigStamp();
+    FontconfigSnapshot snapshot;
+    if (!snapshotPath.isEmpty() && loadFontconfigSnapshot(snapshotPath, stamp, &snapshot)) {
+        snapshot.registerFonts();
+    } else {
+        snapshot = FontconfigSnapshot();
+        populateFromFontconfig(snapshotPath.isEmpty() ? nullptr : &snapshot);
+        if (!snapshotPath.isEmpty())
+            saveFontconfigSnapshot(snapshotPath, stamp, snapshot);
+    }
+
+    registerDefaultFamilies();
 
     //QPA has very lazy population of the font db. We want it to be initialized when
     //QApplication is constructed, so that the population procedure can do something like this to
@@ -86,63 +86,11 @@ int compare(const QByteArray &lhs, const QByteArray &rhs)
 
 } // unnamed namespace
 
-FieldLookupTable::SearchEntry::SearchEntry()
-    : field(),
-      chunk(),
-      offset(),
-      table()
-{
-}
-
-FieldLookupTable::SearchEntry::SearchEntry(const HeaderField *f,
-                                           const Chunk *c,
-                                           quint32 o,
-                                           const FieldLookupTable *t)
-    : field(f),
-      chunk(c),
-      offset(o),
-      table(t)
-{
-    Q_ASSERT(field);
-}
-
-bool FieldLookupTable::SearchEntry::operator < (const SearchEntry &rhs)const
-{
-    Q_ASSERT(field);
-    Q_ASSERT(rhs.field);
-
-    int cmp = compare(field->name, rhs.field->name);
-    if (cmp)
-        return cmp < 0;
-
-    cmp = compare(field->value, rhs.field->value);
-    if (cmp)
-        return cmp < 0;
-
-    if (!chunk) // 'this' is not in the searchIndex.
-        return rhs.chunk;
-
-    if (!rhs.chunk) // not in the searchIndex.
-        return false;
-
-    Q_ASSERT(table);
-    Q_ASSERT(rhs.table == table);
-
-    const quint32 leftChunkIndex = table->indexOfChunk(chunk);
-    const quint32 rightChunkIndex = rhs.table->indexOfChunk(rhs.chunk);
-
-    // Later added - smaller is chunk index (since we push_front).
-    if (leftChunkIndex != rightChunkIndex)
-        return leftChunkIndex > rightChunkIndex;
-
-    // Later added - smaller is offset.
-    return offset > rhs.offset;
-}
-
 FieldLookupTable::FieldLookupTable(quint32 maxSize, bool use)
     : maxTableSize(maxSize),
       tableCapacity(maxSize),
       useIndex(use),
+      nInserted(),
       nDynamic(),
       begin(),
       end(),
@@ -178,13 +126,22 @@ bool FieldLookupTable::prependField(const QByteArray &name, const QByteArray &va
     ++nDynamic;
 
     auto &newField = front();
-    newField.name = name;
     newField.value = value;
+    const quint64 serial = nInserted++;
 
     if (useIndex) {
-        const auto result = searchIndex.insert(frontKey());
-        Q_UNUSED(result);
-        Q_ASSERT(result.second);
+        // Share the name with the entries already in the table, if any.
+        const auto nameIt = nameIndex.find(name);
+        if (nameIt != nameIndex.end()) {
+            newField.name = nameIt.key();
+            *nameIt = serial;
+        } else {
+            newField.name = name;
+            nameIndex.insert(name, serial);
+        }
+        fieldIndex.insert(newField, serial);
+    } else {
+        newField.name = name;
     }
 
     return true;
@@ -197,13 +154,21 @@ void FieldLookupTable::evictEntry()
 
     Q_ASSERT(end != begin);
 
+    const HeaderField &field = back();
+
     if (useIndex) {
-        const auto res = searchIndex.erase(backKey());
-        Q_UNUSED(res);
-        Q_ASSERT(res == 1);
+        // Newer entries with the same name or name|value pair stay indexed.
+        const quint64 serial = nInserted - nDynamic;
+        const auto fieldIt = fieldIndex.find(field);
+        Q_ASSERT(fieldIt != fieldIndex.end());
+        if (*fieldIt == serial)
+            fieldIndex.erase(fieldIt);
+        const auto nameIt = nameIndex.find(field.name);
+        Q_ASSERT(nameIt != nameIndex.end());
+        if (*nameIt == serial)
+            nameIndex.erase(nameIt);
     }
 
-    const HeaderField &field = back();
     const auto entrySize = entry_size(field);
     Q_ASSERT(entrySize.first);
     Q_ASSERT(dataSize >= entrySize.second);
@@ -243,7 +208,8 @@ quint32 FieldLookupTable::dynamicDataSize() const
 
 void FieldLookupTable::clearDynamicTable()
 {
-    searchIndex.clear();
+    fieldIndex.clear();
+    nameIndex.clear();
     chunks.clear();
     begin = 0;
     end = 0;
@@ -273,13 +239,9 @@ quint32 FieldLookupTable::indexOf(const QByteArray &name, const QByteArray &valu
         return 0;
     }
 
-    const SearchEntry key(&field, nullptr, 0, this);
-    const auto pos = searchIndex.lower_bound(key);
-    if (pos != searchIndex.end()) {
-        const HeaderField &found = *pos->field;
-        if (found.name == name && found.value == value)
-            return keyToIndex(*pos);
-    }
+    const auto pos = fieldIndex.constFind(field);
+    if (pos != fieldIndex.cend())
+        return serialToIndex(*pos);
 
     return 0;
 }
@@ -301,13 +263,9 @@ quint32 FieldLookupTable::indexOf(const QByteArray &name) const
         return 0;
     }
 
-    const SearchEntry key(&field, nullptr, 0, this);
-    const auto pos = searchIndex.lower_bound(key);
-    if (pos != searchIndex.end()) {
-        const HeaderField &found = *pos->field;
-        if (found.name == name)
-            return keyToIndex(*pos);
-    }
+    const auto pos = nameIndex.constFind(name);
+    if (pos != nameIndex.cend())
+        return serialToIndex(*pos);
 
     return 0;
 }
@@ -373,47 +331,13 @@ const HeaderField &FieldLookupTable::back() const
     return (*chunks[chunkIndex])[offset];
 }
 
-quint32 FieldLookupTable::indexOfChunk(const Chunk *chunk) const
-{
-    Q_ASSERT(chunk);
-
-    for (size_type i = 0; i < chunks.size(); ++i) {
-        if (chunks[i].get() == chunk)
-            return quint32(i);
-    }
-
-    Q_UNREACHABLE();
-    return 0;
-}
-
-quint32 FieldLookupTable::keyToIndex(const SearchEntry &key) const
-{
-    Q_ASSERT(key.chunk);
-
-    const auto chunkIndex = indexOfChunk(key.chunk);
-    const auto offset = key.offset;
-    Q_ASSERT(offset < ChunkSize);
-    Q_ASSERT(chunkIndex || offset >= begin);
-
-    return quint32(offset + chunkIndex * ChunkSize - begin + 1 + staticPart().size());
-}
-
-FieldLookupTable::SearchEntry FieldLookupTable::frontKey() const
-{
-    Q_ASSERT(chunks.size() && end != begin);
-    return SearchEntry(&front(), chunks.front().get(), begin, this);
-}
-
-FieldLookupTable::SearchEntry FieldLookupTable::backKey() const
+quint32 FieldLookupTable::serialToIndex(quint64 serial) const
 {
-    Q_ASSERT(chunks.size() && end != begin);
-
-    const HeaderField &field = back();
-    const quint32 absIndex = end - 1;
-    const auto offset = absIndex % ChunkSize;
-    const auto chunk = chunks[absIndex / ChunkSize].get();
+    // The front entry is the newest one, it has index 1 in the dynamic part.
+    Q_ASSERT(serial < nInserted);
+    Q_ASSERT(nInserted - serial <= nDynamic);
 
-    return SearchEntry(&field, chunk, offset, this);
+    return quint32(nInserted - serial + staticPart().size());
 }
 
 bool FieldLookupTable::updateDynamicTableSize(quint32 size)
@@ -53,12 +53,12 @@
 
 #include <QtCore/qbytearray.h>
 #include <QtCore/qglobal.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qpair.h>
 
 #include <vector>
 #include <memory>
 #include <deque>
-#include <set>
 
 QT_BEGIN_NAMESPACE
 
@@ -86,6 +86,11 @@ struct Q_AUTOTEST_EXPORT HeaderField
     QByteArray value;
 };
 
+inline size_t qHash(const HeaderField &field, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, field.name, field.value);
+}
+
 using HeaderSize = QPair<bool, quint32>;
 
 HeaderSize entry_size(const QByteArray &name, const QByteArray &value);
@@ -128,19 +133,18 @@ inline HeaderSize entry_size(const HeaderField &entry)
     contains no duplicates, we use binary search comparing string values.
 
     To provide a lookup in dynamic table faster than a linear search,
-    we have an std::set of 'SearchEntries', where each entry contains:
-     - a pointer to a (name|value) pair (to compare
-       name|value strings).
-     - a pointer to a chunk containing this pair and
-     - an offset within this chunk - to calculate a
-       'linear' index.
-
-    Entries in a table can be duplicated (HPACK, 2.3.2),
-    if we evict an entry, we must update our index removing
-    the exactly right key, thus keys in this set are sorted
-    by name|value pairs first, and then by chunk index/offset
-    (so that NewSearchEntryKey < OldSearchEntry even if strings
-    are equal).
+    every dynamic entry gets a serial number when it's inserted, and
+    we have two hash tables: one mapping (name|value) pairs, the other
+    mapping names, to the serial number of the most recently inserted
+    entry that has them. The 'linear' index of an entry follows from
+    its serial number and the number of entries inserted so far.
+
+    Entries in a table can be duplicated (HPACK, 2.3.2). Since
+    entries are evicted oldest first, an evicted entry is still
+    in the index only if it was the last one with its name (or
+    name|value pair), and then it's simply removed. The keys
+    in the name index are shared with the fields in the table,
+    so repeated names are stored only once.
 */
 
 class Q_AUTOTEST_EXPORT FieldLookupTable
@@ -190,28 +194,12 @@ private:
     std::deque<ChunkPtr> chunks;
     using size_type = std::deque<ChunkPtr>::size_type;
 
-    struct SearchEntry;
-    friend struct SearchEntry;
-
-    struct SearchEntry
-    {
-        SearchEntry();
-        SearchEntry(const HeaderField *f, const Chunk *c,
-                    quint32 o, const FieldLookupTable *t);
-
-        const HeaderField *field;
-        const Chunk *chunk;
-        const quint32 offset;
-        const FieldLookupTable *table;
-
-        bool operator < (const SearchEntry &rhs) const;
-    };
-
     bool useIndex;
-    std::set<SearchEntry> searchIndex;
-
-    SearchEntry frontKey() const;
-    SearchEntry backKey() const;
+    // Serial numbers of the newest entries with a given name|value / name:
+    QHash<HeaderField, quint64> fieldIndex;
+    QHash<QByteArray, quint64> nameIndex;
+    // The number of entries ever inserted - the serial number of the next one:
+    quint64 nInserted;
 
     bool fieldAt(quint32 index, HeaderField *field) const;
 
@@ -224,8 +212,7 @@ private:
     quint32 end;
     quint32 dataSize;
 
-    quint32 indexOfChunk(const Chunk *chunk) const;
-    quint32 keyToIndex(const SearchEntry &key) const;
+    quint32 serialToIndex(quint64 serial) const;
 
     enum class CompareMode {
         nameOnly,
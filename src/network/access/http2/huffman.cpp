@@ -42,7 +42,7 @@
 
 #include <QtCore/qbytearray.h>
 
-#include <algorithm>
+#include <array>
 #include <limits>
 
 QT_BEGIN_NAMESPACE
@@ -60,32 +60,14 @@ namespace HPack
     code length. All codes were left-aligned - for implementation
     convenience.
 
-    Using binary trees to implement decoding would be prohibitively
-    expensive (both memory and time-wise). Instead we use a table-based
-    approach and any given code itself works as an index into such table(s).
-    We have 256 possible byte values and code lengths in
-    a range [5, 26]. This would require a huge table (and most of entries
-    would be 'wasted', since we only have to encode 256 elements).
-    Instead we use multi-level tables. The first level table
-    is using 9-bit length index; some entries in this table are 'terminal',
-    some reference the next level table(s).
-
-    For example, bytes with values 48 and 49 (ASCII codes for '0' and '1')
-    both have code length 5, Huffman codes are: 00000 and 00001. They
-    both are placed in the 'root' table,
-    the 'root' table has index length == 9:
-    [00000 | 4 remaining bits]
-     ...
-    [00001 | 4 remaining bits]
-
-    All entries with indices between these two will 'point' to value 48
-    with bitLength == 5 so that bit stream (for example) 000001010 will be
-    decoded as: 48 + "put 1010 back into bitstream".
-
-    A good description can be found here:
-    http://commandlinefanatic.com/cgi-bin/showarticle.cgi?article=art007
-    or just google "Efficient Huffman Decoding".
-    Also see comments below about 'filling holes'.
+    Decoding bit by bit, walking a binary tree, would be prohibitively
+    expensive. Instead we walk the tree an octet at a time: the states of
+    a finite state machine are the tree's internal nodes (a partially read
+    code), and for every state and every possible input octet a table holds
+    the state we end up in and the symbols completed on the way there. Since
+    the shortest code is 5 bits long, an octet completes two symbols at most.
+    With 256 internal nodes the table has 256 * 256 entries; it's built once,
+    the first time a string is decoded.
 */
 
 namespace
@@ -402,172 +384,111 @@ void huffman_encode_string(const QByteArray &inputData, BitOStream &outputStream
         outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
 }
 
-bool padding_is_valid(quint32 chunk, quint32 nBits)
-{
-    Q_ASSERT(nBits);
-
-    // HPACK, 5.2: "A padding strictly longer than 7 bits MUST be
-    // treated as a decoding error."
-    if (nBits > 7)
-        return false;
-    // HPACK, 5.2:
-    // "A padding not corresponding to the most significant bits
-    // of the code for the EOS symbol MUST be treated as a decoding error."
-    return (chunk >> (32 - nBits)) == quint32((1 << nBits) - 1);
-}
-
 HuffmanDecoder::HuffmanDecoder()
-    : minCodeLength()
+    : transitions(256 * 256),
+      accepting(256)
 {
-    const auto nCodes = sizeof staticHuffmanCodeTable / sizeof staticHuffmanCodeTable[0];
-
-    std::vector<CodeEntry> symbols(staticHuffmanCodeTable, staticHuffmanCodeTable + nCodes);
-    // Now we sort: by bit length first (in the descending order) and by the symbol
-    // value (descending). Descending order: to make sure we do not create prefix tables with
-    // short 'indexLength' first and having longer codes that do not fit into such tables later.
-    std::sort(symbols.begin(), symbols.end(), [](const CodeEntry &code1, const CodeEntry &code2) {
-        if (code1.bitLength == code2.bitLength)
-            return code1.byteValue > code2.byteValue;
-        return code1.bitLength > code2.bitLength;
-    });
-
-    minCodeLength = symbols.back().bitLength; // The shortest one, currently it's 5.
-
-    // TODO: add a verification - Huffman codes
-    // within a given bit length range also
-    // should be in descending order.
-
-    // Initialize 'prefixTables' and 'tableData'.
-    addTable(0, quint32(BitConstants::rootPrefix)); // 'root' table.
-
-    for (const auto &s : symbols) {
-        quint32 tableIndex = 0;
-        while (true) {
-            Q_ASSERT(tableIndex < prefixTables.size());
-            // Note, by value - since prefixTables will be updated in between.
-            const auto table = prefixTables[tableIndex];
-            // We skip prefixed bits (if any) and use indexed bits only:
-            const auto entryIndex = s.huffmanCode << table.prefixLength >> (32 - table.indexLength);
-            // Again, by value.
-            PrefixTableEntry entry = tableEntry(table, entryIndex);
-            // How many bits were coded by previous tables and this table:
-            const auto codedLength = table.prefixLength + table.indexLength;
-            if (codedLength < s.bitLength) {
-                // We have to add a new prefix table ... (if it's not done yet).
-                if (!entry.bitLength) {
-                    entry.nextTable = addTable(codedLength, std::min<quint32>(quint32(BitConstants::childPrefix),
-                                                                              s.bitLength - codedLength));
-                    entry.bitLength = s.bitLength;
-                    entry.byteValue = s.byteValue;
-                    setTableEntry(table, entryIndex, entry);
-                }
-                tableIndex = entry.nextTable;
-            } else {
-                // We found the slot for our code (terminal entry):
-                entry.byteValue = s.byteValue;
-                entry.bitLength = s.bitLength;
-                // Refer to our own table as 'nextTable':
-                entry.nextTable = tableIndex;
-                setTableEntry(table, entryIndex, entry);
+    // Build the tree first. An element of 'children' is either
+    // the index of an internal node, or ~symbol for a leaf.
+    // 0 (the root) is never a child, so it marks a missing one.
+    std::vector<std::array<int, 2>> children(1);
+    std::vector<quint32> depth(1);
+    std::vector<bool> onlyOnes(1, true);
+
+    for (const CodeEntry &code : staticHuffmanCodeTable) {
+        quint32 node = 0;
+        for (quint32 i = 0; i < code.bitLength; ++i) {
+            const quint32 bit = code.huffmanCode >> (31 - i) & 1;
+            if (i + 1 == code.bitLength) {
+                Q_ASSERT(!children[node][bit]);
+                children[node][bit] = ~int(code.byteValue);
                 break;
             }
-        }
-    }
 
-    // Now, we have a table(s) and have to fill 'holes' to
-    // 'fix' terminal entries.
-    for (const auto &table : prefixTables) {
-        const quint32 codedLength = table.prefixLength + table.indexLength;
-        for (quint32 j = 0; j < table.size();) {
-            const PrefixTableEntry &entry = tableEntry(table, j);
-            if (entry.bitLength && entry.bitLength < codedLength) {
-                const quint32 range = 1 << (codedLength - entry.bitLength);
-                for (quint32 k = 1; k < range; ++k)
-                    setTableEntry(table, j + k, entry);
-                j += range;
-            } else {
-                ++j;
+            if (!children[node][bit]) {
+                children[node][bit] = int(children.size());
+                children.push_back({});
+                depth.push_back(depth[node] + 1);
+                onlyOnes.push_back(onlyOnes[node] && bit);
             }
+            node = quint32(children[node][bit]);
         }
     }
-}
 
-bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
-{
-    while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
-
-        if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
-
-        quint32 tableIndex = 0;
-        const PrefixTable *table = &prefixTables[tableIndex];
-        quint32 entryIndex = chunk >> (32 - table->indexLength);
-        PrefixTableEntry entry = tableEntry(*table, entryIndex);
-
-        while (true) {
-            if (entry.nextTable == tableIndex)
-                break;
-
-            tableIndex = entry.nextTable;
-            table = &prefixTables[tableIndex];
-            entryIndex = chunk << table->prefixLength >> (32 - table->indexLength);
-            entry = tableEntry(*table, entryIndex);
-        }
+    // The code is complete: 257 leaves, 256 internal nodes.
+    Q_ASSERT(children.size() == 256);
+
+    for (quint32 state = 0; state < 256; ++state) {
+        // HPACK, 5.2: "A padding strictly longer than 7 bits MUST be
+        // treated as a decoding error. A padding not corresponding to
+        // the most significant bits of the code for the EOS symbol MUST
+        // be treated as a decoding error." So the padding must be a
+        // prefix of EOS (all ones), at most 7 bits long.
+        accepting[state] = onlyOnes[state] && depth[state] <= 7;
+
+        for (quint32 octet = 0; octet < 256; ++octet) {
+            quint32 node = state;
+            quint32 transition = 0;
+            quint32 nSymbols = 0;
+            for (int i = 7; i >= 0; --i) {
+                const int child = children[node][octet >> i & 1];
+                Q_ASSERT(child);
+                if (child > 0) {
+                    node = quint32(child);
+                    continue;
+                }
 
-        if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
+                const quint32 symbol = quint32(~child);
+                if (symbol == 256) {
+                    // EOS (256) == compression error (HPACK).
+                    transition |= failure;
+                    break;
+                }
 
-        if (!entry.bitLength || entry.byteValue == 256) {
-            //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
-            return false;
+                Q_ASSERT(nSymbols < 2);
+                transition |= symbol << (8 + 8 * nSymbols);
+                ++nSymbols;
+                node = 0;
+            }
+            transitions[state << 8 | octet] = transition | node | nSymbols << symbolCountShift;
         }
-
-        outputBuffer.append(entry.byteValue);
-        inputStream.skipBits(entry.bitLength);
     }
-
-    return false;
 }
 
-quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
+bool HuffmanDecoder::decode(const uchar *first, const uchar *last, QByteArray &outputBuffer) const
 {
-    PrefixTable newTable{prefix, index};
-    newTable.offset = quint32(tableData.size());
-    prefixTables.push_back(newTable);
-    // Add entries for this table:
-    tableData.resize(tableData.size() + newTable.size());
-
-    return quint32(prefixTables.size() - 1);
-}
+    // Every octet emits at most two symbols, and we always store
+    // two (only advancing past the valid ones): reserve enough
+    // for the longest possible output, plus one spare slot.
+    const qsizetype oldSize = outputBuffer.size();
+    outputBuffer.resize(oldSize + (last - first) * 8 / 5 + 2);
+    char *const begin = outputBuffer.data();
+    char *dst = begin + oldSize;
+
+    quint32 state = 0;
+    for (; first != last; ++first) {
+        const quint32 transition = transitions[state << 8 | *first];
+        if (transition & failure) {
+            outputBuffer.resize(dst - begin);
+            return false;
+        }
 
-PrefixTableEntry HuffmanDecoder::tableEntry(const PrefixTable &table, quint32 index)
-{
-    Q_ASSERT(index < table.size());
-    return tableData[table.offset + index];
-}
+        dst[0] = char(transition >> 8);
+        dst[1] = char(transition >> 16);
+        dst += transition >> symbolCountShift & 3;
+        state = transition & stateMask;
+    }
 
-void HuffmanDecoder::setTableEntry(const PrefixTable &table, quint32 index,
-                                   const PrefixTableEntry &entry)
-{
-    Q_ASSERT(index < table.size());
-    tableData[table.offset + index] = entry;
+    outputBuffer.resize(dst - begin);
+    return accepting[state];
 }
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer)
+bool huffman_decode_string(const uchar *first, const uchar *last, QByteArray *outputBuffer)
 {
     Q_ASSERT(outputBuffer);
 
-    static HuffmanDecoder decoder;
-    return decoder.decodeStream(inputStream, *outputBuffer);
+    static const HuffmanDecoder decoder;
+    return decoder.decode(first, last, *outputBuffer);
 }
 
 }
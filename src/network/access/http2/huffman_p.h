@@ -53,6 +53,8 @@
 
 #include <QtCore/qglobal.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 class QByteArray;
@@ -72,94 +74,39 @@ class BitOStream;
 quint64 huffman_encoded_bit_length(const QByteArray &inputData);
 void huffman_encode_string(const QByteArray &inputData, BitOStream &outputStream);
 
-// PrefixTable:
-// Huffman codes with a small bit length
-// fit into a table (these are 'terminal' symbols),
-// codes with longer codes require additional
-// tables, so several symbols will have the same index
-// in a table - pointing into the next table.
-// Every table has an 'indexLength' - that's
-// how many bits can fit in table's indices +
-// 'prefixLength' - how many bits were addressed
-// by its 'parent' table(s).
-// All PrefixTables are kept in 'prefixTables' array.
-// PrefixTable itself does not have any entries,
-// it just holds table's prefix/index + 'offset' -
-// there table's data starts in an array of all
-// possible entries ('tableData').
-
-struct PrefixTable
-{
-    PrefixTable()
-        : prefixLength(),
-          indexLength(),
-          offset()
-    {
-    }
-
-    PrefixTable(quint32 prefix, quint32 index)
-        : prefixLength(prefix),
-          indexLength(index),
-          offset()
-    {
-    }
-
-    quint32 size()const
-    {
-        // Number of entries table contains:
-        return 1 << indexLength;
-    }
-
-    quint32 prefixLength;
-    quint32 indexLength;
-    quint32 offset;
-};
-
-// Table entry is either a terminal entry (thus probably the code found)
-// or points into another table ('nextTable' - index into
-// 'prefixTables' array). If it's a terminal, 'nextTable' index
-// refers to the same table.
-
-struct PrefixTableEntry
-{
-    PrefixTableEntry()
-        : bitLength(),
-          nextTable(),
-          byteValue()
-    {
-    }
-
-    quint32 bitLength;
-    quint32 nextTable;
-    quint32 byteValue;
-};
-
-class BitIStream;
+// HuffmanDecoder:
+// A finite state machine that consumes the input
+// a whole octet at a time. Its states are the internal
+// nodes of the Huffman tree (there are 256 of them, the
+// code has 257 symbols including EOS). A transition
+// consumes 8 bits and emits zero, one or two symbols:
+// no code is shorter than 5 bits.
 
 class HuffmanDecoder
 {
 public:
-    enum class BitConstants
-    {
-        rootPrefix = 9,
-        childPrefix = 6
-    };
-
     HuffmanDecoder();
 
-    bool decodeStream(BitIStream &inputStream, QByteArray &outputBuffer);
+    bool decode(const uchar *first, const uchar *last, QByteArray &outputBuffer) const;
 
 private:
-    quint32 addTable(quint32 prefixLength, quint32 indexLength);
-    PrefixTableEntry tableEntry(const PrefixTable &table, quint32 index);
-    void setTableEntry(const PrefixTable &table, quint32 index, const PrefixTableEntry &entry);
+    enum : quint32
+    {
+        // Layout of a transition: the next state in bits 0-7,
+        // emitted symbols in bits 8-15 and 16-23, their number
+        // in bits 24-25, bit 26 is set if the octet is invalid.
+        stateMask = 0xff,
+        symbolCountShift = 24,
+        failure = 1u << 26
+    };
 
-    std::vector<PrefixTable> prefixTables;
-    std::vector<PrefixTableEntry> tableData;
-    quint32 minCodeLength;
+    // Indexed by (state << 8 | octet):
+    std::vector<quint32> transitions;
+    // Ending the input in these states is valid padding:
+    std::vector<bool> accepting;
 };
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer);
+bool huffman_decode_string(const uchar *first, const uchar *last, QByteArray *outputBuffer);
 
 } // namespace HPack
 
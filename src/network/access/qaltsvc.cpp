@@ -0,0 +1,333 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qaltsvc_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QAltSvcCache remembers the alternative services (RFC 7838) the origins
+    advertised with their Alt-Svc response header fields. This is the
+    discovery part an HTTP/3 backend needs: an origin reached over TCP
+    announces the UDP endpoint where it speaks "h3".
+*/
+
+void QAltSvcCache::updateFromHeaders(const QList<QPair<QByteArray, QByteArray>> &headers,
+                                     const QUrl &origin)
+{
+    if (!origin.isValid() || origin.host().isEmpty())
+        return;
+
+    QAltSvcHeaderParser parser;
+    if (!parser.parse(headers))
+        return;
+
+    const QString key = originKey(origin);
+    if (parser.clearAlternatives()) {
+        knownOrigins.remove(key);
+        return;
+    }
+
+    // RFC 7838, 3:
+    // "When an Alt-Svc response header field is received from an origin, its
+    // value invalidates and replaces all cached alternative services for that
+    // origin."
+    QList<QAltSvcEntry> entries = parser.alternatives();
+    for (QAltSvcEntry &entry : entries) {
+        if (entry.host.isEmpty())
+            entry.host = origin.host();
+    }
+    knownOrigins.insert(key, entries);
+}
+
+QList<QAltSvcEntry> QAltSvcCache::alternatives(const QUrl &origin) const
+{
+    const auto it = knownOrigins.find(originKey(origin));
+    if (it == knownOrigins.end())
+        return {};
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    it->removeIf([&now](const QAltSvcEntry &entry) { return entry.expires <= now; });
+    if (it->isEmpty()) {
+        knownOrigins.erase(it);
+        return {};
+    }
+
+    return *it;
+}
+
+void QAltSvcCache::clear()
+{
+    knownOrigins.clear();
+}
+
+QString QAltSvcCache::originKey(const QUrl &origin)
+{
+    const QString scheme = origin.scheme().toLower();
+    const int defaultPort = scheme == QLatin1String("https") ? 443 : 80;
+    return scheme + QLatin1String("://") + origin.host().toLower()
+           + QLatin1Char(':') + QString::number(origin.port(defaultPort));
+}
+
+/*
+
+RFC 7838, 3. The Alt-Svc HTTP Header Field.
+Syntax:
+
+Alt-Svc       = clear / 1#alt-value
+clear         = %s"clear"; "clear", case-sensitive
+alt-value     = alternative *( OWS ";" OWS parameter )
+alternative   = protocol-id "=" alt-authority
+protocol-id   = token ; percent-encoded ALPN protocol name
+alt-authority = quoted-string ; containing [ uri-host ] ":" port
+parameter     = token "=" ( token / quoted-string )
+
+Several Alt-Svc header fields are combined into one list, as with any other
+list-based field. A header we fail to parse is ignored as a whole.
+
+*/
+
+bool QAltSvcHeaderParser::parse(const QList<QPair<QByteArray, QByteArray>> &headers)
+{
+    header.clear();
+    for (const auto &h : headers) {
+        if (h.first.compare("alt-svc", Qt::CaseInsensitive) == 0) {
+            if (!header.isEmpty())
+                header += ", ";
+            header += h.second;
+        }
+    }
+
+    if (header.isEmpty())
+        return false;
+
+    if (!parseAltSvcHeader()) {
+        entries.clear();
+        clearFound = false;
+        return false;
+    }
+
+    return true;
+}
+
+static bool isOWS(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+static bool isTCHAR(char c)
+{
+    // RFC 7230, 3.2.6:
+    // tchar = "!" / "#" / "$" / "%" / "&" / "'" / "*" / "+" / "-" / "." /
+    //         "^" / "_" / "`" / "|" / "~" / DIGIT / ALPHA
+    static const char specials[] = "!#$%&'*+-.^_`|~";
+    static const char *end = specials + sizeof specials - 1;
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+           || std::find(specials, end, c) != end;
+}
+
+bool QAltSvcHeaderParser::parseAltSvcHeader()
+{
+    entries.clear();
+    clearFound = false;
+    pos = 0;
+
+    if (header.trimmed() == "clear") {
+        clearFound = true;
+        return true;
+    }
+
+    // 1#alt-value, the list can have empty elements:
+    while (true) {
+        skipOWS();
+        if (pos == header.size())
+            break;
+
+        if (header[pos] == ',') {
+            ++pos;
+            continue;
+        }
+
+        if (!parseAltValue())
+            return false;
+
+        skipOWS();
+        if (pos < header.size() && header[pos] != ',')
+            return false;
+    }
+
+    return !entries.isEmpty();
+}
+
+bool QAltSvcHeaderParser::parseAltValue()
+{
+    QByteArray protocolId;
+    if (!parseToken(protocolId))
+        return false;
+
+    if (pos == header.size() || header[pos] != '=')
+        return false;
+    ++pos;
+
+    QByteArray authority;
+    if (!parseQuotedString(authority))
+        return false;
+
+    const int colon = authority.lastIndexOf(':');
+    if (colon < 0)
+        return false;
+
+    bool ok = false;
+    const uint port = authority.mid(colon + 1).toUInt(&ok);
+    if (!ok || !port || port > 0xffff)
+        return false;
+
+    QAltSvcEntry entry;
+    entry.protocolId = QByteArray::fromPercentEncoding(protocolId);
+    entry.port = quint16(port);
+    QByteArray host = authority.left(colon);
+    if (host.startsWith('[')) {
+        if (!host.endsWith(']'))
+            return false;
+        host = host.mid(1, host.size() - 2);
+    }
+    entry.host = QString::fromLatin1(host);
+
+    bool maxAgeFound = false;
+    while (true) {
+        skipOWS();
+        if (pos == header.size() || header[pos] != ';')
+            break;
+        ++pos;
+        skipOWS();
+        if (!parseParameter(entry, maxAgeFound))
+            return false;
+    }
+
+    // RFC 7838, 3.1: "If ma is not present, [...] the default value of 24 hours
+    // is used."
+    if (!maxAgeFound)
+        entry.expires = QDateTime::currentDateTimeUtc().addSecs(24 * 60 * 60);
+
+    entries.append(entry);
+    return true;
+}
+
+bool QAltSvcHeaderParser::parseParameter(QAltSvcEntry &entry, bool &maxAgeFound)
+{
+    QByteArray name;
+    if (!parseToken(name))
+        return false;
+
+    if (pos == header.size() || header[pos] != '=')
+        return false;
+    ++pos;
+
+    QByteArray value;
+    if (pos < header.size() && header[pos] == '"') {
+        if (!parseQuotedString(value))
+            return false;
+    } else if (!parseToken(value)) {
+        return false;
+    }
+
+    if (name.compare("ma", Qt::CaseInsensitive) == 0) {
+        bool ok = false;
+        const qint64 maxAge = value.toLongLong(&ok);
+        if (!ok || maxAge < 0)
+            return false;
+        entry.expires = QDateTime::currentDateTimeUtc().addSecs(maxAge);
+        maxAgeFound = true;
+    } else if (name.compare("persist", Qt::CaseInsensitive) == 0) {
+        // RFC 7838, 3.1: "This specification only defines a single value for
+        // persist; clients MUST ignore persist parameters with values other
+        // than 1."
+        entry.persist = value == "1";
+    } // else we skip unknown parameters (RFC 7838, 3).
+
+    return true;
+}
+
+bool QAltSvcHeaderParser::parseToken(QByteArray &dst)
+{
+    const int start = pos;
+    while (pos < header.size() && isTCHAR(header[pos]))
+        ++pos;
+
+    dst = header.mid(start, pos - start);
+    return !dst.isEmpty();
+}
+
+bool QAltSvcHeaderParser::parseQuotedString(QByteArray &dst)
+{
+    dst.clear();
+    if (pos == header.size() || header[pos] != '"')
+        return false;
+
+    for (++pos; pos < header.size(); ++pos) {
+        const char c = header[pos];
+        if (c == '"') {
+            ++pos;
+            return true;
+        }
+
+        if (c == '\\') {
+            // quoted-pair = "\" ( HTAB / SP / VCHAR / obs-text )
+            if (++pos == header.size())
+                return false;
+            dst.append(header[pos]);
+        } else if ((c >= 0 && c < ' ' && c != '\t') || c == 127) {
+            return false;
+        } else {
+            dst.append(c);
+        }
+    }
+
+    return false; // No closing '"'.
+}
+
+void QAltSvcHeaderParser::skipOWS()
+{
+    while (pos < header.size() && isOWS(header[pos]))
+        ++pos;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QALTSVC_P_H
+#define QALTSVC_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+// RFC 7838, an alternative service advertised by an origin:
+struct QAltSvcEntry
+{
+    QByteArray protocolId; // ALPN protocol id, e.g. "h2" or "h3"
+    QString host; // the origin's host if the authority had none
+    quint16 port = 0;
+    QDateTime expires;
+    bool persist = false;
+};
+
+class Q_AUTOTEST_EXPORT QAltSvcCache
+{
+public:
+
+    void updateFromHeaders(const QList<QPair<QByteArray, QByteArray>> &headers,
+                           const QUrl &origin);
+    QList<QAltSvcEntry> alternatives(const QUrl &origin) const;
+    void clear();
+
+private:
+
+    static QString originKey(const QUrl &origin);
+
+    mutable QHash<QString, QList<QAltSvcEntry>> knownOrigins;
+};
+
+class Q_AUTOTEST_EXPORT QAltSvcHeaderParser
+{
+public:
+
+    bool parse(const QList<QPair<QByteArray, QByteArray>> &headers);
+
+    // True if the (valid) header was the special value 'clear':
+    bool clearAlternatives() const { return clearFound; }
+    QList<QAltSvcEntry> alternatives() const { return entries; }
+
+private:
+
+    bool parseAltSvcHeader();
+    bool parseAltValue();
+    bool parseParameter(QAltSvcEntry &entry, bool &maxAgeFound);
+    bool parseToken(QByteArray &dst);
+    bool parseQuotedString(QByteArray &dst);
+    void skipOWS();
+
+    QByteArray header;
+    int pos = 0;
+
+    QList<QAltSvcEntry> entries;
+    bool clearFound = false;
+};
+
+QT_END_NAMESPACE
+
+#endif
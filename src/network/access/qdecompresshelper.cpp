@@ -40,6 +40,7 @@
 #include "qdecompresshelper_p.h"
 
 #include <QtCore/private/qbytearray_p.h>
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qiodevice.h>
 
 #include <limits>
@@ -47,6 +48,10 @@
 
 #if QT_CONFIG(brotli)
 #    include <brotli/decode.h>
+#    if __has_include(<brotli/shared_dictionary.h>)
+#        include <brotli/shared_dictionary.h>
+#        define QT_BROTLI_HAS_SHARED_DICTIONARY
+#    endif
 #endif
 
 #if QT_CONFIG(zstd)
@@ -74,6 +79,28 @@ constexpr ContentEncodingMapping contentEncodingMapping[] {
     { "deflate", QDecompressHelper::Deflate },
 };
 
+// Compression Dictionary Transport: the stream is prefixed with a magic
+// number and the SHA-256 hash of the dictionary it was compressed with.
+struct DictionaryEncodingMapping
+{
+    char name[4];
+    QDecompressHelper::ContentEncoding encoding;
+    char magic[8];
+    qsizetype magicSize;
+};
+
+constexpr qsizetype DictionaryHashSize = 32;
+
+constexpr DictionaryEncodingMapping dictionaryEncodingMapping[] {
+#if QT_CONFIG(zstd)
+    { "dcz", QDecompressHelper::Zstandard, { '\x5e', '\x2a', '\x4d', '\x18', '\x20', 0, 0, 0 }, 8 },
+#endif
+#if QT_CONFIG(brotli) && defined(QT_BROTLI_HAS_SHARED_DICTIONARY)
+    { "dcb", QDecompressHelper::Brotli, { '\xff', '\x44', '\x43', '\x42' }, 4 },
+#endif
+    { "", QDecompressHelper::None, {}, 0 }
+};
+
 QDecompressHelper::ContentEncoding encodingFromByteArray(const QByteArray &ce) noexcept
 {
     for (const auto &mapping : contentEncodingMapping) {
@@ -83,6 +110,18 @@ QDecompressHelper::ContentEncoding encodingFromByteArray(const QByteArray &ce) n
     return QDecompressHelper::None;
 }
 
+const DictionaryEncodingMapping *dictionaryEncodingFromByteArray(const QByteArray &ce) noexcept
+{
+    for (const auto &mapping : dictionaryEncodingMapping) {
+        if (mapping.encoding != QDecompressHelper::None
+            && ce.compare(QByteArrayView(mapping.name, strlen(mapping.name)),
+                          Qt::CaseInsensitive) == 0) {
+            return &mapping;
+        }
+    }
+    return nullptr;
+}
+
 z_stream *toZlibPointer(void *ptr)
 {
     return static_cast<z_stream_s *>(ptr);
@@ -105,7 +144,8 @@ ZSTD_DStream *toZstandardPointer(void *ptr)
 
 bool QDecompressHelper::isSupportedEncoding(const QByteArray &encoding)
 {
-    return encodingFromByteArray(encoding) != QDecompressHelper::None;
+    return encodingFromByteArray(encoding) != QDecompressHelper::None
+            || dictionaryEncodingFromByteArray(encoding);
 }
 
 QByteArrayList QDecompressHelper::acceptedEncoding()
@@ -121,6 +161,24 @@ QByteArrayList QDecompressHelper::acceptedEncoding()
     return accepted;
 }
 
+/*!
+    \internal
+    Returns the Compression Dictionary Transport encodings that can be
+    decoded, provided a dictionary was set with setDictionary().
+*/
+QByteArrayList QDecompressHelper::acceptedDictionaryEncoding()
+{
+    static QByteArrayList accepted = []() {
+        QByteArrayList list;
+        for (const auto &mapping : dictionaryEncodingMapping) {
+            if (mapping.encoding != QDecompressHelper::None)
+                list << QByteArray(mapping.name);
+        }
+        return list;
+    }();
+    return accepted;
+}
+
 QDecompressHelper::~QDecompressHelper()
 {
     clear();
@@ -133,6 +191,14 @@ bool QDecompressHelper::setEncoding(const QByteArray &encoding)
         qWarning("Encoding is already set.");
         return false;
     }
+    if (const DictionaryEncodingMapping *mapping = dictionaryEncodingFromByteArray(encoding)) {
+        if (sharedDictionary.isEmpty()) {
+            qWarning("The content encoding %s requires a dictionary.", encoding.data());
+            return false;
+        }
+        dictionaryHeaderSize = mapping->magicSize + DictionaryHashSize;
+        return setEncoding(mapping->encoding);
+    }
     ContentEncoding ce = encodingFromByteArray(encoding);
     if (ce == None) {
         qWarning("An unsupported content encoding was selected: %s", encoding.data());
@@ -166,6 +232,16 @@ bool QDecompressHelper::setEncoding(ContentEncoding ce)
     case Brotli:
 #if QT_CONFIG(brotli)
         decoderPointer = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+#if defined(QT_BROTLI_HAS_SHARED_DICTIONARY)
+        if (decoderPointer && dictionaryHeaderSize != 0
+            && !BrotliDecoderAttachDictionary(
+                    toBrotliPointer(decoderPointer), BROTLI_SHARED_DICTIONARY_RAW,
+                    size_t(sharedDictionary.size()),
+                    reinterpret_cast<const uint8_t *>(sharedDictionary.constData()))) {
+            BrotliDecoderDestroyInstance(toBrotliPointer(decoderPointer));
+            decoderPointer = nullptr;
+        }
+#endif
 #else
         Q_UNREACHABLE();
 #endif
@@ -173,6 +249,20 @@ bool QDecompressHelper::setEncoding(ContentEncoding ce)
     case Zstandard:
 #if QT_CONFIG(zstd)
         decoderPointer = ZSTD_createDStream();
+        if (decoderPointer && !sharedDictionary.isEmpty()) {
+            ZSTD_DStream *zstdStream = toZstandardPointer(decoderPointer);
+#if ZSTD_VERSION_NUMBER >= 10400
+            const size_t ret = ZSTD_DCtx_loadDictionary(zstdStream, sharedDictionary.constData(),
+                                                        size_t(sharedDictionary.size()));
+#else
+            const size_t ret = ZSTD_initDStream_usingDict(zstdStream, sharedDictionary.constData(),
+                                                          size_t(sharedDictionary.size()));
+#endif
+            if (ZSTD_isError(ret)) {
+                ZSTD_freeDStream(zstdStream);
+                decoderPointer = nullptr;
+            }
+        }
 #else
         Q_UNREACHABLE();
 #endif
@@ -181,11 +271,43 @@ bool QDecompressHelper::setEncoding(ContentEncoding ce)
     if (!decoderPointer) {
         qWarning("Failed to initialize the decoder.");
         contentEncoding = QDecompressHelper::None;
+        dictionaryHeaderSize = 0;
         return false;
     }
     return true;
 }
 
+/*!
+    \internal
+
+    Returns the shared dictionary used for decompression.
+
+    \sa setDictionary
+*/
+QByteArray QDecompressHelper::dictionary() const
+{
+    return sharedDictionary;
+}
+
+/*!
+    \internal
+
+    Sets the shared \a dictionary the data was compressed with. It is used
+    as the preset dictionary of zlib streams that ask for one, is loaded into
+    the Zstandard decoder, and is required for the Compression Dictionary
+    Transport encodings ("dcb" and "dcz"), where the hash in the stream
+    header must match it.
+
+    \note Can only be called before contentEncoding is set.
+
+    \sa dictionary, acceptedDictionaryEncoding
+*/
+void QDecompressHelper::setDictionary(const QByteArray &dictionary)
+{
+    Q_ASSERT(contentEncoding == None);
+    sharedDictionary = dictionary;
+}
+
 /*!
     \internal
 
@@ -349,6 +471,8 @@ bool QDecompressHelper::countInternal(const QByteArray &data)
         if (!countHelper) {
             countHelper = std::make_unique<QDecompressHelper>();
             countHelper->setDecompressedSafetyCheckThreshold(archiveBombCheckThreshold);
+            countHelper->setDictionary(sharedDictionary);
+            countHelper->dictionaryHeaderSize = dictionaryHeaderSize;
             countHelper->setEncoding(contentEncoding);
         }
         countHelper->feed(data);
@@ -367,6 +491,8 @@ bool QDecompressHelper::countInternal(const QByteDataBuffer &buffer)
         if (!countHelper) {
             countHelper = std::make_unique<QDecompressHelper>();
             countHelper->setDecompressedSafetyCheckThreshold(archiveBombCheckThreshold);
+            countHelper->setDictionary(sharedDictionary);
+            countHelper->dictionaryHeaderSize = dictionaryHeaderSize;
             countHelper->setEncoding(contentEncoding);
         }
         countHelper->feed(buffer);
@@ -415,6 +541,11 @@ qsizetype QDecompressHelper::readInternal(char *data, qsizetype maxSize)
     if (!hasDataInternal())
         return 0;
 
+    if (dictionaryHeaderSize != 0 && !readDictionaryHeader()) {
+        clear();
+        return -1;
+    }
+
     qsizetype bytesRead = -1;
     switch (contentEncoding) {
     case None:
@@ -509,6 +640,8 @@ bool QDecompressHelper::hasData() const
 */
 bool QDecompressHelper::hasDataInternal() const
 {
+    if (dictionaryHeaderSize != 0)
+        return encodedBytesAvailable() >= dictionaryHeaderSize;
     return encodedBytesAvailable() || decoderHasData;
 }
 
@@ -517,6 +650,36 @@ qint64 QDecompressHelper::encodedBytesAvailable() const
     return compressedDataBuffer.byteAmount();
 }
 
+/*!
+    \internal
+    Consumes the Compression Dictionary Transport header and checks that
+    the stream was compressed with our dictionary.
+*/
+bool QDecompressHelper::readDictionaryHeader()
+{
+    Q_ASSERT(encodedBytesAvailable() >= dictionaryHeaderSize);
+    QByteArray header(dictionaryHeaderSize, Qt::Uninitialized);
+    compressedDataBuffer.read(header.data(), header.size());
+    dictionaryHeaderSize = 0;
+
+    for (const auto &mapping : dictionaryEncodingMapping) {
+        if (mapping.encoding != contentEncoding)
+            continue;
+        const QByteArrayView magic(mapping.magic, mapping.magicSize);
+        if (!header.startsWith(magic))
+            break;
+        const QByteArray hash =
+                QCryptographicHash::hash(sharedDictionary, QCryptographicHash::Sha256);
+        if (header.sliced(mapping.magicSize) != hash) {
+            qWarning("The stream was compressed with a different dictionary.");
+            return false;
+        }
+        return true;
+    }
+    qWarning("Invalid dictionary-compressed stream header.");
+    return false;
+}
+
 bool QDecompressHelper::isValid() const
 {
     return contentEncoding != None;
@@ -558,6 +721,7 @@ void QDecompressHelper::clear()
     compressedDataBuffer.clear();
     decompressedDataBuffer.clear();
     decoderHasData = false;
+    dictionaryHeaderSize = 0;
 
     countDecompressed = false;
     countHelper.reset();
@@ -569,6 +733,8 @@ void QDecompressHelper::clear()
 qsizetype QDecompressHelper::readZLib(char *data, const qsizetype maxSize)
 {
     bool triedRawDeflate = false;
+    const Bytef *dictionaryData = reinterpret_cast<const Bytef *>(sharedDictionary.constData());
+    const uInt dictionarySize = uInt(sharedDictionary.size());
 
     z_stream *inflateStream = toZlibPointer(decoderPointer);
     static const size_t zlibMaxSize =
@@ -591,7 +757,7 @@ qsizetype QDecompressHelper::readZLib(char *data, const qsizetype maxSize)
         auto previous_avail_out = inflateStream->avail_out;
         int ret = inflate(inflateStream, Z_NO_FLUSH);
         // All negative return codes are errors, in the context of HTTP compression, Z_NEED_DICT is
-        // also an error.
+        // also an error unless a shared dictionary was set.
         // in the case where we get Z_DATA_ERROR this could be because we received raw deflate
         // compressed data.
         if (ret == Z_DATA_ERROR && !triedRawDeflate) {
@@ -603,6 +769,8 @@ qsizetype QDecompressHelper::readZLib(char *data, const qsizetype maxSize)
             inflateStream->avail_in = 0;
             inflateStream->next_in = Z_NULL;
             int ret = inflateInit2(inflateStream, -MAX_WBITS);
+            if (ret == Z_OK && !sharedDictionary.isEmpty())
+                ret = inflateSetDictionary(inflateStream, dictionaryData, dictionarySize);
             if (ret != Z_OK) {
                 return -1;
             } else {
@@ -611,6 +779,10 @@ qsizetype QDecompressHelper::readZLib(char *data, const qsizetype maxSize)
                         reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
                 continue;
             }
+        } else if (ret == Z_NEED_DICT && !sharedDictionary.isEmpty()
+                   && inflateSetDictionary(inflateStream, dictionaryData, dictionarySize)
+                           == Z_OK) {
+            continue;
         } else if (ret < 0 || ret == Z_NEED_DICT) {
             return -1;
         }
@@ -75,6 +75,9 @@ public:
 
     bool setEncoding(const QByteArray &contentEncoding);
 
+    QByteArray dictionary() const;
+    void setDictionary(const QByteArray &dictionary);
+
     bool isCountingBytes() const;
     void setCountingBytesEnabled(bool shouldCount);
 
@@ -95,6 +98,7 @@ public:
 
     static bool isSupportedEncoding(const QByteArray &encoding);
     static QByteArrayList acceptedEncoding();
+    static QByteArrayList acceptedDictionaryEncoding();
 
 private:
     bool isPotentialArchiveBomb() const;
@@ -107,6 +111,7 @@ private:
 
     bool setEncoding(ContentEncoding ce);
     qint64 encodedBytesAvailable() const;
+    bool readDictionaryHeader();
 
     qsizetype readZLib(char *data, qsizetype maxSize);
     qsizetype readBrotli(char *data, qsizetype maxSize);
@@ -128,6 +133,11 @@ private:
 
     ContentEncoding contentEncoding = None;
 
+    // Shared dictionary, and for the Compression Dictionary Transport
+    // encodings the size of the header that still precedes the stream
+    QByteArray sharedDictionary;
+    qsizetype dictionaryHeaderSize = 0;
+
     void *decoderPointer = nullptr;
 #if QT_CONFIG(brotli)
     const uint8_t *brotliUnconsumedDataPtr = nullptr;
@@ -77,6 +77,9 @@ QT_BEGIN_NAMESPACE
       \li The server push. Allows to enable or disable server push. Sent
          as 'SETTINGS_ENABLE_PUSH' parameter in the initial 'SETTINGS'
          frame.
+      \li The receive window autotuning. Allows QNetworkAccessManager to
+         grow the receive windows beyond their initial sizes, based on
+         the bandwidth-delay product it measures on the connection.
     \endlist
 
     The QHttp2Configuration class also controls if the header compression
@@ -105,6 +108,8 @@ public:
     bool pushEnabled = false;
     // TODO: for now those two below are noop.
     bool huffmanCompressionEnabled = true;
+
+    bool windowAutoTuningEnabled = false;
 };
 
 /*!
@@ -117,6 +122,7 @@ public:
         \li Window size for connection-level flow control is 65535 octets
         \li Window size for stream-level flow control is 65535 octets
         \li Frame size is 16384 octets
+        \li Receive window autotuning is disabled
     \endlist
 */
 QHttp2Configuration::QHttp2Configuration()
@@ -289,6 +295,40 @@ unsigned QHttp2Configuration::maxFrameSize() const
     return d->maxFrameSize;
 }
 
+/*!
+    \since 6.4
+
+    If \a enable is \c true, QNetworkAccessManager estimates the
+    bandwidth-delay product of the connection while receiving data and
+    grows the stream and session receive windows when they limit the
+    throughput, up to 2147483647 octets. sessionReceiveWindowSize() and
+    streamReceiveWindowSize() are then only the initial window sizes.
+
+    The estimate is obtained by sending a 'PING' frame when 'DATA' is
+    received, and counting the octets received until it is acknowledged.
+    The stream window is grown by sending a new 'SETTINGS' frame with
+    'SETTINGS_INITIAL_WINDOW_SIZE' parameter.
+
+    \sa windowAutoTuningEnabled()
+*/
+void QHttp2Configuration::setWindowAutoTuningEnabled(bool enable)
+{
+    d->windowAutoTuningEnabled = enable;
+}
+
+/*!
+    \since 6.4
+
+    Returns \c true if the receive windows are grown based on the
+    bandwidth-delay product estimate. Disabled by default.
+
+    \sa setWindowAutoTuningEnabled()
+*/
+bool QHttp2Configuration::windowAutoTuningEnabled() const
+{
+    return d->windowAutoTuningEnabled;
+}
+
 /*!
     Swaps this configuration with the \a other configuration.
 */
@@ -320,7 +360,8 @@ bool QHttp2Configuration::isEqual(const QHttp2Configuration &other) const noexce
     return d->pushEnabled == other.d->pushEnabled
            && d->huffmanCompressionEnabled == other.d->huffmanCompressionEnabled
            && d->sessionWindowSize == other.d->sessionWindowSize
-           && d->streamWindowSize == other.d->streamWindowSize;
+           && d->streamWindowSize == other.d->streamWindowSize
+           && d->windowAutoTuningEnabled == other.d->windowAutoTuningEnabled;
 }
 
 QT_END_NAMESPACE
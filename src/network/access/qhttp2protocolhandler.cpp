@@ -182,6 +182,7 @@ QHttp2ProtocolHandler::QHttp2ProtocolHandler(QHttpNetworkConnectionChannel *chan
     pushPromiseEnabled = h2Config.serverPushEnabled();
     streamInitialReceiveWindowSize = h2Config.streamReceiveWindowSize();
     encoder.setCompressStrings(h2Config.huffmanCompressionEnabled());
+    windowAutoTuning = h2Config.windowAutoTuningEnabled();
 
     if (!channel->ssl && m_connection->connectionType() != QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
         // We upgraded from HTTP/1.1 to HTTP/2. channel->request was already sent
@@ -612,6 +613,9 @@ void QHttp2ProtocolHandler::handleDATA()
 
     sessionReceiveWindowSize -= inboundFrame.payloadSize();
 
+    if (windowAutoTuning)
+        sampleBandwidthDelayProduct(inboundFrame.payloadSize());
+
     if (activeStreams.contains(streamID)) {
         auto &stream = activeStreams[streamID];
 
@@ -832,16 +836,98 @@ void QHttp2ProtocolHandler::handlePING()
     if (inboundFrame.streamID() != connectionStreamID)
         return connectionError(PROTOCOL_ERROR, "PING on invalid stream");
 
-    if (inboundFrame.flags() & FrameFlag::ACK)
-        return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
-
     Q_ASSERT(inboundFrame.dataSize() == 8);
 
+    if (inboundFrame.flags() & FrameFlag::ACK) {
+        // The only PING we send is the one estimating the bandwidth-delay product:
+        if (!bdpPingInFlight || qFromBigEndian<quint64>(inboundFrame.dataBegin()) != bdpPingID)
+            return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
+        bdpPingInFlight = false;
+        return updateBandwidthDelayProduct();
+    }
+
     frameWriter.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
     frameWriter.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
     frameWriter.write(*m_socket);
 }
 
+void QHttp2ProtocolHandler::sampleBandwidthDelayProduct(quint32 dataSize)
+{
+    Q_ASSERT(windowAutoTuning);
+    Q_ASSERT(m_socket);
+
+    if (bdpPingInFlight) {
+        bdpSample += dataSize;
+        return;
+    }
+
+    if (streamInitialReceiveWindowSize == Http2::maxSessionReceiveWindowSize)
+        return; // Nothing left to tune.
+
+    frameWriter.start(FrameType::PING, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(++bdpPingID);
+    if (!frameWriter.write(*m_socket))
+        return;
+
+    bdpPingInFlight = true;
+    bdpSample = dataSize;
+    bdpPingTimer.start();
+}
+
+void QHttp2ProtocolHandler::updateBandwidthDelayProduct()
+{
+    // This is the estimator gRPC uses: the round-trip time is smoothed, and the
+    // window is only grown if the sample filled most of it (so it was likely
+    // the bottleneck) and the bandwidth did not drop (so the sample is not
+    // just inflated by a longer round-trip time).
+    const double rttSample = double(std::max<qint64>(bdpPingTimer.nsecsElapsed(), 1));
+    bdpRtt = bdpRtt > 0 ? bdpRtt + (rttSample - bdpRtt) * 0.9 : rttSample;
+
+    if (bdpSample < qint64(streamInitialReceiveWindowSize) * 2 / 3)
+        return;
+
+    const double bandwidth = double(bdpSample) / bdpRtt;
+    if (bandwidth < bdpBandwidthMax)
+        return;
+    bdpBandwidthMax = bandwidth;
+
+    growReceiveWindows(qint32(std::min<qint64>(bdpSample * 2, Http2::maxSessionReceiveWindowSize)));
+}
+
+bool QHttp2ProtocolHandler::growReceiveWindows(qint32 windowSize)
+{
+    Q_ASSERT(m_socket);
+
+    if (windowSize > maxSessionReceiveWindowSize) {
+        const qint32 delta = windowSize - maxSessionReceiveWindowSize;
+        maxSessionReceiveWindowSize = windowSize;
+        sessionReceiveWindowSize += delta;
+        if (!sendWINDOW_UPDATE(connectionStreamID, delta))
+            return false;
+    }
+
+    // We'll grow the stream window on the next estimate, once our
+    // previous SETTINGS were ACKed:
+    if (windowSize <= streamInitialReceiveWindowSize || waitingForSettingsACK)
+        return true;
+
+    // 6.9.2: a change of SETTINGS_INITIAL_WINDOW_SIZE also adjusts the
+    // windows of all the streams that are already open.
+    frameWriter.start(FrameType::SETTINGS, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(Settings::INITIAL_WINDOW_SIZE_ID);
+    frameWriter.append(quint32(windowSize));
+    if (!frameWriter.write(*m_socket))
+        return false;
+
+    waitingForSettingsACK = true;
+    const qint32 delta = windowSize - streamInitialReceiveWindowSize;
+    streamInitialReceiveWindowSize = windowSize;
+    for (Stream &stream : activeStreams)
+        stream.recvWindow += delta;
+
+    return true;
+}
+
 void QHttp2ProtocolHandler::handleGOAWAY()
 {
     // 6.8 GOAWAY
@@ -1351,6 +1437,7 @@ quint32 QHttp2ProtocolHandler::createNewStream(const HttpMessagePair &message, b
     replyPrivate->connection = m_connection;
     replyPrivate->connectionChannel = m_channel;
     reply->setHttp2WasUsed(true);
+    m_channel->recordConnectionTiming(reply);
     streamIDs.insert(reply, newStreamID);
     connect(reply, SIGNAL(destroyed(QObject*)),
             this, SLOT(_q_replyDestroyed(QObject*)));
@@ -1369,6 +1456,7 @@ quint32 QHttp2ProtocolHandler::createNewStream(const HttpMessagePair &message, b
         }
     }
 
+    replyPrivate->recordTiming(QNetworkReplyTiming::RequestSent);
     QMetaObject::invokeMethod(reply, "requestSent", Qt::QueuedConnection);
 
     activeStreams.insert(newStreamID, newStream);
@@ -65,6 +65,7 @@
 
 #include <QtCore/qnamespace.h>
 #include <QtCore/qbytearray.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qglobal.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qflags.h>
@@ -115,6 +116,11 @@ private:
     bool sendRST_STREAM(quint32 streamID, quint32 errorCoder);
     bool sendGOAWAY(quint32 errorCode);
 
+    // Receive window autotuning:
+    void sampleBandwidthDelayProduct(quint32 dataSize);
+    void updateBandwidthDelayProduct();
+    bool growReceiveWindows(qint32 windowSize);
+
     void handleDATA();
     void handleHEADERS();
     void handlePRIORITY();
@@ -151,9 +157,10 @@ private:
     bool streamWasReset(quint32 streamID) const;
 
     bool prefaceSent = false;
-    // In the current implementation we send
-    // SETTINGS only once, immediately after
-    // the client's preface 24-byte message.
+    // We send SETTINGS immediately after the client's
+    // preface 24-byte message, and then only when the
+    // receive window autotuning grows the stream window.
+    // At most one of them is waiting for ACK.
     bool waitingForSettingsACK = false;
 
     static const quint32 maxAcceptableTableSize = 16 * HPack::FieldLookupTable::DefaultSize;
@@ -202,6 +209,20 @@ private:
     // from QHttp2Configuration. Again, signed - can become negative.
     qint32 streamInitialReceiveWindowSize = Http2::defaultSessionWindowSize;
 
+    // Receive window autotuning (QHttp2Configuration::windowAutoTuningEnabled()).
+    // While our PING is in flight, we count the octets of DATA received;
+    // once the PING is ACKed, this sample approximates the bandwidth-delay
+    // product, and the receive windows are grown if they are the bottleneck.
+    bool windowAutoTuning = false;
+    bool bdpPingInFlight = false;
+    quint64 bdpPingID = 0;
+    qint64 bdpSample = 0;
+    QElapsedTimer bdpPingTimer;
+    // Smoothed round-trip time in nanoseconds and the highest bandwidth
+    // (octets per nanosecond) measured so far:
+    double bdpRtt = 0;
+    double bdpBandwidthMax = 0;
+
     // These are our peer's receive window sizes, they will be updated by the
     // peer's SETTINGS and WINDOW_UPDATE frames, defaults presumed to be 64Kb.
     qint32 sessionSendWindowSize = Http2::defaultSessionWindowSize;
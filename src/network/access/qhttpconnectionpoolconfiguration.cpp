@@ -0,0 +1,310 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qhttpconnectionpoolconfiguration.h"
+
+#include "private/qhttpnetworkconnection_p.h"
+
+#include "qdebug.h"
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QHttpConnectionPoolConfiguration
+    \brief The QHttpConnectionPoolConfiguration class controls how QNetworkAccessManager
+    pools its HTTP/1 connections.
+    \since 6.4
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    QNetworkAccessManager keeps the TCP (and TLS) connections it opened to a
+    host in a pool, so that subsequent requests to the same host can reuse
+    them. QHttpConnectionPoolConfiguration controls the size and the lifetime
+    of that pool:
+
+    \list
+      \li The maximum number of connections opened in parallel to one host.
+         Requests that do not find a free connection are queued until one
+         becomes available.
+      \li The maximum number of connections to one host that are kept open
+         while no request is using them.
+      \li How long a host's connections are kept open after the last request
+         to that host finished.
+      \li How many connections QNetworkAccessManager::connectToHost() and
+         QNetworkAccessManager::connectToHostEncrypted() open in advance.
+    \endlist
+
+    The configuration applies to HTTP/1 only. When HTTP/2 is negotiated with
+    a host, all requests to that host are multiplexed over one connection.
+
+    \note The configuration must be set before the first request
+    is sent to a given host, since it is applied when the connection
+    pool for that host is created.
+
+    \sa QNetworkAccessManager::setConnectionPoolConfiguration(), QHttp2Configuration
+*/
+
+class QHttpConnectionPoolConfigurationPrivate : public QSharedData
+{
+public:
+    int maximumConnectionsPerHost = QHttpNetworkConnectionPrivate::defaultHttpChannelCount;
+    int maximumIdleConnectionsPerHost = -1;
+    std::chrono::seconds idleTimeout = std::chrono::seconds(120);
+    int preconnectCount = 1;
+};
+
+/*!
+    Default constructs a QHttpConnectionPoolConfiguration object.
+
+    Such a configuration has the following values:
+    \list
+        \li At most 6 connections per host
+        \li No limit on idle connections other than the maximum number of connections
+        \li Idle connections are closed after 120 seconds
+        \li One connection is opened when preconnecting
+    \endlist
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration()
+    : d(new QHttpConnectionPoolConfigurationPrivate)
+{
+}
+
+/*!
+    Copy-constructs this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration(
+        const QHttpConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-constructs this QHttpConnectionPoolConfiguration from \a other
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration(
+        QHttpConnectionPoolConfiguration &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration &QHttpConnectionPoolConfiguration::operator=(
+        const QHttpConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-assigns \a other to this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration &QHttpConnectionPoolConfiguration::operator=(
+        QHttpConnectionPoolConfiguration &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolConfiguration::~QHttpConnectionPoolConfiguration()
+{
+}
+
+/*!
+    Sets the maximum number of connections opened in parallel to one host
+    to \a count. \a count must be between 1 and 65535 inclusive.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa maximumConnectionsPerHost()
+*/
+bool QHttpConnectionPoolConfiguration::setMaximumConnectionsPerHost(int count)
+{
+    if (count < 1 || count > std::numeric_limits<quint16>::max()) {
+        qWarning("QHttpConnectionPoolConfiguration: Invalid number of connections per host");
+        return false;
+    }
+
+    d->maximumConnectionsPerHost = count;
+    return true;
+}
+
+/*!
+    Returns the maximum number of connections opened in parallel to one host.
+    The default value is 6.
+
+    \sa setMaximumConnectionsPerHost()
+*/
+int QHttpConnectionPoolConfiguration::maximumConnectionsPerHost() const
+{
+    return d->maximumConnectionsPerHost;
+}
+
+/*!
+    Sets the maximum number of connections to one host that are kept open
+    while they are idle to \a count. Connections in excess of that number
+    are closed as soon as no more requests are queued for the host.
+    A \a count of -1 removes the limit.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa maximumIdleConnectionsPerHost()
+*/
+bool QHttpConnectionPoolConfiguration::setMaximumIdleConnectionsPerHost(int count)
+{
+    if (count < -1) {
+        qWarning("QHttpConnectionPoolConfiguration: Invalid number of idle connections per host");
+        return false;
+    }
+
+    d->maximumIdleConnectionsPerHost = count;
+    return true;
+}
+
+/*!
+    Returns the maximum number of idle connections kept open to one host,
+    or -1 if idle connections are only limited by maximumConnectionsPerHost().
+    The default value is -1.
+
+    \sa setMaximumIdleConnectionsPerHost()
+*/
+int QHttpConnectionPoolConfiguration::maximumIdleConnectionsPerHost() const
+{
+    return d->maximumIdleConnectionsPerHost;
+}
+
+/*!
+    Sets the time the connections to a host are kept open after the last
+    request to that host finished to \a timeout. \a timeout must not be
+    negative.
+
+    Returns \c true on success, \c false otherwise.
+
+    \note QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute takes
+    precedence over this value.
+
+    \sa idleTimeout()
+*/
+bool QHttpConnectionPoolConfiguration::setIdleTimeout(std::chrono::seconds timeout)
+{
+    if (timeout.count() < 0) {
+        qWarning("QHttpConnectionPoolConfiguration: Invalid idle timeout");
+        return false;
+    }
+
+    d->idleTimeout = timeout;
+    return true;
+}
+
+/*!
+    Returns the time the connections to a host are kept open after the last
+    request to that host finished. The default value is 120 seconds.
+
+    \sa setIdleTimeout()
+*/
+std::chrono::seconds QHttpConnectionPoolConfiguration::idleTimeout() const
+{
+    return d->idleTimeout;
+}
+
+/*!
+    Sets the number of connections that QNetworkAccessManager::connectToHost()
+    and QNetworkAccessManager::connectToHostEncrypted() open to \a count.
+    \a count must be at least 1. It is capped to maximumConnectionsPerHost()
+    when the connections are opened.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa preconnectCount()
+*/
+bool QHttpConnectionPoolConfiguration::setPreconnectCount(int count)
+{
+    if (count < 1) {
+        qWarning("QHttpConnectionPoolConfiguration: Invalid preconnect count");
+        return false;
+    }
+
+    d->preconnectCount = count;
+    return true;
+}
+
+/*!
+    Returns the number of connections opened when preconnecting to a host.
+    The default value is 1.
+
+    \sa setPreconnectCount()
+*/
+int QHttpConnectionPoolConfiguration::preconnectCount() const
+{
+    return d->preconnectCount;
+}
+
+/*!
+    Swaps this configuration with the \a other configuration.
+*/
+void QHttpConnectionPoolConfiguration::swap(QHttpConnectionPoolConfiguration &other) noexcept
+{
+    d.swap(other.d);
+}
+
+/*!
+    \fn bool QHttpConnectionPoolConfiguration::operator==(const QHttpConnectionPoolConfiguration &lhs, const QHttpConnectionPoolConfiguration &rhs) noexcept
+    Returns \c true if \a lhs and \a rhs have the same set of connection
+    pool parameters.
+*/
+
+/*!
+    \fn bool QHttpConnectionPoolConfiguration::operator!=(const QHttpConnectionPoolConfiguration &lhs, const QHttpConnectionPoolConfiguration &rhs) noexcept
+    Returns \c true if \a lhs and \a rhs do not have the same set of
+    connection pool parameters.
+*/
+
+/*!
+    \internal
+*/
+bool QHttpConnectionPoolConfiguration::isEqual(const QHttpConnectionPoolConfiguration &other) const noexcept
+{
+    if (d == other.d)
+        return true;
+
+    return d->maximumConnectionsPerHost == other.d->maximumConnectionsPerHost
+           && d->maximumIdleConnectionsPerHost == other.d->maximumIdleConnectionsPerHost
+           && d->idleTimeout == other.d->idleTimeout
+           && d->preconnectCount == other.d->preconnectCount;
+}
+
+QT_END_NAMESPACE
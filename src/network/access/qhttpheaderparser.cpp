@@ -76,6 +76,13 @@ static bool fieldNameCheck(QByteArrayView name)
     return name.size() > 0 && std::all_of(name.begin(), name.end(), fieldNameChar);
 }
 
+// Most lookups are for a name that isn't there, so reject on the length before
+// paying for the case-insensitive comparison.
+static bool fieldNameEquals(QByteArrayView lhs, QByteArrayView rhs)
+{
+    return lhs.size() == rhs.size() && lhs.compare(rhs, Qt::CaseInsensitive) == 0;
+}
+
 bool QHttpHeaderParser::parseHeaders(QByteArrayView header)
 {
     // see rfc2616, sec 4 for information about HTTP/1.1 headers.
@@ -92,6 +99,7 @@ bool QHttpHeaderParser::parseHeaders(QByteArrayView header)
         header.chop(tail);
 
     QList<QPair<QByteArray, QByteArray>> result;
+    result.reserve(qMin(header.count('\n'), qsizetype(MAX_HEADER_FIELDS)));
     while (header.size()) {
         const int colon = header.indexOf(':');
         if (colon == -1) // if no colon check if empty headers
@@ -114,17 +122,17 @@ bool QHttpHeaderParser::parseHeaders(QByteArrayView header)
             line = line.trimmed();
             if (line.size()) {
                 if (value.size())
-                    value += ' ' + line.toByteArray();
+                    value.append(' ').append(line);
                 else
                     value = line.toByteArray();
             }
             header = header.sliced(endLine + 1);
         } while (hSpaceStart(header));
         Q_ASSERT(name.size() + 1 + value.size() <= MAX_HEADER_FIELD_SIZE);
-        result.append(qMakePair(name.toByteArray(), value));
+        result.emplaceBack(name.toByteArray(), std::move(value));
     }
 
-    fields = result;
+    fields = std::move(result);
     return true;
 }
 
@@ -172,17 +180,17 @@ const QList<QPair<QByteArray, QByteArray> >& QHttpHeaderParser::headers() const
     return fields;
 }
 
-QByteArray QHttpHeaderParser::firstHeaderField(const QByteArray &name,
+QByteArray QHttpHeaderParser::firstHeaderField(QByteArrayView name,
                                                const QByteArray &defaultValue) const
 {
     for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
-        if (name.compare(it->first, Qt::CaseInsensitive) == 0)
+        if (fieldNameEquals(name, it->first))
             return it->second;
     }
     return defaultValue;
 }
 
-QByteArray QHttpHeaderParser::combinedHeaderValue(const QByteArray &name, const QByteArray &defaultValue) const
+QByteArray QHttpHeaderParser::combinedHeaderValue(QByteArrayView name, const QByteArray &defaultValue) const
 {
     const QList<QByteArray> allValues = headerFieldValues(name);
     if (allValues.isEmpty())
@@ -191,20 +199,20 @@ QByteArray QHttpHeaderParser::combinedHeaderValue(const QByteArray &name, const
         return allValues.join(", ");
 }
 
-QList<QByteArray> QHttpHeaderParser::headerFieldValues(const QByteArray &name) const
+QList<QByteArray> QHttpHeaderParser::headerFieldValues(QByteArrayView name) const
 {
     QList<QByteArray> result;
     for (auto it = fields.constBegin(); it != fields.constEnd(); ++it)
-        if (name.compare(it->first, Qt::CaseInsensitive) == 0)
+        if (fieldNameEquals(name, it->first))
             result += it->second;
 
     return result;
 }
 
-void QHttpHeaderParser::removeHeaderField(const QByteArray &name)
+void QHttpHeaderParser::removeHeaderField(QByteArrayView name)
 {
     auto firstEqualsName = [&name](const QPair<QByteArray, QByteArray> &header) {
-        return name.compare(header.first, Qt::CaseInsensitive) == 0;
+        return fieldNameEquals(name, header.first);
     };
     fields.removeIf(firstEqualsName);
 }
@@ -103,13 +103,17 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(quint16 connectionC
                                                              QHttpNetworkConnection::ConnectionType type)
 : state(RunningState), networkLayerState(Unknown),
   hostName(hostName), port(port), encrypt(encrypt), delayIpv4(true),
-  activeChannelCount(connectionCount), channelCount(connectionCount)
+  activeChannelCount(type == QHttpNetworkConnection::ConnectionTypeHTTP2
+                     || type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
+                     ? 1 : connectionCount),
+  channelCount(connectionCount)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
   , preConnectRequests(0)
   , connectionType(type)
 {
+    Q_ASSERT(channelCount >= activeChannelCount);
     channels = new QHttpNetworkConnectionChannel[channelCount];
 }
 
@@ -300,7 +304,11 @@ void QHttpNetworkConnectionPrivate::prepareRequest(HttpMessagePair &messagePair)
     value = request.headerField("accept-encoding");
     if (value.isEmpty()) {
 #ifndef QT_NO_COMPRESS
-        const QByteArrayList &acceptedEncoding = QDecompressHelper::acceptedEncoding();
+        QByteArrayList acceptedEncoding = QDecompressHelper::acceptedEncoding();
+        // A shared dictionary was announced, so the dictionary encodings
+        // can be decoded as well
+        if (!request.headerField("available-dictionary").isEmpty())
+            acceptedEncoding = QDecompressHelper::acceptedDictionaryEncoding() + acceptedEncoding;
         request.setHeaderField("Accept-Encoding", acceptedEncoding.join(", "));
         request.d->autoDecompress = true;
 #else
@@ -630,6 +638,7 @@ QHttpNetworkReply* QHttpNetworkConnectionPrivate::queueRequest(const QHttpNetwor
     reply->setRequest(request);
     reply->d_func()->connection = q;
     reply->d_func()->connectionChannel = &channels[0]; // will have the correct one set later
+    reply->d_func()->recordTiming(QNetworkReplyTiming::Started);
     HttpMessagePair pair = qMakePair(request, reply);
 
     if (request.isPreConnect())
@@ -650,7 +659,9 @@ QHttpNetworkReply* QHttpNetworkConnectionPrivate::queueRequest(const QHttpNetwor
     else { // HTTP/2 ('h2' mode)
         if (!pair.second->d_func()->requestIsPrepared)
             prepareRequest(pair);
-        channels[0].h2RequestsToSend.insert(request.priority(), pair);
+        // Streams of the same priority are opened in the order they were requested:
+        auto &h2Requests = channels[0].h2RequestsToSend;
+        h2Requests.insert(h2Requests.upperBound(request.priority()), request.priority(), pair);
     }
 
     // For Happy Eyeballs the networkLayerState is set to Unknown
@@ -1060,8 +1071,10 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
     switch (connectionType) {
     case QHttpNetworkConnection::ConnectionTypeHTTP: {
         // return fast if there is nothing to do
-        if (highPriorityQueue.isEmpty() && lowPriorityQueue.isEmpty())
+        if (highPriorityQueue.isEmpty() && lowPriorityQueue.isEmpty()) {
+            closeSurplusIdleChannels();
             return;
+        }
 
         // try to get a free AND connected socket
         for (int i = 0; i < activeChannelCount; ++i) {
@@ -1176,6 +1189,26 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
 }
 
 
+// Close the keep-alive sockets that exceed maximumIdleChannels. Only called
+// when nothing is queued, so the channels closed here would not be reused
+// before the next request arrives anyway.
+void QHttpNetworkConnectionPrivate::closeSurplusIdleChannels()
+{
+    if (maximumIdleChannels < 0)
+        return;
+
+    int idleChannels = 0;
+    for (int i = 0; i < activeChannelCount; ++i) {
+        QHttpNetworkConnectionChannel &channel = channels[i];
+        if (!channel.socket || channel.reply || channel.isSocketBusy()
+            || channel.socket->state() != QAbstractSocket::ConnectedState) {
+            continue;
+        }
+        if (++idleChannels > maximumIdleChannels)
+            channel.close();
+    }
+}
+
 void QHttpNetworkConnectionPrivate::readMoreLater(QHttpNetworkReply *reply)
 {
     for (int i = 0 ; i < activeChannelCount; ++i) {
@@ -1221,6 +1254,8 @@ void QHttpNetworkConnectionPrivate::startHostInfoLookup()
     } else {
         int hostLookupId;
         bool immediateResultValid = false;
+        hostLookupStartedAt = QNetworkReplyTimingPrivate::now();
+        hostLookupFinishedAt = 0;
         QHostInfo hostInfo = qt_qhostinfo_lookup(lookupHost,
                                                  this->q_func(),
                                                  SLOT(_q_hostLookupFinished(QHostInfo)),
@@ -1241,6 +1276,9 @@ void QHttpNetworkConnectionPrivate::_q_hostLookupFinished(const QHostInfo &info)
     if (networkLayerState == IPv4 || networkLayerState == IPv6 || networkLayerState == IPv4or6)
         return;
 
+    if (hostLookupStartedAt)
+        hostLookupFinishedAt = QNetworkReplyTimingPrivate::now();
+
     const auto addresses = info.addresses();
     for (const QHostAddress &address : addresses) {
         const QAbstractSocket::NetworkLayerProtocol protocol = address.protocol();
@@ -1460,6 +1498,18 @@ void QHttpNetworkConnection::setHttp2Parameters(const QHttp2Configuration &param
     d->http2Parameters = params;
 }
 
+int QHttpNetworkConnection::maximumIdleChannels() const
+{
+    Q_D(const QHttpNetworkConnection);
+    return d->maximumIdleChannels;
+}
+
+void QHttpNetworkConnection::setMaximumIdleChannels(int count)
+{
+    Q_D(QHttpNetworkConnection);
+    d->maximumIdleChannels = count;
+}
+
 // SSL support below
 #ifndef QT_NO_SSL
 void QHttpNetworkConnection::setSslConfiguration(const QSslConfiguration &config)
@@ -1485,6 +1535,19 @@ void QHttpNetworkConnection::setSslContext(std::shared_ptr<QSslContext> context)
     d->sslContext = std::move(context);
 }
 
+void QHttpNetworkConnection::setSslSessionCache(QSslSessionCache *cache)
+{
+    Q_D(QHttpNetworkConnection);
+    if (!d->encrypt)
+        return;
+
+    // The sockets of all channels exist already, even those not in use yet.
+    for (int i = 0; i < d->channelCount; ++i) {
+        if (auto *sslSocket = qobject_cast<QSslSocket *>(d->channels[i].socket))
+            sslSocket->setSslSessionCache(cache);
+    }
+}
+
 void QHttpNetworkConnection::ignoreSslErrors(int channel)
 {
     Q_D(QHttpNetworkConnection);
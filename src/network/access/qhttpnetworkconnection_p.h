@@ -85,6 +85,7 @@ class QHostInfo;
 #ifndef QT_NO_SSL
 class QSslConfiguration;
 class QSslContext;
+class QSslSessionCache;
 #endif // !QT_NO_SSL
 
 class QHttpNetworkConnectionPrivate;
@@ -134,12 +135,16 @@ public:
     QHttp2Configuration http2Parameters() const;
     void setHttp2Parameters(const QHttp2Configuration &params);
 
+    int maximumIdleChannels() const;
+    void setMaximumIdleChannels(int count);
+
 #ifndef QT_NO_SSL
     void setSslConfiguration(const QSslConfiguration &config);
     void ignoreSslErrors(int channel = -1);
     void ignoreSslErrors(const QList<QSslError> &errors, int channel = -1);
     std::shared_ptr<QSslContext> sslContext();
     void setSslContext(std::shared_ptr<QSslContext> context);
+    void setSslSessionCache(QSslSessionCache *cache);
 #endif
 
     void preConnectFinished();
@@ -202,6 +207,8 @@ public:
     void resumeConnection();
     ConnectionState state;
     NetworkLayerPreferenceState networkLayerState;
+    qint64 hostLookupStartedAt = 0;
+    qint64 hostLookupFinishedAt = 0;
 
     enum { ChunkSize = 4096 };
 
@@ -219,6 +226,8 @@ public:
     void fillPipeline(QAbstractSocket *socket);
     bool fillPipeline(QList<HttpMessagePair> &queue, QHttpNetworkConnectionChannel &channel);
 
+    void closeSurplusIdleChannels();
+
     // read more HTTP body after the next event loop spin
     void readMoreLater(QHttpNetworkReply *reply);
 
@@ -272,6 +281,8 @@ public:
     QList<HttpMessagePair> lowPriorityQueue;
 
     int preConnectRequests;
+    // Connected channels without a request to keep open, -1 for all of them:
+    int maximumIdleChannels = -1;
 
     QHttpNetworkConnection::ConnectionType connectionType;
 
@@ -52,12 +52,15 @@
 
 #ifndef QT_NO_SSL
 #    include <private/qsslsocket_p.h>
+#    include <private/qsslconfiguration_p.h>
 #    include <QtNetwork/qsslkey.h>
 #    include <QtNetwork/qsslcipher.h>
 #endif
 
 #include "private/qnetconmonitor_p.h"
 
+#include <qtnetwork_tracepoints_p.h>
+
 QT_BEGIN_NAMESPACE
 
 namespace
@@ -393,6 +396,11 @@ bool QHttpNetworkConnectionChannel::ensureConnection()
             }
         }
 #endif
+        Q_TRACE(QHttpNetworkConnectionChannel_connectToHost, this, connectHost, connectPort, ssl);
+        connectStartedAt = QNetworkReplyTimingPrivate::now();
+        secureConnectStartedAt = 0;
+        connectFinishedAt = 0;
+        sessionResumed = false;
         if (ssl) {
 #ifndef QT_NO_SSL
             QSslSocket *sslSocket = qobject_cast<QSslSocket*>(socket);
@@ -751,6 +759,34 @@ void QHttpNetworkConnectionChannel::setSslConfiguration(const QSslConfiguration
 
 #endif
 
+// Attributes the setup of this channel's connection to \a reply if the
+// reply had to wait for it, and marks the connection as reused otherwise.
+void QHttpNetworkConnectionChannel::recordConnectionTiming(QHttpNetworkReply *reply) const
+{
+    QHttpNetworkReplyPrivate *replyPrivate = reply->d_func();
+    QNetworkReplyTimingPrivate *timing = QNetworkReplyTimingPrivate::get(replyPrivate->timing);
+    const qint64 started = timing->timestamps[QNetworkReplyTiming::Started];
+    if (!started || timing->timestamps[QNetworkReplyTiming::RequestStarted])
+        return; // not queued through the connection, or resent
+
+    // Phases that began before the request was queued are clamped to its start
+    const auto clamped = [started](qint64 when) { return when ? qMax(when, started) : 0; };
+    if (connectFinishedAt >= started) {
+        const QHttpNetworkConnectionPrivate *connectionPrivate = connection->d_func();
+        if (connectionPrivate->hostLookupFinishedAt >= started) {
+            timing->record(QNetworkReplyTiming::DomainLookupStarted, clamped(connectionPrivate->hostLookupStartedAt));
+            timing->record(QNetworkReplyTiming::DomainLookupFinished, connectionPrivate->hostLookupFinishedAt);
+        }
+        timing->record(QNetworkReplyTiming::ConnectStarted, clamped(connectStartedAt));
+        timing->record(QNetworkReplyTiming::SecureConnectStarted, clamped(secureConnectStartedAt));
+        timing->record(QNetworkReplyTiming::ConnectFinished, connectFinishedAt);
+    } else {
+        timing->connectionReused = true;
+    }
+    timing->sessionResumed = ssl && sessionResumed;
+    timing->record(QNetworkReplyTiming::RequestStarted);
+}
+
 void QHttpNetworkConnectionChannel::pipelineInto(HttpMessagePair &pair)
 {
     // this is only called for simple GET
@@ -762,6 +798,7 @@ void QHttpNetworkConnectionChannel::pipelineInto(HttpMessagePair &pair)
     reply->d_func()->connectionChannel = this;
     reply->d_func()->autoDecompress = request.d->autoDecompress;
     reply->d_func()->pipeliningUsed = true;
+    recordConnectionTiming(reply);
 
 #ifndef QT_NO_NETWORKPROXY
     pipeline.append(QHttpNetworkRequestPrivate::header(request,
@@ -875,6 +912,8 @@ void QHttpNetworkConnectionChannel::_q_disconnected()
 
 void QHttpNetworkConnectionChannel::_q_connected()
 {
+    Q_TRACE(QHttpNetworkConnectionChannel_connected, this);
+
     // For the Happy Eyeballs we need to check if this is the first channel to connect.
     if (connection->d_func()->networkLayerState == QHttpNetworkConnectionPrivate::HostLookupPending || connection->d_func()->networkLayerState == QHttpNetworkConnectionPrivate::IPv4or6) {
         if (connection->d_func()->delayedConnectionTimer.isActive())
@@ -918,6 +957,11 @@ void QHttpNetworkConnectionChannel::_q_connected()
 
     pipeliningSupported = QHttpNetworkConnectionChannel::PipeliningSupportUnknown;
 
+    if (ssl || pendingEncrypt)
+        secureConnectStartedAt = QNetworkReplyTimingPrivate::now();
+    else
+        connectFinishedAt = QNetworkReplyTimingPrivate::now();
+
     if (QNetworkConnectionMonitor::isEnabled()) {
         auto connectionPrivate = connection->d_func();
         if (!connectionPrivate->connectionMonitor.isMonitoring()) {
@@ -1190,9 +1234,14 @@ void QHttpNetworkConnectionChannel::emitFinishedWithError(QNetworkReply::Network
 #ifndef QT_NO_SSL
 void QHttpNetworkConnectionChannel::_q_encrypted()
 {
+    Q_TRACE(QHttpNetworkConnectionChannel_encrypted, this);
+
     QSslSocket *sslSocket = qobject_cast<QSslSocket *>(socket);
     Q_ASSERT(sslSocket);
 
+    connectFinishedAt = QNetworkReplyTimingPrivate::now();
+    sessionResumed = QSslConfigurationPrivate::peerSessionWasShared(sslSocket->sslConfiguration());
+
     if (!protocolHandler && connection->connectionType() != QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
         // ConnectionTypeHTTP2Direct does not rely on ALPN/NPN to negotiate HTTP/2,
         // after establishing a secure connection we immediately start sending
@@ -123,6 +123,12 @@ public:
     QScopedPointer<QAbstractProtocolHandler> protocolHandler;
     QMultiMap<int, HttpMessagePair> h2RequestsToSend;
     bool switchedToHttp2 = false;
+    // when the current socket started and finished connecting, see recordConnectionTiming()
+    qint64 connectStartedAt = 0;
+    qint64 secureConnectStartedAt = 0;
+    qint64 connectFinishedAt = 0;
+    bool sessionResumed = false;
+    void recordConnectionTiming(QHttpNetworkReply *reply) const;
 #ifndef QT_NO_SSL
     bool ignoreAllSslErrors;
     QList<QSslError> ignoreSslErrorsList;
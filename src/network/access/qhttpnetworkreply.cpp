@@ -307,6 +307,11 @@ bool QHttpNetworkReply::isPipeliningUsed() const
     return d_func()->pipeliningUsed;
 }
 
+QNetworkReplyTiming QHttpNetworkReply::timing() const
+{
+    return d_func()->timing;
+}
+
 bool QHttpNetworkReply::isHttp2Used() const
 {
     return d_func()->h2Used;
@@ -70,6 +70,7 @@
 #include <private/qauthenticator_p.h>
 #include <private/qringbuffer_p.h>
 #include <private/qbytedata_p.h>
+#include <private/qnetworkreplytiming_p.h>
 
 #ifndef QT_NO_NETWORKPROXY
 Q_MOC_INCLUDE(<QtNetwork/QNetworkProxy>)
@@ -161,6 +162,8 @@ public:
 
     bool isCompressed() const;
 
+    QNetworkReplyTiming timing() const;
+
 #ifndef QT_NO_SSL
     QSslConfiguration sslConfiguration() const;
     void setSslConfiguration(const QSslConfiguration &config);
@@ -277,6 +280,11 @@ public:
 
     char* userProvidedDownloadBuffer;
     QUrl redirectUrl;
+
+    // not reset by clear(), a resent request keeps its original timing
+    QNetworkReplyTiming timing;
+    void recordTiming(QNetworkReplyTiming::Event event, qint64 when = QNetworkReplyTimingPrivate::now())
+    { QNetworkReplyTimingPrivate::get(timing)->record(event, when); }
 };
 
 
@@ -292,6 +292,7 @@ bool QHttpProtocolHandler::sendRequest()
         replyPrivate->connectionChannel = m_channel;
         replyPrivate->autoDecompress = m_channel->request.d->autoDecompress;
         replyPrivate->pipeliningUsed = false;
+        m_channel->recordConnectionTiming(m_reply);
 
         // if the url contains authentication parameters, use the new ones
         // both channels will use the new authentication parameters
@@ -319,6 +320,7 @@ bool QHttpProtocolHandler::sendRequest()
 #else
         m_header = QHttpNetworkRequestPrivate::header(m_channel->request, false);
 #endif
+        replyPrivate->recordTiming(QNetworkReplyTiming::RequestSent);
         QMetaObject::invokeMethod(m_reply, "requestSent", Qt::QueuedConnection);
 
         // flushing is dangerous (QSslSocket calls transmit which might read or error)
@@ -181,9 +181,10 @@ class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
 {
     // Q_OBJECT
 public:
-    QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
+    QNetworkAccessCachedHttpConnection(quint16 channelCount, const QString &hostName,
+                                       quint16 port, bool encrypt,
                                        QHttpNetworkConnection::ConnectionType connectionType)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType)
+        : QHttpNetworkConnection(channelCount, hostName, port, encrypt, nullptr, connectionType)
     {
         setExpires(true);
         setShareable(true);
@@ -333,16 +334,20 @@ void QHttpThreadDelegate::startRequest()
     if (!httpConnection) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
-                                                                connectionType);
+        httpConnection = new QNetworkAccessCachedHttpConnection(
+                    quint16(connectionPoolParameters.maximumConnectionsPerHost()),
+                    urlCopy.host(), urlCopy.port(), ssl, connectionType);
+        httpConnection->setMaximumIdleChannels(connectionPoolParameters.maximumIdleConnectionsPerHost());
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             || connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
             httpConnection->setHttp2Parameters(http2Parameters);
         }
 #ifndef QT_NO_SSL
         // Set the QSslConfiguration from this QNetworkRequest.
-        if (ssl)
+        if (ssl) {
             httpConnection->setSslConfiguration(*incomingSslConfiguration);
+            httpConnection->setSslSessionCache(sslSessionCache);
+        }
 #endif
 
 #ifndef QT_NO_NETWORKPROXY
@@ -531,6 +536,8 @@ void QHttpThreadDelegate::finishedSlot()
     if (httpRequest.isFollowRedirects() && httpReply->isRedirecting())
         emit redirected(httpReply->redirectUrl(), httpReply->statusCode(), httpReply->request().redirectCount() - 1);
 
+    updateTiming(QNetworkReplyTiming::ResponseFinished);
+    emit timingChanged(incomingTiming);
     emit downloadFinished();
 
     QMetaObject::invokeMethod(httpReply, "deleteLater", Qt::QueuedConnection);
@@ -556,6 +563,7 @@ void QHttpThreadDelegate::synchronousFinishedSlot()
 
     isCompressed = httpReply->isCompressed();
     synchronousDownloadData = httpReply->readAll();
+    updateTiming(QNetworkReplyTiming::ResponseFinished);
 
     QMetaObject::invokeMethod(httpReply, "deleteLater", Qt::QueuedConnection);
     QMetaObject::invokeMethod(synchronousRequestLoop, "quit", Qt::QueuedConnection);
@@ -576,6 +584,8 @@ void QHttpThreadDelegate::finishedWithErrorSlot(QNetworkReply::NetworkError erro
         emit sslConfigurationChanged(httpReply->sslConfiguration());
 #endif
     emit error(errorCode,detail);
+    updateTiming(QNetworkReplyTiming::ResponseFinished);
+    emit timingChanged(incomingTiming);
     emit downloadFinished();
 
 
@@ -597,6 +607,7 @@ void QHttpThreadDelegate::synchronousFinishedWithErrorSlot(QNetworkReply::Networ
     incomingErrorDetail = detail;
 
     synchronousDownloadData = httpReply->readAll();
+    updateTiming(QNetworkReplyTiming::ResponseFinished);
 
     QMetaObject::invokeMethod(httpReply, "deleteLater", Qt::QueuedConnection);
     QMetaObject::invokeMethod(synchronousRequestLoop, "quit", Qt::QueuedConnection);
@@ -645,6 +656,7 @@ void QHttpThreadDelegate::headerChangedSlot()
     removedContentLength = httpReply->removedContentLength();
     isHttp2Used = httpReply->isHttp2Used();
     isCompressed = httpReply->isCompressed();
+    updateTiming(QNetworkReplyTiming::ResponseStarted);
 
     emit downloadMetaData(incomingHeaders,
                           incomingStatusCode,
@@ -672,6 +684,19 @@ void QHttpThreadDelegate::synchronousHeaderChangedSlot()
     isPipeliningUsed = httpReply->isPipeliningUsed();
     isHttp2Used = httpReply->isHttp2Used();
     incomingContentLength = httpReply->contentLength();
+    updateTiming(QNetworkReplyTiming::ResponseStarted);
+}
+
+// Takes over the connection level phases recorded on httpReply and adds
+// the response events, which only the delegate observes.
+void QHttpThreadDelegate::updateTiming(QNetworkReplyTiming::Event event)
+{
+    const qint64 responseStarted =
+            QNetworkReplyTimingPrivate::get(qAsConst(incomingTiming))->timestamps[QNetworkReplyTiming::ResponseStarted];
+    incomingTiming = httpReply->timing();
+    QNetworkReplyTimingPrivate *timing = QNetworkReplyTimingPrivate::get(incomingTiming);
+    timing->record(QNetworkReplyTiming::ResponseStarted, responseStarted);
+    timing->record(event);
 }
 
 
@@ -63,6 +63,7 @@
 #include "qhttpnetworkrequest_p.h"
 #include "qhttpnetworkconnection_p.h"
 #include "qhttp2configuration.h"
+#include "qhttpconnectionpoolconfiguration.h"
 #include <QSharedPointer>
 #include <QScopedPointer>
 #include "private/qnoncontiguousbytedevice_p.h"
@@ -91,6 +92,7 @@ public:
     bool ssl;
 #ifndef QT_NO_SSL
     QScopedPointer<QSslConfiguration> incomingSslConfiguration;
+    QSslSessionCache *sslSessionCache = nullptr;
 #endif
     QHttpNetworkRequest httpRequest;
     qint64 downloadBufferMaximumSize;
@@ -119,8 +121,10 @@ public:
     QNetworkReply::NetworkError incomingErrorCode;
     QString incomingErrorDetail;
     QHttp2Configuration http2Parameters;
+    QHttpConnectionPoolConfiguration connectionPoolParameters;
 
     bool isCompressed;
+    QNetworkReplyTiming incomingTiming;
 
 protected:
     // The zerocopy download buffer, if used:
@@ -151,6 +155,7 @@ signals:
     void downloadProgress(qint64, qint64);
     void downloadData(const QByteArray &);
     void error(QNetworkReply::NetworkError, const QString &);
+    void timingChanged(const QNetworkReplyTiming &timing);
     void downloadFinished();
     void redirected(const QUrl &url, int httpStatus, int maxRedirectsRemainig);
 
@@ -172,6 +177,7 @@ protected slots:
     void synchronousFinishedWithErrorSlot(QNetworkReply::NetworkError errorCode, const QString &detail = QString());
     void headerChangedSlot();
     void synchronousHeaderChangedSlot();
+    void updateTiming(QNetworkReplyTiming::Event event);
     void dataReadProgressSlot(qint64 done, qint64 total);
     void cacheCredentialsSlot(const QHttpNetworkRequest &request, QAuthenticator *authenticator);
 #ifndef QT_NO_SSL
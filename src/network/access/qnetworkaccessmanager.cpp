@@ -938,7 +938,8 @@ QNetworkReply *QNetworkAccessManager::deleteResource(const QNetworkRequest &requ
     on \a sslConfiguration with QSslConfiguration::ALPNProtocolHTTP2 contained in
     the list of allowed protocols. When using HTTP/2, one single connection per host is
     enough, i.e. calling this method multiple times per host will not result in faster
-    network transactions.
+    network transactions. Otherwise, QHttpConnectionPoolConfiguration::preconnectCount()
+    connections are opened.
 
     \note This function has no possibility to report errors.
 
@@ -964,7 +965,8 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
     on \a sslConfiguration with QSslConfiguration::ALPNProtocolHTTP2 contained in
     the list of allowed protocols. When using HTTP/2, one single connection per host is
     enough, i.e. calling this method multiple times per host will not result in faster
-    network transactions.
+    network transactions. Otherwise, QHttpConnectionPoolConfiguration::preconnectCount()
+    connections are opened.
 
     \note This function has no possibility to report errors.
 
@@ -989,7 +991,56 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
         request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
 
     request.setPeerVerifyName(peerName);
-    get(request);
+
+    // One HTTP/2 connection multiplexes all requests, so only pre-warm the
+    // pool when HTTP/1 will be used.
+    int count = 1;
+#if QT_CONFIG(http)
+    if (!sslConfiguration.allowedNextProtocols().contains(QSslConfiguration::ALPNProtocolHTTP2)) {
+        const QHttpConnectionPoolConfiguration pool = d_func()->connectionPoolConfigurationForHost(hostName);
+        count = qMin(pool.preconnectCount(), pool.maximumConnectionsPerHost());
+    }
+#endif
+    for (int i = 0; i < count; ++i)
+        get(request);
+}
+
+/*!
+    \since 6.4
+
+    Makes all the encrypted HTTP connections of this manager resume TLS
+    sessions from, and store them in, \a cache. This lets a new connection
+    to a host skip the full handshake after another connection, possibly
+    made by a different manager or restored from disk with
+    QSslSessionCache::load(), has negotiated a session with it. Pass
+    \nullptr to stop using a cache, which is the default.
+
+    The setting applies to connections opened after this call. Requests
+    whose SSL configuration has QSsl::SslOptionDisableSessionPersistence
+    set do not use the cache.
+
+    The manager does not take ownership of \a cache, which must outlive it.
+
+    \sa sslSessionCache(), QSslSocket::setSslSessionCache()
+*/
+void QNetworkAccessManager::setSslSessionCache(QSslSessionCache *cache)
+{
+    Q_D(QNetworkAccessManager);
+    d->sslSessionCache = cache;
+}
+
+/*!
+    \since 6.4
+
+    Returns the TLS session cache used by this manager, or \nullptr if it
+    does not use one.
+
+    \sa setSslSessionCache()
+*/
+QSslSessionCache *QNetworkAccessManager::sslSessionCache() const
+{
+    Q_D(const QNetworkAccessManager);
+    return d->sslSessionCache;
 }
 #endif
 
@@ -999,6 +1050,8 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
     Initiates a connection to the host given by \a hostName at port \a port.
     This function is useful to complete the TCP handshake
     to a host before the HTTP request is made, resulting in a lower network latency.
+    The number of connections opened is given by
+    QHttpConnectionPoolConfiguration::preconnectCount().
 
     \note This function has no possibility to report errors.
 
@@ -1011,7 +1064,14 @@ void QNetworkAccessManager::connectToHost(const QString &hostName, quint16 port)
     url.setPort(port);
     url.setScheme(QLatin1String("preconnect-http"));
     QNetworkRequest request(url);
-    get(request);
+
+    int count = 1;
+#if QT_CONFIG(http)
+    const QHttpConnectionPoolConfiguration pool = d_func()->connectionPoolConfigurationForHost(hostName);
+    count = qMin(pool.preconnectCount(), pool.maximumConnectionsPerHost());
+#endif
+    for (int i = 0; i < count; ++i)
+        get(request);
 }
 
 /*!
@@ -1431,6 +1491,133 @@ void QNetworkAccessManager::setTransferTimeout(int timeout)
     d_func()->transferTimeout = timeout;
 }
 
+#if QT_CONFIG(http)
+/*!
+    \since 6.4
+
+    Returns the connection pool configuration used for hosts that have no
+    configuration of their own.
+
+    \sa setConnectionPoolConfiguration(), QHttpConnectionPoolConfiguration
+*/
+QHttpConnectionPoolConfiguration QNetworkAccessManager::connectionPoolConfiguration() const
+{
+    return d_func()->connectionPoolConfiguration;
+}
+
+/*!
+    \since 6.4
+
+    Sets \a configuration as the connection pool configuration for all hosts
+    that have no configuration set with the overload taking a host name.
+
+    \note The configuration is applied when the first request to a host
+    creates the pool of connections to that host. Hosts that already have a
+    pool keep their current configuration until its connections expire or
+    clearConnectionCache() is called.
+
+    \sa connectionPoolConfiguration(), QHttpConnectionPoolConfiguration
+*/
+void QNetworkAccessManager::setConnectionPoolConfiguration(
+        const QHttpConnectionPoolConfiguration &configuration)
+{
+    d_func()->connectionPoolConfiguration = configuration;
+}
+
+/*!
+    \since 6.4
+    \overload
+
+    Returns the connection pool configuration used for connections to
+    \a hostName. This is the configuration set for \a hostName, or the
+    default connection pool configuration if there is none.
+
+    \sa resetConnectionPoolConfiguration()
+*/
+QHttpConnectionPoolConfiguration
+QNetworkAccessManager::connectionPoolConfiguration(const QString &hostName) const
+{
+    return d_func()->connectionPoolConfigurationForHost(hostName);
+}
+
+/*!
+    \since 6.4
+    \overload
+
+    Sets \a configuration as the connection pool configuration for
+    connections to \a hostName, overriding the default configuration.
+    Host names are compared case-insensitively.
+
+    \sa resetConnectionPoolConfiguration()
+*/
+void QNetworkAccessManager::setConnectionPoolConfiguration(const QString &hostName,
+        const QHttpConnectionPoolConfiguration &configuration)
+{
+    d_func()->hostConnectionPoolConfigurations.insert(hostName.toLower(), configuration);
+}
+
+/*!
+    \since 6.4
+
+    Removes the connection pool configuration set for \a hostName, so that
+    connections to it use the default configuration again.
+
+    \sa setConnectionPoolConfiguration()
+*/
+void QNetworkAccessManager::resetConnectionPoolConfiguration(const QString &hostName)
+{
+    d_func()->hostConnectionPoolConfigurations.remove(hostName.toLower());
+}
+
+/*!
+    \since 6.4
+
+    Returns the number of worker threads that handle HTTP connections for
+    this QNetworkAccessManager. The default is 1.
+
+    \sa setHttpThreadCount()
+*/
+int QNetworkAccessManager::httpThreadCount() const
+{
+    return d_func()->httpThreadCount;
+}
+
+/*!
+    \since 6.4
+
+    Sets the number of worker threads that handle HTTP connections for this
+    QNetworkAccessManager to \a count, which must be at least 1.
+
+    By default, a single thread does all network I/O, TLS, HTTP/2 framing
+    and decompression for the manager's HTTP requests. An application with
+    many concurrent requests to many hosts can spread that work across
+    several cores by raising the thread count. Connections are assigned to
+    threads by host name and port: all requests to one host are handled by
+    the same thread, so they still share its connections and HTTP/2
+    sessions. Requests to a single host do not benefit.
+
+    Threads are started when the first request for them is made. Changing
+    the count only affects new requests; it should be done before any
+    requests are made, because afterwards hosts may move to a different
+    thread and open new connections there. Idle connections in the old
+    threads are closed when they expire or when clearConnectionCache() is
+    called.
+
+    Synchronous requests are not affected; each uses a thread of its own.
+
+    \sa httpThreadCount(), clearConnectionCache()
+*/
+void QNetworkAccessManager::setHttpThreadCount(int count)
+{
+    Q_D(QNetworkAccessManager);
+    if (count < 1) {
+        qWarning("QNetworkAccessManager::setHttpThreadCount: invalid count %d", count);
+        return;
+    }
+    d->httpThreadCount = count;
+}
+#endif // QT_CONFIG(http)
+
 void QNetworkAccessManagerPrivate::_q_replyFinished(QNetworkReply *reply)
 {
     Q_Q(QNetworkAccessManager);
@@ -1631,28 +1818,53 @@ QNetworkAccessManagerPrivate::~QNetworkAccessManagerPrivate()
     destroyThread();
 }
 
-QThread * QNetworkAccessManagerPrivate::createThread()
+QThread * QNetworkAccessManagerPrivate::createThread(int index)
 {
+    Q_ASSERT(index >= 0);
+    if (threads.size() <= index)
+        threads.resize(index + 1);
+
+    QThread *&thread = threads[index];
     if (!thread) {
         thread = new QThread;
-        thread->setObjectName(QStringLiteral("QNetworkAccessManager thread"));
+        if (index)
+            thread->setObjectName(QStringLiteral("QNetworkAccessManager thread %1").arg(index));
+        else
+            thread->setObjectName(QStringLiteral("QNetworkAccessManager thread"));
         thread->start();
     }
     Q_ASSERT(thread);
     return thread;
 }
 
+/*
+    Returns the HTTP worker thread that handles connections to \a hostName
+    and \a port. The connection cache is per thread, so all requests to one
+    host have to go to the same thread for its connections (and the HTTP/2
+    sessions multiplexed over them) to be shared.
+*/
+QThread *QNetworkAccessManagerPrivate::threadForHost(const QString &hostName, int port)
+{
+    if (httpThreadCount <= 1)
+        return createThread();
+
+    const size_t hash = qHashMulti(0, hostName.toLower(), port);
+    return createThread(int(hash % size_t(httpThreadCount)));
+}
+
 void QNetworkAccessManagerPrivate::destroyThread()
 {
-    if (thread) {
+    for (QThread *thread : std::as_const(threads)) {
+        if (!thread)
+            continue;
         thread->quit();
         thread->wait(QDeadlineTimer(5000));
         if (thread->isFinished())
             delete thread;
         else
             QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
-        thread = nullptr;
     }
+    threads.clear();
 }
 
 
@@ -63,8 +63,10 @@ class QNetworkReply;
 class QNetworkProxy;
 class QNetworkProxyFactory;
 class QSslError;
+class QSslSessionCache;
 class QHstsPolicy;
 class QHttpMultiPart;
+class QHttpConnectionPoolConfiguration;
 
 class QNetworkReplyImplPrivate;
 class QNetworkAccessManagerPrivate;
@@ -136,6 +138,9 @@ public:
     void connectToHostEncrypted(const QString &hostName, quint16 port,
                                 const QSslConfiguration &sslConfiguration,
                                 const QString &peerName);
+
+    void setSslSessionCache(QSslSessionCache *cache);
+    QSslSessionCache *sslSessionCache() const;
 #endif
     void connectToHost(const QString &hostName, quint16 port = 80);
 
@@ -148,6 +153,18 @@ public:
     int transferTimeout() const;
     void setTransferTimeout(int timeout = QNetworkRequest::DefaultTransferTimeoutConstant);
 
+#if QT_CONFIG(http) || defined(Q_CLANG_QDOC)
+    QHttpConnectionPoolConfiguration connectionPoolConfiguration() const;
+    void setConnectionPoolConfiguration(const QHttpConnectionPoolConfiguration &configuration);
+    QHttpConnectionPoolConfiguration connectionPoolConfiguration(const QString &hostName) const;
+    void setConnectionPoolConfiguration(const QString &hostName,
+                                        const QHttpConnectionPoolConfiguration &configuration);
+    void resetConnectionPoolConfiguration(const QString &hostName);
+
+    int httpThreadCount() const;
+    void setHttpThreadCount(int count);
+#endif
+
 Q_SIGNALS:
 #ifndef QT_NO_NETWORKPROXY
     void proxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
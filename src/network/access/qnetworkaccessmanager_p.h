@@ -66,6 +66,11 @@
 #include "qhstsstore_p.h"
 #endif // QT_CONFIG(settings)
 
+#if QT_CONFIG(http)
+#include "qhttpconnectionpoolconfiguration.h"
+#include <QtCore/qhash.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QAuthenticator;
@@ -79,7 +84,6 @@ public:
     QNetworkAccessManagerPrivate()
         : networkCache(nullptr),
           cookieJar(nullptr),
-          thread(nullptr),
 #ifndef QT_NO_NETWORKPROXY
           proxyFactory(nullptr),
 #endif
@@ -91,7 +95,8 @@ public:
     }
     ~QNetworkAccessManagerPrivate();
 
-    QThread * createThread();
+    QThread * createThread(int index = 0);
+    QThread *threadForHost(const QString &hostName, int port);
     void destroyThread();
 
     void _q_replyFinished(QNetworkReply *reply);
@@ -137,7 +142,8 @@ public:
 
     QNetworkCookieJar *cookieJar;
 
-    QThread *thread;
+    // The HTTP worker threads, created on demand; see threadForHost().
+    QList<QThread *> threads;
 
 
 #ifndef QT_NO_NETWORKPROXY
@@ -165,10 +171,25 @@ public:
 #endif // QT_CONFIG(settings)
     bool stsEnabled = false;
 
+#ifndef QT_NO_SSL
+    // not owned, see QNetworkAccessManager::setSslSessionCache()
+    QSslSessionCache *sslSessionCache = nullptr;
+#endif
+
     bool autoDeleteReplies = false;
 
     int transferTimeout = 0;
 
+#if QT_CONFIG(http)
+    QHttpConnectionPoolConfiguration connectionPoolConfigurationForHost(const QString &hostName) const
+    { return hostConnectionPoolConfigurations.value(hostName.toLower(), connectionPoolConfiguration); }
+
+    QHttpConnectionPoolConfiguration connectionPoolConfiguration;
+    // Per-host overrides, keyed by the lower-cased host name:
+    QHash<QString, QHttpConnectionPoolConfiguration> hostConnectionPoolConfigurations;
+#endif
+    int httpThreadCount = 1;
+
     Q_DECLARE_PUBLIC(QNetworkAccessManager)
 };
 
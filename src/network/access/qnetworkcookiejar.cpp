@@ -43,6 +43,9 @@
 #include "QtNetwork/qnetworkcookie.h"
 #include "QtCore/qurl.h"
 #include "QtCore/qdatetime.h"
+#include "QtCore/qvarlengtharray.h"
+
+#include <algorithm>
 #if QT_CONFIG(topleveldomain)
 #include "private/qtldurl_p.h"
 #else
@@ -57,6 +60,111 @@ QT_END_NAMESPACE
 
 QT_BEGIN_NAMESPACE
 
+static inline bool expiresLater(const QNetworkCookieJarPrivate::Expiry &lhs,
+                                const QNetworkCookieJarPrivate::Expiry &rhs)
+{
+    return lhs.expiresAt > rhs.expiresAt;
+}
+
+QString QNetworkCookieJarPrivate::domainKey(const QString &domain)
+{
+    return domain.startsWith(QLatin1Char('.')) ? domain.mid(1) : domain;
+}
+
+void QNetworkCookieJarPrivate::insert(const QNetworkCookie &cookie)
+{
+    const quint64 serial = nextSerial++;
+    const QString key = domainKey(cookie.domain());
+    cookiesByDomain[key].append({ cookie, serial });
+    ++cookieCount;
+
+    if (!cookie.isSessionCookie()) {
+        expiryHeap.append({ cookie.expirationDate().toMSecsSinceEpoch(), serial, key });
+        std::push_heap(expiryHeap.begin(), expiryHeap.end(), expiresLater);
+    }
+}
+
+bool QNetworkCookieJarPrivate::remove(const QNetworkCookie &cookie)
+{
+    const auto bucket = cookiesByDomain.find(domainKey(cookie.domain()));
+    if (bucket == cookiesByDomain.end())
+        return false;
+
+    for (auto it = bucket->begin(); it != bucket->end(); ++it) {
+        if (it->cookie.hasSameIdentifier(cookie)) {
+            bucket->erase(it);
+            if (bucket->isEmpty())
+                cookiesByDomain.erase(bucket);
+            --cookieCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+void QNetworkCookieJarPrivate::clear()
+{
+    cookiesByDomain.clear();
+    expiryHeap.clear();
+    cookieCount = 0;
+}
+
+void QNetworkCookieJarPrivate::removeExpired(const QDateTime &now)
+{
+    const qint64 nowMSecs = now.toMSecsSinceEpoch();
+    while (!expiryHeap.isEmpty() && expiryHeap.constFirst().expiresAt < nowMSecs) {
+        std::pop_heap(expiryHeap.begin(), expiryHeap.end(), expiresLater);
+        const Expiry expiry = expiryHeap.takeLast();
+
+        const auto bucket = cookiesByDomain.find(expiry.domainKey);
+        if (bucket == cookiesByDomain.end())
+            continue;
+        const auto it = std::find_if(bucket->begin(), bucket->end(),
+                                     [&](const StoredCookie &stored) {
+            return stored.serial == expiry.serial;
+        });
+        if (it == bucket->end())
+            continue;   // already removed
+        bucket->erase(it);
+        if (bucket->isEmpty())
+            cookiesByDomain.erase(bucket);
+        --cookieCount;
+    }
+
+    // Don't let the entries of replaced cookies pile up.
+    if (expiryHeap.size() > 2 * cookieCount + 64) {
+        expiryHeap.clear();
+        for (const QList<StoredCookie> &bucket : std::as_const(cookiesByDomain)) {
+            for (const StoredCookie &stored : bucket) {
+                if (!stored.cookie.isSessionCookie()) {
+                    expiryHeap.append({ stored.cookie.expirationDate().toMSecsSinceEpoch(),
+                                        stored.serial, domainKey(stored.cookie.domain()) });
+                }
+            }
+        }
+        std::make_heap(expiryHeap.begin(), expiryHeap.end(), expiresLater);
+    }
+}
+
+QList<QNetworkCookie> QNetworkCookieJarPrivate::allCookies() const
+{
+    QList<const StoredCookie *> stored;
+    stored.reserve(cookieCount);
+    for (const QList<StoredCookie> &bucket : cookiesByDomain) {
+        for (const StoredCookie &cookie : bucket)
+            stored.append(&cookie);
+    }
+    std::sort(stored.begin(), stored.end(), [](const StoredCookie *lhs, const StoredCookie *rhs) {
+        return lhs->serial < rhs->serial;
+    });
+
+    QList<QNetworkCookie> result;
+    result.reserve(stored.size());
+    for (const StoredCookie *cookie : std::as_const(stored))
+        result.append(cookie->cookie);
+    return result;
+}
+
 /*!
     \class QNetworkCookieJar
     \since 4.4
@@ -128,7 +236,7 @@ QNetworkCookieJar::~QNetworkCookieJar()
 */
 QList<QNetworkCookie> QNetworkCookieJar::allCookies() const
 {
-    return d_func()->allCookies;
+    return d_func()->allCookies();
 }
 
 /*!
@@ -143,7 +251,9 @@ QList<QNetworkCookie> QNetworkCookieJar::allCookies() const
 void QNetworkCookieJar::setAllCookies(const QList<QNetworkCookie> &cookieList)
 {
     Q_D(QNetworkCookieJar);
-    d->allCookies = cookieList;
+    d->clear();
+    for (const QNetworkCookie &cookie : cookieList)
+        d->insert(cookie);
 }
 
 static inline bool isParentPath(const QString &path, const QString &reference)
@@ -233,50 +343,65 @@ QList<QNetworkCookie> QNetworkCookieJar::cookiesForUrl(const QUrl &url) const
 
     Q_D(const QNetworkCookieJar);
     const QDateTime now = QDateTime::currentDateTimeUtc();
-    QList<QNetworkCookie> result;
     bool isEncrypted = url.scheme() == QLatin1String("https");
-
-    // scan our cookies for something that matches
-    QList<QNetworkCookie>::ConstIterator it = d->allCookies.constBegin(),
-                                        end = d->allCookies.constEnd();
-    for ( ; it != end; ++it) {
-        if (!isParentDomain(url.host(), it->domain()))
-            continue;
-        if (!isParentPath(url.path(), it->path()))
-            continue;
-        if (!(*it).isSessionCookie() && (*it).expirationDate() < now)
-            continue;
-        if ((*it).isSecure() && !isEncrypted)
-            continue;
-
-        QString domain = it->domain();
-        if (domain.startsWith(QLatin1Char('.'))) /// Qt6?: remove when compliant with RFC6265
-            domain = domain.mid(1);
+    const QString host = url.host();
+    const QString path = url.path();
+
+    // Only cookies set for the host itself or for one of its parent domains
+    // can match, so look at those buckets alone.
+    QVarLengthArray<const QNetworkCookieJarPrivate::StoredCookie *, 16> matches;
+    qsizetype labelStart = 0;
+    while (true) {
+        const auto bucket = d->cookiesByDomain.constFind(host.mid(labelStart));
+        if (bucket != d->cookiesByDomain.cend()) {
+            for (const QNetworkCookieJarPrivate::StoredCookie &stored : *bucket) {
+                const QNetworkCookie &cookie = stored.cookie;
+                if (!isParentDomain(host, cookie.domain()))
+                    continue;
+                if (!isParentPath(path, cookie.path()))
+                    continue;
+                if (!cookie.isSessionCookie() && cookie.expirationDate() < now)
+                    continue;
+                if (cookie.isSecure() && !isEncrypted)
+                    continue;
+
+                QString domain = cookie.domain();
+                if (domain.startsWith(QLatin1Char('.'))) /// Qt6?: remove when compliant with RFC6265
+                    domain = domain.mid(1);
 #if QT_CONFIG(topleveldomain)
-        if (qIsEffectiveTLD(domain) && url.host() != domain)
-            continue;
+                if (qIsEffectiveTLD(domain) && host != domain)
+                    continue;
 #else
-        if (!domain.contains(QLatin1Char('.')) && url.host() != domain)
-            continue;
+                if (!domain.contains(QLatin1Char('.')) && host != domain)
+                    continue;
 #endif // topleveldomain
 
-        // insert this cookie into result, sorted by path
-        QList<QNetworkCookie>::Iterator insertIt = result.begin();
-        while (insertIt != result.end()) {
-            if (insertIt->path().length() < it->path().length()) {
-                // insert here
-                insertIt = result.insert(insertIt, *it);
-                break;
-            } else {
-                ++insertIt;
+                matches.append(&stored);
             }
         }
 
-        // this is the shortest path yet, just append
-        if (insertIt == result.end())
-            result += *it;
+        const qsizetype dot = host.indexOf(QLatin1Char('.'), labelStart);
+        if (dot < 0)
+            break;
+        labelStart = dot + 1;
     }
 
+    // sort by path, longest first; cookies with paths of the same length
+    // stay in the order they were added to the jar
+    std::sort(matches.begin(), matches.end(),
+              [](const QNetworkCookieJarPrivate::StoredCookie *lhs,
+                 const QNetworkCookieJarPrivate::StoredCookie *rhs) {
+        const qsizetype lhsLength = lhs->cookie.path().length();
+        const qsizetype rhsLength = rhs->cookie.path().length();
+        if (lhsLength != rhsLength)
+            return lhsLength > rhsLength;
+        return lhs->serial < rhs->serial;
+    });
+
+    QList<QNetworkCookie> result;
+    result.reserve(matches.size());
+    for (const QNetworkCookieJarPrivate::StoredCookie *stored : std::as_const(matches))
+        result.append(stored->cookie);
     return result;
 }
 
@@ -287,7 +412,8 @@ QList<QNetworkCookie> QNetworkCookieJar::cookiesForUrl(const QUrl &url) const
     Returns \c true if \a cookie was added, false otherwise.
 
     If a cookie with the same identifier already exists in the
-    cookie jar, it will be overridden.
+    cookie jar, it will be overridden. Cookies in the jar whose expiration
+    date has passed are discarded at the same time.
 */
 bool QNetworkCookieJar::insertCookie(const QNetworkCookie &cookie)
 {
@@ -296,10 +422,11 @@ bool QNetworkCookieJar::insertCookie(const QNetworkCookie &cookie)
     bool isDeletion = !cookie.isSessionCookie() &&
                       cookie.expirationDate() < now;
 
+    d->removeExpired(now);
     deleteCookie(cookie);
 
     if (!isDeletion) {
-        d->allCookies += cookie;
+        d->insert(cookie);
         return true;
     }
     return false;
@@ -333,14 +460,7 @@ bool QNetworkCookieJar::updateCookie(const QNetworkCookie &cookie)
 bool QNetworkCookieJar::deleteCookie(const QNetworkCookie &cookie)
 {
     Q_D(QNetworkCookieJar);
-    QList<QNetworkCookie>::Iterator it;
-    for (it = d->allCookies.begin(); it != d->allCookies.end(); ++it) {
-        if (it->hasSameIdentifier(cookie)) {
-            d->allCookies.erase(it);
-            return true;
-        }
-    }
-    return false;
+    return d->remove(cookie);
 }
 
 /*!
@@ -54,13 +54,39 @@
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include "private/qobject_p.h"
 #include "qnetworkcookie.h"
+#include "QtCore/qhash.h"
 
 QT_BEGIN_NAMESPACE
 
 class QNetworkCookieJarPrivate: public QObjectPrivate
 {
 public:
-    QList<QNetworkCookie> allCookies;
+    struct StoredCookie {
+        QNetworkCookie cookie;
+        quint64 serial;     // insertion order, for allCookies()
+    };
+    struct Expiry {
+        qint64 expiresAt;   // msecs since epoch
+        quint64 serial;
+        QString domainKey;
+    };
+
+    static QString domainKey(const QString &domain);
+    void insert(const QNetworkCookie &cookie);
+    bool remove(const QNetworkCookie &cookie);
+    void clear();
+    void removeExpired(const QDateTime &now);
+    QList<QNetworkCookie> allCookies() const;
+
+    // The cookies, bucketed by their domain without the leading dot. A
+    // request only needs to look at the buckets of its host and of the
+    // host's parent domains.
+    QHash<QString, QList<StoredCookie>> cookiesByDomain;
+    // Min-heap of the expiration times of the persistent cookies. Entries of
+    // cookies that were removed otherwise are dropped lazily.
+    QList<Expiry> expiryHeap;
+    qsizetype cookieCount = 0;
+    quint64 nextSerial = 0;
 
     Q_DECLARE_PUBLIC(QNetworkCookieJar)
 };
@@ -149,6 +149,7 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
     d->cacheDirectory = dir.absolutePath();
     if (!d->cacheDirectory.endsWith(QLatin1Char('/')))
         d->cacheDirectory += QLatin1Char('/');
+    d->resetIndex();
 
     d->dataDirectory = d->cacheDirectory + DATA_DIR + QString::number(CACHE_VERSION) + QLatin1Char('/');
     d->prepareLayout();
@@ -294,9 +295,11 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         && cacheItem->file->error() == QFile::NoError) {
         cacheItem->file->setAutoRemove(false);
         // ### use atomic rename rather then remove & rename
-        if (cacheItem->file->rename(fileName))
-            currentCacheSize += cacheItem->file->size();
-        else
+        if (cacheItem->file->rename(fileName)) {
+            const qint64 size = cacheItem->file->size();
+            currentCacheSize += size;
+            indexFile(fileName, size);
+        } else
             cacheItem->file->setAutoRemove(true);
     }
     if (cacheItem->metaData.url() == lastItem.metaData.url())
@@ -345,11 +348,92 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
     qint64 size = info.size();
     if (QFile::remove(file)) {
         currentCacheSize -= size;
+        unindexFile(file);
         return true;
     }
     return false;
 }
 
+/*!
+    Builds the index of cache files by scanning the cache directory once,
+    ordering the files by their creation date. Files that are still being
+    prepared are not part of the index.
+ */
+void QNetworkDiskCachePrivate::loadIndex()
+{
+    if (indexLoaded)
+        return;
+    resetIndex();
+    indexLoaded = true;
+
+    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
+    QDirIterator it(cacheDirectory, filters, QDirIterator::Subdirectories);
+
+    QMultiMap<QDateTime, QPair<QString, qint64>> cacheItems;
+    while (it.hasNext()) {
+        QFileInfo info = it.nextFileInfo();
+        const QString path = QDir::cleanPath(info.filePath());
+        if (!info.fileName().endsWith(CACHE_POSTFIX) || path.contains(PREPARED_SLASH))
+            continue;
+        const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+        cacheItems.insert(birthTime.isValid() ? birthTime
+                          : info.fileTime(QFile::FileMetadataChangeTime),
+                          qMakePair(path, info.size()));
+    }
+    for (auto i = cacheItems.cbegin(), end = cacheItems.cend(); i != end; ++i)
+        indexFile(i.value().first, i.value().second);
+}
+
+void QNetworkDiskCachePrivate::resetIndex()
+{
+    index.clear();
+    lruList.clear();
+    indexedSize = 0;
+    indexLoaded = false;
+}
+
+/*!
+    Records \a file of \a size bytes as the most recently used cache file.
+ */
+void QNetworkDiskCachePrivate::indexFile(const QString &file, qint64 size)
+{
+    if (!indexLoaded)
+        return;
+    auto it = index.find(file);
+    if (it != index.end()) {
+        indexedSize -= it->size;
+        lruList.splice(lruList.end(), lruList, it->lruPosition);
+        it->size = size;
+    } else {
+        IndexEntry entry;
+        entry.size = size;
+        entry.lruPosition = lruList.insert(lruList.end(), file);
+        index.insert(file, entry);
+    }
+    indexedSize += size;
+}
+
+void QNetworkDiskCachePrivate::touchFile(const QString &file)
+{
+    if (!indexLoaded)
+        return;
+    const auto it = index.constFind(file);
+    if (it != index.cend())
+        lruList.splice(lruList.end(), lruList, it->lruPosition);
+    else
+        indexFile(file, QFileInfo(file).size());
+}
+
+void QNetworkDiskCachePrivate::unindexFile(const QString &file)
+{
+    const auto it = index.constFind(file);
+    if (it == index.cend())
+        return;
+    indexedSize -= it->size;
+    lruList.erase(it->lruPosition);
+    index.erase(it);
+}
+
 /*!
     \reimp
 */
@@ -419,6 +503,7 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
             buffer.reset(new QBuffer);
             buffer->setData(file->readAll());
         }
+        d->touchFile(file->fileName());
     }
     buffer->open(QBuffer::ReadOnly);
     return buffer.release();
@@ -490,8 +575,12 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
 
     When the current size of the cache is greater than the maximumCacheSize()
     older cache files are removed until the total size is less then 90% of
-    maximumCacheSize() starting with the oldest ones first using the file
-    creation date to determine how old a cache file is.
+    maximumCacheSize() starting with the least recently used ones first.
+
+    The cache directory is only scanned the first time this is needed;
+    afterwards the cache keeps track of its files in memory. Files present
+    at that point are ordered by their creation date, files inserted or
+    read afterwards become the most recently used ones.
 
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
@@ -516,56 +605,26 @@ qint64 QNetworkDiskCache::expire()
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
 
-    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
-
-    QMultiMap<QDateTime, QString> cacheItems;
-    qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QFileInfo info = it.nextFileInfo();
-        QString path = info.filePath();
-        QString fileName = info.fileName();
-        if (fileName.endsWith(CACHE_POSTFIX)) {
-            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
-            cacheItems.insert(birthTime.isValid() ? birthTime
-                              : info.fileTime(QFile::FileMetadataChangeTime), path);
-            totalSize += info.size();
-        }
-    }
+    d->loadIndex();
 
     int removedFiles = 0;
     qint64 goal = (maximumCacheSize() * 9) / 10;
-    QMultiMap<QDateTime, QString>::const_iterator i = cacheItems.constBegin();
-    while (i != cacheItems.constEnd()) {
-        if (totalSize < goal)
-            break;
-        QString name = i.value();
-        QFile file(name);
-
-        if (name.contains(PREPARED_SLASH)) {
-            for (QCacheItem *item : qAsConst(d->inserting)) {
-                if (item && item->file && item->file->fileName() == name) {
-                    delete item->file;
-                    item->file = nullptr;
-                    break;
-                }
-            }
-        }
-
-        qint64 size = file.size();
-        file.remove();
-        totalSize -= size;
+    while (!d->lruList.empty() && d->indexedSize >= goal) {
+        const QString name = d->lruList.front();
+        QFile::remove(name);
+        d->unindexFile(name);
         ++removedFiles;
-        ++i;
     }
 #if defined(QNETWORKDISKCACHE_DEBUG)
     if (removedFiles > 0) {
         qDebug() << "QNetworkDiskCache::expire()"
                 << "Removed:" << removedFiles
-                << "Kept:" << cacheItems.count() - removedFiles;
+                << "Kept:" << d->index.count();
     }
+#else
+    Q_UNUSED(removedFiles);
 #endif
-    return totalSize;
+    return d->indexedSize;
 }
 
 /*!
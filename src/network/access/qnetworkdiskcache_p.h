@@ -58,6 +58,8 @@
 #include <qhash.h>
 #include <qtemporaryfile.h>
 
+#include <list>
+
 QT_REQUIRE_CONFIG(networkdiskcache);
 
 QT_BEGIN_NAMESPACE
@@ -111,12 +113,32 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    void loadIndex();
+    void resetIndex();
+    void indexFile(const QString &file, qint64 size);
+    void touchFile(const QString &file);
+    void unindexFile(const QString &file);
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
     qint64 maximumCacheSize;
     qint64 currentCacheSize;
 
+    // In-memory index of the cache files, least recently used first, so
+    // that expire() does not need to walk the cache directory each time
+    // the cache runs full. It is built from a single scan the first time
+    // it is needed and kept up to date by storeItem(), data() and removeFile().
+    struct IndexEntry
+    {
+        qint64 size;
+        std::list<QString>::iterator lruPosition;
+    };
+    QHash<QString, IndexEntry> index;
+    std::list<QString> lruList;
+    qint64 indexedSize = 0;
+    bool indexLoaded = false;
+
     QHash<QIODevice*, QCacheItem*> inserting;
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
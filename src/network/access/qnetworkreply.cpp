@@ -712,6 +712,25 @@ QVariant QNetworkReply::attribute(QNetworkRequest::Attribute code) const
     return d_func()->attributes.value(code);
 }
 
+/*!
+    \since 6.4
+
+    Returns the breakdown of the time spent on the phases of this
+    request: host name lookup, connect, TLS handshake, sending the
+    request and receiving the response.
+
+    The timing is complete once finished() has been emitted. When
+    redirects are followed, it describes the last request only. Only
+    HTTP and HTTPS requests record a timing; for other schemes an invalid
+    QNetworkReplyTiming is returned.
+
+    \sa QNetworkReplyTiming
+*/
+QNetworkReplyTiming QNetworkReply::timing() const
+{
+    return d_func()->timing;
+}
+
 #if QT_CONFIG(ssl)
 /*!
     Returns the SSL configuration and state associated with this
@@ -47,6 +47,7 @@
 
 #include <QtNetwork/QNetworkRequest>
 #include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/qnetworkreplytiming.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -143,6 +144,8 @@ public:
     // attributes
     QVariant attribute(QNetworkRequest::Attribute code) const;
 
+    QNetworkReplyTiming timing() const;
+
 #if QT_CONFIG(ssl)
     QSslConfiguration sslConfiguration() const;
     void setSslConfiguration(const QSslConfiguration &configuration);
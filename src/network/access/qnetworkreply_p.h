@@ -55,6 +55,7 @@
 #include "qnetworkrequest.h"
 #include "qnetworkrequest_p.h"
 #include "qnetworkreply.h"
+#include "qnetworkreplytiming.h"
 #include "QtCore/qpointer.h"
 #include <QtCore/QElapsedTimer>
 #include "private/qiodevice_p.h"
@@ -85,6 +86,7 @@ public:
     QNetworkAccessManager::Operation operation;
     QNetworkReply::NetworkError errorCode;
     bool isFinished;
+    QNetworkReplyTiming timing;
 
     static inline void setManager(QNetworkReply *reply, QNetworkAccessManager *manager)
     { reply->d_func()->manager = manager; }
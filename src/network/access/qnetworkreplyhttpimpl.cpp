@@ -48,6 +48,7 @@
 #include "qnetworkrequest_p.h"
 #include "qnetworkcookie.h"
 #include "qnetworkcookie_p.h"
+#include "QtCore/qcryptographichash.h"
 #include "QtCore/qdatetime.h"
 #include "QtCore/qelapsedtimer.h"
 #include "QtNetwork/qsslconfiguration.h"
@@ -63,6 +64,8 @@
 
 #include "qnetworkreplyimpl_p.h"
 
+#include <qtnetwork_tracepoints_p.h>
+
 #include <string.h>             // for strchr
 
 QT_BEGIN_NAMESPACE
@@ -639,6 +642,7 @@ QHttpNetworkRequest::Priority QNetworkReplyHttpImplPrivate::convert(const QNetwo
 void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpRequest)
 {
     Q_Q(QNetworkReplyHttpImpl);
+    Q_TRACE(QNetworkReplyHttpImpl_postRequest, q, newHttpRequest.url());
 
     QThread *thread = nullptr;
     if (synchronous) {
@@ -648,9 +652,9 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
         QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
         thread->start();
     } else {
-        // We use the manager-global thread.
-        // At some point we could switch to having multiple threads if it makes sense.
-        thread = managerPrivate->createThread();
+        // We use one of the manager's HTTP threads, always the same one for a given host.
+        const QUrl &requestUrl = newHttpRequest.url();
+        thread = managerPrivate->threadForHost(requestUrl.host(), requestUrl.port());
     }
 
     QUrl url = newHttpRequest.url();
@@ -783,6 +787,13 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     for (const QByteArray &header : qAsConst(headers))
         httpRequest.setHeaderField(header, newHttpRequest.rawHeader(header));
 
+    const QByteArray dictionary =
+            request.attribute(QNetworkRequest::CompressionDictionaryAttribute).toByteArray();
+    if (!dictionary.isEmpty() && httpRequest.headerField("Available-Dictionary").isEmpty()) {
+        const QByteArray hash = QCryptographicHash::hash(dictionary, QCryptographicHash::Sha256);
+        httpRequest.setHeaderField("Available-Dictionary", ':' + hash.toBase64() + ':');
+    }
+
     if (newHttpRequest.attribute(QNetworkRequest::HttpPipeliningAllowedAttribute).toBool())
         httpRequest.setPipeliningAllowed(true);
 
@@ -817,6 +828,9 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     QHttpThreadDelegate *delegate = new QHttpThreadDelegate;
     // Propagate Http/2 settings:
     delegate->http2Parameters = request.http2Configuration();
+    // and the pool settings for HTTP/1 connections to this host:
+    delegate->connectionPoolParameters = managerPrivate->connectionPoolConfigurationForHost(url.host());
+    delegate->connectionCacheExpiryTimeoutSeconds = delegate->connectionPoolParameters.idleTimeout().count();
 
     if (request.attribute(QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute).isValid())
         delegate->connectionCacheExpiryTimeoutSeconds = request.attribute(QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute).toInt();
@@ -843,8 +857,10 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
 #endif
     delegate->ssl = ssl;
 #ifndef QT_NO_SSL
-    if (ssl)
+    if (ssl) {
         delegate->incomingSslConfiguration.reset(new QSslConfiguration(newHttpRequest.sslConfiguration()));
+        delegate->sslSessionCache = managerPrivate->sslSessionCache;
+    }
 #endif
 
     // Do we use synchronous HTTP?
@@ -884,6 +900,8 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
                 q, &QNetworkReply::requestSent, Qt::QueuedConnection);
         connect(delegate, &QHttpThreadDelegate::downloadMetaData, this,
                 &QNetworkReplyHttpImplPrivate::replyDownloadMetaData, Qt::QueuedConnection);
+        connect(delegate, &QHttpThreadDelegate::timingChanged, this,
+                &QNetworkReplyHttpImplPrivate::replyTimingChanged, Qt::QueuedConnection);
         QObject::connect(delegate, SIGNAL(downloadProgress(qint64,qint64)),
                 q, SLOT(replyDownloadProgressSlot(qint64,qint64)),
                 Qt::QueuedConnection);
@@ -983,6 +1001,7 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     if (synchronous) {
         emit q->startHttpRequestSynchronously(); // This one is BlockingQueuedConnection, so it will return when all work is done
 
+        replyTimingChanged(delegate->incomingTiming);
         replyDownloadMetaData
                 (delegate->incomingHeaders,
                     delegate->incomingStatusCode,
@@ -1295,8 +1314,10 @@ void QNetworkReplyHttpImplPrivate::followRedirect()
     rawHeaders.clear();
     cookedHeaders.clear();
 
-    if (managerPrivate->thread)
-        managerPrivate->thread->disconnect();
+    for (QThread *thread : std::as_const(managerPrivate->threads)) {
+        if (thread)
+            thread->disconnect();
+    }
 
     QMetaObject::invokeMethod(
             q, [this]() { postRequest(redirectRequest); }, Qt::QueuedConnection);
@@ -1331,6 +1352,7 @@ void QNetworkReplyHttpImplPrivate::replyDownloadMetaData(const QList<QPair<QByte
 {
     Q_Q(QNetworkReplyHttpImpl);
     Q_UNUSED(contentLength);
+    Q_TRACE(QNetworkReplyHttpImpl_metaDataReceived, q, sc);
 
     statusCode = sc;
     reasonPhrase = rp;
@@ -1374,6 +1396,9 @@ void QNetworkReplyHttpImplPrivate::replyDownloadMetaData(const QList<QPair<QByte
             if (!synchronous) // with synchronous all the data is expected to be handled at once
                 decompressHelper.setCountingBytesEnabled(true);
 
+            decompressHelper.setDictionary(
+                    request.attribute(QNetworkRequest::CompressionDictionaryAttribute)
+                            .toByteArray());
             if (!decompressHelper.setEncoding(it->second)) {
                 // error occurred, error copied from QHttpNetworkConnectionPrivate::errorDetail
                 error(QNetworkReplyImpl::NetworkError::ProtocolFailure,
@@ -1520,6 +1545,12 @@ void QNetworkReplyHttpImplPrivate::httpError(QNetworkReply::NetworkError errorCo
     error(errorCode, errorString);
 }
 
+void QNetworkReplyHttpImplPrivate::replyTimingChanged(const QNetworkReplyTiming &newTiming)
+{
+    // Receiving the request timing from the HTTP thread, ahead of replyFinished()
+    timing = newTiming;
+}
+
 #ifndef QT_NO_SSL
 void QNetworkReplyHttpImplPrivate::replyEncrypted()
 {
@@ -2115,6 +2146,7 @@ void QNetworkReplyHttpImplPrivate::finished()
 
     state = Finished;
     q->setFinished(true);
+    Q_TRACE(QNetworkReplyHttpImpl_finished, q, int(errorCode));
 
     if (totalSize.isNull() || totalSize == -1) {
         emit q->downloadProgress(bytesDownloaded, bytesDownloaded);
@@ -0,0 +1,246 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qnetworkreplytiming.h"
+#include "qnetworkreplytiming_p.h"
+
+#include <QtCore/qdebug.h>
+#include <QtCore/qmetaobject.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QNetworkReplyTiming
+    \brief The QNetworkReplyTiming class holds a breakdown of where the time
+    of a network request was spent.
+    \since 6.4
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    QNetworkReplyTiming records when each phase of a request handled by
+    QNetworkAccessManager happened: the host name lookup, the TCP connect,
+    the TLS handshake, sending the request, and receiving the response.
+    All times are reported in nanoseconds relative to the moment the
+    request was started, as measured by a monotonic clock.
+
+    Phases that did not take place for a request are not recorded. For
+    example, a request sent over a connection that was already open has
+    no lookup or connect phase; isConnectionReused() returns \c true in
+    that case. Requests sent over TLS report through isSessionResumed()
+    whether an earlier TLS session was resumed instead of performing a
+    full handshake.
+
+    The timing is currently collected for HTTP and HTTPS requests only.
+    It is complete once QNetworkReply::finished() has been emitted.
+
+    \code
+    connect(reply, &QNetworkReply::finished, [reply] {
+        const QNetworkReplyTiming timing = reply->timing();
+        qDebug() << "TTFB" << timing.elapsed(QNetworkReplyTiming::ResponseStarted) / 1000000 << "ms";
+    });
+    \endcode
+
+    \sa QNetworkReply::timing()
+*/
+
+/*!
+    \enum QNetworkReplyTiming::Event
+
+    This enum lists the points in the lifetime of a request that are
+    recorded.
+
+    \value Started The request was handed to the network layer.
+    \value DomainLookupStarted The host name lookup started.
+    \value DomainLookupFinished The host name lookup finished.
+    \value ConnectStarted The connection to the server (or proxy) was initiated.
+    \value SecureConnectStarted The TCP connection was established and the TLS
+           handshake started.
+    \value ConnectFinished The connection, including any TLS handshake, was
+           established.
+    \value RequestStarted The request was assigned to a connection, after
+           waiting for a free connection if necessary.
+    \value RequestSent The request headers were written to the connection.
+           This is when QNetworkReply::requestSent() is emitted.
+    \value ResponseStarted The response headers were received.
+    \value ResponseFinished The response was fully received or the request
+           failed.
+*/
+
+/*!
+    Constructs an empty, invalid timing object.
+*/
+QNetworkReplyTiming::QNetworkReplyTiming()
+    : d(new QNetworkReplyTimingPrivate)
+{
+}
+
+/*!
+    Copy-constructs a timing object from \a other.
+*/
+QNetworkReplyTiming::QNetworkReplyTiming(const QNetworkReplyTiming &other) = default;
+
+/*!
+    Move-constructs a timing object from \a other.
+*/
+QNetworkReplyTiming::QNetworkReplyTiming(QNetworkReplyTiming &&other) noexcept = default;
+
+/*!
+    Copy-assigns \a other to this timing object.
+*/
+QNetworkReplyTiming &QNetworkReplyTiming::operator=(const QNetworkReplyTiming &other) = default;
+
+/*!
+    Move-assigns \a other to this timing object.
+*/
+QNetworkReplyTiming &QNetworkReplyTiming::operator=(QNetworkReplyTiming &&other) noexcept = default;
+
+/*!
+    Destroys the timing object.
+*/
+QNetworkReplyTiming::~QNetworkReplyTiming() = default;
+
+/*!
+    \fn void QNetworkReplyTiming::swap(QNetworkReplyTiming &other)
+
+    Swaps this timing object with \a other. This operation is very fast
+    and never fails.
+*/
+
+/*!
+    Returns \c true if the start of the request was recorded.
+*/
+bool QNetworkReplyTiming::isValid() const
+{
+    return d->timestamps[Started] != 0;
+}
+
+/*!
+    Returns \c true if \a event was recorded for this request.
+*/
+bool QNetworkReplyTiming::hasEvent(Event event) const
+{
+    return isValid() && d->timestamps[event] != 0;
+}
+
+/*!
+    Returns the time in nanoseconds between the start of the request and
+    \a event, or -1 if \a event was not recorded.
+
+    \sa duration()
+*/
+qint64 QNetworkReplyTiming::elapsed(Event event) const
+{
+    if (!hasEvent(event))
+        return -1;
+    return d->timestamps[event] - d->timestamps[Started];
+}
+
+/*!
+    Returns the time in nanoseconds between \a from and \a to, or -1 if
+    either of the events was not recorded.
+
+    For example, the duration of the TLS handshake is
+    \c{duration(SecureConnectStarted, ConnectFinished)} and the time spent
+    downloading the body is \c{duration(ResponseStarted, ResponseFinished)}.
+
+    \sa elapsed()
+*/
+qint64 QNetworkReplyTiming::duration(Event from, Event to) const
+{
+    if (!hasEvent(from) || !hasEvent(to))
+        return -1;
+    return d->timestamps[to] - d->timestamps[from];
+}
+
+/*!
+    Returns \c true if the request was sent over a connection that had
+    been established for an earlier request.
+*/
+bool QNetworkReplyTiming::isConnectionReused() const
+{
+    return d->connectionReused;
+}
+
+/*!
+    Returns \c true if the TLS handshake of the connection resumed a
+    previous session.
+*/
+bool QNetworkReplyTiming::isSessionResumed() const
+{
+    return d->sessionResumed;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+/*!
+    \relates QNetworkReplyTiming
+
+    Writes \a timing to \a debug, listing the recorded events in milliseconds.
+*/
+QDebug operator<<(QDebug debug, const QNetworkReplyTiming &timing)
+{
+    QDebugStateSaver saver(debug);
+    debug.nospace() << "QNetworkReplyTiming(";
+    if (!timing.isValid())
+        return debug << "invalid)";
+
+    const QMetaEnum events = QMetaEnum::fromType<QNetworkReplyTiming::Event>();
+    const char *separator = "";
+    for (int i = QNetworkReplyTiming::DomainLookupStarted; i <= QNetworkReplyTiming::ResponseFinished; ++i) {
+        const auto event = QNetworkReplyTiming::Event(i);
+        if (!timing.hasEvent(event))
+            continue;
+        debug << separator << events.valueToKey(i) << '=' << timing.elapsed(event) / 1000000.0 << "ms";
+        separator = ", ";
+    }
+    if (timing.isConnectionReused()) {
+        debug << separator << "reused";
+        separator = ", ";
+    }
+    if (timing.isSessionResumed())
+        debug << separator << "resumed";
+    return debug << ')';
+}
+#endif
+
+QT_END_NAMESPACE
+
+#include "moc_qnetworkreplytiming.cpp"
@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QNETWORKREPLYTIMING_H
+#define QNETWORKREPLYTIMING_H
+
+#include <QtNetwork/qtnetworkglobal.h>
+
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qmetatype.h>
+
+QT_BEGIN_NAMESPACE
+
+class QNetworkReplyTimingPrivate;
+class Q_NETWORK_EXPORT QNetworkReplyTiming
+{
+    Q_GADGET
+public:
+    enum Event {
+        Started,
+        DomainLookupStarted,
+        DomainLookupFinished,
+        ConnectStarted,
+        SecureConnectStarted,
+        ConnectFinished,
+        RequestStarted,
+        RequestSent,
+        ResponseStarted,
+        ResponseFinished
+    };
+    Q_ENUM(Event)
+
+    QNetworkReplyTiming();
+    QNetworkReplyTiming(const QNetworkReplyTiming &other);
+    QNetworkReplyTiming(QNetworkReplyTiming &&other) noexcept;
+    QNetworkReplyTiming &operator=(const QNetworkReplyTiming &other);
+    QNetworkReplyTiming &operator=(QNetworkReplyTiming &&other) noexcept;
+    ~QNetworkReplyTiming();
+
+    void swap(QNetworkReplyTiming &other) noexcept { d.swap(other.d); }
+
+    bool isValid() const;
+    bool hasEvent(Event event) const;
+    qint64 elapsed(Event event) const;
+    qint64 duration(Event from, Event to) const;
+
+    bool isConnectionReused() const;
+    bool isSessionResumed() const;
+
+private:
+    friend class QNetworkReplyTimingPrivate;
+    QSharedDataPointer<QNetworkReplyTimingPrivate> d;
+};
+
+Q_DECLARE_SHARED(QNetworkReplyTiming)
+
+#ifndef QT_NO_DEBUG_STREAM
+Q_NETWORK_EXPORT QDebug operator<<(QDebug debug, const QNetworkReplyTiming &timing);
+#endif
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QNetworkReplyTiming)
+
+#endif // QNETWORKREPLYTIMING_H
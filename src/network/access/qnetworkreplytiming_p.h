@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QNETWORKREPLYTIMING_P_H
+#define QNETWORKREPLYTIMING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include "qnetworkreplytiming.h"
+
+#include <QtCore/private/qcoremetrics_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QNetworkReplyTimingPrivate : public QSharedData
+{
+public:
+    static constexpr int EventCount = QNetworkReplyTiming::ResponseFinished + 1;
+
+    static QNetworkReplyTimingPrivate *get(QNetworkReplyTiming &timing)
+    { return timing.d.data(); }
+    static const QNetworkReplyTimingPrivate *get(const QNetworkReplyTiming &timing)
+    { return timing.d.constData(); }
+
+    static qint64 now() noexcept { return QCoreMetrics::timestamp(); }
+
+    // Records the first occurrence only; later calls for the same event
+    // (e.g. a resent request) keep the original timestamp.
+    void record(QNetworkReplyTiming::Event event, qint64 when = now()) noexcept
+    {
+        if (when && !timestamps[event])
+            timestamps[event] = when;
+    }
+
+    // Absolute steady clock timestamps in nanoseconds, 0 if not reached
+    qint64 timestamps[EventCount] = {};
+    bool connectionReused = false;
+    bool sessionResumed = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QNETWORKREPLYTIMING_P_H
@@ -336,6 +336,17 @@ QT_BEGIN_NAMESPACE
         This attribute is ignored if the Http2AllowedAttribute is not set.
         (This value was introduced in 6.3.)
 
+    \value CompressionDictionaryAttribute
+        Requests only, type: QMetaType::QByteArray
+        The contents of a shared compression dictionary the server may have
+        used to compress the reply. If set, QNetworkAccessManager announces
+        the dictionary with an \c{Available-Dictionary} header, accepts the
+        Compression Dictionary Transport encodings when it can decode them,
+        and uses the dictionary when decompressing deflate, Zstandard and
+        dictionary-compressed replies. This attribute has no effect if the
+        \c{Accept-Encoding} header was set explicitly.
+        (This value was introduced in 6.4.)
+
     \value User
         Special type. Additional information can be passed in
         QVariants with types ranging from User to UserMax. The default
@@ -99,6 +99,7 @@ public:
         AutoDeleteReplyOnFinishAttribute,
         ConnectionCacheExpiryTimeoutSecondsAttribute,
         Http2CleartextAllowedAttribute,
+        CompressionDictionaryAttribute,
 
         User = 1000,
         UserMax = 32767
@@ -118,6 +118,25 @@ if_freenameindex(if_nameindex());
 "# FIXME: use: unmapped library: network
 )
 
+# mmsg
+qt_config_compile_test(mmsg
+    LABEL "recvmmsg() and sendmmsg()"
+    CODE
+"#include <sys/types.h>
+#include <sys/socket.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct mmsghdr msgs[2] = {};
+(void)recvmmsg(0, msgs, 2, 0, 0);
+(void)sendmmsg(0, msgs, 2, 0);
+    /* END TEST: */
+    return 0;
+}
+"# FIXME: use: unmapped library: network
+)
+
 # linux-netlink
 qt_config_compile_test(linux_netlink
     LABEL "Linux AF_NETLINK sockets"
@@ -185,6 +204,33 @@ int main(void)
 }
 ")
 
+# ktls
+qt_config_compile_test(ktls
+    LABEL "Kernel TLS offload with OpenSSL"
+    LIBRARIES
+        WrapOpenSSLHeaders::WrapOpenSSLHeaders
+    CODE
+"#include <openssl/ssl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/tls.h>
+#include <sys/socket.h>
+#if defined(OPENSSL_NO_KTLS) || !defined(SSL_OP_ENABLE_KTLS)
+#  error OpenSSL without kernel TLS support
+#endif
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct tls12_crypto_info_aes_gcm_128 info = {};
+(void)setsockopt(0, SOL_TCP, TCP_ULP, \"tls\", sizeof(\"tls\"));
+(void)setsockopt(0, SOL_TLS, TLS_TX, &info, sizeof(info));
+(void)TLS_SET_RECORD_TYPE;
+    /* END TEST: */
+    return 0;
+}
+")
+
 # ocsp
 qt_config_compile_test(ocsp
     LABEL "OCSP stapling support in OpenSSL"
@@ -254,6 +300,10 @@ qt_feature("linux-netlink" PRIVATE
     LABEL "Linux AF_NETLINK"
     CONDITION LINUX AND NOT ANDROID AND TEST_linux_netlink
 )
+qt_feature("mmsg" PRIVATE
+    LABEL "recvmmsg()/sendmmsg()"
+    CONDITION UNIX AND TEST_mmsg
+)
 qt_feature("openssl" PRIVATE
     LABEL "OpenSSL"
     CONDITION QT_FEATURE_openssl_runtime OR QT_FEATURE_openssl_linked
@@ -297,6 +347,10 @@ qt_feature("dtls" PUBLIC
     PURPOSE "Provides a DTLS implementation"
     CONDITION QT_FEATURE_openssl AND QT_FEATURE_udpsocket AND TEST_dtls
 )
+qt_feature("ktls" PRIVATE
+    LABEL "Kernel TLS offload"
+    CONDITION LINUX AND QT_FEATURE_openssl AND TEST_ktls
+)
 qt_feature("ocsp" PUBLIC
     SECTION "Networking"
     LABEL "OCSP-stapling"
@@ -422,6 +476,7 @@ qt_configure_add_summary_entry(ARGS "openssl-linked")
 qt_configure_add_summary_entry(ARGS "opensslv11")
 qt_configure_add_summary_entry(ARGS "dtls")
 qt_configure_add_summary_entry(ARGS "ocsp")
+qt_configure_add_summary_entry(ARGS "ktls")
 qt_configure_add_summary_entry(ARGS "sctp")
 qt_configure_add_summary_entry(ARGS "system-proxies")
 qt_configure_add_summary_entry(ARGS "gssapi")
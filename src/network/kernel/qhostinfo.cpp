@@ -55,6 +55,8 @@
 
 #include <algorithm>
 
+#include <qtnetwork_tracepoints_p.h>
+
 #ifdef Q_OS_UNIX
 #  include <unistd.h>
 #  include <netdb.h>
@@ -427,6 +429,7 @@ QHostInfo QHostInfoAgent::reverseLookup(const QHostAddress &address)
 */
 QHostInfo QHostInfoAgent::lookup(const QString &hostName)
 {
+    Q_TRACE_SCOPE(QHostInfoAgent_lookup, hostName);
     QHostInfo results;
 
     // IDN support
@@ -237,15 +237,67 @@
 
 #include "qauthenticator.h"
 #include "qdebug.h"
+#include "qdeadlinetimer.h"
+#include "qhash.h"
 #include "qmutex.h"
+#include "qnetworkinformation.h"
+#include "qpointer.h"
 #include "qstringlist.h"
 #include "qurl.h"
 
+#if defined(Q_OS_WIN) || defined(Q_OS_MACOS) || QT_CONFIG(libproxy)
+// These backends may run a PAC script or do a D-Bus round trip to answer a
+// query, so remember the answer for each host for a little while.
+#  define QT_CACHE_SYSTEM_PROXIES
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QSocks5SocketEngineHandler;
 class QHttpSocketEngineHandler;
 
+#ifdef QT_CACHE_SYSTEM_PROXIES
+namespace {
+struct SystemProxyCacheKey
+{
+    QNetworkProxyQuery::QueryType queryType;
+    QString protocolTag;
+    QString hostName;
+    int peerPort;
+    int localPort;
+
+    explicit SystemProxyCacheKey(const QNetworkProxyQuery &query)
+        : queryType(query.queryType()), protocolTag(query.protocolTag()),
+          hostName(query.peerHostName()), peerPort(query.peerPort()),
+          localPort(query.localPort())
+    {
+    }
+
+    friend bool operator==(const SystemProxyCacheKey &lhs, const SystemProxyCacheKey &rhs) noexcept
+    {
+        return lhs.queryType == rhs.queryType && lhs.peerPort == rhs.peerPort
+                && lhs.localPort == rhs.localPort && lhs.hostName == rhs.hostName
+                && lhs.protocolTag == rhs.protocolTag;
+    }
+
+    friend size_t qHash(const SystemProxyCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, int(key.queryType), key.protocolTag, key.hostName,
+                          key.peerPort, key.localPort);
+    }
+};
+
+struct SystemProxyCacheEntry
+{
+    QList<QNetworkProxy> proxies;
+    QDeadlineTimer expiry;
+};
+
+constexpr int SystemProxyCacheTimeout = 60 * 1000; // ms
+constexpr qsizetype SystemProxyCacheMaxSize = 256;
+} // unnamed namespace
+#endif // QT_CACHE_SYSTEM_PROXIES
+
 class QGlobalNetworkProxy
 {
 public:
@@ -293,6 +345,7 @@ public:
     {
         QMutexLocker lock(&mutex);
         useSystemProxies = enable;
+        clearSystemProxyCache();
 
         if (useSystemProxies) {
             if (applicationLevelProxy)
@@ -333,6 +386,9 @@ public:
     QList<QNetworkProxy> proxyForQuery(const QNetworkProxyQuery &query);
 
 private:
+    QList<QNetworkProxy> systemProxyForQuery(const QNetworkProxyQuery &query);
+    void clearSystemProxyCache();
+
     QRecursiveMutex mutex;
     QNetworkProxy *applicationLevelProxy;
     QNetworkProxyFactory *applicationLevelProxyFactory;
@@ -343,8 +399,54 @@ private:
     QHttpSocketEngineHandler *httpSocketEngineHandler;
 #endif
     bool useSystemProxies;
+#ifdef QT_CACHE_SYSTEM_PROXIES
+    QHash<SystemProxyCacheKey, SystemProxyCacheEntry> systemProxyCache;
+    QPointer<QNetworkInformation> watchedNetworkInformation;
+#endif
 };
 
+Q_GLOBAL_STATIC(QGlobalNetworkProxy, globalNetworkProxy)
+
+QList<QNetworkProxy> QGlobalNetworkProxy::systemProxyForQuery(const QNetworkProxyQuery &query)
+{
+#ifdef QT_CACHE_SYSTEM_PROXIES
+    // The network we are on decides which proxy applies, so forget everything
+    // when it changes. This only works if the application loaded a backend.
+    QNetworkInformation *info = QNetworkInformation::instance();
+    if (info && info != watchedNetworkInformation) {
+        watchedNetworkInformation = info;
+        const auto invalidate = [] {
+            if (QGlobalNetworkProxy *global = globalNetworkProxy()) {
+                QMutexLocker locker(&global->mutex);
+                global->clearSystemProxyCache();
+            }
+        };
+        QObject::connect(info, &QNetworkInformation::reachabilityChanged, invalidate);
+        QObject::connect(info, &QNetworkInformation::transportMediumChanged, invalidate);
+    }
+
+    const SystemProxyCacheKey key(query);
+    auto it = systemProxyCache.constFind(key);
+    if (it != systemProxyCache.constEnd() && !it->expiry.hasExpired())
+        return it->proxies;
+
+    const QList<QNetworkProxy> result = QNetworkProxyFactory::systemProxyForQuery(query);
+    if (it == systemProxyCache.constEnd() && systemProxyCache.size() >= SystemProxyCacheMaxSize)
+        systemProxyCache.clear();
+    systemProxyCache.insert(key, { result, QDeadlineTimer(SystemProxyCacheTimeout) });
+    return result;
+#else
+    return QNetworkProxyFactory::systemProxyForQuery(query);
+#endif
+}
+
+void QGlobalNetworkProxy::clearSystemProxyCache()
+{
+#ifdef QT_CACHE_SYSTEM_PROXIES
+    systemProxyCache.clear();
+#endif
+}
+
 QList<QNetworkProxy> QGlobalNetworkProxy::proxyForQuery(const QNetworkProxyQuery &query)
 {
     QMutexLocker locker(&mutex);
@@ -367,7 +469,7 @@ QList<QNetworkProxy> QGlobalNetworkProxy::proxyForQuery(const QNetworkProxyQuery
             && applicationLevelProxy->type() != QNetworkProxy::DefaultProxy) {
             result << *applicationLevelProxy;
         } else if (useSystemProxies) {
-            result = QNetworkProxyFactory::systemProxyForQuery(query);
+            result = systemProxyForQuery(query);
 
             // Make sure NoProxy is in the list, so that QTcpServer can work:
             // it searches for the first proxy that can has the ListeningCapability capability
@@ -390,8 +492,6 @@ QList<QNetworkProxy> QGlobalNetworkProxy::proxyForQuery(const QNetworkProxyQuery
     return result;
 }
 
-Q_GLOBAL_STATIC(QGlobalNetworkProxy, globalNetworkProxy)
-
 namespace {
     template<bool> struct StaticAssertTest;
     template<> struct StaticAssertTest<true> { enum { Value = 1 }; };
@@ -1426,6 +1526,13 @@ bool QNetworkProxyFactory::usesSystemConfiguration()
 
     \note See the systemProxyForQuery() documentation for a list of
     limitations related to the use of system proxies.
+
+    \note On Windows, \macos and with libproxy, the system is asked at most
+    once a minute for each host, port and protocol; the answer is reused in
+    between. The remembered answers are dropped when this function is
+    called, and when reachability or the transport medium changes if the
+    application has loaded a QNetworkInformation backend. This caching was
+    introduced in Qt 6.4.
 */
 void QNetworkProxyFactory::setUseSystemConfiguration(bool enable)
 {
@@ -476,6 +476,7 @@
 #include <qpointer.h>
 #include <qtimer.h>
 #include <qelapsedtimer.h>
+#include <qfile.h>
 #include <qscopedvaluerollback.h>
 #include <qvarlengtharray.h>
 
@@ -501,6 +502,12 @@
 QT_BEGIN_NAMESPACE
 
 static const int DefaultConnectTimeout = 30000;
+// How long a connection attempt gets before the next address is tried in
+// parallel, as recommended by RFC 8305, section 5.
+static const int ConnectionAttemptDelay = 250;
+// The number of write buffer chunks passed to the socket engine at once;
+// POSIX guarantees that writev() accepts at least this many.
+static const int MaxWriteChunks = 16;
 
 static bool isProxyError(QAbstractSocket::SocketError error)
 {
@@ -564,6 +571,17 @@ void QAbstractSocketPrivate::resetSocketLayer()
     qDebug("QAbstractSocketPrivate::resetSocketLayer()");
 #endif
 
+    abandonConnectionAttempts();
+    resetSocketEngine();
+}
+
+/*! \internal
+
+    Resets the socket engine of the current connection attempt, leaving
+    earlier attempts that are still racing against it alone.
+*/
+void QAbstractSocketPrivate::resetSocketEngine()
+{
     hasPendingData = false;
     if (socketEngine) {
         socketEngine->close();
@@ -602,7 +620,7 @@ bool QAbstractSocketPrivate::initSocketLayer(QAbstractSocket::NetworkLayerProtoc
     else protocolStr = QLatin1String("UnknownNetworkLayerProtocol");
 #endif
 
-    resetSocketLayer();
+    resetSocketEngine();
     socketEngine = QAbstractSocketEngine::createSocketEngine(q->socketType(), proxyInUse, q);
     if (!socketEngine) {
         setError(QAbstractSocket::UnsupportedSocketOperationError,
@@ -781,7 +799,8 @@ void QAbstractSocketPrivate::connectionNotification()
 
 /*! \internal
 
-    Writes one pending data block in the write buffer to the socket.
+    Writes pending data blocks in the write buffer to the socket, gathering
+    up to MaxWriteChunks of them into one call to the socket engine.
 
     It is usually invoked by canWriteNotification after one or more
     calls to write().
@@ -791,7 +810,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (!hasPendingWrites()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -809,11 +828,42 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    qint64 written;
+    if (!fileTransfers.isEmpty() && fileTransfers.constFirst().precedingBytes == 0) {
+        // Everything written before the file has gone out; send the file.
+        written = writeFileToSocket();
+    } else {
+        // Don't overtake a pending file—only write the data queued before it.
+        qint64 available = writeBuffer.size();
+        if (!fileTransfers.isEmpty())
+            available = qMin(available, fileTransfers.constFirst().precedingBytes);
+
+        // Hand as many chunks as we can to the engine at once, so that small
+        // writes go out in one system call.
+        QByteArrayView chunks[MaxWriteChunks];
+        int count = 0;
+        qint64 gathered = 0;
+        while (gathered < available && count < MaxWriteChunks) {
+            qint64 length;
+            const char *ptr = writeBuffer.readPointerAtPosition(gathered, length);
+            length = qMin(length, available - gathered);
+            chunks[count++] = QByteArrayView(ptr, length);
+            gathered += length;
+        }
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+        if (count == 0)
+            written = 0;
+        else if (count == 1)
+            written = socketEngine->write(chunks[0].data(), chunks[0].size());
+        else
+            written = socketEngine->writeChunks(chunks, count);
+        if (written > 0) {
+            // Remove what we wrote so far.
+            writeBuffer.free(written);
+            if (!fileTransfers.isEmpty())
+                fileTransfers.first().precedingBytes -= written;
+        }
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -831,14 +881,11 @@ bool QAbstractSocketPrivate::writeToSocket()
 #endif
 
     if (written > 0) {
-        // Remove what we wrote so far.
-        writeBuffer.free(written);
-
         // Emit notifications.
         emitBytesWritten(written);
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -846,6 +893,67 @@ bool QAbstractSocketPrivate::writeToSocket()
     return written > 0;
 }
 
+/*! \internal
+
+    Sends the next chunk of the first pending file transfer. The chunk goes
+    through QAbstractSocketEngine::sendFile() when possible, otherwise it is
+    read into a temporary buffer and written normally. Returns the number of
+    bytes written, or -1 on error (in which case the socket engine's error is
+    set).
+*/
+qint64 QAbstractSocketPrivate::writeFileToSocket()
+{
+    PendingFileTransfer &transfer = fileTransfers.first();
+    if (!transfer.file || !transfer.file->isReadable()) {
+        // The file went away: drop the rest of it, since we cannot send it.
+        fileTransfers.removeFirst();
+        return 0;
+    }
+
+    qint64 written = -2;
+    if (transfer.useSendFile) {
+        written = socketEngine->sendFile(transfer.file->handle(), transfer.offset,
+                                         transfer.remaining);
+        if (written == -2)
+            transfer.useSendFile = false;
+    }
+
+    if (!transfer.useSendFile) {
+        char buffer[QABSTRACTSOCKET_BUFFERSIZE];
+        const qint64 chunkSize = qMin(transfer.remaining, qint64(sizeof buffer));
+        qint64 readBytes = -1;
+        if (transfer.file->seek(transfer.offset))
+            readBytes = transfer.file->read(buffer, chunkSize);
+        if (readBytes <= 0) {
+            // The file was truncated or can no longer be read.
+            fileTransfers.removeFirst();
+            return 0;
+        }
+        written = socketEngine->write(buffer, readBytes);
+    }
+
+    if (written > 0) {
+        transfer.offset += written;
+        transfer.remaining -= written;
+        if (transfer.remaining == 0)
+            fileTransfers.removeFirst();
+    }
+    return written;
+}
+
+/*! \internal
+
+    Returns the number of bytes of pending file transfers that have not been
+    written yet.
+*/
+qint64 QAbstractSocketPrivate::pendingFileBytes() const
+{
+    qint64 pending = 0;
+    for (const PendingFileTransfer &transfer : fileTransfers)
+        pending += transfer.remaining;
+    return pending;
+}
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
@@ -856,7 +964,7 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || !fileTransfers.isEmpty()) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
@@ -953,6 +1061,37 @@ void QAbstractSocketPrivate::startConnectingByName(const QString &host)
 
 #endif // !QT_NO_NETWORKPROXY
 
+/*! \internal
+
+    Reorders \a addresses as described in RFC 8305, section 4: address
+    families alternate, starting with the family of the most preferred
+    address, so that a broken IPv6 (or IPv4) path costs at most one connection
+    attempt before the other family is tried.
+*/
+static QList<QHostAddress> interleaveAddressFamilies(const QList<QHostAddress> &addresses)
+{
+    if (addresses.isEmpty())
+        return addresses;
+
+    const QAbstractSocket::NetworkLayerProtocol firstFamily = addresses.first().protocol();
+    QList<QHostAddress> preferred;
+    QList<QHostAddress> others;
+    for (const QHostAddress &address : addresses)
+        (address.protocol() == firstFamily ? preferred : others).append(address);
+    if (others.isEmpty())
+        return addresses;
+
+    QList<QHostAddress> result;
+    result.reserve(addresses.size());
+    for (qsizetype i = 0; i < qMax(preferred.size(), others.size()); ++i) {
+        if (i < preferred.size())
+            result.append(preferred.at(i));
+        if (i < others.size())
+            result.append(others.at(i));
+    }
+    return result;
+}
+
 /*! \internal
 
     Slot connected to QHostInfo::lookupHost() in connectToHost(). This
@@ -974,7 +1113,7 @@ void QAbstractSocketPrivate::_q_startConnecting(const QHostInfo &hostInfo)
     // Only add the addresses for the preferred network layer.
     // Or all if preferred network layer is not set.
     if (preferredNetworkLayerProtocol == QAbstractSocket::UnknownNetworkLayerProtocol || preferredNetworkLayerProtocol == QAbstractSocket::AnyIPProtocol) {
-        addresses = hostInfo.addresses();
+        addresses = interleaveAddressFamilies(hostInfo.addresses());
     } else {
         const auto candidates = hostInfo.addresses();
         for (const QHostAddress &address : candidates) {
@@ -1019,7 +1158,8 @@ void QAbstractSocketPrivate::_q_startConnecting(const QHostInfo &hostInfo)
     emit q->hostFound();
 
     // The addresses returned by the lookup will be tested one after
-    // another by _q_connectToNextAddress().
+    // another by _q_connectToNextAddress(); an attempt that takes long is
+    // raced against the next one (see startNextConnectionAttempt()).
     _q_connectToNextAddress();
 }
 
@@ -1038,6 +1178,14 @@ void QAbstractSocketPrivate::_q_connectToNextAddress()
     do {
         // Check for more pending addresses
         if (addresses.isEmpty()) {
+            if (!connectionAttempts.isEmpty()) {
+                // An attempt that was overtaken earlier may still succeed;
+                // testConnectionAttempt() comes back here if none does.
+                waitingForConnectionAttempts = true;
+                if (connectTimer)
+                    connectTimer->start(DefaultConnectTimeout);
+                return;
+            }
 #if defined(QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocketPrivate::_q_connectToNextAddress(), all addresses failed.");
 #endif
@@ -1109,6 +1257,17 @@ void QAbstractSocketPrivate::_q_connectToNextAddress()
             }
             int connectTimeout = DefaultConnectTimeout;
             connectTimer->start(connectTimeout);
+
+            if (!addresses.isEmpty() && canRaceConnectionAttempts()) {
+                if (!connectionAttemptDelayTimer) {
+                    connectionAttemptDelayTimer = new QTimer(q);
+                    connectionAttemptDelayTimer->setSingleShot(true);
+                    QObject::connect(connectionAttemptDelayTimer, &QTimer::timeout, q,
+                                     [this] { startNextConnectionAttempt(); },
+                                     Qt::DirectConnection);
+                }
+                connectionAttemptDelayTimer->start(ConnectionAttemptDelay);
+            }
         }
 
         // Wait for a write notification that will eventually call
@@ -1171,6 +1330,7 @@ void QAbstractSocketPrivate::_q_abortConnectionAttempt()
     connectTimer->stop();
 
     if (addresses.isEmpty()) {
+        abandonConnectionAttempts();
         state = QAbstractSocket::UnconnectedState;
         setError(QAbstractSocket::SocketTimeoutError,
                  QAbstractSocket::tr("Connection timed out"));
@@ -1181,6 +1341,117 @@ void QAbstractSocketPrivate::_q_abortConnectionAttempt()
     }
 }
 
+/*! \internal
+
+    Returns \c true if a connection attempt that takes long may be raced
+    against an attempt to the next address. This needs an event loop, and a
+    direct connection: through a proxy, the attempts would only race to the
+    proxy.
+*/
+bool QAbstractSocketPrivate::canRaceConnectionAttempts() const
+{
+    if (socketType != QAbstractSocket::TcpSocket || cachedSocketDescriptor != -1
+        || !threadData.loadRelaxed()->hasEventDispatcher()) {
+        return false;
+    }
+#ifndef QT_NO_NETWORKPROXY
+    if (proxyInUse.type() != QNetworkProxy::NoProxy)
+        return false;
+#endif
+    return true;
+}
+
+/*! \internal
+
+    Called when the current connection attempt has not completed within
+    ConnectionAttemptDelay. Keeps that attempt going in the background and
+    starts one to the next address (RFC 8305, section 5); whichever of them
+    connects first wins.
+*/
+void QAbstractSocketPrivate::startNextConnectionAttempt()
+{
+    if (state != QAbstractSocket::ConnectingState || addresses.isEmpty() || !socketEngine
+        || socketEngine->state() != QAbstractSocket::ConnectingState) {
+        return;
+    }
+
+#if defined(QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::startNextConnectionAttempt(), %s is slow, trying the next address",
+           host.toString().toLatin1().constData());
+#endif
+    auto *attempt = new ConnectionAttempt;
+    attempt->d = this;
+    attempt->engine = socketEngine;
+    attempt->address = host;
+    socketEngine->setReceiver(attempt);
+    connectionAttempts.append(attempt);
+    socketEngine = nullptr;
+
+    if (connectTimer)
+        connectTimer->stop();
+    _q_connectToNextAddress();
+}
+
+/*! \internal
+
+    Called when the connection attempt \a attempt, overtaken by a later one,
+    has completed. If it succeeded, the socket continues with its engine and
+    all other attempts are dropped; otherwise, it is discarded.
+*/
+void QAbstractSocketPrivate::testConnectionAttempt(ConnectionAttempt *attempt)
+{
+    connectionAttempts.removeOne(attempt);
+    QAbstractSocketEngine *engine = attempt->engine;
+    const QHostAddress address = attempt->address;
+    delete attempt;
+
+    if (state == QAbstractSocket::ConnectingState
+        && engine->state() == QAbstractSocket::ConnectedState) {
+#if defined(QABSTRACTSOCKET_DEBUG)
+        qDebug("QAbstractSocketPrivate::testConnectionAttempt(), earlier attempt to %s won",
+               address.toString().toLatin1().constData());
+#endif
+        resetSocketEngine();
+        socketEngine = engine;
+        socketEngine->setReceiver(this);
+        host = address;
+        fetchConnectionParameters();
+        if (pendingClose) {
+            q_func()->disconnectFromHost();
+            pendingClose = false;
+        }
+        return;
+    }
+
+    engine->close();
+    engine->disconnect();
+    delete engine;
+
+    if (waitingForConnectionAttempts && connectionAttempts.isEmpty()) {
+        // This was the last hope; report the failure.
+        waitingForConnectionAttempts = false;
+        _q_connectToNextAddress();
+    }
+}
+
+/*! \internal
+
+    Drops all connection attempts that were overtaken by a later one.
+*/
+void QAbstractSocketPrivate::abandonConnectionAttempts()
+{
+    if (connectionAttemptDelayTimer)
+        connectionAttemptDelayTimer->stop();
+    waitingForConnectionAttempts = false;
+    for (ConnectionAttempt *attempt : std::as_const(connectionAttempts)) {
+        attempt->engine->close();
+        attempt->engine->disconnect();
+        delete attempt->engine;
+        delete attempt;
+    }
+    connectionAttempts.clear();
+}
+
 /*! \internal
 
     Reads data from the socket layer into the read buffer. Returns
@@ -1290,6 +1561,7 @@ void QAbstractSocketPrivate::fetchConnectionParameters()
 {
     Q_Q(QAbstractSocket);
 
+    abandonConnectionAttempts();
     peerName = hostName;
     if (socketEngine) {
         if (q->isReadable()) {
@@ -1754,7 +2026,7 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    const qint64 pendingBytes = QIODevice::bytesToWrite() + d_func()->pendingFileBytes();
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -2095,6 +2367,9 @@ bool QAbstractSocket::waitForConnected(int msecs)
     if (state() == UnconnectedState)
         return false; // connect not im progress anymore!
 
+    // Only the current attempt can be waited for.
+    d->abandonConnectionAttempts();
+
     int connectTimeout = DefaultConnectTimeout;
     bool timedOut = true;
 #if defined (QABSTRACTSOCKET_DEBUG)
@@ -2181,7 +2456,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2233,7 +2508,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (!d->hasPendingWrites())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2250,7 +2525,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  d->hasPendingWrites(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2330,7 +2605,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               d->hasPendingWrites(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2367,6 +2642,7 @@ void QAbstractSocket::abort()
     qDebug("QAbstractSocket::abort()");
 #endif
     d->setWriteChannelCount(0);
+    d->fileTransfers.clear();
     d->abortCalled = true;
     close();
 }
@@ -2449,7 +2725,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     }
 
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && !d->hasPendingWrites() && !d->corked) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2490,7 +2766,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     d->write(data, size);
     qint64 written = size;
 
-    if (d->socketEngine && !d->writeBuffer.isEmpty())
+    if (d->socketEngine && !d->writeBuffer.isEmpty() && !d->corked)
         d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined (QABSTRACTSOCKET_DEBUG)
@@ -2599,6 +2875,146 @@ void QAbstractSocket::setPeerName(const QString &name)
     d->peerName = name;
 }
 
+/*!
+    \since 6.4
+
+    Queues \a length bytes of \a file, starting at \a offset, to be written
+    to the socket after any data already written. If \a length is -1 or
+    extends past the end of the file, everything up to the end of the file is
+    sent. Returns the number of bytes queued, or -1 if an error occurred.
+
+    \a file must be open for reading and must stay alive until the data has
+    been written; bytesWritten() is emitted as usual while it is sent, and
+    bytesToWrite() includes the bytes not yet sent. On platforms that support
+    it (currently Linux), the data is passed from the file to the network by
+    the kernel without being copied into the application; elsewhere, and for
+    sockets such as QSslSocket that must process the data themselves, the file
+    is read in chunks and written like regular data. An encrypted QSslSocket
+    can still use the zero-copy path once QSsl::SslOptionEnableKernelTls has
+    taken effect; it then reports the progress through
+    QSslSocket::encryptedBytesWritten(). The current position of \a file is
+    not preserved.
+
+    This function only works for TCP sockets.
+
+    \sa write(), flush(), bytesToWrite()
+*/
+qint64 QAbstractSocket::sendFile(QFile *file, qint64 offset, qint64 length)
+{
+    Q_D(QAbstractSocket);
+    if (d->socketType != TcpSocket) {
+        d->setError(UnsupportedSocketOperationError, tr("Operation on socket is not supported"));
+        return -1;
+    }
+    if (d->state == UnconnectedState || !isWritable()) {
+        d->setError(UnknownSocketError, tr("Socket is not connected"));
+        return -1;
+    }
+    if (!file || !file->isReadable()) {
+        d->setError(UnknownSocketError, tr("File is not open for reading"));
+        return -1;
+    }
+
+    const qint64 fileSize = file->size();
+    if (offset < 0 || offset > fileSize) {
+        d->setError(UnknownSocketError, tr("Invalid file offset"));
+        return -1;
+    }
+    if (length < 0 || length > fileSize - offset)
+        length = fileSize - offset;
+    if (length == 0)
+        return 0;
+
+    if (!d->canSendFiles()) {
+        // A wrapping socket may still be able to hand the file to the socket
+        // it wraps.
+        const qint64 forwarded = d->forwardFile(file, offset, length);
+        if (forwarded >= 0)
+            return forwarded;
+
+        // The data has to go through writeData(), so copy it in chunks.
+        if (!file->seek(offset))
+            return -1;
+        char buffer[QABSTRACTSOCKET_BUFFERSIZE];
+        qint64 queued = 0;
+        while (queued < length) {
+            const qint64 readBytes = file->read(buffer, qMin(length - queued,
+                                                            qint64(sizeof buffer)));
+            if (readBytes <= 0 || write(buffer, readBytes) != readBytes)
+                break;
+            queued += readBytes;
+        }
+        return queued ? queued : -1;
+    }
+
+    // Make sure what was written through QFile is visible through the handle.
+    if (file->isWritable())
+        file->flush();
+
+    qint64 precedingBytes = d->writeBuffer.size();
+    for (const QAbstractSocketPrivate::PendingFileTransfer &transfer : std::as_const(d->fileTransfers))
+        precedingBytes -= transfer.precedingBytes;
+    d->fileTransfers.append({ file, offset, length, precedingBytes, file->handle() != -1 });
+
+    if (d->socketEngine && !d->corked)
+        d->socketEngine->setWriteNotificationEnabled(true);
+    return length;
+}
+
+/*!
+    \since 6.4
+
+    Holds back data written to the socket until uncork() is called.
+
+    While the socket is corked, write() and sendFile() only queue data; it is
+    not sent when control returns to the event loop. This lets a protocol
+    implementation build a complete message from several small writes, such as
+    a header followed by a body, and have it sent with as few system calls and
+    network packets as possible. Calling flush() or waitForBytesWritten()
+    still sends the queued data immediately, and disconnectFromHost() uncorks
+    the socket.
+
+    The socket is buffered while it is corked, even if it was opened with
+    QIODevice::Unbuffered.
+
+    \sa uncork(), isCorked(), flush()
+*/
+void QAbstractSocket::cork()
+{
+    d_func()->corked = true;
+}
+
+/*!
+    \since 6.4
+
+    Releases the data held back since cork() was called. The data is sent
+    once control returns to the event loop; call flush() to start sending it
+    right away.
+
+    \sa cork(), isCorked()
+*/
+void QAbstractSocket::uncork()
+{
+    Q_D(QAbstractSocket);
+    if (!d->corked)
+        return;
+    d->corked = false;
+    if (d->socketEngine && d->hasPendingWrites())
+        d->socketEngine->setWriteNotificationEnabled(true);
+}
+
+/*!
+    \since 6.4
+
+    Returns \c true if the socket is corked; otherwise returns \c false.
+
+    \sa cork(), uncork()
+*/
+bool QAbstractSocket::isCorked() const
+{
+    return d_func()->corked;
+}
+
 /*!
     Closes the I/O device for the socket and calls disconnectFromHost()
     to close the socket's connection.
@@ -2653,6 +3069,9 @@ void QAbstractSocket::disconnectFromHost()
     if (d->socketEngine)
         d->socketEngine->setReadNotificationEnabled(false);
 
+    // Data held back by cork() has to go out before the connection closes.
+    d->corked = false;
+
     if (d->abortCalled) {
 #if defined(QABSTRACTSOCKET_DEBUG)
         qDebug("QAbstractSocket::disconnectFromHost() aborting immediately");
@@ -2677,7 +3096,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
-            || d->socketEngine->bytesToWrite() > 0)) {
+            || !d->fileTransfers.isEmpty() || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined(QABSTRACTSOCKET_DEBUG)
@@ -2707,6 +3126,7 @@ void QAbstractSocket::disconnectFromHost()
     d->peerAddress.clear();
     d->peerName.clear();
     d->setWriteChannelCount(0);
+    d->fileTransfers.clear();
 
 #if defined(QABSTRACTSOCKET_DEBUG)
         qDebug("QAbstractSocket::disconnectFromHost() disconnected!");
@@ -62,6 +62,7 @@ class QNetworkProxy;
 #endif
 class QAbstractSocketPrivate;
 class QAuthenticator;
+class QFile;
 
 class Q_NETWORK_EXPORT QAbstractSocket : public QIODevice
 {
@@ -209,6 +210,10 @@ public:
     void close() override;
     bool isSequential() const override;
     bool flush();
+    qint64 sendFile(QFile *file, qint64 offset = 0, qint64 length = -1);
+    void cork();
+    void uncork();
+    bool isCorked() const;
 
     // for synchronous access
     virtual bool waitForConnected(int msecs = 30000);
@@ -55,6 +55,7 @@
 #include "QtNetwork/qabstractsocket.h"
 #include "QtCore/qbytearray.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qpointer.h"
 #include "QtCore/qtimer.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
@@ -63,6 +64,7 @@
 QT_BEGIN_NAMESPACE
 
 class QHostInfo;
+class QFile;
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
 {
@@ -73,7 +75,13 @@ public:
 
     // from QAbstractSocketEngineReceiver
     inline void readNotification() override { canReadNotification(); }
-    inline void writeNotification() override { canWriteNotification(); }
+    inline void writeNotification() override
+    {
+        if (!corked)
+            canWriteNotification();
+        else if (socketEngine)
+            socketEngine->setWriteNotificationEnabled(false);
+    }
     inline void exceptionNotification() override {}
     inline void closeNotification() override { canCloseNotification(); }
     void connectionNotification() override;
@@ -96,6 +104,31 @@ public:
     void _q_testConnection();
     void _q_abortConnectionAttempt();
 
+    // RFC 8305 ("Happy Eyeballs"): a connection attempt that was overtaken
+    // by an attempt to the next address, but may still complete first.
+    struct ConnectionAttempt : public QAbstractSocketEngineReceiver
+    {
+        QAbstractSocketPrivate *d = nullptr;
+        QAbstractSocketEngine *engine = nullptr;
+        QHostAddress address;
+
+        void readNotification() override {}
+        void writeNotification() override {}
+        void exceptionNotification() override {}
+        void closeNotification() override {}
+        void connectionNotification() override { d->testConnectionAttempt(this); }
+#ifndef QT_NO_NETWORKPROXY
+        void proxyAuthenticationRequired(const QNetworkProxy &, QAuthenticator *) override {}
+#endif
+    };
+    QList<ConnectionAttempt *> connectionAttempts;
+    QTimer *connectionAttemptDelayTimer = nullptr;
+    bool waitingForConnectionAttempts = false;
+    bool canRaceConnectionAttempts() const;
+    void startNextConnectionAttempt();
+    void testConnectionAttempt(ConnectionAttempt *attempt);
+    void abandonConnectionAttempts();
+
     bool emittedReadyRead;
     bool emittedBytesWritten;
 
@@ -129,6 +162,7 @@ public:
     inline void resolveProxy(quint16 port) { resolveProxy(QString(), port); }
 
     void resetSocketLayer();
+    void resetSocketEngine();
     virtual bool flush();
 
     bool initSocketLayer(QAbstractSocket::NetworkLayerProtocol protocol);
@@ -137,14 +171,31 @@ public:
     void fetchConnectionParameters();
     bool readFromSocket();
     virtual bool writeToSocket();
+    qint64 writeFileToSocket();
+    virtual bool canSendFiles() const { return true; }
+    virtual qint64 forwardFile(QFile *, qint64, qint64) { return -1; }
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
+    struct PendingFileTransfer {
+        QPointer<QFile> file;
+        qint64 offset;
+        qint64 remaining;
+        // bytes of writeBuffer that must be written before this file
+        qint64 precedingBytes;
+        bool useSendFile;
+    };
+    QList<PendingFileTransfer> fileTransfers;
+    qint64 pendingFileBytes() const;
+    inline bool hasPendingWrites() const
+    { return !writeBuffer.isEmpty() || !fileTransfers.isEmpty(); }
+
     qint64 readBufferMaxSize;
     bool isBuffered;
+    bool corked = false;
     bool hasPendingData;
 
     QTimer *connectTimer;
@@ -128,6 +128,102 @@ QAbstractSocketEngine *QAbstractSocketEngine::createSocketEngine(qintptr socketD
     return new QNativeSocketEngine(parent);
 }
 
+/*!
+    \internal
+
+    Sends up to \a length bytes of the file referred to by \a fileDescriptor,
+    starting at \a offset, without copying them through user space.
+    Returns the number of bytes sent, -1 on error, or -2 if the engine cannot
+    send files directly; in that case the caller should fall back to write().
+
+    The default implementation returns -2.
+*/
+qint64 QAbstractSocketEngine::sendFile(int fileDescriptor, qint64 offset, qint64 length)
+{
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(length);
+    return -2;
+}
+
+/*!
+    \internal
+
+    Writes the \a count blocks of data in \a chunks, in order, as if they were
+    one contiguous block. Returns the number of bytes written, which may be
+    less than the total if the engine could not accept more, or -1 on error.
+
+    The default implementation calls write() for each block in turn and stops
+    at the first one that is not written completely. Engines that can hand
+    several blocks to the operating system at once reimplement it.
+*/
+qint64 QAbstractSocketEngine::writeChunks(const QByteArrayView *chunks, int count)
+{
+    qint64 total = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 written = write(chunks[i].data(), chunks[i].size());
+        if (written < 0)
+            return total ? total : written;
+        total += written;
+        if (written < chunks[i].size())
+            break;
+    }
+    return total;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    \internal
+
+    Reads up to \a count pending datagrams into \a datagrams. The data of
+    each datagram must already be sized to the maximum number of bytes to
+    receive for it; it is truncated to the size of the datagram received.
+    Returns the number of datagrams read, -1 on error, or -2 if no datagram
+    was pending.
+
+    The default implementation calls readDatagram() for each datagram.
+*/
+int QAbstractSocketEngine::readDatagrams(QNetworkDatagramPrivate **datagrams, int count,
+                                         PacketHeaderOptions options)
+{
+    int received = 0;
+    while (received < count && (received == 0 || hasPendingDatagrams())) {
+        QNetworkDatagramPrivate *datagram = datagrams[received];
+        const qint64 size = readDatagram(datagram->data.data(), datagram->data.size(),
+                                         &datagram->header, options);
+        if (size < 0)
+            return received ? received : int(size);
+        datagram->data.truncate(size);
+        ++received;
+    }
+    return received;
+}
+
+/*!
+    \internal
+
+    Writes the \a count datagrams in \a datagrams, in order, and returns the
+    number of datagrams sent. Stops at the first datagram that cannot be sent;
+    if that is the first one, returns -1 on error, or -2 if the socket's send
+    buffer is full.
+
+    The default implementation calls writeDatagram() for each datagram.
+*/
+int QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                          int count)
+{
+    int sent = 0;
+    for (; sent < count; ++sent) {
+        const QNetworkDatagramPrivate *datagram = datagrams[sent];
+        const qint64 result = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                            datagram->header);
+        if (result < 0)
+            return sent ? sent : int(result);
+    }
+    return sent;
+}
+#endif // QT_NO_UDPSOCKET
+
 QAbstractSocket::SocketError QAbstractSocketEngine::error() const
 {
     return d_func()->socketError;
@@ -160,6 +160,47 @@ QT_BEGIN_NAMESPACE
     \sa setSocketDescriptor()
 */
 
+/*!
+    \fn qint64 QLocalSocket::writeWithFileDescriptors(QByteArrayView data, const QList<int> &fileDescriptors)
+    \since 6.4
+
+    Writes \a data to the socket and passes the file descriptors in
+    \a fileDescriptors along with it, so that the peer receives its own
+    duplicates of them. This allows handing over, for example, a shared
+    memory file instead of copying its contents through the socket.
+
+    \a data must not be empty, and between 1 and 253 descriptors can be
+    passed at a time. The descriptors remain owned by the caller.
+
+    Data written earlier that is still buffered is sent first; this
+    function blocks until that has happened. Returns the number of bytes
+    of \a data accepted, which is either all of it or 0 if the socket
+    cannot take any data right now, in which case the descriptors were not
+    sent either. Returns -1 if an error occurred.
+
+    This function is only available on Unix, and fails on INTEGRITY.
+
+    \sa takeFileDescriptors()
+*/
+
+/*!
+    \fn QList<int> QLocalSocket::takeFileDescriptors()
+    \since 6.4
+
+    Returns the file descriptors the peer passed with
+    writeWithFileDescriptors() that have arrived so far, in the order they
+    were sent. Descriptors are available no later than the readyRead()
+    signal for the data they were sent with.
+
+    The caller takes ownership of the returned descriptors and must close
+    them. Descriptors that have not been taken when the socket is closed
+    are closed along with it.
+
+    This function is only available on Unix.
+
+    \sa writeWithFileDescriptors()
+*/
+
 /*!
     \fn qint64 QLocalSocket::readData(char *data, qint64 c)
     \reimp
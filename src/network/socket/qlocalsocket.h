@@ -125,6 +125,11 @@ public:
     SocketOptions socketOptions() const;
     QBindable<SocketOptions> bindableSocketOptions();
 
+#if defined(Q_OS_UNIX) || defined(Q_CLANG_QDOC)
+    qint64 writeWithFileDescriptors(QByteArrayView data, const QList<int> &fileDescriptors);
+    QList<int> takeFileDescriptors();
+#endif
+
     LocalSocketState state() const;
     bool waitForBytesWritten(int msecs = 30000) override;
     bool waitForConnected(int msecs = 30000);
@@ -111,6 +111,10 @@ public:
     {
         return QTcpSocket::writeData(data, maxSize);
     }
+
+#if !defined(QT_LOCALSOCKET_TCP)
+    QList<int> takeReceivedFileDescriptors();
+#endif
 };
 #endif //#if !defined(Q_OS_WIN) || defined(QT_LOCALSOCKET_TCP)
 
@@ -159,6 +163,9 @@ public:
     QString connectingName;
     int connectingSocket;
     QIODevice::OpenMode connectingOpenMode;
+    QList<int> receivedFileDescriptors;
+    void collectFileDescriptors();
+    void closeFileDescriptors();
 #endif
     QLocalSocket::LocalSocketState state;
     QString serverName;
@@ -294,6 +294,19 @@ qintptr QLocalSocket::socketDescriptor() const
     return d->tcpSocket->socketDescriptor();
 }
 
+#ifdef Q_OS_UNIX
+qint64 QLocalSocket::writeWithFileDescriptors(QByteArrayView, const QList<int> &)
+{
+    qWarning("QLocalSocket::writeWithFileDescriptors: Not supported on this platform");
+    return -1;
+}
+
+QList<int> QLocalSocket::takeFileDescriptors()
+{
+    return {};
+}
+#endif
+
 qint64 QLocalSocket::readData(char *data, qint64 c)
 {
     Q_D(QLocalSocket);
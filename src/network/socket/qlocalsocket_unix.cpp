@@ -40,6 +40,8 @@
 #include "qlocalsocket.h"
 #include "qlocalsocket_p.h"
 #include "qnet_unix_p.h"
+#include "private/qabstractsocket_p.h"
+#include "private/qnativesocketengine_p.h"
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -99,6 +101,8 @@ void QLocalSocketPrivate::init()
     // QIODevice signals
     q->connect(&unixSocket, SIGNAL(bytesWritten(qint64)),
                q, SIGNAL(bytesWritten(qint64)));
+    // pick up descriptors before anyone reacts to the data they came with
+    QObject::connect(&unixSocket, &QIODevice::readyRead, q, [this] { collectFileDescriptors(); });
     q->connect(&unixSocket, SIGNAL(readyRead()), q, SIGNAL(readyRead()));
     // QAbstractSocket signals
     q->connect(&unixSocket, SIGNAL(connected()), q, SIGNAL(connected()));
@@ -476,6 +480,94 @@ qintptr QLocalSocket::socketDescriptor() const
     return d->unixSocket.socketDescriptor();
 }
 
+QList<int> QLocalUnixSocket::takeReceivedFileDescriptors()
+{
+    auto d = static_cast<QAbstractSocketPrivate *>(QObjectPrivate::get(this));
+    if (auto engine = qobject_cast<QNativeSocketEngine *>(d->socketEngine))
+        return engine->takeReceivedFileDescriptors();
+    return {};
+}
+
+void QLocalSocketPrivate::collectFileDescriptors()
+{
+    receivedFileDescriptors += unixSocket.takeReceivedFileDescriptors();
+}
+
+void QLocalSocketPrivate::closeFileDescriptors()
+{
+    collectFileDescriptors();
+    for (int fd : std::as_const(receivedFileDescriptors))
+        qt_safe_close(fd);
+    receivedFileDescriptors.clear();
+}
+
+qint64 QLocalSocket::writeWithFileDescriptors(QByteArrayView data,
+                                              const QList<int> &fileDescriptors)
+{
+    Q_D(QLocalSocket);
+    // the most descriptors Linux accepts in one message (SCM_MAX_FD)
+    constexpr qsizetype MaxFileDescriptors = 253;
+    if (data.isEmpty() || fileDescriptors.isEmpty()
+        || fileDescriptors.size() > MaxFileDescriptors) {
+        qWarning("QLocalSocket::writeWithFileDescriptors: Needs data and 1 to %d descriptors",
+                 int(MaxFileDescriptors));
+        return -1;
+    }
+    if (!isWritable() || d->state != ConnectedState) {
+        qWarning("QLocalSocket::writeWithFileDescriptors: Socket is not connected for writing");
+        return -1;
+    }
+
+    // the descriptors travel with the first byte of data, so everything
+    // written before has to be on its way first
+    while (d->unixSocket.bytesToWrite() > 0) {
+        if (!d->unixSocket.waitForBytesWritten())
+            return -1;
+    }
+
+    union {
+        cmsghdr header;
+        char buffer[CMSG_SPACE(MaxFileDescriptors * sizeof(int))];
+    } control;
+    const size_t fdBytes = size_t(fileDescriptors.size()) * sizeof(int);
+
+    iovec vec;
+    vec.iov_base = const_cast<char *>(data.data());
+    vec.iov_len = size_t(data.size());
+    msghdr msg = {};
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = CMSG_SPACE(fdBytes);
+    memset(control.buffer, 0, msg.msg_controllen);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(fdBytes);
+    memcpy(CMSG_DATA(cmsg), fileDescriptors.constData(), fdBytes);
+
+    const qint64 sent = qt_safe_sendmsg(d->unixSocket.socketDescriptor(), &msg, 0);
+    if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return 0;
+        d->setErrorAndEmit(errno == EPIPE ? QLocalSocket::PeerClosedError
+                                          : QLocalSocket::UnknownSocketError,
+                           QLatin1String("QLocalSocket::writeWithFileDescriptors"));
+        return -1;
+    }
+    // whatever the kernel did not take goes through the regular write buffer
+    if (sent < data.size())
+        d->unixSocket.write(data.data() + sent, data.size() - sent);
+    return data.size();
+}
+
+QList<int> QLocalSocket::takeFileDescriptors()
+{
+    Q_D(QLocalSocket);
+    d->collectFileDescriptors();
+    return qExchange(d->receivedFileDescriptors, {});
+}
+
 qint64 QLocalSocket::readData(char *data, qint64 c)
 {
     Q_D(QLocalSocket);
@@ -533,6 +625,7 @@ void QLocalSocket::close()
     Q_D(QLocalSocket);
 
     QIODevice::close();
+    d->closeFileDescriptors();
     d->unixSocket.close();
     d->cancelDelayedConnect();
     if (d->connectingSocket != -1)
@@ -868,6 +868,29 @@ qint64 QNativeSocketEngine::readDatagram(char *data, qint64 maxSize, QIpPacketHe
     return d->nativeReceiveDatagram(data, maxSize, header, options);
 }
 
+/*!
+    Reads up to \a count pending datagrams into \a datagrams with one
+    system call where the platform supports it (recvmmsg()), and returns the
+    number of datagrams read, or -1 if an error occurred. Returns -2 if no
+    datagram was pending.
+
+    \sa readDatagram()
+*/
+int QNativeSocketEngine::readDatagrams(QNetworkDatagramPrivate **datagrams, int count,
+                                       PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#if QT_CONFIG(mmsg)
+    return d->nativeReceiveDatagrams(datagrams, count, options);
+#else
+    return QAbstractSocketEngine::readDatagrams(datagrams, count, options);
+#endif
+}
+
 /*!
     Writes a datagram of size \a size bytes to the socket from
     \a data to the destination contained in \a header, and returns the
@@ -900,6 +923,29 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+/*!
+    Writes the \a count datagrams in \a datagrams with one system call where
+    the platform supports it (sendmmsg()), and returns the number of
+    datagrams sent. The datagrams are sent in order, stopping at the first
+    one that fails; if no datagram was sent, returns -1 if an error occurred
+    or -2 if the socket's send buffer is full.
+
+    \sa writeDatagram()
+*/
+int QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#if QT_CONFIG(mmsg)
+    return d->nativeSendDatagrams(datagrams, count);
+#else
+    return QAbstractSocketEngine::writeDatagrams(datagrams, count);
+#endif
+}
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -922,6 +968,42 @@ qint64 QNativeSocketEngine::bytesToWrite() const
     return 0;
 }
 
+/*!
+    Sends up to \a length bytes of the file \a fileDescriptor, starting at
+    \a offset, directly from the kernel's page cache. Returns the number of
+    bytes sent, -1 if an error occurred, or -2 if the platform or the file
+    does not support it.
+*/
+qint64 QNativeSocketEngine::sendFile(int fileDescriptor, qint64 offset, qint64 length)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -2);
+#ifdef Q_OS_LINUX
+    return d->nativeSendFile(fileDescriptor, offset, length);
+#else
+    Q_UNUSED(d);
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(length);
+    return -2;
+#endif
+}
+
+/*!
+    Writes the \a count blocks of data in \a chunks to the socket with a
+    single gathering system call (writev() or WSASend()). Returns the number
+    of bytes written, or -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::writeChunks(const QByteArrayView *chunks, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeChunks(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeChunks(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteChunks(chunks, count);
+}
+
 /*!
     Reads up to \a maxSize bytes into \a data from the socket.
     Returns the number of bytes read, or -1 if an error occurred.
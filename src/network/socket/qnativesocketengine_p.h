@@ -159,12 +159,21 @@ public:
 
     bool hasPendingDatagrams() const override;
     qint64 pendingDatagramSize() const override;
+    int readDatagrams(QNetworkDatagramPrivate **datagrams, int count,
+                      PacketHeaderOptions = WantNone) override;
+    int writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count) override;
 #endif // QT_NO_UDPSOCKET
 
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
                         PacketHeaderOptions = WantNone) override;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
     qint64 bytesToWrite() const override;
+    qint64 sendFile(int fileDescriptor, qint64 offset, qint64 length) override;
+    qint64 writeChunks(const QByteArrayView *chunks, int count) override;
+
+#ifndef Q_OS_WIN
+    QList<int> takeReceivedFileDescriptors();
+#endif
 
 #if 0   // currently unused
     qint64 receiveBufferSize() const;
@@ -216,6 +225,11 @@ public:
     LPFN_WSASENDMSG sendmsg;
     LPFN_WSARECVMSG recvmsg;
 #  endif
+#ifndef Q_OS_WIN
+    // descriptors that arrived with the data on an AF_UNIX socket
+    QList<int> receivedFileDescriptors;
+    bool isLocalSocket = false;
+#endif
     enum ErrorString {
         NonBlockingInitFailedErrorString,
         BroadcastingInitFailedErrorString,
@@ -277,8 +291,20 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#if QT_CONFIG(mmsg)
+    int nativeReceiveDatagrams(QNetworkDatagramPrivate **datagrams, int count,
+                               QAbstractSocketEngine::PacketHeaderOptions options);
+    int nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count);
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
+#ifndef Q_OS_WIN
+    qint64 nativeReadWithFileDescriptors(char *data, qint64 maxLength);
+#endif
     qint64 nativeWrite(const char *data, qint64 length);
+    qint64 nativeWriteChunks(const QByteArrayView *chunks, int count);
+#ifdef Q_OS_LINUX
+    qint64 nativeSendFile(int fileDescriptor, qint64 offset, qint64 length);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -255,6 +255,9 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
 
     case QAbstractSocketEngine::PathMtuInformation:
         break;          // not supported on Windows
+
+    case QAbstractSocketEngine::PortReusable:
+        break;          // SO_REUSEADDR shares the port, but does not balance the load
     }
 }
 
@@ -1419,6 +1422,47 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
     return ret;
 }
 
+qint64 QNativeSocketEnginePrivate::nativeWriteChunks(const QByteArrayView *chunks, int count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    QVarLengthArray<WSABUF, 16> bufs(count);
+    for (int i = 0; i < count; ++i) {
+        bufs[i].buf = const_cast<char *>(chunks[i].data());
+        bufs[i].len = ULONG(chunks[i].size());
+    }
+
+    DWORD bytesWritten = 0;
+    qint64 ret = 0;
+    if (::WSASend(socketDescriptor, bufs.data(), DWORD(count), &bytesWritten, 0, 0, 0)
+            != SOCKET_ERROR) {
+        ret = qint64(bytesWritten);
+    } else {
+        int err = WSAGetLastError();
+        WS_ERROR_DEBUG(err);
+        switch (err) {
+        case WSAEWOULDBLOCK:
+        case WSAENOBUFS:
+            // try again later, possibly with less data
+            break;
+        case WSAECONNRESET:
+        case WSAECONNABORTED:
+            ret = -1;
+            setError(QAbstractSocket::NetworkError, WriteErrorString);
+            q->close();
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteChunks(%d chunks) == %lli", count, ret);
+#endif
+
+    return ret;
+}
+
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxLength)
 {
     qint64 ret = -1;
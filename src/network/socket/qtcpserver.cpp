@@ -325,6 +325,12 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    if (d->reusePort && !d->socketEngine->setOption(QAbstractSocketEngine::PortReusable, 1)) {
+        d->serverSocketError = QAbstractSocket::UnsupportedSocketOperationError;
+        d->serverSocketErrorString = tr("Sharing the listening port is not supported");
+        return false;
+    }
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
@@ -677,6 +683,43 @@ int QTcpServer::listenBacklogSize() const
     return d_func()->listenBacklog;
 }
 
+/*!
+    \since 6.4
+
+    If \a enabled is true, the next call to listen() allows other sockets
+    to listen on the same address and port, provided they enable this too and
+    belong to the same user. The operating system then distributes incoming
+    connections among all of these listeners. This makes it possible to accept
+    connections in several threads or processes without handing them over
+    from a central acceptor; see QTcpServerGroup for the threaded case.
+
+    This uses the \c SO_REUSEPORT socket option, which is available on Linux,
+    Android and the BSDs, including \macos. On Linux, connections are balanced
+    across the listeners; other systems may favor the most recent one. If the
+    option is not supported, listen() fails with
+    QAbstractSocket::UnsupportedSocketOperationError.
+
+    This property is disabled by default.
+
+    \sa isReusePortEnabled(), listen()
+*/
+void QTcpServer::setReusePortEnabled(bool enabled)
+{
+    d_func()->reusePort = enabled;
+}
+
+/*!
+    \since 6.4
+
+    Returns whether listen() will share its port with other listeners.
+
+    \sa setReusePortEnabled()
+*/
+bool QTcpServer::isReusePortEnabled() const
+{
+    return d_func()->reusePort;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -72,6 +72,9 @@ public:
     void setListenBacklogSize(int size);
     int listenBacklogSize() const;
 
+    void setReusePortEnabled(bool enabled);
+    bool isReusePortEnabled() const;
+
     quint16 serverPort() const;
     QHostAddress serverAddress() const;
 
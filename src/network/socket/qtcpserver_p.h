@@ -85,6 +85,7 @@ public:
 
     int listenBacklog = 50;
     int maxConnections;
+    bool reusePort = false;
 
 #ifndef QT_NO_NETWORKPROXY
     QNetworkProxy proxy;
@@ -0,0 +1,440 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*!
+    \class QTcpServerGroup
+    \since 6.4
+
+    \brief The QTcpServerGroup class accepts TCP connections on one port from
+    several threads.
+
+    \reentrant
+    \ingroup network
+    \inmodule QtNetwork
+
+    A single QTcpServer accepts all connections in one thread. A threaded
+    server then has to hand every accepted descriptor over to a worker thread,
+    which costs a cross-thread hop per connection and makes the accepting
+    thread a bottleneck.
+
+    QTcpServerGroup instead starts threadCount() worker threads, each running
+    its own event loop and owning its own QTcpServer. All of these listen on
+    the same address and port with QTcpServer::setReusePortEnabled(), and the
+    operating system distributes incoming connections among them. A
+    connection is therefore accepted and handled in the same thread, and
+    accept throughput scales with the number of threads.
+
+    Reimplement createServer() to return the server for a given worker, for
+    example a QTcpServer subclass that reimplements
+    QTcpServer::incomingConnection(), or a plain QTcpServer whose
+    \l{QTcpServer::}{newConnection()} signal is connected to a handler that
+    is a child of the server:
+
+    \code
+    class EchoServerGroup : public QTcpServerGroup
+    {
+    protected:
+        QTcpServer *createServer(int index) override
+        {
+            auto server = new QTcpServer;
+            auto handler = new EchoHandler(server);     // moves along with the server
+            connect(server, &QTcpServer::newConnection,
+                    handler, &EchoHandler::acceptConnections);
+            return server;
+        }
+    };
+    \endcode
+
+    The servers are created in the thread that calls listen() and are then
+    moved, together with their children, to their worker threads. From then
+    on they must only be used from there.
+
+    On Linux, setCpuSteeringEnabled() additionally asks the kernel to pick the
+    listener by the CPU that processed the incoming connection, and keeps each
+    worker on the CPUs it is responsible for, so that a connection stays on
+    one CPU from the network stack to the application.
+
+    Port sharing relies on \c SO_REUSEPORT, see
+    QTcpServer::setReusePortEnabled() for the supported platforms.
+
+    \sa QTcpServer, QThread
+*/
+
+#include "qtcpservergroup.h"
+#include "qtcpservergroup_p.h"
+
+#include "qtcpserver.h"
+#include "qthread.h"
+
+#if defined(Q_OS_LINUX)
+#  include <linux/filter.h>
+#  include <sched.h>
+#  include <sys/socket.h>
+#  ifndef SO_ATTACH_REUSEPORT_CBPF
+#    define SO_ATTACH_REUSEPORT_CBPF 51
+#  endif
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*! \internal
+*/
+void QTcpServerGroupPrivate::stopWorkers()
+{
+    for (const Worker &worker : qAsConst(workers)) {
+        if (worker.thread->isRunning()) {
+            // deferred deletes are still delivered when the thread finishes
+            worker.server->deleteLater();
+            worker.thread->quit();
+        } else {
+            // listen() failed before the servers were moved
+            delete worker.server;
+        }
+    }
+    for (const Worker &worker : qAsConst(workers)) {
+        worker.thread->wait();
+        delete worker.thread;
+    }
+    workers.clear();
+}
+
+/*! \internal
+
+    Makes the kernel choose the listener by the CPU that handles the incoming
+    connection: CPU \c n goes to the listener that was bound as number
+    \c{n % workers.size()}.
+*/
+bool QTcpServerGroupPrivate::attachCpuSteering()
+{
+#if defined(Q_OS_LINUX) && defined(SKF_AD_CPU)
+    sock_filter code[] = {
+        { BPF_LD | BPF_W | BPF_ABS, 0, 0, __u32(SKF_AD_OFF + SKF_AD_CPU) },
+        { BPF_ALU | BPF_MOD | BPF_K, 0, 0, __u32(workers.size()) },
+        { BPF_RET | BPF_A, 0, 0, 0 },
+    };
+    sock_fprog program = { sizeof(code) / sizeof(code[0]), code };
+
+    // the program applies to the whole group, so any listener will do
+    const int fd = int(workers.first().server->socketDescriptor());
+    return ::setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == 0;
+#else
+    return false;
+#endif
+}
+
+/*! \internal
+
+    Restricts the calling worker thread to the CPUs whose connections
+    attachCpuSteering() sends to it.
+*/
+void QTcpServerGroupPrivate::pinCurrentThread(int index, int count)
+{
+#if defined(Q_OS_LINUX)
+    const int cpus = qMin(QThread::idealThreadCount(), int(CPU_SETSIZE));
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = index; cpu < cpus; cpu += count)
+        CPU_SET(cpu, &set);
+    if (CPU_COUNT(&set) > 0)
+        sched_setaffinity(0, sizeof(set), &set);    // 0 is the calling thread
+#else
+    Q_UNUSED(index);
+    Q_UNUSED(count);
+#endif
+}
+
+/*!
+    Constructs a QTcpServerGroup object.
+
+    \a parent is passed to the QObject constructor.
+*/
+QTcpServerGroup::QTcpServerGroup(QObject *parent)
+    : QObject(*new QTcpServerGroupPrivate, parent)
+{
+}
+
+/*!
+    Destroys the QTcpServerGroup object, closing its servers and stopping
+    their threads.
+*/
+QTcpServerGroup::~QTcpServerGroup()
+{
+    close();
+}
+
+/*!
+    Sets the number of worker threads, and thus of listening servers, that
+    listen() starts to \a count. A \a count of 0, the default, uses
+    QThread::idealThreadCount().
+
+    This takes effect the next time listen() is called.
+
+    \sa threadCount()
+*/
+void QTcpServerGroup::setThreadCount(int count)
+{
+    d_func()->threadCount = qMax(0, count);
+}
+
+/*!
+    Returns the number of worker threads listen() starts, or 0 to use
+    QThread::idealThreadCount().
+
+    \sa setThreadCount(), serverCount()
+*/
+int QTcpServerGroup::threadCount() const
+{
+    return d_func()->threadCount;
+}
+
+/*!
+    If \a enabled is true, the next call to listen() steers each connection
+    to the worker thread that is responsible for the CPU the connection
+    arrived on, and restricts the worker threads to their CPUs.
+
+    This is only a hint. It is supported on Linux, and silently ignored
+    where it is not available, in which case the operating system's default
+    balancing applies.
+
+    This property is disabled by default.
+
+    \sa isCpuSteeringEnabled()
+*/
+void QTcpServerGroup::setCpuSteeringEnabled(bool enabled)
+{
+    d_func()->cpuSteering = enabled;
+}
+
+/*!
+    Returns whether listen() steers connections by CPU.
+
+    \sa setCpuSteeringEnabled()
+*/
+bool QTcpServerGroup::isCpuSteeringEnabled() const
+{
+    return d_func()->cpuSteering;
+}
+
+/*!
+    Starts the worker threads and has each of their servers listen for
+    incoming connections on address \a address and port \a port. If \a port
+    is 0, a port is chosen automatically and shared by all servers.
+
+    Returns \c true if all servers are listening; otherwise closes the ones
+    that were started and returns \c false.
+
+    \sa isListening(), close(), createServer()
+*/
+bool QTcpServerGroup::listen(const QHostAddress &address, quint16 port)
+{
+    Q_D(QTcpServerGroup);
+    if (!d->workers.isEmpty()) {
+        qWarning("QTcpServerGroup::listen() called when already listening");
+        return false;
+    }
+
+    const int count = d->threadCount > 0 ? d->threadCount : qMax(1, QThread::idealThreadCount());
+    d->workers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QTcpServer *server = createServer(i);
+        if (!server) {
+            d->serverSocketError = QAbstractSocket::UnknownSocketError;
+            d->serverSocketErrorString = tr("No server was created");
+            d->stopWorkers();
+            return false;
+        }
+        Q_ASSERT_X(!server->parent(), "QTcpServerGroup::createServer",
+                   "Servers must not have a parent, they are moved to another thread");
+
+        auto thread = new QThread;
+        thread->setObjectName(QStringLiteral("QTcpServerGroup worker %1").arg(i));
+        d->workers.append({ thread, server });
+
+        server->setReusePortEnabled(true);
+        // the first listener picks the port for the others
+        if (!server->listen(address, i ? d->port : port)) {
+            d->serverSocketError = server->serverError();
+            d->serverSocketErrorString = server->errorString();
+            d->stopWorkers();
+            return false;
+        }
+        if (i == 0) {
+            d->port = server->serverPort();
+            d->address = server->serverAddress();
+        }
+    }
+
+    const bool steering = d->cpuSteering && d->attachCpuSteering();
+    for (int i = 0; i < count; ++i) {
+        const QTcpServerGroupPrivate::Worker &worker = d->workers.at(i);
+        worker.server->moveToThread(worker.thread);
+        if (steering) {
+            QMetaObject::invokeMethod(worker.server, [i, count] {
+                QTcpServerGroupPrivate::pinCurrentThread(i, count);
+            }, Qt::QueuedConnection);
+        }
+        worker.thread->start();
+    }
+    return true;
+}
+
+/*!
+    Closes all servers and stops their worker threads. Connections that were
+    already accepted are not affected, unless they are children of a server.
+
+    \sa listen()
+*/
+void QTcpServerGroup::close()
+{
+    Q_D(QTcpServerGroup);
+    d->stopWorkers();
+    d->port = 0;
+    d->address.clear();
+}
+
+/*!
+    Returns \c true if the group's servers are listening for incoming
+    connections; otherwise returns \c false.
+
+    \sa listen()
+*/
+bool QTcpServerGroup::isListening() const
+{
+    return !d_func()->workers.isEmpty();
+}
+
+/*!
+    Returns the port the servers are listening on, or 0 if the group is not
+    listening.
+
+    \sa serverAddress()
+*/
+quint16 QTcpServerGroup::serverPort() const
+{
+    return d_func()->port;
+}
+
+/*!
+    Returns the address the servers are listening on, or QHostAddress::Null
+    if the group is not listening.
+
+    \sa serverPort()
+*/
+QHostAddress QTcpServerGroup::serverAddress() const
+{
+    return d_func()->address;
+}
+
+/*!
+    Returns the number of servers, which is the number of worker threads,
+    while the group is listening; otherwise returns 0.
+
+    \sa server(), threadCount()
+*/
+int QTcpServerGroup::serverCount() const
+{
+    return int(d_func()->workers.size());
+}
+
+/*!
+    Returns the server with the given \a index, or \nullptr if there is
+    none. The server lives in serverThread(\a index) and must only be used
+    from there.
+
+    \sa serverCount()
+*/
+QTcpServer *QTcpServerGroup::server(int index) const
+{
+    Q_D(const QTcpServerGroup);
+    return index >= 0 && index < d->workers.size() ? d->workers.at(index).server : nullptr;
+}
+
+/*!
+    Returns the worker thread of the server with the given \a index, or
+    \nullptr if there is none.
+
+    \sa server()
+*/
+QThread *QTcpServerGroup::serverThread(int index) const
+{
+    Q_D(const QTcpServerGroup);
+    return index >= 0 && index < d->workers.size() ? d->workers.at(index).thread : nullptr;
+}
+
+/*!
+    Returns an error code for the last error that occurred in listen().
+
+    \sa errorString()
+*/
+QAbstractSocket::SocketError QTcpServerGroup::serverError() const
+{
+    return d_func()->serverSocketError;
+}
+
+/*!
+    Returns a human readable description of the last error that occurred in
+    listen().
+
+    \sa serverError()
+*/
+QString QTcpServerGroup::errorString() const
+{
+    return d_func()->serverSocketErrorString;
+}
+
+/*!
+    Returns the server for the worker with the given \a index. listen() calls
+    this once per worker thread, in the thread listen() is called from, and
+    takes ownership of the result.
+
+    The returned server must not have a parent: it is moved to its worker
+    thread, together with its children, once all servers are listening.
+    Returning \nullptr makes listen() fail.
+
+    The default implementation returns a plain QTcpServer.
+*/
+QTcpServer *QTcpServerGroup::createServer(int index)
+{
+    Q_UNUSED(index);
+    return new QTcpServer;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qtcpservergroup.cpp"
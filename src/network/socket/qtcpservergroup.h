@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QTCPSERVERGROUP_H
+#define QTCPSERVERGROUP_H
+
+#include <QtNetwork/qtnetworkglobal.h>
+#include <QtCore/qobject.h>
+#include <QtNetwork/qabstractsocket.h>
+#include <QtNetwork/qhostaddress.h>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QTcpServer;
+class QThread;
+class QTcpServerGroupPrivate;
+
+class Q_NETWORK_EXPORT QTcpServerGroup : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QTcpServerGroup(QObject *parent = nullptr);
+    ~QTcpServerGroup();
+
+    void setThreadCount(int count);
+    int threadCount() const;
+
+    void setCpuSteeringEnabled(bool enabled);
+    bool isCpuSteeringEnabled() const;
+
+    bool listen(const QHostAddress &address = QHostAddress::Any, quint16 port = 0);
+    void close();
+
+    bool isListening() const;
+
+    quint16 serverPort() const;
+    QHostAddress serverAddress() const;
+
+    int serverCount() const;
+    QTcpServer *server(int index) const;
+    QThread *serverThread(int index) const;
+
+    QAbstractSocket::SocketError serverError() const;
+    QString errorString() const;
+
+protected:
+    virtual QTcpServer *createServer(int index);
+
+private:
+    Q_DISABLE_COPY(QTcpServerGroup)
+    Q_DECLARE_PRIVATE(QTcpServerGroup)
+};
+
+QT_END_NAMESPACE
+
+#endif // QTCPSERVERGROUP_H
@@ -102,6 +102,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -431,6 +432,124 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.4
+
+    Sends the datagrams in \a datagrams, in order, each to the destination
+    and with the options set in it, as writeDatagram() does. Where the
+    operating system supports it (sendmmsg() on Linux and the BSDs), the
+    datagrams are passed to it in batches, with one system call for each.
+
+    Returns the number of datagrams sent, which is less than the size of \a
+    datagrams if the socket's send buffer became full or an error occurred
+    after the first datagram; returns -1 if the first datagram could not be
+    sent because of an error.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qint64 QUdpSocket::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld datagrams)", qint64(datagrams.size()));
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.first().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> pending;
+    pending.reserve(datagrams.size());
+    for (const QNetworkDatagram &datagram : datagrams)
+        pending.append(datagram.d);
+
+    qsizetype sent = 0;
+    qint64 sentBytes = 0;
+    while (sent < pending.size()) {
+        const int count = int(qMin(pending.size() - sent, qsizetype(INT_MAX)));
+        const int result = d->socketEngine->writeDatagrams(pending.constData() + sent, count);
+        if (result <= 0) {
+            if (result == -1 && sent == 0) {
+                d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+                d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+                return -1;
+            }
+            break;
+        }
+        for (int i = 0; i < result; ++i)
+            sentBytes += pending[sent + i]->data.size();
+        sent += result;
+    }
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sentBytes > 0)
+        emit bytesWritten(sentBytes);
+    return sent;
+}
+
+/*!
+    \since 6.4
+
+    Receives up to \a maxCount pending datagrams, each no larger than \a
+    maxSize bytes, and returns them along with their sender's and, if
+    possible, destination's addresses, ports, and hop limits, as
+    receiveDatagram() does. Where the operating system supports it
+    (recvmmsg() on Linux and the BSDs), all of them are received with a
+    single system call.
+
+    Returns an empty list if no datagram was pending or an error occurred.
+
+    If a datagram is larger than \a maxSize, the rest of it is lost. If \a
+    maxSize is -1 (the default), room for the largest possible UDP datagram
+    is reserved for each of them; passing the largest size the application
+    expects avoids these allocations.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(int maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%d, %lld)", maxCount, maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    if (maxCount <= 0)
+        return QList<QNetworkDatagram>();
+
+    // The largest UDP payload is 65535 bytes minus the UDP header:
+    const bool squeeze = maxSize < 0;
+    if (squeeze)
+        maxSize = 65535 - 8;
+
+    QList<QNetworkDatagram> result(maxCount);
+    QVarLengthArray<QNetworkDatagramPrivate *, 64> buffers(maxCount);
+    for (int i = 0; i < maxCount; ++i) {
+        result[i].d->data = QByteArray(maxSize, Qt::Uninitialized);
+        buffers[i] = result[i].d;
+    }
+
+    const int received = d->socketEngine->readDatagrams(buffers.data(), maxCount,
+                                                        QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (received <= 0) {
+        if (received == -1)
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        return QList<QNetworkDatagram>();
+    }
+
+    result.resize(received);
+    if (squeeze) {
+        for (QNetworkDatagram &datagram : result)
+            datagram.d->data.squeeze();
+    }
+    return result;
+}
+
 /*!
     \since 5.8
 
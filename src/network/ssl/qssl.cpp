@@ -162,6 +162,14 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     chosen based on the servers preferences rather than the order ciphers were
     sent by the client. This option is only relevant to server sockets, and is
     only honored by the OpenSSL backend.
+    \value SslOptionEnableKernelTls Once the handshake has completed, hands
+    the encryption of outgoing application data over to the operating system
+    kernel (kernel TLS, "kTLS"), so that QSslSocket::sendFile() can transmit
+    files without copying them through user space. This option is only
+    honored by the OpenSSL backend (OpenSSL 3.0 or later) on Linux, and
+    requires the kernel's \c tls module; if offloading is not possible, the
+    connection silently keeps encrypting in user space. This enum value was
+    introduced in Qt 6.4.
 
     By default, SslOptionDisableEmptyFragments is turned on since this causes
     problems with a large number of servers. SslOptionDisableLegacyRenegotiation
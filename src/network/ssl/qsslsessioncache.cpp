@@ -0,0 +1,363 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsslsessioncache.h"
+
+#include <QtCore/qcache.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSslSessionCache
+    \brief The QSslSessionCache class stores TLS sessions for resumption
+    across QSslSocket instances.
+    \since 6.4
+
+    \reentrant
+    \threadsafe
+    \ingroup network
+    \ingroup ssl
+    \inmodule QtNetwork
+
+    A TLS client that resumes a previous session with a server skips the
+    expensive parts of the handshake (certificate exchange and key agreement).
+    QSslSocket can already reuse a session by way of
+    QSslConfiguration::setSessionTicket(), but the session is tied to the
+    socket it was negotiated on. QSslSessionCache keeps the sessions
+    negotiated by any number of sockets, keyed by the name the server was
+    addressed by (the verification peer name if one was set, otherwise the
+    peer name, which is also the name sent with the SNI extension) and the
+    port.
+
+    Install a cache on a socket with QSslSocket::setSslSessionCache(), or on
+    a QNetworkAccessManager with QNetworkAccessManager::setSslSessionCache()
+    to share it between all the HTTPS connections the manager opens. Before
+    a client handshake, the socket looks up a session for its peer, unless
+    its configuration already has a session ticket; after the handshake, and
+    whenever the server sends a new session ticket, the socket stores the
+    session in the cache. Sockets whose configuration has
+    QSsl::SslOptionDisableSessionPersistence set bypass the cache.
+
+    Entries expire according to the session ticket lifetime hint the server
+    sent, and the least recently used entries are evicted once maximumSize()
+    is reached. The cache can be written to disk with save() and restored
+    with load(), which allows sessions to be resumed by a different process,
+    or a later run of the same application.
+
+    The same cache can be used from several threads at once. It does not
+    take ownership of, or keep track of, the sockets that use it; it must
+    outlive them.
+
+    \note A serialized session contains the key material needed to resume
+    it. save() restricts the file to its owner, but applications should
+    still treat the file as a secret.
+
+    \note Session resumption is only available with backends that support
+    persistent sessions, such as the OpenSSL backend.
+
+    \sa QSslConfiguration::sessionTicket(), QSslSocket::newSessionTicketReceived()
+*/
+
+namespace {
+
+// RFC 8446, 4.6.1: "Servers MUST NOT use any value greater than 604800
+// seconds (7 days)." We use the same limit for older protocol versions.
+constexpr int maximumLifetime = 604800;
+// Used when the server did not give a hint; the same as OpenSSL's default
+// session timeout.
+constexpr int defaultLifetime = 300;
+
+constexpr quint32 fileMagic = 0x51535343; // 'QSSC'
+constexpr quint32 fileVersion = 1;
+
+QString cacheKey(const QString &peerName, quint16 port)
+{
+    return peerName.toLower() + QLatin1Char(':') + QString::number(port);
+}
+
+} // unnamed namespace
+
+class QSslSessionCachePrivate
+{
+public:
+    explicit QSslSessionCachePrivate(qsizetype maximumSize) : cache(maximumSize) {}
+
+    struct Key
+    {
+        QString peerName;
+        quint16 port = 0;
+    };
+    struct Node
+    {
+        Key key;
+        QByteArray session;
+        QDateTime expiry;
+    };
+
+    void insert(const QString &peerName, quint16 port, const QByteArray &session,
+                const QDateTime &expiry)
+    {
+        auto *node = new Node;
+        node->session = session;
+        node->expiry = expiry;
+        node->key = { peerName.toLower(), port };
+        cache.insert(cacheKey(peerName, port), node);
+    }
+
+    mutable QMutex mutex;
+    QCache<QString, Node> cache;
+};
+
+/*!
+    Constructs an empty session cache that holds at most \a maximumSize
+    sessions.
+*/
+QSslSessionCache::QSslSessionCache(qsizetype maximumSize)
+    : d(new QSslSessionCachePrivate(std::max(maximumSize, qsizetype(0))))
+{
+}
+
+/*!
+    Destroys the cache and all the sessions in it.
+*/
+QSslSessionCache::~QSslSessionCache() = default;
+
+/*!
+    Sets the maximum number of sessions the cache holds to \a maximumSize.
+    If the cache holds more sessions than that, the least recently used
+    ones are evicted.
+
+    \sa maximumSize(), size()
+*/
+void QSslSessionCache::setMaximumSize(qsizetype maximumSize)
+{
+    QMutexLocker locker(&d->mutex);
+    d->cache.setMaxCost(std::max(maximumSize, qsizetype(0)));
+}
+
+/*!
+    Returns the maximum number of sessions the cache holds. The default
+    is 256.
+
+    \sa setMaximumSize()
+*/
+qsizetype QSslSessionCache::maximumSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->cache.maxCost();
+}
+
+/*!
+    Returns the number of sessions in the cache, including the ones that
+    have expired but were not yet looked up.
+*/
+qsizetype QSslSessionCache::size() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->cache.size();
+}
+
+/*!
+    Stores \a session, in the format returned by
+    QSslConfiguration::sessionTicket(), as the session to resume for
+    connections to \a peerName on \a port, replacing any previous session.
+
+    The entry expires \a lifetimeHint seconds from now, if that is positive,
+    or after 5 minutes otherwise. An empty \a session removes the entry.
+
+    Peer names are compared case-insensitively.
+
+    \sa session(), QSslConfiguration::sessionTicketLifeTimeHint()
+*/
+void QSslSessionCache::insert(const QString &peerName, quint16 port, const QByteArray &session,
+                              int lifetimeHint)
+{
+    if (peerName.isEmpty())
+        return;
+
+    QMutexLocker locker(&d->mutex);
+    if (session.isEmpty()) {
+        d->cache.remove(cacheKey(peerName, port));
+        return;
+    }
+
+    const int lifetime = lifetimeHint > 0 ? std::min(lifetimeHint, maximumLifetime)
+                                          : defaultLifetime;
+    d->insert(peerName, port, session, QDateTime::currentDateTimeUtc().addSecs(lifetime));
+}
+
+/*!
+    Returns the session to resume for connections to \a peerName on
+    \a port, or an empty QByteArray if there is none or it has expired.
+    Expired sessions are removed from the cache.
+
+    \sa insert()
+*/
+QByteArray QSslSessionCache::session(const QString &peerName, quint16 port) const
+{
+    if (peerName.isEmpty())
+        return {};
+
+    const QString key = cacheKey(peerName, port);
+    QMutexLocker locker(&d->mutex);
+    const auto *node = d->cache.object(key);
+    if (!node)
+        return {};
+    if (node->expiry <= QDateTime::currentDateTimeUtc()) {
+        d->cache.remove(key);
+        return {};
+    }
+    return node->session;
+}
+
+/*!
+    Removes the session stored for \a peerName and \a port, if any. It
+    can be used when a server rejects a resumed session persistently.
+*/
+void QSslSessionCache::remove(const QString &peerName, quint16 port)
+{
+    QMutexLocker locker(&d->mutex);
+    d->cache.remove(cacheKey(peerName, port));
+}
+
+/*!
+    Removes all the sessions from the cache.
+*/
+void QSslSessionCache::clear()
+{
+    QMutexLocker locker(&d->mutex);
+    d->cache.clear();
+}
+
+/*!
+    Reads the sessions stored by save() in the file \a fileName and adds
+    those that have not expired to the cache, replacing the sessions
+    already cached for the same peers. Returns \c true on success, \c false
+    if the file could not be opened or is not in the expected format (in
+    which case, the cache is left unchanged).
+
+    \sa save()
+*/
+bool QSslSessionCache::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != fileMagic || version != fileVersion)
+        return false;
+
+    qint32 count = 0;
+    in >> count;
+    if (in.status() != QDataStream::Ok || count < 0)
+        return false;
+
+    QList<QSslSessionCachePrivate::Node> nodes;
+    for (qint32 i = 0; i < count; ++i) {
+        QSslSessionCachePrivate::Node node;
+        in >> node.key.peerName >> node.key.port >> node.session >> node.expiry;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        nodes.append(std::move(node));
+    }
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    QMutexLocker locker(&d->mutex);
+    for (const auto &node : std::as_const(nodes)) {
+        if (node.key.peerName.isEmpty() || node.session.isEmpty() || node.expiry <= now)
+            continue;
+        d->insert(node.key.peerName, node.key.port, node.session, node.expiry);
+    }
+    return true;
+}
+
+/*!
+    Writes the sessions in the cache that have not expired to the file
+    \a fileName, replacing its contents, and makes the file readable and
+    writable only by its owner. Returns \c true on success.
+
+    \sa load()
+*/
+bool QSslSessionCache::save(const QString &fileName) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    {
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        QMutexLocker locker(&d->mutex);
+        QList<const QSslSessionCachePrivate::Node *> nodes;
+        const QList<QString> keys = d->cache.keys();
+        for (const QString &key : keys) {
+            const auto *node = d->cache.object(key);
+            if (node && node->expiry > now)
+                nodes.append(node);
+        }
+
+        out << fileMagic << fileVersion << qint32(nodes.size());
+        for (const auto *node : std::as_const(nodes))
+            out << node->key.peerName << node->key.port << node->session << node->expiry;
+    }
+
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+QT_END_NAMESPACE
@@ -384,6 +384,7 @@
 #include "qssl_p.h"
 #include "qsslsocket.h"
 #include "qsslcipher.h"
+#include "qsslsessioncache.h"
 #include "qocspresponse.h"
 #include "qtlsbackend_p.h"
 #include "qsslconfiguration_p.h"
@@ -1013,6 +1014,47 @@ void QSslSocket::setSslConfiguration(const QSslConfiguration &configuration)
     }
 }
 
+/*!
+    \since 6.4
+
+    Sets the cache this socket uses to resume TLS sessions to \a cache.
+    Pass \nullptr to stop using a cache, which is the default.
+
+    When the socket starts a client handshake and its configuration has no
+    session ticket, it looks up a session for its peer in \a cache; once a
+    session is negotiated, or a new session ticket arrives, it stores the
+    session there. Sharing one cache between sockets lets a connection
+    resume the session negotiated by another one. The lookup is keyed by
+    the peer verify name if one was set, otherwise by the peer name, and
+    by the peer port.
+
+    The cache is not used if QSsl::SslOptionDisableSessionPersistence is
+    set in the socket's configuration, or in server mode.
+
+    The socket does not take ownership of \a cache, which must outlive it.
+
+    \sa sslSessionCache(), QSslSessionCache, QSslConfiguration::sessionTicket()
+*/
+void QSslSocket::setSslSessionCache(QSslSessionCache *cache)
+{
+    Q_D(QSslSocket);
+    d->sessionCache = cache;
+}
+
+/*!
+    \since 6.4
+
+    Returns the cache this socket uses to resume TLS sessions, or \nullptr
+    if it does not use one.
+
+    \sa setSslSessionCache()
+*/
+QSslSessionCache *QSslSocket::sslSessionCache() const
+{
+    Q_D(const QSslSocket);
+    return d->sessionCache;
+}
+
 /*!
     Sets the certificate chain to be presented to the peer during the
     SSL handshake to be \a localChain.
@@ -2878,15 +2920,80 @@ bool QSslSocketPrivate::flush()
     return plainSocket && plainSocket->flush();
 }
 
+/*!
+    \internal
+
+    Passes the file transfer of QAbstractSocket::sendFile() on to the plain
+    socket, when the bytes would otherwise reach it unchanged: either the
+    socket is not encrypted, or the backend has handed encryption over to
+    the kernel (see QSsl::SslOptionEnableKernelTls). In the latter case, the
+    progress of the transfer is reported through encryptedBytesWritten().
+    Returns -1 if the file has to go through the TLS backend.
+*/
+qint64 QSslSocketPrivate::forwardFile(QFile *file, qint64 offset, qint64 length)
+{
+    if (!plainSocket)
+        return -1;
+    if (mode == QSslSocket::UnencryptedMode)
+        return autoStartHandshake ? -1 : plainSocket->sendFile(file, offset, length);
+    if (!connectionEncrypted || !backend)
+        return -1;
+
+    // Whatever was written before must reach the plain socket first.
+    transmit();
+    if (!writeBuffer.isEmpty() || !backend->canSendFiles())
+        return -1;
+    return plainSocket->sendFile(file, offset, length);
+}
+
 /*!
     \internal
 */
 void QSslSocketPrivate::startClientEncryption()
 {
+    if (sessionCache && configuration.sslSession.isEmpty()
+        && !(configuration.sslOptions & QSsl::SslOptionDisableSessionPersistence)) {
+        Q_Q(const QSslSocket);
+        configuration.sslSession = sessionCache->session(sessionCachePeerName(), q->peerPort());
+    }
+
     if (backend.get())
         backend->startClientEncryption();
 }
 
+/*!
+    \internal
+
+    Returns the name sessions of this socket are stored under in the session
+    cache, the same name the TLS backends send in the SNI extension.
+*/
+QString QSslSocketPrivate::sessionCachePeerName() const
+{
+    Q_Q(const QSslSocket);
+    if (!verificationPeerName.isEmpty())
+        return verificationPeerName;
+    const QString peerName = q->peerName();
+    return peerName.isEmpty() ? hostName : peerName;
+}
+
+/*!
+    \internal
+
+    Stores the current session in the session cache, if any. Called by the
+    TLS backends (via QTlsBackend) when they have a session to persist.
+*/
+void QSslSocketPrivate::updateSessionCache()
+{
+    if (!sessionCache || mode != QSslSocket::SslClientMode || configuration.sslSession.isEmpty()
+        || (configuration.sslOptions & QSsl::SslOptionDisableSessionPersistence)) {
+        return;
+    }
+
+    Q_Q(const QSslSocket);
+    sessionCache->insert(sessionCachePeerName(), q->peerPort(), configuration.sslSession,
+                         configuration.sslSessionTicketLifeTimeHint);
+}
+
 /*!
     \internal
 */
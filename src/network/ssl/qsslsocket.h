@@ -58,6 +58,7 @@ class QSslCipher;
 class QSslCertificate;
 class QSslConfiguration;
 class QSslPreSharedKeyAuthenticator;
+class QSslSessionCache;
 class QOcspResponse;
 
 class QSslSocketPrivate;
@@ -128,6 +129,8 @@ public:
     // SSL configuration
     QSslConfiguration sslConfiguration() const;
     void setSslConfiguration(const QSslConfiguration &config);
+    void setSslSessionCache(QSslSessionCache *cache);
+    QSslSessionCache *sslSessionCache() const;
 
     // Certificate & cipher accessors.
     void setLocalCertificateChain(const QList<QSslCertificate> &localChain);
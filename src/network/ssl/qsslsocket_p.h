@@ -72,6 +72,7 @@
 QT_BEGIN_NAMESPACE
 
 class QSslContext;
+class QSslSessionCache;
 class QTlsBackend;
 
 class Q_NETWORK_EXPORT QSslSocketPrivate : public QTcpSocketPrivate
@@ -100,6 +101,11 @@ public:
 
     bool allowRootCertOnDemandLoading;
 
+    // not owned, see QSslSocket::setSslSessionCache()
+    QSslSessionCache *sessionCache = nullptr;
+    QString sessionCachePeerName() const;
+    void updateSessionCache();
+
     static bool s_loadRootCertsOnDemand;
 
     static bool supportsSsl();
@@ -154,6 +160,9 @@ public:
     qint64 peek(char *data, qint64 maxSize) override;
     QByteArray peek(qint64 maxSize) override;
     bool flush() override;
+    // data must go through the TLS backend, not straight to the socket
+    bool canSendFiles() const override { return false; }
+    qint64 forwardFile(QFile *file, qint64 offset, qint64 length) override;
 
     void startClientEncryption();
     void startServerEncryption();
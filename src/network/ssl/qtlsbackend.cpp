@@ -1084,6 +1084,7 @@ void QTlsBackend::setSessionAsn1(QSslSocketPrivate *d, const QByteArray &asn1)
 {
     Q_ASSERT(d);
     d->configuration.sslSession = asn1;
+    d->updateSessionCache();
 }
 
 /*!
@@ -1094,6 +1095,7 @@ void QTlsBackend::setSessionLifetimeHint(QSslSocketPrivate *d, int hint)
 {
     Q_ASSERT(d);
     d->configuration.sslSessionTicketLifeTimeHint = hint;
+    d->updateSessionCache();
 }
 
 /*!
@@ -1944,6 +1946,20 @@ QList<QOcspResponse> TlsCryptograph::ocsps() const
     return {};
 }
 
+/*!
+    \internal
+    \since 6.4
+
+    Returns \c true if data written to the plain socket from now on gets
+    encrypted without the backend's involvement (for example, by the kernel),
+    so that QSslSocket can pass files to the plain socket as they are. The
+    default implementation returns \c false.
+*/
+bool TlsCryptograph::canSendFiles() const
+{
+    return false;
+}
+
 /*!
     \internal
 
@@ -212,6 +212,7 @@ public:
     virtual void transmit() = 0;
     virtual bool hasUndecryptedData() const;
     virtual QList<QOcspResponse> ocsps() const;
+    virtual bool canSendFiles() const;
 
     static bool isMatchingHostname(const QSslCertificate &cert, const QString &peerName);
 
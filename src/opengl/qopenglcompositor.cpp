@@ -40,6 +40,7 @@
 #include <QtOpenGL/QOpenGLFramebufferObject>
 #include <QtGui/QOpenGLContext>
 #include <QtGui/QWindow>
+#include <QtGui/private/qopenglcontext_p.h>
 #include <qpa/qplatformbackingstore.h>
 
 #include "qopenglcompositor_p.h"
@@ -67,6 +68,11 @@ QT_BEGIN_NAMESPACE
     raised and lowered (addWindow(), moveToTop(), etc.), and to
     schedule repaints (update()).
 
+    When the target surface reports a buffer age, only the areas damaged
+    since the back buffer was last presented are composed again, and the
+    damage is passed on with the swap. Passing the changed area to update()
+    keeps that damage small; a plain update() recomposes everything.
+
     \note To get support for QWidget-based windows, just use
     QOpenGLCompositorBackingStore. It will automatically create
     textures from the raster-rendered content and trigger the
@@ -110,10 +116,53 @@ void QOpenGLCompositor::setRotation(int degrees)
 
 void QOpenGLCompositor::update()
 {
+    m_fullDamagePending = true;
+    if (!m_updateTimer.isActive())
+        m_updateTimer.start();
+}
+
+/*!
+    Schedules a repaint for \a damage, given in the coordinate system of the
+    target window.
+ */
+void QOpenGLCompositor::update(const QRegion &damage)
+{
+    m_pendingDamage |= damage;
     if (!m_updateTimer.isActive())
         m_updateTimer.start();
 }
 
+QRegion QOpenGLCompositor::frameDamage()
+{
+    // Windows that got added, removed, restacked, moved or faded need both
+    // their old and new areas composed again.
+    QList<ComposedWindow> composedWindows;
+    composedWindows.reserve(m_windows.size());
+    for (QOpenGLCompositorWindow *window : qAsConst(m_windows))
+        composedWindows.append({ window, window->sourceWindow()->geometry(), window->sourceWindow()->opacity() });
+
+    QRegion damage = qExchange(m_pendingDamage, QRegion());
+    if (composedWindows != m_composedWindows) {
+        for (const ComposedWindow &w : qAsConst(m_composedWindows))
+            damage |= w.geometry;
+        for (const ComposedWindow &w : qAsConst(composedWindows))
+            damage |= w.geometry;
+        m_composedWindows = composedWindows;
+    }
+
+    const QRect nativeRect(QPoint(0, 0), m_nativeTargetGeometry.size());
+    if (qExchange(m_fullDamagePending, false) || m_rotation)
+        return nativeRect;
+
+    const qreal dpr = m_targetWindow->devicePixelRatio();
+    if (dpr == 1)
+        return damage;
+    QRegion nativeDamage;
+    for (const QRect &r : damage)
+        nativeDamage |= QRect(r.topLeft() * dpr, r.size() * dpr);
+    return nativeDamage;
+}
+
 QImage QOpenGLCompositor::grab()
 {
     Q_ASSERT(m_context && m_targetWindow);
@@ -135,6 +184,22 @@ void QOpenGLCompositor::renderAll(QOpenGLFramebufferObject *fbo)
     if (fbo)
         fbo->bind();
 
+    QRegion damage;
+    bool partialRepaint = false;
+    if (!fbo) {
+        damage = frameDamage();
+        QOpenGLContextPrivate *contextPrivate = QOpenGLContextPrivate::get(m_context);
+        const QRegion repaintRegion = m_damageTracker.beginFrame(damage, contextPrivate->bufferAge(m_targetWindow),
+                                                                 m_nativeTargetGeometry.size());
+        const QRect scissorRect = repaintRegion.boundingRect();
+        partialRepaint = scissorRect != QRect(QPoint(0, 0), m_nativeTargetGeometry.size());
+        if (partialRepaint) {
+            glEnable(GL_SCISSOR_TEST);
+            glScissor(scissorRect.x(), m_nativeTargetGeometry.height() - scissorRect.y() - scissorRect.height(),
+                      scissorRect.width(), scissorRect.height());
+        }
+    }
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
     glViewport(0, 0, m_nativeTargetGeometry.width(), m_nativeTargetGeometry.height());
 
@@ -150,8 +215,10 @@ void QOpenGLCompositor::renderAll(QOpenGLFramebufferObject *fbo)
         render(m_windows.at(i));
 
     m_blitter.release();
+    if (partialRepaint)
+        glDisable(GL_SCISSOR_TEST);
     if (!fbo)
-        m_context->swapBuffers(m_targetWindow);
+        QOpenGLContextPrivate::get(m_context)->swapBuffers(m_targetWindow, damage);
     else
         fbo->release();
 
@@ -56,6 +56,9 @@
 #include <QtCore/QTimer>
 #include <QtOpenGL/QOpenGLTextureBlitter>
 #include <QtGui/QMatrix4x4>
+#include <QtGui/QRegion>
+
+#include "qopengldamagetracker_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -88,6 +91,7 @@ public:
     QWindow *targetWindow() const { return m_targetWindow; }
 
     void update();
+    void update(const QRegion &damage);
     QImage grab();
 
     QList<QOpenGLCompositorWindow *> windows() const { return m_windows; }
@@ -108,6 +112,17 @@ private:
 
     void renderAll(QOpenGLFramebufferObject *fbo);
     void render(QOpenGLCompositorWindow *window);
+    QRegion frameDamage();
+
+    struct ComposedWindow {
+        QOpenGLCompositorWindow *window;
+        QRect geometry;
+        qreal opacity;
+        bool operator==(const ComposedWindow &other) const
+        {
+            return window == other.window && geometry == other.geometry && opacity == other.opacity;
+        }
+    };
 
     QOpenGLContext *m_context;
     QWindow *m_targetWindow;
@@ -117,6 +132,10 @@ private:
     QTimer m_updateTimer;
     QOpenGLTextureBlitter m_blitter;
     QList<QOpenGLCompositorWindow *> m_windows;
+    QRegion m_pendingDamage;
+    bool m_fullDamagePending = true;
+    QList<ComposedWindow> m_composedWindows;
+    QOpenGLDamageTracker m_damageTracker;
 };
 
 QT_END_NAMESPACE
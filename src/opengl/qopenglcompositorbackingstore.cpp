@@ -184,7 +184,6 @@ void QOpenGLCompositorBackingStore::flush(QWindow *window, const QRegion &region
 {
     // Called for ordinary raster windows.
 
-    Q_UNUSED(region);
     Q_UNUSED(offset);
 
     QOpenGLCompositor *compositor = QOpenGLCompositor::instance();
@@ -200,7 +199,7 @@ void QOpenGLCompositorBackingStore::flush(QWindow *window, const QRegion &region
     m_textures->clear();
     m_textures->appendTexture(nullptr, m_bsTexture, window->geometry());
 
-    compositor->update();
+    compositor->update(region.translated(window->geometry().topLeft()));
 }
 
 void QOpenGLCompositorBackingStore::composeAndFlush(QWindow *window, const QRegion &region, const QPoint &offset,
@@ -209,7 +208,6 @@ void QOpenGLCompositorBackingStore::composeAndFlush(QWindow *window, const QRegi
 {
     // QOpenGLWidget/QQuickWidget content provided as textures. The raster content goes on top.
 
-    Q_UNUSED(region);
     Q_UNUSED(offset);
     Q_UNUSED(translucentBackground);
 
@@ -229,6 +227,25 @@ void QOpenGLCompositorBackingStore::composeAndFlush(QWindow *window, const QRegi
 
     QWindowPrivate::get(window)->lastComposeTime.start();
 
+    // Only the flushed region and the widget textures with new content have
+    // changed, unless the textures got rearranged. With neither a region nor
+    // dirty textures (e.g. on expose) the whole window is composed again.
+    QRegion damage = region;
+    bool texturesChanged = m_textures->count() != textures->count() + 1;
+    bool hasDirtyTextures = false;
+    for (int i = 0; i < textures->count(); ++i) {
+        if (!texturesChanged && (m_textures->geometry(i) != textures->geometry(i)
+                                 || m_textures->clipRect(i) != textures->clipRect(i))) {
+            texturesChanged = true;
+        }
+        if (textures->flags(i).testFlag(QPlatformTextureList::TextureIsDirty)) {
+            damage |= textures->geometry(i);
+            hasDirtyTextures = true;
+        }
+    }
+    if (texturesChanged || (region.isEmpty() && !hasDirtyTextures))
+        damage = QRect(QPoint(0, 0), window->geometry().size());
+
     m_textures->clear();
     for (int i = 0; i < textures->count(); ++i)
         m_textures->appendTexture(textures->source(i), textures->textureId(i), textures->geometry(i),
@@ -240,7 +257,7 @@ void QOpenGLCompositorBackingStore::composeAndFlush(QWindow *window, const QRegi
     textures->lock(true);
     m_lockedWidgetTextures = textures;
 
-    compositor->update();
+    compositor->update(damage.translated(window->geometry().topLeft()));
 }
 
 void QOpenGLCompositorBackingStore::notifyComposited()
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtOpenGL module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef QOPENGLDAMAGETRACKER_P_H
+#define QOPENGLDAMAGETRACKER_P_H
+
+#include <QtOpenGL/qtopenglglobal.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrect.h>
+#include <QtGui/qregion.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Keeps the damage of the last few frames presented on a surface, so that
+    with EGL_EXT_buffer_age (or similar) only the parts of the back buffer
+    that are out of date need to be rendered again. All regions are in
+    device pixels with a top-left origin.
+*/
+class QOpenGLDamageTracker
+{
+public:
+    // Returns the region that has to be rendered into a back buffer of the
+    // given age for it to hold the complete frame. An age of 0 means the
+    // contents are undefined, and so is everything older than the history.
+    QRegion beginFrame(const QRegion &damage, int bufferAge, const QSize &surfaceSize)
+    {
+        const QRect fullRect(QPoint(0, 0), surfaceSize);
+        if (surfaceSize != m_surfaceSize) {
+            m_history.clear();
+            m_surfaceSize = surfaceSize;
+        }
+
+        const QRegion frameDamage = damage & fullRect;
+        QRegion repaint;
+        if (bufferAge <= 0 || bufferAge - 1 > m_history.size() || !isEnabled()) {
+            repaint = fullRect;
+        } else {
+            repaint = frameDamage;
+            for (int i = 0; i < bufferAge - 1; ++i)
+                repaint |= m_history.at(i);
+        }
+
+        m_history.prepend(frameDamage);
+        if (m_history.size() > MaxTrackedFrames)
+            m_history.removeLast();
+
+        return repaint;
+    }
+
+    void invalidate() { m_history.clear(); }
+
+    static bool isEnabled()
+    {
+        static const bool enabled = !qEnvironmentVariableIntValue("QT_OPENGL_NO_PARTIAL_UPDATES");
+        return enabled;
+    }
+
+private:
+    enum { MaxTrackedFrames = 4 };
+    QSize m_surfaceSize;
+    QList<QRegion> m_history; // newest first
+};
+
+QT_END_NAMESPACE
+
+#endif // QOPENGLDAMAGETRACKER_P_H
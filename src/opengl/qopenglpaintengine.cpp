@@ -79,6 +79,7 @@
 #include <private/qfontengine_p.h>
 #include <private/qdatabuffer_p.h>
 #include <private/qstatictext_p.h>
+#include <private/qstrokecache_p.h>
 #include <private/qtriangulator_p.h>
 
 #include <private/qopenglengineshadermanager_p.h>
@@ -1402,26 +1403,49 @@ void QOpenGL2PaintEngineExPrivate::stroke(const QVectorPath &path, const QPen &p
                                                         ? q->state()->rectangleClip
                                                         : QRectF(0, 0, width, height));
 
-    if (penStyle == Qt::SolidLine) {
-        stroker.process(path, pen, clip, s->renderHints);
+    // The triangulation depends on the pen and the scale, and dashes also on
+    // the clip unless the whole path is visible.
+    const bool cacheStroke = QStrokeCache::isEnabled()
+            && (penStyle == Qt::SolidLine || clip.contains(path.controlPointRect()));
+    QStrokeCache::Stroke cachedStroke;
+    const float *vertices = nullptr;
+    int vertexCount = 0;
+
+    if (cacheStroke && QStrokeCache::find(path, QStrokeCache::Key(QStrokeCache::TriangleStrip, pen, inverseScale),
+                                          &cachedStroke)) {
+        vertices = cachedStroke.vertices.constData();
+        vertexCount = int(cachedStroke.vertices.size());
+    } else {
+        if (penStyle == Qt::SolidLine) {
+            stroker.process(path, pen, clip, s->renderHints);
+
+        } else { // Some sort of dash
+            dasher.process(path, pen, clip, s->renderHints);
 
-    } else { // Some sort of dash
-        dasher.process(path, pen, clip, s->renderHints);
+            QVectorPath dashStroke(dasher.points(),
+                                   dasher.elementCount(),
+                                   dasher.elementTypes());
+            stroker.process(dashStroke, pen, clip, s->renderHints);
+        }
 
-        QVectorPath dashStroke(dasher.points(),
-                               dasher.elementCount(),
-                               dasher.elementTypes());
-        stroker.process(dashStroke, pen, clip, s->renderHints);
+        vertices = stroker.vertices();
+        vertexCount = stroker.vertexCount();
+
+        if (cacheStroke && vertexCount) {
+            cachedStroke.vertices = QList<float>(vertices, vertices + vertexCount);
+            QStrokeCache::insert(path, QStrokeCache::Key(QStrokeCache::TriangleStrip, pen, inverseScale),
+                                 cachedStroke);
+        }
     }
 
-    if (!stroker.vertexCount())
+    if (!vertexCount)
         return;
 
     if (opaque) {
         prepareForDraw(opaque);
 
-        uploadData(QT_VERTEX_COORDS_ATTR, stroker.vertices(), stroker.vertexCount());
-        funcs.glDrawArrays(GL_TRIANGLE_STRIP, 0, stroker.vertexCount() / 2);
+        uploadData(QT_VERTEX_COORDS_ATTR, vertices, vertexCount);
+        funcs.glDrawArrays(GL_TRIANGLE_STRIP, 0, vertexCount / 2);
     } else {
         qreal width = qpen_widthf(pen) / 2;
         if (width == 0)
@@ -1435,7 +1459,7 @@ void QOpenGL2PaintEngineExPrivate::stroke(const QVectorPath &path, const QPen &p
 
         QRectF bounds = path.controlPointRect().adjusted(-extra, -extra, extra, extra);
 
-        fillStencilWithVertexArray(stroker.vertices(), stroker.vertexCount() / 2,
+        fillStencilWithVertexArray(vertices, vertexCount / 2,
                                       nullptr, 0, bounds, QOpenGL2PaintEngineExPrivate::TriStripStrokeFillMode);
 
         funcs.glStencilOp(GL_KEEP, GL_REPLACE, GL_REPLACE);
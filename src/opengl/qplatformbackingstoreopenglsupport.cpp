@@ -40,8 +40,10 @@
 #ifndef QT_NO_OPENGL
 
 #include "qplatformbackingstoreopenglsupport.h"
+#include "qopengldamagetracker_p.h"
 
 #include <QtGui/private/qwindow_p.h>
+#include <QtGui/private/qopenglcontext_p.h>
 
 #include <qpa/qplatformgraphicsbuffer.h>
 #include <qpa/qplatformgraphicsbufferhelper.h>
@@ -110,6 +112,15 @@ static inline QRect toBottomLeftRect(const QRect &topLeftRect, int windowHeight)
                  topLeftRect.width(), topLeftRect.height());
 }
 
+static QRect textureRectInWindow(const QPlatformTextureList *textures, int idx, const QPoint &offset)
+{
+    const QRect clipRect = textures->clipRect(idx);
+    if (clipRect.isEmpty())
+        return QRect();
+    const QRect rectInWindow = textures->geometry(idx).translated(-offset);
+    return rectInWindow & clipRect.translated(rectInWindow.topLeft());
+}
+
 static void blitTextureForWidget(const QPlatformTextureList *textures, int idx, QWindow *window, const QRect &deviceWindowRect,
                                  QOpenGLTextureBlitter *blitter, const QPoint &offset, bool canUseSrgb)
 {
@@ -154,6 +165,7 @@ QPlatformBackingStoreOpenGLSupport::~QPlatformBackingStoreOpenGLSupport() {
             blitter->destroy();
     }
     delete blitter;
+    delete damageTracker;
 }
 
 void QPlatformBackingStoreOpenGLSupport::composeAndFlush(QWindow *window, const QRegion &region, const QPoint &offset, QPlatformTextureList *textures, bool translucentBackground)
@@ -192,10 +204,73 @@ void QPlatformBackingStoreOpenGLSupport::composeAndFlush(QWindow *window, const
 
     QWindowPrivate::get(window)->lastComposeTime.start();
 
+    const QSize deviceWindowSize(qRound(window->width() * window->devicePixelRatio()),
+                                 qRound(window->height() * window->devicePixelRatio()));
+    const QRect fullDeviceRect(QPoint(), deviceWindowSize);
+
+    // Figure out what changed since the previous frame: the flushed region of
+    // the backingstore, the render-to-texture widgets that got new content,
+    // and, if any of them moved or resized, both their old and new areas.
+    // With no region and no dirty textures there is nothing to go by (e.g.
+    // an expose), so everything is considered changed.
+    QList<QRect> textureRects;
+    textureRects.reserve(textures->count());
+    bool hasDirtyTextures = false;
+    QRegion damage = deviceRegion(region, window, QPoint());
+    for (int i = 0; i < textures->count(); ++i) {
+        const QRect r = textureRectInWindow(textures, i, offset);
+        textureRects.append(r);
+        if (textures->flags(i).testFlag(QPlatformTextureList::TextureIsDirty)) {
+            damage |= deviceRect(r, window);
+            hasDirtyTextures = true;
+        }
+    }
+    if (textureRects != composedTextureRects) {
+        for (const QRect &r : qAsConst(composedTextureRects))
+            damage |= deviceRect(r, window);
+        for (const QRect &r : qAsConst(textureRects))
+            damage |= deviceRect(r, window);
+        composedTextureRects = textureRects;
+    }
+    if (region.isEmpty() && !hasDirtyTextures)
+        damage = fullDeviceRect;
+
+    // A single render-to-texture widget below the backingstore content, that
+    // covers the entire window and on top of which no widgets are painted,
+    // shows through a fully transparent backingstore. When the backingstore
+    // has no new content either, present the texture directly instead of
+    // clearing, blitting it and blending the backingstore over it.
+    const bool directPresent = region.isEmpty() && textures->count() == 1
+            && (textures->flags(0) & (QPlatformTextureList::StacksOnTop | QPlatformTextureList::Unobscured))
+                == QPlatformTextureList::Unobscured
+            && deviceRect(textureRects.at(0), window).contains(fullDeviceRect);
+
+    if (!damageTracker)
+        damageTracker = new QOpenGLDamageTracker;
+    if (damageTrackedWindow != window) {
+        damageTracker->invalidate();
+        damageTrackedWindow = window;
+    }
+
+    // With a buffer age the back buffer still has the contents of an earlier
+    // frame, so only the parts that changed since then need to be composed.
+    QOpenGLContextPrivate *contextPrivate = QOpenGLContextPrivate::get(context.data());
+    const QRegion repaintRegion = damageTracker->beginFrame(damage, contextPrivate->bufferAge(window),
+                                                            deviceWindowSize);
+    const QRect scissorRect = repaintRegion.boundingRect();
+    const bool partialRepaint = scissorRect != fullDeviceRect;
+
     QOpenGLFunctions *funcs = context->functions();
-    funcs->glViewport(0, 0, qRound(window->width() * window->devicePixelRatio()), qRound(window->height() * window->devicePixelRatio()));
-    funcs->glClearColor(0, 0, 0, translucentBackground ? 0 : 1);
-    funcs->glClear(GL_COLOR_BUFFER_BIT);
+    funcs->glViewport(0, 0, deviceWindowSize.width(), deviceWindowSize.height());
+    if (partialRepaint) {
+        funcs->glEnable(GL_SCISSOR_TEST);
+        const QRect glScissorRect = toBottomLeftRect(scissorRect, deviceWindowSize.height());
+        funcs->glScissor(glScissorRect.x(), glScissorRect.y(), glScissorRect.width(), glScissorRect.height());
+    }
+    if (!directPresent) {
+        funcs->glClearColor(0, 0, 0, translucentBackground ? 0 : 1);
+        funcs->glClear(GL_COLOR_BUFFER_BIT);
+    }
 
     if (!blitter) {
         blitter = new QOpenGLTextureBlitter;
@@ -226,6 +301,14 @@ void QPlatformBackingStoreOpenGLSupport::composeAndFlush(QWindow *window, const
             blitTextureForWidget(textures, i, window, deviceWindowRect, blitter, offset, canUseSrgb);
     }
 
+    if (directPresent) {
+        blitter->release();
+        if (partialRepaint)
+            funcs->glDisable(GL_SCISSOR_TEST);
+        contextPrivate->swapBuffers(window, damage);
+        return;
+    }
+
     // Backingstore texture with the normal widgets.
     GLuint textureId = 0;
     QOpenGLTextureBlitter::Origin origin = QOpenGLTextureBlitter::OriginTopLeft;
@@ -312,7 +395,10 @@ void QPlatformBackingStoreOpenGLSupport::composeAndFlush(QWindow *window, const
     funcs->glDisable(GL_BLEND);
     blitter->release();
 
-    context->swapBuffers(window);
+    if (partialRepaint)
+        funcs->glDisable(GL_SCISSOR_TEST);
+
+    contextPrivate->swapBuffers(window, damage);
 }
 
 GLuint QPlatformBackingStoreOpenGLSupport::toTexture(const QRegion &dirtyRegion, QSize *textureSize, QPlatformBackingStore::TextureFlags *flags) const
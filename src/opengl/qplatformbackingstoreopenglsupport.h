@@ -60,6 +60,7 @@ QT_BEGIN_NAMESPACE
 
 class QOpenGLTextureBlitter;
 class QOpenGLBackingStore;
+class QOpenGLDamageTracker;
 
 class Q_OPENGL_EXPORT QPlatformBackingStoreOpenGLSupport : public QPlatformBackingStoreOpenGLSupportBase
 {
@@ -76,6 +77,9 @@ private:
     mutable bool needsSwizzle = false;
     mutable bool premultiplied = false;
     QOpenGLTextureBlitter *blitter = nullptr;
+    QOpenGLDamageTracker *damageTracker = nullptr;
+    QWindow *damageTrackedWindow = nullptr;
+    QList<QRect> composedTextureRects;
 };
 
 Q_OPENGL_EXPORT void qt_registerDefaultPlatformBackingStoreOpenGLSupport();
@@ -903,6 +903,8 @@ void QKmsDevice::discoverPlanes()
                 plane.zposPropertyId = prop->prop_id;
             } else if (!strcasecmp(prop->name, "blend_op")) {
                 plane.blendOpPropertyId = prop->prop_id;
+            } else if (!strcasecmp(prop->name, "in_fence_fd")) {
+                plane.inFenceFdPropertyId = prop->prop_id;
             }
         });
 
@@ -180,6 +180,7 @@ struct QKmsPlane
     uint32_t crtcheightPropertyId = 0;
     uint32_t zposPropertyId = 0;
     uint32_t blendOpPropertyId = 0;
+    uint32_t inFenceFdPropertyId = 0;
 
     uint32_t activeCrtcId = 0;
 };
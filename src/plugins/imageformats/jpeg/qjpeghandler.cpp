@@ -371,6 +371,21 @@ static bool read_jpeg_image(QImage *outImage,
 
             (void) jpeg_start_decompress(info);
 
+            // The horizontal offset of the clip region in the decoded rows
+            int clipX = clip.x();
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 2000000
+            // Let libjpeg-turbo decode only the iMCU columns covering the
+            // clip region, and skip the rows above it without decoding them.
+            if (clip.width() < int(info->output_width)) {
+                JDIMENSION xoffset = clip.x();
+                JDIMENSION width = clip.width();
+                jpeg_crop_scanline(info, &xoffset, &width);
+                clipX = clip.x() - int(xoffset);
+            }
+            if (clip.y() > 0)
+                (void) jpeg_skip_scanlines(info, clip.y());
+#endif
+
             while (info->output_scanline < info->output_height) {
                 int y = int(info->output_scanline) - clip.y();
                 if (y >= clip.height())
@@ -382,12 +397,12 @@ static bool read_jpeg_image(QImage *outImage,
                     continue;   // Haven't reached the starting line yet.
 
                 if (info->output_components == 3) {
-                    uchar *in = rows[0] + clip.x() * 3;
+                    uchar *in = rows[0] + clipX * 3;
                     QRgb *out = (QRgb*)outImage->scanLine(y);
                     converter(out, in, clip.width());
                 } else if (info->out_color_space == JCS_CMYK) {
                     // Convert CMYK->RGB.
-                    uchar *in = rows[0] + clip.x() * 4;
+                    uchar *in = rows[0] + clipX * 4;
                     QRgb *out = (QRgb*)outImage->scanLine(y);
                     for (int i = 0; i < clip.width(); ++i) {
                         int k = in[3];
@@ -398,7 +413,7 @@ static bool read_jpeg_image(QImage *outImage,
                 } else if (info->output_components == 1) {
                     // Grayscale.
                     memcpy(outImage->scanLine(y),
-                           rows[0] + clip.x(), clip.width());
+                           rows[0] + clipX, clip.width());
                 }
             }
         } else {
@@ -522,6 +537,25 @@ static inline void write_icc_profile(const QImage &image, j_compress_ptr cinfo)
     }
 }
 
+#ifdef JCS_EXTENSIONS
+// libjpeg-turbo reads 32-bit pixels directly, ignoring the fourth byte, which
+// saves converting every scanline to RGB888
+static J_COLOR_SPACE extendedColorSpace(QImage::Format format)
+{
+    switch (format) {
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        return Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? JCS_EXT_BGRX : JCS_EXT_XRGB;
+    case QImage::Format_RGBX8888:
+    case QImage::Format_RGBA8888:
+        return JCS_EXT_RGBX;
+    default:
+        return JCS_UNKNOWN;
+    }
+}
+#endif
+
 static bool do_write_jpeg_image(struct jpeg_compress_struct &cinfo,
                                 JSAMPROW *row_pointer,
                                 const QImage &image,
@@ -576,6 +610,12 @@ static bool do_write_jpeg_image(struct jpeg_compress_struct &cinfo,
         default:
             cinfo.input_components = 3;
             cinfo.in_color_space = JCS_RGB;
+#ifdef JCS_EXTENSIONS
+            if (const J_COLOR_SPACE colorSpace = extendedColorSpace(image.format()); colorSpace != JCS_UNKNOWN) {
+                cinfo.input_components = 4;
+                cinfo.in_color_space = colorSpace;
+            }
+#endif
         }
 
         jpeg_set_defaults(&cinfo);
@@ -605,10 +645,23 @@ static bool do_write_jpeg_image(struct jpeg_compress_struct &cinfo,
         jpeg_start_compress(&cinfo, TRUE);
 
         set_text(image, &cinfo, description);
-        if (cinfo.in_color_space == JCS_RGB)
+        if (!gray)
             write_icc_profile(image, &cinfo);
 
-        row_pointer[0] = new uchar[cinfo.image_width*cinfo.input_components];
+        // Scanlines libjpeg can consume as they are get passed without a copy
+        const bool directScanlines = cinfo.input_components == 4
+                || image.format() == QImage::Format_Grayscale8
+                || image.format() == QImage::Format_RGB888;
+        while (directScanlines && cinfo.next_scanline < cinfo.image_height) {
+            JSAMPROW rows[16];
+            const JDIMENSION count = qMin<JDIMENSION>(16, cinfo.image_height - cinfo.next_scanline);
+            for (JDIMENSION i = 0; i < count; ++i)
+                rows[i] = const_cast<uchar *>(image.constScanLine(cinfo.next_scanline + i));
+            jpeg_write_scanlines(&cinfo, rows, count);
+        }
+
+        if (!directScanlines)
+            row_pointer[0] = new uchar[cinfo.image_width*cinfo.input_components];
         int w = cinfo.image_width;
         while (cinfo.next_scanline < cinfo.image_height) {
             uchar *row = row_pointer[0];
@@ -664,12 +717,6 @@ static bool do_write_jpeg_image(struct jpeg_compress_struct &cinfo,
                     }
                 }
                 break;
-            case QImage::Format_Grayscale8:
-                memcpy(row, image.constScanLine(cinfo.next_scanline), w);
-                break;
-            case QImage::Format_RGB888:
-                memcpy(row, image.constScanLine(cinfo.next_scanline), w * 3);
-                break;
             case QImage::Format_RGB32:
             case QImage::Format_ARGB32:
             case QImage::Format_ARGB32_Premultiplied:
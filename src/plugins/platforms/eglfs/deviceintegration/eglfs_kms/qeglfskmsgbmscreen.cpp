@@ -45,12 +45,16 @@
 #include <private/qeglfsintegration_p.h>
 
 #include <QtCore/QLoggingCategory>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
 
 #include <QtGui/private/qguiapplication_p.h>
 #include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/private/qeglconvenience_p.h>
 #include <QtFbSupport/private/qfbvthandler_p.h>
 
 #include <errno.h>
+#include <unistd.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -263,6 +267,71 @@ void QEglFSKmsGbmScreen::ensureModeSet(uint32_t fb)
     }
 }
 
+#if QT_CONFIG(drm_atomic) && defined(EGL_ANDROID_native_fence_sync)
+struct NativeFenceFunctions
+{
+    PFNEGLCREATESYNCKHRPROC createSync = nullptr;
+    PFNEGLDESTROYSYNCKHRPROC destroySync = nullptr;
+    PFNEGLDUPNATIVEFENCEFDANDROIDPROC dupNativeFenceFd = nullptr;
+};
+
+static const NativeFenceFunctions *nativeFenceFunctions(EGLDisplay display)
+{
+    static const NativeFenceFunctions functions = [display] {
+        NativeFenceFunctions f;
+        if (qEnvironmentVariableIntValue("QT_QPA_EGLFS_KMS_NO_EXPLICIT_FENCING")
+            || !q_hasEglExtension(display, "EGL_ANDROID_native_fence_sync")) {
+            return f;
+        }
+        f.createSync = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+        f.destroySync = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+        f.dupNativeFenceFd = reinterpret_cast<PFNEGLDUPNATIVEFENCEFDANDROIDPROC>(
+                    eglGetProcAddress("eglDupNativeFenceFDANDROID"));
+        if (!f.createSync || !f.destroySync || !f.dupNativeFenceFd)
+            f = NativeFenceFunctions();
+        qCDebug(qLcEglfsKmsDebug, "Explicit fencing for atomic commits %s",
+                f.createSync ? "enabled" : "not available");
+        return f;
+    }();
+    return functions.createSync ? &functions : nullptr;
+}
+#endif
+
+/*!
+    \internal
+
+    Returns a sync file descriptor that signals once the GPU has finished
+    rendering the frame just submitted on the current context, or -1 when
+    the driver cannot export one.
+
+    Passing it as the plane's IN_FENCE_FD lets the kernel queue the atomic
+    commit right away and latch the buffer as soon as rendering completes,
+    without relying on implicit synchronization of the buffer object, which
+    not all display and GPU driver combinations on embedded boards provide.
+    The caller owns the descriptor.
+*/
+int QEglFSKmsGbmScreen::createRenderFence()
+{
+#if QT_CONFIG(drm_atomic) && defined(EGL_ANDROID_native_fence_sync)
+    const NativeFenceFunctions *f = nativeFenceFunctions(display());
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!f || !context)
+        return -1;
+
+    const EGLint attributes[] = { EGL_SYNC_NATIVE_FENCE_FD_ANDROID, EGL_NO_NATIVE_FENCE_FD_ANDROID, EGL_NONE };
+    EGLSyncKHR sync = f->createSync(display(), EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+    if (sync == EGL_NO_SYNC_KHR)
+        return -1;
+    // the fence fd only exists once the fence command has been flushed
+    context->functions()->glFlush();
+    const int fd = f->dupNativeFenceFd(display(), sync);
+    f->destroySync(display(), sync);
+    return fd == EGL_NO_NATIVE_FENCE_FD_ANDROID ? -1 : fd;
+#else
+    return -1;
+#endif
+}
+
 void QEglFSKmsGbmScreen::waitForFlip()
 {
     if (m_headless || m_cloneSource)
@@ -313,6 +382,7 @@ void QEglFSKmsGbmScreen::flip()
     QKmsOutput &op(output());
     const int fd = device()->fd();
     m_flipPending = true;
+    int renderFence = -1;
 
     if (device()->hasAtomicSupport()) {
 #if QT_CONFIG(drm_atomic)
@@ -339,6 +409,13 @@ void QEglFSKmsGbmScreen::flip()
             static uint blendOp = uint(qEnvironmentVariableIntValue("QT_QPA_EGLFS_KMS_BLEND_OP"));
             if (blendOp)
                 drmModeAtomicAddProperty(request, op.eglfs_plane->id, op.eglfs_plane->blendOpPropertyId, blendOp);
+
+            if (op.eglfs_plane->inFenceFdPropertyId) {
+                renderFence = createRenderFence();
+                if (renderFence >= 0)
+                    drmModeAtomicAddProperty(request, op.eglfs_plane->id, op.eglfs_plane->inFenceFdPropertyId,
+                                             renderFence);
+            }
         }
 #endif
     } else {
@@ -388,6 +465,9 @@ void QEglFSKmsGbmScreen::flip()
 #if QT_CONFIG(drm_atomic)
     device()->threadLocalAtomicCommit(this);
 #endif
+    // the kernel holds its own reference once the commit is queued
+    if (renderFence >= 0)
+        close(renderFence);
 }
 
 void QEglFSKmsGbmScreen::flipFinished()
@@ -88,6 +88,7 @@ protected:
     void flipFinished();
     void ensureModeSet(uint32_t fb);
     void cloneDestFlipFinished(QEglFSKmsGbmScreen *cloneDestScreen);
+    int createRenderFence();
 
     gbm_surface *m_gbm_surface;
 
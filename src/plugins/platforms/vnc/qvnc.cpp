@@ -43,6 +43,8 @@
 #include "QtNetwork/qtcpsocket.h"
 #include <qendian.h>
 #include <qthread.h>
+#include <qthreadpool.h>
+#include <qhash.h>
 
 #include <QtGui/qguiapplication.h>
 #include <QtGui/QWindow>
@@ -55,6 +57,8 @@
 
 #include <QtCore/QDebug>
 
+#include <zlib.h>
+
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcVnc, "qt.qpa.vnc");
@@ -534,6 +538,422 @@ void QRfbRawEncoder::write()
     socket->flush();
 }
 
+// ZRLE, RFC 6143 section 7.7.6: the update is split into 64x64 tiles that
+// are individually run-length or palette encoded, and the result is
+// compressed with one zlib stream that lasts as long as the connection.
+static const int ZrleTileSize = 64;
+
+enum ZrleEncodingType {
+    ZrleCopyRectEncoding = 1,
+    ZrleEncoding = 16
+};
+
+struct QRfbZlibStream
+{
+    QRfbZlibStream()
+    {
+        memset(&zs, 0, sizeof(zs));
+        // favor latency: the link is usually slower than the compressor
+        // only at levels where compressing would stall the screen updates
+        deflateInit(&zs, Z_BEST_SPEED);
+    }
+    ~QRfbZlibStream() { deflateEnd(&zs); }
+
+    void deflateInto(const char *data, qsizetype size, int flush, QByteArray *out)
+    {
+        zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        zs.avail_in = uInt(size);
+        do {
+            const qsizetype offset = out->size();
+            out->resize(offset + qMax<qsizetype>(size / 2, 4096));
+            zs.next_out = reinterpret_cast<Bytef *>(out->data() + offset);
+            zs.avail_out = uInt(out->size() - offset);
+            deflate(&zs, flush);
+            out->resize(out->size() - zs.avail_out);
+        } while (zs.avail_out == 0);
+    }
+
+    z_stream zs;
+};
+
+static void appendRfbRect(QByteArray *out, const QRect &rect, qint32 encoding)
+{
+    const quint16 header[4] = { htons(quint16(rect.x())), htons(quint16(rect.y())),
+                                htons(quint16(rect.width())), htons(quint16(rect.height())) };
+    out->append(reinterpret_cast<const char *>(header), sizeof(header));
+    const quint32 enc = htonl(quint32(encoding));
+    out->append(reinterpret_cast<const char *>(&enc), sizeof(enc));
+}
+
+static void copyImageRect(const QImage &src, QImage *dst, const QRect &rect)
+{
+    const int bytesPerPixel = src.depth() / 8;
+    const qsizetype rowBytes = qsizetype(rect.width()) * bytesPerPixel;
+    const qsizetype offset = qsizetype(rect.x()) * bytesPerPixel;
+    for (int y = rect.top(); y <= rect.bottom(); ++y)
+        memcpy(dst->scanLine(y) + offset, src.constScanLine(y) + offset, rowBytes);
+}
+
+#if QT_CONFIG(thread)
+Q_GLOBAL_STATIC(QThreadPool, zrleEncoderPool)
+#endif
+
+QRfbZrleEncoder::QRfbZrleEncoder(QVncClient *s)
+    : QRfbEncoder(s), stream(new QRfbZlibStream)
+{
+}
+
+QRfbZrleEncoder::~QRfbZrleEncoder()
+{
+    // the update in flight still uses the stream and the frames
+    if (busy)
+        done.acquire();
+}
+
+void QRfbZrleEncoder::write()
+{
+    const QImage screenImage = client->server()->screenImage();
+    const QRegion region = client->dirtyRegion() & screenImage.rect();
+    qCDebug(lcVnc) << "QRfbZrleEncoder::write()" << region;
+
+    if (region.isEmpty()) {
+        const char update[4] = { 0, 0, 0, 0 }; // msg type, padding, no rects
+        client->clientSocket()->write(update, sizeof(update));
+        return;
+    }
+
+    if (frame.size() != screenImage.size() || frame.format() != screenImage.format()) {
+        frame = QImage(screenImage.size(), screenImage.format());
+        clientFrame = QImage(); // the client's contents are unknown until the next full update
+    }
+    // The screen keeps being painted on while the update is encoded, so work
+    // on a copy. Copying only the dirty rects keeps this cheap.
+    for (const QRect &rect : region)
+        copyImageRect(screenImage, &frame, rect);
+
+    // a CPIXEL drops the byte of a 32 bit pixel that holds no color bits
+    const QRfbPixelFormat &format = client->pixelFormat();
+    bytesPerPixel = client->clientBytesPerPixel();
+    cpixelOffset = 0;
+    cpixelSize = bytesPerPixel;
+    if (format.bitsPerPixel == 32 && format.trueColor && format.depth <= 24) {
+        const int highestBit = qMax(format.redShift + format.redBits,
+                                    qMax(format.greenShift + format.greenBits,
+                                         format.blueShift + format.blueBits));
+        const int lowestBit = qMin(format.redShift, qMin(format.greenShift, format.blueShift));
+        if (highestBit <= 24) {
+            cpixelSize = 3;
+            cpixelOffset = format.bigEndian ? 1 : 0;
+        } else if (lowestBit >= 8) {
+            cpixelSize = 3;
+            cpixelOffset = format.bigEndian ? 0 : 1;
+        }
+    }
+
+    const bool useCopyRect = client->supportsCopyRect();
+#if QT_CONFIG(thread)
+    busy = true;
+    zrleEncoderPool()->start([this, region, useCopyRect] {
+        const QByteArray update = encode(region, useCopyRect);
+        QVncClient *c = client;
+        QMetaObject::invokeMethod(c, [this, c, update] {
+            done.acquire();
+            busy = false;
+            c->encodingFinished(update);
+        }, Qt::QueuedConnection);
+        done.release();
+    });
+#else
+    client->encodingFinished(encode(region, useCopyRect));
+#endif
+}
+
+QByteArray QRfbZrleEncoder::encode(const QRegion &dirty, bool useCopyRect)
+{
+    QRegion region = dirty;
+    QPoint copySource;
+    QRect copied;
+    if (useCopyRect && !clientFrame.isNull()) {
+        copied = findScrolledRect(region, &copySource);
+        region -= copied;
+    }
+
+    QList<QRect> tiles;
+    QList<qsizetype> firstTile;
+    for (const QRect &rect : region) {
+        firstTile.append(tiles.size());
+        for (int y = rect.top(); y <= rect.bottom(); y += ZrleTileSize) {
+            for (int x = rect.left(); x <= rect.right(); x += ZrleTileSize) {
+                tiles.append(QRect(x, y, qMin(ZrleTileSize, rect.right() - x + 1),
+                                   qMin(ZrleTileSize, rect.bottom() - y + 1)));
+            }
+        }
+    }
+    firstTile.append(tiles.size());
+
+    // The tiles are independent of each other; only the zlib stream is
+    // sequential.
+    QList<QByteArray> encodedTiles(tiles.size());
+    QByteArray *results = encodedTiles.data();
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const qsizetype tasks = qMin<qsizetype>(tiles.size(), threadPool->maxThreadCount());
+    if (tasks > 1 && !threadPool->contains(QThread::currentThread())) {
+        QSemaphore semaphore;
+        QAtomicInteger<qsizetype> next = 0;
+        for (qsizetype t = 0; t < tasks; ++t) {
+            threadPool->start([&] {
+                for (qsizetype i = next.fetchAndAddRelaxed(1); i < tiles.size(); i = next.fetchAndAddRelaxed(1))
+                    results[i] = encodeTile(tiles.at(i));
+                semaphore.release(1);
+            });
+        }
+        semaphore.acquire(int(tasks));
+    } else
+#endif
+    {
+        for (qsizetype i = 0; i < tiles.size(); ++i)
+            results[i] = encodeTile(tiles.at(i));
+    }
+
+    QByteArray update;
+    const char header[2] = { 0, 0 }; // msg type, padding
+    update.append(header, sizeof(header));
+    const quint16 count = htons(quint16(region.rectCount() + (copied.isEmpty() ? 0 : 1)));
+    update.append(reinterpret_cast<const char *>(&count), sizeof(count));
+
+    // CopyRect reads from the client's framebuffer as it is before this
+    // update, so it has to come first
+    if (!copied.isEmpty()) {
+        appendRfbRect(&update, copied, ZrleCopyRectEncoding);
+        const quint16 source[2] = { htons(quint16(copySource.x())), htons(quint16(copySource.y())) };
+        update.append(reinterpret_cast<const char *>(source), sizeof(source));
+    }
+
+    qsizetype r = 0;
+    for (const QRect &rect : region) {
+        appendRfbRect(&update, rect, ZrleEncoding);
+        const qsizetype lengthOffset = update.size();
+        update.append(4, '\0');
+        for (qsizetype i = firstTile.at(r); i < firstTile.at(r + 1); ++i) {
+            const QByteArray &tile = encodedTiles.at(i);
+            stream->deflateInto(tile.constData(), tile.size(),
+                                i + 1 == firstTile.at(r + 1) ? Z_SYNC_FLUSH : Z_NO_FLUSH, &update);
+        }
+        const quint32 length = htonl(quint32(update.size() - lengthOffset - 4));
+        memcpy(update.data() + lengthOffset, &length, sizeof(length));
+        ++r;
+    }
+
+    if (clientFrame.isNull()) {
+        if (dirty.contains(frame.rect()))
+            clientFrame = frame.copy();
+    } else {
+        for (const QRect &rect : dirty)
+            copyImageRect(frame, &clientFrame, rect);
+    }
+
+    return update;
+}
+
+/*
+    Looks for a dirty rect whose contents were scrolled vertically, that is,
+    rows that the client already shows elsewhere in the same columns. Returns
+    the largest part that can be sent as a CopyRect from \a source, or a null
+    rect. Candidate offsets are found by comparing row hashes; the rows of
+    the result are compared exactly.
+*/
+QRect QRfbZrleEncoder::findScrolledRect(const QRegion &region, QPoint *source) const
+{
+    const int pixelBytes = frame.depth() / 8;
+    QRect best;
+    for (const QRect &rect : region) {
+        if (rect.height() < 32 || rect.width() < 64)
+            continue;
+        const qsizetype offset = qsizetype(rect.x()) * pixelBytes;
+        const qsizetype rowBytes = qsizetype(rect.width()) * pixelBytes;
+        const auto currentRow = [&](int y) { return frame.constScanLine(y) + offset; };
+        const auto previousRow = [&](int y) { return clientFrame.constScanLine(y) + offset; };
+
+        QHash<size_t, int> previousRows;
+        const int top = qMax(0, rect.top() - rect.height());
+        const int bottom = qMin(clientFrame.height() - 1, rect.bottom() + rect.height());
+        for (int y = top; y <= bottom; ++y)
+            previousRows.insert(qHashBits(previousRow(y), rowBytes), y);
+
+        QHash<int, int> votes;
+        for (int y = rect.top(); y <= rect.bottom(); ++y) {
+            const auto it = previousRows.constFind(qHashBits(currentRow(y), rowBytes));
+            if (it != previousRows.constEnd() && *it != y)
+                ++votes[*it - y];
+        }
+        int dy = 0;
+        int maxVotes = rect.height() / 4;
+        for (auto it = votes.cbegin(); it != votes.cend(); ++it) {
+            if (it.value() > maxVotes) {
+                maxVotes = it.value();
+                dy = it.key();
+            }
+        }
+        if (!dy)
+            continue;
+
+        int runStart = -1;
+        for (int y = rect.top(); y <= rect.bottom() + 1; ++y) {
+            const bool matches = y <= rect.bottom() && y + dy >= 0 && y + dy < clientFrame.height()
+                    && memcmp(currentRow(y), previousRow(y + dy), rowBytes) == 0;
+            if (matches && runStart < 0) {
+                runStart = y;
+            } else if (!matches && runStart >= 0) {
+                const QRect run(rect.x(), runStart, rect.width(), y - runStart);
+                if (run.height() >= 16 && run.width() * run.height() > best.width() * best.height()) {
+                    best = run;
+                    *source = QPoint(rect.x(), runStart + dy);
+                }
+                runStart = -1;
+            }
+        }
+    }
+    return best;
+}
+
+static void appendRunLength(QByteArray *out, int length)
+{
+    for (length -= 1; length >= 255; length -= 255)
+        out->append(char(255));
+    out->append(char(length));
+}
+
+QByteArray QRfbZrleEncoder::encodeTile(const QRect &tile) const
+{
+    const int w = tile.width();
+    const int h = tile.height();
+    const int depth = frame.depth();
+
+    // client pixels, reduced to CPIXELs
+    QVarLengthArray<quint32, ZrleTileSize * ZrleTileSize> pixels(qsizetype(w) * h);
+    QVarLengthArray<char, ZrleTileSize * 4> row(qsizetype(w) * bytesPerPixel);
+    for (int y = 0; y < h; ++y) {
+        const char *src = reinterpret_cast<const char *>(frame.constScanLine(tile.y() + y))
+                + qsizetype(tile.x()) * depth / 8;
+        if (client->doPixelConversion())
+            client->convertPixels(row.data(), src, w, depth);
+        else
+            memcpy(row.data(), src, row.size());
+        for (int x = 0; x < w; ++x) {
+            quint32 p = 0;
+            memcpy(&p, row.constData() + x * bytesPerPixel + cpixelOffset, cpixelSize);
+            pixels[y * w + x] = p;
+        }
+    }
+
+    // collect the palette (up to 127 colors) and the runs
+    QVarLengthArray<quint32, 127> palette;
+    QVarLengthArray<uchar, ZrleTileSize * ZrleTileSize> indices(pixels.size());
+    QVarLengthArray<int, ZrleTileSize * ZrleTileSize> runs; // run lengths; runs start at sum of previous
+    bool paletteFull = false;
+    qsizetype plainRleSize = 0;
+    qsizetype paletteRleSize = 0;
+    for (qsizetype i = 0; i < pixels.size(); ++i) {
+        const quint32 p = pixels.at(i);
+        if (!paletteFull) {
+            if (i > 0 && pixels.at(i - 1) == p) {
+                indices[i] = indices[i - 1];
+            } else {
+                const auto it = std::find(palette.cbegin(), palette.cend(), p);
+                if (it != palette.cend()) {
+                    indices[i] = uchar(it - palette.cbegin());
+                } else if (palette.size() < 127) {
+                    indices[i] = uchar(palette.size());
+                    palette.append(p);
+                } else {
+                    paletteFull = true;
+                }
+            }
+        }
+        if (i == 0 || pixels.at(i - 1) != p)
+            runs.append(1);
+        else
+            ++runs.last();
+    }
+    for (int length : runs) {
+        const int lengthBytes = (length - 1) / 255 + 1;
+        plainRleSize += cpixelSize + lengthBytes;
+        paletteRleSize += length == 1 ? 1 : 1 + lengthBytes;
+    }
+
+    QByteArray out;
+    const auto appendCPixel = [&](quint32 p) {
+        out.append(reinterpret_cast<const char *>(&p), cpixelSize);
+    };
+
+    if (!paletteFull && palette.size() == 1) {
+        out.append(char(1)); // solid
+        appendCPixel(palette.at(0));
+        return out;
+    }
+
+    const qsizetype colors = palette.size();
+    const int bits = colors <= 2 ? 1 : colors <= 4 ? 2 : 4;
+    const qsizetype rawSize = pixels.size() * cpixelSize;
+    const qsizetype packedSize = (!paletteFull && colors <= 16)
+            ? colors * cpixelSize + qsizetype(h) * ((w * bits + 7) / 8) : rawSize + 1;
+    paletteRleSize = paletteFull ? rawSize + 1 : colors * cpixelSize + paletteRleSize;
+    const qsizetype smallest = qMin(qMin(rawSize, packedSize), qMin(plainRleSize, paletteRleSize));
+
+    if (smallest == rawSize) {
+        out.reserve(1 + rawSize);
+        out.append(char(0));
+        for (quint32 p : pixels)
+            appendCPixel(p);
+    } else if (smallest == packedSize) {
+        out.reserve(1 + packedSize);
+        out.append(char(colors));
+        for (quint32 p : palette)
+            appendCPixel(p);
+        for (int y = 0; y < h; ++y) {
+            uchar byte = 0;
+            int used = 0;
+            for (int x = 0; x < w; ++x) {
+                byte = uchar(byte << bits) | indices.at(y * w + x);
+                used += bits;
+                if (used == 8) {
+                    out.append(char(byte));
+                    byte = 0;
+                    used = 0;
+                }
+            }
+            if (used)
+                out.append(char(byte << (8 - used)));
+        }
+    } else if (smallest == paletteRleSize) {
+        out.reserve(1 + paletteRleSize);
+        out.append(char(128 + colors));
+        for (quint32 p : palette)
+            appendCPixel(p);
+        qsizetype i = 0;
+        for (int length : runs) {
+            if (length == 1) {
+                out.append(char(indices.at(i)));
+            } else {
+                out.append(char(indices.at(i) | 128));
+                appendRunLength(&out, length);
+            }
+            i += length;
+        }
+    } else {
+        out.reserve(1 + plainRleSize);
+        out.append(char(128));
+        qsizetype i = 0;
+        for (int length : runs) {
+            appendCPixel(pixels.at(i));
+            appendRunLength(&out, length);
+            i += length;
+        }
+    }
+    return out;
+}
+
 #if QT_CONFIG(cursor)
 QVncClientCursor::QVncClientCursor()
 {
@@ -45,8 +45,11 @@
 #include <QtCore/QLoggingCategory>
 #include <QtCore/qbytearray.h>
 #include <QtCore/qvarlengtharray.h>
+#include <QtCore/qsemaphore.h>
 #include <qpa/qplatformcursor.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(lcVnc)
@@ -206,6 +209,8 @@ public:
     virtual ~QRfbEncoder() {}
 
     virtual void write() = 0;
+    // true while an update is being encoded in the background
+    virtual bool isBusy() const { return false; }
 
 protected:
     QVncClient *client;
@@ -222,6 +227,32 @@ private:
     QByteArray buffer;
 };
 
+struct QRfbZlibStream;
+
+class QRfbZrleEncoder : public QRfbEncoder
+{
+public:
+    QRfbZrleEncoder(QVncClient *s);
+    ~QRfbZrleEncoder();
+
+    void write() override;
+    bool isBusy() const override { return busy; }
+
+private:
+    QByteArray encode(const QRegion &region, bool useCopyRect);
+    QByteArray encodeTile(const QRect &tile) const;
+    QRect findScrolledRect(const QRegion &region, QPoint *source) const;
+
+    std::unique_ptr<QRfbZlibStream> stream;
+    QImage frame; // the dirty areas of the screen, copied when an update starts
+    QImage clientFrame; // what the client shows once the last update is applied
+    int bytesPerPixel = 0;
+    int cpixelOffset = 0;
+    int cpixelSize = 0;
+    bool busy = false;
+    QSemaphore done;
+};
+
 template <class SRC> class QRfbHextileEncoder;
 
 template <class SRC>
@@ -63,7 +63,9 @@ QVncClient::QVncClient(QTcpSocket *clientSocket, QVncServer *server)
     , m_handleMsg(false)
     , m_encodingsPending(0)
     , m_cutTextPending(0)
+    , m_supportCopyRect(false)
     , m_supportHextile(false)
+    , m_supportZRLE(false)
     , m_wantUpdate(false)
     , m_dirtyCursor(false)
     , m_updatePending(false)
@@ -71,6 +73,7 @@ QVncClient::QVncClient(QTcpSocket *clientSocket, QVncServer *server)
 {
     connect(m_clientSocket,SIGNAL(readyRead()),this,SLOT(readClient()));
     connect(m_clientSocket,SIGNAL(disconnected()),this,SLOT(discardClient()));
+    connect(m_clientSocket,SIGNAL(bytesWritten(qint64)),this,SLOT(scheduleUpdate()));
 
     // send protocol version
     const char *proto = "RFB 003.003\n";
@@ -377,6 +380,12 @@ void QVncClient::readClient()
                     m_handleMsg = true;
                 }
                 if (m_handleMsg) {
+                    // the update being encoded must use the format and
+                    // encoder it was started with; resumed in encodingFinished()
+                    if ((m_msgType == SetPixelFormat || m_msgType == SetEncodings)
+                        && m_encoder && m_encoder->isBusy()) {
+                        break;
+                    }
                     switch (m_msgType ) {
                     case SetPixelFormat:
                         setPixelFormat();
@@ -418,10 +427,19 @@ void QVncClient::discardClient()
     m_server->discardClient(this);
 }
 
+// Updates are not started while this much of the previous ones is still
+// waiting to be sent, so that a slow link gets fewer, more recent frames
+// instead of a growing backlog.
+static const qint64 MaxPendingUpdateBytes = 2 * 1024 * 1024;
+
 void QVncClient::checkUpdate()
 {
     if (!m_wantUpdate)
         return;
+    if (m_encoder && m_encoder->isBusy())
+        return;
+    if (m_clientSocket->bytesToWrite() > MaxPendingUpdateBytes)
+        return; // rescheduled from bytesWritten()
 #if QT_CONFIG(cursor)
     if (m_dirtyCursor) {
         m_server->screen()->clientCursor->write(this);
@@ -438,6 +456,16 @@ void QVncClient::checkUpdate()
     }
 }
 
+void QVncClient::encodingFinished(const QByteArray &update)
+{
+    m_clientSocket->write(update);
+    m_clientSocket->flush();
+    // handle messages that were held back while encoding
+    if (m_handleMsg || m_clientSocket->bytesAvailable())
+        readClient();
+    scheduleUpdate();
+}
+
 void QVncClient::scheduleUpdate()
 {
     if (!m_updatePending) {
@@ -542,6 +570,10 @@ void QVncClient::setEncodings()
                 break;
             case ZRLE:
                 m_supportZRLE = true;
+                if (!m_encoder) {
+                    m_encoder = new QRfbZrleEncoder(this);
+                    qCDebug(lcVnc, "QVncServer::setEncodings: using ZRLE");
+                }
                 break;
             case Cursor:
                 m_supportCursor = true;
@@ -79,6 +79,10 @@ public:
 
     void convertPixels(char *dst, const char *src, int count, int depth) const;
     inline bool doPixelConversion() const { return m_needConversion; }
+    const QRfbPixelFormat &pixelFormat() const { return m_pixelFormat; }
+    bool supportsCopyRect() const { return m_supportCopyRect; }
+
+    void encodingFinished(const QByteArray &update);
 
 signals:
 
@@ -46,6 +46,7 @@
 
 #include <private/qguiapplication_p.h>
 #include <QElapsedTimer>
+#include <QUrl>
 
 #include <QtCore/QDebug>
 
@@ -220,6 +221,158 @@ void QXcbClipboardTransaction::timerEvent(QTimerEvent *ev)
     }
 }
 
+#if QT_CONFIG(future)
+QXcbClipboardRequest::QXcbClipboardRequest(QXcbClipboard *clipboard, xcb_atom_t selection,
+                                           const QString &format)
+    : m_clipboard(clipboard), m_window(clipboard->createRequestorWindow()),
+      m_selection(selection), m_format(format)
+{
+    m_promise.start();
+    m_abortTimerId = startTimer(m_clipboard->clipboardTimeout());
+
+    // ask for the offered targets first, so that only the data in the
+    // best matching format is transferred
+    convert(m_clipboard->atom(QXcbAtom::TARGETS));
+}
+
+QXcbClipboardRequest::~QXcbClipboardRequest()
+{
+    if (m_abortTimerId)
+        killTimer(m_abortTimerId);
+    m_abortTimerId = 0;
+    m_clipboard->removeRequest(m_window);
+    xcb_destroy_window(m_clipboard->xcb_connection(), m_window);
+}
+
+void QXcbClipboardRequest::convert(xcb_atom_t target)
+{
+    const xcb_atom_t property = m_clipboard->atom(QXcbAtom::_QT_SELECTION);
+    xcb_delete_property(m_clipboard->xcb_connection(), m_window, property);
+    xcb_convert_selection(m_clipboard->xcb_connection(), m_window, m_selection, target, property,
+                          m_clipboard->connection()->time());
+    m_clipboard->connection()->flush();
+}
+
+void QXcbClipboardRequest::handleSelectionNotify(const xcb_selection_notify_event_t *event)
+{
+    if (event->property == XCB_NONE || m_incremental) {
+        finish();
+        return;
+    }
+
+    QByteArray buffer;
+    xcb_atom_t type;
+    if (!m_clipboard->clipboardReadProperty(m_window, event->property, true, &buffer,
+                                            nullptr, &type, nullptr)) {
+        finish();
+        return;
+    }
+
+    if (type == m_clipboard->atom(QXcbAtom::INCR)) {
+        // deleting the property told the owner to start sending the chunks
+        const int nbytes = buffer.size() >= 4 ? *reinterpret_cast<const int *>(buffer.constData()) : 0;
+        qCDebug(lcQpaClipboard, "receiving %d bytes incrementally, request: %p", nbytes, this);
+        m_incremental = true;
+        m_data.clear();
+        if (nbytes > 0)
+            m_data.reserve(nbytes);
+        killTimer(m_abortTimerId);
+        m_abortTimerId = startTimer(m_clipboard->clipboardTimeout());
+        return;
+    }
+
+    received(buffer);
+}
+
+void QXcbClipboardRequest::handlePropertyNotify(const xcb_property_notify_event_t *event)
+{
+    if (!m_incremental || event->atom != m_clipboard->atom(QXcbAtom::_QT_SELECTION)
+            || event->state != XCB_PROPERTY_NEW_VALUE)
+        return;
+
+    // restart the timer
+    killTimer(m_abortTimerId);
+    m_abortTimerId = startTimer(m_clipboard->clipboardTimeout());
+
+    QByteArray chunk;
+    int length = 0;
+    if (!m_clipboard->clipboardReadProperty(m_window, event->atom, true, &chunk, &length,
+                                            nullptr, nullptr))
+        return;
+
+    if (length == 0) { // no more data, we're done
+        m_incremental = false;
+        received(std::exchange(m_data, QByteArray()));
+    } else {
+        m_data.append(chunk.constData(), length);
+    }
+}
+
+static QByteArray clipboardVariantToByteArray(const QVariant &value)
+{
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        return value.toString().toUtf8();
+    case QMetaType::QUrl:
+        return value.toUrl().toEncoded() + "\r\n";
+    case QMetaType::QVariantList: {
+        QByteArray result;
+        for (const QVariant &url : value.toList())
+            result += url.toUrl().toEncoded() + "\r\n";
+        return result;
+    }
+    default:
+        return value.toByteArray();
+    }
+}
+
+void QXcbClipboardRequest::received(const QByteArray &data)
+{
+    if (m_promise.isCanceled()) {
+        finish();
+        return;
+    }
+
+    QXcbConnection *connection = m_clipboard->connection();
+    const QMetaType byteArrayType(QMetaType::QByteArray);
+    if (m_target == XCB_NONE) {
+        QList<xcb_atom_t> atoms(data.size() / sizeof(xcb_atom_t));
+        memcpy(atoms.data(), data.constData(), atoms.size() * sizeof(xcb_atom_t));
+        m_target = QXcbMime::mimeAtomForFormat(connection, m_format, byteArrayType, atoms, &m_hasUtf8);
+        if (m_target == XCB_NONE)
+            finish();
+        else
+            convert(m_target);
+        return;
+    }
+
+    finish(clipboardVariantToByteArray(QXcbMime::mimeConvertToFormat(connection, m_target, data, m_format,
+                                                                     byteArrayType, m_hasUtf8)));
+}
+
+void QXcbClipboardRequest::finish(const QByteArray &data)
+{
+    // ignore whatever the owner still sends until we are deleted
+    m_clipboard->removeRequest(m_window);
+
+    qCDebug(lcQpaClipboard, "request %p completed with %lld bytes", this, qlonglong(data.size()));
+    m_promise.addResult(data);
+    m_promise.finish();
+    deleteLater();
+}
+
+void QXcbClipboardRequest::timerEvent(QTimerEvent *ev)
+{
+    if (ev->timerId() == m_abortTimerId) {
+        // the selection owner does not answer, or exited while sending
+        qCDebug(lcQpaClipboard, "timed out while receiving data for %p", this);
+        killTimer(m_abortTimerId);
+        m_abortTimerId = 0;
+        finish();
+    }
+}
+#endif // QT_CONFIG(future)
+
 const int QXcbClipboard::clipboard_timeout = 5000;
 
 QXcbClipboard::QXcbClipboard(QXcbConnection *c)
@@ -249,6 +402,10 @@ QXcbClipboard::QXcbClipboard(QXcbConnection *c)
 QXcbClipboard::~QXcbClipboard()
 {
     m_clipboard_closing = true;
+#if QT_CONFIG(future)
+    // the requests remove themselves from m_requests
+    qDeleteAll(QList<QXcbClipboardRequest *>(m_requests.cbegin(), m_requests.cend()));
+#endif
     // Transfer the clipboard content to the clipboard manager if we own a selection
     if (m_timestamp[QClipboard::Clipboard] != XCB_CURRENT_TIME ||
             m_timestamp[QClipboard::Selection] != XCB_CURRENT_TIME) {
@@ -281,10 +438,20 @@ QXcbClipboard::~QXcbClipboard()
 
 bool QXcbClipboard::handlePropertyNotify(const xcb_generic_event_t *event)
 {
-    if (m_transactions.isEmpty() || event->response_type != XCB_PROPERTY_NOTIFY)
+    if (event->response_type != XCB_PROPERTY_NOTIFY)
         return false;
 
     auto propertyNotify = reinterpret_cast<const xcb_property_notify_event_t *>(event);
+#if QT_CONFIG(future)
+    if (QXcbClipboardRequest *request = m_requests.value(propertyNotify->window)) {
+        request->handlePropertyNotify(propertyNotify);
+        return true;
+    }
+#endif
+
+    if (m_transactions.isEmpty())
+        return false;
+
     TransactionMap::Iterator it = m_transactions.find(propertyNotify->window);
     if (it == m_transactions.constEnd())
         return false;
@@ -292,6 +459,20 @@ bool QXcbClipboard::handlePropertyNotify(const xcb_generic_event_t *event)
     return (*it)->updateIncrementalProperty(propertyNotify);
 }
 
+bool QXcbClipboard::handleSelectionNotify(const xcb_generic_event_t *event)
+{
+#if QT_CONFIG(future)
+    auto selectionNotify = reinterpret_cast<const xcb_selection_notify_event_t *>(event);
+    if (QXcbClipboardRequest *request = m_requests.value(selectionNotify->requestor)) {
+        request->handleSelectionNotify(selectionNotify);
+        return true;
+    }
+#else
+    Q_UNUSED(event);
+#endif
+    return false;
+}
+
 xcb_atom_t QXcbClipboard::atomForMode(QClipboard::Mode mode) const
 {
     if (mode == QClipboard::Clipboard)
@@ -350,6 +531,7 @@ void QXcbClipboard::setMimeData(QMimeData *data, QClipboard::Mode mode)
     xcb_window_t newOwner = XCB_NONE;
 
     if (m_clientClipboard[mode]) {
+        clearSentData(m_clientClipboard[mode]);
         if (m_clientClipboard[QClipboard::Clipboard] != m_clientClipboard[QClipboard::Selection])
             delete m_clientClipboard[mode];
         m_clientClipboard[mode] = nullptr;
@@ -375,6 +557,30 @@ void QXcbClipboard::setMimeData(QMimeData *data, QClipboard::Mode mode)
     emitChanged(mode);
 }
 
+#if QT_CONFIG(future)
+QFuture<QByteArray> QXcbClipboard::fetchData(const QString &mimeType, QClipboard::Mode mode)
+{
+    if (mode > QClipboard::Selection || mimeType.isEmpty())
+        return QtFuture::makeReadyFuture(QByteArray());
+
+    const xcb_atom_t modeAtom = atomForMode(mode);
+    const xcb_window_t owner = connection()->selectionOwner(modeAtom);
+    if (owner == connection()->qtSelectionOwner()) {
+        const QMimeData *data = m_clientClipboard[mode];
+        return QtFuture::makeReadyFuture(data ? QInternalMimeData::renderDataHelper(mimeType, data)
+                                              : QByteArray());
+    }
+    if (owner == XCB_NONE || !screen())
+        return QtFuture::makeReadyFuture(QByteArray());
+
+    // each request uses its own window, so that it can run next to
+    // other requests and the blocking transfers done by mimeData()
+    auto request = new QXcbClipboardRequest(this, modeAtom, mimeType);
+    m_requests.insert(request->window(), request);
+    return request->future();
+}
+#endif
+
 bool QXcbClipboard::supportsMode(QClipboard::Mode mode) const
 {
     if (mode <= QClipboard::Selection)
@@ -400,35 +606,41 @@ QXcbScreen *QXcbClipboard::screen() const
 
 xcb_window_t QXcbClipboard::requestor() const
 {
-     QXcbScreen *platformScreen = screen();
-
-    if (!m_requestor && platformScreen) {
-        const int x = 0, y = 0, w = 3, h = 3;
-        QXcbClipboard *that = const_cast<QXcbClipboard *>(this);
-
-        xcb_window_t window = xcb_generate_id(xcb_connection());
-        xcb_create_window(xcb_connection(),
-                          XCB_COPY_FROM_PARENT,                  // depth -- same as root
-                          window,                                // window id
-                          platformScreen->screen()->root,        // parent window id
-                          x, y, w, h,
-                          0,                                     // border width
-                          XCB_WINDOW_CLASS_INPUT_OUTPUT,         // window class
-                          platformScreen->screen()->root_visual, // visual
-                          0,                                     // value mask
-                          nullptr);                              // value list
-
-        QXcbWindow::setWindowTitle(connection(), window,
-                                   QStringLiteral("Qt Clipboard Requestor Window"));
-
-        uint32_t mask = XCB_EVENT_MASK_PROPERTY_CHANGE;
-        xcb_change_window_attributes(xcb_connection(), window, XCB_CW_EVENT_MASK, &mask);
-
-        that->setRequestor(window);
+    if (!m_requestor) {
+        if (xcb_window_t window = createRequestorWindow())
+            const_cast<QXcbClipboard *>(this)->setRequestor(window);
     }
     return m_requestor;
 }
 
+xcb_window_t QXcbClipboard::createRequestorWindow() const
+{
+    QXcbScreen *platformScreen = screen();
+    if (!platformScreen)
+        return XCB_NONE;
+
+    const int x = 0, y = 0, w = 3, h = 3;
+
+    xcb_window_t window = xcb_generate_id(xcb_connection());
+    xcb_create_window(xcb_connection(),
+                      XCB_COPY_FROM_PARENT,                  // depth -- same as root
+                      window,                                // window id
+                      platformScreen->screen()->root,        // parent window id
+                      x, y, w, h,
+                      0,                                     // border width
+                      XCB_WINDOW_CLASS_INPUT_OUTPUT,         // window class
+                      platformScreen->screen()->root_visual, // visual
+                      0,                                     // value mask
+                      nullptr);                              // value list
+
+    QXcbWindow::setWindowTitle(connection(), window,
+                               QStringLiteral("Qt Clipboard Requestor Window"));
+
+    uint32_t mask = XCB_EVENT_MASK_PROPERTY_CHANGE;
+    xcb_change_window_attributes(xcb_connection(), window, XCB_CW_EVENT_MASK, &mask);
+    return window;
+}
+
 void QXcbClipboard::setRequestor(xcb_window_t window)
 {
     if (m_requestor != XCB_NONE) {
@@ -471,7 +683,22 @@ xcb_atom_t QXcbClipboard::sendSelection(QMimeData *d, xcb_atom_t target, xcb_win
     }
 //    qDebug() << "QClipboard: send_selection(): converting to type" << fmt;
 
-    if (QXcbMime::mimeDataForAtom(connection(), target, d, &data, &atomFormat, &dataFormat)) {
+    // converting large images can take long; don't do it again for every requestor
+    bool converted = m_sentData.mimeData == d && m_sentData.target == target;
+    if (!converted) {
+        m_sentData = SentData();
+        converted = QXcbMime::mimeDataForAtom(connection(), target, d, &m_sentData.data,
+                                              &m_sentData.atomFormat, &m_sentData.dataFormat);
+        if (converted) {
+            m_sentData.mimeData = d;
+            m_sentData.target = target;
+        }
+    }
+
+    if (converted) {
+        data = m_sentData.data;
+        atomFormat = m_sentData.atomFormat;
+        dataFormat = m_sentData.dataFormat;
 
          // don't allow INCR transfers when using MULTIPLE or to
         // Motif clients (since Motif doesn't support INCR)
@@ -501,6 +728,12 @@ xcb_atom_t QXcbClipboard::sendSelection(QMimeData *d, xcb_atom_t target, xcb_win
     return property;
 }
 
+void QXcbClipboard::clearSentData(QMimeData *d)
+{
+    if (m_sentData.mimeData == d)
+        m_sentData = SentData();
+}
+
 void QXcbClipboard::handleSelectionClearRequest(xcb_selection_clear_event_t *event)
 {
     QClipboard::Mode mode = modeForAtom(event->selection);
@@ -522,6 +755,7 @@ void QXcbClipboard::handleSelectionClearRequest(xcb_selection_clear_event_t *eve
     as a result of a call to xcb_set_selection_owner in which case we need to delete the local mime data
     */
     if (newOwner != XCB_NONE) {
+        clearSentData(m_clientClipboard[mode]);
         if (m_clientClipboard[QClipboard::Clipboard] != m_clientClipboard[QClipboard::Selection])
             delete m_clientClipboard[mode];
         m_clientClipboard[mode] = nullptr;
@@ -46,6 +46,9 @@
 #include <xcb/xfixes.h>
 
 #include <QtCore/QObject>
+#if QT_CONFIG(future)
+#include <QtCore/qpromise.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -80,6 +83,41 @@ private:
     int m_abortTimerId = 0;
 };
 
+#if QT_CONFIG(future)
+class QXcbClipboardRequest : public QObject
+{
+    Q_OBJECT
+public:
+    QXcbClipboardRequest(QXcbClipboard *clipboard, xcb_atom_t selection, const QString &format);
+    ~QXcbClipboardRequest();
+
+    QFuture<QByteArray> future() { return m_promise.future(); }
+    xcb_window_t window() const { return m_window; }
+
+    void handleSelectionNotify(const xcb_selection_notify_event_t *event);
+    void handlePropertyNotify(const xcb_property_notify_event_t *event);
+
+protected:
+    void timerEvent(QTimerEvent *ev) override;
+
+private:
+    void convert(xcb_atom_t target);
+    void received(const QByteArray &data);
+    void finish(const QByteArray &data = QByteArray());
+
+    QXcbClipboard *m_clipboard;
+    xcb_window_t m_window;
+    xcb_atom_t m_selection;
+    xcb_atom_t m_target = XCB_NONE;
+    QString m_format;
+    bool m_hasUtf8 = false;
+    bool m_incremental = false;
+    QByteArray m_data;
+    QPromise<QByteArray> m_promise;
+    int m_abortTimerId = 0;
+};
+#endif
+
 class QXcbClipboard : public QXcbObject, public QPlatformClipboard
 {
 public:
@@ -91,11 +129,15 @@ public:
 
     bool supportsMode(QClipboard::Mode mode) const override;
     bool ownsMode(QClipboard::Mode mode) const override;
+#if QT_CONFIG(future)
+    QFuture<QByteArray> fetchData(const QString &mimeType, QClipboard::Mode mode) override;
+#endif
 
     QXcbScreen *screen() const;
 
     xcb_window_t requestor() const;
     void setRequestor(xcb_window_t window);
+    xcb_window_t createRequestorWindow() const;
 
     void handleSelectionRequest(xcb_selection_request_event_t *event);
     void handleSelectionClearRequest(xcb_selection_clear_event_t *event);
@@ -107,6 +149,7 @@ public:
     QByteArray getDataInFormat(xcb_atom_t modeAtom, xcb_atom_t fmtatom);
 
     bool handlePropertyNotify(const xcb_generic_event_t *event);
+    bool handleSelectionNotify(const xcb_generic_event_t *event);
 
     QByteArray getSelection(xcb_atom_t selection, xcb_atom_t target, xcb_atom_t property, xcb_timestamp_t t = 0);
 
@@ -114,12 +157,16 @@ public:
     int clipboardTimeout() const { return clipboard_timeout; }
 
     void removeTransaction(xcb_window_t window) { m_transactions.remove(window); }
+#if QT_CONFIG(future)
+    void removeRequest(xcb_window_t window) { m_requests.remove(window); }
+#endif
 
 private:
     xcb_generic_event_t *waitForClipboardEvent(xcb_window_t window, int type, bool checkManager = false);
 
     xcb_atom_t sendTargetsSelection(QMimeData *d, xcb_window_t window, xcb_atom_t property);
     xcb_atom_t sendSelection(QMimeData *d, xcb_atom_t target, xcb_window_t window, xcb_atom_t property);
+    void clearSentData(QMimeData *d);
 
     xcb_atom_t atomForMode(QClipboard::Mode mode) const;
     QClipboard::Mode modeForAtom(xcb_atom_t atom) const;
@@ -139,6 +186,20 @@ private:
 
     using TransactionMap = QMap<xcb_window_t, QXcbClipboardTransaction *>;
     TransactionMap m_transactions;
+
+#if QT_CONFIG(future)
+    QHash<xcb_window_t, QXcbClipboardRequest *> m_requests;
+#endif
+
+    // the last conversion done for a requestor, so that several requestors
+    // asking for the same format do not convert the data again
+    struct SentData {
+        const QMimeData *mimeData = nullptr;
+        xcb_atom_t target = XCB_NONE;
+        QByteArray data;
+        xcb_atom_t atomFormat = XCB_NONE;
+        int dataFormat = 0;
+    } m_sentData;
 };
 
 #endif // QT_NO_CLIPBOARD
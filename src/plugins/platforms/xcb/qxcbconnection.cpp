@@ -707,6 +707,9 @@ void QXcbConnection::handleXcbEvent(xcb_generic_event_t *event)
         break;
     case XCB_SELECTION_NOTIFY:
         setTime((reinterpret_cast<xcb_selection_notify_event_t *>(event))->time);
+#ifndef QT_NO_CLIPBOARD
+        m_clipboard->handleSelectionNotify(event);
+#endif
         break;
     case XCB_PROPERTY_NOTIFY:
     {
@@ -61,6 +61,7 @@
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcQpaXcb, "qt.qpa.xcb")
+Q_LOGGING_CATEGORY(lcQpaXcbRoundTrip, "qt.qpa.xcb.roundtrip")
 
 #if QT_CONFIG(xcb_xlib)
 static const char * const xcbConnectionErrors[] = {
@@ -139,6 +140,11 @@ QXcbBasicConnection::QXcbBasicConnection(const char *displayName)
     for (xcb_extension_t **ext_it = extensions; *ext_it; ++ext_it)
         xcb_prefetch_extension_data (m_xcbConnection, *ext_it);
 
+    // Send the version queries of all extensions before waiting for any of the
+    // replies, so that connecting costs one round-trip rather than one per
+    // extension, which is noticeable over remote X connections.
+    queryExtensionVersions();
+
     initializeXSync();
     if (!qEnvironmentVariableIsSet("QT_XCB_NO_MITSHM"))
         initializeShm();
@@ -150,6 +156,7 @@ QXcbBasicConnection::QXcbBasicConnection(const char *displayName)
         initializeXInput2();
     initializeXShape();
     initializeXKB();
+    discardExtensionVersions();
 }
 
 QXcbBasicConnection::~QXcbBasicConnection()
@@ -245,6 +252,57 @@ bool QXcbBasicConnection::isXkbType(uint responseType) const
     return m_hasXkb && responseType == m_xkbFirstEvent;
 }
 
+static bool isExtensionPresent(xcb_connection_t *connection, xcb_extension_t *extension)
+{
+    const xcb_query_extension_reply_t *reply = xcb_get_extension_data(connection, extension);
+    return reply && reply->present;
+}
+
+template <typename Cookie>
+static Cookie takeVersionQuery(unsigned int &sequence)
+{
+    Q_ASSERT(sequence);
+    Cookie cookie = { sequence };
+    sequence = 0;
+    return cookie;
+}
+
+void QXcbBasicConnection::queryExtensionVersions()
+{
+    xcb_connection_t *c = m_xcbConnection;
+    if (isExtensionPresent(c, &xcb_shm_id))
+        m_versionQueries.shm = xcb_shm_query_version(c).sequence;
+    if (isExtensionPresent(c, &xcb_xfixes_id))
+        m_versionQueries.xfixes = xcb_xfixes_query_version(c, XCB_XFIXES_MAJOR_VERSION,
+                                                           XCB_XFIXES_MINOR_VERSION).sequence;
+    if (isExtensionPresent(c, &xcb_render_id))
+        m_versionQueries.xrender = xcb_render_query_version(c, XCB_RENDER_MAJOR_VERSION,
+                                                            XCB_RENDER_MINOR_VERSION).sequence;
+    if (isExtensionPresent(c, &xcb_randr_id))
+        m_versionQueries.xrandr = xcb_randr_query_version(c, XCB_RANDR_MAJOR_VERSION,
+                                                          XCB_RANDR_MINOR_VERSION).sequence;
+    // depending on whether bundled xcb is used we may support different XCB protocol versions.
+    if (isExtensionPresent(c, &xcb_input_id))
+        m_versionQueries.xinput = xcb_input_xi_query_version(c, 2, XCB_INPUT_MINOR_VERSION).sequence;
+    if (isExtensionPresent(c, &xcb_shape_id))
+        m_versionQueries.shape = xcb_shape_query_version(c).sequence;
+    if (isExtensionPresent(c, &xcb_xkb_id))
+        m_versionQueries.xkb = xcb_xkb_use_extension(c, 1, 0).sequence;
+}
+
+void QXcbBasicConnection::discardExtensionVersions()
+{
+    // replies for extensions that were disabled from the environment
+    for (unsigned int *sequence : { &m_versionQueries.shm, &m_versionQueries.xfixes,
+                                    &m_versionQueries.xrender, &m_versionQueries.xrandr,
+                                    &m_versionQueries.xinput, &m_versionQueries.shape,
+                                    &m_versionQueries.xkb }) {
+        if (*sequence)
+            xcb_discard_reply(m_xcbConnection, *sequence);
+        *sequence = 0;
+    }
+}
+
 void QXcbBasicConnection::initializeXSync()
 {
     const xcb_query_extension_reply_t *reply = xcb_get_extension_data(m_xcbConnection, &xcb_sync_id);
@@ -262,7 +320,8 @@ void QXcbBasicConnection::initializeShm()
         return;
     }
 
-    auto shmQuery = Q_XCB_REPLY(xcb_shm_query_version, m_xcbConnection);
+    auto shmQuery = Q_XCB_COOKIE_REPLY(xcb_shm_query_version, m_xcbConnection,
+        takeVersionQuery<xcb_shm_query_version_cookie_t>(m_versionQueries.shm));
     if (!shmQuery) {
         qCWarning(lcQpaXcb, "failed to request MIT-SHM version");
         return;
@@ -297,9 +356,8 @@ void QXcbBasicConnection::initializeXRender()
         return;
     }
 
-    auto xrenderQuery = Q_XCB_REPLY(xcb_render_query_version, m_xcbConnection,
-                                     XCB_RENDER_MAJOR_VERSION,
-                                     XCB_RENDER_MINOR_VERSION);
+    auto xrenderQuery = Q_XCB_COOKIE_REPLY(xcb_render_query_version, m_xcbConnection,
+        takeVersionQuery<xcb_render_query_version_cookie_t>(m_versionQueries.xrender));
     if (!xrenderQuery) {
         qCWarning(lcQpaXcb, "xcb_render_query_version failed");
         return;
@@ -316,9 +374,8 @@ void QXcbBasicConnection::initializeXFixes()
     if (!reply || !reply->present)
         return;
 
-    auto xfixesQuery = Q_XCB_REPLY(xcb_xfixes_query_version, m_xcbConnection,
-                                    XCB_XFIXES_MAJOR_VERSION,
-                                    XCB_XFIXES_MINOR_VERSION);
+    auto xfixesQuery = Q_XCB_COOKIE_REPLY(xcb_xfixes_query_version, m_xcbConnection,
+        takeVersionQuery<xcb_xfixes_query_version_cookie_t>(m_versionQueries.xfixes));
     if (!xfixesQuery || xfixesQuery->major_version < 2) {
         qCWarning(lcQpaXcb, "failed to initialize XFixes");
         return;
@@ -334,9 +391,8 @@ void QXcbBasicConnection::initializeXRandr()
     if (!reply || !reply->present)
         return;
 
-    auto xrandrQuery = Q_XCB_REPLY(xcb_randr_query_version, m_xcbConnection,
-                                    XCB_RANDR_MAJOR_VERSION,
-                                    XCB_RANDR_MINOR_VERSION);
+    auto xrandrQuery = Q_XCB_COOKIE_REPLY(xcb_randr_query_version, m_xcbConnection,
+        takeVersionQuery<xcb_randr_query_version_cookie_t>(m_versionQueries.xrandr));
     if (!xrandrQuery || (xrandrQuery->major_version < 1 ||
                         (xrandrQuery->major_version == 1 && xrandrQuery->minor_version < 2))) {
         qCWarning(lcQpaXcb, "failed to initialize XRandr 1.2");
@@ -358,9 +414,8 @@ void QXcbBasicConnection::initializeXInput2()
         return;
     }
 
-    // depending on whether bundled xcb is used we may support different XCB protocol versions.
-    auto xinputQuery = Q_XCB_REPLY(xcb_input_xi_query_version, m_xcbConnection,
-                                   2, XCB_INPUT_MINOR_VERSION);
+    auto xinputQuery = Q_XCB_COOKIE_REPLY(xcb_input_xi_query_version, m_xcbConnection,
+        takeVersionQuery<xcb_input_xi_query_version_cookie_t>(m_versionQueries.xinput));
     if (!xinputQuery || xinputQuery->major_version != 2) {
         qCWarning(lcQpaXcb, "X server does not support XInput 2");
         return;
@@ -383,7 +438,8 @@ void QXcbBasicConnection::initializeXShape()
 
     m_hasXhape = true;
 
-    auto shapeQuery = Q_XCB_REPLY(xcb_shape_query_version, m_xcbConnection);
+    auto shapeQuery = Q_XCB_COOKIE_REPLY(xcb_shape_query_version, m_xcbConnection,
+        takeVersionQuery<xcb_shape_query_version_cookie_t>(m_versionQueries.shape));
     if (!shapeQuery) {
         qCWarning(lcQpaXcb, "failed to initialize XShape extension");
         return;
@@ -403,9 +459,11 @@ void QXcbBasicConnection::initializeXKB()
         return;
     }
 
+    // the version requested by queryExtensionVersions()
     int wantMajor = 1;
     int wantMinor = 0;
-    auto xkbQuery = Q_XCB_REPLY(xcb_xkb_use_extension, m_xcbConnection, wantMajor, wantMinor);
+    auto xkbQuery = Q_XCB_COOKIE_REPLY(xcb_xkb_use_extension, m_xcbConnection,
+        takeVersionQuery<xcb_xkb_use_extension_cookie_t>(m_versionQueries.xkb));
     if (!xkbQuery) {
         qCWarning(lcQpaXcb, "failed to initialize XKeyboard extension");
         return;
@@ -45,6 +45,7 @@
 #include <QtCore/QPair>
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
 #include <QtGui/private/qtguiglobal_p.h>
 
@@ -55,6 +56,7 @@
 QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(lcQpaXcb)
+Q_DECLARE_LOGGING_CATEGORY(lcQpaXcbRoundTrip)
 
 class Q_XCB_EXPORT QXcbBasicConnection : public QObject
 {
@@ -112,6 +114,8 @@ public:
     bool isXkbType(uint responseType) const; // https://bugs.freedesktop.org/show_bug.cgi?id=51295
 
 protected:
+    void queryExtensionVersions();
+    void discardExtensionVersions();
     void initializeShm();
     void initializeXFixes();
     void initializeXRender();
@@ -155,6 +159,17 @@ private:
     uint32_t m_xkbFirstEvent = 0;
 
     uint32_t m_maximumRequestLength = 0;
+
+    // sequence numbers of the version queries sent by queryExtensionVersions()
+    struct {
+        unsigned int shm = 0;
+        unsigned int xfixes = 0;
+        unsigned int xrender = 0;
+        unsigned int xrandr = 0;
+        unsigned int xinput = 0;
+        unsigned int shape = 0;
+        unsigned int xkb = 0;
+    } m_versionQueries;
 };
 
 #define Q_XCB_REPLY_CONNECTION_ARG(connection, ...) connection
@@ -163,15 +178,34 @@ struct QStdFreeDeleter {
     void operator()(void *p) const noexcept { return std::free(p); }
 };
 
-#define Q_XCB_REPLY(call, ...) \
+// Waits for the reply to an already sent request. With the qt.qpa.xcb.roundtrip
+// logging category enabled, reports how long the wait took, which makes
+// requests that could be pipelined visible on high-latency connections.
+template <typename Reply, typename Cookie>
+inline Reply *qXcbWaitForReply(Reply *(*replyFunction)(xcb_connection_t *, Cookie, xcb_generic_error_t **),
+                               xcb_connection_t *connection, Cookie cookie, const char *request)
+{
+    if (Q_LIKELY(!lcQpaXcbRoundTrip().isDebugEnabled()))
+        return replyFunction(connection, cookie, nullptr);
+
+    QElapsedTimer timer;
+    timer.start();
+    Reply *reply = replyFunction(connection, cookie, nullptr);
+    qCDebug(lcQpaXcbRoundTrip, "%s: waited %.3f ms for the reply",
+            request, timer.nsecsElapsed() / 1000000.0);
+    return reply;
+}
+
+#define Q_XCB_COOKIE_REPLY(call, connection, cookie) \
     std::unique_ptr<call##_reply_t, QStdFreeDeleter>( \
-        call##_reply(Q_XCB_REPLY_CONNECTION_ARG(__VA_ARGS__), call(__VA_ARGS__), nullptr) \
+        qXcbWaitForReply(call##_reply, connection, cookie, #call) \
     )
 
+#define Q_XCB_REPLY(call, ...) \
+    Q_XCB_COOKIE_REPLY(call, Q_XCB_REPLY_CONNECTION_ARG(__VA_ARGS__), call(__VA_ARGS__))
+
 #define Q_XCB_REPLY_UNCHECKED(call, ...) \
-    std::unique_ptr<call##_reply_t, QStdFreeDeleter>( \
-        call##_reply(Q_XCB_REPLY_CONNECTION_ARG(__VA_ARGS__), call##_unchecked(__VA_ARGS__), nullptr) \
-    )
+    Q_XCB_COOKIE_REPLY(call, Q_XCB_REPLY_CONNECTION_ARG(__VA_ARGS__), call##_unchecked(__VA_ARGS__))
 
 QT_END_NAMESPACE
 
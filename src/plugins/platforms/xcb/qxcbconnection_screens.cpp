@@ -43,6 +43,7 @@
 #include <QtGui/private/qhighdpiscaling_p.h>
 #include <QtCore/QString>
 #include <QtCore/QList>
+#include <QtCore/QVarLengthArray>
 
 #include <qpa/qwindowsysteminterface.h>
 
@@ -423,13 +424,23 @@ void QXcbConnection::initializeScreensFromOutput(xcb_screen_iterator_t *it, int
             }
 
             if (outputCount) {
-                auto primary = Q_XCB_REPLY(xcb_randr_get_output_primary, xcb_connection(), xcbScreen->root);
+                // Queue the queries for all outputs before waiting for any of
+                // the replies, to need one round-trip to the X server instead
+                // of one per output.
+                auto primaryCookie = xcb_randr_get_output_primary(xcb_connection(), xcbScreen->root);
+                QVarLengthArray<xcb_randr_get_output_info_cookie_t, 8> outputCookies(outputCount);
+                for (int i = 0; i < outputCount; i++)
+                    outputCookies[i] = xcb_randr_get_output_info_unchecked(xcb_connection(), outputs[i], timestamp);
+
+                auto primary = Q_XCB_COOKIE_REPLY(xcb_randr_get_output_primary, xcb_connection(), primaryCookie);
                 if (!primary) {
                     qWarning("failed to get the primary output of the screen");
+                    for (const auto &cookie : qAsConst(outputCookies))
+                        xcb_discard_reply(xcb_connection(), cookie.sequence);
                 } else {
                     for (int i = 0; i < outputCount; i++) {
-                        auto output = Q_XCB_REPLY_UNCHECKED(xcb_randr_get_output_info,
-                                                            xcb_connection(), outputs[i], timestamp);
+                        auto output = Q_XCB_COOKIE_REPLY(xcb_randr_get_output_info,
+                                                         xcb_connection(), outputCookies[i]);
                         // Invalid, disconnected or disabled output
                         if (!output)
                             continue;
@@ -166,6 +166,7 @@ protected:
 
     bool prepare(const QString &stmt) override;
     bool exec() override;
+    bool execBatch(bool arrayBind = false) override;
 };
 
 class QMYSQLResultPrivate: public QSqlResultPrivate
@@ -1062,6 +1063,33 @@ bool QMYSQLResult::exec()
     return true;
 }
 
+bool QMYSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QMYSQLResult);
+    if (!driver())
+        return false;
+
+    // With autocommit enabled every row is committed (and flushed by InnoDB)
+    // on its own. Group the rows into one transaction; it is committed even
+    // if a row fails, so that the preceding rows are kept as before.
+    MYSQL *mysql = d->drv_d_func()->mysql;
+    const bool ownTransaction = (mysql->server_status & SERVER_STATUS_AUTOCOMMIT)
+            && !(mysql->server_status & SERVER_STATUS_IN_TRANS)
+            && mysql_query(mysql, "START TRANSACTION") == 0;
+
+    bool ok = QSqlResult::execBatch(arrayBind);
+
+    if (ownTransaction && mysql_query(mysql, "COMMIT") != 0) {
+        if (ok) {
+            setLastError(qMakeError(QCoreApplication::translate("QMYSQLResult",
+                         "Unable to execute query"), QSqlError::StatementError, d->drv_d_func()));
+            ok = false;
+        }
+        mysql_query(mysql, "ROLLBACK");
+    }
+    return ok;
+}
+
 /////////////////////////////////////////////////////////
 
 static int qMySqlConnectionCount = 0;
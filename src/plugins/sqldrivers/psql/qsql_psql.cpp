@@ -111,9 +111,25 @@ inline void qPQfreemem(void *buffer)
 static const int PGRES_SINGLE_TUPLE = 9;
 #endif
 
+// Number of rows per result in chunked mode (libpq 17 and later)
+static const int FetchChunkSize = 1000;
+
+// Whether a result is a part of a result set fetched in single-row or chunked mode
+static inline bool qIsRowChunk(int status)
+{
+#if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 170000
+    if (status == PGRES_TUPLES_CHUNK)
+        return true;
+#endif
+    return status == PGRES_SINGLE_TUPLE;
+}
+
 typedef int StatementId;
 static const StatementId InvalidStatementId = 0;
 
+// Upper bound for the length of the multi-statement queries sent by execBatch()
+static const int MaxBatchQueryLength = 1024 * 1024;
+
 class QPSQLResultPrivate;
 
 class QPSQLResult final : public QSqlResult
@@ -143,6 +159,7 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind = false) override;
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -227,8 +244,13 @@ bool QPSQLDriverPrivate::setSingleRowMode() const
 {
     // Activates single-row mode for last sent query, see:
     // https://www.postgresql.org/docs/9.2/static/libpq-single-row-mode.html
+    // With libpq 17 and later, rows are fetched in chunks instead, which
+    // saves allocating a PGresult per row, see:
+    // https://www.postgresql.org/docs/17/libpq-single-row-mode.html
     // This method should be called immediately after the sendQuery() call.
-#if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 90200
+#if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 170000
+    return PQsetChunkedRowsMode(connection, FetchChunkSize) > 0;
+#elif defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 90200
     return PQsetSingleRowMode(connection) > 0;
 #else
     return false;
@@ -298,6 +320,7 @@ public:
     PGresult *result = nullptr;
     StatementId stmtId = InvalidStatementId;
     int currentSize = -1;
+    int chunkRow = 0; // row of the current chunk in forward-only mode
     bool canFetchMoreRows = false;
     bool preparedQueriesEnabled = false;
 
@@ -338,12 +361,17 @@ bool QPSQLResultPrivate::processResults()
         q->setSelect(true);
         q->setActive(true);
         currentSize = q->isForwardOnly() ? -1 : PQntuples(result);
+        chunkRow = 0;
         canFetchMoreRows = false;
         return true;
     case PGRES_SINGLE_TUPLE:
+#if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 170000
+    case PGRES_TUPLES_CHUNK:
+#endif
         q->setSelect(true);
         q->setActive(true);
         currentSize = -1;
+        chunkRow = 0;
         canFetchMoreRows = true;
         return true;
     case PGRES_COMMAND_OK:
@@ -462,6 +490,7 @@ void QPSQLResult::cleanup()
     d->stmtId = InvalidStatementId;
     setAt(QSql::BeforeFirstRow);
     d->currentSize = -1;
+    d->chunkRow = 0;
     d->canFetchMoreRows = false;
     setActive(false);
 }
@@ -549,6 +578,12 @@ bool QPSQLResult::fetchNext()
         return false;
 
     if (isForwardOnly()) {
+        if (d->chunkRow + 1 < PQntuples(d->result)) {
+            // Next row of the current chunk
+            ++d->chunkRow;
+            setAt(currentRow + 1);
+            return true;
+        }
         if (!d->canFetchMoreRows)
             return false;
         PQclear(d->result);
@@ -559,11 +594,15 @@ bool QPSQLResult::fetchNext()
             d->canFetchMoreRows = false;
             return false;
         }
+        d->chunkRow = 0;
         int status = PQresultStatus(d->result);
         switch (status) {
         case PGRES_SINGLE_TUPLE:
-            // Fetched next row of current result set
-            Q_ASSERT(PQntuples(d->result) == 1);
+#if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 170000
+        case PGRES_TUPLES_CHUNK:
+#endif
+            // Fetched next row(s) of current result set
+            Q_ASSERT(PQntuples(d->result) >= 1);
             Q_ASSERT(d->canFetchMoreRows);
             setAt(currentRow + 1);
             return true;
@@ -597,7 +636,7 @@ bool QPSQLResult::nextResult()
     if (isForwardOnly()) {
         if (d->canFetchMoreRows) {
             // Skip all rows from current result set
-            while (d->result && PQresultStatus(d->result) == PGRES_SINGLE_TUPLE) {
+            while (d->result && qIsRowChunk(PQresultStatus(d->result))) {
                 PQclear(d->result);
                 d->result = d->drv_d_func()->getResult(d->stmtId);
             }
@@ -630,7 +669,7 @@ QVariant QPSQLResult::data(int i)
         qWarning("QPSQLResult::data: column %d out of range", i);
         return QVariant();
     }
-    const int currentRow = isForwardOnly() ? 0 : at();
+    const int currentRow = isForwardOnly() ? d->chunkRow : at();
     int ptype = PQftype(d->result, i);
     QMetaType type = qDecodePSQLType(ptype);
     if (PQgetisnull(d->result, currentRow, i))
@@ -710,7 +749,7 @@ QVariant QPSQLResult::data(int i)
 bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
-    const int currentRow = isForwardOnly() ? 0 : at();
+    const int currentRow = isForwardOnly() ? d->chunkRow : at();
     return PQgetisnull(d->result, currentRow, field);
 }
 
@@ -937,6 +976,60 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QPSQLResult);
+    // Outside of a transaction block every row is committed on its own, and
+    // a failing row must not take the previous ones with it. Inside one, the
+    // first failing row aborts the transaction anyway, so the rows can be sent
+    // as multi-statement queries, saving a round trip per row.
+    if (!d->preparedQueriesEnabled
+        || PQtransactionStatus(d->drv_d_func()->connection) != PQTRANS_INTRANS) {
+        return QSqlResult::execBatch(arrayBind);
+    }
+
+    const QList<QVariant> values = boundValues();
+    if (values.isEmpty())
+        return false;
+
+    QList<QList<QVariant>> columns;
+    columns.reserve(values.size());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+    const qsizetype rowCount = columns.constFirst().size();
+
+    QList<QVariant> row(columns.size());
+    qsizetype i = 0;
+    while (i < rowCount) {
+        cleanup();
+
+        QString stmt;
+        for (; i < rowCount && stmt.size() < MaxBatchQueryLength; ++i) {
+            for (qsizetype j = 0; j < columns.size(); ++j)
+                row[j] = columns.at(j).value(i);
+            stmt += QStringLiteral("EXECUTE %1 (%2);")
+                        .arg(d->preparedStmtId, qCreateParamString(row, driver()));
+        }
+
+        d->stmtId = d->drv_d_func()->sendQuery(stmt);
+        if (d->stmtId == InvalidStatementId) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                    "Unable to send query"), QSqlError::StatementError, d->drv_d_func()));
+            return false;
+        }
+
+        // Keep the result of the last statement, or of the one that failed
+        while (PGresult *result = d->drv_d_func()->getResult(d->stmtId)) {
+            if (d->result)
+                PQclear(d->result);
+            d->result = result;
+        }
+        if (!d->processResults())
+            return false;
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -51,8 +51,8 @@
 #include <QtSql/private/qsqldriver_p.h>
 #include <qstringlist.h>
 #include <qvariant.h>
-#if QT_CONFIG(regularexpression)
 #include <qcache.h>
+#if QT_CONFIG(regularexpression)
 #include <qregularexpression.h>
 #endif
 #include <QScopedValueRollback>
@@ -144,6 +144,16 @@ protected:
     void virtual_hook(int id, void *data) override;
 };
 
+// A prepared statement that is not used by any result, kept for reuse
+struct QSQLiteCachedStatement
+{
+    explicit QSQLiteCachedStatement(sqlite3_stmt *stmt) : stmt(stmt) {}
+    ~QSQLiteCachedStatement() { sqlite3_finalize(stmt); }
+    Q_DISABLE_COPY_MOVE(QSQLiteCachedStatement)
+
+    sqlite3_stmt *stmt;
+};
+
 class QSQLiteDriverPrivate : public QSqlDriverPrivate
 {
     Q_DECLARE_PUBLIC(QSQLiteDriver)
@@ -153,6 +163,8 @@ public:
     sqlite3 *access = nullptr;
     QList<QSQLiteResult *> results;
     QStringList notificationid;
+    // keyed by SQL text, disabled unless QSQLITE_STATEMENT_CACHE_SIZE is set
+    QCache<QString, QSQLiteCachedStatement> statementCache{0};
 };
 
 
@@ -170,6 +182,7 @@ public:
     void finalize();
 
     sqlite3_stmt *stmt = nullptr;
+    QString cacheKey; // SQL text of stmt if it goes back to the statement cache
     QSqlRecord rInf;
     QList<QVariant> firstRow;
     bool skippedStatus = false; // the status of the fetchNext() that's skipped
@@ -193,7 +206,15 @@ void QSQLiteResultPrivate::finalize()
     if (!stmt)
         return;
 
-    sqlite3_finalize(stmt);
+    QSQLiteDriverPrivate *drv = drv_d_func();
+    if (!cacheKey.isEmpty() && drv) {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        drv->statementCache.insert(cacheKey, new QSQLiteCachedStatement(stmt));
+        cacheKey.clear();
+    } else {
+        sqlite3_finalize(stmt);
+    }
     stmt = 0;
 }
 
@@ -387,6 +408,18 @@ bool QSQLiteResult::prepare(const QString &query)
 
     setSelect(false);
 
+    // A cached statement was prepared from the same text before, so it is
+    // known to consist of a single valid statement.
+    QCache<QString, QSQLiteCachedStatement> &cache = d->drv_d_func()->statementCache;
+    if (cache.maxCost() > 0) {
+        if (QSQLiteCachedStatement *cached = cache.take(query)) {
+            d->stmt = std::exchange(cached->stmt, nullptr);
+            delete cached;
+            d->cacheKey = query;
+            return true;
+        }
+    }
+
     const void *pzTail = nullptr;
     const auto size = int((query.size() + 1) * sizeof(QChar));
 
@@ -409,30 +442,56 @@ bool QSQLiteResult::prepare(const QString &query)
         d->finalize();
         return false;
     }
+    if (cache.maxCost() > 0)
+        d->cacheKey = query;
     return true;
 }
 
 bool QSQLiteResult::execBatch(bool arrayBind)
 {
     Q_UNUSED(arrayBind);
-    Q_D(QSqlResult);
+    Q_D(QSQLiteResult);
     QScopedValueRollback<QList<QVariant>> valuesScope(d->values);
     QList<QVariant> values = d->values;
     if (values.count() == 0)
         return false;
 
-    for (int i = 0; i < values.at(0).toList().count(); ++i) {
+    QList<QList<QVariant>> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : std::as_const(values))
+        columns.append(value.toList());
+
+    // Outside of a transaction every statement is committed (and synced to
+    // disk) on its own. Group the rows into one transaction; it is committed
+    // even if a row fails, so that the preceding rows are kept as before.
+    sqlite3 *access = d->drv_d_func()->access;
+    const bool ownTransaction = sqlite3_get_autocommit(access)
+            && sqlite3_exec(access, "BEGIN", nullptr, nullptr, nullptr) == SQLITE_OK;
+
+    bool ok = true;
+    for (int i = 0; ok && i < columns.at(0).count(); ++i) {
         d->values.clear();
         QScopedValueRollback<QHash<QString, QList<int>>> indexesScope(d->indexes);
         auto it = d->indexes.constBegin();
         while (it != d->indexes.constEnd()) {
-            bindValue(it.key(), values.at(it.value().first()).toList().at(i), QSql::In);
+            bindValue(it.key(), columns.at(it.value().first()).at(i), QSql::In);
             ++it;
         }
-        if (!exec())
-            return false;
+        ok = exec();
     }
-    return true;
+
+    if (ownTransaction && !sqlite3_get_autocommit(access)) {
+        const int res = sqlite3_exec(access, "COMMIT", nullptr, nullptr, nullptr);
+        if (res != SQLITE_OK) {
+            if (ok) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to execute statement"), QSqlError::StatementError, res));
+                ok = false;
+            }
+            sqlite3_exec(access, "ROLLBACK", nullptr, nullptr, nullptr);
+        }
+    }
+    return ok;
 }
 
 bool QSQLiteResult::exec()
@@ -715,6 +774,30 @@ bool QSQLiteDriver::hasFeature(DriverFeature f) const
    SQLite dbs have no user name, passwords, hosts or ports.
    just file names.
 */
+// Returns the value of the connect option "name=value", or a null view if
+// option is not called name
+static QStringView qGetOptionValue(QStringView option, QLatin1String name)
+{
+    if (!option.startsWith(name))
+        return QStringView();
+    option = option.mid(name.size()).trimmed();
+    if (!option.startsWith(QLatin1Char('=')))
+        return QStringView();
+    return option.mid(1).trimmed();
+}
+
+// Returns the PRAGMA statement for a journal_mode or synchronous option, or
+// an empty array if value is not one of the keywords
+static QByteArray qPragmaKeyword(const char *pragma, QStringView value,
+                                 std::initializer_list<const char *> keywords)
+{
+    for (const char *keyword : keywords) {
+        if (value.compare(QLatin1String(keyword), Qt::CaseInsensitive) == 0)
+            return QByteArray("PRAGMA ") + pragma + '=' + keyword;
+    }
+    return QByteArray();
+}
+
 bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, const QString &, int, const QString &conOpts)
 {
     Q_D(QSQLiteDriver);
@@ -727,6 +810,8 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
     bool openReadOnlyOption = false;
     bool openUriOption = false;
     bool useExtendedResultCodes = true;
+    int statementCacheSize = 0;
+    QList<QByteArray> pragmas;
 #if QT_CONFIG(regularexpression)
     static const QLatin1String regexpConnectOption = QLatin1String("QSQLITE_ENABLE_REGEXP");
     bool defineRegexp = false;
@@ -752,6 +837,38 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
             sharedCache = true;
         } else if (option == QLatin1String("QSQLITE_NO_USE_EXTENDED_RESULT_CODES")) {
             useExtendedResultCodes = false;
+        } else if (option.startsWith(QLatin1String("QSQLITE_STATEMENT_CACHE_SIZE"))) {
+            option = option.mid(28).trimmed();
+            if (option.startsWith(QLatin1Char('='))) {
+                bool ok;
+                const int size = option.mid(1).trimmed().toInt(&ok);
+                if (ok && size >= 0)
+                    statementCacheSize = size;
+            }
+        } else if (auto value = qGetOptionValue(option, QLatin1String("QSQLITE_JOURNAL_MODE"));
+                   !value.isNull()) {
+            const QByteArray pragma = qPragmaKeyword("journal_mode", value,
+                    { "DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF" });
+            if (!pragma.isEmpty())
+                pragmas.append(pragma);
+        } else if (auto value = qGetOptionValue(option, QLatin1String("QSQLITE_SYNCHRONOUS"));
+                   !value.isNull()) {
+            const QByteArray pragma = qPragmaKeyword("synchronous", value,
+                    { "OFF", "NORMAL", "FULL", "EXTRA" });
+            if (!pragma.isEmpty())
+                pragmas.append(pragma);
+        } else if (auto value = qGetOptionValue(option, QLatin1String("QSQLITE_MMAP_SIZE"));
+                   !value.isNull()) {
+            bool ok;
+            const qint64 size = value.toLongLong(&ok);
+            if (ok && size >= 0)
+                pragmas.append("PRAGMA mmap_size=" + QByteArray::number(size));
+        } else if (auto value = qGetOptionValue(option, QLatin1String("QSQLITE_CACHE_SIZE"));
+                   !value.isNull()) {
+            bool ok;
+            const int size = value.toInt(&ok);
+            if (ok)
+                pragmas.append("PRAGMA cache_size=" + QByteArray::number(size));
         }
 #if QT_CONFIG(regularexpression)
         else if (option.startsWith(regexpConnectOption)) {
@@ -780,9 +897,19 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
 
     const int res = sqlite3_open_v2(db.toUtf8().constData(), &d->access, openMode, nullptr);
 
+    int pragmaRes = SQLITE_OK;
     if (res == SQLITE_OK) {
         sqlite3_busy_timeout(d->access, timeOut);
         sqlite3_extended_result_codes(d->access, useExtendedResultCodes);
+        for (const QByteArray &pragma : qAsConst(pragmas)) {
+            pragmaRes = sqlite3_exec(d->access, pragma.constData(), nullptr, nullptr, nullptr);
+            if (pragmaRes != SQLITE_OK)
+                break;
+        }
+    }
+
+    if (res == SQLITE_OK && pragmaRes == SQLITE_OK) {
+        d->statementCache.setMaxCost(statementCacheSize);
         setOpen(true);
         setOpenError(false);
 #if QT_CONFIG(regularexpression)
@@ -796,7 +923,7 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
         return true;
     } else {
         setLastError(qMakeError(d->access, tr("Error opening database"),
-                     QSqlError::ConnectionError, res));
+                     QSqlError::ConnectionError, res != SQLITE_OK ? res : pragmaRes));
         setOpenError(true);
 
         if (d->access) {
@@ -814,6 +941,7 @@ void QSQLiteDriver::close()
     if (isOpen()) {
         for (QSQLiteResult *result : qAsConst(d->results))
             result->d_func()->finalize();
+        d->statementCache.clear();
 
         if (d->access && (d->notificationid.count() > 0)) {
             d->notificationid.clear();
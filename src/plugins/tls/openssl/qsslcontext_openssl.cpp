@@ -55,6 +55,11 @@
 
 #include <QtNetwork/private/qssldiffiehellmanparameters_p.h>
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -99,6 +104,126 @@ static inline QString msgErrorSettingEllipticCurves(const QString &why)
     return QSslSocket::tr("Error when setting the elliptic curves (%1)").arg(why);
 }
 
+namespace {
+
+// Chain verification (signature checks plus on-demand lookups in the hashed
+// CA directories) dominates the CPU cost of a handshake with a peer we have
+// talked to moments ago. Contexts that verify against the same trust
+// settings share a small process-wide cache of chains that verified without
+// any error, keyed by the trust settings, the leaf and the intermediates the
+// peer sent. Host name checks are done by QSslSocket after the handshake and
+// are not affected.
+constexpr int verificationCacheCapacity = 256;
+constexpr qint64 verificationCacheLifetimeMs = 10 * 60 * 1000;
+
+class VerificationCache
+{
+public:
+    bool contains(const QByteArray &key)
+    {
+        const QMutexLocker locker(&mutex);
+        const auto it = entries.find(key);
+        if (it == entries.end())
+            return false;
+        if (it->expiry.hasExpired()) {
+            entries.erase(it);
+            return false;
+        }
+        it->lastUse = ++useCounter;
+        return true;
+    }
+
+    void insert(const QByteArray &key, qint64 lifetimeMs)
+    {
+        const QMutexLocker locker(&mutex);
+        if (entries.size() >= verificationCacheCapacity && !entries.contains(key)) {
+            auto victim = entries.begin();
+            for (auto it = entries.begin(); it != entries.end(); ++it) {
+                if (it->expiry.hasExpired()) {
+                    victim = it;
+                    break;
+                }
+                if (it->lastUse < victim->lastUse)
+                    victim = it;
+            }
+            entries.erase(victim);
+        }
+        entries.insert(key, {QDeadlineTimer(lifetimeMs), ++useCounter});
+    }
+
+private:
+    struct Entry
+    {
+        QDeadlineTimer expiry;
+        quint64 lastUse;
+    };
+
+    QMutex mutex;
+    QHash<QByteArray, Entry> entries;
+    quint64 useCounter = 0;
+};
+
+Q_GLOBAL_STATIC(VerificationCache, verificationCache)
+
+bool addDerToHash(QCryptographicHash &hash, X509 *x509)
+{
+    const int length = q_i2d_X509(x509, nullptr);
+    if (length <= 0)
+        return false;
+    QByteArray der(length, Qt::Uninitialized);
+    unsigned char *data = reinterpret_cast<unsigned char *>(der.data());
+    if (q_i2d_X509(x509, &data) != length)
+        return false;
+    hash.addData(der);
+    return true;
+}
+
+qint64 remainingValidityMs(X509 *x509)
+{
+    tm notAfter;
+    const ASN1_TIME *time = q_X509_getm_notAfter(x509);
+    if (!time || !q_ASN1_TIME_to_tm(time, &notAfter))
+        return 0;
+    const QDateTime expiry(QDate(notAfter.tm_year + 1900, notAfter.tm_mon + 1, notAfter.tm_mday),
+                           QTime(notAfter.tm_hour, notAfter.tm_min, notAfter.tm_sec), Qt::UTC);
+    return QDateTime::currentDateTimeUtc().msecsTo(expiry);
+}
+
+} // unnamed namespace
+
+extern "C" int q_X509VerifyCertCallback(X509_STORE_CTX *ctx, void *arg)
+{
+    const auto *trustKey = static_cast<const QByteArray *>(arg);
+    X509 *leaf = q_X509_STORE_CTX_get0_cert(ctx);
+    auto *cache = verificationCache();
+    if (!trustKey || trustKey->isEmpty() || !leaf || !cache)
+        return q_X509_verify_cert(ctx);
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(*trustKey);
+    bool keyed = addDerToHash(hash, leaf);
+    STACK_OF(X509) *untrusted = q_X509_STORE_CTX_get0_untrusted(ctx);
+    const int count = untrusted ? q_sk_X509_num(untrusted) : 0;
+    for (int i = 0; keyed && i < count; ++i)
+        keyed = addDerToHash(hash, q_sk_X509_value(untrusted, i));
+    if (!keyed)
+        return q_X509_verify_cert(ctx);
+
+    const QByteArray key = hash.result();
+    if (cache->contains(key))
+        return 1;
+
+    const int result = q_X509_verify_cert(ctx);
+    // Our verify callbacks let the handshake continue past errors (QSslSocket
+    // reports them later), so only the error code tells a clean chain apart.
+    if (result == 1 && q_X509_STORE_CTX_get_error(ctx) == X509_V_OK) {
+        const qint64 lifetime = qMin(verificationCacheLifetimeMs, remainingValidityMs(leaf));
+        if (lifetime > 0)
+            cache->insert(key, lifetime);
+    }
+    return result;
+}
+
 long QSslContext::setupOpenSslOptions(QSsl::SslProtocol protocol, QSsl::SslOptions sslOptions)
 {
     long options;
@@ -568,7 +693,9 @@ QT_WARNING_POP
 
     const QDateTime now = QDateTime::currentDateTimeUtc();
 
-    // Add all our CAs to this store.
+    // Add all our CAs to this store, hashing what we add into the key that
+    // identifies these trust settings for the chain verification cache.
+    QCryptographicHash trustHash(QCryptographicHash::Sha256);
     const auto caCertificates = sslContext->sslConfiguration.caCertificates();
     for (const QSslCertificate &caCertificate : caCertificates) {
         // From https://www.openssl.org/docs/ssl/SSL_CTX_load_verify_locations.html:
@@ -584,6 +711,11 @@ QT_WARNING_POP
         // See also: QSslSocketBackendPrivate::verify()
         if (caCertificate.expiryDate() >= now) {
             q_X509_STORE_add_cert(q_SSL_CTX_get_cert_store(sslContext->ctx), (X509 *)caCertificate.handle());
+            unsigned char md[EVP_MAX_MD_SIZE];
+            unsigned int length = 0;
+            // SHA-1 digests are precomputed by OpenSSL when the certificate is parsed.
+            if (q_X509_digest((X509 *)caCertificate.handle(), q_EVP_sha1(), md, &length))
+                trustHash.addData(QByteArrayView(md, length));
         }
     }
 
@@ -697,6 +829,25 @@ QT_WARNING_POP
             verificationMode |= SSL_VERIFY_FAIL_IF_NO_PEER_CERT;
 
         q_SSL_CTX_set_verify(sslContext->ctx, verificationMode, verificationCallback);
+
+        // Cache the outcome of chain verification, unless some part of the
+        // configuration makes it depend on more than the certificates.
+        bool cacheVerification = !isDtls && sslContext->sslConfiguration.backendConfiguration().isEmpty();
+#if QT_CONFIG(ocsp)
+        if (sslContext->sslConfiguration.ocspStaplingEnabled())
+            cacheVerification = false;
+#endif // ocsp
+        if (cacheVerification) {
+            const int settings[] = {
+                int(mode),
+                allowRootCertOnDemandLoading && QSslSocketPrivate::rootCertOnDemandLoadingSupported(),
+                sslContext->sslConfiguration.peerVerifyDepth()
+            };
+            trustHash.addData(QByteArrayView(reinterpret_cast<const char *>(settings), sizeof settings));
+            sslContext->verificationTrustKey = trustHash.result();
+            q_SSL_CTX_set_cert_verify_callback(sslContext->ctx, q_X509VerifyCertCallback,
+                                               &sslContext->verificationTrustKey);
+        }
     }
 
 #ifdef TLS1_3_VERSION
@@ -118,6 +118,9 @@ private:
     QSslError::SslError errorCode;
     QString errorStr;
     QSslConfiguration sslConfiguration;
+    // Identifies the trust settings of ctx for the chain verification cache;
+    // empty if verification results must not be cached.
+    QByteArray verificationTrustKey;
 #ifndef OPENSSL_NO_NEXTPROTONEG
     QByteArray m_supportedNPNVersions;
     NPNContext m_npnContext;
@@ -265,6 +265,8 @@ void q_X509_STORE_set_verify_cb(X509_STORE *ctx, X509_STORE_CTX_verify_cb verify
 int q_X509_STORE_set_ex_data(X509_STORE *ctx, int idx, void *data);
 void *q_X509_STORE_get_ex_data(X509_STORE *r, int idx);
 STACK_OF(X509) *q_X509_STORE_CTX_get0_chain(X509_STORE_CTX *ctx);
+STACK_OF(X509) *q_X509_STORE_CTX_get0_untrusted(X509_STORE_CTX *ctx);
+X509 *q_X509_STORE_CTX_get0_cert(X509_STORE_CTX *ctx);
 void q_DH_get0_pqg(const DH *dh, const BIGNUM **p, const BIGNUM **q, const BIGNUM **g);
 
 # define q_SSL_load_error_strings() q_OPENSSL_init_ssl(OPENSSL_INIT_LOAD_SSL_STRINGS \
@@ -314,6 +316,19 @@ extern "C"
 {
 
 typedef int (*CookieVerifyCallback)(SSL *, const unsigned char *, unsigned);
+
+}
+
+int q_DTLSv1_listen(SSL *s, BIO_ADDR *client);
+BIO_ADDR *q_BIO_ADDR_new();
+void q_BIO_ADDR_free(BIO_ADDR *ap);
+
+#endif // dtls
+
+#if QT_CONFIG(dtls) || QT_CONFIG(ktls)
+extern "C"
+{
+
 typedef int (*DgramWriteCallback) (BIO *, const char *, int);
 typedef int (*DgramReadCallback) (BIO *, char *, int);
 typedef int (*DgramPutsCallback) (BIO *, const char *);
@@ -323,11 +338,7 @@ typedef int (*DgramDestroyCallback) (BIO *);
 
 }
 
-int q_DTLSv1_listen(SSL *s, BIO_ADDR *client);
-BIO_ADDR *q_BIO_ADDR_new();
-void q_BIO_ADDR_free(BIO_ADDR *ap);
-
-// API we need for a custom dgram BIO:
+// API we need for a custom dgram (or kTLS) BIO:
 
 BIO_METHOD *q_BIO_meth_new(int type, const char *name);
 void q_BIO_meth_free(BIO_METHOD *biom);
@@ -338,7 +349,7 @@ int q_BIO_meth_set_ctrl(BIO_METHOD *biom, DgramCtrlCallback);
 int q_BIO_meth_set_create(BIO_METHOD *biom, DgramCreateCallback);
 int q_BIO_meth_set_destroy(BIO_METHOD *biom, DgramDestroyCallback);
 
-#endif // dtls
+#endif // dtls || ktls
 
 void q_BIO_set_data(BIO *a, void *ptr);
 void *q_BIO_get_data(BIO *a);
@@ -447,6 +458,7 @@ SSL_CTX *q_SSL_CTX_new(const SSL_METHOD *a);
 int q_SSL_CTX_set_cipher_list(SSL_CTX *a, const char *b);
 int q_SSL_CTX_set_default_verify_paths(SSL_CTX *a);
 void q_SSL_CTX_set_verify(SSL_CTX *a, int b, int (*c)(int, X509_STORE_CTX *));
+void q_SSL_CTX_set_cert_verify_callback(SSL_CTX *a, int (*b)(X509_STORE_CTX *, void *), void *c);
 void q_SSL_CTX_set_verify_depth(SSL_CTX *a, int b);
 extern "C" {
 typedef void (*GenericCallbackType)();
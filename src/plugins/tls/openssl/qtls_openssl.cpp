@@ -55,6 +55,17 @@
 #include <QtCore/qscopedvaluerollback.h>
 #include <QtCore/qscopeguard.h>
 
+#if QT_CONFIG(ktls)
+#include <QtCore/qtimer.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/tls.h>
+
+#include <cerrno>
+#endif // ktls
+
 #include <algorithm>
 #include <cstring>
 
@@ -505,6 +516,89 @@ bool qt_OCSP_certificate_match(OCSP_SINGLERESP *singleResponse, X509 *peerCert,
 } // unnamed namespace
 #endif // ocsp
 
+#if QT_CONFIG(ktls)
+namespace {
+
+// OpenSSL 3.0 only exposes BIO_CTRL_GET_KTLS_SEND/RECV; these are the values
+// it uses internally (see bio.h) to hand the key material and the type of
+// non-application-data records to a socket BIO.
+enum KernelTlsBioCtrl : int
+{
+    KtlsCtrlSet = 72,
+    KtlsCtrlSetRecordType = 74,
+    KtlsCtrlClearRecordType = 75
+};
+
+extern "C" int q_ktls_write(BIO *bio, const char *src, int bytesToWrite)
+{
+    auto crypto = static_cast<TlsCryptographOpenSSL *>(q_BIO_get_app_data(bio));
+    Q_ASSERT(crypto);
+    return crypto->ktlsWrite(src, bytesToWrite);
+}
+
+extern "C" int q_ktls_puts(BIO *bio, const char *src)
+{
+    return q_ktls_write(bio, src, int(std::strlen(src)));
+}
+
+extern "C" long q_ktls_ctrl(BIO *bio, int cmd, long num, void *ptr)
+{
+    auto crypto = static_cast<TlsCryptographOpenSSL *>(q_BIO_get_app_data(bio));
+    Q_ASSERT(crypto);
+    return crypto->ktlsCtrl(cmd, num, ptr);
+}
+
+extern "C" int q_ktls_create(BIO *bio)
+{
+    q_BIO_set_init(bio, 1);
+    return 1;
+}
+
+extern "C" int q_ktls_destroy(BIO *bio)
+{
+    // The memory BIO we forward to is owned by TlsCryptographOpenSSL.
+    Q_UNUSED(bio);
+    return 1;
+}
+
+const BIO_METHOD *ktlsBioMethod()
+{
+    // Never freed: it is shared by all sockets and lives as long as the plugin.
+    static BIO_METHOD *method = [] {
+        BIO_METHOD *biom = q_BIO_meth_new(BIO_TYPE_SOURCE_SINK, "qktlsbio");
+        if (biom) {
+            q_BIO_meth_set_create(biom, q_ktls_create);
+            q_BIO_meth_set_destroy(biom, q_ktls_destroy);
+            q_BIO_meth_set_write(biom, q_ktls_write);
+            q_BIO_meth_set_puts(biom, q_ktls_puts);
+            q_BIO_meth_set_ctrl(biom, q_ktls_ctrl);
+        }
+        return biom;
+    }();
+    return method;
+}
+
+qsizetype ktlsCryptoInfoSize(const void *cryptoInfo)
+{
+    switch (static_cast<const tls_crypto_info *>(cryptoInfo)->cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+        return sizeof(tls12_crypto_info_aes_gcm_128);
+    case TLS_CIPHER_AES_GCM_256:
+        return sizeof(tls12_crypto_info_aes_gcm_256);
+    case TLS_CIPHER_AES_CCM_128:
+        return sizeof(tls12_crypto_info_aes_ccm_128);
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+        return sizeof(tls12_crypto_info_chacha20_poly1305);
+#endif
+    default:
+        return 0;
+    }
+}
+
+} // unnamed namespace
+#endif // ktls
+
 TlsCryptographOpenSSL::~TlsCryptographOpenSSL()
 {
     destroySslContext();
@@ -969,7 +1063,7 @@ void TlsCryptographOpenSSL::transmit()
         // Check if we've got any data to be written to the socket.
         QVarLengthArray<char, 4096> data;
         int pendingBytes;
-        while (plainSocket->isValid() && (pendingBytes = q_BIO_pending(writeBio)) > 0
+        while (plainSocket->isValid() && (pendingBytes = pendingEncryptedBytes()) > 0
                 && plainSocket->openMode() != QIODevice::NotOpen) {
             // Read encrypted data from the write BIO into a buffer.
             data.resize(pendingBytes);
@@ -990,6 +1084,15 @@ void TlsCryptographOpenSSL::transmit()
             transmitting = true;
         }
 
+#if QT_CONFIG(ktls)
+        if (!ktlsBarriers.isEmpty()) {
+            bool progress = false;
+            if (!processKernelTlsBarriers(&progress))
+                return;
+            transmitting = transmitting || progress;
+        }
+#endif // ktls
+
         // Check if we've got any data to be read from the socket.
         if (!q->isEncrypted() || !d->maxReadBufferSize() || buffer.size() < d->maxReadBufferSize())
             while ((pendingBytes = plainSocket->bytesAvailable()) > 0) {
@@ -1380,7 +1483,7 @@ void TlsCryptographOpenSSL::trySendFatalAlert()
     pendingFatalAlert = false;
     QVarLengthArray<char, 4096> data;
     int pendingBytes = 0;
-    while (plainSocket->isValid() && (pendingBytes = q_BIO_pending(writeBio)) > 0
+    while (plainSocket->isValid() && (pendingBytes = pendingEncryptedBytes()) > 0
            && plainSocket->openMode() != QIODevice::NotOpen) {
         // Read encrypted data from the write BIO into a buffer.
         data.resize(pendingBytes);
@@ -1456,6 +1559,11 @@ bool TlsCryptographOpenSSL::initSslContext()
     }
 
     // Assign the bios.
+#if QT_CONFIG(ktls)
+    if (configuration.testSslOption(QSsl::SslOptionEnableKernelTls) && initKernelTls())
+        q_SSL_set_bio(ssl, readBio, ktlsBio);
+    else
+#endif // ktls
     q_SSL_set_bio(ssl, readBio, writeBio);
 
     if (mode == QSslSocket::SslClientMode)
@@ -1536,9 +1644,241 @@ void TlsCryptographOpenSSL::destroySslContext()
         q_SSL_free(ssl);
         ssl = nullptr;
     }
+#if QT_CONFIG(ktls)
+    if (ktlsBio) {
+        // SSL_free() released ktlsBio, but not the memory BIO behind it.
+        q_BIO_free(writeBio);
+        writeBio = nullptr;
+        ktlsBio = nullptr;
+        QObject::disconnect(ktlsBytesWrittenConnection);
+        ktlsBarriers.clear();
+        ktlsBytesQueued = 0;
+        ktlsRecordType = 0;
+        ktlsTxRequested = false;
+        ktlsTxActive = false;
+    }
+#endif // ktls
     sslContextPointer.reset();
 }
 
+/*!
+    \internal
+
+    Returns the number of bytes that can be moved from writeBio to the plain
+    socket. With kernel TLS, this stops at the next pending barrier.
+*/
+int TlsCryptographOpenSSL::pendingEncryptedBytes() const
+{
+    const int pending = int(q_BIO_pending(writeBio));
+#if QT_CONFIG(ktls)
+    if (!ktlsBarriers.isEmpty()) {
+        const qint64 drained = ktlsBytesQueued - pending;
+        return int(qMin(qint64(pending), ktlsBarriers.first().position - drained));
+    }
+#endif // ktls
+    return pending;
+}
+
+#if QT_CONFIG(ktls)
+/*!
+    \internal
+
+    Sets up the BIO that lets OpenSSL hand the symmetric encryption of
+    outgoing records over to the kernel once the handshake has established
+    the keys. Returns \c false if kernel TLS cannot be used, in which case
+    the connection works as usual.
+*/
+bool TlsCryptographOpenSSL::initKernelTls()
+{
+    Q_ASSERT(d);
+    Q_ASSERT(!ktlsBio);
+
+    // The kTLS support that drives our BIO appeared in OpenSSL 3.0.
+    if (q_OpenSSL_version_num() < 0x30000000L)
+        return false;
+    auto *plainSocket = d->plainTcpSocket();
+    if (!plainSocket || plainSocket->socketDescriptor() == -1)
+        return false;
+    const BIO_METHOD *method = ktlsBioMethod();
+    if (!method || !(ktlsBio = q_BIO_new(method)))
+        return false;
+
+    q_BIO_set_app_data(ktlsBio, this);
+    q_SSL_set_options(ssl, SSL_OP_ENABLE_KTLS);
+    // Barriers wait for the plain socket to drain, so resume then.
+    ktlsBytesWrittenConnection = QObject::connect(plainSocket, &QAbstractSocket::bytesWritten,
+                                                  this, [this] {
+        if (!ktlsBarriers.isEmpty())
+            transmit();
+    });
+    return true;
+}
+
+/*!
+    \internal
+
+    Called by OpenSSL (through BIO_set_ktls) with the kernel's crypto info
+    for the new write keys. Everything written so far must still be sent
+    as-is, so the switch to TLS_TX is queued as a barrier. Returns \c false
+    if the kernel cannot do it, and OpenSSL then keeps encrypting.
+*/
+bool TlsCryptographOpenSSL::enableKernelTlsTx(const void *cryptoInfo)
+{
+    const qsizetype size = cryptoInfo ? ktlsCryptoInfoSize(cryptoInfo) : 0;
+    if (!size || ktlsTxRequested)
+        return false;
+
+    const int fd = int(d->plainTcpSocket()->socketDescriptor());
+    // Attaching the "tls" upper layer protocol changes nothing yet; it fails
+    // if the kernel has no TLS support.
+    if (::setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) != 0 && errno != EEXIST)
+        return false;
+
+    KernelTlsBarrier barrier;
+    barrier.position = ktlsBytesQueued;
+    barrier.data = QByteArray(static_cast<const char *>(cryptoInfo), size);
+    ktlsBarriers.append(std::move(barrier));
+    ktlsTxRequested = true;
+    return true;
+}
+
+/*!
+    \internal
+
+    Executes the barriers that writeBio has been drained up to, once the plain
+    socket has passed everything before them to the kernel. Sets \a progress
+    if at least one barrier was executed. Returns \c false if an error was
+    emitted.
+*/
+bool TlsCryptographOpenSSL::processKernelTlsBarriers(bool *progress)
+{
+    auto *plainSocket = d->plainTcpSocket();
+    while (!ktlsBarriers.isEmpty() && !pendingEncryptedBytes()) {
+        if (plainSocket->bytesToWrite()) {
+            plainSocket->flush();
+            if (plainSocket->bytesToWrite())
+                return true; // bytesWritten() brings us back here.
+        }
+
+        const int fd = int(plainSocket->socketDescriptor());
+        KernelTlsBarrier &barrier = ktlsBarriers.first();
+        if (!barrier.recordType) {
+            if (::setsockopt(fd, SOL_TLS, TLS_TX, barrier.data.constData(),
+                             socklen_t(barrier.data.size())) != 0) {
+                // OpenSSL already writes plain text; we cannot go back.
+                const int savedErrno = errno;
+                setErrorAndEmit(d, QAbstractSocket::SslInternalError,
+                                QSslSocket::tr("Unable to enable kernel TLS: %1")
+                                .arg(qt_error_string(savedErrno)));
+                plainSocket->abort();
+                return false;
+            }
+            ktlsTxActive = true;
+        } else {
+            // Records of other types (alerts, post-handshake messages) need
+            // their type passed along as ancillary data.
+            char control[CMSG_SPACE(sizeof(unsigned char))] = {};
+            iovec iov = { barrier.data.data(), size_t(barrier.data.size()) };
+            msghdr msg = {};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof control;
+            cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_TLS;
+            cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+            *CMSG_DATA(cmsg) = static_cast<unsigned char>(barrier.recordType);
+
+            const ssize_t sent = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                QTimer::singleShot(10, this, [this] { transmit(); });
+                return true;
+            }
+            if (sent < 0) {
+                const int savedErrno = errno;
+                setErrorAndEmit(d, QAbstractSocket::SslInternalError,
+                                QSslSocket::tr("Unable to write data: %1")
+                                .arg(qt_error_string(savedErrno)));
+                return false;
+            }
+            if (sent < barrier.data.size()) {
+                barrier.data.remove(0, sent);
+                continue;
+            }
+        }
+        ktlsBarriers.removeFirst();
+        *progress = true;
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns \c true if the kernel encrypts everything written to the socket
+    from now on, so that file contents can be sent without passing through
+    OpenSSL.
+*/
+bool TlsCryptographOpenSSL::canSendFiles() const
+{
+    return ktlsTxActive && ktlsBarriers.isEmpty() && !q_BIO_pending(writeBio);
+}
+
+/*!
+    \internal
+
+    The write callback of ktlsBio.
+*/
+int TlsCryptographOpenSSL::ktlsWrite(const char *data, int size)
+{
+    if (!data || size <= 0)
+        return 0;
+
+    if (ktlsRecordType) {
+        KernelTlsBarrier barrier;
+        barrier.position = ktlsBytesQueued;
+        barrier.recordType = ktlsRecordType;
+        barrier.data = QByteArray(data, size);
+        ktlsBarriers.append(std::move(barrier));
+        return size;
+    }
+
+    const int written = q_BIO_write(writeBio, data, size);
+    if (written > 0)
+        ktlsBytesQueued += written;
+    return written;
+}
+
+/*!
+    \internal
+
+    The ctrl callback of ktlsBio; everything that is not about kernel TLS is
+    forwarded to writeBio.
+*/
+long TlsCryptographOpenSSL::ktlsCtrl(int cmd, long num, void *ptr)
+{
+    switch (cmd) {
+    case BIO_CTRL_GET_KTLS_SEND:
+        return ktlsTxRequested;
+    case BIO_CTRL_GET_KTLS_RECV:
+        return 0;
+    case KtlsCtrlSet:
+        // Incoming records are still decrypted by OpenSSL: by the time the
+        // keys are known, the socket may have been read past the handshake.
+        return num && enableKernelTlsTx(ptr);
+    case KtlsCtrlSetRecordType:
+        ktlsRecordType = int(num);
+        return 1;
+    case KtlsCtrlClearRecordType:
+        ktlsRecordType = 0;
+        return 1;
+    default:
+        return q_BIO_ctrl(writeBio, cmd, num, ptr);
+    }
+}
+#endif // ktls
+
 void TlsCryptographOpenSSL::storePeerCertificates()
 {
     Q_ASSERT(d);
@@ -124,6 +124,13 @@ public:
     bool isInSslRead() const;
     void setRenegotiated(bool renegotiated);
 
+#if QT_CONFIG(ktls)
+    bool canSendFiles() const override;
+
+    int ktlsWrite(const char *data, int size);
+    long ktlsCtrl(int cmd, long num, void *ptr);
+#endif // ktls
+
 #ifdef Q_OS_WIN
     void fetchCaRootForCert(const QSslCertificate &cert);
     void caRootLoaded(QSslCertificate certificate, QSslCertificate trustedRoot);
@@ -135,6 +142,13 @@ private:
     // easier (see qsslsocket_openssl.cpp, while it exists).
     bool initSslContext();
     void destroySslContext();
+    int pendingEncryptedBytes() const;
+
+#if QT_CONFIG(ktls)
+    bool initKernelTls();
+    bool enableKernelTlsTx(const void *cryptoInfo);
+    bool processKernelTlsBarriers(bool *progress);
+#endif // ktls
 
     std::shared_ptr<QSslContext> sslContextPointer;
     SSL *ssl = nullptr; // TLSTODO: RAII.
@@ -145,6 +159,29 @@ private:
     BIO *readBio = nullptr;
     BIO *writeBio = nullptr;
 
+#if QT_CONFIG(ktls)
+    // Something that must happen once everything queued in writeBio before
+    // 'position' has reached the kernel: either switching the socket to
+    // kernel TLS (TLS_TX) with the key material in 'data', or sending 'data'
+    // as a non-application-data record of 'recordType'.
+    struct KernelTlsBarrier
+    {
+        qint64 position = 0;
+        int recordType = 0;
+        QByteArray data;
+    };
+
+    // The BIO OpenSSL writes to, when kernel TLS was requested; it forwards
+    // to writeBio and intercepts OpenSSL's kTLS controls.
+    BIO *ktlsBio = nullptr;
+    QList<KernelTlsBarrier> ktlsBarriers;
+    QMetaObject::Connection ktlsBytesWrittenConnection;
+    qint64 ktlsBytesQueued = 0;
+    int ktlsRecordType = 0;
+    bool ktlsTxRequested = false;
+    bool ktlsTxActive = false;
+#endif // ktls
+
     QList<QOcspResponse> ocspResponses;
 
     // This description will go to setErrorAndEmit(SslHandshakeError, ocspErrorDescription)
@@ -52,6 +52,7 @@
 #include <QtNetwork/qsslcipher.h>
 #include <QtNetwork/qssl.h>
 
+#include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qdiriterator.h>
 #include <QtCore/qlist.h>
@@ -432,9 +433,39 @@ QList<QSslCertificate> systemCaCertificates()
 #endif // !Q_OS_DARWIN
 } // namespace QTlsPrivate
 
+namespace {
+
+// Reading the system store means parsing every PEM file in the certificate
+// directories (or walking the Windows ROOT store), which takes tens of
+// milliseconds. Remember the result for a while instead of doing it again
+// for every QSslSocket::systemCaCertificates() or chain verification call.
+constexpr qint64 systemCaCertificatesLifetimeMs = 10 * 60 * 1000;
+
+struct SystemCaCertificatesCache
+{
+    QMutex mutex;
+    QList<QSslCertificate> certificates;
+    QDeadlineTimer expiry{QDeadlineTimer::Forever};
+    bool loaded = false;
+};
+
+Q_GLOBAL_STATIC(SystemCaCertificatesCache, systemCaCertificatesCache)
+
+} // unnamed namespace
+
 QList<QSslCertificate> QTlsBackendOpenSSL::systemCaCertificates() const
 {
-    return QTlsPrivate::systemCaCertificates();
+    auto *cache = systemCaCertificatesCache();
+    if (!cache)
+        return QTlsPrivate::systemCaCertificates();
+
+    const QMutexLocker locker(&cache->mutex);
+    if (!cache->loaded || cache->expiry.hasExpired()) {
+        cache->certificates = QTlsPrivate::systemCaCertificates();
+        cache->expiry.setRemainingTime(systemCaCertificatesLifetimeMs);
+        cache->loaded = true;
+    }
+    return cache->certificates;
 }
 
 QTlsPrivate::DtlsCookieVerifier *QTlsBackendOpenSSL::createDtlsCookieVerifier() const
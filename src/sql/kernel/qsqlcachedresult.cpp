@@ -51,20 +51,197 @@ QT_BEGIN_NAMESPACE
    backwards over the results again.
 
    All you need to do is to inherit from QSqlCachedResult and reimplement
-   gotoNext(). gotoNext() will have a reference to the internal cache and
-   will give you an index where you can start filling in your data. Special
+   gotoNext(). gotoNext() will have a reference to a row buffer and will
+   give you an index where you can start filling in your data. Special
    case: If the user actually wants a forward-only query, idx will be -1
    to indicate that we are not interested in the actual values.
+
+   Unless the query is forward-only, the values of each fetched row are
+   moved from the row buffer into per-column storage, which keeps numbers
+   and strings in flat arrays rather than in one QVariant per cell.
 */
 
-static const uint initial_cache_size = 128;
+QSqlCachedColumn::Storage QSqlCachedColumn::storageFor(QMetaType type)
+{
+    switch (type.id()) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return Storage::Fixed;
+    case QMetaType::QString:
+        return Storage::String;
+    case QMetaType::QByteArray:
+        return Storage::Bytes;
+    default:
+        return Storage::Variant;
+    }
+}
+
+void QSqlCachedColumn::append(const QVariant &value)
+{
+    if (storage == Storage::Variant) {
+        variants.append(value);
+        ++rowCount;
+        return;
+    }
+
+    const int row = rowCount;
+    if (value.isNull()) {
+        if (hasNulls && nullType != value.metaType())
+            return appendVariant(value);
+        hasNulls = true;
+        nullType = value.metaType();
+        appendNull(row);
+        ++rowCount;
+        return;
+    }
+
+    if (storage == Storage::Unset) {
+        storage = storageFor(value.metaType());
+        type = value.metaType();
+        // all rows so far are null
+        switch (storage) {
+        case Storage::Fixed:
+            fixed.resize(row);
+            break;
+        case Storage::String:
+        case Storage::Bytes:
+            ends.resize(row);
+            break;
+        case Storage::Unset:
+        case Storage::Variant:
+            storage = Storage::Unset;
+            return appendVariant(value);
+        }
+    } else if (type != value.metaType()) {
+        return appendVariant(value);
+    }
+
+    switch (storage) {
+    case Storage::Fixed: {
+        quint64 slot = 0;
+        memcpy(&slot, value.constData(), type.sizeOf());
+        fixed.append(slot);
+        break;
+    }
+    case Storage::String: {
+        const QString *string = static_cast<const QString *>(value.constData());
+        if (string->isNull())
+            return appendVariant(value);
+        characters.append(*string);
+        ends.append(characters.size());
+        break;
+    }
+    case Storage::Bytes: {
+        const QByteArray *array = static_cast<const QByteArray *>(value.constData());
+        if (array->isNull())
+            return appendVariant(value);
+        bytes.append(*array);
+        ends.append(bytes.size());
+        break;
+    }
+    case Storage::Unset:
+    case Storage::Variant:
+        Q_UNREACHABLE();
+    }
+    ++rowCount;
+}
+
+void QSqlCachedColumn::appendNull(int row)
+{
+    const int word = row / 64;
+    if (nullMask.size() <= word)
+        nullMask.resize(word + 1);
+    nullMask[word] |= quint64(1) << (row % 64);
+
+    switch (storage) {
+    case Storage::Fixed:
+        fixed.append(0);
+        break;
+    case Storage::String:
+        ends.append(characters.size());
+        break;
+    case Storage::Bytes:
+        ends.append(bytes.size());
+        break;
+    case Storage::Unset:
+    case Storage::Variant:
+        break;
+    }
+}
+
+// Converts the column to QVariant storage and appends value
+void QSqlCachedColumn::appendVariant(const QVariant &value)
+{
+    QList<QVariant> values;
+    values.reserve(rowCount + 1);
+    for (int row = 0; row < rowCount; ++row)
+        values.append(this->value(row));
+    values.append(value);
+
+    const int count = rowCount + 1;
+    clear();
+    variants = std::move(values);
+    rowCount = count;
+    storage = Storage::Variant;
+}
+
+QVariant QSqlCachedColumn::value(int row) const
+{
+    if (row < 0 || row >= rowCount)
+        return QVariant();
+    if (storage == Storage::Variant)
+        return variants.at(row);
+    if (isNull(row))
+        return QVariant(nullType);
+
+    switch (storage) {
+    case Storage::Fixed:
+        return QVariant(type, &fixed.at(row));
+    case Storage::String: {
+        const qsizetype begin = row ? ends.at(row - 1) : 0;
+        return QVariant(QString(characters.constData() + begin, ends.at(row) - begin));
+    }
+    case Storage::Bytes: {
+        const qsizetype begin = row ? ends.at(row - 1) : 0;
+        return QVariant(QByteArray(bytes.constData() + begin, ends.at(row) - begin));
+    }
+    case Storage::Unset:
+    case Storage::Variant:
+        break;
+    }
+    Q_UNREACHABLE();
+    return QVariant();
+}
+
+bool QSqlCachedColumn::isNull(int row) const
+{
+    if (row < 0 || row >= rowCount)
+        return true;
+    if (storage == Storage::Variant)
+        return variants.at(row).isNull();
+    const int word = row / 64;
+    return word < nullMask.size() && (nullMask.at(word) & (quint64(1) << (row % 64)));
+}
+
+void QSqlCachedColumn::clear()
+{
+    *this = QSqlCachedColumn();
+}
+
+//////////////
 
 void QSqlCachedResultPrivate::cleanup()
 {
     cache.clear();
+    columns.clear();
     atEnd = false;
     colCount = 0;
-    rowCacheEnd = 0;
+    rowCount = 0;
 }
 
 void QSqlCachedResultPrivate::init(int count, bool fo)
@@ -73,45 +250,37 @@ void QSqlCachedResultPrivate::init(int count, bool fo)
     cleanup();
     forwardOnly = fo;
     colCount = count;
-    if (fo) {
-        cache.resize(count);
-        rowCacheEnd = count;
-    } else {
-        cache.resize(initial_cache_size * count);
-    }
+    cache.resize(count);
+    if (!fo)
+        columns.resize(count);
 }
 
-int QSqlCachedResultPrivate::nextIndex()
+void QSqlCachedResultPrivate::clearRows()
 {
-    if (forwardOnly)
-        return 0;
-    int newIdx = rowCacheEnd;
-    if (newIdx + colCount > cache.size())
-        cache.resize(qMin(cache.size() * 2, cache.size() + 10000));
-    rowCacheEnd += colCount;
-
-    return newIdx;
+    for (QSqlCachedColumn &column : columns)
+        column.clear();
+    rowCount = 0;
 }
 
-bool QSqlCachedResultPrivate::canSeek(int i) const
+void QSqlCachedResultPrivate::appendRow()
 {
-    if (forwardOnly || i < 0)
-        return false;
-    return rowCacheEnd >= (i + 1) * colCount;
+    for (int i = 0; i < colCount; ++i)
+        columns[i].append(std::exchange(cache[i], QVariant()));
+    ++rowCount;
 }
 
-void QSqlCachedResultPrivate::revertLast()
+bool QSqlCachedResultPrivate::canSeek(int i) const
 {
-    if (forwardOnly)
-        return;
-    rowCacheEnd -= colCount;
+    if (forwardOnly || i < 0)
+        return false;
+    return rowCount > i;
 }
 
 inline int QSqlCachedResultPrivate::cacheCount() const
 {
     Q_ASSERT(!forwardOnly);
     Q_ASSERT(colCount);
-    return rowCacheEnd / colCount;
+    return rowCount;
 }
 
 //////////////
@@ -152,7 +321,7 @@ bool QSqlCachedResult::fetch(int i)
         setAt(i);
         return true;
     }
-    if (d->rowCacheEnd > 0)
+    if (d->rowCount > 0)
         setAt(d->cacheCount());
     while (at() < i + 1) {
         if (!cacheNext()) {
@@ -218,21 +387,23 @@ bool QSqlCachedResult::fetchLast()
 QVariant QSqlCachedResult::data(int i)
 {
     Q_D(const QSqlCachedResult);
-    int idx = d->forwardOnly ? i : at() * d->colCount + i;
-    if (i >= d->colCount || i < 0 || at() < 0 || idx >= d->rowCacheEnd)
+    if (i >= d->colCount || i < 0 || at() < 0)
         return QVariant();
+    if (d->forwardOnly)
+        return d->cache.at(i);
 
-    return d->cache.at(idx);
+    return d->columns.at(i).value(at());
 }
 
 bool QSqlCachedResult::isNull(int i)
 {
     Q_D(const QSqlCachedResult);
-    int idx = d->forwardOnly ? i : at() * d->colCount + i;
-    if (i >= d->colCount || i < 0 || at() < 0 || idx >= d->rowCacheEnd)
+    if (i >= d->colCount || i < 0 || at() < 0)
         return true;
+    if (d->forwardOnly)
+        return d->cache.at(i).isNull();
 
-    return d->cache.at(idx).isNull();
+    return d->columns.at(i).isNull(at());
 }
 
 void QSqlCachedResult::cleanup()
@@ -247,7 +418,7 @@ void QSqlCachedResult::clearValues()
 {
     Q_D(QSqlCachedResult);
     setAt(QSql::BeforeFirstRow);
-    d->rowCacheEnd = 0;
+    d->clearRows();
     d->atEnd = false;
 }
 
@@ -257,15 +428,14 @@ bool QSqlCachedResult::cacheNext()
     if (d->atEnd)
         return false;
 
-    if (isForwardOnly()) {
-        d->cache.resize(d->colCount);
-    }
+    d->cache.resize(d->colCount);
 
-    if (!gotoNext(d->cache, d->nextIndex())) {
-        d->revertLast();
+    if (!gotoNext(d->cache, 0)) {
         d->atEnd = true;
         return false;
     }
+    if (!d->forwardOnly)
+        d->appendRow();
     setAt(at() + 1);
     return true;
 }
@@ -54,14 +54,48 @@
 #include <QtSql/private/qtsqlglobal_p.h>
 #include "QtSql/qsqlresult.h"
 #include "QtSql/private/qsqlresult_p.h"
-#include <QtCore/qcontainerfwd.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
 
 QT_BEGIN_NAMESPACE
 
-class QVariant;
-
 class QSqlCachedResultPrivate;
 
+// Stores the values of one column of a cached result set. Numbers, strings
+// and byte arrays are kept in typed buffers; a column whose values do not
+// all have the same type falls back to storing QVariants.
+class QSqlCachedColumn
+{
+public:
+    void append(const QVariant &value);
+    QVariant value(int row) const;
+    bool isNull(int row) const;
+    void clear();
+
+private:
+    enum class Storage : quint8 { Unset, Fixed, String, Bytes, Variant };
+
+    static Storage storageFor(QMetaType type);
+    void appendNull(int row);
+    void appendVariant(const QVariant &value);
+
+    QList<quint64> fixed;           // Fixed: the value's bytes, one slot per row
+    QString characters;             // String: the characters of all rows
+    QByteArray bytes;               // Bytes: the data of all rows
+    QList<qsizetype> ends;          // String, Bytes: where each row's data ends
+    QList<QVariant> variants;       // Variant: one QVariant per row
+    QList<quint64> nullMask;
+    QMetaType type;
+    QMetaType nullType;
+    int rowCount = 0;
+    Storage storage = Storage::Unset;
+    bool hasNulls = false;
+};
+Q_DECLARE_TYPEINFO(QSqlCachedColumn, Q_RELOCATABLE_TYPE);
+
 class Q_SQL_EXPORT QSqlCachedResult: public QSqlResult
 {
     Q_DECLARE_PRIVATE(QSqlCachedResult)
@@ -107,11 +141,12 @@ public:
     inline int cacheCount() const;
     void init(int count, bool fo);
     void cleanup();
-    int nextIndex();
-    void revertLast();
+    void clearRows();
+    void appendRow();
 
     QSqlCachedResult::ValueCache cache;
-    int rowCacheEnd = 0;
+    QList<QSqlCachedColumn> columns;
+    int rowCount = 0;
     int colCount = 0;
     bool atEnd = false;
 };
@@ -0,0 +1,431 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsqlconnectionpool.h"
+
+#include "qsqldatabase.h"
+#include "qsqlquery.h"
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSqlConnectionPoolPrivate
+{
+public:
+    struct IdleConnection
+    {
+        QString name;
+        QPointer<QThread> thread;
+        QElapsedTimer idleTimer;
+    };
+
+    explicit QSqlConnectionPoolPrivate(const QString &name) : connectionName(name) {}
+
+    static bool isOwnedBy(const QPointer<QThread> &owner, const QThread *thread);
+    QStringList takeExpiredConnections(const QThread *thread, bool all);
+    QString takeIdleConnection(QThread *thread);
+    static bool validate(QSqlDatabase &db, const QString &query);
+
+    const QString connectionName;
+    QString validationQuery;
+    int maximumConnectionCount = 16;
+    int minimumConnectionCount = 0;
+    int maximumIdleTime = 60000;
+    int connectionCount = 0;
+    int nameCounter = 0;
+    QList<IdleConnection> idle;
+    QHash<QString, QPointer<QThread>> busy;
+    mutable QMutex mutex;
+    QWaitCondition connectionReleased;
+};
+
+/*
+    Returns \c true if a connection created by \a owner may be used or
+    closed from \a thread. Connections of threads that have finished
+    can be closed from any thread.
+*/
+bool QSqlConnectionPoolPrivate::isOwnedBy(const QPointer<QThread> &owner, const QThread *thread)
+{
+    return owner.isNull() || owner == thread || owner->isFinished();
+}
+
+/*
+    Removes the idle connections that can be closed from \a thread and have
+    been idle for too long, or all of them if \a all is \c true, from the
+    pool and returns their names. Must be called with the mutex locked.
+*/
+QStringList QSqlConnectionPoolPrivate::takeExpiredConnections(const QThread *thread, bool all)
+{
+    QStringList names;
+    for (qsizetype i = 0; i < idle.size(); ) {
+        const IdleConnection &connection = idle.at(i);
+        const bool orphaned = connection.thread.isNull() || connection.thread->isFinished();
+        const bool expired = isOwnedBy(connection.thread, thread)
+                && (all || connection.idleTimer.hasExpired(maximumIdleTime))
+                && connectionCount > minimumConnectionCount;
+        if (orphaned || expired) {
+            names.append(connection.name);
+            idle.removeAt(i);
+            --connectionCount;
+        } else {
+            ++i;
+        }
+    }
+    return names;
+}
+
+/*
+    Moves the idle connection of \a thread that was released last to the
+    busy connections and returns its name. Must be called with the mutex
+    locked.
+*/
+QString QSqlConnectionPoolPrivate::takeIdleConnection(QThread *thread)
+{
+    for (qsizetype i = idle.size() - 1; i >= 0; --i) {
+        if (idle.at(i).thread == thread) {
+            const QString name = idle.takeAt(i).name;
+            busy.insert(name, thread);
+            return name;
+        }
+    }
+    return QString();
+}
+
+/*
+    Makes sure \a db is open and, if \a query is not empty, that it still
+    answers it; a connection that does not is opened again.
+*/
+bool QSqlConnectionPoolPrivate::validate(QSqlDatabase &db, const QString &query)
+{
+    if (!db.isValid())
+        return false;
+    if (db.isOpen() && !query.isEmpty()) {
+        QSqlQuery q(db);
+        if (!q.exec(query)) {
+            q.clear();
+            db.close();
+        }
+    }
+    return db.isOpen() || db.open();
+}
+
+/*!
+    \class QSqlConnectionPool
+    \brief The QSqlConnectionPool class keeps database connections open for reuse.
+    \since 6.4
+
+    \ingroup database
+    \inmodule QtSql
+
+    Opening a database connection is expensive, and a QSqlDatabase
+    connection can only be used in the thread that created it. A
+    QSqlConnectionPool hands out connections that are cloned from a
+    template connection, and takes them back for reuse when they are
+    no longer needed, so that a thread that serves many short requests
+    does not have to connect to the database for each of them.
+
+    \snippet code/src_sql_kernel_qsqlconnectionpool.cpp 0
+
+    acquire() returns a connection that was created in the calling thread
+    and is not in use, or clones a new one from the template connection
+    if there is none and maximumConnectionCount() has not been reached.
+    Otherwise it waits until another thread releases a connection. Pooled
+    connections are regular connections in the QSqlDatabase connection
+    list; their names start with the name of the template connection.
+    Release a connection with release() once done with it, after
+    finishing any transaction, and do not keep copies of the returned
+    QSqlDatabase afterwards.
+
+    Connections that are idle for longer than maximumIdleTime() are closed
+    and removed when the thread that owns them next uses the pool, as long
+    as more than minimumConnectionCount() connections exist. The idle
+    connections of threads that have finished are removed as well. A
+    thread that stops using the pool while it keeps running should call
+    removeIdleConnections().
+
+    If a validationQuery() is set, idle connections are checked with it
+    before they are handed out again, and reopened if it fails.
+
+    All functions of QSqlConnectionPool are thread-safe.
+
+    \sa QSqlDatabase::cloneDatabase(), {Threads and the SQL Module}
+*/
+
+/*!
+    Constructs a pool for connections that are cloned from the connection
+    called \a connectionName. The template connection does not need to be
+    open, and it is not used by the pool itself.
+*/
+QSqlConnectionPool::QSqlConnectionPool(const QString &connectionName)
+    : d(new QSqlConnectionPoolPrivate(connectionName))
+{
+}
+
+/*!
+    Destroys the pool and removes its idle connections. Connections that
+    are still in use are left alone.
+
+    The pool should be destroyed after the threads that use it finish.
+*/
+QSqlConnectionPool::~QSqlConnectionPool()
+{
+    QMutexLocker locker(&d->mutex);
+    if (!d->busy.isEmpty()) {
+        qWarning("QSqlConnectionPool: %d connection(s) of '%ls' are still in use",
+                 int(d->busy.size()), qUtf16Printable(d->connectionName));
+    }
+    QStringList names;
+    for (const QSqlConnectionPoolPrivate::IdleConnection &connection : std::as_const(d->idle))
+        names.append(connection.name);
+    d->idle.clear();
+    locker.unlock();
+
+    for (const QString &name : std::as_const(names))
+        QSqlDatabase::removeDatabase(name);
+    delete d;
+}
+
+/*!
+    Returns the name of the template connection.
+*/
+QString QSqlConnectionPool::connectionName() const
+{
+    return d->connectionName;
+}
+
+/*!
+    Sets the maximum number of connections of the pool, in use or idle and
+    across all threads, to \a count. The default is 16.
+
+    \sa acquire()
+*/
+void QSqlConnectionPool::setMaximumConnectionCount(int count)
+{
+    QMutexLocker locker(&d->mutex);
+    d->maximumConnectionCount = qMax(1, count);
+    d->connectionReleased.wakeAll();
+}
+
+int QSqlConnectionPool::maximumConnectionCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maximumConnectionCount;
+}
+
+/*!
+    Sets the number of connections that are kept open even if they are idle
+    for longer than maximumIdleTime() to \a count. The default is 0.
+*/
+void QSqlConnectionPool::setMinimumConnectionCount(int count)
+{
+    QMutexLocker locker(&d->mutex);
+    d->minimumConnectionCount = qMax(0, count);
+}
+
+int QSqlConnectionPool::minimumConnectionCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->minimumConnectionCount;
+}
+
+/*!
+    Sets the time after which idle connections are closed to \a msecs
+    milliseconds. The default is one minute.
+*/
+void QSqlConnectionPool::setMaximumIdleTime(int msecs)
+{
+    QMutexLocker locker(&d->mutex);
+    d->maximumIdleTime = qMax(0, msecs);
+}
+
+int QSqlConnectionPool::maximumIdleTime() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maximumIdleTime;
+}
+
+/*!
+    Sets the statement that idle connections are checked with before they
+    are handed out again to \a query, for example \c{SELECT 1}. By default
+    there is none, and connections are only checked for being open.
+*/
+void QSqlConnectionPool::setValidationQuery(const QString &query)
+{
+    QMutexLocker locker(&d->mutex);
+    d->validationQuery = query;
+}
+
+QString QSqlConnectionPool::validationQuery() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->validationQuery;
+}
+
+/*!
+    Returns the number of connections of the pool, in use or idle.
+*/
+int QSqlConnectionPool::connectionCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->connectionCount;
+}
+
+/*!
+    Returns the number of idle connections of the pool, in all threads.
+*/
+int QSqlConnectionPool::idleConnectionCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return int(d->idle.size());
+}
+
+/*!
+    Returns a connection for use in the calling thread, waiting until
+    \a deadline if the pool has reached maximumConnectionCount(). Returns
+    an invalid QSqlDatabase if the deadline expires first, or if the
+    template connection does not exist.
+
+    The connection is open, unless opening a new connection failed; check
+    QSqlDatabase::isOpen() and QSqlDatabase::lastError(). Either way it
+    must be given back with release().
+*/
+QSqlDatabase QSqlConnectionPool::acquire(QDeadlineTimer deadline)
+{
+    QThread *thread = QThread::currentThread();
+    QMutexLocker locker(&d->mutex);
+    forever {
+        const QStringList expired = d->takeExpiredConnections(thread, false);
+        if (!expired.isEmpty()) {
+            locker.unlock();
+            for (const QString &name : expired)
+                QSqlDatabase::removeDatabase(name);
+            locker.relock();
+            d->connectionReleased.wakeAll();
+        }
+
+        const QString idleName = d->takeIdleConnection(thread);
+        if (!idleName.isEmpty()) {
+            const QString query = d->validationQuery;
+            locker.unlock();
+            QSqlDatabase db = QSqlDatabase::database(idleName, false);
+            if (QSqlConnectionPoolPrivate::validate(db, query))
+                return db;
+            // Drop the broken connection and look again
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(idleName);
+            locker.relock();
+            d->busy.remove(idleName);
+            --d->connectionCount;
+            d->connectionReleased.wakeOne();
+            continue;
+        }
+
+        if (d->connectionCount < d->maximumConnectionCount) {
+            ++d->connectionCount;
+            const QString name = d->connectionName + QLatin1String("_pool_")
+                    + QString::number(++d->nameCounter);
+            d->busy.insert(name, thread);
+            locker.unlock();
+            QSqlDatabase db = QSqlDatabase::cloneDatabase(d->connectionName, name);
+            if (db.isValid()) {
+                db.open();
+                return db;
+            }
+            qWarning("QSqlConnectionPool::acquire: connection '%ls' does not exist",
+                     qUtf16Printable(d->connectionName));
+            locker.relock();
+            d->busy.remove(name);
+            --d->connectionCount;
+            d->connectionReleased.wakeOne();
+            return QSqlDatabase();
+        }
+
+        if (!d->connectionReleased.wait(&d->mutex, deadline))
+            return QSqlDatabase();
+    }
+}
+
+/*!
+    Gives the connection \a db, which was returned by acquire(), back to the
+    pool. It will only be handed out again in the thread that acquired it.
+*/
+void QSqlConnectionPool::release(const QSqlDatabase &db)
+{
+    const QString name = db.connectionName();
+    QMutexLocker locker(&d->mutex);
+    const auto it = d->busy.constFind(name);
+    if (it == d->busy.cend()) {
+        qWarning("QSqlConnectionPool::release: connection '%ls' is not in use from this pool",
+                 qUtf16Printable(name));
+        return;
+    }
+    QSqlConnectionPoolPrivate::IdleConnection connection{name, it.value(), QElapsedTimer()};
+    connection.idleTimer.start();
+    d->busy.erase(it);
+    d->idle.append(std::move(connection));
+    d->connectionReleased.wakeOne();
+}
+
+/*!
+    Closes and removes the idle connections that belong to the calling
+    thread, or to threads that have finished, regardless of
+    minimumConnectionCount().
+*/
+void QSqlConnectionPool::removeIdleConnections()
+{
+    QMutexLocker locker(&d->mutex);
+    const int minimum = std::exchange(d->minimumConnectionCount, 0);
+    const QStringList names = d->takeExpiredConnections(QThread::currentThread(), true);
+    d->minimumConnectionCount = minimum;
+    d->connectionReleased.wakeAll();
+    locker.unlock();
+
+    for (const QString &name : names)
+        QSqlDatabase::removeDatabase(name);
+}
+
+QT_END_NAMESPACE
@@ -1209,6 +1209,11 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li QSQLITE_ENABLE_SHARED_CACHE
     \li QSQLITE_ENABLE_REGEXP
     \li QSQLITE_NO_USE_EXTENDED_RESULT_CODES
+    \li QSQLITE_STATEMENT_CACHE_SIZE
+    \li QSQLITE_JOURNAL_MODE
+    \li QSQLITE_SYNCHRONOUS
+    \li QSQLITE_MMAP_SIZE
+    \li QSQLITE_CACHE_SIZE
     \endlist
 
     \li
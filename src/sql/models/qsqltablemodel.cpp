@@ -155,6 +155,17 @@ void QSqlTableModelPrivate::revertCachedRow(int row)
     }
 }
 
+/*
+    Returns \c true if submitting \a row can neither move the row nor
+    remove it from the model, so that selectRow() suffices to refresh it.
+*/
+bool QSqlTableModelPrivate::canRefreshInPlace(const ModifiedRow &row) const
+{
+    if (row.op() != Update || !filter.isEmpty())
+        return false;
+    return sortColumn < 0 || sortColumn >= row.rec().count() || !row.rec().isGenerated(sortColumn);
+}
+
 bool QSqlTableModelPrivate::exec(const QString &stmt, bool prepStatement,
                                  const QSqlRecord &rec, const QSqlRecord &whereValues)
 {
@@ -740,8 +751,12 @@ bool QSqlTableModel::deleteRowFromTable(int row)
     Returns \c false on error, detailed error information can be
     obtained with lastError().
 
-    In OnManualSubmit, on success the model will be repopulated.
-    Any views presenting it will lose their selections.
+    In OnManualSubmit, on success the model will be repopulated if rows
+    were inserted or deleted, or if an update may have moved a row or
+    removed it from the model because a filter is set or the sort column
+    was changed. Any views presenting it will lose their selections.
+    Otherwise, since Qt 6.4, the updated rows are refreshed in place from
+    the database, as in the other edit strategies.
 
     Note: In OnManualSubmit mode, already submitted changes won't
     be cleared from the cache when submitAll() fails. This allows
@@ -756,6 +771,12 @@ bool QSqlTableModel::submitAll()
 
     bool success = true;
 
+    bool needsSelect = false;
+    if (d->strategy == OnManualSubmit) {
+        for (auto it = d->cache.cbegin(); it != d->cache.cend() && !needsSelect; ++it)
+            needsSelect = !it->submitted() && !d->canRefreshInPlace(*it);
+    }
+
     const auto cachedKeys = d->cache.keys();
     for (int row : cachedKeys) {
         // be sure cache *still* contains the row since overridden selectRow() could have called select()
@@ -789,7 +810,7 @@ bool QSqlTableModel::submitAll()
                     mrow.setValue(c, d->editQuery.lastInsertId());
             }
             mrow.setSubmitted();
-            if (d->strategy != OnManualSubmit)
+            if (!needsSelect)
                 success = selectRow(row);
         }
 
@@ -797,10 +818,8 @@ bool QSqlTableModel::submitAll()
             break;
     }
 
-    if (success) {
-        if (d->strategy == OnManualSubmit)
-            success = select();
-    }
+    if (success && needsSelect)
+        success = select();
 
     return success;
 }
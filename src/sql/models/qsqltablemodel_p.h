@@ -186,6 +186,8 @@ public:
         bool m_insert;
     };
 
+    bool canRefreshInPlace(const ModifiedRow &row) const;
+
     typedef QMap<int, ModifiedRow> CacheMap;
     CacheMap cache;
 };
@@ -29,6 +29,11 @@ qt_feature("valgrind" PUBLIC
     PURPOSE "Profiling support with callgrind."
     CONDITION ( LINUX OR APPLE ) AND QT_FEATURE_process AND QT_FEATURE_regularexpression
 )
+qt_feature("benchmark_allocations" PUBLIC
+    LABEL "Benchmark allocation counting"
+    PURPOSE "Counts heap allocations in benchmarks through a preloaded library that interposes the C allocation functions."
+    CONDITION QT_FEATURE_glibc AND QT_FEATURE_shared AND NOT QT_FEATURE_sanitize_address AND NOT QT_FEATURE_sanitize_thread AND NOT QT_FEATURE_sanitize_memory
+)
 qt_configure_add_summary_section(NAME "Qt Testlib")
 qt_configure_add_summary_entry(ARGS "itemmodeltester")
 qt_configure_end_summary_section() # end of "Qt Testlib" section
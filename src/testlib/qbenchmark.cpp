@@ -41,11 +41,19 @@
 #include <QtTest/private/qbenchmark_p.h>
 #include <QtTest/private/qbenchmarkmetric_p.h>
 #include <QtTest/private/qbenchmarktimemeasurers_p.h>
+#include <QtTest/private/qtestresult_p.h>
 
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qset.h>
 #include <QtCore/qdebug.h>
 
+#include <algorithm>
+#include <cmath>
+
 QT_BEGIN_NAMESPACE
 
 QBenchmarkGlobalData *QBenchmarkGlobalData::current;
@@ -85,6 +93,10 @@ QBenchmarkMeasurerBase * QBenchmarkGlobalData::createMeasurer()
 #ifdef HAVE_TICK_COUNTER
     } else if (mode_ == TickCounter) {
         measurer = new QBenchmarkTickMeasurer;
+#endif
+#if QT_CONFIG(benchmark_allocations)
+    } else if (mode_ == AllocationCounter) {
+        measurer = new QBenchmarkAllocationMeasurer;
 #endif
     } else if (mode_ == EventCounter) {
         measurer = new QBenchmarkEvent;
@@ -101,6 +113,134 @@ int QBenchmarkGlobalData::adjustMedianIterationCount()
         ? medianIterationCount : measurer->adjustMedianCount(1);
 }
 
+int QBenchmarkGlobalData::adjustWarmupIterationCount()
+{
+    // Let the -warmup option override the measurer.
+    if (warmupIterationCount != -1)
+        return warmupIterationCount;
+    return measurer->needsWarmupIteration() ? 1 : 0;
+}
+
+static QString currentBaselineKey()
+{
+    const char *fn = QTestResult::currentTestFunction() ? QTestResult::currentTestFunction()
+        : "UnknownTestFunc";
+    const char *tag = QTestResult::currentDataTag() ? QTestResult::currentDataTag() : "";
+    const char *gtag = QTestResult::currentGlobalDataTag()
+                     ? QTestResult::currentGlobalDataTag()
+                     : "";
+    const char *filler = (tag[0] && gtag[0]) ? ":" : "";
+    return QString::fromUtf8(fn) + QLatin1Char('/') + QString::fromUtf8(gtag)
+            + QLatin1String(filler) + QString::fromUtf8(tag);
+}
+
+/*
+    Reads the results of an earlier run, as written by the JSON logger, for
+    compareWithBaseline(). Returns false if fileName cannot be read or is
+    not such a document.
+*/
+bool QBenchmarkGlobalData::loadBaseline(const char *fileName)
+{
+    QFile file(QString::fromLocal8Bit(fileName));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+    if (!document.isObject())
+        return false;
+
+    const QJsonArray results = document.object().value(QLatin1String("results")).toArray();
+    for (const QJsonValue &value : results) {
+        const QJsonObject object = value.toObject();
+        QBenchmarkStatistics statistics;
+        statistics.samples = object.value(QLatin1String("samples")).toInt(1);
+        statistics.minimum = object.value(QLatin1String("minimum")).toDouble();
+        statistics.median = object.value(QLatin1String("median")).toDouble();
+        statistics.p90 = object.value(QLatin1String("p90")).toDouble();
+        statistics.maximum = object.value(QLatin1String("maximum")).toDouble();
+        statistics.stddev = object.value(QLatin1String("stddev")).toDouble();
+        baseline.insert(object.value(QLatin1String("function")).toString() + QLatin1Char('/')
+                        + object.value(QLatin1String("tag")).toString() + QLatin1Char('/')
+                        + object.value(QLatin1String("metric")).toString(), statistics);
+    }
+    return true;
+}
+
+/*
+    Compares result with the baseline entry of the current test function,
+    data tag and result.metric. Returns a description of the regression if the median got
+    worse by more than baselineThreshold percent and, when both sides have
+    more than one sample, by more than twice the standard error of the
+    difference. Returns an empty byte array otherwise.
+*/
+QByteArray QBenchmarkGlobalData::compareWithBaseline(const QBenchmarkResult &result) const
+{
+    if (baseline.isEmpty())
+        return QByteArray();
+
+    const auto it = baseline.constFind(currentBaselineKey() + QLatin1Char('/')
+                                       + QLatin1String(QTest::benchmarkMetricName(result.metric)));
+    if (it == baseline.constEnd())
+        return QByteArray();
+
+    const QBenchmarkStatistics &base = *it;
+    const QBenchmarkStatistics &current = result.statistics;
+    if (base.median <= 0)
+        return QByteArray();
+
+    // For rates, bigger is better; for everything else, smaller is.
+    const bool higherIsBetter = result.metric == QTest::FramesPerSecond
+            || result.metric == QTest::BitsPerSecond
+            || result.metric == QTest::BytesPerSecond;
+    const qreal delta = higherIsBetter ? base.median - current.median
+                                       : current.median - base.median;
+    const qreal change = 100 * delta / base.median;
+    if (change <= baselineThreshold)
+        return QByteArray();
+
+    if (base.samples > 1 && current.samples > 1) {
+        const qreal standardError =
+                std::sqrt(base.stddev * base.stddev / base.samples
+                          + current.stddev * current.stddev / current.samples);
+        if (delta <= 2 * standardError)
+            return QByteArray();
+    }
+
+    return QString::fromLatin1("Benchmark regression: median %1 %2 per iteration, "
+                               "baseline %3 (%4% worse)")
+            .arg(current.median).arg(QLatin1String(QTest::benchmarkMetricUnit(result.metric)))
+            .arg(base.median).arg(change, 0, 'f', 1).toLocal8Bit();
+}
+
+QBenchmarkStatistics QBenchmarkStatistics::fromSamples(QList<qreal> samples)
+{
+    QBenchmarkStatistics statistics;
+    statistics.samples = samples.size();
+    if (samples.isEmpty())
+        return statistics;
+
+    std::sort(samples.begin(), samples.end());
+    const qsizetype count = samples.size();
+    statistics.minimum = samples.first();
+    statistics.maximum = samples.last();
+    statistics.median = count % 2 ? samples.at(count / 2)
+                                  : (samples.at(count / 2 - 1) + samples.at(count / 2)) / 2;
+    // nearest-rank percentile
+    statistics.p90 = samples.at(qMax(qsizetype(std::ceil(0.9 * count)) - 1, qsizetype(0)));
+
+    if (count > 1) {
+        qreal mean = 0;
+        for (qreal sample : std::as_const(samples))
+            mean += sample;
+        mean /= count;
+        qreal sumOfSquares = 0;
+        for (qreal sample : std::as_const(samples))
+            sumOfSquares += (sample - mean) * (sample - mean);
+        statistics.stddev = std::sqrt(sumOfSquares / (count - 1));
+    }
+    return statistics;
+}
+
 
 QBenchmarkTestMethodData *QBenchmarkTestMethodData::current;
 
@@ -162,6 +302,9 @@ void QBenchmarkTestMethodData::setResult(
 
     this->result = QBenchmarkResult(
         QBenchmarkGlobalData::current->context, value, iterationCount, metric, setByMacro);
+    if (setByMacro)
+        this->result.secondaryMeasurements =
+                QBenchmarkGlobalData::current->measurer->secondaryMeasurements();
 }
 
 /*!
@@ -62,6 +62,8 @@
 #endif
 
 #include <QtTest/private/qbenchmarkmeasurement_p.h>
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QMap>
 #include <QtTest/qttestglobal.h>
 #if QT_CONFIG(valgrind)
@@ -70,6 +72,9 @@
 #ifdef QTESTLIB_USE_PERF_EVENTS
 #include <QtTest/private/qbenchmarkperfevents_p.h>
 #endif
+#if QT_CONFIG(benchmark_allocations)
+#include <QtTest/private/qbenchmarkallocations_p.h>
+#endif
 #include <QtTest/private/qbenchmarkevent_p.h>
 #include <QtTest/private/qbenchmarkmetric_p.h>
 
@@ -93,6 +98,24 @@ struct QBenchmarkContext
 };
 Q_DECLARE_TYPEINFO(QBenchmarkContext, Q_RELOCATABLE_TYPE);
 
+/*
+    Dispersion of the per-iteration values measured over the median
+    iterations of one benchmark. With the default of a single median
+    iteration, samples is 1 and stddev is 0.
+*/
+struct QBenchmarkStatistics
+{
+    int samples = 0;
+    qreal minimum = 0;
+    qreal median = 0;
+    qreal p90 = 0;
+    qreal maximum = 0;
+    qreal stddev = 0;
+
+    static QBenchmarkStatistics fromSamples(QList<qreal> samples);
+};
+Q_DECLARE_TYPEINFO(QBenchmarkStatistics, Q_PRIMITIVE_TYPE);
+
 class QBenchmarkResult
 {
 public:
@@ -102,6 +125,8 @@ public:
     QTest::QBenchmarkMetric metric = QTest::FramesPerSecond;
     bool setByMacro = true;
     bool valid = false;
+    QBenchmarkStatistics statistics;
+    QList<QBenchmarkMeasurerBase::Measurement> secondaryMeasurements;
 
     QBenchmarkResult() = default;
 
@@ -135,21 +160,31 @@ public:
 
     QBenchmarkGlobalData();
     ~QBenchmarkGlobalData();
-    enum Mode { WallTime, CallgrindParentProcess, CallgrindChildProcess, PerfCounter, TickCounter, EventCounter };
+    enum Mode { WallTime, CallgrindParentProcess, CallgrindChildProcess, PerfCounter, TickCounter, EventCounter,
+                AllocationCounter };
     void setMode(Mode mode);
     Mode mode() const { return mode_; }
     QBenchmarkMeasurerBase *createMeasurer();
     int adjustMedianIterationCount();
+    int adjustWarmupIterationCount();
+
+    bool loadBaseline(const char *fileName);
+    QByteArray compareWithBaseline(const QBenchmarkResult &result) const;
 
     QBenchmarkMeasurerBase *measurer = nullptr;
     QBenchmarkContext context;
     int walltimeMinimum = -1;
     int iterationCount = -1;
     int medianIterationCount = -1;
+    int warmupIterationCount = -1;
+    qreal baselineThreshold = 5; // percent
     bool createChart = false;
     bool verboseOutput = false;
     QString callgrindOutFileBase;
     int minimumTotal = -1;
+
+    // keyed by "function/[globaltag:]tag/metric", as written by the JSON logger
+    QHash<QString, QBenchmarkStatistics> baseline;
 private:
     Mode mode_ = WallTime;
 };
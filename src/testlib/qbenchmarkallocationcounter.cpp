@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtTest module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/private/qbenchmarkallocationcounter_p.h>
+
+#include <errno.h>
+#include <malloc.h>
+#include <stdlib.h>
+
+/*
+    This is the allocation counter library, which QtTest's -allocations option
+    needs. It is never linked to QtTest itself: defining malloc() and friends
+    replaces them for the whole process, so only benchmarks that preload this
+    library or link to it get them.
+
+    The definitions forward to glibc's __libc_malloc() and friends, and only
+    do the bookkeeping while a measurement is running. All allocation entry
+    points that glibc provides are defined, so that no block can be allocated
+    by one allocator and freed by another when a different malloc library is
+    loaded after this one. Memory obtained through mmap() or a custom allocator
+    is not counted. Sizes for the heap growth are those reported by
+    malloc_usable_size().
+*/
+
+extern "C" {
+void *__libc_malloc(size_t size) noexcept;
+void *__libc_calloc(size_t count, size_t size) noexcept;
+void *__libc_realloc(void *ptr, size_t size) noexcept;
+void *__libc_memalign(size_t alignment, size_t size) noexcept;
+void *__libc_valloc(size_t size) noexcept;
+void *__libc_pvalloc(size_t size) noexcept;
+void __libc_free(void *ptr) noexcept;
+}
+
+QT_USE_NAMESPACE
+
+namespace {
+QBenchmarkAllocationCounters counters;
+
+void countAllocation(void *ptr, size_t requested)
+{
+    if (!ptr)
+        return;
+    counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    counters.bytesAllocated.fetch_add(qint64(requested), std::memory_order_relaxed);
+    const qint64 size = qint64(malloc_usable_size(ptr));
+    const qint64 current = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    qint64 peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (current > peak
+           && !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+void countRelease(void *ptr)
+{
+    if (ptr)
+        counters.currentBytes.fetch_sub(qint64(malloc_usable_size(ptr)), std::memory_order_relaxed);
+}
+
+inline bool isCounting()
+{
+    return counters.counting.load(std::memory_order_relaxed);
+}
+} // unnamed namespace
+
+extern "C" {
+
+Q_DECL_EXPORT QBenchmarkAllocationCounters *qt_benchmark_allocation_counters()
+{
+    return &counters;
+}
+
+Q_DECL_EXPORT void *malloc(size_t size) noexcept
+{
+    void *ptr = __libc_malloc(size);
+    if (isCounting())
+        countAllocation(ptr, size);
+    return ptr;
+}
+
+Q_DECL_EXPORT void *calloc(size_t count, size_t size) noexcept
+{
+    void *ptr = __libc_calloc(count, size);
+    if (isCounting())
+        countAllocation(ptr, count * size);
+    return ptr;
+}
+
+Q_DECL_EXPORT void *realloc(void *ptr, size_t size) noexcept
+{
+    if (!isCounting())
+        return __libc_realloc(ptr, size);
+
+    const qint64 oldSize = ptr ? qint64(malloc_usable_size(ptr)) : 0;
+    void *result = __libc_realloc(ptr, size);
+    if (result || size == 0) {
+        counters.currentBytes.fetch_sub(oldSize, std::memory_order_relaxed);
+        countAllocation(result, size);
+    }
+    return result;
+}
+
+Q_DECL_EXPORT void *reallocarray(void *ptr, size_t count, size_t size) noexcept
+{
+    size_t total;
+    if (__builtin_mul_overflow(count, size, &total)) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+    return realloc(ptr, total);
+}
+
+Q_DECL_EXPORT void free(void *ptr) noexcept
+{
+    if (isCounting())
+        countRelease(ptr);
+    __libc_free(ptr);
+}
+
+Q_DECL_EXPORT void *memalign(size_t alignment, size_t size) noexcept
+{
+    void *ptr = __libc_memalign(alignment, size);
+    if (isCounting())
+        countAllocation(ptr, size);
+    return ptr;
+}
+
+Q_DECL_EXPORT void *aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    return memalign(alignment, size);
+}
+
+Q_DECL_EXPORT int posix_memalign(void **ptr, size_t alignment, size_t size) noexcept
+{
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    void *result = memalign(alignment, size);
+    if (!result && size)
+        return ENOMEM;
+    *ptr = result;
+    return 0;
+}
+
+Q_DECL_EXPORT void *valloc(size_t size) noexcept
+{
+    void *ptr = __libc_valloc(size);
+    if (isCounting())
+        countAllocation(ptr, size);
+    return ptr;
+}
+
+Q_DECL_EXPORT void *pvalloc(size_t size) noexcept
+{
+    void *ptr = __libc_pvalloc(size);
+    if (isCounting())
+        countAllocation(ptr, size);
+    return ptr;
+}
+
+} // extern "C"
@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtTest module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/private/qbenchmarkallocations_p.h>
+#include <QtTest/private/qbenchmarkallocationcounter_p.h>
+
+#include <dlfcn.h>
+
+// This class does not exist in the API so it's qdoc comment marker was removed.
+
+/*
+    \class QBenchmarkAllocationMeasurer
+    \brief The heap allocation benchmark backend
+
+    This benchmark backend counts the heap allocations made by all threads
+    of the process between start() and stop(), the bytes requested by them,
+    and the peak growth of the heap above its size at start().
+
+    The counting is done by the allocation counter library,
+    libQt6TestAllocationCounter, which defines malloc() and friends. QtTest
+    does not link to it, since that would replace the allocation functions
+    of every process using QtTest; benchmarks are run with the library in
+    LD_PRELOAD or linked to it, and this class finds its counters at run
+    time.
+*/
+
+QT_BEGIN_NAMESPACE
+
+static QBenchmarkAllocationCounters *allocationCounters()
+{
+    using CountersFunction = QBenchmarkAllocationCounters *(*)();
+    static QBenchmarkAllocationCounters *const counters = [] {
+        const auto function = reinterpret_cast<CountersFunction>(
+                dlsym(RTLD_DEFAULT, QBENCHMARK_ALLOCATION_COUNTERS_SYMBOL));
+        return function ? function() : nullptr;
+    }();
+    return counters;
+}
+
+// Returns whether the allocation counter library is loaded into the process
+bool QBenchmarkAllocationMeasurer::isAvailable()
+{
+    return allocationCounters() != nullptr;
+}
+
+QBenchmarkAllocationMeasurer::QBenchmarkAllocationMeasurer() = default;
+
+QBenchmarkAllocationMeasurer::~QBenchmarkAllocationMeasurer() = default;
+
+void QBenchmarkAllocationMeasurer::start()
+{
+    QBenchmarkAllocationCounters *counters = allocationCounters();
+    Q_ASSERT(counters);
+    counters->allocationCount.store(0, std::memory_order_relaxed);
+    counters->bytesAllocated.store(0, std::memory_order_relaxed);
+    counters->currentBytes.store(0, std::memory_order_relaxed);
+    counters->peakBytes.store(0, std::memory_order_relaxed);
+    counters->counting.store(true, std::memory_order_release);
+}
+
+qint64 QBenchmarkAllocationMeasurer::checkpoint()
+{
+    return allocationCounters()->allocationCount.load(std::memory_order_relaxed);
+}
+
+qint64 QBenchmarkAllocationMeasurer::stop()
+{
+    QBenchmarkAllocationCounters *counters = allocationCounters();
+    counters->counting.store(false, std::memory_order_release);
+    return counters->allocationCount.load(std::memory_order_relaxed);
+}
+
+// Allocation counts are exact, and zero is a valid result: accept everything
+bool QBenchmarkAllocationMeasurer::isMeasurementAccepted(qint64 measurement)
+{
+    Q_UNUSED(measurement);
+    return true;
+}
+
+int QBenchmarkAllocationMeasurer::adjustIterationCount(int suggestion)
+{
+    return suggestion;
+}
+
+int QBenchmarkAllocationMeasurer::adjustMedianCount(int suggestion)
+{
+    Q_UNUSED(suggestion);
+    return 1;
+}
+
+QTest::QBenchmarkMetric QBenchmarkAllocationMeasurer::metricType()
+{
+    return QTest::Allocations;
+}
+
+QList<QBenchmarkMeasurerBase::Measurement> QBenchmarkAllocationMeasurer::secondaryMeasurements()
+{
+    QBenchmarkAllocationCounters *counters = allocationCounters();
+    return {
+        { qreal(counters->bytesAllocated.load(std::memory_order_relaxed)), QTest::BytesAllocated },
+        { qreal(counters->peakBytes.load(std::memory_order_relaxed)), QTest::PeakBytesAllocated },
+    };
+}
+
+QT_END_NAMESPACE
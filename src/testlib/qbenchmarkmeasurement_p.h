@@ -52,12 +52,19 @@
 //
 
 #include <QtTest/qbenchmark.h>
+#include <QtCore/qlist.h>
 
 QT_BEGIN_NAMESPACE
 
 class QBenchmarkMeasurerBase
 {
 public:
+    struct Measurement
+    {
+        qreal value;
+        QTest::QBenchmarkMetric metric;
+    };
+
     virtual ~QBenchmarkMeasurerBase() = default;
     virtual void init() {}
     virtual void start() = 0;
@@ -69,7 +76,11 @@ public:
     virtual bool repeatCount() { return true; }
     virtual bool needsWarmupIteration() { return false; }
     virtual QTest::QBenchmarkMetric metricType() = 0;
+    // Further values taken by the last start()/stop() pair, reported
+    // alongside the one stop() returned
+    virtual QList<Measurement> secondaryMeasurements() { return {}; }
 };
+Q_DECLARE_TYPEINFO(QBenchmarkMeasurerBase::Measurement, Q_PRIMITIVE_TYPE);
 
 QT_END_NAMESPACE
 
@@ -80,6 +80,8 @@ enum QBenchmarkMetric {
     AlignmentFaults,
     EmulationFaults,
     RefCPUCycles,
+    Allocations,
+    PeakBytesAllocated,
 };
 
 }
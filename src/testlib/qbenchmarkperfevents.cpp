@@ -41,6 +41,8 @@
 #include "qbenchmarkmetric.h"
 #include "qbenchmark_p.h"
 
+#include <QtCore/qvarlengtharray.h>
+
 #ifdef QTESTLIB_USE_PERF_EVENTS
 
 // include the qcore_unix_p.h without core-private
@@ -84,6 +86,7 @@
 QT_BEGIN_NAMESPACE
 
 static perf_event_attr attr;
+static QList<perf_event_attr> memberAttrs;
 
 static void initPerf()
 {
@@ -181,14 +184,14 @@ bool QBenchmarkPerfEventsMeasurer::isAvailable()
    HW_CACHE     LLC_READ                CacheReads      llc-cache-reads llc-cache-loads llc-loads llc-reads
    HW_CACHE     LLC_WRITE               CacheWrites     llc-cache-writes llc-cache-stores llc-writes llc-stores
    HW_CACHE     LLC_PREFETCH            CachePrefetches llc-cache-prefetches llc-prefetches
-   HW_CACHE     L1D_READ_MISS           CacheReads      l1d-cache-read-misses l1d-cache-load-misses l1d-read-misses l1d-load-misses
-   HW_CACHE     L1D_WRITE_MISS          CacheWrites     l1d-cache-write-misses l1d-cache-store-misses l1d-write-misses l1d-store-misses
-   HW_CACHE     L1D_PREFETCH_MISS       CachePrefetches l1d-cache-prefetch-misses l1d-prefetch-misses
-   HW_CACHE     L1I_READ_MISS           CacheReads      l1i-cache-read-misses l1i-cache-load-misses l1i-read-misses l1i-load-misses
-   HW_CACHE     L1I_PREFETCH_MISS       CachePrefetches l1i-cache-prefetch-misses l1i-prefetch-misses
-   HW_CACHE     LLC_READ_MISS           CacheReads      llc-cache-read-misses llc-cache-load-misses llc-read-misses llc-load-misses
-   HW_CACHE     LLC_WRITE_MISS          CacheWrites     llc-cache-write-misses llc-cache-store-misses llc-write-misses llc-store-misses
-   HW_CACHE     LLC_PREFETCH_MISS       CachePrefetches llc-cache-prefetch-misses llc-prefetch-misses
+   HW_CACHE     L1D_READ_MISS           CacheReadMisses      l1d-cache-read-misses l1d-cache-load-misses l1d-read-misses l1d-load-misses
+   HW_CACHE     L1D_WRITE_MISS          CacheWriteMisses     l1d-cache-write-misses l1d-cache-store-misses l1d-write-misses l1d-store-misses
+   HW_CACHE     L1D_PREFETCH_MISS       CachePrefetchMisses l1d-cache-prefetch-misses l1d-prefetch-misses
+   HW_CACHE     L1I_READ_MISS           CacheReadMisses      l1i-cache-read-misses l1i-cache-load-misses l1i-read-misses l1i-load-misses
+   HW_CACHE     L1I_PREFETCH_MISS       CachePrefetchMisses l1i-cache-prefetch-misses l1i-prefetch-misses
+   HW_CACHE     LLC_READ_MISS           CacheReadMisses      llc-cache-read-misses llc-cache-load-misses llc-read-misses llc-load-misses
+   HW_CACHE     LLC_WRITE_MISS          CacheWriteMisses     llc-cache-write-misses llc-cache-store-misses llc-write-misses llc-store-misses
+   HW_CACHE     LLC_PREFETCH_MISS       CachePrefetchMisses llc-cache-prefetch-misses llc-prefetch-misses
    HW_CACHE     BRANCH_READ             BranchInstructions branch-reads branch-loads branch-predicts
    HW_CACHE     BRANCH_READ_MISS        BranchMisses    branch-mispredicts branch-read-misses branch-load-misses
 
@@ -355,57 +358,57 @@ static const Events eventlist[] = {
     { 287, PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND, QTest::StalledCycles },
     { 307, PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND, QTest::StalledCycles },
     { 328, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, QTest::Instructions },
-    { 341, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReads },
+    { 341, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReadMisses },
     { 363, PERF_TYPE_HW_CACHE, CACHE_L1D_READ, QTest::CacheReads },
-    { 379, PERF_TYPE_HW_CACHE, CACHE_L1D_PREFETCH_MISS, QTest::CachePrefetches },
+    { 379, PERF_TYPE_HW_CACHE, CACHE_L1D_PREFETCH_MISS, QTest::CachePrefetchMisses },
     { 405, PERF_TYPE_HW_CACHE, CACHE_L1D_PREFETCH, QTest::CachePrefetches },
-    { 426, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReads },
+    { 426, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReadMisses },
     { 448, PERF_TYPE_HW_CACHE, CACHE_L1D_READ, QTest::CacheReads },
-    { 464, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWrites },
+    { 464, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWriteMisses },
     { 487, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE, QTest::CacheWrites },
-    { 504, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWrites },
+    { 504, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWriteMisses },
     { 527, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE, QTest::CacheWrites },
-    { 544, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReads },
+    { 544, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReadMisses },
     { 560, PERF_TYPE_HW_CACHE, CACHE_L1D_READ, QTest::CacheReads },
-    { 570, PERF_TYPE_HW_CACHE, CACHE_L1D_PREFETCH_MISS, QTest::CachePrefetches },
+    { 570, PERF_TYPE_HW_CACHE, CACHE_L1D_PREFETCH_MISS, QTest::CachePrefetchMisses },
     { 590, PERF_TYPE_HW_CACHE, CACHE_L1D_PREFETCH, QTest::CachePrefetches },
-    { 605, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReads },
+    { 605, PERF_TYPE_HW_CACHE, CACHE_L1D_READ_MISS, QTest::CacheReadMisses },
     { 621, PERF_TYPE_HW_CACHE, CACHE_L1D_READ, QTest::CacheReads },
-    { 631, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWrites },
+    { 631, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWriteMisses },
     { 648, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE, QTest::CacheWrites },
-    { 659, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWrites },
+    { 659, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE_MISS, QTest::CacheWriteMisses },
     { 676, PERF_TYPE_HW_CACHE, CACHE_L1D_WRITE, QTest::CacheWrites },
-    { 687, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReads },
+    { 687, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReadMisses },
     { 709, PERF_TYPE_HW_CACHE, CACHE_L1I_READ, QTest::CacheReads },
-    { 725, PERF_TYPE_HW_CACHE, CACHE_L1I_PREFETCH_MISS, QTest::CachePrefetches },
+    { 725, PERF_TYPE_HW_CACHE, CACHE_L1I_PREFETCH_MISS, QTest::CachePrefetchMisses },
     { 751, PERF_TYPE_HW_CACHE, CACHE_L1I_PREFETCH, QTest::CachePrefetches },
-    { 772, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReads },
+    { 772, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReadMisses },
     { 794, PERF_TYPE_HW_CACHE, CACHE_L1I_READ, QTest::CacheReads },
-    { 810, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReads },
+    { 810, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReadMisses },
     { 826, PERF_TYPE_HW_CACHE, CACHE_L1I_READ, QTest::CacheReads },
-    { 836, PERF_TYPE_HW_CACHE, CACHE_L1I_PREFETCH_MISS, QTest::CachePrefetches },
+    { 836, PERF_TYPE_HW_CACHE, CACHE_L1I_PREFETCH_MISS, QTest::CachePrefetchMisses },
     { 856, PERF_TYPE_HW_CACHE, CACHE_L1I_PREFETCH, QTest::CachePrefetches },
-    { 871, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReads },
+    { 871, PERF_TYPE_HW_CACHE, CACHE_L1I_READ_MISS, QTest::CacheReadMisses },
     { 887, PERF_TYPE_HW_CACHE, CACHE_L1I_READ, QTest::CacheReads },
-    { 897, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReads },
+    { 897, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReadMisses },
     { 919, PERF_TYPE_HW_CACHE, CACHE_LLC_READ, QTest::CacheReads },
-    { 935, PERF_TYPE_HW_CACHE, CACHE_LLC_PREFETCH_MISS, QTest::CachePrefetches },
+    { 935, PERF_TYPE_HW_CACHE, CACHE_LLC_PREFETCH_MISS, QTest::CachePrefetchMisses },
     { 961, PERF_TYPE_HW_CACHE, CACHE_LLC_PREFETCH, QTest::CachePrefetches },
-    { 982, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReads },
+    { 982, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReadMisses },
     { 1004, PERF_TYPE_HW_CACHE, CACHE_LLC_READ, QTest::CacheReads },
-    { 1020, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWrites },
+    { 1020, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWriteMisses },
     { 1043, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE, QTest::CacheWrites },
-    { 1060, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWrites },
+    { 1060, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWriteMisses },
     { 1083, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE, QTest::CacheWrites },
-    { 1100, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReads },
+    { 1100, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReadMisses },
     { 1116, PERF_TYPE_HW_CACHE, CACHE_LLC_READ, QTest::CacheReads },
-    { 1126, PERF_TYPE_HW_CACHE, CACHE_LLC_PREFETCH_MISS, QTest::CachePrefetches },
+    { 1126, PERF_TYPE_HW_CACHE, CACHE_LLC_PREFETCH_MISS, QTest::CachePrefetchMisses },
     { 1146, PERF_TYPE_HW_CACHE, CACHE_LLC_PREFETCH, QTest::CachePrefetches },
-    { 1161, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReads },
+    { 1161, PERF_TYPE_HW_CACHE, CACHE_LLC_READ_MISS, QTest::CacheReadMisses },
     { 1177, PERF_TYPE_HW_CACHE, CACHE_LLC_READ, QTest::CacheReads },
-    { 1187, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWrites },
+    { 1187, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWriteMisses },
     { 1204, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE, QTest::CacheWrites },
-    { 1215, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWrites },
+    { 1215, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE_MISS, QTest::CacheWriteMisses },
     { 1232, PERF_TYPE_HW_CACHE, CACHE_LLC_WRITE, QTest::CacheWrites },
     { 1243, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MAJ, QTest::MajorPageFaults },
     { 1256, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS, QTest::CPUMigrations },
@@ -429,44 +432,43 @@ QTest::QBenchmarkMetric QBenchmarkPerfEventsMeasurer::metricForEvent(quint32 typ
     return QTest::Events;
 }
 
-void QBenchmarkPerfEventsMeasurer::setCounter(const char *name)
+static void parseCounter(const char *name, size_t length, perf_event_attr *counter)
 {
-    initPerf();
-    const char *colon = strchr(name, ':');
-    int n = colon ? colon - name : strlen(name);
+    const char *colon = static_cast<const char *>(memchr(name, ':', length));
+    int n = colon ? colon - name : int(length);
     const Events *ptr = eventlist;
     for ( ; ptr->type != PERF_TYPE_MAX; ++ptr) {
         int c = strncmp(name, eventlist_strings + ptr->offset, n);
         if (c == 0)
             break;
         if (c < 0) {
-            fprintf(stderr, "ERROR: Performance counter type '%s' is unknown\n", name);
+            fprintf(stderr, "ERROR: Performance counter type '%.*s' is unknown\n", int(length), name);
             exit(1);
         }
     }
 
-    attr.type = ptr->type;
-    attr.config = ptr->event_id;
+    counter->type = ptr->type;
+    counter->config = ptr->event_id;
 
     // now parse the attributes
     if (!colon)
         return;
-    while (*++colon) {
+    while (++colon < name + length) {
         switch (*colon) {
         case 'u':
-            attr.exclude_user = true;
+            counter->exclude_user = true;
             break;
         case 'k':
-            attr.exclude_kernel = true;
+            counter->exclude_kernel = true;
             break;
         case 'h':
-            attr.exclude_hv = true;
+            counter->exclude_hv = true;
             break;
         case 'G':
-            attr.exclude_guest = true;
+            counter->exclude_guest = true;
             break;
         case 'H':
-            attr.exclude_host = true;
+            counter->exclude_host = true;
             break;
         default:
             fprintf(stderr, "ERROR: Unknown attribute '%c'\n", *colon);
@@ -475,6 +477,61 @@ void QBenchmarkPerfEventsMeasurer::setCounter(const char *name)
     }
 }
 
+/*
+    Selects the counter to measure. A comma-separated list selects a group:
+    the first counter is the group leader and provides the benchmark result,
+    the others are read together with it and reported alongside. The kernel
+    schedules a group onto the PMU as a whole, so all of its counters cover
+    the same time, multiplexed with other groups if there are not enough
+    hardware counters.
+*/
+void QBenchmarkPerfEventsMeasurer::setCounter(const char *name)
+{
+    initPerf();
+    memberAttrs.clear();
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.inherit = attr.inherit_stat = true;
+
+    const char *comma = strchr(name, ',');
+    parseCounter(name, comma ? size_t(comma - name) : strlen(name), &attr);
+    while (comma) {
+        name = comma + 1;
+        comma = strchr(name, ',');
+        perf_event_attr member = attr;
+        member.exclude_user = member.exclude_kernel = member.exclude_hv = false;
+        member.exclude_guest = member.exclude_host = false;
+        parseCounter(name, comma ? size_t(comma - name) : strlen(name), &member);
+
+        // the results are told apart by their metric
+        const QTest::QBenchmarkMetric metric = metricForEvent(member.type, member.config);
+        bool duplicate = metric == metricForEvent(attr.type, attr.config);
+        for (const perf_event_attr &other : std::as_const(memberAttrs))
+            duplicate = duplicate || metric == metricForEvent(other.type, other.config);
+        if (duplicate) {
+            fprintf(stderr, "ERROR: Performance counter '%.*s' measures the same metric as an "
+                            "earlier one in the group\n",
+                    comma ? int(comma - name) : int(strlen(name)), name);
+            exit(1);
+        }
+
+        // only the leader can be pinned and enables or disables the group
+        member.pinned = false;
+        member.disabled = false;
+        memberAttrs.append(member);
+    }
+
+    if (!memberAttrs.isEmpty()) {
+        // Group reads are not supported for inherited counters, so a group
+        // only measures the benchmark's own process
+        attr.read_format |= PERF_FORMAT_GROUP;
+        attr.inherit = attr.inherit_stat = false;
+        for (perf_event_attr &member : memberAttrs) {
+            member.read_format = attr.read_format;
+            member.inherit = member.inherit_stat = false;
+        }
+    }
+}
+
 void QBenchmarkPerfEventsMeasurer::listCounters()
 {
     if (!isAvailable()) {
@@ -504,6 +561,8 @@ QBenchmarkPerfEventsMeasurer::QBenchmarkPerfEventsMeasurer() = default;
 
 QBenchmarkPerfEventsMeasurer::~QBenchmarkPerfEventsMeasurer()
 {
+    for (int memberFd : std::as_const(memberFds))
+        qt_safe_close(memberFd);
     qt_safe_close(fd);
 }
 
@@ -527,28 +586,51 @@ void QBenchmarkPerfEventsMeasurer::start()
         } else {
             ::fcntl(fd, F_SETFD, FD_CLOEXEC);
         }
+
+        // the rest of the group, if any, follows the leader
+        for (perf_event_attr &member : memberAttrs) {
+            int memberFd = perf_event_open(&member, 0, -1, fd, 0);
+            if (memberFd == -1) {
+                perror("QBenchmarkPerfEventsMeasurer::start: perf_event_open");
+                exit(1);
+            }
+            ::fcntl(memberFd, F_SETFD, FD_CLOEXEC);
+            memberFds.append(memberFd);
+        }
     }
 
-    // enable the counter
-    ::ioctl(fd, PERF_EVENT_IOC_RESET);
-    ::ioctl(fd, PERF_EVENT_IOC_ENABLE);
+    // enable the counters
+    ::ioctl(fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
 }
 
 qint64 QBenchmarkPerfEventsMeasurer::checkpoint()
 {
-    ::ioctl(fd, PERF_EVENT_IOC_DISABLE);
+    ::ioctl(fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
     qint64 value = readValue();
-    ::ioctl(fd, PERF_EVENT_IOC_ENABLE);
+    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
     return value;
 }
 
 qint64 QBenchmarkPerfEventsMeasurer::stop()
 {
-    // disable the counter
-    ::ioctl(fd, PERF_EVENT_IOC_DISABLE);
+    // disable the counters
+    ::ioctl(fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
     return readValue();
 }
 
+QList<QBenchmarkMeasurerBase::Measurement> QBenchmarkPerfEventsMeasurer::secondaryMeasurements()
+{
+    QList<Measurement> measurements;
+    measurements.reserve(memberAttrs.size());
+    for (qsizetype i = 0; i < memberAttrs.size(); ++i) {
+        const perf_event_attr &member = memberAttrs.at(i);
+        measurements.append({ qreal(memberValues.value(i)),
+                              metricForEvent(member.type, member.config) });
+    }
+    return measurements;
+}
+
 bool QBenchmarkPerfEventsMeasurer::isMeasurementAccepted(qint64)
 {
     return true;
@@ -569,6 +651,30 @@ QTest::QBenchmarkMetric QBenchmarkPerfEventsMeasurer::metricType()
     return metricForEvent(attr.type, attr.config);
 }
 
+static void readBuffer(int fd, void *buffer, size_t size)
+{
+    size_t nread = 0;
+    while (nread < size) {
+        char *ptr = static_cast<char *>(buffer);
+        qint64 r = qt_safe_read(fd, ptr + nread, size - nread);
+        if (r == -1) {
+            perror("QBenchmarkPerfEventsMeasurer::readValue: reading the results");
+            exit(1);
+        }
+        nread += quint64(r);
+    }
+}
+
+static quint64 scaledValue(quint64 value, quint64 timeEnabled, quint64 timeRunning)
+{
+    if (timeRunning == timeEnabled)
+        return value;
+
+    // scale the results, though this shouldn't happen for a single counter;
+    // groups larger than the PMU get multiplexed
+    return value * (double(timeRunning) / double(timeEnabled));
+}
+
 static quint64 rawReadValue(int fd)
 {
     /* from the kernel docs:
@@ -586,34 +692,56 @@ static quint64 rawReadValue(int fd)
         quint64 time_running;
     } results;
 
-    size_t nread = 0;
-    while (nread < sizeof results) {
-        char *ptr = reinterpret_cast<char *>(&results);
-        qint64 r = qt_safe_read(fd, ptr + nread, sizeof results - nread);
-        if (r == -1) {
-            perror("QBenchmarkPerfEventsMeasurer::readValue: reading the results");
-            exit(1);
-        }
-        nread += quint64(r);
-    }
+    readBuffer(fd, &results, sizeof results);
+    return scaledValue(results.value, results.time_enabled, results.time_running);
+}
+
+static QList<quint64> rawReadGroupValues(int fd, qsizetype count)
+{
+    /* from the kernel docs:
+     * struct read_format {
+     *  { u64           nr;            }
+     *    { u64         time_enabled; } && PERF_FORMAT_TOTAL_TIME_ENABLED
+     *    { u64         time_running; } && PERF_FORMAT_TOTAL_TIME_RUNNING
+     *    { u64         value;
+     *      { u64       id;           } && PERF_FORMAT_ID
+     *    }             cntr[nr];
+     *  } && PERF_FORMAT_GROUP
+     */
 
-    if (results.time_running == results.time_enabled)
-        return results.value;
+    QVarLengthArray<quint64, 16> buffer(3 + count);
+    readBuffer(fd, buffer.data(), buffer.size() * sizeof(quint64));
 
-    // scale the results, though this shouldn't happen!
-    return results.value * (double(results.time_running) / double(results.time_enabled));
+    QList<quint64> values;
+    values.reserve(count);
+    for (qsizetype i = 0; i < qMin(qsizetype(buffer[0]), count); ++i)
+        values.append(scaledValue(buffer[3 + i], buffer[1], buffer[2]));
+    return values;
 }
 
-qint64 QBenchmarkPerfEventsMeasurer::readValue()
+static quint64 toMetricUnit(quint64 raw, const perf_event_attr &counter)
 {
-    quint64 raw = rawReadValue(fd);
-    if (metricType() == QTest::WalltimeMilliseconds) {
+    if (QBenchmarkPerfEventsMeasurer::metricForEvent(counter.type, counter.config)
+            == QTest::WalltimeMilliseconds) {
         // perf returns nanoseconds
         return raw / 1000000;
     }
     return raw;
 }
 
+qint64 QBenchmarkPerfEventsMeasurer::readValue()
+{
+    if (memberAttrs.isEmpty())
+        return toMetricUnit(rawReadValue(fd), attr);
+
+    // one read returns the leader and all members
+    const QList<quint64> values = rawReadGroupValues(fd, 1 + memberAttrs.size());
+    memberValues.clear();
+    for (qsizetype i = 1; i < values.size(); ++i)
+        memberValues.append(toMetricUnit(values.at(i), memberAttrs.at(i - 1)));
+    return toMetricUnit(values.value(0), attr);
+}
+
 QT_END_NAMESPACE
 
 #endif
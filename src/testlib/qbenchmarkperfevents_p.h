@@ -70,6 +70,7 @@ public:
     bool repeatCount() override { return true; }
     bool needsWarmupIteration() override { return true; }
     QTest::QBenchmarkMetric metricType() override;
+    QList<Measurement> secondaryMeasurements() override;
 
     static bool isAvailable();
     static QTest::QBenchmarkMetric metricForEvent(quint32 type, quint64 event_id);
@@ -77,6 +78,8 @@ public:
     static void listCounters();
 private:
     int fd = -1;
+    QList<int> memberFds;
+    QList<qint64> memberValues;
 
     qint64 readValue();
 };
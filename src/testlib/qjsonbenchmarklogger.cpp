@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtTest module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include "qjsonbenchmarklogger_p.h"
+#include "qtestresult_p.h"
+#include "qbenchmark_p.h"
+
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Writes the benchmark results of a test run as a single JSON document
+    once the run has finished. The document is also what the -baseline
+    option reads, see QBenchmarkGlobalData::loadBaseline().
+*/
+
+QJsonBenchmarkLogger::QJsonBenchmarkLogger(const char *filename)
+    : QAbstractTestLogger(filename)
+{
+}
+
+QJsonBenchmarkLogger::~QJsonBenchmarkLogger() = default;
+
+void QJsonBenchmarkLogger::startLogging()
+{
+    results = QJsonArray();
+}
+
+void QJsonBenchmarkLogger::stopLogging()
+{
+    QJsonObject document;
+    document.insert(QLatin1String("testCase"),
+                    QString::fromUtf8(QTestResult::currentTestObjectName()));
+    document.insert(QLatin1String("qtVersion"), QLatin1String(QTEST_VERSION_STR));
+    document.insert(QLatin1String("results"), results);
+    outputString(QJsonDocument(document).toJson().constData());
+}
+
+void QJsonBenchmarkLogger::enterTestFunction(const char *)
+{
+    // don't print anything
+}
+
+void QJsonBenchmarkLogger::leaveTestFunction()
+{
+    // don't print anything
+}
+
+void QJsonBenchmarkLogger::addIncident(QAbstractTestLogger::IncidentTypes, const char *, const char *, int)
+{
+    // don't print anything
+}
+
+void QJsonBenchmarkLogger::addBenchmarkResult(const QBenchmarkResult &result)
+{
+    const char *fn = QTestResult::currentTestFunction() ? QTestResult::currentTestFunction()
+        : "UnknownTestFunc";
+    const char *tag = QTestResult::currentDataTag() ? QTestResult::currentDataTag() : "";
+    const char *gtag = QTestResult::currentGlobalDataTag()
+                     ? QTestResult::currentGlobalDataTag()
+                     : "";
+    const char *filler = (tag[0] && gtag[0]) ? ":" : "";
+
+    QJsonObject object;
+    object.insert(QLatin1String("function"), QString::fromUtf8(fn));
+    object.insert(QLatin1String("tag"), QString(QString::fromUtf8(gtag) + QLatin1String(filler)
+                                                + QString::fromUtf8(tag)));
+    object.insert(QLatin1String("metric"),
+                  QLatin1String(QTest::benchmarkMetricName(result.metric)));
+    object.insert(QLatin1String("unit"), QLatin1String(QTest::benchmarkMetricUnit(result.metric)));
+    object.insert(QLatin1String("value"), result.value / result.iterations);
+    object.insert(QLatin1String("total"), result.value);
+    object.insert(QLatin1String("iterations"), result.iterations);
+
+    const QBenchmarkStatistics &statistics = result.statistics;
+    object.insert(QLatin1String("samples"), statistics.samples);
+    object.insert(QLatin1String("minimum"), statistics.minimum);
+    object.insert(QLatin1String("median"), statistics.median);
+    object.insert(QLatin1String("p90"), statistics.p90);
+    object.insert(QLatin1String("maximum"), statistics.maximum);
+    object.insert(QLatin1String("stddev"), statistics.stddev);
+    results.append(object);
+}
+
+void QJsonBenchmarkLogger::addMessage(QAbstractTestLogger::MessageTypes, const QString &, const char *, int)
+{
+    // don't print anything
+}
+
+QT_END_NAMESPACE
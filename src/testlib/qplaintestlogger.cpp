@@ -322,6 +322,24 @@ void QPlainTestLogger::printBenchmarkResult(const QBenchmarkResult &result)
 
     memcpy(buf, bmtag, strlen(bmtag));
     outputMessage(buf);
+
+    // Only report the dispersion if there is one, i.e. with -median
+    const QBenchmarkStatistics &statistics = result.statistics;
+    if (statistics.samples > 1) {
+        const int digits = QTest::countSignificantDigits(result.value);
+        char minimumBuffer[100];
+        char medianBuffer[100];
+        char p90Buffer[100];
+        char stddevBuffer[100];
+        QTest::formatResult(minimumBuffer, 100, statistics.minimum, digits);
+        QTest::formatResult(medianBuffer, 100, statistics.median, digits);
+        QTest::formatResult(p90Buffer, 100, statistics.p90, digits);
+        QTest::formatResult(stddevBuffer, 100, statistics.stddev, digits);
+        qsnprintf(buf, sizeof(buf), "%s(min: %s, median: %s, p90: %s, stddev: %s, samples: %d)\n",
+                  fill + 2, minimumBuffer, medianBuffer, p90Buffer, stddevBuffer,
+                  statistics.samples);
+        outputMessage(buf);
+    }
 }
 
 QPlainTestLogger::QPlainTestLogger(const char *filename)
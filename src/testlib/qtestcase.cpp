@@ -542,6 +542,7 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
          "                       Valid formats are:\n"
          "                         txt      : Plain text\n"
          "                         csv      : CSV format (suitable for benchmarks)\n"
+         "                         json     : JSON document (suitable for benchmarks)\n"
          "                         junitxml : XML JUnit document\n"
          "                         xml      : XML document\n"
          "                         lightxml : A stream of XML tags\n"
@@ -554,6 +555,7 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
          " -o filename         : Write the output into file\n"
          " -txt                : Output results in Plain Text\n"
          " -csv                : Output results in a CSV format (suitable for benchmarks)\n"
+         " -json               : Output results as a JSON document (suitable for benchmarks)\n"
          " -junitxml           : Output results as XML JUnit document\n"
          " -xml                : Output results as XML document\n"
          " -lightxml           : Output results as stream of XML tags\n"
@@ -588,17 +590,30 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
 #endif
 #ifdef QTESTLIB_USE_PERF_EVENTS
          " -perf               : Use Linux perf events to time benchmarks\n"
-         " -perfcounter name   : Use the counter named 'name'\n"
+         " -perfcounter name   : Use the counter named 'name'. A comma-separated list of\n"
+         "                       names measures the counters as one group, reported together\n"
+         " -perfcountergroup   : Measure cycles, instructions, L1 data cache read misses,\n"
+         "                       cache misses and branch misses as one group\n"
          " -perfcounterlist    : Lists the counters available\n"
 #endif
 #ifdef HAVE_TICK_COUNTER
          " -tickcounter        : Use CPU tick counters to time benchmarks\n"
 #endif
          " -eventcounter       : Counts events received during benchmarks\n"
+#if QT_CONFIG(benchmark_allocations)
+         " -allocations        : Counts heap allocations, bytes allocated and peak heap growth\n"
+         "                       during benchmarks. Needs libQt6TestAllocationCounter.so in\n"
+         "                       LD_PRELOAD\n"
+#endif
          " -minimumvalue n     : Sets the minimum acceptable measurement value\n"
          " -minimumtotal n     : Sets the minimum acceptable total for repeated executions of a test function\n"
          " -iterations  n      : Sets the number of accumulation iterations.\n"
          " -median  n          : Sets the number of median iterations.\n"
+         " -warmup  n          : Sets the number of warmup iterations run before measuring.\n"
+         " -baseline file      : Fails benchmarks that regressed against the results in file,\n"
+         "                       as written by the json logger\n"
+         " -baselinethreshold n: Sets the regression threshold for -baseline in percent.\n"
+         "                       Default: 5\n"
          " -vb                 : Print out verbose benchmarking information.\n";
 
     for (int i = 1; i < argc; ++i) {
@@ -638,6 +653,8 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
             logFormat = QTestLog::Plain;
         } else if (strcmp(argv[i], "-csv") == 0) {
             logFormat = QTestLog::CSV;
+        } else if (strcmp(argv[i], "-json") == 0) {
+            logFormat = QTestLog::JSON;
         } else if (strcmp(argv[i], "-junitxml") == 0)  {
             logFormat = QTestLog::JUnitXML;
         } else if (strcmp(argv[i], "-xunitxml") == 0)  {
@@ -677,6 +694,8 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
                     logFormat = QTestLog::Plain;
                 else if (strcmp(format, "csv") == 0)
                     logFormat = QTestLog::CSV;
+                else if (strcmp(format, "json") == 0)
+                    logFormat = QTestLog::JSON;
                 else if (strcmp(format, "lightxml") == 0)
                     logFormat = QTestLog::LightXML;
                 else if (strcmp(format, "xml") == 0)
@@ -691,7 +710,7 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
                 else if (strcmp(format, "tap") == 0)
                     logFormat = QTestLog::TAP;
                 else {
-                    fprintf(stderr, "output format must be one of txt, csv, lightxml, xml, tap, teamcity or junitxml\n");
+                    fprintf(stderr, "output format must be one of txt, csv, json, lightxml, xml, tap, teamcity or junitxml\n");
                     exit(1);
                 }
                 if (strcmp(filename, "-") == 0 && QTestLog::loggerUsingStdout()) {
@@ -767,6 +786,9 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
             } else {
                 QBenchmarkPerfEventsMeasurer::setCounter(argv[++i]);
             }
+        } else if (strcmp(argv[i], "-perfcountergroup") == 0) {
+            QBenchmarkPerfEventsMeasurer::setCounter(
+                    "cycles,instructions,l1d-read-misses,cache-misses,branch-misses");
         } else if (strcmp(argv[i], "-perfcounterlist") == 0) {
             QBenchmarkPerfEventsMeasurer::listCounters();
             exit(0);
@@ -777,6 +799,15 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
 #endif
         } else if (strcmp(argv[i], "-eventcounter") == 0) {
             QBenchmarkGlobalData::current->setMode(QBenchmarkGlobalData::EventCounter);
+#if QT_CONFIG(benchmark_allocations)
+        } else if (strcmp(argv[i], "-allocations") == 0) {
+            if (!QBenchmarkAllocationMeasurer::isAvailable()) {
+                fprintf(stderr, "-allocations needs the allocation counter library; run the "
+                                "test with libQt6TestAllocationCounter.so in LD_PRELOAD\n");
+                exit(1);
+            }
+            QBenchmarkGlobalData::current->setMode(QBenchmarkGlobalData::AllocationCounter);
+#endif
         } else if (strcmp(argv[i], "-minimumvalue") == 0) {
             if (i + 1 >= argc) {
                 fprintf(stderr, "-minimumvalue needs an extra parameter to indicate the minimum time(ms)\n");
@@ -805,6 +836,28 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
             } else {
                 QBenchmarkGlobalData::current->medianIterationCount = qToInt(argv[++i]);
             }
+        } else if (strcmp(argv[i], "-warmup") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-warmup needs an extra parameter to indicate the number of warmup iterations\n");
+                exit(1);
+            } else {
+                QBenchmarkGlobalData::current->warmupIterationCount = qToInt(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "-baseline") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-baseline needs an extra parameter specifying the filename\n");
+                exit(1);
+            } else if (!QBenchmarkGlobalData::current->loadBaseline(argv[++i])) {
+                fprintf(stderr, "Unable to read benchmark baseline from '%s'\n", argv[i]);
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "-baselinethreshold") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-baselinethreshold needs an extra parameter to indicate the threshold in percent\n");
+                exit(1);
+            } else {
+                QBenchmarkGlobalData::current->baselineThreshold = qToInt(argv[++i]);
+            }
 
         } else if (strcmp(argv[i], "-vb") == 0) {
             QBenchmarkGlobalData::current->verboseOutput = true;
@@ -908,6 +961,28 @@ QBenchmarkResult qMedian(const QList<QBenchmarkResult> &container)
     return containerCopy.at(middle);
 }
 
+/*
+    Returns the statistics of the per-iteration values of all results, taking
+    the secondary measurement at index secondary, or the primary value if
+    secondary is -1.
+*/
+static QBenchmarkStatistics benchmarkStatistics(const QList<QBenchmarkResult> &results,
+                                                qsizetype secondary)
+{
+    QList<qreal> samples;
+    samples.reserve(results.size());
+    for (const QBenchmarkResult &r : results) {
+        if (secondary < 0) {
+            samples.append(r.value / r.iterations);
+        } else if (secondary < r.secondaryMeasurements.size()) {
+            const QBenchmarkMeasurerBase::Measurement &m = r.secondaryMeasurements.at(secondary);
+            samples.append(m.metric == QTest::PeakBytesAllocated ? m.value
+                                                                 : m.value / r.iterations);
+        }
+    }
+    return QBenchmarkStatistics::fromSamples(std::move(samples));
+}
+
 struct QTestDataSetter
 {
     QTestDataSetter(QTestData *data)
@@ -934,7 +1009,8 @@ void TestMethods::invokeTestOnData(int index) const
     /* Benchmarking: for each median iteration*/
 
     bool isBenchmark = false;
-    int i = (QBenchmarkGlobalData::current->measurer->needsWarmupIteration()) ? -1 : 0;
+    // negative iterations are warmup iterations
+    int i = -QBenchmarkGlobalData::current->adjustWarmupIterationCount();
 
     QList<QBenchmarkResult> results;
     bool minimumTotalReached = false;
@@ -991,11 +1067,11 @@ void TestMethods::invokeTestOnData(int index) const
 
         QBenchmarkTestMethodData::current->endDataRun();
         if (!QTestResult::skipCurrentTest() && !QTestResult::currentTestFailed()) {
-            if (i > -1)  // iteration -1 is the warmup iteration.
+            if (i > -1)
                 results.append(QBenchmarkTestMethodData::current->result);
 
             if (isBenchmark && QBenchmarkGlobalData::current->verboseOutput) {
-                if (i == -1) {
+                if (i < 0) {
                     QTestLog::info(qPrintable(
                         QString::fromLatin1("warmup stage result      : %1")
                             .arg(QBenchmarkTestMethodData::current->result.value)), nullptr, 0);
@@ -1021,10 +1097,41 @@ void TestMethods::invokeTestOnData(int index) const
     // If the test is a benchmark, finalize the result after all iterations have finished.
     if (isBenchmark) {
         bool testPassed = !QTestResult::skipCurrentTest() && !QTestResult::currentTestFailed();
+        QList<QBenchmarkResult> reported;
+        if (testPassed && QBenchmarkTestMethodData::current->resultsAccepted()
+            && !results.isEmpty()) {
+            const QBenchmarkResult median = qMedian(results);
+            QBenchmarkResult result = median;
+            result.secondaryMeasurements.clear();
+            result.statistics = benchmarkStatistics(results, -1);
+            reported.append(result);
+
+            // Secondary measurements come from the same run as the median
+            for (qsizetype m = 0; m < median.secondaryMeasurements.size(); ++m) {
+                const QBenchmarkMeasurerBase::Measurement &measurement =
+                        median.secondaryMeasurements.at(m);
+                result.value = measurement.value;
+                result.metric = measurement.metric;
+                // a peak does not accumulate over the iterations
+                if (measurement.metric == QTest::PeakBytesAllocated)
+                    result.iterations = 1;
+                else
+                    result.iterations = median.iterations;
+                result.statistics = benchmarkStatistics(results, m);
+                reported.append(result);
+            }
+
+            for (const QBenchmarkResult &r : std::as_const(reported)) {
+                const QByteArray regression =
+                        QBenchmarkGlobalData::current->compareWithBaseline(r);
+                if (!regression.isEmpty())
+                    QTestResult::addFailure(regression.constData());
+            }
+        }
         QTestResult::finishedCurrentTestDataCleanup();
         // Only report benchmark figures if the test passed
-        if (testPassed && QBenchmarkTestMethodData::current->resultsAccepted())
-            QTestLog::addBenchmarkResult(qMedian(results));
+        for (const QBenchmarkResult &r : std::as_const(reported))
+            QTestLog::addBenchmarkResult(r);
     }
 }
 
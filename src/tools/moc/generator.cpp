@@ -43,6 +43,8 @@
 #include <math.h>
 #include <stdio.h>
 
+#include <algorithm>
+
 #include <private/qmetaobject_p.h> //for the flags.
 #include <private/qplugin_p.h> //for the flags.
 
@@ -349,7 +351,16 @@ void Generator::generateCode()
 // build the data array
 //
 
+    // The hashed name index that lets QMetaObject::indexOfProperty() and
+    // indexOfMethod() skip the linear scan only pays off for larger classes.
+    const int nameIndexThreshold = 8;
+    const int nameIndexEntries = int(cdef->signalList.count() + cdef->slotList.count()
+                                     + cdef->methodList.count() + cdef->propertyList.count());
+    const bool hasNameIndex = nameIndexEntries >= nameIndexThreshold;
+
     int index = MetaObjectPrivateFieldCount;
+    if (hasNameIndex)
+        index += 2 + 2 * nameIndexEntries; // the index directly follows the header
     fprintf(out, "static const uint qt_meta_data_%s[] = {\n", qualifiedClassNameIdentifier.constData());
     fprintf(out, "\n // content:\n");
     fprintf(out, "    %4d,       // revision\n", int(QMetaObjectPrivate::OutputRevision));
@@ -387,9 +398,17 @@ void Generator::generateCode()
         // by qdbusxml2cpp which generate code that require that we call qt_metacall for properties
         flags |= PropertyAccessInStaticMetaCall;
     }
+    if (hasNameIndex)
+        flags |= HasNameIndex;
     fprintf(out, "    %4d,       // flags\n", flags);
     fprintf(out, "    %4d,       // signalCount\n", int(cdef->signalList.count()));
 
+//
+// Build name index
+//
+    if (hasNameIndex)
+        generateNameIndex();
+
 
 //
 // Build classinfo array
@@ -710,6 +729,38 @@ void Generator::generateClassInfos()
     }
 }
 
+void Generator::generateNameIndex()
+{
+    const auto generateTable = [this](const char *kind, const QList<QByteArray> &names) {
+        QList<QPair<uint, int>> entries;
+        entries.reserve(names.size());
+        for (int i = 0; i < names.size(); ++i) {
+            const QByteArray &name = names.at(i);
+            entries.append(qMakePair(QMetaObjectPrivate::nameHash(name.constData(), name.size()), i));
+        }
+        std::sort(entries.begin(), entries.end());
+
+        fprintf(out, "\n // %s name index: count, then hash, index\n", kind);
+        fprintf(out, "    %4d,\n", int(entries.size()));
+        for (const auto &entry : qAsConst(entries))
+            fprintf(out, "    0x%08x, %4d, // \"%s\"\n", entry.first, entry.second,
+                    names.at(entry.second).constData());
+    };
+
+    QList<QByteArray> names;
+    for (const PropertyDef &p : qAsConst(cdef->propertyList))
+        names.append(p.name);
+    generateTable("property", names);
+
+    // methods are indexed in the order of the method array: signals, slots, methods
+    names.clear();
+    for (const QList<FunctionDef> *list : { &cdef->signalList, &cdef->slotList, &cdef->methodList }) {
+        for (const FunctionDef &f : *list)
+            names.append(f.name);
+    }
+    generateTable("method", names);
+}
+
 void Generator::registerFunctionStrings(const QList<FunctionDef> &list)
 {
     for (int i = 0; i < list.count(); ++i) {
@@ -49,6 +49,7 @@ private:
     bool registerableMetaType(const QByteArray &propertyType);
     void registerClassInfoStrings();
     void generateClassInfos();
+    void generateNameIndex();
     void registerFunctionStrings(const QList<FunctionDef> &list);
     void registerByteArrayVector(const QList<QByteArray> &list);
     void generateFunctions(const QList<FunctionDef> &list, const char *functype, int type,
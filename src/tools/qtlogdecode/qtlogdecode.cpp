@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the tools applications of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qbinarymessagelog.h>
+#include <QtCore/qcommandlineparser.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qfile.h>
+
+#include <stdio.h>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QLatin1String(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Converts a QBinaryMessageLog to text."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(QStringLiteral("log"),
+                                 QStringLiteral("The binary log, or - to read from standard input."));
+    QCommandLineOption outputOption(QStringList() << QStringLiteral("o") << QStringLiteral("output"),
+                                    QStringLiteral("Write the text to <file> instead of standard output."),
+                                    QStringLiteral("file"));
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1)
+        parser.showHelp(1);
+
+    QFile in;
+    const bool inOpened = args.first() == QLatin1String("-")
+            ? in.open(stdin, QIODevice::ReadOnly)
+            : (in.setFileName(args.first()), in.open(QIODevice::ReadOnly));
+    if (!inOpened) {
+        fprintf(stderr, "qtlogdecode: cannot open %s: %s\n", qPrintable(args.first()),
+                qPrintable(in.errorString()));
+        return 1;
+    }
+
+    QFile out;
+    const bool outOpened = parser.isSet(outputOption)
+            ? (out.setFileName(parser.value(outputOption)), out.open(QIODevice::WriteOnly))
+            : out.open(stdout, QIODevice::WriteOnly);
+    if (!outOpened) {
+        fprintf(stderr, "qtlogdecode: cannot open %s: %s\n", qPrintable(out.fileName()),
+                qPrintable(out.errorString()));
+        return 1;
+    }
+
+    if (!QBinaryMessageLog::decode(&in, &out)) {
+        fprintf(stderr, "qtlogdecode: %s is not a complete binary message log\n",
+                qPrintable(args.first()));
+        return 1;
+    }
+    return 0;
+}
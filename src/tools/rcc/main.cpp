@@ -183,6 +183,12 @@ int runRcc(int argc, char *argv[])
     QCommandLineOption noZstdOption(QStringLiteral("no-zstd"), QStringLiteral("Disable usage of zstd compression."));
     parser.addOption(noZstdOption);
 
+    QCommandLineOption zstdDictionaryOption(QStringLiteral("zstd-dictionary-size"),
+                                            QStringLiteral("Train a zstd dictionary of at most this size on all files, "
+                                                           "and use it for the files it compresses better."),
+                                            QStringLiteral("bytes"));
+    parser.addOption(zstdDictionaryOption);
+
     QCommandLineOption thresholdOption(QStringLiteral("threshold"), QStringLiteral("Threshold to consider compressing files."), QStringLiteral("level"));
     parser.addOption(thresholdOption);
 
@@ -257,6 +263,20 @@ int runRcc(int argc, char *argv[])
         library.setCompressionAlgorithm(RCCResourceLibrary::CompressionAlgorithm::None);
     if (parser.isSet(noZstdOption))
         library.setNoZstd(true);
+    if (parser.isSet(zstdDictionaryOption)) {
+#if QT_CONFIG(zstd)
+        bool ok = false;
+        const int size = parser.value(zstdDictionaryOption).toInt(&ok);
+        if (!ok || size < 0)
+            errorMsg = QLatin1String("Invalid zstd dictionary size specified");
+        else if (formatVersion < 3)
+            errorMsg = QLatin1String("Zstandard dictionaries require format version 3 or higher");
+        else
+            library.setZstdDictionarySize(size);
+#else
+        errorMsg = QLatin1String("Zstandard support not compiled in");
+#endif
+    }
     if (parser.isSet(compressOption) && errorMsg.isEmpty()) {
         int level = library.parseCompressionLevel(library.compressionAlgorithm(), parser.value(compressOption), &errorMsg);
         library.setCompressLevel(level);
@@ -34,6 +34,7 @@
 #include <qdebug.h>
 #include <qdir.h>
 #include <qdiriterator.h>
+#include <qendian.h>
 #include <qfile.h>
 #include <qiodevice.h>
 #include <qlocale.h>
@@ -44,6 +45,7 @@
 
 #if QT_CONFIG(zstd)
 #  include <zstd.h>
+#  include <zdict.h>
 #endif
 
 // Note: A copy of this file is used in Qt Designer (qttools/src/designer/src/lib/shared/rcc.cpp)
@@ -103,7 +105,8 @@ public:
         NoFlags = 0x00,
         Compressed = 0x01,
         Directory = 0x02,
-        CompressedZstd = 0x04
+        CompressedZstd = 0x04,
+        ZstdDictionary = 0x08
     };
 
     RCCFileInfo(const QString &name = QString(), const QFileInfo &fileInfo = QFileInfo(),
@@ -250,9 +253,6 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
 {
     const bool text = lib.m_format == RCCResourceLibrary::C_Code;
     const bool pass1 = lib.m_format == RCCResourceLibrary::Pass1;
-    const bool pass2 = lib.m_format == RCCResourceLibrary::Pass2;
-    const bool binary = lib.m_format == RCCResourceLibrary::Binary;
-    const bool python = lib.m_format == RCCResourceLibrary::Python_Code;
 
     //capture the offset
     m_dataOffset = offset;
@@ -287,9 +287,27 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
             size_t n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
                                          data.constData(), data.size(),
                                          compressLevel);
+
+            // Small files that compress poorly on their own often do well
+            // with the dictionary trained on all files. The frame is then
+            // preceded by the offset of the dictionary.
+            bool useDictionary = false;
+            if (lib.m_zstdCDict && !ZSTD_isError(n)) {
+                QByteArray withDictionary(4 + size, Qt::Uninitialized);
+                const size_t m = ZSTD_compress_usingCDict(lib.m_zstdCCtx, withDictionary.data() + 4,
+                                                          size, data.constData(), data.size(),
+                                                          lib.m_zstdCDict);
+                if (!ZSTD_isError(m) && 4 + m < n) {
+                    qToBigEndian(quint32(lib.m_zstdDictionaryOffset), withDictionary.data());
+                    compressed = std::move(withDictionary);
+                    n = 4 + m;
+                    useDictionary = true;
+                }
+            }
+
             if (n * 100.0 < data.size() * 1.0 * (100 - m_compressThreshold) ) {
                 // compressing is worth it
-                if (m_compressLevel < 0) {
+                if (m_compressLevel < 0 && !useDictionary) {
                     // heuristic compression, so recompress
                     n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
                                           data.constData(), data.size(),
@@ -300,13 +318,18 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
                             .arg(m_name, QString::fromUtf8(ZSTD_getErrorName(n)));
                     lib.m_errorDevice->write(msg.toUtf8());
                 } else if (lib.verbose()) {
-                    QString msg = QString::fromLatin1("%1: note: compressed using zstd (%2 -> %3)\n")
-                            .arg(m_name).arg(data.size()).arg(n);
+                    QString msg = QString::fromLatin1("%1: note: compressed using zstd%2 (%3 -> %4)\n")
+                            .arg(m_name, useDictionary ? QLatin1String(" with dictionary") : QLatin1String(""))
+                            .arg(data.size()).arg(n);
                     lib.m_errorDevice->write(msg.toUtf8());
                 }
 
                 lib.m_overallFlags |= CompressedZstd;
                 m_flags |= CompressedZstd;
+                if (useDictionary) {
+                    lib.m_overallFlags |= ZstdDictionary;
+                    m_flags |= ZstdDictionary;
+                }
                 data = std::move(compressed);
                 data.truncate(n);
             } else if (lib.verbose()) {
@@ -349,40 +372,7 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
         lib.writeString("\n  ");
     }
 
-    // write the length
-    if (text || binary || pass2 || python)
-        lib.writeNumber4(data.size());
-    if (text || pass1)
-        lib.writeString("\n  ");
-    else if (python)
-        lib.writeString("\\\n");
-    offset += 4;
-
-    // write the payload
-    const char *p = data.constData();
-    if (text || python) {
-        for (int i = data.size(), j = 0; --i >= 0; --j) {
-            lib.writeHex(*p++);
-            if (j == 0) {
-                if (text)
-                    lib.writeString("\n  ");
-                else
-                    lib.writeString("\\\n");
-                j = 16;
-            }
-        }
-    } else if (binary || pass2) {
-        lib.writeByteArray(data);
-    }
-    offset += data.size();
-
-    // done
-    if (text || pass1)
-        lib.writeString("\n  ");
-    else if (python)
-        lib.writeString("\\\n");
-
-    return offset;
+    return lib.writeDataPayload(data, offset);
 }
 
 qint64 RCCFileInfo::writeDataName(RCCResourceLibrary &lib, qint64 offset)
@@ -472,11 +462,14 @@ RCCResourceLibrary::RCCResourceLibrary(quint8 formatVersion)
     m_errorDevice(nullptr),
     m_outDevice(nullptr),
     m_formatVersion(formatVersion),
-    m_noZstd(false)
+    m_noZstd(false),
+    m_zstdDictionarySize(0)
 {
     m_out.reserve(30 * 1000 * 1000);
 #if QT_CONFIG(zstd)
     m_zstdCCtx = nullptr;
+    m_zstdCDict = nullptr;
+    m_zstdDictionaryOffset = 0;
 #endif
 }
 
@@ -484,6 +477,7 @@ RCCResourceLibrary::~RCCResourceLibrary()
 {
     delete m_root;
 #if QT_CONFIG(zstd)
+    ZSTD_freeCDict(m_zstdCDict);
     ZSTD_freeCCtx(m_zstdCCtx);
 #endif
 }
@@ -1144,9 +1138,21 @@ bool RCCResourceLibrary::writeDataBlobs()
     if (!m_root)
         return false;
 
+    qint64 offset = 0;
+#if QT_CONFIG(zstd)
+    // the dictionary goes first, as a payload of its own
+    if (m_zstdDictionarySize > 0 && m_formatVersion >= 3 && !m_noZstd && !m_zstdCDict)
+        trainZstdDictionary();
+    if (m_zstdCDict) {
+        if (m_format == C_Code || m_format == Pass1)
+            writeString("  // zstd dictionary\n  ");
+        m_zstdDictionaryOffset = offset;
+        offset = writeDataPayload(m_zstdDictionary, offset);
+    }
+#endif
+
     QStack<RCCFileInfo*> pending;
     pending.push(m_root);
-    qint64 offset = 0;
     QString errorMessage;
     while (!pending.isEmpty()) {
         RCCFileInfo *file = pending.pop();
@@ -1183,6 +1189,112 @@ bool RCCResourceLibrary::writeDataBlobs()
     return true;
 }
 
+#if QT_CONFIG(zstd)
+// Trains a dictionary on the contents of all files that may be compressed
+// with zstd. Files that have a lot in common, like many small QML or JSON
+// files, then compress much better than each on its own.
+void RCCResourceLibrary::trainZstdDictionary()
+{
+    QByteArray samples;
+    QList<size_t> sampleSizes;
+    QStack<RCCFileInfo*> pending;
+    pending.push(m_root);
+    while (!pending.isEmpty()) {
+        RCCFileInfo *file = pending.pop();
+        for (auto it = file->m_children.cbegin(); it != file->m_children.cend(); ++it) {
+            RCCFileInfo *child = it.value();
+            if (child->m_flags & RCCFileInfo::Directory) {
+                pending.push(child);
+                continue;
+            }
+            if (child->m_noZstd
+                || (child->m_compressAlgo != CompressionAlgorithm::Zstd
+                    && child->m_compressAlgo != CompressionAlgorithm::Best)) {
+                continue;
+            }
+            QFile input(child->m_fileInfo.absoluteFilePath());
+            if (!input.open(QFile::ReadOnly))
+                continue; // reported when writing the file
+            const QByteArray data = input.readAll();
+            if (data.isEmpty())
+                continue;
+            samples += data;
+            sampleSizes.append(size_t(data.size()));
+        }
+    }
+
+    QByteArray dictionary(m_zstdDictionarySize, Qt::Uninitialized);
+    const size_t n = ZDICT_trainFromBuffer(dictionary.data(), size_t(dictionary.size()),
+                                           samples.constData(), sampleSizes.data(),
+                                           unsigned(sampleSizes.size()));
+    if (ZDICT_isError(n)) {
+        if (m_verbose) {
+            const QString msg = QString::fromLatin1("note: no zstd dictionary trained: %1\n")
+                    .arg(QString::fromUtf8(ZDICT_getErrorName(n)));
+            m_errorDevice->write(msg.toUtf8());
+        }
+        return;
+    }
+    dictionary.truncate(qsizetype(n));
+
+    const int compressLevel =
+            m_compressLevel < 0 ? int(CONSTANT_ZSTDCOMPRESSLEVEL_STORE) : m_compressLevel;
+    m_zstdCDict = ZSTD_createCDict(dictionary.constData(), n, compressLevel);
+    if (!m_zstdCDict)
+        return;
+    m_zstdDictionary = dictionary;
+    if (m_verbose) {
+        const QString msg = QString::fromLatin1("note: trained zstd dictionary (%1 bytes, %2 files)\n")
+                .arg(n).arg(sampleSizes.size());
+        m_errorDevice->write(msg.toUtf8());
+    }
+}
+#endif
+
+qint64 RCCResourceLibrary::writeDataPayload(const QByteArray &data, qint64 offset)
+{
+    const bool text = m_format == C_Code;
+    const bool pass1 = m_format == Pass1;
+    const bool pass2 = m_format == Pass2;
+    const bool binary = m_format == Binary;
+    const bool python = m_format == Python_Code;
+
+    // write the length
+    if (text || binary || pass2 || python)
+        writeNumber4(data.size());
+    if (text || pass1)
+        writeString("\n  ");
+    else if (python)
+        writeString("\\\n");
+    offset += 4;
+
+    // write the payload
+    const char *p = data.constData();
+    if (text || python) {
+        for (int i = data.size(), j = 0; --i >= 0; --j) {
+            writeHex(*p++);
+            if (j == 0) {
+                if (text)
+                    writeString("\n  ");
+                else
+                    writeString("\\\n");
+                j = 16;
+            }
+        }
+    } else if (binary || pass2) {
+        writeByteArray(data);
+    }
+    offset += data.size();
+
+    // done
+    if (text || pass1)
+        writeString("\n  ");
+    else if (python)
+        writeString("\\\n");
+
+    return offset;
+}
+
 bool RCCResourceLibrary::writeDataNames()
 {
     switch (m_format) {
@@ -1407,11 +1519,20 @@ bool RCCResourceLibrary::writeInitializer()
                                 "    return qt_resourceFeatureZstd;\n"
                                 "}\n");
                 }
+                if (m_overallFlags & RCCFileInfo::ZstdDictionary) {
+                    writeString("static inline unsigned char qResourceFeatureZstdDictionary()\n"
+                                "{\n"
+                                "    extern const unsigned char qt_resourceFeatureZstdDictionary;\n"
+                                "    return qt_resourceFeatureZstdDictionary;\n"
+                                "}\n");
+                }
                 writeString("#else\n");
                 if (m_overallFlags & RCCFileInfo::Compressed)
                     writeString("unsigned char qResourceFeatureZlib();\n");
                 if (m_overallFlags & RCCFileInfo::CompressedZstd)
                     writeString("unsigned char qResourceFeatureZstd();\n");
+                if (m_overallFlags & RCCFileInfo::ZstdDictionary)
+                    writeString("unsigned char qResourceFeatureZstdDictionary();\n");
                 writeString("#endif\n\n");
             }
         }
@@ -1470,6 +1591,11 @@ bool RCCResourceLibrary::writeInitializer()
                 writeAddNamespaceFunction("qResourceFeatureZstd()");
                 writeString(";\n    ");
             }
+            if (m_overallFlags & RCCFileInfo::ZstdDictionary) {
+                writeString("version += ");
+                writeAddNamespaceFunction("qResourceFeatureZstdDictionary()");
+                writeString(";\n    ");
+            }
 
             writeAddNamespaceFunction("qUnregisterResourceData");
             writeString("\n       (version, qt_resource_struct, "
@@ -37,6 +37,7 @@
 #include <qstring.h>
 
 typedef struct ZSTD_CCtx_s ZSTD_CCtx;
+typedef struct ZSTD_CDict_s ZSTD_CDict;
 
 QT_BEGIN_NAMESPACE
 
@@ -112,6 +113,9 @@ public:
     void setNoZstd(bool v) { m_noZstd = v; }
     bool noZstd() const { return m_noZstd; }
 
+    void setZstdDictionarySize(int size) { m_zstdDictionarySize = size; }
+    int zstdDictionarySize() const { return m_zstdDictionarySize; }
+
 private:
     struct Strings {
         Strings();
@@ -132,6 +136,8 @@ private:
         QString currentPath = QString(), bool listMode = false);
     bool writeHeader();
     bool writeDataBlobs();
+    qint64 writeDataPayload(const QByteArray &data, qint64 offset);
+    void trainZstdDictionary();
     bool writeDataNames();
     bool writeDataStructure();
     bool writeInitializer();
@@ -150,6 +156,9 @@ private:
 
 #if QT_CONFIG(zstd)
     ZSTD_CCtx *m_zstdCCtx;
+    ZSTD_CDict *m_zstdCDict;
+    QByteArray m_zstdDictionary;
+    qint64 m_zstdDictionaryOffset;
 #endif
 
     const Strings m_strings;
@@ -174,6 +183,7 @@ private:
     QByteArray m_out;
     quint8 m_formatVersion;
     bool m_noZstd;
+    int m_zstdDictionarySize;
 };
 
 QT_END_NAMESPACE
@@ -493,10 +493,6 @@ QAccessibleInterface *QAccessibleTable::child(int logicalIndex) const
     if (!view()->model())
         return nullptr;
 
-    auto id = childToId.constFind(logicalIndex);
-    if (id != childToId.constEnd())
-        return QAccessible::accessibleInterface(id.value());
-
     int vHeader = verticalHeader() ? 1 : 0;
     int hHeader = horizontalHeader() ? 1 : 0;
 
@@ -505,6 +501,18 @@ QAccessibleInterface *QAccessibleTable::child(int logicalIndex) const
     int row = logicalIndex / columns;
     int column = logicalIndex % columns;
 
+    QModelIndex index;
+    if ((!vHeader || column > 0) && (!hHeader || row > 0)) {
+        index = view()->model()->index(row - hHeader, column - vHeader, view()->rootIndex());
+        if (Q_UNLIKELY(!index.isValid())) {
+            qWarning("QAccessibleTable::child: Invalid index at: %d %d", row - hHeader, column - vHeader);
+            return nullptr;
+        }
+    }
+
+    if (QAccessibleInterface *cached = cachedChild(logicalIndex, index))
+        return cached;
+
     QAccessibleInterface *iface = nullptr;
 
     if (vHeader) {
@@ -524,20 +532,98 @@ QAccessibleInterface *QAccessibleTable::child(int logicalIndex) const
         --row;
     }
 
-    if (!iface) {
-        QModelIndex index = view()->model()->index(row, column, view()->rootIndex());
-        if (Q_UNLIKELY(!index.isValid())) {
-            qWarning("QAccessibleTable::child: Invalid index at: %d %d", row, column);
-            return nullptr;
-        }
+    if (!iface)
         iface = new QAccessibleTableCell(view(), index, cellRole());
+
+    return cacheChild(logicalIndex, iface);
+}
+
+/*
+    Returns the cached child at \a logicalIndex, or nullptr if there is none.
+    If \a index is valid, the cached child must be the cell for that index;
+    rows can move without a model change event (for instance when expanding
+    tree items), in which case the stale interface is dropped.
+*/
+QAccessibleInterface *QAccessibleTable::cachedChild(int logicalIndex, const QModelIndex &index) const
+{
+    const auto it = childToId.constFind(logicalIndex);
+    if (it == childToId.constEnd())
+        return nullptr;
+
+    QAccessibleInterface *iface = QAccessible::accessibleInterface(it.value());
+    if (iface && index.isValid()) {
+        const QAccessibleTableCell *cell = static_cast<QAccessibleTableCell *>(iface->tableCellInterface());
+        if (!cell || cell->m_index != index) {
+            QAccessible::deleteAccessibleInterface(it.value());
+            iface = nullptr;
+        }
     }
+    if (!iface)
+        childToId.erase(it);
+    return iface;
+}
 
+QAccessibleInterface *QAccessibleTable::cacheChild(int logicalIndex, QAccessibleInterface *iface) const
+{
     QAccessible::registerAccessibleInterface(iface);
     childToId.insert(logicalIndex, QAccessible::uniqueId(iface));
+
+    // Clients may walk all children of a huge view within one call, so
+    // the interfaces of cells outside of the viewport are only released
+    // once we are back in the event loop.
+    if (childToId.size() > MaxCachedChildren && !m_trimScheduled) {
+        m_trimScheduled = true;
+        QMetaObject::invokeMethod(view(), [this] { trimChildCache(); }, Qt::QueuedConnection);
+    }
     return iface;
 }
 
+bool QAccessibleTable::isChildOffscreen(QAccessibleInterface *iface) const
+{
+    switch (iface->role()) {
+    case QAccessible::Cell:
+    case QAccessible::ListItem:
+    case QAccessible::TreeItem: {
+        const QAccessibleTableCell *cell = static_cast<QAccessibleTableCell *>(iface->tableCellInterface());
+        if (!cell)
+            return false;
+        if (cell->m_index == view()->currentIndex())
+            return false;
+        return !view()->viewport()->rect().intersects(view()->visualRect(cell->m_index));
+    }
+    case QAccessible::RowHeader:
+    case QAccessible::ColumnHeader: {
+        const QAccessibleTableHeaderCell *cell = static_cast<QAccessibleTableHeaderCell *>(iface);
+        const QHeaderView *header = cell->headerView();
+        if (!header)
+            return false;
+        const int position = header->sectionViewportPosition(cell->index);
+        const int length = header->orientation() == Qt::Horizontal
+                ? header->viewport()->width() : header->viewport()->height();
+        return position + header->sectionSize(cell->index) <= 0 || position >= length;
+    }
+    default:
+        return false;
+    }
+}
+
+void QAccessibleTable::trimChildCache() const
+{
+    m_trimScheduled = false;
+    if (childToId.size() <= MaxCachedChildren || !isValid())
+        return;
+
+    for (auto it = childToId.begin(); it != childToId.end();) {
+        QAccessibleInterface *iface = QAccessible::accessibleInterface(it.value());
+        if (!iface || isChildOffscreen(iface)) {
+            QAccessible::deleteAccessibleInterface(it.value());
+            it = childToId.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void *QAccessibleTable::interface_cast(QAccessible::InterfaceType t)
 {
     if (t == QAccessible::TableInterface)
@@ -608,12 +694,14 @@ void QAccessibleTable::modelChange(QAccessibleTableModelChangeEvent *event)
             QAccessible::Id id = iter.value();
             QAccessibleInterface *iface = QAccessible::accessibleInterface(id);
             Q_ASSERT(iface);
-            if (iface->role() == QAccessible::Cell || iface->role() == QAccessible::ListItem) {
+            if (iface->role() == QAccessible::Cell || iface->role() == QAccessible::ListItem
+                || iface->role() == QAccessible::TreeItem) {
                 Q_ASSERT(iface->tableCellInterface());
                 QAccessibleTableCell *cell = static_cast<QAccessibleTableCell*>(iface->tableCellInterface());
                 // Since it is a QPersistentModelIndex, we only need to check if it is valid
-                if (cell->m_index.isValid())
-                    newCache.insert(indexOfChild(cell), id);
+                const int index = cell->m_index.isValid() ? indexOfChild(cell) : -1;
+                if (index >= 0)
+                    newCache.insert(index, id);
                 else
                     QAccessible::deleteAccessibleInterface(id);
             } else if (event->modelChangeType() == QAccessibleTableModelChangeEvent::RowsRemoved
@@ -708,28 +796,29 @@ QAccessibleInterface *QAccessibleTree::child(int logicalIndex) const
     if (logicalIndex < 0 || !view()->model() || !view()->model()->columnCount())
         return nullptr;
 
-    QAccessibleInterface *iface = nullptr;
+    QModelIndex modelIndex;
     int index = logicalIndex;
 
-    if (horizontalHeader()) {
-        if (index < view()->model()->columnCount()) {
-            iface = new QAccessibleTableHeaderCell(view(), index, Qt::Horizontal);
-        } else {
-            index -= view()->model()->columnCount();
-        }
-    }
+    if (horizontalHeader())
+        index -= view()->model()->columnCount();
 
-    if (!iface) {
+    if (index >= 0) {
         int row = index / view()->model()->columnCount();
         int column = index % view()->model()->columnCount();
-        QModelIndex modelIndex = indexFromLogical(row, column);
+        modelIndex = indexFromLogical(row, column);
         if (!modelIndex.isValid())
             return nullptr;
-        iface = new QAccessibleTableCell(view(), modelIndex, cellRole());
     }
-    QAccessible::registerAccessibleInterface(iface);
-    // ### FIXME: get interfaces from the cache instead of re-creating them
-    return iface;
+
+    if (QAccessibleInterface *cached = cachedChild(logicalIndex, modelIndex))
+        return cached;
+
+    QAccessibleInterface *iface = nullptr;
+    if (modelIndex.isValid())
+        iface = new QAccessibleTableCell(view(), modelIndex, cellRole());
+    else
+        iface = new QAccessibleTableHeaderCell(view(), logicalIndex, Qt::Horizontal);
+    return cacheChild(logicalIndex, iface);
 }
 
 int QAccessibleTree::rowCount() const
@@ -136,12 +136,22 @@ protected:
     typedef QHash<int, QAccessible::Id> ChildCache;
     mutable ChildCache childToId;
 
+    QAccessibleInterface *cachedChild(int logicalIndex, const QModelIndex &index) const;
+    QAccessibleInterface *cacheChild(int logicalIndex, QAccessibleInterface *iface) const;
+
     virtual ~QAccessibleTable();
 
 private:
+    // above this, interfaces of children outside of the viewport are released
+    enum { MaxCachedChildren = 1000 };
+
+    bool isChildOffscreen(QAccessibleInterface *iface) const;
+    void trimChildCache() const;
+
     // the child index for a model index
     inline int logicalIndex(const QModelIndex &index) const;
     QAccessible::Role m_role;
+    mutable bool m_trimScheduled = false;
 };
 
 #if QT_CONFIG(treeview)
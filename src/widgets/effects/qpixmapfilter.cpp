@@ -53,6 +53,7 @@
 #include "private/qmath_p.h"
 #include "private/qmemrotate_p.h"
 #include "private/qdrawhelper_p.h"
+#include "private/qimage_p.h"
 
 #include <memory>
 
@@ -503,6 +504,17 @@ public:
 
     qreal radius;
     QGraphicsBlurEffect::BlurHints hints;
+
+    // the result of the last blur, as effects tend to draw the same source
+    // over and over again
+    mutable struct {
+        qint64 sourceKey = 0;
+        QRectF sourceRect;
+        qreal radius = 0;
+        bool quality = false;
+        QImage image;
+        qreal scale = 1;
+    } lastBlur;
 };
 
 
@@ -644,10 +656,12 @@ inline void qt_blurinner_alphaOnly(uchar *bptr, int &z, int alpha)
     *(bptr) = z >> (zprec + aprec);
 }
 
+// Blurs the row \a line of \a im, whose bits must have been detached
+// already, so that rows can be blurred in several threads at once.
 template<int aprec, int zprec, bool alphaOnly>
 inline void qt_blurrow(QImage & im, int line, int alpha)
 {
-    uchar *bptr = im.scanLine(line);
+    uchar *bptr = const_cast<uchar *>(im.constScanLine(line));
 
     int zR = 0, zG = 0, zB = 0, zA = 0;
 
@@ -675,6 +689,20 @@ inline void qt_blurrow(QImage & im, int line, int alpha)
     }
 }
 
+// Blurs all rows of \a img, spreading them over the image thread pool
+template<int aprec, int zprec, bool alphaOnly>
+static void qt_blurrows(QImage &img, int alpha, bool improvedQuality)
+{
+    img.detach();
+    qt_imageParallelFor(qsizetype(img.width()) * img.height(), img.height(),
+                        [&img, alpha, improvedQuality](int yStart, int yEnd) {
+        for (int row = yStart; row < yEnd; ++row) {
+            for (int i = 0; i <= int(improvedQuality); ++i)
+                qt_blurrow<aprec, zprec, alphaOnly>(img, row, alpha);
+        }
+    });
+}
+
 /*
 *  expblur(QImage &img, int radius)
 *
@@ -712,11 +740,7 @@ void expblur(QImage &img, qreal radius, bool improvedQuality = false, int transp
         ? ((1 << aprec)-1)
         : qRound((1<<aprec)*(1 - qPow(cutOffIntensity * (1 / qreal(255)), 1 / radius)));
 
-    int img_height = img.height();
-    for (int row = 0; row < img_height; ++row) {
-        for (int i = 0; i <= int(improvedQuality); ++i)
-            qt_blurrow<aprec, zprec, alphaOnly>(img, row, alpha);
-    }
+    qt_blurrows<aprec, zprec, alphaOnly>(img, alpha, improvedQuality);
 
     QImage temp(img.height(), img.width(), img.format());
     temp.setDevicePixelRatio(img.devicePixelRatio());
@@ -746,11 +770,7 @@ void expblur(QImage &img, qreal radius, bool improvedQuality = false, int transp
         }
     }
 
-    img_height = temp.height();
-    for (int row = 0; row < img_height; ++row) {
-        for (int i = 0; i <= int(improvedQuality); ++i)
-            qt_blurrow<aprec, zprec, alphaOnly>(temp, row, alpha);
-    }
+    qt_blurrows<aprec, zprec, alphaOnly>(temp, alpha, improvedQuality);
 
     if (transposed == 0) {
         if (img.depth() == 8) {
@@ -862,7 +882,8 @@ Q_WIDGETS_EXPORT QImage qt_halfScaled(const QImage &source)
     return dest;
 }
 
-Q_WIDGETS_EXPORT void qt_blurImage(QPainter *p, QImage &blurImage, qreal radius, bool quality, bool alphaOnly, int transposed = 0)
+// Blurs blurImage, scaling it down for large radii; returns the scale to draw it with
+static qreal qt_blurImageScaled(QImage &blurImage, qreal radius, bool quality, bool alphaOnly, int transposed)
 {
     if (blurImage.format() != QImage::Format_ARGB32_Premultiplied
         && blurImage.format() != QImage::Format_RGB32)
@@ -881,12 +902,21 @@ Q_WIDGETS_EXPORT void qt_blurImage(QPainter *p, QImage &blurImage, qreal radius,
         expblur<12, 10, true>(blurImage, radius, quality, transposed);
     else
         expblur<12, 10, false>(blurImage, radius, quality, transposed);
+    return scale;
+}
 
-    if (p) {
-        p->scale(scale, scale);
-        p->setRenderHint(QPainter::SmoothPixmapTransform);
-        p->drawImage(QRect(QPoint(0, 0), blurImage.deviceIndependentSize().toSize()), blurImage);
-    }
+static void drawBlurredImage(QPainter *p, const QImage &blurImage, qreal scale)
+{
+    p->scale(scale, scale);
+    p->setRenderHint(QPainter::SmoothPixmapTransform);
+    p->drawImage(QRect(QPoint(0, 0), blurImage.deviceIndependentSize().toSize()), blurImage);
+}
+
+Q_WIDGETS_EXPORT void qt_blurImage(QPainter *p, QImage &blurImage, qreal radius, bool quality, bool alphaOnly, int transposed = 0)
+{
+    const qreal scale = qt_blurImageScaled(blurImage, radius, quality, alphaOnly, transposed);
+    if (p)
+        drawBlurredImage(p, blurImage, scale);
 }
 
 Q_WIDGETS_EXPORT void qt_blurImage(QImage &blurImage, qreal radius, bool quality, int transposed = 0)
@@ -925,18 +955,31 @@ void QPixmapBlurFilter::draw(QPainter *painter, const QPointF &p, const QPixmap
     if (qt_scaleForTransform(painter->transform(), &scale))
         scaledRadius /= scale;
 
-    QImage srcImage;
+    const bool quality = d->hints & QGraphicsBlurEffect::QualityHint;
+    auto &lastBlur = d->lastBlur;
+    if (lastBlur.image.isNull() || lastBlur.sourceKey != src.cacheKey()
+            || lastBlur.sourceRect != srcRect || lastBlur.radius != scaledRadius
+            || lastBlur.quality != quality) {
+        QImage srcImage;
 
-    if (srcRect == src.rect()) {
-        srcImage = src.toImage();
-    } else {
-        QRect rect = srcRect.toAlignedRect().intersected(src.rect());
-        srcImage = src.copy(rect).toImage();
+        if (srcRect == src.rect()) {
+            srcImage = src.toImage();
+        } else {
+            QRect rect = srcRect.toAlignedRect().intersected(src.rect());
+            srcImage = src.copy(rect).toImage();
+        }
+
+        lastBlur.scale = qt_blurImageScaled(srcImage, scaledRadius, quality, false, 0);
+        lastBlur.image = std::move(srcImage);
+        lastBlur.sourceKey = src.cacheKey();
+        lastBlur.sourceRect = srcRect;
+        lastBlur.radius = scaledRadius;
+        lastBlur.quality = quality;
     }
 
     QTransform transform = painter->worldTransform();
     painter->translate(p);
-    qt_blurImage(painter, srcImage, scaledRadius, (d->hints & QGraphicsBlurEffect::QualityHint), false);
+    drawBlurredImage(painter, lastBlur.image, lastBlur.scale);
     painter->setWorldTransform(transform);
 }
 
@@ -1152,6 +1195,15 @@ public:
     QPointF offset;
     QColor color;
     qreal radius;
+
+    // the last shadow drawn, and what it was made from
+    mutable struct {
+        qint64 sourceKey = 0;
+        QPointF offset;
+        QColor color;
+        qreal radius = 0;
+        QImage image;
+    } lastShadow;
 };
 
 /*!
@@ -1322,6 +1374,15 @@ void QPixmapDropShadowFilter::draw(QPainter *p,
     if (px.isNull())
         return;
 
+    auto &lastShadow = d->lastShadow;
+    if (!lastShadow.image.isNull() && lastShadow.sourceKey == px.cacheKey()
+            && lastShadow.offset == d->offset && lastShadow.color == d->color
+            && lastShadow.radius == d->radius) {
+        p->drawImage(pos, lastShadow.image);
+        p->drawPixmap(pos, px, src);
+        return;
+    }
+
     QImage tmp(px.size(), QImage::Format_ARGB32_Premultiplied);
     tmp.setDevicePixelRatio(px.devicePixelRatio());
     tmp.fill(0);
@@ -1346,6 +1407,12 @@ void QPixmapDropShadowFilter::draw(QPainter *p,
     tmpPainter.fillRect(tmp.rect(), d->color);
     tmpPainter.end();
 
+    lastShadow.sourceKey = px.cacheKey();
+    lastShadow.offset = d->offset;
+    lastShadow.color = d->color;
+    lastShadow.radius = d->radius;
+    lastShadow.image = tmp;
+
     // draw the blurred drop shadow...
     p->drawImage(pos, tmp);
 
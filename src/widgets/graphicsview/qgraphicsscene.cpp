@@ -193,6 +193,11 @@
     removing items is logarithmic. This approach is best for static scenes
     (i.e., scenes where most items do not move).
 
+    \value [since 6.4] QuadTreeIndex A loose quadtree is applied. Item location
+    is of an order close to logarithmic complexity. Moving an item only
+    updates that item's entry in the index, which makes this approach
+    suitable for large scenes where many items move.
+
     \value NoIndex No index is applied. Item location is of linear complexity,
     as all items on the scene are searched. Adding, moving and removing items,
     however, is done in constant time. This approach is ideal for dynamic
@@ -214,6 +219,7 @@
 #include "qgraphicswidget_p.h"
 #include "qgraphicssceneindex_p.h"
 #include "qgraphicsscenebsptreeindex_p.h"
+#include "qgraphicsscenequadtreeindex_p.h"
 #include "qgraphicsscenelinearindex_p.h"
 
 #include <QtCore/qdebug.h>
@@ -1860,7 +1866,9 @@ void QGraphicsScene::render(QPainter *painter, const QRectF &target, const QRect
 
     For the common case, the default index method BspTreeIndex works fine.  If
     your scene uses many animations and you are experiencing slowness, you can
-    disable indexing by calling \c setItemIndexMethod(NoIndex).
+    disable indexing by calling \c setItemIndexMethod(NoIndex). Large scenes
+    with many moving items can use \c setItemIndexMethod(QuadTreeIndex)
+    instead, which keeps the fast lookups without rebuilding the index.
 
     \sa bspTreeDepth
 */
@@ -1881,6 +1889,8 @@ void QGraphicsScene::setItemIndexMethod(ItemIndexMethod method)
     delete d->index;
     if (method == BspTreeIndex)
         d->index = new QGraphicsSceneBspTreeIndex(this);
+    else if (method == QuadTreeIndex)
+        d->index = new QGraphicsSceneQuadTreeIndex(this);
     else
         d->index = new QGraphicsSceneLinearIndex(this);
     for (int i = oldItems.size() - 1; i >= 0; --i)
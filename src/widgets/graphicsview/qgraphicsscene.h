@@ -108,6 +108,7 @@ class Q_WIDGETS_EXPORT QGraphicsScene : public QObject
 public:
     enum ItemIndexMethod {
         BspTreeIndex,
+        QuadTreeIndex,
         NoIndex = -1
     };
     Q_ENUM(ItemIndexMethod)
@@ -295,6 +296,8 @@ private:
     friend class QGraphicsSceneIndexPrivate;
     friend class QGraphicsSceneBspTreeIndex;
     friend class QGraphicsSceneBspTreeIndexPrivate;
+    friend class QGraphicsSceneQuadTreeIndex;
+    friend class QGraphicsSceneQuadTreeIndexPrivate;
     friend class QGraphicsItemEffectSourcePrivate;
 #ifndef QT_NO_GESTURES
     friend class QGesture;
@@ -0,0 +1,659 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtWidgets module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*!
+    \class QGraphicsSceneQuadTreeIndex
+    \brief The QGraphicsSceneQuadTreeIndex class provides a loose quadtree
+    index for discovering items in QGraphicsScene.
+    \since 6.4
+    \ingroup graphicsview-api
+
+    \internal
+
+    Each item is stored in exactly one node of the tree: the deepest one
+    whose cell contains the center of the item's bounding rect and is at
+    least as large as the item. A node's loose rect, its cell grown by half
+    the cell size on every side, therefore contains all the items of the
+    node, so queries skip every subtree whose loose rect they do not touch.
+
+    As the node of an item only depends on the item's own bounding rect,
+    moving an item takes it out of one node and puts it into another
+    without touching the rest of the tree. The tree is only rebuilt when
+    the scene rect outgrows the root cell; large batches of items are then
+    placed on the thread pool.
+
+    \sa QGraphicsScene, QGraphicsView, QGraphicsSceneIndex, QGraphicsSceneBspTreeIndex
+*/
+
+#include <QtCore/qglobal.h>
+
+#include <private/qgraphicsscene_p.h>
+#include <private/qgraphicsscenequadtreeindex_p.h>
+#include <private/qgraphicsscenebsptreeindex_p.h>
+
+#include <QtCore/qvarlengtharray.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// Cells at the deepest level are 1/4096 of the root cell on each side.
+static const int QuadTreeMaxDepth = 12;
+// Batches of at least this many items are placed on the thread pool.
+static const int QuadTreeParallelThreshold = 4096;
+
+static inline bool rectsTouch(const QRectF &a, const QRectF &b)
+{
+    return a.left() <= b.right() && b.left() <= a.right()
+        && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+static inline QRectF looseRect(const QRectF &cell)
+{
+    const qreal dx = cell.width() / 2;
+    const qreal dy = cell.height() / 2;
+    return cell.adjusted(-dx, -dy, dx, dy);
+}
+
+/*!
+    Constructs a private scene quadtree index.
+*/
+QGraphicsSceneQuadTreeIndexPrivate::QGraphicsSceneQuadTreeIndexPrivate(QGraphicsScene *scene)
+    : QGraphicsSceneIndexPrivate(scene),
+    nodes(1),
+    indexTimerId(0),
+    regenerateIndex(false)
+{
+}
+
+/*!
+    \internal
+
+    Returns the node an item with the bounding rect \a rect belongs in, as
+    its path from the root in Morton order followed by its depth. Sorting
+    by this key groups the items of each node and creates the nodes in
+    depth-first order.
+
+    Only depends on the root cell, so it can be called from any thread.
+*/
+quint32 QGraphicsSceneQuadTreeIndexPrivate::cellKey(const QRectF &rect) const
+{
+    const QPointF center = rect.center();
+    if (rootRect.isEmpty() || !rootRect.contains(center))
+        return 0;
+
+    qreal cellWidth = rootRect.width();
+    qreal cellHeight = rootRect.height();
+    int depth = 0;
+    while (depth < QuadTreeMaxDepth && rect.width() <= cellWidth / 2 && rect.height() <= cellHeight / 2) {
+        cellWidth /= 2;
+        cellHeight /= 2;
+        ++depth;
+    }
+
+    const int cells = 1 << depth;
+    const int x = qBound(0, int((center.x() - rootRect.left()) / cellWidth), cells - 1);
+    const int y = qBound(0, int((center.y() - rootRect.top()) / cellHeight), cells - 1);
+    quint32 path = 0;
+    for (int level = 1; level <= depth; ++level) {
+        const int shift = depth - level;
+        const quint32 quadrant = ((x >> shift) & 1) | (((y >> shift) & 1) << 1);
+        path |= quadrant << (2 * (QuadTreeMaxDepth - level));
+    }
+    return (path << 4) | quint32(depth);
+}
+
+/*!
+    \internal
+
+    Returns the child in \a quadrant of \a node, creating the node's four
+    children if needed.
+*/
+int QGraphicsSceneQuadTreeIndexPrivate::childNode(int node, int quadrant)
+{
+    if (nodes.at(node).firstChild == -1) {
+        const QRectF parentRect = nodes.at(node).looseRect;
+        const qreal width = parentRect.width() / 4;
+        const qreal height = parentRect.height() / 4;
+        const qreal left = parentRect.left() + width;
+        const qreal top = parentRect.top() + height;
+        const int firstChild = nodes.size();
+        nodes.resize(firstChild + 4);
+        for (int i = 0; i < 4; ++i) {
+            const QRectF cell(left + (i & 1) * width, top + (i >> 1) * height, width, height);
+            nodes[firstChild + i].looseRect = looseRect(cell);
+        }
+        nodes[node].firstChild = firstChild;
+    }
+    return nodes.at(node).firstChild + quadrant;
+}
+
+void QGraphicsSceneQuadTreeIndexPrivate::insertIntoNode(int entry, const QRectF &rect, quint32 key)
+{
+    const int depth = int(key & 0xf);
+    const quint32 path = key >> 4;
+    int node = 0;
+    for (int level = 1; level <= depth; ++level)
+        node = childNode(node, int(path >> (2 * (QuadTreeMaxDepth - level))) & 3);
+
+    Entry &e = entries[entry];
+    QList<NodeItem> &items = nodes[node].items;
+    e.node = node;
+    e.slot = items.size();
+    items.append({ rect, e.item });
+}
+
+void QGraphicsSceneQuadTreeIndexPrivate::takeFromNode(int entry)
+{
+    Entry &e = entries[entry];
+    if (e.node == -1)
+        return;
+
+    // Fill the hole with the node's last item.
+    QList<NodeItem> &items = nodes[e.node].items;
+    const NodeItem last = items.takeLast();
+    if (e.slot < items.size()) {
+        items[e.slot] = last;
+        entries[last.item->d_ptr->index].slot = e.slot;
+    }
+    e.node = -1;
+    e.slot = -1;
+}
+
+/*!
+    \internal
+
+    Places the items of the \a pending entries. Bounding rects are computed
+    on this thread as they come from virtual functions; working out the
+    nodes is done in parallel for large batches.
+*/
+void QGraphicsSceneQuadTreeIndexPrivate::insertPending(const QList<int> &pending)
+{
+    struct Placement
+    {
+        QRectF rect;
+        int entry;
+        quint32 key;
+    };
+    QList<Placement> placements;
+    placements.reserve(pending.size());
+
+    for (int entry : pending) {
+        Entry &e = entries[entry];
+        if (!e.pending)
+            continue; // removed or queued twice
+        e.pending = false;
+        QGraphicsItem *item = e.item;
+        if (item->d_ptr->itemIsUntransformable()) {
+            e.untransformable = true;
+            untransformableItems << item;
+            continue;
+        }
+        if (item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorClipsChildren
+            || item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren)
+            continue;
+        placements.append({ item->d_ptr->sceneEffectiveBoundingRect(), entry, 0 });
+    }
+
+    const qsizetype count = placements.size();
+    Placement *data = placements.data();
+#if QT_CONFIG(thread)
+    static const qsizetype chunkSize = 1024;
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const qsizetype chunks = (count + chunkSize - 1) / chunkSize;
+    const qsizetype tasks = qMin<qsizetype>(chunks, threadPool->maxThreadCount());
+    if (count >= QuadTreeParallelThreshold && tasks > 1 && !threadPool->contains(QThread::currentThread())) {
+        QSemaphore semaphore;
+        QAtomicInteger<qsizetype> next = 0;
+        for (qsizetype t = 0; t < tasks; ++t) {
+            threadPool->start([&] {
+                for (qsizetype c = next.fetchAndAddRelaxed(1); c < chunks; c = next.fetchAndAddRelaxed(1)) {
+                    const qsizetype end = qMin(count, (c + 1) * chunkSize);
+                    for (qsizetype i = c * chunkSize; i < end; ++i)
+                        data[i].key = cellKey(data[i].rect);
+                }
+                semaphore.release(1);
+            });
+        }
+        semaphore.acquire(int(tasks));
+    } else
+#endif
+    {
+        for (qsizetype i = 0; i < count; ++i)
+            data[i].key = cellKey(data[i].rect);
+    }
+
+    // Keep the nodes and the items of a node close together in memory.
+    if (count > 1) {
+        std::sort(placements.begin(), placements.end(), [](const Placement &a, const Placement &b) {
+            return a.key < b.key;
+        });
+    }
+    for (const Placement &placement : qAsConst(placements))
+        insertIntoNode(placement.entry, placement.rect, placement.key);
+}
+
+/*!
+    \internal
+
+    Places all pending items, rebuilding the tree first if the root cell
+    has changed.
+*/
+void QGraphicsSceneQuadTreeIndexPrivate::updateIndex()
+{
+    Q_Q(QGraphicsSceneQuadTreeIndex);
+    if (indexTimerId) {
+        q->killTimer(indexTimerId);
+        indexTimerId = 0;
+    }
+
+    if (regenerateIndex) {
+        regenerateIndex = false;
+        nodes.clear();
+        nodes.resize(1);
+        nodes[0].looseRect = looseRect(rootRect);
+        untransformableItems.clear();
+        for (int i = 0; i < entries.size(); ++i) {
+            Entry &e = entries[i];
+            if (!e.item)
+                continue;
+            e.node = -1;
+            e.slot = -1;
+            e.untransformable = false;
+            if (!e.pending) {
+                e.pending = true;
+                pendingEntries << i;
+            }
+        }
+    }
+
+    if (pendingEntries.isEmpty())
+        return;
+    const QList<int> pending = std::exchange(pendingEntries, {});
+    insertPending(pending);
+}
+
+/*!
+    \internal
+
+    Schedules placing the pending items.
+*/
+void QGraphicsSceneQuadTreeIndexPrivate::startIndexTimer()
+{
+    Q_Q(QGraphicsSceneQuadTreeIndex);
+    if (!indexTimerId)
+        indexTimerId = q->startTimer(0);
+}
+
+void QGraphicsSceneQuadTreeIndexPrivate::addItem(QGraphicsItem *item, bool recursive)
+{
+    if (!item)
+        return;
+
+    // Indexing requires sceneBoundingRect(), but because \a item might
+    // not be completely constructed at this point, it is only placed
+    // in the tree later.
+    if (item->d_ptr->index == -1) {
+        int entry;
+        if (!freeEntries.isEmpty()) {
+            entry = freeEntries.takeLast();
+        } else {
+            entry = entries.size();
+            entries.append(Entry());
+        }
+        item->d_ptr->index = entry;
+        entries[entry].item = item;
+        entries[entry].pending = true;
+        pendingEntries << entry;
+        startIndexTimer();
+    } else {
+        qWarning("QGraphicsSceneQuadTreeIndex::addItem: item has already been added to this index");
+    }
+
+    if (recursive) {
+        for (int i = 0; i < item->d_ptr->children.size(); ++i)
+            addItem(item->d_ptr->children.at(i), recursive);
+    }
+}
+
+void QGraphicsSceneQuadTreeIndexPrivate::removeItem(QGraphicsItem *item, bool recursive,
+                                                    bool moveToPendingItems)
+{
+    if (!item)
+        return;
+
+    const int entry = item->d_ptr->index;
+    if (entry != -1) {
+        Q_ASSERT(entries.at(entry).item == item);
+        Entry &e = entries[entry];
+        if (e.untransformable) {
+            untransformableItems.removeOne(item);
+            e.untransformable = false;
+        } else {
+            takeFromNode(entry);
+        }
+
+        if (moveToPendingItems) {
+            if (!e.pending) {
+                e.pending = true;
+                pendingEntries << entry;
+            }
+            startIndexTimer();
+        } else {
+            e = Entry();
+            freeEntries << entry;
+            item->d_ptr->index = -1;
+        }
+    }
+
+    if (recursive) {
+        for (int i = 0; i < item->d_ptr->children.size(); ++i)
+            removeItem(item->d_ptr->children.at(i), recursive, moveToPendingItems);
+    }
+}
+
+QList<QGraphicsItem *> QGraphicsSceneQuadTreeIndexPrivate::estimateItems(const QRectF &rect, Qt::SortOrder order,
+                                                                         bool onlyTopLevelItems)
+{
+    Q_Q(QGraphicsSceneQuadTreeIndex);
+    if (onlyTopLevelItems && rect.isNull())
+        return q->QGraphicsSceneIndex::estimateTopLevelItems(rect, order);
+
+    updateIndex();
+
+    const QRectF area = rect.normalized();
+    QList<QGraphicsItem *> rectItems;
+    // Three siblings at most wait on each level.
+    QVarLengthArray<int, 3 * QuadTreeMaxDepth + 1> stack;
+    stack.append(0);
+    while (!stack.isEmpty()) {
+        const Node &node = nodes.at(stack.last());
+        stack.removeLast();
+        for (const NodeItem &nodeItem : node.items) {
+            if (!rectsTouch(nodeItem.rect, area))
+                continue;
+            QGraphicsItem *item = nodeItem.item;
+            if (onlyTopLevelItems && item->d_ptr->parent)
+                item = item->topLevelItem();
+            if (!item->d_ptr->itemDiscovered && item->d_ptr->visible) {
+                item->d_ptr->itemDiscovered = 1;
+                rectItems << item;
+            }
+        }
+        if (node.firstChild != -1) {
+            for (int i = 0; i < 4; ++i) {
+                if (rectsTouch(nodes.at(node.firstChild + i).looseRect, area))
+                    stack.append(node.firstChild + i);
+            }
+        }
+    }
+    // Reset discovery bits.
+    for (QGraphicsItem *item : qAsConst(rectItems))
+        item->d_ptr->itemDiscovered = 0;
+
+    if (onlyTopLevelItems) {
+        for (int i = 0; i < untransformableItems.size(); ++i) {
+            QGraphicsItem *item = untransformableItems.at(i);
+            if (!item->d_ptr->parent) {
+                rectItems << item;
+            } else {
+                item = item->topLevelItem();
+                if (!rectItems.contains(item))
+                    rectItems << item;
+            }
+        }
+    } else {
+        rectItems += untransformableItems;
+    }
+
+    QGraphicsSceneBspTreeIndexPrivate::sortItems(&rectItems, order, /*cached=*/false, onlyTopLevelItems);
+    return rectItems;
+}
+
+/*!
+    Constructs a quadtree scene index for the given \a scene.
+*/
+QGraphicsSceneQuadTreeIndex::QGraphicsSceneQuadTreeIndex(QGraphicsScene *scene)
+    : QGraphicsSceneIndex(*new QGraphicsSceneQuadTreeIndexPrivate(scene), scene)
+{
+}
+
+QGraphicsSceneQuadTreeIndex::~QGraphicsSceneQuadTreeIndex()
+{
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    for (const auto &entry : qAsConst(d->entries)) {
+        // Ensure item bits are reset properly.
+        if (entry.item)
+            entry.item->d_ptr->index = -1;
+    }
+}
+
+/*!
+    \internal
+    Clears the quadtree index.
+*/
+void QGraphicsSceneQuadTreeIndex::clear()
+{
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    for (const auto &entry : qAsConst(d->entries)) {
+        if (entry.item)
+            entry.item->d_ptr->index = -1;
+    }
+    d->entries.clear();
+    d->freeEntries.clear();
+    d->pendingEntries.clear();
+    d->untransformableItems.clear();
+    d->nodes.clear();
+    d->nodes.resize(1);
+    d->nodes[0].looseRect = looseRect(d->rootRect);
+    d->regenerateIndex = false;
+}
+
+/*!
+    Add the \a item into the quadtree index.
+*/
+void QGraphicsSceneQuadTreeIndex::addItem(QGraphicsItem *item)
+{
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    d->addItem(item);
+}
+
+/*!
+    Remove the \a item from the quadtree index.
+*/
+void QGraphicsSceneQuadTreeIndex::removeItem(QGraphicsItem *item)
+{
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    d->removeItem(item);
+}
+
+/*!
+    \internal
+    Takes the \a item and its descendants out of their nodes; they are
+    placed again once their new bounding rects are known.
+*/
+void QGraphicsSceneQuadTreeIndex::prepareBoundingRectChange(const QGraphicsItem *item)
+{
+    if (!item)
+        return;
+
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    const int entry = item->d_ptr->index;
+    if (entry != -1 && d->entries.at(entry).node != -1)
+        d->removeItem(const_cast<QGraphicsItem *>(item), /*recursive=*/false, /*moveToPendingItems=*/true);
+    for (int i = 0; i < item->d_ptr->children.size(); ++i)
+        prepareBoundingRectChange(item->d_ptr->children.at(i));
+}
+
+/*!
+    Returns an estimation visible items that are either inside or
+    intersect with the specified \a rect and return a list sorted using \a order.
+*/
+QList<QGraphicsItem *> QGraphicsSceneQuadTreeIndex::estimateItems(const QRectF &rect, Qt::SortOrder order) const
+{
+    Q_D(const QGraphicsSceneQuadTreeIndex);
+    return const_cast<QGraphicsSceneQuadTreeIndexPrivate *>(d)->estimateItems(rect, order);
+}
+
+QList<QGraphicsItem *> QGraphicsSceneQuadTreeIndex::estimateTopLevelItems(const QRectF &rect, Qt::SortOrder order) const
+{
+    Q_D(const QGraphicsSceneQuadTreeIndex);
+    return const_cast<QGraphicsSceneQuadTreeIndexPrivate *>(d)->estimateItems(rect, order, /*onlyTopLevels=*/true);
+}
+
+/*!
+    Return all items in the quadtree index and sort them using \a order.
+*/
+QList<QGraphicsItem *> QGraphicsSceneQuadTreeIndex::items(Qt::SortOrder order) const
+{
+    Q_D(const QGraphicsSceneQuadTreeIndex);
+    QList<QGraphicsItem *> itemList;
+    itemList.reserve(d->entries.size() - d->freeEntries.size());
+    for (const auto &entry : d->entries) {
+        if (entry.item)
+            itemList << entry.item;
+    }
+    QGraphicsSceneBspTreeIndexPrivate::sortItems(&itemList, order, /*cached=*/false);
+    return itemList;
+}
+
+/*!
+    \internal
+
+    Items are placed relative to the root cell, so a new scene \a rect
+    means rebuilding the tree. That is only done when the scene outgrows
+    the root cell or shrinks to a fraction of it; items outside of the root
+    cell are kept in the root node.
+*/
+void QGraphicsSceneQuadTreeIndex::updateSceneRect(const QRectF &rect)
+{
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    const QRectF root = d->rootRect;
+    if (root.isEmpty() || rect.isEmpty()) {
+        if (root == rect)
+            return;
+        d->rootRect = rect;
+    } else if (!root.contains(rect)) {
+        // Leave room for the scene to grow further.
+        const qreal dx = rect.width() / 4;
+        const qreal dy = rect.height() / 4;
+        d->rootRect = rect.adjusted(-dx, -dy, dx, dy);
+    } else if (rect.width() * 4 < root.width() || rect.height() * 4 < root.height()) {
+        d->rootRect = rect;
+    } else {
+        return;
+    }
+    d->regenerateIndex = true;
+    d->startIndexTimer();
+}
+
+/*!
+    \internal
+
+    Updates the index when the \a item changes in a way that decides
+    whether it is in the tree.
+*/
+void QGraphicsSceneQuadTreeIndex::itemChange(const QGraphicsItem *item, QGraphicsItem::GraphicsItemChange change, const void *const value)
+{
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    switch (change) {
+    case QGraphicsItem::ItemFlagsChange: {
+        // Handle ItemIgnoresTransformations
+        QGraphicsItem::GraphicsItemFlags newFlags = *static_cast<const QGraphicsItem::GraphicsItemFlags *>(value);
+        bool ignoredTransform = item->d_ptr->flags & QGraphicsItem::ItemIgnoresTransformations;
+        bool willIgnoreTransform = newFlags & QGraphicsItem::ItemIgnoresTransformations;
+        bool clipsChildren = item->d_ptr->flags & QGraphicsItem::ItemClipsChildrenToShape
+                             || item->d_ptr->flags & QGraphicsItem::ItemContainsChildrenInShape;
+        bool willClipChildren = newFlags & QGraphicsItem::ItemClipsChildrenToShape
+                                || newFlags & QGraphicsItem::ItemContainsChildrenInShape;
+        if ((ignoredTransform != willIgnoreTransform) || (clipsChildren != willClipChildren)) {
+            // Place the item and its descendants again; they go into the
+            // tree or the list of untransformable items.
+            d->removeItem(const_cast<QGraphicsItem *>(item), /*recursive=*/true, /*moveToPendingItems=*/true);
+        }
+        break;
+    }
+    case QGraphicsItem::ItemParentChange: {
+        // Handle ItemIgnoresTransformations
+        const QGraphicsItem *newParent = static_cast<const QGraphicsItem *>(value);
+        bool ignoredTransform = item->d_ptr->itemIsUntransformable();
+        bool willIgnoreTransform = (item->d_ptr->flags & QGraphicsItem::ItemIgnoresTransformations)
+                                   || (newParent && newParent->d_ptr->itemIsUntransformable());
+        bool ancestorClippedChildren = item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorClipsChildren
+                                       || item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren;
+        bool ancestorWillClipChildren = newParent
+                            && ((newParent->d_ptr->flags & QGraphicsItem::ItemClipsChildrenToShape
+                                 || newParent->d_ptr->flags & QGraphicsItem::ItemContainsChildrenInShape)
+                                || (newParent->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorClipsChildren
+                                    || newParent->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren));
+        if ((ignoredTransform != willIgnoreTransform) || (ancestorClippedChildren != ancestorWillClipChildren))
+            d->removeItem(const_cast<QGraphicsItem *>(item), /*recursive=*/true, /*moveToPendingItems=*/true);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/*!
+    \reimp
+
+    Used to catch the timer event.
+
+    \internal
+*/
+bool QGraphicsSceneQuadTreeIndex::event(QEvent *event)
+{
+    Q_D(QGraphicsSceneQuadTreeIndex);
+    if (event->type() == QEvent::Timer && d->indexTimerId
+        && static_cast<QTimerEvent *>(event)->timerId() == d->indexTimerId) {
+        // this call will kill the timer
+        d->updateIndex();
+    }
+    return QObject::event(event);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qgraphicsscenequadtreeindex_p.cpp"
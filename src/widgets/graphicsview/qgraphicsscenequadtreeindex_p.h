@@ -0,0 +1,153 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtWidgets module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef QGRAPHICSSCENEQUADTREEINDEX_P_H
+#define QGRAPHICSSCENEQUADTREEINDEX_P_H
+
+#include <QtWidgets/private/qtwidgetsglobal_p.h>
+
+#include "qgraphicssceneindex_p.h"
+#include "qgraphicsitem_p.h"
+
+#include <QtCore/qrect.h>
+#include <QtCore/qlist.h>
+
+QT_REQUIRE_CONFIG(graphicsview);
+
+QT_BEGIN_NAMESPACE
+
+class QGraphicsScene;
+class QGraphicsSceneQuadTreeIndexPrivate;
+
+class Q_AUTOTEST_EXPORT QGraphicsSceneQuadTreeIndex : public QGraphicsSceneIndex
+{
+    Q_OBJECT
+public:
+    QGraphicsSceneQuadTreeIndex(QGraphicsScene *scene = nullptr);
+    ~QGraphicsSceneQuadTreeIndex();
+
+    QList<QGraphicsItem *> estimateItems(const QRectF &rect, Qt::SortOrder order) const override;
+    QList<QGraphicsItem *> estimateTopLevelItems(const QRectF &rect, Qt::SortOrder order) const override;
+    QList<QGraphicsItem *> items(Qt::SortOrder order = Qt::DescendingOrder) const override;
+
+protected Q_SLOTS:
+    void updateSceneRect(const QRectF &rect) override;
+
+protected:
+    bool event(QEvent *event) override;
+    void clear() override;
+
+    void addItem(QGraphicsItem *item) override;
+    void removeItem(QGraphicsItem *item) override;
+    void prepareBoundingRectChange(const QGraphicsItem *item) override;
+
+    void itemChange(const QGraphicsItem *item, QGraphicsItem::GraphicsItemChange change, const void *const value) override;
+
+private:
+    Q_DECLARE_PRIVATE(QGraphicsSceneQuadTreeIndex)
+    Q_DISABLE_COPY_MOVE(QGraphicsSceneQuadTreeIndex)
+};
+
+class QGraphicsSceneQuadTreeIndexPrivate : public QGraphicsSceneIndexPrivate
+{
+    Q_DECLARE_PUBLIC(QGraphicsSceneQuadTreeIndex)
+public:
+    QGraphicsSceneQuadTreeIndexPrivate(QGraphicsScene *scene);
+
+    // The items of a node are stored with their bounding rects, so that a
+    // query only touches the nodes it visits.
+    struct NodeItem
+    {
+        QRectF rect;
+        QGraphicsItem *item;
+    };
+
+    struct Node
+    {
+        QRectF looseRect;
+        int firstChild = -1; // the four children are allocated together
+        QList<NodeItem> items;
+    };
+
+    // One entry per item, found through QGraphicsItemPrivate::index.
+    struct Entry
+    {
+        QGraphicsItem *item = nullptr;
+        int node = -1; // -1 if the item is not in the tree
+        int slot = -1; // position in the node's items
+        bool pending = false; // waiting to be placed
+        bool untransformable = false;
+    };
+
+    QRectF rootRect;
+    QList<Node> nodes;
+    QList<Entry> entries;
+    QList<int> freeEntries;
+    QList<int> pendingEntries;
+    QList<QGraphicsItem *> untransformableItems;
+    int indexTimerId;
+    bool regenerateIndex;
+
+    void updateIndex();
+    void startIndexTimer();
+    void insertPending(const QList<int> &pending);
+    void insertIntoNode(int entry, const QRectF &rect, quint32 key);
+    void takeFromNode(int entry);
+    int childNode(int node, int quadrant);
+    quint32 cellKey(const QRectF &rect) const;
+
+    void addItem(QGraphicsItem *item, bool recursive = false);
+    void removeItem(QGraphicsItem *item, bool recursive = false, bool moveToPendingItems = false);
+    QList<QGraphicsItem *> estimateItems(const QRectF &rect, Qt::SortOrder order, bool onlyTopLevelItems = false);
+};
+
+QT_END_NAMESPACE
+
+#endif // QGRAPHICSSCENEQUADTREEINDEX_P_H
@@ -1158,6 +1158,7 @@ void QAbstractItemView::reset()
     if (d->selectionModel)
         d->selectionModel->reset();
 #ifndef QT_NO_ACCESSIBILITY
+    d->accessibleDataChangedTimer.stop();
     if (QAccessible::isActive()) {
         QAccessibleTableModelChangeEvent accessibleEvent(this, QAccessibleTableModelChangeEvent::ModelReset);
         QAccessible::updateAccessibility(&accessibleEvent);
@@ -2619,6 +2620,10 @@ void QAbstractItemView::timerEvent(QTimerEvent *event)
             scrollTo(d->pressedIndex);
     } else if (event->timerId() == d->pressClosedEditorWatcher.timerId()) {
         d->pressClosedEditorWatcher.stop();
+#ifndef QT_NO_ACCESSIBILITY
+    } else if (event->timerId() == d->accessibleDataChangedTimer.timerId()) {
+        d->flushAccessibleDataChanged();
+#endif
     }
 }
 
@@ -3420,14 +3425,8 @@ void QAbstractItemView::dataChanged(const QModelIndex &topLeft, const QModelInde
     }
 
 #ifndef QT_NO_ACCESSIBILITY
-    if (QAccessible::isActive()) {
-        QAccessibleTableModelChangeEvent accessibleEvent(this, QAccessibleTableModelChangeEvent::DataChanged);
-        accessibleEvent.setFirstRow(topLeft.row());
-        accessibleEvent.setFirstColumn(topLeft.column());
-        accessibleEvent.setLastRow(bottomRight.row());
-        accessibleEvent.setLastColumn(bottomRight.column());
-        QAccessible::updateAccessibility(&accessibleEvent);
-    }
+    if (QAccessible::isActive())
+        d->queueAccessibleDataChanged(topLeft, bottomRight);
 #endif
     d->updateGeometry();
 }
@@ -3549,6 +3548,7 @@ void QAbstractItemViewPrivate::_q_rowsRemoved(const QModelIndex &index, int star
     q->setState(QAbstractItemView::NoState);
 #ifndef QT_NO_ACCESSIBILITY
     if (QAccessible::isActive()) {
+        flushAccessibleDataChanged();
         QAccessibleTableModelChangeEvent accessibleEvent(q, QAccessibleTableModelChangeEvent::RowsRemoved);
         accessibleEvent.setFirstRow(start);
         accessibleEvent.setLastRow(end);
@@ -3640,6 +3640,7 @@ void QAbstractItemViewPrivate::_q_columnsRemoved(const QModelIndex &index, int s
     q->setState(QAbstractItemView::NoState);
 #ifndef QT_NO_ACCESSIBILITY
     if (QAccessible::isActive()) {
+        flushAccessibleDataChanged();
         QAccessibleTableModelChangeEvent accessibleEvent(q, QAccessibleTableModelChangeEvent::ColumnsRemoved);
         accessibleEvent.setFirstColumn(start);
         accessibleEvent.setLastColumn(end);
@@ -3664,6 +3665,7 @@ void QAbstractItemViewPrivate::_q_rowsInserted(const QModelIndex &index, int sta
 #ifndef QT_NO_ACCESSIBILITY
     Q_Q(QAbstractItemView);
     if (QAccessible::isActive()) {
+        flushAccessibleDataChanged();
         QAccessibleTableModelChangeEvent accessibleEvent(q, QAccessibleTableModelChangeEvent::RowsInserted);
         accessibleEvent.setFirstRow(start);
         accessibleEvent.setLastRow(end);
@@ -3689,6 +3691,7 @@ void QAbstractItemViewPrivate::_q_columnsInserted(const QModelIndex &index, int
         q->updateEditorGeometries();
 #ifndef QT_NO_ACCESSIBILITY
     if (QAccessible::isActive()) {
+        flushAccessibleDataChanged();
         QAccessibleTableModelChangeEvent accessibleEvent(q, QAccessibleTableModelChangeEvent::ColumnsInserted);
         accessibleEvent.setFirstColumn(start);
         accessibleEvent.setLastColumn(end);
@@ -3717,6 +3720,7 @@ void QAbstractItemViewPrivate::_q_layoutChanged()
     doDelayedItemsLayout();
 #ifndef QT_NO_ACCESSIBILITY
     Q_Q(QAbstractItemView);
+    accessibleDataChangedTimer.stop();
     if (QAccessible::isActive()) {
         QAccessibleTableModelChangeEvent accessibleEvent(q, QAccessibleTableModelChangeEvent::ModelReset);
         QAccessible::updateAccessibility(&accessibleEvent);
@@ -3734,6 +3738,61 @@ void QAbstractItemViewPrivate::_q_columnsMoved(const QModelIndex &, int, int, co
   _q_layoutChanged();
 }
 
+#ifndef QT_NO_ACCESSIBILITY
+/*!
+    \internal
+
+    Models that change many cells one by one would otherwise produce one
+    accessibility event per cell, so the changes are merged into a single
+    DataChanged event that is sent from the event loop.
+*/
+void QAbstractItemViewPrivate::queueAccessibleDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    Q_Q(QAbstractItemView);
+    const QRect changed(QPoint(topLeft.column(), topLeft.row()),
+                        QPoint(bottomRight.column(), bottomRight.row()));
+    if (!topLeft.isValid() || !changed.isValid()) {
+        flushAccessibleDataChanged();
+        QAccessibleTableModelChangeEvent accessibleEvent(q, QAccessibleTableModelChangeEvent::DataChanged);
+        accessibleEvent.setFirstRow(topLeft.row());
+        accessibleEvent.setFirstColumn(topLeft.column());
+        accessibleEvent.setLastRow(bottomRight.row());
+        accessibleEvent.setLastColumn(bottomRight.column());
+        QAccessible::updateAccessibility(&accessibleEvent);
+        return;
+    }
+
+    const QModelIndex parent = topLeft.parent();
+    if (accessibleDataChangedTimer.isActive() && parent != pendingAccessibleDataChangeParent)
+        flushAccessibleDataChanged();
+
+    if (accessibleDataChangedTimer.isActive()) {
+        pendingAccessibleDataChange |= changed;
+    } else {
+        pendingAccessibleDataChange = changed;
+        pendingAccessibleDataChangeParent = parent;
+        accessibleDataChangedTimer.start(0, q);
+    }
+}
+
+void QAbstractItemViewPrivate::flushAccessibleDataChanged()
+{
+    Q_Q(QAbstractItemView);
+    if (!accessibleDataChangedTimer.isActive())
+        return;
+    accessibleDataChangedTimer.stop();
+    if (!QAccessible::isActive())
+        return;
+
+    QAccessibleTableModelChangeEvent accessibleEvent(q, QAccessibleTableModelChangeEvent::DataChanged);
+    accessibleEvent.setFirstRow(pendingAccessibleDataChange.top());
+    accessibleEvent.setFirstColumn(pendingAccessibleDataChange.left());
+    accessibleEvent.setLastRow(pendingAccessibleDataChange.bottom());
+    accessibleEvent.setLastColumn(pendingAccessibleDataChange.right());
+    QAccessible::updateAccessibility(&accessibleEvent);
+}
+#endif
+
 QRect QAbstractItemViewPrivate::intersectedRect(const QRect rect, const QModelIndex &topLeft, const QModelIndex &bottomRight) const
 {
     Q_Q(const QAbstractItemView);
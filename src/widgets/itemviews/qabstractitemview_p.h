@@ -113,6 +113,11 @@ public:
     void _q_headerDataChanged() { doDelayedItemsLayout(); }
     void _q_scrollerStateChanged();
 
+#ifndef QT_NO_ACCESSIBILITY
+    void queueAccessibleDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void flushAccessibleDataChanged();
+#endif
+
     void fetchMore();
 
     bool shouldEdit(QAbstractItemView::EditTrigger trigger, const QModelIndex &index) const;
@@ -427,6 +432,13 @@ public:
     QBasicTimer delayedAutoScroll; //used when an item is clicked
     QBasicTimer delayedReset;
 
+#ifndef QT_NO_ACCESSIBILITY
+    // cells changed since the last DataChanged event; x is the column, y the row
+    QRect pendingAccessibleDataChange;
+    QModelIndex pendingAccessibleDataChangeParent;
+    QBasicTimer accessibleDataChangedTimer;
+#endif
+
     QAbstractItemView::ScrollMode verticalScrollMode;
     QAbstractItemView::ScrollMode horizontalScrollMode;
 
@@ -484,6 +484,8 @@ void QHeaderView::setOffset(int newOffset)
         d->firstPos += ndelta;
         d->lastPos += ndelta;
     }
+    if (d->resizeContentsSectionWindow >= 0 && d->contentsSections > 0)
+        d->doDelayedResizeSections(); // size the sections scrolled into the window
 }
 
 /*!
@@ -802,7 +804,7 @@ void QHeaderView::moveSection(int from, int to)
 
     qMoveRange(d->sectionItems, from, from + 1, to);
 
-    d->sectionStartposRecalc = true;
+    d->invalidateSectionStartPos(qMin(from, to));
 
     if (d->hasAutoResizeSections())
         d->doDelayedResizeSections();
@@ -1349,6 +1351,49 @@ int QHeaderView::resizeContentsPrecision() const
     return d->resizeContentsPrecision;
 }
 
+/*!
+   \since 6.4
+   Sets which sections QHeaderView measures when ResizeToContents is used.
+
+   Where resizeContentsPrecision() limits how many cells are looked at for
+   each section, \a sections limits which sections are looked at. Sections
+   outside the window keep their current size until they are scrolled into it.
+
+   Special value -1 (the default) means that all sections are resized to their
+   contents. Special value 0 means that only the sections in the visible area
+   are resized. A positive value means the visible sections plus up to
+   \a sections sections before and after them.
+
+   Restricting the window keeps auto resizing fast for headers with a very
+   large number of sections, at the cost of sizes changing while scrolling.
+
+   \sa resizeContentsSectionWindow(), setResizeContentsPrecision(), setSectionResizeMode()
+*/
+
+void QHeaderView::setResizeContentsSectionWindow(int sections)
+{
+    Q_D(QHeaderView);
+    sections = qMax(sections, -1);
+    if (d->resizeContentsSectionWindow == sections)
+        return;
+    d->resizeContentsSectionWindow = sections;
+    if (d->hasAutoResizeSections())
+        d->doDelayedResizeSections();
+}
+
+/*!
+   \since 6.4
+   Returns which sections QHeaderView will measure on ResizeToContents.
+
+   \sa setResizeContentsSectionWindow(), resizeContentsPrecision()
+*/
+
+int QHeaderView::resizeContentsSectionWindow() const
+{
+    Q_D(const QHeaderView);
+    return d->resizeContentsSectionWindow;
+}
+
 /*!
     \since 4.1
 
@@ -1937,7 +1982,7 @@ void QHeaderView::sectionsInserted(const QModelIndex &parent,
     }
 
     QHeaderViewPrivate::SectionItem section(d->defaultSectionSize, d->globalResizeMode);
-    d->sectionStartposRecalc = true;
+    d->invalidateSectionStartPos(insertAt);
 
     if (d->sectionItems.isEmpty() || insertAt >= d->sectionItems.count()) {
         int insertLength = d->defaultSectionSize * insertCount;
@@ -2070,7 +2115,7 @@ void QHeaderViewPrivate::_q_sectionsRemoved(const QModelIndex &parent,
             //Q_ASSERT(headerSectionCount() == sectionCount);
             removeSectionsFromSectionItems(visual, visual);
         } else {
-            sectionStartposRecalc = true; // We will need to recalc positions after removing items
+            invalidateSectionStartPos(); // We will need to recalc positions after removing items
             for (int u = 0; u < sectionItems.count(); ++u)  // Store section info
                 sectionItems.at(u).tmpLogIdx = logicalIndices.at(u);
             for (int v = sectionItems.count() - 1; v >= 0; --v) {  // Remove the sections
@@ -2163,6 +2208,7 @@ void QHeaderViewPrivate::_q_sectionsAboutToBeChanged(const QList<QPersistentMode
             if (itemRef.size != lastSectionSize) {
                 length += lastSectionSize - itemRef.size;
                 itemRef.size = lastSectionSize;
+                invalidateSectionStartPos(visual + 1);
             }
         }
     }
@@ -2263,7 +2309,7 @@ void QHeaderViewPrivate::_q_sectionsChanged(const QList<QPersistentModelIndex> &
         }
     }
 
-    recalcSectionStartPos();
+    invalidateSectionStartPos();
     length = headerLength();
 
     if (stretchLastSection) {
@@ -3497,16 +3543,14 @@ bool QHeaderViewPrivate::isSectionSelected(int section) const
 
 bool QHeaderViewPrivate::isFirstVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
+    ensureSectionStartPos(section);
     const SectionItem &item = sectionItems.at(section);
     return item.size > 0 && item.calculated_startpos == 0;
 }
 
 bool QHeaderViewPrivate::isLastVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
+    ensureSectionStartPos(section);
     const SectionItem &item = sectionItems.at(section);
     return item.size > 0 && item.calculatedEndPos() == length;
 }
@@ -3602,6 +3646,21 @@ void QHeaderViewPrivate::resizeSections(QHeaderView::ResizeMode globalMode, bool
     int lengthToStretch = (orientation == Qt::Horizontal ? viewport->width() : viewport->height());
     int numberOfStretchedSections = 0;
     QList<int> section_sizes;
+
+    // only sections inside the window around the viewport are sized to contents
+    int firstContentsSection = 0;
+    int lastContentsSection = sectionCount() - 1;
+    if (resizeContentsSectionWindow >= 0) {
+        int firstVisible = headerVisualIndexAt(offset);
+        int lastVisible = headerVisualIndexAt(offset + lengthToStretch - 1);
+        if (firstVisible < 0)
+            firstVisible = sectionCount() - 1;
+        if (lastVisible < 0)
+            lastVisible = sectionCount() - 1;
+        firstContentsSection = firstVisible - qMin(resizeContentsSectionWindow, firstVisible);
+        lastContentsSection = lastVisible + qMin(resizeContentsSectionWindow,
+                                                 sectionCount() - 1 - lastVisible);
+    }
     for (int i = 0; i < sectionCount(); ++i) {
         if (isVisualIndexHidden(i))
             continue;
@@ -3622,6 +3681,8 @@ void QHeaderViewPrivate::resizeSections(QHeaderView::ResizeMode globalMode, bool
         int sectionSize = 0;
         if (resizeMode == QHeaderView::Interactive || resizeMode == QHeaderView::Fixed) {
             sectionSize = qBound(q->minimumSectionSize(), headerSectionSize(i), q->maximumSectionSize());
+        } else if (i < firstContentsSection || i > lastContentsSection) {
+            sectionSize = headerSectionSize(i); // ResizeToContents outside the window
         } else { // resizeMode == QHeaderView::ResizeToContents
             int logicalIndex = q->logicalIndex(i);
             sectionSize = qMax(viewSectionSizeHint(logicalIndex),
@@ -3705,14 +3766,13 @@ void QHeaderViewPrivate::resizeSections(QHeaderView::ResizeMode globalMode, bool
 
 void QHeaderViewPrivate::createSectionItems(int start, int end, int sizePerSection, QHeaderView::ResizeMode mode)
 {
-    if (end >= sectionItems.count()) {
-        sectionItems.resize(end + 1);
-        sectionStartposRecalc = true;
-    }
+    if (end >= sectionItems.count())
+        sectionItems.resize(end + 1); // new items are past sectionStartposValidCount
     SectionItem *sectiondata = sectionItems.data();
     for (int i = start; i <= end; ++i) {
         length += (sizePerSection - sectiondata[i].size);
-        sectionStartposRecalc |= (sectiondata[i].size != sizePerSection);
+        if (sectiondata[i].size != sizePerSection)
+            invalidateSectionStartPos(i + 1);
         sectiondata[i].size = sizePerSection;
         sectiondata[i].resizeMode = mode;
     }
@@ -3721,7 +3781,7 @@ void QHeaderViewPrivate::createSectionItems(int start, int end, int sizePerSecti
 void QHeaderViewPrivate::removeSectionsFromSectionItems(int start, int end)
 {
     // remove sections
-    sectionStartposRecalc |= (end != sectionItems.count() - 1);
+    invalidateSectionStartPos(start);
     int removedlength = 0;
     for (int u = start; u <= end; ++u)
         removedlength += sectionItems.at(u).size;
@@ -3738,6 +3798,7 @@ void QHeaderViewPrivate::clear()
         sectionSelected.clear();
         hiddenSectionSize.clear();
         sectionItems.clear();
+        invalidateSectionStartPos();
         lastSectionLogicalIdx = -1;
         invalidateCachedSizeHint();
     }
@@ -3921,7 +3982,7 @@ void QHeaderViewPrivate::setDefaultSectionSize(int size)
             }
         }
     }
-    sectionStartposRecalc = true;
+    invalidateSectionStartPos();
     if (hasAutoResizeSections())
         doDelayedResizeSections();
     viewport->update();
@@ -3938,14 +3999,27 @@ void QHeaderViewPrivate::updateDefaultSectionSizeFromStyle()
     }
 }
 
-void QHeaderViewPrivate::recalcSectionStartPos() const // linear (but fast)
+/*!
+    \internal
+    Calculates the start positions of the sections up to and including
+    \a visual, continuing from the last section with a valid position.
+    Positions after \a visual are left for later, so that a change near the
+    end of a long header does not cost anything until it is looked at.
+*/
+void QHeaderViewPrivate::recalcSectionStartPos(int visual) const // linear (but fast)
 {
-    int pixelpos = 0;
-    for (const SectionItem &i : sectionItems) {
-        i.calculated_startpos = pixelpos; // write into const mutable
-        pixelpos += i.size;
+    const int count = sectionItems.count();
+    visual = qMin(visual, count - 1);
+    int u = sectionStartposValidCount;
+    if (u > visual)
+        return;
+    const SectionItem *sectiondata = sectionItems.constData();
+    int pixelpos = (u > 0 ? sectiondata[u - 1].calculatedEndPos() : 0);
+    for (; u <= visual; ++u) {
+        sectiondata[u].calculated_startpos = pixelpos; // write into const mutable
+        pixelpos += sectiondata[u].size;
     }
-    sectionStartposRecalc = false;
+    sectionStartposValidCount = u;
 }
 
 void QHeaderViewPrivate::resizeSectionItem(int visualIndex, int oldSize, int newSize)
@@ -3966,8 +4040,7 @@ int QHeaderViewPrivate::headerSectionSize(int visual) const
 int QHeaderViewPrivate::headerSectionPosition(int visual) const
 {
     if (visual < sectionCount() && visual >= 0) {
-        if (sectionStartposRecalc)
-            recalcSectionStartPos();
+        ensureSectionStartPos(visual);
         return sectionItems.at(visual).calculated_startpos;
     }
     return -1;
@@ -3975,10 +4048,15 @@ int QHeaderViewPrivate::headerSectionPosition(int visual) const
 
 int QHeaderViewPrivate::headerVisualIndexAt(int position) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
+    // extend the valid positions just far enough to cover position
+    const int count = sectionItems.count();
+    while (sectionStartposValidCount < count
+           && (sectionStartposValidCount == 0
+               || sectionItems.at(sectionStartposValidCount - 1).calculatedEndPos() <= position)) {
+        recalcSectionStartPos(qMin(count - 1, sectionStartposValidCount + 1023));
+    }
     int startidx = 0;
-    int endidx = sectionItems.count() - 1;
+    int endidx = sectionStartposValidCount - 1;
     while (startidx <= endidx) {
         int middle = (endidx + startidx) / 2;
         if (sectionItems.at(middle).calculated_startpos > position) {
@@ -4107,6 +4185,7 @@ void QHeaderViewPrivate::write(QDataStream &out) const
     out << customDefaultSectionSize;
     out << lastSectionSize;
     out << int(sortIndicatorClearable);
+    out << resizeContentsSectionWindow;
 }
 
 bool QHeaderViewPrivate::read(QDataStream &in)
@@ -4223,7 +4302,7 @@ bool QHeaderViewPrivate::read(QDataStream &in)
 
     sectionItems = newSectionItems;
     setHiddenSectionsFromBitVector(sectionHidden);
-    recalcSectionStartPos();
+    invalidateSectionStartPos();
 
     int tmpint;
     in >> tmpint;
@@ -4255,6 +4334,11 @@ bool QHeaderViewPrivate::read(QDataStream &in)
     if (in.status() == QDataStream::Ok)  // we haven't read past end
         sortIndicatorClearable = inSortIndicatorClearable;
 
+    int inResizeContentsSectionWindow;
+    in >> inResizeContentsSectionWindow;
+    if (in.status() == QDataStream::Ok)  // we haven't read past end
+        resizeContentsSectionWindow = inResizeContentsSectionWindow;
+
     return true;
 }
 
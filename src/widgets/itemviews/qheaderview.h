@@ -134,6 +134,8 @@ public:
 
     void setResizeContentsPrecision(int precision);
     int  resizeContentsPrecision() const;
+    void setResizeContentsSectionWindow(int sections);
+    int resizeContentsSectionWindow() const;
 
     int stretchSectionCount() const;
 
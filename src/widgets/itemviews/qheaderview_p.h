@@ -107,8 +107,9 @@ public:
           sectionIndicator(nullptr),
 #endif
           globalResizeMode(QHeaderView::Interactive),
-          sectionStartposRecalc(true),
-          resizeContentsPrecision(1000)
+          sectionStartposValidCount(0),
+          resizeContentsPrecision(1000),
+          resizeContentsSectionWindow(-1)
     {}
 
 
@@ -305,8 +306,9 @@ public:
     QLabel *sectionIndicator;
 #endif
     QHeaderView::ResizeMode globalResizeMode;
-    mutable bool sectionStartposRecalc;
+    mutable int sectionStartposValidCount; // calculated_startpos is valid for visual indexes below this
     int resizeContentsPrecision;
+    int resizeContentsSectionWindow;
     // header sections
 
     struct SectionItem {
@@ -318,8 +320,8 @@ public:
         union { // This union is made in order to save space and ensure good vector performance (on remove)
             mutable int calculated_startpos; // <- this is the primary used member.
             mutable int tmpLogIdx;         // When one of these 'tmp'-members has been used we call
-            int tmpDataStreamSectionCount; // recalcSectionStartPos() or set sectionStartposRecalc to true
-        };                                 // to ensure that calculated_startpos will be calculated afterwards.
+            int tmpDataStreamSectionCount; // invalidateSectionStartPos() to ensure that calculated_startpos
+        };                                 // will be calculated afterwards.
 
         inline SectionItem() : size(0), isHidden(0), resizeMode(QHeaderView::Interactive) {}
         inline SectionItem(int length, QHeaderView::ResizeMode mode)
@@ -346,7 +348,17 @@ public:
     void resizeSectionItem(int visualIndex, int oldSize, int newSize);
     void setDefaultSectionSize(int size);
     void updateDefaultSectionSizeFromStyle();
-    void recalcSectionStartPos() const; // not really const
+    void recalcSectionStartPos(int visual) const; // not really const
+
+    inline void invalidateSectionStartPos(int visual = 0) const {
+        if (visual < sectionStartposValidCount)
+            sectionStartposValidCount = qMax(visual, 0);
+    }
+
+    inline void ensureSectionStartPos(int visual) const {
+        if (visual >= sectionStartposValidCount)
+            recalcSectionStartPos(visual);
+    }
 
     inline int headerLength() const { // for debugging
         int len = 0;
@@ -62,7 +62,9 @@
 #include <qdebug.h>
 #include <qlocale.h>
 #include <qmath.h>
+#include <qscopeguard.h>
 
+#include <array>
 #include <limits.h>
 
 // keep in sync with QAbstractItemDelegate::helpEvent()
@@ -100,9 +102,46 @@ public:
 
     QString valueToText(const QVariant &value, const QStyleOptionViewItem &option) const;
 
+    // While paint() runs, the roles it needs for the painted index are fetched
+    // with a single multiData() call instead of one data() call per role.
+    void fetchPaintData(const QModelIndex &index) const
+    {
+        index.multiData(modelRoleData);
+        paintIndex = index;
+    }
+
+    void releasePaintData() const
+    {
+        paintIndex = QModelIndex();
+        for (QModelRoleData &roleData : modelRoleData)
+            roleData.clearData();
+    }
+
+    QVariant data(const QModelIndex &index, int role) const
+    {
+        if (paintIndex.isValid() && index == paintIndex) {
+            for (const QModelRoleData &roleData : modelRoleData) {
+                if (roleData.role() == role)
+                    return roleData.data();
+            }
+        }
+        return index.data(role);
+    }
+
     QItemEditorFactory *f;
     bool clipPainting;
 
+    mutable QModelIndex paintIndex;
+    mutable std::array<QModelRoleData, 7> modelRoleData = {
+        QModelRoleData(Qt::FontRole),
+        QModelRoleData(Qt::TextAlignmentRole),
+        QModelRoleData(Qt::ForegroundRole),
+        QModelRoleData(Qt::CheckStateRole),
+        QModelRoleData(Qt::DecorationRole),
+        QModelRoleData(Qt::DisplayRole),
+        QModelRoleData(Qt::BackgroundRole)
+    };
+
     QRect displayRect(const QModelIndex &index, const QStyleOptionViewItem &option,
                        const QRect &decorationRect, const QRect &checkRect) const;
     QRect textLayoutBounds(const QStyleOptionViewItem &option,
@@ -128,12 +167,12 @@ QRect QItemDelegatePrivate::displayRect(const QModelIndex &index, const QStyleOp
                                         const QRect &decorationRect, const QRect &checkRect) const
 {
     Q_Q(const QItemDelegate);
-    const QVariant value = index.data(Qt::DisplayRole);
+    const QVariant value = data(index, Qt::DisplayRole);
     if (!value.isValid() || value.isNull())
         return QRect();
 
     const QString text = valueToText(value, option);
-    const QVariant fontVal = index.data(Qt::FontRole);
+    const QVariant fontVal = data(index, Qt::FontRole);
     const QFont fnt = qvariant_cast<QFont>(fontVal).resolve(option.font);
     return q->textRectangle(nullptr,
                             textLayoutBounds(option, decorationRect, checkRect),
@@ -395,6 +434,9 @@ void QItemDelegate::paint(QPainter *painter,
     Q_D(const QItemDelegate);
     Q_ASSERT(index.isValid());
 
+    d->fetchPaintData(index);
+    const auto releasePaintData = qScopeGuard([d] { d->releasePaintData(); });
+
     QStyleOptionViewItem opt = setOptions(index, option);
 
     // prepare
@@ -408,7 +450,7 @@ void QItemDelegate::paint(QPainter *painter,
 
     QPixmap pixmap;
     QRect decorationRect;
-    value = index.data(Qt::DecorationRole);
+    value = d->data(index, Qt::DecorationRole);
     if (value.isValid()) {
         // ### we need the pixmap to call the virtual function
         pixmap = decoration(opt, value);
@@ -430,7 +472,7 @@ void QItemDelegate::paint(QPainter *painter,
 
     QRect checkRect;
     Qt::CheckState checkState = Qt::Unchecked;
-    value = index.data(Qt::CheckStateRole);
+    value = d->data(index, Qt::CheckStateRole);
     if (value.isValid()) {
         checkState = static_cast<Qt::CheckState>(value.toInt());
         checkRect = doCheck(opt, opt.rect, value);
@@ -438,7 +480,7 @@ void QItemDelegate::paint(QPainter *painter,
 
     QString text;
     QRect displayRect;
-    value = index.data(Qt::DisplayRole);
+    value = d->data(index, Qt::DisplayRole);
     if (value.isValid() && !value.isNull()) {
         text = d->valueToText(value, opt);
         displayRect = d->displayRect(index, opt, decorationRect, checkRect);
@@ -811,7 +853,8 @@ void QItemDelegate::drawBackground(QPainter *painter,
 
         painter->fillRect(option.rect, option.palette.brush(cg, QPalette::Highlight));
     } else {
-        QVariant value = index.data(Qt::BackgroundRole);
+        Q_D(const QItemDelegate);
+        QVariant value = d->data(index, Qt::BackgroundRole);
         if (value.canConvert<QBrush>()) {
             QPointF oldBO = painter->brushOrigin();
             painter->setBrushOrigin(option.rect.topLeft());
@@ -1208,22 +1251,23 @@ bool QItemDelegate::editorEvent(QEvent *event,
 QStyleOptionViewItem QItemDelegate::setOptions(const QModelIndex &index,
                                                const QStyleOptionViewItem &option) const
 {
+    Q_D(const QItemDelegate);
     QStyleOptionViewItem opt = option;
 
     // set font
-    QVariant value = index.data(Qt::FontRole);
+    QVariant value = d->data(index, Qt::FontRole);
     if (value.isValid()){
         opt.font = qvariant_cast<QFont>(value).resolve(opt.font);
         opt.fontMetrics = QFontMetrics(opt.font);
     }
 
     // set text alignment
-    value = index.data(Qt::TextAlignmentRole);
+    value = d->data(index, Qt::TextAlignmentRole);
     if (value.isValid())
         opt.displayAlignment = Qt::Alignment(value.toInt());
 
     // set foreground brush
-    value = index.data(Qt::ForegroundRole);
+    value = d->data(index, Qt::ForegroundRole);
     if (value.canConvert<QBrush>())
         opt.palette.setBrush(QPalette::Text, qvariant_cast<QBrush>(value));
 
@@ -747,9 +747,23 @@ void QListView::dataChanged(const QModelIndex &topLeft, const QModelIndex &botto
 void QListView::rowsInserted(const QModelIndex &parent, int start, int end)
 {
     Q_D(QListView);
-    // ### be smarter about inserted items
-    d->clear();
-    d->doDelayedItemsLayout();
+    // rows appended to a finished layout are laid out as one more batch
+    if (parent == d->root && start > 0 && start == d->batchStartRow()
+        && end == d->model->rowCount(d->root) - 1
+        && !d->delayedPendingLayout && !d->batchLayoutTimer.isActive()
+        && d->commonListView->continueBatchedLayout()) {
+        QAbstractItemView::State oldState = state();
+        setState(ExpandingState);
+        if (layoutMode() == SinglePass)
+            d->doItemsLayout(end - start + 1);
+        else if (!d->doItemsLayout(d->batchSize))
+            d->batchLayoutTimer.start(0, this);
+        updateGeometries();
+        setState(oldState);
+    } else {
+        d->clear();
+        d->doDelayedItemsLayout();
+    }
     QAbstractItemView::rowsInserted(parent, start, end);
 }
 
@@ -2736,6 +2750,24 @@ QList<QModelIndex> QListModeViewBase::intersectingSet(const QRect &area) const
     return ret;
 }
 
+/*!
+  \internal
+  Drops the end markers appended by the last batch, so that rows appended
+  to the model can be laid out as another batch.
+*/
+bool QListModeViewBase::continueBatchedLayout()
+{
+    if (flowPositions.isEmpty() || segmentPositions.count() < 2
+        || segmentExtents.isEmpty() || scrollValueMap.isEmpty()) {
+        return false;
+    }
+    flowPositions.removeLast();
+    segmentPositions.removeLast();
+    segmentExtents.removeLast();
+    scrollValueMap.removeLast();
+    return true;
+}
+
 void QListModeViewBase::dataChanged(const QModelIndex &, const QModelIndex &)
 {
     dd->doDelayedItemsLayout();
@@ -2894,8 +2926,14 @@ void QIconModeViewBase::setPositionForIndex(const QPoint &position, const QModel
         dd->viewUpdateGeometries(); // update the scroll bars
 }
 
+bool QIconModeViewBase::continueBatchedLayout()
+{
+    return batchStartRow == items.count();
+}
+
 void QIconModeViewBase::appendHiddenRow(int row)
 {
+    ensureBspTree();
     if (row >= 0 && row < items.count()) //remove item
         tree.removeLeaf(items.at(row).rect(), row);
     QCommonListViewBase::appendHiddenRow(row);
@@ -2904,6 +2942,7 @@ void QIconModeViewBase::appendHiddenRow(int row)
 void QIconModeViewBase::removeHiddenRow(int row)
 {
     QCommonListViewBase::removeHiddenRow(row);
+    ensureBspTree();
     if (row >= 0 && row < items.count()) //insert item
         tree.insertLeaf(items.at(row).rect(), row);
 }
@@ -3114,6 +3153,22 @@ void QIconModeViewBase::initBspTree(const QSize &contents)
     tree.init(QRect(0, 0, contents.width(), contents.height()), type);
 }
 
+/*!
+  \internal
+  Builds the tree for a uniform layout, once an item leaves its grid cell.
+*/
+void QIconModeViewBase::ensureBspTree()
+{
+    if (!uniformLayout)
+        return;
+    uniformLayout = false;
+    if (contentsSize.isEmpty())
+        return;
+    initBspTree(contentsSize);
+    for (int row = 0; row < items.count(); ++row)
+        tree.insertLeaf(items.at(row).rect(), row);
+}
+
 QPoint QIconModeViewBase::initDynamicLayout(const QListViewLayoutInfo &info)
 {
     int x, y;
@@ -3128,10 +3183,20 @@ QPoint QIconModeViewBase::initDynamicLayout(const QListViewLayoutInfo &info)
         const QListViewItem &item = items.at(idx);
         x = item.x;
         y = item.y;
-        if (info.flow == QListView::LeftToRight)
-            x += (info.grid.isValid() ? info.grid.width() : item.w) + info.spacing;
-        else
-            y += (info.grid.isValid() ? info.grid.height() : item.h) + info.spacing;
+        // items are centered in their grid cell along the flow
+        if (info.flow == QListView::LeftToRight) {
+            if (info.grid.isValid())
+                x += info.grid.width() - (info.grid.width() - item.w) / 2;
+            else
+                x += item.w;
+            x += info.spacing;
+        } else {
+            if (info.grid.isValid())
+                y += info.grid.height() - (info.grid.height() - item.h) / 2;
+            else
+                y += item.h;
+            y += info.spacing;
+        }
     }
     return QPoint(x, y);
 }
@@ -3173,6 +3238,19 @@ void QIconModeViewBase::doDynamicLayout(const QListViewLayoutInfo &info)
     if (moved.count() != items.count())
         moved.resize(items.count());
 
+    // with uniform items in a grid, the position of every item follows from
+    // its row, so there is no need to build the tree for hit testing
+    if (info.first == 0) {
+        uniformLayout = !useItemSize && uniformItemSizes() && hiddenCount() == 0
+                        && info.grid.width() > 0 && info.grid.height() > 0;
+        if (uniformLayout) {
+            const int available = segEndPosition - flowPosition;
+            uniformPerSegment = info.wrap ? qMax(1, available / deltaFlowPosition) : INT_MAX;
+            uniformOrigin = topLeft;
+            uniformCell = info.grid;
+        }
+    }
+
     QRect rect(QPoint(), topLeft);
     QListViewItem *item = nullptr;
     Q_ASSERT(info.first <= info.last);
@@ -3260,15 +3338,17 @@ void QIconModeViewBase::doDynamicLayout(const QListViewLayoutInfo &info)
     }
     if (rect.size().isEmpty())
         return;
-    // resize tree
-    int insertFrom = info.first;
-    if (done || info.first == 0) {
-        initBspTree(rect.size());
-        insertFrom = 0;
-    }
-    // insert items in tree
-    for (int row = insertFrom; row <= info.last; ++row)
-        tree.insertLeaf(items.at(row).rect(), row);
+    if (!uniformLayout) {
+        // resize tree
+        int insertFrom = info.first;
+        if (done || info.first == 0) {
+            initBspTree(rect.size());
+            insertFrom = 0;
+        }
+        // insert items in tree
+        for (int row = insertFrom; row <= info.last; ++row)
+            tree.insertLeaf(items.at(row).rect(), row);
+    }
     // if the new items are visible, update the viewport
     QRect changedRect(topLeft, rect.bottomRight());
     if (clipRect().intersects(changedRect))
@@ -3277,6 +3357,8 @@ void QIconModeViewBase::doDynamicLayout(const QListViewLayoutInfo &info)
 
 QList<QModelIndex> QIconModeViewBase::intersectingSet(const QRect &area) const
 {
+    if (uniformLayout)
+        return uniformIntersectingSet(area);
     QIconModeViewBase *that = const_cast<QIconModeViewBase*>(this);
     QBspTree::Data data(static_cast<void*>(that));
     QList<QModelIndex> res;
@@ -3286,6 +3368,52 @@ QList<QModelIndex> QIconModeViewBase::intersectingSet(const QRect &area) const
     return res;
 }
 
+/*!
+  \internal
+  Finds the items intersecting with \a area by looking only at the grid
+  cells it covers.
+*/
+QList<QModelIndex> QIconModeViewBase::uniformIntersectingSet(const QRect &area) const
+{
+    QList<QModelIndex> res;
+    const QRect cells = area.translated(-uniformOrigin);
+    int flowStart, flowEnd, segStart, segEnd, deltaFlow, deltaSeg;
+    if (flow() == QListView::LeftToRight) {
+        flowStart = cells.left();
+        flowEnd = cells.right();
+        segStart = cells.top();
+        segEnd = cells.bottom();
+        deltaFlow = uniformCell.width();
+        deltaSeg = uniformCell.height();
+    } else { // flow == QListView::TopToBottom
+        flowStart = cells.top();
+        flowEnd = cells.bottom();
+        segStart = cells.left();
+        segEnd = cells.right();
+        deltaFlow = uniformCell.height();
+        deltaSeg = uniformCell.width();
+    }
+    if (flowEnd < 0 || segEnd < 0)
+        return res;
+
+    const int count = items.count();
+    const int firstSeg = qMax(0, segStart / deltaSeg);
+    const int lastSeg = segEnd / deltaSeg;
+    const int first = qMax(0, flowStart / deltaFlow);
+    const int last = qMin(uniformPerSegment - 1, flowEnd / deltaFlow);
+    for (int seg = firstSeg; seg <= lastSeg; ++seg) {
+        const qint64 segStartRow = qint64(seg) * uniformPerSegment;
+        if (segStartRow >= count)
+            break;
+        for (int i = first; i <= last && segStartRow + i < count; ++i) {
+            const QListViewItem &item = items.at(segStartRow + i);
+            if (item.isValid() && item.rect().intersects(area))
+                res.append(dd->listViewItemToIndex(item));
+        }
+    }
+    return res;
+}
+
 QRect QIconModeViewBase::itemsRect(const QList<QModelIndex> &indexes) const
 {
     QRect rect;
@@ -3353,6 +3481,7 @@ void QIconModeViewBase::addLeaf(QList<int> &leaf, const QRect &area, uint visite
 void QIconModeViewBase::moveItem(int index, const QPoint &dest)
 {
     // does not impact on the bintree itself or the contents rect
+    ensureBspTree();
     QListViewItem *item = &items[index];
     QRect rect = item->rect();
 
@@ -3411,6 +3540,7 @@ void QIconModeViewBase::clear()
     tree.destroy();
     items.clear();
     moved.clear();
+    uniformLayout = false;
     batchStartRow = 0;
     batchSavedDeltaSeg = 0;
 }
@@ -142,6 +142,7 @@ public:
     virtual void appendHiddenRow(int row);
     virtual void removeHiddenRow(int row);
     virtual void setPositionForIndex(const QPoint &, const QModelIndex &) { }
+    virtual bool continueBatchedLayout() { return false; }
 
 #if QT_CONFIG(draganddrop)
     virtual void paintDragDrop(QPainter *painter);
@@ -215,6 +216,7 @@ public:
     void setRowCount(int rowCount) override { flowPositions.resize(rowCount); }
     QList<QModelIndex> intersectingSet(const QRect &area) const override;
     void dataChanged(const QModelIndex &, const QModelIndex &) override;
+    bool continueBatchedLayout() override;
 
     int horizontalScrollToValue(int index, QListView::ScrollHint hint,
         bool leftOf, bool rightOf,const QRect &area, const QRect &rect) const override;
@@ -248,12 +250,21 @@ private:
 class QIconModeViewBase : public QCommonListViewBase
 {
 public:
-    QIconModeViewBase(QListView *q, QListViewPrivate *d) : QCommonListViewBase(q, d), interSectingVector(nullptr) {}
+    QIconModeViewBase(QListView *q, QListViewPrivate *d)
+        : QCommonListViewBase(q, d), interSectingVector(nullptr), uniformLayout(false),
+          uniformPerSegment(0) {}
 
     QBspTree tree;
     QList<QListViewItem> items;
     QBitArray moved;
 
+    // set when all items sit in the cells of a regular grid; the tree is
+    // then left empty and hit testing is done arithmetically
+    bool uniformLayout;
+    int uniformPerSegment;
+    QPoint uniformOrigin;
+    QSize uniformCell;
+
     QList<QModelIndex> draggedItems; // indices to the tree.itemVector
     mutable QPoint draggedItemsPos;
 
@@ -273,6 +284,7 @@ public:
     void appendHiddenRow(int row) override;
     void removeHiddenRow(int row) override;
     void setPositionForIndex(const QPoint &position, const QModelIndex &index) override;
+    bool continueBatchedLayout() override;
 
 #if QT_CONFIG(draganddrop)
     bool filterDragMoveEvent(QDragMoveEvent *) override;
@@ -283,6 +295,8 @@ public:
 
 private:
     void initBspTree(const QSize &contents);
+    void ensureBspTree();
+    QList<QModelIndex> uniformIntersectingSet(const QRect &area) const;
     QPoint initDynamicLayout(const QListViewLayoutInfo &info);
     void doDynamicLayout(const QListViewLayoutInfo &info);
     static void addLeaf(QList<int> &leaf, const QRect &area, uint visited, QBspTree::Data data);
@@ -451,6 +451,7 @@ void QTreeView::setUniformRowHeights(bool uniform)
 {
     Q_D(QTreeView);
     d->uniformRowHeights = uniform;
+    d->invalidateHeightIndex();
 }
 
 /*!
@@ -2547,7 +2548,12 @@ void QTreeView::rowsInserted(const QModelIndex &parent, int start, int end)
     const int parentItem = d->viewIndex(parent);
     if (((parentItem != -1) && d->viewItems.at(parentItem).expanded)
         || (parent == d->root)) {
-        d->doDelayedItemsLayout();
+        if (d->insertViewItemsForRows(parentItem, parent, start, end)) {
+            updateGeometries();
+            viewport()->update();
+        } else {
+            d->doDelayedItemsLayout();
+        }
     } else if (parentItem != -1 && parentRowCount == delta) {
         // the parent just went from 0 children to more. update to re-paint the decoration
         d->viewItems[parentItem].hasChildren = true;
@@ -2564,7 +2570,8 @@ void QTreeView::rowsAboutToBeRemoved(const QModelIndex &parent, int start, int e
 {
     Q_D(QTreeView);
     QAbstractItemView::rowsAboutToBeRemoved(parent, start, end);
-    d->viewItems.clear();
+    if (!d->removeViewItemsForRows(parent, start, end))
+        d->viewItems.clear();
 }
 
 /*!
@@ -2576,8 +2583,13 @@ void QTreeView::rowsAboutToBeRemoved(const QModelIndex &parent, int start, int e
 void QTreeView::rowsRemoved(const QModelIndex &parent, int start, int end)
 {
     Q_D(QTreeView);
-    d->viewItems.clear();
-    d->doDelayedItemsLayout();
+    if (!d->viewItems.isEmpty() && d->updateViewItemsAfterRemoval(parent, start, end)) {
+        updateGeometries();
+        viewport()->update();
+    } else {
+        d->viewItems.clear();
+        d->doDelayedItemsLayout();
+    }
     d->hasRemovedItems = true;
     d->_q_rowsRemoved(parent, start, end);
 }
@@ -3126,6 +3138,7 @@ void QTreeViewPrivate::expand(int item, bool emitSignal)
 
 void QTreeViewPrivate::insertViewItems(int pos, int count, const QTreeViewItem &viewItem)
 {
+    invalidateHeightIndex();
     viewItems.insert(pos, count, viewItem);
     QTreeViewItem *items = viewItems.data();
     for (int i = pos + count; i < viewItems.count(); i++)
@@ -3135,6 +3148,7 @@ void QTreeViewPrivate::insertViewItems(int pos, int count, const QTreeViewItem &
 
 void QTreeViewPrivate::removeViewItems(int pos, int count)
 {
+    invalidateHeightIndex();
     viewItems.remove(pos, count);
     QTreeViewItem *items = viewItems.data();
     for (int i = pos; i < viewItems.count(); i++)
@@ -3142,6 +3156,176 @@ void QTreeViewPrivate::removeViewItems(int pos, int count)
             items[i].parentItem -= count;
 }
 
+/*!
+  \internal
+  Updates the model indexes of the view items from \a item to the end of
+  the children of \a parentItem, after the rows of \a parent were moved
+  by \a rowDelta. Returns \c false if the model has no index for one of
+  them, in which case the view needs to be laid out again.
+*/
+bool QTreeViewPrivate::updateFollowingViewItems(int parentItem, const QModelIndex &parent, int item, int rowDelta)
+{
+    const int parentEnd = parentItem == -1 ? viewItems.count()
+                                           : parentItem + 1 + viewItems.at(parentItem).total;
+    // The items are in pre-order, so parents are updated before their children.
+    for (int i = item; i < parentEnd; ++i) {
+        QTreeViewItem &viewItem = viewItems[i];
+        if (viewItem.parentItem == parentItem) {
+            viewItem.index = model->index(viewItem.index.row() + rowDelta, 0, parent);
+        } else {
+            viewItem.index = model->index(viewItem.index.row(), 0,
+                                          viewItems.at(viewItem.parentItem).index);
+        }
+        if (!viewItem.index.isValid())
+            return false;
+    }
+    return true;
+}
+
+/*!
+  \internal
+  Lays out the rows \a start to \a end that were inserted under \a parent,
+  the expanded view item \a parentItem or the root, without laying out the
+  rest of the tree. Returns \c false if the view needs to be laid out again
+  instead.
+*/
+bool QTreeViewPrivate::insertViewItemsForRows(int parentItem, const QModelIndex &parent, int start, int end)
+{
+    Q_Q(QTreeView);
+    if (viewItems.isEmpty() || state == QAbstractItemView::AnimatingState)
+        return false;
+
+    // find the first child that comes after the new rows
+    const int parentEnd = parentItem == -1 ? viewItems.count()
+                                           : parentItem + 1 + viewItems.at(parentItem).total;
+    int pos = parentItem + 1;
+    int previousSibling = -1;
+    while (pos < parentEnd && viewItems.at(pos).index.row() < start) {
+        previousSibling = pos;
+        pos += 1 + viewItems.at(pos).total;
+    }
+    const bool followedBySibling = pos < parentEnd;
+    if (!updateFollowingViewItems(parentItem, parent, pos, end - start + 1))
+        return false;
+
+    QModelIndexList rows;
+    rows.reserve(end - start + 1);
+    for (int row = start; row <= end; ++row) {
+        const QModelIndex current = model->index(row, 0, parent);
+        if (!isRowHidden(current))
+            rows.append(current);
+    }
+    if (rows.isEmpty())
+        return true;
+
+    if (uniformRowHeights && parent == root && start == 0)
+        defaultItemHeight = q->indexRowSizeHint(rows.first());
+
+    insertViewItems(pos, rows.count(), QTreeViewItem());
+    for (int i = parentItem; i > -1; i = viewItems.at(i).parentItem)
+        viewItems[i].total += rows.count();
+    if (parentItem != -1)
+        viewItems[parentItem].hasChildren = true;
+    if (previousSibling != -1)
+        viewItems[previousSibling].hasMoreSiblings = true;
+
+    const uint level = parentItem == -1 ? 0 : viewItems.at(parentItem).level + 1;
+    int last = pos;
+    for (const QModelIndex &current : qAsConst(rows)) {
+        last = pos;
+        QTreeViewItem *item = &viewItems[pos];
+        item->index = current;
+        item->parentItem = parentItem;
+        item->level = level;
+        item->spanning = q->isFirstColumnSpanned(current.row(), parent);
+        item->hasMoreSiblings = true;
+        if (isIndexExpanded(current)) {
+            item->expanded = true;
+            layout(pos);
+            item = &viewItems[pos];
+            item->hasChildren = item->total > 0;
+        } else {
+            item->hasChildren = hasVisibleChildren(current);
+        }
+        pos += 1 + item->total;
+    }
+    viewItems[last].hasMoreSiblings = followedBySibling;
+    return true;
+}
+
+/*!
+  \internal
+  Removes the view items of the rows \a start to \a end of \a parent, which
+  are about to be removed from the model. The items that follow them are
+  updated by updateViewItemsAfterRemoval(). Returns \c false if the view
+  needs to be laid out again instead.
+*/
+bool QTreeViewPrivate::removeViewItemsForRows(const QModelIndex &parent, int start, int end)
+{
+    removedRowsParentItem = -1;
+    removedRowsItem = -1;
+    if (delayedPendingLayout || viewItems.isEmpty() || state == QAbstractItemView::AnimatingState
+        || (parent.isValid() && parent.column() != 0)) {
+        return false;
+    }
+
+    const int parentItem = viewIndex(parent);
+    if (parent != root && (parentItem == -1 || !viewItems.at(parentItem).expanded)) {
+        // no view items for the rows
+        removedRowsParentItem = parentItem;
+        return true;
+    }
+
+    const int parentEnd = parentItem == -1 ? viewItems.count()
+                                           : parentItem + 1 + viewItems.at(parentItem).total;
+    int first = parentItem + 1;
+    int previousSibling = -1;
+    while (first < parentEnd && viewItems.at(first).index.row() < start) {
+        previousSibling = first;
+        first += 1 + viewItems.at(first).total;
+    }
+    int last = first;
+    while (last < parentEnd && viewItems.at(last).index.row() <= end)
+        last += 1 + viewItems.at(last).total;
+
+    const int count = last - first;
+    if (count > 0) {
+        removeViewItems(first, count);
+        for (int i = parentItem; i > -1; i = viewItems.at(i).parentItem)
+            viewItems[i].total -= count;
+        if (previousSibling != -1 && last == parentEnd)
+            viewItems[previousSibling].hasMoreSiblings = false;
+    }
+    removedRowsParentItem = parentItem;
+    removedRowsItem = first;
+    return true;
+}
+
+/*!
+  \internal
+  Completes removeViewItemsForRows() once the rows \a start to \a end of
+  \a parent have been removed from the model.
+*/
+bool QTreeViewPrivate::updateViewItemsAfterRemoval(const QModelIndex &parent, int start, int end)
+{
+    const int parentItem = removedRowsParentItem;
+    const int item = removedRowsItem;
+    removedRowsParentItem = -1;
+    removedRowsItem = -1;
+
+    if (item == -1) {
+        // the rows had no view items; the parent may have lost its last child
+        if (parentItem != -1)
+            viewItems[parentItem].hasChildren = hasVisibleChildren(parent);
+        return true;
+    }
+    if (!updateFollowingViewItems(parentItem, parent, item, start - end - 1))
+        return false;
+    if (parentItem != -1)
+        viewItems[parentItem].hasChildren = viewItems.at(parentItem).total > 0;
+    return true;
+}
+
 #if 0
 bool QTreeViewPrivate::checkViewItems() const
 {
@@ -3340,6 +3524,7 @@ void QTreeViewPrivate::_q_columnsRemoved(const QModelIndex &parent, int start, i
 void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninitialized)
 {
     Q_Q(QTreeView);
+    invalidateHeightIndex();
     QModelIndex current;
     QModelIndex parent = (i < 0) ? (QModelIndex)root : modelIndex(i);
 
@@ -3510,6 +3695,79 @@ int QTreeViewPrivate::itemHeight(int item) const
     return qMax(height, 0);
 }
 
+/*!
+  \internal
+  Brings the prefix sums of the item heights up to date. Building them
+  needs the height of every item, which the callers compute anyway to
+  find the size of the contents; afterwards, mapping between items and
+  coordinates takes O(log n).
+*/
+void QTreeViewPrivate::ensureHeightIndex() const
+{
+    const int count = viewItems.count();
+    if (heightIndexValid && heightIndex.count() == count + 1) {
+        for (int item : qAsConst(heightIndexPendingItems)) {
+            if (item < count)
+                heightIndexAdd(item, itemHeight(item) - (heightIndexSum(item + 1) - heightIndexSum(item)));
+        }
+        heightIndexPendingItems.clear();
+        return;
+    }
+
+    heightIndex.resize(count + 1);
+    heightIndex[0] = 0;
+    for (int i = 1; i <= count; ++i)
+        heightIndex[i] = itemHeight(i - 1);
+    for (int i = 1; i <= count; ++i) {
+        const int parent = i + (i & -i);
+        if (parent <= count)
+            heightIndex[parent] += heightIndex.at(i);
+    }
+    heightIndexPendingItems.clear();
+    heightIndexValid = true;
+}
+
+/*!
+  \internal
+  Returns the sum of the heights of the first \a count items.
+*/
+int QTreeViewPrivate::heightIndexSum(int count) const
+{
+    int sum = 0;
+    for (int i = count; i > 0; i -= i & -i)
+        sum += heightIndex.at(i);
+    return sum;
+}
+
+/*!
+  \internal
+  Returns the item at the contents coordinate \a y, or -1 if \a y is below
+  the last item.
+*/
+int QTreeViewPrivate::heightIndexFind(int y) const
+{
+    const int count = heightIndex.count() - 1;
+    int bit = 1;
+    while (bit * 2 <= count)
+        bit *= 2;
+    int item = 0;
+    for (; bit > 0; bit /= 2) {
+        if (item + bit <= count && heightIndex.at(item + bit) <= y) {
+            item += bit;
+            y -= heightIndex.at(item);
+        }
+    }
+    return item < count ? item : -1;
+}
+
+void QTreeViewPrivate::heightIndexAdd(int item, int delta) const
+{
+    if (!delta)
+        return;
+    for (int i = item + 1; i < heightIndex.count(); i += i & -i)
+        heightIndex[i] += delta;
+}
+
 
 /*!
   \internal
@@ -3520,12 +3778,9 @@ int QTreeViewPrivate::coordinateForItem(int item) const
     if (verticalScrollMode == QAbstractItemView::ScrollPerPixel) {
         if (uniformRowHeights)
             return (item * defaultItemHeight) - vbar->value();
-        // ### optimize (maybe do like QHeaderView by letting items have startposition)
-        int y = 0;
-        for (int i = 0; i < viewItems.count(); ++i) {
-            if (i == item)
-                return y - vbar->value();
-            y += itemHeight(i);
+        if (item >= 0 && item < viewItems.count()) {
+            ensureHeightIndex();
+            return heightIndexSum(item) - vbar->value();
         }
     } else { // ScrollPerItem
         int topViewItemIndex = vbar->value();
@@ -3578,14 +3833,8 @@ int QTreeViewPrivate::itemAtCoordinate(int coordinate) const
             const int viewItemIndex = (coordinate + vbar->value()) / defaultItemHeight;
             return ((viewItemIndex >= itemCount || viewItemIndex < 0) ? -1 : viewItemIndex);
         }
-        // ### optimize
-        int viewItemCoordinate = 0;
-        const int contentsCoordinate = coordinate + vbar->value();
-        for (int viewItemIndex = 0; viewItemIndex < viewItems.count(); ++viewItemIndex) {
-            viewItemCoordinate += itemHeight(viewItemIndex);
-            if (viewItemCoordinate > contentsCoordinate)
-                return (viewItemIndex >= itemCount ? -1 : viewItemIndex);
-        }
+        ensureHeightIndex();
+        return heightIndexFind(qMax(0, coordinate + vbar->value()));
     } else { // ScrollPerItem
         int topViewItemIndex = vbar->value();
         if (uniformRowHeights) {
@@ -3687,16 +3936,11 @@ int QTreeViewPrivate::firstVisibleItem(int *offset) const
             *offset = -(value % defaultItemHeight);
         return value / defaultItemHeight;
     }
-    int y = 0; // ### (maybe do like QHeaderView by letting items have startposition)
-    for (int i = 0; i < viewItems.count(); ++i) {
-        y += itemHeight(i); // the height value is cached
-        if (y > value) {
-            if (offset)
-                *offset = y - value - itemHeight(i);
-            return i;
-        }
-    }
-    return -1;
+    ensureHeightIndex();
+    const int item = heightIndexFind(qMax(0, value));
+    if (item != -1 && offset)
+        *offset = heightIndexSum(item) - value;
+    return item;
 }
 
 int QTreeViewPrivate::lastVisibleItem(int firstVisual, int offset) const
@@ -3760,9 +4004,9 @@ void QTreeViewPrivate::updateScrollBars()
         int contentsHeight = 0;
         if (uniformRowHeights) {
             contentsHeight = defaultItemHeight * viewItems.count();
-        } else { // ### (maybe do like QHeaderView by letting items have startposition)
-            for (int i = 0; i < viewItems.count(); ++i)
-                contentsHeight += itemHeight(i);
+        } else {
+            ensureHeightIndex();
+            contentsHeight = heightIndexSum(viewItems.count());
         }
         vbar->setRange(0, contentsHeight - viewportSize.height());
         vbar->setPageStep(viewportSize.height());
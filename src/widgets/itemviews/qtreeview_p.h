@@ -94,7 +94,7 @@ public:
           allColumnsShowFocus(false), customIndent(false), current(0), spanning(false),
           animationsEnabled(false), columnResizeTimerID(0),
           autoExpandDelay(-1), hoverBranch(-1), geometryRecursionBlock(false), hasRemovedItems(false),
-          treePosition(0) {}
+          treePosition(0), heightIndexValid(false), removedRowsParentItem(-1), removedRowsItem(-1) {}
 
     ~QTreeViewPrivate() {}
     void initialize();
@@ -154,6 +154,10 @@ public:
 
     void insertViewItems(int pos, int count, const QTreeViewItem &viewItem);
     void removeViewItems(int pos, int count);
+    bool insertViewItemsForRows(int parentItem, const QModelIndex &parent, int start, int end);
+    bool removeViewItemsForRows(const QModelIndex &parent, int start, int end);
+    bool updateViewItemsAfterRemoval(const QModelIndex &parent, int start, int end);
+    bool updateFollowingViewItems(int parentItem, const QModelIndex &parent, int item, int rowDelta);
 #if 0
     bool checkViewItems() const;
 #endif
@@ -243,7 +247,22 @@ public:
     inline int below(int item) const
         { int i = item; while (isItemHiddenOrDisabled(++item)){} return item >= viewItems.count() ? i : item; }
     inline void invalidateHeightCache(int item) const
-        { viewItems[item].height = 0; }
+    {
+        viewItems[item].height = 0;
+        if (heightIndexValid)
+            heightIndexPendingItems.append(item);
+    }
+
+    // prefix sums of the item heights, for ScrollPerPixel without uniform row heights
+    void ensureHeightIndex() const;
+    int heightIndexSum(int count) const;
+    int heightIndexFind(int y) const;
+    void heightIndexAdd(int item, int delta) const;
+    inline void invalidateHeightIndex() const
+    {
+        heightIndexValid = false;
+        heightIndexPendingItems.clear();
+    }
 
     inline int accessibleTable2Index(const QModelIndex &index) const {
         return (viewIndex(index) + (header ? 1 : 0)) * model->columnCount()+index.column();
@@ -275,6 +294,16 @@ public:
 
     // tree position
     int treePosition;
+
+    // Fenwick tree over the item heights; heightIndex[i] holds the sum of
+    // the heights of the items (i - (i & -i), i]
+    mutable QList<int> heightIndex;
+    mutable QList<int> heightIndexPendingItems;
+    mutable bool heightIndexValid;
+
+    // view items that follow rows being removed, see rowsAboutToBeRemoved()
+    int removedRowsParentItem;
+    int removedRowsItem;
 };
 
 QT_END_NAMESPACE
@@ -90,6 +90,8 @@
 
 #include <qthread.h>
 #include <private/qthread_p.h>
+#include <QtCore/private/qcoremetrics_p.h>
+#include <QtCore/private/qstartuptimeline_p.h>
 
 #include <QtGui/private/qevent_p.h>
 #include <QtGui/private/qeventpoint_p.h>
@@ -810,28 +812,18 @@ bool QApplication::compressEvent(QEvent *event, QObject *receiver, QPostEventLis
           || event->type() == QEvent::Resize
           || event->type() == QEvent::Move
           || event->type() == QEvent::LanguageChange)) {
-        for (QPostEventList::const_iterator it = postedEvents->constBegin(); it != postedEvents->constEnd(); ++it) {
-            const QPostEvent &cur = *it;
-            if (cur.receiver != receiver || cur.event == nullptr || cur.event->type() != event->type())
-                continue;
-            if (cur.event->type() == QEvent::LayoutRequest
-                 || cur.event->type() == QEvent::UpdateRequest) {
-                ;
-            } else if (cur.event->type() == QEvent::Resize) {
-                static_cast<QResizeEvent *>(cur.event)->m_size =
-                    static_cast<const QResizeEvent *>(event)->size();
-            } else if (cur.event->type() == QEvent::Move) {
-                static_cast<QMoveEvent *>(cur.event)->m_pos =
-                    static_cast<const QMoveEvent *>(event)->pos();
-            } else if (cur.event->type() == QEvent::LanguageChange) {
-                ;
-            } else {
-                continue;
-            }
-            delete event;
-            return true;
-        }
-        return false;
+        QEvent *pending = postedEvents->pendingCompressibleEvent(receiver, event->type());
+        if (!pending)
+            return false;
+        if (pending->type() == QEvent::Resize) {
+            static_cast<QResizeEvent *>(pending)->m_size =
+                static_cast<const QResizeEvent *>(event)->size();
+        } else if (pending->type() == QEvent::Move) {
+            static_cast<QMoveEvent *>(pending)->m_pos =
+                static_cast<const QMoveEvent *>(event)->pos();
+        }
+        delete event;
+        return true;
     }
     return QGuiApplication::compressEvent(event, receiver, postedEvents);
 }
@@ -913,6 +905,7 @@ QStyle *QApplication::style()
         }
 
         auto &defaultStyle = QApplicationPrivate::app_style;
+        QStartupTimelineScope timelineScope("QApplication::style");
 
         defaultStyle = QStyleFactory::create(QApplicationPrivate::desktopStyleKey());
         if (!defaultStyle) {
@@ -3301,6 +3294,7 @@ bool QApplicationPrivate::notify_helper(QObject *receiver, QEvent * e)
     bool consumed = false;
     bool filtered = false;
     Q_TRACE_EXIT(QApplication_notify_exit, consumed, filtered);
+    QMetricScopedTimer notifyTimer(QCoreMetrics::eventNotifyTime);
 
     // send to all application event filters
     if (threadRequiresCoreApplication()
@@ -113,6 +113,8 @@
 
 #include "qwindowcontainer_p.h"
 
+#include <qtwidgets_tracepoints_p.h>
+
 // widget/widget data creation count
 //#define QWIDGET_EXTRA_DEBUG
 //#define ALIEN_DEBUG
@@ -184,6 +186,7 @@ QWidgetPrivate::QWidgetPrivate(int version)
 #endif
       , childrenHiddenByWState(0)
       , childrenShownByExpose(0)
+      , hiddenChildrenUnpolished(0)
 #if defined(Q_OS_WIN)
       , noPaintOnScreen(0)
 #endif
@@ -982,6 +985,7 @@ void QWidgetPrivate::init(QWidget *parentWidget, Qt::WindowFlags f)
     wasWidget = true;
 
     Q_ASSERT_X(q != parentWidget, Q_FUNC_INFO, "Cannot parent a QWidget to itself");
+    Q_TRACE_SCOPE(QWidgetPrivate_init, q, parentWidget);
 
     if (Q_UNLIKELY(!qobject_cast<QApplication *>(QCoreApplication::instance())))
         qFatal("QWidget: Cannot create a QWidget without QApplication");
@@ -1141,6 +1145,8 @@ void QWidget::create(WId window, bool initializeWindow, bool destroyOldWindow)
     if (d->data.in_destructor)
         return;
 
+    Q_TRACE_SCOPE(QWidget_create, this, metaObject()->className());
+
     Qt::WindowType type = windowType();
     Qt::WindowFlags &flags = data->window_flags;
 
@@ -5651,6 +5657,7 @@ void QWidgetPrivate::drawWidget(QPaintDevice *pdev, const QRegion &rgn, const QP
 void QWidgetPrivate::sendPaintEvent(const QRegion &toBePainted)
 {
     Q_Q(QWidget);
+    Q_TRACE_SCOPE(QWidgetPrivate_sendPaintEvent, q, q->metaObject()->className());
     QPaintEvent e(toBePainted);
     QCoreApplication::sendSpontaneousEvent(q, &e);
 
@@ -7842,7 +7849,7 @@ void QWidgetPrivate::show_recursive()
 
     if (!q->testAttribute(Qt::WA_WState_Created))
         createRecursively();
-    q->ensurePolished();
+    ensurePolished(PolishChildren::SkipHidden);
 
     if (!q->isWindow() && q->parentWidget()->d_func()->layout && !q->parentWidget()->data->in_show)
         q->parentWidget()->d_func()->layout->activate();
@@ -8227,7 +8234,7 @@ void QWidgetPrivate::setVisible(bool visible)
         Qt::WindowStates initialWindowState = q->windowState();
 
         // polish if necessary
-        q->ensurePolished();
+        ensurePolished(PolishChildren::SkipHidden);
 
         // whether we need to inform the parent widget immediately
         bool needUpdateGeometry = !q->isWindow() && q->testAttribute(Qt::WA_WState_Hidden);
@@ -8918,7 +8925,8 @@ bool QWidget::event(QEvent *event)
         break;
 
     case QEvent::PolishRequest:
-        ensurePolished();
+        if (!d->deferPolishRequest())
+            ensurePolished();
         break;
 
     case QEvent::Polish: {
@@ -10063,31 +10071,82 @@ bool QWidget::nativeEvent(const QByteArray &eventType, void *message, qintptr *r
 void QWidget::ensurePolished() const
 {
     Q_D(const QWidget);
+    d->ensurePolished(QWidgetPrivate::PolishChildren::All);
+}
+
+/*!
+    \internal
+
+    Polishes the widget and its children. With PolishChildren::SkipHidden,
+    which is used when the widget is about to be shown, children that were
+    explicitly hidden are left alone, together with their subtrees; they are
+    polished when they are shown, when their size hint asks for it, or when
+    ensurePolished() is called on this widget. This keeps the pages of
+    stacked and tabbed widgets that are never looked at from being styled.
+    Widgets that are already polished are only descended into if one of
+    their descendants was skipped.
+*/
+void QWidgetPrivate::ensurePolished(PolishChildren mode) const
+{
+    Q_Q(const QWidget);
 
-    const QMetaObject *m = metaObject();
-    if (m == d->polished)
+    const QMetaObject *m = q->metaObject();
+    const bool polishSelf = m != polished;
+    if (!polishSelf && !hiddenChildrenUnpolished)
         return;
-    d->polished = m;
 
-    QEvent e(QEvent::Polish);
-    QCoreApplication::sendEvent(const_cast<QWidget *>(this), &e);
+    if (polishSelf) {
+        polished = m;
+
+        Q_TRACE_SCOPE(QWidget_polish, const_cast<QWidget *>(q), m->className());
+        QEvent e(QEvent::Polish);
+        QCoreApplication::sendEvent(const_cast<QWidget *>(q), &e);
+    }
 
     // polish children after 'this'
-    QList<QObject*> children = d->children;
+    hiddenChildrenUnpolished = false;
+    QList<QObject*> children = this->children;
     for (int i = 0; i < children.size(); ++i) {
         QObject *o = children.at(i);
         if (!o->isWidgetType())
             continue;
-        if (QWidget *w = qobject_cast<QWidget *>(o))
-            w->ensurePolished();
+        if (QWidget *w = qobject_cast<QWidget *>(o)) {
+            if (mode == PolishChildren::SkipHidden && w->isHidden()
+                && w->testAttribute(Qt::WA_WState_ExplicitShowHide)) {
+                hiddenChildrenUnpolished = true;
+                continue;
+            }
+            w->d_func()->ensurePolished(mode);
+        }
     }
 
-    if (d->parent && d->sendChildEvents) {
-        QChildEvent e(QEvent::ChildPolished, const_cast<QWidget *>(this));
-        QCoreApplication::sendEvent(d->parent, &e);
+    if (polishSelf && parent && sendChildEvents) {
+        QChildEvent e(QEvent::ChildPolished, const_cast<QWidget *>(q));
+        QCoreApplication::sendEvent(parent, &e);
     }
 }
 
+/*!
+    \internal
+
+    Returns \c true if the widget lives in a subtree that was explicitly
+    hidden, in which case the polish request posted at construction is
+    dropped; the ancestors up to the window are flagged so that the widget
+    is polished when its subtree is shown.
+*/
+bool QWidgetPrivate::deferPolishRequest() const
+{
+    Q_Q(const QWidget);
+    for (const QWidget *w = q; w && !w->isWindow(); w = w->parentWidget()) {
+        if (w->isHidden() && w->testAttribute(Qt::WA_WState_ExplicitShowHide)) {
+            for (QWidget *p = q->parentWidget(); p; p = p->isWindow() ? nullptr : p->parentWidget())
+                p->d_func()->hiddenChildrenUnpolished = true;
+            return true;
+        }
+    }
+    return false;
+}
+
 /*!
     Returns the mask currently set on a widget. If no mask is set the
     return value will be an empty region.
@@ -279,6 +279,10 @@ public:
     void createRecursively();
     void createWinId();
 
+    enum class PolishChildren { All, SkipHidden };
+    void ensurePolished(PolishChildren mode) const;
+    bool deferPolishRequest() const;
+
     bool setScreenForPoint(const QPoint &pos);
     bool setScreen(QScreen *screen);
 
@@ -764,6 +768,7 @@ public:
 #endif
     uint childrenHiddenByWState : 1;
     uint childrenShownByExpose : 1;
+    mutable uint hiddenChildrenUnpolished : 1;
 
     // *************************** Platform specific ************************************
 #if defined(Q_OS_WIN)
@@ -188,6 +188,19 @@ void QWidgetPrivate::invalidateBackingStore(const T &r)
 // Needed by tst_QWidget
 template Q_AUTOTEST_EXPORT void QWidgetPrivate::invalidateBackingStore<QRect>(const QRect &r);
 
+// Uniting a region with a rectangle gets slower the more rectangles the
+// region consists of. Once a dirty region is this fragmented, repainting its
+// bounding rectangle is cheaper than keeping track of it exactly.
+static constexpr int MaxDirtyRegionRects = 256;
+
+template <class T>
+static void addDirty(QRegion &dirty, const T &r)
+{
+    dirty += r;
+    if (dirty.rectCount() > MaxDirtyRegionRects)
+        dirty = dirty.boundingRect();
+}
+
 static inline QRect widgetRectFor(QWidget *, const QRect &r) { return r; }
 static inline QRect widgetRectFor(QWidget *widget, const QRegion &) { return widget->rect(); }
 
@@ -235,7 +248,7 @@ void QWidgetRepaintManager::markDirty(const T &r, QWidget *widget, UpdateTime up
         }
 
         const bool eventAlreadyPosted = !widget->d_func()->dirty.isEmpty();
-        widget->d_func()->dirty += r;
+        addDirty(widget->d_func()->dirty, r);
         if (!eventAlreadyPosted || updateTime == UpdateNow)
             sendUpdateRequest(widget, updateTime);
         return;
@@ -272,10 +285,10 @@ void QWidgetRepaintManager::markDirty(const T &r, QWidget *widget, UpdateTime up
         const bool eventAlreadyPosted = !dirty.isEmpty() || updateRequestSent;
 #if QT_CONFIG(graphicseffect)
         if (widget->d_func()->graphicsEffect)
-            dirty += widget->d_func()->effectiveRectFor(r).translated(offset);
+            addDirty(dirty, widget->d_func()->effectiveRectFor(r).translated(offset));
         else
 #endif
-            dirty += r.translated(offset);
+            addDirty(dirty, r.translated(offset));
 
         if (!eventAlreadyPosted || updateTime == UpdateNow)
             sendUpdateRequest(tlw, updateTime);
@@ -296,10 +309,10 @@ void QWidgetRepaintManager::markDirty(const T &r, QWidget *widget, UpdateTime up
         if (!qt_region_strictContains(widget->d_func()->dirty, effectiveWidgetRect)) {
 #if QT_CONFIG(graphicseffect)
             if (widget->d_func()->graphicsEffect)
-                widget->d_func()->dirty += widget->d_func()->effectiveRectFor(r);
+                addDirty(widget->d_func()->dirty, widget->d_func()->effectiveRectFor(r));
             else
 #endif
-                widget->d_func()->dirty += r;
+                addDirty(widget->d_func()->dirty, r);
         }
     } else {
         addDirtyWidget(widget, r);
@@ -572,6 +585,35 @@ bool QWidgetRepaintManager::bltRect(const QRect &rect, int dx, int dy, QWidget *
 // ---------------------------------------------------------------------------
 
 #ifndef QT_NO_OPENGL
+// Returns true if nothing is painted into the backingstore on top of the
+// render-to-texture widget \a widget, i.e. it has no visible children and no
+// visible sibling of it or of one of its ancestors stacks above it and
+// overlaps it.
+static bool isUnobscured(QWidget *tlw, QWidget *widget, const QRect &rectInTlw)
+{
+    for (QObject *child : widget->children()) {
+        QWidget *w = qobject_cast<QWidget *>(child);
+        if (w && !w->isWindow() && !w->isHidden())
+            return false;
+    }
+
+    for (QWidget *w = widget; w != tlw; w = w->parentWidget()) {
+        QWidget *parent = w->parentWidget();
+        if (!parent)
+            break;
+        const QObjectList &siblings = parent->children();
+        for (qsizetype i = siblings.indexOf(w) + 1; i < siblings.size(); ++i) {
+            QWidget *sibling = qobject_cast<QWidget *>(siblings.at(i));
+            if (!sibling || sibling->isWindow() || sibling->isHidden())
+                continue;
+            const QRect siblingRect(sibling->mapTo(tlw, QPoint()), sibling->size());
+            if (siblingRect.intersects(rectInTlw))
+                return false;
+        }
+    }
+    return true;
+}
+
 static void findTextureWidgetsRecursively(QWidget *tlw, QWidget *widget,
                                           QPlatformTextureList *widgetTextures,
                                           QList<QWidget *> *nativeChildren)
@@ -579,7 +621,12 @@ static void findTextureWidgetsRecursively(QWidget *tlw, QWidget *widget,
     QWidgetPrivate *wd = QWidgetPrivate::get(widget);
     if (wd->renderToTexture) {
         QPlatformTextureList::Flags flags = wd->textureListFlags();
+        // Still in the dirty list means new content since the last composition
+        if (wd->inDirtyList)
+            flags |= QPlatformTextureList::TextureIsDirty;
         const QRect rect(widget->mapTo(tlw, QPoint()), widget->size());
+        if (isUnobscured(tlw, widget, rect))
+            flags |= QPlatformTextureList::Unobscured;
         widgetTextures->appendTexture(widget, wd->textureId(), rect, wd->clipRect(), flags);
     }
 
@@ -675,6 +722,20 @@ void QWidgetRepaintManager::sync(QWidget *exposedWidget, const QRegion &exposedR
 
     // Nothing to repaint.
     if (!isDirty() && store->size().isValid()) {
+#ifndef QT_NO_OPENGL
+        // The texture lists from the last paint may still flag textures as
+        // dirty, which would limit the composition to those. Refresh them so
+        // that the exposed area gets composed in full. Lists still in use by
+        // the platform must not be touched.
+        QTLWExtra *tlwExtra = tlw->d_func()->topData();
+        bool texturesInUse = false;
+        for (const auto &tl : tlwExtra->widgetTextures)
+            texturesInUse |= tl->isLocked();
+        if (!tlwExtra->widgetTextures.empty() && !texturesInUse) {
+            tlwExtra->widgetTextures.clear();
+            findAllTextureWidgetsRecursively(tlw, tlw);
+        }
+#endif
         QPlatformTextureList *widgetTextures = widgetTexturesFor(tlw, exposedWidget);
         flush(exposedWidget, widgetTextures ? QRegion() : exposedRegion, widgetTextures);
         return;
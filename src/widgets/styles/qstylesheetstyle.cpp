@@ -1662,6 +1662,69 @@ private:
     mutable QHash<const QObject *, QHash<QString, QString> > m_attributeCache;
 };
 
+static void addSelectorAttributeNames(const QList<StyleRule> &rules, QStringList *names)
+{
+    for (const StyleRule &rule : rules) {
+        for (const Selector &selector : rule.selectors) {
+            for (const BasicSelector &basicSelector : selector.basicSelectors) {
+                for (const AttributeSelector &a : basicSelector.attributeSelectors) {
+                    if (!names->contains(a.name))
+                        names->append(a.name);
+                }
+            }
+        }
+    }
+}
+
+static QStringList selectorAttributeNames(const StyleSheet &ss)
+{
+    QStringList names;
+    addSelectorAttributeNames(ss.styleRules, &names);
+    addSelectorAttributeNames(ss.nameIndex.values(), &names);
+    addSelectorAttributeNames(ss.idIndex.values(), &names);
+    addSelectorAttributeNames(ss.classIndex.values(), &names);
+    for (const MediaRule &mediaRule : ss.mediaRules)
+        addSelectorAttributeNames(mediaRule.styleRules, &names);
+    return names;
+}
+
+enum { MaxSharedStyleRules = 4096 };
+
+/*
+    Returns a key that is equal for two objects exactly when no selector of
+    the style sheets in \a selector can distinguish them: the same base style,
+    and along the parent chain the same classes, object names, values of the
+    attributes the selectors test and style sheet owners.
+*/
+static QString styleRulesKey(const QObject *obj, const QStyle *baseStyle,
+                             const QStyleSheetStyleSelector &selector)
+{
+    QStringList attributeNames = styleSheetCaches->styleSheetAttributeNames.value(baseStyle);
+    attributeNames += styleSheetCaches->styleSheetAttributeNames.value(qApp);
+    for (const QObject *o = obj; o; o = parentObject(o))
+        attributeNames += styleSheetCaches->styleSheetAttributeNames.value(o);
+    attributeNames.removeDuplicates();
+
+    QString key = QString::number(quintptr(baseStyle), 16);
+    for (const QObject *o = obj; o; o = parentObject(o)) {
+        key += QLatin1Char('/');
+        if (styleSheetCaches->styleSheetCache.contains(o))
+            key += QString::number(quintptr(o), 16);
+        key += QLatin1Char(':') + QString::number(quintptr(o->metaObject()), 16);
+        const QString name = o->objectName();
+        key += QLatin1Char(':') + QString::number(name.size()) + QLatin1Char(':') + name;
+        StyleSelector::NodePtr n;
+        n.ptr = const_cast<QObject *>(o);
+        for (const QString &attributeName : qAsConst(attributeNames)) {
+            AttributeSelector a;
+            a.name = attributeName;
+            const QString value = selector.attributeValue(n, a);
+            key += QLatin1Char(':') + QString::number(value.size()) + QLatin1Char(':') + value;
+        }
+    }
+    return key;
+}
+
 QList<QCss::StyleRule> QStyleSheetStyle::styleRules(const QObject *obj) const
 {
     QHash<const QObject *, QList<StyleRule>>::const_iterator cacheIt =
@@ -1681,6 +1744,7 @@ QList<QCss::StyleRule> QStyleSheetStyle::styleRules(const QObject *obj) const
         defaultSs = getDefaultStyleSheet();
         QStyle *bs = baseStyle();
         styleSheetCaches->styleSheetCache.insert(bs, defaultSs);
+        styleSheetCaches->styleSheetAttributeNames.insert(bs, selectorAttributeNames(defaultSs));
         QObject::connect(bs, SIGNAL(destroyed(QObject*)), styleSheetCaches, SLOT(styleDestroyed(QObject*)), Qt::UniqueConnection);
     } else {
         defaultSs = defaultCacheIt.value();
@@ -1700,6 +1764,7 @@ QList<QCss::StyleRule> QStyleSheetStyle::styleRules(const QObject *obj) const
             appSs.origin = StyleSheetOrigin_Inline;
             appSs.depth = 1;
             styleSheetCaches->styleSheetCache.insert(qApp, appSs);
+            styleSheetCaches->styleSheetAttributeNames.insert(qApp, selectorAttributeNames(appSs));
         } else {
             appSs = appCacheIt.value();
         }
@@ -1722,6 +1787,7 @@ QList<QCss::StyleRule> QStyleSheetStyle::styleRules(const QObject *obj) const
             }
             ss.origin = StyleSheetOrigin_Inline;
             styleSheetCaches->styleSheetCache.insert(o, ss);
+            styleSheetCaches->styleSheetAttributeNames.insert(o, selectorAttributeNames(ss));
         } else {
             ss = objCacheIt.value();
         }
@@ -1733,10 +1799,23 @@ QList<QCss::StyleRule> QStyleSheetStyle::styleRules(const QObject *obj) const
 
     styleSelector.styleSheets += objectSs;
 
+    // Objects that agree on everything the selectors can look at resolve to
+    // the same rules, so the matching result is shared between them.
+    const QString key = styleRulesKey(obj, baseStyle(), styleSelector);
+    QHash<QString, QList<StyleRule>>::const_iterator sharedIt =
+            styleSheetCaches->sharedStyleRulesCache.constFind(key);
+    if (sharedIt != styleSheetCaches->sharedStyleRulesCache.constEnd()) {
+        styleSheetCaches->styleRulesCache.insert(obj, sharedIt.value());
+        return sharedIt.value();
+    }
+
     StyleSelector::NodePtr n;
     n.ptr = const_cast<QObject *>(obj);
     QList<QCss::StyleRule> rules = styleSelector.styleRulesForNode(n);
     styleSheetCaches->styleRulesCache.insert(obj, rules);
+    if (styleSheetCaches->sharedStyleRulesCache.size() >= MaxSharedStyleRules)
+        styleSheetCaches->sharedStyleRulesCache.clear();
+    styleSheetCaches->sharedStyleRulesCache.insert(key, rules);
     return rules;
 }
 
@@ -2878,13 +2957,13 @@ void QStyleSheetStyleCaches::objectDestroyed(QObject *o)
     renderRulesCache.remove(o);
     customPaletteWidgets.remove((const QWidget *)o);
     customFontWidgets.remove(static_cast<QWidget *>(o));
-    styleSheetCache.remove(o);
+    removeStyleSheet(o);
     autoFillDisabledWidgets.remove((const QWidget *)o);
 }
 
 void QStyleSheetStyleCaches::styleDestroyed(QObject *o)
 {
-    styleSheetCache.remove(o);
+    removeStyleSheet(o);
 }
 
 /*!
@@ -2921,7 +3000,7 @@ void QStyleSheetStyle::polish(QWidget *w)
         styleSheetCaches->styleRulesCache.remove(w);
         styleSheetCaches->hasStyleRuleCache.remove(w);
         styleSheetCaches->renderRulesCache.remove(w);
-        styleSheetCaches->styleSheetCache.remove(w);
+        styleSheetCaches->removeStyleSheet(w);
     }
     setGeometry(w);
     setProperties(w);
@@ -3023,7 +3102,7 @@ void QStyleSheetStyle::repolish(QWidget *w)
     for (auto child: qAsConst(w->children()))
         children.append(child);
     children.append(w);
-    styleSheetCaches->styleSheetCache.remove(w);
+    styleSheetCaches->removeStyleSheet(w);
     updateObjects(children);
 }
 
@@ -3031,8 +3110,9 @@ void QStyleSheetStyle::repolish(QApplication *app)
 {
     Q_UNUSED(app);
     const QList<const QObject*> allObjects = styleSheetCaches->styleRulesCache.keys();
-    styleSheetCaches->styleSheetCache.remove(qApp);
+    styleSheetCaches->removeStyleSheet(qApp);
     styleSheetCaches->styleRulesCache.clear();
+    styleSheetCaches->sharedStyleRulesCache.clear();
     styleSheetCaches->hasStyleRuleCache.clear();
     styleSheetCaches->renderRulesCache.clear();
     updateObjects(allObjects);
@@ -3048,7 +3128,7 @@ void QStyleSheetStyle::unpolish(QWidget *w)
     styleSheetCaches->styleRulesCache.remove(w);
     styleSheetCaches->hasStyleRuleCache.remove(w);
     styleSheetCaches->renderRulesCache.remove(w);
-    styleSheetCaches->styleSheetCache.remove(w);
+    styleSheetCaches->removeStyleSheet(w);
     unsetPalette(w);
     setGeometry(w);
     w->setAttribute(Qt::WA_StyleSheetTarget, false);
@@ -3072,7 +3152,8 @@ void QStyleSheetStyle::unpolish(QApplication *app)
     styleSheetCaches->styleRulesCache.clear();
     styleSheetCaches->hasStyleRuleCache.clear();
     styleSheetCaches->renderRulesCache.clear();
-    styleSheetCaches->styleSheetCache.remove(qApp);
+    styleSheetCaches->removeStyleSheet(qApp);
+    styleSheetCaches->sharedStyleRulesCache.clear();
 }
 
 #if QT_CONFIG(tabbar)
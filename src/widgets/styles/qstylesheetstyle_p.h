@@ -191,6 +191,17 @@ public:
     typedef QHash<int, QHash<quint64, QRenderRule> > QRenderRules;
     QHash<const QObject *, QRenderRules> renderRulesCache;
     QHash<const void *, QCss::StyleSheet> styleSheetCache; // parsed style sheets
+    // attribute names used by the selectors of each parsed style sheet
+    QHash<const void *, QStringList> styleSheetAttributeNames;
+    // style rules shared by all objects that no selector can tell apart
+    QHash<QString, QList<QCss::StyleRule>> sharedStyleRulesCache;
+    void removeStyleSheet(const void *key)
+    {
+        if (styleSheetCache.remove(key)) {
+            styleSheetAttributeNames.remove(key);
+            sharedStyleRulesCache.clear();
+        }
+    }
     QSet<const QWidget *> autoFillDisabledWidgets;
     // widgets with whose palettes and fonts we have tampered:
     template <typename T>
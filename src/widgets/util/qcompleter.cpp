@@ -163,6 +163,11 @@
 #include "QtWidgets/qlineedit.h"
 #endif
 #include "QtCore/qdir.h"
+#if QT_CONFIG(thread)
+#include "QtCore/qthreadpool.h"
+#endif
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -413,7 +418,7 @@ void QCompletionModel::rowsInserted()
 
 void QCompletionModel::invalidate()
 {
-    engine->cache.clear();
+    engine->invalidate();
     filter(engine->curParts);
 }
 
@@ -716,33 +721,120 @@ QMatchData QSortedModelEngine::filter(const QString& part, const QModelIndex& pa
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
+void QCompletionIndex::sort()
+{
+    QList<int> rows;
+    rows.reserve(keys.count());
+    for (int row = 0; row < keys.count(); ++row) {
+        if (selectable.testBit(row))
+            rows.append(row);
+    }
+    std::stable_sort(rows.begin(), rows.end(), [this](int a, int b) {
+        return keys.at(a) < keys.at(b);
+    });
+    sorted = std::move(rows);
+    ready.storeRelease(1);
+}
+
+// Returns all rows whose key starts with \a key, in model order
+QMatchData QCompletionIndex::startsWith(const QString &key) const
+{
+    Q_ASSERT(ready.loadAcquire());
+    const auto begin = std::lower_bound(sorted.cbegin(), sorted.cend(), key,
+                                        [this](int row, const QString &k) {
+        return keys.at(row) < k;
+    });
+    const auto end = std::partition_point(begin, sorted.cend(), [this, &key](int row) {
+        return keys.at(row).startsWith(key);
+    });
+    if (begin == end)
+        return QMatchData();
+
+    // exact matches sort first, and the stable sort keeps them in model order
+    const int emi = keys.at(*begin) == key ? *begin : -1;
+    QList<int> rows(begin, end);
+    std::sort(rows.begin(), rows.end());
+    return QMatchData(QIndexMapper(rows), emi, false);
+}
+
+void QUnsortedModelEngine::invalidate()
+{
+    QCompletionEngine::invalidate();
+    indexes.clear();
+}
+
+// Returns the index of the completion strings below \a parent, creating it if the
+// parent has enough rows for an index to pay off. The prefix order is sorted in
+// the background; until it is ready, the snapshot still spares the model lookups.
+QSharedPointer<QCompletionIndex> QUnsortedModelEngine::completionIndex(const QModelIndex &parent)
+{
+    const auto it = indexes.constFind(parent);
+    if (it != indexes.constEnd())
+        return it.value();
+
+    const QAbstractItemModel *model = c->proxy->sourceModel();
+    const int rowCount = model->rowCount(parent);
+    if (rowCount < IndexThreshold)
+        return QSharedPointer<QCompletionIndex>();
+
+    auto index = QSharedPointer<QCompletionIndex>::create();
+    index->keys.reserve(rowCount);
+    index->selectable.resize(rowCount);
+    for (int row = 0; row < rowCount; ++row) {
+        const QModelIndex idx = model->index(row, c->column, parent);
+        index->selectable.setBit(row, model->flags(idx) & Qt::ItemIsSelectable);
+        QString data = model->data(idx, c->role).toString();
+        index->keys.append(c->cs == Qt::CaseInsensitive ? std::move(data).toCaseFolded() : data);
+    }
+    indexes.insert(parent, index);
+
+#if QT_CONFIG(thread)
+    QThreadPool::globalInstance()->start([index] { index->sort(); });
+#else
+    index->sort();
+#endif
+    return index;
+}
+
 int QUnsortedModelEngine::buildIndices(const QString& str, const QModelIndex& parent, int n,
-                                      const QIndexMapper& indices, QMatchData* m)
+                                      const QIndexMapper& indices, QMatchData* m,
+                                      const QCompletionIndex *index)
 {
     Q_ASSERT(m->partial);
     Q_ASSERT(n != -1 || m->exactMatchIndex == -1);
     const QAbstractItemModel *model = c->proxy->sourceModel();
     int i, count = 0;
 
+    // the index keys are already case folded
+    const QString key = index && c->cs == Qt::CaseInsensitive ? str.toCaseFolded() : str;
+    const Qt::CaseSensitivity cs = index ? Qt::CaseSensitive : c->cs;
+
     for (i = 0; i < indices.count() && count != n; ++i) {
-        QModelIndex idx = model->index(indices[i], c->column, parent);
+        QString data;
+        if (index) {
+            if (!index->selectable.testBit(indices[i]))
+                continue;
+            data = index->keys.at(indices[i]);
+        } else {
+            QModelIndex idx = model->index(indices[i], c->column, parent);
 
-        if (!(model->flags(idx) & Qt::ItemIsSelectable))
-            continue;
+            if (!(model->flags(idx) & Qt::ItemIsSelectable))
+                continue;
 
-        QString data = model->data(idx, c->role).toString();
+            data = model->data(idx, c->role).toString();
+        }
 
         switch (c->filterMode) {
         case Qt::MatchStartsWith:
-            if (!data.startsWith(str, c->cs))
+            if (!data.startsWith(key, cs))
                 continue;
             break;
         case Qt::MatchContains:
-            if (!data.contains(str, c->cs))
+            if (!data.contains(key, cs))
                 continue;
             break;
         case Qt::MatchEndsWith:
-            if (!data.endsWith(str, c->cs))
+            if (!data.endsWith(key, cs))
                 continue;
             break;
         case Qt::MatchExactly:
@@ -757,7 +849,7 @@ int QUnsortedModelEngine::buildIndices(const QString& str, const QModelIndex& pa
         }
         m->indices.append(indices[i]);
         ++count;
-        if (m->exactMatchIndex == -1 && QString::compare(data, str, c->cs) == 0) {
+        if (m->exactMatchIndex == -1 && QString::compare(data, key, cs) == 0) {
             m->exactMatchIndex = indices[i];
             if (n == -1)
                 return indices[i];
@@ -775,7 +867,8 @@ void QUnsortedModelEngine::filterOnDemand(int n)
     const QAbstractItemModel *model = c->proxy->sourceModel();
     int lastRow = model->rowCount(curParent) - 1;
     QIndexMapper im(curMatch.indices.last() + 1, lastRow);
-    int lastIndex = buildIndices(curParts.constLast(), curParent, n, im, &curMatch);
+    int lastIndex = buildIndices(curParts.constLast(), curParent, n, im, &curMatch,
+                                 indexes.value(curParent).data());
     curMatch.partial = (lastRow != lastIndex);
     saveInCache(curParts.constLast(), curParent, curMatch);
 }
@@ -791,6 +884,14 @@ QMatchData QUnsortedModelEngine::filter(const QString& part, const QModelIndex&
     const QAbstractItemModel *model = c->proxy->sourceModel();
     bool foundInCache = lookupCache(part, parent, &m);
 
+    const QSharedPointer<QCompletionIndex> index = completionIndex(parent);
+    if (!foundInCache && index && c->filterMode == Qt::MatchStartsWith
+        && index->ready.loadAcquire()) {
+        m = index->startsWith(c->cs == Qt::CaseInsensitive ? part.toCaseFolded() : part);
+        saveInCache(part, parent, m);
+        return m;
+    }
+
     if (!foundInCache) {
         if (matchHint(part, parent, &hint) && !hint.isValid())
             return QMatchData();
@@ -799,11 +900,11 @@ QMatchData QUnsortedModelEngine::filter(const QString& part, const QModelIndex&
     if (!foundInCache && !hint.isValid()) {
         const int lastRow = model->rowCount(parent) - 1;
         QIndexMapper all(0, lastRow);
-        int lastIndex = buildIndices(part, parent, n, all, &m);
+        int lastIndex = buildIndices(part, parent, n, all, &m, index.data());
         m.partial = (lastIndex != lastRow);
     } else {
         if (!foundInCache) { // build from hint as much as we can
-            buildIndices(part, parent, INT_MAX, hint.indices, &m);
+            buildIndices(part, parent, INT_MAX, hint.indices, &m, index.data());
             m.partial = hint.partial;
         }
         if (m.partial && ((n == -1 && m.exactMatchIndex == -1) || (m.indices.count() < n))) {
@@ -811,7 +912,7 @@ QMatchData QUnsortedModelEngine::filter(const QString& part, const QModelIndex&
             const int lastRow = model->rowCount(parent) - 1;
             QIndexMapper rest(hint.indices.last() + 1, lastRow);
             int want = n == -1 ? -1 : n - m.indices.count();
-            int lastIndex = buildIndices(part, parent, want, rest, &m);
+            int lastIndex = buildIndices(part, parent, want, rest, &m, index.data());
             m.partial = (lastRow != lastIndex);
         }
     }
@@ -1602,6 +1703,10 @@ int QCompleter::completionCount() const
     when the completer's \l caseSensitivity is different to the case sensitivity
     used by the model's when sorting.
 
+    For large unsorted models, the completer takes a snapshot of the completion
+    strings and sorts it in the background, so that prefix matching does not
+    need a linear search either. The snapshot is rebuilt when the model changes.
+
     \sa setCaseSensitivity(), QCompleter::ModelSorting
 */
 void QCompleter::setModelSorting(QCompleter::ModelSorting sorting)
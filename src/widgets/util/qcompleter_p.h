@@ -57,6 +57,8 @@
 
 #include "QtWidgets/qabstractitemview.h"
 #include "QtCore/qabstractproxymodel.h"
+#include "QtCore/qbitarray.h"
+#include "QtCore/qsharedpointer.h"
 #include "qcompleter.h"
 #include "qstyleditemdelegate.h"
 #include "QtGui/qpainter.h"
@@ -141,6 +143,20 @@ struct QMatchData {
     bool partial;
 };
 
+// Snapshot of the completion strings below one parent of a large model.
+// The keys are taken on the GUI thread; the prefix order is built on a
+// worker thread and may only be used once ready is set.
+struct QCompletionIndex
+{
+    QStringList keys; // case folded when matching case insensitively
+    QBitArray selectable;
+    QList<int> sorted; // selectable rows, stably sorted by key
+    QAtomicInt ready;
+
+    void sort();
+    QMatchData startsWith(const QString &key) const;
+};
+
 class QCompletionEngine
 {
 public:
@@ -160,6 +176,7 @@ public:
 
     virtual void filterOnDemand(int) { }
     virtual QMatchData filter(const QString&, const QModelIndex&, int) = 0;
+    virtual void invalidate() { cache.clear(); }
 
     int matchCount() const { return curMatch.indices.count() + historyMatch.indices.count(); }
 
@@ -189,9 +206,18 @@ public:
 
     void filterOnDemand(int) override;
     QMatchData filter(const QString&, const QModelIndex&, int) override;
+    void invalidate() override;
+
+    // parents with at least this many rows get a QCompletionIndex
+    static constexpr int IndexThreshold = 10000;
+
 private:
+    QSharedPointer<QCompletionIndex> completionIndex(const QModelIndex &parent);
     int buildIndices(const QString& str, const QModelIndex& parent, int n,
-                     const QIndexMapper& iv, QMatchData* m);
+                     const QIndexMapper& iv, QMatchData* m,
+                     const QCompletionIndex *index = nullptr);
+
+    QMap<QModelIndex, QSharedPointer<QCompletionIndex>> indexes;
 };
 
 class QCompleterItemDelegate : public QStyledItemDelegate
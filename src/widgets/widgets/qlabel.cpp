@@ -1273,9 +1273,14 @@ void QLabelPrivate::_q_movieUpdated(const QRect& rect)
             QRect pixmapRect(cr.topLeft(), movie->currentPixmap().size());
             if (pixmapRect.isEmpty())
                 return;
-            r.setRect(cr.left(), cr.top(),
-                      (rect.width() * cr.width()) / pixmapRect.width(),
-                      (rect.height() * cr.height()) / pixmapRect.height());
+            // the movie may only update a part of the frame
+            const int left = (rect.left() * cr.width()) / pixmapRect.width();
+            const int top = (rect.top() * cr.height()) / pixmapRect.height();
+            const int right = ((rect.right() + 1) * cr.width() + pixmapRect.width() - 1)
+                    / pixmapRect.width();
+            const int bottom = ((rect.bottom() + 1) * cr.height() + pixmapRect.height() - 1)
+                    / pixmapRect.height();
+            r.setRect(cr.left() + left, cr.top() + top, right - left, bottom - top);
         } else {
             r = q->style()->itemPixmapRect(q->contentsRect(), align, movie->currentPixmap());
             r.translate(rect.x(), rect.y());
@@ -118,6 +118,17 @@ static void qt_split_namespace(QString& prefix, QString& name, const QString& qN
     }
 }
 
+// While the document is being parsed, makes the node share its name, prefix
+// and namespace URI with the nodes parsed before it.
+static void qt_intern_names(QDomNodePrivate *node, QDomDocumentPrivate *doc)
+{
+    if (!doc || !doc->nameTable)
+        return;
+    node->name = doc->internedName(node->name);
+    node->prefix = doc->internedName(node->prefix);
+    node->namespaceURI = doc->internedName(node->namespaceURI);
+}
+
 /**************************************************************
  *
  * Functions for verifying legal data
@@ -3599,6 +3610,7 @@ QDomAttrPrivate::QDomAttrPrivate(QDomDocumentPrivate* d, QDomNodePrivate* parent
     : QDomNodePrivate(d, parent)
 {
     name = name_;
+    qt_intern_names(this, d);
     m_specified = false;
 }
 
@@ -3607,6 +3619,7 @@ QDomAttrPrivate::QDomAttrPrivate(QDomDocumentPrivate* d, QDomNodePrivate* p, con
 {
     qt_split_namespace(prefix, name, qName, !nsURI.isNull());
     namespaceURI = nsURI;
+    qt_intern_names(this, d);
     createdWithDom1Interface = false;
     m_specified = false;
 }
@@ -3886,6 +3899,7 @@ QDomElementPrivate::QDomElementPrivate(QDomDocumentPrivate* d, QDomNodePrivate*
     : QDomNodePrivate(d, p)
 {
     name = tagname;
+    qt_intern_names(this, d);
     m_attr = new QDomNamedNodeMapPrivate(this);
 }
 
@@ -3895,6 +3909,7 @@ QDomElementPrivate::QDomElementPrivate(QDomDocumentPrivate* d, QDomNodePrivate*
 {
     qt_split_namespace(prefix, name, qName, !nsURI.isNull());
     namespaceURI = nsURI;
+    qt_intern_names(this, d);
     createdWithDom1Interface = false;
     m_attr = new QDomNamedNodeMapPrivate(this);
 }
@@ -5893,6 +5908,19 @@ QDomNodePrivate* QDomDocumentPrivate::importNode(QDomNodePrivate *importedNode,
     return node;
 }
 
+QString QDomDocumentPrivate::internedName(const QString &name)
+{
+    Q_ASSERT(nameTable);
+    // null and empty prefixes and namespace URIs mean different things
+    if (name.isNull())
+        return name;
+    const auto it = nameTable->constFind(name);
+    if (it != nameTable->constEnd())
+        return *it;
+    nameTable->insert(name);
+    return name;
+}
+
 void QDomDocumentPrivate::saveDocument(QTextStream& s, const int indent, QDomNode::EncodingPolicy encUsed) const
 {
     const QDomNodePrivate* n = first;
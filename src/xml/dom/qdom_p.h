@@ -45,6 +45,7 @@
 #include <qhash.h>
 #include <qstring.h>
 #include <qlist.h>
+#include <qset.h>
 #include <qshareddata.h>
 
 QT_BEGIN_NAMESPACE
@@ -483,6 +484,7 @@ public:
     QDomEntityReferencePrivate *createEntityReference(const QString &name);
 
     QDomNodePrivate *importNode(QDomNodePrivate *importedNode, bool deep);
+    QString internedName(const QString &name);
 
     // Reimplemented from QDomNodePrivate
     QDomNodePrivate *cloneNode(bool deep = true) override;
@@ -524,6 +526,15 @@ public:
        stored timestamp.
     */
     long nodeListTime;
+
+    /* \internal
+       The element and attribute names, prefixes and namespace URIs seen so
+       far while the document is being parsed, or nullptr when it isn't.
+       Documents repeat a handful of names over and over; sharing one copy of
+       each between all the nodes that use it keeps them from dominating the
+       memory used by the DOM.
+    */
+    QSet<QString> *nameTable = nullptr;
 };
 
 QT_END_NAMESPACE
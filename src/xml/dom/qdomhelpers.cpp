@@ -65,9 +65,13 @@ QDomBuilder::QDomBuilder(QDomDocumentPrivate *d, QXmlStreamReader *r, bool names
 {
     Q_ASSERT(doc);
     Q_ASSERT(reader);
+    doc->nameTable = &nameTable;
 }
 
-QDomBuilder::~QDomBuilder() {}
+QDomBuilder::~QDomBuilder()
+{
+    doc->nameTable = nullptr;
+}
 
 bool QDomBuilder::endDocument()
 {
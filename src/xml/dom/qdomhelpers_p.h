@@ -40,6 +40,7 @@
 #define QDOMHELPERS_P_H
 
 #include <qcoreapplication.h>
+#include <qset.h>
 #include <qglobal.h>
 
 QT_BEGIN_NAMESPACE
@@ -101,6 +102,7 @@ private:
     QDomNodePrivate *node;
     QXmlStreamReader *reader;
     QString entityName;
+    QSet<QString> nameTable;
     bool nsProcessing;
 };
 
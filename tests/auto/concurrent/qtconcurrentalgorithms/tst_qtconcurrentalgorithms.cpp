@@ -0,0 +1,265 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentalgorithms.h>
+#include <qtconcurrentrun.h>
+
+#include <QRandomGenerator>
+#include <QSemaphore>
+#include <QTest>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace QtConcurrent;
+
+class tst_QtConcurrentAlgorithms : public QObject
+{
+    Q_OBJECT
+private slots:
+    void sort_data();
+    void sort();
+    void stableSort_data() { sort_data(); }
+    void stableSort();
+    void inclusiveScan_data() { sort_data(); }
+    void inclusiveScan();
+    void partition_data() { sort_data(); }
+    void partition();
+    void globalThreadPool();
+    void nestedInPool();
+    void cancel();
+
+private:
+    QList<int> randomList(qsizetype size) const;
+};
+
+struct Item
+{
+    int key;
+    int index;
+};
+
+QList<int> tst_QtConcurrentAlgorithms::randomList(qsizetype size) const
+{
+    QList<int> list(size);
+    for (int &value : list)
+        value = QRandomGenerator::global()->bounded(1000);
+    return list;
+}
+
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<qsizetype>("size");
+
+    for (int threads : { 1, 2, 3, 8 }) {
+        for (qsizetype size : { 0, 1, 100, 10000, 100003 }) {
+            QTest::addRow("threads=%d,size=%lld", threads, qlonglong(size))
+                    << threads << size;
+        }
+    }
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    QList<int> list = randomList(size);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QFuture<void> future = QtConcurrent::sort(&pool, list);
+    future.waitForFinished();
+    QCOMPARE(list, expected);
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    blockingSort(&pool, list, std::greater<>());
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::stableSort()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    // few distinct keys, so that there are many equal items
+    QList<Item> items;
+    items.reserve(size);
+    for (int i = 0; i < size; ++i)
+        items.append({ int(QRandomGenerator::global()->bounded(16)), i });
+
+    const auto byKey = [](const Item &lhs, const Item &rhs) { return lhs.key < rhs.key; };
+    QFuture<void> future = QtConcurrent::stableSort(&pool, items, byKey);
+    future.waitForFinished();
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+
+    QCOMPARE(items.size(), size);
+    for (qsizetype i = 1; i < items.size(); ++i) {
+        const Item &previous = items.at(i - 1);
+        const Item &current = items.at(i);
+        QVERIFY(previous.key < current.key
+                || (previous.key == current.key && previous.index < current.index));
+    }
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    const QList<int> input = randomList(size);
+
+    QList<qint64> sums(input.begin(), input.end());
+    QList<qint64> expectedSums = sums;
+    std::partial_sum(expectedSums.begin(), expectedSums.end(), expectedSums.begin());
+    QFuture<void> future = QtConcurrent::inclusiveScan(&pool, sums);
+    future.waitForFinished();
+    QCOMPARE(sums, expectedSums);
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+
+    // any associative operation
+    const auto max = [](int lhs, int rhs) { return qMax(lhs, rhs); };
+    QList<int> maxima = input;
+    QList<int> expectedMaxima = input;
+    std::partial_sum(expectedMaxima.begin(), expectedMaxima.end(), expectedMaxima.begin(), max);
+    blockingInclusiveScan(&pool, maxima, max);
+    QCOMPARE(maxima, expectedMaxima);
+}
+
+void tst_QtConcurrentAlgorithms::partition()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    QList<int> list = randomList(size);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    const auto isOdd = [](int value) { return value % 2 != 0; };
+    QFuture<qsizetype> future = QtConcurrent::partition(&pool, list, isOdd);
+    const qsizetype point = future.result();
+    QCOMPARE(future.progressValue(), future.progressMaximum());
+
+    QCOMPARE(point, std::count_if(expected.cbegin(), expected.cend(), isOdd));
+    QVERIFY(std::all_of(list.cbegin(), list.cbegin() + point, isOdd));
+    QVERIFY(std::none_of(list.cbegin() + point, list.cend(), isOdd));
+
+    // the items were only moved around
+    std::sort(list.begin(), list.end());
+    QCOMPARE(list, expected);
+
+    QCOMPARE(blockingPartition(&pool, list, [](int) { return false; }), 0);
+    QCOMPARE(blockingPartition(&pool, list, [](int) { return true; }), size);
+}
+
+void tst_QtConcurrentAlgorithms::globalThreadPool()
+{
+    QList<int> list = randomList(100000);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::sort(list).waitForFinished();
+    QCOMPARE(list, expected);
+
+    std::reverse(list.begin(), list.end());
+    blockingStableSort(list);
+    QCOMPARE(list, expected);
+
+    blockingInclusiveScan(list, [](int, int rhs) { return rhs; });
+    QCOMPARE(list, expected);
+
+    const qsizetype point = blockingPartition(list, [](int value) { return value < 500; });
+    QCOMPARE(point, std::lower_bound(expected.cbegin(), expected.cend(), 500) - expected.cbegin());
+}
+
+void tst_QtConcurrentAlgorithms::nestedInPool()
+{
+    // the algorithm must not wait for threads of a pool that has none left
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    QList<int> list = randomList(100000);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::run(&pool, [&] { blockingSort(&pool, list); }).waitForFinished();
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithms::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    QList<int> list(100000);
+    std::iota(list.rbegin(), list.rend(), 0);
+    const QList<int> original = list;
+
+    QSemaphore started;
+    QSemaphore resume;
+    QAtomicInt blocked = 0;
+    const auto lessThan = [&](int lhs, int rhs) {
+        if (!blocked.fetchAndStoreRelaxed(1)) {
+            started.release();
+            resume.acquire();
+        }
+        return lhs < rhs;
+    };
+
+    QFuture<void> future = QtConcurrent::sort(&pool, list, lessThan);
+    started.acquire();
+    future.cancel();
+    resume.release();
+    future.waitForFinished();
+
+    QVERIFY(future.isCanceled());
+    QVERIFY(future.progressValue() < future.progressMaximum());
+    QVERIFY(!std::is_sorted(list.cbegin(), list.cend()));
+
+    // the items were only moved around
+    std::sort(list.begin(), list.end());
+    QList<int> expected = original;
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(list, expected);
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+#include "tst_qtconcurrentalgorithms.moc"
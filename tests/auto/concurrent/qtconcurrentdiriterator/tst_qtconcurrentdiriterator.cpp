@@ -0,0 +1,221 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentdiriterator.h>
+
+#include <QDirIterator>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QSet>
+#include <QSemaphore>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThreadPool>
+
+Q_DECLARE_METATYPE(QDir::Filters)
+Q_DECLARE_METATYPE(QDirIterator::IteratorFlags)
+
+class tst_QtConcurrentDirIterator : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void sameEntriesAsQDirIterator_data();
+    void sameEntriesAsQDirIterator();
+    void streamsBatches();
+    void symlinkLoop();
+    void nonExistingDirectory();
+    void cancel();
+
+private:
+    static QSet<QString> sequentialEntries(const QString &path, const QStringList &nameFilters,
+                                           QDir::Filters filters,
+                                           QDirIterator::IteratorFlags flags);
+    static QSet<QString> paths(const QList<QFileInfo> &entries);
+
+    QTemporaryDir tempDir;
+    int fileCount = 0;
+};
+
+void tst_QtConcurrentDirIterator::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+
+    // a tree a few levels deep, with enough files in one directory to span
+    // several result batches
+    QDir root(tempDir.path());
+    const QStringList directories = {
+        "a", "a/b", "a/b/c", "a/.hidden", "d", "d/e", "big",
+    };
+    for (const QString &directory : directories)
+        QVERIFY(root.mkpath(directory));
+
+    const auto touch = [&](const QString &name) {
+        QFile file(root.filePath(name));
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        ++fileCount;
+        return true;
+    };
+    for (const QString &directory : directories) {
+        QVERIFY(touch(directory + "/file.txt"));
+        QVERIFY(touch(directory + "/file.cpp"));
+        QVERIFY(touch(directory + "/.hiddenfile"));
+    }
+    for (int i = 0; i < 1000; ++i)
+        QVERIFY(touch(QString("big/%1.dat").arg(i)));
+}
+
+QSet<QString> tst_QtConcurrentDirIterator::sequentialEntries(const QString &path,
+                                                              const QStringList &nameFilters,
+                                                              QDir::Filters filters,
+                                                              QDirIterator::IteratorFlags flags)
+{
+    QSet<QString> entries;
+    QDirIterator it(path, nameFilters, filters, flags);
+    while (it.hasNext())
+        entries.insert(it.next());
+    return entries;
+}
+
+QSet<QString> tst_QtConcurrentDirIterator::paths(const QList<QFileInfo> &entries)
+{
+    QSet<QString> result;
+    for (const QFileInfo &entry : entries)
+        result.insert(entry.filePath());
+    return result;
+}
+
+void tst_QtConcurrentDirIterator::sameEntriesAsQDirIterator_data()
+{
+    QTest::addColumn<QStringList>("nameFilters");
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QDirIterator::IteratorFlags>("flags");
+
+    const QDirIterator::IteratorFlags recursive = QDirIterator::Subdirectories;
+    QTest::newRow("all") << QStringList() << QDir::Filters(QDir::NoFilter) << recursive;
+    QTest::newRow("hidden") << QStringList() << (QDir::AllEntries | QDir::Hidden) << recursive;
+    QTest::newRow("files") << QStringList() << QDir::Filters(QDir::Files) << recursive;
+    QTest::newRow("dirs") << QStringList() << (QDir::Dirs | QDir::NoDotAndDotDot) << recursive;
+    QTest::newRow("nameFilters") << QStringList { "*.cpp", "*.txt" }
+                                 << QDir::Filters(QDir::Files) << recursive;
+    QTest::newRow("flat") << QStringList() << QDir::Filters(QDir::NoFilter)
+                          << QDirIterator::IteratorFlags(QDirIterator::NoIteratorFlags);
+}
+
+void tst_QtConcurrentDirIterator::sameEntriesAsQDirIterator()
+{
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QFuture<QFileInfo> future = QtConcurrent::iterateDirectory(&pool, tempDir.path(),
+                                                               nameFilters, filters, flags);
+    future.waitForFinished();
+
+    const QList<QFileInfo> results = future.results();
+    const QSet<QString> expected = sequentialEntries(tempDir.path(), nameFilters, filters, flags);
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(results.size(), expected.size());
+    QCOMPARE(paths(results), expected);
+}
+
+void tst_QtConcurrentDirIterator::streamsBatches()
+{
+    QFutureWatcher<QFileInfo> watcher;
+    QSignalSpy resultsSpy(&watcher, &QFutureWatcher<QFileInfo>::resultsReadyAt);
+    QSignalSpy finishedSpy(&watcher, &QFutureWatcher<QFileInfo>::finished);
+    watcher.setFuture(QtConcurrent::iterateDirectory(tempDir.path(), QStringList(),
+                                                     QDir::Files | QDir::Hidden));
+    QVERIFY(finishedSpy.wait());
+
+    QCOMPARE(watcher.future().resultCount(), fileCount);
+    // the big directory alone does not fit into one batch
+    QVERIFY(resultsSpy.count() > 1);
+}
+
+void tst_QtConcurrentDirIterator::symlinkLoop()
+{
+#ifdef Q_OS_UNIX
+    QTemporaryDir loopDir;
+    QVERIFY(loopDir.isValid());
+    QDir root(loopDir.path());
+    QVERIFY(root.mkpath("sub/subsub"));
+    QVERIFY(QFile::link(root.absolutePath(), root.filePath("sub/subsub/up")));
+    QVERIFY(QFile::link(root.filePath("sub"), root.filePath("sub2")));
+
+    const QDirIterator::IteratorFlags flags =
+            QDirIterator::Subdirectories | QDirIterator::FollowSymlinks;
+    const QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot;
+    QFuture<QFileInfo> future = QtConcurrent::iterateDirectory(loopDir.path(), QStringList(),
+                                                               filters, flags);
+    future.waitForFinished();
+
+    // every directory is listed exactly once, but which of its names leads
+    // there depends on timing
+    const QList<QFileInfo> results = future.results();
+    const QSet<QString> expected = sequentialEntries(loopDir.path(), QStringList(),
+                                                     filters, flags);
+    QCOMPARE(results.size(), expected.size());
+#else
+    QSKIP("Symbolic links to directories are only created on Unix");
+#endif
+}
+
+void tst_QtConcurrentDirIterator::nonExistingDirectory()
+{
+    QFuture<QFileInfo> future =
+            QtConcurrent::iterateDirectory(tempDir.filePath("nonexisting"), QStringList());
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.resultCount(), 0);
+}
+
+void tst_QtConcurrentDirIterator::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+
+    // keep the only thread busy until the iteration is canceled
+    QSemaphore blocker;
+    pool.start([&blocker] { blocker.acquire(); });
+
+    QFuture<QFileInfo> future = QtConcurrent::iterateDirectory(&pool, tempDir.path(),
+                                                               QStringList());
+    future.cancel();
+    blocker.release();
+    future.waitForFinished();
+
+    QVERIFY(future.isCanceled());
+    QCOMPARE(future.resultCount(), 0);
+}
+
+QTEST_MAIN(tst_QtConcurrentDirIterator)
+#include "tst_qtconcurrentdiriterator.moc"
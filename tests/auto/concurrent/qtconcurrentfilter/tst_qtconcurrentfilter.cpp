@@ -40,6 +40,7 @@ private slots:
     void filter();
     void filterThreadPool();
     void filterWithMoveOnlyCallable();
+    void filterDispatchPolicy();
     void filtered();
     void filteredThreadPool();
     void filteredWithMoveOnlyCallable();
@@ -207,6 +208,39 @@ void tst_QtConcurrentFilter::filterThreadPool()
     }
 }
 
+void tst_QtConcurrentFilter::filterDispatchPolicy()
+{
+    QList<int> intList;
+    QList<int> intListEven;
+    for (int i = 0; i < 1000; ++i) {
+        intList.append(i);
+        if (i % 2 == 0)
+            intListEven.append(i);
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    const QtConcurrent::DispatchPolicy policies[] = {
+        QtConcurrent::DispatchPolicy::adaptive(),
+        QtConcurrent::DispatchPolicy::fixedGrain(16),
+        QtConcurrent::DispatchPolicy::guided(4),
+        QtConcurrent::DispatchPolicy::staticPartition()
+    };
+    for (const auto policy : policies) {
+        {
+            QList<int> list = intList;
+            QtConcurrent::filter(&pool, policy, list, keepEvenIntegers).waitForFinished();
+            QCOMPARE(list, intListEven);
+        }
+        {
+            QList<int> list = intList;
+            QtConcurrent::blockingFilter(&pool, policy, list, keepEvenIntegers);
+            QCOMPARE(list, intListEven);
+        }
+    }
+}
+
 void tst_QtConcurrentFilter::filterWithMoveOnlyCallable()
 {
     const QList<int> intListEven { 2, 4 };
@@ -67,6 +67,8 @@ private slots:
     void qFutureAssignmentLeak();
     void stressTest();
     void persistentResultTest();
+    void dispatchPolicy_data();
+    void dispatchPolicy();
 public slots:
     void throttling();
 };
@@ -2146,5 +2148,62 @@ void tst_QtConcurrentMap::persistentResultTest()
     QCOMPARE(ref.loadAcquire(), 3);
 }
 
+void tst_QtConcurrentMap::dispatchPolicy_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::addColumn<int>("grainSize");
+
+    QTest::newRow("adaptive") << int(DispatchPolicy::Adaptive) << 1;
+    QTest::newRow("fixedGrain=1") << int(DispatchPolicy::FixedGrain) << 1;
+    QTest::newRow("fixedGrain=7") << int(DispatchPolicy::FixedGrain) << 7;
+    QTest::newRow("fixedGrain=5000") << int(DispatchPolicy::FixedGrain) << 5000;
+    QTest::newRow("guided=1") << int(DispatchPolicy::Guided) << 1;
+    QTest::newRow("guided=64") << int(DispatchPolicy::Guided) << 64;
+    QTest::newRow("staticPartition") << int(DispatchPolicy::StaticPartition) << 1;
+}
+
+void tst_QtConcurrentMap::dispatchPolicy()
+{
+    QFETCH(int, mode);
+    QFETCH(int, grainSize);
+
+    DispatchPolicy policy;
+    switch (DispatchPolicy::Mode(mode)) {
+    case DispatchPolicy::Adaptive:
+        policy = DispatchPolicy::adaptive();
+        break;
+    case DispatchPolicy::FixedGrain:
+        policy = DispatchPolicy::fixedGrain(grainSize);
+        break;
+    case DispatchPolicy::Guided:
+        policy = DispatchPolicy::guided(grainSize);
+        break;
+    case DispatchPolicy::StaticPartition:
+        policy = DispatchPolicy::staticPartition();
+        break;
+    }
+    QCOMPARE(int(policy.mode()), mode);
+    QCOMPARE(policy.grainSize(), grainSize);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    const int listSize = 1000;
+    QList<int> list;
+    for (int i = 0; i < listSize; ++i)
+        list.append(i);
+
+    QtConcurrent::map(&pool, policy, list, multiplyBy2InPlace).waitForFinished();
+    QtConcurrent::blockingMap(&pool, policy, list.begin(), list.end(), multiplyBy2InPlace);
+    for (int i = 0; i < listSize; ++i)
+        QCOMPARE(list.at(i), 4 * i);
+
+    QFuture<int> future = QtConcurrent::mappedReduced<int>(&pool, policy, list, echo, add);
+    QCOMPARE(future.result(), 4 * (listSize - 1) * (listSize / 2));
+    QCOMPARE(future.progressValue(), listSize);
+    QCOMPARE(QtConcurrent::blockingMappedReduced(&pool, policy, list, echo, add),
+             4 * (listSize - 1) * (listSize / 2));
+}
+
 QTEST_MAIN(tst_QtConcurrentMap)
 #include "tst_qtconcurrentmap.moc"
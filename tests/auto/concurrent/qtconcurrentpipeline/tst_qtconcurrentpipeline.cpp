@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtconcurrentpipeline.h>
+
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QTest>
+
+#include <memory>
+
+using namespace QtConcurrent;
+
+Q_DECLARE_METATYPE(QtConcurrent::StageMode)
+
+class tst_QtConcurrentPipeline : public QObject
+{
+    Q_OBJECT
+private slots:
+    void stageModes_data();
+    void stageModes();
+    void tokenLimit();
+    void voidResult();
+    void moveOnly();
+    void globalThreadPool();
+    void cancel();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptions();
+#endif
+};
+
+// Returns a source producing 0, 1, ..., count - 1.
+static auto counter(int count)
+{
+    return [i = 0, count]() mutable -> std::optional<int> {
+        if (i < count)
+            return i++;
+        return std::nullopt;
+    };
+}
+
+void tst_QtConcurrentPipeline::stageModes_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("tokens");
+    QTest::addColumn<StageMode>("firstMode");
+    QTest::addColumn<StageMode>("secondMode");
+
+    const StageMode modes[] = { StageMode::Parallel, StageMode::SerialInOrder,
+                                StageMode::SerialOutOfOrder };
+    for (int threads : { 1, 4 }) {
+        for (int tokens : { 1, 3, 16 }) {
+            for (StageMode first : modes) {
+                for (StageMode second : modes) {
+                    QTest::addRow("threads=%d tokens=%d modes=%d,%d", threads, tokens,
+                                  int(first), int(second))
+                            << threads << tokens << first << second;
+                }
+            }
+        }
+    }
+}
+
+void tst_QtConcurrentPipeline::stageModes()
+{
+    QFETCH(int, threads);
+    QFETCH(int, tokens);
+    QFETCH(StageMode, firstMode);
+    QFETCH(StageMode, secondMode);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    const int count = 200;
+    QAtomicInt firstRunning;
+    bool firstOverlapped = false;
+    int lastInOrder = -1;
+    bool outOfOrder = false;
+
+    QFuture<QString> future = QtConcurrent::pipeline(&pool, tokens, counter(count),
+        stage(firstMode, [&](int value) {
+            if (firstRunning.fetchAndAddOrdered(1) != 0)
+                firstOverlapped = true;
+            QThread::yieldCurrentThread();
+            firstRunning.fetchAndAddOrdered(-1);
+            return value * 2;
+        }),
+        stage(secondMode, [&](int value) {
+            if (secondMode == StageMode::SerialInOrder) {
+                if (value != 2 * (lastInOrder + 1))
+                    outOfOrder = true;
+                lastInOrder = value / 2;
+            }
+            return QString::number(value);
+        }));
+
+    const QList<QString> results = future.results();
+    QCOMPARE(results.size(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(results.at(i), QString::number(2 * i));
+    if (firstMode != StageMode::Parallel)
+        QVERIFY(!firstOverlapped);
+    QVERIFY(!outOfOrder);
+}
+
+void tst_QtConcurrentPipeline::tokenLimit()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+
+    const int tokens = 3;
+    QAtomicInt inFlight;
+    int maxInFlight = 0;
+    QMutex mutex;
+
+    QtConcurrent::pipeline(&pool, tokens,
+        [&, source = counter(100)]() mutable {
+            const int current = inFlight.fetchAndAddOrdered(1) + 1;
+            QMutexLocker locker(&mutex);
+            maxInFlight = qMax(maxInFlight, current);
+            return source();
+        },
+        [](int value) {
+            QThread::yieldCurrentThread();
+            return value;
+        },
+        stage(StageMode::SerialOutOfOrder, [&](int) { inFlight.fetchAndAddOrdered(-1); }))
+            .waitForFinished();
+
+    QVERIFY(maxInFlight <= tokens);
+    QVERIFY(maxInFlight > 0);
+}
+
+void tst_QtConcurrentPipeline::voidResult()
+{
+    QThreadPool pool;
+    QList<int> sink;
+    QFuture<void> future = QtConcurrent::pipeline(&pool, 4, counter(1000),
+        [](int value) { return value + 1; },
+        stage(StageMode::SerialInOrder, [&](int value) { sink.append(value); }));
+    future.waitForFinished();
+
+    QCOMPARE(sink.size(), 1000);
+    for (int i = 0; i < sink.size(); ++i)
+        QCOMPARE(sink.at(i), i + 1);
+}
+
+void tst_QtConcurrentPipeline::moveOnly()
+{
+    QThreadPool pool;
+    QFuture<int> future = QtConcurrent::pipeline(&pool, 4, counter(100),
+        [](int value) { return std::make_unique<int>(value); },
+        stage(StageMode::SerialOutOfOrder, [](std::unique_ptr<int> value) { return *value; }));
+
+    const QList<int> results = future.results();
+    QCOMPARE(results.size(), 100);
+    for (int i = 0; i < results.size(); ++i)
+        QCOMPARE(results.at(i), i);
+}
+
+void tst_QtConcurrentPipeline::globalThreadPool()
+{
+    QFuture<int> future = QtConcurrent::pipeline(2, counter(10),
+        [](int value) { return value * value; });
+    QCOMPARE(future.results(), QList<int>({ 0, 1, 4, 9, 16, 25, 36, 49, 64, 81 }));
+}
+
+void tst_QtConcurrentPipeline::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QSemaphore started;
+    QSemaphore proceed;
+    QAtomicInt processed;
+
+    // an endless source
+    QFuture<void> future = QtConcurrent::pipeline(&pool, 4,
+        [i = 0]() mutable -> std::optional<int> { return i++; },
+        stage(StageMode::SerialInOrder, [&](int value) {
+            if (value == 10) {
+                started.release();
+                proceed.acquire();
+            }
+            processed.fetchAndAddRelaxed(1);
+        }));
+
+    started.acquire();
+    future.cancel();
+    proceed.release();
+    future.waitForFinished();
+
+    QVERIFY(future.isCanceled());
+    QCOMPARE(processed.loadRelaxed(), 11);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QtConcurrentPipeline::exceptions()
+{
+    QThreadPool pool;
+    QFuture<int> future = QtConcurrent::pipeline(&pool, 4, counter(100),
+        stage(StageMode::SerialInOrder, [](int value) {
+            if (value == 40)
+                throw QException();
+            return value;
+        }),
+        [](int value) { return value; });
+
+    QVERIFY_THROWS_EXCEPTION(QException, future.waitForFinished());
+    QVERIFY(future.isCanceled());
+
+    int i = 0;
+    QFuture<void> sourceThrows = QtConcurrent::pipeline(&pool, 4,
+        [&]() -> std::optional<int> {
+            if (i == 5)
+                throw QException();
+            return i++;
+        },
+        [](int) { });
+    QVERIFY_THROWS_EXCEPTION(QException, sourceThrows.waitForFinished());
+}
+#endif
+
+QTEST_MAIN(tst_QtConcurrentPipeline)
+#include "tst_qtconcurrentpipeline.moc"
@@ -28,6 +28,7 @@
 
 #include <QCoreApplication>
 #include <QLoggingCategory>
+#include <QThread>
 
 #ifdef Q_CC_GNU
 #define NEVER_INLINE __attribute__((__noinline__))
@@ -60,11 +61,38 @@ void MyClass::myFunction(int a)
     qDebug() << "from_a_function" << a;
 }
 
+static int asynchronousOutput()
+{
+    qSetMessagePattern("[%{type}] %{message}");
+    qSetAsynchronousMessageOutput(true);
+
+    QList<QThread *> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads << QThread::create([t] {
+            for (int i = 0; i < 1000; ++i)
+                qDebug("thread %d message %d", t, i);
+        });
+        threads.last()->start();
+    }
+    for (QThread *thread : qAsConst(threads)) {
+        thread->wait();
+        delete thread;
+    }
+    qWarning("after the threads");
+
+    qSetAsynchronousMessageOutput(false);
+    qDebug("synchronous");
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     QCoreApplication app(argc, argv);
     app.setApplicationName("tst_qlogging");
 
+    if (app.arguments().contains(QLatin1String("async")))
+        return asynchronousOutput();
+
     qSetMessagePattern("[%{type}] %{message}");
 
     qDebug("qDebug");
@@ -57,6 +57,7 @@ private slots:
     void qMessagePattern_data();
     void qMessagePattern();
     void setMessagePattern();
+    void asynchronousMessageOutput();
 
     void formatLogMessage_data();
     void formatLogMessage();
@@ -857,6 +858,53 @@ void tst_qmessagehandler::setMessagePattern()
 #endif // QT_CONFIG(process)
 }
 
+void tst_qmessagehandler::asynchronousMessageOutput()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#else
+#ifdef Q_OS_ANDROID
+    QSKIP("This test crashes on Android");
+#endif
+
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+    process.setEnvironment(m_baseEnvironment);
+
+    process.start(appExe, { QStringLiteral("async") });
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitCode(), 0);
+
+    QByteArray output = process.readAllStandardError();
+#ifdef Q_OS_WIN
+    output.replace("\r\n", "\n");
+#endif
+    const QList<QByteArray> lines = output.split('\n');
+
+    // every message arrives, formatted, and the messages of each thread in order
+    int next[4] = {};
+    qsizetype afterThreads = -1;
+    for (qsizetype i = 0; i < lines.size(); ++i) {
+        const QByteArray &line = lines.at(i);
+        int thread, message;
+        if (sscanf(line.constData(), "[debug] thread %d message %d", &thread, &message) == 2) {
+            QVERIFY(thread >= 0 && thread < 4);
+            QCOMPARE(message, next[thread]);
+            ++next[thread];
+            QCOMPARE(afterThreads, -1);
+        } else if (line == "[warning] after the threads") {
+            afterThreads = i;
+        }
+    }
+    for (int count : next)
+        QCOMPARE(count, 1000);
+    QVERIFY(afterThreads != -1);
+    QVERIFY(lines.indexOf("[debug] synchronous") > afterThreads);
+#endif // QT_CONFIG(process)
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
@@ -0,0 +1,242 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QTemporaryFile>
+
+#include <QtCore/private/qasyncfileio_p.h>
+
+class tst_QAsyncFileIO : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void readWrite_data();
+    void readWrite();
+    void readPastEnd_data();
+    void readPastEnd();
+    void manyRequests_data();
+    void manyRequests();
+    void invalidRequests();
+    void destroyWithPendingRequests_data();
+    void destroyWithPendingRequests();
+
+private:
+    void addBackendColumn();
+    bool setupBackend();
+};
+
+void tst_QAsyncFileIO::init()
+{
+    qunsetenv("QT_NO_IO_URING");
+}
+
+void tst_QAsyncFileIO::cleanup()
+{
+    qunsetenv("QT_NO_IO_URING");
+}
+
+void tst_QAsyncFileIO::addBackendColumn()
+{
+    QTest::addColumn<QAsyncFileIO::Backend>("backend");
+    QTest::newRow("threadpool") << QAsyncFileIO::ThreadPoolBackend;
+#if QT_CONFIG(io_uring)
+    QTest::newRow("io_uring") << QAsyncFileIO::IoUringBackend;
+#endif
+}
+
+bool tst_QAsyncFileIO::setupBackend()
+{
+    QFETCH(QAsyncFileIO::Backend, backend);
+    if (backend == QAsyncFileIO::ThreadPoolBackend)
+        qputenv("QT_NO_IO_URING", "1");
+
+    QFile dummy;
+    QAsyncFileIO probe(&dummy);
+    return probe.backend() == backend;
+}
+
+void tst_QAsyncFileIO::readWrite_data()
+{
+    addBackendColumn();
+}
+
+void tst_QAsyncFileIO::readWrite()
+{
+    if (!setupBackend())
+        QSKIP("Backend not available on this system");
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QVERIFY(file.write("0123456789") == 10);
+    QVERIFY(file.flush());
+
+    QAsyncFileIO io(&file);
+    QSignalSpy readSpy(&io, &QAsyncFileIO::readFinished);
+    QSignalSpy writeSpy(&io, &QAsyncFileIO::writeFinished);
+
+    const quint64 readId = io.read(2, 4);
+    QVERIFY(readId != 0);
+    QCOMPARE(io.pendingRequests(), 1);
+    QTRY_COMPARE(readSpy.count(), 1);
+    QCOMPARE(readSpy.at(0).at(0).value<quint64>(), readId);
+    QCOMPARE(readSpy.at(0).at(1).toByteArray(), QByteArray("2345"));
+    QCOMPARE(readSpy.at(0).at(2).value<QFileDevice::FileError>(), QFileDevice::NoError);
+
+    const quint64 writeId = io.write(10, "abcdef");
+    QVERIFY(writeId != 0);
+    QVERIFY(writeId != readId);
+    QTRY_COMPARE(writeSpy.count(), 1);
+    QCOMPARE(writeSpy.at(0).at(0).value<quint64>(), writeId);
+    QCOMPARE(writeSpy.at(0).at(1).value<qint64>(), 6);
+    QCOMPARE(writeSpy.at(0).at(2).value<QFileDevice::FileError>(), QFileDevice::NoError);
+    QCOMPARE(io.pendingRequests(), 0);
+
+    // positional I/O must not move the device
+    QCOMPARE(file.pos(), 10);
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.readAll(), QByteArray("0123456789abcdef"));
+}
+
+void tst_QAsyncFileIO::readPastEnd_data()
+{
+    addBackendColumn();
+}
+
+void tst_QAsyncFileIO::readPastEnd()
+{
+    if (!setupBackend())
+        QSKIP("Backend not available on this system");
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QVERIFY(file.write("hello") == 5);
+    QVERIFY(file.flush());
+
+    QAsyncFileIO io(&file);
+    QSignalSpy readSpy(&io, &QAsyncFileIO::readFinished);
+    QVERIFY(io.read(3, 100));
+    QVERIFY(io.read(50, 10));
+    QVERIFY(io.waitForFinished());
+    QCOMPARE(readSpy.count(), 2);
+
+    QMap<quint64, QByteArray> results;
+    for (const QList<QVariant> &args : qAsConst(readSpy))
+        results.insert(args.at(0).value<quint64>(), args.at(1).toByteArray());
+    QCOMPARE(results.first(), QByteArray("lo"));
+    QCOMPARE(results.last(), QByteArray());
+}
+
+void tst_QAsyncFileIO::manyRequests_data()
+{
+    addBackendColumn();
+}
+
+void tst_QAsyncFileIO::manyRequests()
+{
+    if (!setupBackend())
+        QSKIP("Backend not available on this system");
+
+    // more requests than fit into the submission queue at once
+    constexpr int Count = 500;
+    constexpr int BlockSize = 512;
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+
+    QAsyncFileIO io(&file);
+    QSignalSpy writeSpy(&io, &QAsyncFileIO::writeFinished);
+    for (int i = 0; i < Count; ++i)
+        QVERIFY(io.write(qint64(i) * BlockSize, QByteArray(BlockSize, char('a' + i % 26))));
+    QVERIFY(io.waitForFinished());
+    QCOMPARE(writeSpy.count(), Count);
+    QCOMPARE(file.size(), qint64(Count) * BlockSize);
+
+    QSignalSpy readSpy(&io, &QAsyncFileIO::readFinished);
+    QHash<quint64, int> blocks;
+    for (int i = 0; i < Count; ++i)
+        blocks.insert(io.read(qint64(i) * BlockSize, BlockSize), i);
+    QVERIFY(io.waitForFinished());
+    QCOMPARE(readSpy.count(), Count);
+    for (const QList<QVariant> &args : qAsConst(readSpy)) {
+        const int block = blocks.value(args.at(0).value<quint64>(), -1);
+        QVERIFY(block >= 0);
+        QCOMPARE(args.at(1).toByteArray(), QByteArray(BlockSize, char('a' + block % 26)));
+    }
+}
+
+void tst_QAsyncFileIO::invalidRequests()
+{
+    QFile closed;
+    QAsyncFileIO io(&closed);
+
+    QTest::ignoreMessage(QtWarningMsg, "QAsyncFileIO::read: File not open for reading");
+    QCOMPARE(io.read(0, 10), 0u);
+    QTest::ignoreMessage(QtWarningMsg, "QAsyncFileIO::write: File not open for writing");
+    QCOMPARE(io.write(0, "x"), 0u);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QAsyncFileIO io2(&file);
+    QTest::ignoreMessage(QtWarningMsg, "QAsyncFileIO::read: Invalid offset or size");
+    QCOMPARE(io2.read(-1, 10), 0u);
+    QTest::ignoreMessage(QtWarningMsg, "QAsyncFileIO::write: Invalid offset");
+    QCOMPARE(io2.write(-1, "x"), 0u);
+    QCOMPARE(io2.pendingRequests(), 0);
+}
+
+void tst_QAsyncFileIO::destroyWithPendingRequests_data()
+{
+    addBackendColumn();
+}
+
+void tst_QAsyncFileIO::destroyWithPendingRequests()
+{
+    if (!setupBackend())
+        QSKIP("Backend not available on this system");
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+
+    {
+        QAsyncFileIO io(&file);
+        for (int i = 0; i < 100; ++i)
+            QVERIFY(io.write(i * 4, "abcd"));
+    }
+
+    // the destructor waits for all writes to land
+    QCOMPARE(file.size(), 400);
+}
+
+QTEST_MAIN(tst_QAsyncFileIO)
+
+#include "tst_qasyncfileio.moc"
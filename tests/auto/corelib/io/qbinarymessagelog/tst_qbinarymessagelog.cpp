@@ -0,0 +1,222 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBinaryMessageLog>
+#include <QBuffer>
+#include <QLoggingCategory>
+#include <QPoint>
+#include <QThread>
+
+Q_LOGGING_CATEGORY(lcRecorded, "tst.recorded")
+Q_LOGGING_CATEGORY(lcDisabled, "tst.disabled", QtInfoMsg)
+
+class tst_QBinaryMessageLog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanup();
+    void arguments();
+    void inactive();
+    void disabledCategory();
+    void definitionWrittenOnce();
+    void restart();
+    void threads();
+    void truncated();
+
+private:
+    static QStringList decode(QBuffer &log);
+};
+
+QStringList tst_QBinaryMessageLog::decode(QBuffer &log)
+{
+    log.close();
+    log.open(QIODevice::ReadOnly);
+    QBuffer text;
+    text.open(QIODevice::WriteOnly);
+    if (!QBinaryMessageLog::decode(&log, &text))
+        return { QStringLiteral("decoding failed") };
+
+    QStringList lines;
+    for (const QByteArray &line : text.data().split('\n')) {
+        // drop the timestamp
+        if (!line.isEmpty())
+            lines.append(QString::fromUtf8(line.mid(line.indexOf(' ', line.indexOf('.')) + 1)));
+    }
+    return lines;
+}
+
+void tst_QBinaryMessageLog::cleanup()
+{
+    QBinaryMessageLog::stop();
+}
+
+enum class Color { Red = 1, Green = 2 };
+
+void tst_QBinaryMessageLog::arguments()
+{
+    QBuffer log;
+    log.open(QIODevice::WriteOnly);
+    QVERIFY(QBinaryMessageLog::start(&log));
+    QVERIFY(QBinaryMessageLog::isActive());
+
+    qCRecord(lcRecorded, "no arguments");
+    qCRecord(lcRecorded, "%1 %2 %3", -42, 42u, std::numeric_limits<qint64>::min());
+    qCRecord(lcRecorded, "%2 before %1", true, false);
+    qCRecord(lcRecorded, "%1", 0.5);
+    qCRecord(lcRecorded, "%1|%2|%3|%4", "char", QStringLiteral("QString é"),
+             QByteArray("QByteArray"), QLatin1String("Latin-1"));
+    qCRecord(lcRecorded, "%1", Color::Green);
+    qCRecord(lcRecorded, "%1", reinterpret_cast<void *>(0xbeef));
+    qCRecord(lcRecorded, "%1", QPoint(1, 2));
+    qCRecord(lcRecorded, "%1 %3 100%", 1);
+
+    QBinaryMessageLog::stop();
+    QVERIFY(!QBinaryMessageLog::isActive());
+
+    const QStringList expected = {
+        "tst.recorded: no arguments",
+        "tst.recorded: -42 42 -9223372036854775808",
+        "tst.recorded: false before true",
+        "tst.recorded: 0.5",
+        "tst.recorded: char|QString é|QByteArray|Latin-1",
+        "tst.recorded: 2",
+        "tst.recorded: 0xbeef",
+        "tst.recorded: QPoint(1,2)",
+        "tst.recorded: 1 %3 100%",
+    };
+    QCOMPARE(decode(log), expected);
+}
+
+void tst_QBinaryMessageLog::inactive()
+{
+    int evaluated = 0;
+    qCRecord(lcRecorded, "%1", ++evaluated);
+    QCOMPARE(evaluated, 0);
+}
+
+void tst_QBinaryMessageLog::disabledCategory()
+{
+    QBuffer log;
+    log.open(QIODevice::WriteOnly);
+    QVERIFY(QBinaryMessageLog::start(&log));
+
+    int evaluated = 0;
+    qCRecord(lcDisabled, "%1", ++evaluated);
+    qCRecord(lcRecorded, "enabled");
+    QCOMPARE(evaluated, 0);
+
+    QBinaryMessageLog::stop();
+    QCOMPARE(decode(log), QStringList { "tst.recorded: enabled" });
+}
+
+void tst_QBinaryMessageLog::definitionWrittenOnce()
+{
+    QBuffer log;
+    log.open(QIODevice::WriteOnly);
+    QVERIFY(QBinaryMessageLog::start(&log));
+
+    const QByteArray format = "a format string that is only written once";
+    for (int i = 0; i < 100; ++i)
+        qCRecord(lcRecorded, "a format string that is only written once %1", i);
+    QBinaryMessageLog::stop();
+
+    QCOMPARE(log.data().count(format), 1);
+    const QStringList lines = decode(log);
+    QCOMPARE(lines.size(), 100);
+    QCOMPARE(lines.last(), "tst.recorded: " + format + " 99");
+}
+
+void tst_QBinaryMessageLog::restart()
+{
+    // each log is self-contained, even if the call sites were used before
+    for (int run = 0; run < 2; ++run) {
+        QBuffer log;
+        log.open(QIODevice::WriteOnly);
+        QVERIFY(QBinaryMessageLog::start(&log));
+        qCRecord(lcRecorded, "run %1", run);
+        QBinaryMessageLog::stop();
+        QCOMPARE(decode(log), QStringList { QString("tst.recorded: run %1").arg(run) });
+    }
+}
+
+void tst_QBinaryMessageLog::threads()
+{
+    QBuffer log;
+    log.open(QIODevice::WriteOnly);
+    QVERIFY(QBinaryMessageLog::start(&log));
+
+    QList<QThread *> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads << QThread::create([t] {
+            for (int i = 0; i < 1000; ++i)
+                qCRecord(lcRecorded, "%1 %2", t, i);
+        });
+        threads.last()->start();
+    }
+    for (QThread *thread : qAsConst(threads)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+    QBinaryMessageLog::stop();
+
+    const QStringList lines = decode(log);
+    QCOMPARE(lines.size(), 4000);
+    int next[4] = {};
+    for (const QString &line : lines) {
+        const QStringList parts = line.mid(line.indexOf(' ') + 1).split(' ');
+        const int t = parts.at(0).toInt();
+        QCOMPARE(parts.at(1).toInt(), next[t]++);
+    }
+}
+
+void tst_QBinaryMessageLog::truncated()
+{
+    QBuffer log;
+    log.open(QIODevice::WriteOnly);
+    QVERIFY(QBinaryMessageLog::start(&log));
+    qCRecord(lcRecorded, "%1", QStringLiteral("some text"));
+    QBinaryMessageLog::stop();
+
+    QBuffer cut;
+    cut.setData(log.data().chopped(3));
+    cut.open(QIODevice::ReadOnly);
+    QBuffer text;
+    text.open(QIODevice::WriteOnly);
+    QVERIFY(!QBinaryMessageLog::decode(&cut, &text));
+
+    QBuffer garbage;
+    garbage.setData("not a log");
+    garbage.open(QIODevice::ReadOnly);
+    QVERIFY(!QBinaryMessageLog::decode(&garbage, &text));
+}
+
+QTEST_MAIN(tst_QBinaryMessageLog)
+#include "tst_qbinarymessagelog.moc"
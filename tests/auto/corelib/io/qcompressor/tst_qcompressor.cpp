@@ -0,0 +1,350 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBuffer>
+#include <QCompressionDevice>
+#include <QCompressor>
+#include <QRandomGenerator>
+
+class tst_QCompressor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip_data();
+    void roundTrip();
+    void streaming_data();
+    void streaming();
+    void flush_data();
+    void flush();
+    void consecutiveStreams_data();
+    void consecutiveStreams();
+    void invalidData_data();
+    void invalidData();
+    void levels();
+    void qCompressCompatibility();
+    void gzipHeader();
+    void device_data();
+    void device();
+    void truncatedDevice();
+};
+
+static QByteArray sampleData(qsizetype size)
+{
+    // compressible, but not trivially so
+    QByteArray data;
+    data.reserve(size);
+    QRandomGenerator generator(42);
+    while (data.size() < size) {
+        data += "line " + QByteArray::number(generator.bounded(1000)) + ": ";
+        data += QByteArray(generator.bounded(20), char('a' + generator.bounded(26)));
+        data += '\n';
+    }
+    data.truncate(size);
+    return data;
+}
+
+static void addAlgorithmColumns()
+{
+    QTest::addColumn<QCompressor::Algorithm>("algorithm");
+}
+
+static void addAlgorithmRows(const char *suffix = "")
+{
+    QTest::addRow("deflate%s", suffix) << QCompressor::Deflate;
+    QTest::addRow("gzip%s", suffix) << QCompressor::GZip;
+    QTest::addRow("zstd%s", suffix) << QCompressor::Zstandard;
+    QTest::addRow("lz4%s", suffix) << QCompressor::Lz4;
+}
+
+#define SKIP_IF_UNSUPPORTED(algorithm) \
+    if (!QCompressor::isSupported(algorithm)) { \
+        QVERIFY(QCompressor(algorithm).hasError()); \
+        QVERIFY(QDecompressor(algorithm).hasError()); \
+        QSKIP("This build does not support this algorithm"); \
+    }
+
+void tst_QCompressor::roundTrip_data()
+{
+    addAlgorithmColumns();
+    QTest::addColumn<QByteArray>("data");
+
+    const struct {
+        const char *name;
+        QByteArray data;
+    } payloads[] = {
+        { "empty", QByteArray() },
+        { "short", QByteArray("Hello, World!") },
+        { "large", sampleData(1024 * 1024) },
+    };
+    for (const auto &payload : payloads) {
+        QTest::addRow("deflate-%s", payload.name) << QCompressor::Deflate << payload.data;
+        QTest::addRow("gzip-%s", payload.name) << QCompressor::GZip << payload.data;
+        QTest::addRow("zstd-%s", payload.name) << QCompressor::Zstandard << payload.data;
+        QTest::addRow("lz4-%s", payload.name) << QCompressor::Lz4 << payload.data;
+    }
+}
+
+void tst_QCompressor::roundTrip()
+{
+    QFETCH(QCompressor::Algorithm, algorithm);
+    QFETCH(QByteArray, data);
+    SKIP_IF_UNSUPPORTED(algorithm);
+
+    QCompressor compressor(algorithm);
+    QCOMPARE(compressor.algorithm(), algorithm);
+    QVERIFY(!compressor.hasError());
+    const QByteArray compressed = compressor.compress(data) + compressor.finish();
+    QVERIFY(!compressor.hasError());
+    QVERIFY(!compressed.isEmpty());
+    if (data.size() > 1024)
+        QVERIFY(compressed.size() < data.size());
+
+    QDecompressor decompressor(algorithm);
+    QCOMPARE(decompressor.algorithm(), algorithm);
+    QVERIFY(!decompressor.isFinished());
+    QCOMPARE(decompressor.decompress(compressed), data);
+    QVERIFY(!decompressor.hasError());
+    QVERIFY(decompressor.isFinished());
+}
+
+void tst_QCompressor::streaming_data()
+{
+    addAlgorithmColumns();
+    addAlgorithmRows();
+}
+
+void tst_QCompressor::streaming()
+{
+    QFETCH(QCompressor::Algorithm, algorithm);
+    SKIP_IF_UNSUPPORTED(algorithm);
+
+    const QByteArray data = sampleData(300 * 1024);
+    QCompressor compressor(algorithm, 1);
+    QByteArray compressed;
+    for (qsizetype i = 0; i < data.size(); i += 1000)
+        compressed += compressor.compress(data.mid(i, 1000));
+    compressed += compressor.finish();
+    QVERIFY(!compressor.hasError());
+
+    QDecompressor decompressor(algorithm);
+    QByteArray decompressed;
+    for (qsizetype i = 0; i < compressed.size(); i += 7) {
+        QVERIFY(!decompressor.isFinished());
+        decompressed += decompressor.decompress(compressed.mid(i, 7));
+    }
+    QVERIFY(!decompressor.hasError());
+    QVERIFY(decompressor.isFinished());
+    QCOMPARE(decompressed, data);
+}
+
+void tst_QCompressor::flush_data()
+{
+    addAlgorithmColumns();
+    addAlgorithmRows();
+}
+
+void tst_QCompressor::flush()
+{
+    QFETCH(QCompressor::Algorithm, algorithm);
+    SKIP_IF_UNSUPPORTED(algorithm);
+
+    QCompressor compressor(algorithm);
+    QDecompressor decompressor(algorithm);
+
+    // everything compressed before a flush can be decompressed right away
+    const QByteArray messages[] = { "first message", "second message", sampleData(100000) };
+    for (const QByteArray &message : messages) {
+        const QByteArray compressed = compressor.compress(message) + compressor.flush();
+        QVERIFY(!compressor.hasError());
+        QCOMPARE(decompressor.decompress(compressed), message);
+        QVERIFY(!decompressor.isFinished());
+    }
+
+    QVERIFY(decompressor.decompress(compressor.finish()).isEmpty());
+    QVERIFY(decompressor.isFinished());
+    QVERIFY(!decompressor.hasError());
+}
+
+void tst_QCompressor::consecutiveStreams_data()
+{
+    addAlgorithmColumns();
+    // a deflate stream cannot be followed by another one
+    QTest::addRow("gzip") << QCompressor::GZip;
+    QTest::addRow("zstd") << QCompressor::Zstandard;
+    QTest::addRow("lz4") << QCompressor::Lz4;
+}
+
+void tst_QCompressor::consecutiveStreams()
+{
+    QFETCH(QCompressor::Algorithm, algorithm);
+    SKIP_IF_UNSUPPORTED(algorithm);
+
+    QCompressor compressor(algorithm);
+    QByteArray compressed = compressor.compress("first") + compressor.finish();
+    // finishing twice does not produce an empty stream
+    QVERIFY(compressor.finish().isEmpty());
+    compressed += compressor.compress("second") + compressor.finish();
+    QVERIFY(!compressor.hasError());
+
+    QDecompressor decompressor(algorithm);
+    QCOMPARE(decompressor.decompress(compressed), QByteArray("firstsecond"));
+    QVERIFY(decompressor.isFinished());
+}
+
+void tst_QCompressor::invalidData_data()
+{
+    addAlgorithmColumns();
+    addAlgorithmRows();
+}
+
+void tst_QCompressor::invalidData()
+{
+    QFETCH(QCompressor::Algorithm, algorithm);
+    SKIP_IF_UNSUPPORTED(algorithm);
+
+    QDecompressor decompressor(algorithm);
+    decompressor.decompress(QByteArray(64, '\xff'));
+    QVERIFY(decompressor.hasError());
+    QVERIFY(!decompressor.errorString().isEmpty());
+    // nothing more is decompressed until the decompressor is reset
+    QCompressor compressor(algorithm);
+    const QByteArray compressed = compressor.compress("valid") + compressor.finish();
+    QVERIFY(decompressor.decompress(compressed).isEmpty());
+
+    decompressor.reset();
+    QVERIFY(!decompressor.hasError());
+    QCOMPARE(decompressor.decompress(compressed), QByteArray("valid"));
+}
+
+void tst_QCompressor::levels()
+{
+    QCOMPARE(QCompressor(QCompressor::Deflate).level(), 6);
+    QCOMPARE(QCompressor(QCompressor::Deflate, 0).level(), 0);
+    QCOMPARE(QCompressor(QCompressor::GZip, 100).level(), 9);
+
+    const QByteArray data = sampleData(256 * 1024);
+    QCompressor fast(QCompressor::Deflate, 1);
+    QCompressor best(QCompressor::Deflate, 9);
+    QVERIFY((best.compress(data) + best.finish()).size()
+            <= (fast.compress(data) + fast.finish()).size());
+
+    QCompressor none(QCompressor::Deflate, 0);
+    QVERIFY((none.compress(data) + none.finish()).size() > data.size());
+
+    // only zstd compresses on worker threads
+    QVERIFY(!QCompressor(QCompressor::Deflate).setWorkerThreadCount(2));
+    QVERIFY(QCompressor(QCompressor::Deflate).setWorkerThreadCount(0));
+}
+
+void tst_QCompressor::qCompressCompatibility()
+{
+    // qCompress() produces a deflate stream prefixed with the uncompressed size
+    const QByteArray data = sampleData(10000);
+    const QByteArray legacy = qCompress(data);
+
+    QDecompressor decompressor(QCompressor::Deflate);
+    QCOMPARE(decompressor.decompress(QByteArrayView(legacy).sliced(4)), data);
+    QVERIFY(decompressor.isFinished());
+
+    QCompressor compressor(QCompressor::Deflate);
+    QByteArray compressed = compressor.compress(data) + compressor.finish();
+    compressed.prepend(QByteArray::fromHex("00002710"));
+    QCOMPARE(qUncompress(compressed), data);
+}
+
+void tst_QCompressor::gzipHeader()
+{
+    QCompressor compressor(QCompressor::GZip);
+    const QByteArray compressed = compressor.compress("gzip") + compressor.finish();
+    QVERIFY(compressed.startsWith("\x1f\x8b"));
+}
+
+void tst_QCompressor::device_data()
+{
+    addAlgorithmColumns();
+    addAlgorithmRows();
+}
+
+void tst_QCompressor::device()
+{
+    QFETCH(QCompressor::Algorithm, algorithm);
+    SKIP_IF_UNSUPPORTED(algorithm);
+
+    const QByteArray data = sampleData(200 * 1024);
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        QCompressionDevice compressing(&buffer, algorithm);
+        compressing.setCompressionLevel(3);
+        QCOMPARE(compressing.device(), &buffer);
+        QCOMPARE(compressing.algorithm(), algorithm);
+        QVERIFY(compressing.isSequential());
+        QTest::ignoreMessage(QtWarningMsg, "QCompressionDevice::open: "
+                                           "Compression devices are either read or written");
+        QVERIFY(!compressing.open(QIODevice::ReadWrite));
+        QVERIFY(!compressing.open(QIODevice::ReadOnly));
+        QVERIFY(compressing.open(QIODevice::WriteOnly));
+        QCOMPARE(compressing.write(data.first(1000)), qint64(1000));
+        QVERIFY(compressing.flush());
+        QCOMPARE(compressing.write(data.sliced(1000)), qint64(data.size() - 1000));
+        compressing.close();
+        QVERIFY(buffer.isOpen());
+    }
+    buffer.close();
+    QVERIFY(buffer.size() < data.size());
+
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCompressionDevice decompressing(&buffer, algorithm);
+    QVERIFY(decompressing.open(QIODevice::ReadOnly));
+    QCOMPARE(decompressing.read(100), data.first(100));
+    QCOMPARE(decompressing.readAll(), data.sliced(100));
+    QVERIFY(decompressing.atEnd());
+    QCOMPARE(decompressing.errorString(), QLatin1String("Unknown error"));
+}
+
+void tst_QCompressor::truncatedDevice()
+{
+    const QByteArray data = sampleData(10000);
+    QCompressor compressor(QCompressor::GZip);
+    QByteArray compressed = compressor.compress(data) + compressor.finish();
+    compressed.chop(10);
+
+    QBuffer buffer(&compressed);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QCompressionDevice decompressing(&buffer, QCompressor::GZip);
+    QVERIFY(decompressing.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+    const QByteArray result = decompressing.readAll();
+    QVERIFY(data.startsWith(result));
+    QCOMPARE(decompressing.errorString(), QLatin1String("Unexpected end of compressed data"));
+}
+
+QTEST_MAIN(tst_QCompressor)
+#include "tst_qcompressor.moc"
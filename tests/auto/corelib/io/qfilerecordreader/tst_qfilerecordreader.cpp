@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QFileRecordReader>
+#include <QTemporaryFile>
+
+class tst_QFileRecordReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void records_data();
+    void records();
+    void delimiter();
+    void emptyFile();
+    void missingFile();
+    void chunks_data();
+    void chunks();
+
+private:
+    bool writeFile(QTemporaryFile *file, const QByteArray &contents);
+};
+
+bool tst_QFileRecordReader::writeFile(QTemporaryFile *file, const QByteArray &contents)
+{
+    if (!file->open())
+        return false;
+    if (file->write(contents) != contents.size())
+        return false;
+    file->close();
+    return true;
+}
+
+static QList<QByteArray> collect(const QFileRecordReader::Records &records)
+{
+    QList<QByteArray> result;
+    for (QByteArrayView record : records)
+        result.append(record.toByteArray());
+    return result;
+}
+
+void tst_QFileRecordReader::records_data()
+{
+    QTest::addColumn<QByteArray>("contents");
+    QTest::addColumn<QList<QByteArray>>("expected");
+
+    QTest::newRow("single") << QByteArray("one") << QList<QByteArray>{ "one" };
+    QTest::newRow("terminated") << QByteArray("one\n") << QList<QByteArray>{ "one" };
+    QTest::newRow("two") << QByteArray("one\ntwo") << QList<QByteArray>{ "one", "two" };
+    QTest::newRow("empty-lines") << QByteArray("\none\n\ntwo\n\n")
+                                 << QList<QByteArray>{ "", "one", "", "two", "" };
+    QTest::newRow("newline-only") << QByteArray("\n") << QList<QByteArray>{ "" };
+    QTest::newRow("crlf") << QByteArray("a\r\nb\r\n") << QList<QByteArray>{ "a\r", "b\r" };
+}
+
+void tst_QFileRecordReader::records()
+{
+    QFETCH(QByteArray, contents);
+    QFETCH(QList<QByteArray>, expected);
+
+    QTemporaryFile file;
+    QVERIFY(writeFile(&file, contents));
+
+    QFileRecordReader reader(file.fileName());
+    QVERIFY(!reader.isOpen());
+    QVERIFY(reader.open());
+    QVERIFY(reader.isOpen());
+    QCOMPARE(reader.error(), QFileDevice::NoError);
+    QCOMPARE(reader.data(), contents);
+    QCOMPARE(collect(reader.records()), expected);
+
+    // the views point into the mapping, not into copies
+    for (QByteArrayView record : reader) {
+        QVERIFY(record.data() >= reader.data().data());
+        QVERIFY(record.data() + record.size() <= reader.data().data() + reader.data().size());
+    }
+
+    reader.close();
+    QVERIFY(!reader.isOpen());
+    QVERIFY(reader.data().isNull());
+    QCOMPARE(reader.begin(), reader.end());
+}
+
+void tst_QFileRecordReader::delimiter()
+{
+    QTemporaryFile file;
+    QVERIFY(writeFile(&file, "a,b\nc,,d"));
+
+    QFileRecordReader reader(file.fileName(), ',');
+    QCOMPARE(reader.delimiter(), ',');
+    QVERIFY(reader.open(QFileRecordReader::RandomAccess));
+    QCOMPARE(collect(reader.records()), (QList<QByteArray>{ "a", "b\nc", "", "d" }));
+
+    reader.setDelimiter('\n');
+    QCOMPARE(collect(reader.records()), (QList<QByteArray>{ "a,b", "c,,d" }));
+
+    QCOMPARE(collect(QFileRecordReader::Records("x;y", ';')), (QList<QByteArray>{ "x", "y" }));
+}
+
+void tst_QFileRecordReader::emptyFile()
+{
+    QTemporaryFile file;
+    QVERIFY(writeFile(&file, QByteArray()));
+
+    QFileRecordReader reader(file.fileName());
+    QVERIFY(reader.open());
+    QVERIFY(reader.data().isEmpty());
+    QCOMPARE(reader.begin(), reader.end());
+    QVERIFY(reader.chunks(4).isEmpty());
+}
+
+void tst_QFileRecordReader::missingFile()
+{
+    QFileRecordReader reader(QStringLiteral("this-file-does-not-exist"));
+    QVERIFY(!reader.open());
+    QVERIFY(!reader.isOpen());
+    QCOMPARE(reader.error(), QFileDevice::OpenError);
+    QVERIFY(!reader.errorString().isEmpty());
+    QCOMPARE(reader.begin(), reader.end());
+}
+
+void tst_QFileRecordReader::chunks_data()
+{
+    QTest::addColumn<QByteArray>("contents");
+    QTest::addColumn<int>("count");
+
+    QByteArray lines;
+    for (int i = 0; i < 1000; ++i)
+        lines += QByteArray::number(i * 7919) + '\n';
+    QTest::newRow("lines-1") << lines << 1;
+    QTest::newRow("lines-3") << lines << 3;
+    QTest::newRow("lines-16") << lines << 16;
+    QTest::newRow("unterminated") << lines + "last" << 7;
+    QTest::newRow("more-chunks-than-lines") << QByteArray("a\nb\nc") << 10;
+    QTest::newRow("one-long-line") << QByteArray(1000, 'x') << 4;
+    QTest::newRow("long-then-short") << QByteArray(1000, 'x') + "\na\nb\n" << 4;
+}
+
+void tst_QFileRecordReader::chunks()
+{
+    QFETCH(QByteArray, contents);
+    QFETCH(int, count);
+
+    QTemporaryFile file;
+    QVERIFY(writeFile(&file, contents));
+
+    QFileRecordReader reader(file.fileName());
+    QVERIFY(reader.open(QFileRecordReader::RandomAccess));
+
+    const QList<QByteArrayView> chunks = reader.chunks(count);
+    QVERIFY(!chunks.isEmpty());
+    QVERIFY(chunks.size() <= count);
+
+    // the chunks are contiguous, cover the whole file, and hold whole records
+    const char *next = reader.data().data();
+    QList<QByteArray> records;
+    for (QByteArrayView chunk : chunks) {
+        QVERIFY(!chunk.isEmpty());
+        QCOMPARE(chunk.data(), next);
+        next = chunk.data() + chunk.size();
+        if (next != reader.data().data() + reader.data().size())
+            QCOMPARE(chunk.back(), '\n');
+        records += collect(QFileRecordReader::Records(chunk));
+    }
+    QCOMPARE(next, reader.data().data() + reader.data().size());
+    QCOMPARE(records, collect(reader.records()));
+}
+
+QTEST_MAIN(tst_QFileRecordReader)
+#include "tst_qfilerecordreader.moc"
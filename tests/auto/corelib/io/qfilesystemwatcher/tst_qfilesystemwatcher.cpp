@@ -69,6 +69,7 @@ private slots:
     void addPaths();
     void removePaths();
     void removePathsFilesInSameDirectory();
+    void addRemoveManyPaths();
 
 #ifdef QT_BUILD_INTERNAL
     void watchFileAndItsDirectory_data() { basicTest_data(); }
@@ -523,6 +524,59 @@ void tst_QFileSystemWatcher::removePathsFilesInSameDirectory()
     QCOMPARE(watcher.files().size(), 0);
 }
 
+void tst_QFileSystemWatcher::addRemoveManyPaths()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    QDir dir(temporaryDirectory.path());
+
+    QStringList files;
+    QStringList directories;
+    for (int i = 0; i < 200; ++i) {
+        QFile file(dir.filePath(QString::number(i)));
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        files << file.fileName();
+    }
+    for (int i = 0; i < 20; ++i) {
+        const QString name = QStringLiteral("dir") + QString::number(i);
+        QVERIFY(dir.mkdir(name));
+        directories << dir.filePath(name);
+    }
+
+    QFileSystemWatcher watcher;
+    const QStringList paths = files + directories;
+    QCOMPARE(watcher.addPaths(paths), QStringList());
+    QCOMPARE(watcher.files(), files);
+    QCOMPARE(watcher.directories(), directories);
+
+    // already watched paths are handed back
+    const QStringList duplicates = { files.first(), directories.first() };
+    QCOMPARE(watcher.addPaths(duplicates), duplicates);
+    QCOMPARE(watcher.files().size(), files.size());
+    QCOMPARE(watcher.directories().size(), directories.size());
+
+    // remove every other path, keeping the order of the others
+    QStringList removed;
+    QStringList remainingFiles;
+    QStringList remainingDirectories;
+    for (qsizetype i = 0; i < paths.size(); ++i) {
+        if (i % 2)
+            removed << paths.at(i);
+        else if (i < files.size())
+            remainingFiles << paths.at(i);
+        else
+            remainingDirectories << paths.at(i);
+    }
+    QCOMPARE(watcher.removePaths(removed), QStringList());
+    QCOMPARE(watcher.files(), remainingFiles);
+    QCOMPARE(watcher.directories(), remainingDirectories);
+    QCOMPARE(watcher.removePaths(removed), removed);
+
+    QCOMPARE(watcher.removePaths(paths).size(), removed.size());
+    QVERIFY(watcher.files().isEmpty());
+    QVERIFY(watcher.directories().isEmpty());
+}
+
 #ifdef QT_BUILD_INTERNAL
 static QByteArray msgFileOperationFailed(const char *what, const QFile &f)
 {
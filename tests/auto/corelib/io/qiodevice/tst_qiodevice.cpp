@@ -63,6 +63,8 @@ private slots:
     void transaction_data();
     void transaction();
 
+    void readChunk();
+
 private:
     QSharedPointer<QTemporaryDir> m_tempDir;
     QString m_previousCurrent;
@@ -835,5 +837,56 @@ void tst_QIODevice::transaction()
     }
 }
 
+// Test readChunk() and peekChunks() on the read buffer of a sequential device
+void tst_QIODevice::readChunk()
+{
+    QByteArray data(40000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i % 251);
+
+    SequentialReadBuffer dev(&data);
+    dev.open(QIODevice::ReadOnly);
+    QVERIFY(dev.peekChunks().isEmpty());
+
+    // Fill the read buffer:
+    QCOMPARE(dev.peek(1), data.left(1));
+    QList<QByteArrayView> chunks = dev.peekChunks();
+    QCOMPARE(chunks.size(), 1);
+    const QByteArrayView buffered = chunks.first();
+    QVERIFY(buffered.size() > 1);
+    QCOMPARE(buffered, QByteArrayView(data).first(buffered.size()));
+
+    // A transaction skips the data it has read:
+    dev.startTransaction();
+    QCOMPARE(dev.read(10), data.left(10));
+    chunks = dev.peekChunks();
+    QCOMPARE(chunks.size(), 1);
+    QCOMPARE(chunks.first(), buffered.sliced(10));
+    // ... and readChunk() keeps the data in the buffer for a rollback:
+    const QByteArray inTransaction = dev.readChunk();
+    QVERIFY(!inTransaction.isEmpty());
+    QCOMPARE(inTransaction, data.mid(10, inTransaction.size()));
+    dev.rollbackTransaction();
+    QCOMPARE(dev.peekChunks().first().data(), buffered.data());
+
+    // The buffered chunk is handed out without copying:
+    QByteArray result = dev.readChunk();
+    QCOMPARE(result.constData(), buffered.data());
+    QCOMPARE(result.size(), buffered.size());
+
+    // The rest was buffered by the transaction or is read directly:
+    QByteArray chunk;
+    while (!(chunk = dev.readChunk()).isEmpty())
+        result += chunk;
+    QCOMPARE(result, data);
+    QVERIFY(dev.atEnd());
+
+    SequentialReadBuffer textDev("line\r\n");
+    textDev.open(QIODevice::ReadOnly | QIODevice::Text);
+    QCOMPARE(textDev.peek(1), QByteArray("l"));
+    QVERIFY(textDev.peekChunks().isEmpty());
+    QCOMPARE(textDev.readChunk(), QByteArray("line\n"));
+}
+
 QTEST_MAIN(tst_QIODevice)
 #include "tst_qiodevice.moc"
@@ -31,7 +31,9 @@
 #include <QResource>
 #include <QtPlugin>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDirIterator>
 #include <QtCore/QScopeGuard>
+#include <QtCore/QtEndian>
 #include <QtCore/private/qglobal_p.h>
 
 class tst_QResourceEngine: public QObject
@@ -57,6 +59,9 @@ private slots:
     void checkUnregisterResource();
     void compressedResource_data();
     void compressedResource();
+    void decompressionCache_data() { compressedResource_data(); }
+    void decompressionCache();
+    void zstdDictionary();
     void checkStructure_data();
     void checkStructure();
     void searchPath_data();
@@ -175,6 +180,115 @@ void tst_QResourceEngine::compressedResource()
     QCOMPARE(data, expectedData);
 }
 
+void tst_QResourceEngine::decompressionCache()
+{
+    QFETCH(QString, fileName);
+    QFETCH(int, compressionAlgo);
+    QFETCH(bool, supported);
+    if (!supported)
+        QSKIP("Compression algorithm not supported");
+    const QByteArray expectedData(ZERO_FILE_LEN, '\0');
+
+    QCOMPARE(QResource::decompressionCacheLimit(), 0);
+    QResource::setDecompressionCacheLimit(1024 * 1024);
+    auto resetLimit = qScopeGuard([] { QResource::setDecompressionCacheLimit(0); });
+    QCOMPARE(QResource::decompressionCacheLimit(), 1024 * 1024);
+
+    QVERIFY(QResource::registerResource(fileName));
+    auto unregister = qScopeGuard([=] { QResource::unregisterResource(fileName); });
+
+    QResource resource("zero.txt");
+    QVERIFY(resource.isValid());
+    const QByteArray first = resource.uncompressedData();
+    QCOMPARE(first, expectedData);
+
+    // a cache hit shares the data decompressed before
+    const QByteArray second = QResource("zero.txt").uncompressedData();
+    QCOMPARE(second, expectedData);
+    if (compressionAlgo != QResource::NoCompression)
+        QCOMPARE(static_cast<const void *>(second.constData()),
+                 static_cast<const void *>(first.constData()));
+
+    QFile f(":/zero.txt");
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QCOMPARE(f.readAll(), expectedData);
+
+    // data larger than the limit is not cached
+    QResource::setDecompressionCacheLimit(ZERO_FILE_LEN - 1);
+    const QByteArray third = resource.uncompressedData();
+    QCOMPARE(third, expectedData);
+    if (compressionAlgo != QResource::NoCompression) {
+        QVERIFY(resource.uncompressedData().constData() != third.constData());
+    }
+
+    // unregistering drops cached data, which must not be served for a
+    // resource registered again later
+    QResource::setDecompressionCacheLimit(1024 * 1024);
+    QCOMPARE(resource.uncompressedData(), expectedData);
+    unregister.dismiss();
+    resource.setFileName(QString());
+    QVERIFY(QResource::unregisterResource(fileName));
+    QVERIFY(!QResource("zero.txt").isValid());
+    QVERIFY(QResource::registerResource(fileName));
+    QCOMPARE(QResource("zero.txt").uncompressedData(), expectedData);
+    QVERIFY(QResource::unregisterResource(fileName));
+}
+
+void tst_QResourceEngine::zstdDictionary()
+{
+#if QT_CONFIG(zstd)
+#  ifndef ZSTD_DICTIONARY_SOURCES
+    QSKIP("zstd_dictionary.rcc is not generated when cross-compiling");
+#  else
+    const QString fileName = QFINDTESTDATA("zstd_dictionary.rcc");
+    QVERIFY(!fileName.isEmpty());
+    const QString sourcePath = QStringLiteral(ZSTD_DICTIONARY_SOURCES);
+
+    QVERIFY(QResource::registerResource(fileName, "/zstd_dictionary/"));
+    auto unregister = qScopeGuard([=] {
+        QResource::unregisterResource(fileName, "/zstd_dictionary/");
+    });
+
+    int filesWithDictionary = 0;
+    QDirIterator it(":/zstd_dictionary/items", QDir::Files);
+    while (it.hasNext()) {
+        const QString resourcePath = it.next();
+        QFile sourceFile(sourcePath + QLatin1Char('/') + it.fileName());
+        QVERIFY(sourceFile.open(QIODevice::ReadOnly));
+        const QByteArray expectedData = sourceFile.readAll();
+
+        QResource resource(resourcePath);
+        QVERIFY(resource.isValid());
+        if (resource.compressionAlgorithm() != QResource::ZstdCompression)
+            continue;
+
+        // Every payload is preceded by its length. Files compressed with the
+        // dictionary have the offset of the dictionary in between, which
+        // data() and size() leave out, so that they describe the zstd frame.
+        const uchar *data = resource.data();
+        const qint64 size = resource.size();
+        QVERIFY(data);
+        QCOMPARE(qFromLittleEndian<quint32>(data), 0xFD2FB528u); // zstd frame magic
+        if (qFromBigEndian<quint32>(data - 4) != quint32(size)) {
+            QCOMPARE(qFromBigEndian<quint32>(data - 8), quint32(size + 4));
+            QCOMPARE(qFromBigEndian<quint32>(data - 4), 0u); // the dictionary comes first
+            ++filesWithDictionary;
+        }
+
+        QCOMPARE(resource.uncompressedSize(), qint64(expectedData.size()));
+        QCOMPARE(resource.uncompressedData(), expectedData);
+
+        QFile f(resourcePath);
+        QVERIFY(f.open(QIODevice::ReadOnly));
+        QCOMPARE(f.size(), qint64(expectedData.size()));
+        QCOMPARE(f.readAll(), expectedData);
+    }
+    QVERIFY(filesWithDictionary > 0);
+#  endif
+#else
+    QSKIP("This test requires zstd support");
+#endif
+}
 
 void tst_QResourceEngine::checkStructure_data()
 {
@@ -144,6 +144,7 @@ private slots:
     void testChildKeysAndGroups_data();
     void testChildKeysAndGroups();
     void testUpdateRequestEvent();
+    void testBackgroundSync();
     void testThreadSafety();
     void testEmptyData();
     void testEmptyKey();
@@ -2066,6 +2067,53 @@ void tst_QSettings::testUpdateRequestEvent()
     QDir::setCurrent(oldCur);
 }
 
+void tst_QSettings::testBackgroundSync()
+{
+    const QString oldCur = QDir::currentPath();
+    QString dataLocation = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QVERIFY(QDir::root().mkpath(dataLocation));
+    QDir::setCurrent(dataLocation);
+
+    QFile::remove("foo");
+    QVERIFY(!QFile::exists("foo"));
+
+    {
+        QSettings settings1("foo", QSettings::IniFormat);
+        QVERIFY(!settings1.isBackgroundSyncEnabled());
+        settings1.setBackgroundSyncEnabled(true);
+        QVERIFY(settings1.isBackgroundSyncEnabled());
+
+        settings1.setValue("key1", 1);
+        QCOMPARE(QFileInfo("foo").size(), qint64(0));
+        QTRY_VERIFY(QFileInfo("foo").size() > 0);
+        QCOMPARE(settings1.status(), QSettings::NoError);
+
+        // changes made while a write is queued or running all get saved
+        for (int i = 0; i < 100; ++i) {
+            settings1.setValue("key2", i);
+            QCoreApplication::processEvents();
+        }
+        QCOMPARE(settings1.value("key2"), QVariant(99));
+
+        // destroying the object waits for the background write
+        settings1.setValue("key3", 3);
+    }
+
+    QSettings settings2("foo", QSettings::IniFormat);
+    QCOMPARE(settings2.value("key1").toInt(), 1);
+    QCOMPARE(settings2.value("key2").toInt(), 99);
+    QCOMPARE(settings2.value("key3").toInt(), 3);
+
+    QFile file("foo");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QVERIFY2(contents.contains("key2=99"), contents.constData());
+    QVERIFY2(contents.contains("key3=3"), contents.constData());
+    file.close();
+
+    QDir::setCurrent(oldCur);
+}
+
 const int NumIterations = 5;
 const int NumThreads = 4;
 int numThreadSafetyFailures;
@@ -0,0 +1,227 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QAbstractItemModelTester>
+#include <QColumnarTableModel>
+
+class tst_QColumnarTableModel : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void construct();
+    void typedColumns();
+    void otherRoles();
+    void multiData();
+    void insertRemoveRows();
+    void insertRemoveColumns();
+    void setColumnType();
+    void headers();
+};
+
+void tst_QColumnarTableModel::construct()
+{
+    QColumnarTableModel model(3, 2);
+    QAbstractItemModelTester tester(&model);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.rowCount(model.index(0, 0)), 0);
+    QVERIFY(!model.data(model.index(1, 1)).isValid());
+    QVERIFY(!model.columnType(0).isValid());
+    QVERIFY(model.flags(model.index(0, 0)).testFlag(Qt::ItemIsEditable));
+
+    model.setRowCount(5);
+    model.setColumnCount(1);
+    QCOMPARE(model.rowCount(), 5);
+    QCOMPARE(model.columnCount(), 1);
+
+    model.clear();
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(model.columnCount(), 0);
+}
+
+void tst_QColumnarTableModel::typedColumns()
+{
+    QColumnarTableModel model(2, 3);
+    QAbstractItemModelTester tester(&model);
+    QVERIFY(model.setColumnType(0, QMetaType::fromType<int>()));
+    QVERIFY(model.setColumnType(1, QMetaType::fromType<QString>()));
+    QVERIFY(!model.setColumnType(3, QMetaType::fromType<int>()));
+    QCOMPARE(model.columnType(0), QMetaType::fromType<int>());
+
+    QSignalSpy spy(&model, &QAbstractItemModel::dataChanged);
+    QVERIFY(model.setData(model.index(0, 0), 42));
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(model.setData(model.index(1, 0), QStringLiteral("17")));
+    QVERIFY(!model.setData(model.index(1, 0), QStringLiteral("seventeen")));
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(model.data(model.index(0, 0)), QVariant(42));
+    QCOMPARE(model.data(model.index(1, 0), Qt::EditRole), QVariant(17));
+    QCOMPARE(model.data(model.index(1, 0)).metaType(), QMetaType::fromType<int>());
+
+    QVERIFY(model.setData(model.index(0, 1), 3.5));
+    QCOMPARE(model.data(model.index(0, 1)), QVariant(QStringLiteral("3.5")));
+
+    // Columns without a type keep what they are given
+    QVERIFY(model.setData(model.index(0, 2), QDate(2022, 2, 22)));
+    QCOMPARE(model.data(model.index(0, 2)), QVariant(QDate(2022, 2, 22)));
+
+    QVERIFY(model.setData(model.index(0, 0), QVariant()));
+    QVERIFY(!model.data(model.index(0, 0)).isValid());
+    QVERIFY(!model.setData(QModelIndex(), 1));
+}
+
+void tst_QColumnarTableModel::otherRoles()
+{
+    QColumnarTableModel model(2, 2);
+    const QModelIndex index = model.index(1, 1);
+    QVERIFY(model.setData(index, QStringLiteral("text")));
+    QVERIFY(model.setData(index, QStringLiteral("tip"), Qt::ToolTipRole));
+    QVERIFY(model.setData(index, Qt::AlignRight, Qt::TextAlignmentRole));
+    QCOMPARE(model.data(index, Qt::ToolTipRole), QVariant(QStringLiteral("tip")));
+    QVERIFY(!model.data(model.index(0, 1), Qt::ToolTipRole).isValid());
+
+    const QMap<int, QVariant> roles = model.itemData(index);
+    QCOMPARE(roles.size(), 4);
+    QCOMPARE(roles.value(Qt::EditRole), QVariant(QStringLiteral("text")));
+
+    QVERIFY(model.setData(index, QVariant(), Qt::ToolTipRole));
+    QVERIFY(!model.data(index, Qt::ToolTipRole).isValid());
+    QVERIFY(model.clearItemData(index));
+    QVERIFY(model.itemData(index).isEmpty());
+}
+
+void tst_QColumnarTableModel::multiData()
+{
+    QColumnarTableModel model(1, 1);
+    const QModelIndex index = model.index(0, 0);
+    model.setData(index, 7);
+    model.setData(index, QStringLiteral("seven"), Qt::ToolTipRole);
+
+    QModelRoleData roleData[] = {
+        QModelRoleData(Qt::DisplayRole),
+        QModelRoleData(Qt::ToolTipRole),
+        QModelRoleData(Qt::DecorationRole)
+    };
+    model.multiData(index, roleData);
+    QCOMPARE(roleData[0].data(), QVariant(7));
+    QCOMPARE(roleData[1].data(), QVariant(QStringLiteral("seven")));
+    QVERIFY(!roleData[2].data().isValid());
+
+    model.multiData(QModelIndex(), roleData);
+    QVERIFY(!roleData[0].data().isValid());
+}
+
+void tst_QColumnarTableModel::insertRemoveRows()
+{
+    QColumnarTableModel model(4, 1);
+    QAbstractItemModelTester tester(&model);
+    model.setColumnType(0, QMetaType::fromType<int>());
+    for (int row = 0; row < 4; ++row) {
+        model.setData(model.index(row, 0), row);
+        model.setData(model.index(row, 0), row * 10, Qt::UserRole);
+    }
+
+    QVERIFY(model.insertRows(1, 2));
+    QCOMPARE(model.rowCount(), 6);
+    QCOMPARE(model.data(model.index(0, 0)), QVariant(0));
+    QVERIFY(!model.data(model.index(1, 0)).isValid());
+    QVERIFY(!model.data(model.index(2, 0), Qt::UserRole).isValid());
+    QCOMPARE(model.data(model.index(3, 0)), QVariant(1));
+    QCOMPARE(model.data(model.index(3, 0), Qt::UserRole), QVariant(10));
+    QCOMPARE(model.data(model.index(5, 0), Qt::UserRole), QVariant(30));
+
+    QVERIFY(model.removeRows(0, 4));
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.data(model.index(0, 0)), QVariant(2));
+    QCOMPARE(model.data(model.index(1, 0), Qt::UserRole), QVariant(30));
+
+    QVERIFY(!model.insertRows(3, 1));
+    QVERIFY(!model.removeRows(1, 2));
+    QVERIFY(!model.insertRows(0, 1, model.index(0, 0)));
+}
+
+void tst_QColumnarTableModel::insertRemoveColumns()
+{
+    QColumnarTableModel model(2, 2);
+    QAbstractItemModelTester tester(&model);
+    model.setColumnType(1, QMetaType::fromType<double>());
+    model.setData(model.index(0, 1), 1.5);
+
+    QVERIFY(model.insertColumns(0, 2));
+    QCOMPARE(model.columnCount(), 4);
+    QVERIFY(!model.columnType(0).isValid());
+    QCOMPARE(model.columnType(3), QMetaType::fromType<double>());
+    QCOMPARE(model.data(model.index(0, 3)), QVariant(1.5));
+
+    QVERIFY(model.removeColumns(1, 2));
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.data(model.index(0, 1)), QVariant(1.5));
+    QVERIFY(!model.removeColumns(1, 2));
+}
+
+void tst_QColumnarTableModel::setColumnType()
+{
+    QColumnarTableModel model(3, 1);
+    model.setData(model.index(0, 0), QStringLiteral("12"));
+    model.setData(model.index(1, 0), QStringLiteral("twelve"));
+
+    QSignalSpy spy(&model, &QAbstractItemModel::dataChanged);
+    QVERIFY(model.setColumnType(0, QMetaType::fromType<qlonglong>()));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(model.data(model.index(0, 0)), QVariant(12LL));
+    QVERIFY(!model.data(model.index(1, 0)).isValid());
+    QVERIFY(!model.data(model.index(2, 0)).isValid());
+
+    QVERIFY(model.setColumnType(0, QMetaType()));
+    QCOMPARE(model.data(model.index(0, 0)), QVariant(12LL));
+}
+
+void tst_QColumnarTableModel::headers()
+{
+    QColumnarTableModel model(3, 2);
+    QSignalSpy spy(&model, &QAbstractItemModel::headerDataChanged);
+    QCOMPARE(model.headerData(1, Qt::Horizontal), QVariant(2));
+
+    QVERIFY(model.setHeaderData(1, Qt::Horizontal, QStringLiteral("Value")));
+    QVERIFY(model.setHeaderData(2, Qt::Vertical, QStringLiteral("Last")));
+    QVERIFY(!model.setHeaderData(2, Qt::Horizontal, QStringLiteral("None")));
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(model.headerData(1, Qt::Horizontal), QVariant(QStringLiteral("Value")));
+    QCOMPARE(model.headerData(1, Qt::Horizontal, Qt::EditRole), QVariant(QStringLiteral("Value")));
+
+    model.insertRows(0, 1);
+    QCOMPARE(model.headerData(3, Qt::Vertical), QVariant(QStringLiteral("Last")));
+    QCOMPARE(model.headerData(2, Qt::Vertical), QVariant(3));
+}
+
+QTEST_APPLESS_MAIN(tst_QColumnarTableModel)
+#include "tst_qcolumnartablemodel.moc"
@@ -84,6 +84,7 @@ private slots:
     void layoutChangedWithAllSelected2();
     void layoutChangedTreeSelection();
     void deselectRemovedMiddleRange();
+    void manyDisjointRanges();
     void setModel();
 
     void bindableModel();
@@ -2442,6 +2443,49 @@ void tst_QItemSelectionModel::setModel()
     QVERIFY(sel.selection().isEmpty());
 }
 
+void tst_QItemSelectionModel::manyDisjointRanges()
+{
+    QStandardItemModel model(300, 3);
+    QItemSelectionModel selectionModel(&model);
+
+    // Every third row, selected one range at a time and then all at once:
+    QItemSelection selection;
+    for (int row = 0; row < 300; row += 3) {
+        const QItemSelection rowSelection(model.index(row, 0), model.index(row, 2));
+        if (row < 150)
+            selectionModel.select(rowSelection, QItemSelectionModel::Select);
+        else
+            selection.merge(rowSelection, QItemSelectionModel::Select);
+    }
+    selectionModel.select(selection, QItemSelectionModel::Select);
+    QCOMPARE(selectionModel.selection().size(), 100);
+
+    const auto checkSelected = [&](int selectedRemainder) {
+        for (int row = 0; row < model.rowCount(); ++row) {
+            for (int column = 0; column < model.columnCount(); ++column) {
+                QCOMPARE(selectionModel.isSelected(model.index(row, column)),
+                         row % 3 == selectedRemainder);
+            }
+        }
+    };
+    checkSelected(0);
+
+    // The rows of the ranges move with the model:
+    model.insertRow(0);
+    checkSelected(1);
+    model.removeRows(0, 2);
+    checkSelected(2);
+
+    // Toggling overlapping ranges splits only the ranges they intersect:
+    selectionModel.select(QItemSelection(model.index(2, 0), model.index(4, 2)),
+                          QItemSelectionModel::Toggle);
+    QVERIFY(!selectionModel.isSelected(model.index(2, 1)));
+    QVERIFY(selectionModel.isSelected(model.index(3, 1)));
+    QVERIFY(selectionModel.isSelected(model.index(4, 1)));
+    QVERIFY(selectionModel.isSelected(model.index(5, 1)));
+    QVERIFY(!selectionModel.isSelected(model.index(6, 1)));
+}
+
 void tst_QItemSelectionModel::bindableModel()
 {
     QItemSelectionModel sel;
@@ -5327,6 +5327,51 @@ void tst_QSortFilterProxyModel::invalidateColumnsOrRowsFilter()
     QCOMPARE(proxy.rowFiltered, 20);
 }
 
+void tst_QSortFilterProxyModel::parallelFiltering()
+{
+    QStringList strings;
+    for (int i = 0; i < 10000; ++i)
+        strings << QString::number((i * 7919) % 10000);
+    QStringListModel model(strings);
+
+    QSortFilterProxyModel serial;
+    serial.setSourceModel(&model);
+    serial.setFilterRegularExpression("3");
+    serial.sort(0);
+
+    QSortFilterProxyModel parallel;
+    parallel.setParallelFilteringEnabled(true);
+    parallel.setSourceModel(&model);
+    parallel.setFilterRegularExpression("3");
+    parallel.sort(0);
+    QAbstractItemModelTester tester(&parallel);
+
+    const auto compareProxies = [&] {
+        QCOMPARE(parallel.rowCount(), serial.rowCount());
+        for (int row = 0; row < serial.rowCount(); ++row) {
+            QCOMPARE(parallel.mapToSource(parallel.index(row, 0)),
+                     serial.mapToSource(serial.index(row, 0)));
+        }
+    };
+    compareProxies();
+    QVERIFY(parallel.rowCount() > 0);
+    QVERIFY(parallel.rowCount() < model.rowCount());
+
+    // Changing the filter both removes and inserts rows:
+    QSignalSpy removedSpy(&parallel, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy insertedSpy(&parallel, &QAbstractItemModel::rowsInserted);
+    serial.setFilterRegularExpression("^1");
+    parallel.setFilterRegularExpression("^1");
+    compareProxies();
+    QVERIFY(!removedSpy.isEmpty());
+    QVERIFY(!insertedSpy.isEmpty());
+
+    serial.setFilterRegularExpression(QString());
+    parallel.setFilterRegularExpression(QString());
+    compareProxies();
+    QCOMPARE(parallel.rowCount(), model.rowCount());
+}
+
 void tst_QSortFilterProxyModel::filterKeyColumnBinding()
 {
     QSortFilterProxyModel proxyModel;
@@ -5391,6 +5436,14 @@ void tst_QSortFilterProxyModel::autoAcceptChildRowsBinding()
                                                                            "autoAcceptChildRows");
 }
 
+void tst_QSortFilterProxyModel::parallelFilteringEnabledBinding()
+{
+    QSortFilterProxyModel proxyModel;
+    QCOMPARE(proxyModel.isParallelFilteringEnabled(), false);
+    QTestPrivate::testReadWritePropertyBasics<QSortFilterProxyModel, bool>(
+            proxyModel, true, false, "parallelFilteringEnabled");
+}
+
 void tst_QSortFilterProxyModel::filterCaseSensitivityBinding()
 {
     QSortFilterProxyModel proxyModel;
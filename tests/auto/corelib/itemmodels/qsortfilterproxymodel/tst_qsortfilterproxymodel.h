@@ -166,6 +166,7 @@ private slots:
 
     void checkFilteredIndexes();
     void invalidateColumnsOrRowsFilter();
+    void parallelFiltering();
 
     void filterKeyColumnBinding();
     void dynamicSortFilterBinding();
@@ -175,6 +176,7 @@ private slots:
     void filterRoleBinding();
     void recursiveFilteringEnabledBinding();
     void autoAcceptChildRowsBinding();
+    void parallelFilteringEnabledBinding();
     void filterCaseSensitivityBinding();
     void filterRegularExpressionBinding();
 
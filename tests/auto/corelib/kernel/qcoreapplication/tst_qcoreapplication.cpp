@@ -1033,6 +1033,71 @@ void tst_QCoreApplication::testTrWithPercantegeAtTheEnd()
     QCoreApplication::translate("testcontext", "this will crash%", "testdisamb", 3);
 }
 
+class ValueEvent : public QEvent
+{
+public:
+    static QEvent::Type eventType()
+    {
+        static const int type = QEvent::registerEventType();
+        return QEvent::Type(type);
+    }
+
+    explicit ValueEvent(int value) : QEvent(eventType()), value(value) { }
+
+    int value;
+};
+
+class ValueEventReceiver : public QObject
+{
+public:
+    QList<int> values;
+
+    bool event(QEvent *event) override
+    {
+        if (event->type() != ValueEvent::eventType())
+            return QObject::event(event);
+        values.append(static_cast<ValueEvent *>(event)->value);
+        return true;
+    }
+};
+
+void tst_QCoreApplication::compressibleEventTypes()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    QCoreApplication::registerCompressibleEventType(ValueEvent::eventType(),
+                                                    [](QEvent *pending, QEvent *posted) {
+        static_cast<ValueEvent *>(pending)->value += static_cast<ValueEvent *>(posted)->value;
+    });
+
+    const int receiverCount = 100;
+    ValueEventReceiver receivers[receiverCount];
+    for (int round = 1; round <= 10; ++round) {
+        for (ValueEventReceiver &receiver : receivers)
+            QCoreApplication::postEvent(&receiver, new ValueEvent(round));
+    }
+    QCoreApplication::sendPostedEvents();
+    for (const ValueEventReceiver &receiver : receivers)
+        QCOMPARE(receiver.values, QList<int>{ 55 });
+
+    // delivered events are no longer candidates for compression
+    QCoreApplication::postEvent(&receivers[0], new ValueEvent(1));
+    QCoreApplication::sendPostedEvents();
+    QCoreApplication::postEvent(&receivers[0], new ValueEvent(2));
+    QCoreApplication::postEvent(&receivers[0], new ValueEvent(3));
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receivers[0].values, (QList<int>{ 55, 1, 5 }));
+
+    // neither are removed ones
+    QCoreApplication::postEvent(&receivers[1], new ValueEvent(1));
+    QCoreApplication::removePostedEvents(&receivers[1], ValueEvent::eventType());
+    QCoreApplication::postEvent(&receivers[1], new ValueEvent(2));
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receivers[1].values, (QList<int>{ 55, 2 }));
+}
+
 #if QT_CONFIG(library)
 void tst_QCoreApplication::addRemoveLibPaths()
 {
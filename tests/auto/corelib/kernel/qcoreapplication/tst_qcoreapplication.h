@@ -64,6 +64,7 @@ private slots:
     void threadedEventDelivery_data();
     void threadedEventDelivery();
     void testTrWithPercantegeAtTheEnd();
+    void compressibleEventTypes();
 #if QT_CONFIG(library)
     void addRemoveLibPaths();
 #endif
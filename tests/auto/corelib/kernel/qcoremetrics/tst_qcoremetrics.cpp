@@ -0,0 +1,231 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QCoreApplication>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <QtCore/private/qcoremetrics_p.h>
+
+class tst_QCoreMetrics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void histogramBuckets();
+    void registeredMetrics();
+    void prometheusText();
+    void disabled();
+    void postedEvents();
+#ifdef Q_OS_UNIX
+    void timerLateness();
+#endif
+    void threadPool();
+};
+
+void tst_QCoreMetrics::init()
+{
+    QCoreMetrics::reset();
+    QCoreMetrics::setEnabled(true);
+}
+
+void tst_QCoreMetrics::cleanup()
+{
+    QCoreMetrics::setEnabled(false);
+}
+
+void tst_QCoreMetrics::histogramBuckets()
+{
+    QMetricHistogram histogram("test_values", "Values", QMetricHistogram::Count);
+    for (qint64 value : { -1, 0, 1, 2, 3, 4, 5, 1024 })
+        histogram.record(value);
+    histogram.record(std::numeric_limits<qint64>::max());
+
+    QCOMPARE(histogram.upperBound(0), 1);
+    QCOMPARE(histogram.upperBound(3), 8);
+    QCOMPARE(histogram.bucketCount(0), 3u);     // -1 (clamped), 0, 1
+    QCOMPARE(histogram.bucketCount(1), 1u);     // 2
+    QCOMPARE(histogram.bucketCount(2), 2u);     // 3, 4
+    QCOMPARE(histogram.bucketCount(3), 1u);     // 5
+    QCOMPARE(histogram.bucketCount(10), 1u);    // 1024
+    QCOMPARE(histogram.bucketCount(QMetricHistogram::BucketCount), 1u);
+    QCOMPARE(histogram.count(), 9u);
+
+    histogram.reset();
+    QCOMPARE(histogram.count(), 0u);
+    QCOMPARE(histogram.sum(), 0);
+
+    QMetricHistogram shifted("test_shifted", "Shifted", QMetricHistogram::Nanoseconds, 10);
+    shifted.record(1000);
+    shifted.record(1025);
+    QCOMPARE(shifted.upperBound(0), 1024);
+    QCOMPARE(shifted.bucketCount(0), 1u);
+    QCOMPARE(shifted.bucketCount(1), 1u);
+    QCOMPARE(shifted.sum(), 2025);
+}
+
+static const QMetricSample *findSample(const QList<QMetricSample> &samples, const char *name)
+{
+    for (const QMetricSample &sample : samples) {
+        if (sample.name == name)
+            return &sample;
+    }
+    return nullptr;
+}
+
+void tst_QCoreMetrics::registeredMetrics()
+{
+    QMetricCounter counter("test_requests_total", "Requests");
+    QMetricHistogram histogram("test_latency_seconds", "Latency",
+                               QMetricHistogram::Nanoseconds, 10);
+    QCoreMetrics::registerMetric(&counter);
+    QCoreMetrics::registerMetric(&histogram);
+    counter.add(3);
+    histogram.record(2000);
+
+    QList<QMetricSample> samples = QCoreMetrics::snapshot();
+    QVERIFY(findSample(samples, "qt_event_notify_seconds"));
+    const QMetricSample *counterSample = findSample(samples, "test_requests_total");
+    QVERIFY(counterSample);
+    QCOMPARE(counterSample->type, QMetricSample::Counter);
+    QCOMPARE(counterSample->count, 3u);
+    const QMetricSample *histogramSample = findSample(samples, "test_latency_seconds");
+    QVERIFY(histogramSample);
+    QCOMPARE(histogramSample->type, QMetricSample::Histogram);
+    QCOMPARE(histogramSample->count, 1u);
+    QCOMPARE(histogramSample->sum, 2e-6);
+    QCOMPARE(histogramSample->buckets.size(), QMetricHistogram::BucketCount);
+    QCOMPARE(histogramSample->buckets.at(0).second, 0u);
+    QCOMPARE(histogramSample->buckets.at(1).first, 2048e-9);
+    QCOMPARE(histogramSample->buckets.at(1).second, 1u);
+    QCOMPARE(histogramSample->buckets.last().second, 1u);
+
+    QCoreMetrics::reset();
+    QCOMPARE(counter.value(), 0u);
+
+    QCoreMetrics::unregisterMetric(&counter);
+    QCoreMetrics::unregisterMetric(&histogram);
+    samples = QCoreMetrics::snapshot();
+    QVERIFY(!findSample(samples, "test_requests_total"));
+    QVERIFY(!findSample(samples, "test_latency_seconds"));
+}
+
+void tst_QCoreMetrics::prometheusText()
+{
+    QMetricSample counter;
+    counter.name = "test_total";
+    counter.help = "A counter";
+    counter.count = 42;
+
+    QMetricSample histogram;
+    histogram.name = "test_seconds";
+    histogram.help = "A histogram";
+    histogram.type = QMetricSample::Histogram;
+    histogram.count = 3;
+    histogram.sum = 0.5;
+    histogram.buckets = { { 0.25, 1 }, { 0.5, 2 } };
+
+    const QByteArray text = QCoreMetrics::toPrometheusText({ counter, histogram });
+    QCOMPARE(text,
+             "# HELP test_total A counter\n"
+             "# TYPE test_total counter\n"
+             "test_total 42\n"
+             "# HELP test_seconds A histogram\n"
+             "# TYPE test_seconds histogram\n"
+             "test_seconds_bucket{le=\"0.25\"} 1\n"
+             "test_seconds_bucket{le=\"0.5\"} 2\n"
+             "test_seconds_bucket{le=\"+Inf\"} 3\n"
+             "test_seconds_sum 0.5\n"
+             "test_seconds_count 3\n");
+}
+
+void tst_QCoreMetrics::disabled()
+{
+    QCoreMetrics::setEnabled(false);
+    QObject receiver;
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(QCoreMetrics::postedEventQueueDepth.count(), 0u);
+    QCOMPARE(QCoreMetrics::eventNotifyTime.count(), 0u);
+}
+
+void tst_QCoreMetrics::postedEvents()
+{
+    QCoreApplication::sendPostedEvents();
+    QCoreMetrics::reset();
+
+    QObject receiver;
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCOMPARE(QCoreMetrics::postedEventQueueDepth.count(), 2u);
+    QCOMPARE(QCoreMetrics::postedEventQueueDepth.bucketCount(0), 1u);
+    QCOMPARE(QCoreMetrics::postedEventQueueDepth.bucketCount(1), 1u);
+    QCOMPARE(QCoreMetrics::postedEventCount(QThread::currentThread()), 2);
+
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(QCoreMetrics::postedEventCount(QThread::currentThread()), 0);
+    QVERIFY(QCoreMetrics::eventNotifyTime.count() >= 2);
+}
+
+#ifdef Q_OS_UNIX
+void tst_QCoreMetrics::timerLateness()
+{
+    bool fired = false;
+    QTimer::singleShot(10, this, [&fired] { fired = true; });
+    QTRY_VERIFY(fired);
+    QVERIFY(QCoreMetrics::timerLateness.count() >= 1);
+    QVERIFY(QCoreMetrics::eventLoopBusyTime.count() >= 1);
+}
+#endif
+
+void tst_QCoreMetrics::threadPool()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    QSemaphore started;
+    QSemaphore release;
+    pool.start([&] {
+        started.release();
+        release.acquire();
+    });
+    started.acquire();
+    pool.start([] {});      // has to wait in the queue
+    QCOMPARE(QCoreMetrics::threadPoolQueueLength.count(), 1u);
+
+    release.release();
+    QVERIFY(pool.waitForDone());
+    QCOMPARE(QCoreMetrics::threadPoolWaitTime.count(), 1u);
+}
+
+QTEST_MAIN(tst_QCoreMetrics)
+#include "tst_qcoremetrics.moc"
@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QtCore/qcoroutine.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+
+class tst_QCoroutine : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+#ifdef QT_HAS_COROUTINES
+    void awaitFinishedFuture();
+    void awaitPendingFuture();
+    void resumeInAwaitingThread();
+    void cancellationPropagates();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptionPropagates();
+#endif
+    void awaitSignal();
+    void awaitSignalSenderDestroyed();
+    void sleep();
+#endif
+};
+
+void tst_QCoroutine::initTestCase()
+{
+#ifndef QT_HAS_COROUTINES
+    QSKIP("This compiler does not support C++20 coroutines");
+#endif
+}
+
+#ifdef QT_HAS_COROUTINES
+
+static QFuture<int> addOne(QFuture<int> future)
+{
+    const int value = co_await future;
+    co_return value + 1;
+}
+
+void tst_QCoroutine::awaitFinishedFuture()
+{
+    QFuture<int> future = addOne(QtFuture::makeReadyFuture(41));
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), 42);
+}
+
+void tst_QCoroutine::awaitPendingFuture()
+{
+    QPromise<int> promise;
+    QFuture<int> future = addOne(promise.future());
+    QVERIFY(!future.isFinished());
+
+    promise.start();
+    promise.addResult(1);
+    promise.finish();
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), 2);
+}
+
+static QFuture<void> recordResumingThread(QFuture<void> future, QThread **thread)
+{
+    co_await future;
+    *thread = QThread::currentThread();
+}
+
+void tst_QCoroutine::resumeInAwaitingThread()
+{
+    QPromise<void> promise;
+    QThread *resumedIn = nullptr;
+    QFuture<void> future = recordResumingThread(promise.future(), &resumedIn);
+
+    std::unique_ptr<QThread> worker(QThread::create([&promise] {
+        promise.start();
+        promise.finish();
+    }));
+    worker->start();
+    QVERIFY(worker->wait());
+
+    QTRY_VERIFY(future.isFinished());
+    QCOMPARE(resumedIn, QThread::currentThread());
+}
+
+static QFuture<int> addOneAndCount(QFuture<int> future, int *resumed)
+{
+    const int value = co_await future;
+    ++*resumed;
+    co_return value + 1;
+}
+
+void tst_QCoroutine::cancellationPropagates()
+{
+    int resumed = 0;
+    QPromise<int> promise;
+    QFuture<int> future = addOneAndCount(promise.future(), &resumed);
+
+    promise.start();
+    promise.future().cancel();
+    promise.finish();
+    QVERIFY(future.isFinished());
+    QVERIFY(future.isCanceled());
+    QCOMPARE(resumed, 0);
+
+    future = addOneAndCount(QFuture<int>(), &resumed);
+    QVERIFY(future.isCanceled());
+    QCOMPARE(resumed, 0);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QCoroutine::exceptionPropagates()
+{
+    QPromise<int> promise;
+    QFuture<int> future = addOne(promise.future());
+
+    promise.start();
+    promise.setException(std::make_exception_ptr(std::runtime_error("failed")));
+    promise.finish();
+    QVERIFY(future.isFinished());
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, future.waitForFinished());
+}
+#endif
+
+static QFuture<QString> nextObjectName(QObject *object)
+{
+    std::optional<QString> name = co_await QtCoroutine::signal(object, &QObject::objectNameChanged);
+    co_return name.value_or(QStringLiteral("destroyed"));
+}
+
+void tst_QCoroutine::awaitSignal()
+{
+    QObject object;
+    QFuture<QString> future = nextObjectName(&object);
+    QVERIFY(!future.isFinished());
+
+    object.setObjectName(QStringLiteral("first"));
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), QStringLiteral("first"));
+
+    // the connection is gone once the coroutine was resumed
+    object.setObjectName(QStringLiteral("second"));
+    QCOMPARE(future.resultCount(), 1);
+}
+
+void tst_QCoroutine::awaitSignalSenderDestroyed()
+{
+    auto object = std::make_unique<QObject>();
+    QFuture<QString> future = nextObjectName(object.get());
+    QVERIFY(!future.isFinished());
+
+    object.reset();
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), QStringLiteral("destroyed"));
+}
+
+static QFuture<void> sleepFor(std::chrono::milliseconds interval)
+{
+    co_await QtCoroutine::sleep(interval);
+}
+
+void tst_QCoroutine::sleep()
+{
+    QFuture<void> future = sleepFor(10ms);
+    QVERIFY(!future.isFinished());
+    QTRY_VERIFY(future.isFinished());
+}
+
+#endif // QT_HAS_COROUTINES
+
+QTEST_MAIN(tst_QCoroutine)
+#include "tst_qcoroutine.moc"
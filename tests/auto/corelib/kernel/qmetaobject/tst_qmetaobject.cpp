@@ -330,6 +330,8 @@ private slots:
 
     void indexOfMethodPMF();
 
+    void nameIndex();
+
     void signalOffset_data();
     void signalOffset();
     void signalCount_data();
@@ -1712,6 +1714,31 @@ void tst_QMetaObject::indexOfMethod()
     QCOMPARE(object->metaObject()->indexOfSignal(name), !isSignal ? -1 : idx);
 }
 
+void tst_QMetaObject::nameIndex()
+{
+    // moc emits a hashed name index for classes with enough members; lookups
+    // through it must find the same members as the linear scan
+    for (const QMetaObject *mo : { &staticMetaObject, &QSortFilterProxyModel::staticMetaObject }) {
+        QVERIFY(QMetaObjectPrivate::get(mo)->flags & HasNameIndex);
+        for (int i = 0; i < mo->methodCount(); ++i) {
+            const QByteArray signature = mo->method(i).methodSignature();
+            const int found = mo->indexOfMethod(signature);
+            // overrides in a subclass shadow the base class method
+            QVERIFY2(found >= i, signature.constData());
+            QCOMPARE(mo->method(found).methodSignature(), signature);
+        }
+        for (int i = 0; i < mo->propertyCount(); ++i) {
+            const char *name = mo->property(i).name();
+            const int found = mo->indexOfProperty(name);
+            QVERIFY2(found >= i, name);
+            QCOMPARE(mo->property(found).name(), name);
+        }
+        QCOMPARE(mo->indexOfMethod("doesNotExist()"), -1);
+        QCOMPARE(mo->indexOfSignal("deleteLater()"), -1);
+        QCOMPARE(mo->indexOfProperty("doesNotExist"), -1);
+    }
+}
+
 class Base : public QObject {
     Q_OBJECT
 public slots:
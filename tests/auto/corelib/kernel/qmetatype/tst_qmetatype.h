@@ -127,6 +127,7 @@ private slots:
     void convertCustomType_data();
     void convertCustomType();
     void convertConstNonConst();
+    void registrationAfterLookup();
     void compareCustomEqualOnlyType();
     void customDebugStream();
     void unknownType();
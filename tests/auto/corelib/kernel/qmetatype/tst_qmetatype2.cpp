@@ -304,6 +304,29 @@ void tst_QMetaType::convertConstNonConst()
     QVERIFY(QMetaType::canConvert(mtObj, mtConstDerived));
 }
 
+struct LateConvertedSource { int value = 0; };
+struct LateConvertedTarget { int value = 0; };
+
+void tst_QMetaType::registrationAfterLookup()
+{
+    // Lookups are cached per thread, registrations must still be seen
+    // immediately after a failed lookup
+    const QMetaType from = QMetaType::fromType<LateConvertedSource>();
+    const QMetaType to = QMetaType::fromType<LateConvertedTarget>();
+    QVERIFY(!QMetaType::canConvert(from, to));
+    QVERIFY(QMetaType::registerConverter<LateConvertedSource, LateConvertedTarget>(
+                [](const LateConvertedSource &source) { return LateConvertedTarget{source.value}; }));
+    QVERIFY(QMetaType::canConvert(from, to));
+    LateConvertedSource source{42};
+    LateConvertedTarget target;
+    QVERIFY(QMetaType::convert(from, &source, to, &target));
+    QCOMPARE(target.value, 42);
+
+    QVERIFY(!QMetaType::fromName("LateConvertedAlias").isValid());
+    qRegisterMetaType<LateConvertedSource>("LateConvertedAlias");
+    QCOMPARE(QMetaType::fromName("LateConvertedAlias"), from);
+}
+
 void tst_QMetaType::compareCustomEqualOnlyType()
 {
     QMetaType type = QMetaType::fromType<CustomEqualsOnlyType>();
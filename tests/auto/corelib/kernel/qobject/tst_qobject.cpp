@@ -61,6 +61,8 @@
 #endif
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include <math.h>
 
@@ -103,6 +105,10 @@ private slots:
     void recursiveSignalEmission();
     void signalBlocking();
     void blockingQueuedConnection();
+    void queuedConnectionManyProducers_data();
+    void queuedConnectionManyProducers();
+    void batchedQueuedConnection();
+    void coalescedQueuedConnection();
     void childEvents();
     void installEventFilter();
     void deleteSelfInSlot();
@@ -158,6 +164,7 @@ private slots:
     void disconnectDoesNotLeakFunctor();
     void contextDoesNotLeakFunctor();
     void connectBase();
+    void emitWhileReceiverIsDestroyed();
     void connectWarnings();
     void qmlConnect();
     void qmlConnectToQObjectReceiver();
@@ -171,6 +178,7 @@ private slots:
     void singleShotConnection();
     void objectNameBinding();
     void emitToDestroyedClass();
+    void coAllocatedPrivate();
 };
 
 struct QObjectCreatedOnShutdown
@@ -3074,6 +3082,103 @@ void tst_QObject::blockingQueuedConnection()
     }
 }
 
+class SequenceSender : public QObject
+{
+    Q_OBJECT
+signals:
+    void next(int producer, int value);
+};
+
+class SequenceReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SequenceReceiver(int producers) : last(producers, -1) { }
+
+    QList<int> last;
+    bool inOrder = true;
+    QAtomicInt received;
+    // when set, the receiver hops between the two threads every moveEvery calls
+    QThread *threads[2] = {};
+    int moveEvery = 0;
+
+public slots:
+    void next(int producer, int value)
+    {
+        inOrder = inOrder && value == last[producer] + 1;
+        last[producer] = value;
+        const int count = received.loadRelaxed() + 1;
+        received.storeRelease(count);
+        if (moveEvery && count % moveEvery == 0)
+            moveToThread(threads[(count / moveEvery) % 2]);
+    }
+};
+
+class SequenceProducerThread : public QThread
+{
+public:
+    SequenceProducerThread(int producer, int count, SequenceReceiver *receiver)
+        : producer(producer), count(count), receiver(receiver) { }
+
+    void run() override
+    {
+        SequenceSender sender;
+        connect(&sender, &SequenceSender::next, receiver, &SequenceReceiver::next,
+                Qt::QueuedConnection);
+        for (int i = 0; i < count; ++i)
+            emit sender.next(producer, i);
+    }
+
+private:
+    int producer;
+    int count;
+    SequenceReceiver *receiver;
+};
+
+void tst_QObject::queuedConnectionManyProducers_data()
+{
+    QTest::addColumn<bool>("moveReceiver");
+    QTest::newRow("receiver in main thread") << false;
+    QTest::newRow("receiver changing threads") << true;
+}
+
+void tst_QObject::queuedConnectionManyProducers()
+{
+    QFETCH(bool, moveReceiver);
+    const int Producers = 8;
+    const int Count = 5000;
+
+    SequenceReceiver receiver(Producers);
+    MoveToThreadThread threads[2];
+    if (moveReceiver) {
+        threads[0].start();
+        threads[1].start();
+        receiver.threads[0] = &threads[0];
+        receiver.threads[1] = &threads[1];
+        receiver.moveEvery = 997;
+        receiver.moveToThread(&threads[0]);
+    }
+
+    std::vector<std::unique_ptr<SequenceProducerThread>> producers;
+    for (int p = 0; p < Producers; ++p)
+        producers.emplace_back(new SequenceProducerThread(p, Count, &receiver));
+    for (auto &producer : producers)
+        producer->start();
+    for (auto &producer : producers)
+        QVERIFY(producer->wait());
+
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.received.loadAcquire(), Producers * Count, 30000);
+    if (moveReceiver) {
+        for (auto &thread : threads) {
+            thread.quit();
+            QVERIFY(thread.wait());
+        }
+    }
+    QVERIFY(receiver.inOrder);
+    for (int p = 0; p < Producers; ++p)
+        QCOMPARE(receiver.last.at(p), Count - 1);
+}
+
 class EventSpy : public QObject
 {
     Q_OBJECT
@@ -3105,6 +3210,87 @@ private:
     EventList events;
 };
 
+void tst_QObject::batchedQueuedConnection()
+{
+    SequenceSender sender;
+    SequenceReceiver receiver(2);
+    EventSpy spy;
+    receiver.installEventFilter(&spy);
+    QVERIFY(connect(&sender, &SequenceSender::next, &receiver, &SequenceReceiver::next,
+                    Qt::BatchedQueuedConnection));
+
+    for (int i = 0; i < 100; ++i)
+        emit sender.next(0, i);
+    QCOMPARE(receiver.received.loadRelaxed(), 0);
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(spy.eventList(), EventSpy::EventList() << qMakePair(static_cast<QObject *>(&receiver), QEvent::MetaCall));
+    QCOMPARE(receiver.received.loadRelaxed(), 100);
+    QVERIFY(receiver.inOrder);
+    QCOMPARE(receiver.last.at(0), 99);
+
+    // once delivered, the next emission posts a new event
+    spy.clear();
+    emit sender.next(1, 0);
+    emit sender.next(1, 1);
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(spy.eventList().size(), 1);
+    QCOMPARE(receiver.received.loadRelaxed(), 102);
+    QVERIFY(receiver.inOrder);
+    QCOMPARE(receiver.last.at(1), 1);
+
+    // string-based connections batch the same way
+    QVERIFY(sender.disconnect(&receiver));
+    SequenceReceiver other(1);
+    QVERIFY(connect(&sender, SIGNAL(next(int,int)), &other, SLOT(next(int,int)),
+                    Qt::BatchedQueuedConnection));
+    for (int i = 0; i < 10; ++i)
+        emit sender.next(0, i);
+    QCoreApplication::sendPostedEvents(&other, QEvent::MetaCall);
+    QCOMPARE(other.received.loadRelaxed(), 10);
+    QVERIFY(other.inOrder);
+
+    // a batch still pending when the receiver goes away is discarded
+    {
+        SequenceReceiver shortLived(1);
+        connect(&sender, &SequenceSender::next, &shortLived, &SequenceReceiver::next,
+                Qt::BatchedQueuedConnection);
+        emit sender.next(0, 0);
+    }
+    emit sender.next(0, 0);
+    QCoreApplication::sendPostedEvents();
+}
+
+void tst_QObject::coalescedQueuedConnection()
+{
+    SequenceSender sender;
+    QObject context;
+    QList<QPair<int, int>> calls;
+    connect(&sender, &SequenceSender::next, &context, [&calls](int producer, int value) {
+        calls.append(qMakePair(producer, value));
+    }, Qt::CoalescedQueuedConnection);
+
+    for (int i = 0; i < 10; ++i)
+        emit sender.next(0, i);
+    QVERIFY(calls.isEmpty());
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+    QCOMPARE(calls, (QList<QPair<int, int>>() << qMakePair(0, 9)));
+
+    emit sender.next(1, 1);
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+    QCOMPARE(calls, (QList<QPair<int, int>>() << qMakePair(0, 9) << qMakePair(1, 1)));
+
+    // single-shot connections are not coalesced
+    calls.clear();
+    QVERIFY(sender.disconnect(&context));
+    connect(&sender, &SequenceSender::next, &context, [&calls](int producer, int value) {
+        calls.append(qMakePair(producer, value));
+    }, Qt::ConnectionType(Qt::CoalescedQueuedConnection | Qt::SingleShotConnection));
+    emit sender.next(2, 1);
+    emit sender.next(2, 2);
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+    QCOMPARE(calls, (QList<QPair<int, int>>() << qMakePair(2, 1)));
+}
+
 void tst_QObject::childEvents()
 {
     EventSpy::EventList expected;
@@ -6730,6 +6916,45 @@ void tst_QObject::connectBase()
     QCOMPARE( r1.count_slot3, 1 );
 }
 
+class DestroyingBase : public QObject
+{
+    Q_OBJECT
+public:
+    ~DestroyingBase() { sender->emitSignal1(); }
+    SenderObject *sender = nullptr;
+public slots:
+    // a method of its own, so that the subclass's methods start further on
+    void baseSlot() {}
+};
+
+class DestroyingReceiver : public DestroyingBase
+{
+    Q_OBJECT
+public:
+    int *calls = nullptr;
+public slots:
+    void slot() { ++*calls; }
+};
+
+void tst_QObject::emitWhileReceiverIsDestroyed()
+{
+    SenderObject sender;
+    int calls = 0;
+    auto receiver = new DestroyingReceiver;
+    receiver->sender = &sender;
+    receiver->calls = &calls;
+
+    // only connections by signature check that the receiver is complete
+    QVERIFY(connect(&sender, SIGNAL(signal1()), receiver, SLOT(slot())));
+    sender.emitSignal1();
+    sender.emitSignal1();
+    QCOMPARE(calls, 2);
+
+    // ~DestroyingBase() emits after the DestroyingReceiver part is gone
+    delete receiver;
+    QCOMPARE(calls, 2);
+}
+
 void tst_QObject::connectWarnings()
 {
     SubSender sub;
@@ -8207,6 +8432,61 @@ void tst_QObject::emitToDestroyedClass()
     QCOMPARE(wouldHaveAssertedCount, 1);
 }
 
+#ifdef QT_BUILD_INTERNAL
+class CoAllocatedObject final : public QObject
+{
+    Q_OBJECT
+    Q_OBJECT_CO_ALLOCATED
+public:
+    explicit CoAllocatedObject(QObjectPrivate &dd, QObject *parent = nullptr)
+        : QObject(dd, parent)
+    {
+    }
+
+signals:
+    void ping(int value);
+};
+
+#endif
+
+void tst_QObject::coAllocatedPrivate()
+{
+#ifdef QT_BUILD_INTERNAL
+    QObject parent;
+    auto *object = QObjectPrivate::createCoAllocated<CoAllocatedObject>(&parent);
+    QVERIFY(QObjectPrivate::get(object)->isCoAllocated);
+    QCOMPARE(object->parent(), &parent);
+    QCOMPARE(static_cast<void *>(QObjectPrivate::get(object)),
+             static_cast<void *>(reinterpret_cast<char *>(object)
+                                 + ((sizeof(CoAllocatedObject) + alignof(QObjectPrivate) - 1)
+                                    & ~(alignof(QObjectPrivate) - 1))));
+
+    int received = 0;
+    connect(object, &CoAllocatedObject::ping, this, [&](int value) { received = value; });
+    emit object->ping(42);
+    QCOMPARE(received, 42);
+
+    object->setObjectName(QStringLiteral("co-allocated"));
+    object->setProperty("dynamic", 1);
+    QCOMPARE(object->property("dynamic").toInt(), 1);
+
+    // deleting the object directly destroys the private in place
+    QPointer<QObject> guard(object);
+    bool destroyed = false;
+    connect(object, &QObject::destroyed, this, [&] { destroyed = true; });
+    delete object;
+    QVERIFY(destroyed);
+    QVERIFY(guard.isNull());
+    QVERIFY(parent.children().isEmpty());
+
+    // ... and so does deleting the parent
+    QObjectPrivate::createCoAllocated<CoAllocatedObject>(&parent)->setObjectName(QStringLiteral("child"));
+    QCOMPARE(parent.children().size(), 1);
+#else
+    QSKIP("Needs QT_BUILD_INTERNAL");
+#endif
+}
+
 // Test for QtPrivate::HasQ_OBJECT_Macro
 static_assert(QtPrivate::HasQ_OBJECT_Macro<tst_QObject>::Value);
 static_assert(!QtPrivate::HasQ_OBJECT_Macro<SiblingDeleter>::Value);
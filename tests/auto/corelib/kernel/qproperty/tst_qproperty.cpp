@@ -108,6 +108,7 @@ private slots:
     void noDoubleNotification();
     void groupedNotifications();
     void groupedNotificationConsistency();
+    void diamondEvaluatesOnce();
     void uninstalledBindingDoesNotEvaluate();
 
     void notify();
@@ -1842,6 +1843,57 @@ void tst_QProperty::groupedNotificationConsistency()
     QVERIFY(areEqual); // value changed runs after everything has been evaluated
 }
 
+void tst_QProperty::diamondEvaluatesOnce()
+{
+    QProperty<int> a(1);
+    QProperty<int> b([&]() { return a.value() + 1; });
+    QProperty<int> c([&]() { return a.value() * 2; });
+    int dEvaluations = 0;
+    QProperty<int> d([&]() { ++dEvaluations; return b.value() + c.value(); });
+    QProperty<int> e([&]() { return d.value() + c.value(); });
+    QCOMPARE(d.value(), 4);
+    QCOMPARE(e.value(), 6);
+
+    int eNotifications = 0;
+    auto handler = e.onValueChanged([&]() { ++eNotifications; });
+
+    auto *dBinding = QPropertyBindingPrivate::get(d.binding());
+    auto *eBinding = QPropertyBindingPrivate::get(e.binding());
+    dEvaluations = 0;
+    const auto eEvaluations = eBinding->evaluationCount;
+
+    a = 2;
+    QCOMPARE(d.value(), 7);
+    QCOMPARE(e.value(), 11);
+    QCOMPARE(dEvaluations, 1);
+    QCOMPARE(dBinding->evaluationCount, quint64(2));
+    QCOMPARE(eBinding->evaluationCount, eEvaluations + 1);
+    QCOMPARE(eNotifications, 1);
+
+    // bindings whose dependencies did not change are not evaluated
+    QProperty<int> parity([&]() { return a.value() % 2; });
+    int dependentEvaluations = 0;
+    QProperty<int> dependent([&]() { ++dependentEvaluations; return parity.value(); });
+    dependentEvaluations = 0;
+    a = 4;
+    QCOMPARE(dependent.value(), 0);
+    QCOMPARE(dependentEvaluations, 0);
+
+    // several changed properties in a group share one evaluation
+    QProperty<int> f(0);
+    int sumEvaluations = 0;
+    QProperty<int> sum([&]() { ++sumEvaluations; return d.value() + f.value(); });
+    sumEvaluations = 0;
+    dEvaluations = 0;
+    Qt::beginPropertyUpdateGroup();
+    a = 5;
+    f = 1;
+    Qt::endPropertyUpdateGroup();
+    QCOMPARE(dEvaluations, 1);
+    QCOMPARE(sumEvaluations, 1);
+    QCOMPARE(sum.value(), 6 + 10 + 1);
+}
+
 void tst_QProperty::uninstalledBindingDoesNotEvaluate()
 {
     QProperty<int> i;
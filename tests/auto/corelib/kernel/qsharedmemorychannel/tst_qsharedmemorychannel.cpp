@@ -0,0 +1,289 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QSharedMemory>
+#include <QSharedMemoryChannel>
+#include <QSignalSpy>
+#include <QTest>
+#include <QThread>
+
+#include <atomic>
+
+class tst_QSharedMemoryChannel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void createAndAttach();
+    void attachWithoutChannel();
+    void writeAndRead();
+    void wrapAround();
+    void full();
+    void messageTooLarge();
+    void readyRead();
+    void waitForReadyRead();
+    void multipleProducers();
+
+private:
+    QString key;
+};
+
+void tst_QSharedMemoryChannel::init()
+{
+    static int counter = 0;
+    key = QStringLiteral("tst_qsharedmemorychannel_%1_%2")
+            .arg(QCoreApplication::applicationPid()).arg(++counter);
+}
+
+void tst_QSharedMemoryChannel::createAndAttach()
+{
+    QSharedMemoryChannel consumer(key);
+    QVERIFY2(consumer.create(10000), qPrintable(consumer.errorString()));
+    QVERIFY(consumer.isAttached());
+    QVERIFY(consumer.isConsumer());
+    QCOMPARE(consumer.capacity(), qsizetype(16384));
+    QCOMPARE(consumer.maximumMessageSize(), qsizetype(8192 - 8));
+
+    QSharedMemoryChannel second(key);
+    QVERIFY(!second.create(4096));
+    QCOMPARE(second.error(), QSharedMemoryChannel::AlreadyExists);
+
+    QSharedMemoryChannel producer(key);
+    QVERIFY2(producer.attach(), qPrintable(producer.errorString()));
+    QVERIFY(producer.isAttached());
+    QVERIFY(!producer.isConsumer());
+    QCOMPARE(producer.capacity(), consumer.capacity());
+
+    producer.detach();
+    QVERIFY(!producer.isAttached());
+    QCOMPARE(producer.capacity(), qsizetype(0));
+}
+
+void tst_QSharedMemoryChannel::attachWithoutChannel()
+{
+    QSharedMemoryChannel producer(key);
+    QVERIFY(!producer.attach());
+    QCOMPARE(producer.error(), QSharedMemoryChannel::NotFound);
+    QVERIFY(!producer.write("lost"));
+
+    // a plain shared memory segment is not a channel
+    QSharedMemory memory(key);
+    QVERIFY(memory.create(8192));
+    QVERIFY(!producer.attach());
+    QCOMPARE(producer.error(), QSharedMemoryChannel::IncompatibleChannel);
+}
+
+void tst_QSharedMemoryChannel::writeAndRead()
+{
+    QSharedMemoryChannel consumer(key);
+    QVERIFY(consumer.create(4096));
+    QSharedMemoryChannel producer(key);
+    QVERIFY(producer.attach());
+
+    QVERIFY(!consumer.hasPendingMessages());
+    QVERIFY(consumer.read().isNull());
+
+    QVERIFY(producer.write("hello"));
+    QVERIFY(producer.write(QByteArrayView()));
+    QVERIFY(producer.write(QByteArray(100, 'x')));
+
+    // producers can't read
+    QVERIFY(!producer.hasPendingMessages());
+    QVERIFY(producer.read().isNull());
+
+    QVERIFY(consumer.hasPendingMessages());
+    QCOMPARE(consumer.read(), QByteArray("hello"));
+    const QByteArray empty = consumer.read();
+    QVERIFY(!empty.isNull());
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(consumer.read(), QByteArray(100, 'x'));
+    QVERIFY(!consumer.hasPendingMessages());
+    QVERIFY(consumer.read().isNull());
+}
+
+void tst_QSharedMemoryChannel::wrapAround()
+{
+    QSharedMemoryChannel consumer(key);
+    QVERIFY(consumer.create(8192));
+    QSharedMemoryChannel producer(key);
+    QVERIFY(producer.attach());
+
+    // sizes that don't divide the capacity, so records straddle the end
+    // of the ring and need padding
+    QList<QByteArray> expected;
+    for (int i = 0; i < 1000; ++i) {
+        const QByteArray message(1 + (i * 37) % 1500, char('a' + i % 26));
+        QVERIFY2(producer.write(message), qPrintable(producer.errorString()));
+        expected.append(message);
+        if (i % 2 == 0)
+            continue;
+        while (consumer.hasPendingMessages())
+            QCOMPARE(consumer.read(), expected.takeFirst());
+        QVERIFY(expected.isEmpty());
+    }
+}
+
+void tst_QSharedMemoryChannel::full()
+{
+    QSharedMemoryChannel consumer(key);
+    QVERIFY(consumer.create(4096));
+    QSharedMemoryChannel producer(key);
+    QVERIFY(producer.attach());
+
+    const QByteArray message(1000, 'f');
+    int written = 0;
+    while (producer.write(message))
+        ++written;
+    QCOMPARE(producer.error(), QSharedMemoryChannel::ChannelFull);
+    QCOMPARE(written, 4);
+
+    QCOMPARE(consumer.read(), message);
+    QVERIFY(producer.write(message));
+    for (int i = 0; i < written; ++i)
+        QCOMPARE(consumer.read(), message);
+    QVERIFY(!consumer.hasPendingMessages());
+}
+
+void tst_QSharedMemoryChannel::messageTooLarge()
+{
+    QSharedMemoryChannel consumer(key);
+    QVERIFY(consumer.create(4096));
+    QSharedMemoryChannel producer(key);
+    QVERIFY(producer.attach());
+
+    QVERIFY(!producer.write(QByteArray(producer.maximumMessageSize() + 1, 'l')));
+    QCOMPARE(producer.error(), QSharedMemoryChannel::InvalidSize);
+    QVERIFY(producer.write(QByteArray(producer.maximumMessageSize(), 'l')));
+    QCOMPARE(consumer.read().size(), consumer.maximumMessageSize());
+}
+
+void tst_QSharedMemoryChannel::readyRead()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("readyRead() is only emitted on Unix");
+#else
+    QSharedMemoryChannel consumer(key);
+    QVERIFY(consumer.create(4096));
+    QSignalSpy spy(&consumer, &QSharedMemoryChannel::readyRead);
+    QSharedMemoryChannel producer(key);
+    QVERIFY(producer.attach());
+
+    QVERIFY(producer.write("one"));
+    QVERIFY(producer.write("two"));
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(consumer.read(), QByteArray("one"));
+    QCOMPARE(consumer.read(), QByteArray("two"));
+
+    QVERIFY(producer.write("three"));
+    QTRY_COMPARE(spy.count(), 2);
+    QCOMPARE(consumer.read(), QByteArray("three"));
+#endif
+}
+
+void tst_QSharedMemoryChannel::waitForReadyRead()
+{
+    QSharedMemoryChannel consumer(key);
+    QVERIFY(consumer.create(4096));
+
+    QVERIFY(!consumer.waitForReadyRead(10));
+
+    QScopedPointer<QThread> thread(QThread::create([this] {
+        QSharedMemoryChannel producer(key);
+        if (!producer.attach())
+            return;
+        QThread::msleep(50);
+        producer.write("wake up");
+    }));
+    thread->start();
+    QVERIFY(consumer.waitForReadyRead(10000));
+    QCOMPARE(consumer.read(), QByteArray("wake up"));
+    QVERIFY(thread->wait());
+}
+
+void tst_QSharedMemoryChannel::multipleProducers()
+{
+    QSharedMemoryChannel consumer(key);
+    QVERIFY(consumer.create(1 << 16));
+
+    constexpr int Producers = 4;
+    constexpr int MessagesPerProducer = 10000;
+    std::atomic<int> failures = 0;
+    QList<QThread *> threads;
+    for (int p = 0; p < Producers; ++p) {
+        threads.append(QThread::create([&, p] {
+            QSharedMemoryChannel producer(key);
+            if (!producer.attach()) {
+                ++failures;
+                return;
+            }
+            for (int i = 0; i < MessagesPerProducer; ++i) {
+                const int message[2] = { p, i };
+                const QByteArrayView view(reinterpret_cast<const char *>(message), sizeof(message));
+                while (!producer.write(view)) {
+                    if (producer.error() != QSharedMemoryChannel::ChannelFull) {
+                        ++failures;
+                        return;
+                    }
+                    QThread::yieldCurrentThread();
+                }
+            }
+        }));
+        threads.last()->start();
+    }
+
+    // messages of each producer arrive complete and in order
+    int next[Producers] = {};
+    int received = 0;
+    while (received < Producers * MessagesPerProducer && !failures) {
+        if (!consumer.waitForReadyRead(10000))
+            break;
+        while (consumer.hasPendingMessages()) {
+            const QByteArray message = consumer.read();
+            QCOMPARE(message.size(), qsizetype(2 * sizeof(int)));
+            int content[2];
+            memcpy(content, message.constData(), sizeof(content));
+            QVERIFY(content[0] >= 0 && content[0] < Producers);
+            QCOMPARE(content[1], next[content[0]]);
+            ++next[content[0]];
+            ++received;
+        }
+    }
+
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+    QCOMPARE(failures.load(), 0);
+    QCOMPARE(received, Producers * MessagesPerProducer);
+}
+
+QTEST_MAIN(tst_QSharedMemoryChannel)
+#include "tst_qsharedmemorychannel.moc"
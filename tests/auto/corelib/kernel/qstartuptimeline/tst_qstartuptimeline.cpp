@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QCoreApplication>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+#include <QTimer>
+
+#include <QtCore/private/qstartuptimeline_p.h>
+
+static QString timelineFileName()
+{
+    return QDir::temp().filePath(QStringLiteral("tst_qstartuptimeline-%1.json")
+                                 .arg(QCoreApplication::applicationPid()));
+}
+
+class tst_QStartupTimeline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cleanupTestCase();
+
+    void recording();
+    void finishedByExec();
+};
+
+void tst_QStartupTimeline::cleanupTestCase()
+{
+    QFile::remove(timelineFileName());
+}
+
+void tst_QStartupTimeline::recording()
+{
+    QVERIFY(QStartupTimeline::isRecording());
+    QStandardPaths::locate(QStandardPaths::GenericDataLocation,
+                           QStringLiteral("tst_qstartuptimeline.missing"));
+}
+
+void tst_QStartupTimeline::finishedByExec()
+{
+    QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+    QCoreApplication::exec();
+    QVERIFY(!QStartupTimeline::isRecording());
+
+    QFile file(timelineFileName());
+    QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(file.errorString()));
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QHash<QString, QJsonObject> events;
+    const QJsonArray traceEvents = document.object().value(QLatin1String("traceEvents")).toArray();
+    for (const QJsonValue &event : traceEvents)
+        events.insert(event.toObject().value(QLatin1String("name")).toString(), event.toObject());
+
+    const QJsonObject init = events.value(QStringLiteral("QCoreApplicationPrivate::init"));
+    QCOMPARE(init.value(QLatin1String("ph")).toString(), QLatin1String("X"));
+    QVERIFY(init.value(QLatin1String("dur")).toDouble() >= 0);
+    QCOMPARE(init.value(QLatin1String("pid")).toInteger(), QCoreApplication::applicationPid());
+
+    const QJsonObject locate = events.value(QStringLiteral("QStandardPaths::locate"));
+    QCOMPARE(locate.value(QLatin1String("ph")).toString(), QLatin1String("X"));
+    QCOMPARE(locate.value(QLatin1String("args")).toObject().value(QLatin1String("detail")).toString(),
+             QLatin1String("tst_qstartuptimeline.missing"));
+
+    const QJsonObject exec = events.value(QStringLiteral("QCoreApplication::exec"));
+    QCOMPARE(exec.value(QLatin1String("ph")).toString(), QLatin1String("i"));
+    QVERIFY(exec.value(QLatin1String("ts")).toDouble() >= init.value(QLatin1String("ts")).toDouble());
+}
+
+int main(int argc, char *argv[])
+{
+    // recording starts when the application object is created
+    qputenv("QT_STARTUP_TIMELINE", QFile::encodeName(timelineFileName()));
+    QCoreApplication app(argc, argv);
+    tst_QStartupTimeline tc;
+    QTEST_SET_MAIN_SOURCE_PATH
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "tst_qstartuptimeline.moc"
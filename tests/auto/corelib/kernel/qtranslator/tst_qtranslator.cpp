@@ -56,6 +56,7 @@ private slots:
     void threadLoad();
     void testLanguageChange();
     void plural();
+    void cachedTranslation();
     void translate_qm_file_generated_with_msgfmt();
     void loadDirectory();
     void dependencies();
@@ -304,6 +305,40 @@ void tst_QTranslator::plural()
     QCOMPARE(QCoreApplication::translate("QPushButton", "Hello %n world(s)!", 0, 2), QLatin1String("Hallo 2 Welten!"));
 }
 
+class UpperCaseTranslator : public QTranslator
+{
+public:
+    QString translate(const char *, const char *sourceText, const char *, int) const override
+    {
+        return QString::fromUtf8(sourceText).toUpper();
+    }
+};
+
+void tst_QTranslator::cachedTranslation()
+{
+    QTranslator tor;
+    QVERIFY(tor.load("hellotr_la"));
+    QCoreApplication::installTranslator(&tor);
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hallo Welt!"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hallo Welt!"));
+
+    // loading another file into an installed translator invalidates the results
+    QVERIFY(tor.load("hellotr_empty"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hello world!"));
+    QVERIFY(tor.load("hellotr_la"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hallo Welt!"));
+
+    // translations of subclasses take precedence and are not cached
+    UpperCaseTranslator upper;
+    QCoreApplication::installTranslator(&upper);
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("HELLO WORLD!"));
+    QCoreApplication::removeTranslator(&upper);
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hallo Welt!"));
+
+    QCoreApplication::removeTranslator(&tor);
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"), QLatin1String("Hello world!"));
+}
+
 void tst_QTranslator::translate_qm_file_generated_with_msgfmt()
 {
     QTranslator translator;
@@ -532,6 +532,40 @@ void tst_QMimeDatabase::mimeTypeForFileWithContent()
     QVERIFY(mime.isDefault());
 }
 
+void tst_QMimeDatabase::mimeTypesForFiles()
+{
+    QMimeDatabase db;
+
+    QTemporaryFile pdfFile;
+    QVERIFY(pdfFile.open());
+    pdfFile.write("%PDF-");
+    pdfFile.close();
+
+    QTemporaryFile txtFile(QDir::tempPath() + QLatin1String("/tst_QMimeDatabase_XXXXXX.txt"));
+    QVERIFY(txtFile.open());
+    txtFile.write("<smil");
+    txtFile.close();
+
+    const QStringList fileNames = { pdfFile.fileName(), txtFile.fileName(),
+                                    QStringLiteral("doesnotexist.png"), QDir::tempPath() };
+    for (QMimeDatabase::MatchMode mode : { QMimeDatabase::MatchDefault,
+                                           QMimeDatabase::MatchExtension,
+                                           QMimeDatabase::MatchContent }) {
+        const QList<QMimeType> mimes = db.mimeTypesForFiles(fileNames, mode);
+        QCOMPARE(mimes.size(), fileNames.size());
+        for (qsizetype i = 0; i < fileNames.size(); ++i)
+            QCOMPARE(mimes.at(i), db.mimeTypeForFile(fileNames.at(i), mode));
+    }
+
+    const QList<QMimeType> mimes = db.mimeTypesForFiles(fileNames);
+    QCOMPARE(mimes.at(0).name(), QString::fromLatin1("application/pdf"));
+    QCOMPARE(mimes.at(1).name(), QString::fromLatin1("text/plain"));
+    QCOMPARE(mimes.at(2).name(), QString::fromLatin1("image/png"));
+    QCOMPARE(mimes.at(3).name(), QString::fromLatin1("inode/directory"));
+
+    QVERIFY(db.mimeTypesForFiles(QStringList()).isEmpty());
+}
+
 void tst_QMimeDatabase::mimeTypeForUrl()
 {
     QMimeDatabase db;
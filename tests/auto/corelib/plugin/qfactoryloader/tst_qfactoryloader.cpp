@@ -27,9 +27,13 @@
 ****************************************************************************/
 
 #include <QtTest/qtest.h>
+#include <QtCore/qcbormap.h>
+#include <QtCore/qcborvalue.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qtemporarydir.h>
 #include <private/qfactoryloader_p.h>
 #include "plugin1/plugininterface1.h"
 #include "plugin2/plugininterface2.h"
@@ -54,6 +58,7 @@ public slots:
 private slots:
     void usingTwoFactoriesFromSameDir();
     void extraSearchPath();
+    void metaDataCache();
 };
 
 static const char binFolderC[] = "bin";
@@ -123,5 +128,51 @@ void tst_QFactoryLoader::extraSearchPath()
 #endif
 }
 
+void tst_QFactoryLoader::metaDataCache()
+{
+#if !QT_CONFIG(library) || defined(QT_NO_TEMPORARYFILE)
+    QSKIP("Test not applicable in this configuration.");
+#else
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    qputenv("QT_PLUGIN_METADATA_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+    auto restoreEnv = qScopeGuard([] { qunsetenv("QT_PLUGIN_METADATA_CACHE_DIR"); });
+
+    QCoreApplication::setLibraryPaths(QStringList());
+    const QString absoluteBinPath = QFileInfo(binFolder).absoluteFilePath();
+
+    QFactoryLoader loader1(PluginInterface1_iid, "/nonexistent");
+    loader1.setExtraSearchPath(absoluteBinPath);
+    const QFactoryLoader::MetaDataList scanned = loader1.metaData();
+    QCOMPARE(scanned.size(), 1);
+
+    // the scan must have left exactly one cache file, for the bin directory
+    const QStringList cacheFiles = QDir(cacheDir.path()).entryList(QDir::Files);
+    QCOMPARE(cacheFiles.size(), 1);
+    QFile file(cacheDir.filePath(cacheFiles.first()));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QCborMap root = QCborValue::fromCbor(file.readAll()).toMap();
+    QCOMPARE(root.value(QLatin1String("qt")).toInteger(), QT_VERSION);
+    const QCborMap entries = root.value(QLatin1String("entries")).toMap();
+    QVERIFY(!entries.isEmpty());
+
+    bool found = false;
+    for (auto it : entries)
+        found = found || it.second.toArray().at(2).toMap() == scanned.first().toCbor();
+    QVERIFY(found);
+    file.close();
+
+    // a warm scan must produce the same result
+    QFactoryLoader loader2(PluginInterface1_iid, "/nonexistent");
+    loader2.setExtraSearchPath(absoluteBinPath);
+    const QFactoryLoader::MetaDataList cached = loader2.metaData();
+    QCOMPARE(cached.size(), 1);
+    QCOMPARE(cached.first().toCbor(), scanned.first().toCbor());
+    PluginInterface1 *plugin1 = qobject_cast<PluginInterface1 *>(loader2.instance(0));
+    QVERIFY(plugin1);
+    QCOMPARE(plugin1->pluginName(), QLatin1String("Plugin1 ok"));
+#endif
+}
+
 QTEST_MAIN(tst_QFactoryLoader)
 #include "tst_qfactoryloader.moc"
@@ -33,6 +33,8 @@
 #endif
 
 #include <qcoreapplication.h>
+#include <qdatetime.h>
+#include <qset.h>
 #include <quuid.h>
 
 class tst_QUuid : public QObject
@@ -59,6 +61,8 @@ private slots:
 
     // Only in Qt > 3.2.x
     void generate();
+    void generateBulk();
+    void generateV7();
     void less();
     void more();
     void variants();
@@ -328,6 +332,44 @@ void tst_QUuid::generate()
     QVERIFY( shouldnt_be_null_uuidA != shouldnt_be_null_uuidB );
 }
 
+void tst_QUuid::generateBulk()
+{
+    QUuid uuids[100];
+    QUuid::createUuids(uuids, 100);
+    QSet<QUuid> unique;
+    for (const QUuid &uuid : uuids) {
+        QCOMPARE(uuid.variant(), QUuid::DCE);
+        QCOMPARE(uuid.version(), QUuid::Random);
+        unique.insert(uuid);
+    }
+    QCOMPARE(unique.size(), 100);
+
+    QUuid::createUuids(nullptr, 0);
+}
+
+void tst_QUuid::generateV7()
+{
+    const qint64 before = QDateTime::currentMSecsSinceEpoch();
+    QUuid previous = QUuid::createUuidV7();
+    for (int i = 0; i < 10000; ++i) {
+        const QUuid uuid = QUuid::createUuidV7();
+        QCOMPARE(uuid.variant(), QUuid::DCE);
+        QCOMPARE(uuid.version(), QUuid::UnixEpoch);
+        // strictly increasing, also in the textual representation
+        QVERIFY(previous < uuid);
+        QVERIFY(previous.toString() < uuid.toString());
+        previous = uuid;
+    }
+    const qint64 after = QDateTime::currentMSecsSinceEpoch();
+
+    const qint64 msecs = (qint64(previous.data1) << 16) | previous.data2;
+    QVERIFY(msecs >= before);
+    // the counter overflows at most once per 2048 UUIDs, borrowing a millisecond
+    QVERIFY(msecs <= after + 5);
+
+    QCOMPARE(QUuid("{017f22e2-79b0-7cc3-98c4-dc0c0c07398f}").version(), QUuid::UnixEpoch);
+    QCOMPARE(QUuid("{017f22e2-79b0-6cc3-98c4-dc0c0c07398f}").version(), QUuid::VerUnknown);
+}
 
 void tst_QUuid::less()
 {
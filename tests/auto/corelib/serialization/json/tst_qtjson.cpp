@@ -35,8 +35,12 @@ QT_WARNING_DISABLE_DEPRECATED
 #include "qjsonobject.h"
 #include "qjsonvalue.h"
 #include "qjsondocument.h"
+#include "qcbormap.h"
 #include "qregularexpression.h"
+#include "qbuffer.h"
 #include "private/qnumeric_p.h"
+#include "private/qjsonlazydocument_p.h"
+#include "private/qcborvalue_p.h"
 #include <limits>
 
 #define INVALID_UNICODE "\xCE\xBA\xE1"
@@ -98,6 +102,7 @@ private Q_SLOTS:
     void toVariant();
     void fromVariantMap();
     void fromVariantHash();
+    void unsortedObjectConstruction();
     void toVariantMap();
     void toVariantHash();
     void toVariantList();
@@ -105,6 +110,9 @@ private Q_SLOTS:
     void toJson();
     void toJsonSillyNumericValues();
     void toJsonLargeNumericValues();
+    void toJsonDevice_data();
+    void toJsonDevice();
+    void toJsonEscapedRuns();
     void fromJson();
     void fromJsonErrors();
     void parseNumbers();
@@ -179,6 +187,16 @@ private Q_SLOTS:
     void noLeakOnNameClash_data();
     void noLeakOnNameClash();
 
+    void parseLongStrings_data();
+    void parseLongStrings();
+    void lazyDocument();
+    void lazyDocumentArray();
+    void lazyDocumentErrors_data();
+    void lazyDocumentErrors();
+    void arenaDecoder();
+    void arenaDecoderErrors_data() { lazyDocumentErrors_data(); }
+    void arenaDecoderErrors();
+
 private:
     QString testDataDir;
 };
@@ -1568,6 +1586,47 @@ void tst_QtJson::fromVariantHash()
     QCOMPARE(object.value(QLatin1String("key2")), QJsonValue(QLatin1String("value2")));
 }
 
+void tst_QtJson::unsortedObjectConstruction()
+{
+    // later keys override earlier ones and undefined values remove them,
+    // just like consecutive calls to insert()
+    const QJsonObject object{
+        { "b", 1 }, { "a", 2 }, { "c", 3 }, { "b", 4 }, { "c", QJsonValue::Undefined },
+        { "d", QJsonValue::Undefined },
+    };
+    QCOMPARE(object.keys(), QStringList({ "a", "b" }));
+    QCOMPARE(object.value("a"), QJsonValue(2));
+    QCOMPARE(object.value("b"), QJsonValue(4));
+
+    const QJsonObject undefinedOnly{ { "a", QJsonValue::Undefined } };
+    QVERIFY(undefinedOnly.isEmpty());
+    QCOMPARE(undefinedOnly, QJsonObject());
+
+    // a CBOR map in reverse order, in which every key appears twice after
+    // conversion to string
+    QCborMap map;
+    for (int i = 1999; i >= 0; --i)
+        map.insert(i, i * 2);
+    for (int i = 1999; i >= 0; --i)
+        map.insert(QString::number(i), i * 2 + 1);
+    QCOMPARE(map.size(), 4000);
+    const QJsonObject converted = map.toJsonObject();
+    QCOMPARE(converted.size(), 2000);
+    const QStringList convertedKeys = converted.keys();
+    QVERIFY(std::is_sorted(convertedKeys.cbegin(), convertedKeys.cend()));
+    for (int i = 0; i < 2000; ++i)
+        QCOMPARE(converted.value(QString::number(i)), QJsonValue(i * 2 + 1));
+
+    QVariantHash hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(QString::number(i), i);
+    const QJsonObject fromHash = QJsonObject::fromVariantHash(hash);
+    QCOMPARE(fromHash.size(), 1000);
+    QStringList keys = hash.keys();
+    keys.sort();
+    QCOMPARE(fromHash.keys(), keys);
+}
+
 void tst_QtJson::toVariantMap()
 {
     QCOMPARE(QMetaType::Type(QJsonValue(QJsonObject()).toVariant().type()), QMetaType::QVariantMap); // QTBUG-32524
@@ -1766,6 +1825,69 @@ void tst_QtJson::toJsonSillyNumericValues()
     QCOMPARE(json, expected);
 }
 
+void tst_QtJson::toJsonDevice_data()
+{
+    QTest::addColumn<QJsonDocument>("doc");
+
+    // large enough to be written in several blocks
+    QJsonArray records;
+    for (int i = 0; i < 5000; ++i) {
+        QJsonObject record;
+        record.insert("id", i);
+        record.insert("name", QString("record \"%1\"\n\u00e9\u4e2d").arg(i));
+        record.insert("values", QJsonArray{ i, i * 0.5, true, QJsonValue() });
+        records.append(record);
+    }
+
+    QTest::newRow("null") << QJsonDocument();
+    QTest::newRow("empty-object") << QJsonDocument(QJsonObject());
+    QTest::newRow("empty-array") << QJsonDocument(QJsonArray());
+    QTest::newRow("large-array") << QJsonDocument(records);
+    QTest::newRow("large-object") << QJsonDocument(QJsonObject{ { "records", records } });
+}
+
+void tst_QtJson::toJsonDevice()
+{
+    QFETCH(QJsonDocument, doc);
+
+    for (auto format : { QJsonDocument::Indented, QJsonDocument::Compact }) {
+        QByteArray output;
+        QBuffer buffer(&output);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QVERIFY(doc.toJson(&buffer, format));
+        QCOMPARE(output, doc.toJson(format));
+    }
+
+    if (!doc.isNull() && !doc.isEmpty()) {
+        QBuffer readOnly;
+        QVERIFY(readOnly.open(QIODevice::ReadOnly));
+        QTest::ignoreMessage(QtWarningMsg, QRegularExpression("QIODevice::write.*ReadOnly device"));
+        QVERIFY(!doc.toJson(&readOnly));
+    }
+}
+
+void tst_QtJson::toJsonEscapedRuns()
+{
+    // characters needing escapes or UTF-8 encoding at every position of
+    // a run of plain characters
+    const QString specials[] = {
+        QStringLiteral("\""), QStringLiteral("\\"), QStringLiteral("\n"),
+        QStringLiteral("\x01"), QStringLiteral("\x7f"), QStringLiteral("\u00e9"),
+        QStringLiteral("\u4e2d"), QStringLiteral("\U0001f600"),
+    };
+    for (const QString &special : specials) {
+        for (int pos = 0; pos < 40; ++pos) {
+            QString str(40, u'x');
+            str.insert(pos, special);
+            const QJsonArray array{ str };
+            const QByteArray json = QJsonDocument(array).toJson(QJsonDocument::Compact);
+            const QJsonDocument parsed = QJsonDocument::fromJson(json);
+            QVERIFY2(parsed.isArray(), json.constData());
+            QCOMPARE(parsed.array().at(0).toString(), str);
+        }
+    }
+}
+
 void tst_QtJson::toJsonLargeNumericValues()
 {
     QJsonObject object;
@@ -3693,5 +3815,183 @@ void tst_QtJson::noLeakOnNameClash()
     // In particular it should not forget to deref the container for the inner objects.
 }
 
+void tst_QtJson::parseLongStrings_data()
+{
+    QTest::addColumn<QString>("string");
+
+    // long enough to go through the vectorized scanning, with the special
+    // characters at every position relative to the vector width
+    const QString ascii = QStringLiteral("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    QTest::newRow("ascii") << ascii;
+    for (int i = 0; i < 40; ++i) {
+        QTest::addRow("escape-at-%d", i) << QString(ascii).insert(i, u'"');
+        QTest::addRow("utf8-at-%d", i) << QString(ascii).insert(i, u'\u00e9');
+        QTest::addRow("utf8-and-escape-at-%d", i)
+                << QString(ascii).insert(i, u'\\').insert(i / 2, u'\u20ac');
+    }
+}
+
+void tst_QtJson::parseLongStrings()
+{
+    QFETCH(QString, string);
+
+    const QJsonObject object{ { string, string }, { "n", 1 } };
+    for (auto format : { QJsonDocument::Compact, QJsonDocument::Indented }) {
+        QByteArray json = QJsonDocument(object).toJson(format);
+        if (format == QJsonDocument::Indented)
+            json.replace("    ", "\t    \r\n     ");
+
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.object(), object);
+    }
+}
+
+void tst_QtJson::lazyDocument()
+{
+    const QByteArray json = R"({
+        "id": 42,
+        "name": "telemetry",
+        "nested": { "a": [1, 2, {"b": "]}"}], "c": "\\\"" },
+        "esc\u00e9": true,
+        "list": [ 1.5, null, false ],
+        "id": 43
+    })";
+
+    QJsonParseError error;
+    QJsonPrivate::LazyDocument doc(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(doc.isObject());
+    QVERIFY(!doc.isArray());
+    QCOMPARE(doc.size(), 6);
+    QCOMPARE(doc.keyAt(0), u"id");
+    QCOMPARE(doc.keyAt(3), u"esc\u00e9");
+
+    // the last of duplicate keys wins, as in QJsonObject
+    QCOMPARE(doc.value(u"id"), QJsonValue(43));
+    QCOMPARE(doc.valueAt(0), QJsonValue(42));
+    QCOMPARE(doc.value(u"name"), QJsonValue("telemetry"));
+    QCOMPARE(doc.value(u"esc\u00e9"), QJsonValue(true));
+    QVERIFY(doc.contains(u"list"));
+    QVERIFY(!doc.contains(u"missing"));
+    QCOMPARE(doc.value(u"missing"), QJsonValue(QJsonValue::Undefined));
+
+    const QJsonDocument full = QJsonDocument::fromJson(json);
+    QCOMPARE(doc.value(u"nested"), full.object().value("nested"));
+    QCOMPARE(doc.value(u"list"), full.object().value("list"));
+    QCOMPARE(doc.toDocument(), full);
+
+    // values are cached after the first access
+    QCOMPARE(doc.value(u"nested").toObject().value("c"), QJsonValue("\\\""));
+}
+
+void tst_QtJson::lazyDocumentArray()
+{
+    QJsonPrivate::LazyDocument doc("\xef\xbb\xbf [ \"x\", {\"y\": []}, -1e3 ] ");
+    QVERIFY(doc.isArray());
+    QCOMPARE(doc.size(), 3);
+    QVERIFY(doc.keyAt(0).isNull());
+    QCOMPARE(doc.value(u"x"), QJsonValue(QJsonValue::Undefined));
+    QCOMPARE(doc.valueAt(0), QJsonValue("x"));
+    QCOMPARE(doc.valueAt(1), QJsonValue(QJsonObject{ { "y", QJsonArray() } }));
+    QCOMPARE(doc.valueAt(2), QJsonValue(-1000));
+
+    QJsonPrivate::LazyDocument empty("{}");
+    QVERIFY(empty.isObject());
+    QCOMPARE(empty.size(), 0);
+
+    QVERIFY(QJsonPrivate::LazyDocument().isNull());
+}
+
+void tst_QtJson::lazyDocumentErrors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    QTest::newRow("empty") << QByteArray() << QJsonParseError::IllegalValue;
+    QTest::newRow("scalar") << QByteArray("42") << QJsonParseError::IllegalValue;
+    QTest::newRow("unterminated-object") << QByteArray("{\"a\": 1") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("unterminated-array") << QByteArray("[1, 2") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("unterminated-string") << QByteArray("{\"a") << QJsonParseError::UnterminatedString;
+    QTest::newRow("unterminated-nested") << QByteArray("{\"a\": [1, {]") << QJsonParseError::IllegalValue;
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" 1}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]") << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("trailing-comma") << QByteArray("[1, ]") << QJsonParseError::MissingObject;
+    QTest::newRow("garbage-at-end") << QByteArray("{} x") << QJsonParseError::GarbageAtEnd;
+}
+
+void tst_QtJson::lazyDocumentErrors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    QJsonParseError parseError;
+    QJsonPrivate::LazyDocument doc(json, &parseError);
+    QCOMPARE(parseError.error, error);
+    QVERIFY(doc.isNull());
+    QCOMPARE(doc.size(), 0);
+
+    // errors inside members are only found when they are decoded
+    QJsonPrivate::LazyDocument lazy(R"({"good": 1, "bad": [1, tru]})", &parseError);
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+    QCOMPARE(lazy.value(u"good", &parseError), QJsonValue(1));
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+    QCOMPARE(lazy.value(u"bad", &parseError), QJsonValue(QJsonValue::Undefined));
+    QCOMPARE(parseError.error, QJsonParseError::IllegalValue);
+    QVERIFY(parseError.offset > 20);
+}
+
+void tst_QtJson::arenaDecoder()
+{
+    QCborArenaDecoder decoder;
+    QList<QJsonDocument> documents;
+    for (const char *name : { "test.json", "test2.json", "test3.json", "bom.json" }) {
+        QFile file(testDataDir + u'/' + QLatin1String(name));
+        QVERIFY2(file.open(QIODevice::ReadOnly), name);
+        const QByteArray json = file.readAll();
+
+        QJsonParseError error;
+        const QJsonDocument expected = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        const QJsonDocument doc = decoder.fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc, expected);
+        QCOMPARE(doc.toJson(), expected.toJson());
+        documents.append(doc);
+    }
+
+    // the documents outlive each other and the buffers they were built in
+    const QJsonDocument first = QJsonDocument::fromJson(documents.first().toJson());
+    documents.removeLast();
+    QVERIFY(documents.first() == first);
+
+    // modifying moves the data out of the arena
+    QJsonDocument doc = decoder.fromJson(R"({"a": [1, "two", {"b": null}], "c": "d"})");
+    QJsonObject object = doc.object();
+    QJsonArray array = object.value("a").toArray();
+    array.append(QStringLiteral("three"));
+    object.insert("a", array);
+    object.insert("e", QJsonObject{ { "f", true } });
+    object.remove("c");
+    doc.setObject(object);
+    QCOMPARE(doc.toJson(QJsonDocument::Compact),
+             R"({"a":[1,"two",{"b":null},"three"],"e":{"f":true}})");
+    QVERIFY(!decoder.fromJson("[]").array().size());
+}
+
+void tst_QtJson::arenaDecoderErrors()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError expected;
+    QJsonDocument::fromJson(json, &expected);
+    QJsonParseError error;
+    QCborArenaDecoder decoder;
+    QVERIFY(decoder.fromJson(json, &error).isNull());
+    QCOMPARE(error.error, expected.error);
+    QCOMPARE(error.offset, expected.offset);
+}
+
 QTEST_MAIN(tst_QtJson)
 #include "tst_qtjson.moc"
@@ -58,6 +58,8 @@ private Q_SLOTS:
     void fixed();
     void strings_data();
     void strings();
+    void stringViews_data() { strings_data(); }
+    void stringViews();
     void tags_data();
     void tags() { fixed(); }
     void emptyContainers_data();
@@ -727,6 +729,57 @@ void tst_QCborStreamReader::strings()
         QCOMPARE(chunks, 1);
 }
 
+void tst_QCborStreamReader::stringViews()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QString, expected);
+    QFETCH_GLOBAL(bool, useDevice);
+
+    QBuffer buffer(&data), controlBuffer(&data);
+    QCborStreamReader reader(data), controlReader(data);
+    if (useDevice) {
+        buffer.open(QIODevice::ReadOnly);
+        controlBuffer.open(QIODevice::ReadOnly);
+        reader.setDevice(&buffer);
+        controlReader.setDevice(&controlBuffer);
+    }
+    QVERIFY(reader.isString() || reader.isByteArray());
+    const bool isString = reader.isString();
+
+    forever {
+        QCborStreamReader::StringResult<QByteArray> controlData;
+        if (isString) {
+            auto r = controlReader.readString();
+            controlData.data = r.data.toUtf8();
+            controlData.status = r.status;
+        } else {
+            controlData = controlReader.readByteArray();
+        }
+        QVERIFY(controlData.status != QCborStreamReader::Error);
+
+        QCborStreamReader::StringResult<QByteArrayView> r;
+        if (isString) {
+            auto sr = reader.readUtf8StringView();
+            r.data = QByteArrayView(sr.data.data(), sr.data.size());
+            r.status = sr.status;
+        } else {
+            r = reader.readByteArrayView();
+        }
+        QCOMPARE(r.status, controlData.status);
+        QCOMPARE(r.data.toByteArray(), controlData.data);
+        if (!useDevice && r.data.size()) {
+            // the view must point into the original data
+            QVERIFY(r.data.data() >= data.constData());
+            QVERIFY(r.data.data() + r.data.size() <= data.constData() + data.size());
+        }
+
+        if (r.status == QCborStreamReader::EndOfString)
+            break;
+    }
+    QCOMPARE(reader.lastError(), QCborError::NoError);
+    QCOMPARE(reader.currentOffset(), controlReader.currentOffset());
+}
+
 void tst_QCborStreamReader::tags_data()
 {
     addColumns();
@@ -45,6 +45,7 @@
 #include <QtEndian>
 
 #include <QtCore/private/qbytearray_p.h>
+#include <QtCore/private/qcborvalue_p.h>
 
 Q_DECLARE_METATYPE(QCborKnownTags)
 Q_DECLARE_METATYPE(QCborValue)
@@ -112,6 +113,9 @@ private slots:
     void fromCborStreamReaderByteArray();
     void fromCborStreamReaderIODevice_data() { fromCbor_data(); }
     void fromCborStreamReaderIODevice();
+    void fromCborArenaDecoder_data() { fromCbor_data(); }
+    void fromCborArenaDecoder();
+    void arenaDecoderModify();
     void validation_data();
     void validation();
     void extendedTypeValidation_data();
@@ -2079,6 +2083,65 @@ void tst_QCborValue::fromCborStreamReaderIODevice()
     fromCbor_common(doCheck);
 }
 
+void tst_QCborValue::fromCborArenaDecoder()
+{
+    // shared between rows, so the decoder reuses its buffers
+    static QCborArenaDecoder decoder;
+    auto doCheck = [](const QCborValue &expected, const QByteArray &data) {
+        QCborParserError error;
+        QCborValue decoded = decoder.fromCbor(data, &error);
+        QVERIFY2(error.error == QCborError(), qPrintable(error.errorString()));
+        QCOMPARE(error.offset, data.size());
+        QVERIFY(decoded == expected);
+        QVERIFY(expected == decoded);
+
+        // the value must not depend on the decoder's state
+        QCborValue other = decoder.fromCbor(data);
+        QVERIFY(other == decoded);
+        other = QCborValue();
+        QVERIFY(decoded == expected);
+    };
+
+    fromCbor_common(doCheck);
+}
+
+void tst_QCborValue::arenaDecoderModify()
+{
+    QCborMap expected{{"a", QCborArray{1, "two", QCborMap{{3, 4.5}}}}, {"b", "text"}};
+    const QByteArray data = expected.toCborValue().toCbor();
+
+    QCborValue decoded;
+    QCborValue copy;
+    {
+        QCborArenaDecoder decoder;
+        decoded = decoder.fromCbor(data);
+        copy = decoded;
+    }
+    QCOMPARE(decoded, QCborValue(expected));
+
+    // modifications move the data out of the arena, leaving the copy alone
+    QCborMap map = decoded.toMap();
+    QCborArray array = map.value("a").toArray();
+    array.append(QByteArray("bytes"));
+    map.insert(QLatin1String("a"), array);
+    map.remove(QLatin1String("b"));
+    decoded = QCborValue();
+    QCOMPARE(copy, QCborValue(expected));
+
+    expected.remove(QLatin1String("b"));
+    array = expected.value("a").toArray();
+    array.append(QByteArray("bytes"));
+    expected.insert(QLatin1String("a"), array);
+    QCOMPARE(map, expected);
+
+    // a nested container keeps the arena alive after the root is gone
+    const QCborArray nested = copy.toMap().value("a").toArray();
+    copy = QCborValue();
+    QCOMPARE(nested.size(), 3);
+    QCOMPARE(nested.at(1).toString(), QStringLiteral("two"));
+    QCOMPARE(nested.at(2).toMap().value(3).toDouble(), 4.5);
+}
+
 #include "../cborlargedatavalidation.cpp"
 
 void tst_QCborValue::validation_data()
@@ -201,6 +201,8 @@ private slots:
     void status_QHash_QMap();
 
     void status_QList_QVector();
+    void bulkLists_data();
+    void bulkLists();
 
     void streamToAndFromQByteArray();
 
@@ -3211,6 +3213,82 @@ void tst_QDataStream::status_QList_QVector()
     }
 }
 
+template <typename T>
+static void checkBulkList(QDataStream::ByteOrder byteOrder,
+                          QDataStream::FloatingPointPrecision precision)
+{
+    // large enough to need several blocks when byte-swapping
+    QList<T> list;
+    for (int i = 0; i < 10000; ++i)
+        list.append(T(i * 37 - 5000));
+
+    QByteArray bulk;
+    {
+        QDataStream stream(&bulk, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(precision);
+        stream << list;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+
+    QByteArray elementwise;
+    {
+        QDataStream stream(&elementwise, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(precision);
+        stream << quint32(list.size());
+        for (T t : qAsConst(list))
+            stream << t;
+    }
+    QCOMPARE(bulk, elementwise);
+
+    {
+        QDataStream stream(bulk);
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(precision);
+        QList<T> result;
+        stream >> result;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QCOMPARE(result, list);
+        QVERIFY(stream.atEnd());
+    }
+
+    {
+        QDataStream stream(bulk.chopped(1));
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(precision);
+        QList<T> result{ T(1) };
+        stream >> result;
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QVERIFY(result.isEmpty());
+    }
+}
+
+void tst_QDataStream::bulkLists_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+
+    QTest::newRow("big-endian, double") << QDataStream::BigEndian << QDataStream::DoublePrecision;
+    QTest::newRow("big-endian, single") << QDataStream::BigEndian << QDataStream::SinglePrecision;
+    QTest::newRow("little-endian, double") << QDataStream::LittleEndian << QDataStream::DoublePrecision;
+    QTest::newRow("little-endian, single") << QDataStream::LittleEndian << QDataStream::SinglePrecision;
+}
+
+void tst_QDataStream::bulkLists()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+
+    checkBulkList<qint8>(byteOrder, precision);
+    checkBulkList<quint16>(byteOrder, precision);
+    checkBulkList<qint32>(byteOrder, precision);
+    checkBulkList<qint64>(byteOrder, precision);
+    checkBulkList<char16_t>(byteOrder, precision);
+    checkBulkList<float>(byteOrder, precision);
+    checkBulkList<double>(byteOrder, precision);
+}
+
 void tst_QDataStream::streamToAndFromQByteArray()
 {
     QByteArray data;
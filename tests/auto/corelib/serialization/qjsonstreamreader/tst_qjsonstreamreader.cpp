@@ -0,0 +1,320 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <QtCore/private/qjsonstreamreader_p.h>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readDocument_data();
+    void readDocument();
+    void readFromDevice();
+    void keys();
+    void skipping();
+    void errors_data();
+    void errors();
+    void truncatedDevice();
+};
+
+// Feeds the reader with data in steps of the given size whenever it reports
+// that it needs more; a negative step adds everything at once.
+struct Feeder
+{
+    QJsonStreamReader &reader;
+    QByteArray data;
+    qsizetype step;
+    qsizetype fed = 0;
+
+    void fill()
+    {
+        while (reader.isIncomplete() && fed < data.size()) {
+            const qsizetype len = step < 0 ? data.size() : step;
+            reader.addData(data.mid(fed, len));
+            fed += len;
+            reader.reparse();
+        }
+    }
+};
+
+static QJsonValue readValue(QJsonStreamReader &reader, Feeder &feeder)
+{
+    feeder.fill();
+    switch (reader.type()) {
+    case QJsonStreamReader::Null:
+        reader.next();
+        return QJsonValue(QJsonValue::Null);
+    case QJsonStreamReader::Bool: {
+        const bool b = reader.toBool();
+        reader.next();
+        return b;
+    }
+    case QJsonStreamReader::Number: {
+        const QJsonValue v = reader.isInteger() ? QJsonValue(reader.toInteger())
+                                                : QJsonValue(reader.toDouble());
+        reader.next();
+        return v;
+    }
+    case QJsonStreamReader::String:
+        return reader.readString();
+    case QJsonStreamReader::Array: {
+        QJsonArray array;
+        reader.enterContainer();
+        for (feeder.fill(); reader.hasNext(); feeder.fill())
+            array.append(readValue(reader, feeder));
+        reader.leaveContainer();
+        return array;
+    }
+    case QJsonStreamReader::Object: {
+        QJsonObject object;
+        reader.enterContainer();
+        for (feeder.fill(); reader.hasNext(); feeder.fill()) {
+            if (!reader.isKey())
+                return QJsonValue::Undefined;
+            const QString key = reader.readString();
+            object.insert(key, readValue(reader, feeder));
+        }
+        reader.leaveContainer();
+        return object;
+    }
+    case QJsonStreamReader::Invalid:
+        break;
+    }
+    return QJsonValue::Undefined;
+}
+
+static QByteArray largeDocument()
+{
+    // bigger than the reader's chunk size, with some long strings
+    QJsonArray array;
+    for (int i = 0; i < 4000; ++i) {
+        array.append(QJsonObject{
+                { "index", i },
+                { "name", QString(QString(i % 97, QChar(u'a' + i % 26)) + u"\u00e9\"") },
+                { "values", QJsonArray{ i * 0.5, -i, i % 3 == 0 } },
+                { "empty", QJsonObject() } });
+    }
+    return QJsonDocument(array).toJson();
+}
+
+void tst_QJsonStreamReader::readDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<qsizetype>("step");
+
+    const QByteArray documents[] = {
+        "{}",
+        "[]",
+        " \n[ 1, -2, 3.5, 1e3, -0.25E-2, 9223372036854775807 ] ",
+        R"({"a": 1, "b": [true, false, null, "x\n\u00e9\ud83d\ude00"], "c": {"d": {"e": []}}})",
+        "\xef\xbb\xbf{\"bom\": \"\xc3\xa9t\xc3\xa9\"}",
+        R"([[[[]]], {"k": {"k": [{"k": "\\\"]}"}]}}, "tail"])",
+    };
+    int i = 0;
+    for (const QByteArray &json : documents) {
+        QTest::addRow("doc%d-all", i) << json << qsizetype(-1);
+        QTest::addRow("doc%d-bytewise", i) << json << qsizetype(1);
+        QTest::addRow("doc%d-step7", i) << json << qsizetype(7);
+        ++i;
+    }
+    const QByteArray large = largeDocument();
+    QTest::newRow("large-all") << large << qsizetype(-1);
+    QTest::newRow("large-step1000") << large << qsizetype(1000);
+}
+
+void tst_QJsonStreamReader::readDocument()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(qsizetype, step);
+
+    QJsonParseError error;
+    const QJsonDocument expected = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QJsonStreamReader reader;
+    Feeder feeder{ reader, json, step };
+    reader.reparse();
+    QVERIFY(reader.isIncomplete());
+
+    const QJsonValue value = readValue(reader, feeder);
+    feeder.fill();
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.isValid());
+    QCOMPARE(value, expected.isArray() ? QJsonValue(expected.array())
+                                       : QJsonValue(expected.object()));
+}
+
+void tst_QJsonStreamReader::readFromDevice()
+{
+    const QByteArray json = largeDocument();
+    QBuffer buffer;
+    buffer.setData(json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    Feeder feeder{ reader, QByteArray(), -1 };
+    const QJsonValue value = readValue(reader, feeder);
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QVERIFY(!reader.isIncomplete());
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(value, QJsonValue(QJsonDocument::fromJson(json).array()));
+    QCOMPARE(reader.currentOffset(), json.size());
+}
+
+void tst_QJsonStreamReader::keys()
+{
+    QJsonStreamReader reader(QByteArray(R"({"x\"y": "value", "n": 42})"));
+    QVERIFY(reader.isObject());
+    QVERIFY(!reader.isKey());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 1);
+
+    QVERIFY(reader.isString());
+    QVERIFY(reader.isKey());
+    QCOMPARE(reader.readString(), u"x\"y");
+    QVERIFY(reader.isString());
+    QVERIFY(!reader.isKey());
+    QCOMPARE(reader.readString(), u"value");
+
+    QVERIFY(reader.isKey());
+    QVERIFY(reader.next());     // skip the key
+    QVERIFY(reader.isNumber());
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), 42);
+    QCOMPARE(reader.toDouble(), 42.0);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::skipping()
+{
+    const QByteArray json = R"({"skip": {"a": [1, "]}", {"b": "\\\""}]}, "keep": [1, 2, 3], "rest": [4, 5]})";
+
+    // next() on a container skips all of it, also when the data comes in pieces
+    for (qsizetype step : { qsizetype(-1), qsizetype(1), qsizetype(5) }) {
+        QJsonStreamReader reader;
+        Feeder feeder{ reader, json, step };
+        reader.reparse();
+        feeder.fill();
+        QVERIFY(reader.enterContainer());
+        feeder.fill();
+        QCOMPARE(reader.readString(), u"skip");
+        feeder.fill();
+        QVERIFY(reader.isObject());
+        reader.next();
+        feeder.fill();
+        QVERIFY(reader.isKey());
+        QCOMPARE(reader.readString(), u"keep");
+        feeder.fill();
+        QVERIFY(reader.enterContainer());
+        feeder.fill();
+        QCOMPARE(reader.toInteger(), 1);
+
+        // leave the array after its first element, then the object halfway
+        reader.leaveContainer();
+        feeder.fill();
+        QCOMPARE(reader.containerDepth(), 1);
+        QCOMPARE(reader.readString(), u"rest");
+        reader.leaveContainer();
+        feeder.fill();
+        QCOMPARE(reader.containerDepth(), 0);
+        QVERIFY(!reader.hasNext());
+        QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    }
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    QTest::newRow("scalar") << QByteArray("42") << QJsonParseError::IllegalValue;
+    QTest::newRow("bad-literal") << QByteArray("[nul]") << QJsonParseError::IllegalValue;
+    QTest::newRow("bad-number") << QByteArray("[-]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]") << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" 1}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("missing-value") << QByteArray("{\"a\":}") << QJsonParseError::MissingObject;
+    QTest::newRow("trailing-comma") << QByteArray("[1,]") << QJsonParseError::MissingObject;
+    QTest::newRow("non-string-key") << QByteArray("{1: 2}") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("bad-escape") << QByteArray("[\"\\u12x4\"]") << QJsonParseError::IllegalEscapeSequence;
+    QTest::newRow("garbage-at-end") << QByteArray("[] []") << QJsonParseError::GarbageAtEnd;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    QJsonStreamReader reader(json);
+    Feeder feeder{ reader, QByteArray(), -1 };
+    readValue(reader, feeder);
+    reader.reparse();
+    QCOMPARE(reader.lastError().error, error);
+    QVERIFY(!reader.isValid());
+    QVERIFY(!reader.hasNext());
+}
+
+void tst_QJsonStreamReader::truncatedDevice()
+{
+    // a non-sequential device cannot get more data, so running out is an error
+    const std::pair<QByteArray, QJsonParseError::ParseError> documents[] = {
+        { "", QJsonParseError::IllegalValue },
+        { "[1, 2 ", QJsonParseError::UnterminatedArray },
+        { "[1, 2", QJsonParseError::TerminationByNumber },
+        { "{\"a\": [", QJsonParseError::UnterminatedArray },
+        { "{\"a", QJsonParseError::UnterminatedString },
+        { "[12", QJsonParseError::TerminationByNumber },
+    };
+    for (const auto &[json, error] : documents) {
+        QBuffer buffer;
+        buffer.setData(json);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QJsonStreamReader reader(&buffer);
+        Feeder feeder{ reader, QByteArray(), -1 };
+        readValue(reader, feeder);
+        QVERIFY2(!reader.isIncomplete(), json.constData());
+        QCOMPARE(reader.lastError().error, error);
+    }
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
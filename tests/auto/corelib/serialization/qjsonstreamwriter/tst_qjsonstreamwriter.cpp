@@ -0,0 +1,232 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <QtCore/private/qjsonstreamwriter_p.h>
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void matchesToJson_data();
+    void matchesToJson();
+    void appendSubtree_data();
+    void appendSubtree();
+    void scalars();
+    void device();
+    void misuse();
+};
+
+static void writeValue(QJsonStreamWriter &writer, const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        writer.appendNull();
+        break;
+    case QJsonValue::Bool:
+        writer.append(value.toBool());
+        break;
+    case QJsonValue::Double: {
+        const QVariant v = value.toVariant();
+        if (v.typeId() == QMetaType::LongLong)
+            writer.append(v.toLongLong());
+        else
+            writer.append(v.toDouble());
+        break;
+    }
+    case QJsonValue::String:
+        writer.append(value.toString());
+        break;
+    case QJsonValue::Array:
+        writer.startArray();
+        for (const QJsonValue &element : value.toArray())
+            writeValue(writer, element);
+        QVERIFY(writer.endArray());
+        break;
+    case QJsonValue::Object: {
+        writer.startObject();
+        const QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            writer.append(it.key());
+            writeValue(writer, it.value());
+        }
+        QVERIFY(writer.endObject());
+        break;
+    }
+    }
+}
+
+void tst_QJsonStreamWriter::matchesToJson_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+
+    const QByteArray documents[] = {
+        "{}",
+        "[]",
+        "[1, -2, 3.5, 1e300, 9223372036854775807, true, false, null]",
+        R"({"a": [], "b": {}, "c": [[{}]], "d": {"e": {"f": [1, {"g": null}]}}})",
+        R"(["esc\"ape\\", "\n\t\u0001", "é€😀"])",
+    };
+    int i = 0;
+    for (const QByteArray &json : documents) {
+        QTest::addRow("doc%d-compact", i) << json << QJsonDocument::Compact;
+        QTest::addRow("doc%d-indented", i) << json << QJsonDocument::Indented;
+        ++i;
+    }
+}
+
+void tst_QJsonStreamWriter::matchesToJson()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonDocument::JsonFormat, format);
+
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    QVERIFY(!doc.isNull());
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    QCOMPARE(writer.format(), format);
+    writeValue(writer, doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object()));
+    QCOMPARE(writer.containerDepth(), 0);
+    QCOMPARE(output, doc.toJson(format));
+}
+
+void tst_QJsonStreamWriter::appendSubtree_data()
+{
+    matchesToJson_data();
+}
+
+void tst_QJsonStreamWriter::appendSubtree()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonDocument::JsonFormat, format);
+
+    // appending a whole array or object inside a container gives the same
+    // result as writing its elements one by one
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    const QJsonValue value = doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+
+    QByteArray expected;
+    {
+        QJsonStreamWriter writer(&expected);
+        writer.setFormat(format);
+        writer.startObject();
+        writer.append(u"nested");
+        writeValue(writer, value);
+        writer.endObject();
+    }
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    writer.startObject();
+    writer.append(u"nested");
+    writer.append(value);
+    writer.endObject();
+    QCOMPARE(output, expected);
+    QCOMPARE(output, QJsonDocument(QJsonObject{ { "nested", value } }).toJson(format));
+}
+
+void tst_QJsonStreamWriter::scalars()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(QJsonDocument::Compact);
+    writer.startArray();
+    writer.append(42);
+    writer.append(qint64(-1) << 40);
+    writer.append(0.5);
+    writer.append(qInf());
+    writer.append(true);
+    writer.append(nullptr);
+    writer.append(QLatin1String("latin1"));
+    writer.append("utf\xc3\xa9");
+    writer.append("sized", 3);
+    writer.append(QJsonValue(QJsonValue::Undefined));
+    QVERIFY(writer.endArray());
+    QCOMPARE(output, R"([42,-1099511627776,0.5,null,true,null,"latin1","utfé","siz",null])");
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QJsonStreamWriter writer(&buffer);
+    QCOMPARE(writer.device(), &buffer);
+    writer.setFormat(QJsonDocument::Compact);
+
+    // the output appears as soon as it can be written
+    writer.startObject();
+    QCOMPARE(buffer.data(), "{");
+    writer.append(u"k");
+    writer.append(QJsonValue(QJsonArray{ 1, 2 }));
+    QCOMPARE(buffer.data(), R"({"k":[1,2])");
+    writer.endObject();
+    QCOMPARE(buffer.data(), R"({"k":[1,2]})");
+
+    QBuffer other;
+    QVERIFY(other.open(QIODevice::WriteOnly));
+    writer.setDevice(&other);
+    writer.startArray();
+    writer.endArray();
+    QCOMPARE(other.data(), "[]");
+}
+
+void tst_QJsonStreamWriter::misuse()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(QJsonDocument::Compact);
+
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: endArray() called without a matching start");
+    QVERIFY(!writer.endArray());
+
+    writer.startObject();
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: object keys must be strings");
+    writer.append(1);
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: endArray() called without a matching start");
+    QVERIFY(!writer.endArray());
+    writer.append(u"key");
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: missing value for the last key of an object");
+    QVERIFY(!writer.endObject());
+    writer.append(1);
+    QVERIFY(writer.endObject());
+    QCOMPARE(output, R"({"key":1})");
+}
+
+QTEST_MAIN(tst_QJsonStreamWriter)
+#include "tst_qjsonstreamwriter.moc"
@@ -128,6 +128,9 @@ private slots:
     void int_read_with_locale_data();
     void int_read_with_locale();
 
+    void double_read_with_locale_data();
+    void double_read_with_locale();
+
     void int_write_with_locale_data();
     void int_write_with_locale();
 
@@ -2983,6 +2986,36 @@ void tst_QTextStream::int_read_with_locale()
     QCOMPARE(result, output);
 }
 
+void tst_QTextStream::double_read_with_locale_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<QList<double>>("output");
+
+    QTest::newRow("C") << QString("C")
+                       << QString("1 -2.5 +3e2 4E-1 .5 1e400 7")
+                       << QList<double>({ 1, -2.5, 300, 0.4, 0.5, 0, 7 });
+    QTest::newRow("C separators") << QString("C") << QString("1,5 2.25")
+                                  << QList<double>({ 1, 0 });
+    QTest::newRow("de_DE") << QString("de_DE") << QString("1.234,5 -2,5")
+                           << QList<double>({ 1234.5, -2.5 });
+}
+
+void tst_QTextStream::double_read_with_locale()
+{
+    QFETCH(QString, locale);
+    QFETCH(QString, input);
+    QFETCH(QList<double>, output);
+
+    QTextStream stream(&input);
+    stream.setLocale(QLocale(locale));
+    for (double expected : output) {
+        double result = -1;
+        stream >> result;
+        QCOMPARE(result, expected);
+    }
+}
+
 void tst_QTextStream::int_write_with_locale_data()
 {
     QTest::addColumn<QString>("locale");
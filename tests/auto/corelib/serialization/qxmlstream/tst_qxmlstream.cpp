@@ -585,6 +585,7 @@ private slots:
     void roundTrip_data() const;
 
     void entityExpansionLimit() const;
+    void longTextRuns() const;
 
 private:
     static QByteArray readFile(const QString &filename);
@@ -1730,6 +1731,50 @@ void tst_QXmlStream::entityExpansionLimit() const
     }
 }
 
+void tst_QXmlStream::longTextRuns() const
+{
+    // long runs of ordinary characters are scanned in blocks; make sure the
+    // characters that end a run are still handled one by one, wherever they fall
+    const QString run = QStringLiteral("Lorem ipsum dolor sit amet, é中\U0001F600 consectetur");
+    const QString text = run + QStringLiteral("\n") + run + QStringLiteral("]]") + run
+            + QStringLiteral("&amp;") + run + QStringLiteral("\t") + run;
+    const QString expectedText = run + QStringLiteral("\n") + run + QStringLiteral("]]") + run
+            + QStringLiteral("&") + run + QStringLiteral("\t") + run;
+    const QString attribute = run + QStringLiteral("\n") + run + QStringLiteral("&lt;\"") + run;
+    const QString expectedAttribute = run + QStringLiteral(" ") + run + QStringLiteral("<\"") + run;
+    const QString xml = QStringLiteral("<a x='") + attribute + QStringLiteral("'>")
+            + text + QStringLiteral("<b>") + QString(40, u' ') + QStringLiteral("</b>")
+            + QString(40, u' ') + QStringLiteral("x</a>");
+
+    QXmlStreamReader reader(xml);
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.attributes().value(QStringLiteral("x")), expectedAttribute);
+
+    QString collected;
+    while (reader.readNext() == QXmlStreamReader::Characters)
+        collected += reader.text();
+    QCOMPARE(collected, expectedText);
+    QCOMPARE(reader.lineNumber(), 3);
+
+    QCOMPARE(reader.tokenType(), QXmlStreamReader::StartElement);
+    QCOMPARE(reader.readNext(), QXmlStreamReader::Characters);
+    QVERIFY(reader.isWhitespace());
+    QCOMPARE(reader.text().size(), 40);
+    QCOMPARE(reader.readNext(), QXmlStreamReader::EndElement);
+    QCOMPARE(reader.readNext(), QXmlStreamReader::Characters);
+    QVERIFY(!reader.isWhitespace());
+    QCOMPARE(reader.text(), QString(40, u' ') + QStringLiteral("x"));
+    QCOMPARE(reader.readNext(), QXmlStreamReader::EndElement);
+    reader.readNext();
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+
+    // "]]>" is still rejected after a long run
+    QXmlStreamReader invalid(QStringLiteral("<a>") + run + QStringLiteral("]]></a>"));
+    while (!invalid.atEnd())
+        invalid.readNext();
+    QCOMPARE(invalid.error(), QXmlStreamReader::NotWellFormedError);
+}
+
 void tst_QXmlStream::roundTrip() const
 {
     QFETCH(QString, in);
@@ -51,6 +51,7 @@ private slots:
     void overloads();
     void interface();
     void indexIn();
+    void shortPatterns();
     void staticByteArrayMatcher();
     void haystacksWithMoreThan4GiBWork();
 };
@@ -179,6 +180,33 @@ void tst_QByteArrayMatcher::indexIn()
     QCOMPARE(matcher.indexIn(haystack, 34), -1);
 }
 
+void tst_QByteArrayMatcher::shortPatterns()
+{
+    // Short patterns are searched for a block at a time; place the pattern
+    // and decoys with the right first and last byte around block boundaries.
+    for (qsizetype len = 2; len <= 20; ++len) {
+        QByteArray pattern(len, 'b');
+        pattern.front() = 'a';
+        pattern.back() = 'c';
+        QByteArray decoy = pattern;
+        decoy[len / 2] = 'x';
+
+        for (qsizetype pos = 0; pos < 70; ++pos) {
+            QByteArray haystack(80 + len, '.');
+            if (len > 2 && pos > len)
+                haystack.replace(pos - len, len, decoy);
+            haystack.replace(pos, len, pattern);
+
+            QByteArrayMatcher matcher(pattern);
+            QCOMPARE(matcher.indexIn(haystack), pos);
+            QCOMPARE(matcher.indexIn(haystack, pos), pos);
+            QCOMPARE(matcher.indexIn(haystack, pos + 1), -1);
+            QCOMPARE(matcher.indexIn(QByteArrayView(haystack).first(pos + len - 1)), -1);
+            QCOMPARE(haystack.indexOf(pattern), pos);
+        }
+    }
+}
+
 void tst_QByteArrayMatcher::staticByteArrayMatcher()
 {
     {
@@ -33,6 +33,9 @@
 #include <private/qglobal_p.h>
 #include <QScopeGuard>
 
+#include <QRandomGenerator>
+
+#include <algorithm>
 #include <cstring>
 
 class tst_QCollator : public QObject
@@ -47,6 +50,10 @@ private Q_SLOTS:
     void compare();
 
     void state();
+
+    void sort_data();
+    void sort();
+    void sortProjection();
 };
 
 static bool dpointer_is_null(QCollator &c)
@@ -369,6 +376,65 @@ void tst_QCollator::state()
     QCOMPARE(c.locale(), QLocale(QLocale::NorwegianBokmal));
 }
 
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 0, 1, 2, 100, 5000 }) {
+        const QByteArray size = QByteArray::number(count);
+        QTest::newRow(("C-" + size).constData()) << QLocale(QLocale::C) << count;
+        QTest::newRow(("system-" + size).constData()) << QLocale::system().collation() << count;
+    }
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(int, count);
+
+    static const char alphabet[] = "aAbBcCzZ019 -._";
+    QRandomGenerator rng(count);
+    QStringList list;
+    for (int i = 0; i < count; ++i) {
+        QString s;
+        for (int n = rng.bounded(8); n; --n)
+            s += QLatin1Char(alphabet[rng.bounded(int(sizeof(alphabet)) - 1)]);
+        list.append(s);
+    }
+
+    const QCollator collator(locale);
+    QStringList expected = list;
+    std::stable_sort(expected.begin(), expected.end(), [&](const QString &lhs, const QString &rhs) {
+        return collator.compare(lhs, rhs) < 0;
+    });
+
+    collator.sort(list);
+    QCOMPARE(list, expected);
+}
+
+void tst_QCollator::sortProjection()
+{
+    struct Entry
+    {
+        QString name;
+        int id;
+    };
+    QList<Entry> entries = { { "delta", 0 }, { "Alpha", 1 }, { "charlie", 2 },
+                             { "bravo", 3 }, { "alpha", 4 }, { "charlie", 5 } };
+
+    QCollator collator(QLocale(QLocale::English));
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    collator.sort(entries.begin(), entries.end(),
+                  [](const Entry &entry) -> const QString & { return entry.name; });
+
+    QList<int> ids;
+    for (const Entry &entry : qAsConst(entries))
+        ids.append(entry.id);
+    // "Alpha" and "alpha" collate equal and keep their order, as do the two "charlie"s
+    QCOMPARE(ids, QList<int>({ 1, 4, 3, 2, 5, 0 }));
+}
+
 QTEST_APPLESS_MAIN(tst_QCollator)
 
 #include "tst_qcollator.moc"
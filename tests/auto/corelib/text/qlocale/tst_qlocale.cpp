@@ -107,6 +107,7 @@ private slots:
     void toDateTime();
     void negativeNumbers();
     void numberOptions();
+    void sharedPrivates();
     void dayName_data();
     void dayName();
     void standaloneDayName_data();
@@ -2326,6 +2327,32 @@ void tst_QLocale::numberOptions()
     QVERIFY(!ok);
 }
 
+void tst_QLocale::sharedPrivates()
+{
+    QLocale first(QStringLiteral("de_DE"));
+    const QLocale second(QStringLiteral("de_DE"));
+    QCOMPARE(QLocalePrivate::get(first), QLocalePrivate::get(second));
+    const QLocale byIds(QLocale::German, QLocale::Germany);
+    QCOMPARE(QLocalePrivate::get(byIds), QLocalePrivate::get(second));
+
+    // changing one must not affect the others
+    first.setNumberOptions(QLocale::OmitGroupSeparator);
+    QVERIFY(QLocalePrivate::get(first) != QLocalePrivate::get(second));
+    QCOMPARE(second.numberOptions(), QLocale::DefaultNumberOptions);
+    QCOMPARE(QLocale(QStringLiteral("de_DE")).numberOptions(), QLocale::DefaultNumberOptions);
+    QCOMPARE(first.toString(1234), QStringLiteral("1234"));
+    QCOMPARE(second.toString(1234), QStringLiteral("1.234"));
+
+    // more names than are remembered still resolve correctly
+    const QStringList names = { "en_US", "en_GB", "fr_FR", "fr_CA", "de_AT", "de_CH", "it_IT",
+                                "es_ES", "es_MX", "pt_BR", "pt_PT", "nl_NL", "sv_SE", "nb_NO",
+                                "da_DK", "fi_FI", "pl_PL", "cs_CZ", "ru_RU", "ja_JP", "zh_CN" };
+    for (int round = 0; round < 2; ++round) {
+        for (const QString &name : names)
+            QCOMPARE(QLocale(name).name(), name);
+    }
+}
+
 void tst_QLocale::negativeNumbers()
 {
     QLocale locale(QLocale::C);
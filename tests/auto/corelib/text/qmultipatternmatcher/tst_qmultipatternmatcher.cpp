@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <private/qmultipatternmatcher_p.h>
+
+using Match = QMultiPatternMatch;
+
+class tst_QMultiPatternMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void byteArrays();
+    void overlapping();
+    void duplicatePatterns();
+    void indexIn();
+    void bruteForce();
+    void strings();
+    void caseInsensitive();
+};
+
+static QList<Match> naiveFindAll(const QList<QByteArray> &patterns, QByteArrayView data)
+{
+    // same order as the matcher: by end position, then longest first
+    QList<Match> result;
+    for (qsizetype end = 1; end <= data.size(); ++end) {
+        QList<Match> here;
+        for (qsizetype p = 0; p < patterns.size(); ++p) {
+            const qsizetype len = patterns.at(p).size();
+            if (len && len <= end && data.sliced(end - len, len) == patterns.at(p))
+                here.append(Match{ end - len, len, p });
+        }
+        std::stable_sort(here.begin(), here.end(), [](const Match &a, const Match &b) {
+            return a.length > b.length;
+        });
+        result += here;
+    }
+    return result;
+}
+
+static bool operator==(const Match &lhs, const Match &rhs)
+{
+    return lhs.position == rhs.position && lhs.length == rhs.length
+            && lhs.pattern == rhs.pattern;
+}
+
+namespace QTest {
+template <>
+char *toString(const Match &m)
+{
+    return qstrdup(QByteArray("Match(" + QByteArray::number(m.position) + ", "
+                              + QByteArray::number(m.length) + ", "
+                              + QByteArray::number(m.pattern) + ")").constData());
+}
+}
+
+void tst_QMultiPatternMatcher::empty()
+{
+    QMultiByteArrayMatcher matcher;
+    QVERIFY(matcher.patterns().isEmpty());
+    QVERIFY(!matcher.indexIn("hello").isValid());
+    QVERIFY(matcher.findAll("hello").isEmpty());
+
+    matcher.setPatterns({ QByteArray(), QByteArray() });
+    QVERIFY(!matcher.containsAny("hello"));
+    QVERIFY(matcher.findAll("").isEmpty());
+
+    QMultiStringMatcher smatcher;
+    QVERIFY(!smatcher.containsAny(u"hello"));
+}
+
+void tst_QMultiPatternMatcher::byteArrays()
+{
+    const QMultiByteArrayMatcher matcher({ "error", "warning", "fatal" });
+    const QByteArray line = "warning: disk almost full; error: write failed";
+    const QList<Match> expected = { { 0, 7, 1 }, { 27, 5, 0 } };
+    QCOMPARE(matcher.findAll(line), expected);
+    QCOMPARE(matcher.findAll(line, 1), QList<Match>{ expected.at(1) });
+    QCOMPARE(matcher.findAll(line, -5), expected);
+    QVERIFY(matcher.containsAny(line));
+    QVERIFY(!matcher.containsAny("all good"));
+    QCOMPARE(matcher.patterns(), QList<QByteArray>({ "error", "warning", "fatal" }));
+}
+
+void tst_QMultiPatternMatcher::overlapping()
+{
+    const QMultiByteArrayMatcher matcher({ "he", "she", "his", "hers" });
+    const QList<Match> expected = {
+        { 1, 3, 1 }, { 2, 2, 0 }, { 2, 4, 3 },
+    };
+    QCOMPARE(matcher.findAll("ushers"), expected);
+}
+
+void tst_QMultiPatternMatcher::duplicatePatterns()
+{
+    const QMultiByteArrayMatcher matcher({ "ab", "", "ab", "b" });
+    const QList<Match> expected = { { 0, 2, 0 }, { 0, 2, 2 }, { 1, 1, 3 } };
+    QCOMPARE(matcher.findAll("ab"), expected);
+}
+
+void tst_QMultiPatternMatcher::indexIn()
+{
+    const QMultiByteArrayMatcher matcher({ "abcd", "bc", "c" });
+    // the match that ends first wins, the longest one among equals
+    QCOMPARE(matcher.indexIn("xabcd"), Match({ 2, 2, 1 }));
+    QCOMPARE(matcher.indexIn("xabcd", 3), Match({ 3, 1, 2 }));
+    QVERIFY(!matcher.indexIn("xabcd", 4).isValid());
+}
+
+void tst_QMultiPatternMatcher::bruteForce()
+{
+    // a small alphabet gives plenty of overlapping and nested matches
+    auto random = QRandomGenerator::global();
+    for (int round = 0; round < 50; ++round) {
+        QList<QByteArray> patterns;
+        for (int i = random->bounded(1, 20); i; --i) {
+            QByteArray pattern;
+            for (int j = random->bounded(0, 6); j; --j)
+                pattern += char('a' + random->bounded(3));
+            patterns.append(pattern);
+        }
+        QByteArray data;
+        for (int j = random->bounded(0, 200); j; --j)
+            data += char('a' + random->bounded(4));
+
+        const QMultiByteArrayMatcher matcher(patterns);
+        const QList<Match> expected = naiveFindAll(patterns, data);
+        QCOMPARE(matcher.findAll(data), expected);
+        QCOMPARE(matcher.indexIn(data), expected.value(0));
+    }
+}
+
+void tst_QMultiPatternMatcher::strings()
+{
+    const QMultiStringMatcher matcher({ u"\u4e2d\u6587"_qs, u"\u6587"_qs, u"\U0001F600"_qs });
+    const QString text = u"x\u4e2d\u6587y\U0001F600z"_qs;
+    const QList<Match> expected = { { 1, 2, 0 }, { 2, 1, 1 }, { 4, 2, 2 } };
+    QCOMPARE(matcher.findAll(text), expected);
+    QCOMPARE(matcher.indexIn(QStringView(text).sliced(3)), Match({ 1, 2, 2 }));
+
+    // matches must start and end on a code unit boundary
+    const QMultiStringMatcher shifted({ QString(QChar(0x4142)) });
+    QVERIFY(!shifted.containsAny(u"\u4200A"));
+    QVERIFY(shifted.containsAny(u"A\u4142"));
+}
+
+void tst_QMultiPatternMatcher::caseInsensitive()
+{
+    QMultiStringMatcher matcher({ u"Error"_qs, u"STRASSE"_qs, u"\U00010400"_qs });
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(!matcher.containsAny(u"ERROR"));
+
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.indexIn(u"an eRRoR"), Match({ 3, 5, 0 }));
+    QCOMPARE(matcher.indexIn(u"strasse"), Match({ 0, 7, 1 }));
+    // Deseret capital and small long I
+    QCOMPARE(matcher.indexIn(u"-\U00010428"), Match({ 1, 2, 2 }));
+
+    matcher.setCaseSensitivity(Qt::CaseSensitive);
+    QVERIFY(!matcher.containsAny(u"an eRRoR"));
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiPatternMatcher)
+#include "tst_qmultipatternmatcher.moc"
@@ -0,0 +1,224 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QTest>
+
+#include <private/qregularexpressionset_p.h>
+
+class tst_QRegularExpressionSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void basics();
+    void invalidPatterns();
+    void uncombinablePatterns_data();
+    void uncombinablePatterns();
+    void options();
+    void anchoredMatch();
+    void invalidSubject();
+    void manyPatterns();
+    void consistency();
+};
+
+static QList<qsizetype> naiveMatchingPatterns(const QStringList &patterns,
+                                              QRegularExpression::PatternOptions options,
+                                              const QString &subject,
+                                              QRegularExpression::MatchOptions matchOptions = {})
+{
+    QList<qsizetype> result;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QRegularExpression re(patterns.at(i), options);
+        if (re.match(subject, 0, QRegularExpression::NormalMatch, matchOptions).hasMatch())
+            result.append(i);
+    }
+    return result;
+}
+
+void tst_QRegularExpressionSet::empty()
+{
+    QRegularExpressionSet set;
+    QCOMPARE(set.size(), 0);
+    QVERIFY(set.isValid());
+    QVERIFY(set.patterns().isEmpty());
+    QVERIFY(set.matchingPatterns(u"abc").isEmpty());
+    QVERIFY(!set.matchesAny(u"abc"));
+
+    set.setPatterns({ QString() });
+    QCOMPARE(set.size(), 1);
+    QCOMPARE(set.matchingPatterns(u""), QList<qsizetype>{ 0 });
+    QVERIFY(set.matchesAny(u"abc"));
+}
+
+void tst_QRegularExpressionSet::basics()
+{
+    const QStringList patterns = { "foo", "b.r", "^start", "end$", "\\d{3}" };
+    QRegularExpressionSet set(patterns);
+    QCOMPARE(set.size(), patterns.size());
+    QCOMPARE(set.patterns(), patterns);
+    QVERIFY(set.isValid());
+    QCOMPARE(set.regularExpression(1).pattern(), patterns.at(1));
+
+    QCOMPARE(set.matchingPatterns(u"a bar foo"), QList<qsizetype>({ 0, 1 }));
+    QCOMPARE(set.matchingPatterns(u"start 12 end"), QList<qsizetype>({ 2, 3 }));
+    QCOMPARE(set.matchingPatterns(u"x 1234"), QList<qsizetype>{ 4 });
+    QVERIFY(set.matchingPatterns(u"nothing here").isEmpty());
+    QVERIFY(set.matchesAny(u"xbzr"));
+    QVERIFY(!set.matchesAny(u"end start"));
+
+    // copies share the compiled state
+    const QRegularExpressionSet copy = set;
+    set.setPatterns({ "zzz" });
+    QCOMPARE(copy.matchingPatterns(u"a bar foo"), QList<qsizetype>({ 0, 1 }));
+    QCOMPARE(set.matchingPatterns(u"a bar foo"), QList<qsizetype>());
+}
+
+void tst_QRegularExpressionSet::invalidPatterns()
+{
+    QRegularExpressionSet set({ "a", "(", "b", "a{2" });
+    QVERIFY(!set.isValid());
+    QVERIFY(!set.regularExpression(1).isValid());
+    // "a{2" is a literal in PCRE2, the invalid pattern simply never matches
+    QCOMPARE(set.matchingPatterns(u"a{2 b ("), QList<qsizetype>({ 0, 2, 3 }));
+}
+
+void tst_QRegularExpressionSet::uncombinablePatterns_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("matching");
+    QTest::addColumn<QString>("notMatching");
+
+    QTest::newRow("backreference") << "(a)\\1" << "xaa" << "xab";
+    QTest::newRow("named-backreference") << "(?<x>a)\\k<x>" << "xaa" << "xab";
+    QTest::newRow("subroutine") << "(b)(?1)" << "bb" << "bc";
+    QTest::newRow("recursion") << "(?R)?z" << "az" << "a";
+    QTest::newRow("conditional") << "(a)?(?(1)b|c)" << "ab" << "ad";
+    QTest::newRow("accept") << "a(*ACCEPT)q" << "ax" << "x";
+    QTest::newRow("callout") << "(?C1)a" << "a" << "b";
+    QTest::newRow("quote") << "\\Qa.b" << "a.b" << "axb";
+    QTest::newRow("extended-comment") << "(?x)a # b" << "a" << "b";
+    QTest::newRow("duplicate-name") << "(?<n>a)b" << "ab" << "b";
+}
+
+void tst_QRegularExpressionSet::uncombinablePatterns()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, matching);
+    QFETCH(QString, notMatching);
+
+    // surround the pattern with ordinary ones, so that it must not affect them
+    const QStringList patterns = { "(?<n>q)", pattern, "z$", "^x" };
+    QRegularExpressionSet set(patterns);
+    QVERIFY(set.isValid());
+    QCOMPARE(set.matchingPatterns(matching), naiveMatchingPatterns(patterns, {}, matching));
+    QCOMPARE(set.matchingPatterns(notMatching), naiveMatchingPatterns(patterns, {}, notMatching));
+    QVERIFY(set.matchingPatterns(matching).contains(1));
+    QVERIFY(!set.matchingPatterns(notMatching).contains(1));
+}
+
+void tst_QRegularExpressionSet::options()
+{
+    QRegularExpressionSet set({ "foo", "^bar$", "b a z # comment" });
+    QVERIFY(set.matchingPatterns(u"FOO").isEmpty());
+
+    set.setPatterns(set.patterns(), QRegularExpression::CaseInsensitiveOption
+                                        | QRegularExpression::MultilineOption
+                                        | QRegularExpression::ExtendedPatternSyntaxOption);
+    QCOMPARE(set.patternOptions(), QRegularExpression::CaseInsensitiveOption
+                                       | QRegularExpression::MultilineOption
+                                       | QRegularExpression::ExtendedPatternSyntaxOption);
+    QCOMPARE(set.matchingPatterns(u"FOO\nBar\nbAZ"), QList<qsizetype>({ 0, 1, 2 }));
+}
+
+void tst_QRegularExpressionSet::anchoredMatch()
+{
+    QRegularExpressionSet set({ "ab", "b", "a+" });
+    QCOMPARE(set.matchingPatterns(u"aab"), QList<qsizetype>({ 0, 1, 2 }));
+    QCOMPARE(set.matchingPatterns(u"aab", QRegularExpression::AnchorAtOffsetMatchOption),
+             QList<qsizetype>{ 2 });
+}
+
+void tst_QRegularExpressionSet::invalidSubject()
+{
+    QRegularExpressionSet set({ "a", "(a)\\1" });
+    QString subject = "aa";
+    QCOMPARE(set.matchingPatterns(subject), QList<qsizetype>({ 0, 1 }));
+
+    subject.append(QChar(0xd800));
+    QVERIFY(set.matchingPatterns(subject).isEmpty());
+}
+
+void tst_QRegularExpressionSet::manyPatterns()
+{
+    QStringList patterns;
+    for (int i = 0; i < 600; ++i)
+        patterns.append(QStringLiteral("k%1x").arg(i));
+    QRegularExpressionSet set(patterns);
+    QCOMPARE(set.matchingPatterns(u"k5x k599x k77x k5"), QList<qsizetype>({ 5, 77, 599 }));
+}
+
+void tst_QRegularExpressionSet::consistency()
+{
+    static const char *const pool[] = {
+        "foo", "b.r", "^start", "end$", "\\d{3}", "(a)\\1", "(?<x>a)b", "(?<x>b)c", "a(*ACCEPT)q",
+        "x # comment", "\\Qa.b", "(?i)FOO", "[", "(a|ab)(c|bcd)(d*)", "a+b", "(?=ab)a", "(?<=a)b",
+        "\\bword\\b", "(?x)w o r d # c", "(b)(?1)", "(?R)?z", "", "(?C1)a", "\\Gsta", "a{2", "q\\E"
+    };
+    static const char *const subjects[] = {
+        "start foo 123 end", "aa", "ab bc", "xyz", "", "a.b word", "FOO", "ababcd", "q", "aaaab", "bz"
+    };
+
+    QRandomGenerator rng(5);
+    for (int round = 0; round < 500; ++round) {
+        QStringList patterns;
+        for (int n = rng.bounded(12); n; --n)
+            patterns.append(QString::fromLatin1(pool[rng.bounded(int(std::size(pool)))]));
+        QRegularExpression::PatternOptions options;
+        if (rng.bounded(4) == 0)
+            options |= QRegularExpression::CaseInsensitiveOption;
+        if (rng.bounded(6) == 0)
+            options |= QRegularExpression::ExtendedPatternSyntaxOption;
+        if (rng.bounded(6) == 0)
+            options |= QRegularExpression::MultilineOption;
+
+        const QRegularExpressionSet set(patterns, options);
+        for (const char *s : subjects) {
+            const QString subject = QString::fromLatin1(s);
+            const QList<qsizetype> expected = naiveMatchingPatterns(patterns, options, subject);
+            QCOMPARE(set.matchingPatterns(subject), expected);
+            QCOMPARE(set.matchesAny(subject), !expected.isEmpty());
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QRegularExpressionSet)
+
+#include "tst_qregularexpressionset.moc"
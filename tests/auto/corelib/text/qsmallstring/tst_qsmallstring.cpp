@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QHash>
+#include <QSet>
+#include <QTest>
+
+#include <QtCore/qsmallstring.h>
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void layout();
+    void inlineByteArray();
+    void heapByteArray();
+    void appendCrossesCapacity();
+    void copyAndMove();
+    void swap();
+    void strings();
+    void comparisonAndHash();
+};
+
+void tst_QSmallString::layout()
+{
+    static_assert(sizeof(QSmallByteArray) == sizeof(QByteArray));
+    static_assert(sizeof(QSmallString) == sizeof(QString));
+    static_assert(QTypeInfo<QSmallByteArray>::isRelocatable);
+    static_assert(QTypeInfo<QSmallString>::isRelocatable);
+    QCOMPARE(QSmallByteArray::InlineCapacity,
+             qsizetype(sizeof(QByteArray) - sizeof(void *) - 1));
+    QCOMPARE(QSmallString::InlineCapacity,
+             qsizetype((sizeof(QString) - sizeof(void *)) / 2 - 1));
+}
+
+void tst_QSmallString::inlineByteArray()
+{
+    QSmallByteArray empty;
+    QVERIFY(empty.isInline());
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.constData()[0], '\0');
+
+    const QByteArray full(QSmallByteArray::InlineCapacity, 'x');
+    QSmallByteArray s(QByteArrayView{full});
+    QVERIFY(s.isInline());
+    QCOMPARE(s.size(), full.size());
+    QCOMPARE(s.view(), full);
+    QCOMPARE(s.constData()[s.size()], '\0');
+    QCOMPARE(s.toByteArray(), full);
+
+    QSmallByteArray literal("key");
+    QVERIFY(literal.isInline());
+    QCOMPARE(literal.view(), "key");
+}
+
+void tst_QSmallString::heapByteArray()
+{
+    const QByteArray big(QSmallByteArray::InlineCapacity + 1, 'y');
+    QSmallByteArray s(big);
+    QVERIFY(!s.isInline());
+    QCOMPARE(s.view(), big);
+    // constructing from a QByteArray shares its data
+    QCOMPARE(s.constData(), big.constData());
+
+    s.clear();
+    QVERIFY(s.isInline());
+    QVERIFY(s.isEmpty());
+}
+
+void tst_QSmallString::appendCrossesCapacity()
+{
+    QSmallByteArray s("ab");
+    s.append("cd");
+    QVERIFY(s.isInline());
+    QCOMPARE(s.view(), "abcd");
+
+    // appending a view of ourselves
+    s.append(s.view());
+    QCOMPARE(s.view(), "abcdabcd");
+
+    QByteArray expected = s.toByteArray();
+    while (s.isInline()) {
+        s.append("z");
+        expected.append('z');
+    }
+    QCOMPARE(s.size(), QSmallByteArray::InlineCapacity + 1);
+    QCOMPARE(s.view(), expected);
+
+    s.append("tail");
+    expected.append("tail");
+    QCOMPARE(s.view(), expected);
+}
+
+void tst_QSmallString::copyAndMove()
+{
+    const QByteArray big(64, 'q');
+    for (const QByteArray &payload : { QByteArray("small"), big }) {
+        QSmallByteArray s(payload);
+        QSmallByteArray copy = s;
+        QCOMPARE(copy.view(), payload);
+        QCOMPARE(copy.isInline(), s.isInline());
+
+        QSmallByteArray moved = std::move(copy);
+        QCOMPARE(moved.view(), payload);
+        QVERIFY(copy.isInline());
+        QVERIFY(copy.isEmpty());
+
+        copy = moved;
+        QCOMPARE(copy, moved);
+        moved = QSmallByteArray();
+        QVERIFY(moved.isEmpty());
+        QCOMPARE(copy.view(), payload);
+    }
+}
+
+void tst_QSmallString::swap()
+{
+    QSmallByteArray a("inline");
+    QSmallByteArray b(QByteArray(40, 'h'));
+    a.swap(b);
+    QVERIFY(!a.isInline());
+    QVERIFY(b.isInline());
+    QCOMPARE(a.view(), QByteArray(40, 'h'));
+    QCOMPARE(b.view(), "inline");
+    qSwap(a, b);
+    QCOMPARE(a.view(), "inline");
+}
+
+void tst_QSmallString::strings()
+{
+    QSmallString empty;
+    QVERIFY(empty.isInline());
+    QCOMPARE(empty.toString(), QString());
+
+    QSmallString s(QLatin1String("abc"));
+    QVERIFY(s.isInline());
+    QCOMPARE(s.view(), u"abc");
+    s.append(u"\u00e9");
+    QCOMPARE(s.toString(), QString::fromUtf16(u"abc\u00e9"));
+
+    const QString big = QStringLiteral("a string that does not fit inline");
+    QSmallString h(big);
+    QVERIFY(!h.isInline());
+    QCOMPARE(h.toString(), big);
+    QCOMPARE(QSmallString(QLatin1String("a string that does not fit inline")), h);
+
+    QSmallString v(QStringView(big).left(QSmallString::InlineCapacity));
+    QVERIFY(v.isInline());
+    QCOMPARE(v.view(), QStringView(big).left(QSmallString::InlineCapacity));
+}
+
+void tst_QSmallString::comparisonAndHash()
+{
+    QSmallByteArray a("apple");
+    QSmallByteArray b("banana");
+    QVERIFY(a < b);
+    QVERIFY(a != b);
+    QVERIFY(a == QSmallByteArray(QByteArray("apple")));
+    QCOMPARE(qHash(a), qHash(QByteArrayView("apple")));
+
+    QSet<QSmallString> set;
+    set.insert(QSmallString(u"one"));
+    set.insert(QSmallString(QString(50, u'x')));
+    QVERIFY(set.contains(QSmallString(QLatin1String("one"))));
+    QVERIFY(set.contains(QSmallString(QString(50, u'x'))));
+    QVERIFY(!set.contains(QSmallString(u"two")));
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+#include "tst_qsmallstring.moc"
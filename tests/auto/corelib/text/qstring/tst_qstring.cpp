@@ -547,6 +547,7 @@ private slots:
     void doubleOut();
     void arg_fillChar_data();
     void arg_fillChar();
+    void format();
     void capacity_data();
     void capacity();
     void section_data();
@@ -6794,6 +6795,33 @@ void tst_QString::arg_fillChar()
     QCOMPARE(actual, expected);
 }
 
+void tst_QString::format()
+{
+    const QString name = QStringLiteral("world");
+    QCOMPARE(qFormat(u"Hello %1!", name), QStringLiteral("Hello world!"));
+    QCOMPARE(qFormat(QLatin1String("%2-%1-%2"), QLatin1String("a"), QChar(u'b')),
+             QStringLiteral("b-a-b"));
+    QCOMPARE(qFormat(u"%1 / %2 / %3 / %4", -42, 7u, std::numeric_limits<qlonglong>::min(),
+                     std::numeric_limits<qulonglong>::max()),
+             QStringLiteral("-42 / 7 / -9223372036854775808 / 18446744073709551615"));
+    QCOMPARE(qFormat(u"%1 %2", 0, 1.5), QStringLiteral("0 1.5"));
+    QCOMPARE(qFormat(u"100% %1", 3), QStringLiteral("100% 3"));
+    // same argument in several placeholders, numbers and strings mixed
+    QCOMPARE(qFormat(u"%1%2%1%2", 12, u"ab"), QStringLiteral("12ab12ab"));
+
+    // the pattern need not be a literal
+    const QString pattern = QStringLiteral("%1:%2");
+    QCOMPARE(qFormat(pattern, 1, 2), QStringLiteral("1:2"));
+
+    // same results as chained arg()
+    QCOMPARE(qFormat(u"%1 %2", 3.25, -1), QString("%1 %2").arg(3.25).arg(-1));
+
+    {
+        TransientDefaultLocale transient(QLocale(QLocale::German, QLocale::Germany));
+        QCOMPARE(qFormat(u"%1 %L1 %L2", 12345, 1.5), QStringLiteral("12345 12.345 1,5"));
+    }
+}
+
 void tst_QString::compare_data()
 {
     QTest::addColumn<QString>("s1");
@@ -53,6 +53,11 @@ private slots:
     void utf8Codec_data();
     void utf8Codec();
 
+    void utf8LongStrings_data();
+    void utf8LongStrings();
+    void utf8LongInvalid_data();
+    void utf8LongInvalid();
+
     void utf8bom_data();
     void utf8bom();
 
@@ -1316,6 +1321,147 @@ void tst_QStringConverter::utf8Codec()
     QCOMPARE(str, res);
 }
 
+static QByteArray referenceUtf8(const QString &str)
+{
+    QByteArray result;
+    const QList<uint> ucs4 = str.toUcs4();
+    for (uint c : ucs4) {
+        if (c < 0x80) {
+            result += char(c);
+        } else if (c < 0x800) {
+            result += char(0xc0 | (c >> 6));
+            result += char(0x80 | (c & 0x3f));
+        } else if (c < 0x10000) {
+            result += char(0xe0 | (c >> 12));
+            result += char(0x80 | ((c >> 6) & 0x3f));
+            result += char(0x80 | (c & 0x3f));
+        } else {
+            result += char(0xf0 | (c >> 18));
+            result += char(0x80 | ((c >> 12) & 0x3f));
+            result += char(0x80 | ((c >> 6) & 0x3f));
+            result += char(0x80 | (c & 0x3f));
+        }
+    }
+    return result;
+}
+
+// Builds a string of the given length from characters picked from the
+// ranges in a fixed pseudo-random sequence.
+static QString mixedString(std::initializer_list<std::pair<char32_t, char32_t>> ranges, int length)
+{
+    QString result;
+    quint32 seed = 12345;
+    while (result.size() < length) {
+        seed = seed * 1103515245 + 12345;
+        const auto &range = ranges.begin()[(seed >> 16) % ranges.size()];
+        seed = seed * 1103515245 + 12345;
+        const char32_t c = range.first + (seed >> 8) % (range.second - range.first + 1);
+        result += QStringView(QChar::fromUcs4(c));
+    }
+    return result;
+}
+
+void tst_QStringConverter::utf8LongStrings_data()
+{
+    QTest::addColumn<QString>("str");
+
+    // long enough to go through the vectorised code and cross its blocks in
+    // all possible positions
+    for (int length : { 7, 8, 9, 15, 16, 17, 31, 33, 64, 100, 257 }) {
+        QTest::addRow("cyrillic-%d", length)
+                << mixedString({ { 0x410, 0x44f }, { 0x410, 0x44f }, { ' ', ' ' } }, length);
+        QTest::addRow("cjk-%d", length)
+                << mixedString({ { 0x4e00, 0x9fff }, { 0x3001, 0x3002 } }, length);
+        QTest::addRow("two-byte-%d", length) << mixedString({ { 0x80, 0x7ff } }, length);
+        QTest::addRow("three-byte-%d", length)
+                << mixedString({ { 0x800, 0xd7ff }, { 0xe000, 0xffff } }, length);
+        QTest::addRow("mixed-%d", length)
+                << mixedString({ { 0, 0x7f }, { 0x80, 0x7ff }, { 0x800, 0xd7ff }, { 0xe000, 0xffff } },
+                               length);
+        QTest::addRow("non-bmp-%d", length)
+                << mixedString({ { 'a', 'z' }, { 0x3b1, 0x3c9 }, { 0x4e00, 0x4eff },
+                                 { 0x1f600, 0x1f64f } }, length);
+    }
+
+    // the boundaries between the sequence lengths
+    QString boundaries;
+    for (char32_t c : { 0x7f, 0x80, 0x7ff, 0x800, 0xfff, 0x1000, 0xd7ff, 0xe000, 0xfffd, 0xffff })
+        boundaries += QStringView(QChar::fromUcs4(c));
+    QTest::newRow("boundaries") << boundaries + boundaries + boundaries;
+}
+
+void tst_QStringConverter::utf8LongStrings()
+{
+    QFETCH(QString, str);
+    const QByteArray utf8 = referenceUtf8(str);
+
+    QCOMPARE(str.toUtf8(), utf8);
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    QCOMPARE(QByteArray(encoder(str)), utf8);
+    QVERIFY(!encoder.hasError());
+
+    QCOMPARE(QString::fromUtf8(utf8), str);
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    QCOMPARE(QString(decoder(utf8)), str);
+    QVERIFY(!decoder.hasError());
+
+    // and again, split in two at every position
+    for (qsizetype i = 1; i < utf8.size(); ++i) {
+        QStringDecoder splitDecoder(QStringDecoder::Utf8);
+        QString decoded = splitDecoder(QByteArrayView(utf8).first(i));
+        decoded += splitDecoder(QByteArrayView(utf8).sliced(i));
+        QCOMPARE(decoded, str);
+    }
+}
+
+void tst_QStringConverter::utf8LongInvalid_data()
+{
+    QTest::addColumn<QByteArray>("invalid");
+
+    QTest::newRow("0xff") << QByteArray("\xff");
+    QTest::newRow("lone-continuation") << QByteArray("\x80");
+    QTest::newRow("truncated-two") << QByteArray("\xd0");
+    QTest::newRow("truncated-three") << QByteArray("\xe4\xb8");
+    QTest::newRow("overlong-two") << QByteArray("\xc1\xbf");
+    QTest::newRow("overlong-three") << QByteArray("\xe0\x9f\xbf");
+    QTest::newRow("surrogate-high") << QByteArray("\xed\xa0\x80");
+    QTest::newRow("surrogate-low") << QByteArray("\xed\xbf\xbf");
+    QTest::newRow("overlong-four") << QByteArray("\xf0\x8f\xbf\xbf");
+    QTest::newRow("too-large") << QByteArray("\xf4\x90\x80\x80");
+}
+
+void tst_QStringConverter::utf8LongInvalid()
+{
+    QFETCH(QByteArray, invalid);
+    const QString str = mixedString({ { 0x20, 0x7e }, { 0x410, 0x44f }, { 0x4e00, 0x9fff } }, 40);
+    const QByteArray valid = referenceUtf8(str);
+
+    for (qsizetype i = 0; i <= valid.size(); ++i) {
+        // insert only at character boundaries; the invalid sequence is too
+        // short to go through the vectorised code on its own
+        if (i < valid.size() && (uchar(valid.at(i)) & 0xc0) == 0x80)
+            continue;
+        const QByteArray utf8 = valid.left(i) + invalid + valid.mid(i);
+        const QString expected = QString::fromUtf8(valid.left(i)) + QString::fromUtf8(invalid)
+                + QString::fromUtf8(valid.mid(i));
+        QCOMPARE(QString::fromUtf8(utf8), expected);
+
+        QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+        QCOMPARE(QString(decoder(utf8)), expected);
+        QVERIFY(decoder.hasError());
+    }
+
+    // unpaired surrogates in UTF-16 are replaced
+    for (qsizetype i = 0; i <= str.size(); ++i) {
+        const QString utf16 = str.left(i) + QChar(char16_t(0xd800 + i)) + str.mid(i);
+        const QString expected = str.left(i) + QChar(QChar::ReplacementCharacter) + str.mid(i);
+        QStringEncoder encoder(QStringEncoder::Utf8, QStringEncoder::Flag::Stateless);
+        QCOMPARE(QByteArray(encoder(utf16)), referenceUtf8(expected));
+        QVERIFY(encoder.hasError());
+        QCOMPARE(utf16.toUtf8(), referenceUtf8(str.left(i) + u'?' + str.mid(i)));
+    }
+}
+
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_DEPRECATED
 void tst_QStringConverter::utf8bom_data()
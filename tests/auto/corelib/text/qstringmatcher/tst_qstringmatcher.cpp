@@ -38,6 +38,7 @@ private slots:
     void caseSensitivity();
     void indexIn_data();
     void indexIn();
+    void shortPatterns();
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
@@ -107,6 +108,33 @@ void tst_QStringMatcher::indexIn()
     QCOMPARE(matcherSV.indexIn(QStringView(haystack), from), indexIn);
 }
 
+void tst_QStringMatcher::shortPatterns()
+{
+    // Short patterns are searched for a block at a time; place the pattern
+    // and decoys with the right first and last character around block
+    // boundaries.
+    for (qsizetype len = 2; len <= 20; ++len) {
+        QString pattern(len, u'\x4e2d');
+        pattern.front() = u'a';
+        pattern.back() = u'\x6587';
+        QString decoy = pattern;
+        decoy[len / 2] = u'x';
+
+        for (qsizetype pos = 0; pos < 40; ++pos) {
+            QString haystack(50 + len, u'.');
+            if (len > 2 && pos > len)
+                haystack.replace(pos - len, len, decoy);
+            haystack.replace(pos, len, pattern);
+
+            QStringMatcher matcher(pattern);
+            QCOMPARE(matcher.indexIn(haystack), pos);
+            QCOMPARE(matcher.indexIn(haystack, pos), pos);
+            QCOMPARE(matcher.indexIn(haystack, pos + 1), -1);
+            QCOMPARE(matcher.indexIn(QStringView(haystack).first(pos + len - 1)), -1);
+        }
+    }
+}
+
 void tst_QStringMatcher::setCaseSensitivity_data()
 {
     QTest::addColumn<QString>("needle");
@@ -67,6 +67,7 @@ private slots:
     void suspended();
     void suspendedEventsOrder();
     void throttling();
+    void mergeResultsReadyWhenThrottled();
     void incrementalMapResults();
     void incrementalFilterResults();
     void qfutureSynchronizer();
@@ -1028,6 +1029,38 @@ void tst_QFutureWatcher::throttling()
     iface.reportFinished();
 }
 
+void tst_QFutureWatcher::mergeResultsReadyWhenThrottled()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    QFutureWatcher<int> watcher;
+    watcher.setPendingResultsLimit(2);
+    QSignalSpy resultSpy(&watcher, &QFutureWatcher<int>::resultReadyAt);
+    QSignalSpy resultsSpy(&watcher, &QFutureWatcher<int>::resultsReadyAt);
+    watcher.setFuture(iface.future());
+
+    const int resultCount = 1000;
+    for (int i = 0; i < resultCount; ++i)
+        iface.reportResult(i);
+
+    QTRY_COMPARE(resultSpy.count(), resultCount);
+    // progress updates in between start a new range; there are few of them
+    QVERIFY(resultsSpy.count() < resultCount / 10);
+
+    // the ranges are contiguous and cover all results
+    int next = 0;
+    for (const QList<QVariant> &arguments : qAsConst(resultsSpy)) {
+        QCOMPARE(arguments.at(0).toInt(), next);
+        next = arguments.at(1).toInt();
+    }
+    QCOMPARE(next, resultCount);
+    for (int i = 0; i < resultCount; ++i)
+        QCOMPARE(resultSpy.at(i).at(0).toInt(), i);
+
+    QVERIFY(!iface.isThrottled());
+    iface.reportFinished();
+}
+
 int mapper(const int &i)
 {
     return i;
@@ -48,6 +48,7 @@ private slots:
     void futureFromPromise();
     void addResult();
     void addResultOutOfOrder();
+    void addResults();
 #ifndef QT_NO_EXCEPTIONS
     void setException();
 #endif
@@ -252,6 +253,45 @@ void tst_QPromise::addResultOutOfOrder()
     }
 }
 
+void tst_QPromise::addResults()
+{
+    QPromise<int> promise;
+    auto f = promise.future();
+
+    // add to the end
+    {
+        QVERIFY(promise.addResults({ 0, 1, 2 }));
+        QCOMPARE(f.resultCount(), 3);
+        QCOMPARE(f.results(), QList<int>({ 0, 1, 2 }));
+    }
+    // empty lists are rejected
+    {
+        QVERIFY(!promise.addResults({}));
+        QCOMPARE(f.resultCount(), 3);
+    }
+    // add at position, after a gap
+    {
+        QVERIFY(promise.addResults({ 5, 6 }, 5));
+        QCOMPARE(f.resultCount(), 3);
+        QVERIFY(promise.addResults({ 3, 4 }, 3));
+        QCOMPARE(f.resultCount(), 7);
+        QCOMPARE(f.results(), QList<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+    }
+    // overwrite does not work
+    {
+        QVERIFY(!promise.addResults({ -1, -1 }, 0));
+        QCOMPARE(f.resultCount(), 7);
+        QCOMPARE(f.resultAt(0), 0);
+    }
+    // mixed with single results
+    {
+        QVERIFY(promise.addResult(7));
+        QVERIFY(promise.addResults({ 8, 9 }));
+        QCOMPARE(f.resultCount(), 10);
+        QCOMPARE(f.resultAt(9), 9);
+    }
+}
+
 #ifndef QT_NO_EXCEPTIONS
 void tst_QPromise::setException()
 {
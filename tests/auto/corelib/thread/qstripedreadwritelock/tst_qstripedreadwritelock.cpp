@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/private/qstripedreadwritelock_p.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+class tst_QStripedReadWriteLock : public QObject
+{
+    Q_OBJECT
+private slots:
+    void stripeCount();
+    void tryLock();
+    void concurrentReaders();
+    void writersExcludeReaders();
+};
+
+void tst_QStripedReadWriteLock::stripeCount()
+{
+    QCOMPARE(QStripedReadWriteLock(1).stripeCount(), 2);
+    QCOMPARE(QStripedReadWriteLock(5).stripeCount(), 8);
+    QCOMPARE(QStripedReadWriteLock(16).stripeCount(), 16);
+    QCOMPARE(QStripedReadWriteLock(1000).stripeCount(), 64);
+    QVERIFY(QStripedReadWriteLock().stripeCount() >= QThread::idealThreadCount()
+            || QStripedReadWriteLock().stripeCount() == 64);
+}
+
+void tst_QStripedReadWriteLock::tryLock()
+{
+    QStripedReadWriteLock lock;
+
+    QVERIFY(lock.tryLockForRead());
+    QVERIFY(lock.tryLockForRead());
+    QVERIFY(!lock.tryLockForWrite());
+    lock.unlockRead();
+    QVERIFY(!lock.tryLockForWrite());
+    lock.unlockRead();
+
+    QVERIFY(lock.tryLockForWrite());
+    QVERIFY(!lock.tryLockForRead());
+    QVERIFY(!lock.tryLockForWrite());
+    lock.unlockWrite();
+
+    {
+        std::shared_lock locker(lock);
+        QVERIFY(!lock.try_lock());
+    }
+    {
+        std::unique_lock locker(lock);
+        QVERIFY(!lock.try_lock_shared());
+    }
+    QVERIFY(lock.try_lock());
+    lock.unlock();
+}
+
+void tst_QStripedReadWriteLock::concurrentReaders()
+{
+    enum { ThreadCount = 8 };
+    QStripedReadWriteLock lock;
+    QSemaphore allLocked;
+    QSemaphore release;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < ThreadCount; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            std::shared_lock locker(lock);
+            allLocked.release();
+            release.acquire();
+        }));
+        threads.back()->start();
+    }
+
+    // all readers hold the lock at the same time
+    QVERIFY(allLocked.tryAcquire(ThreadCount, 10000));
+    QVERIFY(!lock.tryLockForWrite());
+
+    release.release(ThreadCount);
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QVERIFY(lock.tryLockForWrite());
+    lock.unlockWrite();
+}
+
+void tst_QStripedReadWriteLock::writersExcludeReaders()
+{
+    enum { ThreadCount = 8, Iterations = 20000 };
+    QStripedReadWriteLock lock;
+    int first = 0;
+    int second = 0;
+    std::atomic<int> inconsistentReads = 0;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < ThreadCount; ++i) {
+        threads.emplace_back(QThread::create([&, i] {
+            for (int j = 0; j < Iterations; ++j) {
+                if (j % ThreadCount == i) {
+                    std::unique_lock locker(lock);
+                    ++first;
+                    ++second;
+                } else {
+                    std::shared_lock locker(lock);
+                    if (first != second)
+                        ++inconsistentReads;
+                }
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(inconsistentReads.load(), 0);
+    QCOMPARE(first, Iterations);
+    QCOMPARE(second, Iterations);
+}
+
+QTEST_MAIN(tst_QStripedReadWriteLock)
+#include "tst_qstripedreadwritelock.moc"
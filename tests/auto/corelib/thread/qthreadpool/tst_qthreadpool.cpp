@@ -38,6 +38,9 @@
 #ifdef Q_OS_UNIX
 #include <unistd.h>
 #endif
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
 
 typedef void (*FunctionPointer)();
 
@@ -104,10 +107,14 @@ private slots:
     void waitForDoneTimeout();
     void destroyingWaitsForTasksToFinish();
     void stackSize();
+    void cpuAffinity();
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
     void threadReuse();
+    void workStealing();
+    void workStealingSingleThread();
+    void workStealingTryTakeAndClear();
 
 private:
     QMutex m_functionTestMutex;
@@ -1276,6 +1283,29 @@ void tst_QThreadPool::stackSize()
     QCOMPARE(threadStackSize, targetStackSize);
 }
 
+void tst_QThreadPool::cpuAffinity()
+{
+    const QList<int> targetAffinity = { 0 };
+    QList<int> threadAffinity = { -1 }; // impossible value
+    int threadCpu = -1;
+
+    QThreadPool threadPool;
+    QVERIFY(threadPool.cpuAffinity().isEmpty());
+    threadPool.setCpuAffinity(targetAffinity);
+    QCOMPARE(threadPool.cpuAffinity(), targetAffinity);
+    threadPool.start([&] {
+        threadAffinity = QThread::currentThread()->cpuAffinity();
+#ifdef Q_OS_LINUX
+        threadCpu = sched_getcpu();
+#else
+        threadCpu = 0;
+#endif
+    });
+    QVERIFY(threadPool.waitForDone(30000)); // 30s timeout
+    QCOMPARE(threadAffinity, targetAffinity);
+    QCOMPARE(threadCpu, 0);
+}
+
 void tst_QThreadPool::stressTest()
 {
     class Task : public QRunnable
@@ -1460,5 +1490,87 @@ void tst_QThreadPool::threadReuse()
     }
 }
 
+static void spawnRecursively(QThreadPool *pool, QAtomicInt *count, int depth)
+{
+    count->ref();
+    if (depth == 0)
+        return;
+    for (int i = 0; i < 4; ++i)
+        pool->start([=]() { spawnRecursively(pool, count, depth - 1); });
+}
+
+void tst_QThreadPool::workStealing()
+{
+    QThreadPool pool;
+    QVERIFY(!pool.workStealingEnabled());
+    pool.setWorkStealingEnabled(true);
+    QVERIFY(pool.workStealingEnabled());
+    pool.setMaxThreadCount(4);
+
+    QAtomicInt count;
+    pool.start([&]() { spawnRecursively(&pool, &count, 6); });
+    QVERIFY(pool.waitForDone(60000));
+    // 1 + 4 + 16 + ... + 4^6
+    QCOMPARE(count.loadRelaxed(), 5461);
+    QCOMPARE(pool.activeThreadCount(), 0);
+}
+
+void tst_QThreadPool::workStealingSingleThread()
+{
+    // a single thread has nobody to hand its local work to, and
+    // prioritized work from the shared queue must still come first
+    QThreadPool pool;
+    pool.setWorkStealingEnabled(true);
+    pool.setMaxThreadCount(1);
+
+    QMutex mutex;
+    QByteArrayList order;
+    QSemaphore started;
+    QSemaphore proceed;
+    pool.start([&]() {
+        started.release();
+        proceed.acquire();
+        pool.start([&]() { QMutexLocker locker(&mutex); order << "local"; });
+    });
+    started.acquire();
+    pool.start([&]() { QMutexLocker locker(&mutex); order << "low"; }, -1);
+    pool.start([&]() { QMutexLocker locker(&mutex); order << "high"; }, 1);
+    proceed.release();
+
+    QVERIFY(pool.waitForDone(10000));
+    QCOMPARE(order, QByteArrayList({ "high", "local", "low" }));
+}
+
+void tst_QThreadPool::workStealingTryTakeAndClear()
+{
+    QThreadPool pool;
+    pool.setWorkStealingEnabled(true);
+    pool.setMaxThreadCount(1);
+
+    QAtomicInt ran;
+    QSemaphore queued;
+    QSemaphore proceed;
+    QRunnable *kept = QRunnable::create([&]() { ran.ref(); });
+    kept->setAutoDelete(false);
+
+    pool.start([&]() {
+        pool.start(kept);
+        for (int i = 0; i < 10; ++i)
+            pool.start([&]() { ran.ref(); });
+        queued.release();
+        proceed.acquire();
+    });
+
+    QVERIFY(queued.tryAcquire(1, 10000));
+    QVERIFY(pool.tryTake(kept));
+    QVERIFY(!pool.tryTake(kept));
+    pool.clear();
+    proceed.release();
+
+    QVERIFY(pool.waitForDone(10000));
+    QCOMPARE(ran.loadRelaxed(), 0);
+    delete kept;
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
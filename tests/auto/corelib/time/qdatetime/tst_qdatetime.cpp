@@ -2440,6 +2440,14 @@ void tst_QDateTime::fromStringDateFormat_data()
         << Qt::ISODate << QDateTime(QDate(2014, 12, 15), QTime(15, 37, 9, 745), Qt::UTC);
     QTest::newRow("ISO lower-case") << QString::fromLatin1("2005-06-28T07:57:30.002z")
         << Qt::ISODate << QDateTime(QDate(2005, 6, 28), QTime(7, 57, 30, 2), Qt::UTC);
+    QTest::newRow("ISO lower-case t") << QString::fromLatin1("2005-06-28t07:57:30.5+0130")
+        << Qt::ISODate << QDateTime(QDate(2005, 6, 28), QTime(6, 27, 30, 500), Qt::UTC);
+    QTest::newRow("ISO space zzz-05") << QString::fromLatin1("2005-06-28 07:57:30.25-05")
+        << Qt::ISODate << QDateTime(QDate(2005, 6, 28), QTime(12, 57, 30, 250), Qt::UTC);
+    QTest::newRow("ISO invalid day") << QString::fromLatin1("2005-02-30T07:57:30Z")
+        << Qt::ISODate << QDateTime();
+    QTest::newRow("ISO bad offset") << QString::fromLatin1("2005-06-28T07:57:30+24:00")
+        << Qt::ISODate << QDateTime();
     // No time specified - defaults to Qt::LocalTime.
     QTest::newRow("ISO data3") << QString::fromLatin1("2002-10-01")
         << Qt::ISODate << QDateTime(QDate(2002, 10, 1), QTime(0, 0), Qt::LocalTime);
@@ -2667,6 +2675,14 @@ void tst_QDateTime::fromStringDateFormat()
 
     QDateTime dateTime = QDateTime::fromString(dateTimeStr, dateFormat);
     QCOMPARE(dateTime, expected);
+
+    const QByteArray latin1 = dateTimeStr.toLatin1();
+    if (QString::fromLatin1(latin1) == dateTimeStr) {
+        const QDateTime fromLatin1 = QDateTime::fromString(QLatin1String(latin1), dateFormat);
+        QCOMPARE(fromLatin1, expected);
+        QCOMPARE(fromLatin1.timeSpec(), dateTime.timeSpec());
+        QCOMPARE(fromLatin1.offsetFromUtc(), dateTime.offsetFromUtc());
+    }
 }
 
 # if QT_CONFIG(datetimeparser)
@@ -2894,6 +2910,8 @@ void tst_QDateTime::fromStringStringFormat()
     QDateTime dt = QDateTime::fromString(string, format);
 
     QCOMPARE(dt, expected);
+    // Parsing again reuses the format parsed the first time:
+    QCOMPARE(QDateTime::fromString(string, format), dt);
     if (expected.isValid()) {
         QCOMPARE(dt.timeSpec(), expected.timeSpec());
 #if QT_CONFIG(timezone)
@@ -62,6 +62,8 @@ private Q_SLOTS:
     void transitionEachZone();
     void checkOffset_data();
     void checkOffset();
+    void offsetsFromUtc_data();
+    void offsetsFromUtc();
     void stressTest();
     void windowsId();
     void isValidId_data();
@@ -705,6 +707,62 @@ void tst_QTimeZone::checkOffset()
     QCOMPARE(zone.isDaylightTime(when), dstOffset != 0);
 }
 
+void tst_QTimeZone::offsetsFromUtc_data()
+{
+    QTest::addColumn<QByteArray>("zoneName");
+
+    for (const char *name : { "UTC", "Europe/Berlin", "America/New_York", "Australia/Sydney",
+                              "Asia/Kolkata", "Pacific/Apia" }) {
+        if (QTimeZone::isTimeZoneIdAvailable(name))
+            QTest::newRow(name) << QByteArray(name);
+    }
+}
+
+void tst_QTimeZone::offsetsFromUtc()
+{
+    QFETCH(QByteArray, zoneName);
+    const QTimeZone zone(zoneName);
+    QVERIFY(zone.isValid());
+
+    const QDateTime start(QDate(1900, 1, 1), QTime(0, 0), Qt::UTC);
+    const QDateTime end(QDate(2100, 1, 1), QTime(0, 0), Qt::UTC);
+
+    // Every few days, plus either side of each transition
+    QList<qint64> moments;
+    for (qint64 ms = start.toMSecsSinceEpoch(); ms < end.toMSecsSinceEpoch(); ms += 3 * 86400000LL)
+        moments.append(ms);
+    const QTimeZone::OffsetDataList transitions = zone.transitions(start, end);
+    for (const QTimeZone::OffsetData &tran : transitions) {
+        const qint64 ms = tran.atUtc.toMSecsSinceEpoch();
+        moments << ms - 1 << ms << ms + 1;
+    }
+
+    const auto check = [&zone](const QList<qint64> &moments) {
+        const QList<int> offsets = zone.offsetsFromUtc(moments);
+        QCOMPARE(offsets.size(), moments.size());
+        for (qsizetype i = 0; i < moments.size(); ++i) {
+            const QDateTime when = QDateTime::fromMSecsSinceEpoch(moments.at(i), Qt::UTC);
+            QCOMPARE(offsets.at(i), zone.offsetData(when).offsetFromUtc);
+            QCOMPARE(offsets.at(i), zone.offsetFromUtc(when));
+        }
+    };
+
+    check(moments);
+    if (QTest::currentTestFailed())
+        return;
+    std::sort(moments.begin(), moments.end());
+    check(moments);
+    if (QTest::currentTestFailed())
+        return;
+    std::reverse(moments.begin(), moments.end());
+    check(moments);
+    if (QTest::currentTestFailed())
+        return;
+
+    QVERIFY(zone.offsetsFromUtc({}).isEmpty());
+    QCOMPARE(QTimeZone().offsetsFromUtc({ 0, 1 }), QList<int>({ 0, 0 }));
+}
+
 void tst_QTimeZone::availableTimeZoneIds()
 {
     if (debug) {
@@ -30,6 +30,7 @@
 #include <QTest>
 #include <QtCore/QString>
 #include <QtCore/qarraydata.h>
+#include <QtCore/private/qarraydataallocator_p.h>
 
 #include "simplevector.h"
 
@@ -89,6 +90,12 @@ private slots:
     void relocateWithExceptions_data();
     void relocateWithExceptions();
 #endif // QT_NO_EXCEPTIONS
+    void scopedAllocator();
+    void scopedAllocatorIgnoresFlags();
+    void scopedAllocatorAlignment_data();
+    void scopedAllocatorAlignment();
+    void largeBlocks_data();
+    void largeBlocks();
 };
 
 template <class T> const T &const_(const T &t) { return t; }
@@ -2557,5 +2564,187 @@ void tst_QArrayData::relocateWithExceptions()
 }
 #endif // QT_NO_EXCEPTIONS
 
+class CountingAllocator : public QArrayDataAllocator
+{
+public:
+    int allocations = 0;
+    int reallocations = 0;
+    int deallocations = 0;
+
+    void *allocate(size_t size) override
+    {
+        ++allocations;
+        return ::malloc(size);
+    }
+
+    void *reallocate(void *block, size_t, size_t newSize) override
+    {
+        ++reallocations;
+        return ::realloc(block, newSize);
+    }
+
+    void deallocate(void *block, size_t) override
+    {
+        ++deallocations;
+        ::free(block);
+    }
+};
+
+void tst_QArrayData::scopedAllocator()
+{
+    CountingAllocator allocator;
+    QByteArray bytes;
+    QString string;
+    {
+        QArrayDataAllocator::Scope scope(&allocator);
+        bytes = QByteArray(100, 'x');
+        string = QString(50, u'x');
+        {
+            QArrayDataAllocator::Scope inner(nullptr);
+            QByteArray plain(100, 'y');
+        }
+    }
+    QCOMPARE(allocator.allocations, 2);
+    QCOMPARE(allocator.deallocations, 0);
+
+    // the block keeps its allocator after the scope ended
+    for (int i = 0; i < 1000; ++i)
+        bytes.append('z');
+    QVERIFY(allocator.reallocations > 0);
+    QCOMPARE(bytes.size(), 1100);
+    QCOMPARE(bytes.count('x'), 100);
+
+    // detached copies come from wherever the copying thread allocates
+    QByteArray copy = bytes;
+    copy[0] = 'w';
+    QCOMPARE(allocator.allocations, 2);
+    copy = QByteArray();
+    QCOMPARE(allocator.deallocations, 0);
+
+    bytes = QByteArray();
+    string = QString();
+    QCOMPARE(allocator.deallocations, 2);
+}
+
+void tst_QArrayData::scopedAllocatorIgnoresFlags()
+{
+    // Code inlined from older headers copies QArrayData::flags between
+    // blocks, so they must not decide where a block is freed.
+    CountingAllocator allocator;
+    QArrayData *external;
+    QArrayData *plain;
+    {
+        QArrayDataAllocator::Scope scope(&allocator);
+        QVERIFY(QArrayData::allocate(&external, 1, alignof(QArrayData), 100));
+    }
+    QVERIFY(QArrayData::allocate(&plain, 1, alignof(QArrayData), 100));
+
+    const QArrayData::ArrayOptions allFlags = QArrayData::ArrayOptions(QArrayData::ArrayOption(~0));
+    external->flags = {};
+    plain->flags = allFlags;
+
+    auto grown = QArrayData::reallocateUnaligned(external, nullptr, 1, 1000, QArrayData::Grow);
+    QVERIFY(grown.first);
+    QCOMPARE(allocator.reallocations, 1);
+    external = grown.first;
+    external->flags = allFlags;
+    grown = QArrayData::reallocateUnaligned(plain, nullptr, 1, 1000, QArrayData::Grow);
+    QVERIFY(grown.first);
+    QCOMPARE(allocator.reallocations, 1);
+    plain = grown.first;
+    plain->flags = {};
+
+    QArrayData::deallocate(plain, 1, alignof(QArrayData));
+    QCOMPARE(allocator.deallocations, 0);
+    QArrayData::deallocate(external, 1, alignof(QArrayData));
+    QCOMPARE(allocator.deallocations, 1);
+
+    // the same through the inline growing code, copying the flags of a
+    // block from the allocator into a malloc()ed one
+    QArrayDataPointer<char> from;
+    {
+        QArrayDataAllocator::Scope scope(&allocator);
+        from = QArrayDataPointer<char>::allocateGrow(from, 10, QArrayData::GrowsAtEnd);
+    }
+    QCOMPARE(allocator.allocations, 2);
+    auto to = QArrayDataPointer<char>::allocateGrow(from, 100, QArrayData::GrowsAtEnd);
+    QCOMPARE(allocator.allocations, 2);
+    to = {};
+    QCOMPARE(allocator.deallocations, 1);
+    from = {};
+    QCOMPARE(allocator.deallocations, 2);
+}
+
+void tst_QArrayData::scopedAllocatorAlignment_data()
+{
+    QTest::addColumn<qsizetype>("alignment");
+    for (qsizetype alignment = qsizetype(alignof(QArrayData)); alignment <= 128; alignment *= 2)
+        QTest::addRow("%td", alignment) << alignment;
+}
+
+void tst_QArrayData::scopedAllocatorAlignment()
+{
+    QFETCH(qsizetype, alignment);
+    const qsizetype capacity = 1000;
+    CountingAllocator allocator;
+    QArrayData *external;
+    void *externalData;
+    {
+        QArrayDataAllocator::Scope scope(&allocator);
+        externalData = QArrayData::allocate(&external, 1, alignment, capacity);
+    }
+    QVERIFY(externalData);
+    QCOMPARE(allocator.allocations, 1);
+    QCOMPARE(quintptr(externalData) % alignment, quintptr(0));
+    QCOMPARE(external->allocatedCapacity(), capacity);
+    memset(externalData, 'x', capacity + 1);
+
+    QArrayData *plain;
+    void *plainData = QArrayData::allocate(&plain, 1, alignment, capacity);
+    QVERIFY(plainData);
+    QCOMPARE(quintptr(plainData) % alignment, quintptr(0));
+    QCOMPARE(allocator.allocations, 1);
+
+    QArrayData::deallocate(plain, 1, alignment);
+    QCOMPARE(allocator.deallocations, 0);
+    QArrayData::deallocate(external, 1, alignment);
+    QCOMPARE(allocator.deallocations, 1);
+}
+
+void tst_QArrayData::largeBlocks_data()
+{
+    QTest::addColumn<bool>("mapped");
+    QTest::newRow("malloc") << false;
+    QTest::newRow("mapped") << true;
+}
+
+void tst_QArrayData::largeBlocks()
+{
+    QFETCH(bool, mapped);
+    QArrayDataAllocator *allocator = mapped ? QArrayDataAllocator::mappingAllocator() : nullptr;
+    if (mapped && !allocator)
+        QSKIP("This platform cannot remap memory");
+    QArrayDataAllocator::Scope scope(allocator);
+
+    const qsizetype chunkSize = 1024 * 1024;
+    QByteArray chunk(chunkSize, Qt::Uninitialized);
+    for (qsizetype i = 0; i < chunkSize; ++i)
+        chunk[i] = char(i % 251);
+
+    QByteArray buffer;
+    for (int i = 0; i < 24; ++i) {
+        buffer.append(chunk);
+        QCOMPARE(buffer.size(), (i + 1) * chunkSize);
+        QCOMPARE(buffer.at(i * chunkSize + 250), char(250));
+    }
+    for (int i = 0; i < 24; ++i)
+        QVERIFY(QByteArrayView(buffer).sliced(i * chunkSize, chunkSize) == chunk);
+
+    buffer.squeeze();
+    QCOMPARE(buffer.size(), 24 * chunkSize);
+    QVERIFY(QByteArrayView(buffer).last(chunkSize) == chunk);
+    QCOMPARE(buffer.constData()[buffer.size()], '\0');
+}
+
 QTEST_APPLESS_MAIN(tst_QArrayData)
 #include "tst_qarraydata.moc"
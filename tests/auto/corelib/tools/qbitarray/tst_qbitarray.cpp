@@ -89,6 +89,10 @@ private slots:
 
     void toUInt32_data();
     void toUInt32();
+
+    void countRange();
+    void findNextSet();
+    void largeBitwiseOperators();
 };
 
 void tst_QBitArray::size_data()
@@ -760,5 +764,86 @@ void tst_QBitArray::toUInt32()
     QCOMPARE(ok, check);
 }
 
+void tst_QBitArray::countRange()
+{
+    QBitArray bits(300);
+    for (int i = 0; i < bits.size(); i += 3)
+        bits.setBit(i);
+
+    for (int begin = 0; begin <= bits.size(); begin += 7) {
+        for (int end = begin; end <= bits.size(); end += 11) {
+            int expected = 0;
+            for (int i = begin; i < end; ++i)
+                expected += bits.testBit(i);
+            QCOMPARE(bits.count(true, begin, end), expected);
+            QCOMPARE(bits.count(false, begin, end), end - begin - expected);
+        }
+    }
+    QCOMPARE(bits.count(true, 0, bits.size()), bits.count(true));
+}
+
+void tst_QBitArray::findNextSet()
+{
+    QBitArray empty;
+    QCOMPARE(empty.findFirstSet(), -1);
+    QCOMPARE(empty.findNextSet(0), -1);
+
+    QBitArray bits(1000);
+    QCOMPARE(bits.findFirstSet(), -1);
+
+    const QList<int> positions = { 0, 7, 8, 63, 64, 65, 130, 500, 998, 999 };
+    for (int i : positions)
+        bits.setBit(i);
+    QCOMPARE(bits.findFirstSet(), 0);
+
+    QList<int> found;
+    for (qsizetype i = bits.findFirstSet(); i != -1; i = bits.findNextSet(i + 1))
+        found.append(int(i));
+    QCOMPARE(found, positions);
+
+    QCOMPARE(bits.findNextSet(-5), 0);
+    QCOMPARE(bits.findNextSet(131), 500);
+    QCOMPARE(bits.findNextSet(1000), -1);
+
+    QBitArray ones(77, true);
+    for (int i = 0; i < ones.size(); ++i)
+        QCOMPARE(ones.findNextSet(i), i);
+}
+
+void tst_QBitArray::largeBitwiseOperators()
+{
+    // long enough for the vectorized loops, with a tail that is not
+    const int size = 1000;
+    QBitArray a(size), b(size - 100);
+    for (int i = 0; i < size; ++i)
+        a.setBit(i, i % 3 == 0);
+    for (int i = 0; i < b.size(); ++i)
+        b.setBit(i, i % 5 == 0);
+
+    const QBitArray andResult = a & b;
+    const QBitArray orResult = a | b;
+    const QBitArray xorResult = a ^ b;
+    QCOMPARE(andResult.size(), size);
+    QCOMPARE(orResult.size(), size);
+    QCOMPARE(xorResult.size(), size);
+    for (int i = 0; i < size; ++i) {
+        const bool x = a.testBit(i);
+        const bool y = i < b.size() && b.testBit(i);
+        QCOMPARE(andResult.testBit(i), x && y);
+        QCOMPARE(orResult.testBit(i), x || y);
+        QCOMPARE(xorResult.testBit(i), x != y);
+    }
+
+    // the rvalue overloads must give the same results
+    QCOMPARE(QBitArray(a) & b, andResult);
+    QCOMPARE(QBitArray(a) | b, orResult);
+    QCOMPARE(QBitArray(a) ^ b, xorResult);
+
+    QBitArray c = a;
+    c &= QBitArray();
+    QCOMPARE(c.size(), size);
+    QCOMPARE(c.count(true), 0);
+}
+
 QTEST_APPLESS_MAIN(tst_QBitArray)
 #include "tst_qbitarray.moc"
@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <QTest>
+
+#include <private/qconcurrentcache_p.h>
+#include <qatomic.h>
+#include <qstring.h>
+
+#include <thread>
+#include <vector>
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void construction();
+    void insertAndVisit();
+    void costAndEviction();
+    void take();
+    void visitOrInsert();
+    void concurrentAccess();
+};
+
+namespace {
+struct Counted
+{
+    static QAtomicInt instances;
+    int value = 0;
+    Counted(int v = 0) : value(v) { instances.ref(); }
+    ~Counted() { instances.deref(); }
+    Q_DISABLE_COPY_MOVE(Counted)
+};
+QAtomicInt Counted::instances = 0;
+}
+
+void tst_QConcurrentCache::construction()
+{
+    QConcurrentCache<int, Counted> cache(1000, 10);
+    QCOMPARE(cache.shardCount(), 16);
+    QCOMPARE(cache.maxCost(), 1000);
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.totalCost(), 0);
+
+    QConcurrentCache<int, Counted> single(10, 0);
+    QCOMPARE(single.shardCount(), 1);
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(single.insert(i, new Counted(i)));
+    QCOMPARE(single.size(), 10);
+}
+
+void tst_QConcurrentCache::insertAndVisit()
+{
+    {
+        QConcurrentCache<QString, Counted> cache(100, 4);
+        QVERIFY(cache.insert(u"one"_qs, new Counted(1)));
+        QVERIFY(cache.insert(u"two"_qs, new Counted(2)));
+        QVERIFY(cache.contains(u"one"_qs));
+        QVERIFY(!cache.contains(u"three"_qs));
+        QCOMPARE(cache.size(), 2);
+        QCOMPARE(cache.totalCost(), 2);
+
+        int seen = 0;
+        QVERIFY(cache.visit(u"two"_qs, [&](Counted &c) { seen = c.value; }));
+        QCOMPARE(seen, 2);
+        QVERIFY(!cache.visit(u"three"_qs, [&](Counted &) { QFAIL("unexpected visit"); }));
+
+        // replacing deletes the old object
+        QVERIFY(cache.insert(u"one"_qs, new Counted(11)));
+        QCOMPARE(Counted::instances.loadRelaxed(), 2);
+        QVERIFY(cache.visit(u"one"_qs, [&](Counted &c) { seen = c.value; }));
+        QCOMPARE(seen, 11);
+
+        QVERIFY(cache.remove(u"one"_qs));
+        QVERIFY(!cache.remove(u"one"_qs));
+        QCOMPARE(Counted::instances.loadRelaxed(), 1);
+
+        auto keys = cache.keys();
+        QCOMPARE(keys, QList<QString>{ u"two"_qs });
+    }
+    QCOMPARE(Counted::instances.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::costAndEviction()
+{
+    // a single shard behaves exactly like QCache
+    QConcurrentCache<int, Counted> cache(10, 1);
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(cache.insert(i, new Counted(i)));
+    QVERIFY(cache.visit(0, [](Counted &) {}));
+    QVERIFY(cache.insert(10, new Counted(10), 2));
+    QCOMPARE(cache.totalCost(), 10);
+    QVERIFY(cache.contains(0));
+    QVERIFY(!cache.contains(1));
+    QVERIFY(!cache.contains(2));
+    QVERIFY(cache.contains(10));
+
+    QVERIFY(!cache.insert(11, new Counted(11), 11));
+    QVERIFY(!cache.contains(11));
+    QCOMPARE(Counted::instances.loadRelaxed(), 9);
+
+    cache.setMaxCost(4);
+    QCOMPARE(cache.totalCost(), 4);
+    QCOMPARE(Counted::instances.loadRelaxed(), 3);
+
+    cache.clear();
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(Counted::instances.loadRelaxed(), 0);
+
+    // with several shards, the total cost stays within the maximum
+    QConcurrentCache<int, Counted> sharded(64, 8);
+    for (int i = 0; i < 1000; ++i)
+        sharded.insert(i, new Counted(i));
+    QVERIFY(sharded.totalCost() <= 64);
+    QCOMPARE(Counted::instances.loadRelaxed(), sharded.size());
+    sharded.clear();
+    QCOMPARE(Counted::instances.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::take()
+{
+    QConcurrentCache<int, Counted> cache;
+    cache.insert(1, new Counted(1));
+    std::unique_ptr<Counted> taken(cache.take(1));
+    QVERIFY(taken);
+    QCOMPARE(taken->value, 1);
+    QVERIFY(!cache.contains(1));
+    QCOMPARE(cache.take(1), nullptr);
+    taken.reset();
+    QCOMPARE(Counted::instances.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::visitOrInsert()
+{
+    QConcurrentCache<int, Counted> cache(10, 2);
+    int created = 0;
+    int seen = 0;
+    auto create = [&] { ++created; return new Counted(42); };
+    auto visitor = [&](Counted &c) { seen = c.value; };
+
+    QVERIFY(cache.visitOrInsert(1, create, visitor));
+    QCOMPARE(created, 1);
+    QCOMPARE(seen, 42);
+    QVERIFY(cache.visitOrInsert(1, create, visitor));
+    QCOMPARE(created, 1);
+
+    QVERIFY(!cache.visitOrInsert(2, [] { return static_cast<Counted *>(nullptr); }, visitor));
+    QVERIFY(!cache.contains(2));
+    QVERIFY(!cache.visitOrInsert(3, create, visitor, 100));
+    QCOMPARE(created, 2);
+    QVERIFY(!cache.contains(3));
+    cache.clear();
+    QCOMPARE(Counted::instances.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::concurrentAccess()
+{
+    constexpr int ThreadCount = 8;
+    constexpr int KeyCount = 200;
+    QConcurrentCache<int, Counted> cache(KeyCount / 2, 8);
+    QAtomicInt created;
+    QAtomicInt mismatches;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 5000; ++i) {
+                const int key = (i * 7 + t) % KeyCount;
+                cache.visitOrInsert(key, [&] { created.ref(); return new Counted(key); },
+                                    [&](Counted &c) {
+                                        if (c.value != key)
+                                            mismatches.ref();
+                                    });
+                if (i % 13 == 0)
+                    cache.remove(key);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    QCOMPARE(mismatches.loadRelaxed(), 0);
+    QVERIFY(created.loadRelaxed() >= KeyCount / 2);
+    QVERIFY(cache.totalCost() <= cache.maxCost() + cache.shardCount());
+    QCOMPARE(Counted::instances.loadRelaxed(), cache.size());
+    cache.clear();
+    QCOMPARE(Counted::instances.loadRelaxed(), 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentCache)
+#include "tst_qconcurrentcache.moc"
@@ -56,6 +56,8 @@ private slots:
     void files();
     void hashLength_data();
     void hashLength();
+    void chunkedInput_data();
+    void chunkedInput();
     // keep last
     void moreThan4GiBOfData_data();
     void moreThan4GiBOfData();
@@ -426,6 +428,39 @@ void tst_QCryptographicHash::hashLength()
     QCOMPARE(QCryptographicHash::hashLength(algorithm), output.length());
 }
 
+void tst_QCryptographicHash::chunkedInput_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("expected");
+    QTest::newRow("sha1") << QCryptographicHash::Sha1
+                          << QByteArray("4231a8a50a10fa9758db8ec71fdef855b751048a");
+    QTest::newRow("sha224") << QCryptographicHash::Sha224
+                            << QByteArray("23729dacbd480285c5c68439e2fe22ca5611a63cd6c14d2ec5ae2c85");
+    QTest::newRow("sha256") << QCryptographicHash::Sha256
+                            << QByteArray("1e9bc38cbf860b9ec31918b065f9b524"
+                                          "76c549a782e0e7990bed8ce3868d2371");
+}
+
+void tst_QCryptographicHash::chunkedInput()
+{
+    // Feed several blocks' worth of data in chunks that straddle block
+    // boundaries, so both the buffered and the whole-block paths are used.
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const QByteArray, expected);
+
+    QByteArray data(1000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 7 + 3);
+    QCOMPARE(QCryptographicHash::hash(data, algorithm).toHex(), expected);
+
+    for (qsizetype chunk : { 1, 3, 63, 64, 65, 127, 200, 999 }) {
+        QCryptographicHash hash(algorithm);
+        for (qsizetype pos = 0; pos < data.size(); pos += chunk)
+            hash.addData(QByteArrayView(data).mid(pos, chunk));
+        QCOMPARE(hash.result().toHex(), expected);
+    }
+}
+
 void tst_QCryptographicHash::moreThan4GiBOfData_data()
 {
 #if QT_POINTER_SIZE > 4
@@ -47,6 +47,7 @@ private slots:
     void propertyOrderIsNotImportant();
     void bezierSpline_data();
     void bezierSpline();
+    void bezierSplineDense();
     void tcbSpline_data();
     void tcbSpline();
     void testCbrtDouble();
@@ -641,6 +642,37 @@ void tst_QEasingCurve::bezierSpline()
     QVERIFY( !(bezierEasingCurve.valueForProgress(1) < 1) );
 }
 
+void tst_QEasingCurve::bezierSplineDense()
+{
+    // css "ease-in-out"; x(t) is monotonic, so bisection yields the reference
+    const QPointF c1(0.42, 0.0);
+    const QPointF c2(0.58, 1.0);
+    QEasingCurve curve(QEasingCurve::BezierSpline);
+    curve.addCubicBezierSegment(c1, c2, QPointF(1.0, 1.0));
+    const QEasingCurve copy = curve;
+
+    const auto bezier = [](qreal p1, qreal p2, qreal t) {
+        const qreal s = 1 - t;
+        return 3 * s * s * t * p1 + 3 * s * t * t * p2 + t * t * t;
+    };
+
+    for (int i = 0; i <= 1000; ++i) {
+        const qreal x = i / qreal(1000);
+        qreal low = 0;
+        qreal high = 1;
+        for (int step = 0; step < 50; ++step) {
+            const qreal middle = (low + high) / 2;
+            if (bezier(c1.x(), c2.x(), middle) < x)
+                low = middle;
+            else
+                high = middle;
+        }
+        const qreal expected = bezier(c1.y(), c2.y(), low);
+        QVERIFY2(qAbs(curve.valueForProgress(x) - expected) < 1e-4, qPrintable(QString::number(x)));
+        QCOMPARE(copy.valueForProgress(x), curve.valueForProgress(x));
+    }
+}
+
 void tst_QEasingCurve::tcbSpline_data()
 {
     QTest::addColumn<QString>("definition");
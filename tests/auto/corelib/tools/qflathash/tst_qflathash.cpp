@@ -0,0 +1,315 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+
+#include <private/qflathash_p.h>
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qrandom.h>
+#include <qstring.h>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void construction();
+    void insertAndFind();
+    void operatorBrackets();
+    void remove();
+    void iterators();
+    void copyAndMove();
+    void reserve();
+    void randomOperations();
+    void collidingHashes();
+    void insertOwnKey();
+    void nodeLifetime();
+};
+
+namespace {
+struct BadHashKey
+{
+    int value;
+    friend bool operator==(BadHashKey a, BadHashKey b) noexcept { return a.value == b.value; }
+    // Every key lands in the same group and has the same hash fragment
+    friend size_t qHash(BadHashKey, size_t = 0) noexcept { return 42; }
+};
+
+struct Counted
+{
+    static int instances;
+    int value = 0;
+    Counted(int v = 0) : value(v) { ++instances; }
+    Counted(const Counted &o) : value(o.value) { ++instances; }
+    Counted &operator=(const Counted &) = default;
+    ~Counted() { --instances; }
+};
+int Counted::instances = 0;
+}
+
+void tst_QFlatHash::construction()
+{
+    QFlatHash<int, QString> empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), 0);
+    QCOMPARE(empty.capacity(), 0);
+    QVERIFY(!empty.contains(1));
+    QVERIFY(empty.find(1) == empty.end());
+    QVERIFY(empty.begin() == empty.end());
+    QCOMPARE(empty.value(1, "default"), "default");
+    QVERIFY(!empty.remove(1));
+
+    QFlatHash<int, QString> list { { 1, "one" }, { 2, "two" }, { 3, "three" } };
+    QCOMPARE(list.size(), 3);
+    QCOMPARE(list.value(1), "one");
+    QCOMPARE(list.value(2), "two");
+    QCOMPARE(list.value(3), "three");
+}
+
+void tst_QFlatHash::insertAndFind()
+{
+    QFlatHash<QByteArray, int> hash;
+    auto it = hash.insert("foo", 1);
+    QCOMPARE(it.key(), "foo");
+    QCOMPARE(*it, 1);
+    hash.insert("bar", 2);
+    QCOMPARE(hash.size(), 2);
+
+    it = hash.insert("foo", 3);
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(it.value(), 3);
+
+    QVERIFY(hash.contains("foo"));
+    QVERIFY(hash.contains("bar"));
+    QVERIFY(!hash.contains("baz"));
+    QCOMPARE(hash.value("foo"), 3);
+    QCOMPARE(hash.value("baz", -1), -1);
+
+    const auto &constHash = hash;
+    auto cit = constHash.find("bar");
+    QVERIFY(cit != constHash.end());
+    QCOMPARE(cit.key(), "bar");
+    QCOMPARE(cit.value(), 2);
+    QVERIFY(constHash.constFind("baz") == constHash.constEnd());
+}
+
+void tst_QFlatHash::operatorBrackets()
+{
+    QFlatHash<QString, int> hash;
+    QCOMPARE(hash["a"], 0);
+    QCOMPARE(hash.size(), 1);
+    hash["a"] = 5;
+    ++hash["b"];
+    ++hash["b"];
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value("a"), 5);
+    QCOMPARE(hash.value("b"), 2);
+}
+
+void tst_QFlatHash::remove()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 100);
+
+    for (int i = 0; i < 100; i += 2)
+        QVERIFY(hash.remove(i));
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+        if (i % 2)
+            QCOMPARE(hash.value(i), i * 2);
+    }
+
+    // Deleted slots get reused
+    for (int i = 0; i < 100; i += 2)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(i, -1), i * 2);
+
+    for (auto it = hash.begin(); it != hash.end();) {
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 66);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.contains(i), i % 3 != 0);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(1));
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    QHash<int, int> expected;
+    for (int i = 0; i < 1000; ++i) {
+        hash.insert(i * 7, i);
+        expected.insert(i * 7, i);
+    }
+
+    QHash<int, int> seen;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+        QVERIFY(!seen.contains(it.key()));
+        seen.insert(it.key(), it.value());
+    }
+    QCOMPARE(seen, expected);
+
+    for (int &value : hash)
+        value = -value;
+    for (auto it = hash.constBegin(); it != hash.constEnd(); ++it)
+        QCOMPARE(*it, -expected.value(it.key()));
+}
+
+void tst_QFlatHash::copyAndMove()
+{
+    QFlatHash<QString, QString> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(QString::number(i), QString::number(i * i));
+
+    QFlatHash<QString, QString> copy(hash);
+    QCOMPARE(copy.size(), 100);
+    copy.insert("extra", "value");
+    QCOMPARE(copy.size(), 101);
+    QCOMPARE(hash.size(), 100);
+    QVERIFY(!hash.contains("extra"));
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(copy.value(QString::number(i)), QString::number(i * i));
+
+    QFlatHash<QString, QString> moved(std::move(copy));
+    QCOMPARE(moved.size(), 101);
+    QVERIFY(moved.contains("extra"));
+
+    QFlatHash<QString, QString> assigned;
+    assigned = hash;
+    QCOMPARE(assigned.size(), 100);
+    assigned = std::move(moved);
+    QCOMPARE(assigned.size(), 101);
+    QVERIFY(assigned.contains("extra"));
+}
+
+void tst_QFlatHash::reserve()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    const qsizetype capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    // Never shrinks below what is needed
+    hash.reserve(10);
+    QCOMPARE(hash.capacity(), capacity);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+}
+
+void tst_QFlatHash::randomOperations()
+{
+    QFlatHash<QByteArray, int> hash;
+    QHash<QByteArray, int> reference;
+    QRandomGenerator generator(4711);
+    for (int i = 0; i < 50000; ++i) {
+        const QByteArray key = QByteArray::number(generator.bounded(5000));
+        switch (generator.bounded(3)) {
+        case 0:
+        case 1:
+            hash.insert(key, i);
+            reference.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(hash.remove(key), reference.remove(key));
+            break;
+        }
+    }
+    QCOMPARE(hash.size(), reference.size());
+    for (auto it = reference.cbegin(); it != reference.cend(); ++it)
+        QCOMPARE(hash.value(it.key(), -1), it.value());
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it)
+        QCOMPARE(reference.value(it.key(), -1), it.value());
+}
+
+void tst_QFlatHash::collidingHashes()
+{
+    QFlatHash<BadHashKey, int> hash;
+    for (int i = 0; i < 200; ++i)
+        hash.insert({ i }, i);
+    QCOMPARE(hash.size(), 200);
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(hash.value({ i }, -1), i);
+    QVERIFY(!hash.contains({ 200 }));
+
+    for (int i = 0; i < 200; i += 2)
+        QVERIFY(hash.remove({ i }));
+    for (int i = 0; i < 200; ++i)
+        QCOMPARE(hash.contains({ i }), i % 2 == 1);
+}
+
+void tst_QFlatHash::insertOwnKey()
+{
+    // Inserting a key or value that lives in the table must survive the
+    // table growing underneath it
+    QFlatHash<QString, QString> hash;
+    hash.insert("first", "value");
+    for (int i = 0; i < 200; ++i)
+        hash.insert(QString::number(i), hash.begin().value());
+    QCOMPARE(hash.size(), 201);
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it)
+        QCOMPARE(it.value(), "value");
+}
+
+void tst_QFlatHash::nodeLifetime()
+{
+    {
+        QFlatHash<int, Counted> hash;
+        for (int i = 0; i < 500; ++i)
+            hash.insert(i, Counted(i));
+        QCOMPARE(Counted::instances, 500);
+        for (int i = 0; i < 250; ++i)
+            hash.remove(i);
+        QCOMPARE(Counted::instances, 250);
+        QFlatHash<int, Counted> copy = hash;
+        QCOMPARE(Counted::instances, 500);
+        copy.clear();
+        QCOMPARE(Counted::instances, 250);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+
+#include "tst_qflathash.moc"
@@ -57,6 +57,7 @@ private slots:
     void try_emplace_and_insert_or_assign();
     void viewIterators();
     void varLengthArray();
+    void lowerBound();
 
 private:
     template <typename Compare>
@@ -665,5 +666,21 @@ void tst_QFlatMap::varLengthArray()
     QVERIFY(m.isEmpty());
 }
 
+void tst_QFlatMap::lowerBound()
+{
+    using Map = QFlatMap<int, int, std::less<int>, std::vector<int>, std::vector<int>>;
+    for (int size = 0; size < 40; ++size) {
+        Map m;
+        for (int i = 0; i < size; ++i)
+            m.insert(i * 2, i);
+        const auto keys = m.keys();
+        for (int key = -1; key <= size * 2 + 1; ++key) {
+            const auto expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+            QCOMPARE(std::distance(m.cbegin(), std::as_const(m).lower_bound(key)), expected);
+            QCOMPARE(m.contains(key), key >= 0 && key % 2 == 0 && key < size * 2);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QFlatMap)
 #include "tst_qflatmap.moc"
@@ -30,6 +30,7 @@
 
 #include <qhash.h>
 #include <qmap.h>
+#include <qset.h>
 
 #include <algorithm>
 #include <vector>
@@ -103,6 +104,8 @@ private slots:
     void detachAndReferences();
 
     void lookupUsingKeyIterator();
+
+    void heterogeneousSearch();
 };
 
 struct IdentityTracker {
@@ -2742,5 +2745,66 @@ void tst_QHash::lookupUsingKeyIterator()
         QVERIFY(!hash[*it].isEmpty());
 }
 
+void tst_QHash::heterogeneousSearch()
+{
+    QHash<QString, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(QString::number(i), i);
+    const QString longKey(300, u'x');
+    hash.insert(longKey, -1);
+    const auto &constHash = hash;
+
+    for (int i = 0; i < 100; ++i) {
+        const QString key = QString::number(i);
+        const QByteArray latin1 = key.toLatin1();
+        QVERIFY(hash.contains(QStringView(key)));
+        QVERIFY(hash.contains(QLatin1String(latin1)));
+        QCOMPARE(hash.count(QLatin1String(latin1)), 1);
+        QCOMPARE(hash.value(QStringView(key)), i);
+        QCOMPARE(hash.value(QLatin1String(latin1), -2), i);
+        QCOMPARE(constHash[QStringView(key)], i);
+        QCOMPARE(constHash.find(QLatin1String(latin1)).key(), key);
+        QCOMPARE(hash.constFind(QStringView(key)).value(), i);
+    }
+    QCOMPARE(hash.value(QLatin1String(longKey.toLatin1()), -2), -1);
+    QVERIFY(!hash.contains(QStringView(u"100")));
+    QVERIFY(!hash.contains(QLatin1String("100")));
+    QCOMPARE(hash.value(QLatin1String("100"), -2), -2);
+    QVERIFY(hash.find(QStringView(u"100")) == hash.end());
+
+    auto it = hash.find(QStringView(u"42"));
+    QVERIFY(it != hash.end());
+    *it = 4242;
+    QCOMPARE(hash.value(u"42"_qs), 4242);
+
+    // on a non-const hash, operator[] inserts
+    hash[QStringView(u"42")] = 42;
+    QCOMPARE(hash.value(u"42"_qs), 42);
+    hash[QLatin1String("100")] = 100;
+    QCOMPARE(hash.value(u"100"_qs), 100);
+
+    QMultiHash<QByteArray, int> multiHash;
+    multiHash.insert("a", 1);
+    multiHash.insert("a", 2);
+    multiHash.insert("b", 3);
+    QVERIFY(multiHash.contains(QByteArrayView("a")));
+    QVERIFY(!multiHash.contains(QByteArrayView("c")));
+    QCOMPARE(multiHash.count(QByteArrayView("a")), 2);
+    QCOMPARE(multiHash.value(QByteArrayView("b")), 3);
+    QCOMPARE(multiHash.value(QByteArrayView("c"), -1), -1);
+    QCOMPARE(multiHash.values(QByteArrayView("a")), multiHash.values("a"));
+    QCOMPARE(multiHash.constFind(QByteArrayView("b")).value(), 3);
+    QVERIFY(multiHash.constFind(QByteArrayView("c")) == multiHash.constEnd());
+    multiHash[QByteArrayView("c")] = 4;
+    QCOMPARE(multiHash.value("c"), 4);
+
+    QSet<QString> set { u"alpha"_qs, u"beta"_qs };
+    QVERIFY(set.contains(QStringView(u"alpha")));
+    QVERIFY(set.contains(QLatin1String("beta")));
+    QVERIFY(!set.contains(QLatin1String("gamma")));
+    QCOMPARE(*set.constFind(QLatin1String("beta")), u"beta"_qs);
+    QVERIFY(set.constFind(QStringView(u"gamma")) == set.constEnd());
+}
+
 QTEST_APPLESS_MAIN(tst_QHash)
 #include "tst_qhash.moc"
@@ -29,12 +29,16 @@
 
 #include <QTest>
 #include <QBuffer>
+#include <QTemporaryFile>
 
 #include <qimage.h>
 #include <qimagereader.h>
 #include <qlist.h>
 #include <qtransform.h>
 #include <qrandom.h>
+#if QT_CONFIG(thread)
+#include <qthreadpool.h>
+#endif
 #include <stdio.h>
 
 #include <qpainter.h>
@@ -99,6 +103,8 @@ private slots:
 #if !defined(QT_NO_DATASTREAM)
     void loadFromDataStream();
 #endif
+    void fromMappedFile_data();
+    void fromMappedFile();
 
     void setPixel_data();
     void setPixel();
@@ -250,6 +256,10 @@ private slots:
     void largeFillScale();
     void largeRasterScale();
 
+#if QT_CONFIG(thread)
+    void threadedOperations();
+#endif
+
 #if defined(Q_OS_WIN)
     void toWinHBITMAP_data();
     void toWinHBITMAP();
@@ -1334,6 +1344,63 @@ void tst_QImage::loadFromDataStream()
 }
 #endif // QT_NO_DATASTREAM
 
+void tst_QImage::fromMappedFile_data()
+{
+    QTest::addColumn<qint64>("offset");
+    QTest::addColumn<qsizetype>("bytesPerLine");
+    QTest::addColumn<QImage::Format>("format");
+
+    QTest::newRow("mapped") << qint64(8) << qsizetype(40) << QImage::Format_ARGB32;
+    QTest::newRow("mapped RGB888") << qint64(0) << qsizetype(24) << QImage::Format_RGB888;
+    QTest::newRow("unaligned offset") << qint64(3) << qsizetype(40) << QImage::Format_ARGB32;
+    QTest::newRow("unaligned stride") << qint64(8) << qsizetype(23) << QImage::Format_RGB888;
+}
+
+void tst_QImage::fromMappedFile()
+{
+    QFETCH(qint64, offset);
+    QFETCH(qsizetype, bytesPerLine);
+    QFETCH(QImage::Format, format);
+
+    QImage original(7, 5, format);
+    for (int y = 0; y < original.height(); ++y) {
+        for (int x = 0; x < original.width(); ++x)
+            original.setPixel(x, y, qRgba(x * 30, y * 50, 200, 255));
+    }
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QByteArray contents(offset, 'x');
+    const qsizetype lineSize = original.width() * original.depth() / 8;
+    for (int y = 0; y < original.height(); ++y) {
+        QByteArray line(bytesPerLine, 'p');
+        memcpy(line.data(), original.constScanLine(y), lineSize);
+        contents += line;
+    }
+    QCOMPARE(file.write(contents), contents.size());
+    file.close();
+
+    QImage image = QImage::fromMappedFile(file.fileName(), offset, original.size(), bytesPerLine, format);
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.format(), format);
+    QCOMPARE(image, original);
+
+    // modifying the image detaches it from the file
+    image.setPixel(0, 0, qRgb(0, 0, 0));
+    QCOMPARE(image.pixel(0, 0), qRgb(0, 0, 0));
+    QVERIFY(file.open());
+    QCOMPARE(file.readAll(), contents);
+    file.close();
+
+    // too small for the requested geometry
+    QVERIFY(QImage::fromMappedFile(file.fileName(), offset, QSize(7, 6), bytesPerLine, format).isNull());
+    QVERIFY(QImage::fromMappedFile(file.fileName(), offset, original.size(), 4, format).isNull());
+    QVERIFY(QImage::fromMappedFile(file.fileName(), -1, original.size(), bytesPerLine, format).isNull());
+    QVERIFY(QImage::fromMappedFile(file.fileName(), offset, original.size(), bytesPerLine,
+                                   QImage::Format_Indexed8).isNull());
+    QVERIFY(QImage::fromMappedFile(QString(), offset, original.size(), bytesPerLine, format).isNull());
+}
+
 void tst_QImage::setPixel_data()
 {
     QTest::addColumn<int>("format");
@@ -4059,6 +4126,41 @@ void tst_QImage::largeRasterScale()
 //    image.save("largeRasterScale.png", "PNG");
 }
 
+#if QT_CONFIG(thread)
+void tst_QImage::threadedOperations()
+{
+    // Large enough to be split into several segments
+    QImage image(1031, 517, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qRgba(x, y, x ^ y, (x + y) & 0xff);
+    }
+    const QImage premultiplied = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const QTransform rotation = QTransform().rotate(30);
+
+    auto process = [&]() {
+        return QList<QImage> {
+            premultiplied.transformed(QTransform().rotate(90)),
+            premultiplied.transformed(QTransform().rotate(180)),
+            premultiplied.transformed(QTransform().rotate(270)),
+            premultiplied.transformed(rotation, Qt::SmoothTransformation),
+            premultiplied.scaled(1500, 700, Qt::IgnoreAspectRatio, Qt::SmoothTransformation),
+            image.convertToFormat(QImage::Format_RGBA64_Premultiplied),
+        };
+    };
+
+    qt_setImageThreadPool(nullptr);
+    const QList<QImage> serial = process();
+    qt_setImageThreadPool(QThreadPool::globalInstance());
+    const QList<QImage> threaded = process();
+
+    QCOMPARE(serial.size(), threaded.size());
+    for (qsizetype i = 0; i < serial.size(); ++i)
+        QCOMPARE(threaded.at(i), serial.at(i));
+}
+#endif
+
 #if defined(Q_OS_WIN)
 
 static inline QColor COLORREFToQColor(COLORREF cr)
@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QAtomicInt>
+#include <QThread>
+
+#include <qimage.h>
+#include <private/qimagecache_p.h>
+
+#include <memory>
+
+class tst_QImageCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndFind();
+    void statistics();
+    void budget();
+    void trim();
+    void pools();
+    void threads();
+};
+
+static QImage makeImage(int size, QRgb color)
+{
+    QImage image(size, size, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+void tst_QImageCache::insertAndFind()
+{
+    QImageCache cache;
+    const QImage image = makeImage(16, qRgb(255, 0, 0));
+    QVERIFY(cache.insert(QStringLiteral("red"), image));
+
+    QImage found;
+    QVERIFY(cache.find(QStringLiteral("red"), &found));
+    QCOMPARE(found, image);
+    QVERIFY(!cache.find(QStringLiteral("green"), &found));
+    QCOMPARE(found, image);
+
+    QVERIFY(cache.insert(QStringLiteral("red"), makeImage(8, qRgb(255, 0, 0))));
+    QVERIFY(cache.find(QStringLiteral("red"), &found));
+    QCOMPARE(found.width(), 8);
+
+    QVERIFY(cache.remove(QStringLiteral("red")));
+    QVERIFY(!cache.remove(QStringLiteral("red")));
+    QVERIFY(!cache.find(QStringLiteral("red"), nullptr));
+}
+
+void tst_QImageCache::statistics()
+{
+    QImageCache cache(100);
+    cache.insert(QStringLiteral("a"), makeImage(64, qRgb(0, 0, 0))); // 16 kb
+    cache.find(QStringLiteral("a"), nullptr);
+    cache.find(QStringLiteral("a"), nullptr);
+    cache.find(QStringLiteral("b"), nullptr);
+
+    QImageCache::Statistics statistics = cache.statistics();
+    QCOMPARE(statistics.hits, quint64(2));
+    QCOMPARE(statistics.misses, quint64(1));
+    QCOMPARE(statistics.count, 1);
+    QCOMPARE(statistics.totalCost, 16);
+    QCOMPARE(statistics.maxCost, 100);
+
+    cache.resetStatistics();
+    statistics = cache.statistics();
+    QCOMPARE(statistics.hits, quint64(0));
+    QCOMPARE(statistics.misses, quint64(0));
+    QCOMPARE(statistics.count, 1);
+}
+
+void tst_QImageCache::budget()
+{
+    QImageCache cache(40);
+    QVERIFY(cache.insert(QStringLiteral("a"), makeImage(64, qRgb(0, 0, 0))));
+    QVERIFY(cache.insert(QStringLiteral("b"), makeImage(64, qRgb(0, 0, 0))));
+    // touch "a" so that "b" is the least recently used
+    QVERIFY(cache.find(QStringLiteral("a"), nullptr));
+    QVERIFY(cache.insert(QStringLiteral("c"), makeImage(64, qRgb(0, 0, 0))));
+    QVERIFY(cache.find(QStringLiteral("a"), nullptr));
+    QVERIFY(!cache.find(QStringLiteral("b"), nullptr));
+    QVERIFY(cache.find(QStringLiteral("c"), nullptr));
+
+    // larger than the whole budget
+    QVERIFY(!cache.insert(QStringLiteral("d"), makeImage(128, qRgb(0, 0, 0))));
+    QVERIFY(!cache.find(QStringLiteral("d"), nullptr));
+
+    cache.setMaxCost(16);
+    QCOMPARE(cache.statistics().count, 1);
+    QCOMPARE(cache.maxCost(), 16);
+}
+
+void tst_QImageCache::trim()
+{
+    QImageCache cache(1000);
+    for (int i = 0; i < 10; ++i)
+        cache.insert(QString::number(i), makeImage(64, qRgb(0, 0, 0)));
+    QCOMPARE(cache.statistics().totalCost, 160);
+
+    cache.trim(50);
+    QCOMPARE(cache.statistics().totalCost, 80);
+    QCOMPARE(cache.maxCost(), 1000);
+    // the most recently inserted images are kept
+    QVERIFY(cache.find(QStringLiteral("9"), nullptr));
+    QVERIFY(!cache.find(QStringLiteral("0"), nullptr));
+
+    cache.trim(0);
+    QCOMPARE(cache.statistics().count, 0);
+}
+
+void tst_QImageCache::pools()
+{
+    QImageCache *icons = QImageCache::pool(QStringLiteral("tst_qimagecache-icons"));
+    QImageCache *tiles = QImageCache::pool(QStringLiteral("tst_qimagecache-tiles"));
+    QVERIFY(icons);
+    QVERIFY(tiles);
+    QVERIFY(icons != tiles);
+    QCOMPARE(QImageCache::pool(QStringLiteral("tst_qimagecache-icons")), icons);
+    QVERIFY(QImageCache::pools().contains(QStringLiteral("tst_qimagecache-tiles")));
+
+    icons->setMaxCost(16);
+    tiles->setMaxCost(16);
+    QVERIFY(icons->insert(QStringLiteral("icon"), makeImage(64, qRgb(0, 0, 0))));
+    QVERIFY(tiles->insert(QStringLiteral("tile"), makeImage(64, qRgb(0, 0, 0))));
+    // separate budgets, so neither evicts the other
+    QVERIFY(icons->find(QStringLiteral("icon"), nullptr));
+    QVERIFY(tiles->find(QStringLiteral("tile"), nullptr));
+
+    QImageCache::trimPools(0);
+    QVERIFY(!icons->find(QStringLiteral("icon"), nullptr));
+    QVERIFY(!tiles->find(QStringLiteral("tile"), nullptr));
+}
+
+void tst_QImageCache::threads()
+{
+    QImageCache cache(64);
+    QAtomicInt mismatches;
+    const int threadCount = 4;
+    std::unique_ptr<QThread> threads[threadCount];
+    for (int t = 0; t < threadCount; ++t) {
+        threads[t].reset(QThread::create([&cache, &mismatches, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                const QString key = QString::number(t * 1000 + i % 20);
+                QImage image;
+                if (!cache.find(key, &image))
+                    cache.insert(key, makeImage(16, qRgb(t, i % 20, 0)));
+                else if (image.pixel(0, 0) != qRgb(t, i % 20, 0))
+                    mismatches.ref();
+            }
+        }));
+        threads[t]->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+    QCOMPARE(mismatches.loadRelaxed(), 0);
+
+    const QImageCache::Statistics statistics = cache.statistics();
+    QCOMPARE(statistics.hits + statistics.misses, quint64(threadCount * 1000));
+    QVERIFY(statistics.totalCost <= 64);
+}
+
+QTEST_MAIN(tst_QImageCache)
+#include "tst_qimagecache.moc"
@@ -42,6 +42,8 @@
 #include <QTimer>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
+#include <QThreadPool>
+#include <QScopeGuard>
 
 #include <algorithm>
 
@@ -94,6 +96,8 @@ private slots:
     void setScaledClipRect_data();
     void setScaledClipRect();
 
+    void readImages();
+
     void setFormat();
 
     void imageFormat_data();
@@ -431,12 +435,17 @@ void tst_QImageReader::setClipRect_data()
     QTest::newRow("BMP: 4bpp uncompressed") << "tst7.bmp" << QRect(0, 0, 31, 31) << QByteArray("bmp");
     QTest::newRow("XPM: marble") << "marble" << QRect(0, 0, 50, 50) << QByteArray("xpm");
     QTest::newRow("PNG: kollada") << "kollada" << QRect(0, 0, 50, 50) << QByteArray("png");
+    QTest::newRow("PNG: kollada offset") << "kollada" << QRect(13, 17, 50, 40) << QByteArray("png");
+    QTest::newRow("PNG: kollada-16bpc offset") << "kollada-16bpc" << QRect(13, 17, 50, 40) << QByteArray("png");
+    QTest::newRow("PNG: tst7 offset") << "tst7.png" << QRect(3, 5, 20, 20) << QByteArray("png");
     QTest::newRow("PPM: teapot") << "teapot" << QRect(0, 0, 50, 50) << QByteArray("ppm");
     QTest::newRow("PPM: runners") << "runners.ppm" << QRect(0, 0, 50, 50) << QByteArray("ppm");
     QTest::newRow("PPM: test") << "test.ppm" << QRect(0, 0, 50, 50) << QByteArray("ppm");
     QTest::newRow("XBM: gnus") << "gnus" << QRect(0, 0, 50, 50) << QByteArray("xbm");
 
     QTest::newRow("JPEG: beavis") << "beavis" << QRect(0, 0, 50, 50) << QByteArray("jpeg");
+    QTest::newRow("JPEG: beavis offset") << "beavis" << QRect(37, 21, 50, 40) << QByteArray("jpeg");
+    QTest::newRow("JPEG: YCbCr_rgb offset") << "YCbCr_rgb" << QRect(29, 11, 40, 30) << QByteArray("jpeg");
 
     QTest::newRow("GIF: earth") << "earth" << QRect(0, 0, 50, 50) << QByteArray("gif");
     QTest::newRow("GIF: trolltech") << "trolltech" << QRect(0, 0, 50, 50) << QByteArray("gif");
@@ -457,7 +466,7 @@ void tst_QImageReader::setClipRect()
     reader.setClipRect(newRect);
     QImage image = reader.read();
     QVERIFY(!image.isNull());
-    QCOMPARE(image.rect(), newRect);
+    QCOMPARE(image.rect(), QRect(QPoint(0, 0), newRect.size()));
 
     QImageReader originalReader(prefix + fileName);
     QImage originalImage = originalReader.read();
@@ -515,6 +524,51 @@ void tst_QImageReader::setScaledClipRect()
     QCOMPARE(originalImage.copy(newRect), image);
 }
 
+void tst_QImageReader::readImages()
+{
+    const QStringList fileNames = {
+        prefix + "kollada.png",
+        prefix + "beavis.jpg",
+        prefix + "this-file-does-not-exist.png",
+        prefix + "colorful.bmp",
+        prefix + "earth.gif",
+        prefix + "YCbCr_rgb.jpg",
+    };
+
+    // Make sure the concurrent path is taken even on single core machines.
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int oldMaxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(4);
+    auto restoreMaxThreadCount = qScopeGuard([&] { pool->setMaxThreadCount(oldMaxThreadCount); });
+
+    const QList<QImage> images = QImageReader::readImages(fileNames);
+    QCOMPARE(images.size(), fileNames.size());
+    for (qsizetype i = 0; i < fileNames.size(); ++i) {
+        QImageReader reader(fileNames.at(i));
+        reader.setAutoTransform(true);
+        QCOMPARE(images.at(i), reader.read());
+    }
+    QVERIFY(images.at(2).isNull());
+
+    const QSize bound(64, 48);
+    const QList<QImage> scaled = QImageReader::readImages(fileNames, bound);
+    QCOMPARE(scaled.size(), fileNames.size());
+    QVERIFY(scaled.at(2).isNull());
+    for (qsizetype i = 0; i < fileNames.size(); ++i) {
+        if (images.at(i).isNull())
+            continue;
+        const QSize expected = images.at(i).size().scaled(bound, Qt::KeepAspectRatio);
+        QCOMPARE(scaled.at(i).size(), expected);
+
+        QImageReader reader(fileNames.at(i));
+        reader.setAutoTransform(true);
+        reader.setScaledSize(expected);
+        QCOMPARE(scaled.at(i), reader.read());
+    }
+
+    QVERIFY(QImageReader::readImages(QStringList()).isEmpty());
+}
+
 void tst_QImageReader::setFormat()
 {
     QByteArray ppmImage = "P1 2 2\n1 0\n0 1";
@@ -1648,6 +1702,7 @@ void tst_QImageReader::supportsOption_data()
                               << QImageIOHandler::Quality
                               << QImageIOHandler::CompressionRatio
                               << QImageIOHandler::Size
+                              << QImageIOHandler::ClipRect
                               << QImageIOHandler::ScaledSize);
 }
 
@@ -28,6 +28,7 @@
 
 #include <QTest>
 #include <QDebug>
+#include <QBuffer>
 #include <QFile>
 #include <QImage>
 #include <QImageReader>
@@ -84,6 +85,12 @@ private slots:
 
     void writeEmpty();
 
+    void largePng_data();
+    void largePng();
+
+    void jpegFromFormats_data();
+    void jpegFromFormats();
+
 private:
     QTemporaryDir m_temporaryDir;
     QString prefix;
@@ -604,5 +611,88 @@ void tst_QImageWriter::writeEmpty()
     QVERIFY(!QFileInfo(fileName).exists());
 }
 
+void tst_QImageWriter::largePng_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<int>("compression");
+
+    const QImage::Format formats[] = { QImage::Format_RGB32, QImage::Format_ARGB32,
+                                       QImage::Format_RGB888, QImage::Format_Grayscale8 };
+    for (QImage::Format format : formats) {
+        for (int compression : { 0, 1, 6, 9 }) {
+            QTest::addRow("format %d, compression %d", int(format), compression)
+                    << format << compression;
+        }
+    }
+}
+
+void tst_QImageWriter::largePng()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(int, compression);
+
+    // large enough to be compressed in several blocks, with a mix of
+    // smooth gradients and noise
+    QImage image(1021, 767, format);
+    quint32 seed = 1;
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            seed = seed * 1103515245 + 12345;
+            const int noise = (y / 64) % 2 ? int(seed >> 24) : 0;
+            image.setPixel(x, y, qRgba((x + noise) & 0xff, y & 0xff, (x ^ y) & 0xff,
+                                       image.hasAlphaChannel() ? (x * 3) & 0xff : 0xff));
+        }
+    }
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    QImageWriter writer(&buffer, "png");
+    writer.setCompression(compression);
+    QVERIFY2(writer.write(image), qPrintable(writer.errorString()));
+
+    QImage read = QImage::fromData(data, "png");
+    QVERIFY(!read.isNull());
+    QCOMPARE(read.size(), image.size());
+    QCOMPARE(read.convertToFormat(format), image);
+}
+
+void tst_QImageWriter::jpegFromFormats_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+
+    QTest::newRow("RGB32") << QImage::Format_RGB32;
+    QTest::newRow("ARGB32") << QImage::Format_ARGB32;
+    QTest::newRow("ARGB32_Premultiplied") << QImage::Format_ARGB32_Premultiplied;
+    QTest::newRow("RGBX8888") << QImage::Format_RGBX8888;
+    QTest::newRow("RGBA8888") << QImage::Format_RGBA8888;
+}
+
+void tst_QImageWriter::jpegFromFormats()
+{
+    SKIP_IF_UNSUPPORTED("jpeg");
+    QFETCH(QImage::Format, format);
+
+    // opaque, so that all formats hold the same pixels
+    QImage reference(67, 41, QImage::Format_RGB888);
+    for (int y = 0; y < reference.height(); ++y) {
+        for (int x = 0; x < reference.width(); ++x)
+            reference.setPixel(x, y, qRgb(x * 3, y * 5, (x + y) & 0xff));
+    }
+
+    const auto encode = [](const QImage &image) {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        QImageWriter writer(&buffer, "jpeg");
+        writer.setQuality(90);
+        return writer.write(image) ? data : QByteArray();
+    };
+
+    // the encoded file does not depend on the layout of the source pixels
+    const QByteArray expected = encode(reference);
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(encode(reference.convertToFormat(format)), expected);
+}
+
 QTEST_MAIN(tst_QImageWriter)
 #include "tst_qimagewriter.moc"
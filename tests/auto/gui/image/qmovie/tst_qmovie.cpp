@@ -66,6 +66,9 @@ private slots:
 #endif
     void emptyMovie();
     void bindings();
+    void cacheAhead_data();
+    void cacheAhead();
+    void cacheAheadShared();
 };
 
 // Testing get/set functions
@@ -264,5 +267,74 @@ void tst_QMovie::bindings()
     QCOMPARE(cacheModeObserver, QMovie::CacheAll);
 }
 
+void tst_QMovie::cacheAhead_data()
+{
+    playMovie_data();
+}
+
+void tst_QMovie::cacheAhead()
+{
+    QFETCH(QString, fileName);
+    QFETCH(int, frameCount);
+
+    QMovie reference(QFINDTESTDATA(fileName));
+    QMovie movie(QFINDTESTDATA(fileName));
+    movie.setCacheMode(QMovie::CacheAhead);
+    QRect updatedRect;
+    connect(&movie, &QMovie::updated, this, [&](const QRect &rect) { updatedRect = rect; });
+
+    QImage previous;
+    // play twice, to cover looping back to the first frame
+    for (int i = 0; i < 2 * frameCount; ++i) {
+        QVERIFY(reference.jumpToFrame(i % frameCount));
+        QVERIFY(movie.jumpToFrame(i % frameCount));
+        QCOMPARE(movie.currentFrameNumber(), i % frameCount);
+        const QImage image = movie.currentImage();
+        QCOMPARE(image, reference.currentImage());
+        QCOMPARE(movie.nextFrameDelay(), reference.nextFrameDelay());
+
+        // the pixels outside the updated rect did not change
+        if (!previous.isNull() && previous.size() == image.size()) {
+            for (int y = 0; y < image.height(); ++y) {
+                for (int x = 0; x < image.width(); ++x) {
+                    if (!updatedRect.contains(x, y))
+                        QCOMPARE(image.pixel(x, y), previous.pixel(x, y));
+                }
+            }
+        }
+        previous = image;
+    }
+}
+
+void tst_QMovie::cacheAheadShared()
+{
+#ifdef QTEST_HAVE_GIF
+    const QString fileName = QFINDTESTDATA("animations/trolltech.gif");
+    QMovie first(fileName);
+    QMovie second(fileName);
+    first.setCacheMode(QMovie::CacheAhead);
+    second.setCacheMode(QMovie::CacheAhead);
+
+    // the movies are at different positions in the same animation
+    QVERIFY(first.jumpToFrame(10));
+    for (int i = 0; i < 20; ++i) {
+        QVERIFY(second.jumpToFrame(i));
+        QVERIFY(first.jumpToFrame(10 + i));
+    }
+    const QImage frame = first.currentImage();
+    QVERIFY(second.jumpToFrame(29));
+    QCOMPARE(second.currentImage(), frame);
+
+    // changing the settings of one movie does not affect the other
+    second.setScaledSize(QSize(10, 10));
+    QVERIFY(second.jumpToFrame(0));
+    QCOMPARE(second.currentImage().size(), QSize(10, 10));
+    QVERIFY(first.jumpToFrame(30));
+    QVERIFY(first.currentImage().size() != QSize(10, 10));
+#else
+    QSKIP("This test requires the gif image format");
+#endif
+}
+
 QTEST_MAIN(tst_QMovie)
 #include "tst_qmovie.moc"
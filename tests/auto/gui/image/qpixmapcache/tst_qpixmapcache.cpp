@@ -57,6 +57,7 @@ private slots:
     void noLeak();
     void strictCacheLimit();
     void noCrashOnLargeInsert();
+    void statistics();
 };
 
 static QPixmapCache::KeyData* getPrivate(QPixmapCache::Key &key)
@@ -537,5 +538,31 @@ void tst_QPixmapCache::noCrashOnLargeInsert()
     QVERIFY(true); // no crash
 }
 
+void tst_QPixmapCache::statistics()
+{
+    QPixmapCache::clear();
+    qt_resetPixmapCacheStatistics();
+
+    QPixmap pixmap(64, 64);
+    pixmap.fill(Qt::red);
+    QVERIFY(QPixmapCache::insert("red", pixmap));
+    const QPixmapCache::Key key = QPixmapCache::insert(pixmap);
+    QVERIFY(QPixmapCache::find("red", &pixmap));
+    QVERIFY(QPixmapCache::find(key, &pixmap));
+    QVERIFY(!QPixmapCache::find("green", &pixmap));
+
+    QPixmapCacheStatistics statistics = qt_pixmapCacheStatistics();
+    QCOMPARE(statistics.hits, quint64(2));
+    QCOMPARE(statistics.misses, quint64(1));
+    QCOMPARE(statistics.count, 2);
+    QVERIFY(statistics.totalCost > 0);
+    QCOMPARE(statistics.maxCost, QPixmapCache::cacheLimit());
+
+    qt_resetPixmapCacheStatistics();
+    statistics = qt_pixmapCacheStatistics();
+    QCOMPARE(statistics.hits, quint64(0));
+    QCOMPARE(statistics.misses, quint64(0));
+}
+
 QTEST_MAIN(tst_QPixmapCache)
 #include "tst_qpixmapcache.moc"
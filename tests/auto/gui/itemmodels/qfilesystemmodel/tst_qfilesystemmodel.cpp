@@ -130,6 +130,7 @@ private slots:
     void specialFiles();
 
     void fileInfo();
+    void largeDirectory();
 
 protected:
     bool createFiles(QFileSystemModel *model, const QString &test_path,
@@ -1225,6 +1226,54 @@ void tst_QFileSystemModel::fileInfo()
     QCOMPARE(model.fileInfo(idx), QFileInfo(dirPath));
 }
 
+class CountingFileIconProvider : public QAbstractFileIconProvider
+{
+public:
+    QIcon icon(const QFileInfo &info) const override
+    {
+        ++iconCalls;
+        return QAbstractFileIconProvider::icon(info);
+    }
+    QString type(const QFileInfo &info) const override
+    {
+        ++typeCalls;
+        return QAbstractFileIconProvider::type(info);
+    }
+    using QAbstractFileIconProvider::icon;
+
+    mutable int iconCalls = 0;
+    mutable int typeCalls = 0;
+};
+
+void tst_QFileSystemModel::largeDirectory()
+{
+    // more entries than the gatherer stats in one batch
+    const int count = 1000;
+    QStringList files;
+    for (int i = 0; i < count; ++i)
+        files << QString::asprintf("file%04d.txt", i);
+
+    CountingFileIconProvider provider;
+    QFileSystemModel model;
+    model.setIconProvider(&provider);
+    QVERIFY(createFiles(&model, flatDirTestPath, files));
+
+    const QModelIndex root = model.setRootPath(flatDirTestPath);
+    QTRY_COMPARE(model.rowCount(root), count);
+    for (int row = 0; row < count; ++row)
+        QCOMPARE(model.size(model.index(row, 0, root)), qint64(1024));
+
+    // icons and types are only looked up for the files asked for
+    QVERIFY(provider.typeCalls < count);
+    QVERIFY(provider.iconCalls < count);
+    const int typeCalls = provider.typeCalls;
+    const QModelIndex first = model.index(0, 0, root);
+    QCOMPARE(model.type(first), QAbstractFileIconProvider().type(model.fileInfo(first)));
+    QCOMPARE(provider.typeCalls, typeCalls + 1);
+    model.type(first);
+    QCOMPARE(provider.typeCalls, typeCalls + 1);
+}
+
 QTEST_MAIN(tst_QFileSystemModel)
 #include "tst_qfilesystemmodel.moc"
 
@@ -66,6 +66,7 @@ private slots:
     void testSignals();
     void setMimeData();
     void clearBeforeSetText();
+    void fetchData();
 #  ifdef Q_OS_WIN
     void testWindowsMimeRegisterType();
     void testWindowsMime_data();
@@ -449,6 +450,39 @@ void tst_QClipboard::clearBeforeSetText()
     QCOMPARE(QGuiApplication::clipboard()->text(), text);
 }
 
+void tst_QClipboard::fetchData()
+{
+#if QT_CONFIG(future)
+    if (!PlatformClipboard::isAvailable())
+        QSKIP("Native clipboard not working in this setup");
+
+    QClipboard *clipboard = QGuiApplication::clipboard();
+    const QString text = QStringLiteral("tst_QClipboard::fetchData()");
+    clipboard->setText(text);
+
+    QFuture<QByteArray> future = clipboard->fetchData(QStringLiteral("text/plain"));
+    QTRY_VERIFY(future.isFinished());
+    QCOMPARE(future.result(), text.toUtf8());
+
+    future = clipboard->fetchData(QStringLiteral("application/x-tst-qclipboard"));
+    QTRY_VERIFY(future.isFinished());
+    QVERIFY(future.result().isEmpty());
+
+    // images are only encoded in the requested format
+    QImage image(100, 100, QImage::Format_ARGB32);
+    image.fill(QColor(Qt::red));
+    clipboard->setImage(image);
+    future = clipboard->fetchData(QStringLiteral("image/png"));
+    QTRY_VERIFY(future.isFinished());
+    QImage pasted;
+    QVERIFY(pasted.loadFromData(future.result(), "PNG"));
+    QCOMPARE(pasted.size(), image.size());
+    QCOMPARE(pasted.pixel(50, 50), image.pixel(50, 50));
+#else
+    QSKIP("This test requires QFuture support");
+#endif
+}
+
 #  ifdef Q_OS_WIN
 
 using QWindowsMime = QNativeInterface::Private::QWindowsMime;
@@ -108,6 +108,7 @@ private slots:
     void cleanup();
     void testBlockingWindowShownAfterModalDialog();
     void generatedMouseMove();
+    void pointerEventCoalescing();
     void keepPendingUpdateRequests();
     void activateDeactivateEvent();
     void qobject_castOnDestruction();
@@ -2678,6 +2679,100 @@ void tst_QWindow::generatedMouseMove()
     QVERIFY(w.mouseMovedCount == 5);
 }
 
+class PointerHistoryWindow : public QWindow
+{
+public:
+    int mouseMoveCount = 0;
+    int touchUpdateCount = 0;
+    QList<QEventPoint> history;
+    QList<QList<QEventPoint>> touchHistory;
+
+protected:
+    void mouseMoveEvent(QMouseEvent *event) override
+    {
+        ++mouseMoveCount;
+        history = event->point(0).coalescedPoints();
+    }
+    void touchEvent(QTouchEvent *event) override
+    {
+        if (event->type() != QEvent::TouchUpdate)
+            return;
+        ++touchUpdateCount;
+        touchHistory.clear();
+        for (const QEventPoint &point : event->points())
+            touchHistory.append(point.coalescedPoints());
+    }
+};
+
+void tst_QWindow::pointerEventCoalescing()
+{
+    PointerHistoryWindow w;
+    w.setTitle(QLatin1String(QTest::currentTestFunction()));
+    w.setGeometry(QRect(m_availableTopLeft + QPoint(100, 100), m_testWindowSize));
+    w.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&w));
+    QVERIFY(!w.isPointerEventCoalescingEnabled());
+
+    ulong timestamp = 1000;
+    const auto queueMoves = [&](int count, Qt::MouseButtons buttons = Qt::NoButton) {
+        for (int i = 1; i <= count; ++i) {
+            const QPointF local(10 + i, 20 + i);
+            QWindowSystemInterface::handleMouseEvent(&w, timestamp++, local, w.mapToGlobal(local),
+                                                     buttons, Qt::NoButton, QEvent::MouseMove);
+        }
+    };
+
+    // disabled by default: every move is delivered on its own
+    queueMoves(3);
+    QCoreApplication::processEvents();
+    QCOMPARE(w.mouseMoveCount, 3);
+    QCOMPARE(w.history.count(), 1);
+
+    w.setPointerEventCoalescingEnabled(true);
+    QVERIFY(w.isPointerEventCoalescingEnabled());
+    w.mouseMoveCount = 0;
+    queueMoves(4);
+    QCoreApplication::processEvents();
+    QCOMPARE(w.mouseMoveCount, 1);
+    QCOMPARE(w.history.count(), 4);
+    for (int i = 0; i < w.history.count(); ++i) {
+        QCOMPARE(w.history.at(i).position(), QPointF(11 + i, 21 + i));
+        QCOMPARE(w.history.at(i).timestamp(), timestamp - 4 + i);
+    }
+
+    // a change of button state ends the run
+    w.mouseMoveCount = 0;
+    queueMoves(2);
+    queueMoves(2, Qt::LeftButton);
+    QWindowSystemInterface::handleMouseEvent(&w, timestamp++, QPointF(40, 40), w.mapToGlobal(QPointF(40, 40)),
+                                             Qt::NoButton, Qt::LeftButton, QEvent::MouseButtonRelease);
+    QCoreApplication::processEvents();
+    QCOMPARE(w.mouseMoveCount, 3); // two runs, and the move synthesized for the release
+    QCOMPARE(w.history.count(), 1);
+
+    // touch updates of the same points are merged per point
+    QList<QWindowSystemInterface::TouchPoint> points(2);
+    points[0].id = 1;
+    points[1].id = 2;
+    const auto queueTouch = [&](QEventPoint::State state, int offset) {
+        points[0].state = points[1].state = state;
+        points[0].area = QRectF(w.mapToGlobal(QPointF(10 + offset, 10)), QSizeF(4, 4));
+        points[1].area = QRectF(w.mapToGlobal(QPointF(50 + offset, 10)), QSizeF(4, 4));
+        QWindowSystemInterface::handleTouchEvent(&w, timestamp++, touchDevice, points);
+    };
+    queueTouch(QEventPoint::State::Pressed, 0);
+    for (int i = 1; i <= 3; ++i)
+        queueTouch(QEventPoint::State::Updated, i);
+    QCoreApplication::processEvents();
+    QCOMPARE(w.touchUpdateCount, 1);
+    QCOMPARE(w.touchHistory.count(), 2);
+    QCOMPARE(w.touchHistory.at(0).count(), 3);
+    QCOMPARE(w.touchHistory.at(1).count(), 3);
+    QCOMPARE(w.touchHistory.at(1).first().id(), 2);
+    queueTouch(QEventPoint::State::Released, 3);
+    QCoreApplication::processEvents();
+}
+
 void tst_QWindow::keepPendingUpdateRequests()
 {
     QRect geometry(m_availableTopLeft + QPoint(80, 80), m_testWindowSize);
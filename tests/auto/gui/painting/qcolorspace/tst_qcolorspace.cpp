@@ -63,6 +63,8 @@ private slots:
     void imageConversion64();
     void imageConversion64PM_data();
     void imageConversion64PM();
+    void imageConversionMatchesMap_data();
+    void imageConversionMatchesMap();
     void imageConversionOverLargerGamut_data();
     void imageConversionOverLargerGamut();
 
@@ -434,6 +436,38 @@ void tst_QColorSpace::imageConversion64PM()
     }
 }
 
+void tst_QColorSpace::imageConversionMatchesMap_data()
+{
+    imageConversion_data();
+}
+
+void tst_QColorSpace::imageConversionMatchesMap()
+{
+    QFETCH(QColorSpace::NamedColorSpace, fromColorSpace);
+    QFETCH(QColorSpace::NamedColorSpace, toColorSpace);
+    QFETCH(int, tolerance);
+
+    QImage testImage(256, 256, QImage::Format_ARGB32);
+    for (int y = 0; y < 256; ++y) {
+        for (int x = 0; x < 256; ++x)
+            testImage.setPixel(x, y, qRgba(x, y, (x * 7 + y * 13) & 0xff, 255 - y));
+    }
+    testImage.setColorSpace(fromColorSpace);
+
+    const QColorTransform transform = QColorSpace(fromColorSpace).transformationToColorSpace(toColorSpace);
+    const QImage resultImage = testImage.convertedToColorSpace(toColorSpace);
+    for (int y = 0; y < 256; ++y) {
+        for (int x = 0; x < 256; ++x) {
+            const QRgb expected = transform.map(testImage.pixel(x, y));
+            const QRgb p = resultImage.pixel(x, y);
+            QVERIFY(qAbs(qRed(p) - qRed(expected)) <= tolerance + 1);
+            QVERIFY(qAbs(qGreen(p) - qGreen(expected)) <= tolerance + 1);
+            QVERIFY(qAbs(qBlue(p) - qBlue(expected)) <= tolerance + 1);
+            QCOMPARE(qAlpha(p), qAlpha(expected));
+        }
+    }
+}
+
 void tst_QColorSpace::imageConversionOverLargerGamut_data()
 {
     QTest::addColumn<QColorSpace::NamedColorSpace>("fromColorSpace");
@@ -38,13 +38,16 @@
 #include <qbitmap.h>
 #include <qimage.h>
 #include <qthread.h>
+#include <qthreadpool.h>
 #include <limits.h>
 #include <math.h>
 #include <qpaintengine.h>
 #include <qpixmap.h>
 #include <qrandom.h>
+#include <qscopeguard.h>
 
 #include <private/qdrawhelper_p.h>
+#include <private/qpaintengine_raster_p.h>
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qqueue.h>
@@ -301,6 +304,9 @@ private slots:
 
     void drawImageAtPointF();
     void scaledDashes();
+
+    void parallelRasterization_data();
+    void parallelRasterization();
 #if QT_CONFIG(raster_fp)
     void hdrColors();
 #endif
@@ -5396,6 +5402,121 @@ void tst_QPainter::scaledDashes()
     QVERIFY(backFound);
 }
 
+void tst_QPainter::parallelRasterization_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<int>("clip");
+
+    for (QImage::Format format : { QImage::Format_RGB32, QImage::Format_ARGB32_Premultiplied,
+                                   QImage::Format_RGBA64_Premultiplied }) {
+        const QByteArray name = QByteArray::number(int(format));
+        QTest::newRow((name + "-unclipped").constData()) << format << 0;
+        QTest::newRow((name + "-rect-clip").constData()) << format << 1;
+        QTest::newRow((name + "-path-clip").constData()) << format << 2;
+    }
+}
+
+void tst_QPainter::parallelRasterization()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(int, clip);
+
+    // make sure the work is split even on machines with few cores
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    const int maxThreadCount = threadPool->maxThreadCount();
+    threadPool->setMaxThreadCount(4);
+    auto cleanup = qScopeGuard([&] { threadPool->setMaxThreadCount(maxThreadCount); });
+
+    QImage texture(64, 64, QImage::Format_ARGB32_Premultiplied);
+    texture.fill(Qt::transparent);
+    {
+        QPainter p(&texture);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.setBrush(QColor(200, 30, 60, 180));
+        p.drawEllipse(4, 4, 56, 56);
+    }
+
+    auto render = [&](bool parallel, bool gradients) {
+        QImage image(1024, 768, format);
+        image.fill(Qt::white);
+        QPainter p(&image);
+        auto engine = static_cast<QRasterPaintEngine *>(p.paintEngine());
+        engine->setParallelRasterizationEnabled(parallel);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.setRenderHint(QPainter::SmoothPixmapTransform);
+
+        if (clip == 1) {
+            p.setClipRect(37, 51, 900, 600);
+        } else if (clip == 2) {
+            QPainterPath clipPath;
+            clipPath.addEllipse(20, 10, 980, 740);
+            p.setClipPath(clipPath);
+        }
+
+        p.fillRect(image.rect(), QColor(0, 0, 255, 40));
+        p.fillRect(100, 100, 800, 500, Qt::darkGreen);
+
+        QLinearGradient gradient(0, 0, 1024, 768);
+        gradient.setColorAt(0, QColor(255, 0, 0, 200));
+        gradient.setColorAt(1, QColor(0, 0, 255, 100));
+        if (gradients)
+            p.setBrush(gradient);
+        else
+            p.setBrush(QColor(255, 0, 0, 200));
+        p.setPen(QPen(Qt::black, 7.5));
+        p.drawEllipse(QRectF(10.3, 20.7, 990.1, 720.4));
+
+        QPainterPath star;
+        star.moveTo(512, 30);
+        for (int i = 1; i < 11; ++i) {
+            const qreal r = (i & 1) ? 150 : 360;
+            const qreal a = i * M_PI / 5;
+            star.lineTo(512 + r * qSin(a), 384 - r * qCos(a));
+        }
+        p.setBrush(QColor(255, 255, 0, 128));
+        p.setPen(QPen(QColor(0, 128, 0), 3, Qt::DashLine));
+        p.drawPath(star);
+
+        p.rotate(10);
+        p.setOpacity(0.7);
+        p.drawImage(QRectF(200, 50, 600, 500), texture);
+        p.setCompositionMode(QPainter::CompositionMode_Multiply);
+        p.fillRect(QRectF(100.5, 100.5, 700, 400), QBrush(texture));
+        return image;
+    };
+
+    {
+        QImage image(1, 1, format);
+        QPainter p(&image);
+        auto engine = static_cast<QRasterPaintEngine *>(p.paintEngine());
+        engine->setParallelRasterizationEnabled(true);
+        QVERIFY(engine->isParallelRasterizationEnabled());
+        engine->setParallelRasterizationEnabled(false);
+        QVERIFY(!engine->isParallelRasterizationEnabled());
+    }
+
+    QCOMPARE(render(true, false), render(false, false));
+
+    const QImage serial = render(false, true);
+    const QImage parallel = render(true, true);
+
+    // gradients are evaluated incrementally along runs of adjacent spans, and
+    // the bands may split those runs at different positions
+    bool different = false;
+    for (int y = 0; y < serial.height() && !different; ++y) {
+        for (int x = 0; x < serial.width() && !different; ++x) {
+            const QRgba64 a = serial.pixelColor(x, y).rgba64();
+            const QRgba64 b = parallel.pixelColor(x, y).rgba64();
+            const int off = 2 * 257;
+            different = qAbs(a.red() - b.red()) > off || qAbs(a.green() - b.green()) > off
+                    || qAbs(a.blue() - b.blue()) > off || qAbs(a.alpha() - b.alpha()) > off;
+            if (different)
+                qDebug("Different at %d,%d", x, y);
+        }
+    }
+    QVERIFY(!different);
+}
+
 #if QT_CONFIG(raster_fp)
 void tst_QPainter::hdrColors()
 {
@@ -30,9 +30,14 @@
 #include <QtGlobal>
 #include <QtAlgorithms>
 #include <QTemporaryFile>
+#include <QBuffer>
+#include <QtEndian>
 
+#include <QtCore/QRegularExpression>
 #include <QtGui/QAbstractTextDocumentLayout>
+#include <QtGui/QImage>
 #include <QtGui/QPageLayout>
+#include <QtGui/QPainter>
 #include <QtGui/QPdfWriter>
 #include <QtGui/QTextCursor>
 #include <QtGui/QTextDocument>
@@ -46,6 +51,9 @@ private slots:
     void testPageMetrics_data();
     void testPageMetrics();
     void qtbug59443();
+    void crossReferences_data();
+    void crossReferences();
+    void imageDeduplication();
 };
 
 void tst_QPdfWriter::basics()
@@ -282,6 +290,121 @@ void tst_QPdfWriter::qtbug59443()
 
 }
 
+// Returns the offsets of the objects in the cross-reference table or stream of
+// pdf, with -1 for objects that are stored in object streams
+static QList<qint64> objectOffsets(const QByteArray &pdf, bool *hasXrefStream)
+{
+    QList<qint64> offsets;
+    const qsizetype startxref = pdf.lastIndexOf("startxref\n");
+    if (startxref < 0)
+        return offsets;
+    const qint64 xref = pdf.mid(startxref + 10, pdf.indexOf('\n', startxref + 10) - startxref - 10).trimmed().toLongLong();
+
+    *hasXrefStream = !pdf.mid(xref).startsWith("xref\n");
+    if (!*hasXrefStream) {
+        const QList<QByteArray> lines = pdf.mid(xref, startxref - xref).split('\n');
+        const int size = lines.at(1).split(' ').at(1).toInt();
+        for (int i = 0; i < size; ++i)
+            offsets.append(lines.at(2 + i).left(10).toLongLong());
+        return offsets;
+    }
+
+    const QRegularExpression dict(QStringLiteral("^\\d+ 0 obj\n<<\n/Type /XRef\n/Size (\\d+)\n/W \\[1 (\\d) 2\\]\n"
+                                                 "(?:.*\n)*?/Length (\\d+)\n(?:.*\n)*?>>\nstream\n"));
+    const QRegularExpressionMatch match = dict.match(QString::fromLatin1(pdf.mid(xref, 200)));
+    if (!match.hasMatch())
+        return offsets;
+    const int size = match.captured(1).toInt();
+    const int offsetSize = match.captured(2).toInt();
+    const int rowSize = 1 + offsetSize + 2;
+
+    QByteArray compressed(4, '\0');
+    qToBigEndian<quint32>(size * rowSize, compressed.data());
+    compressed += pdf.mid(xref + match.capturedLength(0), match.captured(3).toInt());
+    const QByteArray entries = qUncompress(compressed);
+    if (entries.size() != size * rowSize)
+        return offsets;
+
+    for (int i = 0; i < size; ++i) {
+        const uchar *row = reinterpret_cast<const uchar *>(entries.constData()) + i * rowSize;
+        qint64 field = 0;
+        for (int j = 0; j < offsetSize; ++j)
+            field = (field << 8) | row[1 + j];
+        offsets.append(row[0] == 1 ? field : row[0] == 2 ? -1 : 0);
+    }
+    return offsets;
+}
+
+void tst_QPdfWriter::crossReferences_data()
+{
+    QTest::addColumn<QPagedPaintDevice::PdfVersion>("version");
+    QTest::addColumn<bool>("objectStreams");
+
+    QTest::newRow("1.4") << QPagedPaintDevice::PdfVersion_1_4 << false;
+    QTest::newRow("A-1b") << QPagedPaintDevice::PdfVersion_A1b << false;
+    QTest::newRow("1.6") << QPagedPaintDevice::PdfVersion_1_6 << true;
+}
+
+void tst_QPdfWriter::crossReferences()
+{
+    QFETCH(QPagedPaintDevice::PdfVersion, version);
+    QFETCH(bool, objectStreams);
+
+    QByteArray pdf;
+    {
+        QBuffer buffer(&pdf);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QPdfWriter writer(&buffer);
+        writer.setPdfVersion(version);
+        QPainter painter(&writer);
+        // Enough pages to fill more than one object stream
+        for (int i = 0; i < 150; ++i) {
+            if (i > 0)
+                QVERIFY(writer.newPage());
+            painter.fillRect(QRect(100 + i, 100, 1000, 1000), Qt::blue);
+        }
+    }
+    QVERIFY(pdf.endsWith("%%EOF\n"));
+
+    bool hasXrefStream = false;
+    const QList<qint64> offsets = objectOffsets(pdf, &hasXrefStream);
+    QVERIFY(!offsets.isEmpty());
+    QCOMPARE(hasXrefStream, objectStreams);
+    QCOMPARE(pdf.contains("/Type /ObjStm"), objectStreams);
+    QCOMPARE(offsets.count(-1) >= 150, objectStreams);
+
+    for (int i = 1; i < offsets.size(); ++i) {
+        if (offsets.at(i) <= 0)
+            continue;
+        const QByteArray header = QByteArray::number(i) + " 0 obj\n";
+        QVERIFY2(pdf.mid(offsets.at(i), header.size()) == header, header.constData());
+    }
+}
+
+void tst_QPdfWriter::imageDeduplication()
+{
+    const auto makeImage = [](QColor color) {
+        QImage image(64, 64, QImage::Format_RGB32);
+        image.fill(color);
+        return image;
+    };
+
+    QByteArray pdf;
+    {
+        QBuffer buffer(&pdf);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QPdfWriter writer(&buffer);
+        QPainter painter(&writer);
+        // Separate instances, so that they have different cache keys
+        painter.drawImage(QPoint(0, 0), makeImage(Qt::red));
+        QVERIFY(writer.newPage());
+        painter.drawImage(QPoint(0, 0), makeImage(Qt::red));
+        painter.drawImage(QPoint(100, 0), makeImage(Qt::green));
+    }
+
+    QCOMPARE(pdf.count("/Subtype /Image"), 2);
+}
+
 QTEST_MAIN(tst_QPdfWriter)
 
 #include "tst_qpdfwriter.moc"
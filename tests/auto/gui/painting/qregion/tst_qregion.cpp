@@ -53,6 +53,7 @@ private slots:
     void rects();
     void swap();
     void setRects();
+    void fromRects();
     void ellipseRegion();
     void polygonRegion();
     void bitmapRegion();
@@ -232,6 +233,29 @@ void tst_QRegion::setRects()
     }
 }
 
+void tst_QRegion::fromRects()
+{
+    QCOMPARE(QRegion::fromRects(nullptr, 0), QRegion());
+
+    const QRect empty;
+    QVERIFY(QRegion::fromRects(&empty, 1).isEmpty());
+
+    QList<QRect> rects;
+    QRegion expected;
+    // overlapping and touching rectangles, in no particular order
+    for (int i = 0; i < 200; ++i) {
+        const QRect rect((i * 37) % 211, (i * 53) % 197, 5 + i % 13, 3 + i % 7);
+        rects << rect;
+        expected += rect;
+    }
+    rects << QRect();
+
+    const QRegion region = QRegion::fromRects(rects.constData(), rects.size());
+    QCOMPARE(region, expected);
+    QCOMPARE(region.rectCount(), expected.rectCount());
+    QCOMPARE(region.boundingRect(), expected.boundingRect());
+}
+
 void tst_QRegion::ellipseRegion()
 {
     QRegion region(0, 0, 100, 100, QRegion::Ellipse);
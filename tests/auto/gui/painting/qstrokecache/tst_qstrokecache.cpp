@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <QTest>
+
+#include <qimage.h>
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <private/qstrokecache_p.h>
+
+class tst_QStrokeCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void key();
+    void disabled();
+    void stroke_data();
+    void stroke();
+    void clear();
+
+private:
+    int savedLimit = 0;
+};
+
+static QPainterPath makePath()
+{
+    QPainterPath path;
+    path.moveTo(10, 10);
+    path.cubicTo(90, 10, 10, 90, 90, 90);
+    path.lineTo(10, 60);
+    return path;
+}
+
+static QImage render(const QPainterPath &path, const QPen &pen)
+{
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(pen);
+    p.drawPath(path);
+    return image;
+}
+
+void tst_QStrokeCache::init()
+{
+    savedLimit = QStrokeCache::cacheLimit();
+    QStrokeCache::clear();
+    QStrokeCache::resetStatistics();
+}
+
+void tst_QStrokeCache::cleanup()
+{
+    QStrokeCache::clear();
+    QStrokeCache::setCacheLimit(savedLimit);
+}
+
+void tst_QStrokeCache::key()
+{
+    QPen pen(Qt::black, 4);
+    const QStrokeCache::Key key(QStrokeCache::Outline, pen, 1);
+
+    QCOMPARE(key, QStrokeCache::Key(QStrokeCache::Outline, pen, 1));
+    QVERIFY(key != QStrokeCache::Key(QStrokeCache::TriangleStrip, pen, 1));
+    QVERIFY(key != QStrokeCache::Key(QStrokeCache::Outline, pen, 2));
+
+    // The color does not affect the geometry
+    pen.setColor(Qt::red);
+    QCOMPARE(key, QStrokeCache::Key(QStrokeCache::Outline, pen, 1));
+
+    pen.setJoinStyle(Qt::RoundJoin);
+    QVERIFY(key != QStrokeCache::Key(QStrokeCache::Outline, pen, 1));
+    pen.setJoinStyle(Qt::BevelJoin);
+
+    pen.setDashPattern({ 2, 3 });
+    QVERIFY(key != QStrokeCache::Key(QStrokeCache::Outline, pen, 1));
+}
+
+void tst_QStrokeCache::disabled()
+{
+    QStrokeCache::setCacheLimit(0);
+    QVERIFY(!QStrokeCache::isEnabled());
+
+    const QPainterPath path = makePath();
+    for (int i = 0; i < 3; ++i)
+        render(path, QPen(Qt::black, 6));
+
+    const QStrokeCache::Statistics stats = QStrokeCache::statistics();
+    QCOMPARE(stats.hits, 0u);
+    QCOMPARE(stats.pathCount, 0);
+}
+
+void tst_QStrokeCache::stroke_data()
+{
+    QTest::addColumn<QPen>("pen");
+
+    QTest::newRow("solid") << QPen(Qt::black, 6);
+    QTest::newRow("round") << QPen(Qt::black, 6, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    QTest::newRow("dashed") << QPen(Qt::black, 3, Qt::DashLine);
+}
+
+void tst_QStrokeCache::stroke()
+{
+    QFETCH(QPen, pen);
+
+    QStrokeCache::setCacheLimit(0);
+    const QImage reference = render(makePath(), pen);
+
+    QStrokeCache::setCacheLimit(1024);
+    QVERIFY(QStrokeCache::isEnabled());
+
+    // A path is cached the second time it is stroked and reused afterwards
+    const QPainterPath path = makePath();
+    QCOMPARE(render(path, pen), reference);
+    QCOMPARE(render(path, pen), reference);
+    QCOMPARE(QStrokeCache::statistics().hits, 0u);
+    QCOMPARE(QStrokeCache::statistics().pathCount, 1);
+    QVERIFY(QStrokeCache::statistics().totalCost > 0);
+
+    QCOMPARE(render(path, pen), reference);
+    QCOMPARE(QStrokeCache::statistics().hits, 1u);
+
+    // A different pen is a different variant of the same path
+    QPen otherPen = pen;
+    otherPen.setWidthF(pen.widthF() * 2);
+    const QImage otherReference = render(makePath(), otherPen);
+    render(path, otherPen);
+    QCOMPARE(render(path, otherPen), otherReference);
+    QCOMPARE(QStrokeCache::statistics().pathCount, 1);
+}
+
+void tst_QStrokeCache::clear()
+{
+    QStrokeCache::setCacheLimit(1024);
+
+    {
+        const QPainterPath path = makePath();
+        for (int i = 0; i < 2; ++i)
+            render(path, QPen(Qt::black, 6));
+        QCOMPARE(QStrokeCache::statistics().pathCount, 1);
+    }
+    // Destroying the path drops its entry
+    QCOMPARE(QStrokeCache::statistics().pathCount, 0);
+    QCOMPARE(QStrokeCache::statistics().totalCost, 0);
+
+    const QPainterPath path = makePath();
+    for (int i = 0; i < 2; ++i)
+        render(path, QPen(Qt::black, 6));
+    QCOMPARE(QStrokeCache::statistics().pathCount, 1);
+    QStrokeCache::clear();
+    QCOMPARE(QStrokeCache::statistics().pathCount, 0);
+    QCOMPARE(QStrokeCache::statistics().totalCost, 0);
+}
+
+QTEST_MAIN(tst_QStrokeCache)
+
+#include "tst_qstrokecache.moc"
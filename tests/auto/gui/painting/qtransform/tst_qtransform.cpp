@@ -59,6 +59,8 @@ private slots:
     void projectivePathMapping();
     void mapInt();
     void mapPathWithPoint();
+    void mapPoints_data();
+    void mapPoints();
 
 private:
     void mapping_data();
@@ -725,6 +727,48 @@ void tst_QTransform::mapPathWithPoint()
     QCOMPARE(p.currentPosition(), QPointF(20, 20));
 }
 
+void tst_QTransform::mapPoints_data()
+{
+    QTest::addColumn<QTransform>("transform");
+
+    QTest::newRow("identity") << QTransform();
+    QTest::newRow("translate") << QTransform::fromTranslate(10, -5);
+    QTest::newRow("scale") << QTransform::fromScale(2, 0.5).translate(3, 4);
+    QTest::newRow("rotate") << QTransform().rotate(30).translate(3, 4);
+    QTest::newRow("shear") << QTransform().shear(0.5, 0.25);
+    QTest::newRow("project") << QTransform().rotate(30, Qt::YAxis);
+}
+
+void tst_QTransform::mapPoints()
+{
+    QFETCH(QTransform, transform);
+
+    QPolygonF points;
+    for (int i = 0; i < 37; ++i)
+        points << QPointF(i * 1.5 - 20, 7 - i * 0.25);
+
+    QPolygonF mapped(points.size());
+    transform.map(points.constData(), mapped.data(), points.size());
+    for (int i = 0; i < points.size(); ++i)
+        QCOMPARE(mapped.at(i), transform.map(points.at(i)));
+
+    // in place
+    QPolygonF inPlace = points;
+    transform.map(inPlace.constData(), inPlace.data(), inPlace.size());
+    QCOMPARE(inPlace, mapped);
+
+    if (transform.type() < QTransform::TxProject) {
+        QCOMPARE(transform.map(points), mapped);
+
+        QPainterPath path;
+        path.addPolygon(points);
+        const QPainterPath mappedPath = transform.map(path);
+        QCOMPARE(mappedPath.elementCount(), points.size());
+        for (int i = 0; i < points.size(); ++i)
+            QCOMPARE(QPointF(mappedPath.elementAt(i)), mapped.at(i));
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QTransform)
 
 
@@ -29,6 +29,8 @@
 #include <QTest>
 #include <QThread>
 #include <QFile>
+#include <QDir>
+#include <QStandardPaths>
 #include <QOffscreenSurface>
 #include <QPainter>
 #include <qrgbafloat.h>
@@ -146,6 +148,8 @@ private slots:
 
     void pipelineCache_data();
     void pipelineCache();
+    void persistentPipelineCache_data();
+    void persistentPipelineCache();
     void textureImportOpenGL_data();
     void textureImportOpenGL();
     void renderbufferImportOpenGL_data();
@@ -4390,6 +4394,62 @@ void tst_QRhi::pipelineCache()
     }
 }
 
+void tst_QRhi::persistentPipelineCache_data()
+{
+    rhiTestData();
+}
+
+void tst_QRhi::persistentPipelineCache()
+{
+    QFETCH(QRhi::Implementation, impl);
+    QFETCH(QRhiInitParams *, initParams);
+
+    QStandardPaths::setTestModeEnabled(true);
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+            + QLatin1String("/qtpipelinecache");
+    QDir(cacheDir).removeRecursively();
+
+    QShader vs = loadShader(":/data/simple.vert.qsb");
+    QVERIFY(vs.isValid());
+    QShader fs = loadShader(":/data/simple.frag.qsb");
+    QVERIFY(fs.isValid());
+    QRhiVertexInputLayout inputLayout;
+    inputLayout.setBindings({ { 2 * sizeof(float) } });
+    inputLayout.setAttributes({ { 0, 0, QRhiVertexInputAttribute::Float2, 0 } });
+
+    for (int run = 0; run < 2; ++run) {
+        QScopedPointer<QRhi> rhi(QRhi::create(impl, initParams, QRhi::EnablePersistentPipelineCache));
+        if (!rhi)
+            QSKIP("QRhi could not be created, skipping testing the persistent pipeline cache");
+
+        if (!rhi->isFeatureSupported(QRhi::PipelineCacheDataLoadSave))
+            QSKIP("PipelineCacheDataLoadSave is not supported with this backend, skipping test");
+
+        QScopedPointer<QRhiTexture> texture(rhi->newTexture(QRhiTexture::RGBA8, QSize(256, 256), 1, QRhiTexture::RenderTarget));
+        QVERIFY(texture->create());
+        QScopedPointer<QRhiTextureRenderTarget> rt(rhi->newTextureRenderTarget({ texture.data() }));
+        QScopedPointer<QRhiRenderPassDescriptor> rpDesc(rt->newCompatibleRenderPassDescriptor());
+        rt->setRenderPassDescriptor(rpDesc.data());
+        QVERIFY(rt->create());
+        QScopedPointer<QRhiShaderResourceBindings> srb(rhi->newShaderResourceBindings());
+        QVERIFY(srb->create());
+        QScopedPointer<QRhiGraphicsPipeline> pipeline(rhi->newGraphicsPipeline());
+        pipeline->setShaderStages({ { QRhiShaderStage::Vertex, vs }, { QRhiShaderStage::Fragment, fs } });
+        pipeline->setVertexInputLayout(inputLayout);
+        pipeline->setShaderResourceBindings(srb.data());
+        pipeline->setRenderPassDescriptor(rpDesc.data());
+        QVERIFY(pipeline->create());
+
+        // The second run starts with the data written out when the first
+        // QRhi was destroyed; all we can check is that pipeline creation
+        // still succeeds.
+        if (run == 1 && !rhi->pipelineCacheData().isEmpty())
+            QVERIFY(!QDir(cacheDir).isEmpty());
+    }
+
+    QDir(cacheDir).removeRecursively();
+}
+
 void tst_QRhi::textureImportOpenGL_data()
 {
     rhiTestDataOpenGL();
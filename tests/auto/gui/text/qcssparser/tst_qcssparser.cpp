@@ -66,6 +66,7 @@ private slots:
     void specificitySort();
     void rulesForNode_data();
     void rulesForNode();
+    void classIndex();
     void shorthandBackgroundProperty_data();
     void shorthandBackgroundProperty();
     void pseudoElement_data();
@@ -1361,6 +1362,32 @@ void tst_QCssParser::rulesForNode()
         QCOMPARE(decls.at(1).d->values.at(0).variant.toString(), value1);
 }
 
+void tst_QCssParser::classIndex()
+{
+    QDomDocument doc;
+    QVERIFY(doc.setContent(QString("<!DOCTYPE test><test><p class=\"bar foo bar\" /></test>")));
+
+    QCss::Parser parser(".foo { color: red } .bar { color: green } .baz { color: blue } "
+                        ".foo[lang=en] { color: black } * { color: white }");
+    QCss::StyleSheet sheet;
+    QVERIFY(parser.parse(&sheet));
+    sheet.buildIndexes();
+    QCOMPARE(sheet.classIndex.count(), 4);
+    QCOMPARE(sheet.styleRules.count(), 1);
+
+    DomStyleSelector testSelector(doc, sheet);
+    QDomElement e = doc.documentElement().firstChildElement();
+    QCss::StyleSelector::NodePtr n;
+    n.ptr = &e;
+    const QList<QCss::StyleRule> rules = testSelector.styleRulesForNode(n);
+
+    QStringList values;
+    for (const QCss::StyleRule &rule : rules)
+        values += rule.declarations.at(0).d->values.at(0).variant.toString();
+    // ascending specificity, and each class is only looked up once
+    QCOMPARE(values, QStringList({ "white", "red", "green" }));
+}
+
 void tst_QCssParser::shorthandBackgroundProperty_data()
 {
     QTest::addColumn<QString>("css");
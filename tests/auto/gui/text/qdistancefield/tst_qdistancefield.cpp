@@ -0,0 +1,160 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <QTest>
+#include <QDir>
+#include <QScopeGuard>
+#include <QTemporaryDir>
+
+#include <qfont.h>
+#include <qfontdatabase.h>
+#include <qpainterpath.h>
+#include <qrawfont.h>
+#include <private/qdistancefield_p.h>
+#include <private/qfont_p.h>
+#include <private/qfontengine_p.h>
+
+class tst_QDistanceField : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void createFromRawFont();
+    void createFromPaths();
+    void cache();
+
+private:
+    QList<glyph_t> glyphs(const QRawFont &font) const;
+
+    QString m_testFont;
+    int m_testFontId = -1;
+};
+
+void tst_QDistanceField::initTestCase()
+{
+    m_testFont = QFINDTESTDATA("../../../shared/resources/testfont.ttf");
+    if (m_testFont.isEmpty())
+        QFAIL("qdistancefield: cannot find test font");
+    m_testFontId = QFontDatabase::addApplicationFont(m_testFont);
+    QVERIFY(m_testFontId >= 0);
+    QDistanceField::setCacheDirectory(QString());
+}
+
+void tst_QDistanceField::cleanupTestCase()
+{
+    QFontDatabase::removeApplicationFont(m_testFontId);
+}
+
+QList<glyph_t> tst_QDistanceField::glyphs(const QRawFont &font) const
+{
+    const QList<quint32> indexes = font.glyphIndexesForString(QStringLiteral("Hello, distance fields!"));
+    return QList<glyph_t>(indexes.cbegin(), indexes.cend());
+}
+
+static void compareFields(const QList<QDistanceField> &fields, const QList<QDistanceField> &expected)
+{
+    QCOMPARE(fields.size(), expected.size());
+    for (qsizetype i = 0; i < fields.size(); ++i) {
+        QCOMPARE(fields.at(i).isNull(), expected.at(i).isNull());
+        QCOMPARE(fields.at(i).glyph(), expected.at(i).glyph());
+        QCOMPARE(fields.at(i).width(), expected.at(i).width());
+        QCOMPARE(fields.at(i).height(), expected.at(i).height());
+        QCOMPARE(fields.at(i).toImage(QImage::Format_Alpha8), expected.at(i).toImage(QImage::Format_Alpha8));
+    }
+}
+
+void tst_QDistanceField::createFromRawFont()
+{
+    const QRawFont font(m_testFont, 12);
+    QVERIFY(font.isValid());
+
+    const QList<glyph_t> glyphs = this->glyphs(font);
+    QVERIFY(!glyphs.isEmpty());
+
+    QList<QDistanceField> expected;
+    for (glyph_t glyph : glyphs)
+        expected.append(QDistanceField(font, glyph));
+
+    compareFields(QDistanceField::create(font, glyphs), expected);
+    QVERIFY(QDistanceField::create(font, {}).isEmpty());
+    QCOMPARE(QDistanceField::create(QRawFont(), glyphs).size(), glyphs.size());
+}
+
+void tst_QDistanceField::createFromPaths()
+{
+    const QRawFont font(m_testFont, 200);
+    QVERIFY(font.isValid());
+
+    const QList<glyph_t> glyphs = this->glyphs(font);
+    QList<QPainterPath> paths;
+    QList<QDistanceField> expected;
+    for (glyph_t glyph : glyphs) {
+        paths.append(font.pathForGlyph(glyph));
+        expected.append(QDistanceField(paths.last(), glyph));
+    }
+
+    compareFields(QDistanceField::create(paths, glyphs), expected);
+}
+
+void tst_QDistanceField::cache()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+
+    QFont font(QFontDatabase::applicationFontFamilies(m_testFontId).first());
+    font.setPixelSize(200);
+    QFontEngine *fontEngine = QFontPrivate::get(font)->engineForScript(QChar::Script_Common);
+    QVERIFY(fontEngine);
+    if (fontEngine->faceId().filename.isEmpty())
+        QSKIP("The font engine is not backed by a file");
+
+    const QList<glyph_t> glyphs = this->glyphs(QRawFont::fromFont(font));
+    QList<QDistanceField> expected;
+    for (glyph_t glyph : glyphs)
+        expected.append(QDistanceField(fontEngine, glyph));
+
+    QDistanceField::setCacheDirectory(cacheDir.path());
+    const auto resetCacheDirectory = qScopeGuard([] { QDistanceField::setCacheDirectory(QString()); });
+
+    compareFields(QDistanceField::create(fontEngine, glyphs), expected);
+    const QStringList cached = QDir(cacheDir.path()).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    QCOMPARE(cached.size(), 1);
+    QVERIFY(!QDir(cacheDir.filePath(cached.first())).isEmpty());
+
+    // The second time the distance fields come from the cache
+    compareFields(QDistanceField::create(fontEngine, glyphs), expected);
+}
+
+QTEST_MAIN(tst_QDistanceField)
+
+#include "tst_qdistancefield.moc"
@@ -34,6 +34,7 @@
 #include <QAbstractTextDocumentLayout>
 #include <QSyntaxHighlighter>
 #include <QSignalSpy>
+#include <QThread>
 
 #ifndef QT_NO_WIDGETS
 #include <QTextEdit>
@@ -87,6 +88,7 @@ private slots:
     void noContentsChangedDuringHighlight();
     void rehighlight();
     void rehighlightBlock();
+    void timeSlicedHighlighting();
 #ifndef QT_NO_WIDGETS
     void textEditParent();
 #endif
@@ -560,6 +562,55 @@ void tst_QSyntaxHighlighter::rehighlightBlock()
     QCOMPARE(hl->callCount, 1);
 }
 
+class SlowStateHighlighter : public QSyntaxHighlighter
+{
+public:
+    using QSyntaxHighlighter::QSyntaxHighlighter;
+
+    void highlightBlock(const QString &text) override
+    {
+        ++callCount;
+        // exceed any time slice with every block
+        QThread::msleep(2);
+        setCurrentBlockState(previousBlockState() + 1 + (text.startsWith(QLatin1Char('x')) ? 100 : 0));
+    }
+
+    int callCount = 0;
+};
+
+void tst_QSyntaxHighlighter::timeSlicedHighlighting()
+{
+    const int blockCount = 20;
+    QStringList lines;
+    for (int i = 0; i < blockCount; ++i)
+        lines << QStringLiteral("line");
+    doc->setPlainText(lines.join(QLatin1Char('\n')));
+
+    SlowStateHighlighter *hl = new SlowStateHighlighter(doc);
+    hl->setHighlightingTimeSlice(1);
+    QCOMPARE(hl->highlightingTimeSlice(), 1);
+
+    // the initial highlighting is spread over several slices
+    QTRY_COMPARE(doc->lastBlock().userState(), blockCount - 1);
+    QCOMPARE(hl->callCount, blockCount);
+
+    // only the changed block is highlighted right away, the cascade follows
+    hl->callCount = 0;
+    QTextCursor(doc).insertText(QStringLiteral("x"));
+    QCOMPARE(hl->callCount, 1);
+    QCOMPARE(doc->firstBlock().userState(), 100);
+    QCOMPARE(doc->lastBlock().userState(), blockCount - 1);
+    QTRY_COMPARE(doc->lastBlock().userState(), 100 + blockCount - 1);
+    QCOMPARE(hl->callCount, blockCount);
+
+    // a full rehighlight is still synchronous
+    hl->callCount = 0;
+    hl->rehighlight();
+    QCOMPARE(hl->callCount, blockCount);
+    QCoreApplication::processEvents();
+    QCOMPARE(hl->callCount, blockCount);
+}
+
 #ifndef QT_NO_WIDGETS
 void tst_QSyntaxHighlighter::textEditParent()
 {
@@ -205,6 +205,8 @@ private slots:
     void insertHtmlWithComments_data();
     void insertHtmlWithComments();
 
+    void setLargePlainText();
+
 private:
     void backgroundImage_checkExpectedHtml(const QTextDocument &doc);
     void buildRegExpData();
@@ -3960,4 +3962,30 @@ void tst_QTextDocument::insertHtmlWithComments()
 }
 
 QTEST_MAIN(tst_QTextDocument)
+void tst_QTextDocument::setLargePlainText()
+{
+    const int lineCount = 100000;
+    QString text;
+    for (int i = 0; i < lineCount; ++i) {
+        text += QString::number(i);
+        text += (i % 2) ? QLatin1String("\r\n") : QLatin1String("\n");
+    }
+
+    QTextDocument document;
+    document.setPlainText(QLatin1String("previous\ncontent"));
+    document.setPlainText(text);
+    QCOMPARE(document.blockCount(), lineCount + 1);
+    QCOMPARE(document.findBlockByNumber(0).text(), QLatin1String("0"));
+    QCOMPARE(document.findBlockByNumber(lineCount - 1).text(), QString::number(lineCount - 1));
+    QVERIFY(document.lastBlock().text().isEmpty());
+
+    // Appending after the bulk load keeps working on the same buffer.
+    QTextCursor cursor(&document);
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(QLatin1String("tail\nend"));
+    QCOMPARE(document.blockCount(), lineCount + 2);
+    QCOMPARE(document.lastBlock().text(), QLatin1String("end"));
+    QCOMPARE(document.lastBlock().previous().text(), QLatin1String("tail"));
+}
+
 #include "tst_qtextdocument.moc"
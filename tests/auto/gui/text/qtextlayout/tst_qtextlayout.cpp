@@ -150,6 +150,7 @@ private slots:
     void softHyphens_data();
     void softHyphens();
     void min_maximumWidth();
+    void shapingCache();
 
 private:
     QFont testFont;
@@ -2708,5 +2709,40 @@ void tst_QTextLayout::min_maximumWidth()
     }
 }
 
+void tst_QTextLayout::shapingCache()
+{
+    QTextShapingCache *cache = QFontCache::instance()->shapingCache();
+    if (cache->maxCost() == 0)
+        QSKIP("The shaping cache is disabled");
+    cache->clear();
+    cache->resetStatistics();
+
+    const QString text = QStringLiteral("Shaping cache test");
+    auto layoutGlyphs = [&]() {
+        QTextLayout layout(text, testFont);
+        layout.beginLayout();
+        layout.createLine();
+        layout.endLayout();
+        return layout.glyphRuns();
+    };
+
+    const QList<QGlyphRun> uncached = layoutGlyphs();
+    if (cache->misses() == 0)
+        QSKIP("Text is not shaped with HarfBuzz on this platform");
+    QCOMPARE(cache->hits(), quint64(0));
+    QVERIFY(cache->totalCost() > 0);
+
+    const QList<QGlyphRun> cached = layoutGlyphs();
+    QVERIFY(cache->hits() > 0);
+    QCOMPARE(cached.size(), uncached.size());
+    for (int i = 0; i < cached.size(); ++i) {
+        QCOMPARE(cached.at(i).glyphIndexes(), uncached.at(i).glyphIndexes());
+        QCOMPARE(cached.at(i).positions(), uncached.at(i).positions());
+    }
+
+    cache->clear();
+    QCOMPARE(cache->totalCost(), 0);
+}
+
 QTEST_MAIN(tst_QTextLayout)
 #include "tst_qtextlayout.moc"
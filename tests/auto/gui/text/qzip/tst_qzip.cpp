@@ -29,6 +29,8 @@
 #include <QTest>
 #include <QDebug>
 #include <QBuffer>
+#include <QTemporaryDir>
+#include <QThreadPool>
 
 #include <private/qzipwriter_p.h>
 #include <private/qzipreader_p.h>
@@ -42,6 +44,10 @@ private slots:
     void symlinks();
     void readTest();
     void createArchive();
+    void entryLookup();
+    void entryDevice_data();
+    void entryDevice();
+    void parallelCompression();
 };
 
 void tst_QZip::basicUnpack()
@@ -137,5 +143,108 @@ void tst_QZip::createArchive()
     QCOMPARE(zip2.fileData("My Filename"), fileContents);
 }
 
+void tst_QZip::entryLookup()
+{
+    QZipReader zip(QFINDTESTDATA("/testdata/symlink.zip"), QIODevice::ReadOnly);
+    QZipReader::FileInfo fi = zip.entryInfo("destination");
+    QVERIFY(fi.isValid());
+    QVERIFY(fi.isFile);
+    QCOMPARE(fi.filePath, QString("destination"));
+    QCOMPARE(fi.size, qint64(zip.fileData("destination").size()));
+
+    QVERIFY(!zip.entryInfo("no such entry").isValid());
+    QVERIFY(!zip.entryDevice("no such entry"));
+}
+
+void tst_QZip::entryDevice_data()
+{
+    QTest::addColumn<bool>("mapped");
+    QTest::addColumn<bool>("compress");
+
+    QTest::newRow("buffer-compressed") << false << true;
+    QTest::newRow("buffer-stored") << false << false;
+    QTest::newRow("file-compressed") << true << true;
+    QTest::newRow("file-stored") << true << false;
+}
+
+void tst_QZip::entryDevice()
+{
+    QFETCH(bool, mapped);
+    QFETCH(bool, compress);
+
+    QByteArray contents;
+    for (int i = 0; i < 20000; ++i)
+        contents += "line " + QByteArray::number(i) + '\n';
+
+    QByteArray archive;
+    {
+        QBuffer buffer(&archive);
+        QZipWriter writer(&buffer);
+        writer.setCompressionPolicy(compress ? QZipWriter::AlwaysCompress
+                                             : QZipWriter::NeverCompress);
+        writer.addFile("small", QByteArray("tiny"));
+        writer.addFile("dir/large", contents);
+        writer.close();
+    }
+
+    QTemporaryDir dir;
+    QBuffer buffer(&archive);
+    QFile file(dir.filePath("archive.zip"));
+    if (mapped) {
+        QVERIFY(dir.isValid());
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(archive), qint64(archive.size()));
+        file.close();
+        QVERIFY(file.open(QIODevice::ReadOnly));
+    } else {
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+    }
+    QZipReader reader(mapped ? static_cast<QIODevice *>(&file) : &buffer);
+    QCOMPARE(reader.count(), 2);
+    QCOMPARE(reader.fileData("dir/large"), contents);
+
+    QScopedPointer<QIODevice> entry(reader.entryDevice("dir/large"));
+    QVERIFY(entry);
+    QVERIFY(entry->isSequential());
+    QCOMPARE(entry->bytesAvailable(), qint64(contents.size()));
+    QByteArray read;
+    while (!entry->atEnd())
+        read += entry->read(1000);
+    QCOMPARE(read, contents);
+
+    entry.reset(reader.entryDevice("small"));
+    QVERIFY(entry);
+    QCOMPARE(entry->readAll(), QByteArray("tiny"));
+}
+
+void tst_QZip::parallelCompression()
+{
+    QList<QByteArray> contents;
+    for (int i = 0; i < 50; ++i)
+        contents.append(QByteArray::number(i).repeated(1000 + 97 * i));
+
+    QThreadPool pool;
+    QBuffer buffer;
+    QZipWriter writer(&buffer);
+    QCOMPARE(writer.threadPool(), nullptr);
+    writer.setThreadPool(&pool);
+    QCOMPARE(writer.threadPool(), &pool);
+    for (int i = 0; i < contents.size(); ++i)
+        writer.addFile(QString::number(i), contents.at(i));
+    writer.close();
+
+    QByteArray archive = buffer.buffer();
+    QBuffer readBuffer(&archive);
+    QZipReader reader(&readBuffer);
+    const QList<QZipReader::FileInfo> files = reader.fileInfoList();
+    QCOMPARE(files.size(), contents.size());
+    // entries keep the order they were added in
+    for (int i = 0; i < contents.size(); ++i) {
+        QCOMPARE(files.at(i).filePath, QString::number(i));
+        QCOMPARE(reader.fileData(QString::number(i)), contents.at(i));
+    }
+    QVERIFY(archive.size() < contents.last().size());
+}
+
 QTEST_MAIN(tst_QZip)
 #include "tst_qzip.moc"
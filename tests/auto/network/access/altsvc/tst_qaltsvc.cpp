@@ -0,0 +1,191 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qurl.h>
+
+#include <QtNetwork/private/qaltsvc_p.h>
+
+QT_USE_NAMESPACE
+
+using Headers = QList<QPair<QByteArray, QByteArray>>;
+
+class tst_QAltSvc : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void headerParser_data();
+    void headerParser();
+    void parameters();
+    void cache();
+};
+
+void tst_QAltSvc::headerParser_data()
+{
+    QTest::addColumn<QByteArray>("value");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<QByteArrayList>("protocols");
+    QTest::addColumn<QStringList>("hosts");
+    QTest::addColumn<QList<int>>("ports");
+
+    QTest::newRow("h3") << QByteArray("h3=\":443\"") << true
+                        << QByteArrayList{"h3"} << QStringList{QString()} << QList<int>{443};
+    QTest::newRow("with-host") << QByteArray("h2=\"alt.example.com:8000\"") << true
+                               << QByteArrayList{"h2"} << QStringList{"alt.example.com"}
+                               << QList<int>{8000};
+    QTest::newRow("ipv6") << QByteArray("h3=\"[::1]:4433\"") << true << QByteArrayList{"h3"}
+                          << QStringList{"::1"} << QList<int>{4433};
+    QTest::newRow("list") << QByteArray("h3=\":443\"; ma=3600, h3-29=\":443\",,h2=\":8443\"")
+                          << true << QByteArrayList{"h3", "h3-29", "h2"}
+                          << QStringList{QString(), QString(), QString()}
+                          << QList<int>{443, 443, 8443};
+    QTest::newRow("percent-encoded") << QByteArray("w%3Dx%3Ay=\":80\"") << true
+                                     << QByteArrayList{"w=x:y"} << QStringList{QString()}
+                                     << QList<int>{80};
+    QTest::newRow("escaped-pair") << QByteArray("h2=\"\\a:1\"") << true << QByteArrayList{"h2"}
+                                  << QStringList{"a"} << QList<int>{1};
+
+    const QByteArrayList none;
+    QTest::newRow("empty") << QByteArray() << false << none << QStringList() << QList<int>();
+    QTest::newRow("no-port") << QByteArray("h3=\"example.com\"") << false << none
+                             << QStringList() << QList<int>();
+    QTest::newRow("port-0") << QByteArray("h3=\":0\"") << false << none << QStringList()
+                            << QList<int>();
+    QTest::newRow("port-too-big") << QByteArray("h3=\":65536\"") << false << none
+                                  << QStringList() << QList<int>();
+    QTest::newRow("unquoted") << QByteArray("h3=:443") << false << none << QStringList()
+                              << QList<int>();
+    QTest::newRow("unterminated") << QByteArray("h3=\":443") << false << none
+                                  << QStringList() << QList<int>();
+    QTest::newRow("garbage-after") << QByteArray("h3=\":443\" h2") << false << none
+                                   << QStringList() << QList<int>();
+    QTest::newRow("bad-ma") << QByteArray("h3=\":443\"; ma=-1") << false << none
+                            << QStringList() << QList<int>();
+    QTest::newRow("clear-in-list") << QByteArray("clear, h3=\":443\"") << false << none
+                                   << QStringList() << QList<int>();
+}
+
+void tst_QAltSvc::headerParser()
+{
+    QFETCH(const QByteArray, value);
+    QFETCH(const bool, valid);
+    QFETCH(const QByteArrayList, protocols);
+    QFETCH(const QStringList, hosts);
+    QFETCH(const QList<int>, ports);
+
+    QAltSvcHeaderParser parser;
+    QCOMPARE(parser.parse({{"Alt-Svc", value}}), valid);
+    QVERIFY(!parser.clearAlternatives());
+
+    const QList<QAltSvcEntry> entries = parser.alternatives();
+    QCOMPARE(entries.size(), protocols.size());
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        QCOMPARE(entries[i].protocolId, protocols[i]);
+        QCOMPARE(entries[i].host, hosts[i]);
+        QCOMPARE(int(entries[i].port), ports[i]);
+    }
+}
+
+void tst_QAltSvc::parameters()
+{
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    QAltSvcHeaderParser parser;
+    QVERIFY(parser.parse({{"alt-svc", "h3=\":443\"; ma=60; persist=1; foo=\"bar;baz\""},
+                          {"Content-Type", "text/plain"},
+                          {"ALT-SVC", "h2=\":443\"; persist=0"}}));
+    const QList<QAltSvcEntry> entries = parser.alternatives();
+    QCOMPARE(entries.size(), 2);
+
+    QVERIFY(entries[0].persist);
+    QVERIFY(entries[0].expires >= now.addSecs(60));
+    QVERIFY(entries[0].expires < now.addSecs(120));
+
+    // No 'ma' means 24 hours:
+    QVERIFY(!entries[1].persist);
+    QVERIFY(entries[1].expires >= now.addSecs(24 * 60 * 60));
+
+    QVERIFY(parser.parse({{"Alt-Svc", " clear "}}));
+    QVERIFY(parser.clearAlternatives());
+    QVERIFY(parser.alternatives().isEmpty());
+
+    // 'clear' is case-sensitive:
+    QVERIFY(!parser.parse({{"Alt-Svc", "Clear"}}));
+}
+
+void tst_QAltSvc::cache()
+{
+    const QUrl origin(QLatin1String("https://example.com/index.html"));
+    const QUrl sameOrigin(QLatin1String("https://EXAMPLE.com:443/other"));
+    const QUrl otherPort(QLatin1String("https://example.com:8443"));
+    const QUrl insecure(QLatin1String("http://example.com"));
+
+    QAltSvcCache cache;
+    QVERIFY(cache.alternatives(origin).isEmpty());
+
+    cache.updateFromHeaders({{"Alt-Svc", "h3=\":443\", h2=\"alt.example.com:443\""}}, origin);
+    QList<QAltSvcEntry> entries = cache.alternatives(sameOrigin);
+    QCOMPARE(entries.size(), 2);
+    // An empty host in the authority means the origin's host:
+    QCOMPARE(entries[0].host, QLatin1String("example.com"));
+    QCOMPARE(entries[1].host, QLatin1String("alt.example.com"));
+    QVERIFY(cache.alternatives(otherPort).isEmpty());
+    QVERIFY(cache.alternatives(insecure).isEmpty());
+
+    // A malformed header does not change anything:
+    cache.updateFromHeaders({{"Alt-Svc", "h3="}}, origin);
+    QCOMPARE(cache.alternatives(origin).size(), 2);
+
+    // A new header replaces what the origin advertised before:
+    cache.updateFromHeaders({{"Alt-Svc", "h3-29=\":443\""}}, origin);
+    entries = cache.alternatives(origin);
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries[0].protocolId, QByteArray("h3-29"));
+
+    // Expired alternatives are dropped:
+    cache.updateFromHeaders({{"Alt-Svc", "h3=\":443\"; ma=0"}}, origin);
+    QVERIFY(cache.alternatives(origin).isEmpty());
+
+    cache.updateFromHeaders({{"Alt-Svc", "h3=\":443\""}}, origin);
+    QCOMPARE(cache.alternatives(origin).size(), 1);
+    cache.updateFromHeaders({{"Alt-Svc", "clear"}}, origin);
+    QVERIFY(cache.alternatives(origin).isEmpty());
+
+    cache.updateFromHeaders({{"Alt-Svc", "h3=\":443\""}}, origin);
+    cache.clear();
+    QVERIFY(cache.alternatives(origin).isEmpty());
+}
+
+QTEST_MAIN(tst_QAltSvc)
+
+#include "tst_qaltsvc.moc"
@@ -637,7 +637,7 @@ void Http2Server::handleIncomingFrame()
         // TODO: this is not tested for now.
         break;
     case FrameType::PING:
-        // TODO: this is not tested for now.
+        handlePING();
         break;
     case FrameType::GOAWAY:
         // TODO: this is not tested for now.
@@ -680,6 +680,34 @@ void Http2Server::handleSETTINGS()
     const uchar *src = inboundFrame.dataBegin();
     const uchar *end = src + inboundFrame.dataSize();
 
+    if (!waitingClientSettings) {
+        // Not a part of the preface: the client autotunes its receive window.
+        for (; src != end; src += 6) {
+            const auto id = Http2::Settings(qFromBigEndian<quint16>(src));
+            const auto value = qFromBigEndian<quint32>(src + 2);
+            if (id != Settings::INITIAL_WINDOW_SIZE_ID) {
+                emit invalidFrame();
+                connectionError = true;
+                return;
+            }
+            const quint32 oldValue = clientSetting(id, Http2::defaultSessionWindowSize);
+            expectedClientSettings[id] = value;
+            emit clientStreamWindowChanged(value);
+            if (value > oldValue) {
+                // 6.9.2: the change applies to the streams that are open already.
+                std::vector<quint32> streams;
+                for (const auto &stream : suspendedStreams)
+                    streams.push_back(stream.first);
+                for (const quint32 streamID : streams)
+                    sendDATA(streamID, value - oldValue);
+            }
+        }
+
+        writer.start(FrameType::SETTINGS, FrameFlag::ACK, connectionStreamID);
+        writer.write(*socket);
+        return;
+    }
+
     const auto notFound = expectedClientSettings.end();
 
     while (src != end) {
@@ -702,6 +730,18 @@ void Http2Server::handleSETTINGS()
     emit clientPrefaceOK();
 }
 
+void Http2Server::handlePING()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::PING);
+
+    if (inboundFrame.flags().testFlag(FrameFlag::ACK))
+        return;
+
+    writer.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
+    writer.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
+    writer.write(*socket);
+}
+
 void Http2Server::handleDATA()
 {
     Q_ASSERT(inboundFrame.type() == FrameType::DATA);
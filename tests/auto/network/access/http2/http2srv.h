@@ -112,6 +112,7 @@ public:
     Q_INVOKABLE void handleConnectionPreface();
     Q_INVOKABLE void handleIncomingFrame();
     Q_INVOKABLE void handleSETTINGS();
+    Q_INVOKABLE void handlePING();
     Q_INVOKABLE void handleDATA();
     Q_INVOKABLE void handleWINDOW_UPDATE();
 
@@ -136,6 +137,8 @@ Q_SIGNALS:
     // Emitted for every DATA frame. Includes the content of the frame as \a body.
     void receivedDATAFrame(quint32 streamID, const QByteArray &body);
     void windowUpdate(quint32 streamID);
+    // Emitted for a SETTINGS_INITIAL_WINDOW_SIZE the client sent after the preface:
+    void clientStreamWindowChanged(quint32 windowSize);
     void sendingData();
 
 private slots:
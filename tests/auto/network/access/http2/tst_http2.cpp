@@ -97,6 +97,7 @@ private slots:
     void multipleRequests();
     void flowControlClientSide();
     void flowControlServerSide();
+    void windowAutoTuning();
     void pushPromise();
     void goaway_data();
     void goaway();
@@ -428,6 +429,48 @@ void tst_Http2::flowControlServerSide()
     QVERIFY(serverGotSettingsACK);
 }
 
+void tst_Http2::windowAutoTuning()
+{
+    // The client starts with the default 64 Kb stream window and has
+    // to grow it while receiving responses that are much larger.
+    clearHTTP2State();
+
+    serverPort = 0;
+    nRequests = 3;
+
+    QHttp2Configuration params = qt_defaultH2Configuration();
+    params.setStreamReceiveWindowSize(Http2::defaultSessionWindowSize);
+    params.setWindowAutoTuningEnabled(true);
+
+    ServerPtr srv(newServer(defaultServerSettings, defaultConnectionType(),
+                            qt_H2ConfigurationToSettings(params)));
+    quint32 clientStreamWindow = 0;
+    connect(srv.data(), &Http2Server::clientStreamWindowChanged, this,
+            [&clientStreamWindow](quint32 windowSize) {
+                QVERIFY(windowSize > clientStreamWindow);
+                clientStreamWindow = windowSize;
+            });
+
+    const QByteArray respond(int(Http2::defaultSessionWindowSize * 200), 'x');
+    srv->setResponseBody(respond);
+
+    QMetaObject::invokeMethod(srv.data(), "startServer", Qt::QueuedConnection);
+
+    runEventLoop();
+    QVERIFY(serverPort != 0);
+
+    for (int i = 0; i < nRequests; ++i)
+        sendRequest(i, QNetworkRequest::NormalPriority, {}, params);
+
+    runEventLoop(120000);
+    STOP_ON_FAILURE
+
+    QVERIFY(nRequests == 0);
+    QVERIFY(prefaceOK);
+    QVERIFY(serverGotSettingsACK);
+    QVERIFY(clientStreamWindow > Http2::defaultSessionWindowSize);
+}
+
 void tst_Http2::pushPromise()
 {
     // We will first send some request, the server should reply and also emulate
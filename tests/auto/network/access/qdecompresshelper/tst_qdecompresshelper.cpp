@@ -68,6 +68,9 @@ private Q_SLOTS:
     void archiveBomb();
 
     void bigZlib();
+
+    void dictionary_data();
+    void dictionary();
 };
 
 void tst_QDecompressHelper::initTestCase()
@@ -111,6 +114,15 @@ void tst_QDecompressHelper::encodingSupported()
     ++expected;
 #endif
     QCOMPARE(expected, accepted.size());
+
+    const QByteArrayList &acceptedDictionary = QDecompressHelper::acceptedDictionaryEncoding();
+    for (const QByteArray &encoding : acceptedDictionary) {
+        QVERIFY(QDecompressHelper::isSupportedEncoding(encoding));
+        QVERIFY(!accepted.contains(encoding));
+    }
+#if QT_CONFIG(zstd)
+    QVERIFY(acceptedDictionary.contains("dcz"));
+#endif
 }
 
 void tst_QDecompressHelper::sharedDecompress_data()
@@ -465,6 +477,48 @@ void tst_QDecompressHelper::bigZlib()
 #endif
 }
 
+void tst_QDecompressHelper::dictionary_data()
+{
+    QTest::addColumn<QByteArray>("dictionary");
+    QTest::addColumn<bool>("countAhead");
+    QTest::addColumn<bool>("shouldFail");
+
+    const QByteArray dictionary("{\"status\": \"ok\", \"results\": [], \"pagination\": ");
+    QTest::newRow("dictionary") << dictionary << false << false;
+    QTest::newRow("dictionary-countAhead") << dictionary << true << false;
+    QTest::newRow("no-dictionary") << QByteArray() << false << true;
+    QTest::newRow("wrong-dictionary") << QByteArray("{\"status\": ") << false << true;
+}
+
+void tst_QDecompressHelper::dictionary()
+{
+    QFETCH(QByteArray, dictionary);
+    QFETCH(bool, countAhead);
+    QFETCH(bool, shouldFail);
+
+    // zlib stream compressed with a preset dictionary
+    const QByteArray data = QByteArray::fromBase64("ePlbuA6kqyZJdV5pTk4tAKt/ENw=");
+    const QByteArray expected("{\"status\": \"ok\", \"results\": [], \"pagination\": null}");
+
+    QDecompressHelper helper;
+    helper.setCountingBytesEnabled(countAhead);
+    helper.setDictionary(dictionary);
+    QCOMPARE(helper.dictionary(), dictionary);
+    QVERIFY(helper.setEncoding("deflate"));
+    helper.feed(data);
+    if (countAhead && !shouldFail)
+        QCOMPARE(helper.uncompressedSize(), expected.size());
+
+    QByteArray actual(expected.size(), Qt::Uninitialized);
+    const qsizetype read = helper.read(actual.data(), actual.size());
+    if (shouldFail) {
+        QCOMPARE(read, -1);
+        return;
+    }
+    QCOMPARE(read, expected.size());
+    QCOMPARE(actual, expected);
+}
+
 QTEST_MAIN(tst_QDecompressHelper)
 
 #include "tst_qdecompresshelper.moc"
@@ -45,6 +45,8 @@ private Q_SLOTS:
 
     void parseEndOfHeader_data();
     void parseEndOfHeader();
+
+    void headerFieldLookup();
 };
 
 void tst_QHttpNetworkReply::parseHeader_data()
@@ -108,6 +110,36 @@ void tst_QHttpNetworkReply::parseHeader()
     }
 }
 
+void tst_QHttpNetworkReply::headerFieldLookup()
+{
+    QHttpHeaderParser parser;
+    QVERIFY(parser.parseHeaders("Content-Type: text/html\r\n"
+                                "content-length: 10\r\n"
+                                "X-Custom:\r\n a\r\n b\r\n"
+                                "CONTENT-LENGTH: 20\r\n"
+                                "Vary: Cookie\r\n"
+                                "vary: User-Agent\r\n"));
+    QCOMPARE(parser.headers().size(), 6);
+    // names keep their original spelling
+    QCOMPARE(parser.headers().at(1).first, "content-length");
+    QCOMPARE(parser.headers().at(2).second, "a b");
+
+    QCOMPARE(parser.firstHeaderField("Content-Length"), "10");
+    QCOMPARE(parser.firstHeaderField(QByteArrayView("content-type")), "text/html");
+    QCOMPARE(parser.firstHeaderField("Content-Typ", "missing"), "missing");
+    QCOMPARE(parser.firstHeaderField("Content-Types", "missing"), "missing");
+    QCOMPARE(parser.headerFieldValues("VARY"), QList<QByteArray>({ "Cookie", "User-Agent" }));
+    QCOMPARE(parser.combinedHeaderValue("vary"), "Cookie, User-Agent");
+
+    parser.removeHeaderField("Content-length");
+    QCOMPARE(parser.headers().size(), 4);
+    QVERIFY(parser.headerFieldValues("content-length").isEmpty());
+
+    parser.setHeaderField("X-CUSTOM", "c");
+    QCOMPARE(parser.headerFieldValues("x-custom"), QList<QByteArray>({ "c" }));
+    QCOMPARE(parser.headers().last().first, "X-CUSTOM");
+}
+
 // both constants are taken from the default settings of Apache
 // see: http://httpd.apache.org/docs/2.2/mod/core.html#limitrequestfieldsize and
 // http://httpd.apache.org/docs/2.2/mod/core.html#limitrequestfields
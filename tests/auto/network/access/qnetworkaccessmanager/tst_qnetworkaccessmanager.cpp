@@ -30,9 +30,74 @@
 
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
+#if QT_CONFIG(http)
+#include <QtNetwork/QHttpConnectionPoolConfiguration>
+#endif
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
 
 #include <QtCore/QDebug>
 
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Accepts HTTP/1.1 requests and answers them with empty keep-alive responses
+// once release() was called, so that tests can observe how many connections
+// the manager opens while its requests are pending.
+class KeepAliveServer : public QTcpServer
+{
+public:
+    KeepAliveServer()
+    {
+        connect(this, &QTcpServer::newConnection, this, [this] {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                ++connectionCount;
+                ++openConnectionCount;
+                sockets.append(socket);
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket] {
+                    buffers[socket] += socket->readAll();
+                    respond(socket);
+                });
+                connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+                    --openConnectionCount;
+                    sockets.removeOne(socket);
+                    buffers.remove(socket);
+                    socket->deleteLater();
+                });
+            }
+        });
+    }
+
+    void release()
+    {
+        released = true;
+        for (QTcpSocket *socket : std::as_const(sockets))
+            respond(socket);
+    }
+
+    int connectionCount = 0;
+    int openConnectionCount = 0;
+
+private:
+    void respond(QTcpSocket *socket)
+    {
+        if (!released)
+            return;
+        QByteArray &buffer = buffers[socket];
+        qsizetype end;
+        while ((end = buffer.indexOf("\r\n\r\n")) >= 0) {
+            buffer.remove(0, end + 4);
+            socket->write("HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n");
+        }
+    }
+
+    QList<QTcpSocket *> sockets;
+    QHash<QTcpSocket *, QByteArray> buffers;
+    bool released = false;
+};
+
 class tst_QNetworkAccessManager : public QObject
 {
     Q_OBJECT
@@ -42,6 +107,14 @@ public:
 
 private slots:
     void alwaysCacheRequest();
+#if QT_CONFIG(http)
+    void connectionPoolConfiguration();
+    void maximumConnectionsPerHost_data();
+    void maximumConnectionsPerHost();
+    void maximumIdleConnectionsPerHost();
+    void preconnectCount();
+    void httpThreadCount();
+#endif
 };
 
 tst_QNetworkAccessManager::tst_QNetworkAccessManager()
@@ -59,5 +132,204 @@ void tst_QNetworkAccessManager::alwaysCacheRequest()
     delete reply;
 }
 
+#if QT_CONFIG(http)
+void tst_QNetworkAccessManager::connectionPoolConfiguration()
+{
+    QHttpConnectionPoolConfiguration config;
+    QCOMPARE(config.maximumConnectionsPerHost(), 6);
+    QCOMPARE(config.maximumIdleConnectionsPerHost(), -1);
+    QCOMPARE(config.idleTimeout(), 120s);
+    QCOMPARE(config.preconnectCount(), 1);
+
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: Invalid number of connections per host");
+    QVERIFY(!config.setMaximumConnectionsPerHost(0));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: Invalid number of connections per host");
+    QVERIFY(!config.setMaximumConnectionsPerHost(70000));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: Invalid number of idle connections per host");
+    QVERIFY(!config.setMaximumIdleConnectionsPerHost(-2));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: Invalid idle timeout");
+    QVERIFY(!config.setIdleTimeout(-1s));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: Invalid preconnect count");
+    QVERIFY(!config.setPreconnectCount(0));
+    QCOMPARE(config, QHttpConnectionPoolConfiguration());
+
+    QVERIFY(config.setMaximumConnectionsPerHost(64));
+    QVERIFY(config.setMaximumIdleConnectionsPerHost(16));
+    QVERIFY(config.setIdleTimeout(30s));
+    QVERIFY(config.setPreconnectCount(8));
+    QCOMPARE(config.maximumConnectionsPerHost(), 64);
+    QCOMPARE(config.maximumIdleConnectionsPerHost(), 16);
+    QCOMPARE(config.idleTimeout(), 30s);
+    QCOMPARE(config.preconnectCount(), 8);
+    QVERIFY(config != QHttpConnectionPoolConfiguration());
+
+    QNetworkAccessManager manager;
+    QCOMPARE(manager.connectionPoolConfiguration(), QHttpConnectionPoolConfiguration());
+    QCOMPARE(manager.connectionPoolConfiguration("example.com"), QHttpConnectionPoolConfiguration());
+
+    manager.setConnectionPoolConfiguration("Example.COM", config);
+    QCOMPARE(manager.connectionPoolConfiguration("example.com"), config);
+    QCOMPARE(manager.connectionPoolConfiguration("example.org"), QHttpConnectionPoolConfiguration());
+    QCOMPARE(manager.connectionPoolConfiguration(), QHttpConnectionPoolConfiguration());
+
+    QHttpConnectionPoolConfiguration defaultConfig;
+    defaultConfig.setMaximumConnectionsPerHost(2);
+    manager.setConnectionPoolConfiguration(defaultConfig);
+    QCOMPARE(manager.connectionPoolConfiguration("example.org"), defaultConfig);
+    QCOMPARE(manager.connectionPoolConfiguration("example.com"), config);
+
+    manager.resetConnectionPoolConfiguration("example.com");
+    QCOMPARE(manager.connectionPoolConfiguration("example.com"), defaultConfig);
+}
+
+void tst_QNetworkAccessManager::maximumConnectionsPerHost_data()
+{
+    QTest::addColumn<int>("defaultMaximum");
+    QTest::addColumn<int>("hostMaximum");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("default") << -1 << -1 << 6;
+    QTest::newRow("1") << 1 << -1 << 1;
+    QTest::newRow("10") << 10 << -1 << 10;
+    QTest::newRow("host override") << 10 << 3 << 3;
+}
+
+void tst_QNetworkAccessManager::maximumConnectionsPerHost()
+{
+    QFETCH(int, defaultMaximum);
+    QFETCH(int, hostMaximum);
+    QFETCH(int, expected);
+
+    KeepAliveServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    if (defaultMaximum > 0) {
+        QHttpConnectionPoolConfiguration config;
+        config.setMaximumConnectionsPerHost(defaultMaximum);
+        manager.setConnectionPoolConfiguration(config);
+    }
+    if (hostMaximum > 0) {
+        QHttpConnectionPoolConfiguration config;
+        config.setMaximumConnectionsPerHost(hostMaximum);
+        manager.setConnectionPoolConfiguration("127.0.0.1", config);
+    }
+
+    const QUrl url(QString("http://127.0.0.1:%1/").arg(server.serverPort()));
+    const int requestCount = 12;
+    int finished = 0;
+    QList<QNetworkReply *> replies;
+    for (int i = 0; i < requestCount; ++i) {
+        QNetworkReply *reply = manager.get(QNetworkRequest(url));
+        connect(reply, &QNetworkReply::finished, this, [&finished] { ++finished; });
+        replies.append(reply);
+    }
+
+    QTRY_COMPARE(server.connectionCount, expected);
+    server.release();
+    QTRY_COMPARE(finished, requestCount);
+    for (QNetworkReply *reply : std::as_const(replies)) {
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        delete reply;
+    }
+    QCOMPARE(server.connectionCount, expected);
+}
+
+void tst_QNetworkAccessManager::maximumIdleConnectionsPerHost()
+{
+    KeepAliveServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    QHttpConnectionPoolConfiguration config;
+    config.setMaximumConnectionsPerHost(4);
+    config.setMaximumIdleConnectionsPerHost(1);
+    manager.setConnectionPoolConfiguration(config);
+
+    const QUrl url(QString("http://127.0.0.1:%1/").arg(server.serverPort()));
+    int finished = 0;
+    for (int i = 0; i < 4; ++i) {
+        QNetworkReply *reply = manager.get(QNetworkRequest(url));
+        connect(reply, &QNetworkReply::finished, this, [&finished, reply] {
+            ++finished;
+            reply->deleteLater();
+        });
+    }
+
+    QTRY_COMPARE(server.openConnectionCount, 4);
+    server.release();
+    QTRY_COMPARE(finished, 4);
+    QTRY_COMPARE(server.openConnectionCount, 1);
+}
+
+void tst_QNetworkAccessManager::preconnectCount()
+{
+    KeepAliveServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    QHttpConnectionPoolConfiguration config;
+    config.setPreconnectCount(3);
+    manager.setConnectionPoolConfiguration(config);
+
+    manager.connectToHost("127.0.0.1", server.serverPort());
+    QTRY_COMPARE(server.connectionCount, 3);
+
+    // The pre-warmed connections are used by the following requests:
+    const QUrl url(QString("http://127.0.0.1:%1/").arg(server.serverPort()));
+    server.release();
+    int finished = 0;
+    for (int i = 0; i < 3; ++i) {
+        QNetworkReply *reply = manager.get(QNetworkRequest(url));
+        connect(reply, &QNetworkReply::finished, this, [&finished, reply] {
+            ++finished;
+            reply->deleteLater();
+        });
+    }
+    QTRY_COMPARE(finished, 3);
+    QCOMPARE(server.connectionCount, 3);
+}
+
+void tst_QNetworkAccessManager::httpThreadCount()
+{
+    QNetworkAccessManager manager;
+    QCOMPARE(manager.httpThreadCount(), 1);
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QNetworkAccessManager::setHttpThreadCount: invalid count 0");
+    manager.setHttpThreadCount(0);
+    QCOMPARE(manager.httpThreadCount(), 1);
+    manager.setHttpThreadCount(4);
+    QCOMPARE(manager.httpThreadCount(), 4);
+
+    // Requests to several hosts are spread over the threads, but each host
+    // stays on one thread and keeps reusing its connection.
+    std::vector<std::unique_ptr<KeepAliveServer>> servers;
+    for (int i = 0; i < 6; ++i) {
+        servers.push_back(std::make_unique<KeepAliveServer>());
+        QVERIFY(servers.back()->listen(QHostAddress::LocalHost));
+        servers.back()->release();
+    }
+
+    for (int round = 0; round < 3; ++round) {
+        int finished = 0;
+        QList<QNetworkReply *> replies;
+        for (const auto &server : servers) {
+            const QUrl url(QString("http://127.0.0.1:%1/").arg(server->serverPort()));
+            QNetworkReply *reply = manager.get(QNetworkRequest(url));
+            connect(reply, &QNetworkReply::finished, this, [&finished] { ++finished; });
+            replies.append(reply);
+        }
+        QTRY_COMPARE(finished, int(servers.size()));
+        for (QNetworkReply *reply : std::as_const(replies)) {
+            QCOMPARE(reply->error(), QNetworkReply::NoError);
+            delete reply;
+        }
+    }
+
+    for (const auto &server : servers)
+        QCOMPARE(server->connectionCount, 1);
+}
+#endif // QT_CONFIG(http)
+
 QTEST_MAIN(tst_QNetworkAccessManager)
 #include "tst_qnetworkaccessmanager.moc"
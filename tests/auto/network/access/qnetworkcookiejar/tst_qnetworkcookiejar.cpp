@@ -56,6 +56,8 @@ private slots:
 #endif
     void rfc6265_data();
     void rfc6265();
+    void manyDomains();
+    void expiredCookiesAreDiscarded();
 };
 
 class MyCookieJar: public QNetworkCookieJar
@@ -597,6 +599,74 @@ void tst_QNetworkCookieJar::rfc6265()
     }
 }
 
+void tst_QNetworkCookieJar::manyDomains()
+{
+    MyCookieJar jar;
+    QList<QNetworkCookie> inserted;
+    for (int i = 0; i < 200; ++i) {
+        const QUrl url(QString::fromLatin1("http://www.host%1.example.com/").arg(i % 50));
+        QNetworkCookie cookie(QByteArray("c") + QByteArray::number(i), "v");
+        if ((i / 50) % 2)
+            cookie.setDomain(QString::fromLatin1(".host%1.example.com").arg(i % 50));
+        cookie.setPath(i % 3 ? QStringLiteral("/") : QStringLiteral("/dir"));
+        QVERIFY(jar.setCookiesFromUrl({ cookie }, url));
+        cookie.normalize(url);
+        inserted += cookie;
+    }
+    // allCookies() keeps the insertion order across domains
+    QCOMPARE(jar.allCookies(), inserted);
+
+    const QList<QNetworkCookie> result = jar.cookiesForUrl(QUrl("http://www.host7.example.com/dir/x"));
+    QList<QNetworkCookie> expected;
+    for (const QNetworkCookie &cookie : std::as_const(inserted)) {
+        if (cookie.path() == QLatin1String("/dir")
+            && (cookie.domain() == QLatin1String(".host7.example.com")
+                || cookie.domain() == QLatin1String("www.host7.example.com")))
+            expected += cookie;
+    }
+    for (const QNetworkCookie &cookie : std::as_const(inserted)) {
+        if (cookie.path() == QLatin1String("/")
+            && (cookie.domain() == QLatin1String(".host7.example.com")
+                || cookie.domain() == QLatin1String("www.host7.example.com")))
+            expected += cookie;
+    }
+    QCOMPARE(result, expected);
+
+    // Replacing a cookie moves it to the end
+    QNetworkCookie replacement = inserted.takeFirst();
+    replacement.setValue("w");
+    QVERIFY(jar.insertCookie(replacement));
+    inserted += replacement;
+    QCOMPARE(jar.allCookies(), inserted);
+}
+
+void tst_QNetworkCookieJar::expiredCookiesAreDiscarded()
+{
+    MyCookieJar jar;
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    QNetworkCookie stale("stale", "1");
+    stale.setDomain("qt-project.org");
+    stale.setPath("/");
+    stale.setExpirationDate(now.addSecs(-60));
+    QNetworkCookie fresh("fresh", "1");
+    fresh.setDomain("qt-project.org");
+    fresh.setPath("/");
+    fresh.setExpirationDate(now.addDays(1));
+
+    // setAllCookies() takes the list as it is
+    jar.setAllCookies({ stale, fresh });
+    QCOMPARE(jar.allCookies().size(), 2);
+    QCOMPARE(jar.cookiesForUrl(QUrl("http://qt-project.org/")), QList<QNetworkCookie>{ fresh });
+
+    // inserting a cookie discards the expired ones
+    QNetworkCookie session("session", "1");
+    session.setDomain("qt-project.org");
+    session.setPath("/");
+    QVERIFY(jar.insertCookie(session));
+    QCOMPARE(jar.allCookies(), (QList<QNetworkCookie>{ fresh, session }));
+}
+
 QTEST_MAIN(tst_QNetworkCookieJar)
 #include "tst_qnetworkcookiejar.moc"
 
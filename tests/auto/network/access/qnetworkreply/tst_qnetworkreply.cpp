@@ -519,6 +519,7 @@ private Q_SLOTS:
 
     void moreActivitySignals_data();
     void moreActivitySignals();
+    void timing();
 
     void contentEncoding_data();
     void contentEncoding();
@@ -9588,6 +9589,48 @@ void tst_QNetworkReply::moreActivitySignals()
     QVERIFY(secondreply->error() == QNetworkReply::NoError);
 }
 
+void tst_QNetworkReply::timing()
+{
+    MiniHttpServer server(tst_QNetworkReply::httpEmpty200Response);
+    server.doClose = false;
+    QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+
+    QNetworkReplyPtr reply(manager.get(request));
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    QNetworkReplyTiming timing = reply->timing();
+    QVERIFY(timing.isValid());
+    QVERIFY(!timing.isConnectionReused());
+    QVERIFY(!timing.isSessionResumed());
+    QCOMPARE(timing.elapsed(QNetworkReplyTiming::Started), qint64(0));
+    QVERIFY(!timing.hasEvent(QNetworkReplyTiming::SecureConnectStarted));
+    const QNetworkReplyTiming::Event events[] = {
+        QNetworkReplyTiming::ConnectStarted, QNetworkReplyTiming::ConnectFinished,
+        QNetworkReplyTiming::RequestStarted, QNetworkReplyTiming::RequestSent,
+        QNetworkReplyTiming::ResponseStarted, QNetworkReplyTiming::ResponseFinished
+    };
+    for (int i = 1; i < int(std::size(events)); ++i) {
+        QVERIFY2(timing.hasEvent(events[i]), QMetaEnum::fromType<QNetworkReplyTiming::Event>().valueToKey(events[i]));
+        QVERIFY(timing.duration(events[i - 1], events[i]) >= 0);
+    }
+
+    // The second request goes over the same keep-alive connection
+    QNetworkReplyPtr secondReply(manager.get(request));
+    QVERIFY2(waitForFinish(secondReply) == Success, msgWaitForFinished(secondReply));
+    timing = secondReply->timing();
+    QVERIFY(timing.isValid());
+    QVERIFY(timing.isConnectionReused());
+    QVERIFY(!timing.hasEvent(QNetworkReplyTiming::DomainLookupStarted));
+    QVERIFY(!timing.hasEvent(QNetworkReplyTiming::ConnectStarted));
+    QVERIFY(timing.hasEvent(QNetworkReplyTiming::RequestSent));
+    QVERIFY(timing.duration(QNetworkReplyTiming::ResponseStarted, QNetworkReplyTiming::ResponseFinished) >= 0);
+
+    // Non-HTTP replies carry no timing
+    QNetworkReplyPtr dataReply(manager.get(QNetworkRequest(QUrl("data:,hello"))));
+    QVERIFY2(waitForFinish(dataReply) == Success, msgWaitForFinished(dataReply));
+    QVERIFY(!dataReply->timing().isValid());
+    QCOMPARE(dataReply->timing().elapsed(QNetworkReplyTiming::ResponseFinished), -1);
+}
+
 void tst_QNetworkReply::contentEncoding_data()
 {
     QTest::addColumn<QByteArray>("encoding");
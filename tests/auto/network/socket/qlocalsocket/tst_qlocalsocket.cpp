@@ -149,6 +149,10 @@ private slots:
 
     void serverBindingsAndProperties();
 
+#if defined(Q_OS_UNIX) && !defined(QT_LOCALSOCKET_TCP)
+    void fileDescriptorPassing();
+#endif
+
 protected slots:
     void socketClosedSlot();
 };
@@ -1816,6 +1820,53 @@ void tst_QLocalSocket::verifyListenWithDescriptor_data()
 
 }
 
+#if defined(Q_OS_UNIX) && !defined(QT_LOCALSOCKET_TCP)
+void tst_QLocalSocket::fileDescriptorPassing()
+{
+    QLocalServer server;
+    QVERIFY(server.listen("fileDescriptorPassing"));
+    QLocalSocket client;
+    client.connectToServer("fileDescriptorPassing");
+    QVERIFY(client.waitForConnected(3000));
+    QVERIFY(server.waitForNewConnection(3000));
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+
+    int pipeFds[2];
+    QCOMPARE(::pipe(pipeFds), 0);
+
+    // data written before has to arrive before the descriptors' data
+    QCOMPARE(serverSocket->write("before "), qint64(7));
+    QCOMPARE(serverSocket->writeWithFileDescriptors("with", { pipeFds[0] }), qint64(4));
+    ::close(pipeFds[0]);
+
+    QByteArray received;
+    while (received.size() < 11 && client.waitForReadyRead(3000))
+        received += client.readAll();
+    QCOMPARE(received, "before with");
+
+    const QList<int> fds = client.takeFileDescriptors();
+    QCOMPARE(fds.size(), 1);
+    QVERIFY(client.takeFileDescriptors().isEmpty());
+
+    QCOMPARE(::write(pipeFds[1], "x", 1), 1);
+    char c = 0;
+    QCOMPARE(::read(fds.first(), &c, 1), 1);
+    QCOMPARE(c, 'x');
+    ::close(fds.first());
+    ::close(pipeFds[1]);
+
+    // descriptors nobody takes are closed with the socket
+    QCOMPARE(::pipe(pipeFds), 0);
+    QCOMPARE(serverSocket->writeWithFileDescriptors("y", { pipeFds[1] }), qint64(1));
+    ::close(pipeFds[1]);
+    QVERIFY(client.waitForReadyRead(3000));
+    client.close();
+    QCOMPARE(::read(pipeFds[0], &c, 1), 0); // no writer left
+    ::close(pipeFds[0]);
+}
+#endif
+
 void tst_QLocalSocket::serverBindingsAndProperties()
 {
     QLocalServer server;
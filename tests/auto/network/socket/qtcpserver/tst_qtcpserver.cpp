@@ -117,6 +117,8 @@ private slots:
 
     void pauseAccepting();
 
+    void reusePort();
+
 private:
     bool shouldSkipIpv6TestsForBrokenGetsockopt();
 #ifdef SHOULD_CHECK_SYSCALL_SUPPORT
@@ -1081,5 +1083,37 @@ void tst_QTcpServer::pauseAccepting()
     QCOMPARE(spy.count(), 6);
 }
 
+void tst_QTcpServer::reusePort()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTcpServer server;
+    QVERIFY(!server.isReusePortEnabled());
+    server.setReusePortEnabled(true);
+    QVERIFY(server.isReusePortEnabled());
+    if (!server.listen(QHostAddress::LocalHost)) {
+        QCOMPARE(server.serverError(), QAbstractSocket::UnsupportedSocketOperationError);
+        QSKIP("SO_REUSEPORT is not supported on this platform");
+    }
+
+    // a listener that does not opt in still cannot take the port
+    QTcpServer plain;
+    QVERIFY(!plain.listen(QHostAddress::LocalHost, server.serverPort()));
+
+    QTcpServer second;
+    second.setReusePortEnabled(true);
+    QVERIFY2(second.listen(QHostAddress::LocalHost, server.serverPort()),
+             qPrintable(second.errorString()));
+    QCOMPARE(second.serverPort(), server.serverPort());
+
+    // connections end up at either of them
+    QTcpSocket client;
+    client.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    QVERIFY(client.waitForConnected(5000));
+    QTRY_VERIFY(server.hasPendingConnections() || second.hasPendingConnections());
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
@@ -0,0 +1,191 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qset.h>
+#include <QtCore/qthread.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpservergroup.h>
+#include <QtNetwork/qtcpsocket.h>
+
+class CountingServerGroup : public QTcpServerGroup
+{
+public:
+    QAtomicInt accepted;
+    QMutex mutex;
+    QSet<QThread *> acceptingThreads;
+
+protected:
+    QTcpServer *createServer(int index) override
+    {
+        Q_UNUSED(index);
+        auto server = new QTcpServer;
+        QObject::connect(server, &QTcpServer::newConnection, server, [this, server] {
+            while (QTcpSocket *socket = server->nextPendingConnection()) {
+                {
+                    QMutexLocker locker(&mutex);
+                    acceptingThreads.insert(QThread::currentThread());
+                }
+                socket->close();
+                socket->deleteLater();
+                accepted.ref();
+            }
+        });
+        return server;
+    }
+};
+
+class tst_QTcpServerGroup : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaults();
+    void listenAndAccept_data();
+    void listenAndAccept();
+    void listenError();
+    void close();
+};
+
+void tst_QTcpServerGroup::defaults()
+{
+    QTcpServerGroup group;
+    QCOMPARE(group.threadCount(), 0);
+    QVERIFY(!group.isCpuSteeringEnabled());
+    QVERIFY(!group.isListening());
+    QCOMPARE(group.serverCount(), 0);
+    QCOMPARE(group.serverPort(), quint16(0));
+    QVERIFY(!group.server(0));
+    QVERIFY(!group.serverThread(0));
+
+    group.setThreadCount(-1);
+    QCOMPARE(group.threadCount(), 0);
+    group.setThreadCount(3);
+    QCOMPARE(group.threadCount(), 3);
+    group.setCpuSteeringEnabled(true);
+    QVERIFY(group.isCpuSteeringEnabled());
+}
+
+void tst_QTcpServerGroup::listenAndAccept_data()
+{
+    QTest::addColumn<bool>("cpuSteering");
+
+    QTest::newRow("kernel-balanced") << false;
+    QTest::newRow("cpu-steered") << true;
+}
+
+void tst_QTcpServerGroup::listenAndAccept()
+{
+    QFETCH(bool, cpuSteering);
+
+    CountingServerGroup group;
+    group.setThreadCount(2);
+    group.setCpuSteeringEnabled(cpuSteering);
+    if (!group.listen(QHostAddress::LocalHost)) {
+        QCOMPARE(group.serverError(), QAbstractSocket::UnsupportedSocketOperationError);
+        QSKIP("SO_REUSEPORT is not supported on this platform");
+    }
+
+    QVERIFY(group.isListening());
+    QCOMPARE(group.serverCount(), 2);
+    QVERIFY(group.serverPort() != 0);
+    QCOMPARE(group.serverAddress(), QHostAddress(QHostAddress::LocalHost));
+    for (int i = 0; i < group.serverCount(); ++i) {
+        QVERIFY(group.server(i));
+        QVERIFY(group.serverThread(i));
+        QVERIFY(group.serverThread(i) != QThread::currentThread());
+        QCOMPARE(group.server(i)->thread(), group.serverThread(i));
+        QCOMPARE(group.server(i)->serverPort(), group.serverPort());
+    }
+
+    constexpr int Connections = 32;
+    QList<QTcpSocket *> clients;
+    for (int i = 0; i < Connections; ++i) {
+        auto client = new QTcpSocket(this);
+        client->connectToHost(QHostAddress::LocalHost, group.serverPort());
+        clients.append(client);
+    }
+    for (QTcpSocket *client : qAsConst(clients))
+        QVERIFY(client->waitForConnected(5000));
+
+    QTRY_COMPARE(group.accepted.loadRelaxed(), Connections);
+
+    QMutexLocker locker(&group.mutex);
+    QVERIFY(!group.acceptingThreads.contains(QThread::currentThread()));
+    for (QThread *thread : qAsConst(group.acceptingThreads))
+        QVERIFY(thread == group.serverThread(0) || thread == group.serverThread(1));
+    locker.unlock();
+
+    qDeleteAll(clients);
+}
+
+void tst_QTcpServerGroup::listenError()
+{
+    QTcpServer blocker;
+    QVERIFY(blocker.listen(QHostAddress::LocalHost));
+
+    // the port is taken by a listener that does not share it
+    QTcpServerGroup group;
+    group.setThreadCount(2);
+    QVERIFY(!group.listen(QHostAddress::LocalHost, blocker.serverPort()));
+    QVERIFY(!group.isListening());
+    QCOMPARE(group.serverCount(), 0);
+    QVERIFY(!group.errorString().isEmpty());
+}
+
+void tst_QTcpServerGroup::close()
+{
+    QTcpServerGroup group;
+    group.setThreadCount(2);
+    if (!group.listen(QHostAddress::LocalHost))
+        QSKIP("SO_REUSEPORT is not supported on this platform");
+
+    const quint16 port = group.serverPort();
+    QPointer<QThread> thread = group.serverThread(0);
+    group.close();
+    QVERIFY(!group.isListening());
+    QCOMPARE(group.serverCount(), 0);
+    QCOMPARE(group.serverPort(), quint16(0));
+    QVERIFY(!thread);
+
+    // the port is free again
+    QTcpServer server;
+    QVERIFY2(server.listen(QHostAddress::LocalHost, port), qPrintable(server.errorString()));
+
+    // and the group can listen again
+    server.close();
+    QVERIFY(group.listen(QHostAddress::LocalHost));
+    QCOMPARE(group.serverCount(), 2);
+}
+
+QTEST_MAIN(tst_QTcpServerGroup)
+#include "tst_qtcpservergroup.moc"
@@ -62,6 +62,7 @@
 #include <QStringList>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QTemporaryFile>
 #ifndef QT_NO_SSL
 #include <QSslSocket>
 #endif
@@ -206,6 +207,9 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void sendFile();
+    void corkedWrites();
+    void raceConnectionAttempts();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3240,5 +3244,170 @@ void tst_QTcpSocket::readNotificationsAfterBind()
     QCOMPARE(spyReadyRead.count(), 0);
 }
 
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QByteArray payload(3 * 1024 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < payload.size(); ++i)
+        payload[i] = char(i % 251);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(payload), payload.size());
+
+    QTcpServer tcpServer;
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    std::unique_ptr<QTcpSocket> peer(tcpServer.nextPendingConnection());
+    QVERIFY(peer);
+
+    // Invalid arguments
+    QCOMPARE(socket->sendFile(nullptr), Q_INT64_C(-1));
+    QCOMPARE(socket->sendFile(&file, payload.size() + 1), Q_INT64_C(-1));
+    QCOMPARE(socket->sendFile(&file, payload.size()), Q_INT64_C(0));
+
+    // Regular writes before and after the file must keep their order
+    QSignalSpy bytesWrittenSpy(socket.get(), &QIODevice::bytesWritten);
+    QCOMPARE(socket->write("head"), Q_INT64_C(4));
+    QCOMPARE(socket->sendFile(&file, 1000), payload.size() - 1000);
+    QCOMPARE(socket->sendFile(&file, 10, 20), Q_INT64_C(20));
+    QCOMPARE(socket->write("tail"), Q_INT64_C(4));
+    QCOMPARE(socket->bytesToWrite(), payload.size() - 1000 + 28);
+
+    const QByteArray expected = "head" + payload.mid(1000) + payload.mid(10, 20) + "tail";
+    QByteArray received;
+    QTRY_VERIFY_WITH_TIMEOUT((received += peer->readAll()).size() >= expected.size(), 10000);
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+    QCOMPARE(socket->bytesToWrite(), Q_INT64_C(0));
+
+    qint64 totalWritten = 0;
+    for (const QList<QVariant> &args : std::as_const(bytesWrittenSpy))
+        totalWritten += args.at(0).toLongLong();
+    QCOMPARE(totalWritten, qint64(expected.size()));
+
+    // A graceful disconnect waits for the file to be sent
+    QCOMPARE(socket->sendFile(&file), payload.size());
+    socket->disconnectFromHost();
+    received.clear();
+    QTRY_VERIFY_WITH_TIMEOUT((received += peer->readAll()).size() >= payload.size(), 10000);
+    QVERIFY(received == payload);
+    QTRY_COMPARE(socket->state(), QAbstractSocket::UnconnectedState);
+}
+
+void tst_QTcpSocket::corkedWrites()
+{
+    QFETCH_GLOBAL(bool, ssl);
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy || ssl)
+        return;
+
+    QTcpServer tcpServer;
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    std::unique_ptr<QTcpSocket> peer(tcpServer.nextPendingConnection());
+    QVERIFY(peer);
+
+    // Nothing goes out while the socket is corked
+    QVERIFY(!socket->isCorked());
+    socket->cork();
+    QVERIFY(socket->isCorked());
+    QCOMPARE(socket->write("HTTP/1.1 200 OK\r\n"), Q_INT64_C(17));
+    QCOMPARE(socket->write("Content-Length: 4\r\n\r\n"), Q_INT64_C(21));
+    QCOMPARE(socket->write("body"), Q_INT64_C(4));
+    QTest::qWait(100);
+    QCOMPARE(socket->bytesToWrite(), Q_INT64_C(42));
+    QCOMPARE(peer->bytesAvailable(), Q_INT64_C(0));
+
+    socket->uncork();
+    QVERIFY(!socket->isCorked());
+    QByteArray received;
+    const QByteArray expected = "HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\nbody";
+    QTRY_VERIFY_WITH_TIMEOUT((received += peer->readAll()).size() >= expected.size(), 5000);
+    QCOMPARE(received, expected);
+
+    // Data spread over many write buffer chunks is gathered in order
+    QByteArray payload(1024 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < payload.size(); ++i)
+        payload[i] = char(i % 251);
+    socket->cork();
+    for (qsizetype i = 0; i < payload.size(); i += 1000)
+        socket->write(payload.constData() + i, qMin<qsizetype>(1000, payload.size() - i));
+    QCOMPARE(socket->bytesToWrite(), payload.size());
+    QVERIFY(socket->flush());
+    socket->uncork();
+    received.clear();
+    QTRY_VERIFY_WITH_TIMEOUT((received += peer->readAll()).size() >= payload.size(), 10000);
+    QVERIFY(received == payload);
+
+    // disconnectFromHost() sends what is still held back
+    socket->cork();
+    socket->write("bye");
+    socket->disconnectFromHost();
+    QVERIFY(!socket->isCorked());
+    received.clear();
+    QTRY_VERIFY_WITH_TIMEOUT((received += peer->readAll()).size() >= 3, 5000);
+    QCOMPARE(received, QByteArray("bye"));
+    QTRY_COMPARE(socket->state(), QAbstractSocket::UnconnectedState);
+}
+
+void tst_QTcpSocket::raceConnectionAttempts()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("This test relies on Linux dropping connections when the listen backlog is full");
+#else
+    QFETCH_GLOBAL(bool, ssl);
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy || ssl)
+        return;
+
+    // A server that does not accept and whose backlog is full: further
+    // connection attempts to it hang, as if the network dropped them.
+    QTcpServer stalled;
+    stalled.setListenBacklogSize(0);
+    QVERIFY(stalled.listen(QHostAddress("127.0.0.1")));
+    stalled.pauseAccepting();
+    QTcpSocket filler;
+    filler.connectToHost(stalled.serverAddress(), stalled.serverPort());
+    QVERIFY(filler.waitForConnected(5000));
+
+    QTcpServer server;
+    if (!server.listen(QHostAddress("127.0.0.2"), stalled.serverPort()))
+        QSKIP("Cannot listen on 127.0.0.2");
+
+    const QString hostName = QStringLiteral("qt-test-connection-race");
+    QHostInfo info;
+    info.setAddresses({ stalled.serverAddress(), server.serverAddress() });
+    qt_qhostinfo_cache_inject(hostName, info);
+
+    // Without racing, the second address would only be tried after the
+    // first attempt timed out.
+    QElapsedTimer stopWatch;
+    stopWatch.start();
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(hostName, stalled.serverPort());
+    QTRY_COMPARE_WITH_TIMEOUT(socket->state(), QAbstractSocket::ConnectedState, 10000);
+    QVERIFY(stopWatch.elapsed() < 10000);
+    QCOMPARE(socket->peerAddress(), server.serverAddress());
+    QCOMPARE(socket->peerName(), hostName);
+
+    // The connection must be usable:
+    QTRY_VERIFY(server.hasPendingConnections());
+    std::unique_ptr<QTcpSocket> peer(server.nextPendingConnection());
+    QVERIFY(peer);
+    QCOMPARE(socket->write("ping"), 4);
+    QTRY_COMPARE(peer->bytesAvailable(), 4);
+    QCOMPARE(peer->readAll(), QByteArray("ping"));
+#endif
+}
+
 QTEST_MAIN(tst_QTcpSocket)
 #include "tst_qtcpsocket.moc"
@@ -48,6 +48,7 @@
 #include <qtcpsocket.h>
 #include <qmap.h>
 #include <qelapsedtimer.h>
+#include <qdeadlinetimer.h>
 #include <qnetworkdatagram.h>
 #include <QNetworkProxy>
 #include <QNetworkInterface>
@@ -126,6 +127,7 @@ private slots:
     void readyReadForEmptyDatagram();
     void asyncReadDatagram();
     void writeInHostLookupState();
+    void batchedDatagrams();
 
 protected slots:
     void empty_readyReadSlot();
@@ -1932,5 +1934,58 @@ void tst_QUdpSocket::writeInHostLookupState()
     QVERIFY(!socket.putChar('0'));
 }
 
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket receiver;
+    QVERIFY2(receiver.bind(QHostAddress(QHostAddress::LocalHost), 0),
+             receiver.errorString().toLatin1().constData());
+    QVERIFY(receiver.receiveDatagrams(8).isEmpty());
+
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress(QHostAddress::LocalHost), 0));
+    QCOMPARE(sender.writeDatagrams({}), qint64(0));
+
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < 10; ++i) {
+        datagrams.append(QNetworkDatagram(QByteArray(i * 100, char('a' + i)),
+                                          receiver.localAddress(), receiver.localPort()));
+    }
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    QCOMPARE(sender.writeDatagrams(datagrams), qint64(datagrams.size()));
+    QCOMPARE(bytesWrittenSpy.count(), 1);
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), qint64(45 * 100));
+
+    QList<QNetworkDatagram> received;
+    QDeadlineTimer deadline(5000);
+    while (received.size() < datagrams.size() && !deadline.hasExpired()) {
+        if (!receiver.hasPendingDatagrams() && !receiver.waitForReadyRead(100))
+            continue;
+        // Fewer than we sent, so that we need more than one batch:
+        received += receiver.receiveDatagrams(4);
+    }
+
+    QCOMPARE(received.size(), datagrams.size());
+    for (int i = 0; i < received.size(); ++i) {
+        const QNetworkDatagram &datagram = received.at(i);
+        QVERIFY(datagram.isValid());
+        // The empty one is received as such:
+        QCOMPARE(datagram.data(), datagrams.at(i).data());
+        QCOMPARE(datagram.senderAddress(), sender.localAddress());
+        QCOMPARE(datagram.senderPort(), int(sender.localPort()));
+        QCOMPARE(datagram.destinationPort(), int(receiver.localPort()));
+    }
+
+    // Datagrams larger than maxSize are truncated:
+    QCOMPARE(sender.writeDatagrams({datagrams.last()}), qint64(1));
+    QVERIFY(receiver.waitForReadyRead(5000));
+    received = receiver.receiveDatagrams(4, 10);
+    QCOMPARE(received.size(), 1);
+    QCOMPARE(received.first().data(), datagrams.last().data().left(10));
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
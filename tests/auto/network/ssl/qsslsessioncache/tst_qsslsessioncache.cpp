@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtNetwork/qsslsessioncache.h>
+
+#include <QTest>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+
+QT_USE_NAMESPACE
+
+class tst_QSslSessionCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void insertAndLookup();
+    void emptyArguments();
+    void expiry();
+    void eviction();
+    void saveAndLoad();
+    void loadInvalid();
+};
+
+void tst_QSslSessionCache::insertAndLookup()
+{
+    QSslSessionCache cache;
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.maximumSize(), 256);
+
+    cache.insert(QStringLiteral("Example.COM"), 443, "session-1");
+    QCOMPARE(cache.size(), 1);
+    // Names are compared case-insensitively, ports are part of the key:
+    QCOMPARE(cache.session(QStringLiteral("example.com"), 443), QByteArray("session-1"));
+    QVERIFY(cache.session(QStringLiteral("example.com"), 8443).isEmpty());
+    QVERIFY(cache.session(QStringLiteral("www.example.com"), 443).isEmpty());
+
+    // A new session replaces the old one:
+    cache.insert(QStringLiteral("example.com"), 443, "session-2");
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.session(QStringLiteral("example.com"), 443), QByteArray("session-2"));
+
+    cache.insert(QStringLiteral("example.com"), 8443, "session-3");
+    QCOMPARE(cache.size(), 2);
+    cache.remove(QStringLiteral("EXAMPLE.com"), 443);
+    QCOMPARE(cache.size(), 1);
+    QVERIFY(cache.session(QStringLiteral("example.com"), 443).isEmpty());
+
+    cache.clear();
+    QCOMPARE(cache.size(), 0);
+}
+
+void tst_QSslSessionCache::emptyArguments()
+{
+    QSslSessionCache cache;
+    cache.insert(QString(), 443, "session");
+    QCOMPARE(cache.size(), 0);
+    QVERIFY(cache.session(QString(), 443).isEmpty());
+
+    cache.insert(QStringLiteral("example.com"), 443, "session");
+    // An empty session removes the entry:
+    cache.insert(QStringLiteral("example.com"), 443, QByteArray());
+    QCOMPARE(cache.size(), 0);
+}
+
+void tst_QSslSessionCache::expiry()
+{
+    QSslSessionCache cache;
+    cache.insert(QStringLiteral("example.com"), 443, "short", 1);
+    cache.insert(QStringLiteral("example.org"), 443, "long", 3600);
+    QCOMPARE(cache.session(QStringLiteral("example.com"), 443), QByteArray("short"));
+
+    QTRY_VERIFY_WITH_TIMEOUT(cache.session(QStringLiteral("example.com"), 443).isEmpty(), 3000);
+    // Expired entries are dropped on lookup:
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.session(QStringLiteral("example.org"), 443), QByteArray("long"));
+}
+
+void tst_QSslSessionCache::eviction()
+{
+    QSslSessionCache cache(2);
+    QCOMPARE(cache.maximumSize(), 2);
+
+    cache.insert(QStringLiteral("a.example"), 443, "a");
+    cache.insert(QStringLiteral("b.example"), 443, "b");
+    // Looking a session up makes it the most recently used one ...
+    QCOMPARE(cache.session(QStringLiteral("a.example"), 443), QByteArray("a"));
+    // ... so 'b' is evicted first:
+    cache.insert(QStringLiteral("c.example"), 443, "c");
+    QCOMPARE(cache.size(), 2);
+    QVERIFY(cache.session(QStringLiteral("b.example"), 443).isEmpty());
+    QCOMPARE(cache.session(QStringLiteral("a.example"), 443), QByteArray("a"));
+    QCOMPARE(cache.session(QStringLiteral("c.example"), 443), QByteArray("c"));
+
+    cache.setMaximumSize(1);
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.session(QStringLiteral("c.example"), 443), QByteArray("c"));
+}
+
+void tst_QSslSessionCache::saveAndLoad()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("sessions"));
+
+    {
+        QSslSessionCache cache;
+        cache.insert(QStringLiteral("example.com"), 443, "session-1", 3600);
+        cache.insert(QStringLiteral("example.org"), 8443, "session-2", 3600);
+        cache.insert(QStringLiteral("example.net"), 443, "expiring", 1);
+        // Expired entries are not written:
+        QTest::qSleep(1100);
+        QVERIFY(cache.save(fileName));
+    }
+
+    const auto permissions = QFile::permissions(fileName);
+    QVERIFY(permissions.testFlag(QFileDevice::ReadOwner));
+    QVERIFY(!permissions.testFlag(QFileDevice::ReadOther));
+
+    QSslSessionCache restored;
+    restored.insert(QStringLiteral("example.com"), 443, "stale");
+    restored.insert(QStringLiteral("example.edu"), 443, "other");
+    QVERIFY(restored.load(fileName));
+    QCOMPARE(restored.session(QStringLiteral("example.com"), 443), QByteArray("session-1"));
+    QCOMPARE(restored.session(QStringLiteral("example.org"), 8443), QByteArray("session-2"));
+    QCOMPARE(restored.session(QStringLiteral("example.edu"), 443), QByteArray("other"));
+    QVERIFY(restored.session(QStringLiteral("example.net"), 443).isEmpty());
+    QCOMPARE(restored.size(), 3);
+}
+
+void tst_QSslSessionCache::loadInvalid()
+{
+    QSslSessionCache cache;
+    cache.insert(QStringLiteral("example.com"), 443, "session");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(!cache.load(dir.filePath(QStringLiteral("does-not-exist"))));
+
+    const QString fileName = dir.filePath(QStringLiteral("garbage"));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("not a session cache");
+    file.close();
+    QVERIFY(!cache.load(fileName));
+
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.session(QStringLiteral("example.com"), 443), QByteArray("session"));
+}
+
+QTEST_MAIN(tst_QSslSessionCache)
+#include "tst_qsslsessioncache.moc"
@@ -34,6 +34,7 @@
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qrandom.h>
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qtemporaryfile.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qhostinfo.h>
 #include <QtNetwork/qnetworkproxy.h>
@@ -43,6 +44,7 @@
 #include <QtNetwork/qsslsocket.h>
 #include <QtNetwork/qtcpserver.h>
 #include <QtNetwork/qsslpresharedkeyauthenticator.h>
+#include <QtNetwork/qsslsessioncache.h>
 
 #include <QTest>
 #include <QNetworkProxy>
@@ -225,6 +227,8 @@ private slots:
     void encryptWithoutConnecting();
     void resume_data();
     void resume();
+    void sessionCache();
+    void kernelTlsSendFile();
     void qtbug18498_peek();
     void qtbug18498_peek2();
     void dhServer();
@@ -1483,6 +1487,10 @@ public:
     QString m_certFile;
     QString m_interFile;
     QList<QSslCipher> ciphers;
+    // If set, all server sockets share the TLS context of the first one (and so,
+    // can resume each other's sessions):
+    bool shareTlsContext = false;
+    std::shared_ptr<QSslContext> tlsContext;
 
 signals:
     void sslErrors(const QList<QSslError> &errors);
@@ -1552,6 +1560,16 @@ protected:
         QVERIFY(!socket->localAddress().isNull());
         QVERIFY(socket->localPort() != 0);
 
+        if (shareTlsContext) {
+            if (tlsContext) {
+                QSslSocketPrivate::checkSettingSslContext(socket, tlsContext);
+            } else {
+                connect(socket, &QSslSocket::encrypted, this, [this, s = socket]() {
+                    tlsContext = QSslSocketPrivate::sslContext(s);
+                });
+            }
+        }
+
         socket->startServerEncryption();
     }
 
@@ -3193,6 +3211,116 @@ void tst_QSslSocket::resume()
     }
 }
 
+void tst_QSslSocket::sessionCache()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Session resumption is only implemented by the OpenSSL backend");
+
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    SslServer server;
+    // With TLS 1.2 the session is known once the handshake is complete:
+    server.protocol = QSsl::TlsV1_2;
+    // OpenSSL refuses to resume a session when requesting a client certificate
+    // without a session id context, which QSslSocket doesn't set:
+    server.peerVerifyMode = QSslSocket::VerifyNone;
+    server.shareTlsContext = true;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    const QString peerName = QHostAddress(QHostAddress::LocalHost).toString();
+    QSslSessionCache cache;
+
+    auto connectClient = [&](QSslSocket &client, bool disablePersistence = false) {
+        client.setSslSessionCache(&cache);
+        QSslConfiguration config = client.sslConfiguration();
+        config.setProtocol(QSsl::TlsV1_2);
+        config.setPeerVerifyMode(QSslSocket::VerifyNone);
+        config.setSslOption(QSsl::SslOptionDisableSessionPersistence, disablePersistence);
+        client.setSslConfiguration(config);
+        client.connectToHostEncrypted(peerName, server.serverPort());
+    };
+
+    QSslSocket first;
+    connectClient(first);
+    QCOMPARE(first.sslSessionCache(), &cache);
+    QTRY_VERIFY(first.isEncrypted());
+    QVERIFY(!QSslConfigurationPrivate::peerSessionWasShared(first.sslConfiguration()));
+    QCOMPARE(cache.size(), 1);
+    QVERIFY(!cache.session(peerName, server.serverPort()).isEmpty());
+    QCOMPARE(cache.session(peerName, server.serverPort()), first.sslConfiguration().sessionTicket());
+    first.disconnectFromHost();
+
+    // A different socket resumes the session the first one negotiated:
+    QSslSocket second;
+    connectClient(second);
+    QTRY_VERIFY(second.isEncrypted());
+    QVERIFY(QSslConfigurationPrivate::peerSessionWasShared(second.sslConfiguration()));
+    second.disconnectFromHost();
+
+    // Persistence disabled - the cache is neither consulted nor updated:
+    cache.clear();
+    QSslSocket third;
+    connectClient(third, true);
+    QTRY_VERIFY(third.isEncrypted());
+    QVERIFY(!QSslConfigurationPrivate::peerSessionWasShared(third.sslConfiguration()));
+    QCOMPARE(cache.size(), 0);
+}
+
+void tst_QSslSocket::kernelTlsSendFile()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QByteArray contents(256 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < contents.size(); ++i)
+        contents[i] = char(i % 251);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), contents.size());
+    QVERIFY(file.flush());
+
+    // Whether or not the kernel can take over, the peer must receive the
+    // same bytes, in order:
+    const QByteArray expected = "head" + contents.mid(10) + "tail";
+    for (QSsl::SslProtocol protocol : { QSsl::TlsV1_2, QSsl::TlsV1_3 }) {
+        SslServer server;
+        server.protocol = protocol;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QSslSocket client;
+        QSslConfiguration config = client.sslConfiguration();
+        config.setProtocol(protocol);
+        config.setPeerVerifyMode(QSslSocket::VerifyNone);
+        config.setSslOption(QSsl::SslOptionEnableKernelTls, true);
+        client.setSslConfiguration(config);
+        client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                      server.serverPort());
+        QTRY_VERIFY(client.isEncrypted());
+        QTRY_VERIFY(server.socket && server.socket->isEncrypted());
+
+        QCOMPARE(client.write("head"), 4);
+        QCOMPARE(client.sendFile(&file, 10), contents.size() - 10);
+        QCOMPARE(client.write("tail"), 4);
+
+        QByteArray received;
+        QTRY_VERIFY_WITH_TIMEOUT((received += server.socket->readAll()).size() >= expected.size(),
+                                 10000);
+        QCOMPARE(received, expected);
+
+        // The connection still works in the other direction as well:
+        QCOMPARE(server.socket->write("pong"), 4);
+        QTRY_COMPARE(client.bytesAvailable(), 4);
+        QCOMPARE(client.readAll(), QByteArray("pong"));
+        client.disconnectFromHost();
+    }
+}
+
 class WebSocket : public QSslSocket
 {
     Q_OBJECT
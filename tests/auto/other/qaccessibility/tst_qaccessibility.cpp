@@ -231,6 +231,7 @@ private slots:
     void listTest();
     void treeTest();
     void tableTest();
+    void largeTableTest();
 
     void calendarWidgetTest();
     void dockWidgetTest();
@@ -3370,6 +3371,64 @@ void tst_QAccessibility::tableTest()
     QTestAccessibility::clearEvents();
 }
 
+void tst_QAccessibility::largeTableTest()
+{
+    QStandardItemModel model(2000, 2);
+    QTableView tableView;
+    tableView.setModel(&model);
+    tableView.resize(200, 200);
+    tableView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&tableView));
+
+    QAccessibleInterface *iface = QAccessible::queryAccessibleInterface(&tableView);
+    QAccessibleTableInterface *table = iface->tableInterface();
+    QVERIFY(table);
+
+    QAccessibleInterface *visibleCell = table->cellAt(0, 0);
+    const QAccessible::Id visibleId = QAccessible::uniqueId(visibleCell);
+    const QAccessible::Id hiddenId = QAccessible::uniqueId(table->cellAt(1999, 1));
+    for (int row = 0; row < model.rowCount(); ++row)
+        QVERIFY(table->cellAt(row, 0));
+
+    // interfaces of cells outside of the viewport are released once
+    // the cache grows too big, and are recreated on demand
+    QTRY_VERIFY(!QAccessible::accessibleInterface(hiddenId));
+    QCOMPARE(QAccessible::accessibleInterface(visibleId), visibleCell);
+    QCOMPARE(table->cellAt(0, 0), visibleCell);
+    QAccessibleInterface *hiddenCell = table->cellAt(1999, 1);
+    QVERIFY(hiddenCell);
+    QCOMPARE(hiddenCell->tableCellInterface()->rowIndex(), 1999);
+    QCOMPARE(hiddenCell->tableCellInterface()->columnIndex(), 1);
+
+    // changes of single cells are reported as one event
+    QTestAccessibility::clearEvents();
+    for (int row = 10; row < 20; ++row)
+        model.setData(model.index(row, 1), row);
+    model.setData(model.index(15, 0), 0);
+    QTRY_VERIFY(!QTestAccessibility::events().isEmpty());
+    const EventList events = QTestAccessibility::events();
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events.first()->type(), QAccessible::TableModelChanged);
+    const auto *event = static_cast<QAccessibleTableModelChangeEvent *>(events.first());
+    QCOMPARE(event->modelChangeType(), QAccessibleTableModelChangeEvent::DataChanged);
+    QCOMPARE(event->firstRow(), 10);
+    QCOMPARE(event->lastRow(), 19);
+    QCOMPARE(event->firstColumn(), 0);
+    QCOMPARE(event->lastColumn(), 1);
+    QTestAccessibility::clearEvents();
+
+    // pending changes are reported before rows are removed
+    model.setData(model.index(1, 1), 1);
+    model.removeRow(1999);
+    const EventList removeEvents = QTestAccessibility::events();
+    QCOMPARE(removeEvents.size(), 2);
+    QCOMPARE(static_cast<QAccessibleTableModelChangeEvent *>(removeEvents.at(0))->modelChangeType(),
+             QAccessibleTableModelChangeEvent::DataChanged);
+    QCOMPARE(static_cast<QAccessibleTableModelChangeEvent *>(removeEvents.at(1))->modelChangeType(),
+             QAccessibleTableModelChangeEvent::RowsRemoved);
+    QTestAccessibility::clearEvents();
+}
+
 void tst_QAccessibility::calendarWidgetTest()
 {
 #if QT_CONFIG(calendarwidget)
@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QtCore/qthread.h>
+#include <QtSql/qsqlconnectionpool.h>
+#include <QtSql/qsqldatabase.h>
+#include <QtSql/qsqlquery.h>
+
+class tst_QSqlConnectionPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void reuseInSameThread();
+    void maximumConnectionCount();
+    void perThreadConnections();
+    void idleTimeout();
+    void validationQuery();
+    void releaseForeignConnection();
+    void missingTemplate();
+};
+
+static const char templateName[] = "tst_qsqlconnectionpool";
+
+void tst_QSqlConnectionPool::initTestCase()
+{
+    if (!QSqlDatabase::isDriverAvailable("QSQLITE"))
+        QSKIP("This test requires the SQLite driver");
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", templateName);
+    db.setDatabaseName(":memory:");
+}
+
+void tst_QSqlConnectionPool::cleanupTestCase()
+{
+    QSqlDatabase::removeDatabase(templateName);
+}
+
+void tst_QSqlConnectionPool::reuseInSameThread()
+{
+    QSqlConnectionPool pool(templateName);
+    QCOMPARE(pool.connectionName(), QString(templateName));
+
+    QSqlDatabase db = pool.acquire();
+    QVERIFY(db.isOpen());
+    QVERIFY(db.connectionName() != QLatin1String(templateName));
+    const QString name = db.connectionName();
+    QCOMPARE(pool.connectionCount(), 1);
+    QCOMPARE(pool.idleConnectionCount(), 0);
+
+    pool.release(db);
+    QCOMPARE(pool.idleConnectionCount(), 1);
+
+    db = pool.acquire();
+    QCOMPARE(db.connectionName(), name);
+    QCOMPARE(pool.connectionCount(), 1);
+    pool.release(db);
+    db = QSqlDatabase();
+
+    pool.removeIdleConnections();
+    QCOMPARE(pool.connectionCount(), 0);
+    QVERIFY(!QSqlDatabase::contains(name));
+}
+
+void tst_QSqlConnectionPool::maximumConnectionCount()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setMaximumConnectionCount(2);
+
+    QSqlDatabase first = pool.acquire();
+    QSqlDatabase second = pool.acquire();
+    QVERIFY(first.isOpen());
+    QVERIFY(second.isOpen());
+    QVERIFY(first.connectionName() != second.connectionName());
+
+    QVERIFY(!pool.acquire(QDeadlineTimer(50)).isValid());
+
+    // A connection released by another thread wakes up the waiting one
+    QScopedPointer<QThread> releaser(QThread::create([&] {
+        QThread::msleep(50);
+        pool.release(second);
+    }));
+    releaser->start();
+    QSqlDatabase third = pool.acquire(QDeadlineTimer(10000));
+    QVERIFY(releaser->wait());
+    QCOMPARE(third.connectionName(), second.connectionName());
+
+    pool.release(first);
+    pool.release(third);
+    first = second = third = QSqlDatabase();
+    pool.removeIdleConnections();
+}
+
+void tst_QSqlConnectionPool::perThreadConnections()
+{
+    QSqlConnectionPool pool(templateName);
+    QSqlDatabase db = pool.acquire();
+    const QString mainName = db.connectionName();
+    pool.release(db);
+    db = QSqlDatabase();
+
+    QString threadName;
+    bool threadOpen = false;
+    QScopedPointer<QThread> thread(QThread::create([&] {
+        QSqlDatabase db = pool.acquire();
+        threadOpen = db.isOpen();
+        threadName = db.connectionName();
+        pool.release(db);
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QVERIFY(threadOpen);
+    QVERIFY(threadName != mainName);
+    QCOMPARE(pool.connectionCount(), 2);
+
+    // The idle connection of the finished thread is dropped on the next use
+    db = pool.acquire();
+    QCOMPARE(db.connectionName(), mainName);
+    QCOMPARE(pool.connectionCount(), 1);
+    QVERIFY(!QSqlDatabase::contains(threadName));
+    pool.release(db);
+    db = QSqlDatabase();
+    pool.removeIdleConnections();
+}
+
+void tst_QSqlConnectionPool::idleTimeout()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setMaximumIdleTime(0);
+    QSqlDatabase first = pool.acquire();
+    QSqlDatabase second = pool.acquire();
+    const QString secondName = second.connectionName();
+    pool.release(first);
+    pool.release(second);
+    first = second = QSqlDatabase();
+    QCOMPARE(pool.connectionCount(), 2);
+
+    // Both connections expired, but one is kept for the minimum count
+    pool.setMinimumConnectionCount(1);
+    QThread::msleep(10);
+    QSqlDatabase db = pool.acquire();
+    QCOMPARE(pool.connectionCount(), 1);
+    QCOMPARE(db.connectionName(), secondName);
+    pool.release(db);
+    db = QSqlDatabase();
+
+    pool.removeIdleConnections();
+    QCOMPARE(pool.connectionCount(), 0);
+}
+
+void tst_QSqlConnectionPool::validationQuery()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setValidationQuery("SELECT 1");
+    QCOMPARE(pool.validationQuery(), QString("SELECT 1"));
+
+    QSqlDatabase db = pool.acquire();
+    const QString name = db.connectionName();
+    db.close();
+    pool.release(db);
+
+    db = pool.acquire();
+    QCOMPARE(db.connectionName(), name);
+    QVERIFY(db.isOpen());
+    pool.release(db);
+    db = QSqlDatabase();
+    pool.removeIdleConnections();
+}
+
+void tst_QSqlConnectionPool::releaseForeignConnection()
+{
+    QSqlConnectionPool pool(templateName);
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QSqlConnectionPool::release: connection 'tst_qsqlconnectionpool' "
+                         "is not in use from this pool");
+    pool.release(QSqlDatabase::database(templateName, false));
+    QCOMPARE(pool.idleConnectionCount(), 0);
+}
+
+void tst_QSqlConnectionPool::missingTemplate()
+{
+    QSqlConnectionPool pool("tst_qsqlconnectionpool_missing");
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QSqlConnectionPool::acquire: connection "
+                         "'tst_qsqlconnectionpool_missing' does not exist");
+    QVERIFY(!pool.acquire().isValid());
+    QCOMPARE(pool.connectionCount(), 0);
+}
+
+QTEST_MAIN(tst_QSqlConnectionPool)
+#include "tst_qsqlconnectionpool.moc"
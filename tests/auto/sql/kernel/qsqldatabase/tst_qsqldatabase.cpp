@@ -201,6 +201,11 @@ private slots:
     void sqlite_enableRegexp_data() { generic_data("QSQLITE"); }
     void sqlite_enableRegexp();
 
+    void sqlite_statementCache_data() { generic_data("QSQLITE"); }
+    void sqlite_statementCache();
+    void sqlite_pragmaOptions_data() { generic_data("QSQLITE"); }
+    void sqlite_pragmaOptions();
+
     void sqlite_openError();
 
     void sqlite_check_json1_data() { generic_data("QSQLITE"); }
@@ -2414,6 +2419,103 @@ void tst_QSqlDatabase::sqlite_enableRegexp()
     QFAIL_SQL(q, next());
 }
 
+void tst_QSqlDatabase::sqlite_statementCache()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    if (db.driverName().startsWith("QSQLITE2"))
+        QSKIP("SQLite3 specific test");
+
+    db.close();
+    db.setConnectOptions("QSQLITE_STATEMENT_CACHE_SIZE=2");
+    QVERIFY_SQL(db, open());
+
+    const QString tableName(qTableName("stmtcache_test", __FILE__, db));
+    {
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, exec(QString("CREATE TABLE %1(id INTEGER)").arg(tableName)));
+    }
+
+    const QString insert = QString("INSERT INTO %1 VALUES(?)").arg(tableName);
+    QVariant firstHandle;
+    for (int i = 0; i < 3; ++i) {
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, prepare(insert));
+        if (i == 0)
+            firstHandle = q.result()->handle();
+        else // the statement is reused instead of being prepared again
+            QCOMPARE(q.result()->handle(), firstHandle);
+        q.addBindValue(i);
+        QVERIFY_SQL(q, exec());
+    }
+
+    // A statement that is in use is not handed out twice
+    QSqlQuery q1(db);
+    QSqlQuery q2(db);
+    QVERIFY_SQL(q1, prepare(insert));
+    QVERIFY_SQL(q2, prepare(insert));
+    QVERIFY(q1.result()->handle() != q2.result()->handle());
+    q1.addBindValue(3);
+    q2.addBindValue(4);
+    QVERIFY_SQL(q1, exec());
+    QVERIFY_SQL(q2, exec());
+
+    QVERIFY_SQL(q1, exec(QString("SELECT id FROM %1 ORDER BY id").arg(tableName)));
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY_SQL(q1, next());
+        QCOMPARE(q1.value(0).toInt(), i);
+    }
+    QFAIL_SQL(q1, next());
+    q1.clear();
+    q2.clear();
+
+    db.close();
+    db.setConnectOptions();
+    QVERIFY_SQL(db, open());
+}
+
+void tst_QSqlDatabase::sqlite_pragmaOptions()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    if (db.driverName().startsWith("QSQLITE2"))
+        QSKIP("SQLite3 specific test");
+
+    db.close();
+    db.setConnectOptions("QSQLITE_JOURNAL_MODE=memory; QSQLITE_SYNCHRONOUS = OFF;"
+                         "QSQLITE_CACHE_SIZE=-4000;QSQLITE_MMAP_SIZE=0");
+    QVERIFY_SQL(db, open());
+    {
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, exec("PRAGMA journal_mode"));
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toString().toLower(), QString("memory"));
+        QVERIFY_SQL(q, exec("PRAGMA synchronous"));
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), 0);
+        QVERIFY_SQL(q, exec("PRAGMA cache_size"));
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), -4000);
+    }
+
+    // Invalid values are ignored
+    db.close();
+    db.setConnectOptions("QSQLITE_SYNCHRONOUS=sometimes;QSQLITE_CACHE_SIZE=big");
+    QVERIFY_SQL(db, open());
+    {
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, exec("PRAGMA synchronous"));
+        QVERIFY(q.next());
+        QVERIFY(q.value(0).toInt() != 0);
+    }
+
+    db.close();
+    db.setConnectOptions();
+    QVERIFY_SQL(db, open());
+}
+
 void tst_QSqlDatabase::sqlite_openError()
 {
     // see QTBUG-70506
@@ -251,6 +251,9 @@ private slots:
     void sqlite_real_data() { generic_data("QSQLITE"); }
     void sqlite_real();
 
+    void sqlite_cachedColumnTypes_data() { generic_data("QSQLITE"); }
+    void sqlite_cachedColumnTypes();
+
     void aggregateFunctionTypes_data() { generic_data(); }
     void aggregateFunctionTypes();
 
@@ -4428,6 +4431,60 @@ void tst_QSqlQuery::sqlite_real()
     QCOMPARE(q.value(0).toDouble(), 5.6);
 }
 
+void tst_QSqlQuery::sqlite_cachedColumnTypes()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString tableName(qTableName("sqlitecachedcolumns", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    // SQLite allows values of any type in any column, so the cached columns
+    // have to cope with nulls and with values of changing types
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName
+                        + " (id INTEGER, num INTEGER, txt TEXT, mixed, blb BLOB)"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName
+                        + " VALUES (1, NULL, NULL, NULL, NULL)"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName
+                        + " VALUES (2, 42, 'foo', 7, x'0102')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName
+                        + " VALUES (3, 43, '', 'bar', x'')"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + tableName
+                        + " VALUES (4, NULL, 'baz', 1.5, NULL)"));
+
+    QVERIFY(!q.isForwardOnly());
+    QVERIFY_SQL(q, exec("SELECT num, txt, mixed, blb FROM " + tableName + " ORDER BY id"));
+    QVERIFY(q.last());
+    QCOMPARE(q.at(), 3);
+
+    QVERIFY(q.isNull(0));
+    QCOMPARE(q.value(1), QVariant(QString("baz")));
+    QCOMPARE(q.value(2), QVariant(1.5));
+    QVERIFY(q.isNull(3));
+
+    QVERIFY(q.previous());
+    QCOMPARE(q.value(0), QVariant(qlonglong(43)));
+    QCOMPARE(q.value(1).toString(), QString(""));
+    QVERIFY(!q.value(1).isNull());
+    QCOMPARE(q.value(2), QVariant(QString("bar")));
+    QCOMPARE(q.value(3).toByteArray(), QByteArray());
+
+    QVERIFY(q.previous());
+    QCOMPARE(q.value(0), QVariant(qlonglong(42)));
+    QCOMPARE(q.value(1), QVariant(QString("foo")));
+    QCOMPARE(q.value(2), QVariant(qlonglong(7)));
+    QCOMPARE(q.value(3), QVariant(QByteArray("\x01\x02", 2)));
+
+    QVERIFY(q.first());
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(q.isNull(i));
+        QVERIFY(q.value(i).isNull());
+    }
+    QVERIFY(q.seek(3));
+    QCOMPARE(q.value(1), QVariant(QString("baz")));
+}
+
 void tst_QSqlQuery::aggregateFunctionTypes()
 {
     QFETCH(QString, dbName);
@@ -86,6 +86,8 @@ private slots:
     void insertColumns();
     void submitAll_data() { generic_data(); }
     void submitAll();
+    void submitAllUpdatesInPlace_data() { generic_data(); }
+    void submitAllUpdatesInPlace();
     void setData_data()  { generic_data(); }
     void setData();
     void setRecord_data()  { generic_data(); }
@@ -1098,6 +1100,50 @@ void tst_QSqlTableModel::submitAll()
     QCOMPARE(model.data(model.index(1, 1)).toString(), QString("trond"));
 }
 
+void tst_QSqlTableModel::submitAllUpdatesInPlace()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const auto test = qTableName("test1", __FILE__, db);
+
+    QSqlTableModel model(0, db);
+    model.setTable(test);
+    model.setSort(0, Qt::AscendingOrder);
+    model.setEditStrategy(QSqlTableModel::OnManualSubmit);
+    QVERIFY_SQL(model, select());
+
+    QSignalSpy modelResetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy dataChangedSpy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+
+    // Updates that cannot move rows are refreshed without resetting the model
+    QVERIFY(model.setData(model.index(1, 1), "trond2", Qt::EditRole));
+    dataChangedSpy.clear();
+    QVERIFY_SQL(model, submitAll());
+    QCOMPARE(modelResetSpy.count(), 0);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QModelIndex>(dataChangedSpy.at(0).at(0)), model.index(1, 0));
+    QVERIFY(!model.isDirty());
+    QCOMPARE(model.data(model.index(1, 1)).toString(), QString("trond2"));
+
+    QVERIFY(model.setData(model.index(1, 1), "trond", Qt::EditRole));
+    QVERIFY_SQL(model, submitAll());
+    QCOMPARE(modelResetSpy.count(), 0);
+    QCOMPARE(model.data(model.index(1, 1)).toString(), QString("trond"));
+
+    // Changing the sort column may reorder the rows
+    const int id = model.data(model.index(0, 0)).toInt();
+    QVERIFY(model.setData(model.index(0, 0), 100, Qt::EditRole));
+    QVERIFY_SQL(model, submitAll());
+    QCOMPARE(modelResetSpy.count(), 1);
+    QCOMPARE(model.data(model.index(model.rowCount() - 1, 0)).toInt(), 100);
+
+    QVERIFY(model.setData(model.index(model.rowCount() - 1, 0), id, Qt::EditRole));
+    QVERIFY_SQL(model, submitAll());
+    QCOMPARE(modelResetSpy.count(), 2);
+    QCOMPARE(model.data(model.index(0, 0)).toInt(), id);
+}
+
 void tst_QSqlTableModel::removeRow()
 {
     QFETCH(QString, dbName);
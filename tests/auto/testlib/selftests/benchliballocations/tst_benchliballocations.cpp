@@ -0,0 +1,73 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QTest>
+
+#include <stdlib.h>
+
+class tst_BenchlibAllocations : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void allocations_data();
+    void allocations();
+};
+
+void tst_BenchlibAllocations::allocations_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("0")  << 0;
+    QTest::newRow("1")  << 1;
+    QTest::newRow("10") << 10;
+}
+
+void tst_BenchlibAllocations::allocations()
+{
+    QFETCH(int, count);
+
+    // volatile, so that the compiler cannot elide the allocations
+    void *volatile blocks[10];
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            blocks[i] = malloc(1000);
+        for (int i = 0; i < count; ++i)
+            free(blocks[i]);
+    }
+}
+
+QTEST_MAIN_WRAPPER(tst_BenchlibAllocations,
+    std::vector<const char*> args(argv, argv + argc);
+    args.push_back("-allocations");
+    argc = args.size();
+    argv = const_cast<char**>(&args[0]);
+    QTEST_MAIN_SETUP())
+
+#include "tst_benchliballocations.moc"
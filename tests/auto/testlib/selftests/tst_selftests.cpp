@@ -87,6 +87,13 @@ static bool compareBenchmarkResult(BenchmarkResult const &r1, BenchmarkResult co
         variance = 0.001;
     else if (r1.unit == QLatin1String("CPU ticks") || r1.unit == QLatin1String("CPUTicks"))
         variance = 0.001;
+    else if (r1.unit == QLatin1String("bytes peak"))
+        variance = 0.1; // includes the rounding of the block sizes by malloc()
+    else if (r1.unit == QLatin1String("CPU cycles") || r1.unit == QLatin1String("instructions")
+             || r1.unit == QLatin1String("cache load misses")
+             || r1.unit == QLatin1String("cache misses")
+             || r1.unit == QLatin1String("branch misses"))
+        return true; // depend on the CPU; only the unit and the iterations are checked
 
     if (variance == 0.) {
         // No variance allowed - compare whole string
@@ -665,7 +672,8 @@ bool TestLogger::shouldIgnoreTest(const QString &test) const
     // testing by setting the QTEST_ENABLE_EXTRA_SELFTESTS environment
     // variable to something non-empty.
     static bool enableExtraTests = !qEnvironmentVariableIsEmpty("QTEST_ENABLE_EXTRA_SELFTESTS");
-    if (!enableExtraTests && (test == "benchlibtickcounter" || test == "benchlibwalltime"))
+    if (!enableExtraTests && (test == "benchlibtickcounter" || test == "benchlibwalltime"
+                              || test == "benchlibperfcountergroup"))
         return true;
 
 #if defined(Q_OS_WIN)
@@ -720,9 +728,13 @@ bool TestLogger::shouldIgnoreTest(const QString &test) const
 
         // These tests produce variable output (callgrind because of #if-ery,
         // crashes by virtue of platform differences in where the output cuts
-        // off), so only test them for one format, to avoid the need for several
-        // _n variants for each format. Also, crashes can produce invalid XML.
-        if (test == "crashes" || test == "benchlibcallgrind")
+        // off, the allocation and perf counter tests because of differences
+        // between machines), so only test them for one format, to avoid the
+        // need for several _n variants for each format. Also, crashes can
+        // produce invalid XML.
+        if (test == "crashes" || test == "benchlibcallgrind"
+            || test == "benchliballocations" || test == "benchlibperfcounterlist"
+            || test == "benchlibperfcountergroup")
             return true;
 
         // this test prints out some floats in the testlog and the formatting is
@@ -746,6 +758,11 @@ bool TestLogger::shouldIgnoreTest(const QString &test) const
     if (logger == (test.startsWith("benchlib") ? QTestLog::TeamCity : QTestLog::CSV))
         return true;
 
+    // The JSON logger's figures vary from run to run and are not line based,
+    // so there are no expectation files for it
+    if (logger == QTestLog::JSON)
+        return true;
+
     if (logger != QTestLog::JUnitXML && test == "junit")
         return true;
 
@@ -1137,8 +1154,9 @@ bool isCommandLineLogger(QTestLog::LogMode logger)
 
 bool isGenericCommandLineLogger(QTestLog::LogMode logger)
 {
-    // The CSV logger is only used for benchmarks
-    return isCommandLineLogger(logger) && logger != QTestLog::CSV;
+    // The CSV and JSON loggers are only used for benchmarks
+    return isCommandLineLogger(logger) && logger != QTestLog::CSV
+            && logger != QTestLog::JSON;
 }
 
 TEST_CASE("Loggers support both old and new style arguments")
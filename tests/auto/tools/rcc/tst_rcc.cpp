@@ -40,6 +40,7 @@
 #include <QtCore/QList>
 #include <QtCore/QResource>
 #include <QtCore/QLocale>
+#include <QtCore/QtEndian>
 #include <QtCore/QtGlobal>
 
 #include <algorithm>
@@ -95,6 +96,8 @@ private slots:
 
     void python();
 
+    void zstdDictionary();
+
     void cleanupTestCase();
 
 private:
@@ -492,12 +495,104 @@ void tst_rcc::python()
         QFAIL(qPrintable(diff));
 }
 
+void tst_rcc::zstdDictionary()
+{
+    const QString path = m_dataPath + QLatin1String("/zstddictionary");
+    const QString qrcFile = path + QLatin1String("/zstddictionary.qrc");
+    const QString cppFile = path + QLatin1String("/zstddictionary.qrc.cpp");
+    const QString rccFile = path + QLatin1String("/zstddictionary.rcc");
+
+    QProcess process;
+    process.setWorkingDirectory(path);
+    process.start(m_rcc, { "--verbose", "--zstd-dictionary-size", "1024", "-o", cppFile, qrcFile });
+    QVERIFY2(process.waitForStarted(), msgProcessStartFailed(process).constData());
+    if (!process.waitForFinished()) {
+        process.kill();
+        QFAIL(msgProcessTimeout(process).constData());
+    }
+    QVERIFY2(process.exitStatus() == QProcess::NormalExit,
+             msgProcessCrashed(process).constData());
+    QByteArray messages = process.readAllStandardError();
+    if (messages.contains("Zstandard support not compiled in"))
+        QSKIP("rcc was built without zstd support");
+    QVERIFY2(process.exitCode() == 0, messages.constData());
+
+    // all files have much in common, so each compresses better with the dictionary
+    QVERIFY2(messages.contains("note: trained zstd dictionary"), messages.constData());
+    QCOMPARE(messages.count("compressed using zstd with dictionary"), 16);
+
+    QFile cppOutput(cppFile);
+    QVERIFY(cppOutput.open(QIODevice::ReadOnly | QIODevice::Text));
+    const QByteArray code = cppOutput.readAll();
+    QVERIFY(code.contains("// zstd dictionary"));
+    QVERIFY(code.contains("extern const unsigned char qt_resourceFeatureZstdDictionary;"));
+    QVERIFY(code.contains("version += qResourceFeatureZstdDictionary();"));
+
+    // the binary format
+    process.start(m_rcc, { "-binary", "--zstd-dictionary-size", "1024", "-o", rccFile, qrcFile });
+    QVERIFY2(process.waitForStarted(), msgProcessStartFailed(process).constData());
+    if (!process.waitForFinished()) {
+        process.kill();
+        QFAIL(msgProcessTimeout(process).constData());
+    }
+    QVERIFY2(process.exitStatus() == QProcess::NormalExit,
+             msgProcessCrashed(process).constData());
+    QVERIFY2(process.exitCode() == 0,
+             msgProcessFailed(process).constData());
+
+    QFile rccOutput(rccFile);
+    QVERIFY(rccOutput.open(QIODevice::ReadOnly));
+    QByteArray rccData = rccOutput.readAll();
+    rccOutput.close();
+
+    // magic, version, offsets of tree, data and names, then the file flags:
+    // CompressedZstd and ZstdDictionary
+    QVERIFY(rccData.size() > 24);
+    QCOMPARE(qFromBigEndian<quint32>(rccData.constData() + 4), 3u);
+    QCOMPARE(qFromBigEndian<quint32>(rccData.constData() + 20), 0x0cu);
+
+    const QString rootPrefix = QLatin1String("/zstd_dictionary/");
+    QVERIFY(QResource::registerResource(rccFile, rootPrefix));
+    for (int i = 0; i < 16; ++i) {
+        const QString fileName = QString::fromLatin1("items/item-%1.json").arg(i);
+        QFile resourceFile(QLatin1Char(':') + rootPrefix + fileName);
+        QVERIFY(resourceFile.open(QIODevice::ReadOnly));
+        QFile sourceFile(path + QLatin1Char('/') + fileName);
+        QVERIFY(sourceFile.open(QIODevice::ReadOnly));
+        QCOMPARE(resourceFile.readAll(), sourceFile.readAll());
+    }
+    QVERIFY(QResource::unregisterResource(rccFile, rootPrefix));
+
+    // file flags unknown to QtCore make it reject the data, which is what
+    // keeps versions without dictionary support from misreading the files
+    qToBigEndian(quint32(0x0c | 0x80), rccData.data() + 20);
+    QVERIFY(!QResource::registerResource(reinterpret_cast<const uchar *>(rccData.constData()),
+                                         rootPrefix));
+
+    // the dictionary needs the file flags of format version 3
+    process.start(m_rcc, { "--format-version", "2", "--zstd-dictionary-size", "1024",
+                           "-o", cppFile, qrcFile });
+    QVERIFY2(process.waitForStarted(), msgProcessStartFailed(process).constData());
+    if (!process.waitForFinished()) {
+        process.kill();
+        QFAIL(msgProcessTimeout(process).constData());
+    }
+    QVERIFY2(process.exitStatus() == QProcess::NormalExit,
+             msgProcessCrashed(process).constData());
+    QVERIFY(process.exitCode() != 0);
+    messages = process.readAllStandardError();
+    QVERIFY2(messages.contains("Zstandard dictionaries require format version 3 or higher"),
+             messages.constData());
+}
+
 void tst_rcc::cleanupTestCase()
 {
     QDir dataDir(m_dataPath + QLatin1String("/binary"));
     QFileInfoList entries = dataDir.entryInfoList(QStringList() << QLatin1String("*.rcc"));
     QDir dataDepDir(m_dataPath + QLatin1String("/depfile"));
     entries += dataDepDir.entryInfoList({QLatin1String("*.d"), QLatin1String("*.qrc.cpp")});
+    QDir dataZstdDictionaryDir(m_dataPath + QLatin1String("/zstddictionary"));
+    entries += dataZstdDictionaryDir.entryInfoList({QLatin1String("*.rcc"), QLatin1String("*.qrc.cpp")});
     foreach (const QFileInfo &entry, entries)
         QFile::remove(entry.absoluteFilePath());
 }
@@ -30,6 +30,7 @@
 #include <QTest>
 #include <qpixmap.h>
 #include <private/qpixmapfilter_p.h>
+#include <private/qimage_p.h>
 #include <qpainter.h>
 
 class tst_QPixmapFilter : public QObject
@@ -48,6 +49,8 @@ private slots:
     void convolutionDrawSubRect();
     void dropShadowBoundingRectFor();
     void blurIndexed8();
+    void blurLargeImage();
+    void blurDrawRepeated();
 
     void testDefaultImplementations();
 };
@@ -411,5 +414,68 @@ void tst_QPixmapFilter::blurIndexed8()
     QCOMPARE(original.size(), QSize(img.height(), img.width()));
 }
 
+void tst_QPixmapFilter::blurLargeImage()
+{
+#if QT_CONFIG(thread)
+    // large enough for the rows to be blurred in several threads
+    QImage img(1024, 768, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < img.height(); ++y) {
+        for (int x = 0; x < img.width(); ++x)
+            img.setPixel(x, y, (x / 16 + y / 16) % 2 ? 0xffff8000 : 0x80000040);
+    }
+
+    QImage serial = img;
+    QThreadPool *threadPool = qt_imageThreadPool();
+    qt_setImageThreadPool(nullptr);
+    qt_blurImage(serial, 10, true, 0);
+    qt_setImageThreadPool(threadPool);
+
+    QImage parallel = img;
+    qt_blurImage(parallel, 10, true, 0);
+    QCOMPARE(parallel, serial);
+    QVERIFY(parallel != img);
+#else
+    QSKIP("This test requires threads");
+#endif
+}
+
+void tst_QPixmapFilter::blurDrawRepeated()
+{
+    QPixmap source(64, 64);
+    source.fill(Qt::transparent);
+    {
+        QPainter p(&source);
+        p.fillRect(16, 16, 32, 32, Qt::red);
+    }
+
+    QPixmapBlurFilter blur;
+    blur.setRadius(8);
+    QPixmapDropShadowFilter shadow;
+    shadow.setBlurRadius(6);
+
+    const auto draw = [&](const QPixmapFilter &filter) {
+        QImage target(100, 100, QImage::Format_ARGB32_Premultiplied);
+        target.fill(Qt::white);
+        QPainter p(&target);
+        filter.draw(&p, QPointF(10, 10), source);
+        return target;
+    };
+
+    // drawing the same source again reuses the blurred result
+    const QImage blurred = draw(blur);
+    QCOMPARE(draw(blur), blurred);
+    const QImage shadowed = draw(shadow);
+    QCOMPARE(draw(shadow), shadowed);
+
+    // but changes to the source or the filter are picked up
+    source.fill(Qt::blue);
+    QVERIFY(draw(blur) != blurred);
+    QVERIFY(draw(shadow) != shadowed);
+    shadow.setColor(Qt::green);
+    const QImage recolored = draw(shadow);
+    source.fill(Qt::transparent);
+    QVERIFY(draw(shadow) != recolored);
+}
+
 QTEST_MAIN(tst_QPixmapFilter)
 #include "tst_qpixmapfilter.moc"
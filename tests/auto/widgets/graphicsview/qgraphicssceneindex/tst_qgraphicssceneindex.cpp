@@ -33,6 +33,7 @@
 #include <private/qgraphicsscenebsptreeindex_p.h>
 #include <private/qgraphicssceneindex_p.h>
 #include <private/qgraphicsscenelinearindex_p.h>
+#include <private/qgraphicsscenequadtreeindex_p.h>
 
 class tst_QGraphicsSceneIndex : public QObject
 {
@@ -53,10 +54,12 @@ private slots:
     void boundingRectPointIntersection();
     void removeItems();
     void clear();
+    void quadTreeMatchesLinearIndex();
 
 private:
     void common_data();
     QGraphicsSceneIndex *createIndex(const QString &name);
+    static QGraphicsScene::ItemIndexMethod itemIndexMethod(const QString &name);
 };
 
 void tst_QGraphicsSceneIndex::initTestCase()
@@ -69,6 +72,16 @@ void tst_QGraphicsSceneIndex::common_data()
 
     QTest::newRow("BSP") << QString("bsp");
     QTest::newRow("Linear") << QString("linear");
+    QTest::newRow("QuadTree") << QString("quadtree");
+}
+
+QGraphicsScene::ItemIndexMethod tst_QGraphicsSceneIndex::itemIndexMethod(const QString &name)
+{
+    if (name == "linear")
+        return QGraphicsScene::NoIndex;
+    if (name == "quadtree")
+        return QGraphicsScene::QuadTreeIndex;
+    return QGraphicsScene::BspTreeIndex;
 }
 
 QGraphicsSceneIndex *tst_QGraphicsSceneIndex::createIndex(const QString &indexMethod)
@@ -81,6 +94,9 @@ QGraphicsSceneIndex *tst_QGraphicsSceneIndex::createIndex(const QString &indexMe
     if (indexMethod == "linear")
         index = new QGraphicsSceneLinearIndex(scene);
 
+    if (indexMethod == "quadtree")
+        index = new QGraphicsSceneQuadTreeIndex(scene);
+
     return index;
 }
 
@@ -94,7 +110,7 @@ void tst_QGraphicsSceneIndex::scatteredItems()
     QFETCH(QString, indexMethod);
 
     QGraphicsScene scene;
-    scene.setItemIndexMethod(indexMethod == "linear" ? QGraphicsScene::NoIndex : QGraphicsScene::BspTreeIndex);
+    scene.setItemIndexMethod(itemIndexMethod(indexMethod));
 
     for (int i = 0; i < 10; ++i)
         scene.addRect(i*50, i*50, 40, 35);
@@ -118,7 +134,7 @@ void tst_QGraphicsSceneIndex::overlappedItems()
     QFETCH(QString, indexMethod);
 
     QGraphicsScene scene;
-    scene.setItemIndexMethod(indexMethod == "linear" ? QGraphicsScene::NoIndex : QGraphicsScene::BspTreeIndex);
+    scene.setItemIndexMethod(itemIndexMethod(indexMethod));
 
     for (int i = 0; i < 10; ++i)
         for (int j = 0; j < 10; ++j)
@@ -147,7 +163,7 @@ void tst_QGraphicsSceneIndex::movingItems()
     QFETCH(QString, indexMethod);
 
     QGraphicsScene scene;
-    scene.setItemIndexMethod(indexMethod == "linear" ? QGraphicsScene::NoIndex : QGraphicsScene::BspTreeIndex);
+    scene.setItemIndexMethod(itemIndexMethod(indexMethod));
 
     for (int i = 0; i < 10; ++i)
         scene.addRect(i*50, i*50, 40, 35);
@@ -359,5 +375,62 @@ void tst_QGraphicsSceneIndex::clear()
     QTRY_VERIFY(item->numPaints > 0);
 }
 
+void tst_QGraphicsSceneIndex::quadTreeMatchesLinearIndex()
+{
+    QGraphicsScene linearScene;
+    linearScene.setItemIndexMethod(QGraphicsScene::NoIndex);
+    QGraphicsScene quadTreeScene;
+    quadTreeScene.setItemIndexMethod(QGraphicsScene::QuadTreeIndex);
+
+    // Enough items to be placed on the thread pool, of very different
+    // sizes, some of them with children.
+    QList<QGraphicsRectItem *> linearItems;
+    QList<QGraphicsRectItem *> quadTreeItems;
+    for (int i = 0; i < 5000; ++i) {
+        const QRectF rect((i * 37) % 2000, (i * 53) % 1500, 1 + (i % 7) * (i % 11), 1 + (i % 13) * 3);
+        linearItems << linearScene.addRect(rect);
+        quadTreeItems << quadTreeScene.addRect(rect);
+        if (i % 100 == 0) {
+            new QGraphicsRectItem(QRectF(0, 0, 5, 5), linearItems.last());
+            new QGraphicsRectItem(QRectF(0, 0, 5, 5), quadTreeItems.last());
+        }
+    }
+
+    const auto compare = [&] {
+        const QRectF queries[] = { QRectF(0, 0, 10, 10), QRectF(100, 200, 300, 50),
+                                   QRectF(1900, 1400, 500, 500), QRectF(-5000, -5000, 10000, 10000),
+                                   QRectF(2500, 100, 10, 10) };
+        for (const QRectF &query : queries) {
+            const QList<QGraphicsItem *> expected = linearScene.items(query, Qt::IntersectsItemShape,
+                                                                      Qt::AscendingOrder);
+            const QList<QGraphicsItem *> actual = quadTreeScene.items(query, Qt::IntersectsItemShape,
+                                                                      Qt::AscendingOrder);
+            QCOMPARE(actual.size(), expected.size());
+        }
+        QCOMPARE(quadTreeScene.items(QPointF(5, 5)).size(), linearScene.items(QPointF(5, 5)).size());
+    };
+    compare();
+
+    // Move items around, including far outside of the initial scene rect.
+    for (int i = 0; i < linearItems.size(); i += 3) {
+        const QPointF pos((i % 5) * 100 - 200, (i % 17) * 40);
+        linearItems.at(i)->setPos(pos);
+        quadTreeItems.at(i)->setPos(pos);
+    }
+    linearItems.at(1)->setPos(2500, 100);
+    quadTreeItems.at(1)->setPos(2500, 100);
+    compare();
+
+    // Let the index catch up with the grown scene rect.
+    QTest::qWait(10);
+    compare();
+
+    for (int i = 0; i < linearItems.size(); i += 2) {
+        delete linearItems.at(i);
+        delete quadTreeItems.at(i);
+    }
+    compare();
+}
+
 QTEST_MAIN(tst_QGraphicsSceneIndex)
 #include "tst_qgraphicssceneindex.moc"
@@ -250,6 +250,8 @@ private slots:
     void testResetCachedSizeHint();
     void statusTips();
     void testRemovingColumnsViaLayoutChanged();
+    void sectionPositionsAfterResize();
+    void resizeContentsSectionWindow();
 
 protected:
     void setupTestData(bool use_reset_model = false);
@@ -3676,5 +3678,74 @@ void tst_QHeaderView::testRemovingColumnsViaLayoutChanged()
     // The main point of this test is that the section-size restoring code didn't go out of bounds.
 }
 
+void tst_QHeaderView::sectionPositionsAfterResize()
+{
+    // positions are recalculated lazily; make sure they are never stale
+    QStandardItemModel model(2000, 1);
+    QHeaderView header(Qt::Vertical);
+    header.setMinimumSectionSize(1);
+    header.setDefaultSectionSize(20);
+    header.setModel(&model);
+
+    auto checkPositions = [&header]() {
+        int pos = 0;
+        for (int visual = 0; visual < header.count(); ++visual) {
+            const int logical = header.logicalIndex(visual);
+            QCOMPARE(header.sectionPosition(logical), pos);
+            if (header.sectionSize(logical) > 0)
+                QCOMPARE(header.logicalIndexAt(pos - header.offset()), logical);
+            pos += header.sectionSize(logical);
+        }
+        QCOMPARE(header.length(), pos);
+    };
+
+    QCOMPARE(header.sectionPosition(1999), 1999 * 20);
+    header.resizeSection(1500, 5);
+    QCOMPARE(header.sectionPosition(1501), 1500 * 20 + 5);
+    header.resizeSection(10, 40);
+    QCOMPARE(header.logicalIndexAt(1510 * 20 + 5 + 20), 1511);
+    checkPositions();
+
+    header.hideSection(3);
+    header.moveSection(1999, 0);
+    model.removeRows(500, 100);
+    model.insertRows(20, 7);
+    checkPositions();
+}
+
+void tst_QHeaderView::resizeContentsSectionWindow()
+{
+    QStandardItemModel model(1, 200);
+    for (int i = 0; i < model.columnCount(); ++i)
+        model.setHeaderData(i, Qt::Horizontal, QSize(77, 20), Qt::SizeHintRole);
+
+    QHeaderView header(Qt::Horizontal);
+    QCOMPARE(header.resizeContentsSectionWindow(), -1);
+    header.setMinimumSectionSize(10);
+    header.setDefaultSectionSize(30);
+    header.setModel(&model);
+    header.setResizeContentsSectionWindow(2);
+    QCOMPARE(header.resizeContentsSectionWindow(), 2);
+    header.resize(200, 25);
+    header.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&header));
+
+    header.setSectionResizeMode(QHeaderView::ResizeToContents);
+    header.resizeSections(QHeaderView::ResizeToContents);
+    QCOMPARE(header.sectionSize(0), 77);
+    QCOMPARE(header.sectionSize(4), 77);
+    QCOMPARE(header.sectionSize(50), 30);
+    QCOMPARE(header.sectionSize(100), 30);
+
+    // scrolling sizes the sections that come into the window
+    header.setOffset(header.sectionPosition(100));
+    QTRY_COMPARE(header.sectionSize(100), 77);
+    QCOMPARE(header.sectionSize(50), 30);
+
+    header.setResizeContentsSectionWindow(-1);
+    QTRY_COMPARE(header.sectionSize(50), 77);
+    QCOMPARE(header.length(), 200 * 77);
+}
+
 QTEST_MAIN(tst_QHeaderView)
 #include "tst_qheaderview.moc"
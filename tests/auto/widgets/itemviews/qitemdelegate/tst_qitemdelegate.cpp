@@ -57,6 +57,7 @@
 #include <QDialog>
 
 #include <qscreen.h>
+#include <qpainter.h>
 
 #include <QtWidgets/private/qabstractitemdelegate_p.h>
 
@@ -229,6 +230,7 @@ private slots:
     void QTBUG16469_textForRole();
     void dateTextForRole_data();
     void dateTextForRole();
+    void paintFetchesDataInOneBatch();
 
 private:
 #ifdef QT_BUILD_INTERNAL
@@ -1643,6 +1645,63 @@ void tst_QItemDelegate::dateTextForRole()
 #endif
 }
 
+class MultiDataCountingModel : public QAbstractTableModel
+{
+public:
+    int rowCount(const QModelIndex &) const override { return 1; }
+    int columnCount(const QModelIndex &) const override { return 1; }
+
+    QVariant data(const QModelIndex &, int role) const override
+    {
+        ++dataCalls;
+        return role == Qt::DisplayRole ? QVariant(QStringLiteral("text")) : QVariant();
+    }
+
+    void multiData(const QModelIndex &, QModelRoleDataSpan roleDataSpan) const override
+    {
+        ++multiDataCalls;
+        for (QModelRoleData &roleData : roleDataSpan) {
+            switch (roleData.role()) {
+            case Qt::DisplayRole:
+                roleData.setData(QStringLiteral("text"));
+                break;
+            case Qt::CheckStateRole:
+                roleData.setData(Qt::Checked);
+                break;
+            case Qt::BackgroundRole:
+                roleData.setData(QBrush(Qt::red));
+                break;
+            default:
+                roleData.clearData();
+                break;
+            }
+        }
+    }
+
+    mutable int dataCalls = 0;
+    mutable int multiDataCalls = 0;
+};
+
+void tst_QItemDelegate::paintFetchesDataInOneBatch()
+{
+    MultiDataCountingModel model;
+    QItemDelegate delegate;
+    QStyleOptionViewItem option;
+    option.rect = QRect(0, 0, 100, 20);
+    option.state = QStyle::State_Enabled;
+
+    QPixmap pixmap(option.rect.size());
+    QPainter painter(&pixmap);
+    delegate.paint(&painter, option, model.index(0, 0));
+    QCOMPARE(model.multiDataCalls, 1);
+    QCOMPARE(model.dataCalls, 0);
+
+    // the batch is dropped once painting is done
+    delegate.sizeHint(option, model.index(0, 0));
+    QVERIFY(model.dataCalls > 0);
+    QCOMPARE(model.multiDataCalls, 1);
+}
+
 // ### _not_ covered:
 
 // editing with a custom editor factory
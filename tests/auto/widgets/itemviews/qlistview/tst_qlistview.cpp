@@ -39,6 +39,7 @@
 #include <QtMath>
 #include <QProxyStyle>
 #include <QVBoxLayout>
+#include <QHBoxLayout>
 #include <QDialog>
 
 #include <QtTest/private/qtesthelpers_p.h>
@@ -179,6 +180,8 @@ private slots:
     void spacingWithWordWrap();
     void scrollOnRemove_data();
     void scrollOnRemove();
+    void uniformIconModeLayout_data();
+    void uniformIconModeLayout();
 };
 
 // Testing get/set functions
@@ -3177,6 +3180,79 @@ void tst_QListView::scrollOnRemove()
         QTRY_COMPARE(view.verticalScrollBar()->value(), item25Position);
 }
 
+void tst_QListView::uniformIconModeLayout_data()
+{
+    QTest::addColumn<QListView::Flow>("flow");
+    QTest::addColumn<QListView::LayoutMode>("layoutMode");
+
+    QTest::newRow("LeftToRight, SinglePass") << QListView::LeftToRight << QListView::SinglePass;
+    QTest::newRow("TopToBottom, SinglePass") << QListView::TopToBottom << QListView::SinglePass;
+    QTest::newRow("LeftToRight, Batched") << QListView::LeftToRight << QListView::Batched;
+}
+
+void tst_QListView::uniformIconModeLayout()
+{
+    QFETCH(QListView::Flow, flow);
+    QFETCH(QListView::LayoutMode, layoutMode);
+
+    // a view with uniform item sizes does its hit testing arithmetically and
+    // lays out appended rows incrementally; it must agree with a view that
+    // lays out every item on its own
+    QStandardItemModel model;
+    for (int i = 0; i < 150; ++i)
+        model.appendRow(new QStandardItem(QString::number(i)));
+
+    QWidget widget;
+    QHBoxLayout *layout = new QHBoxLayout(&widget);
+    PublicListView views[2];
+    for (PublicListView &view : views) {
+        view.setViewMode(QListView::IconMode);
+        view.setFlow(flow);
+        view.setWrapping(true);
+        view.setGridSize(QSize(50, 40));
+        view.setLayoutMode(layoutMode);
+        view.setBatchSize(32);
+        view.setModel(&model);
+        layout->addWidget(&view);
+    }
+    views[0].setUniformItemSizes(true);
+    widget.resize(640, 300);
+    widget.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&widget));
+
+    auto compareViews = [&]() {
+        for (int row = 0; row < model.rowCount(); ++row) {
+            const QModelIndex index = model.index(row, 0);
+            const QRect rect = views[1].visualRect(index);
+            QCOMPARE(views[0].visualRect(index), rect);
+            if (views[0].viewport()->rect().contains(rect.center()))
+                QCOMPARE(views[0].indexAt(rect.center()), index);
+        }
+    };
+
+    QTRY_COMPARE(views[0].visualRect(model.index(149, 0)),
+                 views[1].visualRect(model.index(149, 0)));
+    compareViews();
+
+    for (int i = 150; i < 200; ++i)
+        model.appendRow(new QStandardItem(QString::number(i)));
+    QTRY_COMPARE(views[0].visualRect(model.index(199, 0)),
+                 views[1].visualRect(model.index(199, 0)));
+    compareViews();
+
+    // the appended rows end up where a full layout puts them
+    views[1].doItemsLayout();
+    QTRY_COMPARE(views[0].visualRect(model.index(199, 0)),
+                 views[1].visualRect(model.index(199, 0)));
+    compareViews();
+
+    // moving an item takes it out of the grid
+    const QModelIndex moved = model.index(120, 0);
+    const QPoint target(3, views[0].contentsSize().height() + 100);
+    views[0].setPositionForIndex(target, moved);
+    QCOMPARE(views[0].indexAt(views[0].visualRect(moved).center()), moved);
+    QCOMPARE(views[0].indexAt(views[1].visualRect(moved).center()), QModelIndex());
+}
 
 QTEST_MAIN(tst_QListView)
 #include "tst_qlistview.moc"
@@ -154,6 +154,7 @@ private slots:
     void noModel();
     void emptyModel();
     void removeRows();
+    void incrementalRowChanges();
     void removeCols();
     void limitedExpand();
     void expandAndCollapse_data();
@@ -1506,6 +1507,67 @@ void tst_QTreeView::removeRows()
     QVERIFY(!model.wrongIndex);
 }
 
+void tst_QTreeView::incrementalRowChanges()
+{
+    // Rows inserted or removed under expanded items are laid out without
+    // a full relayout; the result must be the same as that of one.
+    QStandardItemModel model;
+    for (int i = 0; i < 6; ++i) {
+        QStandardItem *item = new QStandardItem(QString::number(i));
+        item->setSizeHint(QSize(50, 15 + i));
+        for (int j = 0; j < 3; ++j) {
+            QStandardItem *child = new QStandardItem(QString::number(i) + QString::number(j));
+            child->setSizeHint(QSize(50, 20 + j));
+            child->appendRow(new QStandardItem(QLatin1String("leaf")));
+            item->appendRow(child);
+        }
+        model.appendRow(item);
+    }
+
+    QTreeView view;
+    view.setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view.setModel(&model);
+    view.resize(300, 200);
+    view.expand(model.index(1, 0));
+    view.expand(model.index(3, 0));
+    view.expand(model.index(0, 0, model.index(3, 0)));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const auto rows = [&view, &model] {
+        QList<QPair<QModelIndex, int>> result;
+        for (QModelIndex index = model.index(0, 0); index.isValid(); index = view.indexBelow(index))
+            result.append({ index, view.visualRect(index).top() });
+        return result;
+    };
+    const auto verifyLayout = [&] {
+        const auto incremental = rows();
+        view.doItemsLayout();
+        QCOMPARE(incremental, rows());
+    };
+
+    model.insertRow(2, new QStandardItem(QLatin1String("new top-level")));
+    verifyLayout();
+    model.item(1)->insertRow(0, new QStandardItem(QLatin1String("new first child")));
+    verifyLayout();
+    model.item(4)->appendRow(new QStandardItem(QLatin1String("new last child")));
+    verifyLayout();
+    QStandardItem *expandedChild = model.item(4)->child(0);
+    expandedChild->insertRow(1, new QStandardItem(QLatin1String("new grandchild")));
+    verifyLayout();
+    model.item(0)->appendRow(new QStandardItem(QLatin1String("collapsed")));
+    verifyLayout();
+
+    model.item(4)->removeRows(0, 2);
+    verifyLayout();
+    model.item(1)->removeRow(model.item(1)->rowCount() - 1);
+    verifyLayout();
+    model.item(1)->removeRows(0, model.item(1)->rowCount());
+    verifyLayout();
+    model.removeRows(1, 2);
+    verifyLayout();
+}
+
 void tst_QTreeView::removeCols()
 {
     QtTestModel model(5, 8);
@@ -298,6 +298,7 @@ private slots:
     void clean_qt_x11_enforce_cursor();
 
     void childEvents();
+    void deferredPolishOfHiddenChildren();
     void render();
     void renderChildFillsBackground();
     void renderTargetOffset();
@@ -7285,6 +7286,49 @@ void tst_QWidget::childEvents()
     }
 }
 
+class PolishCountingWidget : public QWidget
+{
+public:
+    using QWidget::QWidget;
+    int polishCount = 0;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::Polish)
+            ++polishCount;
+        return QWidget::event(e);
+    }
+};
+
+void tst_QWidget::deferredPolishOfHiddenChildren()
+{
+    QWidget widget;
+    widget.resize(200, 200);
+    auto *visibleChild = new PolishCountingWidget(&widget);
+    auto *hiddenChild = new PolishCountingWidget(&widget);
+    auto *hiddenGrandChild = new PolishCountingWidget(hiddenChild);
+    auto *otherHiddenChild = new PolishCountingWidget(&widget);
+    hiddenChild->hide();
+    otherHiddenChild->hide();
+
+    widget.show();
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(visibleChild->polishCount, 1);
+    QCOMPARE(hiddenChild->polishCount, 0);
+    QCOMPARE(hiddenGrandChild->polishCount, 0);
+
+    hiddenChild->show();
+    QCOMPARE(hiddenChild->polishCount, 1);
+    QCOMPARE(hiddenGrandChild->polishCount, 1);
+
+    // An explicit request still polishes hidden subtrees.
+    QCOMPARE(otherHiddenChild->polishCount, 0);
+    widget.ensurePolished();
+    QCOMPARE(otherHiddenChild->polishCount, 1);
+    QCOMPARE(visibleChild->polishCount, 1);
+}
+
 class RenderWidget : public QWidget
 {
 public:
@@ -87,6 +87,7 @@ private slots:
     void reparentWithNoChildStyleSheet();
     void reparentWithChildStyleSheet();
     void dynamicProperty();
+    void sharedStyleRules();
     // NB! Invoking this slot after layoutSpacing crashes on Mac.
     void namespaces();
 #ifdef Q_OS_MAC
@@ -669,6 +670,49 @@ void tst_QStyleSheetStyle::dynamicProperty()
     QVERIFY(COLOR(pb2) == Qt::blue);
 }
 
+void tst_QStyleSheetStyle::sharedStyleRules()
+{
+    qApp->setStyleSheet(QString());
+
+    QWidget w;
+    w.setStyleSheet("QPushButton { color: red; } "
+                    "QPushButton[flag=\"true\"] { color: green; } "
+                    ".warning { color: yellow; } "
+                    "#special { color: blue; }");
+    QPushButton pb1(&w);
+    QPushButton pb2(&w);
+    QPushButton pb3(&w);
+    pb3.setProperty("flag", true);
+    QPushButton pb4(&w);
+    pb4.setObjectName("special");
+    QPushButton pb5(&w);
+    pb5.setProperty("class", "button warning");
+
+    QCOMPARE(COLOR(pb1), QColor(Qt::red));
+    QCOMPARE(COLOR(pb2), QColor(Qt::red));
+    QCOMPARE(COLOR(pb3), QColor(Qt::green));
+    QCOMPARE(COLOR(pb4), QColor(Qt::blue));
+    QCOMPARE(COLOR(pb5), QColor(Qt::yellow));
+
+    // a widget leaves the rules it shared with its siblings once it is repolished
+    pb2.setProperty("flag", true);
+    pb2.style()->unpolish(&pb2);
+    pb2.style()->polish(&pb2);
+    QCOMPARE(COLOR(pb2), QColor(Qt::green));
+    QCOMPARE(COLOR(pb1), QColor(Qt::red));
+
+    // changing a style sheet invalidates the shared rules
+    w.setStyleSheet("QPushButton { color: white; }");
+    QCOMPARE(COLOR(pb1), QColor(Qt::white));
+    QCOMPARE(COLOR(pb3), QColor(Qt::white));
+
+    qApp->setStyleSheet("QPushButton { color: black; }");
+    w.setStyleSheet(QString());
+    QCOMPARE(COLOR(pb1), QColor(Qt::black));
+    QCOMPARE(COLOR(pb4), QColor(Qt::black));
+    qApp->setStyleSheet(QString());
+}
+
 #ifdef Q_OS_MAC
 void tst_QStyleSheetStyle::layoutSpacing()
 {
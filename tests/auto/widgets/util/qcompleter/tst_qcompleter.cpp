@@ -132,6 +132,7 @@ private slots:
 
     void dynamicSortOrder();
     void disabledItems();
+    void largeUnsortedModel();
 
     // task-specific tests below me
     void task178797_activatedOnReturn();
@@ -1189,6 +1190,55 @@ void tst_QCompleter::disabledItems()
     QVERIFY(!view->isVisible());
 }
 
+static QStringList completions(QCompleter *completer, const QString &prefix)
+{
+    completer->setCompletionPrefix(prefix);
+    QStringList result;
+    for (int row = 0; completer->setCurrentRow(row); ++row)
+        result << completer->currentCompletion();
+    return result;
+}
+
+void tst_QCompleter::largeUnsortedModel()
+{
+    // big enough for the completer to index the model
+    const int count = 20000;
+    QStringList strings;
+    for (int i = 0; i < count; ++i)
+        strings << QLatin1String(i % 2 ? "Item" : "item") + QString::number((i * 7919) % count);
+    QStringListModel model(strings);
+    QCompleter completer(&model);
+    completer.setCaseSensitivity(Qt::CaseInsensitive);
+
+    auto expected = [&](const QString &prefix, Qt::MatchFlags mode) {
+        QStringList result;
+        for (const QString &s : qAsConst(strings)) {
+            if ((mode == Qt::MatchContains && s.contains(prefix, Qt::CaseInsensitive))
+                || (mode == Qt::MatchStartsWith && s.startsWith(prefix, Qt::CaseInsensitive)))
+                result << s;
+        }
+        return result;
+    };
+
+    // narrowing while the index may still be sorted in the background
+    for (const char *prefix : { "item1", "ITEM19", "item199", "item1999", "item1999x" })
+        QCOMPARE(completions(&completer, prefix), expected(prefix, Qt::MatchStartsWith));
+
+#if QT_CONFIG(thread)
+    QThreadPool::globalInstance()->waitForDone();
+#endif
+    for (const char *prefix : { "item2", "Item27", "item2718", "item27189", "ix" })
+        QCOMPARE(completions(&completer, prefix), expected(prefix, Qt::MatchStartsWith));
+
+    model.setData(model.index(0, 0), QStringLiteral("item27180"));
+    strings[0] = QStringLiteral("item27180");
+    QCOMPARE(completions(&completer, "item2718"), expected("item2718", Qt::MatchStartsWith));
+
+    completer.setFilterMode(Qt::MatchContains);
+    for (const char *prefix : { "9", "99", "M99", "m999" })
+        QCOMPARE(completions(&completer, prefix), expected(prefix, Qt::MatchContains));
+}
+
 void tst_QCompleter::task178797_activatedOnReturn()
 {
     if (QGuiApplication::platformName().startsWith(QLatin1String("wayland"), Qt::CaseInsensitive))
@@ -118,6 +118,7 @@ private slots:
     void DTDNotationDecl();
     void DTDEntityDecl();
     void QTBUG49113_dontCrashWithNegativeIndex() const;
+    void repeatedNames() const;
 
     void cleanupTestCase() const;
 
@@ -2033,5 +2034,37 @@ void tst_QDom::QTBUG49113_dontCrashWithNegativeIndex() const
     QVERIFY(node.isNull());
 }
 
+void tst_QDom::repeatedNames() const
+{
+    QString xml = QStringLiteral("<r:root xmlns:r=\"urn:r\">");
+    for (int i = 0; i < 100; ++i)
+        xml += QStringLiteral("<r:item r:id=\"%1\" kind=\"x\"/>").arg(i);
+    xml += QStringLiteral("</r:root>");
+
+    QDomDocument doc;
+    QVERIFY(doc.setContent(xml, true));
+    const QDomNodeList items = doc.documentElement().childNodes();
+    QCOMPARE(items.count(), 100);
+    for (int i = 0; i < items.count(); ++i) {
+        const QDomElement item = items.at(i).toElement();
+        QCOMPARE(item.localName(), QStringLiteral("item"));
+        QCOMPARE(item.prefix(), QStringLiteral("r"));
+        QCOMPARE(item.namespaceURI(), QStringLiteral("urn:r"));
+        QCOMPARE(item.attributeNS("urn:r", "id"), QString::number(i));
+        QCOMPARE(item.attribute("kind"), QStringLiteral("x"));
+    }
+
+    // names stay independent of each other after parsing
+    QDomElement first = items.at(0).toElement();
+    first.setPrefix("s");
+    QCOMPARE(first.prefix(), QStringLiteral("s"));
+    QCOMPARE(items.at(1).prefix(), QStringLiteral("r"));
+
+    // nodes created after parsing are unaffected
+    QDomElement created = doc.createElementNS("urn:r", "r:item");
+    doc.documentElement().appendChild(created);
+    QCOMPARE(created.localName(), QStringLiteral("item"));
+}
+
 QTEST_MAIN(tst_QDom)
 #include "tst_qdom.moc"
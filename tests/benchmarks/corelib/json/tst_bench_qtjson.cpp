@@ -29,6 +29,8 @@
 #include <QTest>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <private/qcborvalue_p.h>
+#include <private/qjsonlazydocument_p.h>
 
 class BenchmarkQtJson: public QObject
 {
@@ -45,6 +47,8 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseJsonLazy();
+    void parseJsonArena();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -117,6 +121,36 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtJson::parseJsonLazy()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    // index the document but only decode one of its members
+    QBENCHMARK {
+        QJsonPrivate::LazyDocument doc(testJson);
+        QJsonValue value = doc.valueAt(0);
+    }
+}
+
+void BenchmarkQtJson::parseJsonArena()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    QCborArenaDecoder decoder;
+    QBENCHMARK {
+        QJsonDocument doc = decoder.fromJson(testJson);
+        QJsonObject object = doc.object();
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
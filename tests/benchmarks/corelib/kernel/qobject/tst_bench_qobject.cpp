@@ -31,6 +31,13 @@
 #include "object.h"
 #include <qcoreapplication.h>
 #include <qdatetime.h>
+#include <private/qobject_p.h>
+
+#include <memory>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
 
 enum {
     CreationDeletionBenckmarkConstant = 34567,
@@ -53,6 +60,10 @@ private slots:
     void receiver_destroyed_benchmark();
 
     void stdAllocator();
+    void construction_data();
+    void construction();
+    void residentBytesPerObject_data();
+    void residentBytesPerObject();
 };
 
 class QObjectUsingStandardAllocator : public QObject
@@ -100,6 +111,85 @@ void tst_QObject::stdAllocator()
     allocator<QObjectUsingStandardAllocator>();
 }
 
+class CoAllocatedObject final : public QObject
+{
+    Q_OBJECT
+    Q_OBJECT_CO_ALLOCATED
+public:
+    explicit CoAllocatedObject(QObjectPrivate &dd, QObject *parent = nullptr)
+        : QObject(dd, parent)
+    {
+    }
+};
+
+static QObject *createObject(bool coAllocated, QObject *parent = nullptr)
+{
+    if (coAllocated)
+        return QObjectPrivate::createCoAllocated<CoAllocatedObject>(parent);
+    return new QObject(parent);
+}
+
+static void addAllocationRows()
+{
+    QTest::addColumn<bool>("coAllocated");
+    QTest::newRow("separate private") << false;
+    QTest::newRow("co-allocated private") << true;
+}
+
+void tst_QObject::construction_data()
+{
+    addAllocationRows();
+}
+
+void tst_QObject::construction()
+{
+    QFETCH(bool, coAllocated);
+    const int count = 64 * 1024;
+    std::unique_ptr<QObject *[]> objects(new QObject *[count]);
+    QBENCHMARK {
+        for (int i = 0; i < count; ++i)
+            objects[i] = createObject(coAllocated);
+        for (int i = 0; i < count; ++i)
+            delete objects[i];
+    }
+}
+
+#ifdef Q_OS_LINUX
+static qint64 residentBytes()
+{
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+}
+#endif
+
+void tst_QObject::residentBytesPerObject_data()
+{
+    addAllocationRows();
+}
+
+void tst_QObject::residentBytesPerObject()
+{
+#ifdef Q_OS_LINUX
+    QFETCH(bool, coAllocated);
+    const int count = 1024 * 1024;
+    QObject root;
+    const qint64 before = residentBytes();
+    for (int i = 0; i < count; ++i)
+        createObject(coAllocated, &root);
+    const qint64 after = residentBytes();
+    if (before < 0 || after < 0)
+        QSKIP("Cannot read /proc/self/statm");
+    QTest::setBenchmarkResult(qreal(after - before) / count, QTest::BytesAllocated);
+#else
+    QSKIP("Resident set size is only measured on Linux");
+#endif
+}
+
 struct Functor {
     void operator()(){}
 };
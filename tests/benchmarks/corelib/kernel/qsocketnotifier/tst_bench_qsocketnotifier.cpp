@@ -0,0 +1,240 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QTest>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qeventloop.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qsocketnotifier.h>
+
+#ifdef Q_OS_WIN
+#  include <winsock2.h>
+#else
+#  include <sys/resource.h>
+#  include <errno.h>
+#  include <unistd.h>
+#endif
+
+// Measures the cost of one socket notifier activation while a varying number
+// of idle notifiers is registered with the thread's event dispatcher.
+//
+// Run it once as is and once with the scalable backend enabled to compare how
+// the two scale with the number of registered descriptors:
+//  - Linux: QT_EVENTDISPATCHER_EPOLL=1 (epoll instead of poll())
+//  - Windows: QT_EVENTDISPATCHER_AFD=1 (AFD polls instead of WSAAsyncSelect())
+
+#ifdef Q_OS_WIN
+// Unconnected UDP sockets on the loopback interface: the idle ones are never
+// sent to, the active pair sends one datagram per iteration.
+static qintptr createBoundSocket()
+{
+    SOCKET s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET)
+        return -1;
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(s, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+        ::closesocket(s);
+        return -1;
+    }
+    return qintptr(s);
+}
+
+static bool createActivePair(qintptr fds[2])
+{
+    fds[0] = createBoundSocket();
+    fds[1] = createBoundSocket();
+    sockaddr_in addr;
+    int len = sizeof(addr);
+    return fds[0] != -1 && fds[1] != -1
+            && ::getsockname(SOCKET(fds[0]), reinterpret_cast<sockaddr *>(&addr), &len) == 0
+            && ::connect(SOCKET(fds[1]), reinterpret_cast<sockaddr *>(&addr), len) == 0;
+}
+
+static qintptr createIdle(qintptr)
+{
+    return createBoundSocket();
+}
+
+static bool writeByte(qintptr fd)
+{
+    const char c = 'x';
+    return ::send(SOCKET(fd), &c, 1, 0) == 1;
+}
+
+static bool readByte(qintptr fd)
+{
+    char c;
+    return ::recv(SOCKET(fd), &c, 1, 0) == 1;
+}
+
+static void closeDescriptor(qintptr fd)
+{
+    if (fd != -1)
+        ::closesocket(SOCKET(fd));
+}
+#else
+// The read ends of pipes: the idle ones are duplicates of a pipe that is
+// never written to, the active pair gets one byte per iteration.
+static bool createActivePair(qintptr fds[2])
+{
+    int p[2];
+    if (::pipe(p) != 0)
+        return false;
+    fds[0] = p[0];
+    fds[1] = p[1];
+    return true;
+}
+
+static qintptr createIdle(qintptr idleSource)
+{
+    return ::dup(int(idleSource));
+}
+
+static bool writeByte(qintptr fd)
+{
+    const char c = 'x';
+    return ::write(int(fd), &c, 1) == 1;
+}
+
+static bool readByte(qintptr fd)
+{
+    char c;
+    return ::read(int(fd), &c, 1) == 1;
+}
+
+static void closeDescriptor(qintptr fd)
+{
+    if (fd != -1)
+        ::close(int(fd));
+}
+#endif
+
+class tst_QSocketNotifier : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void activation_data();
+    void activation();
+
+private:
+    int maxDescriptors = 0;
+};
+
+void tst_QSocketNotifier::initTestCase()
+{
+#ifdef Q_OS_WIN
+    WSADATA wsaData;
+    QCOMPARE(WSAStartup(MAKEWORD(2, 2), &wsaData), 0);
+    // Windows has no per-process descriptor limit worth mentioning
+    maxDescriptors = std::numeric_limits<int>::max();
+#else
+    // Allow as many descriptors as the hard limit permits.
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        if (limit.rlim_cur < limit.rlim_max) {
+            limit.rlim_cur = limit.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &limit);
+            getrlimit(RLIMIT_NOFILE, &limit);
+        }
+        maxDescriptors = limit.rlim_cur == RLIM_INFINITY
+                ? std::numeric_limits<int>::max()
+                : int(qMin<rlim_t>(limit.rlim_cur, std::numeric_limits<int>::max()));
+    }
+#endif
+}
+
+void tst_QSocketNotifier::cleanupTestCase()
+{
+#ifdef Q_OS_WIN
+    WSACleanup();
+#endif
+}
+
+void tst_QSocketNotifier::activation_data()
+{
+    QTest::addColumn<int>("idleNotifiers");
+
+    for (int count : { 0, 16, 256, 4096, 16384 })
+        QTest::addRow("idle-%d", count) << count;
+}
+
+void tst_QSocketNotifier::activation()
+{
+    QFETCH(int, idleNotifiers);
+
+    // the active pair, stdio and some slack for the test library
+    if (idleNotifiers + 32 > maxDescriptors)
+        QSKIP("Not enough file descriptors available for this row");
+
+    qintptr active[2];
+    QVERIFY(createActivePair(active));
+
+    qintptr idle[2];
+    QVERIFY(createActivePair(idle));
+
+    QList<qintptr> idleFds;
+    QList<QSocketNotifier *> notifiers;
+    idleFds.reserve(idleNotifiers);
+    notifiers.reserve(idleNotifiers);
+    for (int i = 0; i < idleNotifiers; ++i) {
+        const qintptr fd = createIdle(idle[0]);
+        QVERIFY2(fd != -1, qPrintable(qt_error_string()));
+        idleFds.append(fd);
+        notifiers.append(new QSocketNotifier(fd, QSocketNotifier::Read));
+    }
+
+    QSocketNotifier notifier(active[0], QSocketNotifier::Read);
+    int activations = 0;
+    connect(&notifier, &QSocketNotifier::activated, [&](QSocketDescriptor fd) {
+        if (readByte(fd))
+            ++activations;
+    });
+
+    QBENCHMARK {
+        QVERIFY(writeByte(active[1]));
+        const int expected = activations + 1;
+        while (activations < expected)
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    }
+
+    qDeleteAll(notifiers);
+    for (qintptr fd : qAsConst(idleFds))
+        closeDescriptor(fd);
+    closeDescriptor(idle[0]);
+    closeDescriptor(idle[1]);
+    closeDescriptor(active[0]);
+    closeDescriptor(active[1]);
+}
+
+QTEST_MAIN(tst_QSocketNotifier)
+
+#include "tst_bench_qsocketnotifier.moc"
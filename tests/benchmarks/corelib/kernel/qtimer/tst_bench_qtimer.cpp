@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtCore/qobject.h>
+#include <QtCore/qtimer.h>
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void restart_data();
+    void restart();
+    void startKillTimer_data();
+    void startKillTimer();
+};
+
+static void populateTimerCounts()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("50000") << 50000;
+}
+
+void tst_QTimer::restart_data()
+{
+    populateTimerCounts();
+}
+
+// Restarts every timer of a large set, the typical pattern of watchdogs and
+// idle timeouts that are pushed back on each bit of activity.
+void tst_QTimer::restart()
+{
+    QFETCH(int, count);
+
+    std::vector<std::unique_ptr<QTimer>> timers;
+    timers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto timer = std::make_unique<QTimer>();
+        timer->setInterval(10000 + (i * 7919) % 50000);
+        timer->start();
+        timers.push_back(std::move(timer));
+    }
+
+    QBENCHMARK {
+        for (const auto &timer : timers)
+            timer->start();
+    }
+}
+
+void tst_QTimer::startKillTimer_data()
+{
+    populateTimerCounts();
+}
+
+// Starts and kills a single timer while many others are registered.
+void tst_QTimer::startKillTimer()
+{
+    QFETCH(int, count);
+
+    QObject owner;
+    for (int i = 0; i < count; ++i)
+        owner.startTimer(10000 + (i * 7919) % 50000);
+
+    QObject object;
+    QBENCHMARK {
+        const int id = object.startTimer(30000);
+        object.killTimer(id);
+    }
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
@@ -29,6 +29,7 @@
 #include <QDebug>
 #include <QIODevice>
 #include <QFile>
+#include <QLocale>
 #include <QString>
 
 #include <qtest.h>
@@ -47,6 +48,10 @@ private slots:
     void toLongLong();
     void toULongLong_data();
     void toULongLong();
+    void toDouble_data();
+    void toDouble();
+    void numberDouble_data();
+    void numberDouble();
 
     void latin1Uppercasing_qt54();
     void latin1Uppercasing_xlate();
@@ -174,6 +179,73 @@ void tst_QByteArray::toULongLong()
     QCOMPARE(ok, good);
 }
 
+void tst_QByteArray::toDouble_data()
+{
+    QTest::addColumn<QByteArray>("text");
+    QTest::addColumn<bool>("good");
+    QTest::addColumn<double>("number");
+#define ROW(n) QTest::newRow(#n) << QByteArray(#n) << true << double(n)
+    ROW(0);
+    ROW(1);
+    ROW(-17.5);
+    ROW(0.1);
+    ROW(3.14159265358979);
+    ROW(-1.7976931348623157e+308);
+    ROW(4.9406564584124654e-324);
+    ROW(123456789012345678901234567890.0);
+#undef ROW
+    QTest::newRow("spaces") << QByteArray("  6.02214076e23\t") << true << 6.02214076e23;
+    QTest::newRow("overflow") << QByteArray("1e400") << false << qInf();
+    QTest::newRow("garbage") << QByteArray("1.5x") << false << 0.0;
+}
+
+void tst_QByteArray::toDouble()
+{
+    QFETCH(QByteArray, text);
+    QFETCH(bool, good);
+    QFETCH(double, number);
+
+    double actual = 0;
+    bool ok;
+    QBENCHMARK {
+        actual = text.toDouble(&ok);
+    }
+    QCOMPARE(actual, number);
+    QCOMPARE(ok, good);
+}
+
+void tst_QByteArray::numberDouble_data()
+{
+    QTest::addColumn<double>("number");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<int>("precision");
+    QTest::addColumn<QByteArray>("expected");
+
+    const int shortest = QLocale::FloatingPointShortest;
+    QTest::newRow("0.1-shortest") << 0.1 << 'g' << shortest << QByteArray("0.1");
+    QTest::newRow("pi-shortest") << 3.141592653589793 << 'g' << shortest << QByteArray("3.141592653589793");
+    QTest::newRow("pi-g6") << 3.141592653589793 << 'g' << 6 << QByteArray("3.14159");
+    QTest::newRow("pi-f2") << 3.141592653589793 << 'f' << 2 << QByteArray("3.14");
+    QTest::newRow("big-shortest") << 6.02214076e23 << 'g' << shortest << QByteArray("6.02214076e+23");
+    QTest::newRow("big-e3") << 6.02214076e23 << 'e' << 3 << QByteArray("6.022e+23");
+    QTest::newRow("max-shortest") << std::numeric_limits<double>::max() << 'g' << shortest
+                                  << QByteArray("1.7976931348623157e+308");
+}
+
+void tst_QByteArray::numberDouble()
+{
+    QFETCH(double, number);
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    QFETCH(QByteArray, expected);
+
+    QByteArray actual;
+    QBENCHMARK {
+        actual = QByteArray::number(number, format, precision);
+    }
+    QCOMPARE(actual, expected);
+}
+
 void tst_QByteArray::latin1Uppercasing_qt54()
 {
     QByteArray s = sourcecode;
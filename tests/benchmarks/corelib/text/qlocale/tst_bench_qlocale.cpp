@@ -54,6 +54,10 @@ private Q_SLOTS:
     void toUpper_QLocale_2();
     void toUpper_QString();
     void number_QString();
+    void number_double_data();
+    void number_double();
+    void toDouble_data();
+    void toDouble();
 };
 
 static QString data()
@@ -392,6 +396,60 @@ void tst_QLocale::number_QString()
     }
 }
 
+void tst_QLocale::number_double_data()
+{
+    QTest::addColumn<double>("number");
+    QTest::addColumn<int>("precision");
+    QTest::addColumn<QString>("expected");
+
+    const int shortest = QLocale::FloatingPointShortest;
+    QTest::newRow("0.1-shortest") << 0.1 << shortest << QStringLiteral("0.1");
+    QTest::newRow("pi-shortest") << 3.141592653589793 << shortest
+                                 << QStringLiteral("3.141592653589793");
+    QTest::newRow("pi-6") << 3.141592653589793 << 6 << QStringLiteral("3.14159");
+    QTest::newRow("tiny-shortest") << -1.5e-300 << shortest << QStringLiteral("-1.5e-300");
+    QTest::newRow("integer-shortest") << 12345678.0 << shortest << QStringLiteral("12345678");
+}
+
+void tst_QLocale::number_double()
+{
+    QFETCH(double, number);
+    QFETCH(int, precision);
+    QFETCH(QString, expected);
+
+    QString s;
+    QBENCHMARK {
+        s = QString::number(number, 'g', precision);
+    }
+    QCOMPARE(s, expected);
+}
+
+void tst_QLocale::toDouble_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<double>("number");
+
+    QTest::newRow("0") << QStringLiteral("0") << 0.0;
+    QTest::newRow("0.1") << QStringLiteral("0.1") << 0.1;
+    QTest::newRow("pi") << QStringLiteral("3.141592653589793") << 3.141592653589793;
+    QTest::newRow("tiny") << QStringLiteral("-1.5e-300") << -1.5e-300;
+    QTest::newRow("integer") << QStringLiteral("12345678") << 12345678.0;
+}
+
+void tst_QLocale::toDouble()
+{
+    QFETCH(QString, text);
+    QFETCH(double, number);
+
+    double d = 0;
+    bool ok = false;
+    QBENCHMARK {
+        d = text.toDouble(&ok);
+    }
+    QVERIFY(ok);
+    QCOMPARE(d, number);
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
@@ -57,6 +57,11 @@ private slots:
     void number_double_data();
     void number_double();
 
+    void toUtf8_data();
+    void toUtf8();
+    void fromUtf8_data();
+    void fromUtf8();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
@@ -319,6 +324,51 @@ void tst_QString::number_double()
     QCOMPARE(actual, expected);
 }
 
+void tst_QString::toUtf8_data()
+{
+    QTest::addColumn<QString>("s");
+
+    auto repeat = [](QStringView pattern, int count) {
+        QString result;
+        for (int i = 0; i < count; ++i)
+            result += pattern;
+        return result;
+    };
+
+    QTest::newRow("ascii") << repeat(u"The quick brown fox jumps over the lazy dog. ", 100);
+    QTest::newRow("latin1") << repeat(u"Ça fait déjà très longtemps, où êtes-vous? ", 100);
+    QTest::newRow("cyrillic") << repeat(u"Съешь же ещё этих мягких французских булок. ", 100);
+    QTest::newRow("greek") << repeat(u"Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. ", 100);
+    QTest::newRow("cjk") << repeat(u"我能吞下玻璃而不伤身体。私はガラスを食べられます。", 100);
+    QTest::newRow("mixed") << repeat(u"Qt 6: Unicode — テキスト, Текст, Κείμενο. ", 100);
+}
+
+void tst_QString::toUtf8()
+{
+    QFETCH(QString, s);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = s.toUtf8();
+    }
+}
+
+void tst_QString::fromUtf8_data()
+{
+    toUtf8_data();
+}
+
+void tst_QString::fromUtf8()
+{
+    QFETCH(QString, s);
+    const QByteArray utf8 = s.toUtf8();
+
+    QString result;
+    QBENCHMARK {
+        result = QString::fromUtf8(utf8);
+    }
+    QCOMPARE(result, s);
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_bench_qstring.moc"
@@ -27,6 +27,7 @@
 ****************************************************************************/
 
 #include <QtCore/QtCore>
+#include <QtCore/private/qstripedreadwritelock_p.h>
 #include <QTest>
 #include <mutex>
 #if __has_include(<shared_mutex>)
@@ -107,6 +108,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
+    void readMostly_data();
+    void readMostly();
     // void readWrite();
 };
 
@@ -157,6 +160,12 @@ void tst_QReadWriteLock::uncontended_data()
     ROW(2);
     ROW(32);
 #undef ROW
+    QTest::newRow("QStripedReadWriteLock, read") << FunctionPtrHolder(
+        testUncontended<QStripedReadWriteLock,
+                        LockerWrapper<std::shared_lock<QStripedReadWriteLock>>>);
+    QTest::newRow("QStripedReadWriteLock, write") << FunctionPtrHolder(
+        testUncontended<QStripedReadWriteLock,
+                        LockerWrapper<std::unique_lock<QStripedReadWriteLock>>>);
     QTest::newRow("std::mutex") << FunctionPtrHolder(
         testUncontended<std::mutex, LockerWrapper<std::unique_lock<std::mutex>>>);
 #ifdef __cpp_lib_shared_mutex
@@ -231,6 +240,9 @@ void tst_QReadWriteLock::readOnly_data()
     ROW(2);
     ROW(32);
 #undef ROW
+    QTest::newRow("QStripedReadWriteLock") << FunctionPtrHolder(
+        testReadOnly<QStripedReadWriteLock,
+                     LockerWrapper<std::shared_lock<QStripedReadWriteLock>>>);
     QTest::newRow("std::mutex") << FunctionPtrHolder(
         testReadOnly<std::mutex, LockerWrapper<std::unique_lock<std::mutex>>>);
 #ifdef __cpp_lib_shared_mutex
@@ -299,6 +311,9 @@ void tst_QReadWriteLock::writeOnly_data()
     ROW(2);
     ROW(32);
 #undef ROW
+    QTest::newRow("QStripedReadWriteLock") << FunctionPtrHolder(
+        testWriteOnly<QStripedReadWriteLock,
+                      LockerWrapper<std::unique_lock<QStripedReadWriteLock>>>);
     QTest::newRow("std::mutex") << FunctionPtrHolder(
         testWriteOnly<std::mutex, LockerWrapper<std::unique_lock<std::mutex>>>);
 #ifdef __cpp_lib_shared_mutex
@@ -319,5 +334,69 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+template <typename Mutex, typename ReadLocker, typename WriteLocker>
+void testReadMostly()
+{
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        void run() override
+        {
+            for (int i = 0; i < Iterations; ++i) {
+                QString s = QString::number(i); // Do something outside the lock
+                if (i % 100 == 0) {
+                    WriteLocker locker(lock);
+                    global_hash.insert(s, s);
+                } else {
+                    ReadLocker locker(lock);
+                    global_hash.contains(s);
+                }
+            }
+        }
+    };
+    Mutex lock;
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        auto t = std::make_unique<Thread>();
+        t->lock = &lock;
+        threads.push_back(std::move(t));
+    }
+    QBENCHMARK {
+        for (auto &t : threads) {
+            t->start();
+        }
+        for (auto &t : threads) {
+            t->wait();
+        }
+    }
+    global_hash.clear();
+}
+
+void tst_QReadWriteLock::readMostly_data()
+{
+    QTest::addColumn<FunctionPtrHolder>("holder");
+
+    QTest::newRow("QMutex") << FunctionPtrHolder(
+        testReadMostly<QMutex, QMutexLocker<QMutex>, QMutexLocker<QMutex>>);
+    QTest::newRow("QReadWriteLock") << FunctionPtrHolder(
+        testReadMostly<QReadWriteLock, QReadLocker, QWriteLocker>);
+    QTest::newRow("QStripedReadWriteLock") << FunctionPtrHolder(
+        testReadMostly<QStripedReadWriteLock,
+                       LockerWrapper<std::shared_lock<QStripedReadWriteLock>>,
+                       LockerWrapper<std::unique_lock<QStripedReadWriteLock>>>);
+#ifdef __cpp_lib_shared_mutex
+    QTest::newRow("std::shared_mutex") << FunctionPtrHolder(
+        testReadMostly<std::shared_mutex,
+                       LockerWrapper<std::shared_lock<std::shared_mutex>>,
+                       LockerWrapper<std::unique_lock<std::shared_mutex>>>);
+#endif
+}
+
+void tst_QReadWriteLock::readMostly()
+{
+    QFETCH(FunctionPtrHolder, holder);
+    holder.value();
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_bench_qreadwritelock.moc"
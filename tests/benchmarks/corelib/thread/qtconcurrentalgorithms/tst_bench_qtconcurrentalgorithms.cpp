@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** Copyright (C) 2013 David Faure <david.faure@kdab.com>
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtCore>
+#include <qtconcurrentalgorithms.h>
+
+#include <algorithm>
+#include <numeric>
+
+class tst_QtConcurrentAlgorithms : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sort_data();
+    void sort();
+    void stableSort_data() { sort_data(); }
+    void stableSort();
+    void inclusiveScan_data() { sort_data(); }
+    void inclusiveScan();
+    void partition_data() { sort_data(); }
+    void partition();
+};
+
+static QList<int> randomList(qsizetype size)
+{
+    QList<int> list(size);
+    QRandomGenerator random(size);
+    for (int &value : list)
+        value = int(random.generate());
+    return list;
+}
+
+// threads == 0 runs the std:: algorithm for comparison
+void tst_QtConcurrentAlgorithms::sort_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<qsizetype>("size");
+
+    const int idealThreads = QThread::idealThreadCount();
+    for (qsizetype size : { 10000, 1000000, 10000000 }) {
+        QTest::addRow("std,%lld", qlonglong(size)) << 0 << size;
+        QTest::addRow("1 thread,%lld", qlonglong(size)) << 1 << size;
+        if (idealThreads > 1) {
+            QTest::addRow("%d threads,%lld", idealThreads, qlonglong(size))
+                    << idealThreads << size;
+        }
+    }
+}
+
+void tst_QtConcurrentAlgorithms::sort()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threads));
+    const QList<int> input = randomList(size);
+    QList<int> list;
+
+    QBENCHMARK {
+        list = input;
+        list.detach();
+        if (threads)
+            QtConcurrent::blockingSort(&pool, list);
+        else
+            std::sort(list.begin(), list.end());
+    }
+    QVERIFY(std::is_sorted(list.cbegin(), list.cend()));
+}
+
+void tst_QtConcurrentAlgorithms::stableSort()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threads));
+    const QList<int> input = randomList(size);
+    QList<int> list;
+
+    QBENCHMARK {
+        list = input;
+        list.detach();
+        if (threads)
+            QtConcurrent::blockingStableSort(&pool, list);
+        else
+            std::stable_sort(list.begin(), list.end());
+    }
+    QVERIFY(std::is_sorted(list.cbegin(), list.cend()));
+}
+
+void tst_QtConcurrentAlgorithms::inclusiveScan()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threads));
+    QList<qint64> list(size, 1);
+
+    QBENCHMARK {
+        std::fill(list.begin(), list.end(), 1);
+        if (threads)
+            QtConcurrent::blockingInclusiveScan(&pool, list);
+        else
+            std::partial_sum(list.begin(), list.end(), list.begin());
+    }
+    QCOMPARE(list.last(), size);
+}
+
+void tst_QtConcurrentAlgorithms::partition()
+{
+    QFETCH(int, threads);
+    QFETCH(qsizetype, size);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, threads));
+    const QList<int> input = randomList(size);
+    QList<int> list;
+    const auto isEven = [](int value) { return value % 2 == 0; };
+
+    QBENCHMARK {
+        list = input;
+        list.detach();
+        if (threads)
+            QtConcurrent::blockingPartition(&pool, list, isEven);
+        else
+            std::partition(list.begin(), list.end(), isEven);
+    }
+    QVERIFY(std::is_partitioned(list.cbegin(), list.cend(), isEven));
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithms)
+
+#include "tst_bench_qtconcurrentalgorithms.moc"
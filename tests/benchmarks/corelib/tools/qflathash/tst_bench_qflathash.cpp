@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+
+#include <private/qflathash_p.h>
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qlist.h>
+
+// Compares QFlatHash against QHash for insertion, lookup hits and lookup
+// misses with QByteArray keys, the symbol table use case.
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insert_QHash_data() { data(); }
+    void insert_QHash() { insert<QHash<QByteArray, int>>(); }
+    void insert_QFlatHash_data() { data(); }
+    void insert_QFlatHash() { insert<QFlatHash<QByteArray, int>>(); }
+
+    void findHit_QHash_data() { data(); }
+    void findHit_QHash() { find<QHash<QByteArray, int>>(true); }
+    void findHit_QFlatHash_data() { data(); }
+    void findHit_QFlatHash() { find<QFlatHash<QByteArray, int>>(true); }
+
+    void findMiss_QHash_data() { data(); }
+    void findMiss_QHash() { find<QHash<QByteArray, int>>(false); }
+    void findMiss_QFlatHash_data() { data(); }
+    void findMiss_QFlatHash() { find<QFlatHash<QByteArray, int>>(false); }
+
+private:
+    void data();
+    template <typename Hash> void insert();
+    template <typename Hash> void find(bool hit);
+
+    static QList<QByteArray> keys(int count, const char *prefix);
+};
+
+QList<QByteArray> tst_QFlatHash::keys(int count, const char *prefix)
+{
+    QList<QByteArray> result;
+    result.reserve(count);
+    for (int i = 0; i < count; ++i)
+        result.append(prefix + QByteArray::number(i, 36));
+    return result;
+}
+
+void tst_QFlatHash::data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+    QTest::newRow("1000000") << 1000000;
+}
+
+template <typename Hash> void tst_QFlatHash::insert()
+{
+    QFETCH(int, count);
+    const QList<QByteArray> items = keys(count, "symbol_");
+
+    QBENCHMARK {
+        Hash hash;
+        for (int i = 0; i < count; ++i)
+            hash.insert(items.at(i), i);
+    }
+}
+
+template <typename Hash> void tst_QFlatHash::find(bool hit)
+{
+    QFETCH(int, count);
+    const QList<QByteArray> items = keys(count, "symbol_");
+    const QList<QByteArray> lookups = hit ? items : keys(count, "missing_");
+
+    Hash hash;
+    for (int i = 0; i < count; ++i)
+        hash.insert(items.at(i), i);
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        for (const QByteArray &key : lookups)
+            found += hash.contains(key);
+    }
+    QCOMPARE(found > 0, hit);
+}
+
+QTEST_MAIN(tst_QFlatHash)
+
+#include "tst_bench_qflathash.moc"
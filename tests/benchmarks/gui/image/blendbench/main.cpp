@@ -173,7 +173,8 @@ void BlendBench::unalignedBlendArgb32_data()
 {
     // The performance of blending can depend of the alignment of the data
     // on 16 bytes. Some SIMD instruction set have significantly better
-    // memory access when the memory is aligned on 16 bytes boundary.
+    // memory access when the memory is aligned on 16 bytes boundary, or on
+    // 64 bytes for AVX-512.
 
     // offset in 32 bits words
     QTest::addColumn<int>("offset");
@@ -181,6 +182,8 @@ void BlendBench::unalignedBlendArgb32_data()
     QTest::newRow("unaligned by 4 bytes") << 1;
     QTest::newRow("unaligned by 8 bytes") << 2;
     QTest::newRow("unaligned by 12 bytes") << 3;
+    QTest::newRow("unaligned by 32 bytes") << 8;
+    QTest::newRow("unaligned by 60 bytes") << 15;
 }
 
 void BlendBench::unalignedBlendArgb32()
@@ -189,11 +192,11 @@ void BlendBench::unalignedBlendArgb32()
 
     // We use dst aligned by design. We don't want to test all the combination of alignemnt for src and dst.
     // Moreover, it make sense for us to align dst in the implementation because it is accessed more often.
-    uchar *dstMemory = static_cast<uchar*>(qMallocAligned((dimension * dimension * sizeof(quint32)), 16));
+    uchar *dstMemory = static_cast<uchar*>(qMallocAligned((dimension * dimension * sizeof(quint32)), 64));
     QImage destination(dstMemory, dimension, dimension, QImage::Format_ARGB32_Premultiplied);
     destination.fill(0x12345678); // avoid special cases of alpha
 
-    uchar *srcMemory = static_cast<uchar*>(qMallocAligned((dimension * dimension * sizeof(quint32)) + 16, 16));
+    uchar *srcMemory = static_cast<uchar*>(qMallocAligned((dimension * dimension * sizeof(quint32)) + 64, 64));
     QFETCH(int, offset);
     uchar *imageSrcMemory = srcMemory + (offset * sizeof(quint32));
 
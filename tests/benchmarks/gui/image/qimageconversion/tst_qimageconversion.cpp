@@ -263,6 +263,7 @@ void tst_QImageConversion::convertGeneric_data()
     QTest::newRow("rgba8888 -> rgb888") << rgba32 << QImage::Format_RGB888;
     QTest::newRow("rgba8888 -> rgb30") << rgba32 << QImage::Format_RGB30;
     QTest::newRow("rgba8888 -> a2bgr30") << rgba32 << QImage::Format_A2BGR30_Premultiplied;
+    QTest::newRow("rgba8888 -> rgba64pm") << rgba32 << QImage::Format_RGBA64_Premultiplied;
 
     QTest::newRow("bgr30 -> rgb32") << bgr30 << QImage::Format_RGB32;
     QTest::newRow("bgr30 -> argb32") << bgr30 << QImage::Format_ARGB32;
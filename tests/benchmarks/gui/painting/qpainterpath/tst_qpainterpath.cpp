@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QPainterPath>
+#include <QPolygonF>
+#include <qmath.h>
+
+class tst_QPainterPath : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void booleanOperation_data();
+    void booleanOperation();
+};
+
+// A closed, star-shaped polygon with many short edges, similar to an
+// outline of a region on a map
+static QPainterPath jaggedPolygon(int vertices, const QPointF &center, qreal radius)
+{
+    QPolygonF polygon;
+    polygon.reserve(vertices + 1);
+    for (int i = 0; i < vertices; ++i) {
+        const qreal angle = 2 * M_PI * i / vertices;
+        const qreal r = radius * (i % 2 ? 0.9 : 1.0) * (1 + 0.05 * qSin(angle * 17));
+        polygon << center + QPointF(r * qCos(angle), r * qSin(angle));
+    }
+    polygon << polygon.first();
+
+    QPainterPath path;
+    path.addPolygon(polygon);
+    path.closeSubpath();
+    return path;
+}
+
+enum Operation { United, Intersected, Subtracted, Simplified };
+
+void tst_QPainterPath::booleanOperation_data()
+{
+    QTest::addColumn<int>("operation");
+    QTest::addColumn<int>("vertices");
+
+    const char *names[] = { "united", "intersected", "subtracted", "simplified" };
+    for (int operation = United; operation <= Simplified; ++operation) {
+        for (int vertices : { 100, 1000, 10000 }) {
+            QTest::addRow("%s, %d vertices", names[operation], vertices)
+                    << operation << vertices;
+        }
+    }
+}
+
+void tst_QPainterPath::booleanOperation()
+{
+    QFETCH(int, operation);
+    QFETCH(int, vertices);
+
+    const QPainterPath a = jaggedPolygon(vertices, QPointF(0, 0), 100);
+    const QPainterPath b = jaggedPolygon(vertices, QPointF(40, 30), 100);
+    QPainterPath self = a;
+    self.addPath(jaggedPolygon(vertices, QPointF(-20, 10), 80));
+
+    QPainterPath result;
+    QBENCHMARK {
+        switch (operation) {
+        case United:
+            result = a.united(b);
+            break;
+        case Intersected:
+            result = a.intersected(b);
+            break;
+        case Subtracted:
+            result = a.subtracted(b);
+            break;
+        case Simplified:
+            result = self.simplified();
+            break;
+        }
+    }
+    QVERIFY(!result.isEmpty());
+}
+
+QTEST_MAIN(tst_QPainterPath)
+
+#include "tst_qpainterpath.moc"
@@ -39,6 +39,11 @@ private slots:
 
     void intersects_data();
     void intersects();
+
+    void unitedRects_data();
+    void unitedRects();
+    void fromRects_data();
+    void fromRects();
 };
 
 
@@ -121,6 +126,52 @@ void tst_qregion::intersects()
     }
 }
 
+// small rectangles scattered over a window, like the dirty regions of many
+// widgets that update independently
+static QList<QRect> scatteredRects(int count)
+{
+    QList<QRect> rects;
+    rects.reserve(count);
+    for (int i = 0; i < count; ++i)
+        rects << QRect((i * 97) % 1900, (i * 61) % 1060, 8 + i % 5, 12);
+    return rects;
+}
+
+void tst_qregion::unitedRects_data()
+{
+    QTest::addColumn<int>("count");
+
+    for (int count : { 10, 100, 1000, 5000 })
+        QTest::addRow("%d rects", count) << count;
+}
+
+void tst_qregion::unitedRects()
+{
+    QFETCH(int, count);
+    const QList<QRect> rects = scatteredRects(count);
+
+    QBENCHMARK {
+        QRegion region;
+        for (const QRect &rect : rects)
+            region += rect;
+    }
+}
+
+void tst_qregion::fromRects_data()
+{
+    unitedRects_data();
+}
+
+void tst_qregion::fromRects()
+{
+    QFETCH(int, count);
+    const QList<QRect> rects = scatteredRects(count);
+
+    QBENCHMARK {
+        QRegion::fromRects(rects.constData(), rects.size());
+    }
+}
+
 QTEST_MAIN(tst_qregion)
 
 #include "main.moc"
@@ -0,0 +1,418 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/qmath.h>
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+#include <QtGui/QPicture>
+#include <QtGui/QTextDocument>
+#include <QtWidgets/QCheckBox>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QProgressBar>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QScrollBar>
+#include <QtWidgets/QSlider>
+#include <QtWidgets/QSpinBox>
+#include <QtWidgets/QTreeWidget>
+
+#ifndef QT_NO_OPENGL
+#include <QOpenGLFramebufferObjectFormat>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLPaintDevice>
+#include <QtGui/QWindow>
+#endif
+
+#include <algorithm>
+
+// Each scenario is a sequence of frames recorded into QPictures from the
+// code that would paint them in an application, so that playback measures
+// only the paint engine and not the widget or text layout machinery.
+
+static const QSize frameSize(640, 480);
+static const int frameCount = 30;
+
+typedef QList<QPicture> Frames;
+Q_DECLARE_METATYPE(QImage::Format)
+
+class tst_UiFrames : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void raster_data();
+    void raster();
+    void rasterPerFrame_data();
+    void rasterPerFrame();
+    void frameTimeDistribution();
+
+#ifndef QT_NO_OPENGL
+    void openGL_data();
+    void openGL();
+#endif
+
+private:
+    void addScenarioRows();
+    static void play(QPaintDevice *device, Frames &frames);
+
+    static Frames recordItemView();
+    static Frames recordStyledWidgets();
+    static Frames recordRichText();
+    static Frames recordChart();
+
+    QMap<QString, Frames> scenarios;
+};
+
+void tst_UiFrames::initTestCase()
+{
+    scenarios.insert(QStringLiteral("itemview"), recordItemView());
+    scenarios.insert(QStringLiteral("widgets"), recordStyledWidgets());
+    scenarios.insert(QStringLiteral("richtext"), recordRichText());
+    scenarios.insert(QStringLiteral("chart"), recordChart());
+
+    for (auto it = scenarios.cbegin(); it != scenarios.cend(); ++it) {
+        QCOMPARE(it.value().size(), frameCount);
+        for (const QPicture &frame : it.value())
+            QVERIFY2(!frame.isNull(), qPrintable(it.key()));
+    }
+}
+
+Frames tst_UiFrames::recordItemView()
+{
+    QTreeWidget tree;
+    tree.setColumnCount(4);
+    tree.setHeaderLabels({ QStringLiteral("Name"), QStringLiteral("Size"),
+                           QStringLiteral("Type"), QStringLiteral("Modified") });
+    tree.setAlternatingRowColors(true);
+    for (int i = 0; i < 50; ++i) {
+        auto *folder = new QTreeWidgetItem(&tree, { QStringLiteral("Folder %1").arg(i),
+                                                    QString(), QStringLiteral("Folder"),
+                                                    QStringLiteral("2022-01-%1").arg(i % 28 + 1) });
+        for (int j = 0; j < 10; ++j) {
+            new QTreeWidgetItem(folder, { QStringLiteral("document_%1_%2.txt").arg(i).arg(j),
+                                          QStringLiteral("%1 KB").arg(i * 10 + j),
+                                          QStringLiteral("Text file"),
+                                          QStringLiteral("2022-02-%1").arg(j + 1) });
+        }
+        folder->setExpanded(i % 3 == 0);
+    }
+    tree.resize(frameSize);
+
+    Frames frames;
+    QScrollBar *scrollBar = tree.verticalScrollBar();
+    for (int i = 0; i < frameCount; ++i) {
+        scrollBar->setValue(i * scrollBar->maximum() / (frameCount - 1));
+        QPicture picture;
+        tree.render(&picture);
+        frames.append(picture);
+    }
+    return frames;
+}
+
+Frames tst_UiFrames::recordStyledWidgets()
+{
+    QWidget form;
+    auto *layout = new QFormLayout(&form);
+    auto *lineEdit = new QLineEdit(QStringLiteral("Some text being edited"));
+    auto *comboBox = new QComboBox;
+    comboBox->addItems({ QStringLiteral("First"), QStringLiteral("Second"), QStringLiteral("Third") });
+    auto *spinBox = new QSpinBox;
+    spinBox->setRange(0, 1000);
+    auto *checkBox = new QCheckBox(QStringLiteral("Enabled"));
+    auto *slider = new QSlider(Qt::Horizontal);
+    slider->setRange(0, frameCount);
+    auto *progressBar = new QProgressBar;
+    progressBar->setRange(0, frameCount);
+    auto *button = new QPushButton(QStringLiteral("Apply"));
+    layout->addRow(QStringLiteral("Name:"), lineEdit);
+    layout->addRow(QStringLiteral("Choice:"), comboBox);
+    layout->addRow(QStringLiteral("Count:"), spinBox);
+    layout->addRow(QString(), checkBox);
+    layout->addRow(QStringLiteral("Level:"), slider);
+    layout->addRow(QStringLiteral("Progress:"), progressBar);
+    layout->addRow(QString(), button);
+    form.resize(frameSize);
+
+    Frames frames;
+    for (int i = 0; i < frameCount; ++i) {
+        lineEdit->setCursorPosition(i % lineEdit->text().size());
+        comboBox->setCurrentIndex(i % comboBox->count());
+        spinBox->setValue(i * 33);
+        checkBox->setChecked(i % 2);
+        slider->setValue(i);
+        progressBar->setValue(i);
+        button->setDown(i % 5 == 0);
+        QPicture picture;
+        form.render(&picture);
+        frames.append(picture);
+    }
+    return frames;
+}
+
+Frames tst_UiFrames::recordRichText()
+{
+    QString html;
+    for (int section = 0; section < 8; ++section) {
+        html += QStringLiteral("<h2>Section %1</h2>").arg(section);
+        html += QStringLiteral("<p>Plain text mixed with <b>bold</b>, <i>italic</i>, "
+                               "<u>underlined</u> and <span style=\"color:#2060a0\">coloured</span> "
+                               "runs, long enough to wrap across several lines of the frame so that "
+                               "the layout contains more than a single line per block.</p>");
+        html += QStringLiteral("<ul><li>First point</li><li>Second point</li>"
+                               "<li>Third point with <code>code</code></li></ul>");
+        html += QStringLiteral("<table border=\"1\" cellpadding=\"2\">");
+        for (int row = 0; row < 4; ++row) {
+            html += QStringLiteral("<tr>");
+            for (int column = 0; column < 5; ++column)
+                html += QStringLiteral("<td>%1.%2</td>").arg(row).arg(column);
+            html += QStringLiteral("</tr>");
+        }
+        html += QStringLiteral("</table>");
+    }
+
+    QTextDocument document;
+    document.setHtml(html);
+    document.setTextWidth(frameSize.width());
+    const qreal scrollRange = qMax(qreal(0), document.size().height() - frameSize.height());
+
+    Frames frames;
+    for (int i = 0; i < frameCount; ++i) {
+        const qreal offset = i * scrollRange / (frameCount - 1);
+        QPicture picture;
+        QPainter p(&picture);
+        p.fillRect(QRect(QPoint(), frameSize), Qt::white);
+        p.translate(0, -offset);
+        document.drawContents(&p, QRectF(0, offset, frameSize.width(), frameSize.height()));
+        p.end();
+        frames.append(picture);
+    }
+    return frames;
+}
+
+Frames tst_UiFrames::recordChart()
+{
+    const QRectF plot(50, 20, frameSize.width() - 70, frameSize.height() - 60);
+    const int sampleCount = 400;
+
+    Frames frames;
+    for (int i = 0; i < frameCount; ++i) {
+        QPicture picture;
+        QPainter p(&picture);
+        p.fillRect(QRect(QPoint(), frameSize), Qt::white);
+
+        p.setPen(QPen(Qt::lightGray, 0));
+        for (int line = 0; line <= 10; ++line) {
+            const qreal x = plot.left() + line * plot.width() / 10;
+            const qreal y = plot.top() + line * plot.height() / 10;
+            p.drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+            p.drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+            p.setPen(Qt::black);
+            p.drawText(QRectF(x - 20, plot.bottom() + 4, 40, 16), Qt::AlignCenter,
+                       QString::number(i + line * 10));
+            p.drawText(QRectF(0, y - 8, plot.left() - 4, 16), Qt::AlignRight | Qt::AlignVCenter,
+                       QString::number(100 - line * 10));
+            p.setPen(QPen(Qt::lightGray, 0));
+        }
+
+        QPainterPath curve;
+        for (int s = 0; s < sampleCount; ++s) {
+            const qreal t = (s + i * 4) * 0.05;
+            const QPointF point(plot.left() + s * plot.width() / (sampleCount - 1),
+                                plot.center().y() - plot.height() * 0.35 * (qSin(t) * 0.7 + qSin(t * 3.7) * 0.3));
+            if (s == 0)
+                curve.moveTo(point);
+            else
+                curve.lineTo(point);
+        }
+        QPainterPath area = curve;
+        area.lineTo(plot.bottomRight());
+        area.lineTo(plot.bottomLeft());
+        area.closeSubpath();
+
+        p.setRenderHint(QPainter::Antialiasing);
+        QLinearGradient gradient(plot.topLeft(), plot.bottomLeft());
+        gradient.setColorAt(0, QColor(32, 96, 160, 160));
+        gradient.setColorAt(1, QColor(32, 96, 160, 16));
+        p.fillPath(area, gradient);
+        p.strokePath(curve, QPen(QColor(32, 96, 160), 2));
+
+        p.setPen(Qt::black);
+        p.setBrush(QColor(255, 255, 255, 200));
+        p.drawRoundedRect(QRectF(plot.right() - 120, plot.top() + 10, 110, 30), 4, 4);
+        p.drawText(QRectF(plot.right() - 115, plot.top() + 10, 100, 30), Qt::AlignVCenter,
+                   QStringLiteral("Signal %1").arg(i));
+        p.end();
+        frames.append(picture);
+    }
+    return frames;
+}
+
+void tst_UiFrames::play(QPaintDevice *device, Frames &frames)
+{
+    for (QPicture &frame : frames) {
+        QPainter p(device);
+        frame.play(&p);
+    }
+}
+
+void tst_UiFrames::addScenarioRows()
+{
+    QTest::addColumn<QString>("scenario");
+    for (auto it = scenarios.cbegin(); it != scenarios.cend(); ++it)
+        QTest::newRow(qPrintable(it.key())) << it.key();
+}
+
+void tst_UiFrames::raster_data()
+{
+    QTest::addColumn<QString>("scenario");
+    QTest::addColumn<QImage::Format>("format");
+    const QPair<const char *, QImage::Format> formats[] = {
+        { "ARGB32PM", QImage::Format_ARGB32_Premultiplied },
+        { "RGB32", QImage::Format_RGB32 },
+        { "RGB16", QImage::Format_RGB16 },
+    };
+    for (auto it = scenarios.cbegin(); it != scenarios.cend(); ++it) {
+        for (const auto &format : formats)
+            QTest::addRow("%s-%s", qPrintable(it.key()), format.first) << it.key() << format.second;
+    }
+}
+
+void tst_UiFrames::raster()
+{
+    QFETCH(QString, scenario);
+    QFETCH(QImage::Format, format);
+    Frames &frames = scenarios[scenario];
+
+    QImage image(frameSize, format);
+    image.fill(Qt::white);
+    QBENCHMARK {
+        play(&image, frames);
+    }
+}
+
+void tst_UiFrames::rasterPerFrame_data()
+{
+    QTest::addColumn<QString>("scenario");
+    QTest::addColumn<int>("frame");
+    for (auto it = scenarios.cbegin(); it != scenarios.cend(); ++it) {
+        for (int i = 0; i < frameCount; ++i)
+            QTest::addRow("%s-%02d", qPrintable(it.key()), i) << it.key() << i;
+    }
+}
+
+// One result per frame, so that the benchmark output can be charted as a
+// frame time series and regressions in a single frame are not averaged away.
+void tst_UiFrames::rasterPerFrame()
+{
+    QFETCH(QString, scenario);
+    QFETCH(int, frame);
+    QPicture &picture = scenarios[scenario][frame];
+
+    QImage image(frameSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QBENCHMARK {
+        QPainter p(&image);
+        picture.play(&p);
+    }
+}
+
+// Summarizes the spread of frame times per scenario, since a smooth average
+// can hide the occasional slow frame that is noticed as a stutter.
+void tst_UiFrames::frameTimeDistribution()
+{
+    const int rounds = 10;
+    QImage image(frameSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+
+    for (auto it = scenarios.begin(); it != scenarios.end(); ++it) {
+        QList<qint64> times;
+        times.reserve(rounds * frameCount);
+        QElapsedTimer timer;
+        for (int round = 0; round < rounds; ++round) {
+            for (QPicture &frame : it.value()) {
+                timer.start();
+                QPainter p(&image);
+                frame.play(&p);
+                p.end();
+                times.append(timer.nsecsElapsed());
+            }
+        }
+        std::sort(times.begin(), times.end());
+        const auto percentile = [&times](int p) {
+            return times.at((times.size() - 1) * p / 100) / 1000.0;
+        };
+        qInfo("%s: frame time (us) min %.1f median %.1f p90 %.1f p99 %.1f max %.1f",
+              qPrintable(it.key()), percentile(0), percentile(50), percentile(90),
+              percentile(99), percentile(100));
+    }
+}
+
+#ifndef QT_NO_OPENGL
+void tst_UiFrames::openGL_data()
+{
+    addScenarioRows();
+}
+
+void tst_UiFrames::openGL()
+{
+    QFETCH(QString, scenario);
+    Frames &frames = scenarios[scenario];
+
+    QWindow win;
+    win.setSurfaceType(QSurface::OpenGLSurface);
+    win.create();
+    QOpenGLContext ctx;
+    if (!ctx.create() || !ctx.makeCurrent(&win))
+        QSKIP("System under test does not meet preconditions for GL testing. Skipping.");
+    QOpenGLFramebufferObjectFormat fmt;
+    fmt.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    fmt.setSamples(4);
+    QOpenGLFramebufferObject fbo(frameSize, fmt);
+    if (!fbo.isValid() || !fbo.bind())
+        QSKIP("System under test does not meet preconditions for GL testing. Skipping.");
+
+    QOpenGLPaintDevice device(frameSize);
+    QBENCHMARK {
+        play(&device, frames);
+        // make sure the GPU work is part of the measurement
+        ctx.functions()->glFinish();
+    }
+}
+#endif
+
+QTEST_MAIN(tst_UiFrames)
+
+#include "tst_uiframes.moc"
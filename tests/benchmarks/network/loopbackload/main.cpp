@@ -0,0 +1,671 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+// A load generator for the network stack: runs a server and a client in one
+// process, over the loopback interface, and measures requests per second and
+// the latency distribution of each protocol under a given concurrency and
+// payload size. Run with -help for the options.
+
+#include <QtCore/qcommandlineparser.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qeventloop.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtimer.h>
+
+#include <QtNetwork/qlocalserver.h>
+#include <QtNetwork/qlocalsocket.h>
+#include <QtNetwork/qnetworkaccessmanager.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtNetwork/qnetworkrequest.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#if QT_CONFIG(ssl)
+#include <QtNetwork/qsslcertificate.h>
+#include <QtNetwork/qsslkey.h>
+#include <QtNetwork/qsslsocket.h>
+#endif
+
+#include "http2srv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+enum class Protocol { Http1, Https1, Http2, Https2, Local };
+
+static const struct {
+    Protocol protocol;
+    const char name[8];
+} protocolNames[] = {
+    { Protocol::Http1, "http1" },
+    { Protocol::Https1, "https1" },
+    { Protocol::Http2, "http2" },
+    { Protocol::Https2, "https2" },
+    { Protocol::Local, "local" },
+};
+
+static QString protocolName(Protocol protocol)
+{
+    for (const auto &entry : protocolNames) {
+        if (entry.protocol == protocol)
+            return QLatin1String(entry.name);
+    }
+    Q_UNREACHABLE();
+    return QString();
+}
+
+static bool isEncrypted(Protocol protocol)
+{
+    return protocol == Protocol::Https1 || protocol == Protocol::Https2;
+}
+
+// Requests sent over QLocalSocket are this many bytes, to keep the framing
+// trivial; responses are a quint32 length followed by the payload.
+static constexpr qsizetype LocalRequestSize = 16;
+
+// ----------------------------- Servers -----------------------------
+
+class Http1Server : public QTcpServer
+{
+    Q_OBJECT
+public:
+    Http1Server(const QByteArray &body, bool encrypted)
+        : response("HTTP/1.1 200 OK\r\n"
+                   "Content-Type: application/octet-stream\r\n"
+                   "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                   "\r\n" + body),
+          encrypted(encrypted)
+    {
+    }
+
+    Q_INVOKABLE quint16 start()
+    {
+        return listen(QHostAddress::LocalHost) ? serverPort() : 0;
+    }
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        QTcpSocket *socket = nullptr;
+#if QT_CONFIG(ssl)
+        if (encrypted) {
+            auto sslSocket = new QSslSocket(this);
+            QFile keyFile(QT_TESTCASE_SOURCEDIR "/certs/fluke.key");
+            keyFile.open(QIODevice::ReadOnly);
+            sslSocket->setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa));
+            sslSocket->setLocalCertificateChain(
+                    QSslCertificate::fromPath(QT_TESTCASE_SOURCEDIR "/certs/fluke.cert"));
+            sslSocket->setPeerVerifyMode(QSslSocket::VerifyNone);
+            sslSocket->setSocketDescriptor(socketDescriptor);
+            sslSocket->startServerEncryption();
+            socket = sslSocket;
+        }
+#endif
+        if (!socket) {
+            socket = new QTcpSocket(this);
+            socket->setSocketDescriptor(socketDescriptor);
+        }
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] { readRequests(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+            pending.remove(socket);
+            socket->deleteLater();
+        });
+    }
+
+private:
+    // The requests have no body: answer every complete header block
+    void readRequests(QTcpSocket *socket)
+    {
+        QByteArray &buffer = pending[socket];
+        buffer += socket->readAll();
+        qsizetype end;
+        while ((end = buffer.indexOf("\r\n\r\n")) >= 0) {
+            buffer.remove(0, end + 4);
+            socket->write(response);
+        }
+    }
+
+    const QByteArray response;
+    const bool encrypted;
+    QHash<QTcpSocket *, QByteArray> pending;
+};
+
+class LocalServer : public QLocalServer
+{
+    Q_OBJECT
+public:
+    explicit LocalServer(const QByteArray &body)
+    {
+        const quint32 size = quint32(body.size());
+        response = QByteArray(reinterpret_cast<const char *>(&size), sizeof size) + body;
+    }
+
+    Q_INVOKABLE QString start()
+    {
+        const QString name = QLatin1String("qt_loopbackload_")
+                + QString::number(QCoreApplication::applicationPid());
+        removeServer(name);
+        return listen(name) ? fullServerName() : QString();
+    }
+
+protected:
+    void incomingConnection(quintptr socketDescriptor) override
+    {
+        auto socket = new QLocalSocket(this);
+        socket->setSocketDescriptor(socketDescriptor);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket] {
+            while (socket->bytesAvailable() >= LocalRequestSize) {
+                socket->skip(LocalRequestSize);
+                socket->write(response);
+            }
+        });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+    }
+
+private:
+    QByteArray response;
+};
+
+// ----------------------------- Client -----------------------------
+
+/*
+    Keeps concurrency requests in flight until requests have completed, and
+    records the latency of each. Lives in its own thread.
+*/
+class LoadClient : public QObject
+{
+    Q_OBJECT
+public:
+    LoadClient(Protocol protocol, const QString &server, int concurrency)
+        : protocol(protocol), server(server), concurrency(concurrency)
+    {
+    }
+
+    Q_INVOKABLE void run(qint64 count)
+    {
+        requests = count;
+        issued = completed = failures = 0;
+        latencies.clear();
+        latencies.reserve(count);
+        clock.start();
+
+        if (protocol == Protocol::Local) {
+            if (sockets.empty())
+                connectLocalSockets();
+            for (QLocalSocket *socket : sockets)
+                sendLocalRequest(socket);
+        } else {
+            if (!manager)
+                manager = new QNetworkAccessManager(this);
+            for (int i = 0; i < concurrency; ++i)
+                sendHttpRequest();
+        }
+    }
+
+    // valid after finished()
+    std::vector<qint64> latencies; // nanoseconds
+    qint64 failures = 0;
+
+Q_SIGNALS:
+    void finished();
+
+private:
+    void sendHttpRequest()
+    {
+        if (issued == requests)
+            return;
+        ++issued;
+
+        QNetworkRequest request{QUrl(server)};
+        switch (protocol) {
+        case Protocol::Http1:
+        case Protocol::Https1:
+            request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+            break;
+        case Protocol::Http2:
+            request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+            break;
+        case Protocol::Https2:
+            request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+            break;
+        case Protocol::Local:
+            Q_UNREACHABLE();
+        }
+
+        const qint64 started = clock.nsecsElapsed();
+        QNetworkReply *reply = manager->get(request);
+        if (isEncrypted(protocol))
+            reply->ignoreSslErrors();
+        connect(reply, &QNetworkReply::finished, this, [this, reply, started] {
+            reply->readAll();
+            reply->deleteLater();
+            if (reply->error() != QNetworkReply::NoError)
+                ++failures;
+            requestDone(started);
+            sendHttpRequest();
+        });
+    }
+
+    void connectLocalSockets()
+    {
+        for (int i = 0; i < concurrency; ++i) {
+            auto socket = new QLocalSocket(this);
+            socket->connectToServer(server);
+            socket->waitForConnected();
+            connect(socket, &QLocalSocket::readyRead, this, [this, socket] {
+                readLocalResponse(socket);
+            });
+            sockets.push_back(socket);
+        }
+    }
+
+    void sendLocalRequest(QLocalSocket *socket)
+    {
+        if (issued == requests)
+            return;
+        ++issued;
+        socket->setProperty("started", clock.nsecsElapsed());
+        socket->write(QByteArray(LocalRequestSize, 'r'));
+    }
+
+    void readLocalResponse(QLocalSocket *socket)
+    {
+        quint32 size;
+        while (socket->peek(reinterpret_cast<char *>(&size), sizeof size) == sizeof size
+               && socket->bytesAvailable() >= qint64(sizeof size + size)) {
+            socket->skip(sizeof size + size);
+            requestDone(socket->property("started").toLongLong());
+            sendLocalRequest(socket);
+        }
+    }
+
+    void requestDone(qint64 started)
+    {
+        latencies.push_back(clock.nsecsElapsed() - started);
+        if (++completed == requests)
+            emit finished();
+    }
+
+    const Protocol protocol;
+    const QString server;
+    const int concurrency;
+    QNetworkAccessManager *manager = nullptr;
+    std::vector<QLocalSocket *> sockets;
+    QElapsedTimer clock;
+    qint64 requests = 0;
+    qint64 issued = 0;
+    qint64 completed = 0;
+};
+
+// ----------------------------- Driver -----------------------------
+
+struct Scenario
+{
+    Protocol protocol;
+    int concurrency;
+    int payloadSize;
+    int clientThreads;
+    qint64 requests;
+    qint64 warmupRequests;
+};
+
+class ScenarioRunner
+{
+public:
+    explicit ScenarioRunner(const Scenario &scenario)
+        : scenario(scenario)
+    {
+        serverThread.start();
+    }
+
+    ~ScenarioRunner()
+    {
+        // the clients and servers are deleted when their threads finish
+        for (QThread *thread : std::as_const(clientThreads)) {
+            thread->quit();
+            thread->wait();
+            delete thread;
+        }
+        serverThread.quit();
+        serverThread.wait();
+    }
+
+    bool setUp()
+    {
+        const QByteArray body(scenario.payloadSize, 'x');
+        const int perThread = qMax(1, scenario.concurrency / scenario.clientThreads);
+        for (int i = 0; i < scenario.clientThreads; ++i) {
+            const QString server = startServer(body, i == 0);
+            if (server.isEmpty())
+                return false;
+            auto thread = new QThread;
+            thread->start();
+            clientThreads.append(thread);
+            auto client = new LoadClient(scenario.protocol, server, perThread);
+            client->moveToThread(thread);
+            QObject::connect(thread, &QThread::finished, client, &QObject::deleteLater);
+            clients.append(client);
+        }
+        return true;
+    }
+
+    // Runs count requests over all clients and returns the elapsed time in nanoseconds
+    qint64 run(qint64 count)
+    {
+        QEventLoop loop;
+        int running = int(clients.size());
+        std::vector<QMetaObject::Connection> connections;
+        for (LoadClient *client : std::as_const(clients)) {
+            connections.push_back(QObject::connect(client, &LoadClient::finished, &loop, [&] {
+                if (--running == 0)
+                    loop.quit();
+            }));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        const qint64 perClient = qMax(qint64(1), count / qint64(clients.size()));
+        for (LoadClient *client : std::as_const(clients))
+            QMetaObject::invokeMethod(client, "run", Q_ARG(qint64, perClient));
+        loop.exec();
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        for (const auto &connection : connections)
+            QObject::disconnect(connection);
+        return elapsed;
+    }
+
+    QJsonObject measure()
+    {
+        if (scenario.warmupRequests)
+            run(scenario.warmupRequests);
+        const qint64 elapsed = run(scenario.requests);
+
+        std::vector<qint64> latencies;
+        qint64 failures = 0;
+        for (LoadClient *client : std::as_const(clients)) {
+            latencies.insert(latencies.end(), client->latencies.begin(), client->latencies.end());
+            failures += client->failures;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&](double p) {
+            if (latencies.empty())
+                return 0.0;
+            const size_t rank = size_t(std::max(1.0, std::ceil(p / 100 * latencies.size())));
+            return latencies.at(rank - 1) / 1000.0;
+        };
+
+        const double seconds = elapsed / 1e9;
+        const qint64 completed = qint64(latencies.size());
+        QJsonObject result;
+        result.insert(QLatin1String("protocol"), protocolName(scenario.protocol));
+        result.insert(QLatin1String("concurrency"), scenario.concurrency);
+        result.insert(QLatin1String("payloadBytes"), scenario.payloadSize);
+        result.insert(QLatin1String("clientThreads"), scenario.clientThreads);
+        result.insert(QLatin1String("connections"), connectionCount());
+        result.insert(QLatin1String("requests"), completed);
+        result.insert(QLatin1String("failures"), failures);
+        result.insert(QLatin1String("seconds"), seconds);
+        result.insert(QLatin1String("requestsPerSecond"), completed / seconds);
+        result.insert(QLatin1String("bytesPerSecond"), completed * scenario.payloadSize / seconds);
+        result.insert(QLatin1String("latencyP50Us"), percentile(50));
+        result.insert(QLatin1String("latencyP90Us"), percentile(90));
+        result.insert(QLatin1String("latencyP99Us"), percentile(99));
+        result.insert(QLatin1String("latencyMaxUs"), percentile(100));
+        return result;
+    }
+
+private:
+    // Returns the URL or server name the client has to use, or an empty string
+    QString startServer(const QByteArray &body, bool first)
+    {
+        QString address;
+        QObject *server = nullptr;
+        switch (scenario.protocol) {
+        case Protocol::Http1:
+        case Protocol::Https1: {
+            // one server takes all connections
+            if (!first)
+                return servers.constFirst()->property("address").toString();
+            auto http1 = new Http1Server(body, isEncrypted(scenario.protocol));
+            http1->moveToThread(&serverThread);
+            quint16 port = 0;
+            QMetaObject::invokeMethod(http1, "start", Qt::BlockingQueuedConnection,
+                                      Q_RETURN_ARG(quint16, port));
+            if (port) {
+                address = QLatin1String(isEncrypted(scenario.protocol) ? "https" : "http")
+                        + QLatin1String("://127.0.0.1:") + QString::number(port) + QLatin1Char('/');
+            }
+            server = http1;
+            break;
+        }
+        case Protocol::Http2:
+        case Protocol::Https2: {
+            // Http2Server only serves a single connection, and each client
+            // thread has its own QNetworkAccessManager and connection
+            const H2Type type = scenario.protocol == Protocol::Http2 ? H2Type::h2cDirect
+                                                                     : H2Type::h2Alpn;
+            auto http2 = new Http2Server(type, {{Http2::Settings::MAX_CONCURRENT_STREAMS_ID, 100}},
+                                         {});
+            const bool emptyBody = body.isEmpty();
+            http2->setResponseBody(body);
+            QObject::connect(http2, &Http2Server::receivedRequest, http2,
+                             [http2, emptyBody](quint32 streamID) {
+                QMetaObject::invokeMethod(http2, "sendResponse", Qt::QueuedConnection,
+                                          Q_ARG(quint32, streamID), Q_ARG(bool, emptyBody));
+            });
+            http2->moveToThread(&serverThread);
+            QMetaObject::invokeMethod(http2, "startServer", Qt::BlockingQueuedConnection);
+            if (const quint16 port = http2->serverPort()) {
+                address = QLatin1String(type == H2Type::h2cDirect ? "http" : "https")
+                        + QLatin1String("://127.0.0.1:") + QString::number(port) + QLatin1Char('/');
+            }
+            server = http2;
+            break;
+        }
+        case Protocol::Local: {
+            if (!first)
+                return servers.constFirst()->property("address").toString();
+            auto local = new LocalServer(body);
+            local->moveToThread(&serverThread);
+            QMetaObject::invokeMethod(local, "start", Qt::BlockingQueuedConnection,
+                                      Q_RETURN_ARG(QString, address));
+            server = local;
+            break;
+        }
+        }
+
+        QObject::connect(&serverThread, &QThread::finished, server, &QObject::deleteLater);
+        server->setProperty("address", address);
+        servers.append(server);
+        return address;
+    }
+
+    int connectionCount() const
+    {
+        const int perThread = qMax(1, scenario.concurrency / scenario.clientThreads);
+        switch (scenario.protocol) {
+        case Protocol::Http1:
+        case Protocol::Https1:
+            // QNetworkAccessManager opens up to six connections per host
+            return scenario.clientThreads * qMin(perThread, 6);
+        case Protocol::Http2:
+        case Protocol::Https2:
+            return scenario.clientThreads;
+        case Protocol::Local:
+            return scenario.clientThreads * perThread;
+        }
+        return 0;
+    }
+
+    const Scenario scenario;
+    QThread serverThread;
+    QList<QObject *> servers;
+    QList<QThread *> clientThreads;
+    QList<LoadClient *> clients;
+};
+
+static QList<int> parseIntList(const QString &value, bool *ok)
+{
+    QList<int> list;
+    for (const QString &item : value.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        const int number = item.toInt(ok);
+        if (!*ok || number < 0) {
+            *ok = false;
+            return {};
+        }
+        list.append(number);
+    }
+    *ok = !list.isEmpty();
+    return list;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QLatin1String(
+            "Loopback load generator for the Qt network stack. Runs every combination "
+            "of the given protocols, concurrency levels and payload sizes."));
+    parser.addHelpOption();
+    QCommandLineOption protocolsOption(QLatin1String("protocols"),
+            QLatin1String("Comma-separated protocols: http1, https1, http2, https2, local."),
+            QLatin1String("list"), QLatin1String("http1,https1,http2,https2,local"));
+    QCommandLineOption concurrencyOption(QLatin1String("concurrency"),
+            QLatin1String("Comma-separated numbers of requests in flight."),
+            QLatin1String("list"), QLatin1String("1,16,64"));
+    QCommandLineOption payloadOption(QLatin1String("payload"),
+            QLatin1String("Comma-separated response sizes in bytes."),
+            QLatin1String("list"), QLatin1String("0,1024,65536"));
+    QCommandLineOption requestsOption(QLatin1String("requests"),
+            QLatin1String("Number of measured requests per scenario."),
+            QLatin1String("n"), QLatin1String("2000"));
+    QCommandLineOption warmupOption(QLatin1String("warmup"),
+            QLatin1String("Number of requests before measuring."),
+            QLatin1String("n"), QLatin1String("200"));
+    QCommandLineOption threadsOption(QLatin1String("threads"),
+            QLatin1String("Number of client threads; the concurrency is split among them."),
+            QLatin1String("n"), QLatin1String("1"));
+    QCommandLineOption jsonOption(QLatin1String("json"),
+            QLatin1String("Write the results as JSON to file, or - for stdout."),
+            QLatin1String("file"));
+    parser.addOptions({ protocolsOption, concurrencyOption, payloadOption, requestsOption,
+                        warmupOption, threadsOption, jsonOption });
+    parser.process(app);
+
+    QList<Protocol> protocols;
+    for (const QString &name : parser.value(protocolsOption).split(QLatin1Char(','))) {
+        const auto it = std::find_if(std::begin(protocolNames), std::end(protocolNames),
+                                     [&](const auto &entry) {
+            return name == QLatin1String(entry.name);
+        });
+        if (it == std::end(protocolNames)) {
+            qWarning("Unknown protocol '%s'", qPrintable(name));
+            return 1;
+        }
+#if QT_CONFIG(ssl)
+        if (isEncrypted(it->protocol) && !QSslSocket::supportsSsl()) {
+            qWarning("Skipping %s, TLS is not supported", it->name);
+            continue;
+        }
+#else
+        if (isEncrypted(it->protocol)) {
+            qWarning("Skipping %s, TLS is not supported", it->name);
+            continue;
+        }
+#endif
+        protocols.append(it->protocol);
+    }
+
+    bool ok;
+    const QList<int> concurrencies = parseIntList(parser.value(concurrencyOption), &ok);
+    const QList<int> payloads = ok ? parseIntList(parser.value(payloadOption), &ok) : QList<int>();
+    const qint64 requests = ok ? parser.value(requestsOption).toLongLong(&ok) : 0;
+    const qint64 warmup = ok ? parser.value(warmupOption).toLongLong(&ok) : 0;
+    const int threads = ok ? parser.value(threadsOption).toInt(&ok) : 0;
+    if (!ok || requests <= 0 || warmup < 0 || threads <= 0 || concurrencies.contains(0)) {
+        qWarning("Invalid numeric option");
+        return 1;
+    }
+
+    QJsonArray results;
+    for (Protocol protocol : std::as_const(protocols)) {
+        for (int concurrency : concurrencies) {
+            for (int payload : payloads) {
+                const Scenario scenario{ protocol, concurrency, payload,
+                                         qMin(threads, concurrency), requests, warmup };
+                ScenarioRunner runner(scenario);
+                if (!runner.setUp()) {
+                    qWarning("Could not start the %s server", qPrintable(protocolName(protocol)));
+                    return 1;
+                }
+                const QJsonObject result = runner.measure();
+                results.append(result);
+                if (!parser.isSet(jsonOption) || parser.value(jsonOption) != QLatin1String("-")) {
+                    printf("%-7s concurrency %4d payload %7d: %10.1f req/s  "
+                           "p50 %8.1f us  p99 %8.1f us  (%lld failed)\n",
+                           qPrintable(protocolName(protocol)), concurrency, payload,
+                           result.value(QLatin1String("requestsPerSecond")).toDouble(),
+                           result.value(QLatin1String("latencyP50Us")).toDouble(),
+                           result.value(QLatin1String("latencyP99Us")).toDouble(),
+                           qint64(result.value(QLatin1String("failures")).toDouble()));
+                    fflush(stdout);
+                }
+            }
+        }
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject document;
+        document.insert(QLatin1String("qtVersion"), QLatin1String(qVersion()));
+        document.insert(QLatin1String("results"), results);
+        const QByteArray json = QJsonDocument(document).toJson();
+        const QString fileName = parser.value(jsonOption);
+        if (fileName == QLatin1String("-")) {
+            fwrite(json.constData(), 1, size_t(json.size()), stdout);
+        } else {
+            QFile file(fileName);
+            if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()) {
+                qWarning("Cannot write %s", qPrintable(fileName));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+#include "main.moc"
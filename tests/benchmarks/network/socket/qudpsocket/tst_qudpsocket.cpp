@@ -41,6 +41,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void roundTrip_data();
+    void roundTrip();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -76,5 +78,50 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::roundTrip_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("size");
+    for (int size : {64, 1200}) {
+        QTest::addRow("single-%d", size) << false << size;
+        QTest::addRow("batched-%d", size) << true << size;
+    }
+}
+
+void tst_QUdpSocket::roundTrip()
+{
+    QFETCH(bool, batched);
+    QFETCH(int, size);
+    constexpr int Count = 64;
+
+    QUdpSocket socket;
+    QVERIFY(socket.bind(QHostAddress::LocalHost));
+
+    const QNetworkDatagram datagram(QByteArray(size, 'a'), QHostAddress::LocalHost,
+                                    socket.localPort());
+    const QList<QNetworkDatagram> datagrams(Count, datagram);
+
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(socket.writeDatagrams(datagrams), qint64(Count));
+        } else {
+            for (const QNetworkDatagram &d : datagrams)
+                QCOMPARE(socket.writeDatagram(d), size);
+        }
+
+        int received = 0;
+        while (received < Count) {
+            if (!socket.hasPendingDatagrams())
+                QVERIFY(socket.waitForReadyRead(5000));
+            if (batched) {
+                received += socket.receiveDatagrams(Count - received, size).size();
+            } else {
+                QVERIFY(socket.receiveDatagram(size).isValid());
+                ++received;
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
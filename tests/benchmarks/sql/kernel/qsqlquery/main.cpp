@@ -52,6 +52,10 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkExecBatch_data() { generic_data(); }
+    void benchmarkExecBatch();
+    void benchmarkExecBatchInTransaction_data() { generic_data(); }
+    void benchmarkExecBatchInTransaction();
 
 private:
     // returns all database connections
@@ -59,6 +63,7 @@ private:
     void dropTestTables( QSqlDatabase db );
     void createTestTables( QSqlDatabase db );
     void populateTestTables( QSqlDatabase db );
+    void execBatch(bool inTransaction);
 
     tst_Databases dbs;
 };
@@ -293,4 +298,52 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     tst_Databases::safeDropTable(db, tableName);
 }
 
+void tst_QSqlQuery::benchmarkExecBatch()
+{
+    execBatch(false);
+}
+
+void tst_QSqlQuery::benchmarkExecBatchInTransaction()
+{
+    execBatch(true);
+}
+
+void tst_QSqlQuery::execBatch(bool inTransaction)
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    if (!db.driver()->hasFeature(QSqlDriver::PreparedQueries))
+        QSKIP("Test requires prepared query support");
+    if (inTransaction && !db.driver()->hasFeature(QSqlDriver::Transactions))
+        QSKIP("Test requires transaction support");
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(20))"));
+
+    const int NUM_ROWS = 10000;
+    QVariantList ids;
+    QVariantList names;
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        ids << i;
+        names << QString("Name%1").arg(i);
+    }
+
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " (id, name) VALUES (?, ?)"));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    QBENCHMARK {
+        if (inTransaction)
+            QVERIFY(db.transaction());
+        QVERIFY_SQL(q, execBatch());
+        if (inTransaction)
+            QVERIFY(db.commit());
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 #include "main.moc"